@@ -261,6 +261,7 @@ class CDCReadRpc : public rpc::Rpc, public client::internal::TabletRpc {
 
   void InvokeAsync(
       CDCServiceProxy *cdc_proxy, rpc::RpcController *controller, rpc::ResponseCallback callback) {
+    controller->set_priority_class(rpc::RpcPriorityClass::kBackground);
     cdc_proxy->GetChangesAsync(req_, &resp_, controller, std::move(callback));
   }
 
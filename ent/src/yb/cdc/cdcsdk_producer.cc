@@ -12,6 +12,10 @@
 
 #include "yb/cdc/cdc_producer.h"
 
+#include <deque>
+#include <map>
+#include <mutex>
+
 #include "yb/cdc/cdc_common_util.h"
 
 #include "yb/client/client.h"
@@ -24,6 +28,9 @@
 #include "yb/docdb/docdb_util.h"
 #include "yb/docdb/doc_key.h"
 
+#include "yb/gutil/casts.h"
+#include "yb/gutil/thread_annotations.h"
+
 #include "yb/master/master_client.pb.h"
 #include "yb/master/master_util.h"
 
@@ -34,6 +41,12 @@ using std::string;
 
 DEFINE_RUNTIME_int32(cdc_snapshot_batch_size, 250, "Batch size for the snapshot operation in CDC");
 
+DEFINE_RUNTIME_uint64(cdc_snapshot_batch_size_bytes, 0,
+    "Max total size in bytes of records in one batch of the snapshot operation in CDC. Allows "
+    "to increase cdc_snapshot_batch_size for tables with small rows, while keeping responses "
+    "with large rows bounded. 0 means that batches are limited only by cdc_snapshot_batch_size.");
+TAG_FLAG(cdc_snapshot_batch_size_bytes, advanced);
+
 DEFINE_RUNTIME_bool(stream_truncate_record, false, "Enable streaming of TRUNCATE record");
 
 DECLARE_int64(cdc_intent_retention_ms);
@@ -41,6 +54,11 @@ DECLARE_int64(cdc_intent_retention_ms);
 DEFINE_RUNTIME_bool(enable_single_record_update, true,
     "Enable packing updates corresponding to a row in single CDC record");
 
+DEFINE_RUNTIME_bool(cdcsdk_compact_column_references, false,
+    "Reference columns of CDCSDK row records by their index in the schema announced by the DDL "
+    "record, instead of sending the column name with every value. Requires connector support.");
+TAG_FLAG(cdcsdk_compact_column_references, advanced);
+
 namespace yb {
 namespace cdc {
 
@@ -53,6 +71,52 @@ using yb::QLTableRow;
 
 YB_DEFINE_ENUM(OpType, (INSERT)(UPDATE)(DELETE));
 
+namespace {
+
+// Schemas of tables at snapshot times. All batches of a tablet snapshot are read at the same
+// snapshot time, so only the first batch has to request the schema from the master.
+class SnapshotSchemaCache {
+ public:
+  Result<std::pair<Schema, SchemaVersion>> Get(
+      client::YBClient* client, const TableId& table_id, uint64_t snapshot_time) {
+    auto key = std::make_pair(table_id, snapshot_time);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = entries_.find(key);
+      if (it != entries_.end()) {
+        return it->second;
+      }
+    }
+    auto result = VERIFY_RESULT(client->GetTableSchemaFromSysCatalog(table_id, snapshot_time));
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.emplace(key, result).second) {
+      order_.push_back(std::move(key));
+      if (order_.size() > kMaxEntries) {
+        entries_.erase(order_.front());
+        order_.pop_front();
+      }
+    }
+    return result;
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 128;
+
+  using Key = std::pair<TableId, uint64_t>;
+
+  std::mutex mutex_;
+  std::map<Key, std::pair<Schema, SchemaVersion>> entries_ GUARDED_BY(mutex_);
+  // Keys in insertion order, the oldest is evicted first.
+  std::deque<Key> order_ GUARDED_BY(mutex_);
+};
+
+SnapshotSchemaCache& GetSnapshotSchemaCache() {
+  static SnapshotSchemaCache cache;
+  return cache;
+}
+
+} // namespace
+
 void SetOperation(RowMessage* row_message, OpType type, const Schema& schema) {
   switch (type) {
     case OpType::INSERT:
@@ -69,16 +133,27 @@ void SetOperation(RowMessage* row_message, OpType type, const Schema& schema) {
   row_message->set_pgschema_name(schema.SchemaName());
 }
 
+void SetColumnReference(
+    const ColumnSchema& col_schema, size_t col_idx, DatumMessagePB* cdc_datum_message) {
+  if (FLAGS_cdcsdk_compact_column_references) {
+    cdc_datum_message->set_column_index(narrow_cast<int32_t>(col_idx));
+  } else {
+    cdc_datum_message->set_column_name(col_schema.name());
+  }
+}
+
 template <class Value>
 Status AddColumnToMap(
     const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
-    const ColumnSchema& col_schema,
+    const Schema& schema,
+    size_t col_idx,
     const Value& col,
     const EnumOidLabelMap& enum_oid_label_map,
     const CompositeAttsMap& composite_atts_map,
     DatumMessagePB* cdc_datum_message) {
   auto tablet = VERIFY_RESULT(tablet_peer->shared_tablet_safe());
-  cdc_datum_message->set_column_name(col_schema.name());
+  const auto& col_schema = schema.column(col_idx);
+  SetColumnReference(col_schema, col_idx, cdc_datum_message);
   QLValuePB ql_value;
   if (tablet->table_type() == PGSQL_TABLE_TYPE) {
     col.ToQLValuePB(col_schema.type(), &ql_value);
@@ -93,6 +168,24 @@ Status AddColumnToMap(
   return Status::OK();
 }
 
+template <class Value>
+Status AddColumnToMap(
+    const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
+    const Schema& schema,
+    ColumnId col_id,
+    const Value& col,
+    const EnumOidLabelMap& enum_oid_label_map,
+    const CompositeAttsMap& composite_atts_map,
+    DatumMessagePB* cdc_datum_message) {
+  auto col_idx = schema.find_column_by_id(col_id);
+  if (col_idx == Schema::kColumnNotFound) {
+    return STATUS_FORMAT(NotFound, "Column $0 not found in schema", col_id);
+  }
+  return AddColumnToMap(
+      tablet_peer, schema, col_idx, col, enum_oid_label_map, composite_atts_map,
+      cdc_datum_message);
+}
+
 DatumMessagePB* AddTuple(RowMessage* row_message) {
   if (!row_message) {
     return nullptr;
@@ -117,14 +210,14 @@ Status AddPrimaryKey(
   for (const auto& col : decoded_key.doc_key().hashed_group()) {
     DatumMessagePB* tuple = AddTuple(row_message);
     RETURN_NOT_OK(AddColumnToMap(
-        tablet_peer, tablet_schema.column(i), col, enum_oid_label_map, composite_atts_map, tuple));
+        tablet_peer, tablet_schema, i, col, enum_oid_label_map, composite_atts_map, tuple));
     i++;
   }
 
   for (const auto& col : decoded_key.doc_key().range_group()) {
     DatumMessagePB* tuple = AddTuple(row_message);
     RETURN_NOT_OK(AddColumnToMap(
-        tablet_peer, tablet_schema.column(i), col, enum_oid_label_map, composite_atts_map, tuple));
+        tablet_peer, tablet_schema, i, col, enum_oid_label_map, composite_atts_map, tuple));
     i++;
   }
   return Status::OK();
@@ -202,9 +295,8 @@ Result<size_t> PopulatePackedRows(
     if (!slice.empty()) {
       RETURN_NOT_OK(pv.DecodeFromValue(slice));
     }
-    const ColumnSchema& col = VERIFY_RESULT(schema.column_by_id(column_data.id));
     RETURN_NOT_OK(AddColumnToMap(
-        tablet_peer, col, pv, enum_oid_label_map, composite_atts_map,
+        tablet_peer, schema, column_data.id, pv, enum_oid_label_map, composite_atts_map,
         row_message->add_new_tuple()));
     row_message->add_old_tuple();
   }
@@ -359,12 +451,9 @@ Status PopulateCDCSDKIntentRecord(
         RETURN_NOT_OK(decoded_value.Decode(intent.value_buf));
 
         if (column_id_opt && column_id_opt->type() == docdb::KeyEntryType::kColumnId) {
-          const ColumnSchema& col =
-              VERIFY_RESULT(schema.column_by_id(column_id_opt->GetColumnId()));
-
           RETURN_NOT_OK(AddColumnToMap(
-              tablet_peer, col, decoded_value.primitive_value(), enum_oid_label_map,
-              composite_atts_map, row_message->add_new_tuple()));
+              tablet_peer, schema, column_id_opt->GetColumnId(), decoded_value.primitive_value(),
+              enum_oid_label_map, composite_atts_map, row_message->add_new_tuple()));
           row_message->add_old_tuple();
 
         } else if (column_id_opt && column_id_opt->type() != docdb::KeyEntryType::kSystemColumnId) {
@@ -501,13 +590,12 @@ Status PopulateCDCSDKWriteRecord(
         Slice key_column = key.WithoutPrefix(key_size);
         RETURN_NOT_OK(docdb::KeyEntryValue::DecodeKey(&key_column, &column_id));
         if (column_id.type() == docdb::KeyEntryType::kColumnId) {
-          const ColumnSchema& col = VERIFY_RESULT(schema.column_by_id(column_id.GetColumnId()));
           docdb::Value decoded_value;
           RETURN_NOT_OK(decoded_value.Decode(write_pair.value()));
 
           RETURN_NOT_OK(AddColumnToMap(
-              tablet_peer, col, decoded_value.primitive_value(), enum_oid_label_map,
-              composite_atts_map, row_message->add_new_tuple()));
+              tablet_peer, schema, column_id.GetColumnId(), decoded_value.primitive_value(),
+              enum_oid_label_map, composite_atts_map, row_message->add_new_tuple()));
           row_message->add_old_tuple();
 
         } else if (column_id.type() != docdb::KeyEntryType::kSystemColumnId) {
@@ -779,7 +867,7 @@ Status PopulateCDCSDKSnapshotRecord(
     const ColumnSchema& col_schema = VERIFY_RESULT(schema.column_by_id(col_id));
 
     cdc_datum_message = row_message->add_new_tuple();
-    cdc_datum_message->set_column_name(col_schema.name());
+    SetColumnReference(col_schema, col_idx, cdc_datum_message);
 
     if (value && value->value_case() != QLValuePB::VALUE_NOT_SET
         && col_schema.pg_type_oid() != 0 /*kInvalidOid*/) {
@@ -945,8 +1033,8 @@ Status GetChangesForCDCSDK(
 
       Schema schema;
       SchemaVersion schema_version;
-      auto result = client->GetTableSchemaFromSysCatalog(
-          tablet_ptr->metadata()->table_id(), from_op_id.snapshot_time());
+      auto result = GetSnapshotSchemaCache().Get(
+          client, tablet_ptr->metadata()->table_id(), from_op_id.snapshot_time());
       // Failed to get specific schema version from the system catalog, use the latest
       // schema version for the key-value decoding.
       if (!result.ok()) {
@@ -962,16 +1050,22 @@ Status GetChangesForCDCSDK(
       FillDDLInfo(tablet_peer, schema, schema_version, resp);
 
       int limit = FLAGS_cdc_snapshot_batch_size;
+      const auto size_limit = GetAtomicFlag(&FLAGS_cdc_snapshot_batch_size_bytes);
       int fetched = 0;
+      size_t fetched_bytes = 0;
       std::vector<QLTableRow> rows;
       QLTableRow row;
       auto iter = VERIFY_RESULT(tablet_ptr->CreateCDCSnapshotIterator(
           schema.CopyWithoutColumnIds(), time, nextKey));
-      while (VERIFY_RESULT(iter->HasNext()) && fetched < limit) {
+      while (VERIFY_RESULT(iter->HasNext()) && fetched < limit &&
+             (size_limit == 0 || fetched_bytes < size_limit)) {
         RETURN_NOT_OK(iter->NextRow(&row));
         RETURN_NOT_OK(PopulateCDCSDKSnapshotRecord(
             resp, &row, schema, tablet_peer, time, enum_oid_label_map, composite_atts_map));
         fetched++;
+        if (size_limit != 0) {
+          fetched_bytes += resp->cdc_sdk_proto_records().rbegin()->ByteSizeLong();
+        }
       }
       docdb::SubDocKey sub_doc_key;
       RETURN_NOT_OK(iter->GetNextReadSubDocKey(&sub_doc_key));
@@ -85,6 +85,7 @@ DECLARE_int32(cdc_wal_retention_time_secs);
 DECLARE_int32(replication_failure_delay_exponent);
 DECLARE_double(TEST_respond_write_failed_probability);
 DECLARE_int32(cdc_max_apply_batch_num_records);
+DECLARE_int32(cdc_max_parallel_apply_tablets);
 DECLARE_int32(async_replication_idle_delay_ms);
 DECLARE_int32(async_replication_polling_delay_ms);
 DECLARE_int32(async_replication_max_idle_wait);
@@ -2502,6 +2503,53 @@ TEST_P(TwoDCTest, ApplyOperationsRandomFailures) {
   ASSERT_OK(DeleteUniverseReplication(kUniverseId, producer_client(), producer_cluster()));
 }
 
+TEST_P(TwoDCTest, ApplyOperationsParallel) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_cdc_max_parallel_apply_tablets) = 4;
+
+  uint32_t replication_factor = NonTsanVsTsan(3, 1);
+  // Use a single producer tablet, so each GetChanges response is written to multiple consumer
+  // tablets in parallel.
+  auto tables = ASSERT_RESULT(SetUpWithParams({1}, {8}, replication_factor));
+
+  std::vector<std::shared_ptr<client::YBTable>> producer_tables;
+  producer_tables.reserve(1);
+  producer_tables.push_back(tables[0]);
+  ASSERT_OK(SetupUniverseReplication(producer_tables));
+  ASSERT_OK(CorrectlyPollingAllTablets(consumer_cluster(), 1));
+
+  WriteWorkload(0, 500, producer_client(), tables[0]->name());
+  ASSERT_OK(VerifyWrittenRecords(tables[0]->name(), tables[1]->name()));
+
+  ASSERT_OK(DeleteUniverseReplication());
+}
+
+TEST_P(TwoDCTest, ApplyOperationsParallelRandomFailures) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_cdc_max_parallel_apply_tablets) = 4;
+  SetAtomicFlag(0.25, &FLAGS_TEST_respond_write_failed_probability);
+
+  uint32_t replication_factor = NonTsanVsTsan(3, 1);
+  auto tables = ASSERT_RESULT(SetUpWithParams({1}, {8}, replication_factor));
+
+  std::vector<std::shared_ptr<client::YBTable>> producer_tables;
+  producer_tables.reserve(1);
+  producer_tables.push_back(tables[0]);
+  ASSERT_OK(SetupUniverseReplication(producer_tables));
+  ASSERT_OK(CorrectlyPollingAllTablets(consumer_cluster(), 1));
+
+  // A failed write is reported only after the writes to other tablets are done, and the whole
+  // batch is retried. The poller should neither hang nor lose records.
+  WriteWorkload(0, 500, producer_client(), tables[0]->name());
+  ASSERT_OK(VerifyWrittenRecords(tables[0]->name(), tables[1]->name()));
+
+  // Replication keeps going after the failures stop.
+  SetAtomicFlag(0.0, &FLAGS_TEST_respond_write_failed_probability);
+  WriteWorkload(500, 1000, producer_client(), tables[0]->name());
+  ASSERT_OK(VerifyWrittenRecords(tables[0]->name(), tables[1]->name()));
+  ASSERT_OK(CorrectlyPollingAllTablets(consumer_cluster(), 1));
+
+  ASSERT_OK(DeleteUniverseReplication());
+}
+
 class TwoDCTestToggleBatching : public TwoDCTest {};
 
 INSTANTIATE_TEST_CASE_P(
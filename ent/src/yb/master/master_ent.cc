@@ -47,6 +47,9 @@ Status Master::RegisterServices() {
   server::HybridClock::RegisterProvider(NtpClock::Name(), [](const std::string&) {
     return std::make_shared<NtpClock>();
   });
+  server::HybridClock::RegisterProvider(BoundedErrorClock::Name(), [](const std::string&) {
+    return std::make_shared<BoundedErrorClock>();
+  });
 #endif
 
   std::unique_ptr<ServiceIf> master_backup_service(new MasterBackupServiceImpl(this));
@@ -114,6 +114,9 @@ Status TabletServer::RegisterServices() {
   server::HybridClock::RegisterProvider(NtpClock::Name(), [](const std::string&) {
     return std::make_shared<NtpClock>();
   });
+  server::HybridClock::RegisterProvider(BoundedErrorClock::Name(), [](const std::string&) {
+    return std::make_shared<BoundedErrorClock>();
+  });
 #endif
 
   cdc_service_ = std::make_shared<cdc::CDCServiceImpl>(
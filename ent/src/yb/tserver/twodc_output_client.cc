@@ -13,6 +13,8 @@
 #include "yb/tserver/twodc_output_client.h"
 
 #include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "yb/cdc/cdc_util.h"
 #include "yb/cdc/cdc_rpc.h"
@@ -44,6 +46,11 @@ DEFINE_RUNTIME_bool(cdc_force_remote_tserver, false,
 
 DECLARE_int32(cdc_read_rpc_timeout_ms);
 
+DEFINE_RUNTIME_int32(cdc_max_parallel_apply_tablets, 8,
+    "Max number of consumer tablets, that the changes of one producer tablet are written to "
+    "concurrently. Writes to the same consumer tablet are always sent one after another.");
+TAG_FLAG(cdc_max_parallel_apply_tablets, advanced);
+
 DEFINE_test_flag(bool, xcluster_consumer_fail_after_process_split_op, false,
     "Whether or not to fail after processing a replicated split_op on the consumer.");
 
@@ -72,7 +79,6 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
       local_client_(local_client),
       thread_pool_(thread_pool),
       rpcs_(rpcs),
-      write_handle_(rpcs->InvalidHandle()),
       apply_changes_clbk_(std::move(apply_changes_clbk)),
       use_local_tserver_(use_local_tserver),
       all_tablets_result_(STATUS(Uninitialized, "Result has not been initialized.")),
@@ -93,15 +99,17 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
     DCHECK(!shutdown_);
     shutdown_ = true;
 
-    rpc::RpcCommandPtr rpc_to_abort;
+    std::vector<rpc::RpcCommandPtr> rpcs_to_abort;
     {
       std::lock_guard<decltype(lock_)> l(lock_);
-      if (write_handle_ != rpcs_->InvalidHandle()) {
-        rpc_to_abort = *write_handle_;
+      for (const auto& [tablet_id, handle] : write_handles_) {
+        if (handle != rpcs_->InvalidHandle()) {
+          rpcs_to_abort.push_back(*handle);
+        }
       }
     }
-    if (rpc_to_abort) {
-      rpc_to_abort->Abort();
+    for (const auto& rpc : rpcs_to_abort) {
+      rpc->Abort();
     }
   }
 
@@ -154,10 +162,16 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
 
   Status SendUserTableWrites();
 
+  // Picks write requests to tablets without writes in flight, up to
+  // cdc_max_parallel_apply_tablets tablets in total, and marks those tablets as busy.
+  std::vector<std::unique_ptr<WriteRequestPB>> GetNextWriteRequestsUnlocked() REQUIRES(lock_);
+
   void SendNextCDCWriteToTablet(std::unique_ptr<WriteRequestPB> write_request);
 
-  void WriteCDCRecordDone(const Status& status, const WriteResponsePB& response);
-  void DoWriteCDCRecordDone(const Status& status, const WriteResponsePB& response);
+  void WriteCDCRecordDone(
+      const TabletId& tablet_id, const Status& status, const WriteResponsePB& response);
+  void DoWriteCDCRecordDone(
+      const TabletId& tablet_id, const Status& status, const WriteResponsePB& response);
 
   // Increment processed record count.
   // Returns true if all records are processed, false if there are still some pending records.
@@ -177,7 +191,8 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
   std::shared_ptr<CDCClient> local_client_;
   ThreadPool* thread_pool_;  // Use threadpool so that callbacks aren't run on reactor threads.
   rpc::Rpcs* rpcs_;
-  rpc::Rpcs::Handle write_handle_ GUARDED_BY(lock_);
+  // Handles of write rpcs in flight, by consumer tablet.
+  std::unordered_map<TabletId, rpc::Rpcs::Handle> write_handles_ GUARDED_BY(lock_);
   // Retain COMMIT rpcs in-flight as these need to be cleaned up on shutdown
   std::vector<std::shared_ptr<client::ExternalTransaction>> external_transactions_;
   std::function<void(const cdc::OutputClientResponse& response)> apply_changes_clbk_;
@@ -186,12 +201,17 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
 
   std::shared_ptr<client::YBTable> table_;
 
-  // Used to protect error_status_, op_id_, done_processing_, write_handle_ and record counts.
+  // Used to protect error_status_, op_id_, done_processing_, write_handles_ and record counts.
   mutable rw_spinlock lock_;
   Status error_status_ GUARDED_BY(lock_);
   OpIdPB op_id_ GUARDED_BY(lock_) = consensus::MinimumOpId();
   bool done_processing_ GUARDED_BY(lock_) = false;
   uint32_t wait_for_version_ GUARDED_BY(lock_) = 0;
+  // Consumer tablets with a write in flight. The response is not sent until all of them are done,
+  // so the poller advances the checkpoint and safe time only after all writes are applied.
+  std::unordered_set<TabletId> in_flight_write_tablets_ GUARDED_BY(lock_);
+  // First error of the writes in the current batch.
+  Status write_status_ GUARDED_BY(lock_);
   std::atomic<bool> shutdown_ = false;
 
   uint32_t processed_record_count_ GUARDED_BY(lock_) = 0;
@@ -249,7 +269,8 @@ Status TwoDCOutputClient::ApplyChanges(const cdc::GetChangesResponsePB* poller_r
   // ApplyChanges is called in a single threaded manner.
   // For all the changes in GetChangesResponsePB, we first fan out and find the tablet for
   // every record key.
-  // Then we apply the records in the same order in which we received them.
+  // Then we apply the records in the same order in which we received them. Records of different
+  // tablets are written concurrently, while records of the same tablet are written in order.
   // Once all changes have been applied (successfully or not), we invoke the callback which will
   // then either poll for next set of changes (in case of successful application) or will try to
   // re-apply.
@@ -264,6 +285,8 @@ Status TwoDCOutputClient::ApplyChanges(const cdc::GetChangesResponsePB* poller_r
     error_status_ = Status::OK();
     done_processing_ = false;
     wait_for_version_ = 0;
+    DCHECK(in_flight_write_tablets_.empty());
+    write_status_ = Status::OK();
     processed_record_count_ = 0;
     record_count_ = poller_resp->records_size();
     ResetWriteInterface(&write_strategy_);
@@ -426,19 +449,35 @@ Status TwoDCOutputClient::SendTransactionCommits() {
 
 Status TwoDCOutputClient::SendUserTableWrites() {
   // Send out the buffered writes.
-  std::unique_ptr<WriteRequestPB> write_request;
+  std::vector<std::unique_ptr<WriteRequestPB>> write_requests;
   {
     std::lock_guard<decltype(lock_)> l(lock_);
-    write_request = write_strategy_->GetNextWriteRequest();
+    write_requests = GetNextWriteRequestsUnlocked();
   }
-  if (!write_request) {
+  if (write_requests.empty()) {
     LOG(WARNING) << "Expected to find a write_request but were unable to";
     return STATUS(IllegalState, "Could not find a write request to send");
   }
-  SendNextCDCWriteToTablet(std::move(write_request));
+  for (auto& write_request : write_requests) {
+    SendNextCDCWriteToTablet(std::move(write_request));
+  }
   return Status::OK();
 }
 
+std::vector<std::unique_ptr<WriteRequestPB>> TwoDCOutputClient::GetNextWriteRequestsUnlocked() {
+  std::vector<std::unique_ptr<WriteRequestPB>> result;
+  const size_t max_tablets = std::max(FLAGS_cdc_max_parallel_apply_tablets, 1);
+  while (in_flight_write_tablets_.size() < max_tablets) {
+    auto write_request = write_strategy_->GetNextWriteRequest(in_flight_write_tablets_);
+    if (!write_request) {
+      break;
+    }
+    in_flight_write_tablets_.insert(write_request->tablet_id());
+    result.push_back(std::move(write_request));
+  }
+  return result;
+}
+
 bool TwoDCOutputClient::UseLocalTserver() {
   return use_local_tserver_ && !FLAGS_cdc_force_remote_tserver;
 }
@@ -568,84 +607,122 @@ Result<bool> TwoDCOutputClient::ProcessMetaOp(const cdc::CDCRecordPB& record) {
 }
 
 void TwoDCOutputClient::SendNextCDCWriteToTablet(std::unique_ptr<WriteRequestPB> write_request) {
-  // TODO: This should be parallelized for better performance with M:N setups.
   auto deadline =
       CoarseMonoClock::Now() + MonoDelta::FromMilliseconds(FLAGS_cdc_write_rpc_timeout_ms);
 
-  std::lock_guard<decltype(lock_)> l(lock_);
-  write_handle_ = rpcs_->Prepare();
-  if (write_handle_ != rpcs_->InvalidHandle()) {
-    // Send in nullptr for RemoteTablet since cdc rpc now gets the tablet_id from the write request.
-    *write_handle_ = cdc::CreateCDCWriteRpc(
-        deadline,
-        nullptr /* RemoteTablet */,
-        table_,
-        local_client_->client.get(),
-        write_request.get(),
-        std::bind(&TwoDCOutputClient::WriteCDCRecordDone, SharedFromThis(), _1, _2),
-        UseLocalTserver());
-    (**write_handle_).SendRpc();
-  } else {
-    LOG(WARNING) << "Invalid handle for CDC write, tablet ID: " << write_request->tablet_id();
+  {
+    std::lock_guard<decltype(lock_)> l(lock_);
+    auto& write_handle = write_handles_[write_request->tablet_id()];
+    write_handle = rpcs_->Prepare();
+    if (write_handle != rpcs_->InvalidHandle()) {
+      // Send in nullptr for RemoteTablet since cdc rpc now gets the tablet_id from the write
+      // request.
+      *write_handle = cdc::CreateCDCWriteRpc(
+          deadline,
+          nullptr /* RemoteTablet */,
+          table_,
+          local_client_->client.get(),
+          write_request.get(),
+          std::bind(&TwoDCOutputClient::WriteCDCRecordDone, SharedFromThis(),
+                    write_request->tablet_id(), _1, _2),
+          UseLocalTserver());
+      (**write_handle).SendRpc();
+      return;
+    }
+    write_handles_.erase(write_request->tablet_id());
   }
+
+  LOG(WARNING) << "Invalid handle for CDC write, tablet ID: " << write_request->tablet_id();
+  // Complete the write with an error, so the tablet is removed from in_flight_write_tablets_ and
+  // the response is returned to the poller once the other writes in flight are done.
+  DoWriteCDCRecordDone(
+      write_request->tablet_id(),
+      STATUS_FORMAT(
+          Aborted, "Could not prepare CDC write to tablet $0", write_request->tablet_id()),
+      WriteResponsePB());
 }
 
-void TwoDCOutputClient::WriteCDCRecordDone(const Status& status, const WriteResponsePB& response) {
+void TwoDCOutputClient::WriteCDCRecordDone(
+    const TabletId& tablet_id, const Status& status, const WriteResponsePB& response) {
   rpc::RpcCommandPtr retained;
   {
     std::lock_guard<decltype(lock_)> l(lock_);
-    retained = rpcs_->Unregister(&write_handle_);
+    auto it = write_handles_.find(tablet_id);
+    if (it != write_handles_.end()) {
+      retained = rpcs_->Unregister(&it->second);
+      write_handles_.erase(it);
+    }
   }
   RETURN_WHEN_OFFLINE();
 
   WARN_NOT_OK(
       thread_pool_->SubmitFunc(std::bind(
-          &TwoDCOutputClient::DoWriteCDCRecordDone, SharedFromThis(), status, std::move(response))),
+          &TwoDCOutputClient::DoWriteCDCRecordDone, SharedFromThis(), tablet_id, status,
+          std::move(response))),
       "Could not submit DoWriteCDCRecordDone to thread pool");
 }
 
 void TwoDCOutputClient::DoWriteCDCRecordDone(
-    const Status& status, const WriteResponsePB& response) {
+    const TabletId& tablet_id, const Status& status, const WriteResponsePB& response) {
   RETURN_WHEN_OFFLINE();
 
-  if (!status.ok()) {
-    HandleError(status);
-    return;
-  } else if (response.has_error()) {
-    HandleError(StatusFromPB(response.error().status()));
-    return;
+  auto write_status = status;
+  if (write_status.ok() && response.has_error()) {
+    write_status = StatusFromPB(response.error().status());
+  }
+  if (write_status.ok()) {
+    cdc_consumer_->IncrementNumSuccessfulWriteRpcs();
   }
-  cdc_consumer_->IncrementNumSuccessfulWriteRpcs();
 
-  // See if we need to handle any more writes.
-  std::unique_ptr<WriteRequestPB> write_request;
+  // See if we need to handle any more writes. On error, wait for writes in flight to other
+  // tablets before reporting it, so the next ApplyChanges does not overlap with them.
+  std::vector<std::unique_ptr<WriteRequestPB>> write_requests;
+  bool all_writes_done = false;
   {
     std::lock_guard<decltype(lock_)> l(lock_);
-    write_request = write_strategy_->GetNextWriteRequest();
+    in_flight_write_tablets_.erase(tablet_id);
+    if (!write_status.ok() && write_status_.ok()) {
+      write_status_ = write_status;
+    }
+    if (write_status_.ok()) {
+      write_requests = GetNextWriteRequestsUnlocked();
+    }
+    all_writes_done = in_flight_write_tablets_.empty();
+    if (all_writes_done) {
+      write_status = std::move(write_status_);
+      write_status_ = Status::OK();
+    }
   }
 
-  if (write_request) {
+  for (auto& write_request : write_requests) {
     SendNextCDCWriteToTablet(std::move(write_request));
-  } else {
-    // We may still have more records to process (in case of ddls/master requests).
-    int next_record = 0;
-    {
-      SharedLock<decltype(lock_)> l(lock_);
-      if (processed_record_count_ < record_count_) {
-        // processed_record_count_ is 1-based, so no need to add 1 to get next record.
-        next_record = processed_record_count_;
-      }
+  }
+  if (!all_writes_done) {
+    return;
+  }
+  if (!write_status.ok()) {
+    HandleError(write_status);
+    return;
+  }
+
+  // We may still have more records to process (in case of ddls/master requests).
+  int next_record = 0;
+  {
+    SharedLock<decltype(lock_)> l(lock_);
+    if (processed_record_count_ < record_count_) {
+      // processed_record_count_ is 1-based, so no need to add 1 to get next record.
+      next_record = processed_record_count_;
     }
-    if (next_record > 0) {
-      // Process rest of the records.
-      Status s = ProcessChangesStartingFromIndex(next_record);
-      if (!s.ok()) {
-        HandleError(s);
-      }
-    } else {
-      // Last record, return response to caller.
-      HandleResponse();
+  }
+  if (next_record > 0) {
+    // Process rest of the records.
+    Status s = ProcessChangesStartingFromIndex(next_record);
+    if (!s.ok()) {
+      HandleError(s);
     }
+  } else {
+    // Last record, return response to caller.
+    HandleResponse();
   }
 }
 
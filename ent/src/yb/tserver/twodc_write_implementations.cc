@@ -229,7 +229,7 @@ Status AddRecord(const ProcessRecordInfo& process_record_info,
 // Max number of records in a request is cdc_max_apply_batch_num_records, and max size of a request
 // is cdc_max_apply_batch_size_kb. Batches are not sent by opid order, since a GetChangesResponse
 // can contain interleaved records to multiple tablets. Rather, we send batches to each tablet
-// in order for that tablet, before moving on to the next tablet.
+// in order for that tablet, while batches to different tablets could be sent concurrently.
 class BatchedWriteImplementation : public TwoDCWriteInterface {
   ~BatchedWriteImplementation() = default;
 
@@ -279,17 +279,21 @@ class BatchedWriteImplementation : public TwoDCWriteInterface {
     return Status::OK();
   }
 
-  std::unique_ptr<WriteRequestPB> GetNextWriteRequest() override {
-    if (records_.empty()) {
-      return nullptr;
-    }
-    auto& queue = records_.begin()->second;
-    auto next_req = std::move(queue.front());
-    queue.pop_front();
-    if (queue.empty()) {
-      records_.erase(next_req->tablet_id());
+  std::unique_ptr<WriteRequestPB> GetNextWriteRequest(
+      const std::unordered_set<TabletId>& skip_tablets) override {
+    for (auto it = records_.begin(); it != records_.end(); ++it) {
+      if (skip_tablets.count(it->first)) {
+        continue;
+      }
+      auto& queue = it->second;
+      auto next_req = std::move(queue.front());
+      queue.pop_front();
+      if (queue.empty()) {
+        records_.erase(it);
+      }
+      return next_req;
     }
-    return next_req;
+    return nullptr;
   }
 
   std::vector<client::ExternalTransactionMetadata>& GetTransactionMetadatas() override {
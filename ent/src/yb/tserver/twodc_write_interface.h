@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_set>
 
 #include "yb/client/external_transaction.h"
 
@@ -43,7 +44,10 @@ struct ProcessRecordInfo {
 class TwoDCWriteInterface {
  public:
   virtual ~TwoDCWriteInterface() {}
-  virtual std::unique_ptr<WriteRequestPB> GetNextWriteRequest() = 0;
+  // Returns the next write request to a tablet that is not in skip_tablets, or nullptr when there
+  // are no such requests. Requests to the same tablet are returned in the order they were built.
+  virtual std::unique_ptr<WriteRequestPB> GetNextWriteRequest(
+      const std::unordered_set<TabletId>& skip_tablets) = 0;
   virtual Status ProcessRecord(
       const ProcessRecordInfo& process_record_info, const cdc::CDCRecordPB& record) = 0;
   virtual Status ProcessCommitRecord(
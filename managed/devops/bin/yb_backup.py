@@ -937,6 +937,8 @@ class YBManifest:
         if not self.backup.args.disable_checksums:
             properties['hash-algorithm'] = XXH64_FILE_EXT \
                 if self.backup.use_xxhash_checksum else SHA_FILE_EXT
+        if self.backup.args.prev_backup_location:
+            properties['incremental-from'] = self.backup.args.prev_backup_location
 
     def init_locations(self, tablet_leaders, snapshot_bucket):
         locations = self.body['locations']
@@ -1006,6 +1008,10 @@ class YBManifest:
         assert 'properties' in self.body
         return self.body['properties'].get('hash-algorithm', SHA_FILE_EXT)
 
+    def is_incremental(self):
+        assert 'properties' in self.body
+        return 'incremental-from' in self.body['properties']
+
 
 class YBBackup:
     def __init__(self):
@@ -1221,6 +1227,12 @@ class YBBackup:
             '--no_snapshot_deleting',
             action='store_true',
             help="Disable automatic snapshot deleting after the backup creating or restoring.")
+        parser.add_argument(
+            '--prev_backup_location', required=False, default=None,
+            help="Location of the previous backup of the same tables, as printed in its "
+                 "snapshot_url. When set, the backup is incremental: snapshot files that are "
+                 "identical to files of the previous backup are not uploaded, but referenced. "
+                 "The referenced backups must be kept while this backup is needed.")
         parser.add_argument(
             '--snapshot_id', type=check_uuid,
             help="Use the existing snapshot ID instead of creating a new one.")
@@ -1439,6 +1451,14 @@ class YBBackup:
         else:
             self.use_xxhash_checksum = False
 
+        if self.args.prev_backup_location:
+            if self.args.disable_checksums:
+                raise BackupException(
+                    "Incremental backup compares check-sums of files, so it cannot be used with "
+                    "--disable_checksums")
+            if self.per_region_backup():
+                raise BackupException("Incremental backup is not supported for regional backups")
+
         if self.args.mac:
             # As this arg is used only for the purpose of tests & we use hardcoded paths only
             # defaulting it to shasum.
@@ -2445,6 +2465,68 @@ class YBBackup:
             os.path.join(pipes.quote(strip_dir(dir_path)), '[!i]*'),
             pipes.quote(self.checksum_path(strip_dir(dir_path))))
 
+    @staticmethod
+    def refs_path(tablet_path):
+        """
+        Path of the file that lists files of the incremental backup's tablet directory, that are
+        stored by previous backups. Each line is '<file name> <tablet directory URL>'.
+        """
+        return strip_dir(tablet_path) + '.refs'
+
+    def prepare_incremental_upload_commands(self, parallel_commands, tablet_id, snapshot_dir):
+        """
+        Prepares the commands that create a copy of the snapshot directory, which contains
+        hard links to the files that changed since the previous backup, and the refs file for
+        the unchanged ones.
+        :return: the directory to upload
+        """
+        snapshot_dir = strip_dir(snapshot_dir)
+        prev_tablet_filepath = os.path.join(self.args.prev_backup_location,
+                                            'tablet-%s' % (tablet_id))
+        prev_checksum_path = self.checksum_path(snapshot_dir + '.prev')
+        prev_refs_path = self.refs_path(snapshot_dir + '.prev')
+        refs_path = self.refs_path(snapshot_dir)
+        incremental_dir = snapshot_dir + '.incremental'
+
+        # The tablet could be missing in the previous backup, or the previous backup could be a
+        # full one without refs. Then all files are uploaded.
+        for (src, dest) in [(self.checksum_path(prev_tablet_filepath), prev_checksum_path),
+                            (self.refs_path(prev_tablet_filepath), prev_refs_path)]:
+            parallel_commands.add_args('rm -f {}'.format(pipes.quote(dest)))
+            parallel_commands.add_args(
+                '{} || : > {}'.format(' '.join(self.storage.download_file_cmd(src, dest)),
+                                      pipes.quote(dest)))
+
+        # A file is unchanged when the previous backup has a file with the same name and
+        # check-sum. It is referenced at the location that stores it, which is the previous
+        # backup itself, or the backup referenced by it.
+        parallel_commands.add_args('rm -f {}'.format(pipes.quote(refs_path)))
+        parallel_commands.add_args(
+            "awk -v url={} -v refs={} 'FILENAME == ARGV[1] {{ ref[$1] = $2; next }} "
+            "{{ name = $2; sub(\".*/\", \"\", name) }} "
+            "FILENAME == ARGV[2] {{ prev[name] = $1; next }} "
+            "(name in prev) && prev[name] == $1 {{ "
+            "print name, (name in ref ? ref[name] : url) > refs }}' {} {} {}".format(
+                pipes.quote(prev_tablet_filepath), pipes.quote(refs_path),
+                pipes.quote(prev_refs_path), pipes.quote(prev_checksum_path),
+                pipes.quote(self.checksum_path(snapshot_dir))))
+        parallel_commands.add_args('touch {}'.format(pipes.quote(refs_path)))
+        parallel_commands.add_args('rm -rf {}'.format(pipes.quote(incremental_dir)))
+        parallel_commands.add_args('cp -al {} {}'.format(
+            pipes.quote(snapshot_dir), pipes.quote(incremental_dir)))
+        parallel_commands.add_args(
+            'while read -r name url; do rm -f {}/"$name"; done < {}'.format(
+                pipes.quote(incremental_dir), pipes.quote(refs_path)))
+        return incremental_dir + '/'
+
+    def cleanup_incremental_upload_commands(self, parallel_commands, snapshot_dir):
+        snapshot_dir = strip_dir(snapshot_dir)
+        parallel_commands.add_args('rm -rf {} {} {} {}'.format(
+            pipes.quote(snapshot_dir + '.incremental'),
+            pipes.quote(self.checksum_path(snapshot_dir + '.prev')),
+            pipes.quote(self.refs_path(snapshot_dir + '.prev')),
+            pipes.quote(self.refs_path(snapshot_dir))))
+
     def prepare_upload_command(self, parallel_commands, snapshot_filepath, tablet_id,
                                tserver_ip, snapshot_dir):
         """
@@ -2471,9 +2553,6 @@ class YBBackup:
                 snapshot_dir_checksum, target_checksum_filepath)
 
         target_filepath = target_tablet_filepath + '/'
-        logging.info('Uploading %s from tablet server %s to %s URL %s' % (
-                     snapshot_dir, tserver_ip, self.args.storage_type, target_filepath))
-        upload_tablet_cmd = self.storage.upload_dir_cmd(snapshot_dir, target_filepath)
 
         # Commands to be run on TSes over ssh for uploading the tablet backup.
         if not self.args.disable_checksums:
@@ -2481,8 +2560,21 @@ class YBBackup:
             parallel_commands.add_args(create_checksum_cmd)
             # 2. Upload check-sum file.
             parallel_commands.add_args(tuple(upload_checksum_cmd))
-        # 3. Upload tablet folder.
-        parallel_commands.add_args(tuple(upload_tablet_cmd))
+
+        upload_dir = snapshot_dir
+        if self.args.prev_backup_location:
+            # 3. Find files changed since the previous backup, and upload refs to the unchanged.
+            upload_dir = self.prepare_incremental_upload_commands(
+                parallel_commands, tablet_id, snapshot_dir)
+            parallel_commands.add_args(tuple(self.storage.upload_file_cmd(
+                self.refs_path(snapshot_dir), self.refs_path(target_tablet_filepath))))
+
+        # 4. Upload tablet folder.
+        logging.info('Uploading %s from tablet server %s to %s URL %s' % (
+                     upload_dir, tserver_ip, self.args.storage_type, target_filepath))
+        parallel_commands.add_args(tuple(self.storage.upload_dir_cmd(upload_dir, target_filepath)))
+        if self.args.prev_backup_location:
+            self.cleanup_incremental_upload_commands(parallel_commands, snapshot_dir)
 
     def prepare_download_command(self, parallel_commands, tablet_id,
                                  tserver_ip, snapshot_dir, snapshot_metadata):
@@ -2532,6 +2624,20 @@ class YBBackup:
         parallel_commands.add_args(tuple(mkdircmd))
         # 3. Download tablet folder.
         parallel_commands.add_args(tuple(cmd))
+        if self.manifest.is_incremental():
+            # 3a. Download files referenced by the incremental backup from the backups that
+            # store them. Command template is filled for each file, since storages quote
+            # arguments differently.
+            refs_path = self.refs_path(snapshot_dir)
+            parallel_commands.add_args(tuple(self.storage.download_file_cmd(
+                self.refs_path(source_filepath), refs_path)))
+            template = ' '.join(self.storage.download_file_cmd('@SRC@', '@DST@'))
+            parallel_commands.add_args(
+                'template={}; while read -r name url; do '
+                'cmd=${{template//@SRC@/$url/$name}}; cmd=${{cmd//@DST@/{}$name}}; eval "$cmd"; '
+                'done < {}; rm -f {}'.format(
+                    pipes.quote(template), pipes.quote(snapshot_dir_tmp), pipes.quote(refs_path),
+                    pipes.quote(refs_path)))
         if not self.args.disable_checksums:
             # 4. Download check-sum file.
             parallel_commands.add_args(tuple(cmd_checksum))
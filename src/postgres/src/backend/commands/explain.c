@@ -3034,6 +3034,22 @@ show_yb_rpc_stats(PlanState *planstate, bool indexScan, ExplainState *es)
 			ExplainPropertyFloat("Storage Table Execution Time", "ms",
 								 tbl_read_wait / 1000000.0, 3, es);
 	}
+
+	if (es->verbose && (reads > 0.0 || tbl_reads > 0.0))
+	{
+		YbPgDocDBStats *stats = &planstate->instrument->yb_docdb_stats;
+
+		ExplainPropertyFloat("DocDB Seeks", NULL,
+							 stats->seeks / nloops, 0, es);
+		ExplainPropertyFloat("DocDB Keys Skipped", NULL,
+							 stats->keys_skipped / nloops, 0, es);
+		ExplainPropertyFloat("DocDB Block Cache Hits", NULL,
+							 stats->block_cache_hits / nloops, 0, es);
+		ExplainPropertyFloat("DocDB Block Cache Misses", NULL,
+							 stats->block_cache_misses / nloops, 0, es);
+		ExplainPropertyFloat("DocDB Block Read Bytes", NULL,
+							 stats->block_read_bytes / nloops, 0, es);
+	}
 }
 
 /*
@@ -730,7 +730,6 @@ nextval_internal(Oid relid, bool check_permissions)
 	HeapTuple	pgstuple;
 	Form_pg_sequence pgsform;
 	HeapTupleData seqdatatuple;
-	FormData_pg_sequence_data seq_data;
 	Form_pg_sequence_data seq;
 	int64		incby,
 				maxv,
@@ -788,30 +787,66 @@ nextval_internal(Oid relid, bool check_permissions)
 	cycle = pgsform->seqcycle;
 	ReleaseSysCache(pgstuple);
 
-retry:
-	rescnt = 0;
+	/*
+	 * YugaByte fetches the next cache of values through the node level cache
+	 * of the sequence values. The node leases larger ranges from the sequence
+	 * row, so concurrent backends of the node do not update the row on every
+	 * refill of their caches.
+	 */
 	if (IsYugaByteEnabled())
 	{
-		int64_t last_val;
-		bool is_called;
-		HandleYBStatus(YBCReadSequenceTuple(MyDatabaseId,
-											relid,
-											yb_catalog_cache_version,
-											YBIsDBCatalogVersionMode(),
-											&last_val,
-											&is_called));
-		seq_data.last_value = last_val;
-		seq_data.is_called = is_called;
-		seq_data.log_cnt = 0;
-		seq = &seq_data;
-	}
-	else
-	{
-		/* lock page' buffer and read tuple */
-		seq = read_seq_tuple(seqrel, &buf, &seqdatatuple);
-		page = BufferGetPage(buf);
+		int64_t		first_value;
+		int64_t		last_value;
+		YBCStatus	status;
+
+		status = YBCFetchSequenceTuple(MyDatabaseId,
+									   relid,
+									   yb_catalog_cache_version,
+									   YBIsDBCatalogVersionMode(),
+									   cache,
+									   incby,
+									   minv,
+									   maxv,
+									   cycle,
+									   &first_value,
+									   &last_value);
+		if (status &&
+			YBCStatusPgsqlError(status) == ERRCODE_SEQUENCE_GENERATOR_LIMIT_EXCEEDED)
+		{
+			char		buf[100];
+
+			YBCFreeStatus(status);
+			if (incby > 0)
+			{
+				snprintf(buf, sizeof(buf), INT64_FORMAT, maxv);
+				ereport(ERROR,
+						(errcode(ERRCODE_SEQUENCE_GENERATOR_LIMIT_EXCEEDED),
+						 errmsg("nextval: reached maximum value of sequence \"%s\" (%s)",
+								RelationGetRelationName(seqrel), buf)));
+			}
+			snprintf(buf, sizeof(buf), INT64_FORMAT, minv);
+			ereport(ERROR,
+					(errcode(ERRCODE_SEQUENCE_GENERATOR_LIMIT_EXCEEDED),
+					 errmsg("nextval: reached minimum value of sequence \"%s\" (%s)",
+							RelationGetRelationName(seqrel), buf)));
+		}
+		HandleYBStatus(status);
+
+		/* save info in local cache */
+		elm->increment = incby;
+		elm->last = first_value;	/* last returned number */
+		elm->cached = last_value;	/* last fetched number */
+		elm->last_valid = true;
+
+		last_used_seq = elm;
+		relation_close(seqrel, NoLock);
+		return first_value;
 	}
 
+	/* lock page' buffer and read tuple */
+	seq = read_seq_tuple(seqrel, &buf, &seqdatatuple);
+	page = BufferGetPage(buf);
+
 	elm->increment = incby;
 	last = next = result = seq->last_value;
 	fetch = cache;
@@ -823,12 +858,6 @@ retry:
 		fetch--;
 	}
 
-	/*
-	 * We don't use the WAL log record. The value has already been updated and there is no way
-	 * to rollback to another sequence number.
-	 */
-	if (IsYugaByteEnabled())
-		goto check_bounds;
 	/*
 	 * Decide whether we should emit a WAL log record.  If so, force up the
 	 * fetch count to grab SEQ_LOG_VALS more values than we actually need to
@@ -857,7 +886,6 @@ retry:
 		}
 	}
 
-check_bounds:
 	while (fetch)				/* try to fetch cache [+ log ] numbers */
 	{
 		/*
@@ -922,8 +950,7 @@ check_bounds:
 	}
 
 	log -= fetch;				/* adjust for any unfetched numbers */
-	if (!IsYugaByteEnabled())
-		Assert(log >= 0);
+	Assert(log >= 0);
 
 	/* save info in local cache */
 	elm->last = result;			/* last returned number */
@@ -932,35 +959,6 @@ check_bounds:
 
 	last_used_seq = elm;
 
-	/*
-	 * YugaByte doesn't use the WAL, and we don't need to free the buffer because we didn't allocate
-	 * memory for it. So close the relation and return the result now.
-	 */
-	if (IsYugaByteEnabled())
-	{
-		bool skipped = false;
-		/*
-		 * We do a conditional update here to detect write conflicts with other sessions. If the
-		 * update fails, we retry again by reading the last_val and is_called values and going
-		 * through the whole process again.
-		 */
-		HandleYBStatus(YBCUpdateSequenceTupleConditionally(MyDatabaseId,
-														   relid,
-														   yb_catalog_cache_version,
-														   YBIsDBCatalogVersionMode(),
-														   last /* last_val */,
-														   true /* is_called */,
-														   seq->last_value /* expected_last_val */,
-														   seq->is_called /* expected_is_called */,
-														   &skipped));
-		if (skipped)
-		{
-			goto retry;
-		}
-		relation_close(seqrel, NoLock);
-		return result;
-	}
-
 	/*
 	 * If something needs to be WAL logged, acquire an xid, so this
 	 * transaction's commit will trigger a WAL flush and wait for syncrep.
@@ -791,5 +791,6 @@ YbExecUpdateInstrumentIndexOnlyScan(IndexOnlyScanState *node,
 	Assert(PointerIsValid(ybscan));
 	if (ybscan->handle)
 		YbUpdateReadRpcStats(ybscan->handle,
-							 &instr->yb_read_rpcs, &instr->yb_tbl_read_rpcs);
+							 &instr->yb_read_rpcs, &instr->yb_tbl_read_rpcs,
+							 &instr->yb_docdb_stats);
 }
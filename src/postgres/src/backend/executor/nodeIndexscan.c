@@ -1873,5 +1873,6 @@ YbExecUpdateInstrumentIndexScan(IndexScanState *node, Instrumentation *instr)
 	Assert(PointerIsValid(ybscan));
 	if (ybscan->handle)
 		YbUpdateReadRpcStats(ybscan->handle,
-							 &instr->yb_read_rpcs, &instr->yb_tbl_read_rpcs);
+							 &instr->yb_read_rpcs, &instr->yb_tbl_read_rpcs,
+							 &instr->yb_docdb_stats);
 }
@@ -343,5 +343,6 @@ YbExecUpdateInstrumentSeqScan(SeqScanState *node, Instrumentation *instr)
 	Assert(PointerIsValid(ybscan));
 	if (ybscan->handle)
 		YbUpdateReadRpcStats(ybscan->handle,
-							 &instr->yb_read_rpcs, &instr->yb_tbl_read_rpcs);
+							 &instr->yb_read_rpcs, &instr->yb_tbl_read_rpcs,
+							 &instr->yb_docdb_stats);
 }
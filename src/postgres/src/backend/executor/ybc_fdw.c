@@ -698,7 +698,8 @@ YbExecUpdateInstrumentForeignScan(ForeignScanState *node,
 	YbFdwExecState *ybc_state = (YbFdwExecState *) node->fdw_state;
 	if (ybc_state->handle)
 		YbUpdateReadRpcStats(ybc_state->handle,
-							 &instr->yb_read_rpcs, &instr->yb_tbl_read_rpcs);
+							 &instr->yb_read_rpcs, &instr->yb_tbl_read_rpcs,
+							 &instr->yb_docdb_stats);
 }
 
 /* ------------------------------------------------------------------------- */
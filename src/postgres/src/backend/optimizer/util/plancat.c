@@ -944,6 +944,41 @@ infer_collation_opclass_match(InferenceElem *elem, Relation idxRel,
  * relation's attr_widths[] cache; we fill this in if we have need to compute
  * the attribute widths for estimation purposes.
  */
+/*
+ * Replaces the pg_class estimate of the number of rows of the YB relation with
+ * the estimate maintained by its tablets, when all of them have reported it.
+ * Failure to get the estimate is not an error, pg_class estimate is kept then.
+ */
+static void
+yb_estimate_rel_tuples(Relation rel, double *tuples)
+{
+	double		num_rows = 0;
+	int32		num_missing_tablets = 0;
+	YBCStatus	status;
+
+	/*
+	 * Catalog tables and primary indexes don't have dedicated tables in
+	 * DocDB, and colocated tables do not have size info.
+	 */
+	if (IsCatalogRelation(rel) ||
+		(rel->rd_index && rel->rd_index->indisprimary) ||
+		YbGetTableProperties(rel)->is_colocated)
+		return;
+
+	status = YBCPgGetTableEstimatedNumRows(YbGetStorageRelid(rel),
+										   MyDatabaseId, &num_rows,
+										   &num_missing_tablets);
+	if (status)
+	{
+		YBCFreeStatus(status);
+		return;
+	}
+
+	/* Zero could mean that tablets have not reported estimates yet. */
+	if (num_missing_tablets == 0 && num_rows > 0)
+		*tuples = num_rows;
+}
+
 void
 estimate_rel_size(Relation rel, int32 *attr_widths,
 				  BlockNumber *pages, double *tuples, double *allvisfrac)
@@ -955,14 +990,16 @@ estimate_rel_size(Relation rel, int32 *attr_widths,
 	double		density;
 
 	/*
-	 * TODO We don't support forwarding size estimates to postgres yet.
-	 * Use whatever is in pg_class.
+	 * Use whatever is in pg_class, unless the number of rows estimated by
+	 * tablets is requested.
 	 */
 	if (IsYBRelation(rel))
 	{
 		*pages = rel->rd_rel->relpages;
 		*tuples = rel->rd_rel->reltuples;
 		*allvisfrac = 0;
+		if (yb_enable_tablet_row_estimates)
+			yb_estimate_rel_tuples(rel, tuples);
 		return;
 	}
 
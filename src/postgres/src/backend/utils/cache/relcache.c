@@ -445,6 +445,9 @@ AllocateRelationDesc(Form_pg_class relp)
 
 	/* YB properties will be loaded lazily */
 	relation->yb_table_properties = NULL;
+	relation->yb_pkattr_loaded = false;
+	relation->yb_pkattr = NULL;
+	relation->yb_full_pkattr = NULL;
 
 	/*
 	 * Copy the relation tuple form
@@ -3242,6 +3245,8 @@ RelationDestroyRelation(Relation relation, bool remember_tupdesc)
 	bms_free(relation->rd_pkattr);
 	bms_free(relation->rd_idattr);
 	bms_free(relation->rd_projidx);
+	bms_free(relation->yb_pkattr);
+	bms_free(relation->yb_full_pkattr);
 	if (relation->rd_pubactions)
 		pfree(relation->rd_pubactions);
 	if (relation->rd_options)
@@ -6745,6 +6750,9 @@ load_relcache_init_file(bool shared)
 		rel->rd_idattr = NULL;
 		rel->rd_projidx = NULL;
 		rel->rd_pubactions = NULL;
+		rel->yb_pkattr_loaded = false;
+		rel->yb_pkattr = NULL;
+		rel->yb_full_pkattr = NULL;
 		rel->rd_statvalid = false;
 		rel->rd_statlist = NIL;
 		rel->rd_createSubid = InvalidSubTransactionId;
@@ -2080,6 +2080,16 @@ static struct config_bool ConfigureNamesBool[] =
 		NULL, NULL, NULL
 
 	},
+	{
+		{"yb_enable_tablet_row_estimates", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Use the number of rows estimated by tablets instead of "
+						 "the pg_class estimate from the last ANALYZE."),
+			NULL
+		},
+		&yb_enable_tablet_row_estimates,
+		false,
+		NULL, NULL, NULL
+	},
 	{
 		{"yb_enable_expression_pushdown", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Push supported expressions down to DocDB for evaluation."),
@@ -269,18 +269,45 @@ static Bitmapset *GetTablePrimaryKeyBms(Relation rel,
 	return pkey;
 }
 
+/*
+ * Primary key columns are looked up for every inserted row, so they are cached
+ * in the relcache entry.
+ */
+static void YbLoadTablePrimaryKeyBms(Relation rel)
+{
+	if (rel->yb_pkattr_loaded)
+		return;
+
+	Bitmapset *pkey = GetTablePrimaryKeyBms(
+		rel,
+		YBGetFirstLowInvalidAttributeNumber(rel) /* minattr */,
+		false /* includeYBSystemColumns */);
+	Bitmapset *full_pkey = GetTablePrimaryKeyBms(
+		rel,
+		YBSystemFirstLowInvalidAttributeNumber + 1 /* minattr */,
+		true /* includeYBSystemColumns */);
+
+	/* Relcache entry data must live in CacheMemoryContext */
+	MemoryContext oldcxt = MemoryContextSwitchTo(CacheMemoryContext);
+	rel->yb_pkattr = bms_copy(pkey);
+	rel->yb_full_pkattr = bms_copy(full_pkey);
+	MemoryContextSwitchTo(oldcxt);
+	rel->yb_pkattr_loaded = true;
+
+	bms_free(pkey);
+	bms_free(full_pkey);
+}
+
 Bitmapset *YBGetTablePrimaryKeyBms(Relation rel)
 {
-	return GetTablePrimaryKeyBms(rel,
-	                             YBGetFirstLowInvalidAttributeNumber(rel) /* minattr */,
-	                             false /* includeYBSystemColumns */);
+	YbLoadTablePrimaryKeyBms(rel);
+	return bms_copy(rel->yb_pkattr);
 }
 
 Bitmapset *YBGetTableFullPrimaryKeyBms(Relation rel)
 {
-	return GetTablePrimaryKeyBms(rel,
-	                             YBSystemFirstLowInvalidAttributeNumber + 1 /* minattr */,
-	                             true /* includeYBSystemColumns */);
+	YbLoadTablePrimaryKeyBms(rel);
+	return bms_copy(rel->yb_full_pkattr);
 }
 
 extern bool YBRelHasOldRowTriggers(Relation rel, CmdType operation)
@@ -958,6 +985,7 @@ bool yb_enable_create_with_table_oid = false;
 int yb_index_state_flags_update_delay = 1000;
 bool yb_enable_expression_pushdown = true;
 bool yb_enable_optimizer_statistics = false;
+bool yb_enable_tablet_row_estimates = false;
 bool yb_make_next_ddl_statement_nonbreaking = false;
 bool yb_plpgsql_disable_prefetch_in_for_query = false;
 
@@ -2898,14 +2926,23 @@ void YBCheckServerAccessIsAllowed() {
 }
 
 void YbUpdateReadRpcStats(YBCPgStatement handle,
-						  YbPgRpcStats *reads, YbPgRpcStats *tbl_reads) {
+						  YbPgRpcStats *reads, YbPgRpcStats *tbl_reads,
+						  YbPgDocDBStats *docdb_stats) {
 	uint64_t read_count = 0, read_wait = 0, tbl_read_count = 0, tbl_read_wait = 0;
+	YBCPgDocDBStats stats = {0};
 	YBCGetAndResetReadRpcStats(handle, &read_count, &read_wait,
 							   &tbl_read_count, &tbl_read_wait);
 	reads->count += read_count;
 	reads->wait_time += read_wait;
 	tbl_reads->count += tbl_read_count;
 	tbl_reads->wait_time += tbl_read_wait;
+
+	YBCGetAndResetDocDBStats(handle, &stats);
+	docdb_stats->seeks += stats.seeks;
+	docdb_stats->keys_skipped += stats.keys_skipped;
+	docdb_stats->block_cache_hits += stats.block_cache_hits;
+	docdb_stats->block_cache_misses += stats.block_cache_misses;
+	docdb_stats->block_read_bytes += stats.block_read_bytes;
 }
 
 void YbSetCatalogCacheVersion(YBCPgStatement handle, uint64_t version)
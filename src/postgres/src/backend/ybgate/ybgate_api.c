@@ -152,13 +152,115 @@ struct YbgExprContextData
 };
 
 /*
- * Evaluate an expression against an expression context.
+ * Prepared expressions are compiled once into a flat program of steps, so
+ * the per row evaluation does not walk the node tree, resolve function info
+ * or allocate memory. It works similarly to the PG ExprState, but does not
+ * depend on syscaches and other executor infrastructure.
+ * Every step stores its result into the resvalue/resnull locations, which
+ * either belong to the parent step (like function call arguments) or hold
+ * the overall result.
+ */
+typedef enum YbgExprStepKind
+{
+	YBG_STEP_CONST,
+	YBG_STEP_VAR,
+	YBG_STEP_FUNC,
+	YBG_STEP_NULLTEST,
+	YBG_STEP_NOT,
+	/* Resets the null flag of an AND/OR expression. */
+	YBG_STEP_BOOL_START,
+	/* Checks the result of a boolean argument, may jump to the end. */
+	YBG_STEP_AND,
+	YBG_STEP_OR,
+	/* Sets the boolean result after all the arguments have been checked. */
+	YBG_STEP_AND_END,
+	YBG_STEP_OR_END,
+	/* Checks the WHEN condition, jumps to the next WHEN if not true. */
+	YBG_STEP_CASE_WHEN,
+	YBG_STEP_JUMP,
+} YbgExprStepKind;
+
+typedef struct YbgExprStep
+{
+	YbgExprStepKind kind;
+	Datum	   *resvalue;
+	bool	   *resnull;
+	union
+	{
+		struct
+		{
+			Datum		value;
+			bool		isnull;
+		}			constval;
+		struct
+		{
+			int32_t		att_idx;
+		}			var;
+		struct
+		{
+			FunctionCallInfo fcinfo;
+			bool		strict;
+		}			func;
+		struct
+		{
+			bool	   *argnull;
+			NullTestType nulltesttype;
+		}			nulltest;
+		struct
+		{
+			bool	   *anynull;
+			int			jumpdone;
+		}			boolexpr;
+		struct
+		{
+			Datum	   *condvalue;
+			bool	   *condnull;
+			int			jumpnext;
+		}			casewhen;
+		struct
+		{
+			int			jumpto;
+		}			jump;
+	}			d;
+} YbgExprStep;
+
+struct YbgPreparedExprData
+{
+	/* Source expression, used to determine the result type info. */
+	Expr	   *expr;
+	YbgExprStep *steps;
+	int			nsteps;
+	int			maxsteps;
+	Datum		resvalue;
+	bool		resnull;
+};
+
+static int addStep(YbgPreparedExpr pexpr, YbgExprStepKind kind,
+				   Datum *resvalue, bool *resnull)
+{
+	if (pexpr->nsteps == pexpr->maxsteps)
+	{
+		pexpr->maxsteps *= 2;
+		pexpr->steps = repalloc(pexpr->steps,
+								sizeof(YbgExprStep) * pexpr->maxsteps);
+	}
+	YbgExprStep *step = &pexpr->steps[pexpr->nsteps];
+	memset(step, 0, sizeof(YbgExprStep));
+	step->kind = kind;
+	step->resvalue = resvalue;
+	step->resnull = resnull;
+	return pexpr->nsteps++;
+}
+
+/*
+ * Append steps evaluating the expression and storing result into resvalue and
+ * resnull.
  * Currently assumes the expression has been checked by the planner to only
  * allow immutable functions and the node types handled below.
  * TODO: this should use the general YSQL/PG expression evaluation framework, but
  * that requires syscaches and other dependencies to be fully initialized.
  */
-static Datum evalExpr(YbgExprContext ctx, Expr* expr, bool *is_null)
+static void compileExpr(YbgPreparedExpr pexpr, Expr *expr, Datum *resvalue, bool *resnull)
 {
 	switch (expr->type)
 	{
@@ -186,103 +288,100 @@ static Datum evalExpr(YbgExprContext ctx, Expr* expr, bool *is_null)
 				inputcollid = op_expr->inputcollid;
 			}
 
+			/*
+			 * Function info and call info are resolved once and live as long as
+			 * the prepared expression, so the function may also keep its cache
+			 * in fn_extra between the rows.
+			 */
 			FmgrInfo *flinfo = palloc0(sizeof(FmgrInfo));
-			FunctionCallInfoData fcinfo;
+			FunctionCallInfo fcinfo = palloc0(sizeof(FunctionCallInfoData));
 
 			fmgr_info(funcid, flinfo);
-			InitFunctionCallInfoData(fcinfo,
+			InitFunctionCallInfoData(*fcinfo,
 									 flinfo,
 									 list_length(args),
 									 inputcollid,
 									 NULL,
 									 NULL);
+			/* Arguments are evaluated directly into the call info. */
 			int i = 0;
 			foreach(lc, args)
 			{
 				Expr *arg = (Expr *) lfirst(lc);
-				fcinfo.arg[i] = evalExpr(ctx, arg, &fcinfo.argnull[i]);
-				/*
-				 * Strict functions are guaranteed to return NULL if any of
-				 * their arguments are NULL.
-				 */
-				if (flinfo->fn_strict && fcinfo.argnull[i]) {
-					*is_null = true;
-					return (Datum) 0;
-				}
+				compileExpr(pexpr, arg, &fcinfo->arg[i], &fcinfo->argnull[i]);
 				i++;
 			}
-			Datum result = FunctionCallInvoke(&fcinfo);
-			*is_null = fcinfo.isnull;
-			return result;
+			int step = addStep(pexpr, YBG_STEP_FUNC, resvalue, resnull);
+			pexpr->steps[step].d.func.fcinfo = fcinfo;
+			pexpr->steps[step].d.func.strict = flinfo->fn_strict;
+			return;
 		}
 		case T_RelabelType:
 		{
 			RelabelType *rt = castNode(RelabelType, expr);
-			return evalExpr(ctx, rt->arg, is_null);
+			compileExpr(pexpr, rt->arg, resvalue, resnull);
+			return;
 		}
 		case T_NullTest:
 		{
 			NullTest   *nt = castNode(NullTest, expr);
-			bool		arg_is_null;
-			evalExpr(ctx, nt->arg, &arg_is_null);
-			*is_null = false;
-			return (Datum) (nt->nulltesttype == IS_NULL) == arg_is_null;
+			Datum	   *argvalue = palloc(sizeof(Datum));
+			bool	   *argnull = palloc(sizeof(bool));
+			compileExpr(pexpr, nt->arg, argvalue, argnull);
+			int step = addStep(pexpr, YBG_STEP_NULLTEST, resvalue, resnull);
+			pexpr->steps[step].d.nulltest.argnull = argnull;
+			pexpr->steps[step].d.nulltest.nulltesttype = nt->nulltesttype;
+			return;
 		}
 		case T_BoolExpr:
 		{
 			BoolExpr   *be = castNode(BoolExpr, expr);
 			ListCell   *lc;
-			Expr	   *arg;
-			Datum		arg_value;
-			bool		arg_is_null;
+			YbgExprStepKind check_kind;
+			YbgExprStepKind end_kind;
 			switch (be->boolop)
 			{
 				case AND_EXPR:
-					*is_null = false;
-					foreach(lc, be->args)
-					{
-						arg = (Expr *) lfirst(lc);
-						arg_value = evalExpr(ctx, arg, &arg_is_null);
-						if (arg_is_null)
-						{
-							*is_null = true;
-						}
-						else if (!arg_value)
-						{
-							*is_null = false;
-							return (Datum) false;
-						}
-					}
-					return *is_null ? (Datum) 0 : (Datum) true;
+					check_kind = YBG_STEP_AND;
+					end_kind = YBG_STEP_AND_END;
+					break;
 				case OR_EXPR:
-					*is_null = false;
-					foreach(lc, be->args)
-					{
-						arg = (Expr *) lfirst(lc);
-						arg_value = evalExpr(ctx, arg, &arg_is_null);
-						if (arg_is_null)
-						{
-							*is_null = true;
-						}
-						else if (arg_value)
-						{
-							*is_null = false;
-							return (Datum) true;
-						}
-					}
-					return *is_null ? (Datum) 0 : (Datum) false;
+					check_kind = YBG_STEP_OR;
+					end_kind = YBG_STEP_OR_END;
+					break;
 				case NOT_EXPR:
-					arg = (Expr *) linitial(be->args);
-					arg_value = evalExpr(ctx, arg, is_null);
-					return *is_null ? (Datum) 0 : (Datum) (!arg_value);
+					compileExpr(pexpr, (Expr *) linitial(be->args), resvalue, resnull);
+					addStep(pexpr, YBG_STEP_NOT, resvalue, resnull);
+					return;
 				default:
 					/* Planner should ensure we never get here. */
 					ereport(ERROR,
 						(errcode(ERRCODE_INTERNAL_ERROR), errmsg(
 						"Unsupported boolop received by DocDB")));
-					break;
+					return;
 			}
-			return true;
+			/*
+			 * Each argument is evaluated into the result and checked right
+			 * away, the first argument that determines the result jumps past
+			 * the end step.
+			 */
+			bool	   *anynull = palloc(sizeof(bool));
+			List	   *checks = NIL;
+			int start = addStep(pexpr, YBG_STEP_BOOL_START, resvalue, resnull);
+			pexpr->steps[start].d.boolexpr.anynull = anynull;
+			foreach(lc, be->args)
+			{
+				compileExpr(pexpr, (Expr *) lfirst(lc), resvalue, resnull);
+				int step = addStep(pexpr, check_kind, resvalue, resnull);
+				pexpr->steps[step].d.boolexpr.anynull = anynull;
+				checks = lappend_int(checks, step);
+			}
+			int end = addStep(pexpr, end_kind, resvalue, resnull);
+			pexpr->steps[end].d.boolexpr.anynull = anynull;
+			foreach(lc, checks)
+				pexpr->steps[lfirst_int(lc)].d.boolexpr.jumpdone = end + 1;
+			list_free(checks);
+			return;
 		}
 		case T_CaseExpr:
 		{
@@ -298,34 +397,53 @@ static Datum evalExpr(YbgExprContext ctx, Expr* expr, bool *is_null)
 					"Unsupported CASE expression received by DocDB")));
 			/*
 			 * Evaluate WHEN clause expressions one by one, if any evaluation
-			 * result is true, evaluate and return respective result expression
+			 * result is true, evaluate respective result expression and jump
+			 * to the end.
 			 */
+			Datum	   *condvalue = palloc(sizeof(Datum));
+			bool	   *condnull = palloc(sizeof(bool));
+			List	   *jumps = NIL;
 			foreach(lc, ce->args)
 			{
 				CaseWhen *cw = castNode(CaseWhen, lfirst(lc));
-				bool arg_is_null;
-				if (evalExpr(ctx, cw->expr, &arg_is_null))
-					return evalExpr(ctx, cw->result, is_null);
+				compileExpr(pexpr, cw->expr, condvalue, condnull);
+				int when = addStep(pexpr, YBG_STEP_CASE_WHEN, resvalue, resnull);
+				pexpr->steps[when].d.casewhen.condvalue = condvalue;
+				pexpr->steps[when].d.casewhen.condnull = condnull;
+				compileExpr(pexpr, cw->result, resvalue, resnull);
+				jumps = lappend_int(jumps, addStep(pexpr, YBG_STEP_JUMP, resvalue, resnull));
+				pexpr->steps[when].d.casewhen.jumpnext = pexpr->nsteps;
 			}
 			/* None of the exprerssions was true, so evaluate the default. */
 			if (ce->defresult)
-				return evalExpr(ctx, ce->defresult, is_null);
-			/* If default is not specified, return NULL */
-			*is_null = true;
-			return (Datum) 0;
+				compileExpr(pexpr, ce->defresult, resvalue, resnull);
+			else
+			{
+				/* If default is not specified, return NULL */
+				int step = addStep(pexpr, YBG_STEP_CONST, resvalue, resnull);
+				pexpr->steps[step].d.constval.value = (Datum) 0;
+				pexpr->steps[step].d.constval.isnull = true;
+			}
+			foreach(lc, jumps)
+				pexpr->steps[lfirst_int(lc)].d.jump.jumpto = pexpr->nsteps;
+			list_free(jumps);
+			return;
 		}
 		case T_Const:
 		{
 			Const* const_expr = castNode(Const, expr);
-			*is_null = const_expr->constisnull;
-			return const_expr->constvalue;
+			int step = addStep(pexpr, YBG_STEP_CONST, resvalue, resnull);
+			pexpr->steps[step].d.constval.value = const_expr->constvalue;
+			pexpr->steps[step].d.constval.isnull = const_expr->constisnull;
+			return;
 		}
 		case T_Var:
 		{
 			Var* var_expr = castNode(Var, expr);
-			int32_t att_idx = var_expr->varattno - ctx->min_attno;
-			*is_null = bms_is_member(att_idx, ctx->attr_nulls);
-			return ctx->attr_vals[att_idx];
+			int step = addStep(pexpr, YBG_STEP_VAR, resvalue, resnull);
+			/* Index is resolved against the context's min_attno at evaluation. */
+			pexpr->steps[step].d.var.att_idx = var_expr->varattno;
+			return;
 		}
 		default:
 			/* Planner should ensure we never get here. */
@@ -334,8 +452,110 @@ static Datum evalExpr(YbgExprContext ctx, Expr* expr, bool *is_null)
 				"Unsupported YSQL expression received by DocDB")));
 			break;
 	}
-	*is_null = true;
-	return (Datum) 0;
+}
+
+/*
+ * Evaluate a prepared expression against an expression context.
+ */
+static Datum evalExpr(YbgExprContext ctx, YbgPreparedExpr pexpr, bool *is_null)
+{
+	YbgExprStep *steps = pexpr->steps;
+	int			nsteps = pexpr->nsteps;
+	int			i = 0;
+	while (i < nsteps)
+	{
+		YbgExprStep *step = &steps[i++];
+		switch (step->kind)
+		{
+			case YBG_STEP_CONST:
+				*step->resvalue = step->d.constval.value;
+				*step->resnull = step->d.constval.isnull;
+				break;
+			case YBG_STEP_VAR:
+			{
+				int32_t att_idx = step->d.var.att_idx - ctx->min_attno;
+				*step->resnull = bms_is_member(att_idx, ctx->attr_nulls);
+				*step->resvalue = ctx->attr_vals[att_idx];
+				break;
+			}
+			case YBG_STEP_FUNC:
+			{
+				FunctionCallInfo fcinfo = step->d.func.fcinfo;
+				/*
+				 * Strict functions are guaranteed to return NULL if any of
+				 * their arguments are NULL.
+				 */
+				if (step->d.func.strict)
+				{
+					int argno;
+					for (argno = 0; argno < fcinfo->nargs; argno++)
+						if (fcinfo->argnull[argno])
+							break;
+					if (argno < fcinfo->nargs)
+					{
+						*step->resvalue = (Datum) 0;
+						*step->resnull = true;
+						break;
+					}
+				}
+				fcinfo->isnull = false;
+				*step->resvalue = FunctionCallInvoke(fcinfo);
+				*step->resnull = fcinfo->isnull;
+				break;
+			}
+			case YBG_STEP_NULLTEST:
+				*step->resvalue = (Datum) (step->d.nulltest.nulltesttype == IS_NULL) ==
+								  *step->d.nulltest.argnull;
+				*step->resnull = false;
+				break;
+			case YBG_STEP_NOT:
+				if (!*step->resnull)
+					*step->resvalue = (Datum) (!*step->resvalue);
+				else
+					*step->resvalue = (Datum) 0;
+				break;
+			case YBG_STEP_BOOL_START:
+				*step->d.boolexpr.anynull = false;
+				break;
+			case YBG_STEP_AND:
+			case YBG_STEP_OR:
+			{
+				bool value_determines = step->kind == YBG_STEP_OR;
+				if (*step->resnull)
+					*step->d.boolexpr.anynull = true;
+				else if (DatumGetBool(*step->resvalue) == value_determines)
+				{
+					*step->resvalue = BoolGetDatum(value_determines);
+					*step->resnull = false;
+					i = step->d.boolexpr.jumpdone;
+				}
+				break;
+			}
+			case YBG_STEP_AND_END:
+			case YBG_STEP_OR_END:
+				if (*step->d.boolexpr.anynull)
+				{
+					*step->resvalue = (Datum) 0;
+					*step->resnull = true;
+				}
+				else
+				{
+					*step->resvalue = BoolGetDatum(step->kind == YBG_STEP_AND_END);
+					*step->resnull = false;
+				}
+				break;
+			case YBG_STEP_CASE_WHEN:
+				if (*step->d.casewhen.condnull ||
+					!DatumGetBool(*step->d.casewhen.condvalue))
+					i = step->d.casewhen.jumpnext;
+				break;
+			case YBG_STEP_JUMP:
+				i = step->d.jump.jumpto;
+				break;
+		}
+	}
+	*is_null = pexpr->resnull;
+	return pexpr->resvalue;
 }
 
 YbgStatus YbgExprContextCreate(int32_t min_attno, int32_t max_attno, YbgExprContext *expr_ctx)
@@ -386,28 +606,33 @@ YbgStatus YbgExprContextAddColValue(YbgExprContext expr_ctx,
 YbgStatus YbgPrepareExpr(char* expr_cstring, YbgPreparedExpr *expr)
 {
 	PG_SETUP_ERROR_REPORTING();
-	*expr = (YbgPreparedExpr) stringToNode(expr_cstring);
+	YbgPreparedExpr pexpr = palloc0(sizeof(struct YbgPreparedExprData));
+	pexpr->expr = (Expr *) stringToNode(expr_cstring);
+	pexpr->maxsteps = 16;
+	pexpr->steps = palloc(sizeof(YbgExprStep) * pexpr->maxsteps);
+	compileExpr(pexpr, pexpr->expr, &pexpr->resvalue, &pexpr->resnull);
+	*expr = pexpr;
 	return PG_STATUS_OK;
 }
 
 YbgStatus YbgExprType(const YbgPreparedExpr expr, int32_t *typid)
 {
 	PG_SETUP_ERROR_REPORTING();
-	*typid = exprType((Node *) expr);
+	*typid = exprType((Node *) expr->expr);
 	return PG_STATUS_OK;
 }
 
 YbgStatus YbgExprTypmod(const YbgPreparedExpr expr, int32_t *typmod)
 {
 	PG_SETUP_ERROR_REPORTING();
-	*typmod = exprTypmod((Node *) expr);
+	*typmod = exprTypmod((Node *) expr->expr);
 	return PG_STATUS_OK;
 }
 
 YbgStatus YbgExprCollation(const YbgPreparedExpr expr, int32_t *collid)
 {
 	PG_SETUP_ERROR_REPORTING();
-	*collid = exprCollation((Node *) expr);
+	*collid = exprCollation((Node *) expr->expr);
 	return PG_STATUS_OK;
 }
 
@@ -49,6 +49,17 @@ typedef struct YbPgRpcStats {
 	double	wait_time;		/* RPC wait time (ns) */
 } YbPgRpcStats;
 
+/*
+ * YugabyteDB DocDB execution statistics
+ */
+typedef struct YbPgDocDBStats {
+	double	seeks;				/* # of RocksDB iterator seeks */
+	double	keys_skipped;		/* # of obsolete internal keys skipped */
+	double	block_cache_hits;	/* # of block cache hits */
+	double	block_cache_misses;	/* # of blocks read from SST files */
+	double	block_read_bytes;	/* bytes read from SST files */
+} YbPgDocDBStats;
+
 typedef struct Instrumentation
 {
 	/* Parameters set at node creation: */
@@ -63,6 +74,7 @@ typedef struct Instrumentation
 	BufferUsage bufusage_start; /* Buffer usage at start */
 	YbPgRpcStats yb_read_rpcs;	/* Index read RPC stats */
 	YbPgRpcStats yb_tbl_read_rpcs;	/* Table row fetch RPC stats */
+	YbPgDocDBStats yb_docdb_stats;	/* DocDB stats of index and table reads */
 	/* Accumulated statistics across all completed cycles: */
 	double		startup;		/* Total startup time (in seconds) */
 	double		total;			/* Total total time (in seconds) */
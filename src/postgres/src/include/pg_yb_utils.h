@@ -427,6 +427,13 @@ extern bool yb_enable_expression_pushdown;
  */
 extern bool yb_enable_optimizer_statistics;
 
+/*
+ * YSQL guc variable that is used to enable the use of table row count
+ * estimates, that are maintained by tablets between ANALYZE runs.
+ * e.g. 'SET yb_enable_tablet_row_estimates = true'
+ */
+extern bool yb_enable_tablet_row_estimates;
+
 /*
  * Enables nonbreaking DDL mode in which a DDL statement is not considered as
  * a "breaking catalog change" and therefore will not cause running transactions
@@ -672,7 +679,8 @@ extern void assign_yb_xcluster_consistency_level(const char *newval,
  * Update read RPC statistics for EXPLAIN ANALYZE.
  */
 void YbUpdateReadRpcStats(YBCPgStatement handle,
-						  YbPgRpcStats *reads, YbPgRpcStats *tbl_reads);
+						  YbPgRpcStats *reads, YbPgRpcStats *tbl_reads,
+						  YbPgDocDBStats *docdb_stats);
 
 /*
  * If the tserver gflag --ysql_disable_server_file_access is set to
@@ -192,6 +192,14 @@ typedef struct RelationData
 	struct PgStat_TableStatus *pgstat_info; /* statistics collection area */
 
 	YbTableProperties yb_table_properties; /* NULL if not loaded */
+
+	/*
+	 * YB primary key columns, as returned by YBGetTablePrimaryKeyBms and
+	 * YBGetTableFullPrimaryKeyBms. Valid only if yb_pkattr_loaded is set.
+	 */
+	bool		yb_pkattr_loaded;
+	Bitmapset  *yb_pkattr;
+	Bitmapset  *yb_full_pkattr;
 } RelationData;
 
 
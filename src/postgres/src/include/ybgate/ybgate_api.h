@@ -166,7 +166,7 @@ typedef void* YbgExprContext;
 typedef void* YbgPreparedExpr;
 #else
 typedef struct YbgExprContextData* YbgExprContext;
-typedef struct Expr* YbgPreparedExpr;
+typedef struct YbgPreparedExprData* YbgPreparedExpr;
 #endif
 
 /*
@@ -182,6 +182,10 @@ YbgStatus YbgExprContextReset(YbgExprContext expr_ctx);
  */
 YbgStatus YbgExprContextAddColValue(YbgExprContext expr_ctx, int32_t attno, uint64_t datum, bool is_null);
 
+/*
+ * Deserialize an expression and compile it for repeated evaluation.
+ * The prepared expression is allocated in the current memory context.
+ */
 YbgStatus YbgPrepareExpr(char* expr_cstring, YbgPreparedExpr *expr);
 
 YbgStatus YbgExprType(const YbgPreparedExpr expr, int32_t *typid);
@@ -0,0 +1,38 @@
+-- Test evaluation of expressions pushed down to DocDB
+CREATE TABLE pushdown_exprs(k int primary key, b1 bool, b2 bool, i1 int, i2 int);
+INSERT INTO pushdown_exprs VALUES
+  (1, true, true, 1, 10),
+  (2, true, false, 2, NULL),
+  (3, true, NULL, NULL, 30),
+  (4, false, true, 4, 40),
+  (5, false, false, NULL, NULL),
+  (6, false, NULL, 6, 60),
+  (7, NULL, true, 7, NULL),
+  (8, NULL, false, 8, 80),
+  (9, NULL, NULL, NULL, 90);
+EXPLAIN (COSTS OFF) SELECT k FROM pushdown_exprs WHERE b1 OR b2 ORDER BY k;
+-- AND/OR with NULLs
+SELECT k FROM pushdown_exprs WHERE (b1 AND b2) ORDER BY k;
+SELECT k FROM pushdown_exprs WHERE (b1 AND b2) IS NULL ORDER BY k;
+SELECT k FROM pushdown_exprs WHERE b1 OR b2 ORDER BY k;
+SELECT k FROM pushdown_exprs WHERE (b1 OR b2) IS NULL ORDER BY k;
+-- NOT
+SELECT k FROM pushdown_exprs WHERE NOT b1 ORDER BY k;
+SELECT k FROM pushdown_exprs WHERE (NOT b1) IS NULL ORDER BY k;
+SELECT k FROM pushdown_exprs WHERE NOT (b1 OR b2) ORDER BY k;
+SELECT k FROM pushdown_exprs WHERE NOT (b1 AND b2) ORDER BY k;
+-- CASE with ELSE
+SELECT k FROM pushdown_exprs WHERE CASE WHEN i1 > 5 THEN b1 WHEN i2 > 50 THEN b2 ELSE i1 IS NULL END ORDER BY k;
+SELECT k FROM pushdown_exprs WHERE (CASE WHEN i1 > 5 THEN b1 WHEN i2 > 50 THEN b2 ELSE i1 IS NULL END) IS NULL ORDER BY k;
+-- CASE without ELSE
+SELECT k FROM pushdown_exprs WHERE CASE WHEN b1 THEN i1 > 1 WHEN b2 THEN i2 > 1 END ORDER BY k;
+SELECT k FROM pushdown_exprs WHERE (CASE WHEN b1 THEN i1 > 1 WHEN b2 THEN i2 > 1 END) IS NULL ORDER BY k;
+-- Strict functions with NULL arguments
+SELECT k FROM pushdown_exprs WHERE i1 + i2 > 40 ORDER BY k;
+SELECT k FROM pushdown_exprs WHERE (i1 + i2) IS NULL ORDER BY k;
+SELECT k FROM pushdown_exprs WHERE int4larger(i1, i2) > 50 ORDER BY k;
+-- Nested expressions
+SELECT k FROM pushdown_exprs WHERE (i1 * 2 + i2) - (i2 / 10) * (i1 + 1) > 25 ORDER BY k;
+SELECT k FROM pushdown_exprs WHERE b1 OR (CASE WHEN i1 > 5 THEN i2 > 50 ELSE b2 END AND i2 IS NOT NULL) ORDER BY k;
+SELECT k FROM pushdown_exprs WHERE (b1 OR (CASE WHEN i1 > 5 THEN i2 > 50 ELSE b2 END AND i2 IS NOT NULL)) IS NULL ORDER BY k;
+DROP TABLE pushdown_exprs;
@@ -14,6 +14,7 @@
 #include "yb/client/async_rpc.h"
 
 #include "yb/client/batcher.h"
+#include "yb/client/client-internal.h"
 #include "yb/client/client_error.h"
 #include "yb/client/in_flight_op.h"
 #include "yb/client/meta_cache.h"
@@ -79,6 +80,10 @@ DEFINE_RUNTIME_int32(ybclient_print_trace_every_n, 0,
     "disables printing the collected traces.");
 TAG_FLAG(ybclient_print_trace_every_n, advanced);
 
+DEFINE_RUNTIME_bool(ybclient_per_table_metrics, false,
+    "Export per table histograms of tablet lookup time, time waiting for transaction prepare "
+    "and rpc time, and counter of rpc retries, through the client metric entity.");
+
 DEFINE_bool(forward_redis_requests, true, "If false, the redis op will not be served if it's not "
             "a local request. The op response will be set to the redis error "
             "'-MOVED partition_key 0.0.0.0:0'. This works with jedis which only looks at the MOVED "
@@ -95,6 +100,11 @@ DEFINE_bool(ysql_forward_rpcs_to_local_tserver, false,
 DEFINE_CAPABILITY(PickReadTimeAtTabletServer, 0x8284d67b);
 
 DECLARE_bool(collect_end_to_end_traces);
+DECLARE_uint64(consistent_prefix_read_max_staleness_ms);
+
+DEFINE_RUNTIME_bool(client_refresh_stale_partitions_in_background, true,
+    "Start refreshing table partitions as soon as the first RPC finds them stale, for example "
+    "because of tablet split, instead of waiting for the following tablet lookup.");
 
 DEFINE_test_flag(bool, asyncrpc_finished_set_timedout, false,
                  "Whether to reset asyncrpc response status to Timedout.");
@@ -141,8 +151,35 @@ void FillRequestIds(const RetryableRequestId request_id,
 
 } // namespace
 
+TableRpcMetrics::TableRpcMetrics(
+    const scoped_refptr<MetricEntity>& metric_entity, const YBTable& table) {
+  auto histogram = [&metric_entity, &table](const char* phase) {
+    auto name = Format(
+        "yb_client_$0_$1_$2_time", table.name().namespace_name(), table.name().table_name(),
+        phase);
+    EscapeMetricNameForPrometheus(&name);
+    auto description = Format("Microseconds spent in $0 by rpcs to $1", phase, table.name());
+    return metric_entity->FindOrCreateHistogram(std::make_unique<OwningHistogramPrototype>(
+        metric_entity->prototype().name(), name, description, MetricUnit::kMicroseconds,
+        description, MetricLevel::kInfo, 0 /* flags */, 60000000 /* max_trackable_value */,
+        2 /* num_sig_digits */));
+  };
+  lookup_time = histogram("lookup");
+  queue_time = histogram("queue");
+  rpc_time = histogram("rpc");
+
+  auto name = Format(
+      "yb_client_$0_$1_rpc_retries", table.name().namespace_name(), table.name().table_name());
+  EscapeMetricNameForPrometheus(&name);
+  auto description = Format("Number of rpc retries to $0", table.name());
+  retries = metric_entity->FindOrCreateCounter(std::make_unique<OwningCounterPrototype>(
+      metric_entity->prototype().name(), name, description, MetricUnit::kRequests, description,
+      MetricLevel::kInfo));
+}
+
 AsyncRpcMetrics::AsyncRpcMetrics(const scoped_refptr<yb::MetricEntity>& entity)
-    : remote_write_rpc_time(METRIC_handler_latency_yb_client_write_remote.Instantiate(entity)),
+    : metric_entity(entity),
+      remote_write_rpc_time(METRIC_handler_latency_yb_client_write_remote.Instantiate(entity)),
       remote_read_rpc_time(METRIC_handler_latency_yb_client_read_remote.Instantiate(entity)),
       local_write_rpc_time(METRIC_handler_latency_yb_client_write_local.Instantiate(entity)),
       local_read_rpc_time(METRIC_handler_latency_yb_client_read_local.Instantiate(entity)),
@@ -152,6 +189,18 @@ AsyncRpcMetrics::AsyncRpcMetrics(const scoped_refptr<yb::MetricEntity>& entity)
       consistent_prefix_failed_reads(METRIC_consistent_prefix_failed_reads.Instantiate(entity)) {
 }
 
+std::shared_ptr<TableRpcMetrics> AsyncRpcMetrics::TableMetrics(const YBTable& table) {
+  if (!GetAtomicFlag(&FLAGS_ybclient_per_table_metrics)) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(table_metrics_mutex);
+  auto& result = table_metrics[table.id()];
+  if (!result) {
+    result = std::make_shared<TableRpcMetrics>(metric_entity, table);
+  }
+  return result;
+}
+
 AsyncRpc::AsyncRpc(
     const AsyncRpcData& data, YBConsistencyLevel yb_consistency_level)
     : Rpc(data.batcher->deadline(), data.batcher->messenger(), &data.batcher->proxy_cache()),
@@ -170,6 +219,15 @@ AsyncRpc::AsyncRpc(
       async_rpc_metrics_(data.batcher->async_rpc_metrics()) {
   mutable_retrier()->mutable_controller()->set_allow_local_calls_in_curr_thread(
       data.allow_local_calls_in_curr_thread);
+  if (async_rpc_metrics_ && !table()->name().is_system()) {
+    table_rpc_metrics_ = async_rpc_metrics_->TableMetrics(*table());
+  }
+  if (table_rpc_metrics_) {
+    table_rpc_metrics_->lookup_time->Increment(
+        ToMicroseconds(batcher_->lookups_done_time() - batcher_->flush_start_time()));
+    table_rpc_metrics_->queue_time->Increment(
+        ToMicroseconds(start_ - batcher_->lookups_done_time()));
+  }
 }
 
 AsyncRpc::~AsyncRpc() {
@@ -237,11 +295,21 @@ void AsyncRpc::Finished(const Status& status) {
   if (tablet_invoker_.Done(&new_status)) {
     if (tablet().is_split() ||
         ClientError(new_status) == ClientErrorCode::kTablePartitionListIsStale) {
-      ops_[0].yb_op->MarkTablePartitionListAsStale();
+      if (ops_[0].yb_op->MarkTablePartitionListAsStale() &&
+          GetAtomicFlag(&FLAGS_client_refresh_stale_partitions_in_background)) {
+        // The first RPC that found partitions stale starts refreshing them, so retries of this
+        // and other operations of the table are likely to find partitions already up to date.
+        tablet_invoker_.client().data_->meta_cache_->RefreshTablePartitionsInBackground(
+            ops_[0].yb_op->mutable_table());
+      }
     }
     if (async_rpc_metrics_ && status.ok() && tablet_invoker_.is_consistent_prefix()) {
       IncrementCounter(async_rpc_metrics_->consistent_prefix_successful_reads);
     }
+    if (table_rpc_metrics_) {
+      table_rpc_metrics_->rpc_time->Increment(ToMicroseconds(CoarseMonoClock::Now() - start_));
+      table_rpc_metrics_->retries->IncrementBy(num_attempts() - 1);
+    }
     ProcessResponseFromTserver(new_status);
     batcher_->Flushed(ops_, new_status, MakeFlushExtraResult());
     retained_self_.reset();
@@ -670,6 +738,12 @@ ReadRpc::ReadRpc(const AsyncRpcData& data, YBConsistencyLevel yb_consistency_lev
   VTRACE_TO(1, trace_, "Tablet $0 table $1", data.tablet->tablet_id(), table()->name().ToString());
   req_.set_consistency_level(yb_consistency_level);
   req_.set_proxy_uuid(data.batcher->proxy_uuid());
+  if (yb_consistency_level == YBConsistencyLevel::CONSISTENT_PREFIX) {
+    auto max_staleness_ms = GetAtomicFlag(&FLAGS_consistent_prefix_read_max_staleness_ms);
+    if (max_staleness_ms > 0) {
+      req_.set_max_staleness_ms(max_staleness_ms);
+    }
+  }
 
   switch (table()->table_type()) {
     case YBTableType::REDIS_TABLE_TYPE:
@@ -715,12 +789,18 @@ void ReadRpc::CallRemoteMethod() {
   TRACE_TO(trace, "SendRpcToTserver");
   ADOPT_TRACE(trace.get());
 
+  auto* controller = PrepareController();
+  tablet_invoker_.LimitAttemptDeadline(controller);
   tablet_invoker_.proxy()->ReadAsync(
-    req_, &resp_, PrepareController(), std::bind(&ReadRpc::Finished, this, Status::OK()));
+    req_, &resp_, controller, std::bind(&ReadRpc::Finished, this, Status::OK()));
   TRACE_TO(trace, "RpcDispatched Asynchronously");
 }
 
 void ReadRpc::SwapResponses() {
+  if (tablet_invoker_.is_consistent_prefix() && resp_.has_used_read_time()) {
+    // Replica picks its safe time as read time, so it shows how stale the replica is.
+    tablet_invoker_.RecordReplicaSafeTime(HybridTime(resp_.used_read_time().read_ht()));
+  }
   int redis_idx = 0;
   int ql_idx = 0;
   int pgsql_idx = 0;
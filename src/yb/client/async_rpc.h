@@ -13,6 +13,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <unordered_map>
+
 #include <boost/range/iterator_range_core.hpp>
 #include <boost/version.hpp>
 
@@ -20,9 +23,12 @@
 #include "yb/client/tablet_rpc.h"
 
 #include "yb/common/common_types.pb.h"
+#include "yb/common/entity_ids_types.h"
 #include "yb/common/read_hybrid_time.h"
 #include "yb/common/retryable_request.h"
 
+#include "yb/gutil/thread_annotations.h"
+
 #include "yb/rpc/rpc_fwd.h"
 
 #include "yb/tserver/tserver.pb.h"
@@ -42,10 +48,28 @@ struct InFlightOp;
 class RemoteTablet;
 class RemoteTabletServer;
 
+// Latency breakdown of the rpcs to a single table, see ybclient_per_table_metrics.
+struct TableRpcMetrics {
+  TableRpcMetrics(const scoped_refptr<MetricEntity>& metric_entity, const YBTable& table);
+
+  // Time from the start of batcher flush till all tablet lookups are done.
+  scoped_refptr<Histogram> lookup_time;
+  // Time from all tablet lookups are done till rpc is created, i.e. transaction prepare wait.
+  scoped_refptr<Histogram> queue_time;
+  // Time from rpc creation till it is finished, including retries.
+  scoped_refptr<Histogram> rpc_time;
+  scoped_refptr<Counter> retries;
+};
+
 // Container for async rpc metrics
 struct AsyncRpcMetrics {
   explicit AsyncRpcMetrics(const scoped_refptr<MetricEntity>& metric_entity);
 
+  // Returns metrics for the specified table, or nullptr when per table metrics are disabled.
+  std::shared_ptr<TableRpcMetrics> TableMetrics(const YBTable& table);
+
+  const scoped_refptr<MetricEntity> metric_entity;
+
   scoped_refptr<Histogram> remote_write_rpc_time;
   scoped_refptr<Histogram> remote_read_rpc_time;
   scoped_refptr<Histogram> local_write_rpc_time;
@@ -53,6 +77,10 @@ struct AsyncRpcMetrics {
   scoped_refptr<Histogram> time_to_send;
   scoped_refptr<Counter> consistent_prefix_successful_reads;
   scoped_refptr<Counter> consistent_prefix_failed_reads;
+
+  std::mutex table_metrics_mutex;
+  std::unordered_map<TableId, std::shared_ptr<TableRpcMetrics>> table_metrics
+      GUARDED_BY(table_metrics_mutex);
 };
 
 using InFlightOps = boost::iterator_range<std::vector<InFlightOp>::iterator>;
@@ -128,6 +156,7 @@ class AsyncRpc : public rpc::Rpc, public TabletRpc {
 
   CoarseTimePoint start_;
   std::shared_ptr<AsyncRpcMetrics> async_rpc_metrics_;
+  std::shared_ptr<TableRpcMetrics> table_rpc_metrics_;
   rpc::RpcCommandPtr retained_self_;
 };
 
@@ -0,0 +1,127 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+
+#include "yb/client/client_fwd.h"
+#include "yb/client/session.h"
+#include "yb/client/transaction.h"
+
+#include "yb/rpc/thread_pool.h"
+
+#include "yb/util/monotime.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace client {
+
+// C++20 awaiter, that starts asynchronous operation using its callback based API and resumes the
+// awaiting coroutine when the callback is invoked.
+// When executor is specified, the coroutine is resumed in it, otherwise it is resumed in the
+// thread that invoked the callback, that could be a reactor thread.
+// The awaiter itself is used as a thread pool task, and the callback captures only the pointer to
+// the awaiter, so the awaited path does not allocate.
+template <class Value>
+class CallbackAwaiter : public rpc::ThreadPoolTask {
+ public:
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  bool await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    Start();
+    // Operation could complete synchronously, in this case the coroutine is not suspended.
+    return !completed_.exchange(true, std::memory_order_acq_rel);
+  }
+
+  Value await_resume() {
+    return std::move(value_);
+  }
+
+ protected:
+  explicit CallbackAwaiter(rpc::ThreadPool* executor) : executor_(executor) {}
+  ~CallbackAwaiter() = default;
+
+  virtual void Start() = 0;
+
+  void Complete(Value value) {
+    value_ = std::move(value);
+    if (!completed_.exchange(true, std::memory_order_acq_rel)) {
+      // await_suspend is still in progress, it will continue the coroutine.
+      return;
+    }
+    if (executor_) {
+      // Done is invoked even when executor is shutting down.
+      executor_->Enqueue(this);
+      return;
+    }
+    handle_.resume();
+  }
+
+ private:
+  void Run() override {}
+
+  void Done(const Status& status) override {
+    // Awaiter belongs to the coroutine frame, so it should not be accessed after resume.
+    handle_.resume();
+  }
+
+  rpc::ThreadPool* const executor_;
+  std::coroutine_handle<> handle_;
+  std::atomic<bool> completed_{false};
+  Value value_;
+};
+
+// Awaits YBSession::FlushAsync, result is the flush status.
+class SessionFlushAwaiter : public CallbackAwaiter<FlushStatus> {
+ public:
+  SessionFlushAwaiter(YBSession* session, rpc::ThreadPool* executor)
+      : CallbackAwaiter(executor), session_(session) {}
+
+ private:
+  void Start() override {
+    session_->FlushAsync([this](FlushStatus* flush_status) {
+      Complete(std::move(*flush_status));
+    });
+  }
+
+  YBSession* const session_;
+};
+
+// Awaits YBTransaction::Commit, result is the commit status.
+class TransactionCommitAwaiter : public CallbackAwaiter<Status> {
+ public:
+  TransactionCommitAwaiter(
+      YBTransaction* transaction, CoarseTimePoint deadline, SealOnly seal_only,
+      rpc::ThreadPool* executor)
+      : CallbackAwaiter(executor), transaction_(transaction), deadline_(deadline),
+        seal_only_(seal_only) {}
+
+ private:
+  void Start() override {
+    transaction_->Commit(deadline_, seal_only_, [this](const Status& status) {
+      Complete(status);
+    });
+  }
+
+  YBTransaction* const transaction_;
+  const CoarseTimePoint deadline_;
+  const SealOnly seal_only_;
+};
+
+} // namespace client
+} // namespace yb
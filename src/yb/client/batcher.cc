@@ -82,6 +82,15 @@ DEFINE_test_flag(double, simulate_tablet_lookup_does_not_match_partition_key_pro
                  "Probability for simulating the error that happens when a key is not in the key "
                  "range of the resolved tablet's partition.");
 
+DEFINE_RUNTIME_uint64(batcher_max_rpc_ops, 0,
+    "Max number of operations sent to a tablet in a single RPC, larger batches are split into "
+    "multiple RPCs. Operations with the same partition key are always sent in the same RPC. "
+    "0 - no limit.");
+DEFINE_RUNTIME_uint64(batcher_max_rpc_bytes, 0,
+    "Max estimated size of the operations sent to a tablet in a single RPC, larger batches are "
+    "split into multiple RPCs. Operations with the same partition key are always sent in the "
+    "same RPC. 0 - no limit.");
+
 using std::pair;
 using std::set;
 using std::unique_ptr;
@@ -218,6 +227,7 @@ void Batcher::FlushAsync(
 
   CHECK_EQ(state_, BatcherState::kGatheringOps);
   state_ = BatcherState::kResolvingTablets;
+  flush_start_time_ = CoarseMonoClock::now();
 
   const auto operations_count = ops_.size();
   outstanding_lookups_ = operations_count;
@@ -399,6 +409,7 @@ void Batcher::AllLookupsDone() {
   auto errors = CollectOpsErrors();
 
   state_ = BatcherState::kTransactionPrepare;
+  lookups_done_time_ = CoarseMonoClock::now();
 
   VLOG_WITH_PREFIX_AND_FUNC(4)
       << "Errors: " << errors.size() << ", ops queue: " << ops_queue_.size();
@@ -463,17 +474,75 @@ void Batcher::AllLookupsDone() {
       return;
     }
     if (current_tablet != it_tablet || current_group != it_group) {
-      ops_info_.groups.emplace_back(group_start, it);
+      AddOpsGroups(group_start, it);
       group_start = it;
       current_group = it_group;
       current_tablet = it_tablet;
     }
   }
-  ops_info_.groups.emplace_back(group_start, ops_queue_.end());
+  AddOpsGroups(group_start, ops_queue_.end());
 
   ExecuteOperations(Initial::kTrue);
 }
 
+void Batcher::AddOpsGroups(
+    std::vector<InFlightOp>::iterator begin, std::vector<InFlightOp>::iterator end) {
+  const auto max_ops = GetAtomicFlag(&FLAGS_batcher_max_rpc_ops);
+  const auto max_bytes = GetAtomicFlag(&FLAGS_batcher_max_rpc_bytes);
+  const auto num_ops = static_cast<size_t>(end - begin);
+  bool fits = max_ops == 0 || num_ops <= max_ops;
+  if (fits && max_bytes != 0) {
+    size_t bytes = 0;
+    for (auto it = begin; fits && it != end; ++it) {
+      bytes += it->yb_op->request_size();
+      fits = bytes <= max_bytes;
+    }
+  }
+  if (fits) {
+    ops_info_.groups.emplace_back(begin, end);
+    return;
+  }
+
+  // Operations with the same partition key should be sent in the same RPC, to preserve their
+  // order. Stable sort keeps order of operations with the same key.
+  std::stable_sort(begin, end, [](const InFlightOp& lhs, const InFlightOp& rhs) {
+    return lhs.partition_key < rhs.partition_key;
+  });
+
+  const auto old_num_groups = ops_info_.groups.size();
+  auto chunk_begin = begin;
+  size_t chunk_ops = 0;
+  size_t chunk_bytes = 0;
+  for (auto it = begin; it != end;) {
+    const auto& partition_key = it->partition_key;
+    size_t key_ops = 0;
+    size_t key_bytes = 0;
+    auto key_end = it;
+    for (; key_end != end && key_end->partition_key == partition_key; ++key_end) {
+      ++key_ops;
+      if (max_bytes != 0) {
+        key_bytes += key_end->yb_op->request_size();
+      }
+    }
+    if (chunk_ops != 0 &&
+        ((max_ops != 0 && chunk_ops + key_ops > max_ops) ||
+         (max_bytes != 0 && chunk_bytes + key_bytes > max_bytes))) {
+      ops_info_.groups.emplace_back(chunk_begin, it);
+      chunk_begin = it;
+      chunk_ops = 0;
+      chunk_bytes = 0;
+    }
+    chunk_ops += key_ops;
+    chunk_bytes += key_bytes;
+    it = key_end;
+  }
+  ops_info_.groups.emplace_back(chunk_begin, end);
+
+  VLOG_WITH_PREFIX_AND_FUNC(3)
+      << "Split " << num_ops << " ops to " << begin->tablet->tablet_id() << " into "
+      << ops_info_.groups.size() - old_num_groups << " groups";
+}
+
 void Batcher::ExecuteOperations(Initial initial) {
   VLOG_WITH_PREFIX_AND_FUNC(3) << "initial: " << initial;
   auto transaction = this->transaction();
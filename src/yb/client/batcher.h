@@ -203,6 +203,16 @@ class Batcher : public Runnable, public std::enable_shared_from_this<Batcher> {
     return async_rpc_metrics_;
   }
 
+  // Time when tablet lookups were started by FlushAsync.
+  CoarseTimePoint flush_start_time() const {
+    return flush_start_time_;
+  }
+
+  // Time when all tablet lookups were finished.
+  CoarseTimePoint lookups_done_time() const {
+    return lookups_done_time_;
+  }
+
   ConsistentReadPoint* read_point() {
     return read_point_;
   }
@@ -264,6 +274,12 @@ class Batcher : public Runnable, public std::enable_shared_from_this<Batcher> {
 
   void FlushFinished();
   void AllLookupsDone();
+
+  // Adds groups for operations to the same tablet of the same op group.
+  // Splits them when they don't fit into batcher_max_rpc_ops or batcher_max_rpc_bytes.
+  void AddOpsGroups(
+      std::vector<InFlightOp>::iterator begin, std::vector<InFlightOp>::iterator end);
+
   std::shared_ptr<AsyncRpc> CreateRpc(
       const BatcherPtr& self, RemoteTablet* tablet, const InFlightOpsGroup& group,
       bool allow_local_calls_in_curr_thread, bool need_consistent_read);
@@ -320,6 +336,9 @@ class Batcher : public Runnable, public std::enable_shared_from_this<Batcher> {
   // The absolute deadline for all in-flight ops.
   CoarseTimePoint deadline_;
 
+  CoarseTimePoint flush_start_time_;
+  CoarseTimePoint lookups_done_time_;
+
   // Number of outstanding lookups across all in-flight ops.
   std::atomic<size_t> outstanding_lookups_{0};
   std::atomic<size_t> outstanding_rpcs_{0};
@@ -2396,7 +2396,7 @@ Result<TableSizeInfo> YBClient::Data::GetTableDiskSize(
     return StatusFromPB(resp.error().status());
   }
 
-  return TableSizeInfo{resp.size(), resp.num_missing_tablets()};
+  return TableSizeInfo{resp.size(), resp.num_missing_tablets(), resp.estimated_num_rows()};
 }
 
 Result<bool> YBClient::Data::CheckIfPitrActive(CoarseTimePoint deadline) {
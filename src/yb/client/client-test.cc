@@ -40,6 +40,7 @@
 #include <gtest/gtest.h>
 
 #include "yb/client/async_initializer.h"
+#include "yb/client/awaitable.h"
 #include "yb/client/client-internal.h"
 #include "yb/client/client-test-util.h"
 #include "yb/client/client.h"
@@ -84,6 +85,7 @@
 #include "yb/rpc/proxy.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/rpc/rpc_test_util.h"
+#include "yb/rpc/thread_pool.h"
 
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_metadata.h"
@@ -126,6 +128,8 @@ DEFINE_int32(test_scan_num_rows, 1000, "Number of rows to insert and scan");
 DECLARE_int32(min_backoff_ms_exponent);
 DECLARE_int32(max_backoff_ms_exponent);
 DECLARE_bool(TEST_force_master_lookup_all_tablets);
+DECLARE_bool(client_prefetch_table_locations);
+DECLARE_uint64(batcher_max_rpc_ops);
 DECLARE_double(TEST_simulate_lookup_timeout_probability);
 
 METRIC_DECLARE_counter(rpcs_queue_overflow);
@@ -2596,6 +2600,9 @@ TEST_F(ClientTest, ColocatedTablesLookupTablet) {
     table_names.push_back(table_name);
   }
 
+  // Tablet locations should be obtained by the single lookup RPC, not prefetched by OpenTable.
+  FLAGS_client_prefetch_table_locations = false;
+
   const auto lookup_serial_start = client::internal::TEST_GetLookupSerial();
 
   TabletId colocated_tablet_id;
@@ -2616,6 +2623,117 @@ TEST_F(ClientTest, ColocatedTablesLookupTablet) {
   ASSERT_EQ(lookup_serial_stop, lookup_serial_start + 1);
 }
 
+// Locations of all table tablets are fetched by OpenTable, so lookups should not send RPCs to
+// master.
+TEST_F(ClientTest, PrefetchTableLocations) {
+  auto client = ASSERT_RESULT(YBClientBuilder()
+      .add_master_server_addr(ToString(cluster_->mini_master()->bound_rpc_addr()))
+      .Build());
+  auto table = ASSERT_RESULT(client->OpenTable(kTableName));
+
+  const auto lookup_serial_start = client::internal::TEST_GetLookupSerial();
+  auto partitions = table->GetPartitionsCopy();
+  ASSERT_GT(partitions.size(), 1);
+  std::unordered_set<TabletId> tablet_ids;
+  for (const auto& partition_start : partitions) {
+    auto tablet = ASSERT_RESULT(client->LookupTabletByKeyFuture(
+        table, partition_start, CoarseMonoClock::now() + 10s).get());
+    tablet_ids.insert(tablet->tablet_id());
+  }
+  ASSERT_EQ(tablet_ids.size(), partitions.size());
+  ASSERT_EQ(client::internal::TEST_GetLookupSerial(), lookup_serial_start);
+}
+
+TEST_F(ClientTest, AutoFlushWithSplitBatches) {
+  constexpr int kNumRows = 25;
+  constexpr int kMaxBufferedOps = 10;
+  FLAGS_batcher_max_rpc_ops = 3;
+
+  std::atomic<int> auto_flushes{0};
+  std::atomic<int> auto_flush_errors{0};
+  auto session = CreateSession();
+  session->EnableAutoFlush(YBSession::AutoFlushOptions {
+    .max_buffered_ops = kMaxBufferedOps,
+    .max_buffered_bytes = 0,
+    .max_buffering_time = MonoDelta(),
+    .callback = [&auto_flushes, &auto_flush_errors](FlushStatus* flush_status) {
+      if (!flush_status->status.ok()) {
+        ++auto_flush_errors;
+      }
+      ++auto_flushes;
+    },
+  });
+  for (int i = 0; i != kNumRows; ++i) {
+    ApplyInsertToSession(session.get(), client_table_, i, i * 10, "row");
+  }
+  ASSERT_EQ(session->TEST_CountBufferedOperations(), kNumRows % kMaxBufferedOps);
+  FlushSessionOrDie(session);
+
+  ASSERT_OK(WaitFor([&auto_flushes] {
+    return auto_flushes.load() == kNumRows / kMaxBufferedOps;
+  }, 10s, "Auto flushes"));
+  ASSERT_EQ(auto_flush_errors.load(), 0);
+  ASSERT_EQ(CountRowsFromClient(client_table_), kNumRows);
+}
+
+namespace {
+
+// Coroutine that starts immediately and is not awaited by anybody.
+struct DetachedCoroutine {
+  struct promise_type {
+    DetachedCoroutine get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+struct AwaitResult {
+  Status status;
+  bool resumed_in_executor;
+};
+
+DetachedCoroutine FlushInCoroutine(
+    YBSession* session, rpc::ThreadPool* executor, std::promise<AwaitResult>* promise) {
+  auto flush_status = co_await session->FlushAwaitable(executor);
+  promise->set_value(AwaitResult {
+    .status = flush_status.status,
+    .resumed_in_executor = executor->OwnsThisThread(),
+  });
+}
+
+AwaitResult FlushUsingCoroutine(YBSession* session, rpc::ThreadPool* executor) {
+  std::promise<AwaitResult> promise;
+  auto future = promise.get_future();
+  FlushInCoroutine(session, executor, &promise);
+  return future.get();
+}
+
+} // namespace
+
+TEST_F(ClientTest, FlushAwaitable) {
+  rpc::ThreadPool executor(rpc::ThreadPoolOptions {
+    .name = "test_executor",
+    .queue_limit = 16,
+    .max_workers = 1,
+  });
+  auto session = CreateSession();
+
+  // Empty flush completes synchronously, so the coroutine is not suspended.
+  auto result = FlushUsingCoroutine(session.get(), &executor);
+  ASSERT_OK(result.status);
+  ASSERT_FALSE(result.resumed_in_executor);
+
+  ApplyInsertToSession(session.get(), client_table_, 1, 10, "row");
+  result = FlushUsingCoroutine(session.get(), &executor);
+  ASSERT_OK(result.status);
+  ASSERT_TRUE(result.resumed_in_executor);
+  ASSERT_EQ(CountRowsFromClient(client_table_), 1);
+
+  executor.Shutdown();
+}
+
 class ClientTestWithHashAndRangePk : public ClientTest {
  public:
   void SetUp() override {
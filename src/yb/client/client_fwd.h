@@ -66,6 +66,8 @@ class YBRedisWriteOp;
 class YBSession;
 typedef std::shared_ptr<YBSession> YBSessionPtr;
 struct FlushStatus;
+class SessionFlushAwaiter;
+class TransactionCommitAwaiter;
 using FlushCallback = boost::function<void(FlushStatus*)>;
 using CommitCallback = boost::function<void(const Status&)>;
 
@@ -34,6 +34,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <atomic>
 #include <list>
 #include <memory>
@@ -107,6 +108,10 @@ DEFINE_int64(meta_cache_lookup_throttling_step_ms, 5,
 DEFINE_int64(meta_cache_lookup_throttling_max_delay_ms, 1000,
              "Max delay between calls during lookup throttling.");
 
+DEFINE_RUNTIME_int32(replica_staleness_estimate_ttl_ms, 5000,
+    "Time since the estimation of the replica staleness, after which the estimate is not used "
+    "anymore, so lagging replica is probed again.");
+
 DEFINE_test_flag(bool, force_master_lookup_all_tablets, false,
                  "If set, force the client to go to the master for all tablet lookup "
                  "instead of reading from cache.");
@@ -302,6 +307,18 @@ std::string RemoteTabletServer::TEST_PlacementZone() const {
   return cloud_info_pb_.placement_zone();
 }
 
+void RemoteTabletServer::UpdateRtt(MonoDelta rtt) {
+  // Exponentially weighted moving average with weight 1/8, like TCP smoothed RTT.
+  auto sample_us = std::max<int64_t>(rtt.ToMicroseconds(), 1);
+  auto old_us = rtt_us_.load(std::memory_order_acquire);
+  for (;;) {
+    auto new_us = old_us == 0 ? sample_us : old_us + (sample_us - old_us) / 8;
+    if (rtt_us_.compare_exchange_weak(old_us, new_us, std::memory_order_acq_rel)) {
+      break;
+    }
+  }
+}
+
 std::string ReplicasCount::ToString() {
   return Format(
       " live replicas $0, read replicas $1, expected live replicas $2, expected read replicas $3",
@@ -610,6 +627,38 @@ void RemoteTablet::MarkTServerAsFollower(const RemoteTabletServer* server) {
                 << server->ToString() << ". Replicas: " << ReplicasAsStringUnlocked();
 }
 
+void RemoteTablet::UpdateReplicaStaleness(
+    const RemoteTabletServer* server, MonoDelta staleness) {
+  auto now = CoarseMonoClock::now();
+  std::lock_guard<rw_spinlock> lock(mutex_);
+  for (RemoteReplica& replica : replicas_) {
+    if (replica.ts == server) {
+      replica.staleness = staleness;
+      replica.staleness_time = now;
+      return;
+    }
+  }
+}
+
+std::optional<MonoDelta> RemoteTablet::ReplicaStaleness(const RemoteTabletServer* server) const {
+  auto min_time = CoarseMonoClock::now() -
+                  GetAtomicFlag(&FLAGS_replica_staleness_estimate_ttl_ms) * 1ms;
+  SharedLock<rw_spinlock> lock(mutex_);
+  for (const RemoteReplica& replica : replicas_) {
+    if (replica.ts != server) {
+      continue;
+    }
+    if (replica.role == PeerRole::LEADER) {
+      return MonoDelta::kZero;
+    }
+    if (replica.staleness_time == CoarseTimePoint() || replica.staleness_time < min_time) {
+      return std::nullopt;
+    }
+    return replica.staleness;
+  }
+  return std::nullopt;
+}
+
 std::string RemoteTablet::ReplicasAsString() const {
   SharedLock<rw_spinlock> lock(mutex_);
   return ReplicasAsStringUnlocked();
@@ -672,7 +721,8 @@ void LookupCallbackVisitor::operator()(
 MetaCache::MetaCache(YBClient* client)
   : client_(client),
     master_lookup_sem_(FLAGS_max_concurrent_master_lookups),
-    log_prefix_(Format("MetaCache($0)(client_id: $1): ", static_cast<void*>(this), client_->id())) {
+    log_prefix_(Format("MetaCache($0)(client_id: $1): ", static_cast<void*>(this), client_->id())),
+    tablets_by_partition_snapshots_(std::make_shared<TabletsByPartitionSnapshots>()) {
 }
 
 MetaCache::~MetaCache() {
@@ -949,19 +999,33 @@ Status MetaCache::ProcessTabletLocations(
     std::lock_guard<decltype(mutex_)> lock(mutex_);
     ProcessedTablesMap processed_tables;
 
+    Status status;
     for (const TabletLocationsPB& loc : locations) {
-      auto remote = VERIFY_RESULT(ProcessTabletLocation(
-          loc, &processed_tables, table_partition_list_version, lookup_rpc));
+      auto remote = ProcessTabletLocation(
+          loc, &processed_tables, table_partition_list_version, lookup_rpc);
+      if (!remote.ok()) {
+        status = remote.status();
+        break;
+      }
 
       auto it = tablet_lookups_by_id_.find(loc.tablet_id());
       if (it != tablet_lookups_by_id_.end()) {
         while (auto* lookup = it->second.lookups.Pop()) {
           to_notify.emplace_back(std::move(lookup->callback),
-                                 LookupCallbackVisitor(remote));
+                                 LookupCallbackVisitor(*remote));
           delete lookup;
         }
       }
     }
+    // Locations processed before the failure are already applied to the tables, so their
+    // snapshots should be updated anyway.
+    std::vector<TableId> processed_table_ids;
+    processed_table_ids.reserve(processed_tables.size());
+    for (const auto& [table_id, _] : processed_tables) {
+      processed_table_ids.push_back(table_id);
+    }
+    UpdateTabletsByPartitionSnapshotsUnlocked(processed_table_ids);
+    RETURN_NOT_OK(status);
     if (lookup_rpc) {
       lookup_rpc->AddCallbacksToBeNotified(processed_tables, &tables_, &to_notify);
       lookup_rpc->CleanupRequest();
@@ -1176,6 +1240,7 @@ void MetaCache::InvalidateTableCache(const YBTable& table) {
     // Only update partitions here after invalidating TableData cache to avoid inconsistencies.
     // See https://github.com/yugabyte/yugabyte-db/issues/6890.
     table_data.partition_list = table_partition_list;
+    UpdateTabletsByPartitionSnapshotsUnlocked({table_id});
   }
   for (const auto& callback : to_notify) {
     const auto s = STATUS_EC_FORMAT(
@@ -1185,6 +1250,29 @@ void MetaCache::InvalidateTableCache(const YBTable& table) {
   }
 }
 
+void MetaCache::PrefetchTableLocations(
+    const TableId& table_id, const VersionedTablePartitionListPtr& partitions,
+    const google::protobuf::RepeatedPtrField<master::TabletLocationsPB>& locations) {
+  {
+    UniqueLock<decltype(mutex_)> lock(mutex_);
+    auto it = tables_.find(table_id);
+    if (it == tables_.end()) {
+      InitTableDataUnlocked(table_id, partitions);
+    } else if (it->second.partition_list->version != partitions->version) {
+      VLOG_WITH_PREFIX_AND_FUNC(1) << Format(
+          "Skip prefetch for table $0, cached partitions version: $1, fetched: $2",
+          table_id, it->second.partition_list->version, partitions->version);
+      return;
+    }
+  }
+
+  auto status = ProcessTabletLocations(locations, partitions->version, /* lookup_rpc= */ nullptr);
+  if (!status.ok()) {
+    // Lookups would just fall back to master in this case.
+    VLOG_WITH_PREFIX_AND_FUNC(1) << "Failed to prefetch table " << table_id << ": " << status;
+  }
+}
+
 class MetaCache::CallbackNotifier {
  public:
   explicit CallbackNotifier(const Status& status) : status_(status) {}
@@ -1755,18 +1843,20 @@ void MetaCache::LookupByIdFailed(
   }
 }
 
-RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(
+RemoteTabletPtr MetaCache::LookupTabletByKeyFastPath(
     const TableId& table_id, const VersionedPartitionStartKey& versioned_partition_start_key) {
-  auto it = tables_.find(table_id);
-  if (PREDICT_FALSE(it == tables_.end())) {
+  auto snapshots = std::atomic_load_explicit(
+      &tablets_by_partition_snapshots_, std::memory_order_acquire);
+  auto it = snapshots->find(table_id);
+  if (PREDICT_FALSE(it == snapshots->end())) {
     // No cache available for this table.
     return nullptr;
   }
 
-  const auto& table_data = it->second;
+  const auto& snapshot = *it->second;
 
   if (PREDICT_FALSE(
-          table_data.partition_list->version !=
+          snapshot.partition_list_version !=
           versioned_partition_start_key.partition_list_version)) {
     // TableData::partition_list version in cache does not match partition_list_version used to
     // calculate partition_key_start, can't use cache.
@@ -1775,17 +1865,12 @@ RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(
 
   const auto& partition_start_key = *versioned_partition_start_key.key;
 
-  DCHECK_EQ(
-      partition_start_key,
-      *client::FindPartitionStart(table_data.partition_list, partition_start_key));
-  auto tablet_it = table_data.tablets_by_partition.find(partition_start_key);
-  if (PREDICT_FALSE(tablet_it == it->second.tablets_by_partition.end())) {
+  auto result = snapshot.Find(partition_start_key);
+  if (PREDICT_FALSE(!result)) {
     // No tablets with a start partition key lower than 'partition_key'.
     return nullptr;
   }
 
-  const auto& result = tablet_it->second;
-
   // Stale entries must be re-fetched.
   if (result->stale()) {
     return nullptr;
@@ -1800,6 +1885,33 @@ RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(
   return nullptr;
 }
 
+void MetaCache::UpdateTabletsByPartitionSnapshotsUnlocked(
+    const std::vector<TableId>& table_ids) {
+  std::shared_ptr<TabletsByPartitionSnapshots> new_snapshots;
+  for (const auto& table_id : table_ids) {
+    auto it = tables_.find(table_id);
+    if (it == tables_.end()) {
+      continue;
+    }
+    if (!new_snapshots) {
+      new_snapshots = std::make_shared<TabletsByPartitionSnapshots>(
+          *tablets_by_partition_snapshots_);
+    }
+    const auto& table_data = it->second;
+    auto snapshot = std::make_shared<TabletsByPartitionSnapshot>();
+    snapshot->partition_list_version = table_data.partition_list->version;
+    snapshot->tablets.assign(
+        table_data.tablets_by_partition.begin(), table_data.tablets_by_partition.end());
+    (*new_snapshots)[table_id] = std::move(snapshot);
+  }
+  if (new_snapshots) {
+    std::atomic_store_explicit(
+        &tablets_by_partition_snapshots_,
+        std::shared_ptr<const TabletsByPartitionSnapshots>(std::move(new_snapshots)),
+        std::memory_order_release);
+  }
+}
+
 boost::optional<std::vector<RemoteTabletPtr>> MetaCache::FastLookupAllTabletsUnlocked(
     const std::shared_ptr<const YBTable>& table) {
   auto tablets = std::vector<RemoteTabletPtr>();
@@ -1822,11 +1934,10 @@ boost::optional<std::vector<RemoteTabletPtr>> MetaCache::FastLookupAllTabletsUnl
   return tablets;
 }
 
-// We disable thread safety analysis in this function due to manual conditional locking.
-RemoteTabletPtr MetaCache::FastLookupTabletByKeyUnlocked(
+RemoteTabletPtr MetaCache::FastLookupTabletByKey(
     const TableId& table_id, const VersionedPartitionStartKey& partition_start) {
   // Fast path: lookup in the cache.
-  auto result = LookupTabletByKeyFastPathUnlocked(table_id, partition_start);
+  auto result = LookupTabletByKeyFastPath(table_id, partition_start);
   if (result && result->HasLeader()) {
     VLOG_WITH_PREFIX(5) << "Fast lookup: found tablet " << result->tablet_id();
     return result;
@@ -1863,9 +1974,13 @@ bool MetaCache::DoLookupTabletByKey(
   int64_t request_no;
   {
     Lock lock(mutex_);
-    tablet = FastLookupTabletByKeyUnlocked(table->id(), {partition_start, partitions->version});
-    if (tablet) {
-      return true;
+    // Lock free lookup was already done by the caller, so it is only repeated under unique lock,
+    // since the cache could be updated concurrently.
+    if (IsUniqueLock(&lock)) {
+      tablet = FastLookupTabletByKey(table->id(), {partition_start, partitions->version});
+      if (tablet) {
+        return true;
+      }
     }
 
     auto table_it = tables_.find(table->id());
@@ -2002,6 +2117,13 @@ void MetaCache::LookupTabletByKey(const std::shared_ptr<YBTable>& table,
                     << ", partition_key: " << Slice(partition_key).ToDebugHexString()
                     << ", partition_start: " << Slice(*partition_start).ToDebugHexString();
 
+  auto tablet = FastLookupTabletByKey(
+      table->id(), {partition_start, table_partition_list->version});
+  if (tablet) {
+    callback(tablet);
+    return;
+  }
+
   PartitionGroupStartKeyPtr partition_group_start;
   if (DoLookupTabletByKey<SharedLock<std::shared_timed_mutex>>(
           table, table_partition_list, partition_start, deadline, &callback,
@@ -2161,6 +2283,18 @@ void MetaCache::RefreshTablePartitions(
   return;
 }
 
+void MetaCache::RefreshTablePartitionsInBackground(const std::shared_ptr<YBTable>& table) {
+  RefreshTablePartitions(
+      [](const StdStatusCallback&) {}, table,
+      StdStatusCallback([this, table_id = table->id()](const Status& status) {
+        if (!status.ok()) {
+          // Partitions are still stale, so they will be refreshed by the next lookup.
+          VLOG_WITH_PREFIX(1) << "Failed to refresh partitions of table " << table_id << ": "
+                              << status;
+        }
+      }));
+}
+
 void MetaCache::MarkTSFailed(RemoteTabletServer* ts,
                              const Status& status) {
   LOG_WITH_PREFIX(INFO) << "Marking tablet server " << ts->ToString() << " as failed.";
@@ -2224,6 +2358,16 @@ void LookupDataGroup::Finished(
       << expected << " was running, could happen during tablet split";
 }
 
+RemoteTabletPtr TabletsByPartitionSnapshot::Find(const PartitionKey& partition_start) const {
+  auto it = std::lower_bound(
+      tablets.begin(), tablets.end(), partition_start,
+      [](const auto& entry, const PartitionKey& key) { return entry.first < key; });
+  if (it == tablets.end() || it->first != partition_start) {
+    return nullptr;
+  }
+  return it->second;
+}
+
 TableData::TableData(const VersionedTablePartitionListPtr& partition_list_)
     : partition_list(partition_list_) {
   DCHECK_ONLY_NOTNULL(partition_list);
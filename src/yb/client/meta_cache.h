@@ -32,10 +32,12 @@
 // This module is internal to the client and not a public API.
 #pragma once
 
+#include <atomic>
 #include <shared_mutex>
 #include <map>
 #include <string>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -145,6 +147,14 @@ class RemoteTabletServer {
 
   std::string TEST_PlacementZone() const;
 
+  // Updates estimate of the round trip time to this tablet server with the time of the call.
+  void UpdateRtt(MonoDelta rtt);
+
+  // Smoothed round trip time of calls to this tablet server, zero when there were no calls yet.
+  MonoDelta rtt() const {
+    return MonoDelta::FromMicroseconds(rtt_us_.load(std::memory_order_acquire));
+  }
+
  private:
   mutable rw_spinlock mutex_;
   const std::string uuid_;
@@ -157,6 +167,7 @@ class RemoteTabletServer {
   const tserver::LocalTabletServer* const local_tserver_ = nullptr;
   scoped_refptr<Histogram> dns_resolve_histogram_;
   std::vector<CapabilityId> capabilities_ GUARDED_BY(mutex_);
+  std::atomic<int64_t> rtt_us_{0};
 
   DISALLOW_COPY_AND_ASSIGN(RemoteTabletServer);
 };
@@ -167,6 +178,10 @@ struct RemoteReplica {
   MonoTime last_failed_time = MonoTime::kUninitialized;
   // The state of this replica. Only updated after calling GetTabletStatus.
   tablet::RaftGroupStatePB state = tablet::RaftGroupStatePB::UNKNOWN;
+  // Estimated lag of this replica behind the leader, based on the safe time it reported, and
+  // time when it was estimated. Not initialized time means that there is no estimate.
+  MonoDelta staleness;
+  CoarseTimePoint staleness_time;
 
   RemoteReplica(RemoteTabletServer* ts_, PeerRole role_)
       : ts(ts_), role(role_) {}
@@ -326,6 +341,13 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
   // Mark the specified tablet server as a follower in the cache.
   void MarkTServerAsFollower(const RemoteTabletServer* server);
 
+  // Updates estimated staleness of the replica on the specified server.
+  void UpdateReplicaStaleness(const RemoteTabletServer* server, MonoDelta staleness);
+
+  // Returns estimated staleness of the replica on the specified server, zero for the leader and
+  // std::nullopt when there is no recent estimate.
+  std::optional<MonoDelta> ReplicaStaleness(const RemoteTabletServer* server) const;
+
   // Return stringified representation of the list of replicas for this tablet.
   std::string ReplicasAsString() const;
 
@@ -468,6 +490,21 @@ struct TableData {
   // miss the key, because it doesn't exist in 1st post-split tablet.
 };
 
+// Immutable copy of TableData::tablets_by_partition, used to lookup tablet by key without
+// acquiring MetaCache mutex.
+struct TabletsByPartitionSnapshot {
+  // Version of TableData::partition_list at the moment the snapshot was taken.
+  PartitionListVersion partition_list_version;
+  // Sorted by partition start key.
+  std::vector<std::pair<PartitionKey, RemoteTabletPtr>> tablets;
+
+  // Returns tablet with exactly the specified partition start key, nullptr if absent.
+  RemoteTabletPtr Find(const PartitionKey& partition_start) const;
+};
+
+using TabletsByPartitionSnapshots =
+    std::unordered_map<TableId, std::shared_ptr<const TabletsByPartitionSnapshot>>;
+
 class LookupCallbackVisitor : public boost::static_visitor<> {
  public:
   explicit LookupCallbackVisitor(const LookupCallbackParam& param) : param_(param) {
@@ -566,6 +603,16 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
 
   void InvalidateTableCache(const YBTable& table);
 
+  // Starts refreshing table partitions without waiting for it, so they could be already up to
+  // date when they are needed by the following lookups.
+  void RefreshTablePartitionsInBackground(const std::shared_ptr<YBTable>& table);
+
+  // Populates the cache for the table with locations of all its tablets, fetched together with
+  // table partitions. Does nothing if cache was already initialized with other partitions version.
+  void PrefetchTableLocations(
+      const TableId& table_id, const VersionedTablePartitionListPtr& partitions,
+      const google::protobuf::RepeatedPtrField<master::TabletLocationsPB>& locations);
+
   const std::string& LogPrefix() const { return log_prefix_; }
 
  private:
@@ -577,10 +624,9 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   FRIEND_TEST(client::ClientTest, TestMasterLookupPermits);
 
   // Lookup the given tablet by partition_start_key, only consulting local information.
-  // Returns true and sets *remote_tablet if successful.
-  RemoteTabletPtr LookupTabletByKeyFastPathUnlocked(
-      const TableId& table_id,
-      const VersionedPartitionStartKey& partition_key) REQUIRES_SHARED(mutex_);
+  // Does not require mutex_, since uses tablets_by_partition_snapshots_.
+  RemoteTabletPtr LookupTabletByKeyFastPath(
+      const TableId& table_id, const VersionedPartitionStartKey& partition_key);
 
   std::optional<RemoteTabletPtr> LookupTabletByIdFastPathUnlocked(const TabletId& tablet_id)
       REQUIRES_SHARED(mutex_);
@@ -623,9 +669,12 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
       LookupDataGroup* lookup_data_group,
       CallbackNotifier* notifier) REQUIRES(mutex_);
 
-  RemoteTabletPtr FastLookupTabletByKeyUnlocked(
-      const TableId& table_id,
-      const VersionedPartitionStartKey& partition_start) REQUIRES_SHARED(mutex_);
+  RemoteTabletPtr FastLookupTabletByKey(
+      const TableId& table_id, const VersionedPartitionStartKey& partition_start);
+
+  // Replaces snapshots of tablets_by_partition for the specified tables with their current state.
+  void UpdateTabletsByPartitionSnapshotsUnlocked(const std::vector<TableId>& table_ids)
+      REQUIRES(mutex_);
 
   // Lookup from cache the set of tablets corresponding to a tiven table.
   // Returns empty vector if the cache is invalid or a tablet is stale,
@@ -686,6 +735,10 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   // Cache of tablets, keyed by table ID, then by start partition key.
   std::unordered_map<TableId, TableData> tables_ GUARDED_BY(mutex_);
 
+  // Copy-on-write snapshots of TableData::tablets_by_partition, keyed by table ID.
+  // Replaced only while holding mutex_ exclusively, and read without mutex_ via atomic load.
+  std::shared_ptr<const TabletsByPartitionSnapshots> tablets_by_partition_snapshots_;
+
   // Cache of tablets, keyed by tablet ID.
   std::unordered_map<TabletId, RemoteTabletPtr> tablets_by_id_ GUARDED_BY(mutex_);
 
@@ -64,6 +64,7 @@ DECLARE_bool(TEST_master_fail_transactional_tablet_lookups);
 DECLARE_bool(TEST_transaction_allow_rerequest_status);
 DECLARE_bool(delete_intents_sst_files);
 DECLARE_bool(enable_load_balancing);
+DECLARE_bool(enable_transaction_heartbeat_batching);
 DECLARE_bool(fail_on_out_of_range_clock_skew);
 DECLARE_bool(flush_rocksdb_on_shutdown);
 DECLARE_bool(rocksdb_disable_compactions);
@@ -442,6 +443,25 @@ TEST_F(QLTransactionTest, Heartbeat) {
   AssertNoRunningTransactions();
 }
 
+// Multiple transactions share status tablets, so their heartbeats are sent in batches.
+TEST_F(QLTransactionTest, HeartbeatBatching) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_transaction_heartbeat_batching) = true;
+  constexpr size_t kTransactions = 20;
+  std::vector<YBTransactionPtr> transactions;
+  for (size_t i = 0; i != kTransactions; ++i) {
+    auto txn = CreateTransaction();
+    auto session = CreateSession(txn);
+    ASSERT_OK(WriteRows(session, i));
+    transactions.push_back(std::move(txn));
+  }
+  std::this_thread::sleep_for(GetTransactionTimeout() * 2);
+  for (const auto& txn : transactions) {
+    ASSERT_OK(txn->CommitFuture().get());
+  }
+  VerifyData(kTransactions);
+  AssertNoRunningTransactions();
+}
+
 TEST_F(QLTransactionTest, Expire) {
   SetDisableHeartbeatInTests(true);
   auto txn = CreateTransaction();
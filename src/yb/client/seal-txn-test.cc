@@ -31,6 +31,7 @@ DECLARE_bool(TEST_fail_on_replicated_batch_idx_set_in_txn_record);
 DECLARE_double(transaction_max_missed_heartbeat_periods);
 DECLARE_int32(TEST_write_rejection_percentage);
 DECLARE_int64(transaction_rpc_timeout_ms);
+DECLARE_bool(transaction_parallel_commit);
 
 namespace yb {
 namespace client {
@@ -151,5 +152,20 @@ TEST_F(SealTxnTest, Update) {
   AssertNoRunningTransactions();
 }
 
+// Regular commit issued while writes are in flight is converted to seal.
+TEST_F(SealTxnTest, ParallelCommit) {
+  FLAGS_transaction_parallel_commit = true;
+
+  auto txn = CreateTransaction();
+  auto session = CreateSession(txn);
+  ASSERT_OK(WriteRows(session, /* transaction = */ 0, WriteOpType::INSERT, Flush::kFalse));
+  auto flush_future = session->FlushFuture();
+  auto commit_future = txn->CommitFuture();
+  ASSERT_OK(flush_future.get().status);
+  ASSERT_OK(commit_future.get());
+  ASSERT_NO_FATALS(VerifyData());
+  AssertNoRunningTransactions();
+}
+
 } // namespace client
 } // namespace yb
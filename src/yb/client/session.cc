@@ -14,6 +14,7 @@
 #include "yb/client/session.h"
 
 #include "yb/client/async_rpc.h"
+#include "yb/client/awaitable.h"
 #include "yb/client/batcher.h"
 #include "yb/client/client.h"
 #include "yb/client/client_error.h"
@@ -241,6 +242,10 @@ std::future<FlushStatus> YBSession::FlushFuture() {
   return future;
 }
 
+SessionFlushAwaiter YBSession::FlushAwaitable(rpc::ThreadPool* executor) {
+  return SessionFlushAwaiter(this, executor);
+}
+
 YBClient* YBSession::client() const {
   return batcher_config_.client;
 }
@@ -299,12 +304,17 @@ internal::Batcher& YBSession::Batcher() {
 
       batcher_->SetDeadline(CoarseMonoClock::now() + timeout);
     }
+    buffered_bytes_ = 0;
+    buffering_start_ = CoarseMonoClock::now();
   }
   return *batcher_;
 }
 
 void YBSession::Apply(YBOperationPtr yb_op) {
   Batcher().Add(yb_op);
+  if (auto_flush_) {
+    MaybeAutoFlush(auto_flush_->max_buffered_bytes ? yb_op->request_size() : 0);
+  }
 }
 
 bool YBSession::IsInProgress(YBOperationPtr yb_op) const {
@@ -325,8 +335,40 @@ void YBSession::Apply(const std::vector<YBOperationPtr>& ops) {
     return;
   }
   auto& batcher = Batcher();
+  size_t applied_bytes = 0;
+  const auto count_bytes = auto_flush_ && auto_flush_->max_buffered_bytes;
   for (const auto& op : ops) {
     batcher.Add(op);
+    if (count_bytes) {
+      applied_bytes += op->request_size();
+    }
+  }
+  if (auto_flush_) {
+    MaybeAutoFlush(applied_bytes);
+  }
+}
+
+void YBSession::EnableAutoFlush(AutoFlushOptions options) {
+  auto_flush_ = std::move(options);
+}
+
+void YBSession::DisableAutoFlush() {
+  auto_flush_.reset();
+}
+
+void YBSession::MaybeAutoFlush(size_t applied_bytes) {
+  const auto& options = *auto_flush_;
+  buffered_bytes_ += applied_bytes;
+  const auto buffered_ops = batcher_->CountBufferedOperations();
+  bool flush =
+      (options.max_buffered_ops && buffered_ops >= options.max_buffered_ops) ||
+      (options.max_buffered_bytes && buffered_bytes_ >= options.max_buffered_bytes) ||
+      (options.max_buffering_time > MonoDelta::kZero &&
+       CoarseMonoClock::now() - buffering_start_ >= options.max_buffering_time);
+  if (flush) {
+    VLOG_WITH_FUNC(4) << "Auto flush " << buffered_ops << " ops, "
+                      << buffered_bytes_ << " bytes";
+    FlushAsync(options.callback);
   }
 }
 
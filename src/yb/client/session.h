@@ -14,6 +14,7 @@
 #pragma once
 
 #include <future>
+#include <optional>
 #include <unordered_set>
 
 #include "yb/client/client_fwd.h"
@@ -22,6 +23,8 @@
 
 #include "yb/gutil/ref_counted.h"
 
+#include "yb/rpc/rpc_fwd.h"
+
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
 
@@ -133,6 +136,24 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
 
   void Apply(const std::vector<YBOperationPtr>& ops);
 
+  // Options of the automatic flush of the buffered operations, that is triggered by Apply as soon
+  // as one of the limits is reached. Zero limit is not checked.
+  struct AutoFlushOptions {
+    size_t max_buffered_ops = 0;
+    // Limit for the approximate size of the buffered operations requests.
+    size_t max_buffered_bytes = 0;
+    // Limit for the time since the first buffered operation was applied.
+    MonoDelta max_buffering_time;
+    // Invoked with the result of each automatic flush.
+    FlushCallback callback;
+  };
+
+  // Enables automatic flush of the buffered operations.
+  // Explicit flush is still required to send the operations applied after the last automatic
+  // flush.
+  void EnableAutoFlush(AutoFlushOptions options);
+  void DisableAutoFlush();
+
   // Flush any pending writes.
   //
   // Returns a bad status if session failed to resolve tablets for at least some operations or
@@ -170,6 +191,12 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
   void FlushAsync(FlushCallback callback);
   std::future<FlushStatus> FlushFuture();
 
+  // Returns awaiter for the flush, that could be used in C++20 coroutine:
+  //   auto flush_status = co_await session->FlushAwaitable(executor);
+  // When executor is specified, the coroutine is resumed in it.
+  // Awaiter is defined in yb/client/awaitable.h.
+  SessionFlushAwaiter FlushAwaitable(rpc::ThreadPool* executor = nullptr);
+
   // For production code use async variants of the following functions instead.
   FlushStatus TEST_FlushAndGetOpsErrors();
   Status TEST_Flush();
@@ -252,6 +279,9 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
 
   internal::Batcher& Batcher();
 
+  // Flushes buffered operations, when they reach limits of the automatic flush.
+  void MaybeAutoFlush(size_t applied_bytes);
+
   BatcherConfig batcher_config_;
 
   // Lock protecting flushed_batchers_.
@@ -277,6 +307,12 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
 
   internal::AsyncRpcMetricsPtr async_rpc_metrics_;
 
+  std::optional<AutoFlushOptions> auto_flush_;
+  // Approximate size of the operations buffered in batcher_ and time when the first of them was
+  // applied. Reset when new batcher is created.
+  size_t buffered_bytes_ = 0;
+  CoarseTimePoint buffering_start_;
+
   DISALLOW_COPY_AND_ASSIGN(YBSession);
 };
 
@@ -35,6 +35,7 @@
 using namespace std::literals;
 
 DECLARE_bool(enable_history_cutoff_propagation);
+DECLARE_bool(enable_in_place_pitr);
 DECLARE_int32(history_cutoff_propagation_interval_ms);
 DECLARE_int32(timestamp_history_retention_interval_sec);
 DECLARE_uint64(snapshot_coordinator_poll_interval_ms);
@@ -317,6 +318,33 @@ TEST_F(SnapshotScheduleTest, RestoreSchema) {
   ASSERT_NO_FATALS(VerifyData());
 }
 
+TEST_F(SnapshotScheduleTest, RestoreInPlace) {
+  FLAGS_enable_in_place_pitr = true;
+  ASSERT_NO_FATALS(WriteData());
+  auto schedule_id = ASSERT_RESULT(
+    snapshot_util_->CreateSchedule(table_, YQLDatabase::YQL_DATABASE_PGSQL, "yugabyte"));
+  ASSERT_OK(snapshot_util_->WaitScheduleSnapshot(schedule_id));
+  ASSERT_OK(cluster_->FlushTablets());
+  auto hybrid_time = cluster_->mini_master(0)->master()->clock()->Now();
+
+  ASSERT_NO_FATALS(WriteData(WriteOpType::UPDATE));
+  ASSERT_NO_FATALS(VerifyData(WriteOpType::UPDATE));
+  ASSERT_RESULT(WriteRow(CreateSession(), 1000, 1000));
+
+  auto schedules = ASSERT_RESULT(snapshot_util_->ListSchedules());
+  ASSERT_EQ(schedules.size(), 1);
+  const auto& snapshots = schedules[0].snapshots();
+  ASSERT_EQ(snapshots.size(), 1);
+
+  ASSERT_OK(snapshot_util_->RestoreSnapshot(
+      TryFullyDecodeTxnSnapshotId(snapshots[0].id()), hybrid_time));
+
+  ASSERT_NO_FATALS(VerifyData());
+  auto select_result = SelectRow(CreateSession(), 1000);
+  ASSERT_NOK(select_result);
+  ASSERT_TRUE(select_result.status().IsNotFound()) << select_result.status();
+}
+
 TEST_F(SnapshotScheduleTest, RemoveNewTablets) {
   const auto kInterval = 5s * kTimeMultiplier;
   const auto kRetention = kInterval * 2;
@@ -14,6 +14,8 @@
 #include "yb/client/table.h"
 
 #include "yb/client/client.h"
+#include "yb/client/client-internal.h"
+#include "yb/client/meta_cache.h"
 #include "yb/client/table_info.h"
 #include "yb/client/yb_op.h"
 
@@ -21,6 +23,7 @@
 
 #include "yb/master/master_client.pb.h"
 
+#include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/result.h"
 #include "yb/util/shared_lock.h"
@@ -33,6 +36,10 @@ DEFINE_int32(
     max_num_tablets_for_table, 5000,
     "Max number of tablets that can be specified in a CREATE TABLE statement");
 
+DEFINE_RUNTIME_bool(client_prefetch_table_locations, true,
+    "Populate MetaCache with locations of all table tablets, received while fetching table "
+    "partitions, so first lookups of the table tablets don't require master RPCs.");
+
 namespace yb {
 namespace client {
 
@@ -269,8 +276,8 @@ void YBTable::RefreshPartitions(YBClient* client, StdStatusCallback callback) {
   });
 }
 
-void YBTable::MarkPartitionsAsStale() {
-  partitions_are_stale_ = true;
+bool YBTable::MarkPartitionsAsStale() {
+  return !partitions_are_stale_.exchange(true);
 }
 
 bool YBTable::ArePartitionsStale() const {
@@ -285,7 +292,7 @@ void YBTable::FetchPartitions(
   client->GetTableLocations(
       table_id, /* max_tablets = */ std::numeric_limits<int32_t>::max(),
       RequireTabletsRunning::kTrue,
-      [table_id, callback = std::move(callback)]
+      [client, table_id, callback = std::move(callback)]
           (const Result<master::GetTableLocationsResponsePB*>& result) {
         if (!result.ok()) {
           callback(result.status());
@@ -305,6 +312,11 @@ void YBTable::FetchPartitions(
         }
         std::sort(partitions->keys.begin(), partitions->keys.end());
 
+        if (GetAtomicFlag(&FLAGS_client_prefetch_table_locations)) {
+          client->data_->meta_cache_->PrefetchTableLocations(
+              table_id, partitions, resp.tablet_locations());
+        }
+
         callback(partitions);
       });
 }
@@ -129,7 +129,8 @@ class YBTable : public std::enable_shared_from_this<YBTable> {
   // Partitions could be grouped by group_by bunches, in this case start of such bunch is returned.
   PartitionKeyPtr FindPartitionStart(const PartitionKey& partition_key, size_t group_by = 1) const;
 
-  void MarkPartitionsAsStale();
+  // Returns true if partitions were not marked as stale before this call.
+  bool MarkPartitionsAsStale();
   bool ArePartitionsStale() const;
 
   // Asynchronously refreshes table partitions.
@@ -43,6 +43,7 @@ TableType ClientToPBTableType(YBTableType table_type);
 struct TableSizeInfo {
   int64 table_size;
   int32 num_missing_tablets;
+  uint64 estimated_num_rows;
 };
 
 }  // namespace client
@@ -20,8 +20,11 @@
 #include "yb/client/client_error.h"
 #include "yb/client/meta_cache.h"
 
+#include "yb/common/hybrid_time.h"
 #include "yb/common/wire_protocol.h"
 
+#include "yb/gutil/walltime.h"
+
 #include "yb/rpc/network_error.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/rpc/rpc_header.pb.h"
@@ -50,6 +53,23 @@ DEFINE_int32(lookup_cache_refresh_secs, 60, "When non-zero, specifies how often
              "This request is only sent if we are processing a ConsistentPrefix read and the RPC "
              "layer has determined that its view of the replicas is inconsistent with what the "
              "master has reported");
+DEFINE_RUNTIME_uint64(consistent_prefix_read_max_staleness_ms, 0,
+    "Max time a replica serving consistent prefix read could be behind the leader. It is sent "
+    "with the read, and replica rejects it when it is more stale, so the read is retried on the "
+    "leader. 0 - use max_stale_read_bound_time_ms of the replica.");
+DEFINE_RUNTIME_bool(consistent_prefix_read_route_by_latency, false,
+    "Route consistent prefix reads to the replica with the lowest observed round trip time, "
+    "among replicas whose estimated staleness fits consistent_prefix_read_max_staleness_ms, "
+    "instead of the closest replica by placement. Falls back to the leader when there is no "
+    "such replica.");
+DEFINE_RUNTIME_uint64(consistent_prefix_read_hedge_rtt_multiplier, 0,
+    "When a consistent prefix read does not get a response from the replica within this "
+    "multiple of the replica's smoothed round trip time, the attempt is abandoned and the read "
+    "is retried on another replica, that is not used for the rest of this read. "
+    "0 - disabled.");
+DEFINE_RUNTIME_uint64(consistent_prefix_read_hedge_min_delay_ms, 10,
+    "Minimal time a consistent prefix read waits for the replica before being retried on "
+    "another replica, see consistent_prefix_read_hedge_rtt_multiplier.");
 DEFINE_test_flag(int32, assert_failed_replicas_less_than, 0,
                  "If greater than 0, this process will crash if the number of failed replicas for "
                  "a RemoteTabletServer is greater than the specified number.");
@@ -94,13 +114,85 @@ void TabletInvoker::SelectTabletServerWithConsistentPrefix() {
     }
   }
 
+  if (GetAtomicFlag(&FLAGS_consistent_prefix_read_route_by_latency)) {
+    current_ts_ = SelectLowestLatencyReplica();
+    VLOG(1) << "Using lowest latency tserver: " << yb::ToString(current_ts_);
+    if (current_ts_) {
+      return;
+    }
+  }
+
   std::vector<RemoteTabletServer*> candidates;
   current_ts_ = client_->data_->SelectTServer(tablet_.get(),
-                                              YBClient::ReplicaSelection::CLOSEST_REPLICA, {},
-                                              &candidates);
+                                              YBClient::ReplicaSelection::CLOSEST_REPLICA,
+                                              hedged_replicas_, &candidates);
   VLOG(1) << "Using tserver: " << yb::ToString(current_ts_);
 }
 
+RemoteTabletServer* TabletInvoker::SelectLowestLatencyReplica() {
+  auto max_staleness_ms = GetAtomicFlag(&FLAGS_consistent_prefix_read_max_staleness_ms);
+  // Replica that rejected read as stale has infinite staleness estimate, so it is always skipped.
+  auto max_staleness = max_staleness_ms ? MonoDelta::FromMilliseconds(max_staleness_ms)
+                                        : MonoDelta::kMax;
+  RemoteTabletServer* result = nullptr;
+  for (auto* ts : tablet_->GetRemoteTabletServers()) {
+    if (hedged_replicas_.count(ts->permanent_uuid())) {
+      continue;
+    }
+    // Replica without recent estimate is tried, since it checks staleness itself.
+    auto staleness = tablet_->ReplicaStaleness(ts);
+    if (staleness && *staleness >= max_staleness) {
+      continue;
+    }
+    // Servers without RTT estimate have zero RTT, so they are probed first.
+    if (!result || ts->rtt() < result->rtt()) {
+      result = ts;
+    }
+  }
+  return result ? result : tablet_->LeaderTServer();
+}
+
+void TabletInvoker::RecordReplicaSafeTime(HybridTime safe_time) {
+  if (!current_ts_ || !tablet_ || !safe_time.is_valid()) {
+    return;
+  }
+  auto staleness_us = std::max<int64_t>(
+      GetCurrentTimeMicros() - static_cast<int64_t>(safe_time.GetPhysicalValueMicros()), 0);
+  tablet_->UpdateReplicaStaleness(current_ts_, MonoDelta::FromMicroseconds(staleness_us));
+}
+
+void TabletInvoker::SetupHedgeDeadline() {
+  hedge_deadline_ = CoarseTimePoint();
+  auto multiplier = GetAtomicFlag(&FLAGS_consistent_prefix_read_hedge_rtt_multiplier);
+  if (!multiplier || hedged_replicas_.count(current_ts_->permanent_uuid())) {
+    return;
+  }
+  // Hedge only when there is another replica to retry the read on.
+  bool has_other_replica = false;
+  for (auto* ts : tablet_->GetRemoteTabletServers()) {
+    if (ts != current_ts_ && !hedged_replicas_.count(ts->permanent_uuid())) {
+      has_other_replica = true;
+      break;
+    }
+  }
+  if (!has_other_replica) {
+    return;
+  }
+  auto delay = std::max<MonoDelta>(
+      current_ts_->rtt() * static_cast<int64_t>(multiplier),
+      MonoDelta::FromMilliseconds(GetAtomicFlag(&FLAGS_consistent_prefix_read_hedge_min_delay_ms)));
+  auto deadline = send_time_ + delay;
+  if (deadline < retrier_->deadline()) {
+    hedge_deadline_ = deadline;
+  }
+}
+
+void TabletInvoker::LimitAttemptDeadline(rpc::RpcController* controller) const {
+  if (hedge_deadline_ != CoarseTimePoint()) {
+    controller->set_deadline(hedge_deadline_);
+  }
+}
+
 void TabletInvoker::SelectLocalTabletServer() {
   TRACE_TO(trace_, "SelectLocalTabletServer()");
 
@@ -263,6 +355,13 @@ void TabletInvoker::Execute(const std::string& tablet_id, bool leader_only) {
   VLOG(2) << "Tablet " << tablet_id_ << ": Sending " << command_->ToString() << " to replica "
           << current_ts_->ToString();
 
+  send_time_ = CoarseMonoClock::now();
+  if (consistent_prefix_ && !leader_only && !local_tserver_only_) {
+    SetupHedgeDeadline();
+  } else {
+    hedge_deadline_ = CoarseTimePoint();
+  }
+
   rpc_->SendRpcToTserver(retrier_->attempt_num());
 }
 
@@ -271,6 +370,9 @@ Status TabletInvoker::FailToNewReplica(const Status& reason,
   TRACE_TO(trace_, "FailToNewReplica($0)", reason.ToString());
   if (ErrorCode(error_code) == tserver::TabletServerErrorPB::STALE_FOLLOWER) {
     VLOG(1) << "Stale follower for " << command_->ToString() << " just retry";
+    if (tablet_ && current_ts_) {
+      tablet_->UpdateReplicaStaleness(current_ts_, MonoDelta::kMax);
+    }
   } else if (ErrorCode(error_code) == tserver::TabletServerErrorPB::NOT_THE_LEADER) {
     VLOG(1) << "Not the leader for " << command_->ToString()
             << " retrying with a different replica";
@@ -333,6 +435,32 @@ bool TabletInvoker::Done(Status* status) {
     return true;
   }
 
+  // Server responded, so time of the call could be used to estimate RTT.
+  if (current_ts_ && send_time_ != CoarseTimePoint() && !status->IsNetworkError() &&
+      !status->IsTimedOut()) {
+    current_ts_->UpdateRtt(CoarseMonoClock::now() - send_time_);
+  }
+
+  // Replica did not respond in time, so read is retried on another replica, without waiting
+  // till the deadline of the whole read.
+  auto hedge_deadline = std::exchange(hedge_deadline_, CoarseTimePoint());
+  if (status->IsTimedOut() && hedge_deadline != CoarseTimePoint() && current_ts_ &&
+      CoarseMonoClock::now() < retrier_->deadline()) {
+    VLOG(1) << "Tablet " << tablet_id_ << ": hedging " << command_->ToString() << ", replica "
+            << current_ts_->ToString() << " did not respond in "
+            << MonoDelta(hedge_deadline - send_time_);
+    // Replica was at least that slow, so it is less preferred by the following reads.
+    current_ts_->UpdateRtt(CoarseMonoClock::now() - send_time_);
+    hedged_replicas_.insert(current_ts_->permanent_uuid());
+    send_time_ = CoarseTimePoint();
+    auto retry_status = retrier_->DelayedRetry(command_, *status, MonoDelta::kZero);
+    if (!retry_status.ok()) {
+      LOG(WARNING) << "Failed to schedule hedged retry: " << retry_status;
+    }
+    return !retry_status.ok();
+  }
+  send_time_ = CoarseTimePoint();
+
   // Prefer early failures over controller failures.
   if (status->ok() && retrier_->HandleResponse(command_, status)) {
     return false;
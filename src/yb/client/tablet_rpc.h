@@ -16,6 +16,7 @@
 #pragma once
 
 #include <memory>
+#include <set>
 #include <string>
 #include <unordered_set>
 
@@ -94,6 +95,13 @@ class TabletInvoker {
 
   bool is_consistent_prefix() const { return consistent_prefix_; }
 
+  // Updates staleness estimate of the replica that served the read, using its safe time.
+  void RecordReplicaSafeTime(HybridTime safe_time);
+
+  // Limits deadline of the current attempt, when consistent prefix read should be retried on
+  // another replica after consistent_prefix_read_hedge_rtt_multiplier RTTs.
+  void LimitAttemptDeadline(rpc::RpcController* controller) const;
+
  private:
   friend class TabletRpcTest;
   FRIEND_TEST(TabletRpcTest, TabletInvokerSelectTabletServerRace);
@@ -104,10 +112,16 @@ class TabletInvoker {
   // there is no requirement that the read needs to hit the leader.
   void SelectTabletServerWithConsistentPrefix();
 
+  // Returns replica with the lowest RTT, whose estimated staleness fits the bound, or the leader.
+  RemoteTabletServer* SelectLowestLatencyReplica();
+
   // This is for Redis ops which always prefer to invoke the local tablet server. In case when it
   // is not the leader, a MOVED response will be returned.
   void SelectLocalTabletServer();
 
+  // Sets hedge_deadline_ for the attempt sent to current_ts_ at send_time_.
+  void SetupHedgeDeadline();
+
   // Marks all replicas on current_ts_ as failed and retries the write on a
   // new replica.
   Status FailToNewReplica(const Status& reason,
@@ -178,6 +192,16 @@ class TabletInvoker {
 
   // Should we assign new leader in meta cache when successful response is received.
   bool assign_new_leader_ = false;
+
+  // Time when the RPC was sent to current_ts_, used to estimate its RTT.
+  CoarseTimePoint send_time_;
+
+  // Deadline of the current attempt, after which it is retried on another replica. Not set when
+  // the attempt is not hedged.
+  CoarseTimePoint hedge_deadline_;
+
+  // UUIDs of replicas that did not respond in time to this read, not used for its retries.
+  std::set<std::string> hedged_replicas_;
 };
 
 Status ErrorStatus(const tserver::TabletServerErrorPB* error);
@@ -17,6 +17,7 @@
 
 #include <unordered_set>
 
+#include "yb/client/awaitable.h"
 #include "yb/client/batcher.h"
 #include "yb/client/client.h"
 #include "yb/client/in_flight_op.h"
@@ -70,6 +71,8 @@ TAG_FLAG(txn_slow_op_threshold_ms, advanced);
 DEFINE_uint64(transaction_heartbeat_usec, 500000 * yb::kTimeMultiplier,
               "Interval of transaction heartbeat in usec.");
 DEFINE_bool(transaction_disable_heartbeat_in_tests, false, "Disable heartbeat during test.");
+DEFINE_RUNTIME_AUTO_bool(enable_transaction_heartbeat_batching, kLocalVolatile, false, true,
+    "Send PENDING heartbeats of transactions with the same status tablet in a single RPC.");
 DECLARE_uint64(max_clock_skew_usec);
 
 DEFINE_bool(auto_promote_nonlocal_transactions_to_global, true,
@@ -85,6 +88,12 @@ DEFINE_test_flag(int32, txn_status_moved_rpc_send_delay_ms, 0,
                  "Inject delay before sending UpdateTransactionStatusLocation RPCs to participant "
                  "tablets.");
 
+DEFINE_RUNTIME_bool(transaction_parallel_commit, false,
+    "Allow commit of a transaction while its write requests are still in progress. The commit "
+    "record is written together with the number of batches sent to each participant, and the "
+    "transaction is considered committed once all of them are replicated. Requires "
+    "enable_transaction_sealing on all tablet servers.");
+
 DEFINE_test_flag(int32, old_txn_status_abort_delay_ms, 0,
                  "Inject delay before sending abort to old transaction status tablet.");
 
@@ -93,6 +102,12 @@ METRIC_DEFINE_counter(server, transaction_promotions,
                       yb::MetricUnit::kTransactions,
                       "Number of transactions being promoted to global transactions");
 
+METRIC_DEFINE_counter(server, transaction_single_tablet_commits,
+                      "Number of committed transactions that wrote intents to a single tablet",
+                      yb::MetricUnit::kTransactions,
+                      "Number of committed transactions that wrote intents to a single tablet, "
+                      "i.e. transactions that could use one phase commit");
+
 DECLARE_bool(enable_wait_queues);
 
 namespace yb {
@@ -472,6 +487,13 @@ class YBTransaction::Impl final : public internal::TxnBatcherIf {
     TRACE_TO(trace_, __func__);
     {
       UNIQUE_LOCK(lock, mutex_);
+      if (!seal_only && running_requests_ > 0 &&
+          GetAtomicFlag(&FLAGS_transaction_parallel_commit)) {
+        // Sealed transaction is committed by the coordinator as soon as all batches are
+        // replicated, and callback is invoked after all running requests are finished.
+        VLOG_WITH_PREFIX(2) << "Parallel commit with " << running_requests_ << " running requests";
+        seal_only = SealOnly::kTrue;
+      }
       auto status = CheckCouldCommitUnlocked(seal_only);
       if (!status.ok()) {
         lock.unlock();
@@ -647,6 +669,7 @@ class YBTransaction::Impl final : public internal::TxnBatcherIf {
     }
     ready_ = false;
     metadata_.locality = TransactionLocality::GLOBAL;
+    manager_->LocalTransactionPromoted();
 
     for (const auto& tablet_state : tablets_) {
       const auto& participant_tablet = tablet_state.first;
@@ -972,6 +995,8 @@ class YBTransaction::Impl final : public internal::TxnBatcherIf {
     auto metric_entity = manager_->client()->metric_entity();
     if (metric_entity) {
       transaction_promotions_ = METRIC_transaction_promotions.Instantiate(metric_entity);
+      transaction_single_tablet_commits_ =
+          METRIC_transaction_single_tablet_commits.Instantiate(metric_entity);
     }
   }
 
@@ -1112,6 +1137,12 @@ class YBTransaction::Impl final : public internal::TxnBatcherIf {
       subtransaction_.get().aborted.ToPB(state.mutable_aborted()->mutable_set());
     }
 
+    // Only counts transactions that could use one phase commit, such commits still go through
+    // the status tablet and apply intents as usual.
+    if (!seal_only && state.tablets().size() == 1) {
+      IncrementCounter(transaction_single_tablet_commits_);
+    }
+
     manager_->rpcs().RegisterAndStart(
         UpdateTransaction(
             deadline,
@@ -1546,20 +1577,34 @@ class YBTransaction::Impl final : public internal::TxnBatcherIf {
       timeout = TransactionRpcTimeout();
     }
 
+    const bool batched = status == TransactionStatus::PENDING &&
+                         GetAtomicFlag(&FLAGS_enable_transaction_heartbeat_batching);
     rpc::RpcCommandPtr rpc;
+    internal::RemoteTabletPtr status_tablet;
     {
       SharedLock<std::shared_mutex> lock(mutex_);
-      internal::RemoteTabletPtr status_tablet;
 
       if (!send_to_new_tablet && old_status_tablet_) {
         status_tablet = old_status_tablet_;
       } else {
         status_tablet = status_tablet_;
       }
-      rpc = PrepareHeartbeatRPC(
-          CoarseMonoClock::now() + timeout, status_tablet, status,
-          std::bind(
-              &Impl::HeartbeatDone, this, _1, _2, _3, status, transaction, send_to_new_tablet));
+      if (!batched) {
+        rpc = PrepareHeartbeatRPC(
+            CoarseMonoClock::now() + timeout, status_tablet, status,
+            std::bind(
+                &Impl::HeartbeatDone, this, _1, _2, _3, status, transaction, send_to_new_tablet));
+      }
+    }
+
+    if (batched) {
+      manager_->SendHeartbeat(
+          status_tablet, id, CoarseMonoClock::now() + timeout,
+          [this, transaction, send_to_new_tablet](const Status& status) {
+        HeartbeatDone(status, /* request= */ {}, /* response= */ {}, TransactionStatus::PENDING,
+                      transaction, send_to_new_tablet);
+      });
+      return;
     }
 
     auto& handle = send_to_new_tablet ? new_heartbeat_handle_ : heartbeat_handle_;
@@ -2000,6 +2045,7 @@ class YBTransaction::Impl final : public internal::TxnBatcherIf {
   bool commit_replicated_ GUARDED_BY(mutex_) = false;
 
   scoped_refptr<Counter> transaction_promotions_;
+  scoped_refptr<Counter> transaction_single_tablet_commits_;
 };
 
 CoarseTimePoint AdjustDeadline(CoarseTimePoint deadline) {
@@ -2083,6 +2129,11 @@ std::future<Status> YBTransaction::CommitFuture(
   });
 }
 
+TransactionCommitAwaiter YBTransaction::CommitAwaitable(
+    CoarseTimePoint deadline, rpc::ThreadPool* executor, SealOnly seal_only) {
+  return TransactionCommitAwaiter(this, deadline, seal_only, executor);
+}
+
 void YBTransaction::Abort(CoarseTimePoint deadline) {
   impl_->Abort(AdjustDeadline(deadline));
 }
@@ -27,6 +27,8 @@
 #include "yb/client/client_fwd.h"
 #include "yb/client/in_flight_op.h"
 
+#include "yb/rpc/rpc_fwd.h"
+
 #include "yb/util/status_fwd.h"
 
 namespace yb {
@@ -102,6 +104,14 @@ class YBTransaction : public std::enable_shared_from_this<YBTransaction> {
   std::future<Status> CommitFuture(
       CoarseTimePoint deadline = CoarseTimePoint(), SealOnly seal_only = SealOnly::kFalse);
 
+  // Returns awaiter for the commit, that could be used in C++20 coroutine:
+  //   auto status = co_await transaction->CommitAwaitable(deadline, executor);
+  // When executor is specified, the coroutine is resumed in it.
+  // Awaiter is defined in yb/client/awaitable.h.
+  TransactionCommitAwaiter CommitAwaitable(
+      CoarseTimePoint deadline = CoarseTimePoint(), rpc::ThreadPool* executor = nullptr,
+      SealOnly seal_only = SealOnly::kFalse);
+
   // Aborts this transaction.
   void Abort(CoarseTimePoint deadline = CoarseTimePoint());
 
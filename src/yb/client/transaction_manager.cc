@@ -15,19 +15,29 @@
 
 #include "yb/client/transaction_manager.h"
 
+#include <unordered_map>
+
 #include "yb/client/client.h"
 #include "yb/client/meta_cache.h"
 #include "yb/client/table.h"
+#include "yb/client/transaction_rpc.h"
 #include "yb/client/yb_table_name.h"
 
+#include "yb/common/wire_protocol.h"
+
 #include "yb/master/catalog_manager.h"
 
+#include "yb/rpc/rpc.h"
 #include "yb/rpc/tasks_pool.h"
 
 #include "yb/server/server_base_options.h"
 
+#include "yb/tserver/tserver_service.pb.h"
+
 #include "yb/util/flags.h"
 #include "yb/util/format.h"
+#include "yb/util/locks.h"
+#include "yb/util/random_util.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 #include "yb/util/string_util.h"
@@ -39,6 +49,11 @@ DEFINE_uint64(transaction_manager_workers_limit, 50,
 DEFINE_uint64(transaction_manager_queue_limit, 500,
               "Max number of tasks used by transaction manager");
 
+DEFINE_RUNTIME_uint64(transaction_heartbeat_max_batch_size, 1000,
+    "Max number of transaction heartbeats sent to the same status tablet in a single RPC.");
+
+DECLARE_uint64(transaction_heartbeat_usec);
+
 DEFINE_test_flag(string, transaction_manager_preferred_tablet, "",
                  "For testing only. If non-empty, transaction manager will try to use the status "
                  "tablet with id matching this flag, if present in the list of status tablets.");
@@ -48,12 +63,228 @@ namespace client {
 
 namespace {
 
+// Number of transactions of this process that picked the status tablet or sent heartbeats to it
+// during the current and the previous heartbeat intervals. Since every running transaction sends
+// heartbeat once per interval, it estimates the number of running transactions per status tablet.
+class StatusTabletsLoad {
+ public:
+  void Add(const TabletId& tablet_id, size_t count) EXCLUDES(mutex_) {
+    std::lock_guard<simple_spinlock> lock(mutex_);
+    RotateIfNecessary();
+    tablets_[tablet_id].current += count;
+  }
+
+  // Returns the less loaded of two random tablets from the list, and accounts the new transaction
+  // in its load.
+  const TabletId& PickTablet(const std::vector<const TabletId*>& tablet_ids) EXCLUDES(mutex_) {
+    const TabletId* result = RandomElement(tablet_ids);
+    if (tablet_ids.size() > 1) {
+      const TabletId* other = RandomElement(tablet_ids);
+      while (other == result) {
+        other = RandomElement(tablet_ids);
+      }
+      std::lock_guard<simple_spinlock> lock(mutex_);
+      RotateIfNecessary();
+      if (Load(*other) < Load(*result)) {
+        result = other;
+      }
+      ++tablets_[*result].current;
+    }
+    return *result;
+  }
+
+ private:
+  struct Entry {
+    size_t current = 0;
+    size_t previous = 0;
+  };
+
+  size_t Load(const TabletId& tablet_id) REQUIRES(mutex_) {
+    auto it = tablets_.find(tablet_id);
+    return it == tablets_.end() ? 0 : std::max(it->second.current, it->second.previous);
+  }
+
+  void RotateIfNecessary() REQUIRES(mutex_) {
+    auto now = CoarseMonoClock::now();
+    if (now < interval_end_) {
+      return;
+    }
+    const auto interval = std::chrono::microseconds(FLAGS_transaction_heartbeat_usec);
+    const bool keep_current = now < interval_end_ + interval;
+    for (auto it = tablets_.begin(); it != tablets_.end();) {
+      it->second.previous = keep_current ? it->second.current : 0;
+      it->second.current = 0;
+      if (it->second.previous == 0) {
+        it = tablets_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    interval_end_ = now + interval;
+  }
+
+  simple_spinlock mutex_;
+  std::unordered_map<TabletId, Entry> tablets_ GUARDED_BY(mutex_);
+  CoarseTimePoint interval_end_ GUARDED_BY(mutex_);
+};
+
+// Batches PENDING heartbeats of transactions per status tablet.
+// There is at most one heartbeats RPC in flight per status tablet, unless the heartbeats queued
+// while it is in flight exceed the max batch size. Heartbeats requested while the RPC is in
+// flight are sent in the next RPC, right after the previous one completes. So under low load
+// heartbeats are sent immediately, and under high load the number of RPCs does not depend on
+// the number of transactions.
+class TransactionHeartbeatBatcher {
+ public:
+  TransactionHeartbeatBatcher(
+      YBClient* client, ClockBase* clock, rpc::Rpcs* rpcs, StatusTabletsLoad* load)
+      : client_(client), clock_(clock), rpcs_(*rpcs), load_(*load) {}
+
+  void Send(
+      const internal::RemoteTabletPtr& status_tablet, const TransactionId& transaction_id,
+      CoarseTimePoint deadline, TransactionHeartbeatCallback callback) EXCLUDES(mutex_) {
+    BatchPtr batch;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& queue = queues_[status_tablet->tablet_id()];
+      queue.heartbeats.push_back(Heartbeat {
+        .transaction_id = transaction_id,
+        .deadline = deadline,
+        .callback = std::move(callback),
+      });
+      if (queue.in_flight == 0 ||
+          queue.heartbeats.size() >= FLAGS_transaction_heartbeat_max_batch_size) {
+        batch = TakeBatch(status_tablet, &queue);
+      }
+    }
+    if (batch) {
+      SendBatch(batch);
+    }
+  }
+
+ private:
+  struct Heartbeat {
+    TransactionId transaction_id;
+    CoarseTimePoint deadline;
+    TransactionHeartbeatCallback callback;
+  };
+
+  struct Batch {
+    internal::RemoteTabletPtr status_tablet;
+    std::vector<Heartbeat> heartbeats;
+    rpc::Rpcs::Handle handle;
+  };
+
+  using BatchPtr = std::shared_ptr<Batch>;
+
+  struct Queue {
+    std::vector<Heartbeat> heartbeats;
+    size_t in_flight = 0;
+  };
+
+  BatchPtr TakeBatch(const internal::RemoteTabletPtr& status_tablet, Queue* queue)
+      REQUIRES(mutex_) {
+    auto batch = std::make_shared<Batch>();
+    batch->status_tablet = status_tablet;
+    batch->handle = rpcs_.InvalidHandle();
+    auto size = std::min<size_t>(
+        queue->heartbeats.size(),
+        std::max<uint64_t>(FLAGS_transaction_heartbeat_max_batch_size, 1));
+    auto begin = std::make_move_iterator(queue->heartbeats.begin());
+    batch->heartbeats.assign(begin, begin + size);
+    queue->heartbeats.erase(queue->heartbeats.begin(), queue->heartbeats.begin() + size);
+    ++queue->in_flight;
+    return batch;
+  }
+
+  void SendBatch(const BatchPtr& batch) {
+    load_.Add(batch->status_tablet->tablet_id(), batch->heartbeats.size());
+
+    tserver::HeartbeatTransactionsRequestPB req;
+    req.set_tablet_id(batch->status_tablet->tablet_id());
+    req.set_propagated_hybrid_time(clock_->Now().ToUint64());
+    auto deadline = CoarseTimePoint::min();
+    for (const auto& heartbeat : batch->heartbeats) {
+      req.add_transaction_ids(
+          heartbeat.transaction_id.data(), heartbeat.transaction_id.size());
+      deadline = std::max(deadline, heartbeat.deadline);
+    }
+    auto rpc = HeartbeatTransactions(
+        deadline, batch->status_tablet.get(), client_, &req,
+        [this, batch](
+            const Status& status, const tserver::HeartbeatTransactionsRequestPB& request,
+            const tserver::HeartbeatTransactionsResponsePB& response) {
+          rpcs_.Unregister(&batch->handle);
+          BatchDone(batch, status, response);
+        });
+    if (!rpcs_.RegisterAndStart(rpc, &batch->handle)) {
+      BatchDone(
+          batch, STATUS(Aborted, "Transaction manager is shutting down"),
+          tserver::HeartbeatTransactionsResponsePB());
+    }
+  }
+
+  void BatchDone(
+      const BatchPtr& batch, const Status& status,
+      const tserver::HeartbeatTransactionsResponsePB& response) {
+    if (response.has_propagated_hybrid_time()) {
+      clock_->Update(HybridTime(response.propagated_hybrid_time()));
+    }
+    VLOG(4) << "Sent " << batch->heartbeats.size() << " heartbeats to "
+            << batch->status_tablet->tablet_id() << ": " << status;
+    for (size_t i = 0; i != batch->heartbeats.size(); ++i) {
+      Status heartbeat_status;
+      if (!status.ok()) {
+        heartbeat_status = status;
+      } else if (i < static_cast<size_t>(response.statuses().size())) {
+        heartbeat_status = StatusFromPB(response.statuses(i));
+      } else {
+        heartbeat_status = STATUS_FORMAT(
+            IllegalState, "Missing status of heartbeat $0 in response of $1", i,
+            batch->heartbeats.size());
+      }
+      batch->heartbeats[i].callback(heartbeat_status);
+    }
+
+    BatchPtr next_batch;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = queues_.find(batch->status_tablet->tablet_id());
+      if (it == queues_.end()) {
+        LOG(DFATAL) << "Heartbeats queue of " << batch->status_tablet->tablet_id()
+                    << " not found";
+        return;
+      }
+      auto& queue = it->second;
+      --queue.in_flight;
+      if (queue.in_flight == 0) {
+        if (queue.heartbeats.empty()) {
+          queues_.erase(it);
+        } else {
+          next_batch = TakeBatch(batch->status_tablet, &queue);
+        }
+      }
+    }
+    if (next_batch) {
+      SendBatch(next_batch);
+    }
+  }
+
+  YBClient* const client_;
+  ClockBase* const clock_;
+  rpc::Rpcs& rpcs_;
+  StatusTabletsLoad& load_;
+
+  std::mutex mutex_;
+  std::unordered_map<TabletId, Queue> queues_ GUARDED_BY(mutex_);
+};
+
 // Cache of tablet ids of the global transaction table and any transaction tables with
 // the same placement.
 class TransactionTableState {
  public:
-  explicit TransactionTableState(LocalTabletFilter local_tablet_filter)
-      : local_tablet_filter_(local_tablet_filter) {
+  TransactionTableState(LocalTabletFilter local_tablet_filter, StatusTabletsLoad* load)
+      : local_tablet_filter_(local_tablet_filter), load_(*load) {
   }
 
   void InvokeCallback(const PickStatusTabletCallback& callback,
@@ -69,7 +300,7 @@ class TransactionTableState {
       return;
     }
     YB_LOG_EVERY_N_SECS(WARNING, 1) << "No local transaction status tablet found";
-    callback(RandomElement(tablets));
+    callback(load_.PickTablet(ToPointers(tablets)));
   }
 
   bool IsInitialized() {
@@ -110,23 +341,26 @@ class TransactionTableState {
       callback(FLAGS_TEST_transaction_manager_preferred_tablet);
       return true;
     }
+    auto ids = ToPointers(tablets);
     if (local_tablet_filter_) {
-      std::vector<const TabletId*> ids;
-      ids.reserve(tablets.size());
-      for (const auto& id : tablets) {
-        ids.push_back(&id);
-      }
       local_tablet_filter_(&ids);
-      if (!ids.empty()) {
-        callback(*RandomElement(ids));
-        return true;
+      if (ids.empty()) {
+        return false;
       }
-      return false;
     }
-    callback(RandomElement(tablets));
+    callback(load_.PickTablet(ids));
     return true;
   }
 
+  static std::vector<const TabletId*> ToPointers(const std::vector<TabletId>& tablets) {
+    std::vector<const TabletId*> result;
+    result.reserve(tablets.size());
+    for (const auto& id : tablets) {
+      result.push_back(&id);
+    }
+    return result;
+  }
+
   const std::vector<TabletId>& PickTabletList(TransactionLocality locality)
       REQUIRES_SHARED(mutex_) {
     if (tablets_.placement_local_tablets.empty()) {
@@ -142,6 +376,7 @@ class TransactionTableState {
   }
 
   LocalTabletFilter local_tablet_filter_;
+  StatusTabletsLoad& load_;
 
   // Set to true once transaction tablets have been loaded at least once. global_tablets
   // is assumed to have at least one entry in it if this is true.
@@ -243,12 +478,13 @@ class TransactionManager::Impl {
                 LocalTabletFilter local_tablet_filter)
       : client_(client),
         clock_(clock),
-        table_state_{std::move(local_tablet_filter)},
+        table_state_(std::move(local_tablet_filter), &status_tablets_load_),
         thread_pool_(
             "TransactionManager", FLAGS_transaction_manager_queue_limit,
             FLAGS_transaction_manager_workers_limit),
         tasks_pool_(FLAGS_transaction_manager_queue_limit),
-        invoke_callback_tasks_(FLAGS_transaction_manager_queue_limit) {
+        invoke_callback_tasks_(FLAGS_transaction_manager_queue_limit),
+        heartbeat_batcher_(client, clock.get(), &rpcs_, &status_tablets_load_) {
     CHECK(clock);
   }
 
@@ -300,6 +536,12 @@ class TransactionManager::Impl {
     }
   }
 
+  void SendHeartbeat(
+      const internal::RemoteTabletPtr& status_tablet, const TransactionId& transaction_id,
+      CoarseTimePoint deadline, TransactionHeartbeatCallback callback) {
+    heartbeat_batcher_.Send(status_tablet, transaction_id, deadline, std::move(callback));
+  }
+
   const scoped_refptr<ClockBase>& clock() const {
     return clock_;
   }
@@ -337,9 +579,35 @@ class TransactionManager::Impl {
     return table_state_.GetStatusTabletsVersion();
   }
 
+  void LocalTransactionStarted() {
+    std::lock_guard<simple_spinlock> lock(promotion_stats_mutex_);
+    // Counters are halved periodically, so the ratio reflects recent transactions.
+    if (++local_transactions_started_ >= kPromotionStatsWindow) {
+      local_transactions_started_ /= 2;
+      local_transactions_promoted_ /= 2;
+    }
+  }
+
+  void LocalTransactionPromoted() {
+    std::lock_guard<simple_spinlock> lock(promotion_stats_mutex_);
+    ++local_transactions_promoted_;
+  }
+
+  double LocalTransactionsPromotionRatio() {
+    std::lock_guard<simple_spinlock> lock(promotion_stats_mutex_);
+    if (local_transactions_started_ == 0) {
+      return 0;
+    }
+    return std::min(
+        static_cast<double>(local_transactions_promoted_) / local_transactions_started_, 1.0);
+  }
+
  private:
+  static constexpr uint64_t kPromotionStatsWindow = 1024;
+
   YBClient* const client_;
   scoped_refptr<ClockBase> clock_;
+  StatusTabletsLoad status_tablets_load_;
   TransactionTableState table_state_;
   std::atomic<bool> closed_{false};
 
@@ -347,6 +615,11 @@ class TransactionManager::Impl {
   yb::rpc::TasksPool<LoadStatusTabletsTask> tasks_pool_;
   yb::rpc::TasksPool<InvokeCallbackTask> invoke_callback_tasks_;
   yb::rpc::Rpcs rpcs_;
+  TransactionHeartbeatBatcher heartbeat_batcher_;
+
+  simple_spinlock promotion_stats_mutex_;
+  uint64_t local_transactions_started_ GUARDED_BY(promotion_stats_mutex_) = 0;
+  uint64_t local_transactions_promoted_ GUARDED_BY(promotion_stats_mutex_) = 0;
 };
 
 TransactionManager::TransactionManager(
@@ -366,6 +639,12 @@ void TransactionManager::PickStatusTablet(
   impl_->PickStatusTablet(std::move(callback), locality);
 }
 
+void TransactionManager::SendHeartbeat(
+    const internal::RemoteTabletPtr& status_tablet, const TransactionId& transaction_id,
+    CoarseTimePoint deadline, TransactionHeartbeatCallback callback) {
+  impl_->SendHeartbeat(status_tablet, transaction_id, deadline, std::move(callback));
+}
+
 YBClient* TransactionManager::client() const {
   return impl_->client();
 }
@@ -394,6 +673,18 @@ bool TransactionManager::PlacementLocalTransactionsPossible() {
   return impl_->PlacementLocalTransactionsPossible();
 }
 
+void TransactionManager::LocalTransactionStarted() {
+  impl_->LocalTransactionStarted();
+}
+
+void TransactionManager::LocalTransactionPromoted() {
+  impl_->LocalTransactionPromoted();
+}
+
+double TransactionManager::LocalTransactionsPromotionRatio() {
+  return impl_->LocalTransactionsPromotionRatio();
+}
+
 uint64_t TransactionManager::GetLoadedStatusTabletsVersion() {
   return impl_->GetLoadedStatusTabletsVersion();
 }
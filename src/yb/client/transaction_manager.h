@@ -22,6 +22,7 @@
 
 #include "yb/common/clock.h"
 #include "yb/common/hybrid_time.h"
+#include "yb/common/transaction.h"
 #include "yb/common/transaction.pb.h"
 
 #include "yb/rpc/rpc_fwd.h"
@@ -31,6 +32,7 @@ namespace client {
 
 using PickStatusTabletCallback = std::function<void(const Result<std::string>&)>;
 using UpdateTransactionTablesVersionCallback = std::function<void(const Status&)>;
+using TransactionHeartbeatCallback = std::function<void(const Status&)>;
 
 // TransactionManager manages multiple transactions. It lives at the YQL engine layer.
 class TransactionManager {
@@ -48,8 +50,17 @@ class TransactionManager {
       uint64_t version,
       UpdateTransactionTablesVersionCallback callback = UpdateTransactionTablesVersionCallback());
 
+  // Picks the less loaded of two random status tablets, where load is the number of transactions
+  // of this process that recently picked the tablet or sent heartbeats to it.
   void PickStatusTablet(PickStatusTabletCallback callback, TransactionLocality locality);
 
+  // Sends PENDING heartbeat of the transaction to its status tablet. Heartbeats to the same status
+  // tablet, that are requested while the previous heartbeats to it are in flight, are sent
+  // together in a single RPC.
+  void SendHeartbeat(
+      const internal::RemoteTabletPtr& status_tablet, const TransactionId& transaction_id,
+      CoarseTimePoint deadline, TransactionHeartbeatCallback callback);
+
   rpc::Rpcs& rpcs();
   YBClient* client() const;
 
@@ -61,6 +72,14 @@ class TransactionManager {
 
   bool PlacementLocalTransactionsPossible();
 
+  // Statistics of local transactions promotion, used to predict whether a new transaction would
+  // need to be global.
+  void LocalTransactionStarted();
+  void LocalTransactionPromoted();
+
+  // Returns fraction of recently started local transactions, that were promoted to global.
+  double LocalTransactionsPromotionRatio();
+
   uint64_t GetLoadedStatusTabletsVersion();
 
   void Shutdown();
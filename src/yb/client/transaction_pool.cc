@@ -28,6 +28,7 @@
 #include "yb/rpc/scheduler.h"
 
 #include "yb/util/metrics.h"
+#include "yb/util/random_util.h"
 #include "yb/util/result.h"
 #include "yb/util/trace.h"
 
@@ -44,6 +45,15 @@ DEFINE_double(transaction_pool_reserve_factor, 2,
 DEFINE_bool(force_global_transactions, false,
             "Force all transactions to be global transactions");
 
+DEFINE_RUNTIME_double(transaction_pool_global_prediction_threshold, 0.5,
+    "When fraction of recent local transactions, that were promoted to global, is above this "
+    "threshold, new transactions are taken from the pool of global transactions, so first write "
+    "does not wait for the promotion. 0 disables prediction.");
+
+DEFINE_RUNTIME_int32(transaction_pool_global_prediction_probe_1_in_n, 16,
+    "While global transactions are predicted, every Nth transaction is still started as local, "
+    "to detect that workload became placement local again.");
+
 DEFINE_test_flag(bool, track_last_transaction, false,
                  "Keep track of the last transaction taken from pool for testing");
 
@@ -277,7 +287,11 @@ class TransactionPool::Impl {
       ForceGlobalTransaction force_global_transaction, CoarseTimePoint deadline) EXCLUDES(mutex_) {
     const auto is_global = force_global_transaction ||
                            FLAGS_force_global_transactions ||
-                           !manager_->PlacementLocalTransactionsPossible();
+                           !manager_->PlacementLocalTransactionsPossible() ||
+                           PromotionToGlobalPredicted();
+    if (!is_global) {
+      manager_->LocalTransactionStarted();
+    }
     auto transaction = (is_global ? &global_pool_ : &local_pool_)->Take(deadline);
     if (FLAGS_TEST_track_last_transaction) {
       std::lock_guard<std::mutex> lock(mutex_);
@@ -292,6 +306,15 @@ class TransactionPool::Impl {
     return last_transaction_;
   }
  private:
+  bool PromotionToGlobalPredicted() {
+    auto threshold = GetAtomicFlag(&FLAGS_transaction_pool_global_prediction_threshold);
+    if (threshold <= 0 || manager_->LocalTransactionsPromotionRatio() < threshold) {
+      return false;
+    }
+    auto probe_1_in_n = GetAtomicFlag(&FLAGS_transaction_pool_global_prediction_probe_1_in_n);
+    return probe_1_in_n <= 0 || !RandomActWithProbability(1.0 / probe_1_in_n);
+  }
+
   TransactionManager* manager_;
   SingleLocalityPool global_pool_;
   SingleLocalityPool local_pool_;
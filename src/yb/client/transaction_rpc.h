@@ -34,6 +34,7 @@ class HybridTime;
 
 #define TRANSACTION_RPCS \
     ((UpdateTransaction, WITH_REQUEST)) \
+    ((HeartbeatTransactions, WITH_REQUEST)) \
     ((GetTransactionStatus, WITHOUT_REQUEST)) \
     ((GetTransactionStatusAtParticipant, WITHOUT_REQUEST)) \
     ((AbortTransaction, WITHOUT_REQUEST)) \
@@ -453,8 +453,8 @@ bool YBOperation::IsYsqlCatalogOp() const {
   return table_->schema().table_properties().is_ysql_catalog_table();
 }
 
-void YBOperation::MarkTablePartitionListAsStale() {
-  table_->MarkPartitionsAsStale();
+bool YBOperation::MarkTablePartitionListAsStale() {
+  return table_->MarkPartitionsAsStale();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -601,6 +601,10 @@ std::string YBqlWriteOp::ToString() const {
   return "QL_WRITE " + ql_write_request_->ShortDebugString();
 }
 
+size_t YBqlWriteOp::request_size() const {
+  return request().ByteSizeLong();
+}
+
 Status YBqlWriteOp::GetPartitionKey(string* partition_key) const {
   return table_->partition_schema().EncodeKey(ql_write_request_->hashed_column_values(),
                                               partition_key);
@@ -748,6 +752,10 @@ std::string YBqlReadOp::ToString() const {
   return "QL_READ " + ql_read_request_->DebugString();
 }
 
+size_t YBqlReadOp::request_size() const {
+  return request().ByteSizeLong();
+}
+
 void YBqlReadOp::SetHashCode(const uint16_t hash_code) {
   ql_read_request_->set_hash_code(hash_code);
 }
@@ -920,12 +928,21 @@ std::unique_ptr<YBPgsqlWriteOp> YBPgsqlWriteOp::NewTruncateColocated(
   return NewYBPgsqlWriteOp(table, PgsqlWriteRequestPB::PGSQL_TRUNCATE_COLOCATED);
 }
 
+std::unique_ptr<YBPgsqlWriteOp> YBPgsqlWriteOp::NewDeleteRange(
+    const std::shared_ptr<YBTable>& table) {
+  return NewYBPgsqlWriteOp(table, PgsqlWriteRequestPB::PGSQL_DELETE_RANGE);
+}
+
 std::string YBPgsqlWriteOp::ToString() const {
   return Format(
       "PGSQL_WRITE $0$1$2", request_->ShortDebugString(),
       (write_time_ ? " write_time: " + write_time_.ToString() : ""), ResponseSuffix(response()));
 }
 
+size_t YBPgsqlWriteOp::request_size() const {
+  return request().ByteSizeLong();
+}
+
 void YBPgsqlWriteOp::SetHashCode(const uint16_t hash_code) {
   request_->set_hash_code(hash_code);
 }
@@ -979,6 +996,10 @@ std::string YBPgsqlReadOp::ToString() const {
   return "PGSQL_READ " + request_->ShortDebugString() + ResponseSuffix(response());
 }
 
+size_t YBPgsqlReadOp::request_size() const {
+  return request().ByteSizeLong();
+}
+
 void YBPgsqlReadOp::SetHashCode(const uint16_t hash_code) {
   request_->set_hash_code(hash_code);
 }
@@ -111,6 +111,9 @@ class YBOperation {
   virtual bool succeeded() const = 0;
   virtual bool returns_sidecar() = 0;
 
+  // Approximate serialized size of the request, used to bound size of the batched RPCs.
+  virtual size_t request_size() const = 0;
+
   virtual OpGroup group() {
     return read_only() ? OpGroup::kLeaderRead : OpGroup::kWrite;
   }
@@ -157,7 +160,8 @@ class YBOperation {
   bool IsYsqlCatalogOp() const;
 
   // Mark table this op is designated for as having stale partitions.
-  void MarkTablePartitionListAsStale();
+  // Returns true if partitions were not marked as stale before this call.
+  bool MarkTablePartitionListAsStale();
 
   // If partition_list_version is set YBSession guarantees that this operation instance won't
   // be applied to the tablet with a different table partition_list_version (meaning serving
@@ -205,6 +209,8 @@ class YBRedisOp : public YBOperation {
   bool has_response() { return redis_response_ ? true : false; }
   virtual size_t space_used_by_request() const = 0;
 
+  size_t request_size() const override { return space_used_by_request(); }
+
   const RedisResponsePB& response() const;
 
   RedisResponsePB* mutable_response();
@@ -326,6 +332,8 @@ class YBqlWriteOp : public YBqlOp {
 
   std::string ToString() const override;
 
+  size_t request_size() const override;
+
   bool read_only() const override { return false; };
 
   bool returns_sidecar() override;
@@ -396,6 +404,8 @@ class YBqlReadOp : public YBqlOp {
 
   std::string ToString() const override;
 
+  size_t request_size() const override;
+
   bool read_only() const override { return true; };
 
   bool returns_sidecar() override { return true; }
@@ -492,6 +502,8 @@ class YBPgsqlWriteOp : public YBPgsqlOp {
 
   std::string ToString() const override;
 
+  size_t request_size() const override;
+
   bool read_only() const override { return false; };
 
   // TODO check for e.g. returning clause.
@@ -512,6 +524,7 @@ class YBPgsqlWriteOp : public YBPgsqlOp {
   static std::unique_ptr<YBPgsqlWriteOp> NewUpdate(const YBTablePtr& table);
   static std::unique_ptr<YBPgsqlWriteOp> NewDelete(const YBTablePtr& table);
   static std::unique_ptr<YBPgsqlWriteOp> NewTruncateColocated(const YBTablePtr& table);
+  static std::unique_ptr<YBPgsqlWriteOp> NewDeleteRange(const YBTablePtr& table);
 
  protected:
   virtual Type type() const override { return PGSQL_WRITE; }
@@ -545,6 +558,8 @@ class YBPgsqlReadOp : public YBPgsqlOp {
 
   std::string ToString() const override;
 
+  size_t request_size() const override;
+
   bool read_only() const override { return true; };
 
   bool returns_sidecar() override { return true; }
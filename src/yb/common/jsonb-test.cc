@@ -13,17 +13,21 @@
 
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <rapidjson/prettywriter.h>
 
+#include "yb/common/common.pb.h"
 #include "yb/common/jsonb.h"
+#include "yb/common/ql_value.h"
 
 #include "yb/gutil/dynamic_annotations.h"
 
 #include "yb/util/status.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/tostring.h"
+#include "yb/util/varint.h"
 
 using std::to_string;
 using std::numeric_limits;
@@ -158,5 +162,85 @@ TEST(JsonbTest, TestArrays) {
   VerifyArray(document);
 }
 
+void AddJsonOperation(
+    JsonOperatorPB json_operator, QLJsonColumnOperationsPB* json_ops, const std::string& key) {
+  auto* op = json_ops->add_json_operations();
+  op->set_json_operator(json_operator);
+  op->mutable_operand()->mutable_value()->set_string_value(key);
+}
+
+void AddJsonOperation(
+    JsonOperatorPB json_operator, QLJsonColumnOperationsPB* json_ops, int64_t index) {
+  auto* op = json_ops->add_json_operations();
+  op->set_json_operator(json_operator);
+  op->mutable_operand()->mutable_value()->set_varint_value(
+      util::VarInt(index).EncodeToComparable());
+}
+
+TEST(JsonbTest, TestOperators) {
+  Jsonb jsonb;
+  ASSERT_OK(jsonb.FromString(R"#(
+        { "a" : 1, "b" : { "c" : [10, "x", { "d" : "y" }] }, "e" : "z", "f" : null }
+      )#"));
+
+  auto apply = [&jsonb](const QLJsonColumnOperationsPB& json_ops) -> Result<QLValuePB> {
+    QLValuePB result;
+    RETURN_NOT_OK(Jsonb::ApplyJsonbOperators(jsonb.SerializedJsonb(), json_ops, &result));
+    return result;
+  };
+
+  {
+    // b->c->2->>d
+    QLJsonColumnOperationsPB json_ops;
+    AddJsonOperation(JsonOperatorPB::JSON_OBJECT, &json_ops, "b");
+    AddJsonOperation(JsonOperatorPB::JSON_OBJECT, &json_ops, "c");
+    AddJsonOperation(JsonOperatorPB::JSON_OBJECT, &json_ops, 2);
+    AddJsonOperation(JsonOperatorPB::JSON_TEXT, &json_ops, "d");
+    auto result = ASSERT_RESULT(apply(json_ops));
+    ASSERT_EQ(result.string_value(), "y");
+  }
+
+  {
+    // b->c->>0
+    QLJsonColumnOperationsPB json_ops;
+    AddJsonOperation(JsonOperatorPB::JSON_OBJECT, &json_ops, "b");
+    AddJsonOperation(JsonOperatorPB::JSON_OBJECT, &json_ops, "c");
+    AddJsonOperation(JsonOperatorPB::JSON_TEXT, &json_ops, 0);
+    auto result = ASSERT_RESULT(apply(json_ops));
+    ASSERT_EQ(result.string_value(), "10");
+  }
+
+  {
+    // b->c returns jsonb of the nested array.
+    QLJsonColumnOperationsPB json_ops;
+    AddJsonOperation(JsonOperatorPB::JSON_OBJECT, &json_ops, "b");
+    AddJsonOperation(JsonOperatorPB::JSON_OBJECT, &json_ops, "c");
+    auto result = ASSERT_RESULT(apply(json_ops));
+    std::string json;
+    ASSERT_OK(Jsonb(result.jsonb_value()).ToJsonString(&json));
+    ASSERT_EQ(json, R"#([10,"x",{"d":"y"}])#");
+  }
+
+  // Missing keys, out of bounds indexes, wrong operand types and operators applied to scalars
+  // result in null.
+  for (const auto& path : std::vector<std::vector<std::string>>{
+           {"0"}, {"b", "d"}, {"a", "b"}, {"e", "x"}, {"f", "x"}, {"aa"}, {""}}) {
+    QLJsonColumnOperationsPB json_ops;
+    for (const auto& key : path) {
+      AddJsonOperation(JsonOperatorPB::JSON_OBJECT, &json_ops, key);
+    }
+    auto result = ASSERT_RESULT(apply(json_ops));
+    ASSERT_TRUE(IsNull(result)) << AsString(path) << ": " << result.ShortDebugString();
+  }
+  {
+    QLJsonColumnOperationsPB json_ops;
+    AddJsonOperation(JsonOperatorPB::JSON_OBJECT, &json_ops, "b");
+    AddJsonOperation(JsonOperatorPB::JSON_OBJECT, &json_ops, "c");
+    AddJsonOperation(JsonOperatorPB::JSON_OBJECT, &json_ops, 3);
+    auto result = ASSERT_RESULT(apply(json_ops));
+    ASSERT_TRUE(IsNull(result)) << result.ShortDebugString();
+  }
+}
+
 }  // namespace common
 }  // namespace yb
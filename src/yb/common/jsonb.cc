@@ -671,11 +671,12 @@ Status Jsonb::ToJsonStringInternal(const Slice& jsonb, std::string* json) {
   return Status::OK();
 }
 
-Status Jsonb::ApplyJsonbOperatorToArray(const Slice& jsonb, const QLJsonOperationPB& json_op,
-                                        const JsonbHeader& jsonb_header,
-                                        Slice* result, JEntry* element_metadata) {
+Result<bool> Jsonb::ApplyJsonbOperatorToArray(const Slice& jsonb,
+                                              const QLJsonOperationPB& json_op,
+                                              const JsonbHeader& jsonb_header,
+                                              Slice* result, JEntry* element_metadata) {
   if(!json_op.operand().value().has_varint_value()) {
-    return STATUS_SUBSTITUTE(NotFound, "Couldn't apply json operator");
+    return false;
   }
 
   // For arrays, the argument needs to be an integer.
@@ -687,49 +688,50 @@ Status Jsonb::ApplyJsonbOperatorToArray(const Slice& jsonb, const QLJsonOperatio
   int64_t array_index = VERIFY_RESULT(varint.ToInt64());
 
   if (array_index < 0 || implicit_cast<size_t>(array_index) >= num_array_entries) {
-    return STATUS_SUBSTITUTE(NotFound, "Array index: $0 out of bounds [0, $1)",
-                             array_index, num_array_entries);
+    return false;
   }
 
   RETURN_NOT_OK(GetArrayElement(array_index, jsonb, sizeof(jsonb_header),
                                 ComputeDataOffset(num_array_entries, kJBArray), result,
                                 element_metadata));
-  return Status::OK();
+  return true;
 }
 
-Status Jsonb::ApplyJsonbOperatorToObject(const Slice& jsonb, const QLJsonOperationPB& json_op,
-                                         const JsonbHeader& jsonb_header,
-                                         Slice* result, JEntry* element_metadata) {
+Result<bool> Jsonb::ApplyJsonbOperatorToObject(const Slice& jsonb,
+                                               const QLJsonOperationPB& json_op,
+                                               const JsonbHeader& jsonb_header,
+                                               Slice* result, JEntry* element_metadata) {
   if (!json_op.operand().value().has_string_value()) {
-    return STATUS_SUBSTITUTE(NotFound, "Couldn't apply json operator");
+    return false;
   }
 
   size_t num_kv_pairs = GetCount(jsonb_header);
-  const string& search_key = json_op.operand().value().string_value();
+  Slice search_key(json_op.operand().value().string_value());
 
   size_t metadata_begin_offset = sizeof(jsonb_header);
   size_t data_begin_offset = ComputeDataOffset(num_kv_pairs, kJBObject);
 
-  // Binary search to find the key.
-  int64_t low = 0, high = num_kv_pairs - 1;
-  auto search_key_slice = Slice(search_key);
-  while (low <= high) {
-    size_t mid = low + (high - low)/2;
+  // Binary search to find the key. Keys are stored in the order of std::string comparison, that
+  // is the same as bytewise comparison of slices, so they are compared in place.
+  size_t low = 0, high = num_kv_pairs;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
     Slice mid_key;
     RETURN_NOT_OK(GetObjectKey(mid, jsonb, metadata_begin_offset, data_begin_offset, &mid_key));
 
-    if (mid_key == search_key_slice) {
-      RETURN_NOT_OK(GetObjectValue(mid, jsonb, sizeof(jsonb_header),
-                                   ComputeDataOffset(num_kv_pairs, kJBObject), num_kv_pairs,
-                                   result, element_metadata));
-      return Status::OK();
-    } else if (mid_key.ToBuffer() > search_key) {
-      high = mid - 1;
+    auto compare_result = mid_key.compare(search_key);
+    if (compare_result == 0) {
+      RETURN_NOT_OK(GetObjectValue(mid, jsonb, metadata_begin_offset, data_begin_offset,
+                                   num_kv_pairs, result, element_metadata));
+      return true;
+    }
+    if (compare_result > 0) {
+      high = mid;
     } else {
       low = mid + 1;
     }
   }
-  return STATUS_SUBSTITUTE(NotFound, "Couldn't find key $0 in json document", search_key);
+  return false;
 }
 
 Status Jsonb::ApplyJsonbOperators(const std::string &serialized_json,
@@ -742,14 +744,11 @@ Status Jsonb::ApplyJsonbOperators(const std::string &serialized_json,
   JEntry element_metadata;
   for (int i = 0; i < num_ops; i++) {
     const QLJsonOperationPB &op = json_ops.json_operations().Get(i);
-    const Status s = ApplyJsonbOperator(operand, op, &jsonop_result,
-                                        &element_metadata);
-    if (s.IsNotFound()) {
+    if (!VERIFY_RESULT(ApplyJsonbOperator(operand, op, &jsonop_result, &element_metadata))) {
       // We couldn't apply the operator to the operand and hence return null as the result.
       SetNull(result);
       return Status::OK();
     }
-    RETURN_NOT_OK(s);
 
     if (IsScalar(element_metadata) && i != num_ops - 1) {
       // We have to apply another operation after this, but we received a scalar intermediate
@@ -785,8 +784,8 @@ Status Jsonb::ApplyJsonbOperators(const std::string &serialized_json,
   return Status::OK();
 }
 
-Status Jsonb::ApplyJsonbOperator(const Slice& jsonb, const QLJsonOperationPB& json_op,
-                                 Slice* result, JEntry* element_metadata) {
+Result<bool> Jsonb::ApplyJsonbOperator(const Slice& jsonb, const QLJsonOperationPB& json_op,
+                                       Slice* result, JEntry* element_metadata) {
   // Currently, both these operators are considered the same since we only handle strings.
   DCHECK(json_op.json_operator() == JsonOperatorPB::JSON_OBJECT ||
          json_op.json_operator() == JsonOperatorPB::JSON_TEXT);
@@ -801,7 +800,7 @@ Status Jsonb::ApplyJsonbOperator(const Slice& jsonb, const QLJsonOperationPB& js
   JsonbHeader jsonb_header = BigEndian::Load32(jsonb.data());
   if ((jsonb_header & kJBScalar) && (jsonb_header & kJBArray)) {
     // This is a scalar value and no operators can be applied to it.
-    return STATUS(NotFound, "Cannot apply operators to scalar values");
+    return false;
   } else if (jsonb_header & kJBArray) {
     return ApplyJsonbOperatorToArray(jsonb, json_op, jsonb_header, result, element_metadata);
   } else if (jsonb_header & kJBObject) {
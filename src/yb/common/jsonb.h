@@ -104,9 +104,11 @@ class Jsonb {
   std::string serialized_jsonb_;
 
   // Given a jsonb slice, it applies the given operator to the slice and returns the result as a
-  // Slice and the element's metadata.
-  static Status ApplyJsonbOperator(const Slice& jsonb, const QLJsonOperationPB& json_op,
-                                           Slice* result, JEntry* element_metadata);
+  // Slice and the element's metadata. Returns false when the operator could not be applied, i.e.
+  // the key or index is missing, without building an error status, since misses are common in
+  // filters.
+  static Result<bool> ApplyJsonbOperator(const Slice& jsonb, const QLJsonOperationPB& json_op,
+                                         Slice* result, JEntry* element_metadata);
 
   static bool IsScalar(const JEntry& jentry);
 
@@ -182,17 +184,17 @@ class Jsonb {
                                                       size_t data_begin_offset,
                                                       size_t metadata_begin_offset);
 
-  static Status ApplyJsonbOperatorToArray(const Slice& jsonb,
-                                                  const QLJsonOperationPB& json_op,
-                                                  const JsonbHeader& jsonb_header,
-                                                  Slice* result,
-                                                  JEntry* element_metadata);
-
-  static Status ApplyJsonbOperatorToObject(const Slice& jsonb,
-                                                   const QLJsonOperationPB& json_op,
-                                                   const JsonbHeader& jsonb_header,
-                                                   Slice* result,
-                                                   JEntry* element_metadata);
+  static Result<bool> ApplyJsonbOperatorToArray(const Slice& jsonb,
+                                                const QLJsonOperationPB& json_op,
+                                                const JsonbHeader& jsonb_header,
+                                                Slice* result,
+                                                JEntry* element_metadata);
+
+  static Result<bool> ApplyJsonbOperatorToObject(const Slice& jsonb,
+                                                 const QLJsonOperationPB& json_op,
+                                                 const JsonbHeader& jsonb_header,
+                                                 Slice* result,
+                                                 JEntry* element_metadata);
 
   static inline uint32_t GetOffset(JEntry metadata) { return metadata & kJEOffsetMask; }
 
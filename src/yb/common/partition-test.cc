@@ -120,4 +120,26 @@ TEST(PartitionTest, TestRedisEncoding) {
   ASSERT_EQ(pk1, pk2);
 }
 
+
+TEST(PartitionTest, TestHashPartitionIndexes) {
+  const vector<string> compounds = { "", "a", "key1", "some longer compound value" };
+  vector<Slice> slices(compounds.begin(), compounds.end());
+  vector<uint16_t> hash_codes;
+  PartitionSchema::HashColumnCompoundValues(slices, &hash_codes);
+  ASSERT_EQ(hash_codes.size(), compounds.size());
+  for (size_t i = 0; i != compounds.size(); ++i) {
+    ASSERT_EQ(hash_codes[i], PartitionSchema::HashColumnCompoundValue(compounds[i]));
+  }
+
+  const vector<string> partition_keys = {
+    "",
+    PartitionSchema::EncodeMultiColumnHashValue(0x4000),
+    PartitionSchema::EncodeMultiColumnHashValue(0x8000),
+    PartitionSchema::EncodeMultiColumnHashValue(0xc000),
+  };
+  hash_codes = { 0, 0x3fff, 0x4000, 0x4001, 0x8000, 0xbfff, 0xc000, 0xffff };
+  ASSERT_EQ(PartitionSchema::FindHashPartitionIndexes(partition_keys, hash_codes),
+            (vector<size_t>{ 0, 0, 1, 1, 2, 2, 3, 3 }));
+}
+
 } // namespace yb
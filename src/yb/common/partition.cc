@@ -1233,24 +1233,38 @@ Status PartitionSchema::EncodeColumns(const YBPartialRow& row,
   return Status::OK();
 }
 
-uint16_t PartitionSchema::HashColumnCompoundValue(const string& compound) {
-  // In the future, if you wish to change the hashing behavior, you must introduce a new hashing
-  // method for your newly-created tables.  Existing tables must continue to use their hashing
-  // methods that was define by their PartitionSchema.
-
-  // At the moment, Jenkins' hash is the only method we are using. In the future, we'll keep this
-  // as the default hashing behavior. Constant 'kseed" cannot be changed as it'd yield a different
-  // hashing result.
-  static const int kseed = 97;
-  const uint64_t hash_value = Hash64StringWithSeed(compound, kseed);
-
-  // Convert the 64-bit hash value to 16 bit integer.
-  const uint64_t h1 = hash_value >> 48;
-  const uint64_t h2 = 3 * (hash_value >> 32);
-  const uint64_t h3 = 5 * (hash_value >> 16);
-  const uint64_t h4 = 7 * (hash_value & 0xffff);
-
-  return (h1 ^ h2 ^ h3 ^ h4) & 0xffff;
+uint16_t PartitionSchema::HashColumnCompoundValue(Slice compound) {
+  return YBPartition::HashColumnCompoundValue(compound);
+}
+
+void PartitionSchema::HashColumnCompoundValues(
+    const std::vector<Slice>& compounds, std::vector<uint16_t>* hash_codes) {
+  hash_codes->clear();
+  hash_codes->reserve(compounds.size());
+  for (const auto& compound : compounds) {
+    hash_codes->push_back(YBPartition::HashColumnCompoundValue(compound));
+  }
+}
+
+std::vector<size_t> PartitionSchema::FindHashPartitionIndexes(
+    const std::vector<PartitionKey>& partition_keys, const std::vector<uint16_t>& hash_codes) {
+  // Decode partition bounds once, so each row is looked up with integer comparisons, instead of
+  // encoding its hash code and comparing strings.
+  std::vector<uint16_t> partition_starts;
+  partition_starts.reserve(partition_keys.size());
+  for (const auto& key : partition_keys) {
+    partition_starts.push_back(key.empty() ? 0 : DecodeMultiColumnHashValue(key));
+  }
+  DCHECK(!partition_starts.empty() && partition_starts.front() == 0)
+      << "Hash partitions should cover the whole hash space: " << AsString(partition_keys);
+
+  std::vector<size_t> result;
+  result.reserve(hash_codes.size());
+  for (auto hash_code : hash_codes) {
+    auto it = std::upper_bound(partition_starts.begin(), partition_starts.end(), hash_code);
+    result.push_back(it - partition_starts.begin() - 1);
+  }
+  return result;
 }
 
 // Encodes the hash columns of the supplied row into a 2-byte partition key.
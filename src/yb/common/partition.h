@@ -408,7 +408,17 @@ class PartitionSchema {
                               std::string* buf);
 
   // Hashes a compound string of all columns into a 16-bit integer.
-  static uint16_t HashColumnCompoundValue(const std::string& compound);
+  static uint16_t HashColumnCompoundValue(Slice compound);
+
+  // Hashes compound strings of multiple rows, the same way HashColumnCompoundValue does.
+  static void HashColumnCompoundValues(
+      const std::vector<Slice>& compounds, std::vector<uint16_t>* hash_codes);
+
+  // Returns the index of the hash partition containing each of the specified hash codes.
+  // partition_keys are sorted start keys of the table partitions, the same as used by
+  // client::FindPartitionStartIndex, the first one being empty.
+  static std::vector<size_t> FindHashPartitionIndexes(
+      const std::vector<PartitionKey>& partition_keys, const std::vector<uint16_t>& hash_codes);
 
   // Encodes the specified columns of a row into 2-byte partition key using the multi column
   // hashing scheme.
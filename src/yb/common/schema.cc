@@ -156,6 +156,19 @@ bool ColumnSchema::TEST_Equals(const ColumnSchema& lhs, const ColumnSchema& rhs)
 
 const TableId kNoCopartitionTableId = "";
 
+namespace {
+
+std::vector<ColumnId> ColumnStatsIdsFromPB(const TablePropertiesPB& pb) {
+  std::vector<ColumnId> result;
+  result.reserve(pb.column_stats_ids().size());
+  for (auto id : pb.column_stats_ids()) {
+    result.emplace_back(id);
+  }
+  return result;
+}
+
+} // namespace
+
 void TableProperties::ToTablePropertiesPB(TablePropertiesPB *pb) const {
   if (HasDefaultTimeToLive()) {
     pb->set_default_time_to_live(default_time_to_live_);
@@ -173,6 +186,12 @@ void TableProperties::ToTablePropertiesPB(TablePropertiesPB *pb) const {
   pb->set_is_ysql_catalog_table(is_ysql_catalog_table_);
   pb->set_retain_delete_markers(retain_delete_markers_);
   pb->set_partitioning_version(partitioning_version_);
+  if (bloom_filter_range_components_) {
+    pb->set_bloom_filter_range_components(bloom_filter_range_components_);
+  }
+  for (const auto& column_id : column_stats_ids_) {
+    pb->add_column_stats_ids(column_id.rep());
+  }
 }
 
 TableProperties TableProperties::FromTablePropertiesPB(const TablePropertiesPB& pb) {
@@ -206,6 +225,10 @@ TableProperties TableProperties::FromTablePropertiesPB(const TablePropertiesPB&
   }
   table_properties.set_partitioning_version(
       pb.has_partitioning_version() ? pb.partitioning_version() : 0);
+  if (pb.has_bloom_filter_range_components()) {
+    table_properties.SetBloomFilterRangeComponents(pb.bloom_filter_range_components());
+  }
+  table_properties.SetColumnStatsIds(ColumnStatsIdsFromPB(pb));
   return table_properties;
 }
 
@@ -235,6 +258,12 @@ void TableProperties::AlterFromTablePropertiesPB(const TablePropertiesPB& pb) {
     SetRetainDeleteMarkers(pb.retain_delete_markers());
   }
   set_partitioning_version(pb.has_partitioning_version() ? pb.partitioning_version() : 0);
+  if (pb.has_bloom_filter_range_components()) {
+    SetBloomFilterRangeComponents(pb.bloom_filter_range_components());
+  }
+  if (!pb.column_stats_ids().empty()) {
+    SetColumnStatsIds(ColumnStatsIdsFromPB(pb));
+  }
 }
 
 void TableProperties::Reset() {
@@ -250,6 +279,8 @@ void TableProperties::Reset() {
   partitioning_version_ =
       PREDICT_TRUE(FLAGS_TEST_partitioning_version < 0) ? kCurrentPartitioningVersion
                                                         : FLAGS_TEST_partitioning_version;
+  bloom_filter_range_components_ = 0;
+  column_stats_ids_.clear();
 }
 
 string TableProperties::ToString() const {
@@ -262,6 +293,12 @@ string TableProperties::ToString() const {
   if (HasCopartitionTableId()) {
     result += Format("copartition_table_id: $0 ", copartition_table_id_);
   }
+  if (bloom_filter_range_components_) {
+    result += Format("bloom_filter_range_components: $0 ", bloom_filter_range_components_);
+  }
+  if (!column_stats_ids_.empty()) {
+    result += Format("column_stats_ids: $0 ", column_stats_ids_);
+  }
   return result + Format(
       "consistency_level: $0 is_ysql_catalog_table: $1 partitioning_version: $2 }",
       consistency_level_,
@@ -334,6 +334,8 @@ class TableProperties {
     // Ignoring num_tablets_.
     // Ignoring retain_delete_markers_.
     // Ignoring partitioning_version_.
+    // Ignoring bloom_filter_range_components_.
+    // Ignoring column_stats_ids_.
   }
 
   bool operator!=(const TableProperties& other) const {
@@ -365,6 +367,8 @@ class TableProperties {
     // Ignoring contain_counters_.
     // Ignoring retain_delete_markers_.
     // Ignoring partitioning_version_.
+    // Ignoring bloom_filter_range_components_.
+    // Ignoring column_stats_ids_.
     return true;
   }
 
@@ -460,6 +464,22 @@ class TableProperties {
     partitioning_version_ = value;
   }
 
+  uint32_t bloom_filter_range_components() const {
+    return bloom_filter_range_components_;
+  }
+
+  void SetBloomFilterRangeComponents(uint32_t value) {
+    bloom_filter_range_components_ = value;
+  }
+
+  const std::vector<ColumnId>& column_stats_ids() const {
+    return column_stats_ids_;
+  }
+
+  void SetColumnStatsIds(std::vector<ColumnId> value) {
+    column_stats_ids_ = std::move(value);
+  }
+
   void ToTablePropertiesPB(TablePropertiesPB *pb) const;
 
   static TableProperties FromTablePropertiesPB(const TablePropertiesPB& pb);
@@ -485,6 +505,8 @@ class TableProperties {
   int num_tablets_;
   bool is_ysql_catalog_table_;
   uint32_t partitioning_version_;
+  uint32_t bloom_filter_range_components_;
+  std::vector<ColumnId> column_stats_ids_;
 };
 
 typedef std::string PgSchemaName;
@@ -76,7 +76,11 @@ class TransactionStatusManagerMock : public TransactionStatusManager {
   }
 
   HybridTime MinRunningHybridTime() const override {
-    return HybridTime::kMin;
+    return min_running_ht_;
+  }
+
+  void SetMinRunningHybridTime(HybridTime value) {
+    min_running_ht_ = value;
   }
 
   Result<HybridTime> WaitForSafeTime(HybridTime safe_time, CoarseTimePoint deadline) override {
@@ -90,6 +94,7 @@ class TransactionStatusManagerMock : public TransactionStatusManager {
 
  private:
   std::unordered_map<TransactionId, HybridTime, TransactionIdHash> txn_commit_time_;
+  HybridTime min_running_ht_ = HybridTime::kMin;
 };
 
 } // namespace yb
@@ -112,7 +112,10 @@ inline std::ostream& operator<<(std::ostream& out, const TransactionStatusResult
 typedef std::function<void(Result<TransactionStatusResult>)> TransactionStatusCallback;
 struct TransactionMetadata;
 
-YB_DEFINE_ENUM(TransactionLoadFlag, (kMustExist)(kCleanup));
+// kAcceptRecentPending - pending status recently received by any tablet of the node could be used
+// as status at the requested time. It is fine for conflict resolution, since the worst outcome is
+// a spurious conflict with transaction, that has just committed or aborted.
+YB_DEFINE_ENUM(TransactionLoadFlag, (kMustExist)(kCleanup)(kAcceptRecentPending));
 typedef EnumBitSet<TransactionLoadFlag> TransactionLoadFlags;
 
 // Used by RequestStatusAt.
@@ -181,6 +184,13 @@ class TransactionStatusManager {
   // Returns minimal running hybrid time of all running transactions.
   virtual HybridTime MinRunningHybridTime() const = 0;
 
+  // Returns minimal start time of running transactions, whose intents were not yet applied to
+  // regular DB. Intents of applied transactions, that are still kept for CDC, are not needed by
+  // reads.
+  virtual HybridTime MinRunningNotAppliedHybridTime() const {
+    return MinRunningHybridTime();
+  }
+
   virtual Result<HybridTime> WaitForSafeTime(HybridTime safe_time, CoarseTimePoint deadline) = 0;
 
   virtual const TabletId& tablet_id() const = 0;
@@ -30,6 +30,9 @@
 // under the License.
 //
 
+#include <condition_variable>
+#include <mutex>
+
 #include <gtest/gtest.h>
 
 #include "yb/common/schema.h"
@@ -46,10 +49,12 @@
 
 #include "yb/server/hybrid_clock.h"
 
+#include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/metrics.h"
 #include "yb/util/opid.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
@@ -59,6 +64,9 @@ using namespace std::chrono_literals;
 
 METRIC_DECLARE_entity(tablet);
 
+DECLARE_int32(consensus_max_in_flight_update_requests);
+DECLARE_int32(raft_heartbeat_interval_ms);
+
 namespace yb {
 namespace consensus {
 
@@ -76,6 +84,132 @@ const char* kTabletId = "test-peers-tablet";
 const char* kLeaderUuid = "peer-0";
 const char* kFollowerUuid = "peer-1";
 
+// Keeps update requests in flight until the test handles them, so the test controls both the order
+// in which the follower receives requests, and the order in which the leader receives responses.
+class PipelinedPeerProxy : public TestPeerProxy {
+ public:
+  explicit PipelinedPeerProxy(ThreadPool* pool) : TestPeerProxy(pool) {}
+
+  void UpdateAsync(const LWConsensusRequestPB* request,
+                   RequestTriggerMode trigger_mode,
+                   LWConsensusResponsePB* response,
+                   rpc::RpcController* controller,
+                   const rpc::ResponseCallback& callback) override {
+    auto preceding_id = OpId::FromPB(request->preceding_id());
+    std::lock_guard<std::mutex> lock(mutex_);
+    calls_.push_back(Call {
+      .preceding_id = preceding_id,
+      .last_id = request->ops().empty() ? preceding_id : OpId::FromPB(request->ops().back().id()),
+      .caller_term = request->caller_term(),
+      .response = response,
+      .callback = callback,
+    });
+    cond_.notify_all();
+  }
+
+  // Waits until the specified number of requests were sent to the proxy.
+  bool WaitForCalls(size_t count, std::chrono::steady_clock::duration timeout = 10s) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cond_.wait_for(lock, timeout, [this, count] { return calls_.size() >= count; });
+  }
+
+  size_t num_calls() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return calls_.size();
+  }
+
+  // Returns ids of the op preceding the request with the specified index, and of its last op.
+  std::pair<OpId, OpId> CallOps(size_t idx) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return {calls_[idx].preceding_id, calls_[idx].last_id};
+  }
+
+  // Handles the request as a follower, that appends only ops following the last received one.
+  void HandleCall(size_t idx) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& call = calls_[idx];
+    auto* response = call.response;
+    response->Clear();
+    if (last_received_ < call.preceding_id) {
+      auto* error = response->mutable_status()->mutable_error();
+      error->set_code(ConsensusErrorPB::PRECEDING_ENTRY_DIDNT_MATCH);
+      StatusToPB(STATUS(IllegalState, ""), error->mutable_status());
+    } else if (last_received_ < call.last_id) {
+      last_received_ = call.last_id;
+    }
+    response->ref_responder_uuid(kFollowerUuid);
+    response->set_responder_term(call.caller_term);
+    last_received_.ToPB(response->mutable_status()->mutable_last_received());
+    last_received_.ToPB(response->mutable_status()->mutable_last_received_current_leader());
+    response->mutable_status()->set_last_committed_idx(last_received_.index);
+    call.handled = true;
+  }
+
+  // Responds to the request with an error, like a follower that failed to handle it.
+  void FailCall(size_t idx) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& call = calls_[idx];
+    call.response->Clear();
+    auto* error = call.response->mutable_error();
+    error->set_code(tserver::TabletServerErrorPB::UNKNOWN_ERROR);
+    StatusToPB(STATUS(NetworkError, "fake error"), error->mutable_status());
+    call.handled = true;
+  }
+
+  // Delivers the response to the handled request to the leader.
+  void DeliverCall(size_t idx) {
+    rpc::ResponseCallback callback;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& call = calls_[idx];
+      CHECK(call.handled) << idx;
+      CHECK(call.callback) << idx;
+      callback = std::move(call.callback);
+      call.callback = nullptr;
+    }
+    WARN_NOT_OK(pool_->SubmitFunc(callback), "Submit failed");
+  }
+
+  // Handles and delivers the oldest not delivered request, waiting for it to be sent at most for
+  // the specified time. Returns false if there is no such request.
+  bool RespondToNextCall(std::chrono::steady_clock::duration timeout) {
+    if (!WaitForCalls(next_to_respond_ + 1, timeout)) {
+      return false;
+    }
+    HandleCall(next_to_respond_);
+    DeliverCall(next_to_respond_);
+    ++next_to_respond_;
+    return true;
+  }
+
+  // Marks requests before the specified index as delivered by the test itself.
+  void SetNextToRespond(size_t idx) {
+    next_to_respond_ = idx;
+  }
+
+  OpId last_received() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_received_;
+  }
+
+ private:
+  struct Call {
+    OpId preceding_id;
+    OpId last_id;
+    int64_t caller_term;
+    LWConsensusResponsePB* response;
+    rpc::ResponseCallback callback;
+    bool handled = false;
+  };
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::vector<Call> calls_ GUARDED_BY(mutex_);
+  OpId last_received_ GUARDED_BY(mutex_);
+  // Accessed only by the test thread.
+  size_t next_to_respond_ = 0;
+};
+
 class ConsensusPeersTest : public YBTest {
  public:
   ConsensusPeersTest()
@@ -151,6 +285,52 @@ class ConsensusPeersTest : public YBTest {
     return proxy_ptr;
   }
 
+  // Creates peer that could pipeline requests, and completes the first exchange with it, since ops
+  // are pipelined only to a peer with known state.
+  PipelinedPeerProxy* NewPipelinedPeer(std::shared_ptr<Peer>* peer) {
+    FLAGS_consensus_max_in_flight_update_requests = 3;
+    // Heartbeats are not needed to replicate ops, and request is pipelined only during heartbeat
+    // interval after the last regular request.
+    FLAGS_raft_heartbeat_interval_ms = 10000 * kTimeMultiplier;
+    auto proxy = new PipelinedPeerProxy(raft_pool_.get());
+    *peer = CHECK_RESULT(Peer::NewRemotePeer(
+        FakeRaftPeerPB(kFollowerUuid), kTabletId, kLeaderUuid, PeerProxyPtr(proxy),
+        message_queue_.get(), nullptr /* multi raft batcher */, raft_pool_token_.get(),
+        nullptr /* consensus */, messenger_.get()));
+
+    AppendReplicateMessagesToQueue(message_queue_.get(), clock_, 1, 1);
+    CHECK_OK((**peer).SignalRequest(RequestTriggerMode::kNonEmptyOnly));
+    RespondUntilIdle(proxy);
+    CHECK(consensus_->IsMajorityReplicated(1));
+    return proxy;
+  }
+
+  // Responds to requests in the order they were sent, until the peer stops sending them.
+  void RespondUntilIdle(PipelinedPeerProxy* proxy) {
+    while (proxy->RespondToNextCall(500ms * kTimeMultiplier)) {
+    }
+  }
+
+  // Appends ops one by one, signalling the peer after every op, and checks that every op is sent
+  // in its own request, while the previous requests are in flight.
+  // Returns index of the first of those requests at the proxy.
+  Result<size_t> SendPipelinedRequests(
+      PipelinedPeerProxy* proxy, Peer* peer, int64_t first_index, size_t count) {
+    auto first_call = proxy->num_calls();
+    for (size_t i = 0; i != count; ++i) {
+      auto index = first_index + static_cast<int64_t>(i);
+      AppendReplicateMessagesToQueue(message_queue_.get(), clock_, index, 1);
+      RETURN_NOT_OK(peer->SignalRequest(RequestTriggerMode::kNonEmptyOnly));
+      SCHECK(proxy->WaitForCalls(first_call + i + 1), TimedOut,
+             Format("Request with op $0 was not sent", index));
+      auto ops = proxy->CallOps(first_call + i);
+      SCHECK_EQ(ops.first.index, index - 1, IllegalState, "Wrong preceding op of request");
+      SCHECK_EQ(ops.second.index, index, IllegalState, "Wrong last op of request");
+    }
+    proxy->SetNextToRespond(first_call + count);
+    return first_call;
+  }
+
   void CheckLastLogEntry(int64_t term, int64_t index) {
     ASSERT_EQ(log_->GetLatestEntryOpId(), OpId(term, index));
   }
@@ -414,5 +594,101 @@ TEST_F(ConsensusPeersTest, TestDontSendOneRpcPerWriteWhenPeerIsDown) {
   ASSERT_LT(mock_proxy->update_count() - initial_update_count, 5);
 }
 
+// Follower receives pipelined requests in order, but responses are delivered to the leader in
+// reverse order. Responses should be processed in the order requests were sent.
+TEST_F(ConsensusPeersTest, PipelinedResponsesReordered) {
+  std::shared_ptr<Peer> peer;
+  auto se = ScopeExit([&peer] {
+    peer->Close();
+  });
+  auto* proxy = NewPipelinedPeer(&peer);
+
+  constexpr size_t kRequests = 3;
+  auto first_call = ASSERT_RESULT(SendPipelinedRequests(proxy, peer.get(), 2, kRequests));
+  for (size_t i = 0; i != kRequests; ++i) {
+    proxy->HandleCall(first_call + i);
+  }
+  for (size_t i = kRequests; i-- > 0;) {
+    proxy->DeliverCall(first_call + i);
+  }
+
+  consensus_->WaitForMajorityReplicatedIndex(4);
+  RespondUntilIdle(proxy);
+  ASSERT_EQ(proxy->last_received(), MakeOpIdForIndex(4));
+  // All ops were accepted, so none of them is resent.
+  for (auto i = first_call + kRequests; i != proxy->num_calls(); ++i) {
+    ASSERT_GE(proxy->CallOps(i).first.index, 4);
+  }
+}
+
+// Follower handles pipelined requests before the first one, so rejects them because of preceding
+// entry mismatch. Queue should not be rewound because of it, and the rejected ops should be resent
+// once the pipeline drains.
+TEST_F(ConsensusPeersTest, PipelinedRequestPrecedingEntryMismatch) {
+  std::shared_ptr<Peer> peer;
+  auto se = ScopeExit([&peer] {
+    peer->Close();
+  });
+  auto* proxy = NewPipelinedPeer(&peer);
+
+  constexpr size_t kRequests = 3;
+  auto first_call = ASSERT_RESULT(SendPipelinedRequests(proxy, peer.get(), 2, kRequests));
+  for (size_t i = kRequests; i-- > 0;) {
+    proxy->HandleCall(first_call + i);
+  }
+  for (size_t i = 0; i != kRequests; ++i) {
+    proxy->DeliverCall(first_call + i);
+  }
+
+  ASSERT_TRUE(proxy->WaitForCalls(first_call + kRequests + 1));
+  auto resent_ops = proxy->CallOps(first_call + kRequests);
+  ASSERT_EQ(resent_ops.first, MakeOpIdForIndex(2));
+  ASSERT_EQ(resent_ops.second, MakeOpIdForIndex(4));
+
+  RespondUntilIdle(proxy);
+  consensus_->WaitForMajorityReplicatedIndex(4);
+  ASSERT_EQ(proxy->last_received(), MakeOpIdForIndex(4));
+}
+
+// Request in the middle of the pipeline fails. Responses to the following requests should be
+// ignored, and replication should be resumed, including pipelining, after the pipeline drains.
+TEST_F(ConsensusPeersTest, PipelinedRequestFailed) {
+  std::shared_ptr<Peer> peer;
+  auto se = ScopeExit([&peer] {
+    peer->Close();
+  });
+  auto* proxy = NewPipelinedPeer(&peer);
+
+  constexpr size_t kRequests = 3;
+  auto first_call = ASSERT_RESULT(SendPipelinedRequests(proxy, peer.get(), 2, kRequests));
+  proxy->HandleCall(first_call);
+  proxy->FailCall(first_call + 1);
+  proxy->HandleCall(first_call + 2);
+  for (size_t i = 0; i != kRequests; ++i) {
+    proxy->DeliverCall(first_call + i);
+  }
+
+  // After a failure the peer waits for a heartbeat before sending ops, so heartbeats are
+  // triggered by the test till the pipeline drains.
+  ASSERT_OK(WaitFor([proxy, peer, first_call]() -> Result<bool> {
+    if (proxy->num_calls() > first_call + kRequests) {
+      return true;
+    }
+    RETURN_NOT_OK(peer->SignalRequest(RequestTriggerMode::kAlwaysSend));
+    return false;
+  }, 10s * kTimeMultiplier, "Ops resent after failure"));
+  ASSERT_EQ(proxy->CallOps(first_call + kRequests).first, MakeOpIdForIndex(2));
+
+  RespondUntilIdle(proxy);
+  consensus_->WaitForMajorityReplicatedIndex(4);
+  ASSERT_EQ(proxy->last_received(), MakeOpIdForIndex(4));
+
+  // Pipelining is resumed after successful exchange.
+  first_call = ASSERT_RESULT(SendPipelinedRequests(proxy, peer.get(), 5, 2));
+  proxy->SetNextToRespond(first_call);
+  RespondUntilIdle(proxy);
+  consensus_->WaitForMajorityReplicatedIndex(6);
+}
+
 }  // namespace consensus
 }  // namespace yb
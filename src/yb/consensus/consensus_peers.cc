@@ -83,9 +83,21 @@ DEFINE_int32(max_wait_for_processresponse_before_closing_ms,
              "finish before returning proceding to close the Peer and return");
 TAG_FLAG(max_wait_for_processresponse_before_closing_ms, advanced);
 
+DEFINE_RUNTIME_int32(consensus_max_in_flight_update_requests, 1,
+    "Maximum number of UpdateConsensus requests with new operations, that the leader could have "
+    "in flight to a single follower. Values greater than 1 pipeline replication to followers with "
+    "high round trip time, instead of waiting for the response to each request.");
+
+DEFINE_RUNTIME_bool(enable_consensus_lease_renewals, false,
+    "Whether the leader extends leases of a follower with a separate lease only request, sent "
+    "through the multi Raft batcher, when an update to this follower is in flight for more than "
+    "a heartbeat interval. Keeps leader leases and safe time moving while large updates are "
+    "replicated. Requires enable_multi_raft_heartbeat_batcher.");
+
 DECLARE_int32(raft_heartbeat_interval_ms);
 
 DECLARE_bool(enable_multi_raft_heartbeat_batcher);
+DECLARE_uint64(multi_raft_update_batch_max_bytes);
 
 DEFINE_test_flag(double, fault_crash_on_leader_request_fraction, 0.0,
                  "Fraction of the time when the leader will crash just before sending an "
@@ -116,6 +128,15 @@ using rpc::PeriodicTimer;
 using rpc::RpcController;
 using strings::Substitute;
 
+struct Peer::PipelinedRequest {
+  Arena arena;
+  LWConsensusRequestPB* request = arena.NewObject<LWConsensusRequestPB>(&arena);
+  LWConsensusResponsePB* response = arena.NewObject<LWConsensusResponsePB>(&arena);
+  rpc::RpcController controller;
+  bool done = false;
+  Status status;
+};
+
 Peer::Peer(
     const RaftPeerPB& peer_pb, string tablet_id, string leader_uuid, PeerProxyPtr proxy,
     PeerMessageQueue* queue, MultiRaftHeartbeatBatcherPtr multi_raft_batcher,
@@ -159,6 +180,10 @@ Status Peer::SignalRequest(RequestTriggerMode trigger_mode) {
   // If there are new requests in the queue we'll get them on ProcessResponse().
   auto performing_update_lock = LockPerformingUpdate(std::try_to_lock);
   if (!performing_update_lock.owns_lock()) {
+    SchedulePipelinedRequest();
+    if (trigger_mode == RequestTriggerMode::kAlwaysSend) {
+      SendLeaseRenewal();
+    }
     return Status::OK();
   }
 
@@ -204,10 +229,12 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   DCHECK(performing_update_mutex_.is_locked()) << "Cannot send request";
 
   auto performing_update_lock = LockPerformingUpdate(std::adopt_lock);
+  std::unique_lock<std::mutex> send_lock(send_mutex_);
   auto processing_lock = StartProcessingUnlocked();
   if (!processing_lock.owns_lock()) {
     return;
   }
+  DCHECK(!update_in_flight_ && pipelined_requests_.empty());
 
   int64_t commit_index_before = update_request_ && update_request_->has_committed_op_id() ?
       update_request_->committed_op_id().index() : kMinimumOpIdIndex;
@@ -267,6 +294,7 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
       auto uuid = peer_pb_.permanent_uuid();
       // Remove these here, before we drop the locks.
       processing_lock.unlock();
+      send_lock.unlock();
       performing_update_lock.unlock();
       consensus::ChangeConfigRequestPB req;
       consensus::ChangeConfigResponsePB resp;
@@ -330,15 +358,17 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
       return;
     }
 
-    // TODO(lw_uc) support multiraft heartbeat with LW
-    update_request_->ToGoogleProtobuf(&heartbeat_request_);
-    update_response_->ToGoogleProtobuf(&heartbeat_response_);
+    // The heartbeat could be still in flight when update_request_ is rebuilt, so it is copied.
+    heartbeat_arena_.Reset(ResetMode::kKeepFirst);
+    heartbeat_request_ = heartbeat_arena_.NewObject<LWConsensusRequestPB>(
+        &heartbeat_arena_, *update_request_);
+    heartbeat_response_ = heartbeat_arena_.NewObject<LWConsensusResponsePB>(&heartbeat_arena_);
     cur_heartbeat_id_++;
     processing_lock.unlock();
     performing_update_lock.unlock();
     performing_heartbeat_lock.release();
     multi_raft_batcher_->AddRequestToBatch(
-        &heartbeat_request_, &heartbeat_response_,
+        heartbeat_request_, heartbeat_response_,
         std::bind(&Peer::ProcessHeartbeatResponse, retain_self, _1));
     return;
   }
@@ -351,11 +381,113 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   // and this new request in the same order they were received by the remote peer.
   // TODO: Remove batched but unsent heartbeats (in the respective MultiRaftBatcher) in this case
   minimum_viable_heartbeat_ = cur_heartbeat_id_ + 1;
+  update_sent_time_ = CoarseMonoClock::now();
+  last_sent_op_index_ = update_request_->ops().empty()
+      ? update_request_->preceding_id().index() : update_request_->ops().back().id().index();
+
+  const auto max_batched_update_size = FLAGS_multi_raft_update_batch_max_bytes;
+  if (!req_is_heartbeat && multi_raft_batcher_ && FLAGS_enable_multi_raft_heartbeat_batcher &&
+      max_batched_update_size > 0 && update_request_->SerializedSize() <= max_batched_update_size) {
+    // Small update is sent together with requests of other tablets to the same tablet server.
+    // It is not tracked as in flight, so no requests are pipelined after it, since they could
+    // reach the peer before the batch.
+    // update_request_ is not rebuilt until the response is processed, so the batch refers to it
+    // without copying.
+    batched_update_msgs_holder_ = std::move(msgs_holder);
+    processing_lock.unlock();
+    performing_update_lock.release();
+    multi_raft_batcher_->AddRequestToBatch(
+        update_request_, update_response_,
+        std::bind(&Peer::ProcessBatchedResponse, retain_self, _1));
+    return;
+  }
+
+  update_in_flight_ = true;
   processing_lock.unlock();
   performing_update_lock.release();
   controller_.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
   proxy_->UpdateAsync(update_request_, trigger_mode, update_response_, &controller_,
                       std::bind(&Peer::ProcessResponse, retain_self));
+  // Ops that did not fit into the request could be sent without waiting for the response.
+  if (!req_is_heartbeat) {
+    SchedulePipelinedRequest();
+  }
+}
+
+bool Peer::CanSendPipelinedRequestUnlocked() const {
+  // The request to send after the pipeline drains extends the leader lease, so pipelining is
+  // paused when the lease was not extended for a heartbeat interval.
+  const size_t in_flight = update_in_flight_ + pipelined_requests_.size();
+  return in_flight > 0 && !pipeline_failed_ && failed_attempts_ == 0 &&
+         in_flight < static_cast<size_t>(
+             std::max(FLAGS_consensus_max_in_flight_update_requests, 1)) &&
+         CoarseMonoClock::now() < update_sent_time_ + FLAGS_raft_heartbeat_interval_ms * 1ms;
+}
+
+void Peer::SchedulePipelinedRequest() {
+  if (FLAGS_consensus_max_in_flight_update_requests <= 1) {
+    return;
+  }
+  {
+    auto processing_lock = StartProcessingUnlocked();
+    if (!processing_lock.owns_lock() || pipelined_request_scheduled_ ||
+        !CanSendPipelinedRequestUnlocked()) {
+      return;
+    }
+    pipelined_request_scheduled_ = true;
+    using_thread_pool_.fetch_add(1, std::memory_order_acq_rel);
+  }
+  auto status = raft_pool_token_->SubmitFunc(
+      std::bind(&Peer::SendPipelinedRequest, shared_from_this()));
+  using_thread_pool_.fetch_sub(1, std::memory_order_acq_rel);
+  if (!status.ok()) {
+    std::lock_guard<simple_spinlock> lock(peer_lock_);
+    pipelined_request_scheduled_ = false;
+  }
+}
+
+void Peer::SendPipelinedRequest() {
+  auto retain_self = shared_from_this();
+  std::lock_guard<std::mutex> send_lock(send_mutex_);
+  auto processing_lock = StartProcessingUnlocked();
+  if (!processing_lock.owns_lock()) {
+    return;
+  }
+  pipelined_request_scheduled_ = false;
+  if (!CanSendPipelinedRequestUnlocked()) {
+    return;
+  }
+
+  auto pipelined_request = std::make_unique<PipelinedRequest>();
+  auto* request = pipelined_request->request;
+  bool needs_remote_bootstrap = false;
+  LWReplicateMsgsHolder msgs_holder;
+  auto s = queue_->RequestForPeer(
+      peer_pb_.permanent_uuid(), request, &msgs_holder, &needs_remote_bootstrap,
+      nullptr /* member_type */, nullptr /* last_exchange_successful */, last_sent_op_index_);
+  if (PREDICT_FALSE(!s.ok())) {
+    LOG_WITH_PREFIX(INFO) << "Could not obtain pipelined request from queue for peer: " << s;
+    return;
+  }
+  // Status only requests are sent by SendNextRequest after the pipeline drains.
+  if (request->ops().empty()) {
+    return;
+  }
+
+  request->ref_tablet_id(tablet_id_);
+  request->ref_caller_uuid(leader_uuid_);
+  request->ref_dest_uuid(peer_pb_.permanent_uuid());
+  heartbeater_->Snooze();
+
+  last_sent_op_index_ = request->ops().back().id().index();
+  auto* raw_request = pipelined_request.get();
+  pipelined_requests_.push_back(std::move(pipelined_request));
+  processing_lock.unlock();
+  // Request is not destroyed until its response is processed.
+  raw_request->controller.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
+  proxy_->UpdateAsync(
+      request, RequestTriggerMode::kNonEmptyOnly, raw_request->response, &raw_request->controller,
+      std::bind(&Peer::ProcessPipelinedResponse, retain_self, raw_request));
 }
 
 std::unique_lock<simple_spinlock> Peer::StartProcessingUnlocked() {
@@ -444,23 +576,112 @@ void Peer::ProcessResponse() {
   }
   controller_.Reset();
 
+  ProcessUpdateResponse(status);
+}
+
+void Peer::ProcessBatchedResponse(const Status& status) {
+  DCHECK(performing_update_mutex_.is_locked()) << "Got a response when nothing was pending.";
+  batched_update_msgs_holder_.Reset();
+  ProcessUpdateResponse(status);
+}
+
+void Peer::ProcessUpdateResponse(const Status& status) {
   auto performing_update_lock = LockPerformingUpdate(std::adopt_lock);
   auto processing_lock = StartProcessingUnlocked();
   if (!processing_lock.owns_lock()) {
     return;
   }
+  update_in_flight_ = false;
   bool more_pending = ProcessResponseWithStatus(status, update_response_);
 
-  if (more_pending) {
+  if (!pipelined_requests_.empty()) {
+    if (!status.ok() || update_response_->has_error() || update_response_->status().has_error()) {
+      pipeline_failed_ = true;
+    }
+    ProcessPipelinedResponsesUnlocked(&more_pending);
+  }
+
+  performing_update_lock.release();
+  FinishProcessingUnlocked(more_pending, std::move(processing_lock));
+}
+
+void Peer::ProcessPipelinedResponse(PipelinedRequest* request) {
+  auto status = request->controller.status();
+  if (status.ok()) {
+    status = request->controller.thread_pool_failure();
+  }
+
+  auto processing_lock = StartProcessingUnlocked();
+  if (!processing_lock.owns_lock()) {
+    return;
+  }
+  request->status = status;
+  request->done = true;
+  if (update_in_flight_) {
+    // Will be processed after the response to update_request_.
+    return;
+  }
+
+  bool more_pending = false;
+  ProcessPipelinedResponsesUnlocked(&more_pending);
+  FinishProcessingUnlocked(more_pending, std::move(processing_lock));
+}
+
+void Peer::ProcessPipelinedResponsesUnlocked(bool* more_pending) {
+  while (!pipelined_requests_.empty() && pipelined_requests_.front()->done) {
+    auto request = std::move(pipelined_requests_.front());
+    pipelined_requests_.pop_front();
+    if (pipeline_failed_) {
+      // The request was sent after a failed one, so its response is not consistent with the queue
+      // state anymore.
+      continue;
+    }
+    const auto& response = *request->response;
+    if (request->status.ok() && !response.has_error() && response.status().has_error() &&
+        response.status().error().code() == ConsensusErrorPB::PRECEDING_ENTRY_DIDNT_MATCH) {
+      // The follower could handle concurrently received requests in a different order, rejecting
+      // the request whose preceding ops were not received yet. The queue should not be rewound
+      // because of it, so ops are resent from the queue state after the pipeline drains.
+      VLOG_WITH_PREFIX(1) << "Pipelined request rejected: " << response.ShortDebugString();
+      *more_pending = true;
+      resend_after_pipeline_drained_ = true;
+    } else {
+      *more_pending = ProcessResponseWithStatus(request->status, request->response);
+    }
+    if (!request->status.ok() || response.has_error() || response.status().has_error()) {
+      pipeline_failed_ = true;
+    }
+  }
+}
+
+void Peer::FinishProcessingUnlocked(
+    bool more_pending, std::unique_lock<simple_spinlock> processing_lock) {
+  if (!pipelined_requests_.empty()) {
+    // performing_update_mutex_ stays locked until responses to all requests in flight are
+    // processed.
+    bool send_pipelined = more_pending && CanSendPipelinedRequestUnlocked();
     processing_lock.unlock();
-    performing_update_lock.release();
+    if (send_pipelined) {
+      SendPipelinedRequest();
+    }
+    return;
+  }
+
+  pipeline_failed_ = false;
+  // Responses to requests sent after the rejected one are ignored, so the last processed response
+  // could be unaware of the ops to resend.
+  more_pending = std::exchange(resend_after_pipeline_drained_, false) || more_pending;
+  processing_lock.unlock();
+  if (more_pending) {
     SendNextRequest(RequestTriggerMode::kAlwaysSend);
+  } else {
+    performing_update_mutex_.unlock();
   }
 }
 
 void Peer::ProcessHeartbeatResponse(const Status& status) {
   DCHECK(performing_heartbeat_mutex_.is_locked()) << "Got a heartbeat when nothing was pending.";
-  DCHECK(heartbeat_request_.ops().empty()) << "Got a heartbeat with a non-zero number of ops.";
+  DCHECK(heartbeat_request_->ops().empty()) << "Got a heartbeat with a non-zero number of ops.";
 
   auto performing_heartbeat_lock = LockPerformingHeartbeat(std::adopt_lock);
   auto processing_lock = StartProcessingUnlocked();
@@ -476,9 +697,7 @@ void Peer::ProcessHeartbeatResponse(const Status& status) {
     return;
   }
 
-  // TODO(lw_uc) support multiraft heartbeat with LW
-  auto lw_response = rpc::CopySharedMessage(heartbeat_response_);
-  bool more_pending = ProcessResponseWithStatus(status, lw_response.get());
+  bool more_pending = ProcessResponseWithStatus(status, heartbeat_response_);
 
   if (more_pending) {
     auto performing_update_lock = LockPerformingUpdate(std::try_to_lock);
@@ -492,6 +711,70 @@ void Peer::ProcessHeartbeatResponse(const Status& status) {
   }
 }
 
+void Peer::SendLeaseRenewal() {
+  if (!multi_raft_batcher_ || !FLAGS_enable_multi_raft_heartbeat_batcher ||
+      !GetAtomicFlag(&FLAGS_enable_consensus_lease_renewals)) {
+    return;
+  }
+  auto performing_heartbeat_lock = LockPerformingHeartbeat(std::try_to_lock);
+  if (!performing_heartbeat_lock.owns_lock()) {
+    return;
+  }
+  {
+    auto processing_lock = StartProcessingUnlocked();
+    if (!processing_lock.owns_lock() || state_ != kPeerRunning ||
+        CoarseMonoClock::now() < update_sent_time_ + FLAGS_raft_heartbeat_interval_ms * 1ms) {
+      return;
+    }
+  }
+
+  // Request is built on the calling thread, so it does not wait behind the update in the
+  // raft pool token.
+  heartbeat_arena_.Reset(ResetMode::kKeepFirst);
+  lease_renewal_request_ = heartbeat_arena_.NewObject<LWConsensusRequestPB>(&heartbeat_arena_);
+  lease_renewal_response_ = heartbeat_arena_.NewObject<LWConsensusResponsePB>(&heartbeat_arena_);
+  auto renew = queue_->LeaseRenewalRequestForPeer(
+      peer_pb_.permanent_uuid(), lease_renewal_request_, &lease_renewal_);
+  if (!renew.ok()) {
+    VLOG_WITH_PREFIX(1) << "Could not obtain lease renewal request for peer: " << renew.status();
+    return;
+  }
+  if (!*renew) {
+    return;
+  }
+  lease_renewal_request_->ref_tablet_id(tablet_id_);
+  lease_renewal_request_->ref_caller_uuid(leader_uuid_);
+  lease_renewal_request_->ref_dest_uuid(peer_pb_.permanent_uuid());
+
+  performing_heartbeat_lock.release();
+  multi_raft_batcher_->AddRequestToBatch(
+      lease_renewal_request_, lease_renewal_response_,
+      std::bind(&Peer::ProcessLeaseRenewalResponse, shared_from_this(), _1));
+}
+
+void Peer::ProcessLeaseRenewalResponse(const Status& status) {
+  DCHECK(performing_heartbeat_mutex_.is_locked()) << "No lease renewal is pending.";
+
+  auto performing_heartbeat_lock = LockPerformingHeartbeat(std::adopt_lock);
+  auto processing_lock = StartProcessingUnlocked();
+  if (!processing_lock.owns_lock()) {
+    return;
+  }
+
+  // Errors are handled by the regular requests to the peer, that are still in flight, so the
+  // failed renewal is just not accounted.
+  if (!status.ok() || lease_renewal_response_->has_error() ||
+      lease_renewal_response_->status().has_error() ||
+      lease_renewal_response_->responder_term() != lease_renewal_.term) {
+    VLOG_WITH_PREFIX(1) << "Lease renewal was not accepted: " << status << ", "
+                        << lease_renewal_response_->ShortDebugString();
+    return;
+  }
+
+  processing_lock.unlock();
+  queue_->LeaseRenewalResponseFromPeer(peer_pb_.permanent_uuid(), lease_renewal_);
+}
+
 Status Peer::SendRemoteBootstrapRequest() {
   YB_LOG_WITH_PREFIX_EVERY_N_SECS(INFO, 30) << "Sending request to remotely bootstrap";
   controller_.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolNormal);
@@ -37,7 +37,9 @@
 #include <atomic>
 #include <cstdint>
 #include <cstdlib>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -48,7 +50,9 @@
 #include "yb/consensus/consensus_fwd.h"
 #include "yb/consensus/consensus.pb.h"
 #include "yb/consensus/consensus_util.h"
+#include "yb/consensus/leader_lease.h"
 #include "yb/consensus/metadata.pb.h"
+#include "yb/consensus/replicate_msgs_holder.h"
 
 #include "yb/gutil/integral_types.h"
 
@@ -59,6 +63,7 @@
 #include "yb/util/countdown_latch.h"
 #include "yb/util/locks.h"
 #include "yb/util/memory/arena.h"
+#include "yb/util/monotime.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/result.h"
 #include "yb/util/semaphore.h"
@@ -125,6 +130,12 @@ namespace consensus {
 //        v                               v
 //  SignalRequest()                    return
 //
+// When consensus_max_in_flight_update_requests is greater than 1, SignalRequest() and
+// ProcessResponse() that find a request in flight could send new operations in an additional
+// pipelined request, following the last sent operation. Responses are processed in the order
+// requests were sent. After a failed request, responses to requests sent after it are ignored, and
+// sending is resumed from the queue state once all of them are received.
+//
 class Peer;
 typedef std::shared_ptr<Peer> PeerPtr;
 
@@ -186,9 +197,43 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // requires IO or may block.
   void ProcessResponse();
 
+  // Signals that a response to the update request sent through multi_raft_batcher_ was received.
+  void ProcessBatchedResponse(const Status& status);
+
+  void ProcessUpdateResponse(const Status& status);
+
+  struct PipelinedRequest;
+
+  // Sends request with operations following the last sent operation, while previous requests to
+  // the peer are in flight.
+  void SendPipelinedRequest();
+
+  void SchedulePipelinedRequest();
+
+  void ProcessPipelinedResponse(PipelinedRequest* request);
+
+  // Processes received responses to pipelined requests, in the order requests were sent.
+  // Sets more_pending to true if there are more pending ops to process.
+  void ProcessPipelinedResponsesUnlocked(bool* more_pending);
+
+  // Called when response to the oldest request in flight was processed. Sends next request if
+  // there are more pending ops to process.
+  void FinishProcessingUnlocked(
+      bool more_pending, std::unique_lock<simple_spinlock> processing_lock);
+
+  bool CanSendPipelinedRequestUnlocked() const;
+
   // Signals that a heartbeat response was received from the peer.
   void ProcessHeartbeatResponse(const Status& status);
 
+  // Sends a lease only request through multi_raft_batcher_, when the update in flight was sent
+  // more than a heartbeat interval ago. So leader leases are extended while large updates are
+  // still being transferred or processed by the peer.
+  void SendLeaseRenewal();
+
+  // Signals that a response to the lease renewal request was received from the peer.
+  void ProcessLeaseRenewalResponse(const Status& status);
+
   // Returns true if there are more pending ops to process, false otherwise.
   bool ProcessResponseWithStatus(const Status& status,
                                  LWConsensusResponsePB* response);
@@ -238,9 +283,22 @@ class Peer : public std::enable_shared_from_this<Peer> {
   LWConsensusRequestPB* update_request_ = nullptr;
   LWConsensusResponsePB* update_response_ = nullptr;
 
+  // Stores the latest heartbeat or lease renewal request and response. Protected by
+  // performing_heartbeat_mutex_, since only one of them is in flight.
+  Arena heartbeat_arena_;
+
   // Latest heartbeat request and response
-  ConsensusRequestPB heartbeat_request_;
-  ConsensusResponsePB heartbeat_response_;
+  LWConsensusRequestPB* heartbeat_request_ = nullptr;
+  LWConsensusResponsePB* heartbeat_response_ = nullptr;
+
+  // Latest lease renewal request and response, and leases carried by it.
+  LWConsensusRequestPB* lease_renewal_request_ = nullptr;
+  LWConsensusResponsePB* lease_renewal_response_ = nullptr;
+  LeaderLeaseRenewal lease_renewal_;
+
+  // Operations of update_request_ sent through multi_raft_batcher_. The batch refers to the
+  // request, so they are retained until the response is received.
+  LWReplicateMsgsHolder batched_update_msgs_holder_;
 
   // Each time a heartbeat request is sent this value is incremented.
   int64_t cur_heartbeat_id_ = 0;
@@ -261,7 +319,7 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // single request outstanding at a time, and to wait for the outstanding requests at Close().
   AtomicTryMutex performing_update_mutex_;
 
-  // Held if there is an outstanding heartbeat request.
+  // Held if there is an outstanding heartbeat or lease renewal request.
   // This is used in order to ensure that we only have a
   // single heartbeat request outstanding at a time.
   AtomicTryMutex performing_heartbeat_mutex_;
@@ -291,6 +349,34 @@ class Peer : public std::enable_shared_from_this<Peer> {
   Consensus* consensus_ = nullptr;
   rpc::Messenger* messenger_ = nullptr;
   std::atomic<int> using_thread_pool_{0};
+
+  // Orders sending of update requests, so they are sent in the order they were assembled.
+  // Acquired before peer_lock_.
+  std::mutex send_mutex_;
+
+  // Fields below are protected by peer_lock_.
+
+  // Whether update_request_ was sent and its response was not processed yet.
+  bool update_in_flight_ = false;
+
+  // Pipelined requests in the order they were sent, whose responses were not processed yet.
+  std::deque<std::unique_ptr<PipelinedRequest>> pipelined_requests_;
+
+  // Index of the last op sent to the peer, pipelined request starts after it.
+  int64_t last_sent_op_index_ = 0;
+
+  // Time when update_request_ was sent. Only update_request_ extends leader lease, so requests
+  // are pipelined for at most a heartbeat interval after it.
+  CoarseTimePoint update_sent_time_;
+
+  // Set when a request in flight failed, so responses to requests sent after it are ignored.
+  bool pipeline_failed_ = false;
+
+  // Set when a pipelined request was rejected because of preceding entry mismatch, so ops are
+  // resent after the pipeline drains.
+  bool resend_after_pipeline_drained_ = false;
+
+  bool pipelined_request_scheduled_ = false;
 };
 
 // A proxy to another peer. Usually a thin wrapper around an rpc proxy but can be replaced for
@@ -274,6 +274,62 @@ TEST_F(ConsensusQueueTest, TestStartTrackingAfterStart) {
   ASSERT_TRUE(request.ops().empty());
 }
 
+// Tests that lease renewal requests refer to the last operation acked by the peer, and that their
+// responses extend peer leases, even when received before responses to earlier regular requests.
+TEST_F(ConsensusQueueTest, TestLeaseRenewal) {
+  queue_->Init(OpId::Min());
+  queue_->SetLeaderMode(
+      OpId::Min(), OpId::Min().term, OpId::Min(), BuildRaftConfigPBForTests(2));
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 1, kNumMessages);
+
+  Arena arena;
+  LWConsensusRequestPB request(&arena);
+  LWConsensusResponsePB response(&arena);
+  response.ref_responder_uuid(kPeerUuid);
+
+  OpId last_received = MakeOpIdForIndex(kNumMessages / 2);
+  ASSERT_TRUE(UpdatePeerWatermarkToOp(&request, &response, last_received, OpId::Min()));
+
+  // Last exchange with the peer was not successful, so its log is not known.
+  LWConsensusRequestPB renewal_request(&arena);
+  LeaderLeaseRenewal renewal;
+  ASSERT_FALSE(ASSERT_RESULT(queue_->LeaseRenewalRequestForPeer(
+      kPeerUuid, &renewal_request, &renewal)));
+
+  LWReplicateMsgsHolder refs;
+  bool needs_remote_bootstrap;
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_EQ(kNumMessages / 2, request.ops().size());
+  last_received = OpId::FromPB(request.ops().back().id());
+  SetLastReceivedAndLastCommitted(&response, last_received);
+  queue_->ResponseFromPeer(kPeerUuid, response);
+
+  // Regular request is sent before the lease renewal, but responded after it.
+  refs.Reset();
+  request.Clear();
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_TRUE(request.ops().empty());
+
+  ASSERT_TRUE(ASSERT_RESULT(queue_->LeaseRenewalRequestForPeer(
+      kPeerUuid, &renewal_request, &renewal)));
+  ASSERT_EQ(renewal.term, renewal_request.caller_term());
+  ASSERT_EQ(last_received, OpId::FromPB(renewal_request.preceding_id()));
+  ASSERT_TRUE(renewal_request.ops().empty());
+  ASSERT_TRUE(renewal_request.has_leader_lease_duration_ms());
+  ASSERT_EQ(renewal.ht_lease_expiration, renewal_request.ht_lease_expiration());
+  ASSERT_FALSE(renewal_request.has_propagated_safe_time());
+
+  queue_->LeaseRenewalResponseFromPeer(kPeerUuid, renewal);
+  auto peer = queue_->GetTrackedPeerForTests(kPeerUuid);
+  ASSERT_EQ(renewal.leader_lease_expiration, peer.leader_lease_expiration.last_received);
+  ASSERT_EQ(renewal.ht_lease_expiration, peer.leader_ht_lease_expiration.last_received);
+
+  queue_->ResponseFromPeer(kPeerUuid, response);
+  peer = queue_->GetTrackedPeerForTests(kPeerUuid);
+  ASSERT_EQ(renewal.leader_lease_expiration, peer.leader_lease_expiration.last_received);
+  ASSERT_EQ(renewal.ht_lease_expiration, peer.leader_ht_lease_expiration.last_received);
+}
+
 // Tests that the peers gets the messages pages, with the size of a page being
 // 'consensus_max_batch_size_bytes'
 TEST_F(ConsensusQueueTest, TestGetPagedMessages) {
@@ -151,9 +151,35 @@ static bool RpcThrottleThresholdBytesValidator(const char* flagname, int64_t val
   return true;
 }
 
+// Sets leader leases, that are extended by the request starting at now_ht.
+template <class Request>
+LeaderLeaseRenewal SetLeaderLeases(HybridTime now_ht, Request* request) {
+  LeaderLeaseRenewal result;
+  result.ht_lease_expiration = now_ht.GetPhysicalValueMicros() + FLAGS_ht_lease_duration_ms * 1000;
+  auto leader_lease_duration_ms = GetAtomicFlag(&FLAGS_leader_lease_duration_ms);
+  request->set_leader_lease_duration_ms(leader_lease_duration_ms);
+  request->set_ht_lease_expiration(result.ht_lease_expiration);
+
+  // As noted here:
+  // https://red.ht/2sCSErb
+  //
+  // The _COARSE variants are faster to read and have a precision (also known as resolution) of
+  // one millisecond (ms).
+  //
+  // Coarse clock precision is 1 millisecond.
+  const auto kCoarseClockPrecision = 1ms;
+
+  // Because of coarse clocks we subtract 2ms, to be sure that our local version of lease
+  // does not expire after it expires at follower.
+  result.leader_lease_expiration =
+      CoarseMonoClock::Now() + leader_lease_duration_ms * 1ms - kCoarseClockPrecision * 2;
+  return result;
+}
+
 } // namespace
 
 DECLARE_int64(rpc_throttle_threshold_bytes);
+DECLARE_bool(log_cache_compress_ops);
 
 namespace yb {
 namespace consensus {
@@ -481,9 +507,11 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
                                         LWReplicateMsgsHolder* msgs_holder,
                                         bool* needs_remote_bootstrap,
                                         PeerMemberType* member_type,
-                                        bool* last_exchange_successful) {
+                                        bool* last_exchange_successful,
+                                        int64_t pipelined_after_index) {
   static constexpr uint64_t kSendUnboundedLogOps = std::numeric_limits<uint64_t>::max();
   DCHECK(request->ops().empty()) << request->ShortDebugString();
+  const bool pipelined = pipelined_after_index != kInvalidOpIdIndex;
 
   OpId preceding_id;
   MonoDelta unreachable_time = MonoDelta::kMin;
@@ -513,29 +541,17 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     HybridTime now_ht;
 
     is_new = peer->is_new;
-    if (!is_new) {
+    if (pipelined) {
+      // Responses to pipelined requests don't move leader lease watermarks, so they should not
+      // extend the lease at the follower either.
       now_ht = clock_->Now();
-
-      auto ht_lease_expiration_micros = now_ht.GetPhysicalValueMicros() +
-                                        FLAGS_ht_lease_duration_ms * 1000;
-      auto leader_lease_duration_ms = GetAtomicFlag(&FLAGS_leader_lease_duration_ms);
-      request->set_leader_lease_duration_ms(leader_lease_duration_ms);
-      request->set_ht_lease_expiration(ht_lease_expiration_micros);
-
-      // As noted here:
-      // https://red.ht/2sCSErb
-      //
-      // The _COARSE variants are faster to read and have a precision (also known as resolution) of
-      // one millisecond (ms).
-      //
-      // Coarse clock precision is 1 millisecond.
-      const auto kCoarseClockPrecision = 1ms;
-
-      // Because of coarse clocks we subtract 2ms, to be sure that our local version of lease
-      // does not expire after it expires at follower.
-      peer->leader_lease_expiration.last_sent =
-          CoarseMonoClock::Now() + leader_lease_duration_ms * 1ms - kCoarseClockPrecision * 2;
-      peer->leader_ht_lease_expiration.last_sent = ht_lease_expiration_micros;
+      request->clear_leader_lease_duration_ms();
+      request->clear_ht_lease_expiration();
+    } else if (!is_new) {
+      now_ht = clock_->Now();
+      auto leases = SetLeaderLeases(now_ht, request);
+      peer->leader_lease_expiration.last_sent = leases.leader_lease_expiration;
+      peer->leader_ht_lease_expiration.last_sent = leases.ht_lease_expiration;
     } else {
       now_ht = clock_->Now();
       request->clear_leader_lease_duration_ms();
@@ -582,20 +598,31 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     if (last_exchange_successful) *last_exchange_successful = peer->is_last_exchange_successful;
     *needs_remote_bootstrap = peer->needs_remote_bootstrap;
 
-    previously_sent_index = peer->next_index - 1;
-    if (FLAGS_enable_consensus_exponential_backoff && peer->last_num_messages_sent >= 0) {
-      // Previous request to peer has not been acked. Reduce number of entries to be sent
-      // in this attempt using exponential backoff. Note that to_index is inclusive.
-      num_log_ops_to_send = GetNumMessagesToSendWithBackoff(peer->last_num_messages_sent);
-    } else {
-      // Previous request to peer has been acked or a heartbeat response has been received.
-      // Transmit as many entries as allowed.
+    if (pipelined) {
+      if (is_new || !peer->is_last_exchange_successful || peer->needs_remote_bootstrap) {
+        // Peer state is not known yet, so operations will be sent after all outstanding requests
+        // are responded.
+        *needs_remote_bootstrap = false;
+        return Status::OK();
+      }
+      previously_sent_index = pipelined_after_index;
       num_log_ops_to_send = kSendUnboundedLogOps;
-    }
+    } else {
+      previously_sent_index = peer->next_index - 1;
+      if (FLAGS_enable_consensus_exponential_backoff && peer->last_num_messages_sent >= 0) {
+        // Previous request to peer has not been acked. Reduce number of entries to be sent
+        // in this attempt using exponential backoff. Note that to_index is inclusive.
+        num_log_ops_to_send = GetNumMessagesToSendWithBackoff(peer->last_num_messages_sent);
+      } else {
+        // Previous request to peer has been acked or a heartbeat response has been received.
+        // Transmit as many entries as allowed.
+        num_log_ops_to_send = kSendUnboundedLogOps;
+      }
 
-    peer->current_retransmissions++;
+      peer->current_retransmissions++;
+    }
 
-    if (peer->member_type == PeerMemberType::VOTER) {
+    if (IsVoterMemberType(peer->member_type)) {
       is_voter = true;
     }
     current_term = queue_state_.current_term;
@@ -661,7 +688,9 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
         return STATUS(NotFound, "Peer not tracked.");
       }
 
-      peer->last_num_messages_sent = result->messages.size();
+      if (!pipelined) {
+        peer->last_num_messages_sent = result->messages.size();
+      }
     }
 
     ScopedTrackedConsumption consumption;
@@ -1208,6 +1237,65 @@ void PeerMessageQueue::RequestWasNotSent(const std::string& peer_uuid) {
   peer->ResetLastRequest();
 }
 
+Result<bool> PeerMessageQueue::LeaseRenewalRequestForPeer(
+    const std::string& uuid, LWConsensusRequestPB* request, LeaderLeaseRenewal* renewal) {
+  LockGuard lock(queue_lock_);
+  if (PREDICT_FALSE(queue_state_.state != State::kQueueOpen ||
+                    queue_state_.mode == Mode::NON_LEADER)) {
+    return STATUS(IllegalState, "Queue is closed or not in leader mode.");
+  }
+
+  auto peer = FindPtrOrNull(peers_map_, uuid);
+  if (PREDICT_FALSE(peer == nullptr)) {
+    return STATUS(NotFound, "Peer not tracked.");
+  }
+
+  // Operations acked by the peer are the only ones known to be in its log.
+  if (peer->is_new || !peer->is_last_exchange_successful || peer->needs_remote_bootstrap ||
+      peer->last_received == OpId::Min()) {
+    return false;
+  }
+
+  auto now_ht = clock_->Now();
+  *renewal = SetLeaderLeases(now_ht, request);
+  renewal->term = queue_state_.current_term;
+
+  request->set_caller_term(queue_state_.current_term);
+  request->set_propagated_hybrid_time(now_ht.ToUint64());
+  peer->last_received.ToPB(request->mutable_preceding_id());
+  auto committed_op_id = std::min(queue_state_.committed_op_id, peer->last_received);
+  committed_op_id.ToPB(request->mutable_committed_op_id());
+
+  VLOG_WITH_PREFIX_UNLOCKED(2)
+      << "Sending lease renewal request to Peer: " << uuid << ": " << request->ShortDebugString();
+  return true;
+}
+
+void PeerMessageQueue::LeaseRenewalResponseFromPeer(
+    const std::string& uuid, const LeaderLeaseRenewal& renewal) {
+  MajorityReplicatedData majority_replicated;
+  {
+    LockGuard lock(queue_lock_);
+    auto peer = FindPtrOrNull(peers_map_, uuid);
+    if (PREDICT_FALSE(queue_state_.state != State::kQueueOpen || peer == nullptr ||
+                      queue_state_.mode != Mode::LEADER ||
+                      queue_state_.current_term != renewal.term)) {
+      return;
+    }
+
+    peer->last_successful_communication_time = MonoTime::Now();
+    peer->leader_lease_expiration.OnReplyFromFollower(renewal.leader_lease_expiration);
+    peer->leader_ht_lease_expiration.OnReplyFromFollower(renewal.ht_lease_expiration);
+
+    majority_replicated.op_id = queue_state_.majority_replicated_op_id;
+    majority_replicated.leader_lease_expiration = LeaderLeaseExpirationWatermark();
+    majority_replicated.ht_lease_expiration = HybridTimeLeaseExpirationWatermark();
+    majority_replicated.num_sst_files = NumSSTFilesWatermark();
+  }
+
+  NotifyObserversOfMajorityReplOpChange(majority_replicated);
+}
+
 
 bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
                                         const LWConsensusResponsePB& response) {
@@ -1400,6 +1488,9 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
   }
 
   if (mode_copy == Mode::LEADER) {
+    // Operations replicated to majority, that were not evicted above, are kept in the cache only
+    // for lagging followers.
+    CompressLogCache(majority_replicated.op_id.index);
     NotifyObserversOfMajorityReplOpChange(majority_replicated);
   }
 
@@ -1557,6 +1648,20 @@ void PeerMessageQueue::NotifyObserversOfMajorityReplOpChange(
                            "majority replicated op change.");
 }
 
+void PeerMessageQueue::CompressLogCache(int64_t index) {
+  if (!FLAGS_log_cache_compress_ops || log_cache_compression_scheduled_.exchange(true)) {
+    return;
+  }
+  auto status = raft_pool_observers_token_->SubmitFunc([this, index] {
+    log_cache_compression_scheduled_ = false;
+    log_cache_.CompressThroughOp(index);
+  });
+  if (!status.ok()) {
+    log_cache_compression_scheduled_ = false;
+    LOG_WITH_PREFIX(WARNING) << "Unable to schedule log cache compression: " << status;
+  }
+}
+
 template <class Func>
 void PeerMessageQueue::NotifyObservers(const char* title, Func&& func) {
   WARN_NOT_OK(
@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <iosfwd>
 #include <map>
 #include <set>
@@ -45,6 +46,7 @@
 #include "yb/common/placement_info.h"
 
 #include "yb/consensus/consensus_fwd.h"
+#include "yb/consensus/leader_lease.h"
 #include "yb/consensus/metadata.pb.h"
 #include "yb/consensus/log_cache.h"
 #include "yb/consensus/opid_util.h"
@@ -91,7 +93,15 @@ struct FollowerWatermark {
   }
 
   void OnReplyFromFollower() {
-    last_received = last_sent;
+    OnReplyFromFollower(last_sent);
+  }
+
+  // Replies to requests that are sent independently from regular ones, like lease renewals, could
+  // be received out of order, so last_received never moves backward here.
+  void OnReplyFromFollower(const Value& sent) {
+    if (last_received < sent) {
+      last_received = sent;
+    }
   }
 
   std::string ToString() const {
@@ -106,8 +116,9 @@ struct FollowerWatermark {
 // This also takes care of pushing requests to peers as new operations are added, and notifying
 // RaftConsensus when the commit index advances.
 //
-// TODO Currently this class is able to track one outstanding operation per peer. If we want to have
-// more than one outstanding RPC we need to modify it.
+// Responses from a peer are expected to be passed in the order the requests were sent. Only the
+// oldest outstanding request to a peer is tracked for lease and retransmission purposes, requests
+// pipelined after it are tracked by the Peer.
 class PeerMessageQueue {
  public:
   struct TrackedPeer {
@@ -291,13 +302,20 @@ class PeerMessageQueue {
   // not delete the entries. The simplest way is to pass the same instance of ConsensusRequestPB to
   // RequestForPeer(): the buffer will replace the old entries with new ones without de-allocating
   // the old ones if they are still required.
+  //
+  // If 'pipelined_after_index' is specified, the request is assembled to be sent while previous
+  // requests to the peer, with operations through this index, are still in flight. Such a request
+  // contains operations after 'pipelined_after_index' and doesn't extend leader leases, since
+  // responses to it are not accounted by the queue for lease purposes. It is left empty, when the
+  // last exchange with the peer was not successful.
   virtual Status RequestForPeer(
       const std::string& uuid,
       LWConsensusRequestPB* request,
       LWReplicateMsgsHolder* msgs_holder,
       bool* needs_remote_bootstrap,
       PeerMemberType* member_type = nullptr,
-      bool* last_exchange_successful = nullptr);
+      bool* last_exchange_successful = nullptr,
+      int64_t pipelined_after_index = kInvalidOpIdIndex);
 
   // Fill in a StartRemoteBootstrapRequest for the specified peer.  If that peer should not remotely
   // bootstrap, returns a non-OK status.  On success, also internally resets
@@ -323,6 +341,19 @@ class PeerMessageQueue {
 
   void RequestWasNotSent(const std::string& peer_uuid);
 
+  // Fills a status only request to the specified peer, that only extends leader leases. Such
+  // a request could be sent while regular requests to the peer are still in flight, so it refers
+  // to the last operation acked by the peer and does not propagate safe time, since the peer may
+  // not have received in flight operations yet.
+  // Returns false if the lease could not be renewed separately, e.g. when the peer state is not
+  // known yet. Otherwise fills 'renewal' with leases that should be passed to
+  // LeaseRenewalResponseFromPeer when the peer successfully processes the request.
+  Result<bool> LeaseRenewalRequestForPeer(
+      const std::string& uuid, LWConsensusRequestPB* request, LeaderLeaseRenewal* renewal);
+
+  // Updates leader lease watermarks of the peer, that accepted the lease renewal.
+  void LeaseRenewalResponseFromPeer(const std::string& uuid, const LeaderLeaseRenewal& renewal);
+
   // Closes the queue, peers are still allowed to call UntrackPeer() and ResponseFromPeer() but no
   // additional peers can be tracked or messages queued.
   virtual void Close();
@@ -490,6 +521,10 @@ class PeerMessageQueue {
 
   void NotifyObserversOfMajorityReplOpChangeTask(const MajorityReplicatedData& data);
 
+  // Schedules compression of log cache operations through the specified index, which are needed
+  // only by followers that did not replicate them yet.
+  void CompressLogCache(int64_t index);
+
   void NotifyObserversOfTermChange(int64_t term);
 
   void NotifyObserversOfFailedFollower(const std::string& uuid,
@@ -591,6 +626,9 @@ class PeerMessageQueue {
 
   LogCache log_cache_;
 
+  // Whether log cache compression task is scheduled on raft_pool_observers_token_.
+  std::atomic<bool> log_cache_compression_scheduled_{false};
+
   std::shared_ptr<MemTracker> operations_mem_tracker_;
 
   Metrics metrics_;
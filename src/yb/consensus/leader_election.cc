@@ -41,6 +41,7 @@
 
 #include "yb/consensus/consensus_peers.h"
 #include "yb/consensus/metadata.pb.h"
+#include "yb/consensus/quorum_util.h"
 
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/port.h"
@@ -159,8 +160,8 @@ LeaderElection::LeaderElection(const RaftConfigPB& config,
       decision_callback_(std::move(decision_callback)) {
   for (const RaftPeerPB& peer : config.peers()) {
     if (request.candidate_uuid() == peer.permanent_uuid()) continue;
-    // Only peers with member_type == VOTER are allowed to vote.
-    if (peer.member_type() != PeerMemberType::VOTER) {
+    // Only voters, including witnesses, are allowed to vote.
+    if (!IsVoterMemberType(peer.member_type())) {
       LOG(INFO) << "Ignoring peer " << peer.permanent_uuid() << " vote because its member type is "
                 << PeerMemberType_Name(peer.member_type());
       continue;
@@ -75,5 +75,12 @@ typedef LeaseData<CoarseTimePoint> CoarseTimeLease;
 
 typedef LeaseData<MicrosTime> PhysicalComponentLease;
 
+// Leader leases sent to a follower by a separate lease renewal request.
+struct LeaderLeaseRenewal {
+  int64_t term = -1;
+  CoarseTimePoint leader_lease_expiration;
+  MicrosTime ht_lease_expiration = 0;
+};
+
 } // namespace consensus
 } // namespace yb
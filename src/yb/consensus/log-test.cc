@@ -58,6 +58,7 @@ DEFINE_int32(num_batches, 10000,
              "Number of batches to write to/read from the Log in TestWriteManyBatches");
 
 DECLARE_int32(log_min_segments_to_retain);
+DECLARE_int32(log_max_recycled_segments);
 DECLARE_bool(never_fsync);
 DECLARE_bool(writable_file_use_fsync);
 DECLARE_int32(o_direct_block_alignment_bytes);
@@ -774,6 +775,42 @@ TEST_F(LogTest, TestGCOfIndexChunks) {
   ASSERT_TRUE(!result.ok() && result.status().IsNotFound()) << "unexpected result: " << result;
 }
 
+// Tests that GCed segment files are recycled and reused by the following segment allocations.
+TEST_F(LogTest, TestGCRecyclesSegments) {
+  FLAGS_log_min_segments_to_retain = 1;
+  FLAGS_log_max_recycled_segments = 1;
+  BuildLog();
+
+  auto count_recycled_files = [this]() -> Result<size_t> {
+    auto files = VERIFY_RESULT(env_->GetChildren(tablet_wal_path_, ExcludeDots::kTrue));
+    return static_cast<size_t>(std::count_if(
+        files.begin(), files.end(), [](const std::string& file) {
+          return HasPrefixString(file, ".tmp.recycledsegment");
+        }));
+  };
+
+  const int kNumOpsPerSegment = 5;
+  OpIdPB op_id = MakeOpId(1, 1);
+  ASSERT_OK(AppendMultiSegmentSequence(4, kNumOpsPerSegment, &op_id, /* anchors = */ nullptr));
+
+  int num_gced_segments = 0;
+  ASSERT_OK(log_->GC(op_id.index(), &num_gced_segments));
+  ASSERT_EQ(3, num_gced_segments);
+  CheckRightNumberOfSegmentFiles(1);
+  // Only one of the GCed segments is kept for reuse, the others are deleted.
+  ASSERT_EQ(1, ASSERT_RESULT(count_recycled_files()));
+
+  // Rolling over picks up the recycled file, and the new segments are readable.
+  ASSERT_OK(AppendMultiSegmentSequence(3, kNumOpsPerSegment, &op_id, /* anchors = */ nullptr));
+  ASSERT_EQ(0, ASSERT_RESULT(count_recycled_files()));
+  const auto last_index = op_id.index() - 1;
+  auto loaded_op = ASSERT_RESULT(log_->GetLogReader()->LookupOpId(last_index));
+  ASSERT_EQ(yb::OpId(1, last_index), loaded_op);
+
+  ASSERT_OK(log_->Close());
+  CheckRightNumberOfSegmentFiles(3);
+}
+
 // Tests that we can append FLUSH_MARKER messages to the log queue to make sure
 // all messages up to a certain point were fsync()ed without actually
 // writing them to the log.
@@ -52,6 +52,7 @@
 #include "yb/consensus/log_index.h"
 #include "yb/consensus/log_metrics.h"
 #include "yb/consensus/log_reader.h"
+#include "yb/consensus/log_sync_group.h"
 #include "yb/consensus/log_util.h"
 
 #include "yb/fs/fs_manager.h"
@@ -116,6 +117,12 @@ DEFINE_RUNTIME_int32(log_min_seconds_to_retain, 900,
     "machines.");
 TAG_FLAG(log_min_seconds_to_retain, advanced);
 
+DEFINE_RUNTIME_int32(log_max_recycled_segments, 0,
+    "The maximum number of GCed log segment files per tablet that are kept for reuse by the "
+    "following segment allocations, instead of being deleted. Reusing a file avoids creating "
+    "and unlinking an inode on every segment roll over.");
+TAG_FLAG(log_max_recycled_segments, advanced);
+
 // Flag to enable background log sync. When enabled, we DON'T wait for performing fsync until
 // either
 // 1. unsynced data reaches bytes_durable_wal_write_mb_ threshold OR
@@ -130,6 +137,10 @@ TAG_FLAG(log_min_seconds_to_retain, advanced);
 // every call to Log::Sync()
 DEFINE_bool(log_enable_background_sync, true,
             "If true, log fsync operations in the aggresively performed in the background.");
+DEFINE_NON_RUNTIME_bool(log_group_sync, false,
+    "Whether log syncs of all tablets, whose WALs are located on the same file system, are "
+    "coalesced into shared sync rounds. See log_sync_per_file_system and "
+    "log_sync_coalescing_window_us.");
 DEFINE_double(log_background_sync_data_fraction, 0.5,
              "When log_enable_background_sync is enabled and periodic_sync_unsynced_bytes_ "
              "reaches bytes_durable_wal_write_mb_*log_background_sync_data_fraction, the fsync "
@@ -220,6 +231,7 @@ DEFINE_validator(log_min_segments_to_retain, &ValidateLogsToRetain);
 
 static std::string kSegmentPlaceholderFilePrefix = ".tmp.newsegment";
 static std::string kSegmentPlaceholderFileTemplate = kSegmentPlaceholderFilePrefix + "XXXXXX";
+static std::string kRecycledSegmentFilePrefix = ".tmp.recycledsegment";
 
 namespace yb {
 namespace log {
@@ -238,6 +250,10 @@ bool IsMarkerType(LogEntryTypePB type) {
          type == LogEntryTypePB::FLUSH_MARKER;
 }
 
+size_t MaxRecycledSegments() {
+  return std::max(FLAGS_log_max_recycled_segments, 0);
+}
+
 } // namespace
 
 // This class represents a batch of operations to be written and synced to the log. It is opaque to
@@ -634,6 +650,9 @@ Status Log::Init() {
   CHECK_EQ(kLogInitialized, log_state_);
   // Init the index
   log_index_ = VERIFY_RESULT(LogIndex::NewLogIndex(wal_dir_));
+  if (FLAGS_log_group_sync) {
+    sync_group_ = VERIFY_RESULT(LogSyncGroup::ForDir(wal_dir_));
+  }
   // Reader for previous segments.
   RETURN_NOT_OK(LogReader::Open(get_env(),
                                 log_index_,
@@ -642,6 +661,7 @@ Status Log::Init() {
                                 table_metric_entity_.get(),
                                 tablet_metric_entity_.get(),
                                 &reader_));
+  RETURN_NOT_OK(LoadRecycledSegmentFiles());
 
   // The case where we are continuing an existing log.  We must pick up where the previous WAL left
   // off in terms of sequence numbers.
@@ -1000,7 +1020,15 @@ Status Log::DoSync() {
   LOG_SLOW_EXECUTION_EVERY_N_SECS(INFO, /* log at most one slow execution every 1 sec */ 1,
                                   50, "Fsync log took a long time") {
     SCOPED_LATENCY_METRIC(metrics_, sync_latency);
-    status = active_segment_->Sync();
+    if (sync_group_) {
+      size_t batch_size = 0;
+      status = sync_group_->Sync(active_segment_.get(), &batch_size);
+      if (metrics_) {
+        metrics_->sync_batch_size->Increment(batch_size);
+      }
+    } else {
+      status = active_segment_->Sync();
+    }
   }
 
   return status;
@@ -1349,7 +1377,11 @@ Status Log::GC(int64_t min_op_idx, int32_t* num_gced) {
       LOG_WITH_PREFIX(INFO) << "Deleting log segment in path: " << segment->path()
                             << " (GCed ops < " << segment->footer().max_replicate_index() + 1
                             << ")";
-      RETURN_NOT_OK(get_env()->DeleteFile(segment->path()));
+      auto recycled = VERIFY_RESULT(RecycleSegmentFile(
+          segment->path(), segment->header().sequence_number()));
+      if (!recycled) {
+        RETURN_NOT_OK(get_env()->DeleteFile(segment->path()));
+      }
       (*num_gced)++;
 
       if (metrics_) {
@@ -1686,7 +1718,9 @@ Status Log::PreAllocateNewSegment() {
   CHECK_EQ(allocation_state(), SegmentAllocationState::kAllocationInProgress);
 
   auto opts = GetNewSegmentWritableFileOptions();
-  RETURN_NOT_OK(CreatePlaceholderSegment(opts, &next_segment_path_, &next_segment_file_));
+  if (!VERIFY_RESULT(ReuseRecycledSegmentFile(opts, &next_segment_path_, &next_segment_file_))) {
+    RETURN_NOT_OK(CreatePlaceholderSegment(opts, &next_segment_path_, &next_segment_file_));
+  }
 
   if (options_.preallocate_segments) {
     uint64_t next_segment_size = NextSegmentDesiredSize();
@@ -1805,6 +1839,56 @@ Status Log::CreatePlaceholderSegment(const WritableFileOptions& opts,
   return Status::OK();
 }
 
+Result<bool> Log::RecycleSegmentFile(const std::string& path, uint64_t sequence_number) {
+  std::lock_guard<std::mutex> lock(recycled_segments_mutex_);
+  if (recycled_segments_.size() >= MaxRecycledSegments()) {
+    return false;
+  }
+  auto recycled_path = JoinPathSegments(
+      wal_dir_, Format("$0$1", kRecycledSegmentFilePrefix, sequence_number));
+  VLOG_WITH_PREFIX(1) << "Recycling log segment " << path << " to " << recycled_path;
+  RETURN_NOT_OK(get_env()->RenameFile(path, recycled_path));
+  recycled_segments_.push_back(std::move(recycled_path));
+  return true;
+}
+
+Result<bool> Log::ReuseRecycledSegmentFile(const WritableFileOptions& opts,
+                                           std::string* result_path,
+                                           std::shared_ptr<WritableFile>* out) {
+  {
+    std::lock_guard<std::mutex> lock(recycled_segments_mutex_);
+    if (recycled_segments_.empty()) {
+      return false;
+    }
+    *result_path = std::move(recycled_segments_.back());
+    recycled_segments_.pop_back();
+  }
+  // The file is truncated on open. The reader of a segment without footer relies on the
+  // preallocated space being zeroed, so entries of the old segment must not be left in there.
+  std::unique_ptr<WritableFile> segment_file;
+  RETURN_NOT_OK(get_env()->NewWritableFile(opts, *result_path, &segment_file));
+  VLOG_WITH_PREFIX(1) << "Reusing recycled file for next WAL segment, path: " << *result_path;
+  out->reset(segment_file.release());
+  return true;
+}
+
+Status Log::LoadRecycledSegmentFiles() {
+  auto children = VERIFY_RESULT(get_env()->GetChildren(wal_dir_, ExcludeDots::kTrue));
+  std::lock_guard<std::mutex> lock(recycled_segments_mutex_);
+  for (const auto& child : children) {
+    if (!boost::starts_with(child, kRecycledSegmentFilePrefix)) {
+      continue;
+    }
+    auto path = JoinPathSegments(wal_dir_, child);
+    if (recycled_segments_.size() < MaxRecycledSegments()) {
+      recycled_segments_.push_back(std::move(path));
+    } else {
+      RETURN_NOT_OK(get_env()->DeleteFile(path));
+    }
+  }
+  return Status::OK();
+}
+
 uint64_t Log::active_segment_sequence_number() const {
   return active_segment_sequence_number_;
 }
@@ -371,6 +371,20 @@ class Log : public RefCountedThreadSafe<Log> {
                                           std::string* result_path,
                                           std::shared_ptr<WritableFile>* out);
 
+  // Renames the GCed segment file at 'path' to a recycled file, that could be reused by the
+  // following segment allocation. Returns false when there are already enough recycled files.
+  Result<bool> RecycleSegmentFile(const std::string& path, uint64_t sequence_number)
+      EXCLUDES(recycled_segments_mutex_);
+
+  // Opens a recycled file as the placeholder segment, if there is one. Returns false otherwise.
+  Result<bool> ReuseRecycledSegmentFile(const WritableFileOptions& opts,
+                                        std::string* result_path,
+                                        std::shared_ptr<WritableFile>* out)
+      EXCLUDES(recycled_segments_mutex_);
+
+  // Picks up recycled files left in the WAL dir by the previous run.
+  Status LoadRecycledSegmentFiles() EXCLUDES(recycled_segments_mutex_);
+
   // Creates a new WAL segment on disk, writes the next_segment_header_ to disk as the header, and
   // sets active_segment_ to point to this new segment.
   Status SwitchToAllocatedSegment() EXCLUDES(active_segment_mutex_);
@@ -509,6 +523,10 @@ class Log : public RefCountedThreadSafe<Log> {
   // true as long as append/truncate are being performed by the same thread.
   std::unique_ptr<WritableLogSegment> active_segment_;
 
+  // When set, syncs of the active segment are performed as part of file system wide sync rounds,
+  // shared with logs of other tablets on the same file system.
+  std::shared_ptr<LogSyncGroup> sync_group_;
+
   // The current (active) segment sequence number. Initialized in the Log constructor based on
   // LogOptions.
   std::atomic<uint64_t> active_segment_sequence_number_;
@@ -519,6 +537,11 @@ class Log : public RefCountedThreadSafe<Log> {
   // The path for the next allocated segment.
   std::string next_segment_path_;
 
+  std::mutex recycled_segments_mutex_;
+
+  // Paths of GCed segment files, that are kept to be reused by the following segment allocations.
+  std::vector<std::string> recycled_segments_ GUARDED_BY(recycled_segments_mutex_);
+
   // Lock to protect mutations to log_state_ and other shared state variables.
   mutable percpu_rwlock state_lock_;
 
@@ -68,6 +68,8 @@ using std::thread;
 DECLARE_int32(log_cache_size_limit_mb);
 DECLARE_int32(global_log_cache_size_limit_mb);
 DECLARE_int32(global_log_cache_size_limit_percentage);
+DECLARE_bool(log_cache_compress_ops);
+DECLARE_int32(log_cache_compression_threshold_percentage);
 DECLARE_bool(TEST_pause_before_wal_sync);
 DECLARE_bool(TEST_set_pause_before_wal_sync);
 
@@ -367,6 +369,71 @@ TEST_F(LogCacheTest, TestMemoryLimit) {
   ASSERT_EQ(cache_->BytesUsed(), 0);
 }
 
+TEST_F(LogCacheTest, TestCompression) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_cache_compress_ops) = true;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_cache_compression_threshold_percentage) = 0;
+
+  const int kPayloadSize = 100_KB;
+  ASSERT_OK(AppendReplicateMessagesToCache(1, 3, kPayloadSize));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+  auto size_before = cache_->BytesUsed();
+
+  cache_->CompressThroughOp(2);
+  ASSERT_EQ(3, cache_->num_cached_ops());
+  ASSERT_EQ(2, cache_->metrics_.num_compressed_ops->value());
+  ASSERT_LT(cache_->BytesUsed(), size_before / 2);
+
+  auto disk_reads = cache_->metrics_.disk_reads->value();
+  auto read_result = ASSERT_RESULT(cache_->ReadOps(0, 8_MB));
+  ASSERT_EQ(3, read_result.messages.size());
+  for (int64_t i = 0; i != 3; ++i) {
+    const auto& msg = *read_result.messages[i];
+    ASSERT_EQ(i + 1, msg.id().index());
+    ASSERT_EQ(std::string(kPayloadSize, 'Y'), msg.noop_request().payload_for_tests().ToBuffer());
+  }
+  ASSERT_EQ(disk_reads, cache_->metrics_.disk_reads->value());
+  ASSERT_EQ(3, cache_->metrics_.hits->value());
+
+  cache_->EvictThroughOp(3);
+  ASSERT_EQ(0, cache_->num_cached_ops());
+  ASSERT_EQ(0, cache_->metrics_.num_compressed_ops->value());
+  ASSERT_EQ(0, cache_->BytesUsed());
+}
+
+TEST_F(LogCacheTest, TestDiskReadOps) {
+  const int kPayloadSize = 100_KB;
+  ASSERT_OK(AppendReplicateMessagesToCache(1, 3, kPayloadSize));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+  cache_->EvictThroughOp(3);
+  ASSERT_EQ(0, cache_->num_cached_ops());
+
+  // The first read goes to disk, the second one is served from operations it has read.
+  for (int i = 0; i != 2; ++i) {
+    auto read_result = ASSERT_RESULT(cache_->ReadOps(0, 8_MB));
+    ASSERT_EQ(3, read_result.messages.size());
+    for (int64_t j = 0; j != 3; ++j) {
+      ASSERT_EQ(j + 1, read_result.messages[j]->id().index());
+    }
+    ASSERT_EQ(3, cache_->metrics_.disk_reads->value());
+    ASSERT_EQ(i * 3, cache_->metrics_.disk_read_ops_hits->value());
+  }
+
+  // Read starting in the middle of kept operations.
+  auto read_result = ASSERT_RESULT(cache_->ReadOps(1, 8_MB));
+  ASSERT_EQ(2, read_result.messages.size());
+  ASSERT_EQ(3, cache_->metrics_.disk_reads->value());
+  ASSERT_EQ(5, cache_->metrics_.disk_read_ops_hits->value());
+
+  // Overwritten operations are not kept.
+  ASSERT_OK(AppendReplicateMessagesToCache(2, 1, kPayloadSize));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+  cache_->EvictThroughOp(2);
+  read_result = ASSERT_RESULT(cache_->ReadOps(0, 8_MB));
+  ASSERT_EQ(2, read_result.messages.size());
+  ASSERT_EQ(4, cache_->metrics_.disk_reads->value());
+  ASSERT_EQ(6, cache_->metrics_.disk_read_ops_hits->value());
+}
+
 TEST_F(LogCacheTest, TestGlobalMemoryLimitMB) {
   ANNOTATE_UNPROTECTED_WRITE(FLAGS_global_log_cache_size_limit_mb) = 4;
   ANNOTATE_UNPROTECTED_WRITE(FLAGS_global_log_cache_size_limit_percentage) = 100;
@@ -37,6 +37,8 @@
 #include <mutex>
 #include <vector>
 
+#include <lz4.h>
+
 #include "yb/consensus/consensus.messages.h"
 #include "yb/consensus/consensus_util.h"
 #include "yb/consensus/log.h"
@@ -44,6 +46,7 @@
 #include "yb/consensus/opid_util.h"
 
 #include "yb/gutil/bind.h"
+#include "yb/gutil/casts.h"
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/strings/human_readable.h"
 
@@ -52,6 +55,7 @@
 #include "yb/util/locks.h"
 #include "yb/util/logging.h"
 #include "yb/util/mem_tracker.h"
+#include "yb/util/memory/arena.h"
 #include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
 #include "yb/util/result.h"
@@ -62,6 +66,7 @@ using std::vector;
 using std::string;
 
 using namespace std::literals;
+using namespace yb::size_literals;
 
 DEFINE_int32(log_cache_size_limit_mb, 128,
              "The total per-tablet size of consensus entries which may be kept in memory. "
@@ -80,6 +85,28 @@ DEFINE_int32(global_log_cache_size_limit_percentage, 5,
              "entries across all tablets. Default is 5.");
 TAG_FLAG(global_log_cache_size_limit_percentage, advanced);
 
+DEFINE_RUNTIME_bool(log_cache_compress_ops, false,
+    "Whether operations that were replicated to the majority, but are still needed by lagging "
+    "followers, are LZ4 compressed in the log cache when it is close to its memory limit. "
+    "Allows the cache to keep more operations for lagging followers, instead of reading them "
+    "from disk, at the cost of compression on the leader.");
+
+DEFINE_RUNTIME_int32(log_cache_compression_threshold_percentage, 50,
+    "Log cache operations are compressed only when the tablet log cache, or log caches of all "
+    "tablets, use more than this percentage of their memory limit.");
+
+DEFINE_RUNTIME_uint64(log_cache_compression_min_op_size, 256,
+    "Log cache operations smaller than this size in bytes are not compressed.");
+
+DEFINE_RUNTIME_uint64(log_cache_compression_max_batch_size, 1_MB,
+    "Max total size in bytes of log cache operations compressed in one batch.");
+
+DEFINE_RUNTIME_uint64(log_cache_disk_read_ops_size_limit_mb, 8,
+    "Max total size of operations recently read from disk, that are kept per tablet to serve "
+    "following reads of the same range, e.g. by several CDC streams of the tablet, without "
+    "reading and decoding them from disk again. 0 disables keeping them.");
+TAG_FLAG(log_cache_disk_read_ops_size_limit_mb, advanced);
+
 DEFINE_test_flag(bool, log_cache_skip_eviction, false,
                  "Don't evict log entries in tests.");
 
@@ -94,6 +121,19 @@ METRIC_DEFINE_gauge_int64(tablet, log_cache_size, "Log Cache Memory Usage",
 METRIC_DEFINE_counter(tablet, log_cache_disk_reads, "Log Cache Disk Reads",
                       yb::MetricUnit::kEntries,
                       "Amount of operations read from disk.");
+METRIC_DEFINE_counter(tablet, log_cache_hits, "Log Cache Hits",
+                      yb::MetricUnit::kEntries,
+                      "Amount of operations read from the log cache.");
+METRIC_DEFINE_counter(tablet, log_cache_disk_read_ops_hits, "Log Cache Disk Read Ops Hits",
+                      yb::MetricUnit::kEntries,
+                      "Amount of operations served from operations recently read from disk.");
+METRIC_DEFINE_gauge_int64(tablet, log_cache_num_compressed_ops,
+                          "Log Cache Compressed Operation Count",
+                          yb::MetricUnit::kOperations,
+                          "Number of compressed operations in the log cache.");
+METRIC_DEFINE_counter(tablet, log_cache_decompress_time_us, "Log Cache Decompression Time",
+                      yb::MetricUnit::kMicroseconds,
+                      "Time spent decompressing operations read from the log cache.");
 
 DECLARE_bool(get_changes_honor_deadline);
 
@@ -108,6 +148,10 @@ const std::string kParentMemTrackerId = "log_cache"s;
 
 typedef vector<const ReplicateMsg*>::const_iterator MsgIter;
 
+OpId LogCache::CacheEntry::id() const {
+  return msg ? OpId::FromPB(msg->id()) : compressed.id;
+}
+
 LogCache::LogCache(const scoped_refptr<MetricEntity>& metric_entity,
                    const log::LogPtr& log,
                    const MemTrackerPtr& server_tracker,
@@ -161,6 +205,7 @@ LogCache::~LogCache() {
   {
     std::lock_guard<simple_spinlock> l(lock_);
     cache_.clear();
+    disk_read_ops_.clear();
   }
 
   tracker_->UnregisterFromParent();
@@ -207,6 +252,9 @@ LogCache::PrepareAppendResult LogCache::PrepareAppendOperations(const ReplicateM
         cache_.erase(it);
       }
     }
+    ++num_overwrites_;
+    EraseDiskReadOpsUnlocked(
+        disk_read_ops_.lower_bound(first_idx_in_batch), disk_read_ops_.end());
 
     if (min_pinned_op_index_ < next_sequential_op_index_) {
       // There are ops in progress of flushing, increment the counter to avoid ops in the
@@ -309,7 +357,7 @@ Result<yb::OpId> LogCache::LookupOpId(int64_t op_index) const {
     }
     auto iter = cache_.find(op_index);
     if (iter != cache_.end()) {
-      return yb::OpId::FromPB(iter->second.msg->id());
+      return iter->second.id();
     }
   }
 
@@ -321,13 +369,21 @@ namespace {
 
 // Calculate the total byte size that will be used on the wire to replicate this message as part of
 // a consensus update request. This accounts for the length delimiting and tagging of the message.
-int64_t TotalByteSizeForMessage(const LWReplicateMsg& msg) {
+int64_t TotalByteSizeForSerializedSize(size_t serialized_size) {
   auto msg_size = google::protobuf::internal::WireFormatLite::LengthDelimitedSize(
-      msg.SerializedSize());
+      serialized_size);
   msg_size += 1; // for the type tag
   return msg_size;
 }
 
+// Messages are not modified after they were added to the cache or read from the log, and their
+// size was already calculated at that point, so cached size is used to avoid walking the whole
+// message again.
+int64_t TotalByteSizeForMessage(const LWReplicateMsg& msg) {
+  DCHECK_EQ(msg.cached_size(), msg.SerializedSize());
+  return TotalByteSizeForSerializedSize(msg.cached_size());
+}
+
 Status UpdateResultHeaderSchemaFromSegment(
     log::LogReader* log_reader, const int64_t segment_seq_num, ReadOpsResult* result) {
   const auto segment_result = log_reader->GetSegmentBySequenceNumber(segment_seq_num);
@@ -347,6 +403,20 @@ Status UpdateResultHeaderSchemaFromSegment(
   return Status::OK();
 }
 
+// Picks header schema of WAL segment, that contains operation with specified index.
+Status UpdateResultHeaderSchemaForOp(
+    log::LogReader* log_reader, int64_t op_index, ReadOpsResult* result) {
+  const auto seg_num_result = log_reader->LookupOpWalSegmentNumber(op_index);
+  if (seg_num_result.ok()) {
+    return UpdateResultHeaderSchemaFromSegment(log_reader, *seg_num_result, result);
+  }
+  if (!seg_num_result.status().IsNotFound()) {
+    // Unexpected error - to be handled by the caller.
+    return seg_num_result.status();
+  }
+  return Status::OK();
+}
+
 } // anonymous namespace
 
 Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index, size_t max_size_bytes) {
@@ -370,6 +440,9 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
   ReadOpsResult result;
   int64_t starting_op_segment_seq_num;
   result.preceding_op = VERIFY_RESULT(LookupOpId(after_op_index));
+  // Compressed operations picked from the cache, with their positions in result.messages.
+  // They are decompressed after the lock is released.
+  std::vector<std::pair<size_t, CompressedMsg>> compressed_messages;
 
   std::unique_lock<simple_spinlock> l(lock_);
   int64_t next_index = after_op_index + 1;
@@ -402,6 +475,32 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
         up_to = std::min(iter->first - 1, to_index - 1);
       }
 
+      // Operations could be already read from disk by another reader of the same range.
+      auto disk_read_it = disk_read_ops_.find(next_index);
+      if (disk_read_it != disk_read_ops_.end()) {
+        if (!result.header_schema.IsInitialized()) {
+          RETURN_NOT_OK(UpdateResultHeaderSchemaForOp(log_->GetLogReader(), next_index, &result));
+        }
+        for (; disk_read_it != disk_read_ops_.end() && disk_read_it->first == next_index &&
+               next_index <= up_to; ++disk_read_it) {
+          const auto& msg = disk_read_it->second;
+          auto current_message_size = TotalByteSizeForMessage(*msg);
+          remaining_space -= current_message_size;
+          if (remaining_space < 0 && !result.messages.empty()) {
+            break;
+          }
+          metrics_.disk_read_ops_hits->Increment();
+          result.messages.push_back(msg);
+          if (msg->op_type() == consensus::OperationType::CHANGE_METADATA_OP) {
+            msg->change_metadata_request().schema().ToGoogleProtobuf(&result.header_schema);
+            result.header_schema_version = msg->change_metadata_request().schema_version();
+          }
+          next_index++;
+        }
+        continue;
+      }
+
+      const auto num_overwrites = num_overwrites_;
       l.unlock();
 
       ReplicateMsgs raw_replicate_ptrs;
@@ -420,6 +519,9 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
       LOG_WITH_PREFIX(INFO)
           << "Successfully read " << raw_replicate_ptrs.size() << " ops from disk.";
       l.lock();
+      if (num_overwrites == num_overwrites_) {
+        AddDiskReadOpsUnlocked(raw_replicate_ptrs);
+      }
 
       for (auto& msg : raw_replicate_ptrs) {
         CHECK_EQ(next_index, msg->id().index());
@@ -438,15 +540,7 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
         next_index++;
       }
     } else {
-      const auto seg_num_result = log_->GetLogReader()->LookupOpWalSegmentNumber(next_index);
-      if (seg_num_result.ok()) {
-        starting_op_segment_seq_num = *seg_num_result;
-        RETURN_NOT_OK(UpdateResultHeaderSchemaFromSegment(
-            log_->GetLogReader(), starting_op_segment_seq_num, &result));
-      } else if (!seg_num_result.status().IsNotFound()) {
-        // Unexpected error - to be handled by the caller.
-        return seg_num_result.status();
-      }
+      RETURN_NOT_OK(UpdateResultHeaderSchemaForOp(log_->GetLogReader(), next_index, &result));
 
       // Pull contiguous messages from the cache until the size limit is achieved.
       for (; iter != cache_.end(); ++iter) {
@@ -454,17 +548,30 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
           break;
         }
         const ReplicateMsgPtr& msg = iter->second.msg;
-        int64_t index = msg->id().index();
+        int64_t index = iter->first;
         if (index != next_index) {
           continue;
         }
 
+        if (!msg) {
+          const auto& compressed = iter->second.compressed;
+          remaining_space -= TotalByteSizeForSerializedSize(compressed.serialized_size);
+          if (remaining_space < 0 && !result.messages.empty()) {
+            break;
+          }
+          compressed_messages.emplace_back(result.messages.size(), compressed);
+          result.messages.emplace_back();
+          next_index++;
+          continue;
+        }
+
         auto current_message_size = TotalByteSizeForMessage(*msg);
         remaining_space -= current_message_size;
         if (remaining_space < 0 && !result.messages.empty()) {
           break;
         }
 
+        metrics_.hits->Increment();
         result.messages.push_back(msg);
         if (msg->op_type() == consensus::OperationType::CHANGE_METADATA_OP) {
           msg->change_metadata_request().schema().ToGoogleProtobuf(&result.header_schema);
@@ -475,9 +582,48 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
     }
   }
   result.have_more_messages = HaveMoreMessages(remaining_space < 0);
+
+  if (!compressed_messages.empty()) {
+    l.unlock();
+    MonoTime start = MonoTime::Now();
+    for (const auto& [position, compressed] : compressed_messages) {
+      result.messages[position] = VERIFY_RESULT(Decompress(compressed));
+    }
+    metrics_.decompress_time_us->IncrementBy((MonoTime::Now() - start).ToMicroseconds());
+    metrics_.hits->IncrementBy(compressed_messages.size());
+  }
   return result;
 }
 
+void LogCache::AddDiskReadOpsUnlocked(const ReplicateMsgs& msgs) {
+  const auto limit = GetAtomicFlag(&FLAGS_log_cache_disk_read_ops_size_limit_mb) * 1_MB;
+  if (limit == 0) {
+    EraseDiskReadOpsUnlocked(disk_read_ops_.begin(), disk_read_ops_.end());
+    return;
+  }
+  for (const auto& msg : msgs) {
+    if (disk_read_ops_.emplace(msg->id().index(), msg).second) {
+      disk_read_ops_bytes_ += TotalByteSizeForMessage(*msg);
+    }
+  }
+  // Readers proceed to higher indexes, so the oldest operations are the least likely to be read
+  // again.
+  auto it = disk_read_ops_.begin();
+  while (disk_read_ops_bytes_ > limit && it != disk_read_ops_.end()) {
+    disk_read_ops_bytes_ -= TotalByteSizeForMessage(*it->second);
+    ++it;
+  }
+  disk_read_ops_.erase(disk_read_ops_.begin(), it);
+}
+
+void LogCache::EraseDiskReadOpsUnlocked(
+    DiskReadOps::const_iterator begin, DiskReadOps::const_iterator end) {
+  for (auto it = begin; it != end; ++it) {
+    disk_read_ops_bytes_ -= TotalByteSizeForMessage(*it->second);
+  }
+  disk_read_ops_.erase(begin, end);
+}
+
 size_t LogCache::EvictThroughOp(int64_t index, int64_t bytes_to_evict) {
   // Capture the evicted messages and release the memory outside of lock.
   ReplicateMsgVector evicted_messages;
@@ -506,8 +652,8 @@ size_t LogCache::EvictSomeUnlocked(int64_t stop_after_index, int64_t bytes_to_ev
   for (auto iter = cache_.begin(); iter != cache_.end();) {
     const CacheEntry& entry = iter->second;
     const ReplicateMsgPtr& msg = entry.msg;
-    VLOG_WITH_PREFIX_UNLOCKED(2) << "considering for eviction: " << OpId::FromPB(msg->id());
-    int64_t msg_index = msg->id().index();
+    VLOG_WITH_PREFIX_UNLOCKED(2) << "considering for eviction: " << entry.id();
+    int64_t msg_index = iter->first;
     if (msg_index == 0) {
       // Always keep our special '0' op.
       ++iter;
@@ -518,7 +664,7 @@ size_t LogCache::EvictSomeUnlocked(int64_t stop_after_index, int64_t bytes_to_ev
       break;
     }
 
-    VLOG_WITH_PREFIX_UNLOCKED(2) << "Evicting cache. Removing: " << OpId::FromPB(msg->id());
+    VLOG_WITH_PREFIX_UNLOCKED(2) << "Evicting cache. Removing: " << entry.id();
     AccountForMessageRemovalUnlocked(entry);
     bytes_evicted += entry.mem_usage;
 
@@ -540,6 +686,120 @@ void LogCache::AccountForMessageRemovalUnlocked(const CacheEntry& entry) REQUIRE
   }
   metrics_.size->DecrementBy(entry.mem_usage);
   metrics_.num_ops->Decrement();
+  if (!entry.msg) {
+    metrics_.num_compressed_ops->Decrement();
+  }
+}
+
+bool LogCache::ShouldCompress() const {
+  auto threshold = FLAGS_log_cache_compression_threshold_percentage;
+  for (const auto* tracker : {tracker_.get(), parent_tracker_.get()}) {
+    if (tracker->has_limit() && tracker->consumption() * 100 > tracker->limit() * threshold) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void LogCache::CompressThroughOp(int64_t index) {
+  if (!FLAGS_log_cache_compress_ops || !ShouldCompress()) {
+    return;
+  }
+
+  const auto min_op_size = FLAGS_log_cache_compression_min_op_size;
+  const auto max_batch_size = FLAGS_log_cache_compression_max_batch_size;
+  // Also keeps the original messages alive, so they are released outside of lock.
+  std::vector<ReplicateMsgPtr> candidates;
+  {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    size_t batch_size = 0;
+    for (const auto& [msg_index, entry] : cache_) {
+      if (msg_index > index || msg_index >= min_pinned_op_index_ ||
+          batch_size >= max_batch_size) {
+        break;
+      }
+      // Keep our special '0' op, and operations that ReadOps takes header schema from.
+      if (msg_index == 0 || !entry.msg || entry.mem_usage < min_op_size ||
+          entry.msg->op_type() == consensus::OperationType::CHANGE_METADATA_OP) {
+        continue;
+      }
+      candidates.push_back(entry.msg);
+      batch_size += entry.mem_usage;
+    }
+  }
+  if (candidates.empty()) {
+    return;
+  }
+
+  std::vector<CompressedMsg> compressed_messages;
+  compressed_messages.reserve(candidates.size());
+  RefCntBuffer serialized;
+  std::string buffer;
+  for (const auto& msg : candidates) {
+    auto serialized_size = msg->SerializedSize();
+    if (serialized.size() < serialized_size) {
+      serialized = RefCntBuffer(serialized_size);
+    }
+    msg->SerializeToArray(serialized.udata());
+    buffer.resize(LZ4_compressBound(narrow_cast<int>(serialized_size)));
+    int compressed_size = LZ4_compress_default(
+        serialized.data(), buffer.data(), narrow_cast<int>(serialized_size),
+        narrow_cast<int>(buffer.size()));
+    // Don't keep operations that don't compress well, i.e. are already compressed by the client.
+    if (compressed_size <= 0 || static_cast<size_t>(compressed_size) * 10 > serialized_size * 9) {
+      compressed_messages.emplace_back();
+      continue;
+    }
+    compressed_messages.push_back(CompressedMsg {
+      .id = OpId::FromPB(msg->id()),
+      .serialized_size = serialized_size,
+      .data = RefCntBuffer(buffer.data(), compressed_size),
+    });
+  }
+
+  std::lock_guard<simple_spinlock> lock(lock_);
+  for (size_t i = 0; i != candidates.size(); ++i) {
+    auto& compressed = compressed_messages[i];
+    if (compressed.data.empty()) {
+      continue;
+    }
+    auto it = cache_.find(compressed.id.index);
+    // The entry could be evicted or overwritten while we were compressing it.
+    if (it == cache_.end() || it->second.msg != candidates[i]) {
+      continue;
+    }
+    auto& entry = it->second;
+    auto freed = entry.mem_usage - compressed.data.size();
+    if (entry.tracked) {
+      tracker_->Release(freed);
+    }
+    metrics_.size->DecrementBy(freed);
+    metrics_.num_compressed_ops->Increment();
+    entry.msg = nullptr;
+    entry.mem_usage = compressed.data.size();
+    entry.compressed = std::move(compressed);
+  }
+}
+
+Result<ReplicateMsgPtr> LogCache::Decompress(const CompressedMsg& compressed) {
+  struct DataHolder {
+    RefCntBuffer buffer;
+    Arena arena;
+
+    explicit DataHolder(size_t size) : buffer(size) {}
+  };
+
+  auto holder = std::make_shared<DataHolder>(compressed.serialized_size);
+  int size = LZ4_decompress_safe(
+      compressed.data.data(), holder->buffer.data(), narrow_cast<int>(compressed.data.size()),
+      narrow_cast<int>(holder->buffer.size()));
+  if (size < 0 || static_cast<size_t>(size) != compressed.serialized_size) {
+    return STATUS_FORMAT(
+        Corruption, "Failed to decompress log cache operation $0: $1", compressed.id, size);
+  }
+  auto msg = holder->arena.NewObject<LWReplicateMsg>(&holder->arena);
+  RETURN_NOT_OK(msg->ParseFromSlice(holder->buffer.AsSlice()));
+  return rpc::SharedField(holder, msg);
 }
 
 int64_t LogCache::BytesUsed() const {
@@ -608,6 +868,12 @@ void LogCache::DumpToStrings(vector<string>* lines) const {
   lines->push_back("Messages:");
   for (const auto& entry : cache_) {
     const ReplicateMsgPtr msg = entry.second.msg;
+    if (!msg) {
+      lines->push_back(Format(
+          "Message[$0] $1 : REPLICATE. Compressed, Size: $2",
+          counter++, entry.second.id(), entry.second.compressed.serialized_size));
+      continue;
+    }
     lines->push_back(
       Substitute("Message[$0] $1.$2 : REPLICATE. Type: $3, Size: $4",
                  counter++, msg->id().term(), msg->id().index(),
@@ -627,6 +893,13 @@ void LogCache::DumpToHtml(std::ostream& out) const {
   int counter = 0;
   for (const auto& entry : cache_) {
     const ReplicateMsgPtr msg = entry.second.msg;
+    if (!msg) {
+      out << Format("<tr><th>$0</th><th>$1.$2</th><td>REPLICATE</td>"
+                    "<td>$3</td><td>Compressed</td></tr>",
+                    counter++, entry.second.id().term, entry.second.id().index,
+                    entry.second.compressed.serialized_size) << endl;
+      continue;
+    }
     out << Substitute("<tr><th>$0</th><th>$1.$2</th><td>REPLICATE $3</td>"
                       "<td>$4</td><td>$5</td></tr>",
                       counter++, msg->id().term(), msg->id().index(),
@@ -650,7 +923,7 @@ void LogCache::TrackOperationsMemory(const OpIds& op_ids) {
     size_t mem_required = 0;
     for (const auto& op_id : op_ids) {
       auto it = cache_.find(op_id.index);
-      if (it != cache_.end() && it->second.msg->id().term() == op_id.term) {
+      if (it != cache_.end() && it->second.id().term == op_id.term) {
         mem_required += it->second.mem_usage;
         it->second.tracked = true;
       }
@@ -689,7 +962,11 @@ int64_t LogCache::num_cached_ops() const {
 LogCache::Metrics::Metrics(const scoped_refptr<MetricEntity>& metric_entity)
   : INSTANTIATE_METRIC(num_ops, 0),
     INSTANTIATE_METRIC(size, 0),
-    INSTANTIATE_METRIC(disk_reads) {
+    INSTANTIATE_METRIC(disk_reads),
+    INSTANTIATE_METRIC(hits),
+    INSTANTIATE_METRIC(disk_read_ops_hits),
+    INSTANTIATE_METRIC(num_compressed_ops, 0),
+    INSTANTIATE_METRIC(decompress_time_us) {
 }
 #undef INSTANTIATE_METRIC
 
@@ -60,6 +60,7 @@
 #include "yb/util/monotime.h"
 #include "yb/util/mutex.h"
 #include "yb/util/opid.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/restart_safe_clock.h"
 #include "yb/util/status_callback.h"
 
@@ -151,6 +152,13 @@ class LogCache {
   size_t EvictThroughOp(
       int64_t index, int64_t bytes_to_evict = std::numeric_limits<int64_t>::max());
 
+  // Compress cached operations with op index <= 'index', when the cache is close to its memory
+  // limit. Compressed operations stay in the cache and are decompressed by ReadOps, so peers that
+  // still need them don't have to read them from disk.
+  // Compression is executed without holding the cache lock, so it is expected to be called from
+  // a background thread.
+  void CompressThroughOp(int64_t index);
+
   // Return the number of bytes of memory currently in use by the cache.
   int64_t BytesUsed() const;
 
@@ -190,18 +198,33 @@ class LogCache {
   FRIEND_TEST(LogCacheTest, TestReplaceMessages);
   friend class LogCacheTest;
 
+  // LZ4 compressed serialized operation.
+  struct CompressedMsg {
+    OpId id;
+    // Size of the serialized operation before compression.
+    size_t serialized_size = 0;
+    RefCntBuffer data;
+  };
+
   // An entry in the cache.
   struct CacheEntry {
+    // Null when the entry is compressed.
     ReplicateMsgPtr msg;
     // The cached value of msg->SpaceUsedLong(). This method is expensive
     // to compute, so we compute it only once upon insertion.
+    // Size of the compressed data for compressed entries.
     size_t mem_usage = 0;
 
     // Did we start memory tracking for this entry.
     bool tracked = false;
+
+    CompressedMsg compressed;
+
+    OpId id() const;
   };
 
   typedef boost::container::small_vector<ReplicateMsgPtr, 8> ReplicateMsgVector;
+  typedef std::map<int64_t, ReplicateMsgPtr> DiskReadOps;
 
   // Try to evict the oldest operations from the queue, stopping either when
   // 'bytes_to_evict' bytes have been evicted, or the op with index
@@ -210,10 +233,23 @@ class LogCache {
       int64_t bytes_to_evict,
       ReplicateMsgVector* evicted_messages) REQUIRES(lock_);
 
+  // Returns true when either this cache or all log caches of the server use more than
+  // log_cache_compression_threshold_percentage of their memory limit.
+  bool ShouldCompress() const;
+
+  static Result<ReplicateMsgPtr> Decompress(const CompressedMsg& compressed);
+
   // Update metrics and MemTracker to account for the removal of the
   // given message.
   void AccountForMessageRemovalUnlocked(const CacheEntry& entry) REQUIRES(lock_);
 
+  // Keeps operations read from disk, to serve following reads of them, and evicts the oldest ones
+  // over log_cache_disk_read_ops_size_limit_mb.
+  void AddDiskReadOpsUnlocked(const ReplicateMsgs& msgs) REQUIRES(lock_);
+
+  void EraseDiskReadOpsUnlocked(
+      DiskReadOps::const_iterator begin, DiskReadOps::const_iterator end) REQUIRES(lock_);
+
   // Return a string with stats
   std::string StatsStringUnlocked() const;
 
@@ -258,6 +294,15 @@ class LogCache {
   typedef std::map<int64_t, CacheEntry> MessageCache;
   MessageCache cache_ GUARDED_BY(lock_);
 
+  // Operations recently read from disk, that are not present in cache_. Shared by readers of the
+  // same range, like several CDC streams of the tablet, so each of them does not read and decode
+  // the same operations from disk.
+  DiskReadOps disk_read_ops_ GUARDED_BY(lock_);
+  size_t disk_read_ops_bytes_ GUARDED_BY(lock_) = 0;
+  // Incremented when cached operations are overwritten, so operations that were read from disk
+  // concurrently are not kept.
+  int64_t num_overwrites_ GUARDED_BY(lock_) = 0;
+
   // The next log index to append. Each append operation must either start with this log index, or
   // go backward (but never skip forward).
   int64_t next_sequential_op_index_ GUARDED_BY(lock_);
@@ -290,6 +335,18 @@ class LogCache {
     scoped_refptr<AtomicGauge<int64_t>> size;
 
     scoped_refptr<Counter> disk_reads;
+
+    // Number of operations read from the cache.
+    scoped_refptr<Counter> hits;
+
+    // Number of operations read from operations recently read from disk.
+    scoped_refptr<Counter> disk_read_ops_hits;
+
+    // Keeps track of the number of compressed operations in the cache.
+    scoped_refptr<AtomicGauge<int64_t>> num_compressed_ops;
+
+    // Time spent decompressing operations read from the cache.
+    scoped_refptr<Counter> decompress_time_us;
   };
   Metrics metrics_;
 
@@ -28,6 +28,7 @@ using LogPtr = scoped_refptr<Log>;
 class LogEntryBatchPB;
 class LogEntryPB;
 class LogIndex;
+class LogSyncGroup;
 class LogReader;
 class LogSegmentFooterPB;
 class LogSegmentHeaderPB;
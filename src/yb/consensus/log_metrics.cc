@@ -46,6 +46,11 @@ METRIC_DEFINE_coarse_histogram(table, log_sync_latency, "Log Sync Latency",
                                yb::MetricUnit::kMicroseconds,
                                "Microseconds spent on synchronizing the log segment file");
 
+METRIC_DEFINE_coarse_histogram(table, log_sync_batch_size, "Log Sync Batch Size",
+                               yb::MetricUnit::kRequests,
+                               "Number of log syncs of tablets on the same file system, served by "
+                               "the same sync round");
+
 METRIC_DEFINE_coarse_histogram(table, log_append_latency, "Log Append Latency",
                         yb::MetricUnit::kMicroseconds,
                         "Microseconds spent on appending to the log segment file");
@@ -71,6 +76,7 @@ LogMetrics::LogMetrics(const scoped_refptr<MetricEntity>& table_metric_entity,
     : MINIT(tablet_metric_entity, bytes_logged),
       MINIT(tablet_metric_entity, wal_size),
       MINIT(table_metric_entity, sync_latency),
+      MINIT(table_metric_entity, sync_batch_size),
       MINIT(table_metric_entity, append_latency),
       MINIT(table_metric_entity, group_commit_latency),
       MINIT(table_metric_entity, roll_latency),
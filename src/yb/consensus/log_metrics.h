@@ -53,6 +53,7 @@ struct LogMetrics {
 
   // Per-group group commit stats
   scoped_refptr<Histogram> sync_latency;
+  scoped_refptr<Histogram> sync_batch_size;
   scoped_refptr<Histogram> append_latency;
   scoped_refptr<Histogram> group_commit_latency;
   scoped_refptr<Histogram> roll_latency;
@@ -35,6 +35,8 @@
 #include <algorithm>
 #include <mutex>
 
+#include <boost/range/iterator_range.hpp>
+
 #include <glog/logging.h>
 
 #include "yb/consensus/consensus.messages.h"
@@ -411,6 +413,9 @@ Status LogReader::ReadReplicatesInRange(
   int64_t total_size = 0;
   bool limit_exceeded = false;
   std::shared_ptr<LWLogEntryBatchPB> batch;
+  // Entries of the batch that were not checked yet. Since indexes in a batch are increasing, the
+  // next index could only be found after the previous one.
+  boost::iterator_range<decltype(batch->mutable_entry()->begin())> batch_entries;
   for (int64_t index = starting_at; index <= up_to && !limit_exceeded; index++) {
     // Stop reading if a deadline was specified and the deadline has been exceeded.
     if (deadline != CoarseTimePoint::max() && CoarseMonoClock::Now() >= deadline) {
@@ -447,10 +452,14 @@ Status LogReader::ReadReplicatesInRange(
           << "\nBatch: " << batch->ShortDebugString();
         prev_index = this_index;
       }
+      batch_entries = boost::make_iterator_range(
+          batch->mutable_entry()->begin(), batch->mutable_entry()->end());
     }
 
     bool found = false;
-    for (auto& entry : *batch->mutable_entry()) {
+    while (!batch_entries.empty()) {
+      auto& entry = batch_entries.front();
+      batch_entries.advance_begin(1);
       if (!entry.has_replicate() || entry.replicate().id().index() != index) {
         continue;
       }
@@ -0,0 +1,82 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "yb/consensus/log_sync_group.h"
+#include "yb/consensus/log_util.h"
+
+#include "yb/util/env.h"
+#include "yb/util/format.h"
+#include "yb/util/path_util.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace log {
+
+class LogSyncGroupTest : public YBTest {
+};
+
+TEST_F(LogSyncGroupTest, Coalesce) {
+  auto dir1 = JoinPathSegments(GetTestDataDirectory(), "wal1");
+  auto dir2 = JoinPathSegments(GetTestDataDirectory(), "wal2");
+  ASSERT_OK(env_->CreateDir(dir1));
+  ASSERT_OK(env_->CreateDir(dir2));
+
+  auto group = ASSERT_RESULT(LogSyncGroup::ForDir(dir1));
+  // Both dirs are on the same file system.
+  ASSERT_EQ(group, ASSERT_RESULT(LogSyncGroup::ForDir(dir2)));
+
+  constexpr int kThreads = 8;
+  constexpr int kSyncsPerThread = 20;
+  std::vector<std::unique_ptr<WritableLogSegment>> segments;
+  for (int i = 0; i != kThreads; ++i) {
+    auto path = JoinPathSegments(i % 2 ? dir1 : dir2, Format("segment-$0", i));
+    std::unique_ptr<WritableFile> file;
+    ASSERT_OK(env_->NewWritableFile(path, &file));
+    segments.push_back(std::make_unique<WritableLogSegment>(path, std::move(file)));
+  }
+
+  size_t batch_size = 0;
+  ASSERT_OK(group->Sync(segments.front().get(), &batch_size));
+  ASSERT_EQ(batch_size, 1);
+  ASSERT_EQ(group->TEST_CompletedRounds(), 1);
+
+  std::atomic<size_t> max_batch_size{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i != kThreads; ++i) {
+    threads.emplace_back([group, segment = segments[i].get(), &max_batch_size] {
+      for (int j = 0; j != kSyncsPerThread; ++j) {
+        size_t batch_size = 0;
+        ASSERT_OK(group->Sync(segment, &batch_size));
+        ASSERT_GE(batch_size, 1);
+        ASSERT_LE(batch_size, kThreads);
+        auto current = max_batch_size.load();
+        while (batch_size > current && !max_batch_size.compare_exchange_weak(current, batch_size)) {
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto rounds = group->TEST_CompletedRounds();
+  LOG(INFO) << "Sync rounds: " << rounds << ", max batch size: " << max_batch_size.load();
+  ASSERT_LE(rounds, 1 + kThreads * kSyncsPerThread);
+}
+
+} // namespace log
+} // namespace yb
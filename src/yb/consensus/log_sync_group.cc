@@ -0,0 +1,180 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/log_sync_group.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <unordered_map>
+
+#include "yb/consensus/log_util.h"
+
+#include "yb/util/debug/trace_event.h"
+#include "yb/util/errno.h"
+#include "yb/util/flags.h"
+#include "yb/util/logging.h"
+#include "yb/util/monotime.h"
+#include "yb/util/thread_restrictions.h"
+
+DEFINE_NON_RUNTIME_bool(log_sync_per_file_system, false,
+    "When log_group_sync is set, whether log sync round flushes the whole file system with a "
+    "single syncfs call, instead of fsync of each segment. Intended for WAL dirs on dedicated "
+    "devices with many tablets per tablet server, since syncfs also flushes all other files of "
+    "the file system. Linux 5.8+ is required for syncfs to report write back errors.");
+
+DEFINE_RUNTIME_uint64(log_sync_coalescing_window_us, 0,
+    "Time the log sync round waits for syncs of other tablets on the same file system, before "
+    "executing them together. Trades sync latency for fewer device flushes, useful on HDD and "
+    "network block storage.");
+
+DECLARE_bool(never_fsync);
+
+namespace yb {
+namespace log {
+
+namespace {
+
+class LogSyncGroupRegistry {
+ public:
+  Result<std::shared_ptr<LogSyncGroup>> ForDir(const std::string& dir) {
+    struct stat st;
+    if (stat(dir.c_str(), &st) != 0) {
+      return STATUS_FROM_ERRNO_SPECIAL_EIO_HANDLING(dir, errno);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& weak_group = groups_[st.st_dev];
+    auto group = weak_group.lock();
+    if (group) {
+      return group;
+    }
+    int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+      return STATUS_FROM_ERRNO_SPECIAL_EIO_HANDLING(dir, errno);
+    }
+    group = std::make_shared<LogSyncGroup>(fd, dir);
+    weak_group = group;
+    return group;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<dev_t, std::weak_ptr<LogSyncGroup>> groups_ GUARDED_BY(mutex_);
+};
+
+} // namespace
+
+struct LogSyncGroup::Request {
+  WritableLogSegment* segment = nullptr;
+  bool done = false;
+  size_t batch_size = 0;
+  Status status;
+};
+
+Result<std::shared_ptr<LogSyncGroup>> LogSyncGroup::ForDir(const std::string& dir) {
+  static LogSyncGroupRegistry registry;
+  return registry.ForDir(dir);
+}
+
+LogSyncGroup::LogSyncGroup(int dir_fd, std::string dir)
+    : dir_fd_(dir_fd), dir_(std::move(dir)) {
+}
+
+LogSyncGroup::~LogSyncGroup() {
+  close(dir_fd_);
+}
+
+Status LogSyncGroup::Sync(WritableLogSegment* segment, size_t* batch_size) {
+  Request request;
+  request.segment = segment;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // The round in progress could have started before data of the caller was written, so the
+    // request is served by the next round.
+    pending_.push_back(&request);
+    while (!request.done) {
+      if (round_in_progress_) {
+        cond_.wait(lock);
+        continue;
+      }
+      round_in_progress_ = true;
+      auto window_us = GetAtomicFlag(&FLAGS_log_sync_coalescing_window_us);
+      if (window_us) {
+        lock.unlock();
+        SleepFor(MonoDelta::FromMicroseconds(window_us));
+        lock.lock();
+      }
+      std::vector<Request*> batch;
+      batch.swap(pending_);
+      lock.unlock();
+      ExecuteRound(batch);
+      lock.lock();
+      for (auto* batch_request : batch) {
+        batch_request->done = true;
+      }
+      ++completed_rounds_;
+      round_in_progress_ = false;
+      cond_.notify_all();
+    }
+  }
+
+  *batch_size = request.batch_size;
+  RETURN_NOT_OK(request.status);
+  if (FLAGS_log_sync_per_file_system) {
+    return Status::OK();
+  }
+  // Write back was already started by the round, so fsyncs of the batch mostly wait for the same
+  // device flush, and are executed by their callers concurrently.
+  return segment->Sync();
+}
+
+void LogSyncGroup::ExecuteRound(const std::vector<Request*>& batch) {
+  TRACE_EVENT1("io", "LogSyncGroup::ExecuteRound", "batch_size", batch.size());
+  for (auto* request : batch) {
+    request->batch_size = batch.size();
+    request->status = request->segment->StartSync();
+  }
+  if (!FLAGS_log_sync_per_file_system) {
+    return;
+  }
+  auto status = SyncFileSystem();
+  for (auto* request : batch) {
+    if (request->status.ok()) {
+      request->status = status;
+    }
+  }
+}
+
+Status LogSyncGroup::SyncFileSystem() {
+  ThreadRestrictions::AssertIOAllowed();
+  if (FLAGS_never_fsync) {
+    return Status::OK();
+  }
+#if defined(__linux__)
+  if (syncfs(dir_fd_) != 0) {
+    return STATUS_FROM_ERRNO_SPECIAL_EIO_HANDLING(dir_, errno);
+  }
+  return Status::OK();
+#else
+  return STATUS(NotSupported, "File system sync is not supported", dir_);
+#endif
+}
+
+uint64_t LogSyncGroup::TEST_CompletedRounds() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return completed_rounds_;
+}
+
+} // namespace log
+} // namespace yb
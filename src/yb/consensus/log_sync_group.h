@@ -0,0 +1,71 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "yb/consensus/log_fwd.h"
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/util/result.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace log {
+
+// Group commit of log syncs for all tablets, whose WALs are located on the same file system.
+// Syncs requested while the previous round is in progress, or during the optional coalescing
+// window, are served by the same round. The round starts write back of all its segments at once,
+// so the device could handle them together, and then either flushes the whole file system with a
+// single syncfs call, or lets each caller fsync its own segment concurrently.
+// Thread safe.
+class LogSyncGroup {
+ public:
+  // Returns group for file system of the specified directory, shared by all directories on the
+  // same file system.
+  static Result<std::shared_ptr<LogSyncGroup>> ForDir(const std::string& dir);
+
+  LogSyncGroup(int dir_fd, std::string dir);
+  ~LogSyncGroup();
+
+  // Makes data written to the segment before the call durable.
+  // Sets batch_size to the number of syncs served by the same round.
+  Status Sync(WritableLogSegment* segment, size_t* batch_size);
+
+  uint64_t TEST_CompletedRounds();
+
+ private:
+  struct Request;
+
+  void ExecuteRound(const std::vector<Request*>& batch);
+
+  Status SyncFileSystem();
+
+  const int dir_fd_;
+  const std::string dir_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::vector<Request*> pending_ GUARDED_BY(mutex_);
+  bool round_in_progress_ GUARDED_BY(mutex_) = false;
+  uint64_t completed_rounds_ GUARDED_BY(mutex_) = 0;
+};
+
+} // namespace log
+} // namespace yb
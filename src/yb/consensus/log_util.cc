@@ -149,6 +149,13 @@ const size_t kLogSegmentFooterMagicAndFooterLength  = 12;
 
 const size_t kEntryHeaderSize = 12;
 
+namespace {
+
+// Number of bytes read together with the entry header.
+constexpr size_t kEntryPrefetchSize = 4_KB;
+
+} // namespace
+
 const int kLogMajorVersion = 1;
 const int kLogMinorVersion = 0;
 
@@ -847,9 +854,23 @@ Status ReadableLogSegment::MakeCorruptionStatus(
 
 Result<std::shared_ptr<LWLogEntryBatchPB>> ReadableLogSegment::ReadEntryHeaderAndBatch(
     int64_t* offset) {
+  // Read the header together with the beginning of the batch, so small batches are read with a
+  // single system call.
+  uint8_t scratch[kEntryPrefetchSize];
+  auto read_size = std::min<int64_t>(sizeof(scratch), readable_to_offset() - *offset);
   EntryHeader header;
-  RETURN_NOT_OK(ReadEntryHeader(offset, &header));
-  return ReadEntryBatch(offset, header);
+  if (read_size <= static_cast<int64_t>(kEntryHeaderSize)) {
+    RETURN_NOT_OK(ReadEntryHeader(offset, &header));
+    return ReadEntryBatch(offset, header);
+  }
+
+  Slice prefetched;
+  RETURN_NOT_OK_PREPEND(ReadFully(readable_file().get(), *offset, read_size, &prefetched, scratch),
+                        "Could not read log entry header");
+  RETURN_NOT_OK(DecodeEntryHeader(prefetched.Prefix(kEntryHeaderSize), &header));
+  *offset += kEntryHeaderSize;
+  prefetched.remove_prefix(kEntryHeaderSize);
+  return ReadEntryBatch(offset, header, prefetched);
 }
 
 
@@ -883,7 +904,7 @@ Status ReadableLogSegment::DecodeEntryHeader(const Slice& data, EntryHeader* hea
 
 
 Result<std::shared_ptr<LWLogEntryBatchPB>> ReadableLogSegment::ReadEntryBatch(
-    int64_t *offset, const EntryHeader& header) {
+    int64_t *offset, const EntryHeader& header, Slice prefetched) {
   TRACE_EVENT2("log", "ReadableLogSegment::ReadEntryBatch",
                "path", path_,
                "range", Substitute("offset=$0 entry_len=$1",
@@ -903,8 +924,25 @@ Result<std::shared_ptr<LWLogEntryBatchPB>> ReadableLogSegment::ReadEntryBatch(
 
   RefCntBuffer buffer(header.msg_length);
   Slice entry_batch_slice;
-
-  Status s = readable_file()->Read(*offset, header.msg_length, &entry_batch_slice, buffer.data());
+  Status s;
+
+  auto prefetched_size = std::min<size_t>(prefetched.size(), header.msg_length);
+  if (prefetched_size == header.msg_length) {
+    memcpy(buffer.data(), prefetched.data(), prefetched_size);
+    entry_batch_slice = Slice(buffer.data(), prefetched_size);
+  } else if (prefetched_size == 0) {
+    s = readable_file()->Read(*offset, header.msg_length, &entry_batch_slice, buffer.udata());
+  } else {
+    memcpy(buffer.data(), prefetched.data(), prefetched_size);
+    Slice rest;
+    s = ReadFully(
+        readable_file().get(), *offset + prefetched_size, header.msg_length - prefetched_size,
+        &rest, buffer.udata() + prefetched_size);
+    if (s.ok() && rest.data() != buffer.udata() + prefetched_size) {
+      memcpy(buffer.data() + prefetched_size, rest.data(), rest.size());
+    }
+    entry_batch_slice = Slice(buffer.data(), header.msg_length);
+  }
 
   if (!s.ok()) {
     return STATUS_FORMAT(
@@ -1136,6 +1174,10 @@ Status WritableLogSegment::WriteIndexBlock(const LogIndexBlock& index_block) {
   return writable_file_->Append(index_block.data);
 }
 
+Status WritableLogSegment::StartSync() {
+  return writable_file_->Flush(WritableFile::FLUSH_ASYNC);
+}
+
 Status WritableLogSegment::Sync() {
   return writable_file_->Sync();
 }
@@ -343,8 +343,9 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
 
   // Reads a log entry batch from the provided readable segment, which gets decoded
   // into 'entry_batch' and increments 'offset' by the batch's length.
+  // 'prefetched' contains data of the segment starting at 'offset', that was already read.
   Result<std::shared_ptr<LWLogEntryBatchPB>> ReadEntryBatch(
-      int64_t *offset, const EntryHeader& header);
+      int64_t *offset, const EntryHeader& header, Slice prefetched = Slice());
 
   void UpdateReadableToOffset(int64_t readable_to_offset);
 
@@ -415,6 +416,9 @@ class WritableLogSegment {
   // Makes sure that the log segment has not been closed.
   Status WriteEntryBatch(const Slice& entry_batch_data);
 
+  // Starts write back of the written data to the device, without waiting for it.
+  Status StartSync();
+
   // Makes sure the I/O buffers in the underlying writable file are flushed.
   Status Sync();
 
@@ -19,9 +19,12 @@
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/consensus.proxy.h"
 
+#include "yb/rpc/messenger.h"
 #include "yb/rpc/periodic.h"
+#include "yb/rpc/scheduler.h"
 
 #include "yb/util/flags.h"
+#include "yb/util/status_format.h"
 
 using namespace std::literals;
 using namespace std::placeholders;
@@ -37,6 +40,15 @@ DEFINE_uint64(multi_raft_batch_size, 0,
               "Maximum batch size for a multi-Raft consensus payload. Ignored if set to zero.");
 TAG_FLAG(multi_raft_batch_size, advanced);
 
+DEFINE_RUNTIME_uint64(multi_raft_update_batch_max_bytes, 0,
+    "When multi-Raft batching is enabled, consensus update requests with operations, whose size "
+    "does not exceed this value, are also batched together with requests to other tablets on the "
+    "same tablet server. Ignored if set to zero.");
+
+DEFINE_RUNTIME_uint64(multi_raft_update_batch_delay_us, 1000,
+    "Maximum time a consensus update request with operations waits in the multi-Raft batch "
+    "before the batch is sent.");
+
 DECLARE_int32(consensus_rpc_timeout_ms);
 
 namespace yb {
@@ -48,17 +60,20 @@ namespace {
 
 // Tracks a single peers ConsensusResponsePB as well as its ProcessResponse callback.
 struct ResponseCallbackData {
-  ConsensusResponsePB* resp;
+  LWConsensusResponsePB* resp;
   HeartbeatResponseCallback callback;
 };
 
 }
 
 struct MultiRaftHeartbeatBatcher::MultiRaftConsensusData {
-  MultiRaftConsensusRequestPB batch_req;
-  MultiRaftConsensusResponsePB batch_res;
+  Arena arena;
+  LWMultiRaftConsensusRequestPB batch_req{&arena};
+  LWMultiRaftConsensusResponsePB batch_res{&arena};
   rpc::RpcController controller;
   std::vector<ResponseCallbackData> response_callback_data;
+  // Whether batch contains requests with operations.
+  bool has_updates = false;
 };
 
 MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(
@@ -90,10 +105,13 @@ MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() {
       << "Not empty batch in ~MultiRaftHeartbeatBatcher";
 }
 
-void MultiRaftHeartbeatBatcher::AddRequestToBatch(ConsensusRequestPB* request,
-                                                  ConsensusResponsePB* response,
+void MultiRaftHeartbeatBatcher::AddRequestToBatch(LWConsensusRequestPB* request,
+                                                  LWConsensusResponsePB* response,
                                                   HeartbeatResponseCallback callback) {
   std::shared_ptr<MultiRaftConsensusData> data = nullptr;
+  std::weak_ptr<MultiRaftConsensusData> batch_to_flush;
+  const bool has_ops = !request->ops().empty();
+  const auto update_delay_us = FLAGS_multi_raft_update_batch_delay_us;
   {
     std::lock_guard<std::mutex> lock(mutex_);
     current_batch_->response_callback_data.push_back({
@@ -101,11 +119,47 @@ void MultiRaftHeartbeatBatcher::AddRequestToBatch(ConsensusRequestPB* request,
       .callback = std::move(callback)
     });
     // Add a ConsensusRequestPB to the batch
-    current_batch_->batch_req.add_consensus_request()->Swap(request);
-    if (FLAGS_multi_raft_batch_size > 0
-        && current_batch_->response_callback_data.size() >= FLAGS_multi_raft_batch_size) {
+    current_batch_->batch_req.mutable_consensus_request()->push_back_ref(request);
+    bool first_update = false;
+    if (has_ops) {
+      first_update = !current_batch_->has_updates;
+      current_batch_->has_updates = true;
+    }
+    if ((FLAGS_multi_raft_batch_size > 0
+         && current_batch_->response_callback_data.size() >= FLAGS_multi_raft_batch_size)
+        || (has_ops && update_delay_us == 0)) {
       data = PrepareNextBatchRequest();
+    } else if (first_update) {
+      batch_to_flush = current_batch_;
+    }
+  }
+  if (!batch_to_flush.expired()) {
+    // Operations should not wait for the regular heartbeat interval.
+    std::weak_ptr<MultiRaftHeartbeatBatcher> weak_self = shared_from_this();
+    messenger_->scheduler().Schedule(
+        [weak_self, batch_to_flush](const Status& status) {
+          if (!status.ok()) {
+            return;
+          }
+          if (auto self = weak_self.lock()) {
+            self->FlushBatch(batch_to_flush);
+          }
+        },
+        update_delay_us * 1us);
+  }
+  SendBatchRequest(data);
+}
+
+void MultiRaftHeartbeatBatcher::FlushBatch(const std::weak_ptr<MultiRaftConsensusData>& batch) {
+  std::shared_ptr<MultiRaftConsensusData> data;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto batch_ptr = batch.lock();
+    // Batch was already sent.
+    if (!batch_ptr || batch_ptr != current_batch_) {
+      return;
     }
+    data = PrepareNextBatchRequest();
   }
   SendBatchRequest(data);
 }
@@ -121,7 +175,7 @@ void MultiRaftHeartbeatBatcher::PrepareAndSendBatchRequest() {
 
 std::shared_ptr<MultiRaftHeartbeatBatcher::MultiRaftConsensusData>
     MultiRaftHeartbeatBatcher::PrepareNextBatchRequest() {
-  if (!current_batch_ || current_batch_->batch_req.consensus_request_size() == 0) {
+  if (!current_batch_ || current_batch_->batch_req.consensus_request().empty()) {
     return nullptr;
   }
   batch_sender_->Snooze();
@@ -139,14 +193,21 @@ void MultiRaftHeartbeatBatcher::SendBatchRequest(std::shared_ptr<MultiRaftConsen
 
   data->controller.Reset();
   data->controller.set_timeout(MonoDelta::FromMilliseconds(
-      FLAGS_consensus_rpc_timeout_ms * data->batch_req.consensus_request_size()));
+      FLAGS_consensus_rpc_timeout_ms * data->batch_req.consensus_request().size()));
   auto callback = [data, running_calls = running_calls_]() {
     --*running_calls;
     auto status = data->controller.status();
-    for (int i = 0; i < data->batch_req.consensus_request_size(); i++) {
-      auto callback_data = data->response_callback_data[i];
+    const auto& responses = data->batch_res.consensus_response();
+    if (status.ok() && responses.size() != data->response_callback_data.size()) {
+      status = STATUS_FORMAT(
+          IllegalState, "Wrong number of responses in batch: $0, expected: $1", responses.size(),
+          data->response_callback_data.size());
+    }
+    auto response_it = responses.begin();
+    for (const auto& callback_data : data->response_callback_data) {
       if (status.ok()) {
-        callback_data.resp->Swap(data->batch_res.mutable_consensus_response(i));
+        callback_data.resp->CopyFrom(*response_it);
+        ++response_it;
       }
       callback_data.callback(status);
     }
@@ -40,6 +40,8 @@ using HeartbeatResponseCallback = std::function<void(const Status&)>;
 // - A heartbeat is added to a batch upon calling AddRequestToBatch and a batch is sent
 //   out every FLAGS_multi_raft_heartbeat_interval_ms ms or once the batch size reaches
 //   FLAGS_multi_raft_batch_size
+// - Small requests with operations could also be added to a batch, in this case the batch is sent
+//   out at most FLAGS_multi_raft_update_batch_delay_us us after the first of them was added
 // - To improve efficency multiple batches may be processed concurrently
 //   but only a single batch is being built at any given time
 class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
@@ -54,12 +56,13 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
   // Required to start a periodic timer to send out batches.
   void Start();
 
-  // When called adds the request to a batch (request data will be swapped).
+  // When called adds the request to a batch. The batch refers to the request, so it should not be
+  // changed or destroyed until the callback is executed.
   // If the batch executes sucessfully then the response is populated and the callback is executed.
   // If the batch rpc call fails the response will NOT be populated and the callback will be
   // executed with an error status.
-  void AddRequestToBatch(ConsensusRequestPB* request,
-                         ConsensusResponsePB* response,
+  void AddRequestToBatch(LWConsensusRequestPB* request,
+                         LWConsensusResponsePB* response,
                          HeartbeatResponseCallback callback);
 
   void Shutdown();
@@ -71,6 +74,9 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
 
   void PrepareAndSendBatchRequest();
 
+  // Sends the batch if it was not sent yet.
+  void FlushBatch(const std::weak_ptr<MultiRaftConsensusData>& batch);
+
   // This method will return a nullptr if the current batch is empty.
   std::shared_ptr<MultiRaftConsensusData> PrepareNextBatchRequest() REQUIRES(mutex_);
 
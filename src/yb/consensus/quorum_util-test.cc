@@ -74,5 +74,23 @@ TEST(QuorumUtilTest, TestMemberExtraction) {
   ASSERT_EQ("B", peer_pb.permanent_uuid());
 }
 
+TEST(QuorumUtilTest, Witness) {
+  RaftConfigPB config;
+  SetPeerInfo("A", PeerMemberType::VOTER, config.add_peers());
+  SetPeerInfo("B", PeerMemberType::WITNESS, config.add_peers());
+  SetPeerInfo("C", PeerMemberType::OBSERVER, config.add_peers());
+
+  ASSERT_EQ(2, CountVoters(config));
+  ASSERT_TRUE(IsRaftConfigVoter("B", config));
+  ASSERT_TRUE(IsRaftConfigWitness("B", config));
+  ASSERT_FALSE(IsRaftConfigWitness("A", config));
+  ASSERT_FALSE(IsRaftConfigVoter("C", config));
+
+  ConsensusStatePB cstate;
+  *cstate.mutable_config() = config;
+  cstate.set_leader_uuid("A");
+  ASSERT_EQ(PeerRole::FOLLOWER, GetConsensusRole("B", cstate));
+}
+
 } // namespace consensus
 } // namespace yb
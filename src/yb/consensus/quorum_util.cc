@@ -64,12 +64,25 @@ bool IsRaftConfigMember(const std::string& uuid, const RaftConfigPB& config) {
 bool IsRaftConfigVoter(const std::string& uuid, const RaftConfigPB& config) {
   for (const RaftPeerPB& peer : config.peers()) {
     if (peer.permanent_uuid() == uuid) {
-      return peer.member_type() == PeerMemberType::VOTER;
+      return IsVoterMemberType(peer.member_type());
     }
   }
   return false;
 }
 
+bool IsRaftConfigWitness(const std::string& uuid, const RaftConfigPB& config) {
+  for (const RaftPeerPB& peer : config.peers()) {
+    if (peer.permanent_uuid() == uuid) {
+      return peer.member_type() == PeerMemberType::WITNESS;
+    }
+  }
+  return false;
+}
+
+bool IsVoterMemberType(PeerMemberType member_type) {
+  return member_type == PeerMemberType::VOTER || member_type == PeerMemberType::WITNESS;
+}
+
 Status GetRaftConfigMember(const RaftConfigPB& config,
                            const std::string& uuid,
                            RaftPeerPB* peer_pb) {
@@ -152,7 +165,8 @@ bool RemoveFromRaftConfig(RaftConfigPB* config, const ChangeConfigRequestPB& req
 }
 
 size_t CountVoters(const RaftConfigPB& config) {
-  return CountMemberType(config, PeerMemberType::VOTER);
+  return CountMemberType(config, PeerMemberType::VOTER) +
+         CountMemberType(config, PeerMemberType::WITNESS);
 }
 
 size_t CountVotersInTransition(const RaftConfigPB& config) {
@@ -202,6 +216,7 @@ PeerRole GetConsensusRole(const std::string& permanent_uuid, const ConsensusStat
     if (peer.permanent_uuid() == permanent_uuid) {
       switch (peer.member_type()) {
         case PeerMemberType::VOTER:
+        case PeerMemberType::WITNESS:
           return PeerRole::FOLLOWER;
 
         // PRE_VOTER, PRE_OBSERVER peers are considered LEARNERs.
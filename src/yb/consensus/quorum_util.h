@@ -53,8 +53,15 @@ enum RaftConfigState {
 };
 
 bool IsRaftConfigMember(const std::string& uuid, const RaftConfigPB& config);
+
+// Whether the member votes and counts towards majorities, i.e. it is a VOTER or a WITNESS.
 bool IsRaftConfigVoter(const std::string& uuid, const RaftConfigPB& config);
 
+bool IsRaftConfigWitness(const std::string& uuid, const RaftConfigPB& config);
+
+// Whether members of this type vote and count towards majorities.
+bool IsVoterMemberType(PeerMemberType member_type);
+
 // Get the specified member of the config.
 // Returns Status::NotFound if a member with the specified uuid could not be
 // found in the config.
@@ -89,7 +96,7 @@ size_t CountMemberType(const RaftConfigPB& config,
                        const PeerMemberType member_type,
                        const std::string& ignore_uuid = "");
 
-// Counts the number of voters in the configuration.
+// Counts the number of voters in the configuration, including witnesses.
 size_t CountVoters(const RaftConfigPB& config);
 
 // Counts the number of servers that are in transition (being bootstrapped) to become voters.
@@ -383,7 +383,8 @@ shared_ptr<RaftConsensus> RaftConsensus::Create(
       parent_mem_tracker,
       mark_dirty_clbk,
       table_type,
-      retryable_requests);
+      retryable_requests,
+      raft_pool->NewToken(ThreadPool::ExecutionMode::SERIAL));
 }
 
 RaftConsensus::RaftConsensus(
@@ -399,8 +400,10 @@ RaftConsensus::RaftConsensus(
     shared_ptr<MemTracker> parent_mem_tracker,
     Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
-    RetryableRequests* retryable_requests)
+    RetryableRequests* retryable_requests,
+    std::unique_ptr<ThreadPoolToken> apply_token)
     : raft_pool_token_(std::move(raft_pool_token)),
+      apply_token_(std::move(apply_token)),
       log_(log),
       clock_(clock),
       peer_proxy_factory_(std::move(proxy_factory)),
@@ -439,7 +442,8 @@ RaftConsensus::RaftConsensus(
       DCHECK_NOTNULL(consensus_context),
       this,
       retryable_requests,
-      std::bind(&PeerMessageQueue::TrackOperationsMemory, queue_.get(), _1));
+      std::bind(&PeerMessageQueue::TrackOperationsMemory, queue_.get(), _1),
+      apply_token_.get());
 
   peer_manager_->SetConsensus(this);
 }
@@ -583,6 +587,11 @@ Status RaftConsensus::DoStartElection(const LeaderElectionData& data, PreElected
                             << ", active_role=" << active_role;
       return Status::OK();
     }
+    if (IsRaftConfigWitness(state_->GetPeerUuid(), state_->GetActiveConfigUnlocked())) {
+      VLOG_WITH_PREFIX(1) << "Not starting " << election_name << " -- witness";
+      SnoozeFailureDetector(DO_NOT_LOG);
+      return Status::OK();
+    }
     if (PREDICT_FALSE(active_role == PeerRole::NON_PARTICIPANT)) {
       VLOG_WITH_PREFIX(1) << "Not starting " << election_name << " -- non participant";
       // Avoid excessive election noise while in this state.
@@ -2534,13 +2543,20 @@ Status RaftConsensus::ChangeConfig(const ChangeConfigRequestPB& req,
             Substitute("Server with UUID $0 not a member of the config. RaftConfig: $1",
                        server_uuid, new_config.ShortDebugString()));
         }
-        if (new_peer->member_type() != PeerMemberType::PRE_OBSERVER &&
-            new_peer->member_type() != PeerMemberType::PRE_VOTER) {
+        if (server.has_member_type() && server.member_type() == PeerMemberType::WITNESS) {
+          // The number of voters does not change, so majority size stays the same.
+          if (new_peer->member_type() != PeerMemberType::VOTER) {
+            return STATUS(IllegalState, Substitute("Cannot change role of server with UUID $0 "
+                                                   "to WITNESS because its member type is $1",
+                                                   server_uuid, new_peer->member_type()));
+          }
+          new_peer->set_member_type(PeerMemberType::WITNESS);
+        } else if (new_peer->member_type() != PeerMemberType::PRE_OBSERVER &&
+                   new_peer->member_type() != PeerMemberType::PRE_VOTER) {
           return STATUS(IllegalState, Substitute("Cannot change role of server with UUID $0 "
                                                  "because its member type is $1",
                                                  server_uuid, new_peer->member_type()));
-        }
-        if (new_peer->member_type() == PeerMemberType::PRE_OBSERVER) {
+        } else if (new_peer->member_type() == PeerMemberType::PRE_OBSERVER) {
           new_peer->set_member_type(PeerMemberType::OBSERVER);
         } else {
           new_peer->set_member_type(PeerMemberType::VOTER);
@@ -2615,7 +2631,9 @@ Status RaftConsensus::UnsafeChangeConfig(
                                << yb::ToString(state_->GetPendingConfigUnlocked());
     }
     last_committed_opid = state_->GetCommittedOpIdUnlocked();
-    preceding_opid = state_->GetLastAppliedOpIdUnlocked();
+    // Writes up to the committed op id could be still applying, but the new config should
+    // follow committed operations anyway.
+    preceding_opid = last_committed_opid;
   }
 
   // Validate that passed replica uuids are part of the committed config
@@ -2751,6 +2769,11 @@ void RaftConsensus::Shutdown() {
   // We must close the queue after we close the peers.
   queue_->Close();
 
+  // Committed writes should be applied before pending operations are cancelled.
+  if (apply_token_) {
+    apply_token_->Wait();
+  }
+
   CHECK_OK(state_->CancelPendingOperations());
 
   {
@@ -2763,6 +2786,9 @@ void RaftConsensus::Shutdown() {
 
   // Shut down things that might acquire locks during destruction.
   raft_pool_token_->Shutdown();
+  if (apply_token_) {
+    apply_token_->Shutdown();
+  }
   // We might not have run Start yet, so make sure we have a FD.
   if (failure_detector_) {
     DisableFailureDetector();
@@ -140,7 +140,8 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
     std::shared_ptr<MemTracker> parent_mem_tracker,
     Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
-    RetryableRequests* retryable_requests);
+    RetryableRequests* retryable_requests,
+    std::unique_ptr<ThreadPoolToken> apply_token = nullptr);
 
   virtual ~RaftConsensus();
 
@@ -661,6 +662,9 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
   // etc.
   std::unique_ptr<ThreadPoolToken> raft_pool_token_;
 
+  // Serial token used by ReplicaState to apply committed write operations.
+  std::unique_ptr<ThreadPoolToken> apply_token_;
+
   scoped_refptr<log::Log> log_;
   scoped_refptr<server::Clock> clock_;
   std::unique_ptr<PeerProxyFactory> peer_proxy_factory_;
@@ -54,6 +54,7 @@
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 #include "yb/util/thread_restrictions.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/tostring.h"
 #include "yb/util/trace.h"
 
@@ -65,6 +66,11 @@ DEFINE_int32(inject_delay_commit_pre_voter_to_voter_secs, 0,
 TAG_FLAG(inject_delay_commit_pre_voter_to_voter_secs, unsafe);
 TAG_FLAG(inject_delay_commit_pre_voter_to_voter_secs, hidden);
 
+DEFINE_RUNTIME_bool(consensus_apply_writes_async, false,
+    "Apply committed write operations in a per tablet serial task on the Raft thread pool, "
+    "instead of in place while holding the replica state lock. Keeps applying writes on hot "
+    "tablets from delaying processing of the following consensus updates.");
+
 namespace yb {
 namespace consensus {
 
@@ -80,13 +86,15 @@ ReplicaState::ReplicaState(
     ConsensusOptions options, string peer_uuid, std::unique_ptr<ConsensusMetadata> cmeta,
     ConsensusContext* consensus_context, SafeOpIdWaiter* safe_op_id_waiter,
     RetryableRequests* retryable_requests,
-    std::function<void(const OpIds&)> applied_ops_tracker)
+    std::function<void(const OpIds&)> applied_ops_tracker,
+    ThreadPoolToken* apply_token)
     : options_(std::move(options)),
       peer_uuid_(std::move(peer_uuid)),
       cmeta_(std::move(cmeta)),
       context_(consensus_context),
       safe_op_id_waiter_(safe_op_id_waiter),
-      applied_ops_tracker_(std::move(applied_ops_tracker)) {
+      applied_ops_tracker_(std::move(applied_ops_tracker)),
+      apply_token_(apply_token) {
   CHECK(cmeta_) << "ConsensusMeta passed as NULL";
   if (retryable_requests) {
     retryable_requests_ = std::move(*retryable_requests);
@@ -820,6 +828,10 @@ Status ReplicaState::InitCommittedOpIdUnlocked(const yb::OpId& committed_op_id)
   if (!pending_operations_.empty() &&
       committed_op_id.index >= pending_operations_.front()->id().index) {
     RETURN_NOT_OK(ApplyPendingOperationsUnlocked(committed_op_id, CouldStop::kFalse));
+    if (deferred_apply_op_id_) {
+      // Committed index is advanced by ResumeDeferredApply, after the rest of operations applied.
+      return Status::OK();
+    }
   }
 
   SetLastCommittedIndexUnlocked(committed_op_id);
@@ -894,6 +906,9 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
   OpIds applied_op_ids;
   applied_op_ids.reserve(committed_op_id.index - prev_id.index);
 
+  const bool apply_writes_async = apply_token_ && FLAGS_consensus_apply_writes_async;
+  std::vector<ConsensusRoundPtr> async_rounds;
+
   Status status;
 
   while (!pending_operations_.empty()) {
@@ -909,6 +924,16 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
     }
 
     auto type = round->replicate_msg()->op_type();
+    const bool apply_async = type == OperationType::WRITE_OP && apply_writes_async;
+
+    if (!apply_async &&
+        (!async_rounds.empty() || num_pending_async_applies_.load(std::memory_order_acquire))) {
+      // Operations are applied in order, so previously submitted writes should be applied first.
+      // Instead of waiting for them under the lock, ResumeDeferredApply continues from here.
+      VLOG_WITH_PREFIX(2) << "Defer apply of " << current_id << " till writes are applied";
+      deferred_apply_op_id_.MakeAtLeast(committed_op_id);
+      break;
+    }
 
     // For write operations we block rocksdb flush, until appropriate records are written to the
     // log file. So we could apply them before adding to log.
@@ -948,15 +973,26 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
     }
 
     pending_operations_.pop_front();
+    if (apply_async) {
+      if (async_rounds.empty() && !num_pending_async_applies_.load(std::memory_order_acquire)) {
+        last_async_applied_op_id_.store(prev_id, std::memory_order_release);
+      }
+      prev_id = current_id;
+      retryable_requests_.ReplicationFinished(*round->replicate_msg(), Status::OK(), leader_term);
+      async_rounds.push_back(std::move(round));
+      continue;
+    }
+    prev_id = current_id;
+
     // Set committed configuration.
     if (PREDICT_FALSE(type == OperationType::CHANGE_CONFIG_OP)) {
       ApplyConfigChangeUnlocked(round);
     }
 
-    prev_id = current_id;
     NotifyReplicationFinishedUnlocked(round, Status::OK(), leader_term, &applied_op_ids);
   }
 
+  SubmitApplyUnlocked(&async_rounds, leader_term);
   SetLastCommittedIndexUnlocked(prev_id);
 
   applied_ops_tracker_(applied_op_ids);
@@ -964,6 +1000,61 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
   return status;
 }
 
+void ReplicaState::SubmitApplyUnlocked(
+    std::vector<ConsensusRoundPtr>* rounds, int64_t leader_term) {
+  if (rounds->empty()) {
+    return;
+  }
+  auto apply = [this, rounds = std::move(*rounds), leader_term,
+                applied_ops_tracker = applied_ops_tracker_] {
+    OpIds applied_op_ids;
+    applied_op_ids.reserve(rounds.size());
+    for (const auto& round : rounds) {
+      round->NotifyReplicationFinished(Status::OK(), leader_term, &applied_op_ids);
+    }
+    applied_ops_tracker(applied_op_ids);
+    last_async_applied_op_id_.store(rounds.back()->id(), std::memory_order_release);
+    return num_pending_async_applies_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  };
+  rounds->clear();
+  num_pending_async_applies_.fetch_add(1, std::memory_order_acq_rel);
+  auto status = apply_token_->SubmitFunc([this, apply] {
+    if (apply()) {
+      ResumeDeferredApply();
+    }
+  });
+  if (!status.ok()) {
+    // Committed operations should be applied anyway, so apply them in place. Submit fails only
+    // when apply_token_ is shut down, so there are no previously submitted applies to wait for.
+    LOG_WITH_PREFIX(WARNING) << "Failed to submit apply of committed operations: " << status;
+    apply();
+  }
+}
+
+void ReplicaState::ResumeDeferredApply() {
+  UniqueLock lock;
+  auto status = LockForUpdate(&lock);
+  if (!status.ok()) {
+    // Deferred operations are aborted by CancelPendingOperations during shutdown.
+    VLOG_WITH_PREFIX(1) << "Cannot resume deferred apply: " << status;
+    return;
+  }
+  auto committed_op_id = std::exchange(deferred_apply_op_id_, OpId());
+  if (!committed_op_id) {
+    return;
+  }
+  WARN_NOT_OK(ResultToStatus(AdvanceCommittedOpIdUnlocked(committed_op_id, CouldStop::kFalse)),
+              LogPrefix() + "Failed to resume deferred apply");
+}
+
+OpId ReplicaState::GetLastAppliedOpIdUnlocked() const {
+  DCHECK(IsLocked());
+  if (num_pending_async_applies_.load(std::memory_order_acquire)) {
+    return last_async_applied_op_id_.load(std::memory_order_acquire);
+  }
+  return last_committed_op_id_;
+}
+
 void ReplicaState::ApplyConfigChangeUnlocked(const ConsensusRoundPtr& round) {
   const auto& change_config_record = round->replicate_msg()->change_config_record();
   DCHECK(change_config_record.has_old_config());
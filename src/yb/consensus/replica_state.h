@@ -58,6 +58,7 @@ namespace yb {
 class HostPort;
 class ReplicaState;
 class ThreadPool;
+class ThreadPoolToken;
 
 namespace consensus {
 
@@ -119,7 +120,8 @@ class ReplicaState {
       ConsensusOptions options, std::string peer_uuid, std::unique_ptr<ConsensusMetadata> cmeta,
       ConsensusContext* consensus_context, SafeOpIdWaiter* safe_op_id_waiter,
       RetryableRequests* retryable_requests,
-      std::function<void(const OpIds&)> applied_ops_tracker);
+      std::function<void(const OpIds&)> applied_ops_tracker,
+      ThreadPoolToken* apply_token = nullptr);
 
   ~ReplicaState();
 
@@ -305,10 +307,7 @@ class ReplicaState {
 
   // Returns the watermark below which all operations are known to be applied according to
   // consensus.
-  const OpId& GetLastAppliedOpIdUnlocked() const {
-    // See comment for last_committed_op_id_ for why we return committed op ID here.
-    return GetCommittedOpIdUnlocked();
-  }
+  OpId GetLastAppliedOpIdUnlocked() const;
 
   // Returns true if an op from the current term has been committed.
   bool AreCommittedAndCurrentTermsSameUnlocked() const;
@@ -442,6 +441,13 @@ class ReplicaState {
   Status ApplyPendingOperationsUnlocked(
       const yb::OpId& committed_op_id, CouldStop could_stop);
 
+  // Submits apply of committed write operations to apply_token_ and clears rounds.
+  void SubmitApplyUnlocked(std::vector<ConsensusRoundPtr>* rounds, int64_t leader_term);
+
+  // Invoked by apply_token_ after all submitted applies are done, resumes apply of committed
+  // operations that were deferred by ApplyPendingOperationsUnlocked.
+  void ResumeDeferredApply();
+
   void SetLastCommittedIndexUnlocked(const yb::OpId& committed_op_id);
 
   // Applies committed config change.
@@ -498,7 +504,9 @@ class ReplicaState {
 
   // The ID of the operation that was last committed. Initialized to MinimumOpId().
   // NOTE: due to implementation details at this and lower layers all operations up to
-  // last_committed_op_id_ are guaranteed to be already applied.
+  // last_committed_op_id_ are guaranteed to be already applied, except write operations that
+  // were submitted to apply_token_. Use GetLastAppliedOpIdUnlocked() when applied operations are
+  // required.
   OpId last_committed_op_id_;
 
   // If set, a leader election is pending upon the specific op id commitment to this peer's log.
@@ -537,6 +545,22 @@ class ReplicaState {
 
   std::function<void(const OpIds&)> applied_ops_tracker_;
 
+  // Serial token used to apply committed write operations outside of update_lock_, when
+  // consensus_apply_writes_async is set. Keeps the order of applies, while consensus updates
+  // could proceed concurrently with them.
+  ThreadPoolToken* const apply_token_;
+
+  // Number of tasks submitted to apply_token_ that are not finished yet.
+  std::atomic<size_t> num_pending_async_applies_{0};
+
+  // The ID of the last applied operation, valid while num_pending_async_applies_ is not zero.
+  std::atomic<OpId> last_async_applied_op_id_;
+
+  // Committed op id, up to which operations should be applied after the submitted applies are
+  // done. Non write operations are not applied while there are pending async applies, since they
+  // should be applied in order and we don't want to wait for apply_token_ under update_lock_.
+  OpId deferred_apply_op_id_;
+
   struct LeaderStateCache {
     static constexpr size_t kStatusBits = 3;
     static_assert(kLeaderStatusMapSize <= (1 << kStatusBits),
@@ -13,6 +13,8 @@
 
 #include "yb/consensus/retryable_requests.h"
 
+#include <deque>
+
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/ordered_index.hpp>
@@ -144,6 +146,13 @@ struct ClientRetryableRequests {
   RunningRetryableRequests running;
   ReplicatedRetryableRequestRanges replicated;
   RetryableRequestId min_running_request_id = 0;
+};
+
+// Client without running requests and replicated ranges.
+// We keep only min running request id for it, to be able to filter requests with too small request
+// id, so short lived clients don't hold request containers till they are expired.
+struct IdleClientRetryableRequests {
+  RetryableRequestId min_running_request_id;
   RestartSafeCoarseTimePoint empty_since;
 };
 
@@ -225,7 +234,7 @@ class RetryableRequests::Impl {
       entry_time = clock_.Now();
     }
 
-    ClientRetryableRequests& client_retryable_requests = clients_[data.client_id()];
+    ClientRetryableRequests& client_retryable_requests = ClientRequests(data.client_id());
 
     CleanupReplicatedRequests(
         data.write().min_running_request_id(), &client_retryable_requests);
@@ -286,16 +295,28 @@ class RetryableRequests::Impl {
       if (op_id_index.empty() && client_retryable_requests.running.empty()) {
         // We delay deleting client with empty requests, to be able to filter requests with too
         // small request id.
-        if (client_retryable_requests.empty_since == RestartSafeCoarseTimePoint()) {
-          client_retryable_requests.empty_since = now;
-        } else if (client_retryable_requests.empty_since < clean_start) {
-          ci = clients_.erase(ci);
-          continue;
-        }
+        idle_clients_.emplace(ci->first, IdleClientRetryableRequests {
+          .min_running_request_id = client_retryable_requests.min_running_request_id,
+          .empty_since = now,
+        });
+        idle_clients_queue_.emplace_back(now, ci->first);
+        ci = clients_.erase(ci);
+        continue;
       }
       ++ci;
     }
 
+    // Idle clients are queued in order of empty_since, so only expired ones are visited.
+    while (!idle_clients_queue_.empty() && idle_clients_queue_.front().first < clean_start) {
+      const auto& [empty_since, client_id] = idle_clients_queue_.front();
+      auto it = idle_clients_.find(client_id);
+      // Client could become active again, and then idle with a later empty_since.
+      if (it != idle_clients_.end() && it->second.empty_since == empty_since) {
+        idle_clients_.erase(it);
+      }
+      idle_clients_queue_.pop_front();
+    }
+
     return result;
   }
 
@@ -306,7 +327,7 @@ class RetryableRequests::Impl {
       return;
     }
 
-    auto& client_retryable_requests = clients_[data.client_id()];
+    auto& client_retryable_requests = ClientRequests(data.client_id());
     auto& running_indexed_by_request_id = client_retryable_requests.running.get<RequestIdIndex>();
     auto running_it = running_indexed_by_request_id.find(data.request_id());
     if (running_it == running_indexed_by_request_id.end()) {
@@ -345,7 +366,7 @@ class RetryableRequests::Impl {
       return;
     }
 
-    auto& client_retryable_requests = clients_[data.client_id()];
+    auto& client_retryable_requests = ClientRequests(data.client_id());
     auto& running_indexed_by_request_id = client_retryable_requests.running.get<RequestIdIndex>();
     if (running_indexed_by_request_id.count(data.request_id()) != 0) {
 #ifndef NDEBUG
@@ -386,13 +407,31 @@ class RetryableRequests::Impl {
 
   Result<RetryableRequestId> MinRunningRequestId(const ClientId& client_id) const {
     const auto it = clients_.find(client_id);
-    if (it == clients_.end()) {
-      return STATUS_FORMAT(NotFound, "Client requests data not found for client $0", client_id);
+    if (it != clients_.end()) {
+      return it->second.min_running_request_id;
     }
-    return it->second.min_running_request_id;
+    const auto idle_it = idle_clients_.find(client_id);
+    if (idle_it != idle_clients_.end()) {
+      return idle_it->second.min_running_request_id;
+    }
+    return STATUS_FORMAT(NotFound, "Client requests data not found for client $0", client_id);
   }
 
  private:
+  ClientRetryableRequests& ClientRequests(const ClientId& client_id) {
+    auto it = clients_.find(client_id);
+    if (it != clients_.end()) {
+      return it->second;
+    }
+    auto& result = clients_[client_id];
+    auto idle_it = idle_clients_.find(client_id);
+    if (idle_it != idle_clients_.end()) {
+      result.min_running_request_id = idle_it->second.min_running_request_id;
+      idle_clients_.erase(idle_it);
+    }
+    return result;
+  }
+
   void CleanupReplicatedRequests(
       RetryableRequestId new_min_running_request_id,
       ClientRetryableRequests* client_retryable_requests) {
@@ -540,6 +579,9 @@ class RetryableRequests::Impl {
 
   std::string log_prefix_;
   std::unordered_map<ClientId, ClientRetryableRequests, ClientIdHash> clients_;
+  std::unordered_map<ClientId, IdleClientRetryableRequests, ClientIdHash> idle_clients_;
+  // Idle clients in order of empty_since, could contain entries for clients that became active.
+  std::deque<std::pair<RestartSafeCoarseTimePoint, ClientId>> idle_clients_queue_;
   RestartSafeCoarseMonoClock clock_;
   scoped_refptr<AtomicGauge<int64_t>> running_requests_gauge_;
   scoped_refptr<AtomicGauge<int64_t>> replicated_request_ranges_gauge_;
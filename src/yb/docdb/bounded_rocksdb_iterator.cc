@@ -23,9 +23,19 @@ namespace docdb {
 BoundedRocksDbIterator::BoundedRocksDbIterator(
     rocksdb::DB* rocksdb, const rocksdb::ReadOptions& read_opts,
     const KeyBounds* key_bounds)
-    : iterator_(rocksdb->NewIterator(read_opts)), key_bounds_(key_bounds) {
+    : key_bounds_(key_bounds) {
   CHECK_NOTNULL(key_bounds_);
   VLOG(3) << "key_bounds_ = " << AsString(key_bounds_);
+  // Split child shares SST files with its parent, so without upper bound the underlying iterator
+  // would step over all keys of the sibling, that are filtered out by Valid anyway.
+  if (read_opts.iterate_upper_bound || key_bounds_->upper.empty()) {
+    iterator_.reset(rocksdb->NewIterator(read_opts));
+    return;
+  }
+  upper_bound_ = std::make_unique<Slice>(key_bounds_->upper.AsSlice());
+  auto bounded_read_opts = read_opts;
+  bounded_read_opts.iterate_upper_bound = upper_bound_.get();
+  iterator_.reset(rocksdb->NewIterator(bounded_read_opts));
 }
 
 bool BoundedRocksDbIterator::Valid() const {
@@ -41,7 +51,7 @@ void BoundedRocksDbIterator::SeekToFirst() {
 }
 
 void BoundedRocksDbIterator::SeekToLast() {
-  if (!key_bounds_->upper.empty()) {
+  if (!key_bounds_->upper.empty() && !upper_bound_) {
     // TODO(tsplit): this code path is only used for post-split tablets, particularly during
     // reverse scan for range-partitioned tables.
     // Need to add unit-test for this scenario when adding unit-tests for tablet splitting of
@@ -15,6 +15,7 @@
 
 #include <stdint.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -76,6 +77,10 @@ class BoundedRocksDbIterator : public rocksdb::Iterator {
   }
 
  private:
+  // Upper bound of the key bounds, used as iterate_upper_bound when caller did not specify one.
+  // Allocated separately, because the underlying iterator keeps pointer to it, and this iterator
+  // could be moved.
+  std::unique_ptr<Slice> upper_bound_;
   std::unique_ptr<rocksdb::Iterator> iterator_;
   const KeyBounds* key_bounds_;
 };
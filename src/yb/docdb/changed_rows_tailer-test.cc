@@ -0,0 +1,80 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <vector>
+
+#include "yb/common/hybrid_time.h"
+#include "yb/common/ql_value.h"
+
+#include "yb/docdb/changed_rows_tailer.h"
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_path.h"
+#include "yb/docdb/docdb_test_base.h"
+
+#include "yb/util/test_macros.h"
+
+namespace yb {
+namespace docdb {
+
+class ChangedRowsTailerTest : public DocDBTestBase {
+ protected:
+  static KeyBytes RowKey(int32_t key) {
+    return DocKey({KeyEntryValue::Int32(key)}).Encode();
+  }
+
+  Status Write(int32_t key, HybridTime hybrid_time) {
+    return SetPrimitive(
+        DocPath(RowKey(key), KeyEntryValue::MakeColumnId(ColumnId(10))),
+        ValueRef(QLValue::Primitive(key)), hybrid_time);
+  }
+
+  Result<std::vector<KeyBytes>> Poll(ChangedRowsTailer* tailer, HybridTime up_to) {
+    std::vector<KeyBytes> result;
+    RETURN_NOT_OK(tailer->Poll(up_to, [&result](Slice encoded_doc_key) {
+      result.emplace_back(encoded_doc_key);
+      return Status::OK();
+    }));
+    return result;
+  }
+};
+
+TEST_F(ChangedRowsTailerTest, Poll) {
+  ASSERT_OK(Write(1, 1000_usec_ht));
+  ASSERT_OK(Write(2, 2000_usec_ht));
+
+  ChangedRowsTailer tailer(doc_db(), 1000_usec_ht);
+  ASSERT_EQ(ASSERT_RESULT(Poll(&tailer, 3000_usec_ht)), std::vector<KeyBytes>{RowKey(2)});
+  ASSERT_EQ(tailer.changed_after(), 3000_usec_ht);
+
+  // Writes made after tailer creation are observed by the same iterator.
+  ASSERT_OK(Write(3, 4000_usec_ht));
+  ASSERT_OK(Write(1, 4000_usec_ht));
+  ASSERT_OK(Write(1, 5000_usec_ht));
+  // Row is reported once, while the write after up_to is left for the next poll.
+  ASSERT_EQ(ASSERT_RESULT(Poll(&tailer, 4500_usec_ht)),
+            (std::vector<KeyBytes>{RowKey(1), RowKey(3)}));
+  ASSERT_EQ(ASSERT_RESULT(Poll(&tailer, 5000_usec_ht)), std::vector<KeyBytes>{RowKey(1)});
+
+  // Changes are still observed after the memtable is flushed.
+  ASSERT_OK(Write(4, 6000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  ASSERT_OK(Write(2, 7000_usec_ht));
+  ASSERT_EQ(ASSERT_RESULT(Poll(&tailer, 7000_usec_ht)),
+            (std::vector<KeyBytes>{RowKey(2), RowKey(4)}));
+  ASSERT_EQ(ASSERT_RESULT(Poll(&tailer, 8000_usec_ht)), std::vector<KeyBytes>{});
+
+  ASSERT_NOK(tailer.Poll(6000_usec_ht, [](Slice) { return Status::OK(); }));
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,76 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/changed_rows_tailer.h"
+
+#include "yb/common/doc_hybrid_time.h"
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/key_bytes.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/rocksdb/options.h"
+
+#include "yb/util/status_format.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+rocksdb::ReadOptions TailingReadOptions() {
+  rocksdb::ReadOptions result;
+  result.tailing = true;
+  return result;
+}
+
+} // namespace
+
+ChangedRowsTailer::ChangedRowsTailer(const DocDB& doc_db, HybridTime changed_after)
+    : iter_(doc_db.regular, TailingReadOptions(), doc_db.key_bounds),
+      changed_after_(changed_after) {
+}
+
+Status ChangedRowsTailer::Poll(HybridTime up_to, const RowCallback& callback) {
+  SCHECK_GE(up_to, changed_after_, InvalidArgument, "Poll before the previously polled time");
+  if (up_to == changed_after_) {
+    return Status::OK();
+  }
+
+  // Keys of regular RocksDB are ordered by doc key, and the writes could land anywhere in the key
+  // space, so every poll does a pass over the whole tablet, jumping over each reported row.
+  KeyBuffer doc_key;
+  iter_.SeekToFirst();
+  while (iter_.Valid()) {
+    auto key = iter_.key();
+    auto write_time = VERIFY_RESULT(DocHybridTime::DecodeFromEnd(key)).hybrid_time();
+    if (write_time <= changed_after_ || write_time > up_to) {
+      iter_.Next();
+      continue;
+    }
+    auto doc_key_size = VERIFY_RESULT(DocKey::EncodedHashPartAndDocKeySizes(key)).doc_key_size;
+    doc_key = key.Prefix(doc_key_size);
+    RETURN_NOT_OK(callback(doc_key.AsSlice()));
+
+    // Skip remaining entries of the same row.
+    doc_key.PushBack(KeyEntryTypeAsChar::kMaxByte);
+    iter_.Seek(doc_key.AsSlice());
+  }
+  RETURN_NOT_OK(iter_.status());
+
+  changed_after_ = up_to;
+  return Status::OK();
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,59 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <functional>
+
+#include "yb/common/hybrid_time.h"
+
+#include "yb/docdb/bounded_rocksdb_iterator.h"
+#include "yb/docdb/key_bounds.h"
+
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+namespace docdb {
+
+// Finds rows of the regular RocksDB, that were changed after the specified hybrid time, for readers
+// that need the latest state of the changed rows instead of every operation from the WAL.
+//
+// Uses tailing RocksDB iterator, that observes writes made after its creation, so a single
+// iterator serves all polls instead of creating a new one per poll.
+//
+// Only the fact of the change is tracked, so the caller is expected to read the current state of
+// the reported rows. The caller is also responsible for retaining history after the last polled
+// hybrid time, otherwise changes, e.g. deletions, could be compacted away before they are polled.
+class ChangedRowsTailer {
+ public:
+  using RowCallback = std::function<Status(Slice encoded_doc_key)>;
+
+  ChangedRowsTailer(const DocDB& doc_db, HybridTime changed_after);
+
+  // Invokes callback with the encoded doc key of each row changed after the hybrid time of the
+  // previous poll and not later than up_to, in the key order, once per row.
+  // up_to should not exceed the safe time of the tablet, so no more writes could be made at
+  // hybrid times up to it.
+  Status Poll(HybridTime up_to, const RowCallback& callback);
+
+  HybridTime changed_after() const {
+    return changed_after_;
+  }
+
+ private:
+  BoundedRocksDbIterator iter_;
+  HybridTime changed_after_;
+};
+
+}  // namespace docdb
+}  // namespace yb
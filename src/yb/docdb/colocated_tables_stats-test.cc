@@ -0,0 +1,81 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <string>
+
+#include "yb/docdb/colocated_tables_stats.h"
+#include "yb/docdb/key_bytes.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+class ColocatedTablesStatsTest : public YBTest {
+ protected:
+  static KeyBytes Prefix(ColocationId colocation_id) {
+    KeyBytes result;
+    result.AppendKeyEntryType(KeyEntryType::kColocationId);
+    result.AppendUInt32(colocation_id);
+    return result;
+  }
+
+  static std::string Key(ColocationId colocation_id, const std::string& row) {
+    return Prefix(colocation_id).ToStringBuffer() + row;
+  }
+
+  Status Add(ColocatedTablesCollector* collector, const std::string& key) {
+    return collector->AddUserKey(key, "value", rocksdb::kEntryPut, ++seq_, 0);
+  }
+
+  rocksdb::SequenceNumber seq_ = 0;
+};
+
+TEST_F(ColocatedTablesStatsTest, Collect) {
+  ColocatedTablesCollector collector;
+  ASSERT_OK(Add(&collector, Key(3, "row_1")));
+  ASSERT_OK(Add(&collector, Key(3, "row_2")));
+  ASSERT_OK(Add(&collector, Key(20, "row_1")));
+  // Key without colocated table prefix does not affect the property.
+  ASSERT_OK(Add(&collector, "row_3"));
+
+  rocksdb::TableProperties properties;
+  ASSERT_OK(collector.Finish(&properties.user_collected_properties));
+  ASSERT_TRUE(MayContainColocatedTable(properties, Prefix(3).AsSlice()));
+  ASSERT_TRUE(MayContainColocatedTable(properties, Prefix(20).AsSlice()));
+  ASSERT_FALSE(MayContainColocatedTable(properties, Prefix(4).AsSlice()));
+  ASSERT_FALSE(MayContainColocatedTable(properties, Prefix(300).AsSlice()));
+}
+
+TEST_F(ColocatedTablesStatsTest, Missing) {
+  // Files written before the collector was installed could contain any table.
+  rocksdb::TableProperties properties;
+  ASSERT_TRUE(MayContainColocatedTable(properties, Prefix(3).AsSlice()));
+}
+
+TEST_F(ColocatedTablesStatsTest, TooManyTables) {
+  ColocatedTablesCollector collector;
+  for (size_t i = 0; i <= ColocatedTablesCollector::kMaxTables; ++i) {
+    ASSERT_OK(Add(&collector, Key(static_cast<ColocationId>(i + 1), "row")));
+  }
+
+  rocksdb::TableProperties properties;
+  ASSERT_OK(collector.Finish(&properties.user_collected_properties));
+  ASSERT_TRUE(MayContainColocatedTable(
+      properties, Prefix(ColocatedTablesCollector::kMaxTables + 100).AsSlice()));
+}
+
+}  // namespace docdb
+}  // namespace yb
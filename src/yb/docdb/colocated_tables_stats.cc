@@ -0,0 +1,171 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/colocated_tables_stats.h"
+
+#include "yb/common/schema.h"
+
+#include "yb/docdb/value_type.h"
+
+#include "yb/rocksdb/table/table_reader.h"
+
+#include "yb/util/logging.h"
+#include "yb/util/status.h"
+#include "yb/util/uuid.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+const std::string kColocatedTablesPropertyName = "yb.docdb.colocated_tables";
+
+class ColocatedTablesCollectorFactory : public rocksdb::TablePropertiesCollectorFactory {
+ public:
+  rocksdb::TablePropertiesCollector* CreateTablePropertiesCollector(
+      rocksdb::TablePropertiesCollectorFactory::Context context) override {
+    return new ColocatedTablesCollector();
+  }
+
+  const char* Name() const override {
+    return "ColocatedTablesCollectorFactory";
+  }
+};
+
+} // namespace
+
+KeyBytes ColocatedTablePrefix(const Schema& schema) {
+  KeyBytes result;
+  if (schema.has_cotable_id()) {
+    std::string bytes;
+    schema.cotable_id().EncodeToComparable(&bytes);
+    result.AppendKeyEntryType(KeyEntryType::kTableId);
+    result.AppendRawBytes(bytes);
+  } else if (schema.has_colocation_id()) {
+    result.AppendKeyEntryType(KeyEntryType::kColocationId);
+    result.AppendUInt32(schema.colocation_id());
+  }
+  return result;
+}
+
+Slice ColocatedTablePrefix(Slice key) {
+  if (key.empty()) {
+    return Slice();
+  }
+  size_t size;
+  switch (DecodeKeyEntryType(key[0])) {
+    case KeyEntryType::kTableId:
+      size = 1 + kUuidSize;
+      break;
+    case KeyEntryType::kColocationId:
+      size = 1 + sizeof(ColocationId);
+      break;
+    default:
+      return Slice();
+  }
+  return key.size() >= size ? key.Prefix(size) : Slice();
+}
+
+Status ColocatedTablesCollector::AddUserKey(
+    const Slice& key, const Slice& value, rocksdb::EntryType type, rocksdb::SequenceNumber seq,
+    uint64_t file_size) {
+  if (failed_) {
+    return Status::OK();
+  }
+  auto prefix = ColocatedTablePrefix(key);
+  if (prefix.empty() || prefix == last_prefix_) {
+    return Status::OK();
+  }
+  prefix.CopyToBuffer(&last_prefix_);
+  if (prefixes_.size() >= kMaxTables && !prefixes_.count(last_prefix_)) {
+    failed_ = true;
+    prefixes_.clear();
+    return Status::OK();
+  }
+  prefixes_.insert(last_prefix_);
+  return Status::OK();
+}
+
+Status ColocatedTablesCollector::Finish(rocksdb::UserCollectedProperties* properties) {
+  if (failed_) {
+    return Status::OK();
+  }
+  // Prefixes are self delimited by their key entry type, so they are simply concatenated.
+  std::string value;
+  for (const auto& prefix : prefixes_) {
+    value += prefix;
+  }
+  properties->emplace(kColocatedTablesPropertyName, std::move(value));
+  return Status::OK();
+}
+
+rocksdb::UserCollectedProperties ColocatedTablesCollector::GetReadableProperties() const {
+  rocksdb::UserCollectedProperties result;
+  if (failed_) {
+    return result;
+  }
+  std::string value;
+  for (const auto& prefix : prefixes_) {
+    if (!value.empty()) {
+      value += ", ";
+    }
+    value += Slice(prefix).ToDebugHexString();
+  }
+  result.emplace(kColocatedTablesPropertyName, std::move(value));
+  return result;
+}
+
+const char* ColocatedTablesCollector::Name() const {
+  return "ColocatedTablesCollector";
+}
+
+std::shared_ptr<rocksdb::TablePropertiesCollectorFactory> CreateColocatedTablesCollectorFactory() {
+  return std::make_shared<ColocatedTablesCollectorFactory>();
+}
+
+bool MayContainColocatedTable(const rocksdb::TableProperties& properties, Slice table_prefix) {
+  auto it = properties.user_collected_properties.find(kColocatedTablesPropertyName);
+  if (it == properties.user_collected_properties.end()) {
+    return true;
+  }
+  Slice tables(it->second);
+  while (!tables.empty()) {
+    auto prefix = ColocatedTablePrefix(tables);
+    if (prefix.empty()) {
+      YB_LOG_EVERY_N_SECS(DFATAL, 60)
+          << "Malformed colocated tables property: " << Slice(it->second).ToDebugHexString();
+      return true;
+    }
+    if (prefix == table_prefix) {
+      return true;
+    }
+    tables.remove_prefix(prefix.size());
+  }
+  return false;
+}
+
+ColocatedTableFileFilter::ColocatedTableFileFilter(
+    Slice table_prefix, std::shared_ptr<rocksdb::TableAwareReadFileFilter> base_filter)
+    : table_prefix_(table_prefix.ToBuffer()), base_filter_(std::move(base_filter)) {
+}
+
+bool ColocatedTableFileFilter::Filter(rocksdb::TableReader* reader) const {
+  auto properties = reader->GetTableProperties();
+  if (properties && !MayContainColocatedTable(*properties, table_prefix_)) {
+    return false;
+  }
+  return !base_filter_ || base_filter_->Filter(reader);
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,89 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Colocated tables present in regular DB SST file of colocated tablet. Collected to table
+// properties by flush and compaction. Used by reads of a colocated table to skip files, that
+// contain only other tables of the tablet.
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+
+#include "yb/common/common_fwd.h"
+
+#include "yb/docdb/key_bytes.h"
+
+#include "yb/rocksdb/options.h"
+#include "yb/rocksdb/table_properties.h"
+
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+namespace docdb {
+
+// Returns key prefix of the colocated table with specified schema, i.e. encoded cotable id or
+// colocation id. Empty when the table is not colocated.
+KeyBytes ColocatedTablePrefix(const Schema& schema);
+
+// Returns the prefix of the colocated table that the key belongs to, or empty slice when the key
+// does not start with cotable id or colocation id.
+Slice ColocatedTablePrefix(Slice key);
+
+// Collects the set of colocated table prefixes of all entries in the file. When the file contains
+// too many tables, the property is not written.
+class ColocatedTablesCollector : public rocksdb::TablePropertiesCollector {
+ public:
+  // Max number of tables stored in the property.
+  static constexpr size_t kMaxTables = 4096;
+
+  Status AddUserKey(
+      const Slice& key, const Slice& value, rocksdb::EntryType type, rocksdb::SequenceNumber seq,
+      uint64_t file_size) override;
+
+  Status Finish(rocksdb::UserCollectedProperties* properties) override;
+
+  rocksdb::UserCollectedProperties GetReadableProperties() const override;
+
+  const char* Name() const override;
+
+ private:
+  std::set<std::string> prefixes_;
+  // Prefix of the previous entry, since entries of the same table are adjacent.
+  std::string last_prefix_;
+  bool failed_ = false;
+};
+
+std::shared_ptr<rocksdb::TablePropertiesCollectorFactory> CreateColocatedTablesCollectorFactory();
+
+// Returns false when file with specified properties does not contain entries of colocated table
+// with specified prefix. Files written without collector could contain any tables.
+bool MayContainColocatedTable(const rocksdb::TableProperties& properties, Slice table_prefix);
+
+// Skips files that don't contain entries of the colocated table. Remaining files are checked with
+// the base filter, if any.
+class ColocatedTableFileFilter : public rocksdb::TableAwareReadFileFilter {
+ public:
+  ColocatedTableFileFilter(
+      Slice table_prefix, std::shared_ptr<rocksdb::TableAwareReadFileFilter> base_filter);
+
+  bool Filter(rocksdb::TableReader* reader) const override;
+
+ private:
+  const std::string table_prefix_;
+  const std::shared_ptr<rocksdb::TableAwareReadFileFilter> base_filter_;
+};
+
+}  // namespace docdb
+}  // namespace yb
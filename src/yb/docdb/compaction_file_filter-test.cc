@@ -12,6 +12,7 @@
 //
 
 #include <cstddef>
+#include <limits>
 #include <memory>
 #include <random>
 #include <string>
@@ -38,6 +39,7 @@
 
 DECLARE_bool(file_expiration_ignore_value_ttl);
 DECLARE_bool(file_expiration_value_ttl_overrides_table_ttl);
+DECLARE_int32(compaction_time_windows_per_table_ttl);
 
 namespace yb {
 namespace docdb {
@@ -477,5 +479,40 @@ TEST_F(ExpirationFilterTest, TestFilterMixTableAndValueTTLWithTrustValueTTLFlag)
   TestFilterFilesAgainstResults(&factory, frontiers, expected_results);
 }
 
+TEST_F(ExpirationFilterTest, TimeWindows) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_compaction_time_windows_per_table_ttl) = 10;
+  MonoDelta table_ttl = ValueControlFields::kMaxTtl;
+  DocDBCompactionTimeWindowPolicy policy([&table_ttl] { return table_ttl; });
+  auto file_ptrs = CreateFilePtrs({
+    CreateConsensusFrontier(1900000_usec_ht),
+    CreateConsensusFrontier(1500000_usec_ht),
+    CreateConsensusFrontier(500000_usec_ht, 600000_usec_ht),
+  });
+
+  // While table has no TTL, files are split by value expiration. The largest value TTL is 100ms,
+  // so windows are of 10ms, and files that never expire get the maximal window.
+  constexpr auto kNever = std::numeric_limits<uint64_t>::max();
+  EXPECT_EQ(policy.GetWindows(file_ptrs), (std::vector<uint64_t>{kNever, kNever, 60}));
+
+  // Files are not split into windows when no value expires.
+  {
+    auto no_ttl_file_ptrs = CreateFilePtrs({
+      CreateConsensusFrontier(1900000_usec_ht),
+      CreateConsensusFrontier(1500000_usec_ht, kUseDefaultTTL),
+    });
+    EXPECT_TRUE(policy.GetWindows(no_ttl_file_ptrs).empty());
+    DeleteFilePtrs(&no_ttl_file_ptrs);
+  }
+
+  // Windows of 1 second, value level TTL does not affect window of the file.
+  table_ttl = MonoDelta::FromSeconds(10);
+  EXPECT_EQ(policy.GetWindows(file_ptrs), (std::vector<uint64_t>{1, 1, 0}));
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_compaction_time_windows_per_table_ttl) = 0;
+  EXPECT_TRUE(policy.GetWindows(file_ptrs).empty());
+
+  DeleteFilePtrs(&file_ptrs);
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -14,12 +14,14 @@
 #include "yb/docdb/compaction_file_filter.h"
 
 #include <algorithm>
+#include <limits>
 
 #include "yb/common/hybrid_time.h"
 
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/docdb_compaction_context.h"
+#include "yb/docdb/value.h"
 
 #include "yb/gutil/casts.h"
 
@@ -44,6 +46,11 @@ DEFINE_RUNTIME_bool(file_expiration_value_ttl_overrides_table_ttl, false,
     "written with a value-level TTL. Misuse can result in the deletion of live data!");
 TAG_FLAG(file_expiration_value_ttl_overrides_table_ttl, unsafe);
 
+DEFINE_RUNTIME_int32(compaction_time_windows_per_table_ttl, 30,
+    "Number of time windows per table TTL, used by time window compaction. Files from different "
+    "windows are not compacted together, so smaller windows lower write amplification, but "
+    "increase number of files.");
+
 namespace yb {
 namespace docdb {
 
@@ -192,6 +199,84 @@ const char* DocDBCompactionFileFilterFactory::Name() const {
   return "DocDBCompactionFileFilterFactory";
 }
 
+namespace {
+
+bool HasValueExpiration(const ExpirationTime& expiry) {
+  return expiry.ttl_expiration_ht.is_valid() && expiry.ttl_expiration_ht != kNoExpiration &&
+         expiry.ttl_expiration_ht != kUseDefaultTTL && expiry.created_ht.is_valid() &&
+         expiry.created_ht != HybridTime::kMax;
+}
+
+// Windows of the table without table TTL are built from the value expiration time, with the
+// window size derived from the largest value TTL seen in the files.
+std::vector<uint64_t> GetValueExpirationWindows(
+    const std::vector<FileMetaData*>& files, int32_t windows_per_ttl) {
+  std::vector<ExpirationTime> expirations;
+  expirations.reserve(files.size());
+  int64_t max_ttl_micros = 0;
+  for (auto* file : files) {
+    expirations.push_back(ExtractExpirationTime(file));
+    const auto& expiry = expirations.back();
+    if (HasValueExpiration(expiry)) {
+      max_ttl_micros = std::max<int64_t>(
+          max_ttl_micros,
+          expiry.ttl_expiration_ht.GetPhysicalValueMicros() -
+              expiry.created_ht.GetPhysicalValueMicros());
+    }
+  }
+  if (max_ttl_micros <= 0) {
+    return {};
+  }
+  const uint64_t window_micros = std::max<int64_t>(max_ttl_micros / windows_per_ttl, 1);
+
+  std::vector<uint64_t> result;
+  result.reserve(files.size());
+  for (const auto& expiry : expirations) {
+    // Files that never expire get the maximal window, so they are never merged with files that
+    // could be dropped.
+    result.push_back(
+        HasValueExpiration(expiry)
+            ? expiry.ttl_expiration_ht.GetPhysicalValueMicros() / window_micros
+            : std::numeric_limits<uint64_t>::max());
+  }
+  VLOG(4) << "Value expiration windows of " << window_micros << "us: " << AsString(result);
+  return result;
+}
+
+} // namespace
+
+std::vector<uint64_t> DocDBCompactionTimeWindowPolicy::GetWindows(
+    const std::vector<FileMetaData*>& files) {
+  const auto table_ttl = table_ttl_provider_();
+  const auto windows_per_ttl = FLAGS_compaction_time_windows_per_table_ttl;
+  if (windows_per_ttl <= 0 || !table_ttl.Initialized()) {
+    return {};
+  }
+  if (table_ttl == ValueControlFields::kMaxTtl) {
+    return GetValueExpirationWindows(files, windows_per_ttl);
+  }
+  if (table_ttl.ToMicroseconds() <= 0) {
+    return {};
+  }
+  const uint64_t window_micros =
+      std::max<int64_t>(table_ttl.ToMicroseconds() / windows_per_ttl, 1);
+
+  std::vector<uint64_t> result;
+  result.reserve(files.size());
+  for (auto* file : files) {
+    // Files without frontier get the window with maximal hybrid time, so they are never merged
+    // with older windows.
+    auto created_ht = ExtractExpirationTime(file).created_ht;
+    result.push_back(created_ht.GetPhysicalValueMicros() / window_micros);
+  }
+  VLOG(4) << "Time windows of " << window_micros << "us: " << AsString(result);
+  return result;
+}
+
+const char* DocDBCompactionTimeWindowPolicy::Name() const {
+  return "DocDBCompactionTimeWindowPolicy";
+}
+
 std::string ExpirationTime::ToString() const {
   return YB_STRUCT_TO_STRING(ttl_expiration_ht, created_ht);
 }
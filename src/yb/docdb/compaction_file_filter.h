@@ -13,7 +13,10 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <vector>
+
 #include "yb/docdb/docdb_fwd.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/rocksdb/compaction_filter.h"
@@ -104,6 +107,25 @@ class DocDBCompactionFileFilterFactory : public rocksdb::CompactionFileFilterFac
   scoped_refptr<server::Clock> clock_;
 };
 
+// DocDBCompactionTimeWindowPolicy splits files into time windows by their maximum HybridTime,
+// while table has TTL. Window size is the table TTL divided by
+// compaction_time_windows_per_table_ttl, so a window expires entirely soon after its end plus TTL.
+// When table does not have TTL, files are split by their maximum value expiration time instead,
+// with the window size derived from the largest value TTL in the same way. Files that never expire
+// form the newest window.
+class DocDBCompactionTimeWindowPolicy : public rocksdb::CompactionTimeWindowPolicy {
+ public:
+  explicit DocDBCompactionTimeWindowPolicy(std::function<MonoDelta()> table_ttl_provider)
+      : table_ttl_provider_(std::move(table_ttl_provider)) {}
+
+  std::vector<uint64_t> GetWindows(const std::vector<rocksdb::FileMetaData*>& files) override;
+
+  const char* Name() const override;
+
+ private:
+  std::function<MonoDelta()> table_ttl_provider_;
+};
+
 }  // namespace docdb
 }  // namespace yb
 
@@ -504,7 +504,8 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
         0, // serial no. Could use 0 here, because read_ht == global_limit_ht.
            // So we cannot accept status with time >= read_ht and < global_limit_ht.
         &kRequestReason,
-        TransactionLoadFlags{TransactionLoadFlag::kCleanup},
+        TransactionLoadFlags{
+            TransactionLoadFlag::kCleanup, TransactionLoadFlag::kAcceptRecentPending},
         [self, &transaction](Result<TransactionStatusResult> result) {
           if (result.ok()) {
             transaction.ProcessStatus(*result);
@@ -759,11 +760,14 @@ class StrongConflictChecker {
   Status Check(const Slice& intent_key, bool strong, WaitPolicy wait_policy) {
     const auto hash = VERIFY_RESULT(DecodeDocKeyHash(intent_key));
     if (PREDICT_FALSE(!value_iter_.Initialized() || hash != value_iter_hash_)) {
+      // Iterator is reused for keys with the same hash, so bloom filter should not take into
+      // account range components after the first one.
+      auto filter_key_size = DocKey::EncodedSize(intent_key, DocKeyPart::kUpToHashOrFirstRange);
       value_iter_ = CreateRocksDBIterator(
           resolver_.doc_db().regular,
           resolver_.doc_db().key_bounds,
           BloomFilterMode::USE_BLOOM_FILTER,
-          intent_key,
+          filter_key_size.ok() ? intent_key.Prefix(*filter_key_size) : intent_key,
           rocksdb::kDefaultQueryId);
       value_iter_hash_ = hash;
     }
@@ -35,6 +35,7 @@
 #include "yb/docdb/doc_ql_scanspec.h"
 #include "yb/docdb/doc_read_context.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
+#include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/doc_write_batch.h"
 #include "yb/docdb/docdb.messages.h"
 #include "yb/docdb/docdb_debug.h"
@@ -841,16 +842,18 @@ Status QLWriteOperation::ApplyForRegularColumns(const QLColumnValuePB& column_va
           MakeSubPath(column, column_id), value, data.read_time, data.deadline, request_.query_id(),
           control_fields.ttl));
       break;
-    case TSOpcode::kListRemove:
-      // TODO(akashnil or mihnea) this should call RemoveFromList once thats implemented
-      // Currently list subtraction is computed in memory using builtin call so this
-      // case should never be reached. Once it is implemented the corresponding case
-      // from EvalQLExpressionPB should be uncommented to enable this optimization.
+    case TSOpcode::kListRemove: {
+      // The expression evaluates to the list without the removed elements, which is used to update
+      // indexes. Instead of rewriting the whole list, only the removed elements are deleted.
       RETURN_NOT_OK(CheckUserTimestampForCollections(control_fields.timestamp));
-      RETURN_NOT_OK(data.doc_write_batch->InsertSubDocument(
-          MakeSubPath(column, column_id), value, data.read_time, data.deadline,
-          request_.query_id(), control_fields.ttl, control_fields.timestamp));
+      QLExprResult removed_values;
+      RETURN_NOT_OK(EvalExpr(
+          column_value.expr().tscall().operands(1), existing_row, removed_values.Writer()));
+      RETURN_NOT_OK(data.doc_write_batch->RemoveFromCqlList(
+          MakeSubPath(column, column_id), removed_values.Value(), data.read_time, data.deadline,
+          request_.query_id(), TableTTL(doc_read_context_->schema)));
       break;
+    }
     default:
       LOG(FATAL) << "Unsupported operation: " << static_cast<int>(write_instruction);
       break;
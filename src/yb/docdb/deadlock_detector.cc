@@ -13,6 +13,7 @@
 
 #include "yb/docdb/deadlock_detector.h"
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <mutex>
@@ -51,6 +52,11 @@ DEFINE_int32(
 TAG_FLAG(clear_active_probes_older_than_seconds, hidden);
 TAG_FLAG(clear_active_probes_older_than_seconds, advanced);
 
+DEFINE_RUNTIME_AUTO_bool(batch_deadlock_probes_by_status_tablet, kLocalVolatile, false, true,
+    "Whether to send probes for all blockers of a waiter, that have the same status tablet, in "
+    "one rpc. Older versions ignore the additional blockers of a probe, so it is enabled only "
+    "after all nodes are upgraded.");
+
 METRIC_DEFINE_coarse_histogram(
     tablet, deadlock_size, "Deadlock size", yb::MetricUnit::kTransactions,
     "The number of transactions involved in detected deadlocks");
@@ -60,6 +66,17 @@ METRIC_DEFINE_coarse_histogram(
 METRIC_DEFINE_gauge_uint64(
     tablet, deadlock_detector_waiters, "Num Waiting Txns", yb::MetricUnit::kTransactions,
     "The total number of waiting transactions tracked by one deadlock detector.");
+METRIC_DEFINE_counter(
+    tablet, deadlock_probes_sent, "Deadlock probes sent", yb::MetricUnit::kRequests,
+    "The number of probe rpcs sent by one deadlock detector, including forwarded probes.");
+METRIC_DEFINE_counter(
+    tablet, deadlock_probes_received, "Deadlock probes received", yb::MetricUnit::kRequests,
+    "The number of probe rpcs received by one deadlock detector.");
+METRIC_DEFINE_coarse_histogram(
+    tablet, deadlock_detection_latency, "Deadlock detection latency",
+    yb::MetricUnit::kMilliseconds,
+    "The time from receiving the wait-for relationship of a waiting transaction until the "
+    "deadlock probed on its behalf is detected.");
 
 namespace yb {
 namespace tablet {
@@ -67,6 +84,7 @@ namespace tablet {
 namespace {
 
 YB_STRONGLY_TYPED_UUID(DetectorId);
+YB_STRONGLY_TYPED_BOOL(IsProbeScan);
 
 using LocalProbeProcessorCallback = std::function<void(
     const Status&, const tserver::ProbeTransactionDeadlockResponsePB&)>;
@@ -193,24 +211,32 @@ class LocalProbeProcessor : public std::enable_shared_from_this<LocalProbeProces
   LocalProbeProcessor(
       const std::string& detector_log_prefix, const DetectorId& origin_detector_id,
       uint32_t probe_num, uint32_t min_probe_num, const TransactionId& waiter_id, rpc::Rpcs* rpcs,
-      client::YBClient* client, scoped_refptr<Histogram> probe_latency)
+      client::YBClient* client, scoped_refptr<Histogram> probe_latency,
+      scoped_refptr<Counter> probes_sent)
       : detector_log_prefix_(detector_log_prefix), origin_detector_id_(origin_detector_id),
         waiter_(waiter_id), probe_num_(probe_num), min_probe_num_(min_probe_num), rpcs_(rpcs),
-        client_(client), probe_latency_(std::move(probe_latency)) {}
+        client_(client), probe_latency_(std::move(probe_latency)),
+        probes_sent_(std::move(probes_sent)) {}
 
   const std::string LogPrefix() const {
     return Format("$0- probe($1, $2) ", detector_log_prefix_, origin_detector_id_, probe_num_);
   }
 
   void AddBlocker(const TransactionId& remote_blocker, const TabletId& remote_status_tablet) {
-    handles_.push_back(rpcs_->Prepare());
-    auto handle = handles_.back();
-    if (handle == rpcs_->InvalidHandle()) {
-      LOG_WITH_PREFIX_AND_FUNC(WARNING) << "Shutting down. Cannot send probe.";
-      return;
+    if (GetAtomicFlag(&FLAGS_batch_deadlock_probes_by_status_tablet)) {
+      auto it = request_idx_by_status_tablet_.find(remote_status_tablet);
+      if (it != request_idx_by_status_tablet_.end()) {
+        VLOG_WITH_PREFIX_AND_FUNC(4)
+            << "Batching blocking_txn_id: " << remote_blocker << " with probe to "
+            << "remote_status_tablet: " << remote_status_tablet;
+        requests_[it->second].add_additional_blocking_txn_ids(
+            remote_blocker.data(), remote_blocker.size());
+        return;
+      }
+      request_idx_by_status_tablet_.emplace(remote_status_tablet, requests_.size());
     }
 
-    tserver::ProbeTransactionDeadlockRequestPB req;
+    auto& req = requests_.emplace_back();
     req.set_detector_uuid(origin_detector_id_.data(), origin_detector_id_.size());
     req.set_probe_num(probe_num_);
     req.set_min_probe_num(min_probe_num_);
@@ -224,35 +250,46 @@ class LocalProbeProcessor : public std::enable_shared_from_this<LocalProbeProces
         << "remote_status_tablet: " << remote_status_tablet << ", "
         << "probe_num: " << probe_num_ << ", "
         << "min_probe_num: " << min_probe_num_;
-
-    auto wrapped_callback = [instance = shared_from_this(), handle](
-        const auto& status, const auto& req, const auto& resp) {
-      instance->callback(status, req, resp);
-      instance->rpcs_->Unregister(handle);
-    };
-
-    *handle = client::ProbeTransactionDeadlock(
-        TransactionRpcDeadline(),
-        nullptr /* tablet*/,
-        client_,
-        &req,
-        wrapped_callback);;
   }
 
   void Send() {
-    if (handles_.size() == 0 && CanTrySendResponse()) {
+    if (requests_.empty() && CanTrySendResponse()) {
       LOG_WITH_PREFIX(DFATAL) << "Tried sending probes to 0 remote blockers.";
       callback_(Status::OK(), tserver::ProbeTransactionDeadlockResponsePB());
       return;
     }
 
-    VLOG_WITH_PREFIX(4) << "Sending " << handles_.size() << " probes";
+    VLOG_WITH_PREFIX(4) << "Sending " << requests_.size() << " probes";
 
-    remaining_requests_ = handles_.size();
+    remaining_requests_ = requests_.size();
     if (probe_latency_) {
       sent_at_ = CoarseMonoClock::Now();
     }
-    for (auto& handle : handles_) {
+    for (const auto& request : requests_) {
+      auto handle = rpcs_->Prepare();
+      if (handle == rpcs_->InvalidHandle()) {
+        LOG_WITH_PREFIX_AND_FUNC(WARNING) << "Shutting down. Cannot send probe.";
+        callback(
+            STATUS(ShutdownInProgress, "Deadlock detector is shutting down"), request,
+            tserver::ProbeTransactionDeadlockResponsePB());
+        continue;
+      }
+
+      auto wrapped_callback = [instance = shared_from_this(), handle](
+          const auto& status, const auto& req, const auto& resp) {
+        instance->callback(status, req, resp);
+        instance->rpcs_->Unregister(handle);
+      };
+
+      *handle = client::ProbeTransactionDeadlock(
+          TransactionRpcDeadline(),
+          nullptr /* tablet*/,
+          client_,
+          &request,
+          wrapped_callback);
+      if (probes_sent_) {
+        probes_sent_->Increment();
+      }
       (**handle).SendRpc();
     }
   }
@@ -322,10 +359,12 @@ class LocalProbeProcessor : public std::enable_shared_from_this<LocalProbeProces
   rpc::Rpcs* rpcs_;
   client::YBClient* client_;
   scoped_refptr<Histogram> probe_latency_;
+  scoped_refptr<Counter> probes_sent_;
 
   CoarseTimePoint sent_at_;
 
-  std::vector<rpc::Rpcs::Handle> handles_;
+  std::vector<tserver::ProbeTransactionDeadlockRequestPB> requests_;
+  std::unordered_map<TabletId, size_t> request_idx_by_status_tablet_;
 
   LocalProbeProcessorCallback callback_ = [](const auto& status, const auto& resp) {
     DCHECK(false) << "Did not set callback before sending probes.";
@@ -341,6 +380,13 @@ class LocalProbeProcessor : public std::enable_shared_from_this<LocalProbeProces
 
 using LocalProbeProcessorPtr = std::shared_ptr<LocalProbeProcessor>;
 
+struct ForwardedProbe {
+  LocalProbeProcessorPtr processor;
+  // Maps each transaction the probe is forwarded to, to the blocker from the received probe that
+  // waits on it. Used to extend the deadlock reported by remote detector.
+  std::unordered_map<TransactionId, TransactionId, TransactionIdHash> waiting_blockers;
+};
+
 } // namespace
 
 class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetector::Impl> {
@@ -354,7 +400,10 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
         log_prefix_(Format("T $0 D $1 ", status_tablet_id, detector_id_)),
         deadlock_size_(METRIC_deadlock_size.Instantiate(metrics)),
         probe_latency_(METRIC_deadlock_probe_latency.Instantiate(metrics)),
-        deadlock_detector_waiters_(METRIC_deadlock_detector_waiters.Instantiate(metrics, 0)) {
+        deadlock_detector_waiters_(METRIC_deadlock_detector_waiters.Instantiate(metrics, 0)),
+        probes_sent_(METRIC_deadlock_probes_sent.Instantiate(metrics)),
+        probes_received_(METRIC_deadlock_probes_received.Instantiate(metrics)),
+        detection_latency_(METRIC_deadlock_detection_latency.Instantiate(metrics)) {
     VLOG_WITH_PREFIX(4) << "Deadlock detector started with instance id: " << detector_id_;
   }
 
@@ -371,24 +420,28 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
       tserver::ProbeTransactionDeadlockResponsePB* resp,
       DeadlockDetectorRpcCallback&& callback) {
     VLOG_WITH_PREFIX(4) << "Processing probe request " << req.ShortDebugString();
+    probes_received_->Increment();
 
-    auto processor_or_status = GetProbesToForward(req, resp);
-    if (!processor_or_status.ok()) {
-      callback(processor_or_status.status());
+    auto forwarded_or_status = GetProbesToForward(req, resp);
+    if (!forwarded_or_status.ok()) {
+      callback(forwarded_or_status.status());
       return;
     }
-    if (!*processor_or_status) {
+    if (!forwarded_or_status->processor) {
       callback(Status::OK());
       return;
     }
-    auto& processor = *processor_or_status;
+    auto processor = std::move(forwarded_or_status->processor);
 
     processor->SetCallback(
-        [callback = std::move(callback), detector = shared_from_this(), req, resp]
+        [callback = std::move(callback), detector = shared_from_this(), req, resp,
+         waiting_blockers = std::move(forwarded_or_status->waiting_blockers)]
         (const auto& status, const auto& remote_resp) {
       if (remote_resp.deadlocked_txn_ids_size() > 0) {
         *resp->mutable_deadlocked_txn_ids() = remote_resp.deadlocked_txn_ids();
-        resp->add_deadlocked_txn_ids(req.blocking_txn_id());
+        resp->add_deadlocked_txn_ids(WaitingBlocker(
+            req, remote_resp.deadlocked_txn_ids(remote_resp.deadlocked_txn_ids_size() - 1),
+            waiting_blockers));
         callback(Status::OK());
       } else {
         callback(status);
@@ -420,9 +473,11 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
       const tserver::UpdateTransactionWaitingForStatusRequestPB& req,
       tserver::UpdateTransactionWaitingForStatusResponsePB* resp,
       DeadlockDetectorRpcCallback&& callback) {
-    std::vector<std::pair<const TransactionId, std::shared_ptr<const WaiterData>>> waiters_to_probe;
-    auto status = [this, &waiters_to_probe](const auto& req) -> Status {
+    std::vector<LocalProbeProcessorPtr> probes_to_send;
+    auto status = [this, &probes_to_send](const auto& req) -> Status {
+      std::vector<Waiters::value_type> waiters_to_probe;
       UniqueLock<decltype(mutex_)> l(mutex_);
+      auto now = CoarseMonoClock::Now();
       for (const auto& waiter : req.waiting_transactions()) {
         auto waiter_txn_id = VERIFY_RESULT(FullyDecodeTransactionId(waiter.transaction_id()));
         if (waiter.blocking_transaction_size() == 0) {
@@ -434,6 +489,7 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
         VLOG_WITH_PREFIX(4) << "Processing waiter " << waiter_txn_id;
 
         std::shared_ptr<WaiterData> waiter_data = nullptr;
+        BlockerData old_blockers;
         auto waiter_it = waiters_.find(waiter_txn_id);
         if (waiter_it != waiters_.end()) {
           auto existing_waiter_start_time = waiter_it->second->wait_start_time;
@@ -452,6 +508,7 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
                               << " with newer request at " << wait_start_time;
           waiter_data = waiter_it->second;
           waiter_data->wait_start_time = wait_start_time;
+          old_blockers = std::move(waiter_data->blockers);
           waiter_data->blockers = BlockerData();
         } else {
           VLOG_WITH_PREFIX(1) << "Creating new stored waiter " << waiter_txn_id
@@ -467,6 +524,7 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
 
         auto& blockers = DCHECK_NOTNULL(waiter_data)->blockers;
         blockers.reserve(waiter.blocking_transaction_size());
+        bool has_new_edges = false;
         for (const auto& blocker : waiter.blocking_transaction()) {
           if (blocker.status_tablet_id().empty()) {
             LOG_WITH_PREFIX_AND_FUNC(DFATAL)
@@ -479,6 +537,11 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
             .status_tablet = blocker.status_tablet_id(),
             .subtransactions = nullptr,
           });
+          has_new_edges = has_new_edges || std::none_of(
+              old_blockers.begin(), old_blockers.end(),
+              [&blocker_txn_id](const auto& old_blocker) {
+                return old_blocker.id == blocker_txn_id;
+              });
           VLOG_WITH_PREFIX(4)
               << "Adding new wait-for relationship --"
               << "blocker txn id: " << blocker_txn_id << " "
@@ -486,8 +549,16 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
               << "waiter txn id: " << waiter_txn_id << " "
               << "start time: " << wait_start_time;
         }
+        // Deadlock could only be formed by a new wait-for edge, and waiters with already probed
+        // edges are still covered by the periodic probe scan.
+        if (!has_new_edges) {
+          VLOG_WITH_PREFIX(1) << "No new wait-for edges for waiter " << waiter_txn_id;
+          continue;
+        }
+        waiter_data->reported_at = now;
         waiters_to_probe.push_back(*waiter_it);
       }
+      probes_to_send = GetProbesToSend(waiters_to_probe, IsProbeScan::kFalse);
       return Status::OK();
     }(req);
 
@@ -497,14 +568,15 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
     }
 
     callback(Status::OK());
-    for (const auto& probe : GetProbesToSend(waiters_to_probe)) {
+    for (const auto& probe : probes_to_send) {
       probe->Send();
     }
   }
 
   void TriggerProbes() EXCLUDES(mutex_) {
-    // We should be able to trigger probes only once per unique waiting transaction, but we still
-    // trigger all active probes on a fixed interval for safetey/simplicity.
+    // Probes are sent when new wait-for edges are reported, but we still re-send probes on a
+    // fixed interval for waiters which were not probed since the previous scan, in case their
+    // probes were lost.
     std::vector<LocalProbeProcessorPtr> probes_to_send;
     {
       UniqueLock<decltype(mutex_)> l(mutex_);
@@ -513,10 +585,17 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
       if (is_probe_scan_active_) {
         return;
       }
-      is_probe_scan_active_ = true;
-      // TODO(pessimistic): Trigger probes only for waiters which which have
-      // wait_start_time > Now() - N seconds
-      probes_to_send = GetProbesToSend(waiters_);
+      std::vector<Waiters::value_type> waiters_to_probe;
+      for (const auto& entry : waiters_) {
+        if (entry.second->last_probed_at <= last_scan_time_) {
+          waiters_to_probe.push_back(entry);
+        }
+      }
+      VLOG_WITH_PREFIX(1) << "Probe scan of " << waiters_to_probe.size() << " out of "
+                          << waiters_.size() << " waiters";
+      probes_to_send = GetProbesToSend(waiters_to_probe, IsProbeScan::kTrue);
+      last_scan_time_ = CoarseMonoClock::Now();
+      is_probe_scan_active_ = !probes_to_send.empty();
     }
 
     for (auto& processor : probes_to_send) {
@@ -537,36 +616,42 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
   }
 
  private:
-  template <class T>
-  std::vector<LocalProbeProcessorPtr> GetProbesToSend(const T& waiters) {
+  std::vector<LocalProbeProcessorPtr> GetProbesToSend(
+      const std::vector<Waiters::value_type>& waiters, IsProbeScan is_probe_scan)
+      REQUIRES(mutex_) {
     std::vector<LocalProbeProcessorPtr> probes_to_send;
-    std::shared_ptr<std::atomic<uint64>> outstanding_probes =
-        std::make_shared<std::atomic<uint64>>(waiters.size());
+    auto outstanding_probes = std::make_shared<std::atomic<uint64>>(0);
+    auto now = CoarseMonoClock::Now();
     for (const auto& [waiter_txn_id, waiter_data] : waiters) {
       if (waiter_data->blockers.empty()) {
         LOG_WITH_PREFIX(WARNING) << "Tried getting probes for waiter with no blockers "
                                  << waiter_txn_id;
         continue;
       }
+      waiter_data->last_probed_at = now;
       auto probe_num = seq_no_.fetch_add(1);
       auto processor = std::make_shared<LocalProbeProcessor>(
           log_prefix_, detector_id_, probe_num, created_probes_.GetSmallestProbeNo(),
-          waiter_txn_id, &rpcs_, &client(), probe_latency_);
+          waiter_txn_id, &rpcs_, &client(), probe_latency_, probes_sent_);
       for (const auto& blocker : waiter_data->blockers) {
         DCHECK(!blocker.status_tablet.empty());
         processor->AddBlocker(blocker.id, blocker.status_tablet);
       }
-      processor->SetCallback([detector = shared_from_this(), outstanding_probes, probe_num]
+      processor->SetCallback(
+          [detector = shared_from_this(), outstanding_probes, probe_num, is_probe_scan,
+           reported_at = waiter_data->reported_at]
           (const auto& status, const auto& resp) {
         VLOG(4) << "Got callback for probe "
                 << Format("($0, $1)", probe_num, detector->detector_id_);
         detector->created_probes_.Remove(probe_num);
-        if (outstanding_probes->fetch_sub(1) == 1) {
+        if (outstanding_probes->fetch_sub(1) == 1 && is_probe_scan) {
           UniqueLock<decltype(mutex_)> l(detector->mutex_);
           detector->is_probe_scan_active_ = false;
         }
         if (resp.deadlocked_txn_ids_size() > 0) {
           detector->deadlock_size_->Increment(resp.deadlocked_txn_ids_size());
+          detector->detection_latency_->Increment(ToMilliseconds(
+              CoarseMonoClock::Now() - reported_at));
           auto waiter_or_status = FullyDecodeTransactionId(resp.deadlocked_txn_ids(0));
           if (!waiter_or_status.ok()) {
             LOG(ERROR) << "Failed to decode transaction id in detected deadlock!";
@@ -581,6 +666,8 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
       probes_to_send.push_back(processor);
       created_probes_.AddOrGet(probe_num, TransactionId(waiter_txn_id));
     }
+    // Callbacks could be invoked only after probes are sent, so it is safe to set the counter here.
+    outstanding_probes->store(probes_to_send.size());
     return probes_to_send;
   }
 
@@ -605,85 +692,111 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
     return &waiter_it->second->blockers;
   }
 
-  Result<LocalProbeProcessorPtr> GetProbesToForward(
+  Result<ForwardedProbe> GetProbesToForward(
       const tserver::ProbeTransactionDeadlockRequestPB& req,
       tserver::ProbeTransactionDeadlockResponsePB* resp) {
     auto detector_id = VERIFY_RESULT(FullyDecodeDetectorId(req.detector_uuid()));
     auto probe_num = req.probe_num();
     auto waiting_txn_id = VERIFY_RESULT(FullyDecodeTransactionId(req.waiting_txn_id()));
-    auto blocking_txn_id = VERIFY_RESULT(FullyDecodeTransactionId(req.blocking_txn_id()));
-
-    const BlockerData* blockers = nullptr;
-    {
-      UniqueLock<decltype(mutex_)> l(mutex_);
-      if (detector_id == detector_id_) {
-        auto* probe_originating_txn = created_probes_.Get(probe_num);
-        if (!probe_originating_txn) {
-          LOG_WITH_PREFIX_AND_FUNC(INFO) << "Did not find probe_num: " << probe_num;
-        } else if (*probe_originating_txn == blocking_txn_id) {
-          LOG_WITH_PREFIX_AND_FUNC(INFO)
-              << "Found deadlock: probe_num: " << probe_num << ", waiter: " << waiting_txn_id
-              << ", blocked on: " << blocking_txn_id;
-          resp->add_deadlocked_txn_ids(req.blocking_txn_id());
-          return nullptr;
-        } else {
-          LOG_WITH_PREFIX_AND_FUNC(INFO)
-              << "Found probe_num " << probe_num
-              << " with different transaction_id "<< *probe_originating_txn << " "
-              << "than blocker " << blocking_txn_id << ". Not marking as deadlock.";
-        }
-      }
+    std::vector<TransactionId> blocking_txn_ids;
+    blocking_txn_ids.reserve(1 + req.additional_blocking_txn_ids_size());
+    blocking_txn_ids.push_back(VERIFY_RESULT(FullyDecodeTransactionId(req.blocking_txn_id())));
+    for (const auto& blocking_txn_id : req.additional_blocking_txn_ids()) {
+      blocking_txn_ids.push_back(VERIFY_RESULT(FullyDecodeTransactionId(blocking_txn_id)));
+    }
 
-      auto processing_it = forwarded_probes_.emplace(
-          detector_id, std::make_shared<ProbeTracker<TransactionIdSet>>());
-      if (processing_it.second) {
-        VLOG_WITH_PREFIX(4) << "Creating new probe tracker for detector " << detector_id;
+    ForwardedProbe result;
+    UniqueLock<decltype(mutex_)> l(mutex_);
+    if (detector_id == detector_id_) {
+      auto* probe_originating_txn = created_probes_.Get(probe_num);
+      if (!probe_originating_txn) {
+        LOG_WITH_PREFIX_AND_FUNC(INFO) << "Did not find probe_num: " << probe_num;
+      } else if (std::find(blocking_txn_ids.begin(), blocking_txn_ids.end(),
+                           *probe_originating_txn) != blocking_txn_ids.end()) {
+        LOG_WITH_PREFIX_AND_FUNC(INFO)
+            << "Found deadlock: probe_num: " << probe_num << ", waiter: " << waiting_txn_id
+            << ", blocked on: " << *probe_originating_txn;
+        resp->add_deadlocked_txn_ids(
+            probe_originating_txn->data(), probe_originating_txn->size());
+        return result;
       } else {
-        VLOG_WITH_PREFIX(4) << "Reusing old probe tracker for detector " << detector_id;
-      }
-      auto& tracker = processing_it.first->second;
-      DCHECK_GE(probe_num, req.min_probe_num());
-      tracker->UpdateMinProbeNo(req.min_probe_num());
-
-      auto* seen_blockers = tracker->AddOrGet(probe_num, {});
-      if (!seen_blockers) {
-        VLOG_WITH_PREFIX_AND_FUNC(1)
-            << "Dropping probe with too-small probe_num " << probe_num
-            << " from detector " << detector_id;
-        return nullptr;
+        LOG_WITH_PREFIX_AND_FUNC(INFO)
+            << "Found probe_num " << probe_num
+            << " with different transaction_id "<< *probe_originating_txn << " "
+            << "than blockers " << AsString(blocking_txn_ids) << ". Not marking as deadlock.";
       }
+    }
+
+    auto processing_it = forwarded_probes_.emplace(
+        detector_id, std::make_shared<ProbeTracker<TransactionIdSet>>());
+    if (processing_it.second) {
+      VLOG_WITH_PREFIX(4) << "Creating new probe tracker for detector " << detector_id;
+    } else {
+      VLOG_WITH_PREFIX(4) << "Reusing old probe tracker for detector " << detector_id;
+    }
+    auto& tracker = processing_it.first->second;
+    DCHECK_GE(probe_num, req.min_probe_num());
+    tracker->UpdateMinProbeNo(req.min_probe_num());
+
+    auto* seen_blockers = tracker->AddOrGet(probe_num, {});
+    if (!seen_blockers) {
+      VLOG_WITH_PREFIX_AND_FUNC(1)
+          << "Dropping probe with too-small probe_num " << probe_num
+          << " from detector " << detector_id;
+      return result;
+    }
 
+    for (const auto& blocking_txn_id : blocking_txn_ids) {
       auto blocking_it = seen_blockers->emplace(blocking_txn_id);
       if (!blocking_it.second) {
         VLOG_WITH_PREFIX_AND_FUNC(1) << "Dropping already seen probe"
                 << " from detector " << detector_id
                 << " with probe_num " << probe_num
-                << " at detector " << detector_id_;
-        return nullptr;
-      } else {
-        VLOG_WITH_PREFIX_AND_FUNC(1) << "Tracking probe"
-                << " from detector " << detector_id
-                << " with probe_num " << probe_num
-                << " from waiter " << waiting_txn_id
                 << " to blocker " << blocking_txn_id
                 << " at detector " << detector_id_;
+        continue;
+      }
+      VLOG_WITH_PREFIX_AND_FUNC(1) << "Tracking probe"
+              << " from detector " << detector_id
+              << " with probe_num " << probe_num
+              << " from waiter " << waiting_txn_id
+              << " to blocker " << blocking_txn_id
+              << " at detector " << detector_id_;
+
+      auto* blockers = GetBlockers(detector_id, probe_num, waiting_txn_id, blocking_txn_id);
+      if (!blockers) {
+        continue;
+      }
+      if (!result.processor) {
+        result.processor = std::make_shared<LocalProbeProcessor>(
+            log_prefix_, detector_id, probe_num, req.min_probe_num(), waiting_txn_id, &rpcs_,
+            &client(), nullptr /* probe_latency */, probes_sent_);
+      }
+      for (const auto& blocker : *blockers) {
+        result.processor->AddBlocker(blocker.id, blocker.status_tablet);
+        result.waiting_blockers.emplace(blocker.id, blocking_txn_id);
       }
-
-      blockers = GetBlockers(detector_id, probe_num, waiting_txn_id, blocking_txn_id);
-    }
-    if (!blockers || blockers->empty()) {
-      return nullptr;
     }
 
-    auto local_processor = std::make_shared<LocalProbeProcessor>(
-        log_prefix_, detector_id, probe_num, req.min_probe_num(), waiting_txn_id, &rpcs_,
-        &client(), nullptr /* probe_latency */);
+    return result;
+  }
 
-    for (const auto& blocker : *blockers) {
-      local_processor->AddBlocker(blocker.id, blocker.status_tablet);
+  // Returns the blocker from the received probe, that waits on the last transaction of the
+  // deadlock reported by remote detector.
+  static std::string WaitingBlocker(
+      const tserver::ProbeTransactionDeadlockRequestPB& req, const std::string& remote_txn_id,
+      const std::unordered_map<TransactionId, TransactionId, TransactionIdHash>&
+          waiting_blockers) {
+    auto remote_txn = FullyDecodeTransactionId(remote_txn_id);
+    if (remote_txn.ok()) {
+      auto it = waiting_blockers.find(*remote_txn);
+      if (it != waiting_blockers.end()) {
+        return it->second.AsSlice().ToBuffer();
+      }
     }
-
-    return local_processor;
+    LOG(DFATAL) << "Unexpected transaction " << Slice(remote_txn_id).ToDebugHexString()
+                << " in deadlock reported for probe " << req.ShortDebugString();
+    return req.blocking_txn_id();
   }
 
   void TxnAbortCallback(Result<TransactionStatusResult> res, const TransactionId txn_id) {
@@ -714,6 +827,9 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
   scoped_refptr<Histogram> deadlock_size_;
   scoped_refptr<Histogram> probe_latency_;
   scoped_refptr<AtomicGauge<uint64_t>> deadlock_detector_waiters_;
+  scoped_refptr<Counter> probes_sent_;
+  scoped_refptr<Counter> probes_received_;
+  scoped_refptr<Histogram> detection_latency_;
 
   mutable rw_spinlock mutex_;
 
@@ -727,6 +843,10 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
 
   bool is_probe_scan_active_ GUARDED_BY(mutex_) = false;
 
+  // When the last probe scan was started. Waiters probed after it because of new wait-for edges
+  // are skipped by the next scan.
+  CoarseTimePoint last_scan_time_ GUARDED_BY(mutex_);
+
   Waiters waiters_ GUARDED_BY(mutex_);
 
   std::atomic<uint32_t> seq_no_ = 0;
@@ -21,6 +21,8 @@
 #include "yb/common/transaction.h"
 #include "yb/docdb/wait_queue.h"
 
+#include "yb/util/monotime.h"
+
 namespace yb {
 namespace tablet {
 
@@ -28,6 +30,10 @@ using BlockerData = std::vector<BlockingTransactionData>;
 struct WaiterData {
     HybridTime wait_start_time;
     BlockerData blockers;
+    // When the current wait-for edges of this waiter were reported to the detector.
+    CoarseTimePoint reported_at = CoarseTimePoint();
+    // When probes were last sent on behalf of this waiter.
+    CoarseTimePoint last_probed_at = CoarseTimePoint();
 };
 using Waiters = std::unordered_map<TransactionId,
                                    std::shared_ptr<WaiterData>,
@@ -54,18 +60,23 @@ using DeadlockDetectorRpcCallback = std::function<void(const Status&)>;
 // from a tserver, it forwards this directly to the deadlock detector. The deadlock detector then
 // adds or overwrites information for each waiting transaction_id found in that request.
 //
+// Probes are edge triggered: when a waiter with a new wait-for edge is reported, the deadlock
+// detector does the following for it:
+// 1. probe_id = (probe_no++,detector_id)
+// 2. for each status tablet of blockers:
+// 3.    send probe{probe_id, waiter_id, blocker_ids} to blockers' coordinator
+//
 // On a regular interval (controlled by FLAGS_transaction_deadlock_detection_interval_usec), the
-// deadlock detector will scan all waiting transactions and, for each, do the following:
-// 1. for each blocker:
-// 2.    probe_id = (probe_no++,detector_id)
-// 3.    send probe{probe_id, waiter_id, blocker_id} to blocker's coordinator
+// deadlock detector re-sends probes for waiters, that were not probed since the previous scan.
+// This covers probes lost to rpc failures or forwarded before the blocker's wait-for edges were
+// reported.
 //
 // Upon receiving a ProbeTransactionDeadlockRequestPB, a coordinator forwards it directly to the
 // deadlock detector which does the following:
 // 1. if probe_id is one being tracked by this deadlock detector, and it was originated by the
 //    blocker specified in this probe, then respond indicating that a deadlock has been detected
-// 2. else if the blocker specified in the probe itself has blockers, forward the probe to each of
-//    those coordinators with the same probe_id and waiter_id/blocker_id updated accordingly
+// 2. else if the blockers specified in the probe themselves have blockers, forward the probe to
+//    those coordinators with the same probe_id and waiter_id/blocker_ids updated accordingly
 //
 // When a deadlock is detected, either locally or remotely, attach the waiter who triggered that
 // probe to the response and pass it back to the caller. The originator of the probe should then
@@ -0,0 +1,279 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/common/ql_protocol.pb.h"
+#include "yb/common/ql_value.h"
+#include "yb/common/schema.h"
+
+#include "yb/docdb/doc_column_stats.h"
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/docdb.pb.h"
+#include "yb/docdb/docdb_compaction_context.h"
+#include "yb/docdb/key_entry_value.h"
+#include "yb/docdb/packed_row.h"
+#include "yb/docdb/primitive_value.h"
+#include "yb/docdb/schema_packing.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+constexpr SchemaVersion kSchemaVersion = 1;
+
+class TestSchemaPackingProvider : public SchemaPackingProvider {
+ public:
+  explicit TestSchemaPackingProvider(const Schema& schema)
+      : packing_(std::make_shared<SchemaPacking>(schema)) {}
+
+  Result<CompactionSchemaInfo> CotablePacking(
+      const Uuid& table_id, uint32_t schema_version, HybridTime history_cutoff) override {
+    if (schema_version != kSchemaVersion) {
+      return STATUS_FORMAT(NotFound, "Unknown schema version: $0", schema_version);
+    }
+    return CompactionSchemaInfo {
+      .table_type = TableType::YQL_TABLE_TYPE,
+      .schema_version = kSchemaVersion,
+      .schema_packing = packing_,
+    };
+  }
+
+  Result<CompactionSchemaInfo> ColocationPacking(
+      ColocationId colocation_id, uint32_t schema_version, HybridTime history_cutoff) override {
+    return STATUS(NotSupported, "Colocation is not supported");
+  }
+
+  const SchemaPacking& packing() const {
+    return *packing_;
+  }
+
+ private:
+  std::shared_ptr<SchemaPacking> packing_;
+};
+
+} // namespace
+
+class DocColumnStatsTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    SchemaBuilder builder;
+    ASSERT_OK(builder.AddHashKeyColumn("h", DataType::INT32));
+    ASSERT_OK(builder.AddNullableColumn("v1", DataType::INT32));
+    ASSERT_OK(builder.AddNullableColumn("v2", DataType::STRING));
+    ASSERT_OK(builder.AddNullableColumn("v3", DataType::INT64));
+    schema_ = builder.Build();
+    h_id_ = schema_.column_id(0);
+    v1_id_ = schema_.column_id(1);
+    v2_id_ = schema_.column_id(2);
+    v3_id_ = schema_.column_id(3);
+    // Key column and v3 are listed, but only v1 and v2 should have statistics.
+    schema_.mutable_table_properties()->SetColumnStatsIds({h_id_, v1_id_, v2_id_});
+    provider_.emplace(schema_);
+  }
+
+  static DocKey RowDocKey(int32_t key) {
+    return DocKey(0, {KeyEntryValue::Int32(key)});
+  }
+
+  static std::string Encode(const QLValuePB& value) {
+    std::string result;
+    AppendEncodedValue(value, &result);
+    return result;
+  }
+
+  static std::string KeyEncoded(const QLValuePB& value) {
+    return KeyEntryValue::FromQLValuePB(value, SortingType::kAscending).ToKeyBytes()
+        .ToStringBuffer();
+  }
+
+  void AddColumn(
+      rocksdb::TablePropertiesCollector* collector, int32_t key, ColumnId column_id,
+      const QLValuePB& value) {
+    auto encoded_key = SubDocKey(
+        RowDocKey(key), KeyEntryValue::MakeColumnId(column_id),
+        HybridTime::FromMicros(1000)).Encode();
+    ASSERT_OK(collector->AddUserKey(
+        encoded_key.AsSlice(), Encode(value), rocksdb::kEntryPut, 0, 0));
+  }
+
+  void AddPackedRow(
+      rocksdb::TablePropertiesCollector* collector, int32_t key, const QLValuePB& v1,
+      const QLValuePB& v2, const QLValuePB& v3) {
+    RowPacker packer(
+        kSchemaVersion, provider_->packing(),
+        /* packed_size_limit= */ std::numeric_limits<size_t>::max(),
+        /* control_fields= */ Slice());
+    ASSERT_OK(packer.AddValue(v1_id_, v1));
+    ASSERT_OK(packer.AddValue(v2_id_, v2));
+    ASSERT_OK(packer.AddValue(v3_id_, v3));
+    auto packed = ASSERT_RESULT(packer.Complete());
+    auto encoded_key = SubDocKey(RowDocKey(key), HybridTime::FromMicros(1000)).Encode();
+    ASSERT_OK(collector->AddUserKey(encoded_key.AsSlice(), packed, rocksdb::kEntryPut, 0, 0));
+  }
+
+  ColumnStatsPB Stats(const rocksdb::UserCollectedProperties& properties, ColumnId column_id) {
+    ColumnStatsPB result;
+    auto it = properties.find(ColumnStatsPropertyName(column_id));
+    if (it != properties.end()) {
+      EXPECT_TRUE(result.ParseFromString(it->second));
+    }
+    return result;
+  }
+
+  bool Filter(const rocksdb::UserCollectedProperties& properties, const QLConditionPB& condition) {
+    auto filter = CreateColumnStatsFileFilter(schema_, condition);
+    if (!filter) {
+      return true;
+    }
+    return std::static_pointer_cast<ColumnStatsFileFilter>(filter)->Filter(properties);
+  }
+
+  static QLConditionPB Compare(QLOperator op, ColumnId column_id, const QLValuePB& value) {
+    QLConditionPB result;
+    result.set_op(op);
+    result.add_operands()->set_column_id(column_id.rep());
+    *result.add_operands()->mutable_value() = value;
+    return result;
+  }
+
+  Schema schema_;
+  ColumnId h_id_;
+  ColumnId v1_id_;
+  ColumnId v2_id_;
+  ColumnId v3_id_;
+  std::optional<TestSchemaPackingProvider> provider_;
+};
+
+TEST_F(DocColumnStatsTest, Collect) {
+  auto factory = CreateColumnStatsCollectorFactory(schema_, &*provider_);
+  ASSERT_NE(factory, nullptr);
+  std::unique_ptr<rocksdb::TablePropertiesCollector> collector(
+      factory->CreateTablePropertiesCollector({}));
+  ASSERT_NO_FATALS(AddPackedRow(
+      collector.get(), 1, QLValue::Primitive(20), QLValue::Primitive("open"),
+      QLValue::PrimitiveInt64(5)));
+  ASSERT_NO_FATALS(AddPackedRow(
+      collector.get(), 2, QLValuePB(), QLValue::Primitive("closed"), QLValue::PrimitiveInt64(7)));
+  ASSERT_NO_FATALS(AddColumn(collector.get(), 3, v1_id_, QLValue::Primitive(-5)));
+  ASSERT_NO_FATALS(AddColumn(collector.get(), 3, v3_id_, QLValue::PrimitiveInt64(100)));
+
+  rocksdb::UserCollectedProperties properties;
+  ASSERT_OK(collector->Finish(&properties));
+  ASSERT_EQ(properties.size(), 2);
+
+  auto v1_stats = Stats(properties, v1_id_);
+  ASSERT_EQ(v1_stats.null_count(), 1);
+  ASSERT_EQ(v1_stats.min_value(), KeyEncoded(QLValue::Primitive(-5)));
+  ASSERT_EQ(v1_stats.max_value(), KeyEncoded(QLValue::Primitive(20)));
+
+  auto v2_stats = Stats(properties, v2_id_);
+  ASSERT_EQ(v2_stats.null_count(), 0);
+  ASSERT_EQ(v2_stats.min_value(), KeyEncoded(QLValue::Primitive("closed")));
+  ASSERT_EQ(v2_stats.max_value(), KeyEncoded(QLValue::Primitive("open")));
+
+  ASSERT_TRUE(Filter(properties, Compare(QL_OP_EQUAL, v2_id_, QLValue::Primitive("open"))));
+  ASSERT_FALSE(Filter(properties, Compare(QL_OP_EQUAL, v2_id_, QLValue::Primitive("pending"))));
+  ASSERT_FALSE(Filter(properties, Compare(QL_OP_EQUAL, v2_id_, QLValue::Primitive("a"))));
+  ASSERT_TRUE(Filter(properties, Compare(QL_OP_GREATER_THAN_EQUAL, v1_id_,
+                                         QLValue::Primitive(20))));
+  ASSERT_FALSE(Filter(properties, Compare(QL_OP_GREATER_THAN, v1_id_, QLValue::Primitive(20))));
+  ASSERT_FALSE(Filter(properties, Compare(QL_OP_LESS_THAN, v1_id_, QLValue::Primitive(-5))));
+  // Constant of different type does not allow to compare encoded values.
+  ASSERT_TRUE(Filter(properties, Compare(QL_OP_GREATER_THAN, v1_id_,
+                                         QLValue::PrimitiveInt64(100))));
+  // Column without statistics.
+  ASSERT_TRUE(Filter(properties, Compare(QL_OP_EQUAL, v3_id_, QLValue::PrimitiveInt64(1))));
+
+  // File is skipped when any of the conjuncts could not be satisfied.
+  QLConditionPB condition;
+  condition.set_op(QL_OP_AND);
+  *condition.add_operands()->mutable_condition() =
+      Compare(QL_OP_EQUAL, v2_id_, QLValue::Primitive("open"));
+  *condition.add_operands()->mutable_condition() =
+      Compare(QL_OP_GREATER_THAN, v1_id_, QLValue::Primitive(100));
+  ASSERT_FALSE(Filter(properties, condition));
+
+  // File written without statistics is never skipped.
+  ASSERT_TRUE(Filter({}, Compare(QL_OP_EQUAL, v2_id_, QLValue::Primitive("pending"))));
+}
+
+TEST_F(DocColumnStatsTest, UnknownSchemaVersion) {
+  ColumnStatsCollector collector(
+      std::make_shared<ColumnStatsColumns>(ColumnStatsColumnsFromSchema(schema_)), &*provider_);
+  auto encoded_key = SubDocKey(RowDocKey(1), HybridTime::FromMicros(1000)).Encode();
+  std::string packed;
+  packed.push_back(ValueEntryTypeAsChar::kPackedRow);
+  // Varint encoded schema version 2.
+  packed.push_back(static_cast<char>(0x02));
+  ASSERT_OK(collector.AddUserKey(encoded_key.AsSlice(), packed, rocksdb::kEntryPut, 0, 0));
+  rocksdb::UserCollectedProperties properties;
+  ASSERT_OK(collector.Finish(&properties));
+  ASSERT_TRUE(properties.empty());
+}
+
+TEST_F(DocColumnStatsTest, DataBlockStats) {
+  DataBlockColumnStatsCollector collector(
+      std::make_shared<ColumnStatsColumns>(ColumnStatsColumnsFromSchema(schema_)), &*provider_);
+  auto add_column = [&collector](int32_t key, ColumnId column_id, const QLValuePB& value) {
+    auto encoded_key = SubDocKey(
+        RowDocKey(key), KeyEntryValue::MakeColumnId(column_id),
+        HybridTime::FromMicros(1000)).Encode();
+    collector.Add(encoded_key.AsSlice(), Encode(value), rocksdb::kEntryPut);
+  };
+  add_column(1, v1_id_, QLValue::Primitive(10));
+  add_column(2, v2_id_, QLValue::Primitive("open"));
+  collector.BlockFinished();
+  // Row 2 continues in the second block, so its values should be present in both blocks.
+  add_column(2, v1_id_, QLValue::Primitive(50));
+  collector.BlockFinished();
+  // Delete of row 3 does not have values, but still extends row 3 to the third block.
+  auto delete_key = SubDocKey(RowDocKey(3), HybridTime::FromMicros(2000)).Encode();
+  collector.Add(delete_key.AsSlice(), Slice(), rocksdb::kEntryDelete);
+  collector.BlockFinished();
+  add_column(3, v1_id_, QLValue::Primitive(30));
+  collector.BlockFinished();
+
+  auto blocks = collector.Finish();
+  ASSERT_EQ(blocks.size(), 4);
+
+  auto filter = std::static_pointer_cast<ColumnStatsFileFilter>(CreateColumnStatsFileFilter(
+      schema_, Compare(QL_OP_GREATER_THAN, v1_id_, QLValue::Primitive(40))));
+  ASSERT_NE(filter, nullptr);
+  ASSERT_TRUE(filter->FilterDataBlock(blocks[0]));
+  ASSERT_TRUE(filter->FilterDataBlock(blocks[1]));
+  ASSERT_FALSE(filter->FilterDataBlock(blocks[2]));
+  ASSERT_FALSE(filter->FilterDataBlock(blocks[3]));
+
+  filter = std::static_pointer_cast<ColumnStatsFileFilter>(CreateColumnStatsFileFilter(
+      schema_, Compare(QL_OP_LESS_THAN_EQUAL, v1_id_, QLValue::Primitive(30))));
+  ASSERT_TRUE(filter->FilterDataBlock(blocks[0]));
+  ASSERT_FALSE(filter->FilterDataBlock(blocks[1]));
+  ASSERT_TRUE(filter->FilterDataBlock(blocks[2]));
+  ASSERT_TRUE(filter->FilterDataBlock(blocks[3]));
+
+  filter = std::static_pointer_cast<ColumnStatsFileFilter>(CreateColumnStatsFileFilter(
+      schema_, Compare(QL_OP_EQUAL, v2_id_, QLValue::Primitive("open"))));
+  ASSERT_TRUE(filter->FilterDataBlock(blocks[0]));
+  ASSERT_TRUE(filter->FilterDataBlock(blocks[1]));
+  ASSERT_FALSE(filter->FilterDataBlock(blocks[2]));
+
+  // Block without stats is never skipped.
+  ASSERT_TRUE(filter->FilterDataBlock("garbage"));
+}
+
+}  // namespace docdb
+}  // namespace yb
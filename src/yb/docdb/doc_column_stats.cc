@@ -0,0 +1,588 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/doc_column_stats.h"
+
+#include "yb/common/pgsql_protocol.pb.h"
+#include "yb/common/ql_protocol.pb.h"
+#include "yb/common/ql_type.h"
+#include "yb/common/ql_value.h"
+#include "yb/common/schema.h"
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/docdb.pb.h"
+#include "yb/docdb/docdb_compaction_context.h"
+#include "yb/docdb/key_entry_value.h"
+#include "yb/docdb/primitive_value.h"
+#include "yb/docdb/schema_packing.h"
+#include "yb/docdb/value.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/gutil/casts.h"
+
+#include "yb/rocksdb/table/table_reader.h"
+
+#include "yb/util/fast_varint.h"
+#include "yb/util/logging.h"
+#include "yb/util/result.h"
+#include "yb/util/status_format.h"
+#include "yb/util/uuid.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+const std::string kColumnStatsPropertyPrefix = "yb.docdb.column_stats.";
+
+bool IsColumnStatsSupported(DataType type) {
+  switch (type) {
+    case DataType::INT8: FALLTHROUGH_INTENDED;
+    case DataType::INT16: FALLTHROUGH_INTENDED;
+    case DataType::INT32: FALLTHROUGH_INTENDED;
+    case DataType::INT64: FALLTHROUGH_INTENDED;
+    case DataType::STRING: FALLTHROUGH_INTENDED;
+    case DataType::FLOAT: FALLTHROUGH_INTENDED;
+    case DataType::DOUBLE: FALLTHROUGH_INTENDED;
+    case DataType::TIMESTAMP: FALLTHROUGH_INTENDED;
+    case DataType::DATE: FALLTHROUGH_INTENDED;
+    case DataType::TIME: FALLTHROUGH_INTENDED;
+    case DataType::DECIMAL: FALLTHROUGH_INTENDED;
+    case DataType::VARINT:
+      return true;
+    default:
+      // Booleans are encoded using different key entry types for true and false, so they could
+      // not be checked the same way. Other types are not ordered or don't make sense for ranges.
+      return false;
+  }
+}
+
+class ColumnStatsCollectorFactory : public rocksdb::TablePropertiesCollectorFactory {
+ public:
+  ColumnStatsCollectorFactory(
+      ColumnStatsColumns columns, SchemaPackingProvider* schema_packing_provider)
+      : columns_(std::make_shared<ColumnStatsColumns>(std::move(columns))),
+        schema_packing_provider_(schema_packing_provider) {}
+
+  rocksdb::TablePropertiesCollector* CreateTablePropertiesCollector(
+      rocksdb::TablePropertiesCollectorFactory::Context context) override {
+    return new ColumnStatsCollector(columns_, schema_packing_provider_);
+  }
+
+  const char* Name() const override {
+    return "ColumnStatsCollectorFactory";
+  }
+
+ private:
+  std::shared_ptr<const ColumnStatsColumns> columns_;
+  SchemaPackingProvider* schema_packing_provider_;
+};
+
+class DataBlockColumnStatsCollectorFactory : public rocksdb::DataBlockStatsCollectorFactory {
+ public:
+  DataBlockColumnStatsCollectorFactory(
+      ColumnStatsColumns columns, SchemaPackingProvider* schema_packing_provider)
+      : columns_(std::make_shared<ColumnStatsColumns>(std::move(columns))),
+        schema_packing_provider_(schema_packing_provider) {}
+
+  std::unique_ptr<rocksdb::DataBlockStatsCollector> CreateDataBlockStatsCollector() override {
+    return std::make_unique<DataBlockColumnStatsCollector>(columns_, schema_packing_provider_);
+  }
+
+ private:
+  std::shared_ptr<const ColumnStatsColumns> columns_;
+  SchemaPackingProvider* schema_packing_provider_;
+};
+
+} // namespace
+
+std::string ColumnStatsPropertyName(ColumnId column_id) {
+  return kColumnStatsPropertyPrefix + std::to_string(column_id.rep());
+}
+
+ColumnStatsColumns ColumnStatsColumnsFromSchema(const Schema& schema) {
+  ColumnStatsColumns result;
+  for (const auto& column_id : schema.table_properties().column_stats_ids()) {
+    auto idx = schema.find_column_by_id(column_id);
+    if (idx == Schema::kColumnNotFound || schema.is_key_column(idx)) {
+      continue;
+    }
+    const auto& column = schema.column(idx);
+    if (!IsColumnStatsSupported(column.type()->main())) {
+      continue;
+    }
+    result.push_back(ColumnStatsColumn {
+      .id = column_id,
+      .type = column.type(),
+    });
+  }
+  return result;
+}
+
+void ColumnValueStats::AddValue(Slice encoded_value) {
+  if (!has_values) {
+    has_values = true;
+    min_value = encoded_value.ToBuffer();
+    max_value = min_value;
+  } else if (encoded_value.compare(min_value) < 0) {
+    min_value.assign(encoded_value.cdata(), encoded_value.size());
+  } else if (encoded_value.compare(max_value) > 0) {
+    max_value.assign(encoded_value.cdata(), encoded_value.size());
+  }
+}
+
+void ColumnValueStats::Merge(const ColumnValueStats& rhs) {
+  null_count += rhs.null_count;
+  if (!rhs.has_values) {
+    return;
+  }
+  if (!has_values) {
+    has_values = true;
+    min_value = rhs.min_value;
+    max_value = rhs.max_value;
+    return;
+  }
+  if (rhs.min_value < min_value) {
+    min_value = rhs.min_value;
+  }
+  if (rhs.max_value > max_value) {
+    max_value = rhs.max_value;
+  }
+}
+
+void ColumnValueStats::ToPB(ColumnStatsPB* pb) const {
+  if (has_values) {
+    pb->set_min_value(min_value);
+    pb->set_max_value(max_value);
+  }
+  pb->set_null_count(null_count);
+}
+
+ColumnStatsDecoder::ColumnStatsDecoder(
+    std::shared_ptr<const ColumnStatsColumns> columns,
+    SchemaPackingProvider* schema_packing_provider)
+    : columns_(std::move(columns)), schema_packing_provider_(schema_packing_provider) {
+}
+
+Result<size_t> ColumnStatsDecoder::Decode(
+    Slice key, Slice value, ColumnValueStatsVector* stats) {
+  auto doc_key_size = VERIFY_RESULT(DocKey::EncodedSize(key, DocKeyPart::kWholeDocKey));
+  auto key_type = DecodeKeyEntryType(key[0]);
+  if (key_type == KeyEntryType::kTableId || key_type == KeyEntryType::kColocationId) {
+    return STATUS_FORMAT(NotSupported, "Column stats are not supported for colocated tables");
+  }
+  Slice subkeys = key.WithoutPrefix(doc_key_size);
+  if (subkeys.empty()) {
+    return STATUS(Corruption, "Key without hybrid time");
+  }
+  key_type = DecodeKeyEntryType(subkeys[0]);
+  if (key_type == KeyEntryType::kHybridTime) {
+    // Row level entry.
+    RETURN_NOT_OK(ValueControlFields::Decode(&value));
+    if (value.TryConsumeByte(ValueEntryTypeAsChar::kPackedRow)) {
+      RETURN_NOT_OK(AddPackedRow(value, stats));
+    }
+    return doc_key_size;
+  }
+  if (key_type != KeyEntryType::kColumnId) {
+    return doc_key_size;
+  }
+  subkeys.consume_byte();
+  ColumnId column_id;
+  RETURN_NOT_OK(ColumnId::FromInt64(
+      VERIFY_RESULT(util::FastDecodeSignedVarIntUnsafe(&subkeys)), &column_id));
+  // Entries of collection elements have additional subkeys, such columns are not tracked.
+  if (subkeys.empty() || DecodeKeyEntryType(subkeys[0]) != KeyEntryType::kHybridTime) {
+    return doc_key_size;
+  }
+  for (size_t i = 0; i != columns_->size(); ++i) {
+    if ((*columns_)[i].id == column_id) {
+      RETURN_NOT_OK(ValueControlFields::Decode(&value));
+      RETURN_NOT_OK(AddValue(i, value, stats));
+      break;
+    }
+  }
+  return doc_key_size;
+}
+
+Status ColumnStatsDecoder::AddPackedRow(Slice packed_row, ColumnValueStatsVector* stats) {
+  auto schema_version = narrow_cast<uint32_t>(
+      VERIFY_RESULT(util::FastDecodeUnsignedVarInt(&packed_row)));
+  if (schema_version != schema_version_ || !schema_packing_) {
+    auto info = VERIFY_RESULT(schema_packing_provider_->CotablePacking(
+        Uuid::Nil(), schema_version, HybridTime::kMax));
+    schema_packing_ = std::move(info.schema_packing);
+    schema_version_ = schema_version;
+    packed_indexes_.clear();
+    for (const auto& column : *columns_) {
+      packed_indexes_.push_back(schema_packing_->GetIndex(column.id));
+    }
+  }
+  for (size_t i = 0; i != packed_indexes_.size(); ++i) {
+    if (packed_indexes_[i] == SchemaPacking::kNoColumnIdx) {
+      // Column was added after the row was written, or its values are stored in column entries.
+      ++(*stats)[i].null_count;
+      continue;
+    }
+    RETURN_NOT_OK(AddValue(i, schema_packing_->GetValue(packed_indexes_[i], packed_row), stats));
+  }
+  return Status::OK();
+}
+
+Status ColumnStatsDecoder::AddValue(
+    size_t column_idx, Slice value, ColumnValueStatsVector* stats) {
+  auto& column_stats = (*stats)[column_idx];
+  if (value.empty()) {
+    ++column_stats.null_count;
+    return Status::OK();
+  }
+  const auto& type = (*columns_)[column_idx].type;
+  QLValuePB ql_value;
+  RETURN_NOT_OK(PrimitiveValue::DecodeToQLValuePB(value, type, &ql_value));
+  if (IsNull(ql_value)) {
+    ++column_stats.null_count;
+    return Status::OK();
+  }
+  buffer_.Clear();
+  KeyEntryValue::FromQLValuePB(ql_value, SortingType::kAscending).AppendToKey(&buffer_);
+  column_stats.AddValue(buffer_.AsSlice());
+  return Status::OK();
+}
+
+ColumnStatsCollector::ColumnStatsCollector(
+    std::shared_ptr<const ColumnStatsColumns> columns,
+    SchemaPackingProvider* schema_packing_provider)
+    : decoder_(std::move(columns), schema_packing_provider),
+      stats_(decoder_.columns().size()) {
+}
+
+ColumnStatsCollector::~ColumnStatsCollector() = default;
+
+Status ColumnStatsCollector::AddUserKey(
+    const Slice& key, const Slice& value, rocksdb::EntryType type, rocksdb::SequenceNumber seq,
+    uint64_t file_size) {
+  if (failed_ || type != rocksdb::kEntryPut) {
+    return Status::OK();
+  }
+  auto result = decoder_.Decode(key, value, &stats_);
+  if (!result.ok()) {
+    // Statistics are optional, so don't fail flush or compaction because of them.
+    YB_LOG_EVERY_N_SECS(WARNING, 60)
+        << "Failed to collect column stats for " << key.ToDebugHexString() << ": "
+        << result.status();
+    failed_ = true;
+  }
+  return Status::OK();
+}
+
+Status ColumnStatsCollector::Finish(rocksdb::UserCollectedProperties* properties) {
+  if (failed_) {
+    return Status::OK();
+  }
+  const auto& columns = decoder_.columns();
+  for (size_t i = 0; i != columns.size(); ++i) {
+    ColumnStatsPB pb;
+    stats_[i].ToPB(&pb);
+    properties->emplace(ColumnStatsPropertyName(columns[i].id), pb.SerializeAsString());
+  }
+  return Status::OK();
+}
+
+rocksdb::UserCollectedProperties ColumnStatsCollector::GetReadableProperties() const {
+  rocksdb::UserCollectedProperties result;
+  if (failed_) {
+    return result;
+  }
+  const auto& columns = decoder_.columns();
+  for (size_t i = 0; i != columns.size(); ++i) {
+    const auto& stats = stats_[i];
+    result.emplace(
+        ColumnStatsPropertyName(columns[i].id),
+        stats.has_values
+            ? Format("min: $0, max: $1, null_count: $2",
+                     Slice(stats.min_value).ToDebugHexString(),
+                     Slice(stats.max_value).ToDebugHexString(), stats.null_count)
+            : Format("null_count: $0", stats.null_count));
+  }
+  return result;
+}
+
+const char* ColumnStatsCollector::Name() const {
+  return "ColumnStatsCollector";
+}
+
+std::shared_ptr<rocksdb::TablePropertiesCollectorFactory> CreateColumnStatsCollectorFactory(
+    const Schema& schema, SchemaPackingProvider* schema_packing_provider) {
+  auto columns = ColumnStatsColumnsFromSchema(schema);
+  if (columns.empty()) {
+    return nullptr;
+  }
+  return std::make_shared<ColumnStatsCollectorFactory>(
+      std::move(columns), schema_packing_provider);
+}
+
+DataBlockColumnStatsCollector::DataBlockColumnStatsCollector(
+    std::shared_ptr<const ColumnStatsColumns> columns,
+    SchemaPackingProvider* schema_packing_provider)
+    : decoder_(std::move(columns), schema_packing_provider),
+      current_row_stats_(decoder_.columns().size()) {
+  blocks_.emplace_back(decoder_.columns().size());
+}
+
+DataBlockColumnStatsCollector::~DataBlockColumnStatsCollector() = default;
+
+void DataBlockColumnStatsCollector::Add(
+    const Slice& user_key, const Slice& value, rocksdb::EntryType type) {
+  if (failed_) {
+    return;
+  }
+  auto status = DoAdd(user_key, type == rocksdb::kEntryPut ? value : Slice());
+  if (!status.ok()) {
+    YB_LOG_EVERY_N_SECS(WARNING, 60)
+        << "Failed to collect data block column stats for " << user_key.ToDebugHexString()
+        << ": " << status;
+    failed_ = true;
+  }
+}
+
+Status DataBlockColumnStatsCollector::DoAdd(Slice key, Slice value) {
+  auto doc_key_size = VERIFY_RESULT(DocKey::EncodedSize(key, DocKeyPart::kWholeDocKey));
+  if (key.Prefix(doc_key_size) != current_row_) {
+    FinishRow();
+    key.Prefix(doc_key_size).CopyToBuffer(&current_row_);
+  }
+  // Entries without value, i.e. deletes, only extend the range of blocks of their row.
+  if (value.empty()) {
+    return Status::OK();
+  }
+  RETURN_NOT_OK(decoder_.Decode(key, value, &current_row_stats_));
+  return Status::OK();
+}
+
+void DataBlockColumnStatsCollector::FinishRow() {
+  for (auto i = current_row_first_block_; i != blocks_.size(); ++i) {
+    auto& block = blocks_[i];
+    for (size_t column_idx = 0; column_idx != block.size(); ++column_idx) {
+      block[column_idx].Merge(current_row_stats_[column_idx]);
+    }
+  }
+  current_row_stats_.assign(decoder_.columns().size(), ColumnValueStats());
+  current_row_first_block_ = blocks_.size() - 1;
+}
+
+void DataBlockColumnStatsCollector::BlockFinished() {
+  blocks_.emplace_back(decoder_.columns().size());
+}
+
+std::vector<std::string> DataBlockColumnStatsCollector::Finish() {
+  FinishRow();
+  if (failed_) {
+    return {};
+  }
+  const auto& columns = decoder_.columns();
+  std::vector<std::string> result;
+  // The last element of blocks_ is the block that was not started.
+  result.reserve(blocks_.size() - 1);
+  for (size_t i = 0; i + 1 < blocks_.size(); ++i) {
+    DataBlockColumnStatsPB pb;
+    for (size_t column_idx = 0; column_idx != columns.size(); ++column_idx) {
+      pb.add_column_ids(columns[column_idx].id.rep());
+      blocks_[i][column_idx].ToPB(pb.add_columns());
+    }
+    result.push_back(pb.SerializeAsString());
+  }
+  return result;
+}
+
+std::shared_ptr<rocksdb::DataBlockStatsCollectorFactory> CreateDataBlockColumnStatsCollectorFactory(
+    const Schema& schema, SchemaPackingProvider* schema_packing_provider) {
+  auto columns = ColumnStatsColumnsFromSchema(schema);
+  if (columns.empty()) {
+    return nullptr;
+  }
+  return std::make_shared<DataBlockColumnStatsCollectorFactory>(
+      std::move(columns), schema_packing_provider);
+}
+
+ColumnStatsFileFilter::ColumnStatsFileFilter(std::vector<Bound> bounds)
+    : bounds_(std::move(bounds)) {
+}
+
+bool ColumnStatsFileFilter::Filter(rocksdb::TableReader* reader) const {
+  auto properties = reader->GetTableProperties();
+  return !properties || Filter(properties->user_collected_properties);
+}
+
+bool ColumnStatsFileFilter::MayMatch(const Bound& bound, const ColumnStatsPB& stats) {
+  if (!stats.has_min_value()) {
+    // Only nulls, that never satisfy comparison.
+    return false;
+  }
+  const auto& stats_value = bound.is_lower ? stats.max_value() : stats.min_value();
+  auto bound_value = bound.value.AsSlice();
+  // Values of different key entry types, e.g. int32 column compared with int64 constant,
+  // are not ordered in the same way as the values themselves.
+  if (stats_value.empty() || stats_value[0] != bound_value[0]) {
+    return true;
+  }
+  auto cmp = Slice(stats_value).compare(bound_value);
+  if (!bound.is_lower) {
+    cmp = -cmp;
+  }
+  return cmp > 0 || (cmp == 0 && bound.is_inclusive);
+}
+
+bool ColumnStatsFileFilter::Filter(const rocksdb::UserCollectedProperties& properties) const {
+  for (const auto& bound : bounds_) {
+    auto it = properties.find(ColumnStatsPropertyName(bound.column_id));
+    if (it == properties.end()) {
+      continue;
+    }
+    ColumnStatsPB pb;
+    if (!pb.ParseFromString(it->second)) {
+      continue;
+    }
+    if (!MayMatch(bound, pb)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ColumnStatsFileFilter::FilterDataBlock(Slice block_stats) const {
+  DataBlockColumnStatsPB pb;
+  if (!pb.ParseFromArray(block_stats.cdata(), narrow_cast<int>(block_stats.size())) ||
+      pb.column_ids_size() != pb.columns_size()) {
+    return true;
+  }
+  for (const auto& bound : bounds_) {
+    for (int i = 0; i != pb.column_ids_size(); ++i) {
+      if (pb.column_ids(i) != bound.column_id.rep()) {
+        continue;
+      }
+      if (!MayMatch(bound, pb.columns(i))) {
+        return false;
+      }
+      break;
+    }
+  }
+  return true;
+}
+
+Slice ColumnStatsFileFilter::RowPrefix(Slice user_key) const {
+  auto doc_key_size = DocKey::EncodedSize(user_key, DocKeyPart::kWholeDocKey);
+  if (!doc_key_size.ok()) {
+    LOG(DFATAL) << "Failed to decode doc key from " << user_key.ToDebugHexString() << ": "
+                << doc_key_size.status();
+    return user_key;
+  }
+  return user_key.Prefix(*doc_key_size);
+}
+
+namespace {
+
+template <class Condition>
+void AddColumnStatsBounds(
+    const ColumnStatsColumns& columns, const Condition& condition,
+    bool equality_only, std::vector<ColumnStatsFileFilter::Bound>* bounds) {
+  bool lower = false;
+  bool upper = false;
+  bool inclusive = true;
+  switch (condition.op()) {
+    case QL_OP_AND:
+      for (const auto& operand : condition.operands()) {
+        if (operand.has_condition()) {
+          AddColumnStatsBounds(columns, operand.condition(), equality_only, bounds);
+        }
+      }
+      return;
+    case QL_OP_EQUAL:
+      lower = upper = true;
+      break;
+    case QL_OP_LESS_THAN:
+      inclusive = false;
+      FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN_EQUAL:
+      upper = true;
+      break;
+    case QL_OP_GREATER_THAN:
+      inclusive = false;
+      FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN_EQUAL:
+      lower = true;
+      break;
+    default:
+      return;
+  }
+  if ((equality_only && !(lower && upper)) || condition.operands().size() != 2) {
+    return;
+  }
+  const auto& lhs = condition.operands(0);
+  const auto& rhs = condition.operands(1);
+  bool lhs_is_column = lhs.has_column_id();
+  const auto& column_operand = lhs_is_column ? lhs : rhs;
+  const auto& value_operand = lhs_is_column ? rhs : lhs;
+  if (!column_operand.has_column_id() || !value_operand.has_value() ||
+      IsNull(value_operand.value())) {
+    return;
+  }
+  if (!lhs_is_column) {
+    // <value> < <column> is the same as <column> > <value>.
+    std::swap(lower, upper);
+  }
+  ColumnId column_id(column_operand.column_id());
+  auto it = std::find_if(columns.begin(), columns.end(), [column_id](const auto& column) {
+    return column.id == column_id;
+  });
+  if (it == columns.end()) {
+    return;
+  }
+  KeyBytes value;
+  KeyEntryValue::FromQLValuePB(value_operand.value(), SortingType::kAscending).AppendToKey(&value);
+  if (lower) {
+    bounds->push_back({column_id, value, /* is_lower= */ true, inclusive});
+  }
+  if (upper) {
+    bounds->push_back({column_id, std::move(value), /* is_lower= */ false, inclusive});
+  }
+}
+
+template <class Condition>
+std::shared_ptr<rocksdb::TableStatsReadFileFilter> DoCreateColumnStatsFileFilter(
+    const Schema& schema, const Condition& condition, bool equality_only) {
+  auto columns = ColumnStatsColumnsFromSchema(schema);
+  if (columns.empty()) {
+    return nullptr;
+  }
+  std::vector<ColumnStatsFileFilter::Bound> bounds;
+  AddColumnStatsBounds(columns, condition, equality_only, &bounds);
+  if (bounds.empty()) {
+    return nullptr;
+  }
+  return std::make_shared<ColumnStatsFileFilter>(std::move(bounds));
+}
+
+} // namespace
+
+std::shared_ptr<rocksdb::TableStatsReadFileFilter> CreateColumnStatsFileFilter(
+    const Schema& schema, const QLConditionPB& condition) {
+  return DoCreateColumnStatsFileFilter(schema, condition, /* equality_only= */ false);
+}
+
+std::shared_ptr<rocksdb::TableStatsReadFileFilter> CreateColumnStatsFileFilter(
+    const Schema& schema, const PgsqlConditionPB& condition) {
+  return DoCreateColumnStatsFileFilter(schema, condition, /* equality_only= */ true);
+}
+
+}  // namespace docdb
+}  // namespace yb
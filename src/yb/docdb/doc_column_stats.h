@@ -0,0 +1,204 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Statistics of non key column values, collected to table properties of SST files and to stats of
+// their data blocks by flush and compaction. Used by scans with conditions on such columns to skip
+// files and data blocks, that could not contain matching rows.
+
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "yb/common/column_id.h"
+#include "yb/common/common_fwd.h"
+
+#include "yb/docdb/docdb_fwd.h"
+#include "yb/docdb/key_bytes.h"
+
+#include "yb/rocksdb/options.h"
+#include "yb/rocksdb/table.h"
+#include "yb/rocksdb/table_properties.h"
+
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+namespace docdb {
+
+struct ColumnStatsColumn {
+  ColumnId id;
+  std::shared_ptr<QLType> type;
+};
+
+using ColumnStatsColumns = std::vector<ColumnStatsColumn>;
+
+// Name of the user collected table property, that contains serialized ColumnStatsPB of the column.
+std::string ColumnStatsPropertyName(ColumnId column_id);
+
+// Returns columns listed in column_stats_ids table property of the schema, that could have
+// statistics. Those are non key columns of types whose key encoding preserves value order.
+ColumnStatsColumns ColumnStatsColumnsFromSchema(const Schema& schema);
+
+// Min/max key encoded non null values and number of nulls of the column.
+struct ColumnValueStats {
+  std::string min_value;
+  std::string max_value;
+  bool has_values = false;
+  uint64_t null_count = 0;
+
+  void AddValue(Slice encoded_value);
+  void Merge(const ColumnValueStats& rhs);
+  void ToPB(ColumnStatsPB* pb) const;
+};
+
+using ColumnValueStatsVector = std::vector<ColumnValueStats>;
+
+// Decodes values of specified columns from entries of regular DB of non colocated tablet.
+// Both column entries and packed rows are taken into account.
+class ColumnStatsDecoder {
+ public:
+  ColumnStatsDecoder(
+      std::shared_ptr<const ColumnStatsColumns> columns,
+      SchemaPackingProvider* schema_packing_provider);
+
+  // Adds values of the entry to stats, that has an element for each column.
+  // Returns size of the encoded doc key of the entry.
+  Result<size_t> Decode(Slice key, Slice value, ColumnValueStatsVector* stats);
+
+  const ColumnStatsColumns& columns() const {
+    return *columns_;
+  }
+
+ private:
+  Status AddPackedRow(Slice packed_row, ColumnValueStatsVector* stats);
+  Status AddValue(size_t column_idx, Slice value, ColumnValueStatsVector* stats);
+
+  std::shared_ptr<const ColumnStatsColumns> columns_;
+  SchemaPackingProvider* schema_packing_provider_;
+  // Packing of the last seen packed row, and indexes of columns_ in it.
+  uint32_t schema_version_ = std::numeric_limits<uint32_t>::max();
+  std::shared_ptr<const SchemaPacking> schema_packing_;
+  std::vector<int64_t> packed_indexes_;
+  KeyBytes buffer_;
+};
+
+// Collects min/max values and null count of specified columns to table properties.
+// Overwritten versions are also taken into account, so statistics cover all values stored in the
+// file. When some entry could not be decoded, no statistics are written for the file.
+class ColumnStatsCollector : public rocksdb::TablePropertiesCollector {
+ public:
+  ColumnStatsCollector(
+      std::shared_ptr<const ColumnStatsColumns> columns,
+      SchemaPackingProvider* schema_packing_provider);
+  ~ColumnStatsCollector();
+
+  Status AddUserKey(
+      const Slice& key, const Slice& value, rocksdb::EntryType type, rocksdb::SequenceNumber seq,
+      uint64_t file_size) override;
+
+  Status Finish(rocksdb::UserCollectedProperties* properties) override;
+
+  rocksdb::UserCollectedProperties GetReadableProperties() const override;
+
+  const char* Name() const override;
+
+ private:
+  ColumnStatsDecoder decoder_;
+  ColumnValueStatsVector stats_;
+  bool failed_ = false;
+};
+
+// Returns nullptr when schema has no columns with statistics.
+std::shared_ptr<rocksdb::TablePropertiesCollectorFactory> CreateColumnStatsCollectorFactory(
+    const Schema& schema, SchemaPackingProvider* schema_packing_provider);
+
+// Collects statistics of specified columns for each data block of SST file, encoded as
+// DataBlockColumnStatsPB. Statistics of the data block cover all entries of the rows that have
+// entries in this block, even when some of them are stored in the neighbour blocks. So when row
+// matches the filter, none of its data blocks is skipped.
+class DataBlockColumnStatsCollector : public rocksdb::DataBlockStatsCollector {
+ public:
+  DataBlockColumnStatsCollector(
+      std::shared_ptr<const ColumnStatsColumns> columns,
+      SchemaPackingProvider* schema_packing_provider);
+  ~DataBlockColumnStatsCollector();
+
+  void Add(const Slice& user_key, const Slice& value, rocksdb::EntryType type) override;
+
+  void BlockFinished() override;
+
+  std::vector<std::string> Finish() override;
+
+ private:
+  Status DoAdd(Slice key, Slice value);
+
+  // Adds stats of the current row to all blocks that contain its entries.
+  void FinishRow();
+
+  ColumnStatsDecoder decoder_;
+  // Stats of finished blocks, followed by stats of the current block.
+  std::vector<ColumnValueStatsVector> blocks_;
+  std::string current_row_;
+  // Index of the block in blocks_ that contains the first entry of the current row.
+  size_t current_row_first_block_ = 0;
+  ColumnValueStatsVector current_row_stats_;
+  bool failed_ = false;
+};
+
+// Returns nullptr when schema has no columns with statistics.
+std::shared_ptr<rocksdb::DataBlockStatsCollectorFactory> CreateDataBlockColumnStatsCollectorFactory(
+    const Schema& schema, SchemaPackingProvider* schema_packing_provider);
+
+// Skips files and data blocks whose column statistics show that some of the conjuncts could not be
+// satisfied.
+class ColumnStatsFileFilter : public rocksdb::TableStatsReadFileFilter {
+ public:
+  struct Bound {
+    ColumnId column_id;
+    KeyBytes value;
+    bool is_lower;
+    bool is_inclusive;
+  };
+
+  explicit ColumnStatsFileFilter(std::vector<Bound> bounds);
+
+  bool Filter(rocksdb::TableReader* reader) const override;
+
+  Slice RowPrefix(Slice user_key) const override;
+
+  // Returns false when table with specified properties does not contain matching values.
+  bool Filter(const rocksdb::UserCollectedProperties& properties) const;
+
+  bool FilterDataBlock(Slice block_stats) const override;
+
+ private:
+  // Returns false when column with specified stats does not have values satisfying the bound.
+  static bool MayMatch(const Bound& bound, const ColumnStatsPB& stats);
+
+  std::vector<Bound> bounds_;
+};
+
+// Returns filter for comparisons of columns with statistics and constants joined with AND,
+// or nullptr when condition has no such comparisons.
+std::shared_ptr<rocksdb::TableStatsReadFileFilter> CreateColumnStatsFileFilter(
+    const Schema& schema, const QLConditionPB& condition);
+
+// Only equality comparisons are used for YSQL, because ordering of its types is defined by
+// collations and does not always match the key encoding.
+std::shared_ptr<rocksdb::TableStatsReadFileFilter> CreateColumnStatsFileFilter(
+    const Schema& schema, const PgsqlConditionPB& condition);
+
+}  // namespace docdb
+}  // namespace yb
@@ -438,6 +438,65 @@ TEST_F(DocKeyTest, TestKeyMatching) {
   ASSERT_FALSE(may_match(EncodeSimpleSubDocKey(absent_key))) << "Key: " << absent_key;
 }
 
+TEST_F(DocKeyTest, TestRangePrefixKeyMatching) {
+  DocDbAwareRangePrefixFilterPolicy policy(
+      rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr, /* num_range_components= */ 2);
+  ASSERT_EQ(std::string(policy.Name()), "DocKeyRangePrefix2Filter");
+  const auto* transformer = policy.GetKeyTransformer();
+
+  auto make_key = [](const std::string& device, std::vector<KeyEntryValue> range) {
+    return DocKey(0, KeyEntryValues(device), std::move(range)).Encode();
+  };
+  auto make_sub_doc_key = [](const std::string& device, int32_t day, int64_t ts) {
+    return SubDocKey(
+        DocKey(0, KeyEntryValues(device),
+               {KeyEntryValue::Int32(day), KeyEntryValue::Int32(1), KeyEntryValue::Int64(ts)}),
+        KeyEntryValue::MakeColumnId(ColumnId(11)), HybridTime::FromMicros(1000)).Encode();
+  };
+
+  std::unique_ptr<FilterBitsBuilder> builder(policy.GetFilterBitsBuilder());
+  ASSERT_NE(builder, nullptr);
+  for (int32_t day : {1, 2}) {
+    for (int64_t ts = 0; ts != 10; ++ts) {
+      builder->AddKey(transformer->Transform(make_sub_doc_key("dev1", day, ts)));
+    }
+  }
+  std::unique_ptr<const char[]> buf;
+  rocksdb::Slice filter = builder->Finish(&buf);
+  std::unique_ptr<FilterBitsReader> reader(policy.GetFilterBitsReader(filter));
+
+  // Emulates the way DocRowwiseIterator builds filter key from scan bounds.
+  auto may_match = [&](const KeyBytes& lower, const KeyBytes& upper) -> Result<bool> {
+    auto prefix_size = VERIFY_RESULT(
+        EqualDocKeyComponentsPrefixSize(lower.AsSlice(), upper.AsSlice()));
+    auto filter_key = transformer->Transform(lower.AsSlice().Prefix(prefix_size));
+    return filter_key.empty() || reader->MayMatch(filter_key);
+  };
+
+  auto day_lower = [&](const std::string& device, int32_t day) {
+    return make_key(device, {KeyEntryValue::Int32(day), KeyEntryValue::Int32(1)});
+  };
+  auto day_upper = [&](const std::string& device, int32_t day) {
+    return make_key(device, {KeyEntryValue::Int32(day), KeyEntryValue::Int32(1),
+                             KeyEntryValue(KeyEntryType::kHighest)});
+  };
+
+  ASSERT_TRUE(ASSERT_RESULT(may_match(day_lower("dev1", 1), day_upper("dev1", 1))));
+  ASSERT_TRUE(ASSERT_RESULT(may_match(day_lower("dev1", 2), day_upper("dev1", 2))));
+  ASSERT_FALSE(ASSERT_RESULT(may_match(day_lower("dev1", 3), day_upper("dev1", 3))));
+  ASSERT_FALSE(ASSERT_RESULT(may_match(day_lower("dev2", 1), day_upper("dev2", 1))));
+
+  // Scan over several days does not fix the second range component, so file cannot be skipped.
+  ASSERT_TRUE(ASSERT_RESULT(may_match(
+      make_key("dev2", {KeyEntryValue::Int32(1)}), make_key("dev2", {KeyEntryValue::Int32(5)}))));
+  // Different hashed components.
+  ASSERT_TRUE(ASSERT_RESULT(may_match(day_lower("dev2", 1), day_upper("dev3", 1))));
+
+  // Keys with less range components than filter depth always match.
+  ASSERT_TRUE(transformer->Transform(make_key("dev2", {KeyEntryValue::Int32(1)})).empty());
+  ASSERT_TRUE(transformer->Transform(make_key("dev2", {})).empty());
+}
+
 TEST_F(DocKeyTest, TestWriteId) {
   SubDocKey subdoc_key(DocKey({KeyEntryValue("a"), KeyEntryValue::Int32(135)}),
                        DocHybridTime(1000000, 4091, 135));
@@ -13,6 +13,7 @@
 
 #include "yb/docdb/doc_key.h"
 
+#include <array>
 #include <memory>
 #include <sstream>
 
@@ -883,11 +884,13 @@ Status SubDocKey::DecodeDocKeyAndSubKeyEnds(
         && slice[id_size] == KeyEntryTypeAsChar::kGroupEnd) {
       SCHECK_GE(slice.size(), id_size + 2, Corruption,
                 Format("Space for kHybridTime expected in key $0", slice.ToDebugHexString()));
-      SCHECK_EQ(slice[id_size + 1], KeyEntryTypeAsChar::kHybridTime, Corruption,
-                Format("Hybrid time expected in key $0", slice.ToDebugHexString()));
       // Consume kGroupEnd without pushing to out because the empty key of a table tombstone
       // shouldn't count as an end.
       slice.remove_prefix(id_size + 1);
+      // Range tombstones of the table are stored as subkeys of the empty key.
+      if (slice[0] != KeyEntryTypeAsChar::kHybridTime) {
+        out->push_back(id_size + 1);
+      }
     } else {
       slice.remove_prefix(id_size);
       auto doc_key_size = VERIFY_RESULT(DocKey::EncodedSize(slice, DocKeyPart::kWholeDocKey));
@@ -1153,6 +1156,46 @@ class HashedDocKeyUpToHashComponentsExtractor : public rocksdb::FilterPolicy::Ke
   HashedDocKeyUpToHashComponentsExtractor() = default;
 };
 
+class DocKeyRangePrefixExtractor : public rocksdb::FilterPolicy::KeyTransformer {
+ public:
+  DocKeyRangePrefixExtractor(const DocKeyRangePrefixExtractor&) = delete;
+  DocKeyRangePrefixExtractor& operator=(const DocKeyRangePrefixExtractor&) = delete;
+
+  static const DocKeyRangePrefixExtractor& GetInstance(size_t num_range_components) {
+    static const std::array<DocKeyRangePrefixExtractor, kMaxBloomFilterRangeComponents> instances {
+      DocKeyRangePrefixExtractor(1),
+      DocKeyRangePrefixExtractor(2),
+      DocKeyRangePrefixExtractor(3),
+      DocKeyRangePrefixExtractor(4),
+    };
+    return instances[num_range_components - 1];
+  }
+
+  // For encoded DocKey extracts prefix up to hashed components and num_range_components_ range
+  // components. For non-DocKey or DocKey with less range components returns empty key, so
+  // they will always match the filter.
+  Slice Transform(Slice key) const override {
+    auto size_result = DocKey::EncodedSize(key, DocKeyPart::kUpToHash);
+    if (!size_result.ok()) {
+      return Slice();
+    }
+    Slice range_components = key.WithoutPrefix(*size_result);
+    for (size_t i = 0; i != num_range_components_; ++i) {
+      auto consumed = ConsumePrimitiveValueFromKey(&range_components);
+      if (!consumed.ok() || !*consumed) {
+        return Slice();
+      }
+    }
+    return Slice(key.data(), range_components.data());
+  }
+
+ private:
+  explicit DocKeyRangePrefixExtractor(size_t num_range_components)
+      : num_range_components_(num_range_components) {}
+
+  const size_t num_range_components_;
+};
+
 } // namespace
 
 void DocDbAwareFilterPolicyBase::CreateFilter(
@@ -1197,6 +1240,20 @@ DocDbAwareV3FilterPolicy::GetKeyTransformer() const {
   return &DocKeyComponentsExtractor<DocKeyPart::kUpToHashOrFirstRange>::GetInstance();
 }
 
+DocDbAwareRangePrefixFilterPolicy::DocDbAwareRangePrefixFilterPolicy(
+    size_t filter_block_size_bits, rocksdb::Logger* logger, size_t num_range_components)
+    : DocDbAwareFilterPolicyBase(filter_block_size_bits, logger),
+      num_range_components_(num_range_components),
+      name_(Format("DocKeyRangePrefix$0Filter", num_range_components)) {
+  CHECK_GE(num_range_components, 1);
+  CHECK_LE(num_range_components, kMaxBloomFilterRangeComponents);
+}
+
+const rocksdb::FilterPolicy::KeyTransformer*
+DocDbAwareRangePrefixFilterPolicy::GetKeyTransformer() const {
+  return &DocKeyRangePrefixExtractor::GetInstance(num_range_components_);
+}
+
 DocKeyEncoderAfterTableIdStep DocKeyEncoder::CotableId(const Uuid& cotable_id) {
   if (!cotable_id.IsNil()) {
     std::string bytes;
@@ -1412,6 +1469,60 @@ Result<bool> HashedOrFirstRangeComponentsEqual(const Slice& lhs, const Slice& rh
   return rhs_decoder.GroupEnded();
 }
 
+Result<size_t> EqualDocKeyComponentsPrefixSize(const Slice& lhs, const Slice& rhs) {
+  DocKeyDecoder lhs_decoder(lhs);
+  DocKeyDecoder rhs_decoder(rhs);
+  RETURN_NOT_OK(lhs_decoder.DecodeCotableId());
+  RETURN_NOT_OK(rhs_decoder.DecodeCotableId());
+  RETURN_NOT_OK(lhs_decoder.DecodeColocationId());
+  RETURN_NOT_OK(rhs_decoder.DecodeColocationId());
+
+  const bool hash_present = VERIFY_RESULT(lhs_decoder.DecodeHashCode(AllowSpecial::kTrue));
+  if (hash_present != VERIFY_RESULT(rhs_decoder.DecodeHashCode(AllowSpecial::kTrue))) {
+    return 0;
+  }
+
+  size_t result = lhs_decoder.ConsumedSizeFrom(lhs.data());
+  if (result != rhs_decoder.ConsumedSizeFrom(rhs.data()) ||
+      !strings::memeq(lhs.data(), rhs.data(), result)) {
+    return 0;
+  }
+
+  // Returns true if next components of lhs and rhs are present and equal.
+  auto consume_equal_component = [&lhs_decoder, &rhs_decoder]() -> Result<bool> {
+    if (lhs_decoder.GroupEnded() || rhs_decoder.GroupEnded()) {
+      return false;
+    }
+    auto lhs_start = lhs_decoder.left_input().data();
+    auto rhs_start = rhs_decoder.left_input().data();
+    RETURN_NOT_OK(lhs_decoder.DecodeKeyEntryValue(AllowSpecial::kTrue));
+    RETURN_NOT_OK(rhs_decoder.DecodeKeyEntryValue(AllowSpecial::kTrue));
+    auto consumed = lhs_decoder.ConsumedSizeFrom(lhs_start);
+    return consumed == rhs_decoder.ConsumedSizeFrom(rhs_start) &&
+           strings::memeq(lhs_start, rhs_start, consumed);
+  };
+
+  if (hash_present) {
+    while (!lhs_decoder.GroupEnded()) {
+      if (!VERIFY_RESULT(consume_equal_component())) {
+        return 0;
+      }
+    }
+    if (!rhs_decoder.GroupEnded() || lhs_decoder.left_input().empty() ||
+        rhs_decoder.left_input().empty()) {
+      return 0;
+    }
+    RETURN_NOT_OK(lhs_decoder.ConsumeGroupEnd());
+    RETURN_NOT_OK(rhs_decoder.ConsumeGroupEnd());
+    result = lhs_decoder.ConsumedSizeFrom(lhs.data());
+  }
+
+  while (VERIFY_RESULT(consume_equal_component())) {
+    result = lhs_decoder.ConsumedSizeFrom(lhs.data());
+  }
+  return result;
+}
+
 bool DocKeyBelongsTo(Slice doc_key, const Schema& schema) {
   bool has_table_id = !doc_key.empty() &&
        (doc_key[0] == KeyEntryTypeAsChar::kTableId ||
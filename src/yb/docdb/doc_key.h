@@ -438,6 +438,12 @@ Result<bool> ClearRangeComponents(KeyBytes* out, AllowSpecial allow_special = Al
 // hashed components and first range components are equal and false otherwise.
 Result<bool> HashedOrFirstRangeComponentsEqual(const Slice& lhs, const Slice& rhs);
 
+// Returns size of lhs prefix, that contains doc key components which are equal in both keys:
+// table id, all hashed components (only when all of them are equal) and leading range components.
+// Used to build key for bloom filter checks, so only components fixed by scan are taken into
+// account.
+Result<size_t> EqualDocKeyComponentsPrefixSize(const Slice& lhs, const Slice& rhs);
+
 bool DocKeyBelongsTo(Slice doc_key, const Schema& schema);
 
 // Consumes single primitive value from start of slice.
@@ -881,6 +887,28 @@ class DocDbAwareV3FilterPolicy : public DocDbAwareFilterPolicyBase {
   const KeyTransformer* GetKeyTransformer() const override;
 };
 
+// Max number of range components supported by DocDbAwareRangePrefixFilterPolicy.
+constexpr size_t kMaxBloomFilterRangeComponents = 4;
+
+// This filter policy takes into account hashed components of the doc key, if present, followed by
+// the specified number of its leading range components. Keys that do not have enough range
+// components always match the filter.
+// Allows to skip files for scans with equality condition on leading range columns, e.g. for
+// time series tables keyed by (hash device_id, range day, ts).
+class DocDbAwareRangePrefixFilterPolicy : public DocDbAwareFilterPolicyBase {
+ public:
+  DocDbAwareRangePrefixFilterPolicy(
+      size_t filter_block_size_bits, rocksdb::Logger* logger, size_t num_range_components);
+
+  const char* Name() const override { return name_.c_str(); }
+
+  const KeyTransformer* GetKeyTransformer() const override;
+
+ private:
+  const size_t num_range_components_;
+  const std::string name_;
+};
+
 }  // namespace docdb
 }  // namespace yb
 
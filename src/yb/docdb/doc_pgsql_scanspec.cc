@@ -13,11 +13,14 @@
 
 #include "yb/docdb/doc_pgsql_scanspec.h"
 
+#include <algorithm>
+
 #include <boost/optional/optional_io.hpp>
 
 #include "yb/common/pgsql_protocol.pb.h"
 #include "yb/common/schema.h"
 
+#include "yb/docdb/doc_column_stats.h"
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_ql_filefilter.h"
 #include "yb/docdb/doc_scanspec_util.h"
@@ -73,6 +76,20 @@ DocPgsqlScanSpec::DocPgsqlScanSpec(const Schema& schema,
   upper_doc_key_.AppendKeyEntryTypeBeforeGroupEnd(KeyEntryType::kHighest);
 }
 
+DocPgsqlScanSpec::DocPgsqlScanSpec(const Schema& schema,
+                                   const rocksdb::QueryId query_id,
+                                   Slice encoded_doc_key)
+    : PgsqlScanSpec(nullptr),
+      schema_(schema),
+      query_id_(query_id),
+      hashed_components_(nullptr),
+      range_components_(nullptr),
+      lower_doc_key_(encoded_doc_key),
+      upper_doc_key_(encoded_doc_key),
+      is_forward_scan_(true) {
+  upper_doc_key_.AppendKeyEntryTypeBeforeGroupEnd(KeyEntryType::kHighest);
+}
+
 DocPgsqlScanSpec::DocPgsqlScanSpec(
     const Schema& schema,
     const rocksdb::QueryId query_id,
@@ -87,6 +104,7 @@ DocPgsqlScanSpec::DocPgsqlScanSpec(
     const DocKey& lower_doc_key,
     const DocKey& upper_doc_key)
     : PgsqlScanSpec(where_expr),
+      condition_(condition),
       range_bounds_(condition ? new QLScanRange(schema, *condition) : nullptr),
       schema_(schema),
       query_id_(query_id),
@@ -173,16 +191,33 @@ void DocPgsqlScanSpec::InitRangeOptions(const PgsqlConditionPB& condition) {
         DCHECK(condition.operands(1).value().has_list_value());
         const auto &options = condition.operands(1).value().list_value();
         int opt_size = options.elems_size();
-        (*range_options_)[col_idx - num_hash_cols].reserve(opt_size);
+        auto& col_options = (*range_options_)[col_idx - num_hash_cols];
+        col_options.reserve(opt_size);
 
-        // IN arguments should have been de-duplicated and ordered ascendingly by the executor.
+        // IN arguments are usually de-duplicated and ordered ascendingly by the executor, but
+        // batched nested loop join could send outer keys in arbitrary order. Scan choices seek
+        // through the options merge style, so they must be sorted in the scan order and disjoint.
         bool is_reverse_order = is_forward_scan_ ^ (sortingType == SortingType::kAscending ||
             sortingType == SortingType::kAscendingNullsLast);
+        bool sorted = true;
         for (int i = 0; i < opt_size; i++) {
           int elem_idx = is_reverse_order ? opt_size - i - 1 : i;
           const auto &elem = options.elems(elem_idx);
           auto pv = KeyEntryValue::FromQLValuePBForKey(elem, sortingType);
-          (*range_options_)[col_idx - num_hash_cols].push_back({pv});
+          if (sorted && !col_options.empty()) {
+            const auto& prev = col_options.back().front();
+            sorted = is_forward_scan_ ? prev < pv : pv < prev;
+          }
+          col_options.push_back({pv});
+        }
+        if (!sorted) {
+          if (is_forward_scan_) {
+            std::sort(col_options.begin(), col_options.end());
+          } else {
+            std::sort(col_options.begin(), col_options.end(), std::greater<>());
+          }
+          col_options.erase(
+              std::unique(col_options.begin(), col_options.end()), col_options.end());
         }
       }
 
@@ -295,6 +330,11 @@ std::shared_ptr<rocksdb::ReadFileFilter> DocPgsqlScanSpec::CreateFileFilter() co
   }
 }
 
+std::shared_ptr<rocksdb::TableStatsReadFileFilter>
+    DocPgsqlScanSpec::CreateTableStatsFileFilter() const {
+  return condition_ ? CreateColumnStatsFileFilter(schema_, *condition_) : nullptr;
+}
+
 Result<KeyBytes> DocPgsqlScanSpec::LowerBound() const {
   return Bound(true /* lower_bound */);
 }
@@ -39,6 +39,11 @@ class DocPgsqlScanSpec : public PgsqlScanSpec {
                    const DocKey& start_doc_key = DefaultStartDocKey(),
                    bool is_forward_scan = true);
 
+  // Scan for the specified encoded doc_key.
+  DocPgsqlScanSpec(const Schema& schema,
+                   const rocksdb::QueryId query_id,
+                   Slice encoded_doc_key);
+
   // Scan for the given hash key, a condition, and optional doc_key.
   //
   // Note: std::reference_wrapper is used instead of raw lvalue reference to prevent
@@ -71,6 +76,7 @@ class DocPgsqlScanSpec : public PgsqlScanSpec {
   //------------------------------------------------------------------------------------------------
   // Filters.
   std::shared_ptr<rocksdb::ReadFileFilter> CreateFileFilter() const;
+  std::shared_ptr<rocksdb::TableStatsReadFileFilter> CreateTableStatsFileFilter() const;
 
   // Return the inclusive lower and upper bounds of the scan.
   Result<KeyBytes> LowerBound() const;
@@ -108,6 +114,9 @@ class DocPgsqlScanSpec : public PgsqlScanSpec {
   // Returns the lower/upper doc key based on the range components.
   KeyBytes bound_key(const Schema& schema, const bool lower_bound) const;
 
+  // The condition is owned by the caller of DocPgsqlScanSpec.
+  const PgsqlConditionPB* condition_ = nullptr;
+
   // The scan range within the hash key when a WHERE condition is specified.
   const std::unique_ptr<const QLScanRange> range_bounds_;
 
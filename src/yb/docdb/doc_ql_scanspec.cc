@@ -17,6 +17,7 @@
 #include "yb/common/ql_value.h"
 #include "yb/common/schema.h"
 
+#include "yb/docdb/doc_column_stats.h"
 #include "yb/docdb/doc_expr.h"
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_ql_filefilter.h"
@@ -372,6 +373,11 @@ std::shared_ptr<rocksdb::ReadFileFilter> DocQLScanSpec::CreateFileFilter() const
   }
 }
 
+std::shared_ptr<rocksdb::TableStatsReadFileFilter>
+    DocQLScanSpec::CreateTableStatsFileFilter() const {
+  return condition_ ? CreateColumnStatsFileFilter(schema_, *condition_) : nullptr;
+}
+
 Result<KeyBytes> DocQLScanSpec::LowerBound() const {
   return Bound(true /* lower_bound */);
 }
@@ -62,6 +62,9 @@ class DocQLScanSpec : public QLScanSpec {
   // Create file filter based on range components.
   std::shared_ptr<rocksdb::ReadFileFilter> CreateFileFilter() const;
 
+  // Create file filter based on conditions on columns with statistics, see doc_column_stats.h.
+  std::shared_ptr<rocksdb::TableStatsReadFileFilter> CreateTableStatsFileFilter() const;
+
   // Gets the query id.
   const rocksdb::QueryId QueryId() const {
     return query_id_;
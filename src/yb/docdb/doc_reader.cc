@@ -27,6 +27,7 @@
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/row_cache.h"
 #include "yb/docdb/schema_packing.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
@@ -49,6 +50,9 @@ namespace {
 
 constexpr int64_t kNothingFound = -1;
 
+// Used in projection plan to mark liveness column, that is always present in packed row.
+constexpr int64_t kLivenessColumnIdx = -2;
+
 YB_STRONGLY_TYPED_BOOL(CheckExistOnly);
 
 // Shared information about packed row. I.e. common for all columns in this row.
@@ -169,10 +173,47 @@ DocDBTableReader::DocDBTableReader(
       << "Projection: " << AsString(projection_) << ", read time: " << iter_->read_time();
 }
 
+const std::vector<int64_t>& DocDBTableReader::PackedProjection(
+    const SchemaPacking& schema_packing) {
+  for (const auto& [packing, plan] : packed_projections_) {
+    if (packing == &schema_packing) {
+      return plan;
+    }
+  }
+  std::vector<int64_t> plan;
+  plan.reserve(projection_->size());
+  for (const auto& column : *projection_) {
+    if (!column.IsColumnId()) {
+      // Used in tests only.
+      plan.push_back(SchemaPacking::kNoColumnIdx);
+    } else if (column.GetColumnId() == KeyEntryValue::kLivenessColumn.GetColumnId()) {
+      plan.push_back(kLivenessColumnIdx);
+    } else {
+      plan.push_back(schema_packing.GetIndex(column.GetColumnId()));
+    }
+  }
+  VLOG_WITH_FUNC(4)
+      << "Projection plan for " << schema_packing.ToString() << ": " << AsString(plan);
+  packed_projections_.emplace_back(&schema_packing, std::move(plan));
+  return packed_projections_.back().second;
+}
+
 void DocDBTableReader::SetTableTtl(const Schema& table_schema) {
   table_expiration_ = Expiration(TableTTL(table_schema));
 }
 
+void DocDBTableReader::SetRowCache(RowCache* row_cache) {
+  // Empty projection is used to check row existence only, so it is not worth caching.
+  if (!projection_ || projection_->empty()) {
+    return;
+  }
+  row_cache_ = row_cache;
+  row_cache_projection_.clear();
+  for (const auto& column : encoded_projection_) {
+    row_cache_projection_.append(column.AsSlice().cdata(), column.size());
+  }
+}
+
 Status DocDBTableReader::UpdateTableTombstoneTime(const Slice& root_doc_key) {
   if (root_doc_key[0] == KeyEntryTypeAsChar::kColocationId ||
       root_doc_key[0] == KeyEntryTypeAsChar::kTableId) {
@@ -196,10 +237,20 @@ Status DocDBTableReader::UpdateTableTombstoneTime(const Slice& root_doc_key) {
                 "Invalid hybrid time for table tombstone");
       table_tombstone_time_ = doc_ht;
     }
+    // Range tombstones are stored right after the table tombstone, so it is just a short seek.
+    range_tombstones_.Clear();
+    RETURN_NOT_OK(LoadRangeTombstones(table_id_encoded, iter_, &range_tombstones_));
   }
   return Status::OK();
 }
 
+DocHybridTime DocDBTableReader::RowTombstoneTime(Slice root_doc_key) const {
+  if (range_tombstones_.empty() || IsTableDocKey(root_doc_key)) {
+    return table_tombstone_time_;
+  }
+  return std::max(table_tombstone_time_, range_tombstones_.MaxWriteTime(root_doc_key));
+}
+
 // Scan state entry. See state_ description below for details.
 struct StateEntry {
   KeyBytes key_entry; // Represents the part of the key that is related to this state entry.
@@ -245,8 +296,11 @@ class DocDBTableReader::GetHelper {
     RETURN_NOT_OK(Scan(CheckExistOnly::kFalse));
 
     if (last_found_ >= 0) {
+      MaybeAddToRowCache();
       return true;
     }
+    // Row from cache does not have live columns, check liveness of the row using regular path.
+    from_row_cache_ = false;
     if (has_root_value_) { // For tests only.
       if (IsCollectionType(result_.type())) {
         result_.object_container().clear();
@@ -280,7 +334,8 @@ class DocDBTableReader::GetHelper {
   // Iterator should already point to the first such entry.
   // Changes nearly all internal state fields.
   Status Scan(CheckExistOnly check_exist_only) {
-    while (reader_.iter_->valid()) {
+    // Row taken from row cache does not have other entries, so there is nothing to scan.
+    while (!from_row_cache_ && reader_.iter_->valid()) {
       if (reader_.deadline_info_.CheckAndSetDeadlinePassed()) {
         return STATUS(Expired, "Deadline for query passed");
       }
@@ -307,6 +362,7 @@ class DocDBTableReader::GetHelper {
         << key_result.write_time << ", value: " << reader_.iter_->value().ToDebugHexString();
     DCHECK(key_result.key.starts_with(root_doc_key_));
     auto subkeys = key_result.key.WithoutPrefix(root_doc_key_.size());
+    has_column_entries_ = has_column_entries_ || !subkeys.empty();
 
     return DoHandleRecord(key_result, subkeys, check_exist_only);
   }
@@ -477,30 +533,48 @@ class DocDBTableReader::GetHelper {
   // Before calling, all fields should have correct values, especially column_index_ that points
   // to the current column in projection.
   void UpdatePackedColumnData() {
-    auto& column = (*reader_.projection_)[column_index_];
-    if (column.IsColumnId()) {
-      packed_column_data_ = GetPackedColumn(column.GetColumnId());
-    } else {
-      // Used in tests only.
+    if (!packed_projection_) {
       packed_column_data_.row = nullptr;
+      return;
     }
+    packed_column_data_ = GetPackedColumnByIndex((*packed_projection_)[column_index_]);
   }
 
   Status Prepare() {
     VLOG_WITH_PREFIX_AND_FUNC(4) << "Pos: " << reader_.iter_->DebugPosToString();
 
+    const auto row_tombstone_time = reader_.RowTombstoneTime(root_doc_key_);
+    DocHybridTime doc_ht = row_tombstone_time;
+    if (reader_.row_cache_) {
+      if (reader_.row_cache_->Get(
+              root_doc_key_, reader_.row_cache_projection_, reader_.iter_->read_time().read,
+              &doc_ht, &row_cache_value_)) {
+        VLOG_WITH_PREFIX_AND_FUNC(4) << "Found in row cache, write time: " << doc_ht;
+        from_row_cache_ = true;
+        return PrepareRoot(doc_ht, row_cache_value_.AsSlice());
+      }
+      row_cache_token_ = reader_.row_cache_->PrepareRead();
+    }
+
     state_.front().key_entry.AppendRawBytes(root_doc_key_);
     reader_.iter_->SeekForward(&state_.front().key_entry);
 
     Slice value;
-    DocHybridTime doc_ht = reader_.table_tombstone_time_;
     RETURN_NOT_OK(reader_.iter_->FindLatestRecord(root_doc_key_, &doc_ht, &value));
 
-    auto& root = state_.front();
     if (!reader_.iter_->valid()) {
-      root.write_time = reader_.table_tombstone_time_;
+      state_.front().write_time = row_tombstone_time;
       return Status::OK();
     }
+    if (reader_.row_cache_) {
+      row_cache_value_.Assign(value);
+    }
+    return PrepareRoot(doc_ht, value);
+  }
+
+  // Fills root state entry and packed row info using the latest record of the row itself.
+  Status PrepareRoot(const DocHybridTime& doc_ht, Slice value) {
+    auto& root = state_.front();
     auto control_fields = VERIFY_RESULT(ValueControlFields::Decode(&value));
 
     auto value_type = DecodeValueEntryType(value);
@@ -510,6 +584,9 @@ class DocDBTableReader::GetHelper {
       packed_row_.Assign(value);
       packed_row_data_.doc_ht = doc_ht;
       packed_row_data_.control_fields = control_fields;
+      if (reader_.projection_) {
+        packed_projection_ = &reader_.PackedProjection(*schema_packing_);
+      }
       auto& expiration = root.expiration;
       expiration = GetNewExpiration(expiration, control_fields.ttl, doc_ht);
     } else if (value_type != ValueEntryType::kTombstone && value_type != ValueEntryType::kInvalid) {
@@ -528,6 +605,16 @@ class DocDBTableReader::GetHelper {
     return Status::OK();
   }
 
+  // Row could be cached only when it consists of the packed row entry only.
+  void MaybeAddToRowCache() {
+    if (!reader_.row_cache_ || from_row_cache_ || !schema_packing_ || has_column_entries_) {
+      return;
+    }
+    reader_.row_cache_->Insert(
+        row_cache_token_, reader_.iter_->read_time().read, root_doc_key_,
+        reader_.row_cache_projection_, packed_row_data_.doc_ht, row_cache_value_.AsSlice());
+  }
+
   PackedColumnData GetPackedColumn(ColumnId column_id) {
     if (!schema_packing_) {
       // Actual for tests only.
@@ -535,6 +622,16 @@ class DocDBTableReader::GetHelper {
     }
 
     if (column_id == KeyEntryValue::kLivenessColumn.GetColumnId()) {
+      return GetPackedColumnByIndex(kLivenessColumnIdx);
+    }
+
+    return GetPackedColumnByIndex(schema_packing_->GetIndex(column_id));
+  }
+
+  // Returns packed data for column with specified index in schema packing.
+  // packed_idx could also be kNoColumnIdx or kLivenessColumnIdx.
+  PackedColumnData GetPackedColumnByIndex(int64_t packed_idx) {
+    if (packed_idx == kLivenessColumnIdx) {
       VLOG_WITH_PREFIX_AND_FUNC(4) << "Packed row for liveness column";
       return PackedColumnData {
         .row = &packed_row_data_,
@@ -542,16 +639,18 @@ class DocDBTableReader::GetHelper {
       };
     }
 
-    auto slice = schema_packing_->GetValue(column_id, packed_row_.AsSlice());
-    if (!slice) {
-      VLOG_WITH_PREFIX_AND_FUNC(4) << "No packed row data for " << column_id;
+    if (packed_idx == SchemaPacking::kNoColumnIdx) {
+      VLOG_WITH_PREFIX_AND_FUNC(4) << "No packed row data for column " << column_index_;
       return PackedColumnData();
     }
 
-    VLOG_WITH_PREFIX_AND_FUNC(4) << "Packed row " << column_id << ": " << slice->ToDebugHexString();
+    auto slice = schema_packing_->GetValue(packed_idx, packed_row_.AsSlice());
+    VLOG_WITH_PREFIX_AND_FUNC(4)
+        << "Packed row " << schema_packing_->column_packing_data(packed_idx).id << ": "
+        << slice.ToDebugHexString();
     return PackedColumnData {
       .row = &packed_row_data_,
-      .encoded_value = slice->empty() ? NullSlice() : *slice,
+      .encoded_value = slice.empty() ? NullSlice() : slice,
     };
   }
 
@@ -592,6 +691,17 @@ class DocDBTableReader::GetHelper {
   ValueBuffer packed_row_;
   PackedRowData packed_row_data_;
   const SchemaPacking* schema_packing_ = nullptr;
+  // Indexes of projection columns in schema_packing_, owned by reader.
+  const std::vector<int64_t>* packed_projection_ = nullptr;
+
+  // Row cache related fields.
+  // Whether the row was taken from row cache, so iterator should not be used to scan it.
+  bool from_row_cache_ = false;
+  // Whether entries for row columns were found, so the row could not be cached.
+  bool has_column_entries_ = false;
+  // Value of the latest row record, i.e. packed row.
+  ValueBuffer row_cache_value_;
+  RowCache::ReadToken row_cache_token_;
 
   // Scanning stack.
   // I.e. the first entry is related to whole document (i.e. row).
@@ -16,6 +16,8 @@
 #include <string>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include "yb/docdb/docdb_fwd.h"
 #include "yb/rocksdb/cache.h"
 
@@ -27,6 +29,7 @@
 #include "yb/docdb/deadline_info.h"
 #include "yb/docdb/docdb_types.h"
 #include "yb/docdb/expiration.h"
+#include "yb/docdb/range_tombstones.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
 
@@ -79,8 +82,9 @@ class DocDBTableReader {
       TableType table_type,
       std::reference_wrapper<const SchemaPackingStorage> schema_packing_storage);
 
-  // Updates expiration/overwrite data based on table tombstone time. If the table is not a
-  // colocated table as indicated by the provided root_doc_key, this method is a no-op.
+  // Updates expiration/overwrite data based on table tombstone time and range tombstones of the
+  // table. If the table is not a colocated table as indicated by the provided root_doc_key, this
+  // method is a no-op.
   Status UpdateTableTombstoneTime(const Slice& root_doc_key);
 
   // Determine based on the provided schema if there is a table-level TTL and use the computed value
@@ -88,6 +92,10 @@ class DocDBTableReader {
   // subsequently read SubDocuments.
   void SetTableTtl(const Schema& table_schema);
 
+  // Use specified row cache for rows read by this reader. Should be used only when reader does not
+  // have to take intents into account, i.e. for non transactional tables.
+  void SetRowCache(RowCache* row_cache);
+
   // Read value (i.e. row), identified by root_doc_key to result.
   // Returns true if value was found, false otherwise.
   Result<bool> Get(const Slice& root_doc_key, SubDocument* result);
@@ -97,6 +105,15 @@ class DocDBTableReader {
   // at that row.
   Status InitForKey(const Slice& sub_doc_key);
 
+  // Returns time of the latest table or range tombstone, that deletes the row with specified
+  // doc key.
+  DocHybridTime RowTombstoneTime(Slice root_doc_key) const;
+
+  // Returns indexes of projection columns in the specified schema packing.
+  // Indexes are resolved once per packing and then reused for all rows read by this reader,
+  // so the per-row cost of extracting a projected column from the packed row is O(1).
+  const std::vector<int64_t>& PackedProjection(const SchemaPacking& schema_packing);
+
   class GetHelper;
 
   // Owned by caller.
@@ -107,7 +124,18 @@ class DocDBTableReader {
   const SchemaPackingStorage& schema_packing_storage_;
 
   std::vector<KeyBytes> encoded_projection_;
+
+  RowCache* row_cache_ = nullptr;
+  // Concatenated encoded_projection_, used to check that cached row was read with the same
+  // projection.
+  std::string row_cache_projection_;
+
+  // Projection plans for schema packings met during scan. Usually there is only one packing,
+  // so linear search is used.
+  boost::container::small_vector<std::pair<const SchemaPacking*, std::vector<int64_t>>, 2>
+      packed_projections_;
   DocHybridTime table_tombstone_time_ = DocHybridTime::kMin;
+  RangeTombstones range_tombstones_;
   Expiration table_expiration_;
 };
 
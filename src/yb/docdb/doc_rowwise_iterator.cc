@@ -28,6 +28,7 @@
 #include "yb/common/read_hybrid_time.h"
 #include "yb/common/transaction.h"
 
+#include "yb/docdb/colocated_tables_stats.h"
 #include "yb/docdb/docdb_fwd.h"
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_path.h"
@@ -166,10 +167,23 @@ Status DocRowwiseIterator::DoInit(const T& doc_spec) {
       VERIFY_RESULT(HashedOrFirstRangeComponentsEqual(lower_doc_key, upper_doc_key));
   const auto mode = is_fixed_point_get ? BloomFilterMode::USE_BLOOM_FILTER
                                        : BloomFilterMode::DONT_USE_BLOOM_FILTER;
+  // Bloom filter could take into account several range components, so use only components that
+  // are fixed by the scan.
+  Slice user_key_for_filter = lower_doc_key.AsSlice();
+  if (is_fixed_point_get) {
+    user_key_for_filter = user_key_for_filter.Prefix(
+        VERIFY_RESULT(EqualDocKeyComponentsPrefixSize(lower_doc_key, upper_doc_key)));
+  }
+  // Scans would just evict hot rows from the cache, so use it only for point reads.
+  row_cache_ = is_fixed_point_get && !txn_op_context_ ? doc_db_.row_cache : nullptr;
 
+  // Files of colocated tablet that don't contain the scanned table are skipped, so a scan of a
+  // small table does not pay for large tables colocated with it.
+  auto colocated_table_prefix = ColocatedTablePrefix(doc_read_context_.schema);
   db_iter_ = CreateIntentAwareIterator(
-      doc_db_, mode, lower_doc_key.AsSlice(), doc_spec.QueryId(), txn_op_context_,
-      deadline_, read_time_, doc_spec.CreateFileFilter());
+      doc_db_, mode, user_key_for_filter, doc_spec.QueryId(), txn_op_context_,
+      deadline_, read_time_, doc_spec.CreateFileFilter(), nullptr /* iterate_upper_bound */,
+      doc_spec.CreateTableStatsFileFilter(), colocated_table_prefix.AsSlice());
 
   row_ready_ = false;
 
@@ -328,6 +342,9 @@ Result<bool> DocRowwiseIterator::HasNext() {
       if (!ignore_ttl_) {
         doc_reader_->SetTableTtl(doc_read_context_.schema);
       }
+      if (row_cache_) {
+        doc_reader_->SetRowCache(row_cache_);
+      }
     }
 
     DCHECK(row_.type() == ValueEntryType::kObject);
@@ -451,6 +468,19 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
   return Status::OK();
 }
 
+Result<size_t> DocRowwiseIterator::DoNextRowBatch(
+    const Schema& projection, std::vector<QLTableRow>* rows) {
+  size_t num_rows = 0;
+  // Qualified calls are used to avoid virtual dispatch per row.
+  while (num_rows != rows->size() && VERIFY_RESULT(DocRowwiseIterator::HasNext())) {
+    auto& row = (*rows)[num_rows];
+    row.Clear();
+    RETURN_NOT_OK(DocRowwiseIterator::DoNextRow(projection, &row));
+    ++num_rows;
+  }
+  return num_rows;
+}
+
 bool DocRowwiseIterator::LivenessColumnExists() const {
   const SubDocument* subdoc = row_.GetChild(KeyEntryValue::kLivenessColumn);
   return subdoc != nullptr && subdoc->value_type() != ValueEntryType::kInvalid;
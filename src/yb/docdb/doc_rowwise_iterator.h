@@ -136,6 +136,9 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
   // Read next row into a value map using the specified projection.
   Status DoNextRow(const Schema& projection, QLTableRow* table_row) override;
 
+  Result<size_t> DoNextRowBatch(
+      const Schema& projection, std::vector<QLTableRow>* rows) override;
+
   const Schema& projection_;
   // Used to maintain ownership of projection_.
   // Separate field is used since ownership could be optional.
@@ -197,6 +200,9 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
 
   std::unique_ptr<DocDBTableReader> doc_reader_ = nullptr;
 
+  // Row cache used by doc_reader_, set only for point reads of non transactional tables.
+  RowCache* row_cache_ = nullptr;
+
   TableType table_type_;
   bool ignore_ttl_ = false;
 
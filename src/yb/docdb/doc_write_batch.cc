@@ -23,6 +23,7 @@
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/kv_debug.h"
+#include "yb/docdb/primitive_value.h"
 #include "yb/docdb/schema_packing.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value_type.h"
@@ -77,10 +78,13 @@ struct DocWriteBatch::LazyIterator {
 
 DocWriteBatch::DocWriteBatch(const DocDB& doc_db,
                              InitMarkerBehavior init_marker_behavior,
-                             std::atomic<int64_t>* monotonic_counter)
+                             std::atomic<int64_t>* monotonic_counter,
+                             Arena* arena)
     : doc_db_(doc_db),
       init_marker_behavior_(init_marker_behavior),
-      monotonic_counter_(monotonic_counter) {}
+      monotonic_counter_(monotonic_counter),
+      own_arena_(arena ? nullptr : std::make_unique<Arena>()),
+      arena_(arena ? arena : own_arena_.get()) {}
 
 Status DocWriteBatch::SeekToKeyPrefix(LazyIterator* iter, HasAncestor has_ancestor) {
   subdoc_exists_ = false;
@@ -237,7 +241,7 @@ Status DocWriteBatch::SetPrimitiveInternal(
     LazyIterator* iter,
     const bool is_deletion,
     std::optional<IntraTxnWriteId> write_id) {
-  UpdateMaxValueTtl(control_fields.ttl);
+  UpdateMaxValueTtl(control_fields.ttl, is_deletion);
 
   // The write_id is always incremented by one for each new element of the write batch.
   if (put_batch_.size() > numeric_limits<IntraTxnWriteId>::max()) {
@@ -346,8 +350,8 @@ Status DocWriteBatch::SetPrimitiveInternal(
       // (We replicate key/value pairs without the HybridTime and only add it before writing to
       // RocksDB.)
       put_batch_.push_back({
-        .key = key_prefix_.ToStringBuffer(),
-        .value = std::string(1, ValueEntryTypeAsChar::kObject),
+        .key = arena_->DupSlice(key_prefix_.AsSlice()),
+        .value = arena_->DupSlice(Slice(&ValueEntryTypeAsChar::kObject, 1)),
       });
 
       // Update our local cache to record the fact that we're adding this subdocument, so that
@@ -362,16 +366,13 @@ Status DocWriteBatch::SetPrimitiveInternal(
     // The key in the key/value batch does not have an encoded HybridTime.
     DocWriteBatchEntry* kv_pair_ptr;
     if (write_id) {
-      put_batch_[*write_id].key = key_prefix_.ToStringBuffer();
       kv_pair_ptr = &put_batch_[*write_id];
     } else {
-      put_batch_.push_back({
-        .key = key_prefix_.ToStringBuffer(),
-        .value = std::string(),
-      });
-      kv_pair_ptr = &put_batch_.back();
+      kv_pair_ptr = &put_batch_.emplace_back();
     }
-    auto& encoded_value = kv_pair_ptr->value;
+    kv_pair_ptr->key = arena_->DupSlice(key_prefix_.AsSlice());
+    auto& encoded_value = value_buffer_;
+    encoded_value.clear();
     control_fields.AppendEncoded(&encoded_value);
     size_t prefix_len = encoded_value.size();
 
@@ -388,6 +389,7 @@ Status DocWriteBatch::SetPrimitiveInternal(
     // the key we expect to look up.
     cache_.Put(key_prefix_, hybrid_time, static_cast<ValueEntryType>(encoded_value[prefix_len]),
                control_fields.timestamp);
+    kv_pair_ptr->value = arena_->DupSlice(encoded_value);
   }
 
   return Status::OK();
@@ -676,26 +678,32 @@ Status DocWriteBatch::ReplaceRedisInList(
   }
 }
 
-void DocWriteBatch::UpdateMaxValueTtl(const MonoDelta& ttl) {
+void DocWriteBatch::UpdateMaxValueTtl(const MonoDelta& ttl, bool is_deletion) {
   // Don't update the max value TTL if the value is uninitialized or if it is set to
   // kMaxTtl (i.e. use table TTL).
   if (!ttl.Initialized() || ttl.Equals(ValueControlFields::kMaxTtl)) {
+    // Tombstones don't have to be kept after the data they delete has expired.
+    if (!is_deletion) {
+      has_value_with_default_ttl_ = true;
+    }
+    return;
+  }
+  // kResetTtl means that the value never expires, so it dominates any other TTL.
+  if (ttl_.Initialized() && ttl_.Equals(ValueControlFields::kResetTtl)) {
     return;
   }
-  if (!ttl_.Initialized() || ttl > ttl_) {
+  if (!ttl_.Initialized() || ttl.Equals(ValueControlFields::kResetTtl) || ttl > ttl_) {
     ttl_ = ttl;
   }
 }
 
-Status DocWriteBatch::ReplaceCqlInList(
+Result<bool> DocWriteBatch::ForEachCqlListElement(
     const DocPath& doc_path,
-    const int target_cql_index,
-    const ValueRef& value,
     const ReadHybridTime& read_ht,
     const CoarseTimePoint deadline,
     const rocksdb::QueryId query_id,
     MonoDelta default_ttl,
-    MonoDelta write_ttl) {
+    const CqlListElementCallback& callback) {
   SubDocKey sub_doc_key;
   RETURN_NOT_OK(sub_doc_key.FromDocPath(doc_path));
   key_prefix_ = sub_doc_key.Encode();
@@ -712,7 +720,7 @@ Status DocWriteBatch::ReplaceCqlInList(
   RETURN_NOT_OK(SeekToKeyPrefix(iter.get(), HasAncestor::kFalse));
 
   if (!iter->valid()) {
-    return STATUS(QLError, "Unable to replace items in empty list.");
+    return false;
   }
 
   auto current_key = VERIFY_RESULT(iter->FetchKey());
@@ -729,23 +737,14 @@ Status DocWriteBatch::ReplaceCqlInList(
 
   Slice value_slice;
   SubDocKey found_key;
-  int current_cql_index = 0;
 
   // Seek past init marker if it exists.
   key_prefix_.AppendKeyEntryType(KeyEntryType::kArrayIndex);
   RETURN_NOT_OK(SeekToKeyPrefix(iter.get(), HasAncestor::kFalse));
 
   FetchKeyResult key_data;
-  while (true) {
-    if (target_cql_index < 0 || !iter->valid() ||
-        !(key_data = VERIFY_RESULT(iter->FetchKey())).key.starts_with(key_prefix_)) {
-      return STATUS_SUBSTITUTE(
-          QLError,
-          "Unable to replace items into list, expecting index $0, reached end of list with size $1",
-          target_cql_index,
-          current_cql_index);
-    }
-
+  while (iter->valid() &&
+         (key_data = VERIFY_RESULT(iter->FetchKey())).key.starts_with(key_prefix_)) {
     RETURN_NOT_OK(found_key.FullyDecodeFrom(key_data.key, HybridTimeRequired::kFalse));
 
     value_slice = iter->value();
@@ -760,25 +759,100 @@ Status DocWriteBatch::ReplaceCqlInList(
       has_expired = HasExpiredTTL(key_data.write_time.hybrid_time(), entry_ttl, read_ht.read);
     }
 
-    if (has_expired) {
-      found_key.KeepPrefix(sub_doc_key.num_subkeys() + 1);
-      iter->SeekPastSubKey(key_data.key);
-      continue;
-    }
-
     // Should we verify that the subkeys are indeed numbers as list indices should be?
     // Or just go in order for the index'th largest key in any subdocument?
-    if (current_cql_index == target_cql_index) {
-      // When inserting, key_prefix_ is modified.
-      KeyBytes array_index_prefix(key_prefix_);
-      DocPath child_doc_path = doc_path;
-      child_doc_path.AddSubKey(found_key.subkeys()[sub_doc_key.num_subkeys()]);
-      return InsertSubDocument(child_doc_path, value, read_ht, deadline, query_id, write_ttl);
+    if (!has_expired &&
+        !VERIFY_RESULT(callback(found_key.subkeys()[sub_doc_key.num_subkeys()], value_slice))) {
+      break;
     }
 
-    current_cql_index++;
     iter->SeekPastSubKey(key_data.key);
   }
+  return true;
+}
+
+Status DocWriteBatch::ReplaceCqlInList(
+    const DocPath& doc_path,
+    const int target_cql_index,
+    const ValueRef& value,
+    const ReadHybridTime& read_ht,
+    const CoarseTimePoint deadline,
+    const rocksdb::QueryId query_id,
+    MonoDelta default_ttl,
+    MonoDelta write_ttl) {
+  std::optional<KeyEntryValue> found_index;
+  int current_cql_index = 0;
+  auto list_found = VERIFY_RESULT(ForEachCqlListElement(
+      doc_path, read_ht, deadline, query_id, default_ttl,
+      [target_cql_index, &current_cql_index, &found_index](
+          const KeyEntryValue& index, Slice) -> Result<bool> {
+        if (target_cql_index < 0) {
+          return false;
+        }
+        if (current_cql_index == target_cql_index) {
+          found_index = index;
+          return false;
+        }
+        ++current_cql_index;
+        return true;
+      }));
+
+  if (!list_found) {
+    return STATUS(QLError, "Unable to replace items in empty list.");
+  }
+
+  if (!found_index) {
+    return STATUS_SUBSTITUTE(
+        QLError,
+        "Unable to replace items into list, expecting index $0, reached end of list with size $1",
+        target_cql_index,
+        current_cql_index);
+  }
+
+  DocPath child_doc_path = doc_path;
+  child_doc_path.AddSubKey(std::move(*found_index));
+  return InsertSubDocument(child_doc_path, value, read_ht, deadline, query_id, write_ttl);
+}
+
+Status DocWriteBatch::RemoveFromCqlList(
+    const DocPath& doc_path,
+    const QLValuePB& values,
+    const ReadHybridTime& read_ht,
+    const CoarseTimePoint deadline,
+    const rocksdb::QueryId query_id,
+    MonoDelta default_ttl) {
+  if (values.value_case() != QLValuePB::kListValue || values.list_value().elems().empty()) {
+    return Status::OK();
+  }
+
+  // List elements are written with the same encoding, so values are compared in encoded form,
+  // without decoding the elements of the list.
+  std::vector<std::string> encoded_values;
+  encoded_values.reserve(values.list_value().elems().size());
+  for (const auto& elem : values.list_value().elems()) {
+    AppendEncodedValue(elem, &encoded_values.emplace_back());
+  }
+
+  std::vector<KeyEntryValue> removed_indexes;
+  RETURN_NOT_OK(ForEachCqlListElement(
+      doc_path, read_ht, deadline, query_id, default_ttl,
+      [&encoded_values, &removed_indexes](
+          const KeyEntryValue& index, Slice value) -> Result<bool> {
+        for (const auto& encoded_value : encoded_values) {
+          if (value == encoded_value) {
+            removed_indexes.push_back(index);
+            break;
+          }
+        }
+        return true;
+      }));
+
+  for (auto& index : removed_indexes) {
+    DocPath child_doc_path = doc_path;
+    child_doc_path.AddSubKey(std::move(index));
+    RETURN_NOT_OK(DeleteSubDoc(child_doc_path, read_ht, deadline, query_id));
+  }
+  return Status::OK();
 }
 
 Status DocWriteBatch::DeleteSubDoc(
@@ -794,18 +868,31 @@ Status DocWriteBatch::DeleteSubDoc(
 void DocWriteBatch::Clear() {
   put_batch_.clear();
   cache_.Clear();
+  if (own_arena_) {
+    own_arena_->Reset(ResetMode::kKeepLast);
+  }
 }
 
-// TODO(lw_uc) allocate entries on the same arena, then just reference them.
 void DocWriteBatch::MoveToWriteBatchPB(LWKeyValueWriteBatchPB *kv_pb) {
+  // Entries allocated on the arena of kv_pb are referenced, so their keys and values are copied
+  // only once, when they are encoded.
+  const bool same_arena = &kv_pb->arena() == arena_;
   for (auto& entry : put_batch_) {
     auto* kv_pair = kv_pb->add_write_pairs();
-    kv_pair->dup_key(entry.key);
-    kv_pair->dup_value(entry.value);
+    if (same_arena) {
+      kv_pair->ref_key(entry.key);
+      kv_pair->ref_value(entry.value);
+    } else {
+      kv_pair->dup_key(entry.key);
+      kv_pair->dup_value(entry.value);
+    }
   }
   if (has_ttl()) {
     kv_pb->set_ttl(ttl_ns());
   }
+  if (has_value_with_default_ttl_) {
+    kv_pb->set_has_value_with_default_ttl(true);
+  }
 }
 
 void DocWriteBatch::TEST_CopyToWriteBatchPB(LWKeyValueWriteBatchPB *kv_pb) const {
@@ -817,6 +904,9 @@ void DocWriteBatch::TEST_CopyToWriteBatchPB(LWKeyValueWriteBatchPB *kv_pb) const
   if (has_ttl()) {
     kv_pb->set_ttl(ttl_ns());
   }
+  if (has_value_with_default_ttl_) {
+    kv_pb->set_has_value_with_default_ttl(true);
+  }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -13,6 +13,9 @@
 
 #pragma once
 
+#include <functional>
+#include <optional>
+
 #include "yb/bfql/tserver_opcodes.h"
 
 #include "yb/common/constants.h"
@@ -30,6 +33,7 @@
 #include "yb/rocksutil/write_batch_formatter.h"
 
 #include "yb/util/enums.h"
+#include "yb/util/memory/arena.h"
 #include "yb/util/monotime.h"
 
 namespace yb {
@@ -143,9 +147,10 @@ YB_DEFINE_ENUM(InitMarkerBehavior,
 YB_STRONGLY_TYPED_BOOL(HasAncestor);
 
 // We store key/value as string to be able to move them to KeyValuePairPB later.
+// Key and value are allocated on the arena of DocWriteBatch.
 struct DocWriteBatchEntry {
-  std::string key;
-  std::string value;
+  Slice key;
+  Slice value;
 };
 
 // The DocWriteBatch class is used to build a RocksDB write batch for a DocDB batch of operations
@@ -155,9 +160,13 @@ struct DocWriteBatchEntry {
 // Take ownership of it using std::move if it needs to live longer than this DocWriteBatch.
 class DocWriteBatch {
  public:
+  // If arena is specified, keys and values are allocated on it, otherwise DocWriteBatch owns its
+  // arena. Passing the arena of the LWKeyValueWriteBatchPB, that the batch will be moved to, lets
+  // MoveToWriteBatchPB reference entries instead of copying them.
   explicit DocWriteBatch(const DocDB& doc_db,
                          InitMarkerBehavior init_marker_behavior,
-                         std::atomic<int64_t>* monotonic_counter = nullptr);
+                         std::atomic<int64_t>* monotonic_counter = nullptr,
+                         Arena* arena = nullptr);
 
   // Custom write_id could specified. Such write_id should be previously allocated with
   // ReserveWriteId. In this case the value will be put to batch into preallocated position.
@@ -244,6 +253,17 @@ class DocWriteBatch {
       MonoDelta default_ttl = ValueControlFields::kMaxTtl,
       MonoDelta write_ttl = ValueControlFields::kMaxTtl);
 
+  // Removes the elements of the list at doc_path, that are equal to any element of values list.
+  // Only the removed elements are overwritten with tombstones, so the rest of the list keeps its
+  // indexes and TTLs, and the list is not rewritten as a whole.
+  Status RemoveFromCqlList(
+      const DocPath& doc_path,
+      const QLValuePB& values,
+      const ReadHybridTime& read_ht,
+      const CoarseTimePoint deadline,
+      const rocksdb::QueryId query_id,
+      MonoDelta default_ttl = ValueControlFields::kMaxTtl);
+
   Status DeleteSubDoc(
       const DocPath& doc_path,
       const ReadHybridTime& read_ht = ReadHybridTime::Max(),
@@ -276,12 +296,16 @@ class DocWriteBatch {
     return cache_.Get(encoded_key_prefix);
   }
 
-  DocWriteBatchEntry& AddRaw() {
-    put_batch_.emplace_back();
-    return put_batch_.back();
+  void AddRaw(Slice key, Slice value) {
+    // TTL of raw values is unknown, so they are considered to use the table default TTL.
+    has_value_with_default_ttl_ = true;
+    put_batch_.push_back({
+      .key = arena_->DupSlice(key),
+      .value = arena_->DupSlice(value),
+    });
   }
 
-  void UpdateMaxValueTtl(const MonoDelta& ttl);
+  void UpdateMaxValueTtl(const MonoDelta& ttl, bool is_deletion = false);
 
   int64_t ttl_ns() const {
     return ttl_.ToNanoseconds();
@@ -291,6 +315,10 @@ class DocWriteBatch {
     return ttl_.Initialized();
   }
 
+  bool has_value_with_default_ttl() const {
+    return has_value_with_default_ttl_;
+  }
+
   // See SetPrimitive above.
   IntraTxnWriteId ReserveWriteId() {
     put_batch_.emplace_back();
@@ -312,6 +340,20 @@ class DocWriteBatch {
   Status SeekToKeyPrefix(LazyIterator* doc_iter, HasAncestor has_ancestor);
   Status SeekToKeyPrefix(IntentAwareIterator* doc_iter, HasAncestor has_ancestor);
 
+  // Invoked with the array index subkey and the encoded value of a list element.
+  // Returns false to stop the iteration.
+  using CqlListElementCallback = std::function<Result<bool>(const KeyEntryValue&, Slice)>;
+
+  // Invokes callback for live elements of the list at doc_path, in the list order.
+  // Returns false if nothing was found at doc_path.
+  Result<bool> ForEachCqlListElement(
+      const DocPath& doc_path,
+      const ReadHybridTime& read_ht,
+      const CoarseTimePoint deadline,
+      const rocksdb::QueryId query_id,
+      MonoDelta default_ttl,
+      const CqlListElementCallback& callback);
+
   // This member function performs the necessary operations to set a primitive value for a given
   // docpath assuming the appropriate operations have been taken care of for subkeys with index <
   // subkey_index. This method assumes responsibility of ensuring the proper DocDB structure
@@ -342,7 +384,11 @@ class DocWriteBatch {
 
   InitMarkerBehavior init_marker_behavior_;
   std::atomic<int64_t>* monotonic_counter_;
+  std::unique_ptr<Arena> own_arena_;
+  Arena* arena_;
   std::vector<DocWriteBatchEntry> put_batch_;
+  // Buffer used to encode values before they are copied to the arena, reused between values.
+  std::string value_buffer_;
 
   // Taken from internal_doc_iterator
   KeyBytes key_prefix_;
@@ -350,6 +396,7 @@ class DocWriteBatch {
   DocWriteBatchCache::Entry current_entry_;
 
   MonoDelta ttl_;
+  bool has_value_with_default_ttl_ = false;
 };
 
 // Converts a RocksDB WriteBatch to a string.
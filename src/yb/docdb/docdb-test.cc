@@ -770,6 +770,30 @@ SubDocKey(DocKey([], ["mydockey", 123456]), ["subkey1"; HT{ physical: 3000 }]) -
       )#");
 }
 
+TEST_P(DocDBTestWrapper, HistoryGCOnFlush) {
+  regular_db_options_.flush_compaction_context_factory =
+      regular_db_options_.compaction_context_factory;
+  ASSERT_OK(ReopenRocksDB());
+
+  const DocKey doc_key(KeyEntryValues("mydockey", kIntKey1));
+  KeyBytes encoded_doc_key(doc_key.Encode());
+  for (int i = 1; i <= 3; ++i) {
+    ASSERT_OK(SetPrimitive(
+        DocPath(encoded_doc_key, KeyEntryValue("subkey1")),
+        QLValue::Primitive(Format("value$0", i)),
+        HybridTime::FromMicros(1000 * i)));
+  }
+  SetHistoryCutoffHybridTime(2500_usec_ht);
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  // Versions overwritten before the history cutoff are not flushed.
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(
+      R"#(
+SubDocKey(DocKey([], ["mydockey", 123456]), ["subkey1"; HT{ physical: 3000 }]) -> "value3"
+SubDocKey(DocKey([], ["mydockey", 123456]), ["subkey1"; HT{ physical: 2000 }]) -> "value2"
+      )#");
+}
+
 TEST_P(DocDBTestWrapper, SetPrimitiveQL) {
   const DocKey doc_key(KeyEntryValues("mydockey", kIntKey1));
   SetupRocksDBState(doc_key.Encode());
@@ -1121,6 +1145,47 @@ SubDocKey(DocKey([], ["list_test", 231]), ["list", ArrayIndex(5); \
     }
   }
         )#");
+
+  // Only the live element is removed, overwritten value 3 does not match, and the rest of the list
+  // is not rewritten.
+  ASSERT_OK(RemoveFromList(
+      DocPath(encoded_doc_key, KeyEntryValue("list")), QLValue::PrimitiveArray(3, 6),
+      ReadHybridTime::SingleTime(HybridTime(550)), HybridTime(600)));
+  VerifyDocument(doc_key, HybridTime(600),
+      R"#(
+  {
+    "list": {
+      ArrayIndex(2): 17,
+      ArrayIndex(3): 8
+    }
+  }
+        )#");
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(
+      R"#(
+SubDocKey(DocKey([], ["list_test", 231]), [HT{ physical: 0 logical: 100 }]) -> {}
+SubDocKey(DocKey([], ["list_test", 231]), ["list"; HT{ physical: 0 logical: 300 }]) -> {}
+SubDocKey(DocKey([], ["list_test", 231]), ["list"; HT{ physical: 0 logical: 200 }]) -> {}
+SubDocKey(DocKey([], ["list_test", 231]), ["list", ArrayIndex(1); \
+    HT{ physical: 0 logical: 600 }]) -> DEL
+SubDocKey(DocKey([], ["list_test", 231]), ["list", ArrayIndex(1); \
+    HT{ physical: 0 logical: 300 w: 1 }]) -> 6
+SubDocKey(DocKey([], ["list_test", 231]), ["list", ArrayIndex(1); \
+    HT{ physical: 0 logical: 200 w: 1 }]) -> 1
+SubDocKey(DocKey([], ["list_test", 231]), ["list", ArrayIndex(2); \
+    HT{ physical: 0 logical: 500 }]) -> 17
+SubDocKey(DocKey([], ["list_test", 231]), ["list", ArrayIndex(2); \
+    HT{ physical: 0 logical: 300 w: 2 }]) -> 7
+SubDocKey(DocKey([], ["list_test", 231]), ["list", ArrayIndex(2); \
+    HT{ physical: 0 logical: 200 w: 2 }]) -> 2
+SubDocKey(DocKey([], ["list_test", 231]), ["list", ArrayIndex(3); \
+    HT{ physical: 0 logical: 300 w: 3 }]) -> 8
+SubDocKey(DocKey([], ["list_test", 231]), ["list", ArrayIndex(3); \
+    HT{ physical: 0 logical: 200 w: 3 }]) -> 3
+SubDocKey(DocKey([], ["list_test", 231]), ["list", ArrayIndex(4); \
+    HT{ physical: 0 logical: 200 w: 4 }]) -> 4
+SubDocKey(DocKey([], ["list_test", 231]), ["list", ArrayIndex(5); \
+    HT{ physical: 0 logical: 200 w: 5 }]) -> 5
+        )#");
 }
 
 TEST_P(DocDBTestWrapper, ExpiredValueCompactionTest) {
@@ -3288,11 +3353,13 @@ TEST_P(DocDBTestWrapper, TestUpdateDocWriteBatchTTL) {
   LWKeyValueWriteBatchPB kv_pb(&arena);
   dwb.TEST_CopyToWriteBatchPB(&kv_pb);
   ASSERT_FALSE(kv_pb.has_ttl());
+  ASSERT_FALSE(kv_pb.has_value_with_default_ttl());
 
   // Write a subdoc with kMaxTtl, which should not show up in the the kv ttl.
   ASSERT_OK(InsertToWriteBatchWithTTL(&dwb, ValueControlFields::kMaxTtl));
   dwb.TEST_CopyToWriteBatchPB(&kv_pb);
   ASSERT_FALSE(kv_pb.has_ttl());
+  ASSERT_TRUE(kv_pb.has_value_with_default_ttl());
 
   // Write a subdoc with 10s TTL, which should show up in the the kv ttl.
   ASSERT_OK(InsertToWriteBatchWithTTL(&dwb, 10s));
@@ -3315,6 +3382,23 @@ TEST_P(DocDBTestWrapper, TestUpdateDocWriteBatchTTL) {
   ASSERT_EQ(kv_pb.ttl(), 15 * MonoTime::kNanosecondsPerSecond);
 }
 
+TEST_P(DocDBTestWrapper, TestResetTTLDominatesDocWriteBatchTTL) {
+  auto dwb = MakeDocWriteBatch();
+  Arena arena;
+  LWKeyValueWriteBatchPB kv_pb(&arena);
+
+  ASSERT_OK(InsertToWriteBatchWithTTL(&dwb, 10s));
+  dwb.TEST_CopyToWriteBatchPB(&kv_pb);
+  ASSERT_EQ(kv_pb.ttl(), 10 * MonoTime::kNanosecondsPerSecond);
+  ASSERT_FALSE(kv_pb.has_value_with_default_ttl());
+
+  // Value with reset TTL never expires, so larger TTL should not replace it.
+  ASSERT_OK(InsertToWriteBatchWithTTL(&dwb, ValueControlFields::kResetTtl));
+  ASSERT_OK(InsertToWriteBatchWithTTL(&dwb, 15s));
+  dwb.TEST_CopyToWriteBatchPB(&kv_pb);
+  ASSERT_EQ(kv_pb.ttl(), 0);
+}
+
 TEST_P(DocDBTestWrapper, TestCompactionWithUserTimestamp) {
   const DocKey doc_key(KeyEntryValues("k1"));
   HybridTime t3000 = 3000_usec_ht;
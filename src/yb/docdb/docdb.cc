@@ -37,6 +37,7 @@
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/docdb/pgsql_operation.h"
 #include "yb/docdb/rocksdb_writer.h"
+#include "yb/docdb/shared_lock_manager.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
 #include "yb/docdb/value_type.h"
@@ -281,6 +282,35 @@ Result<PrepareDocWriteOperationResult> PrepareDocWriteOperation(
   return result;
 }
 
+Result<bool> HasConflictingWriteLocks(
+    Slice doc_key, bool transactional_table, SharedLockManager* lock_manager) {
+  // Use the same keys that would be locked by serializable read of the document, weak write locks
+  // on the document prefixes don't conflict with them.
+  boost::container::small_vector<size_t, 32> key_prefix_lengths;
+  RETURN_NOT_OK(SubDocKey::DecodePrefixLengths(doc_key, &key_prefix_lengths));
+  if (key_prefix_lengths.empty()) {
+    return STATUS_FORMAT(Corruption, "Unable to decode key prefixes from: $0",
+                         doc_key.ToDebugHexString());
+  }
+  key_prefix_lengths.pop_back();
+
+  const IntentTypeSet strong_intent_types{IntentType::kStrongRead};
+  LockBatchEntries entries;
+  RefCntPrefix doc_path(doc_key);
+  auto partial_key = doc_path;
+  if (doc_path.size() > 0 && transactional_table) {
+    partial_key.Resize(0);
+    RETURN_NOT_OK(ApplyIntent(partial_key, StrongToWeak(strong_intent_types), &entries));
+  }
+  for (size_t prefix_length : key_prefix_lengths) {
+    partial_key.Resize(prefix_length);
+    RETURN_NOT_OK(ApplyIntent(partial_key, StrongToWeak(strong_intent_types), &entries));
+  }
+  RETURN_NOT_OK(ApplyIntent(doc_path, strong_intent_types, &entries));
+
+  return lock_manager->HasConflictingLocks(entries);
+}
+
 Status SetDocOpQLErrorResponse(DocOperation* doc_op, string err_msg) {
   switch (doc_op->OpType()) {
     case DocOperation::Type::QL_WRITE_OPERATION: {
@@ -313,7 +343,10 @@ Status AssembleDocWriteBatch(const vector<unique_ptr<DocOperation>>& doc_write_o
                              HybridTime* restart_read_ht,
                              const string& table_name) {
   DCHECK_ONLY_NOTNULL(restart_read_ht);
-  DocWriteBatch doc_write_batch(doc_db, init_marker_behavior, monotonic_counter);
+  // Keys and values are encoded directly on the arena of the write batch, so they are not copied
+  // again by MoveToWriteBatchPB.
+  DocWriteBatch doc_write_batch(
+      doc_db, init_marker_behavior, monotonic_counter, &write_batch->arena());
   DocOperationApplyData data = {&doc_write_batch, deadline, read_time, restart_read_ht};
   for (const unique_ptr<DocOperation>& doc_op : doc_write_ops) {
     Status s = doc_op->Apply(data);
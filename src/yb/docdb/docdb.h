@@ -119,6 +119,11 @@ Result<PrepareDocWriteOperationResult> PrepareDocWriteOperation(
     PartialRangeKeyIntents partial_range_key_intents,
     SharedLockManager *lock_manager);
 
+// Returns true when lock_manager has write locks, that conflict with reading the whole document
+// with the specified encoded doc key, i.e. there could be an in-flight write to this document.
+Result<bool> HasConflictingWriteLocks(
+    Slice doc_key, bool transactional_table, SharedLockManager* lock_manager);
+
 // This constructs a DocWriteBatch using the given list of DocOperations, reading the previous
 // state of data from RocksDB when necessary.
 //
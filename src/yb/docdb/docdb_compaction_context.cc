@@ -22,6 +22,7 @@
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/key_bounds.h"
 #include "yb/docdb/packed_row.h"
+#include "yb/docdb/range_tombstones.h"
 #include "yb/docdb/schema_packing.h"
 #include "yb/docdb/value.h"
 #include "yb/docdb/value_type.h"
@@ -652,6 +653,11 @@ class DocDBCompactionFeed : public rocksdb::CompactionFeed, public PackedRowFeed
 
   PendingEntry* first_pending_row_ = nullptr;
   PendingEntry** last_pending_row_next_ = &first_pending_row_;
+
+  // Range tombstones at or below history cutoff of the current table.
+  RangeTombstones range_tombstones_;
+  // Max write time of range tombstones covering the current row.
+  EncodedDocHybridTime row_range_tombstone_ht_ = DocHybridTime::EncodedMin();
 };
 
 // ------------------------------------------------------------------------------------------------
@@ -725,6 +731,25 @@ Status DocDBCompactionFeed::Feed(const Slice& internal_key, const Slice& value)
     return Status::OK();
   }
 
+  // Range tombstones of a table precede its rows, so they are collected while passing the table
+  // doc key and applied to the following rows of the same table.
+  if (num_shared_components == 0) {
+    range_tombstones_.Clear();
+  }
+  const bool is_table_key =
+      sub_key_ends_.size() < 2 || IsTableDocKey(key.Prefix(sub_key_ends_[1]));
+  bool is_range_tombstone = false;
+  RangeTombstone range_tombstone;
+  if (is_table_key && sub_key_ends_.size() > 2) {
+    is_range_tombstone = VERIFY_RESULT(DecodeRangeTombstone(
+        key.Prefix(sub_key_ends_.back()).WithoutPrefix(sub_key_ends_[1]), &range_tombstone));
+  }
+  if (num_shared_components <= 1) {
+    row_range_tombstone_ht_ = range_tombstones_.empty() || is_table_key
+        ? DocHybridTime::EncodedMin()
+        : EncodedDocHybridTime(range_tombstones_.MaxWriteTime(key.Prefix(sub_key_ends_[1])));
+  }
+
   const size_t new_stack_size = sub_key_ends_.size();
 
   // Remove overwrite hybrid_times for components that are no longer relevant for the current
@@ -757,6 +782,10 @@ Status DocDBCompactionFeed::Feed(const Slice& internal_key, const Slice& value)
   //
   EncodedDocHybridTime prev_overwrite_ht(
       overwrite_.empty() ? DocHybridTime::EncodedMin() : overwrite_.back().encoded_doc_ht);
+  // Row was deleted by range tombstone at or below history cutoff.
+  if (overwrite_.size() <= 1 && row_range_tombstone_ht_ > prev_overwrite_ht) {
+    prev_overwrite_ht = row_range_tombstone_ht_;
+  }
 
   // We only keep entries with hybrid_time equal to or later than the latest time the subdocument
   // was fully overwritten or deleted prior to or at the history cutoff time. The intuition is that
@@ -829,7 +858,12 @@ Status DocDBCompactionFeed::Feed(const Slice& internal_key, const Slice& value)
   // TODO: could there be a case when there is still a read request running that uses an old schema,
   //       and we end up removing some data that the client expects to see?
   VLOG(4) << "Sub key ends: " << AsString(sub_key_ends_);
-  if (sub_key_ends_.size() > 1) {
+  if (is_range_tombstone) {
+    if (DecodeValueEntryType(value_slice) == ValueEntryType::kTombstone) {
+      range_tombstone.write_time = VERIFY_RESULT(encoded_doc_ht.Decode());
+      range_tombstones_.Add(range_tombstone);
+    }
+  } else if (sub_key_ends_.size() > 1) {
     // 0 - end of cotable id section.
     // 1 - end of doc key section.
     // Column ID is the first subkey in every row.
@@ -1145,6 +1179,16 @@ std::shared_ptr<rocksdb::CompactionContextFactory> CreateCompactionContextFactor
   });
 }
 
+std::shared_ptr<std::function<Result<Slice>(Slice)>> CreateCompactionRowPrefixExtractor() {
+  return std::make_shared<std::function<Result<Slice>(Slice)>>(
+      [](Slice user_key) -> Result<Slice> {
+    if (user_key.empty() || IsInternalRecordKeyType(DecodeKeyEntryType(user_key[0]))) {
+      return STATUS_FORMAT(InvalidArgument, "Not a doc key: $0", user_key.ToDebugHexString());
+    }
+    return user_key.Prefix(VERIFY_RESULT(DocKey::EncodedSize(user_key, DocKeyPart::kWholeDocKey)));
+  });
+}
+
 // ------------------------------------------------------------------------------------------------
 
 HistoryRetentionDirective ManualHistoryRetentionPolicy::GetRetentionDirective() {
@@ -108,6 +108,9 @@ std::shared_ptr<rocksdb::CompactionContextFactory> CreateCompactionContextFactor
     const DeleteMarkerRetentionTimeProvider& delete_marker_retention_provider,
     SchemaPackingProvider* schema_packing_provider);
 
+// Returns doc key of the regular DB key, so subcompactions don't split rows.
+std::shared_ptr<std::function<Result<Slice>(Slice)>> CreateCompactionRowPrefixExtractor();
+
 // A history retention policy that can be configured manually. Useful in tests. This class is
 // useful for testing and is thread-safe.
 class ManualHistoryRetentionPolicy : public HistoryRetentionPolicy {
@@ -30,6 +30,7 @@ class DocDBCompactionFilterFactory;
 class DocKey;
 class DocOperation;
 class DocPath;
+class DocPgExprExecutor;
 class DocPgsqlScanSpec;
 class DocQLScanSpec;
 class DocRowwiseIterator;
@@ -45,12 +46,15 @@ class PgsqlWriteOperation;
 class PrimitiveValue;
 class QLWriteOperation;
 class RedisWriteOperation;
+class RowCache;
 class RowPacker;
 class ScanChoices;
 class SchemaPacking;
+class SchemaPackingProvider;
 class SchemaPackingStorage;
 class SharedLockManager;
 class SubDocKey;
+class WaitQueue;
 class YQLRowwiseIteratorIf;
 class YQLStorageIf;
 
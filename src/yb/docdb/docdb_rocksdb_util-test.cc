@@ -27,6 +27,8 @@ DECLARE_int32(block_restart_interval);
 DECLARE_int32(index_block_restart_interval);
 DECLARE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec);
 DECLARE_string(rocksdb_compact_flush_rate_limit_sharing_mode);
+DECLARE_int32(max_nexts_to_avoid_seek);
+DECLARE_int32(max_adaptive_nexts_to_avoid_seek);
 
 namespace yb {
 namespace docdb {
@@ -254,5 +256,48 @@ TEST_F(DocDBRocksDBUtilTest, RocksDBRateLimiter) {
   }
 }
 
+TEST_F(DocDBRocksDBUtilTest, NextsToAvoidSeekPolicy) {
+  FLAGS_max_nexts_to_avoid_seek = 2;
+  FLAGS_max_adaptive_nexts_to_avoid_seek = 8;
+
+  {
+    // Nexts never reach the target, so policy should switch to immediate seek.
+    NextsToAvoidSeekPolicy policy;
+    ASSERT_EQ(policy.NextsToTry(), 2);
+    for (int i = 0; i != 100; ++i) {
+      auto nexts = policy.NextsToTry();
+      policy.Update(nexts, false);
+    }
+    ASSERT_EQ(policy.max_nexts(), 0);
+    // And restore nexts after successful probe.
+    for (int i = 0; i != 100; ++i) {
+      auto nexts = policy.NextsToTry();
+      policy.Update(nexts, true);
+    }
+    ASSERT_EQ(policy.max_nexts(), 2);
+  }
+
+  {
+    // Nexts usually reach the target, so policy should allow more of them, up to the limit.
+    NextsToAvoidSeekPolicy policy;
+    for (int i = 0; i != 100; ++i) {
+      auto nexts = policy.NextsToTry();
+      policy.Update(nexts, i % 4 != 0);
+    }
+    ASSERT_EQ(policy.max_nexts(), 8);
+  }
+
+  {
+    // Adaptation disabled.
+    FLAGS_max_adaptive_nexts_to_avoid_seek = 0;
+    NextsToAvoidSeekPolicy policy;
+    for (int i = 0; i != 100; ++i) {
+      auto nexts = policy.NextsToTry();
+      ASSERT_EQ(nexts, 2);
+      policy.Update(nexts, false);
+    }
+  }
+}
+
 }  // namespace docdb
 }  // namespace yb
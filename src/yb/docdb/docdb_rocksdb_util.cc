@@ -21,6 +21,7 @@
 #include "yb/common/transaction.h"
 
 #include "yb/docdb/bounded_rocksdb_iterator.h"
+#include "yb/docdb/colocated_tables_stats.h"
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/intent_aware_iterator.h"
@@ -38,6 +39,7 @@
 #include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/rate_limiter.h"
+#include "yb/rocksdb/slice_transform.h"
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table/filtering_iterator.h"
 #include "yb/rocksdb/types.h"
@@ -45,6 +47,7 @@
 
 #include "yb/rocksutil/yb_rocksdb_logger.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/flags.h"
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/priority_thread_pool.h"
@@ -99,10 +102,18 @@ DEFINE_string(rocksdb_compact_flush_rate_limit_sharing_mode, "tserver",
               "  none - rate limit is calculated independently for every RocksDB instance");
 DEFINE_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 1024 * 1024,
              "Threshold beyond which compaction is considered large.");
+DEFINE_int32(rocksdb_max_subcompactions, 1,
+             "Maximal number of threads used by a large compaction of regular DB, that is split "
+             "into subcompactions by row ranges. 1 - compaction is not split.");
 DEFINE_uint64(rocksdb_max_file_size_for_compaction, 0,
              "Maximal allowed file size to participate in RocksDB compaction. 0 - unlimited.");
 DEFINE_int32(rocksdb_max_write_buffer_number, 2,
              "Maximum number of write buffers that are built up in memory.");
+DEFINE_int32(rocksdb_max_open_files, 5000,
+             "Maximal number of table readers kept open by the table cache of each RocksDB "
+             "instance. SST files are opened on the first access and readers over the limit are "
+             "evicted in LRU order. -1 - all files are opened when RocksDB is opened and kept "
+             "open, which increases startup time and memory usage on nodes with many tablets.");
 
 DEFINE_int64(db_block_size_bytes, 32_KB,
              "Size of RocksDB data block (in bytes).");
@@ -116,18 +127,45 @@ DEFINE_int64(db_index_block_size_bytes, 32_KB,
 DEFINE_int64(db_min_keys_per_index_block, 100,
              "Minimum number of keys per index block.");
 
+DEFINE_bool(db_data_block_fence_pointers, false,
+            "Whether to write fence pointers for data blocks to new SST files. Fence pointers are "
+            "pinned in memory and allow to find data block for point reads without reading "
+            "lower level index blocks.");
+
+DEFINE_bool(db_cache_index_and_filter_blocks_with_high_priority, false,
+            "Whether to put index and filter blocks directly to the multi touch part of the block "
+            "cache, so they are not evicted by scans of data blocks.");
+
 DEFINE_int64(db_write_buffer_size, -1,
              "Size of RocksDB write buffer (in bytes). -1 to use default.");
 
 DEFINE_int32(memstore_size_mb, 128,
              "Max size (in mb) of the memstore, before needing to flush.");
 
+DEFINE_NON_RUNTIME_uint64(memstore_huge_page_size, 0,
+    "Page size for huge page TLB used for memstore arena blocks, e.g. 2097152. 0 to allocate "
+    "memstore arena blocks with malloc. Huge pages should be reserved via vm.nr_hugepages, "
+    "otherwise allocation falls back to malloc.");
+
+DEFINE_NON_RUNTIME_bool(use_doc_key_memtable_index, false,
+    "Whether to index memtable entries by their encoded DocKey, so seeks and point lookups start "
+    "from the first entry of the document instead of searching the whole memtable.");
+
 DEFINE_bool(use_docdb_aware_bloom_filter, true,
             "Whether to use the DocDbAwareFilterPolicy for both bloom storage and seeks.");
+DEFINE_RUNTIME_bool(use_bloom_filter_for_intents, true,
+    "Whether point reads use bloom filters of intents DB files, so files that contain only "
+    "intents of other keys are skipped. Most useful for existence checks of bulk inserts, e.g. "
+    "into unique indexes, that are done within large transactions.");
 // Empirically 2 is a minimal value that provides best performance on sequential scan.
 DEFINE_int32(max_nexts_to_avoid_seek, 2,
              "The number of next calls to try before doing resorting to do a rocksdb seek.");
 
+DEFINE_RUNTIME_int32(max_adaptive_nexts_to_avoid_seek, 8,
+    "Upper bound for the number of next calls to try before doing rocksdb seek, when it is "
+    "adjusted per iterator based on observed key version density. Set to 0 to always use "
+    "max_nexts_to_avoid_seek.");
+
 DEFINE_bool(use_multi_level_index, true, "Whether to use multi-level data index.");
 
 // Using class kExternal as this change affects the format of data in the SST files which are sent
@@ -154,12 +192,36 @@ DEFINE_string(compression_type, "Snappy",
               "On-disk compression type to use in RocksDB."
               "By default, Snappy is used if supported.");
 
+DEFINE_string(large_sst_compression_type, "Zlib",
+              "On-disk compression type to use in RocksDB for output of compactions, whose input "
+              "files are at least large_sst_compression_min_size_bytes in total. Allows to use "
+              "stronger compression for big files of major compactions.");
+
+DEFINE_uint64(large_sst_compression_min_size_bytes, 0,
+              "Minimal total size of compaction input files to use large_sst_compression_type "
+              "for its output. 0 means that compression_type is used for all files.");
+
 DEFINE_int32(block_restart_interval, kDefaultDataBlockRestartInterval,
              "Controls the number of keys to look at for computing the diff encoding.");
 
 DEFINE_int32(index_block_restart_interval, kDefaultIndexBlockRestartInterval,
              "Controls the number of data blocks to be indexed inside an index block.");
 
+DEFINE_uint64(rocksdb_compaction_readahead_size_bytes, 0,
+              "Size of readahead used by compactions while reading input files. Non zero value "
+              "makes compaction read its input with separate file readers in large sequential "
+              "chunks. 0 disables compaction readahead.");
+
+DEFINE_string(rocksdb_compaction_access_hint, "NORMAL",
+              "Access pattern hint passed to the OS for input files of compaction: NONE, NORMAL, "
+              "SEQUENTIAL or WILLNEED.");
+
+DEFINE_NON_RUNTIME_bool(rocksdb_use_mmap_reads, false,
+    "Read SST files through memory mapping. Uncompressed blocks are then used directly from the "
+    "mapped memory instead of being copied to the block cache, and checksum of each block is "
+    "verified once after the file is opened. Intended for nodes, where the data fits in memory. "
+    "Mapped memory is not accounted by memory trackers.");
+
 DEFINE_bool(prioritize_tasks_by_disk, false,
             "Consider disk load when considering compaction and flush priorities.");
 
@@ -190,6 +252,21 @@ Result<rocksdb::CompressionType> GetConfiguredCompressionType(const std::string&
       InvalidArgument, "Configured compression type $0 is not valid.", flag_value);
 }
 
+Result<rocksdb::Options::AccessHint> GetConfiguredAccessHint(const std::string& flag_value) {
+  const std::vector<std::pair<const char*, rocksdb::Options::AccessHint>> kAccessHints = {
+    {"NONE", rocksdb::Options::NONE},
+    {"NORMAL", rocksdb::Options::NORMAL},
+    {"SEQUENTIAL", rocksdb::Options::SEQUENTIAL},
+    {"WILLNEED", rocksdb::Options::WILLNEED},
+  };
+  for (const auto& [name, access_hint] : kAccessHints) {
+    if (boost::iequals(flag_value, name)) {
+      return access_hint;
+    }
+  }
+  return STATUS_FORMAT(InvalidArgument, "Access hint $0 is not valid.", flag_value);
+}
+
 } // namespace
 
 namespace docdb {
@@ -210,6 +287,15 @@ namespace docdb {
 
 namespace {
 
+bool AccessHintValidator(const char* flag_name, const std::string& flag_value) {
+  auto res = yb::GetConfiguredAccessHint(flag_value);
+  if (!res.ok()) {
+    LOG(ERROR) << flag_name << ": " << res.status();
+    return false;
+  }
+  return true;
+}
+
 bool CompressionTypeValidator(const char* flagname, const std::string& flag_compression_type) {
   auto res = yb::GetConfiguredCompressionType(flag_compression_type);
   if (!res.ok()) {
@@ -233,6 +319,8 @@ bool KeyValueEncodingFormatValidator(const char* flag_name, const std::string& f
 } // namespace
 
 DEFINE_validator(compression_type, &CompressionTypeValidator);
+DEFINE_validator(large_sst_compression_type, &CompressionTypeValidator);
+DEFINE_validator(rocksdb_compaction_access_hint, &AccessHintValidator);
 DEFINE_validator(regular_tablets_data_block_key_value_encoding, &KeyValueEncodingFormatValidator);
 
 using std::shared_ptr;
@@ -272,9 +360,62 @@ struct SeekStats {
   int seek = 0;
 };
 
-SeekStats SeekPossiblyUsingNext(rocksdb::Iterator* iter, const Slice& seek_key) {
+namespace {
+
+constexpr int kRateScale = 1024;
+// Each update contributes 1/2^kRateDecayShift to the rate.
+constexpr int kRateDecayShift = 4;
+// When nexts are disabled, the policy periodically tries them, to react on workload change.
+constexpr uint32_t kProbeInterval = 64;
+
+} // namespace
+
+NextsToAvoidSeekPolicy::NextsToAvoidSeekPolicy()
+    : max_nexts_(FLAGS_max_nexts_to_avoid_seek), success_rate_(kRateScale / 2) {
+}
+
+int NextsToAvoidSeekPolicy::NextsToTry() {
+  if (max_nexts_ > 0 || FLAGS_max_nexts_to_avoid_seek <= 0 ||
+      FLAGS_max_adaptive_nexts_to_avoid_seek <= 0) {
+    return max_nexts_;
+  }
+  if (++seeks_since_probe_ < kProbeInterval) {
+    return 0;
+  }
+  seeks_since_probe_ = 0;
+  return FLAGS_max_nexts_to_avoid_seek;
+}
+
+void NextsToAvoidSeekPolicy::Update(int nexts_tried, bool reached) {
+  auto max_limit = FLAGS_max_adaptive_nexts_to_avoid_seek;
+  if (max_limit <= 0 || FLAGS_max_nexts_to_avoid_seek <= 0) {
+    max_nexts_ = FLAGS_max_nexts_to_avoid_seek;
+    return;
+  }
+  if (nexts_tried == 0) {
+    // Nothing learned.
+    return;
+  }
+  success_rate_ += ((reached ? kRateScale : 0) - success_rate_) >> kRateDecayShift;
+  if (reached) {
+    if (max_nexts_ == 0) {
+      // Probe succeeded.
+      max_nexts_ = nexts_tried;
+    }
+    return;
+  }
+  if (success_rate_ >= kRateScale / 2) {
+    // Nexts usually reach the target, so it should be just a bit further.
+    max_nexts_ = std::min(max_nexts_ + 1, max_limit);
+  } else {
+    max_nexts_ = std::max(max_nexts_ - 1, 0);
+  }
+}
+
+SeekStats SeekPossiblyUsingNext(
+    rocksdb::Iterator* iter, const Slice& seek_key, int max_nexts) {
   SeekStats result;
-  for (int nexts = FLAGS_max_nexts_to_avoid_seek; nexts-- > 0;) {
+  for (int nexts = max_nexts; nexts-- > 0;) {
     if (!iter->Valid() || iter->key().compare(seek_key) >= 0) {
       VTRACE(3, "Did $0 Next(s) instead of a Seek", result.next);
       return result;
@@ -285,12 +426,16 @@ SeekStats SeekPossiblyUsingNext(rocksdb::Iterator* iter, const Slice& seek_key)
     ++result.next;
   }
 
-  VTRACE(3, "Forced to do an actual Seek after $0 Next(s)", FLAGS_max_nexts_to_avoid_seek);
+  VTRACE(3, "Forced to do an actual Seek after $0 Next(s)", max_nexts);
   iter->Seek(seek_key);
   ++result.seek;
   return result;
 }
 
+SeekStats SeekPossiblyUsingNext(rocksdb::Iterator* iter, const Slice& seek_key) {
+  return SeekPossiblyUsingNext(iter, seek_key, FLAGS_max_nexts_to_avoid_seek);
+}
+
 void PerformRocksDBSeek(
     rocksdb::Iterator *iter,
     const rocksdb::Slice &seek_key,
@@ -371,12 +516,26 @@ unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time,
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter,
-    const Slice* iterate_upper_bound) {
+    const Slice* iterate_upper_bound,
+    std::shared_ptr<rocksdb::TableStatsReadFileFilter> table_stats_file_filter,
+    Slice colocated_table_prefix) {
   // TODO(dtxn) do we need separate options for intents db?
   rocksdb::ReadOptions read_opts = PrepareReadOptions(doc_db.regular, bloom_filter_mode,
       user_key_for_filter, query_id, std::move(file_filter), iterate_upper_bound);
+  read_opts.table_stats_file_filter = std::move(table_stats_file_filter);
+  if (!colocated_table_prefix.empty()) {
+    read_opts.table_aware_file_filter = std::make_shared<ColocatedTableFileFilter>(
+        colocated_table_prefix, std::move(read_opts.table_aware_file_filter));
+  }
+  // Intents DB shares table factory with regular DB, so its files have filters built with the same
+  // policy, and intents of a key share the prefix with entries of this key in regular DB.
+  boost::optional<const Slice> intents_user_key_for_filter;
+  if (bloom_filter_mode == BloomFilterMode::USE_BLOOM_FILTER &&
+      GetAtomicFlag(&FLAGS_use_bloom_filter_for_intents)) {
+    intents_user_key_for_filter = user_key_for_filter;
+  }
   return std::make_unique<IntentAwareIterator>(
-      doc_db, read_opts, deadline, read_time, txn_op_context);
+      doc_db, read_opts, deadline, read_time, txn_op_context, intents_user_key_for_filter);
 }
 
 namespace {
@@ -459,6 +618,11 @@ void AutoInitFromRocksDBFlags(rocksdb::Options* options) {
 
   options->max_background_compactions = GetMaxBackgroundCompactions();
   options->base_background_compactions = GetBaseBackgroundCompactions();
+  // Sanitization of options turns on separate table readers for compaction inputs, when readahead
+  // is used. Flag validator ensures that access hint is valid.
+  options->compaction_readahead_size = FLAGS_rocksdb_compaction_readahead_size_bytes;
+  options->access_hint_on_compaction_start =
+      CHECK_RESULT(GetConfiguredAccessHint(FLAGS_rocksdb_compaction_access_hint));
 }
 
 void AutoInitFromBlockBasedTableOptions(rocksdb::BlockBasedTableOptions* table_options) {
@@ -468,6 +632,7 @@ void AutoInitFromBlockBasedTableOptions(rocksdb::BlockBasedTableOptions* table_o
   table_options->filter_block_size = FLAGS_db_filter_block_size_bytes;
   table_options->index_block_size = FLAGS_db_index_block_size_bytes;
   table_options->min_keys_per_index_block = FLAGS_db_min_keys_per_index_block;
+  table_options->data_block_fence_pointers = FLAGS_db_data_block_fence_pointers;
 
   if (FLAGS_block_restart_interval < kMinBlockRestartInterval) {
     LOG(INFO) << "FLAGS_block_restart_interval was set to a very low value, overriding "
@@ -535,6 +700,42 @@ rocksdb::InternalIterator* WrapIterator(
   return iterator;
 }
 
+// Extracts encoded DocKey, used to index memtable entries by document.
+// Keys that don't start with DocKey, like transaction metadata and reverse index records in
+// intents DB, are out of domain.
+class DocKeyPrefixTransform : public rocksdb::SliceTransform {
+ public:
+  const char* Name() const override {
+    return "DocKeyPrefixTransform";
+  }
+
+  Slice Transform(const Slice& src) const override {
+    auto size = DocKey::EncodedSize(src, DocKeyPart::kWholeDocKey);
+    DCHECK(size.ok()) << src.ToDebugHexString() << ": " << size.status();
+    return src.Prefix(size.ok() ? *size : src.size());
+  }
+
+  bool InDomain(const Slice& src) const override {
+    return MayStartWithDocKey(src) && DocKey::EncodedSize(src, DocKeyPart::kWholeDocKey).ok();
+  }
+
+  bool InRange(const Slice& dst) const override {
+    if (!MayStartWithDocKey(dst)) {
+      return false;
+    }
+    auto size = DocKey::EncodedSize(dst, DocKeyPart::kWholeDocKey);
+    return size.ok() && *size == dst.size();
+  }
+
+ private:
+  // Checks special keys without decoding, RocksDB calls InDomain for each added and looked up key.
+  static bool MayStartWithDocKey(Slice src) {
+    return !src.empty() && src[0] != KeyEntryTypeAsChar::kTransactionId &&
+           src[0] != KeyEntryTypeAsChar::kTransactionApplyState &&
+           src[0] != KeyEntryTypeAsChar::kExternalTransactionId;
+  }
+};
+
 void AddSupportedFilterPolicy(
     const rocksdb::BlockBasedTableOptions::FilterPolicyPtr& filter_policy,
     rocksdb::BlockBasedTableOptions* table_options) {
@@ -610,7 +811,8 @@ void InitRocksDBOptions(
     const shared_ptr<rocksdb::Statistics>& statistics,
     const tablet::TabletOptions& tablet_options,
     rocksdb::BlockBasedTableOptions table_options,
-    const uint64_t group_no) {
+    const uint64_t group_no,
+    size_t bloom_filter_range_components) {
   AutoInitFromRocksDBFlags(options);
   SetLogPrefix(options, log_prefix);
   options->create_if_missing = true;
@@ -628,6 +830,9 @@ void InitRocksDBOptions(
   } else {
     options->write_buffer_size = FLAGS_memstore_size_mb * 1_MB;
   }
+  options->memtable_huge_page_size = FLAGS_memstore_huge_page_size;
+  options->max_open_files = FLAGS_rocksdb_max_open_files;
+  options->allow_mmap_reads = FLAGS_rocksdb_use_mmap_reads;
   options->env = tablet_options.rocksdb_env;
   options->checkpoint_env = rocksdb::Env::Default();
   options->priority_thread_pool_for_compactions_and_flushes = GetGlobalPriorityThreadPool();
@@ -639,6 +844,11 @@ void InitRocksDBOptions(
   // Since the flag validator for FLAGS_compression_type will fail if the result of this call is not
   // OK, this CHECK_RESULT should never fail and is safe.
   options->compression = CHECK_RESULT(GetConfiguredCompressionType(FLAGS_compression_type));
+  if (FLAGS_large_sst_compression_min_size_bytes > 0) {
+    options->large_output_compression_min_size = FLAGS_large_sst_compression_min_size_bytes;
+    options->large_output_compression =
+        CHECK_RESULT(GetConfiguredCompressionType(FLAGS_large_sst_compression_type));
+  }
 
   options->listeners.insert(
       options->listeners.end(), tablet_options.listeners.begin(),
@@ -647,8 +857,11 @@ void InitRocksDBOptions(
   // Set block cache options.
   if (tablet_options.block_cache) {
     table_options.block_cache = tablet_options.block_cache;
+    table_options.block_cache_compressed = tablet_options.compressed_block_cache;
     // Cache the bloom filters in the block cache.
     table_options.cache_index_and_filter_blocks = true;
+    table_options.cache_index_and_filter_blocks_with_high_priority =
+        FLAGS_db_cache_index_and_filter_blocks_with_high_priority;
   } else {
     table_options.no_block_cache = true;
     table_options.cache_index_and_filter_blocks = false;
@@ -659,14 +872,32 @@ void InitRocksDBOptions(
   // Set our custom bloom filter that is docdb aware.
   if (FLAGS_use_docdb_aware_bloom_filter) {
     const auto filter_block_size_bits = table_options.filter_block_size * 8;
-    table_options.filter_policy = std::make_shared<const DocDbAwareV3FilterPolicy>(
-        filter_block_size_bits, options->info_log.get());
     table_options.supported_filter_policies =
         std::make_shared<rocksdb::BlockBasedTableOptions::FilterPoliciesMap>();
     AddSupportedFilterPolicy(std::make_shared<const DocDbAwareHashedComponentsFilterPolicy>(
             filter_block_size_bits, options->info_log.get()), &table_options);
     AddSupportedFilterPolicy(std::make_shared<const DocDbAwareV2FilterPolicy>(
             filter_block_size_bits, options->info_log.get()), &table_options);
+    // Files could be written with different number of range components, if it was changed for
+    // table, so all of them should be supported.
+    std::shared_ptr<const rocksdb::FilterPolicy> range_prefix_policy;
+    for (size_t i = 1; i <= kMaxBloomFilterRangeComponents; ++i) {
+      auto policy = std::make_shared<const DocDbAwareRangePrefixFilterPolicy>(
+          filter_block_size_bits, options->info_log.get(), i);
+      if (i == bloom_filter_range_components) {
+        range_prefix_policy = policy;
+      }
+      AddSupportedFilterPolicy(policy, &table_options);
+    }
+    if (range_prefix_policy) {
+      table_options.filter_policy = range_prefix_policy;
+    } else {
+      LOG_IF(WARNING, bloom_filter_range_components != 0)
+          << log_prefix << "Unsupported number of bloom filter range components: "
+          << bloom_filter_range_components << ", using default filter";
+      table_options.filter_policy = std::make_shared<const DocDbAwareV3FilterPolicy>(
+          filter_block_size_bits, options->info_log.get());
+    }
   }
 
   if (FLAGS_use_multi_level_index) {
@@ -704,6 +935,7 @@ void InitRocksDBOptions(
     options->compaction_options_universal.min_merge_width =
         FLAGS_rocksdb_universal_compaction_min_merge_width;
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
+    options->max_subcompactions = std::max(FLAGS_rocksdb_max_subcompactions, 1);
     options->rate_limiter = tablet_options.rate_limiter ? tablet_options.rate_limiter
                                                         : CreateRocksDBRateLimiter();
   } else {
@@ -713,8 +945,14 @@ void InitRocksDBOptions(
 
   options->max_write_buffer_number = FLAGS_rocksdb_max_write_buffer_number;
 
-  options->memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
-      0 /* lookahead */, rocksdb::ConcurrentWrites::kFalse);
+  if (FLAGS_use_doc_key_memtable_index) {
+    static const auto doc_key_prefix_transform = std::make_shared<DocKeyPrefixTransform>();
+    options->memtable_factory = std::make_shared<rocksdb::PrefixIndexedSkipListFactory>(
+        doc_key_prefix_transform);
+  } else {
+    options->memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
+        0 /* lookahead */, rocksdb::ConcurrentWrites::kFalse);
+  }
 
   options->iterator_replacer = std::make_shared<rocksdb::IteratorReplacer>(&WrapIterator);
 
@@ -1001,13 +1239,20 @@ std::shared_ptr<rocksdb::RateLimiter> CreateRocksDBRateLimiter() {
   return nullptr;
 }
 
-void SeekForward(const rocksdb::Slice& slice, rocksdb::Iterator *iter) {
+void SeekForward(
+    const rocksdb::Slice& slice, rocksdb::Iterator *iter, NextsToAvoidSeekPolicy* policy) {
   if (!iter->Valid() || iter->key().compare(slice) >= 0) {
     return;
   }
 
   iter->Next();
-  SeekPossiblyUsingNext(iter, slice);
+  if (!policy) {
+    SeekPossiblyUsingNext(iter, slice);
+    return;
+  }
+  auto nexts = policy->NextsToTry();
+  auto stats = SeekPossiblyUsingNext(iter, slice, nexts);
+  policy->Update(nexts, stats.seek == 0);
 }
 
 } // namespace docdb
@@ -34,9 +34,42 @@ const int kDefaultGroupNo = 0;
 
 class IntentAwareIterator;
 
+// Adaptive policy for the number of Next calls to try before doing an actual Seek, kept per
+// iterator. Tracks exponentially decaying rate of seeks that were satisfied by Next calls.
+// When Next calls rarely reach the target, for instance because of many versions per key, they are
+// wasted, so the number of Next calls is decreased, down to immediate Seek. When Next calls
+// reach the target but sometimes fall a bit short, the number of Next calls is increased, up to
+// max_adaptive_nexts_to_avoid_seek.
+// Starts from max_nexts_to_avoid_seek. Not thread safe.
+class NextsToAvoidSeekPolicy {
+ public:
+  NextsToAvoidSeekPolicy();
+
+  // Number of Next calls to try for the upcoming seek.
+  int NextsToTry();
+
+  // Updates policy with the result of the seek, that was started with nexts_tried Next calls
+  // allowed. reached is true if the target was reached by Next calls.
+  void Update(int nexts_tried, bool reached);
+
+  int max_nexts() const {
+    return max_nexts_;
+  }
+
+ private:
+  int max_nexts_;
+  // Rate of seeks satisfied by Next calls, scaled by kRateScale.
+  int success_rate_;
+  uint32_t seeks_since_probe_ = 0;
+};
+
 // See to a rocksdb point that is at least sub_doc_key.
 // If the iterator is already positioned far enough, does not perform a seek.
-void SeekForward(const rocksdb::Slice& slice, rocksdb::Iterator *iter);
+// When policy is specified it is used to decide on number of Next calls tried before Seek,
+// otherwise max_nexts_to_avoid_seek is used.
+void SeekForward(
+    const rocksdb::Slice& slice, rocksdb::Iterator *iter,
+    NextsToAvoidSeekPolicy* policy = nullptr);
 
 void SeekForward(const KeyBytes& key_bytes, rocksdb::Iterator *iter);
 
@@ -98,7 +131,9 @@ std::unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time,
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter = nullptr,
-    const Slice* iterate_upper_bound = nullptr);
+    const Slice* iterate_upper_bound = nullptr,
+    std::shared_ptr<rocksdb::TableStatsReadFileFilter> table_stats_file_filter = nullptr,
+    Slice colocated_table_prefix = Slice());
 
 // Request RocksDB compaction and wait until it completes.
 Status ForceRocksDBCompact(rocksdb::DB* db, SkipFlush skip_flush = SkipFlush::kFalse);
@@ -132,7 +167,8 @@ void InitRocksDBOptions(
     const std::shared_ptr<rocksdb::Statistics>& statistics,
     const tablet::TabletOptions& tablet_options,
     rocksdb::BlockBasedTableOptions table_options = rocksdb::BlockBasedTableOptions(),
-    const uint64_t group_no = kDefaultGroupNo);
+    const uint64_t group_no = kDefaultGroupNo,
+    size_t bloom_filter_range_components = 0);
 
 // Sets logs prefix for RocksDB options. This will also reinitialize options->info_log.
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix);
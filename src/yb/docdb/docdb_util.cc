@@ -149,7 +149,7 @@ Status DocDBRocksDBUtil::PopulateRocksDBWriteBatch(
       // don't contain the HybridTime.
       RETURN_NOT_OK_PREPEND(
           subdoc_key.FullyDecodeFromKeyWithOptionalHybridTime(entry.key),
-          Substitute("when decoding key: $0", FormatBytesAsStr(entry.key)));
+          Substitute("when decoding key: $0", FormatSliceAsStr(entry.key)));
     }
   }
 
@@ -177,11 +177,11 @@ Status DocDBRocksDBUtil::PopulateRocksDBWriteBatch(
         // HybridTime provided. Append a PrimitiveValue with the HybridTime to the key.
         const KeyBytes encoded_ht =
             KeyEntryValue(DocHybridTime(hybrid_time, write_id)).ToKeyBytes();
-        rocksdb_key = entry.key + encoded_ht.ToStringBuffer();
+        rocksdb_key = entry.key.ToBuffer() + encoded_ht.ToStringBuffer();
       } else {
         // Useful when printing out a write batch that does not yet know the HybridTime it will be
         // committed with.
-        rocksdb_key = entry.key;
+        rocksdb_key = entry.key.ToBuffer();
       }
       rocksdb_write_batch->Put(rocksdb_key, entry.value);
       if (increment_write_id) {
@@ -439,6 +439,18 @@ Status DocDBRocksDBUtil::ReplaceInList(
   return WriteToRocksDB(dwb, hybrid_time);
 }
 
+Status DocDBRocksDBUtil::RemoveFromList(
+    const DocPath& doc_path,
+    const QLValuePB& values,
+    const ReadHybridTime& read_ht,
+    const HybridTime& hybrid_time,
+    MonoDelta default_ttl) {
+  auto dwb = MakeDocWriteBatch();
+  RETURN_NOT_OK(dwb.RemoveFromCqlList(
+      doc_path, values, read_ht, CoarseTimePoint::max(), rocksdb::kDefaultQueryId, default_ttl));
+  return WriteToRocksDB(dwb, hybrid_time);
+}
+
 Status DocDBRocksDBUtil::DeleteSubDoc(
     const DocPath& doc_path,
     HybridTime hybrid_time,
@@ -174,6 +174,13 @@ class DocDBRocksDBUtil {
       MonoDelta ttl = ValueControlFields::kMaxTtl,
       UserTimeMicros user_timestamp = ValueControlFields::kInvalidTimestamp);
 
+  Status RemoveFromList(
+      const DocPath& doc_path,
+      const QLValuePB& values,
+      const ReadHybridTime& read_ht,
+      const HybridTime& hybrid_time,
+      MonoDelta default_ttl = ValueControlFields::kMaxTtl);
+
   Status DeleteSubDoc(
       const DocPath& doc_path,
       HybridTime hybrid_time,
@@ -28,6 +28,7 @@
 #include "yb/docdb/docdb_test_base.h"
 #include "yb/docdb/docdb_test_util.h"
 #include "yb/docdb/packed_row.h"
+#include "yb/docdb/range_tombstones.h"
 #include "yb/docdb/schema_packing.h"
 
 #include "yb/server/hybrid_clock.h"
@@ -123,6 +124,7 @@ class DocRowwiseIteratorTest : public DocDBTestBase {
   void TestDocRowwiseIteratorHasNextIdempotence();
   void TestDocRowwiseIteratorIncompleteProjection();
   void TestColocatedTableTombstone();
+  void TestColocatedRangeTombstone();
   void TestDocRowwiseIteratorMultipleDeletes();
   void TestDocRowwiseIteratorValidColumnNotInProjection();
   void TestDocRowwiseIteratorKeyProjection();
@@ -132,6 +134,8 @@ class DocRowwiseIteratorTest : public DocDBTestBase {
   void TestScanWithinTheSameTxn();
   void TestLargeKeys();
   void TestPackedRow();
+  void TestNextRowBatch();
+  void TestSkipIntentsOfTransactionsStartedAfterRead();
   // Restore doesn't use delete tombstones for rows, instead marks all columns
   // as deleted.
   void TestDeletedDocumentUsingLivenessColumnDelete();
@@ -297,6 +301,87 @@ void DocRowwiseIteratorTest::InsertTestRangeData() {
   }
 }
 
+void DocRowwiseIteratorTest::TestSkipIntentsOfTransactionsStartedAfterRead() {
+  SetTransactionIsolationLevel(IsolationLevel::SNAPSHOT_ISOLATION);
+
+  TransactionStatusManagerMock txn_status_manager;
+  auto txn = ASSERT_RESULT(FullyDecodeTransactionId("0000000000000001"));
+
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey1, KeyEntryValue::MakeColumnId(30_ColId)),
+      QLValue::Primitive("row1_c"), HybridTime::FromMicros(1000)));
+
+  SetCurrentTransactionId(txn);
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey1, KeyEntryValue::MakeColumnId(30_ColId)),
+      QLValue::Primitive("row1_c_t1"), HybridTime::FromMicros(1500)));
+  ResetCurrentTransactionId();
+  txn_status_manager.Commit(txn, HybridTime::FromMicros(1600));
+
+  const Schema &projection = kProjectionForIteratorTests;
+  const auto txn_context = TransactionOperationContext(
+      TransactionId::GenerateRandom(), &txn_status_manager);
+  DocReadContext doc_read_context(kSchemaForIteratorTests, 1);
+
+  auto read_c = [&]() -> Result<std::string> {
+    auto iter = VERIFY_RESULT(CreateIterator(
+        projection, doc_read_context, txn_context, doc_db(), CoarseTimePoint::max() /* deadline */,
+        ReadHybridTime::FromMicros(2000)));
+    SCHECK(VERIFY_RESULT(iter->HasNext()), IllegalState, "Row expected");
+    QLTableRow row;
+    RETURN_NOT_OK(iter->NextRow(&row));
+    QLValue value;
+    RETURN_NOT_OK(row.GetValue(projection.column_id(0), &value));
+    return value.string_value();
+  };
+
+  ASSERT_EQ(ASSERT_RESULT(read_c()), "row1_c_t1");
+
+  // When all running transactions started after the read time, intents DB is not used at all.
+  txn_status_manager.SetMinRunningHybridTime(HybridTime::FromMicros(3000));
+  ASSERT_EQ(ASSERT_RESULT(read_c()), "row1_c");
+
+  txn_status_manager.SetMinRunningHybridTime(HybridTime::kMax);
+  ASSERT_EQ(ASSERT_RESULT(read_c()), "row1_c");
+
+  // Min running hybrid time is not yet known.
+  txn_status_manager.SetMinRunningHybridTime(HybridTime::kInvalid);
+  ASSERT_EQ(ASSERT_RESULT(read_c()), "row1_c_t1");
+}
+
+void DocRowwiseIteratorTest::TestNextRowBatch() {
+  constexpr size_t kBatchSize = 4;
+  constexpr size_t kExpectedRows = 15;
+
+  InsertTestRangeData();
+  DocReadContext doc_read_context(test_range_schema, 1);
+
+  auto iter = ASSERT_RESULT(CreateIterator(
+      test_range_schema, doc_read_context, kNonTransactionalOperationContext, doc_db(),
+      CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000)));
+
+  std::vector<QLTableRow> rows(kBatchSize);
+  size_t total_rows = 0;
+  for (;;) {
+    auto num_rows = ASSERT_RESULT(iter->NextRowBatch(test_range_schema, &rows));
+    ASSERT_LE(num_rows, kBatchSize);
+    for (size_t i = 0; i != num_rows; ++i) {
+      QLValue value;
+      ASSERT_OK(rows[i].GetValue(test_range_schema.column_id(3), &value));
+      ASSERT_FALSE(value.IsNull());
+      ASSERT_GE(value.int32_value(), 4);
+      ASSERT_LT(value.int32_value(), 9);
+    }
+    total_rows += num_rows;
+    if (num_rows < kBatchSize) {
+      break;
+    }
+  }
+  ASSERT_EQ(total_rows, kExpectedRows);
+  ASSERT_FALSE(ASSERT_RESULT(iter->HasNext()));
+  ASSERT_EQ(ASSERT_RESULT(iter->NextRowBatch(test_range_schema, &rows)), 0);
+}
+
 void DocRowwiseIteratorTest::TestClusteredFilterRange() {
   InsertTestRangeData();
   DocReadContext doc_read_context(test_range_schema, 1);
@@ -1324,6 +1409,58 @@ SubDocKey(DocKey(ColocationId=16385, [], ["row1", 11111]), [SystemColumnId(0); \
   }
 }
 
+void DocRowwiseIteratorTest::TestColocatedRangeTombstone() {
+  constexpr ColocationId colocation_id(0x4001);
+  auto dwb = MakeDocWriteBatch();
+
+  std::vector<KeyBytes> row_keys;
+  for (const auto* encoded_doc_key : {&kEncodedDocKey1, &kEncodedDocKey2}) {
+    DocKey doc_key;
+    ASSERT_OK(doc_key.FullyDecodeFrom(encoded_doc_key->AsSlice()));
+    doc_key.set_colocation_id(colocation_id);
+    row_keys.push_back(doc_key.Encode());
+    ASSERT_OK(dwb.SetPrimitive(
+        DocPath(row_keys.back(), KeyEntryValue::kLivenessColumn),
+        ValueRef(ValueEntryType::kNullLow)));
+  }
+  ASSERT_OK(WriteToRocksDBAndClear(&dwb, HybridTime::FromMicros(1000)));
+
+  // Delete the first row only.
+  DocKey colocation_key(colocation_id);
+  ASSERT_OK(dwb.DeleteSubDoc(RangeTombstonePath(
+      colocation_key.Encode().AsSlice(), row_keys[0].AsSlice(), row_keys[1].AsSlice())));
+  ASSERT_OK(WriteToRocksDBAndClear(&dwb, HybridTime::FromMicros(2000)));
+
+  Schema schema_copy = kSchemaForIteratorTests;
+  schema_copy.set_colocation_id(colocation_id);
+  Schema projection;
+  DocReadContext doc_read_context(schema_copy, 1);
+
+  auto count_rows = [&](const ReadHybridTime& read_time) -> Result<size_t> {
+    auto iter = VERIFY_RESULT(CreateIterator(
+        projection, doc_read_context, kNonTransactionalOperationContext, doc_db(),
+        CoarseTimePoint::max() /* deadline */, read_time, nullptr));
+    size_t result = 0;
+    QLTableRow row;
+    while (VERIFY_RESULT(iter->HasNext())) {
+      RETURN_NOT_OK(iter->NextRow(&row));
+      ++result;
+    }
+    return result;
+  };
+
+  ASSERT_EQ(ASSERT_RESULT(count_rows(ReadHybridTime::FromMicros(1500))), 2);
+  ASSERT_EQ(ASSERT_RESULT(count_rows(ReadHybridTime::Max())), 1);
+
+  // Compaction removes deleted row together with the range tombstone.
+  FullyCompactHistoryBefore(HybridTime::FromMicros(3000));
+  ASSERT_DOCDB_DEBUG_DUMP_STR_EQ(R"#(
+SubDocKey(DocKey(ColocationId=16385, [], ["row2", 22222]), [SystemColumnId(0); \
+    HT{ physical: 1000 }]) -> null
+      )#");
+  ASSERT_EQ(ASSERT_RESULT(count_rows(ReadHybridTime::Max())), 1);
+}
+
 void DocRowwiseIteratorTest::TestDocRowwiseIteratorMultipleDeletes() {
   auto dwb = MakeDocWriteBatch();
 
@@ -2243,6 +2380,10 @@ TEST_F(DocRowwiseIteratorTest, ColocatedTableTombstoneTest) {
     TestColocatedTableTombstone();
 }
 
+TEST_F(DocRowwiseIteratorTest, ColocatedRangeTombstoneTest) {
+    TestColocatedRangeTombstone();
+}
+
 TEST_F(DocRowwiseIteratorTest, DocRowwiseIteratorMultipleDeletes) {
     TestDocRowwiseIteratorMultipleDeletes();
 }
@@ -2283,5 +2424,13 @@ TEST_F(DocRowwiseIteratorTest, DeletedDocumentUsingLivenessColumnDeleteTest) {
     TestDeletedDocumentUsingLivenessColumnDelete();
 }
 
+TEST_F(DocRowwiseIteratorTest, NextRowBatchTest) {
+    TestNextRowBatch();
+}
+
+TEST_F(DocRowwiseIteratorTest, SkipIntentsOfTransactionsStartedAfterReadTest) {
+    TestSkipIntentsOfTransactionsStartedAfterRead();
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -234,7 +234,8 @@ IntentAwareIterator::IntentAwareIterator(
     const rocksdb::ReadOptions& read_opts,
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time,
-    const TransactionOperationContext& txn_op_context)
+    const TransactionOperationContext& txn_op_context,
+    const boost::optional<const Slice>& intents_user_key_for_filter)
     : read_time_(read_time),
       encoded_read_time_read_(EncodeHybridTime(read_time_.read)),
       encoded_read_time_local_limit_(EncodeHybridTime(read_time_.local_limit)),
@@ -249,16 +250,28 @@ IntentAwareIterator::IntentAwareIterator(
           << ", txn_op_context: " << txn_op_context_;
 
   if (txn_op_context) {
-    if (txn_op_context.txn_status_manager->MinRunningHybridTime() != HybridTime::kMax) {
+    // Intents of transactions started after read_time.global_limit could not be visible to this
+    // read, nor cause read restart, since their commit time is greater than their start time.
+    // In particular, when there are no running transactions, MinRunningHybridTime is kMax.
+    // So intents DB iterator is not necessary in this case.
+    // Intents of transactions that were already applied to regular DB, but are kept for CDC,
+    // are not taken into account, since their values are read from regular DB.
+    auto min_running_ht = txn_op_context.txn_status_manager->MinRunningNotAppliedHybridTime();
+    if (min_running_ht != HybridTime::kMax &&
+        (!min_running_ht.is_valid() || min_running_ht <= read_time_.global_limit)) {
+      const auto bloom_filter_mode = intents_user_key_for_filter
+          ? docdb::BloomFilterMode::USE_BLOOM_FILTER
+          : docdb::BloomFilterMode::DONT_USE_BLOOM_FILTER;
       intent_iter_ = docdb::CreateRocksDBIterator(doc_db.intents,
                                                   doc_db.key_bounds,
-                                                  docdb::BloomFilterMode::DONT_USE_BLOOM_FILTER,
-                                                  boost::none,
+                                                  bloom_filter_mode,
+                                                  intents_user_key_for_filter,
                                                   rocksdb::kDefaultQueryId,
                                                   nullptr /* file_filter */,
                                                   &intent_upperbound_);
     } else {
-      VLOG(4) << "No transactions running";
+      VLOG(4) << "No transactions running before " << read_time_.global_limit
+              << ", min running: " << min_running_ht;
     }
   }
   // WARNING: Is is important for regular DB iterator to be created after intents DB iterator,
@@ -269,7 +282,14 @@ IntentAwareIterator::IntentAwareIterator(
   // 4) Transaction T1 is applied, k1->v1 is written into regular DB, intent k1->v1 is deleted.
   // 5) Intents DB iterator is created on an intents DB snapshot containing no intents for k1.
   // 6) Client reads no values for k1.
-  iter_ = BoundedRocksDbIterator(doc_db.regular, read_opts, doc_db.key_bounds);
+  if (intent_iter_.Initialized() && read_opts.table_stats_file_filter) {
+    // Intents could contain entries of rows from files skipped by table stats filter.
+    auto regular_read_opts = read_opts;
+    regular_read_opts.table_stats_file_filter = nullptr;
+    iter_ = BoundedRocksDbIterator(doc_db.regular, regular_read_opts, doc_db.key_bounds);
+  } else {
+    iter_ = BoundedRocksDbIterator(doc_db.regular, read_opts, doc_db.key_bounds);
+  }
   VTRACE(2, "Created iterator");
 }
 
@@ -644,7 +664,7 @@ Slice IntentAwareIterator::value() {
 
 void IntentAwareIterator::SeekForwardRegular(const Slice& slice) {
   VLOG(4) << "SeekForwardRegular(" << SubDocKey::DebugSliceToString(slice) << ")";
-  docdb::SeekForward(slice, &iter_);
+  docdb::SeekForward(slice, &iter_, &iter_policy_);
   skip_future_records_needed_ = true;
 }
 
@@ -740,7 +760,7 @@ void IntentAwareIterator::SeekForwardToSuitableIntent() {
     }
   }
 
-  docdb::SeekForward(seek_key_buffer_.AsSlice(), &intent_iter_);
+  docdb::SeekForward(seek_key_buffer_.AsSlice(), &intent_iter_, &intent_iter_policy_);
   SeekToSuitableIntent<Direction::kForward>();
 }
 
@@ -19,6 +19,7 @@
 #include "yb/common/read_hybrid_time.h"
 
 #include "yb/docdb/bounded_rocksdb_iterator.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent_aware_iterator_interface.h"
 #include "yb/docdb/key_bytes.h"
 #include "yb/docdb/transaction_status_cache.h"
@@ -60,7 +61,8 @@ class IntentAwareIterator : public IntentAwareIteratorIf {
       const rocksdb::ReadOptions& read_opts,
       CoarseTimePoint deadline,
       const ReadHybridTime& read_time,
-      const TransactionOperationContext& txn_op_context);
+      const TransactionOperationContext& txn_op_context,
+      const boost::optional<const Slice>& intents_user_key_for_filter = boost::none);
 
   IntentAwareIterator(const IntentAwareIterator& other) = delete;
   void operator=(const IntentAwareIterator& other) = delete;
@@ -284,6 +286,10 @@ class IntentAwareIterator : public IntentAwareIteratorIf {
   const TransactionOperationContext txn_op_context_;
   docdb::BoundedRocksDbIterator intent_iter_;
   docdb::BoundedRocksDbIterator iter_;
+  // Number of Next calls to try before Seek is adjusted separately for each iterator, since
+  // density of versions is different in regular and intents DB.
+  NextsToAvoidSeekPolicy intent_iter_policy_;
+  NextsToAvoidSeekPolicy iter_policy_;
   // iter_valid_ is true if and only if iter_ is positioned at key which matches top prefix from
   // the stack and record time satisfies read_time_ criteria.
   bool iter_valid_ = false;
@@ -0,0 +1,110 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "yb/docdb/intents_file_transactions.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+class IntentsFileTransactionsTest : public YBTest {
+ protected:
+  std::string ReverseIndexKey(const TransactionId& id) {
+    std::string result(1, KeyEntryTypeAsChar::kTransactionId);
+    result.append(id.AsSlice().cdata(), id.AsSlice().size());
+    result.append("write_id");
+    return result;
+  }
+
+  std::string IntentValue(const TransactionId& id) {
+    std::string result(1, ValueEntryTypeAsChar::kTransactionId);
+    result.append(id.AsSlice().cdata(), id.AsSlice().size());
+    result.append("value");
+    return result;
+  }
+
+  Result<boost::optional<std::vector<TransactionId>>> Finish(
+      IntentsFileTransactionsCollector* collector) {
+    rocksdb::TableProperties properties;
+    RETURN_NOT_OK(collector->Finish(&properties.user_collected_properties));
+    return IntentsFileTransactions(properties);
+  }
+};
+
+TEST_F(IntentsFileTransactionsTest, Collect) {
+  auto txn1 = TransactionId::GenerateRandom();
+  auto txn2 = TransactionId::GenerateRandom();
+  auto txn3 = TransactionId::GenerateRandom();
+
+  IntentsFileTransactionsCollector collector(10);
+  ASSERT_OK(collector.AddUserKey(
+      ReverseIndexKey(txn1), "intent_key", rocksdb::kEntryPut, 1, 0));
+  ASSERT_OK(collector.AddUserKey("doc_key_1", IntentValue(txn1), rocksdb::kEntryPut, 2, 0));
+  ASSERT_OK(collector.AddUserKey("doc_key_2", IntentValue(txn2), rocksdb::kEntryPut, 3, 0));
+  // Delete markers are not attributed to transactions.
+  ASSERT_OK(collector.AddUserKey(ReverseIndexKey(txn3), "", rocksdb::kEntryDelete, 4, 0));
+
+  auto transactions = ASSERT_RESULT(Finish(&collector));
+  ASSERT_TRUE(transactions);
+  std::vector<TransactionId> expected = {txn1, txn2};
+  std::sort(expected.begin(), expected.end());
+  ASSERT_EQ(*transactions, expected);
+}
+
+TEST_F(IntentsFileTransactionsTest, Untracked) {
+  auto txn1 = TransactionId::GenerateRandom();
+  auto txn2 = TransactionId::GenerateRandom();
+
+  {
+    // Too many transactions.
+    IntentsFileTransactionsCollector collector(1);
+    ASSERT_OK(collector.AddUserKey("doc_key_1", IntentValue(txn1), rocksdb::kEntryPut, 1, 0));
+    ASSERT_OK(collector.AddUserKey("doc_key_2", IntentValue(txn2), rocksdb::kEntryPut, 2, 0));
+    ASSERT_FALSE(ASSERT_RESULT(Finish(&collector)));
+  }
+
+  {
+    // Value without transaction id.
+    IntentsFileTransactionsCollector collector(10);
+    ASSERT_OK(collector.AddUserKey("doc_key_1", "value", rocksdb::kEntryPut, 1, 0));
+    ASSERT_FALSE(ASSERT_RESULT(Finish(&collector)));
+  }
+
+  {
+    // External intents.
+    IntentsFileTransactionsCollector collector(10);
+    std::string key(1, KeyEntryTypeAsChar::kExternalTransactionId);
+    ASSERT_OK(collector.AddUserKey(key, "value", rocksdb::kEntryPut, 1, 0));
+    ASSERT_FALSE(ASSERT_RESULT(Finish(&collector)));
+  }
+
+  {
+    // Tracking disabled.
+    IntentsFileTransactionsCollector collector(0);
+    ASSERT_OK(collector.AddUserKey("doc_key_1", IntentValue(txn1), rocksdb::kEntryPut, 1, 0));
+    ASSERT_FALSE(ASSERT_RESULT(Finish(&collector)));
+  }
+
+  // File written without collector.
+  ASSERT_FALSE(ASSERT_RESULT(IntentsFileTransactions(rocksdb::TableProperties())));
+}
+
+}  // namespace docdb
+}  // namespace yb
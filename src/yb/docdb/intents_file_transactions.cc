@@ -0,0 +1,155 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/intents_file_transactions.h"
+
+#include <algorithm>
+
+#include "yb/docdb/intent.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/logging.h"
+#include "yb/util/result.h"
+#include "yb/util/status_format.h"
+
+DEFINE_RUNTIME_uint64(intents_sst_max_tracked_transactions, 10000,
+                      "Max number of transactions, whose ids are stored in table properties of "
+                      "intents SST file. Files with more transactions are deleted only when "
+                      "all transactions started before their last write are finished. "
+                      "0 disables tracking.");
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+const std::string kIntentsFileTransactionsPropertyName = "yb.docdb.intents_file_transactions";
+
+class IntentsFileTransactionsCollectorFactory : public rocksdb::TablePropertiesCollectorFactory {
+ public:
+  rocksdb::TablePropertiesCollector* CreateTablePropertiesCollector(
+      rocksdb::TablePropertiesCollectorFactory::Context context) override {
+    // Flag is read once per file, so the limit could not change while the file is written.
+    return new IntentsFileTransactionsCollector(
+        GetAtomicFlag(&FLAGS_intents_sst_max_tracked_transactions));
+  }
+
+  const char* Name() const override {
+    return "IntentsFileTransactionsCollectorFactory";
+  }
+};
+
+} // namespace
+
+IntentsFileTransactionsCollector::IntentsFileTransactionsCollector(size_t max_transactions)
+    : max_transactions_(max_transactions), untracked_(max_transactions == 0) {
+}
+
+Status IntentsFileTransactionsCollector::AddUserKey(
+    const Slice& key, const Slice& value, rocksdb::EntryType type, rocksdb::SequenceNumber seq,
+    uint64_t file_size) {
+  if (untracked_ || type != rocksdb::kEntryPut) {
+    return Status::OK();
+  }
+  auto status = DoAddUserKey(key, value);
+  if (!status.ok()) {
+    // Transactions are optional, so don't fail flush or compaction because of them.
+    YB_LOG_EVERY_N_SECS(WARNING, 60)
+        << "Failed to collect transaction of " << key.ToDebugHexString() << ": " << status;
+    untracked_ = true;
+  }
+  return Status::OK();
+}
+
+Status IntentsFileTransactionsCollector::DoAddUserKey(Slice key, Slice value) {
+  if (key.empty()) {
+    return STATUS(Corruption, "Empty intents DB key");
+  }
+  TransactionId transaction_id = TransactionId::Nil();
+  switch (static_cast<KeyEntryType>(key[0])) {
+    case KeyEntryType::kTransactionId: FALLTHROUGH_INTENDED;
+    case KeyEntryType::kTransactionApplyState:
+      // Transaction metadata, reverse index record or apply state.
+      key.consume_byte();
+      transaction_id = VERIFY_RESULT(DecodeTransactionId(&key));
+      break;
+    case KeyEntryType::kExternalTransactionId:
+      // External intents are cleaned up by time, so such file could not be tracked.
+      untracked_ = true;
+      return Status::OK();
+    default:
+      // Intent record, that contains transaction id in its value.
+      transaction_id = VERIFY_RESULT(DecodeTransactionIdFromIntentValue(&value));
+      break;
+  }
+  if (transactions_.insert(transaction_id).second && transactions_.size() > max_transactions_) {
+    untracked_ = true;
+    transactions_.clear();
+  }
+  return Status::OK();
+}
+
+Status IntentsFileTransactionsCollector::Finish(rocksdb::UserCollectedProperties* properties) {
+  if (untracked_) {
+    return Status::OK();
+  }
+  std::vector<TransactionId> ids(transactions_.begin(), transactions_.end());
+  std::sort(ids.begin(), ids.end());
+  std::string encoded;
+  encoded.reserve(ids.size() * TransactionId::StaticSize());
+  for (const auto& id : ids) {
+    encoded.append(id.AsSlice().cdata(), id.AsSlice().size());
+  }
+  properties->emplace(kIntentsFileTransactionsPropertyName, std::move(encoded));
+  return Status::OK();
+}
+
+rocksdb::UserCollectedProperties IntentsFileTransactionsCollector::GetReadableProperties() const {
+  rocksdb::UserCollectedProperties result;
+  if (!untracked_) {
+    result.emplace(kIntentsFileTransactionsPropertyName, std::to_string(transactions_.size()));
+  }
+  return result;
+}
+
+const char* IntentsFileTransactionsCollector::Name() const {
+  return "IntentsFileTransactionsCollector";
+}
+
+std::shared_ptr<rocksdb::TablePropertiesCollectorFactory>
+    CreateIntentsFileTransactionsCollectorFactory() {
+  return std::make_shared<IntentsFileTransactionsCollectorFactory>();
+}
+
+Result<boost::optional<std::vector<TransactionId>>> IntentsFileTransactions(
+    const rocksdb::TableProperties& properties) {
+  auto it = properties.user_collected_properties.find(kIntentsFileTransactionsPropertyName);
+  if (it == properties.user_collected_properties.end()) {
+    return boost::none;
+  }
+  Slice encoded(it->second);
+  if (encoded.size() % TransactionId::StaticSize() != 0) {
+    return STATUS_FORMAT(
+        Corruption, "Wrong size of intents file transactions: $0", encoded.size());
+  }
+  std::vector<TransactionId> result;
+  result.reserve(encoded.size() / TransactionId::StaticSize());
+  while (!encoded.empty()) {
+    result.push_back(VERIFY_RESULT(DecodeTransactionId(&encoded)));
+  }
+  return result;
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,70 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Set of transactions, whose records are stored in intents SST file. Collected to table properties
+// by flush and compaction. Used to delete the whole file, when all of those transactions were
+// applied or aborted.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "yb/common/transaction.h"
+
+#include "yb/rocksdb/table_properties.h"
+
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+namespace docdb {
+
+// Collects ids of transactions, whose intents, reverse index and metadata records are stored in
+// the file. Delete markers are not taken into account, since dropping them together with the file
+// does not affect older files. When the file has records that could not be attributed to a
+// transaction, or too many transactions, the property is not written.
+class IntentsFileTransactionsCollector : public rocksdb::TablePropertiesCollector {
+ public:
+  explicit IntentsFileTransactionsCollector(size_t max_transactions);
+
+  Status AddUserKey(
+      const Slice& key, const Slice& value, rocksdb::EntryType type, rocksdb::SequenceNumber seq,
+      uint64_t file_size) override;
+
+  Status Finish(rocksdb::UserCollectedProperties* properties) override;
+
+  rocksdb::UserCollectedProperties GetReadableProperties() const override;
+
+  const char* Name() const override;
+
+ private:
+  Status DoAddUserKey(Slice key, Slice value);
+
+  const size_t max_transactions_;
+  TransactionIdSet transactions_;
+  bool untracked_ = false;
+};
+
+std::shared_ptr<rocksdb::TablePropertiesCollectorFactory>
+    CreateIntentsFileTransactionsCollectorFactory();
+
+// Returns transactions of the intents SST file with specified properties.
+// Returns boost::none when file does not have such information, so it could contain records of
+// any transaction.
+Result<boost::optional<std::vector<TransactionId>>> IntentsFileTransactions(
+    const rocksdb::TableProperties& properties);
+
+}  // namespace docdb
+}  // namespace yb
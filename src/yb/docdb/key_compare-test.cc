@@ -0,0 +1,155 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Correctness checks and microbenchmark for comparison of encoded DocDB keys.
+// All key comparisons in DocDB (RocksDB bytewise comparator, scan choices, iterator bounds)
+// end up in Slice::compare/operator==, so this test measures them on realistic YSQL key shapes.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "yb/common/doc_hybrid_time.h"
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/key_bytes.h"
+
+#include "yb/util/monotime.h"
+#include "yb/util/random_util.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+#include "yb/util/tsan_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+enum class KeyShape {
+  // hash (int4), range (int8), column id, hybrid time.
+  kHashInt,
+  // hash (text), range (text, int4), column id, hybrid time.
+  kHashTextRangeText,
+  // colocated table: colocation id, range (text), column id, hybrid time.
+  kColocatedRangeText,
+};
+
+constexpr size_t kNumGroups = 64;
+
+std::string RandomText(size_t len) {
+  return RandomHumanReadableString(len);
+}
+
+// Generates keys that share long common prefixes, like keys of adjacent rows and columns do.
+std::vector<KeyBytes> GenerateKeys(KeyShape shape, size_t num_keys) {
+  std::vector<std::string> group_prefixes;
+  for (size_t i = 0; i != kNumGroups; ++i) {
+    group_prefixes.push_back("tenant_" + RandomText(16));
+  }
+
+  std::vector<KeyBytes> result;
+  result.reserve(num_keys);
+  for (size_t i = 0; i != num_keys; ++i) {
+    auto group = RandomUniformInt<size_t>(0, kNumGroups - 1);
+    DocKey doc_key;
+    switch (shape) {
+      case KeyShape::kHashInt:
+        doc_key = DocKey(
+            static_cast<DocKeyHash>(group), {KeyEntryValue::Int32(static_cast<int32_t>(group))},
+            {KeyEntryValue::Int64(RandomUniformInt<int64_t>(0, 1000000))});
+        break;
+      case KeyShape::kHashTextRangeText:
+        doc_key = DocKey(
+            static_cast<DocKeyHash>(group), {KeyEntryValue(group_prefixes[group])},
+            {KeyEntryValue(group_prefixes[group] + "/" + RandomText(8)),
+             KeyEntryValue::Int32(RandomUniformInt<int32_t>(0, 100))});
+        break;
+      case KeyShape::kColocatedRangeText:
+        doc_key = DocKey(ColocationId(16384), /* hash= */ 0, {},
+                         {KeyEntryValue(group_prefixes[group] + "/" + RandomText(24))});
+        break;
+    }
+    SubDocKey sub_doc_key(
+        doc_key, KeyEntryValue::MakeColumnId(ColumnId(RandomUniformInt(11, 20))),
+        HybridTime::FromMicros(RandomUniformInt<uint64_t>(1, 1000000)));
+    result.push_back(sub_doc_key.Encode());
+  }
+  return result;
+}
+
+int Sign(int value) {
+  return (value > 0) - (value < 0);
+}
+
+void CheckCompare(KeyShape shape) {
+  auto keys = GenerateKeys(shape, 1000);
+  for (size_t i = 0; i != 100000; ++i) {
+    const auto& lhs = RandomElement(keys);
+    auto rhs = RandomElement(keys).AsSlice();
+    // Also compare with prefixes, to check prefix and bound checks.
+    rhs = rhs.Prefix(RandomUniformInt<size_t>(0, rhs.size()));
+    auto lhs_str = lhs.ToStringBuffer();
+    auto rhs_str = rhs.ToBuffer();
+    ASSERT_EQ(Sign(lhs.AsSlice().compare(rhs)), Sign(lhs_str.compare(rhs_str)))
+        << lhs.AsSlice().ToDebugHexString() << " vs " << rhs.ToDebugHexString();
+    ASSERT_EQ(lhs.AsSlice() == rhs, lhs_str == rhs_str);
+    ASSERT_EQ(lhs.AsSlice().starts_with(rhs), lhs_str.starts_with(rhs_str));
+  }
+}
+
+void MeasureCompare(KeyShape shape) {
+  const size_t kNumKeys = 4096;
+  const size_t kNumComparisons = RegularBuildVsSanitizers(20000000, 200000);
+  auto keys = GenerateKeys(shape, kNumKeys);
+  std::sort(keys.begin(), keys.end());
+
+  std::vector<Slice> slices;
+  slices.reserve(keys.size());
+  for (const auto& key : keys) {
+    slices.push_back(key.AsSlice());
+  }
+
+  // Compare neighbours of the sorted sequence, like merging iterators and binary search do.
+  int64_t checksum = 0;
+  auto start = MonoTime::Now();
+  for (size_t i = 0; i != kNumComparisons; ++i) {
+    auto idx = i % (kNumKeys - 1);
+    checksum += slices[idx].compare(slices[idx + 1]);
+  }
+  auto passed = MonoTime::Now() - start;
+  LOG(INFO) << "Shape " << static_cast<int>(shape) << ", avg key size: "
+            << keys.front().size() << ", comparisons: " << kNumComparisons << ", time: "
+            << passed << ", comparisons per second: "
+            << kNumComparisons / passed.ToSeconds() << ", checksum: " << checksum;
+}
+
+} // namespace
+
+TEST(KeyCompareTest, Correctness) {
+  for (auto shape : {KeyShape::kHashInt, KeyShape::kHashTextRangeText,
+                     KeyShape::kColocatedRangeText}) {
+    ASSERT_NO_FATALS(CheckCompare(shape));
+  }
+}
+
+TEST(KeyCompareTest, Performance) {
+  for (auto shape : {KeyShape::kHashInt, KeyShape::kHashTextRangeText,
+                     KeyShape::kColocatedRangeText}) {
+    MeasureCompare(shape);
+  }
+}
+
+}  // namespace docdb
+}  // namespace yb
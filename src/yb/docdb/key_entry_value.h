@@ -42,7 +42,8 @@ class KeyEntryValue;
 using FrozenContainer = std::vector<KeyEntryValue>;
 
 enum class SystemColumnIds : ColumnIdRep {
-  kLivenessColumn = 0  // Stores the TTL for QL rows inserted using an INSERT statement.
+  kLivenessColumn = 0,  // Stores the TTL for QL rows inserted using an INSERT statement.
+  kRangeTombstone = 1,  // Subkey of table doc key, that stores range tombstones of the table.
 };
 
 class KeyEntryValue {
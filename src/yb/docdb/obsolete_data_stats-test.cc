@@ -0,0 +1,129 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <string>
+
+#include "yb/common/doc_hybrid_time.h"
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/obsolete_data_stats.h"
+#include "yb/docdb/value.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/util/kv_util.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+class ObsoleteDataStatsTest : public YBTest {
+ protected:
+  std::string Key(const std::string& doc_key, MicrosTime micros) {
+    std::string result = doc_key;
+    result.push_back(KeyEntryTypeAsChar::kHybridTime);
+    DocHybridTime(HybridTime::FromMicros(micros)).AppendEncodedInDocDbFormat(&result);
+    return result;
+  }
+
+  std::string Value(MonoDelta ttl = ValueControlFields::kMaxTtl) {
+    ValueBuffer buffer;
+    ValueControlFields control_fields;
+    control_fields.ttl = ttl;
+    control_fields.AppendEncoded(&buffer);
+    std::string result = buffer.ToStringBuffer();
+    result.push_back(ValueEntryTypeAsChar::kString);
+    result.append("value");
+    return result;
+  }
+
+  Result<std::optional<ObsoleteDataStatsPB>> Finish(ObsoleteDataStatsCollector* collector) {
+    rocksdb::TableProperties properties;
+    RETURN_NOT_OK(collector->Finish(&properties.user_collected_properties));
+    return ObsoleteDataStats(properties);
+  }
+};
+
+TEST_F(ObsoleteDataStatsTest, Collect) {
+  const std::string tombstone(1, ValueEntryTypeAsChar::kTombstone);
+  ObsoleteDataStatsCollector collector(
+      ValueControlFields::kMaxTtl, HybridTime::FromMicros(10000000));
+
+  // Live entry, and its version overwritten by it.
+  ASSERT_OK(collector.AddUserKey(Key("key_1", 3000000), Value(), rocksdb::kEntryPut, 1, 0));
+  ASSERT_OK(collector.AddUserKey(Key("key_1", 2000000), Value(), rocksdb::kEntryPut, 2, 0));
+  // Tombstone, that overwrites older version.
+  ASSERT_OK(collector.AddUserKey(Key("key_2", 4000000), tombstone, rocksdb::kEntryPut, 3, 0));
+  ASSERT_OK(collector.AddUserKey(Key("key_2", 1000000), Value(), rocksdb::kEntryPut, 4, 0));
+  // Expired and not yet expired entries.
+  ASSERT_OK(collector.AddUserKey(
+      Key("key_3", 1000000), Value(MonoDelta::FromSeconds(1)), rocksdb::kEntryPut, 5, 0));
+  ASSERT_OK(collector.AddUserKey(
+      Key("key_4", 1000000), Value(MonoDelta::FromSeconds(100)), rocksdb::kEntryPut, 6, 0));
+
+  auto stats = ASSERT_RESULT(Finish(&collector));
+  ASSERT_TRUE(stats);
+  ASSERT_EQ(stats->tombstone_count(), 1);
+  ASSERT_EQ(stats->overwritten_count(), 2);
+  ASSERT_EQ(stats->expired_count(), 1);
+  ASSERT_GT(stats->total_bytes(),
+            stats->tombstone_bytes() + stats->overwritten_bytes() + stats->expired_bytes());
+  ASSERT_EQ(HybridTime(stats->max_obsolete_ht()), HybridTime::FromMicros(4000000));
+}
+
+TEST_F(ObsoleteDataStatsTest, CountRows) {
+  const std::string tombstone(1, ValueEntryTypeAsChar::kTombstone);
+  ObsoleteDataStatsCollector collector(
+      ValueControlFields::kMaxTtl, HybridTime::FromMicros(10000000));
+  auto row_key = [](const std::string& key) {
+    return DocKey({ KeyEntryValue(key) }).Encode().ToStringBuffer();
+  };
+  auto column_key = [](const std::string& key) {
+    return SubDocKey(DocKey({ KeyEntryValue(key) }), KeyEntryValue::MakeColumnId(ColumnId(1)))
+        .EncodeWithoutHt().ToStringBuffer();
+  };
+
+  // Row with several columns.
+  ASSERT_OK(collector.AddUserKey(Key(row_key("a"), 2000000), Value(), rocksdb::kEntryPut, 1, 0));
+  ASSERT_OK(collector.AddUserKey(
+      Key(column_key("a"), 3000000), Value(), rocksdb::kEntryPut, 2, 0));
+  ASSERT_OK(collector.AddUserKey(
+      Key(column_key("a"), 1000000), Value(), rocksdb::kEntryPut, 3, 0));
+  // Deleted row.
+  ASSERT_OK(collector.AddUserKey(Key(row_key("b"), 4000000), tombstone, rocksdb::kEntryPut, 4, 0));
+  ASSERT_OK(collector.AddUserKey(Key(row_key("b"), 3000000), Value(), rocksdb::kEntryPut, 5, 0));
+  // Row having only column update in this file.
+  ASSERT_OK(collector.AddUserKey(
+      Key(column_key("c"), 3000000), Value(), rocksdb::kEntryPut, 6, 0));
+
+  auto stats = ASSERT_RESULT(Finish(&collector));
+  ASSERT_TRUE(stats);
+  ASSERT_EQ(stats->doc_key_count(), 3);
+  ASSERT_EQ(stats->deleted_doc_key_count(), 1);
+}
+
+TEST_F(ObsoleteDataStatsTest, Untracked) {
+  {
+    // Key without hybrid time.
+    ObsoleteDataStatsCollector collector(
+        ValueControlFields::kMaxTtl, HybridTime::FromMicros(10000000));
+    ASSERT_OK(collector.AddUserKey("", Value(), rocksdb::kEntryPut, 1, 0));
+    ASSERT_FALSE(ASSERT_RESULT(Finish(&collector)));
+  }
+
+  // File written without collector.
+  ASSERT_FALSE(ASSERT_RESULT(ObsoleteDataStats(rocksdb::TableProperties())));
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,182 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/obsolete_data_stats.h"
+
+#include "yb/common/doc_hybrid_time.h"
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_ttl_util.h"
+#include "yb/docdb/value.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/gutil/walltime.h"
+
+#include "yb/server/hybrid_clock.h"
+
+#include "yb/util/logging.h"
+#include "yb/util/result.h"
+#include "yb/util/status_format.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+const std::string kObsoleteDataStatsPropertyName = "yb.docdb.obsolete_data_stats";
+
+class ObsoleteDataStatsCollectorFactory : public rocksdb::TablePropertiesCollectorFactory {
+ public:
+  explicit ObsoleteDataStatsCollectorFactory(TableTTLProvider table_ttl_provider)
+      : table_ttl_provider_(std::move(table_ttl_provider)) {}
+
+  rocksdb::TablePropertiesCollector* CreateTablePropertiesCollector(
+      rocksdb::TablePropertiesCollectorFactory::Context context) override {
+    return new ObsoleteDataStatsCollector(
+        table_ttl_provider_(), HybridTime::FromMicros(GetCurrentTimeMicros()));
+  }
+
+  const char* Name() const override {
+    return "ObsoleteDataStatsCollectorFactory";
+  }
+
+ private:
+  TableTTLProvider table_ttl_provider_;
+};
+
+} // namespace
+
+ObsoleteDataStatsCollector::ObsoleteDataStatsCollector(MonoDelta table_ttl, HybridTime now)
+    : table_ttl_(table_ttl), now_(now) {
+}
+
+Status ObsoleteDataStatsCollector::AddUserKey(
+    const Slice& key, const Slice& value, rocksdb::EntryType type, rocksdb::SequenceNumber seq,
+    uint64_t file_size) {
+  if (failed_) {
+    return Status::OK();
+  }
+  stats_.set_total_bytes(stats_.total_bytes() + key.size() + value.size());
+  if (type != rocksdb::kEntryPut) {
+    return Status::OK();
+  }
+  auto status = DoAddUserKey(key, value);
+  if (!status.ok()) {
+    // Stats are optional, so don't fail flush or compaction because of them.
+    YB_LOG_EVERY_N_SECS(WARNING, 60)
+        << "Failed to collect obsolete data stats of " << key.ToDebugHexString() << ": "
+        << status;
+    failed_ = true;
+  }
+  return Status::OK();
+}
+
+Status ObsoleteDataStatsCollector::DoAddUserKey(Slice key, Slice value) {
+  auto entry_bytes = key.size() + value.size();
+  auto doc_ht = VERIFY_RESULT(DocHybridTime::DecodeFromEnd(&key));
+  auto control_fields = VERIFY_RESULT(ValueControlFields::Decode(&value));
+  CountRow(key, value);
+  bool overwritten = prev_overwrites_ && key == Slice(prev_key_);
+  auto overwriting_ht = prev_ht_;
+
+  // Versions of the same key are ordered from the newest to the oldest.
+  prev_key_.assign(key.cdata(), key.size());
+  prev_ht_ = doc_ht.hybrid_time();
+  prev_overwrites_ = control_fields.merge_flags != ValueControlFields::kTtlFlag;
+
+  if (overwritten) {
+    stats_.set_overwritten_count(stats_.overwritten_count() + 1);
+    stats_.set_overwritten_bytes(stats_.overwritten_bytes() + entry_bytes);
+    AddObsolete(overwriting_ht);
+    return Status::OK();
+  }
+
+  if (!value.empty() && DecodeValueEntryType(value[0]) == ValueEntryType::kTombstone) {
+    stats_.set_tombstone_count(stats_.tombstone_count() + 1);
+    stats_.set_tombstone_bytes(stats_.tombstone_bytes() + entry_bytes);
+    AddObsolete(doc_ht.hybrid_time());
+    return Status::OK();
+  }
+
+  auto ttl = ComputeTTL(control_fields.ttl, table_ttl_);
+  if (HasExpiredTTL(doc_ht.hybrid_time(), ttl, now_)) {
+    stats_.set_expired_count(stats_.expired_count() + 1);
+    stats_.set_expired_bytes(stats_.expired_bytes() + entry_bytes);
+    AddObsolete(server::HybridClock::AddPhysicalTimeToHybridTime(doc_ht.hybrid_time(), ttl));
+  }
+  return Status::OK();
+}
+
+void ObsoleteDataStatsCollector::CountRow(Slice key, Slice value) {
+  auto doc_key_size = DocKey::EncodedSize(key, DocKeyPart::kWholeDocKey);
+  if (!doc_key_size.ok()) {
+    return;
+  }
+  auto doc_key = key.Prefix(*doc_key_size);
+  if (doc_key == Slice(prev_doc_key_)) {
+    return;
+  }
+  prev_doc_key_.assign(doc_key.cdata(), doc_key.size());
+  stats_.set_doc_key_count(stats_.doc_key_count() + 1);
+  // Row level entry of the doc key sorts before its sub keys, and its newest version goes first.
+  if (key.size() == doc_key.size() && !value.empty() &&
+      DecodeValueEntryType(value[0]) == ValueEntryType::kTombstone) {
+    stats_.set_deleted_doc_key_count(stats_.deleted_doc_key_count() + 1);
+  }
+}
+
+void ObsoleteDataStatsCollector::AddObsolete(HybridTime removable_ht) {
+  max_obsolete_ht_.MakeAtLeast(removable_ht);
+}
+
+Status ObsoleteDataStatsCollector::Finish(rocksdb::UserCollectedProperties* properties) {
+  if (failed_) {
+    return Status::OK();
+  }
+  stats_.set_max_obsolete_ht(max_obsolete_ht_.ToUint64());
+  properties->emplace(kObsoleteDataStatsPropertyName, stats_.SerializeAsString());
+  return Status::OK();
+}
+
+rocksdb::UserCollectedProperties ObsoleteDataStatsCollector::GetReadableProperties() const {
+  rocksdb::UserCollectedProperties result;
+  if (!failed_) {
+    result.emplace(kObsoleteDataStatsPropertyName, stats_.ShortDebugString());
+  }
+  return result;
+}
+
+const char* ObsoleteDataStatsCollector::Name() const {
+  return "ObsoleteDataStatsCollector";
+}
+
+std::shared_ptr<rocksdb::TablePropertiesCollectorFactory> CreateObsoleteDataStatsCollectorFactory(
+    TableTTLProvider table_ttl_provider) {
+  return std::make_shared<ObsoleteDataStatsCollectorFactory>(std::move(table_ttl_provider));
+}
+
+Result<std::optional<ObsoleteDataStatsPB>> ObsoleteDataStats(
+    const rocksdb::TableProperties& properties) {
+  auto it = properties.user_collected_properties.find(kObsoleteDataStatsPropertyName);
+  if (it == properties.user_collected_properties.end()) {
+    return std::nullopt;
+  }
+  ObsoleteDataStatsPB result;
+  if (!result.ParseFromString(it->second)) {
+    return STATUS(Corruption, "Failed to parse obsolete data stats");
+  }
+  return result;
+}
+
+}  // namespace docdb
+}  // namespace yb
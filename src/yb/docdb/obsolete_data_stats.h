@@ -0,0 +1,92 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Estimate of obsolete data stored in regular DB SST file: tombstones, overwritten versions and
+// entries with expired TTL. Collected to table properties by flush and compaction. Used to
+// schedule full compactions on tablets, where they could free noticeable amount of space.
+// Also counts rows that have entries in the file, used to estimate number of rows in the tablet.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "yb/common/hybrid_time.h"
+
+#include "yb/docdb/docdb.pb.h"
+
+#include "yb/rocksdb/table_properties.h"
+
+#include "yb/util/monotime.h"
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+namespace docdb {
+
+// Provides default TTL of the table, that is used for entries without TTL in value.
+using TableTTLProvider = std::function<MonoDelta()>;
+
+// Counts entries of the file that could be removed by full compaction. Only versions overwritten
+// in the same file are taken into account, since older files are not visible to the collector.
+// When some entry could not be decoded, the property is not written.
+class ObsoleteDataStatsCollector : public rocksdb::TablePropertiesCollector {
+ public:
+  // Entries whose TTL expires before now are considered expired.
+  ObsoleteDataStatsCollector(MonoDelta table_ttl, HybridTime now);
+
+  Status AddUserKey(
+      const Slice& key, const Slice& value, rocksdb::EntryType type, rocksdb::SequenceNumber seq,
+      uint64_t file_size) override;
+
+  Status Finish(rocksdb::UserCollectedProperties* properties) override;
+
+  rocksdb::UserCollectedProperties GetReadableProperties() const override;
+
+  const char* Name() const override;
+
+ private:
+  Status DoAddUserKey(Slice key, Slice value);
+
+  // Accounts row of the entry with specified key without hybrid time. Entries that do not start
+  // with a doc key are not accounted.
+  void CountRow(Slice key, Slice value);
+
+  // Accounts obsolete entry, that could be removed when history cutoff is above removable_ht.
+  void AddObsolete(HybridTime removable_ht);
+
+  const MonoDelta table_ttl_;
+  const HybridTime now_;
+  ObsoleteDataStatsPB stats_;
+  HybridTime max_obsolete_ht_ = HybridTime::kMin;
+  // Key of the previous entry without its hybrid time, and hybrid time of that entry.
+  std::string prev_key_;
+  HybridTime prev_ht_;
+  // Whether previous entry overwrites older versions of its key, i.e. it is not TTL only update.
+  bool prev_overwrites_ = false;
+  // Doc key of the previous entry.
+  std::string prev_doc_key_;
+  bool failed_ = false;
+};
+
+std::shared_ptr<rocksdb::TablePropertiesCollectorFactory> CreateObsoleteDataStatsCollectorFactory(
+    TableTTLProvider table_ttl_provider);
+
+// Returns obsolete data stats of the SST file with specified properties, or nullopt when file
+// does not have such information.
+Result<std::optional<ObsoleteDataStatsPB>> ObsoleteDataStats(
+    const rocksdb::TableProperties& properties);
+
+}  // namespace docdb
+}  // namespace yb
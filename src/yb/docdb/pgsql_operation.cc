@@ -13,7 +13,10 @@
 
 #include "yb/docdb/pgsql_operation.h"
 
+#include <algorithm>
 #include <limits>
+#include <numeric>
+#include <optional>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -24,6 +27,7 @@
 #include "yb/common/pg_system_attr.h"
 #include "yb/common/ql_value.h"
 
+#include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_path.h"
 #include "yb/docdb/doc_pg_expr.h"
 #include "yb/docdb/doc_pgsql_scanspec.h"
@@ -37,6 +41,7 @@
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/docdb/packed_row.h"
 #include "yb/docdb/primitive_value_util.h"
+#include "yb/docdb/range_tombstones.h"
 #include "yb/docdb/ql_storage_interface.h"
 
 #include "yb/util/algorithm_util.h"
@@ -85,6 +90,20 @@ DEFINE_uint64(
     ysql_packed_row_size_limit, 0,
     "Packed row size limit for YSQL in bytes. 0 to make this equal to SSTable block size.");
 
+DEFINE_uint64(ysql_aggregate_scan_batch_size, 128,
+              "Number of rows read from the iterator per call while evaluating pushed down "
+              "aggregates. Set to 0 or 1 to read rows one by one.");
+
+DEFINE_bool(ysql_sort_batched_ybctid_reads, true,
+            "Whether to read rows of batched ybctid request in the order of ybctids, so "
+            "consecutive reads access neighbouring blocks of SST files. Rows are returned in the "
+            "order of the request anyway.");
+
+DEFINE_uint64(ysql_sampling_max_skip_keys, 10000,
+              "Max number of keys dividing the largest SST file of a tablet into parts, that are "
+              "used by ANALYZE sampling to skip whole parts of the tablet instead of reading all "
+              "the rows. Set to 0 to read all the rows.");
+
 DEFINE_test_flag(bool, ysql_suppress_ybctid_corruption_details, false,
                  "Whether to show less details on ybctid corruption error status message.  Useful "
                  "during tests that require consistent output.");
@@ -167,21 +186,24 @@ Result<R> FetchDocKeyImpl(const Schema& schema,
   }
 }
 
-Result<string> FetchEncodedDocKey(const Schema& schema, const PgsqlReadRequestPB& request) {
-  return FetchDocKeyImpl<string>(
+// ybctid is already encoded doc key, so it is only validated instead of being decoded and encoded
+// back.
+Result<RefCntPrefix> FetchEncodedDocKey(const Schema& schema, const PgsqlWriteRequestPB& request) {
+  return FetchDocKeyImpl<RefCntPrefix>(
       schema, request,
-      [](const auto& doc_key) { return doc_key.Encode().ToStringBuffer(); },
-      [](const auto& encoded_doc_key) { return encoded_doc_key; });
-}
-
-Result<DocKey> FetchDocKey(const Schema& schema, const PgsqlWriteRequestPB& request) {
-  return FetchDocKeyImpl<DocKey>(
-      schema, request,
-      [](const auto& doc_key) { return doc_key; },
-      [&schema](const auto& encoded_doc_key) -> Result<DocKey> {
-        DocKey key(schema);
-        RETURN_NOT_OK(key.DecodeFrom(encoded_doc_key));
-        return key;
+      [](const auto& doc_key) { return doc_key.EncodeAsRefCntPrefix(); },
+      [&schema](const auto& ybctid) -> Result<RefCntPrefix> {
+        Slice ybctid_slice(ybctid);
+        KeyBytes encoded_doc_key;
+        // ybctid does not contain cotable id / colocation id, they are taken from the schema.
+        if (!ybctid_slice.starts_with(KeyEntryTypeAsChar::kTableId) &&
+            !ybctid_slice.starts_with(KeyEntryTypeAsChar::kColocationId)) {
+          DocKeyEncoder(&encoded_doc_key).Schema(schema);
+        }
+        encoded_doc_key.AppendRawBytes(ybctid_slice);
+        auto size = VERIFY_RESULT(DocKey::EncodedSize(
+            encoded_doc_key.AsSlice(), DocKeyPart::kWholeDocKey));
+        return RefCntPrefix(encoded_doc_key.AsSlice().Prefix(size));
       });
 }
 
@@ -325,8 +347,77 @@ class ExpressionHelper {
   size_t next_result_idx_ = 0;
 };
 
+// Tracks position of the sampling scan relative to the keys that divide the tablet into parts of
+// roughly the same size. Number of rows per part is estimated from the parts that were scanned
+// completely, and used to skip whole parts when the sampling algorithm decides to skip more rows
+// than there are in a part.
+class SamplePartSkipper {
+ public:
+  explicit SamplePartSkipper(std::vector<std::string> keys) : keys_(std::move(keys)) {}
+
+  // Should be called for each scanned row.
+  void RowScanned(Slice tuple_id) {
+    size_t crossed_keys = 0;
+    while (next_key_ < keys_.size() && tuple_id.compare(keys_[next_key_]) >= 0) {
+      ++next_key_;
+      ++crossed_keys;
+    }
+    if (crossed_keys) {
+      if (part_started_at_key_) {
+        full_parts_ += crossed_keys;
+        full_parts_rows_ += rows_in_part_;
+      }
+      part_started_at_key_ = true;
+      rows_in_part_ = 0;
+    }
+    ++rows_in_part_;
+  }
+
+  // Returns tuple id to seek to, in order to skip at most rows_to_skip rows, and stores the
+  // estimated number of skipped rows in skipped_rows. Returns nullptr if not a single whole part
+  // could be skipped.
+  const std::string* Skip(double rows_to_skip, double* skipped_rows) {
+    if (full_parts_rows_ == 0 || next_key_ >= keys_.size()) {
+      return nullptr;
+    }
+    const double rows_per_part = static_cast<double>(full_parts_rows_) / full_parts_;
+    const double rows_left_in_part = std::max(rows_per_part - rows_in_part_, 0.0);
+    if (rows_to_skip < rows_left_in_part + rows_per_part) {
+      return nullptr;
+    }
+    const auto parts = std::min(
+        static_cast<size_t>((rows_to_skip - rows_left_in_part) / rows_per_part),
+        keys_.size() - 1 - next_key_);
+    if (parts == 0) {
+      return nullptr;
+    }
+    next_key_ += parts;
+    *skipped_rows = rows_left_in_part + parts * rows_per_part;
+    // Rows of the part we are seeking into should not be added to the estimate.
+    part_started_at_key_ = false;
+    rows_in_part_ = 0;
+    return &keys_[next_key_];
+  }
+
+ private:
+  const std::vector<std::string> keys_;
+  // Index of the first key greater than the current row.
+  size_t next_key_ = 0;
+  bool part_started_at_key_ = false;
+  size_t rows_in_part_ = 0;
+  size_t full_parts_ = 0;
+  size_t full_parts_rows_ = 0;
+};
+
 } // namespace
 
+Result<string> FetchEncodedDocKey(const Schema& schema, const PgsqlReadRequestPB& request) {
+  return FetchDocKeyImpl<string>(
+      schema, request,
+      [](const auto& doc_key) { return doc_key.Encode().ToStringBuffer(); },
+      [](const auto& encoded_doc_key) { return encoded_doc_key; });
+}
+
 class PgsqlWriteOperation::RowPackContext {
  public:
   RowPackContext(const PgsqlWriteRequestPB& request,
@@ -365,8 +456,7 @@ Status PgsqlWriteOperation::Init(PgsqlResponsePB* response) {
   // Initialize operation inputs.
   response_ = response;
 
-  doc_key_ = VERIFY_RESULT(FetchDocKey(doc_read_context_->schema, request_));
-  encoded_doc_key_ = doc_key_->EncodeAsRefCntPrefix();
+  encoded_doc_key_ = VERIFY_RESULT(FetchEncodedDocKey(doc_read_context_->schema, request_));
 
   return Status::OK();
 }
@@ -389,7 +479,7 @@ Result<bool> PgsqlWriteOperation::HasDuplicateUniqueIndexValue(const DocOperatio
 Result<bool> PgsqlWriteOperation::HasDuplicateUniqueIndexValue(
     const DocOperationApplyData& data, Direction direction) {
   VLOG(2) << "Looking for collision while going " << yb::ToString(direction)
-          << ". Trying to insert " << *doc_key_;
+          << ". Trying to insert " << DocKey::DebugSliceToString(encoded_doc_key_.as_slice());
   auto requested_read_time = data.read_time;
   if (direction == Direction::kForward) {
     return HasDuplicateUniqueIndexValue(data, requested_read_time);
@@ -398,19 +488,19 @@ Result<bool> PgsqlWriteOperation::HasDuplicateUniqueIndexValue(
   auto iter = CreateIntentAwareIterator(
       data.doc_write_batch->doc_db(),
       BloomFilterMode::USE_BLOOM_FILTER,
-      doc_key_->Encode().AsSlice(),
+      encoded_doc_key_.as_slice(),
       rocksdb::kDefaultQueryId,
       txn_op_context_,
       data.deadline,
       ReadHybridTime::Max());
 
   HybridTime oldest_past_min_ht = VERIFY_RESULT(FindOldestOverwrittenTimestamp(
-      iter.get(), SubDocKey(*doc_key_), requested_read_time.read));
+      iter.get(), encoded_doc_key_.as_slice(), requested_read_time.read));
+  KeyBytes liveness_key(encoded_doc_key_.as_slice());
+  KeyEntryValue::kLivenessColumn.AppendToKey(&liveness_key);
   const HybridTime oldest_past_min_ht_liveness =
       VERIFY_RESULT(FindOldestOverwrittenTimestamp(
-          iter.get(),
-          SubDocKey(*doc_key_, KeyEntryValue::kLivenessColumn),
-          requested_read_time.read));
+          iter.get(), liveness_key.AsSlice(), requested_read_time.read));
   oldest_past_min_ht.MakeAtMost(oldest_past_min_ht_liveness);
   if (!oldest_past_min_ht.is_valid()) {
     return false;
@@ -422,7 +512,8 @@ Result<bool> PgsqlWriteOperation::HasDuplicateUniqueIndexValue(
 Result<bool> PgsqlWriteOperation::HasDuplicateUniqueIndexValue(
     const DocOperationApplyData& data, ReadHybridTime read_time) {
   // Set up the iterator to read the current primary key associated with the index key.
-  DocPgsqlScanSpec spec(doc_read_context_->schema, request_.stmt_id(), *doc_key_);
+  DocPgsqlScanSpec spec(
+      doc_read_context_->schema, request_.stmt_id(), encoded_doc_key_.as_slice());
   DocRowwiseIterator iterator(doc_read_context_->schema,
                               *doc_read_context_,
                               txn_op_context_,
@@ -474,20 +565,20 @@ Result<bool> PgsqlWriteOperation::HasDuplicateUniqueIndexValue(
 
 Result<HybridTime> PgsqlWriteOperation::FindOldestOverwrittenTimestamp(
     IntentAwareIterator* iter,
-    const SubDocKey& sub_doc_key,
+    Slice sub_key_slice,
     HybridTime min_read_time) {
   HybridTime result;
-  VLOG(3) << "Doing iter->Seek " << *doc_key_;
-  iter->Seek(*doc_key_);
+  const auto doc_key = encoded_doc_key_.as_slice();
+  VLOG(3) << "Doing iter->Seek " << DocKey::DebugSliceToString(doc_key);
+  iter->Seek(doc_key);
   if (iter->valid()) {
-    const KeyBytes bytes = sub_doc_key.EncodeWithoutHt();
-    const Slice& sub_key_slice = bytes.AsSlice();
     result = VERIFY_RESULT(
         iter->FindOldestRecord(sub_key_slice, min_read_time));
     VLOG(2) << "iter->FindOldestRecord returned " << result << " for "
             << SubDocKey::DebugSliceToString(sub_key_slice);
   } else {
-    VLOG(3) << "iter->Seek " << *doc_key_ << " turned out to be invalid";
+    VLOG(3) << "iter->Seek " << DocKey::DebugSliceToString(doc_key)
+            << " turned out to be invalid";
   }
   return result;
 }
@@ -521,6 +612,9 @@ Status PgsqlWriteOperation::Apply(const DocOperationApplyData& data) {
 
     case PgsqlWriteRequestPB::PGSQL_TRUNCATE_COLOCATED:
       return ApplyTruncateColocated(data);
+
+    case PgsqlWriteRequestPB::PGSQL_DELETE_RANGE:
+      return ApplyDeleteRange(data);
   }
   return Status::OK();
 }
@@ -821,13 +915,29 @@ Status PgsqlWriteOperation::ApplyTruncateColocated(const DocOperationApplyData&
   return Status::OK();
 }
 
+Status PgsqlWriteOperation::ApplyDeleteRange(const DocOperationApplyData& data) {
+  const auto& start = request_.range_delete_start();
+  const auto& end = request_.range_delete_end();
+  // Table doc key sorts before all rows of the table, so it is never covered by the range.
+  SCHECK(Slice(start).compare(encoded_doc_key_.as_slice()) > 0 &&
+             DocKeyBelongsTo(start, doc_read_context_->schema),
+         InvalidArgument,
+         Format("Invalid range delete start: $0", Slice(start).ToDebugHexString()));
+  SCHECK(end.empty() || start < end, InvalidArgument,
+         Format("Invalid range delete end: $0", Slice(end).ToDebugHexString()));
+  RETURN_NOT_OK(data.doc_write_batch->DeleteSubDoc(
+      RangeTombstonePath(encoded_doc_key_.as_slice(), start, end), data.read_time, data.deadline));
+  response_->set_status(PgsqlResponsePB::PGSQL_STATUS_OK);
+  return Status::OK();
+}
+
 Status PgsqlWriteOperation::ReadColumns(const DocOperationApplyData& data,
                                         QLTableRow* table_row) {
   // Filter the columns using primary key.
-  if (doc_key_) {
+  if (encoded_doc_key_) {
     Schema projection;
     RETURN_NOT_OK(CreateProjection(doc_read_context_->schema, request_.column_refs(), &projection));
-    DocPgsqlScanSpec spec(projection, request_.stmt_id(), *doc_key_);
+    DocPgsqlScanSpec spec(projection, request_.stmt_id(), encoded_doc_key_.as_slice());
     DocRowwiseIterator iterator(projection,
                                 *doc_read_context_,
                                 txn_op_context_,
@@ -1030,11 +1140,25 @@ Result<size_t> PgsqlReadOperation::ExecuteSample(const YQLStorageIf& ql_storage,
   table_iter_ = VERIFY_RESULT(CreateIterator(
       ql_storage, request_, projection, doc_read_context, txn_op_context_,
       deadline, read_time, is_explicit_request_read_time));
+  // Skipping whole parts of the tablet makes the number of scanned rows an estimate, but reduces
+  // sampling time of large tablets from the time of full scan to the time of reading the sample.
+  std::optional<SamplePartSkipper> part_skipper;
+  if (FLAGS_ysql_sampling_max_skip_keys > 0) {
+    auto skip_keys = VERIFY_RESULT(ql_storage.GetSampleTupleIds(
+        doc_read_context.schema, FLAGS_ysql_sampling_max_skip_keys));
+    if (!skip_keys.empty()) {
+      part_skipper.emplace(std::move(skip_keys));
+    }
+  }
+  double skipped_rows = 0;
   bool scan_time_exceeded = false;
   CoarseTimePoint stop_scan = deadline - FLAGS_ysql_scan_deadline_margin_ms * 1ms;
   while (scanned_rows++ < row_count_limit &&
          VERIFY_RESULT(table_iter_->HasNext()) &&
          !scan_time_exceeded) {
+    if (part_skipper) {
+      part_skipper->RowScanned(VERIFY_RESULT(table_iter_->GetTupleId()));
+    }
     if (numrows < targrows) {
       // Select first targrows of the table. If first partition(s) have less than that, next
       // partition starts to continue populating it's reservoir starting from the numrows' position:
@@ -1059,6 +1183,17 @@ Result<size_t> PgsqlReadOperation::ExecuteSample(const YQLStorageIf& ql_storage,
         YbgReservoirGetNextS(rstate, samplerows, targrows, &rowstoskip);
       } else {
         rowstoskip -= 1;
+        double part_skipped_rows;
+        const std::string* seek_tuple_id =
+            part_skipper ? part_skipper->Skip(rowstoskip, &part_skipped_rows) : nullptr;
+        if (seek_tuple_id) {
+          rowstoskip -= part_skipped_rows;
+          skipped_rows += part_skipped_rows;
+          // Seek positions the iterator to the next row to scan.
+          RETURN_NOT_OK(table_iter_->SeekTuple(*seek_tuple_id));
+          scan_time_exceeded = CoarseMonoClock::now() >= stop_scan;
+          continue;
+        }
       }
     }
     // Taking tuple ID does not advance the table iterator. Move it now.
@@ -1067,7 +1202,7 @@ Result<size_t> PgsqlReadOperation::ExecuteSample(const YQLStorageIf& ql_storage,
     scan_time_exceeded = CoarseMonoClock::now() >= stop_scan;
   }
   // Count live rows we have scanned TODO how to count dead rows?
-  samplerows += scanned_rows - 1;
+  samplerows += scanned_rows - 1 + skipped_rows;
   // Return collected tuples from the reservoir.
   // Tuples are returned as (index, ybctid) pairs, where index is in [0..targrows-1] range.
   // As mentioned above, for large tables reservoirs become increasingly sparse from page to page.
@@ -1216,6 +1351,13 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const YQLStorageIf& ql_storage,
   // Fetching data.
   int match_count = 0;
   QLTableRow row;
+  if (request_.is_aggregate() && !request_.has_index_request() &&
+      FLAGS_ysql_aggregate_scan_batch_size > 1) {
+    // The batched evaluation stops only when the iterator is exhausted or the scan time is
+    // exceeded, so the loop below does not process any rows.
+    match_count = VERIFY_RESULT(EvalAggregateBatched(
+        iter, doc_projection, &doc_expr_exec, stop_scan, &scan_time_exceeded));
+  }
   while (fetched_rows < row_count_limit && VERIFY_RESULT(iter->HasNext()) &&
          !scan_time_exceeded) {
     bool is_match = true;
@@ -1321,7 +1463,27 @@ Result<size_t> PgsqlReadOperation::ExecuteBatchYbctid(const YQLStorageIf& ql_sto
     VLOG(1) << "Added where expression to the executor";
   }
 
-  for (const PgsqlBatchArgumentPB& batch_argument : request_.batch_arguments()) {
+  const auto& batch_arguments = request_.batch_arguments();
+  std::vector<int> read_order(batch_arguments.size());
+  std::iota(read_order.begin(), read_order.end(), 0);
+  auto ybctid_less = [&batch_arguments](int lhs, int rhs) {
+    return batch_arguments.Get(lhs).ybctid().value().binary_value() <
+           batch_arguments.Get(rhs).ybctid().value().binary_value();
+  };
+  const bool sort_reads = FLAGS_ysql_sort_batched_ybctid_reads &&
+                          !std::is_sorted(read_order.begin(), read_order.end(), ybctid_less);
+  if (sort_reads) {
+    std::sort(read_order.begin(), read_order.end(), ybctid_less);
+  }
+  // When reads are sorted, rows are collected to rows_buffer and then copied to the result in the
+  // order of batch arguments, since client expects rows of each response to be ordered.
+  faststring sorted_rows;
+  faststring* rows_buffer = sort_reads ? &sorted_rows : result_buffer;
+  std::vector<std::optional<std::pair<size_t, size_t>>> row_ranges(
+      sort_reads ? batch_arguments.size() : 0);
+
+  for (const auto idx : read_order) {
+    const PgsqlBatchArgumentPB& batch_argument = batch_arguments.Get(idx);
     SCHECK(batch_argument.has_ybctid(),
            InternalError,
            "ybctid arguments can be batched only");
@@ -1337,13 +1499,26 @@ Result<size_t> PgsqlReadOperation::ExecuteBatchYbctid(const YQLStorageIf& ql_sto
       RETURN_NOT_OK(expr_exec.Exec(row, nullptr, &is_match));
       if (is_match) {
         // Populate result set.
-        RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
-        response_.add_batch_orders(batch_argument.order());
+        const auto row_start = rows_buffer->size();
+        RETURN_NOT_OK(PopulateResultSet(row, rows_buffer));
+        if (sort_reads) {
+          row_ranges[idx].emplace(row_start, rows_buffer->size());
+        } else {
+          response_.add_batch_orders(batch_argument.order());
+        }
         row_count++;
       }
     }
   }
 
+  for (int idx = 0; idx != static_cast<int>(row_ranges.size()); ++idx) {
+    if (row_ranges[idx]) {
+      const auto [begin, end] = *row_ranges[idx];
+      result_buffer->append(sorted_rows.data() + begin, end - begin);
+      response_.add_batch_orders(batch_arguments.Get(idx).order());
+    }
+  }
+
   // Set status for this batch.
   // Mark all rows were processed even in case some of the ybctids were not found.
   response_.set_batch_arg_count(request_.batch_arguments_size());
@@ -1431,6 +1606,34 @@ Status PgsqlReadOperation::EvalAggregate(const QLTableRow& table_row) {
   return Status::OK();
 }
 
+Result<int> PgsqlReadOperation::EvalAggregateBatched(
+    YQLRowwiseIteratorIf* iter, const Schema& projection, DocPgExprExecutor* expr_exec,
+    CoarseTimePoint stop_scan, bool* scan_time_exceeded) {
+  std::vector<QLTableRow> rows(FLAGS_ysql_aggregate_scan_batch_size);
+  int match_count = 0;
+  for (;;) {
+    auto num_rows = VERIFY_RESULT(iter->NextRowBatch(projection, &rows));
+    for (size_t i = 0; i != num_rows; ++i) {
+      bool is_match = true;
+      RETURN_NOT_OK(expr_exec->Exec(rows[i], nullptr, &is_match));
+      if (is_match) {
+        ++match_count;
+        RETURN_NOT_OK(EvalAggregate(rows[i]));
+      }
+    }
+    if (num_rows < rows.size()) {
+      break;
+    }
+    // Check if we are running out of time. Whole batch is consumed, so iterator position is
+    // consistent with the rows that were aggregated.
+    if (CoarseMonoClock::now() >= stop_scan) {
+      *scan_time_exceeded = true;
+      break;
+    }
+  }
+  return match_count;
+}
+
 Status PgsqlReadOperation::PopulateAggregate(const QLTableRow& table_row,
                                              faststring *result_buffer) {
   int column_count = request_.targets().size();
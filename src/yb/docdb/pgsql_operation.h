@@ -67,7 +67,7 @@ class PgsqlWriteOperation :
       ReadHybridTime read_time);
   Result<HybridTime> FindOldestOverwrittenTimestamp(
       IntentAwareIterator* iter,
-      const SubDocKey& sub_doc_key,
+      Slice sub_key_slice,
       HybridTime min_hybrid_time);
 
   // Execute write.
@@ -80,12 +80,13 @@ class PgsqlWriteOperation :
     }
   }
 
-  // Insert, update, delete, and colocated truncate operations.
+  // Insert, update, delete, colocated truncate and range delete operations.
   Status ApplyInsert(
       const DocOperationApplyData& data, IsUpsert is_upsert = IsUpsert::kFalse);
   Status ApplyUpdate(const DocOperationApplyData& data);
   Status ApplyDelete(const DocOperationApplyData& data, const bool is_persist_needed);
   Status ApplyTruncateColocated(const DocOperationApplyData& data);
+  Status ApplyDeleteRange(const DocOperationApplyData& data);
 
   Status DeleteRow(const DocPath& row_path, DocWriteBatch* doc_write_batch,
                    const ReadHybridTime& read_ht, CoarseTimePoint deadline);
@@ -122,8 +123,7 @@ class PgsqlWriteOperation :
   // TODO(neil) Output arguments.
   // UPDATE, DELETE, INSERT operations should return total number of new or changed rows.
 
-  // Doc key and encoded doc key for the primary key.
-  boost::optional<DocKey> doc_key_;
+  // Encoded doc key for the primary key.
   RefCntPrefix encoded_doc_key_;
 
   // Rows result requested.
@@ -200,6 +200,13 @@ class PgsqlReadOperation : public DocExprExecutor {
 
   Status EvalAggregate(const QLTableRow& table_row);
 
+  // Evaluates aggregates over rows matching expr_exec conditions, reading rows from iter in
+  // batches. Stops when iterator is exhausted or stop_scan is reached, the latter is reported via
+  // scan_time_exceeded. Returns number of matched rows.
+  Result<int> EvalAggregateBatched(
+      YQLRowwiseIteratorIf* iter, const Schema& projection, DocPgExprExecutor* expr_exec,
+      CoarseTimePoint stop_scan, bool* scan_time_exceeded);
+
   Status PopulateAggregate(const QLTableRow& table_row,
                                    faststring *result_buffer);
 
@@ -222,6 +229,10 @@ class PgsqlReadOperation : public DocExprExecutor {
   YQLRowwiseIteratorIf::UniPtr index_iter_;
 };
 
+// Returns encoded doc key of the row specified by ybctid or key column values of the request.
+// When only a prefix of key columns is specified, the encoded prefix is returned.
+Result<std::string> FetchEncodedDocKey(const Schema& schema, const PgsqlReadRequestPB& request);
+
 }  // namespace docdb
 }  // namespace yb
 
@@ -15,12 +15,19 @@
 
 #include "yb/common/pgsql_protocol.pb.h"
 #include "yb/common/ql_protocol.pb.h"
+#include "yb/common/schema.h"
 
+#include "yb/docdb/colocated_tables_stats.h"
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_read_context.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/doc_ql_scanspec.h"
 #include "yb/docdb/primitive_value_util.h"
+#include "yb/docdb/range_tombstones.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/rocksdb/db.h"
+#include "yb/rocksdb/db/dbformat.h"
 
 #include "yb/util/result.h"
 
@@ -237,5 +244,43 @@ Status QLRocksDBStorage::GetIterator(
   return Status::OK();
 }
 
+Result<std::vector<std::string>> QLRocksDBStorage::GetSampleTupleIds(
+    const Schema& schema, size_t max_keys) const {
+  std::vector<std::string> result;
+  auto sample_keys = doc_db_.regular->GetSampleKeys(max_keys);
+  if (!sample_keys.ok()) {
+    // There are no SST files yet.
+    if (sample_keys.status().IsIncomplete()) {
+      return result;
+    }
+    return sample_keys.status();
+  }
+
+  // Tuple ids don't include cotable id / colocation id, so keys of other tables are skipped.
+  auto table_prefix = ColocatedTablePrefix(schema);
+
+  result.reserve(sample_keys->size());
+  for (const auto& key : *sample_keys) {
+    auto user_key = rocksdb::ExtractUserKey(key);
+    if (user_key.empty() || IsInternalRecordKeyType(DecodeKeyEntryType(user_key[0])) ||
+        !user_key.starts_with(table_prefix.AsSlice()) ||
+        !IsWithinBounds(doc_db_.key_bounds, user_key)) {
+      continue;
+    }
+    // Index keys could be shortened and don't have to be valid doc keys.
+    auto doc_key_size = DocKey::EncodedSize(user_key, DocKeyPart::kWholeDocKey);
+    if (!doc_key_size.ok() || *doc_key_size <= table_prefix.size() ||
+        IsTableDocKey(user_key.Prefix(*doc_key_size))) {
+      continue;
+    }
+    Slice tuple_id(user_key.data() + table_prefix.size(), user_key.data() + *doc_key_size);
+    if (!result.empty() && tuple_id.compare(result.back()) <= 0) {
+      continue;
+    }
+    result.push_back(tuple_id.ToBuffer());
+  }
+  return result;
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -83,6 +83,9 @@ class QLRocksDBStorage : public YQLStorageIf {
       const QLValuePB& ybctid,
       YQLRowwiseIteratorIf::UniPtr* iter) const override;
 
+  Result<std::vector<std::string>> GetSampleTupleIds(
+      const Schema& schema, size_t max_keys) const override;
+
  private:
   const DocDB doc_db_;
 };
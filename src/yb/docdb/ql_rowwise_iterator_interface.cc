@@ -13,6 +13,8 @@
 
 #include "yb/docdb/ql_rowwise_iterator_interface.h"
 
+#include "yb/common/ql_expr.h"
+
 #include "yb/util/result.h"
 
 namespace yb {
@@ -38,5 +40,22 @@ Status YQLRowwiseIteratorIf::NextRow(QLTableRow* table_row) {
   return DoNextRow(schema(), table_row);
 }
 
+Result<size_t> YQLRowwiseIteratorIf::NextRowBatch(
+    const Schema& projection, std::vector<QLTableRow>* rows) {
+  return DoNextRowBatch(projection, rows);
+}
+
+Result<size_t> YQLRowwiseIteratorIf::DoNextRowBatch(
+    const Schema& projection, std::vector<QLTableRow>* rows) {
+  size_t num_rows = 0;
+  while (num_rows != rows->size() && VERIFY_RESULT(HasNext())) {
+    auto& row = (*rows)[num_rows];
+    row.Clear();
+    RETURN_NOT_OK(DoNextRow(projection, &row));
+    ++num_rows;
+  }
+  return num_rows;
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "yb/common/common_fwd.h"
 
@@ -77,8 +78,17 @@ class YQLRowwiseIteratorIf {
 
   Status NextRow(QLTableRow* table_row);
 
+  // Read up to rows->size() next rows using the specified projection, reusing rows that are
+  // already allocated in rows. Returns number of rows read, it is less than rows->size() only
+  // when there are no more rows to read.
+  // Allows tight loops over rows, without virtual HasNext/NextRow calls per row.
+  Result<size_t> NextRowBatch(const Schema& projection, std::vector<QLTableRow>* rows);
+
  private:
   virtual Status DoNextRow(const Schema& projection, QLTableRow* table_row) = 0;
+
+  // Default implementation reads rows one by one using HasNext and DoNextRow.
+  virtual Result<size_t> DoNextRowBatch(const Schema& projection, std::vector<QLTableRow>* rows);
 };
 
 }  // namespace docdb
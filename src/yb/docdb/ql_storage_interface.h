@@ -16,6 +16,7 @@
 #include <limits>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "yb/common/common_fwd.h"
 
@@ -102,6 +103,11 @@ class YQLStorageIf {
       const ReadHybridTime& read_time,
       const QLValuePB& ybctid,
       std::unique_ptr<YQLRowwiseIteratorIf>* iter) const = 0;
+
+  // Returns up to max_keys sorted tuple ids of the table with the given schema, that divide the
+  // table data into parts of roughly the same size. Used to skip whole parts while sampling.
+  virtual Result<std::vector<std::string>> GetSampleTupleIds(
+      const Schema& schema, size_t max_keys) const = 0;
 };
 
 }  // namespace docdb
@@ -0,0 +1,95 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/range_tombstones.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+DocHybridTime WriteTime(uint64_t micros) {
+  return DocHybridTime(HybridTime::FromMicros(micros));
+}
+
+RangeTombstone Tombstone(std::string start, std::string end, uint64_t micros) {
+  return RangeTombstone {
+    .start = std::move(start),
+    .end = std::move(end),
+    .write_time = WriteTime(micros),
+  };
+}
+
+} // namespace
+
+class RangeTombstonesTest : public YBTest {
+};
+
+TEST_F(RangeTombstonesTest, Disjoint) {
+  RangeTombstones tombstones;
+  ASSERT_TRUE(tombstones.empty());
+  tombstones.Add(Tombstone("b", "d", 10));
+  tombstones.Add(Tombstone("f", "h", 20));
+  ASSERT_FALSE(tombstones.empty());
+
+  ASSERT_EQ(tombstones.MaxWriteTime("a"), DocHybridTime::kMin);
+  ASSERT_EQ(tombstones.MaxWriteTime("b"), WriteTime(10));
+  ASSERT_EQ(tombstones.MaxWriteTime("c"), WriteTime(10));
+  // End is exclusive.
+  ASSERT_EQ(tombstones.MaxWriteTime("d"), DocHybridTime::kMin);
+  ASSERT_EQ(tombstones.MaxWriteTime("e"), DocHybridTime::kMin);
+  ASSERT_EQ(tombstones.MaxWriteTime("g"), WriteTime(20));
+  ASSERT_EQ(tombstones.MaxWriteTime("h"), DocHybridTime::kMin);
+
+  tombstones.Clear();
+  ASSERT_TRUE(tombstones.empty());
+  ASSERT_EQ(tombstones.MaxWriteTime("c"), DocHybridTime::kMin);
+}
+
+TEST_F(RangeTombstonesTest, Overlapping) {
+  RangeTombstones tombstones;
+  tombstones.Add(Tombstone("b", "f", 10));
+  tombstones.Add(Tombstone("d", "h", 30));
+  tombstones.Add(Tombstone("c", "e", 20));
+  // Empty end stands for the end of the table.
+  tombstones.Add(Tombstone("g", "", 5));
+
+  ASSERT_EQ(tombstones.MaxWriteTime("a"), DocHybridTime::kMin);
+  ASSERT_EQ(tombstones.MaxWriteTime("b"), WriteTime(10));
+  ASSERT_EQ(tombstones.MaxWriteTime("c"), WriteTime(20));
+  ASSERT_EQ(tombstones.MaxWriteTime("d"), WriteTime(30));
+  ASSERT_EQ(tombstones.MaxWriteTime("e"), WriteTime(30));
+  ASSERT_EQ(tombstones.MaxWriteTime("g"), WriteTime(30));
+  ASSERT_EQ(tombstones.MaxWriteTime("h"), WriteTime(5));
+  ASSERT_EQ(tombstones.MaxWriteTime("z"), WriteTime(5));
+}
+
+TEST_F(RangeTombstonesTest, Empty) {
+  RangeTombstones tombstones;
+  // Tombstones with empty range cover nothing.
+  tombstones.Add(Tombstone("c", "c", 10));
+  tombstones.Add(Tombstone("d", "b", 10));
+  ASSERT_EQ(tombstones.MaxWriteTime("b"), DocHybridTime::kMin);
+  ASSERT_EQ(tombstones.MaxWriteTime("c"), DocHybridTime::kMin);
+
+  // Empty start stands for the start of the table.
+  tombstones.Add(Tombstone("", "", 10));
+  ASSERT_EQ(tombstones.MaxWriteTime(""), WriteTime(10));
+  ASSERT_EQ(tombstones.MaxWriteTime("c"), WriteTime(10));
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,149 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/range_tombstones.h"
+
+#include <algorithm>
+
+#include "yb/docdb/doc_path.h"
+#include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/key_bytes.h"
+#include "yb/docdb/key_entry_value.h"
+#include "yb/docdb/value.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/util/format.h"
+#include "yb/util/result.h"
+#include "yb/util/status_format.h"
+#include "yb/util/uuid.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+const KeyEntryValue& RangeTombstoneSubKey() {
+  static const KeyEntryValue kResult = KeyEntryValue::SystemColumnId(
+      SystemColumnIds::kRangeTombstone);
+  return kResult;
+}
+
+Result<std::string> DecodeStringSubKey(Slice* subkeys) {
+  KeyEntryValue value;
+  RETURN_NOT_OK(KeyEntryValue::DecodeKey(subkeys, &value));
+  SCHECK(value.IsString(), Corruption, Format("Range tombstone bound expected: $0", value));
+  return value.GetString();
+}
+
+} // namespace
+
+std::string RangeTombstone::ToString() const {
+  return Format(
+      "{ start: $0 end: $1 write_time: $2 }", Slice(start).ToDebugHexString(),
+      Slice(end).ToDebugHexString(), write_time);
+}
+
+void RangeTombstones::Add(const RangeTombstone& tombstone) {
+  if (!tombstone.end.empty() && tombstone.end <= tombstone.start) {
+    return;
+  }
+  // end is greater than start, so adding its boundary does not shift the start one.
+  auto begin_idx = SplitAt(tombstone.start);
+  auto end_idx = tombstone.end.empty() ? boundaries_.size() : SplitAt(tombstone.end);
+  for (auto i = begin_idx; i != end_idx; ++i) {
+    auto& write_time = boundaries_[i].write_time;
+    write_time = std::max(write_time, tombstone.write_time);
+  }
+}
+
+size_t RangeTombstones::SplitAt(const std::string& key) {
+  auto it = std::upper_bound(
+      boundaries_.begin(), boundaries_.end(), key,
+      [](const std::string& lhs, const Boundary& rhs) { return lhs < rhs.key; });
+  if (it != boundaries_.begin() && std::prev(it)->key == key) {
+    return std::prev(it) - boundaries_.begin();
+  }
+  auto write_time = it == boundaries_.begin() ? DocHybridTime::kMin : std::prev(it)->write_time;
+  return boundaries_.insert(it, Boundary{key, write_time}) - boundaries_.begin();
+}
+
+DocHybridTime RangeTombstones::MaxWriteTime(Slice doc_key) const {
+  auto it = std::upper_bound(
+      boundaries_.begin(), boundaries_.end(), doc_key,
+      [](Slice lhs, const Boundary& rhs) { return lhs.compare(rhs.key) < 0; });
+  return it == boundaries_.begin() ? DocHybridTime::kMin : std::prev(it)->write_time;
+}
+
+bool IsTableDocKey(Slice doc_key) {
+  size_t prefix_size = 0;
+  if (!doc_key.empty()) {
+    switch (DecodeKeyEntryType(doc_key[0])) {
+      case KeyEntryType::kTableId:
+        prefix_size = 1 + kUuidSize;
+        break;
+      case KeyEntryType::kColocationId:
+        prefix_size = 1 + sizeof(ColocationId);
+        break;
+      default:
+        break;
+    }
+  }
+  return doc_key.size() == prefix_size + 1 &&
+         doc_key[prefix_size] == KeyEntryTypeAsChar::kGroupEnd;
+}
+
+DocPath RangeTombstonePath(Slice table_doc_key, Slice start, Slice end) {
+  return DocPath(table_doc_key, RangeTombstoneSubKey(), KeyEntryValue(start), KeyEntryValue(end));
+}
+
+Result<bool> DecodeRangeTombstone(Slice subkeys, RangeTombstone* tombstone) {
+  if (subkeys.empty() || subkeys[0] != KeyEntryTypeAsChar::kSystemColumnId) {
+    return false;
+  }
+  KeyEntryValue column;
+  RETURN_NOT_OK(KeyEntryValue::DecodeKey(&subkeys, &column));
+  if (column != RangeTombstoneSubKey()) {
+    return false;
+  }
+  tombstone->start = VERIFY_RESULT(DecodeStringSubKey(&subkeys));
+  tombstone->end = VERIFY_RESULT(DecodeStringSubKey(&subkeys));
+  SCHECK(subkeys.empty(), Corruption,
+         Format("Extra data after range tombstone: $0", subkeys.ToDebugHexString()));
+  return true;
+}
+
+Status LoadRangeTombstones(
+    Slice table_doc_key, IntentAwareIterator* iter, RangeTombstones* tombstones) {
+  KeyBytes prefix(table_doc_key);
+  RangeTombstoneSubKey().AppendToKey(&prefix);
+  IntentAwareIteratorPrefixScope prefix_scope(prefix, iter);
+  iter->Seek(prefix);
+  while (iter->valid()) {
+    auto key_data = VERIFY_RESULT(iter->FetchKey());
+    RangeTombstone tombstone;
+    if (!VERIFY_RESULT(DecodeRangeTombstone(
+            key_data.key.WithoutPrefix(table_doc_key.size()), &tombstone))) {
+      return STATUS_FORMAT(
+          Corruption, "Unexpected key in range tombstones: $0", key_data.key.ToDebugHexString());
+    }
+    if (VERIFY_RESULT(Value::IsTombstoned(iter->value()))) {
+      tombstone.write_time = key_data.write_time;
+      tombstones->Add(tombstone);
+    }
+    iter->SeekPastSubKey(key_data.key);
+  }
+  return Status::OK();
+}
+
+}  // namespace docdb
+}  // namespace yb
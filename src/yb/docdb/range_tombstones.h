@@ -0,0 +1,99 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Range tombstone deletes all rows of a colocated table with encoded doc key in [start, end), that
+// were written before the tombstone. Empty end stands for the end of the table.
+//
+// Range tombstones are stored in regular DB as subkeys of the table doc key, i.e. doc key of the
+// table without hashed and range components, so they precede all rows of the table:
+//   <table doc key> <kRangeTombstone system column> <start> <end> HT -> tombstone
+// So they are written via DocWriteBatch as any other key, are visible at read time like any
+// other record, and are taken into account by DocDBTableReader along with table tombstone.
+// Compaction removes rows covered by range tombstones at or below history cutoff, and the range
+// tombstones themselves as regular tombstones.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "yb/common/doc_hybrid_time.h"
+
+#include "yb/docdb/docdb_fwd.h"
+
+#include "yb/util/slice.h"
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+namespace docdb {
+
+struct RangeTombstone {
+  std::string start;
+  std::string end;
+  DocHybridTime write_time;
+
+  std::string ToString() const;
+};
+
+// Range tombstones of a table, merged into disjoint key ranges, each with the max write time of
+// the tombstones covering it. So lookup for a row is a binary search, regardless of how many
+// tombstones overlap.
+class RangeTombstones {
+ public:
+  void Add(const RangeTombstone& tombstone);
+
+  void Clear() {
+    boundaries_.clear();
+  }
+
+  bool empty() const {
+    return boundaries_.empty();
+  }
+
+  // Returns max write time of tombstones covering specified row doc key, or DocHybridTime::kMin
+  // if there are no such tombstones.
+  DocHybridTime MaxWriteTime(Slice doc_key) const;
+
+ private:
+  // Write time of keys starting from key and up to the key of the next boundary, or up to the end
+  // of the table for the last boundary. DocHybridTime::kMin means that keys are not covered.
+  struct Boundary {
+    std::string key;
+    DocHybridTime write_time;
+  };
+
+  // Returns index of the boundary with specified key, adding it if necessary.
+  size_t SplitAt(const std::string& key);
+
+  // Sorted by key.
+  std::vector<Boundary> boundaries_;
+};
+
+// Whether the encoded doc key is the table doc key, i.e. consists of cotable id / colocation id
+// only.
+bool IsTableDocKey(Slice doc_key);
+
+// Returns path of range tombstone record for the table with specified table doc key.
+DocPath RangeTombstonePath(Slice table_doc_key, Slice start, Slice end);
+
+// Decodes start and end of range tombstone from its record key, i.e. subkeys following the
+// table doc key, without hybrid time. Returns false if the key is not a range tombstone key.
+Result<bool> DecodeRangeTombstone(Slice subkeys, RangeTombstone* tombstone);
+
+// Adds range tombstones of the table with specified table doc key, that are visible at read time
+// of the iterator, to the tombstones.
+Status LoadRangeTombstones(
+    Slice table_doc_key, IntentAwareIterator* iter, RangeTombstones* tombstones);
+
+}  // namespace docdb
+}  // namespace yb
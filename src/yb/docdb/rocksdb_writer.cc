@@ -378,8 +378,13 @@ DocHybridTimeBuffer::DocHybridTimeBuffer() {
 }
 
 IntentsWriterContext::IntentsWriterContext(const TransactionId& transaction_id)
+    : IntentsWriterContext(transaction_id, FLAGS_txn_max_apply_batch_records) {
+}
+
+IntentsWriterContext::IntentsWriterContext(
+    const TransactionId& transaction_id, int64_t max_records)
     : transaction_id_(transaction_id),
-      left_records_(FLAGS_txn_max_apply_batch_records) {
+      left_records_(max_records) {
 }
 
 IntentsWriter::IntentsWriter(const Slice& start_key,
@@ -438,6 +443,13 @@ Status IntentsWriter::Apply(rocksdb::DirectWriteHandler* handler) {
   return Status::OK();
 }
 
+Status CompositeDirectWriter::Apply(rocksdb::DirectWriteHandler* handler) {
+  for (auto* writer : writers_) {
+    RETURN_NOT_OK(writer->Apply(handler));
+  }
+  return Status::OK();
+}
+
 ApplyIntentsContext::ApplyIntentsContext(
     const TransactionId& transaction_id,
     const ApplyTransactionState* apply_state,
@@ -445,8 +457,9 @@ ApplyIntentsContext::ApplyIntentsContext(
     HybridTime commit_ht,
     HybridTime log_ht,
     const KeyBounds* key_bounds,
-    rocksdb::DB* intents_db)
-    : IntentsWriterContext(transaction_id),
+    rocksdb::DB* intents_db,
+    int64_t max_records)
+    : IntentsWriterContext(transaction_id, max_records),
       apply_state_(apply_state),
       // In case we have passed in a non-null apply_state, it's aborted set will have been loaded
       // from persisted apply state, and the passed in aborted set will correspond to the aborted
@@ -115,6 +115,9 @@ class IntentsWriterContext {
  public:
   explicit IntentsWriterContext(const TransactionId& transaction_id);
 
+  // max_records - max number of records written by this context, before it interrupts iteration.
+  IntentsWriterContext(const TransactionId& transaction_id, int64_t max_records);
+
   virtual ~IntentsWriterContext() = default;
 
   // Called at the start of iteration. Passed key of the first found entry, if present.
@@ -187,7 +190,8 @@ class ApplyIntentsContext : public IntentsWriterContext {
       HybridTime commit_ht,
       HybridTime log_ht,
       const KeyBounds* key_bounds,
-      rocksdb::DB* intents_db);
+      rocksdb::DB* intents_db,
+      int64_t max_records);
 
   void Start(const boost::optional<Slice>& first_key) override;
 
@@ -209,6 +213,20 @@ class ApplyIntentsContext : public IntentsWriterContext {
   BoundedRocksDbIterator intent_iter_;
 };
 
+// Applies several direct writers to the same write batch, one after another.
+// Used to apply intents of several transactions with one write.
+class CompositeDirectWriter : public rocksdb::DirectWriter {
+ public:
+  void Add(rocksdb::DirectWriter* writer) {
+    writers_.push_back(writer);
+  }
+
+  Status Apply(rocksdb::DirectWriteHandler* handler) override;
+
+ private:
+  std::vector<rocksdb::DirectWriter*> writers_;
+};
+
 class RemoveIntentsContext : public IntentsWriterContext {
  public:
   explicit RemoveIntentsContext(const TransactionId& transaction_id, uint8_t reason);
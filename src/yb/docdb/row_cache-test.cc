@@ -0,0 +1,126 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/docdb.messages.h"
+#include "yb/docdb/row_cache.h"
+
+#include "yb/util/size_literals.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+class RowCacheTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    row_cache_ = std::make_unique<RowCache>(1_MB, MemTracker::GetRootTracker());
+  }
+
+  static KeyBytes RowKey(int32_t key) {
+    return DocKey({KeyEntryValue::Int32(key)}).Encode();
+  }
+
+  static HybridTime Time(uint64_t micros) {
+    return HybridTime::FromMicros(micros);
+  }
+
+  bool Get(int32_t key, HybridTime read_ht, std::string* value = nullptr) {
+    DocHybridTime write_time;
+    ValueBuffer buffer;
+    auto result = row_cache_->Get(RowKey(key), kProjection, read_ht, &write_time, &buffer);
+    if (result && value) {
+      *value = buffer.AsSlice().ToBuffer();
+    }
+    return result;
+  }
+
+  void Insert(
+      const RowCache::ReadToken& token, int32_t key, HybridTime read_ht, HybridTime write_ht,
+      const std::string& value) {
+    row_cache_->Insert(
+        token, read_ht, RowKey(key), kProjection, DocHybridTime(write_ht, 0), value);
+  }
+
+  void Write(int32_t key, HybridTime hybrid_time) {
+    Arena arena;
+    LWKeyValueWriteBatchPB put_batch(&arena);
+    auto* kv_pair = put_batch.add_write_pairs();
+    SubDocKey sub_doc_key(
+        DocKey({KeyEntryValue::Int32(key)}), KeyEntryValue::MakeColumnId(ColumnId(10)));
+    kv_pair->dup_key(sub_doc_key.Encode().AsSlice());
+    kv_pair->dup_value("value");
+    row_cache_->WillApply(put_batch, hybrid_time);
+    row_cache_->Applied(put_batch);
+  }
+
+  static constexpr const char* kProjection = "projection";
+
+  std::unique_ptr<RowCache> row_cache_;
+};
+
+TEST_F(RowCacheTest, Simple) {
+  Insert(row_cache_->PrepareRead(), 1, Time(20), Time(10), "row1");
+  std::string value;
+  ASSERT_TRUE(Get(1, Time(30), &value));
+  ASSERT_EQ(value, "row1");
+  ASSERT_TRUE(Get(1, Time(10)));
+  // Row was written after read time.
+  ASSERT_FALSE(Get(1, Time(5)));
+  ASSERT_FALSE(Get(2, Time(30)));
+
+  // Row cached with different projection.
+  DocHybridTime write_time;
+  ValueBuffer buffer;
+  ASSERT_FALSE(row_cache_->Get(RowKey(1), "other", Time(30), &write_time, &buffer));
+
+  // Write to the row should invalidate it.
+  Write(1, Time(40));
+  ASSERT_FALSE(Get(1, Time(50)));
+
+  Insert(row_cache_->PrepareRead(), 1, Time(50), Time(40), "row1");
+  ASSERT_TRUE(Get(1, Time(50)));
+  row_cache_->Clear();
+  ASSERT_FALSE(Get(1, Time(50)));
+}
+
+TEST_F(RowCacheTest, ConcurrentWrite) {
+  // Write applied before read, but after read time, so reader could miss it.
+  Write(1, Time(40));
+  Insert(row_cache_->PrepareRead(), 1, Time(30), Time(10), "row1");
+  ASSERT_FALSE(Get(1, Time(50)));
+
+  // Write applied between read and insert.
+  auto token = row_cache_->PrepareRead();
+  Write(1, Time(60));
+  Insert(token, 1, Time(50), Time(40), "row1");
+  ASSERT_FALSE(Get(1, Time(70)));
+
+  // Write to the different row does not prevent caching, if it is before the read time.
+  token = row_cache_->PrepareRead();
+  Insert(token, 1, Time(70), Time(60), "row1");
+  ASSERT_TRUE(Get(1, Time(70)));
+  Write(2, Time(80));
+  ASSERT_TRUE(Get(1, Time(90)));
+
+  // Clear between read and insert.
+  token = row_cache_->PrepareRead();
+  row_cache_->Clear();
+  Insert(token, 3, Time(90), Time(10), "row3");
+  ASSERT_FALSE(Get(3, Time(90)));
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,152 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/row_cache.h"
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/docdb.messages.h"
+
+#include "yb/gutil/endian.h"
+
+#include "yb/util/atomic.h"
+#include "yb/util/flags.h"
+
+DEFINE_int32(docdb_row_cache_num_shard_bits, 4,
+             "Number of shard bits used by per tablet row cache.");
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+struct RowCacheEntry {
+  DocHybridTime write_time;
+  std::string projection;
+  std::string value;
+  ScopedTrackedConsumption consumption;
+};
+
+void DeleteEntry(const Slice& key, void* value) {
+  delete static_cast<RowCacheEntry*>(value);
+}
+
+// Cache key is the epoch followed by encoded doc key.
+class RowCacheKey {
+ public:
+  RowCacheKey(uint64_t epoch, Slice doc_key) {
+    char epoch_buffer[sizeof(epoch)];
+    BigEndian::Store64(epoch_buffer, epoch);
+    buffer_.Append(epoch_buffer, sizeof(epoch_buffer));
+    buffer_.Append(doc_key);
+  }
+
+  Slice AsSlice() const {
+    return buffer_.AsSlice();
+  }
+
+ private:
+  KeyBuffer buffer_;
+};
+
+} // namespace
+
+RowCache::RowCache(size_t capacity, const MemTrackerPtr& parent_mem_tracker)
+    : mem_tracker_(MemTracker::FindOrCreateTracker("RowCache", parent_mem_tracker)),
+      cache_(rocksdb::NewLRUCache(capacity, FLAGS_docdb_row_cache_num_shard_bits)) {
+}
+
+RowCache::~RowCache() = default;
+
+RowCache::ReadToken RowCache::PrepareRead() const {
+  return ReadToken {
+    .epoch = epoch_.load(),
+    .applied_writes = applied_writes_.load(),
+    .max_applied_ht = max_applied_ht_.load(),
+  };
+}
+
+bool RowCache::Get(
+    Slice doc_key, Slice projection, HybridTime read_ht, DocHybridTime* write_time,
+    ValueBuffer* value) {
+  RowCacheKey key(epoch_.load(), doc_key);
+  auto* handle = cache_->Lookup(key.AsSlice(), rocksdb::kDefaultQueryId);
+  if (!handle) {
+    return false;
+  }
+  const auto& entry = *static_cast<RowCacheEntry*>(cache_->Value(handle));
+  bool result = entry.write_time.hybrid_time() <= read_ht && projection == entry.projection;
+  if (result) {
+    *write_time = entry.write_time;
+    value->Assign(entry.value);
+  }
+  cache_->Release(handle);
+  return result;
+}
+
+void RowCache::Insert(
+    const ReadToken& token, HybridTime read_ht, Slice doc_key, Slice projection,
+    const DocHybridTime& write_time, Slice value) {
+  // When write after read_ht was already applied, it could be invisible for the reader, so the row
+  // read by it is not necessary the latest one.
+  if (token.max_applied_ht > read_ht || token.epoch != epoch_.load()) {
+    return;
+  }
+  RowCacheKey key(token.epoch, doc_key);
+  auto charge = key.AsSlice().size() + projection.size() + value.size() + sizeof(RowCacheEntry);
+  auto* entry = new RowCacheEntry {
+    .write_time = write_time,
+    .projection = projection.ToBuffer(),
+    .value = value.ToBuffer(),
+    .consumption = ScopedTrackedConsumption(mem_tracker_, charge),
+  };
+  if (!cache_->Insert(key.AsSlice(), rocksdb::kDefaultQueryId, entry, charge, &DeleteEntry).ok()) {
+    return;
+  }
+  // Row could be updated concurrently, after it was read, but before it was inserted,
+  // so the writer could miss erasing it.
+  if (applied_writes_.load() != token.applied_writes) {
+    cache_->Erase(key.AsSlice());
+  }
+}
+
+void RowCache::WillApply(const LWKeyValueWriteBatchPB& put_batch, HybridTime hybrid_time) {
+  for (const auto& kv_pair : put_batch.write_pairs()) {
+    if (kv_pair.has_external_hybrid_time()) {
+      hybrid_time.MakeAtLeast(HybridTime(kv_pair.external_hybrid_time()));
+    }
+  }
+  UpdateAtomicMax(&max_applied_ht_, hybrid_time);
+}
+
+void RowCache::Applied(const LWKeyValueWriteBatchPB& put_batch) {
+  ++applied_writes_;
+  for (const auto& kv_pair : put_batch.write_pairs()) {
+    auto doc_key_size = DocKey::EncodedSize(kv_pair.key(), DocKeyPart::kWholeDocKey);
+    if (!doc_key_size.ok()) {
+      Clear();
+      return;
+    }
+    Erase(kv_pair.key().Prefix(*doc_key_size));
+  }
+}
+
+void RowCache::Erase(Slice doc_key) {
+  cache_->Erase(RowCacheKey(epoch_.load(), doc_key).AsSlice());
+}
+
+void RowCache::Clear() {
+  ++epoch_;
+}
+
+} // namespace docdb
+} // namespace yb
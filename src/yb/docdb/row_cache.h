@@ -0,0 +1,96 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "yb/common/doc_hybrid_time.h"
+#include "yb/common/hybrid_time.h"
+
+#include "yb/docdb/docdb.fwd.h"
+#include "yb/docdb/docdb_fwd.h"
+
+#include "yb/rocksdb/cache.h"
+
+#include "yb/util/kv_util.h"
+#include "yb/util/mem_tracker.h"
+#include "yb/util/slice.h"
+
+namespace yb {
+namespace docdb {
+
+// Per tablet cache of hot rows, that are stored as a single packed row entry in regular DB.
+// Keyed by encoded DocKey, the value is packed row value with its write time.
+// Reader skips entries of columns that are not in its projection, so row is cached together with
+// projection it was read with, and could be used only by readers with the same projection.
+//
+// Used only for tablets of non transactional tables, so all writes go directly to regular DB and
+// are known to the cache via WillApply/Applied.
+//
+// Cached row could be used for read at read_ht, if it was written before read_ht. Any write to the
+// row erases it from cache, so the cached value is always the latest version of the row.
+// In order to not cache a stale row, reader should obtain a token via PrepareRead after creating
+// DB iterator and before reading the row, and pass it to Insert.
+class RowCache {
+ public:
+  struct ReadToken {
+    uint64_t epoch;
+    uint64_t applied_writes;
+    HybridTime max_applied_ht;
+  };
+
+  RowCache(size_t capacity, const MemTrackerPtr& parent_mem_tracker);
+  ~RowCache();
+
+  ReadToken PrepareRead() const;
+
+  // Returns true and fills write_time and value when row identified by doc_key is found in cache
+  // and could be used for read at read_ht with specified encoded projection.
+  bool Get(
+      Slice doc_key, Slice projection, HybridTime read_ht, DocHybridTime* write_time,
+      ValueBuffer* value);
+
+  // Adds row, that was read at read_ht after obtaining token, to the cache.
+  void Insert(
+      const ReadToken& token, HybridTime read_ht, Slice doc_key, Slice projection,
+      const DocHybridTime& write_time, Slice value);
+
+  // Should be called before write batch is applied to regular DB at hybrid_time.
+  void WillApply(const LWKeyValueWriteBatchPB& put_batch, HybridTime hybrid_time);
+
+  // Should be called after write batch is applied to regular DB.
+  void Applied(const LWKeyValueWriteBatchPB& put_batch);
+
+  // Invalidates all cached rows, e.g. after data was imported to regular DB bypassing writes.
+  void Clear();
+
+  const MemTrackerPtr& mem_tracker() const {
+    return mem_tracker_;
+  }
+
+ private:
+  void Erase(Slice doc_key);
+
+  MemTrackerPtr mem_tracker_;
+  std::shared_ptr<rocksdb::Cache> cache_;
+
+  // Cached entries from previous epochs are ignored.
+  std::atomic<uint64_t> epoch_{0};
+  std::atomic<uint64_t> applied_writes_{0};
+  std::atomic<HybridTime> max_applied_ht_{HybridTime::kMin};
+};
+
+} // namespace docdb
+} // namespace yb
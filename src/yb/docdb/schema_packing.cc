@@ -121,6 +121,11 @@ bool SchemaPacking::SkippedColumn(ColumnId column_id) const {
   return it != column_to_idx_.end() && it->second == kSkippedColumnIdx;
 }
 
+int64_t SchemaPacking::GetIndex(ColumnId column_id) const {
+  auto it = column_to_idx_.find(column_id);
+  return it == column_to_idx_.end() || it->second == kSkippedColumnIdx ? kNoColumnIdx : it->second;
+}
+
 Slice SchemaPacking::GetValue(size_t idx, const Slice& packed) const {
   const auto& column_data = columns_[idx];
   size_t offset = column_data.num_varlen_columns_before
@@ -133,11 +138,11 @@ Slice SchemaPacking::GetValue(size_t idx, const Slice& packed) const {
 }
 
 std::optional<Slice> SchemaPacking::GetValue(ColumnId column_id, const Slice& packed) const {
-  auto it = column_to_idx_.find(column_id);
-  if (it == column_to_idx_.end() || it->second == kSkippedColumnIdx) {
+  auto idx = GetIndex(column_id);
+  if (idx == kNoColumnIdx) {
     return {};
   }
-  return GetValue(it->second, packed);
+  return GetValue(idx, packed);
 }
 
 std::string SchemaPacking::ToString() const {
@@ -62,6 +62,8 @@ struct ColumnPackingData {
 
 class SchemaPacking {
  public:
+  static constexpr int64_t kNoColumnIdx = -1;
+
   explicit SchemaPacking(const Schema& schema);
   explicit SchemaPacking(const SchemaPackingPB& pb);
 
@@ -83,6 +85,12 @@ class SchemaPacking {
   }
 
   bool SkippedColumn(ColumnId column_id) const;
+
+  // Returns index of the column with specified id in this packing, or kNoColumnIdx when column
+  // is not packed, i.e. missing or skipped.
+  // Could be used to resolve column indexes once and then use GetValue by index for each row.
+  int64_t GetIndex(ColumnId column_id) const;
+
   Slice GetValue(size_t idx, const Slice& packed) const;
   std::optional<Slice> GetValue(ColumnId column_id, const Slice& packed) const;
   void ToPB(SchemaPackingPB* out) const;
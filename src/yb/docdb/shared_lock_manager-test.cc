@@ -22,6 +22,7 @@
 #include "yb/rpc/thread_pool.h"
 
 #include "yb/util/backoff_waiter.h"
+#include "yb/util/flags.h"
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/result.h"
 #include "yb/util/test_macros.h"
@@ -36,6 +37,11 @@ using std::thread;
 
 DECLARE_bool(dump_lock_keys);
 
+DEFINE_int32(lock_contention_benchmark_secs, 0,
+             "Number of seconds to run lock contention benchmark for, 0 disables the benchmark.");
+DEFINE_int32(lock_contention_benchmark_threads, 16,
+             "Number of threads locking batches in lock contention benchmark.");
+
 namespace yb {
 namespace docdb {
 
@@ -162,6 +168,66 @@ TEST_F(SharedLockManagerTest, QuickLockUnlock) {
   }
 }
 
+// Measures throughput of many threads locking non conflicting batches. Each batch contains weak
+// intents on keys shared by all threads, as for writes to rows of the same table or document, and
+// strong intents on keys of this thread.
+// Disabled by default, use --lock_contention_benchmark_secs to run it.
+TEST_F(SharedLockManagerTest, ContentionBenchmark) {
+  if (FLAGS_lock_contention_benchmark_secs <= 0) {
+    LOG(INFO) << "Lock contention benchmark is disabled";
+    return;
+  }
+  const size_t kThreads = FLAGS_lock_contention_benchmark_threads;
+  constexpr size_t kSharedKeys = 2;
+  constexpr size_t kOwnKeys = 2;
+  const auto kDuration = FLAGS_lock_contention_benchmark_secs * 1s;
+
+  std::atomic<bool> stop_requested{false};
+  std::vector<std::thread> threads;
+  std::vector<size_t> num_batches(kThreads);
+  for (size_t thread_idx = 0; thread_idx != kThreads; ++thread_idx) {
+    threads.emplace_back([this, &stop_requested, &num_batches, thread_idx] {
+      size_t i = 0;
+      while (!stop_requested.load(std::memory_order_acquire)) {
+        LockBatchEntries entries;
+        for (size_t key_idx = 0; key_idx != kSharedKeys; ++key_idx) {
+          entries.push_back(LockBatchEntry {
+              .key = RefCntPrefix(Format("shared_$0", key_idx)),
+              .intent_types = IntentTypeSet({IntentType::kWeakWrite}),
+          });
+        }
+        for (size_t key_idx = 0; key_idx != kOwnKeys; ++key_idx) {
+          entries.push_back(LockBatchEntry {
+              .key = RefCntPrefix(Format("own_$0_$1_$2", thread_idx, i, key_idx)),
+              .intent_types = IntentTypeSet({IntentType::kStrongWrite}),
+          });
+        }
+        LockBatch lb(&lm_, std::move(entries), CoarseTimePoint::max());
+        ASSERT_OK(lb.status());
+        ++i;
+      }
+      num_batches[thread_idx] = i;
+    });
+  }
+
+  std::this_thread::sleep_for(kDuration);
+  stop_requested.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  size_t total = 0;
+  for (auto count : num_batches) {
+    total += count;
+  }
+  LOG(INFO) << "Locked " << total << " batches by " << kThreads << " threads, "
+            << total / FLAGS_lock_contention_benchmark_secs << " batches per second";
+  // Batches do not conflict, so every thread should make progress.
+  for (auto count : num_batches) {
+    ASSERT_GT(count, 0);
+  }
+}
+
 TEST_F(SharedLockManagerTest, LockConflicts) {
   rpc::ThreadPool tp(rpc::ThreadPoolOptions{"test_pool"s, 10, 1});
 
@@ -187,6 +253,22 @@ TEST_F(SharedLockManagerTest, LockConflicts) {
   tp.Shutdown();
 }
 
+TEST_F(SharedLockManagerTest, HasConflictingLocks) {
+  for (size_t idx1 = 0; idx1 != kIntentTypeSetMapSize; ++idx1) {
+    IntentTypeSet set1(idx1);
+    SCOPED_TRACE(Format("Set1: $0", set1));
+    LockBatch lb(&lm_, {{kKey1, set1}}, CoarseTimePoint::max());
+    ASSERT_OK(lb.status());
+    for (size_t idx2 = 0; idx2 != kIntentTypeSetMapSize; ++idx2) {
+      IntentTypeSet set2(idx2);
+      SCOPED_TRACE(Format("Set2: $0", set2));
+      ASSERT_EQ(lm_.HasConflictingLocks({{kKey1, set2}}), IntentTypeSetsConflict(set1, set2));
+      ASSERT_FALSE(lm_.HasConflictingLocks({{kKey2, set2}}));
+    }
+  }
+  ASSERT_FALSE(lm_.HasConflictingLocks({{kKey1, IntentTypeSet({IntentType::kStrongWrite})}}));
+}
+
 TEST_F(SharedLockManagerTest, DumpKeys) {
   FLAGS_dump_lock_keys = true;
 
@@ -24,6 +24,8 @@
 
 #include "yb/docdb/lock_batch.h"
 
+#include "yb/gutil/port.h"
+
 #include "yb/util/enums.h"
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/scope_exit.h"
@@ -135,8 +137,8 @@ struct LockedBatchEntry {
 
   std::condition_variable cond_var;
 
-  // Refcounting for garbage collection. Can only be used while the global mutex is locked.
-  // Global mutex resides in lock manager and covers this field for all LockBatchEntries.
+  // Refcounting for garbage collection. Can only be used while the mutex of the lock manager
+  // stripe, that contains this entry, is locked.
   size_t ref_count = 0;
 
   // Number of holders for each type
@@ -160,30 +162,55 @@ class SharedLockManager::Impl {
  public:
   MUST_USE_RESULT bool Lock(LockBatchEntries* key_to_intent_type, CoarseTimePoint deadline);
   void Unlock(const LockBatchEntries& key_to_intent_type);
+  bool HasConflictingLocks(const LockBatchEntries& key_to_intent_type);
 
   ~Impl() {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    LOG_IF(DFATAL, !locks_.empty()) << "Locks not empty in dtor: " << yb::ToString(locks_);
+    for (auto& stripe : stripes_) {
+      std::lock_guard<std::mutex> lock(stripe.mutex);
+      LOG_IF(DFATAL, !stripe.locks.empty())
+          << "Locks not empty in dtor: " << yb::ToString(stripe.locks);
+    }
   }
 
  private:
   typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
-  // as the keys in the batch.
+  // Lock entries are sharded by key hash, so batches with different keys don't contend on the
+  // same mutex while looking up their entries. Stripes are aligned to cache line to avoid false
+  // sharing.
+  struct alignas(CACHELINE_SIZE) LockStripe {
+    // Returns entry for the key, creating it when necessary, and increments its refcount.
+    LockedBatchEntry* Reserve(const RefCntPrefix& key);
+
+    // Returns true when the key has locks held, that conflict with the specified intent types.
+    bool HasConflictingLocks(const RefCntPrefix& key, IntentTypeSet intent_types);
+
+    // Decrements refcount of the entry, and returns it to the cache when it is no longer used.
+    void Release(const RefCntPrefix& key, LockedBatchEntry* entry);
+
+    // Should be taken only for very short duration, with no blocking wait.
+    std::mutex mutex;
+
+    LockEntryMap locks GUARDED_BY(mutex);
+    // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
+    std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries GUARDED_BY(mutex);
+    std::vector<LockedBatchEntry*> free_lock_entries GUARDED_BY(mutex);
+  };
+
+  static constexpr size_t kNumStripes = 32;
+
+  LockStripe& StripeForKey(const RefCntPrefix& key) {
+    return stripes_[RefCntPrefixHash()(key) % kNumStripes];
+  }
+
+  // Make sure the entries exist in the locks map of their stripes and set pointers to them in
+  // the batch, so we can access them without holding the stripe lock.
   void Reserve(LockBatchEntries* batch);
 
   // Update refcounts and maybe collect garbage.
   void Cleanup(const LockBatchEntries& key_to_intent_type);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
-
-  LockEntryMap locks_ GUARDED_BY(global_mutex_);
-  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
-  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries_ GUARDED_BY(global_mutex_);
-  std::vector<LockedBatchEntry*> free_lock_entries_ GUARDED_BY(global_mutex_);
+  std::array<LockStripe, kNumStripes> stripes_;
 };
 
 std::string SharedLockManager::ToString(const LockState& state) {
@@ -303,21 +330,26 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
 }
 
 void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
   for (auto& key_and_intent_type : *key_to_intent_type) {
-    auto& value = locks_[key_and_intent_type.key];
-    if (!value) {
-      if (!free_lock_entries_.empty()) {
-        value = free_lock_entries_.back();
-        free_lock_entries_.pop_back();
-      } else {
-        lock_entries_.emplace_back(std::make_unique<LockedBatchEntry>());
-        value = lock_entries_.back().get();
-      }
+    key_and_intent_type.locked = StripeForKey(key_and_intent_type.key).Reserve(
+        key_and_intent_type.key);
+  }
+}
+
+LockedBatchEntry* SharedLockManager::Impl::LockStripe::Reserve(const RefCntPrefix& key) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& value = locks[key];
+  if (!value) {
+    if (!free_lock_entries.empty()) {
+      value = free_lock_entries.back();
+      free_lock_entries.pop_back();
+    } else {
+      lock_entries.emplace_back(std::make_unique<LockedBatchEntry>());
+      value = lock_entries.back().get();
     }
-    value->ref_count++;
-    key_and_intent_type.locked = value;
   }
+  value->ref_count++;
+  return value;
 }
 
 void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type) {
@@ -330,14 +362,39 @@ void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type)
   Cleanup(key_to_intent_type);
 }
 
-void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
+bool SharedLockManager::Impl::HasConflictingLocks(const LockBatchEntries& key_to_intent_type) {
   for (const auto& item : key_to_intent_type) {
-    if (--(item.locked->ref_count) == 0) {
-      locks_.erase(item.key);
-      free_lock_entries_.push_back(item.locked);
+    if (StripeForKey(item.key).HasConflictingLocks(item.key, item.intent_types)) {
+      return true;
     }
   }
+  return false;
+}
+
+bool SharedLockManager::Impl::LockStripe::HasConflictingLocks(
+    const RefCntPrefix& key, IntentTypeSet intent_types) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = locks.find(key);
+  if (it == locks.end()) {
+    return false;
+  }
+  auto num_holding = it->second->num_holding.load(std::memory_order_acquire);
+  return (num_holding & kIntentTypeSetConflicts[intent_types.ToUIntPtr()]) != 0;
+}
+
+void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
+  for (const auto& item : key_to_intent_type) {
+    StripeForKey(item.key).Release(item.key, item.locked);
+  }
+}
+
+void SharedLockManager::Impl::LockStripe::Release(
+    const RefCntPrefix& key, LockedBatchEntry* entry) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (--(entry->ref_count) == 0) {
+    locks.erase(key);
+    free_lock_entries.push_back(entry);
+  }
 }
 
 SharedLockManager::SharedLockManager() : impl_(new Impl) {
@@ -353,5 +410,9 @@ void SharedLockManager::Unlock(const LockBatchEntries& key_to_intent_type) {
   impl_->Unlock(key_to_intent_type);
 }
 
+bool SharedLockManager::HasConflictingLocks(const LockBatchEntries& key_to_intent_type) {
+  return impl_->HasConflictingLocks(key_to_intent_type);
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -48,6 +48,10 @@ class SharedLockManager {
   // Release the batch of locks. Requires that the locks are held.
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
+  // Returns true when some of the keys has locks held, that conflict with the specified intent
+  // types. Does not acquire or wait for any locks.
+  bool HasConflictingLocks(const LockBatchEntries& key_to_intent_type);
+
   // Whether or not the state is possible
   static std::string ToString(const LockState& state);
 
@@ -19,6 +19,7 @@
 #include "yb/common/hybrid_time.h"
 #include "yb/docdb/transaction_dump.h"
 #include "yb/util/backoff_waiter.h"
+#include "yb/util/call_accounting.h"
 #include "yb/util/result.h"
 #include "yb/util/status_format.h"
 #include "yb/util/tsan_util.h"
@@ -90,6 +91,7 @@ Result<TransactionLocalState> TransactionStatusCache::GetTransactionLocalState(
 
 Result<TransactionStatusCache::GetCommitDataResult> TransactionStatusCache::DoGetCommitData(
     const TransactionId& transaction_id) {
+  ScopedCallPhase intents_resolution_phase(CallPhase::kIntentsResolution);
   auto local_commit_data_opt = GetLocalCommitData(transaction_id);
   if (local_commit_data_opt != boost::none) {
     return GetCommitDataResult {
@@ -13,6 +13,7 @@
 
 #include "yb/docdb/wait_queue.h"
 
+#include <algorithm>
 #include <future>
 #include <memory>
 
@@ -279,6 +280,12 @@ class BlockerData {
     UniqueLock<decltype(mutex_)> l(mutex_);
     std::vector<WaiterDataPtr> waiters_to_signal;
 
+    // Resolved transaction could not become pending again, so a stale poll response, that arrives
+    // after the transaction was signaled as finished by the local participant, is ignored.
+    if (is_txn_pending && txn_status_.ok() && *txn_status_ != ResolutionStatus::kPending) {
+      return waiters_to_signal;
+    }
+
     txn_status_ = txn_status;
     if (txn_status_response.ok()) {
       if (aborted_subtransactions_ != txn_status_response->aborted_subtxn_set) {
@@ -469,9 +476,10 @@ class WaitQueue::Impl {
   }
 
   void Poll(HybridTime now) EXCLUDES(mutex_) {
-    // TODO(pessimistic): Rely on signaling from the RunningTransaction instance of the blocker
-    // rather than this polling-based mechanism. We should also signal from the RunningTransaction
-    // instance of the waiting transaction in case the waiter is aborted by deadlock or otherwise.
+    // Blockers that were committed or aborted on this tablet are signaled by the transaction
+    // participant, so polling only handles blockers resolved elsewhere and aborted waiters.
+    // TODO(pessimistic): We should also signal from the RunningTransaction instance of the waiting
+    // transaction in case the waiter is aborted by deadlock or otherwise.
     // See https://github.com/yugabyte/yugabyte-db/issues/13578
     const std::string kBlockerReason = "Getting status for blocker wait queue";
     const std::string kWaiterReason = "Getting status for waiter in wait queue";
@@ -608,6 +616,11 @@ class WaitQueue::Impl {
         << "Called CompleteShutdown without empty waiter_status_";
   }
 
+  void SignalResolved(const TransactionId& transaction, TransactionStatusResult res)
+      EXCLUDES(mutex_) {
+    MaybeSignalWaitingTransactions(transaction, std::move(res));
+  }
+
  private:
   void HandleWaiterStatusFromParticipant(
       WaiterDataPtr waiter, Result<TransactionStatusResult> res) {
@@ -720,7 +733,13 @@ class WaitQueue::Impl {
       return;
     }
 
-    for (const auto& waiter : resolved_blocker->Signal(std::move(res))) {
+    auto waiters = resolved_blocker->Signal(std::move(res));
+    // Waiters are resumed one by one through the serial thread pool token, so submit them in the
+    // order they started waiting to hand off the released locks fairly.
+    std::stable_sort(waiters.begin(), waiters.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs->created_at < rhs->created_at;
+    });
+    for (const auto& waiter : waiters) {
       WARN_NOT_OK(thread_pool_token_->SubmitFunc([weak_waiter = std::weak_ptr(waiter), this]() {
         {
           SharedLock<decltype(mutex_)> l(mutex_);
@@ -856,6 +875,17 @@ void WaitQueue::Poll(HybridTime now) {
   return impl_->Poll(now);
 }
 
+void WaitQueue::SignalCommitted(
+    const TransactionId& id, HybridTime commit_ht,
+    const AbortedSubTransactionSet& aborted_subtxn_set) {
+  impl_->SignalResolved(
+      id, TransactionStatusResult(TransactionStatus::COMMITTED, commit_ht, aborted_subtxn_set));
+}
+
+void WaitQueue::SignalAborted(const TransactionId& id) {
+  impl_->SignalResolved(id, TransactionStatusResult::Aborted());
+}
+
 void WaitQueue::StartShutdown() {
   impl_->StartShutdown();
 }
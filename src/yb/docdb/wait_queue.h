@@ -79,6 +79,14 @@ class WaitQueue {
 
   void Poll(HybridTime now);
 
+  // Signal waiters blocked on the given transaction once this tablet learns that it was committed
+  // or aborted, so they are resumed without waiting for the next Poll().
+  void SignalCommitted(
+      const TransactionId& id, HybridTime commit_ht,
+      const AbortedSubTransactionSet& aborted_subtxn_set);
+
+  void SignalAborted(const TransactionId& id);
+
   void StartShutdown();
 
   void CompleteShutdown();
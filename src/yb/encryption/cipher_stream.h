@@ -15,10 +15,14 @@
 
 #include <openssl/ossl_typ.h>
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "yb/encryption/cipher_stream_fwd.h"
 
+#include "yb/gutil/thread_annotations.h"
+
 #include "yb/util/status_fwd.h"
 #include "yb/util/locks.h"
 
@@ -37,7 +41,7 @@ class BlockAccessCipherStream {
   explicit BlockAccessCipherStream(EncryptionParamsPtr encryption_params);
   Status Init();
 
-  // Encrypt data at an offset.
+  // Encrypt data at an offset. Output could be the same buffer as input, to encrypt in place.
   Status Encrypt(
       uint64_t file_offset,
       const Slice& input,
@@ -45,7 +49,7 @@ class BlockAccessCipherStream {
       EncryptionOverflowWorkaround counter_overflow_workaround =
           EncryptionOverflowWorkaround::kFalse);
 
-  // Decrypt data at an offset.
+  // Decrypt data at an offset. Output could be the same buffer as input, to decrypt in place.
   // counter_overflow_workaround indicates whether we should add one to byte 11 of the initilization
   // vector. Used to as a workaround in case of block checksum mismatches when reading data that is
   // affected by https://github.com/yugabyte/yugabyte-db/issues/3707.
@@ -59,6 +63,17 @@ class BlockAccessCipherStream {
   bool UseOpensslCompatibleCounterOverflow();
 
  private:
+  struct CipherContextDeleter {
+    void operator()(EVP_CIPHER_CTX* ctx) const;
+  };
+
+  using CipherContextPtr = std::unique_ptr<EVP_CIPHER_CTX, CipherContextDeleter>;
+
+  // Returns context initialized with the cipher and key of the stream, so only iv has to be set
+  // for the operation.
+  Result<CipherContextPtr> TakeContext();
+  void ReturnContext(CipherContextPtr context);
+
   Status EncryptByBlock(
       uint64_t block_index,
       const Slice& input,
@@ -70,8 +85,11 @@ class BlockAccessCipherStream {
                         EncryptionOverflowWorkaround counter_overflow_workaround);
 
   EncryptionParamsPtr encryption_params_;
-  std::unique_ptr<EVP_CIPHER_CTX, std::function<void(EVP_CIPHER_CTX*)>> encryption_context_;
-  mutable simple_spinlock mutex_;
+  // Template context with expanded key, that is copied to create contexts of concurrent
+  // operations. It is never used for encryption itself.
+  CipherContextPtr encryption_context_;
+  simple_spinlock mutex_;
+  std::vector<CipherContextPtr> free_contexts_ GUARDED_BY(mutex_);
 };
 
 } // namespace encryption
@@ -128,6 +128,28 @@ TEST_F(TestCipherStream, ConcurrentEncryption) {
   }
 }
 
+TEST_F(TestCipherStream, InPlace) {
+  rpc::InitOpenSSL();
+
+  auto plaintext_bytes = RandomBytes(kDataSize);
+  auto cipher_stream = ASSERT_RESULT(BlockAccessCipherStream::FromEncryptionParams(
+      EncryptionParams::NewEncryptionParams()));
+  uint8_t encrypted_bytes[kDataSize];
+  ASSERT_OK(cipher_stream->Encrypt(
+      0, Slice(plaintext_bytes.data(), kDataSize), encrypted_bytes));
+
+  for (int i = 0; i < kNumRuns; i++) {
+    int start_idx = RandomUniformInt(0, kDataSize);
+    int size = RandomUniformInt(0, kDataSize - start_idx);
+    uint8_t buffer[kDataSize];
+    memcpy(buffer, encrypted_bytes + start_idx, size);
+    ASSERT_OK(cipher_stream->Decrypt(start_idx, Slice(buffer, size), buffer));
+    ASSERT_EQ(Slice(buffer, size), Slice(plaintext_bytes.data() + start_idx, size));
+    ASSERT_OK(cipher_stream->Encrypt(start_idx, Slice(buffer, size), buffer));
+    ASSERT_EQ(Slice(buffer, size), Slice(encrypted_bytes + start_idx, size));
+  }
+}
+
 TEST_F(TestCipherStream, Overflow) {
   // Create a cipher stream on a iv about to overflow.
   ASSERT_OK(TestOverFlowWithKeyType(true /* use_openssl_compatible_counter_overflow */ ));
@@ -24,6 +24,19 @@
 namespace yb {
 namespace encryption {
 
+namespace {
+
+// Max number of idle contexts kept by the stream, it is enough for the usual number of concurrent
+// reads of the same file.
+constexpr size_t kMaxFreeContexts = 8;
+
+} // namespace
+
+void BlockAccessCipherStream::CipherContextDeleter::operator()(EVP_CIPHER_CTX* ctx) const {
+  EVP_CIPHER_CTX_cleanup(ctx);
+  EVP_CIPHER_CTX_free(ctx);
+}
+
 Result<std::unique_ptr<BlockAccessCipherStream>> BlockAccessCipherStream::FromEncryptionParams(
     EncryptionParamsPtr encryption_params) {
   auto stream = std::make_unique<BlockAccessCipherStream>(std::move(encryption_params));
@@ -34,10 +47,7 @@ Result<std::unique_ptr<BlockAccessCipherStream>> BlockAccessCipherStream::FromEn
 BlockAccessCipherStream::BlockAccessCipherStream(
     EncryptionParamsPtr encryption_params) :
     encryption_params_(std::move(encryption_params)),
-    encryption_context_(EVP_CIPHER_CTX_new(), [](EVP_CIPHER_CTX* ctx){
-      EVP_CIPHER_CTX_cleanup(ctx);
-      EVP_CIPHER_CTX_free(ctx);
-    }) {}
+    encryption_context_(EVP_CIPHER_CTX_new()) {}
 
 Status BlockAccessCipherStream::Init() {
   EVP_CIPHER_CTX_init(encryption_context_.get());
@@ -57,8 +67,9 @@ Status BlockAccessCipherStream::Init() {
           encryption_params_->key_size);
   }
 
+  // Key is set once, so its schedule is not expanded again for each operation.
   const auto encrypt_init_ex_result = EVP_EncryptInit_ex(
-      encryption_context_.get(), cipher, /* impl */ nullptr, /* key */ nullptr,
+      encryption_context_.get(), cipher, /* impl */ nullptr, encryption_params_->key,
       /* iv */ nullptr);
   if (encrypt_init_ex_result != 1) {
     return STATUS_FORMAT(InternalError,
@@ -76,6 +87,30 @@ Status BlockAccessCipherStream::Init() {
   return Status::OK();
 }
 
+Result<BlockAccessCipherStream::CipherContextPtr> BlockAccessCipherStream::TakeContext() {
+  {
+    std::lock_guard<simple_spinlock> l(mutex_);
+    if (!free_contexts_.empty()) {
+      auto result = std::move(free_contexts_.back());
+      free_contexts_.pop_back();
+      return result;
+    }
+  }
+  CipherContextPtr result(EVP_CIPHER_CTX_new());
+  const auto copy_result = EVP_CIPHER_CTX_copy(result.get(), encryption_context_.get());
+  if (copy_result != 1) {
+    return STATUS_FORMAT(InternalError, "EVP_CIPHER_CTX_copy returned $0", copy_result);
+  }
+  return result;
+}
+
+void BlockAccessCipherStream::ReturnContext(CipherContextPtr context) {
+  std::lock_guard<simple_spinlock> l(mutex_);
+  if (free_contexts_.size() < kMaxFreeContexts) {
+    free_contexts_.push_back(std::move(context));
+  }
+}
+
 Status BlockAccessCipherStream::Encrypt(
     uint64_t file_offset,
     const Slice& input,
@@ -149,12 +184,12 @@ Status BlockAccessCipherStream::EncryptByBlock(
   const uint64_t start_index = encryption_params_->counter + block_index;
   IncrementCounter(start_index, iv, counter_overflow_workaround);
 
-  // Lock the encryption op since we modify encryption context.
-  std::lock_guard<simple_spinlock> l(mutex_);
+  // Each operation uses its own context, so concurrent operations are not serialized.
+  auto context = VERIFY_RESULT(TakeContext());
 
   const int init_result =
-      EVP_EncryptInit_ex(encryption_context_.get(), /* cipher */ nullptr, /* impl */ nullptr,
-                         encryption_params_->key, iv);
+      EVP_EncryptInit_ex(context.get(), /* cipher */ nullptr, /* impl */ nullptr,
+                         /* key */ nullptr, iv);
   if (init_result != 1) {
     return STATUS_FORMAT(InternalError,
                          "EVP_EncryptInit_ex returned $0 when encrypting/decrypting $1 bytes "
@@ -165,8 +200,7 @@ Status BlockAccessCipherStream::EncryptByBlock(
   // Perform the encryption.
   int bytes_updated = 0;
   const int update_result = EVP_EncryptUpdate(
-      encryption_context_.get(), static_cast<uint8_t*>(output), &bytes_updated, input.data(),
-      data_size);
+      context.get(), static_cast<uint8_t*>(output), &bytes_updated, input.data(), data_size);
   if (update_result != 1) {
     return STATUS_FORMAT(InternalError,
                          "EVP_EncryptUpdate returned $0 when encrypting/decrypting $1 bytes "
@@ -181,6 +215,7 @@ Status BlockAccessCipherStream::EncryptByBlock(
 
   }
 
+  ReturnContext(std::move(context));
   return Status::OK();
 }
 
@@ -47,8 +47,10 @@ Status EncryptedRandomAccessFile::ReadInternal(
   if (!scratch) {
     return STATUS(InvalidArgument, "scratch argument is null.");
   }
-  uint8_t* buf = static_cast<uint8_t*>(EncryptionBuffer::Get()->GetBuffer(n));
-  RETURN_NOT_OK(RandomAccessFileWrapper::Read(offset + header_size_, n, result, buf));
+  // Ciphertext is read directly into the destination buffer and decrypted in place. Underlying
+  // file could return data from its own buffer, then it is decrypted from there.
+  RETURN_NOT_OK(RandomAccessFileWrapper::Read(
+      offset + header_size_, n, result, pointer_cast<uint8_t*>(scratch)));
   RETURN_NOT_OK(stream_->Decrypt(offset, *result, scratch, counter_overflow_workaround));
   *result = Slice(scratch, result->size());
   return Status::OK();
@@ -35,6 +35,12 @@
 #include <stdio.h>
 #include <string.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "yb/gutil/integral_types.h"
 #include "yb/gutil/port.h"
 
@@ -83,6 +89,24 @@ inline bool memeq(const void* a_v, const void* b_v, size_t n) {
   return n == 0 || UNALIGNED_LOAD64(a) == UNALIGNED_LOAD64(b);
 }
 
+namespace internal {
+
+// Returns difference of the first differing bytes of a and b, given that x and y are
+// little endian 64 bit words loaded from a and b and x != y.
+inline int DiffFirstByte64(const uint8_t* a, const uint8_t* b, uint64 x, uint64 y) {
+#if defined(IS_LITTLE_ENDIAN)
+  size_t idx = __builtin_ctzll(x ^ y) >> 3;
+#else
+  size_t idx = __builtin_clzll(x ^ y) >> 3;
+#endif
+  return static_cast<int>(a[idx]) - static_cast<int>(b[idx]);
+}
+
+} // namespace internal
+
+// Encoded keys are usually short and share long common prefixes, so instead of byte by byte
+// comparison we look for the first differing byte in 16 byte (SSE2/NEON) and 8 byte blocks.
+// Result has the same sign as memcmp, and is equal to the difference of first differing bytes.
 inline int fastmemcmp_inlined(const void *a_void, const void *b_void, size_t n) {
   const uint8_t *a = reinterpret_cast<const uint8_t *>(a_void);
   const uint8_t *b = reinterpret_cast<const uint8_t *>(b_void);
@@ -90,20 +114,33 @@ inline int fastmemcmp_inlined(const void *a_void, const void *b_void, size_t n)
   if (n >= 64) {
     return memcmp(a, b, n);
   }
-  const void* a_limit = a + n;
-  const size_t sizeof_uint64 = sizeof(uint64);
-  while (a + sizeof_uint64 <= a_limit &&
-         UNALIGNED_LOAD64(a) == UNALIGNED_LOAD64(b)) {
-    a += sizeof_uint64;
-    b += sizeof_uint64;
+#if defined(__SSE2__)
+  for (; n >= 16; n -= 16, a += 16, b += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+    unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) ^ 0xffff;
+    if (mask) {
+      size_t idx = __builtin_ctz(mask);
+      return static_cast<int>(a[idx]) - static_cast<int>(b[idx]);
+    }
   }
-  const size_t sizeof_uint32 = sizeof(uint32);
-  if (a + sizeof_uint32 <= a_limit &&
-      UNALIGNED_LOAD32(a) == UNALIGNED_LOAD32(b)) {
-    a += sizeof_uint32;
-    b += sizeof_uint32;
+#elif defined(__ARM_NEON)
+  for (; n >= 16; n -= 16, a += 16, b += 16) {
+    uint8x16_t eq = vceqq_u8(vld1q_u8(a), vld1q_u8(b));
+    // All bytes equal iff minimum of comparison mask lanes is 0xff.
+    if (vminvq_u8(eq) != 0xff) {
+      break;
+    }
   }
-  while (a < a_limit) {
+#endif
+  for (; n >= sizeof(uint64); n -= sizeof(uint64), a += sizeof(uint64), b += sizeof(uint64)) {
+    uint64 x = UNALIGNED_LOAD64(a);
+    uint64 y = UNALIGNED_LOAD64(b);
+    if (x != y) {
+      return internal::DiffFirstByte64(a, b, x, y);
+    }
+  }
+  for (; n > 0; --n) {
     int d = static_cast<uint32>(*a++) - static_cast<uint32>(*b++);
     if (d) return d;
   }
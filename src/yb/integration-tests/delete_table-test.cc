@@ -438,6 +438,36 @@ TEST_F(DeleteTableTest, TestDeleteEmptyTable) {
       TestWorkloadOptions::kDefaultTableName.table_name()) == std::string::npos);
 }
 
+// Test that tablets of the deleted table are removed when master batches DeleteTablet RPCs.
+TEST_F(DeleteTableTest, TestDeleteTableBatchedDeleteTablets) {
+  ASSERT_NO_FATALS(StartCluster(
+      {}, {"--enable_master_delete_tablet_rpc_batching=true",
+           "--master_delete_tablet_rpc_batch_size=3"}));
+  ASSERT_OK(client_->CreateNamespaceIfNotExists(
+      TestWorkloadOptions::kDefaultTableName.namespace_name(),
+      TestWorkloadOptions::kDefaultTableName.namespace_type()));
+  // Number of tablets is not multiple of the batch size, so both full and delayed batches are sent.
+  const int kNumTablets = 5;
+  Schema schema(GetSimpleTestSchema());
+  client::YBSchema client_schema(client::YBSchemaFromSchema(schema));
+  std::unique_ptr<YBTableCreator> table_creator(client_->NewTableCreator());
+  ASSERT_OK(table_creator->table_name(TestWorkloadOptions::kDefaultTableName)
+                          .num_tablets(kNumTablets)
+                          .schema(&client_schema)
+                          .Create());
+  ASSERT_OK(inspect_->WaitForReplicaCount(kNumTablets * 3));
+
+  vector<string> tablets = inspect_->ListTabletsOnTS(1);
+  ASSERT_EQ(kNumTablets, tablets.size());
+
+  ASSERT_NO_FATALS(DeleteTable(TestWorkloadOptions::kDefaultTableName));
+  for (const auto& tablet_id : tablets) {
+    for (int i = 0; i < 3; i++) {
+      ASSERT_NO_FATALS(WaitForTabletDeletedOnTS(i, tablet_id, SUPERBLOCK_EXPECTED));
+    }
+  }
+}
+
 // Test that a DeleteTable RPC is rejected without a matching destination UUID.
 TEST_F(DeleteTableTest, TestDeleteTableDestUuidValidation) {
   ASSERT_NO_FATALS(StartCluster());
@@ -459,6 +459,9 @@ class RaftConsensusITest : public TabletServerIntegrationTestBase {
   static const bool WITHOUT_NOTIFICATION_LATENCY = false;
   void DoTestChurnyElections(bool with_latency);
 
+  // Removes and adds back servers while writes are running, using extra_ts_flags for tservers.
+  void DoTestConfigChangeUnderLoad(const vector<string>& extra_ts_flags);
+
  protected:
   // Flags needed for CauseFollowerToFallBehindLogGC() to work well.
   void AddFlagsForLogRolls(vector<string>* extra_tserver_flags);
@@ -626,6 +629,39 @@ TEST_F(RaftConsensusITest, MultiThreadedMutateAndInsertThroughConsensus) {
   ASSERT_ALL_REPLICAS_AGREE(FLAGS_client_inserts_per_thread * FLAGS_num_client_threads);
 }
 
+// Same as above, but with update requests pipelined to followers, so delays injected into the
+// followers fail requests in the middle of the pipeline.
+TEST_F(RaftConsensusITest, MultiThreadedInsertWithPipelinedUpdates) {
+  ASSERT_NO_FATALS(BuildAndStart({"--consensus_max_in_flight_update_requests=4"}));
+
+  int num_threads = FLAGS_num_client_threads;
+  for (int i = 0; i < num_threads; i++) {
+    scoped_refptr<yb::Thread> new_thread;
+    CHECK_OK(yb::Thread::Create("test", strings::Substitute("ts-test$0", i),
+                                  &RaftConsensusITest::InsertTestRowsRemoteThread,
+                                  this, i * FLAGS_client_inserts_per_thread,
+                                  FLAGS_client_inserts_per_thread,
+                                  FLAGS_client_num_batches_per_thread,
+                                  vector<CountDownLatch*>(),
+                                  &new_thread));
+    threads_.push_back(new_thread);
+  }
+  for (int i = 0; i < FLAGS_num_replicas; i++) {
+    scoped_refptr<yb::Thread> new_thread;
+    CHECK_OK(yb::Thread::Create("test", strings::Substitute("chaos-test$0", i),
+                                  &RaftConsensusITest::DelayInjectorThread,
+                                  this, cluster_->tablet_server(i),
+                                  kConsensusRpcTimeoutForTests,
+                                  &new_thread));
+    threads_.push_back(new_thread);
+  }
+  for (scoped_refptr<yb::Thread> thr : threads_) {
+    CHECK_OK(ThreadJoiner(thr.get()).Join());
+  }
+
+  ASSERT_ALL_REPLICAS_AGREE(FLAGS_client_inserts_per_thread * FLAGS_num_client_threads);
+}
+
 TEST_F(RaftConsensusITest, TestReadOnNonLeader) {
   ASSERT_NO_FATALS(BuildAndStart(vector<string>()));
 
@@ -2537,9 +2573,10 @@ void DoWriteTestRows(const TServerDetails* leader_tserver,
 }
 
 // Test that config change works while running a workload.
-TEST_F(RaftConsensusITest, TestConfigChangeUnderLoad) {
+void RaftConsensusITest::DoTestConfigChangeUnderLoad(const vector<string>& extra_ts_flags) {
   FLAGS_num_tablet_servers = 3;
   vector<string> ts_flags = { "--enable_leader_failure_detection=false" };
+  ts_flags.insert(ts_flags.end(), extra_ts_flags.begin(), extra_ts_flags.end());
   vector<string> master_flags = {
     "--catalog_manager_wait_for_new_tablets_to_elect_leader=false"s,
     "--use_create_table_leader_hint=false"s,
@@ -2639,6 +2676,15 @@ TEST_F(RaftConsensusITest, TestConfigChangeUnderLoad) {
   ASSERT_ALL_REPLICAS_AGREE(rows_inserted.load());
 }
 
+TEST_F(RaftConsensusITest, TestConfigChangeUnderLoad) {
+  DoTestConfigChangeUnderLoad({});
+}
+
+// Config changes should be applied in order with writes, that are applied asynchronously.
+TEST_F(RaftConsensusITest, TestConfigChangeUnderLoadWithAsyncApply) {
+  DoTestConfigChangeUnderLoad({"--consensus_apply_writes_async=true"});
+}
+
 TEST_F(RaftConsensusITest, TestMasterNotifiedOnConfigChange) {
   MonoDelta timeout = MonoDelta::FromSeconds(30);
   FLAGS_num_tablet_servers = 3;
@@ -64,6 +64,18 @@ DEFINE_test_flag(int32, slowdown_master_async_rpc_tasks_by_ms, 0,
                  "For testing purposes, slow down the run method to take longer.");
 
 // The flags are defined in catalog_manager.cc.
+DEFINE_RUNTIME_AUTO_bool(enable_master_delete_tablet_rpc_batching, kLocalVolatile, false, true,
+    "Send delete tablet requests of the master to the same tablet server in a single "
+    "DeleteTablets RPC.");
+
+DEFINE_RUNTIME_int32(master_delete_tablet_rpc_batch_size, 16,
+    "Maximum number of delete tablet requests to the same tablet server, that are sent by the "
+    "master in a single DeleteTablets RPC, when enable_master_delete_tablet_rpc_batching is set.");
+
+DEFINE_RUNTIME_int32(master_delete_tablet_rpc_batch_delay_ms, 10,
+    "Time the master accumulates delete tablet requests to the same tablet server, before sending "
+    "them in a single DeleteTablets RPC.");
+
 DECLARE_int32(master_ts_rpc_timeout_ms);
 DECLARE_int32(tablet_creation_timeout_ms);
 DECLARE_int32(TEST_slowdown_alter_table_rpcs_ms);
@@ -212,6 +224,7 @@ Status RetryingTSRpcTask::Run() {
                            << state;
   } else {
     rpc_.Reset();
+    batched_rpc_status_.reset();
   }
 
   // Calculate and set the timeout deadline.
@@ -307,15 +320,25 @@ void RetryingTSRpcTask::RpcCallback() {
   }
 }
 
+void RetryingTSRpcTask::BatchedRpcCallback(const Status& status) {
+  batched_rpc_status_ = status;
+  RpcCallback();
+}
+
+Status RetryingTSRpcTask::rpc_status() const {
+  return batched_rpc_status_ ? *batched_rpc_status_ : rpc_.status();
+}
+
 // Handle the actual work of the RPC callback. This is run on the master's worker
 // pool, rather than a reactor thread, so it may do blocking IO operations.
 void RetryingTSRpcTask::DoRpcCallback() {
-  VLOG_WITH_PREFIX_AND_FUNC(3) << "Rpc status: " << rpc_.status();
+  const auto rpc_status = this->rpc_status();
+  VLOG_WITH_PREFIX_AND_FUNC(3) << "Rpc status: " << rpc_status;
 
-  if (!rpc_.status().ok()) {
+  if (!rpc_status.ok()) {
     LOG_WITH_PREFIX(WARNING) << "TS " << target_ts_desc_->permanent_uuid() << ": "
                              << type_name() << " RPC failed for tablet "
-                             << tablet_id() << ": " << rpc_.status().ToString();
+                             << tablet_id() << ": " << rpc_status.ToString();
     if (!target_ts_desc_->IsLive() && type() == MonitoredTaskType::kDeleteReplica) {
       LOG_WITH_PREFIX(WARNING)
           << "TS " << target_ts_desc_->permanent_uuid() << ": delete failed for tablet "
@@ -854,13 +877,25 @@ bool AsyncDeleteReplica::SendRequest(int attempt) {
                                   table()->LockForRead()->started_deleting();
   req.set_should_abort_active_txns(should_abort_active_txns);
 
-  ts_admin_proxy_->DeleteTabletAsync(req, &resp_, &rpc_, BindRpcCallback());
   VLOG_WITH_PREFIX(1) << "Send delete tablet request to " << permanent_uuid_
                       << " (attempt " << attempt << "):\n"
                       << req.DebugString();
+  if (GetAtomicFlag(&FLAGS_enable_master_delete_tablet_rpc_batching) &&
+      FLAGS_master_delete_tablet_rpc_batch_size > 1) {
+    master_->delete_replica_batcher().Add(
+        shared_from(this), &req, permanent_uuid_, ts_admin_proxy_);
+    return true;
+  }
+  ts_admin_proxy_->DeleteTabletAsync(req, &resp_, &rpc_, BindRpcCallback());
   return true;
 }
 
+void AsyncDeleteReplica::BatchedResponse(
+    const Status& status, tserver::DeleteTabletResponsePB* resp) {
+  resp_.Swap(resp);
+  BatchedRpcCallback(status);
+}
+
 void AsyncDeleteReplica::UnregisterAsyncTaskCallback() {
   // Only notify if we are in a success state.
   if (state() == MonitoredTaskState::kComplete) {
@@ -868,6 +903,120 @@ void AsyncDeleteReplica::UnregisterAsyncTaskCallback() {
   }
 }
 
+// ============================================================================
+//  Class DeleteReplicaBatcher.
+// ============================================================================
+struct DeleteReplicaBatcher::Batch {
+  std::shared_ptr<tserver::TabletServerAdminServiceProxy> proxy;
+  tserver::DeleteTabletsRequestPB req;
+  tserver::DeleteTabletsResponsePB resp;
+  rpc::RpcController controller;
+  std::vector<std::shared_ptr<AsyncDeleteReplica>> tasks;
+};
+
+DeleteReplicaBatcher::DeleteReplicaBatcher(Master* master) : master_(master) {}
+
+DeleteReplicaBatcher::~DeleteReplicaBatcher() = default;
+
+void DeleteReplicaBatcher::Add(
+    std::shared_ptr<AsyncDeleteReplica> task, tserver::DeleteTabletRequestPB* req,
+    const std::string& ts_uuid,
+    const std::shared_ptr<tserver::TabletServerAdminServiceProxy>& proxy) {
+  BatchPtr new_batch;
+  BatchPtr full_batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& batch = pending_[ts_uuid];
+    if (!batch) {
+      batch = std::make_shared<Batch>();
+      batch->req.set_dest_uuid(ts_uuid);
+      new_batch = batch;
+    }
+    batch->proxy = proxy;
+    batch->req.add_requests()->Swap(req);
+    batch->tasks.push_back(std::move(task));
+    if (batch->tasks.size() >= static_cast<size_t>(FLAGS_master_delete_tablet_rpc_batch_size)) {
+      full_batch = std::move(batch);
+      pending_.erase(ts_uuid);
+    }
+  }
+
+  if (full_batch) {
+    Send(full_batch);
+    return;
+  }
+  if (!new_batch) {
+    return;
+  }
+
+  auto* messenger = master_->messenger();
+  auto task_id = messenger->ScheduleOnReactor(
+      [weak_self = weak_from_this(), ts_uuid, new_batch](const Status& status) {
+        auto self = weak_self.lock();
+        if (self) {
+          self->SendPending(ts_uuid, new_batch, status);
+        }
+      },
+      FLAGS_master_delete_tablet_rpc_batch_delay_ms * 1ms, SOURCE_LOCATION(), messenger);
+  if (task_id == rpc::kInvalidTaskId) {
+    SendPending(ts_uuid, new_batch, STATUS(Aborted, "Failed to schedule delete tablets batch"));
+  }
+}
+
+void DeleteReplicaBatcher::SendPending(
+    const std::string& ts_uuid, const BatchPtr& batch, const Status& status) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = pending_.find(ts_uuid);
+    // The batch could be already sent because it became full.
+    if (it == pending_.end() || it->second != batch) {
+      return;
+    }
+    pending_.erase(it);
+  }
+
+  if (!status.ok()) {
+    Complete(batch, status);
+    return;
+  }
+  Send(batch);
+}
+
+void DeleteReplicaBatcher::Send(const BatchPtr& batch) {
+  VLOG(1) << "Send delete tablets request with " << batch->tasks.size() << " tablets to "
+          << batch->req.dest_uuid();
+  batch->controller.set_timeout(FLAGS_master_ts_rpc_timeout_ms * 1ms);
+  // The callback is kept by the controller of the batch, so release the batch on completion to
+  // avoid reference cycle.
+  batch->proxy->DeleteTabletsAsync(
+      batch->req, &batch->resp, &batch->controller, [batch]() mutable {
+        auto completed = std::move(batch);
+        Complete(completed, completed->controller.status());
+      });
+}
+
+void DeleteReplicaBatcher::Complete(const BatchPtr& batch, const Status& status) {
+  auto batch_status = status;
+  if (batch_status.ok() && !batch->resp.has_error() &&
+      static_cast<size_t>(batch->resp.responses_size()) != batch->tasks.size()) {
+    batch_status = STATUS_FORMAT(
+        IllegalState, "Wrong number of delete tablet responses from $0: $1, expected $2",
+        batch->req.dest_uuid(), batch->resp.responses_size(), batch->tasks.size());
+  }
+
+  for (size_t i = 0; i != batch->tasks.size(); ++i) {
+    tserver::DeleteTabletResponsePB resp;
+    if (batch_status.ok()) {
+      if (batch->resp.has_error()) {
+        *resp.mutable_error() = batch->resp.error();
+      } else {
+        resp.Swap(batch->resp.mutable_responses(narrow_cast<int>(i)));
+      }
+    }
+    batch->tasks[i]->BatchedResponse(batch_status, &resp);
+  }
+}
+
 // ============================================================================
 //  Class AsyncAlterTable.
 // ============================================================================
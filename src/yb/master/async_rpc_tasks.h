@@ -13,7 +13,11 @@
 #pragma once
 
 #include <atomic>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <boost/optional/optional.hpp>
 
@@ -27,6 +31,7 @@
 
 #include "yb/gutil/ref_counted.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/thread_annotations.h"
 
 #include "yb/master/master_fwd.h"
 #include "yb/master/catalog_manager_if.h"
@@ -186,6 +191,13 @@ class RetryingTSRpcTask : public server::MonitoredTask {
   // Callback meant to be invoked from asynchronous RPC service proxy calls.
   void RpcCallback();
 
+  // Callback for the task whose request was sent as a part of the batch RPC, status is the status
+  // of that batch RPC. Response of the task should be filled before this call.
+  void BatchedRpcCallback(const Status& status);
+
+  // Status of the RPC that carried the request of this task.
+  Status rpc_status() const;
+
   auto BindRpcCallback() {
     return std::bind(&RetryingTSRpcTask::RpcCallback, shared_from(this));
   }
@@ -218,6 +230,8 @@ class RetryingTSRpcTask : public server::MonitoredTask {
 
   int attempt_ = 0;
   rpc::RpcController rpc_;
+  // Set when the request of the current attempt was sent as a part of the batch RPC.
+  std::optional<Status> batched_rpc_status_;
   TSDescriptor* target_ts_desc_ = nullptr;
   std::shared_ptr<tserver::TabletServerServiceProxy> ts_proxy_;
   std::shared_ptr<tserver::TabletServerAdminServiceProxy> ts_admin_proxy_;
@@ -433,6 +447,9 @@ class AsyncDeleteReplica : public RetrySpecificTSRpcTask {
     keep_data_ = value;
   }
 
+  // Invoked by DeleteReplicaBatcher when the batch containing request of this task is completed.
+  void BatchedResponse(const Status& status, tserver::DeleteTabletResponsePB* resp);
+
  protected:
   TabletId tablet_id() const override { return tablet_id_; }
 
@@ -449,6 +466,34 @@ class AsyncDeleteReplica : public RetrySpecificTSRpcTask {
   bool keep_data_ = false;
 };
 
+// Coalesces DeleteTablet requests of AsyncDeleteReplica tasks to the same tablet server into
+// DeleteTablets RPCs. Each task still handles its own item of the response, including retries.
+class DeleteReplicaBatcher : public std::enable_shared_from_this<DeleteReplicaBatcher> {
+ public:
+  explicit DeleteReplicaBatcher(Master* master);
+  ~DeleteReplicaBatcher();
+
+  // Adds request of the task to the pending batch of the tablet server. The batch is sent when
+  // it is full, or after master_delete_tablet_rpc_batch_delay_ms since its first request.
+  void Add(
+      std::shared_ptr<AsyncDeleteReplica> task, tserver::DeleteTabletRequestPB* req,
+      const std::string& ts_uuid,
+      const std::shared_ptr<tserver::TabletServerAdminServiceProxy>& proxy);
+
+ private:
+  struct Batch;
+  using BatchPtr = std::shared_ptr<Batch>;
+
+  // Sends the pending batch of the tablet server, if it is still pending.
+  void SendPending(const std::string& ts_uuid, const BatchPtr& batch, const Status& status);
+  void Send(const BatchPtr& batch);
+  static void Complete(const BatchPtr& batch, const Status& status);
+
+  Master* const master_;
+  std::mutex mutex_;
+  std::unordered_map<std::string, BatchPtr> pending_ GUARDED_BY(mutex_);
+};
+
 // Send the "Alter Table" with the latest table schema to the leader replica
 // for the tablet.
 // Keeps retrying until we get an "ok" response.
@@ -1456,6 +1456,8 @@ bool BackfillChunk::SendRequest(int attempt) {
   }
   req.set_propagated_hybrid_time(backfill_tablet_->master()->clock()->Now().ToUint64());
 
+  // Backfill should not delay user traffic on the tablet server.
+  rpc_.set_priority_class(rpc::RpcPriorityClass::kBackground);
   ts_admin_proxy_->BackfillIndexAsync(req, &resp_, &rpc_, BindRpcCallback());
   VLOG(1) << "Send " << description() << " to " << permanent_uuid()
           << " (attempt " << attempt << "):\n"
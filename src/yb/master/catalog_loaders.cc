@@ -244,7 +244,7 @@ Status TabletLoader::Visit(const TabletId& tablet_id, const SysTabletsEntryPB& m
         should_delete_tablet = false;
       }
 
-      auto schema = tl->schema();
+      const auto& schema = tl->schema();
       ColocationId colocation_id = kColocationIdNotSet;
       bool is_colocated = true;
       if (schema.has_colocated_table_id() &&
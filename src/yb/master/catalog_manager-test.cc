@@ -33,6 +33,12 @@
 #include "yb/master/catalog_manager-test_base.h"
 #include "yb/master/master_client.pb.h"
 #include "yb/master/master_cluster.pb.h"
+#include "yb/master/master_types.pb.h"
+
+#include "yb/util/flags.h"
+
+DECLARE_double(load_balancer_disk_cost_weight);
+DECLARE_double(load_balancer_ops_cost_weight);
 
 namespace yb {
 namespace master {
@@ -101,6 +107,38 @@ TEST(TableInfoTest, TestAssignmentRanges) {
   }
 }
 
+TEST(TestLoadBalancerCommunity, TabletServerCosts) {
+  auto ts0 = SetupTS("0000", "a");
+  auto ts1 = SetupTS("1111", "a");
+  TServerMetricsPB metrics;
+  metrics.set_total_sst_file_size(1000);
+  metrics.set_read_ops_per_sec(10);
+  ts0->UpdateMetrics(metrics);
+  metrics.set_total_sst_file_size(250);
+  metrics.set_read_ops_per_sec(30);
+  ts1->UpdateMetrics(metrics);
+
+  GlobalLoadState state;
+  state.ts_descs_ = {ts0, ts1};
+  state.ComputeTabletServerCosts();
+  // Costs are disabled by default.
+  ASSERT_EQ(state.GetTabletServerCost("0000"), 0);
+  ASSERT_EQ(state.GetTabletServerCost("1111"), 0);
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_load_balancer_disk_cost_weight) = 1;
+  state.ComputeTabletServerCosts();
+  ASSERT_DOUBLE_EQ(state.GetTabletServerCost("0000"), 1);
+  ASSERT_DOUBLE_EQ(state.GetTabletServerCost("1111"), 0.25);
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_load_balancer_ops_cost_weight) = 2;
+  state.ComputeTabletServerCosts();
+  ASSERT_DOUBLE_EQ(state.GetTabletServerCost("0000"), 1 + 2.0 / 3);
+  ASSERT_DOUBLE_EQ(state.GetTabletServerCost("1111"), 0.25 + 2);
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_load_balancer_disk_cost_weight) = 0;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_load_balancer_ops_cost_weight) = 0;
+}
+
 TEST(TestTSDescriptor, TestReplicaCreationsDecay) {
   TSDescriptor ts("test");
   ASSERT_EQ(0, ts.RecentReplicaCreations());
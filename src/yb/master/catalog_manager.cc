@@ -247,6 +247,16 @@ DEFINE_RUNTIME_int32(catalog_manager_report_batch_size, 1,
     "The max number of tablets evaluated in the heartbeat as a single SysCatalog update.");
 TAG_FLAG(catalog_manager_report_batch_size, advanced);
 
+DEFINE_RUNTIME_int32(catalog_manager_assignments_batch_size_tables, 16,
+    "The max number of tables, whose pending tablet assignments are persisted by the catalog "
+    "manager background task as a single SysCatalog update.");
+TAG_FLAG(catalog_manager_assignments_batch_size_tables, advanced);
+
+DEFINE_RUNTIME_int32(catalog_manager_report_lookup_batch_size, 1000,
+    "The max number of tablets of the tablet report, that are looked up in the catalog while "
+    "holding catalog manager lock. The lock is released between such batches.");
+TAG_FLAG(catalog_manager_report_lookup_batch_size, advanced);
+
 // TODO: Is this code even useful?
 DEFINE_RUNTIME_int32(master_failover_catchup_timeout_ms, 30 * 1000 * yb::kTimeMultiplier,  // 30 sec
     "Amount of time to give a newly-elected leader master to load"
@@ -255,6 +265,12 @@ DEFINE_RUNTIME_int32(master_failover_catchup_timeout_ms, 30 * 1000 * yb::kTimeMu
 TAG_FLAG(master_failover_catchup_timeout_ms, advanced);
 TAG_FLAG(master_failover_catchup_timeout_ms, experimental);
 
+DEFINE_RUNTIME_bool(master_lock_free_catalog_lookups, true,
+    "Whether table and tablet lookups by id, used by read only master RPCs like "
+    "GetTableLocations and GetTabletLocations, go through the immutable snapshot of catalog "
+    "maps, instead of acquiring catalog manager lock.");
+TAG_FLAG(master_lock_free_catalog_lookups, advanced);
+
 DEFINE_RUNTIME_bool(master_tombstone_evicted_tablet_replicas, true,
     "Whether the Master should tombstone (delete) tablet replicas that "
     "are no longer part of the latest reported raft config.");
@@ -432,6 +448,17 @@ DEFINE_RUNTIME_int64(tablet_split_low_phase_size_threshold_bytes, 512_MB,
 DEFINE_RUNTIME_int64(tablet_split_high_phase_size_threshold_bytes, 10_GB,
     "The tablet size threshold at which to split tablets in phase 2. "
     "See tablet_split_high_phase_shard_count_per_node.");
+DEFINE_RUNTIME_double(tablet_split_load_threshold_ops_per_sec, 0,
+    "The rate of read and write requests handled by the tablet leader at which to split the "
+    "tablet regardless of its size, if it is not smaller than "
+    "tablet_split_load_min_size_bytes. 0 disables load based splitting.");
+DEFINE_RUNTIME_int64(tablet_split_load_min_size_bytes, 64_MB,
+    "Tablets smaller than this size are not split because of the load. "
+    "See tablet_split_load_threshold_ops_per_sec.");
+DEFINE_RUNTIME_double(tablet_split_load_max_hot_key_fraction, 0.5,
+    "Tablets whose single hottest key receives at least this fraction of the sampled reads or "
+    "writes are not split because of the load, since the split would not distribute the load "
+    "of that key. See tablet_split_load_threshold_ops_per_sec.");
 DEFINE_RUNTIME_int64(tablet_force_split_threshold_bytes, 100_GB,
     "The tablet size threshold at which to split tablets regardless of how many tablets "
     "exist in the table already. This should be configured to prevent runaway whale "
@@ -1068,6 +1095,7 @@ Status CatalogManager::GetTableDiskSize(const GetTableDiskSizeRequestPB* req,
   }
 
   int64 table_size = 0;
+  uint64 estimated_num_rows = 0;
   int32 num_missing_tablets = 0;
   if (!table_info->IsColocatedUserTable()) {
     // Colocated user tables do not have size info
@@ -1089,6 +1117,7 @@ Status CatalogManager::GetTableDiskSize(const GetTableDiskSizeRequestPB* req,
 
         table_size += drive_info.wal_files_size;
         table_size += drive_info.sst_files_size;
+        estimated_num_rows += drive_info.estimated_num_rows;
       } else {
         ++num_missing_tablets;
       }
@@ -1097,6 +1126,7 @@ Status CatalogManager::GetTableDiskSize(const GetTableDiskSizeRequestPB* req,
 
   resp->set_size(table_size);
   resp->set_num_missing_tablets(num_missing_tablets);
+  resp->set_estimated_num_rows(estimated_num_rows);
 
   return Status::OK();
 }
@@ -1247,7 +1277,7 @@ Status CatalogManager::Load(const std::string& title, const int64_t term) {
   LOG_WITH_PREFIX(INFO) << __func__ << ": Loading " << title << " into memory.";
   std::unique_ptr<Loader> loader = std::make_unique<Loader>(this, term);
   RETURN_NOT_OK_PREPEND(
-      sys_catalog_->Visit(loader.get()),
+      sys_catalog_->Visit(loader.get(), background_tasks_thread_pool_.get()),
       "Failed while visiting " + title + " in sys catalog");
   return Status::OK();
 }
@@ -2738,6 +2768,20 @@ Status CatalogManager::ShouldSplitValidCandidate(
   }
   ssize_t size = drive_info.sst_files_size;
   DCHECK(size >= 0) << "Detected overflow in casting sst_files_size to signed int.";
+  const auto load_threshold = FLAGS_tablet_split_load_threshold_ops_per_sec;
+  if (load_threshold > 0 && size >= FLAGS_tablet_split_load_min_size_bytes) {
+    auto ops_per_sec = drive_info.read_ops_per_sec + drive_info.write_ops_per_sec;
+    if (ops_per_sec >= load_threshold) {
+      if (drive_info.hot_key_fraction < FLAGS_tablet_split_load_max_hot_key_fraction) {
+        VLOG(1) << Format("Tablet $0 load ($1 ops/sec) >= load threshold ($2)",
+                          tablet_info.id(), ops_per_sec, load_threshold);
+        return Status::OK();
+      }
+      VLOG(1) << Format("Tablet $0 is not split by load, hot key fraction ($1) >= max ($2)",
+                        tablet_info.id(), drive_info.hot_key_fraction,
+                        FLAGS_tablet_split_load_max_hot_key_fraction);
+    }
+  }
   if (size < FLAGS_tablet_split_low_phase_size_threshold_bytes) {
     return STATUS_FORMAT(IllegalState, "Tablet $0 SST size ($0) < low phase size threshold ($1).",
         tablet_info.id(), size, FLAGS_tablet_split_low_phase_size_threshold_bytes);
@@ -2932,7 +2976,12 @@ Status CatalogManager::DoSplitTablet(
 
 Result<scoped_refptr<TabletInfo>> CatalogManager::GetTabletInfo(const TabletId& tablet_id)
     EXCLUDES(mutex_) {
+  auto tablet = FindTabletInSnapshot(tablet_id);
+  if (tablet) {
+    return tablet;
+  }
   SharedLock lock(mutex_);
+  UpdateLookupSnapshots();
   return GetTabletInfoUnlocked(tablet_id);
 }
 
@@ -5006,7 +5055,14 @@ Status CatalogManager::RemoveTableIdsFromTabletInfo(
 
 Result<scoped_refptr<TableInfo>> CatalogManager::FindTable(
     const TableIdentifierPB& table_identifier) const {
+  if (table_identifier.has_table_id()) {
+    auto table = FindTableInSnapshot(table_identifier.table_id());
+    if (table) {
+      return table;
+    }
+  }
   SharedLock lock(mutex_);
+  UpdateLookupSnapshots();
   return FindTableUnlocked(table_identifier);
 }
 
@@ -5040,10 +5096,43 @@ Result<scoped_refptr<TableInfo>> CatalogManager::FindTableUnlocked(
 
 Result<scoped_refptr<TableInfo>> CatalogManager::FindTableById(
     const TableId& table_id) const {
+  auto table = FindTableInSnapshot(table_id);
+  if (table) {
+    return table;
+  }
   SharedLock lock(mutex_);
+  UpdateLookupSnapshots();
   return FindTableByIdUnlocked(table_id);
 }
 
+scoped_refptr<TableInfo> CatalogManager::FindTableInSnapshot(const TableId& table_id) const
+    NO_THREAD_SAFETY_ANALYSIS {
+  if (!GetAtomicFlag(&FLAGS_master_lock_free_catalog_lookups)) {
+    return nullptr;
+  }
+  // Only atomic version of table_ids_map_ is accessed, so mutex_ is not required.
+  auto snapshot = table_ids_map_snapshot_.GetIfActual(table_ids_map_);
+  return snapshot ? FindPtrOrNull(snapshot->value, table_id) : nullptr;
+}
+
+scoped_refptr<TabletInfo> CatalogManager::FindTabletInSnapshot(const TabletId& tablet_id) const
+    NO_THREAD_SAFETY_ANALYSIS {
+  if (!GetAtomicFlag(&FLAGS_master_lock_free_catalog_lookups)) {
+    return nullptr;
+  }
+  // Only atomic version of tablet_map_ is accessed, so mutex_ is not required.
+  auto snapshot = tablet_map_snapshot_.GetIfActual(tablet_map_);
+  return snapshot ? FindPtrOrNull(snapshot->value, tablet_id) : nullptr;
+}
+
+void CatalogManager::UpdateLookupSnapshots() const {
+  if (!GetAtomicFlag(&FLAGS_master_lock_free_catalog_lookups)) {
+    return;
+  }
+  table_ids_map_snapshot_.Update(table_ids_map_);
+  tablet_map_snapshot_.Update(tablet_map_);
+}
+
 Result<scoped_refptr<TableInfo>> CatalogManager::FindTableByIdUnlocked(
     const TableId& table_id) const {
   auto it = table_ids_map_->find(table_id);
@@ -7293,25 +7382,21 @@ Status CatalogManager::ProcessTabletReportBatch(
     ReportedTablets::iterator end,
     TabletReportUpdatesPB* full_report_update,
     std::vector<RetryingTSRpcTaskPtr>* rpcs) {
-  // 1. First Pass. Iterate in TabletId Order to discover all Table locks we'll need. Even though
-  //    read locks are sufficient here, take write locks since we'll be writing to the tablet while
-  //    holding this.
-  //    Need to acquire both types of locks in Id order to prevent deadlock.
-  std::map<TableId, TableInfo::WriteLock> table_write_locks;
+  // 1. First Pass. Discover all Table locks we'll need. Even though read locks are sufficient
+  //    here, take write locks since we'll be writing to the tablet while holding this.
+  //    Need to acquire both types of locks in Id order to prevent deadlock, so tables are locked
+  //    after all of them are collected, including colocated tables.
+  std::map<TableId, TableInfo*> tables_to_lock;
   for (auto it = begin; it != end; ++it) {
-    auto& lock = table_write_locks[it->info->table()->id()];
-    if (!lock.locked()) {
-      lock = it->info->table()->LockForWrite();
-    }
-    // Acquire locks for all colocated tables reported
-    // in sorted order of table ids (We use a map).
+    tables_to_lock.emplace(it->table_id, it->info->table().get());
     for (const auto& id_to_info : it->tables) {
-      auto& lock = table_write_locks[id_to_info.first];
-      if (!lock.locked()) {
-        lock = id_to_info.second->LockForWrite();
-      }
+      tables_to_lock.emplace(id_to_info.first, id_to_info.second.get());
     }
   }
+  std::map<TableId, TableInfo::WriteLock> table_write_locks;
+  for (const auto& [table_id, table] : tables_to_lock) {
+    table_write_locks[table_id] = table->LockForWrite();
+  }
 
   map<TabletId, TabletInfo::WriteLock> tablet_write_locks; // used for unlock.
   // 2. Second Pass.  Process each tablet. This may not be in the order that the tablets
@@ -7524,13 +7609,17 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
   // Tablet Deletes to process after the catalog lock below.
   set<TabletId> orphaned_tablets;
 
-  {
-    // Lock the catalog to iterate over tablet_ids_map_ & table_ids_map_.
+  // Fill the above variables before processing
+  full_report_update->mutable_tablets()->Reserve(num_tablets);
+  const auto lookup_batch_size = std::max(
+      GetAtomicFlag(&FLAGS_catalog_manager_report_lookup_batch_size), 1);
+  for (int batch_begin = 0; batch_begin < num_tablets; batch_begin += lookup_batch_size) {
+    // Lock the catalog to iterate over tablet_ids_map_ & table_ids_map_. The lock is released
+    // between batches, so a big report does not block catalog writers for the whole lookup.
     SharedLock lock(mutex_);
-
-    // Fill the above variables before processing
-    full_report_update->mutable_tablets()->Reserve(num_tablets);
-    for (const ReportedTabletPB& report : full_report.updated_tablets()) {
+    const auto batch_end = std::min(num_tablets, batch_begin + lookup_batch_size);
+    for (int idx = batch_begin; idx != batch_end; ++idx) {
+      const ReportedTabletPB& report = full_report.updated_tablets(idx);
       const string& tablet_id = report.tablet_id();
 
       // 1a. Find the tablet, deleting/skipping it if it can't be found.
@@ -7558,6 +7647,7 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
       // 1b. Found the tablet, update local state.
       reported_tablets.push_back(ReportedTablet {
         .tablet_id = tablet_id,
+        .table_id = tablet->table()->id(),
         .info = tablet,
         .report = &report,
         .tables = {}
@@ -7577,8 +7667,10 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
     }
   }
 
+  // Group tablets by table, so each batch locks as few tables as possible, and reports of tablets
+  // of the same table are processed together.
   std::sort(reported_tablets.begin(), reported_tablets.end(), [](const auto& lhs, const auto& rhs) {
-    return lhs.tablet_id < rhs.tablet_id;
+    return std::tie(lhs.table_id, lhs.tablet_id) < std::tie(rhs.table_id, rhs.tablet_id);
   });
 
   // Process any delete requests from orphaned tablets, identified above.
@@ -10241,8 +10333,70 @@ Status CatalogManager::HandleTabletSchemaVersionReport(
   return MultiStageAlterTable::LaunchNextTableInfoVersionIfNecessary(this, table, version);
 }
 
-Status CatalogManager::ProcessPendingAssignmentsPerTable(
-    const TableId& table_id, const TabletInfos& tablets, CMGlobalLoadState* global_load_state) {
+// Assignments of the table's tablets, that were prepared but not yet persisted. Tablets stay
+// locked until the assignments are persisted or aborted.
+struct PendingTableAssignments {
+  PendingTableAssignments() = default;
+  PendingTableAssignments(const PendingTableAssignments&) = delete;
+  void operator=(const PendingTableAssignments&) = delete;
+
+  bool empty() const {
+    return deferred.modified_tablets.empty() && deferred.needs_create_rpc.empty();
+  }
+
+  TableId table_id;
+  TabletInfos tablets;
+  ScopedInfoCommitter<TabletInfo> unlocker_in{&tablets};
+  // Any tablets created by the helper functions will also be created in a locked state, so we must
+  // ensure they are unlocked before we return to avoid deadlocks.
+  TabletInfos new_tablets;
+  ScopedInfoCommitter<TabletInfo> unlocker_out{&new_tablets};
+  DeferredAssignmentActions deferred;
+  std::unordered_set<TableInfo*> ok_status_tables;
+};
+
+bool CatalogManager::ProcessPendingAssignments(
+    const TableToTabletInfos& tables, CMGlobalLoadState* global_load_state) {
+  const size_t batch_size = std::max(
+      GetAtomicFlag(&FLAGS_catalog_manager_assignments_batch_size_tables), 1);
+  bool processed_tablets = false;
+  std::vector<std::unique_ptr<PendingTableAssignments>> batch;
+  auto persist_batch = [this, &batch, &processed_tablets] {
+    if (batch.empty()) {
+      return;
+    }
+    auto s = PersistPendingAssignments(&batch);
+    WARN_NOT_OK(s, "Assignment failed");
+    // Set processed_tablets as true if the call succeeds for at least one table.
+    processed_tablets = processed_tablets || s.ok();
+    batch.clear();
+  };
+  for (const auto& entries : tables) {
+    LOG(INFO) << "Processing pending assignments for table: " << entries.first;
+    auto assignments = std::make_unique<PendingTableAssignments>();
+    auto s = PreparePendingAssignments(
+        entries.first, entries.second, global_load_state, assignments.get());
+    if (!s.ok()) {
+      WARN_NOT_OK(s, "Assignment failed");
+      continue;
+    }
+    if (assignments->empty()) {
+      // Nothing to do.
+      processed_tablets = true;
+      continue;
+    }
+    batch.push_back(std::move(assignments));
+    if (batch.size() >= batch_size) {
+      persist_batch();
+    }
+  }
+  persist_batch();
+  return processed_tablets;
+}
+
+Status CatalogManager::PreparePendingAssignments(
+    const TableId& table_id, const TabletInfos& tablets, CMGlobalLoadState* global_load_state,
+    PendingTableAssignments* assignments) {
   VLOG(1) << "Processing pending assignments";
 
   TSDescriptorVector ts_descs = GetAllLiveNotBlacklistedTServers();
@@ -10252,20 +10406,15 @@ Status CatalogManager::ProcessPendingAssignmentsPerTable(
   InitializeTableLoadState(table_id, ts_descs, &table_load_state);
   table_load_state.SortLoad();
 
-  // Take write locks on all tablets to be processed, and ensure that they are
-  // unlocked at the end of this scope.
+  // Take write locks on all tablets to be processed, they are unlocked when assignments are
+  // persisted or aborted.
+  assignments->table_id = table_id;
+  assignments->tablets = tablets;
   for (const scoped_refptr<TabletInfo>& tablet : tablets) {
     tablet->mutable_metadata()->StartMutation();
   }
-  ScopedInfoCommitter<TabletInfo> unlocker_in(&tablets);
-
-  // Any tablets created by the helper functions will also be created in a
-  // locked state, so we must ensure they are unlocked before we return to
-  // avoid deadlocks.
-  TabletInfos new_tablets;
-  ScopedInfoCommitter<TabletInfo> unlocker_out(&new_tablets);
 
-  DeferredAssignmentActions deferred;
+  auto& deferred = assignments->deferred;
 
   // Iterate over each of the tablets and handle it, whatever state
   // it may be in. The actions required for the tablet are collected
@@ -10279,7 +10428,7 @@ Status CatalogManager::ProcessPendingAssignmentsPerTable(
         break;
 
       case SysTabletsEntryPB::CREATING:
-        HandleAssignCreatingTablet(tablet.get(), &deferred, &new_tablets);
+        HandleAssignCreatingTablet(tablet.get(), &deferred, &assignments->new_tablets);
         break;
 
       default:
@@ -10290,97 +10439,121 @@ Status CatalogManager::ProcessPendingAssignmentsPerTable(
   }
 
   // Nothing to do.
-  if (deferred.modified_tablets.empty() &&
-      deferred.needs_create_rpc.empty()) {
+  if (assignments->empty()) {
+    assignments->unlocker_out.Commit();
+    assignments->unlocker_in.Commit();
     return Status::OK();
   }
 
   // For those tablets which need to be created in this round, assign replicas.
-  Status s;
-  std::unordered_set<TableInfo*> ok_status_tables;
   for (TabletInfo *tablet : deferred.needs_create_rpc) {
     // NOTE: if we fail to select replicas on the first pass (due to
     // insufficient Tablet Servers being online), we will still try
     // again unless the tablet/table creation is cancelled.
     LOG(INFO) << "Selecting replicas for tablet " << tablet->id();
-    s = SelectReplicasForTablet(ts_descs, tablet, &table_load_state, global_load_state);
+    auto s = SelectReplicasForTablet(ts_descs, tablet, &table_load_state, global_load_state);
     if (!s.ok()) {
       s = s.CloneAndPrepend(Substitute(
           "An error occurred while selecting replicas for tablet $0: $1",
           tablet->tablet_id(), s.ToString()));
       tablet->table()->SetCreateTableErrorStatus(s);
-      break;
-    } else {
-      ok_status_tables.emplace(tablet->table().get());
+      AbortPendingAssignments(assignments, s);
+      return s;
     }
+    assignments->ok_status_tables.emplace(tablet->table().get());
   }
 
-  // Update the sys catalog with the new set of tablets/metadata.
-  if (s.ok()) {
+  return Status::OK();
+}
+
+Status CatalogManager::PersistPendingAssignments(
+    std::vector<std::unique_ptr<PendingTableAssignments>>* batch) {
+  // Update the sys catalog with the new set of tablets/metadata of all tables of the batch, using
+  // single write.
+  std::vector<TabletInfo*> modified_tablets;
+  for (const auto& assignments : *batch) {
+    modified_tablets.insert(
+        modified_tablets.end(), assignments->deferred.modified_tablets.begin(),
+        assignments->deferred.modified_tablets.end());
+  }
+  auto s = sys_catalog_->Upsert(leader_ready_term(), modified_tablets);
+  if (!s.ok()) {
+    s = s.CloneAndPrepend("An error occurred while persisting the updated tablet metadata");
+    for (auto& assignments : *batch) {
+      AbortPendingAssignments(assignments.get(), s);
+    }
+    return s;
+  }
+
+  for (auto& assignments : *batch) {
     // If any of the ok_status_tables had an error in the previous iterations, we
     // need to clear up the error status to reflect that all the create tablets have now
     // succeded.
-    for (TableInfo* table : ok_status_tables) {
+    for (TableInfo* table : assignments->ok_status_tables) {
       table->SetCreateTableErrorStatus(Status::OK());
     }
+    assignments->unlocker_out.Commit();
+    assignments->unlocker_in.Commit();
 
-    s = sys_catalog_->Upsert(leader_ready_term(), deferred.modified_tablets);
-    if (!s.ok()) {
-      s = s.CloneAndPrepend("An error occurred while persisting the updated tablet metadata");
+    // Send DeleteTablet requests to tablet servers serving deleted tablets.
+    // This is asynchronous / non-blocking.
+    for (auto* tablet : assignments->deferred.modified_tablets) {
+      if (tablet->metadata().dirty().is_deleted()) {
+        // Actual delete, because we delete tablet replica.
+        DeleteTabletReplicas(tablet, tablet->metadata().dirty().pb.state_msg(), HideOnly::kFalse,
+                             KeepData::kFalse);
+      }
+    }
+    // Send the CreateTablet() requests to the servers. This is asynchronous / non-blocking.
+    auto send_status = SendCreateTabletRequests(assignments->deferred.needs_create_rpc);
+    if (!send_status.ok()) {
+      LOG(WARNING) << "Failed to send create tablet requests for table " << assignments->table_id
+                   << ": " << send_status;
+      s = send_status;
     }
   }
+  return s;
+}
 
-  if (!s.ok()) {
-    LOG(WARNING) << "Aborting the current task due to error: " << s.ToString();
-    // If there was an error, abort any mutations started by the current task.
-    // NOTE: Lock order should be lock_ -> table -> tablet.
-    // We currently have a bunch of tablets locked and need to unlock first to ensure this holds.
+void CatalogManager::AbortPendingAssignments(
+    PendingTableAssignments* assignments, const Status& status) {
+  LOG(WARNING) << "Aborting the current task due to error: " << status.ToString();
+  // If there was an error, abort any mutations started by the current task.
+  // NOTE: Lock order should be lock_ -> table -> tablet.
+  // We currently have a bunch of tablets locked and need to unlock first to ensure this holds.
+  auto& new_tablets = assignments->new_tablets;
 
-    std::sort(new_tablets.begin(), new_tablets.end(), [](const auto& lhs, const auto& rhs) {
-      return lhs->table().get() < rhs->table().get();
-    });
-    {
-      std::string current_table_name;
-      TableInfoPtr current_table;
-      for (auto& tablet_to_remove : new_tablets) {
-        if (tablet_to_remove->table()->RemoveTablet(tablet_to_remove->tablet_id())) {
-          if (VLOG_IS_ON(1)) {
-            if (current_table != tablet_to_remove->table()) {
-              current_table = tablet_to_remove->table();
-              current_table_name = current_table->name();
-            }
-            LOG(INFO) << "Removed tablet " << tablet_to_remove->tablet_id() << " from table "
-                      << current_table_name;
+  std::sort(new_tablets.begin(), new_tablets.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs->table().get() < rhs->table().get();
+  });
+  {
+    std::string current_table_name;
+    TableInfoPtr current_table;
+    for (auto& tablet_to_remove : new_tablets) {
+      if (tablet_to_remove->table()->RemoveTablet(tablet_to_remove->tablet_id())) {
+        if (VLOG_IS_ON(1)) {
+          if (current_table != tablet_to_remove->table()) {
+            current_table = tablet_to_remove->table();
+            current_table_name = current_table->name();
           }
+          LOG(INFO) << "Removed tablet " << tablet_to_remove->tablet_id() << " from table "
+                    << current_table_name;
         }
       }
     }
-
-    unlocker_out.Abort();  // tablet.unlock
-    unlocker_in.Abort();
-
-    {
-      LockGuard lock(mutex_); // lock_.lock
-      auto tablet_map_checkout = tablet_map_.CheckOut();
-      for (auto& tablet_to_remove : new_tablets) {
-        // Potential race condition above, but it's okay if a background thread deleted this.
-        tablet_map_checkout->erase(tablet_to_remove->tablet_id());
-      }
-    }
-    return s;
   }
 
-  // Send DeleteTablet requests to tablet servers serving deleted tablets.
-  // This is asynchronous / non-blocking.
-  for (auto* tablet : deferred.modified_tablets) {
-    if (tablet->metadata().dirty().is_deleted()) {
-      // Actual delete, because we delete tablet replica.
-      DeleteTabletReplicas(tablet, tablet->metadata().dirty().pb.state_msg(), HideOnly::kFalse,
-                           KeepData::kFalse);
+  assignments->unlocker_out.Abort();  // tablet.unlock
+  assignments->unlocker_in.Abort();
+
+  {
+    LockGuard lock(mutex_); // lock_.lock
+    auto tablet_map_checkout = tablet_map_.CheckOut();
+    for (auto& tablet_to_remove : new_tablets) {
+      // Potential race condition above, but it's okay if a background thread deleted this.
+      tablet_map_checkout->erase(tablet_to_remove->tablet_id());
     }
   }
-  // Send the CreateTablet() requests to the servers. This is asynchronous / non-blocking.
-  return SendCreateTabletRequests(deferred.needs_create_rpc);
 }
 
 Status CatalogManager::SelectProtegeForTablet(
@@ -10897,9 +11070,10 @@ Result<shared_ptr<tablet::AbstractTablet>> CatalogManager::GetSystemTablet(const
 
 Status CatalogManager::GetTabletLocations(
     const TabletId& tablet_id, TabletLocationsPB* locs_pb, IncludeInactive include_inactive) {
-  scoped_refptr<TabletInfo> tablet_info;
-  {
+  scoped_refptr<TabletInfo> tablet_info = FindTabletInSnapshot(tablet_id);
+  if (!tablet_info) {
     SharedLock lock(mutex_);
+    UpdateLookupSnapshots();
     if (!FindCopy(*tablet_map_, tablet_id, &tablet_info)) {
       return STATUS_SUBSTITUTE(NotFound, "Unknown tablet $0", tablet_id);
     }
@@ -11885,7 +12059,11 @@ void CatalogManager::ProcessTabletStorageMetadata(
         storage_metadata.sst_file_size(),
         storage_metadata.wal_file_size(),
         storage_metadata.uncompressed_sst_file_size(),
-        storage_metadata.may_have_orphaned_post_split_data()};
+        storage_metadata.may_have_orphaned_post_split_data(),
+        storage_metadata.read_ops_per_sec(),
+        storage_metadata.write_ops_per_sec(),
+        storage_metadata.hot_key_fraction(),
+        storage_metadata.estimated_num_rows()};
   tablet->UpdateReplicaDriveInfo(ts_uuid, drive_info);
 }
 
@@ -128,6 +128,7 @@ enum RaftGroupStatePB;
 namespace master {
 
 struct DeferredAssignmentActions;
+struct PendingTableAssignments;
 class XClusterSafeTimeService;
 
 using PlacementId = std::string;
@@ -838,6 +839,15 @@ class CatalogManager : public tserver::TabletPeerLookupIf,
   Result<scoped_refptr<TableInfo>> FindTableByIdUnlocked(
       const TableId& table_id) const REQUIRES_SHARED(mutex_);
 
+  // Lookup table or tablet in the lock free snapshot of table_ids_map_ or tablet_map_.
+  // Returns nullptr when snapshot is stale or does not contain the object, so the caller should
+  // fallback to the lookup under mutex_.
+  scoped_refptr<TableInfo> FindTableInSnapshot(const TableId& table_id) const;
+  scoped_refptr<TabletInfo> FindTabletInSnapshot(const TabletId& tablet_id) const;
+
+  // Rebuilds stale lookup snapshots.
+  void UpdateLookupSnapshots() const REQUIRES_SHARED(mutex_);
+
   Result<bool> TableExists(
       const std::string& namespace_name, const std::string& table_name) const EXCLUDES(mutex_);
 
@@ -1227,8 +1237,24 @@ class CatalogManager : public tserver::TabletPeerLookupIf,
 
   // Task that takes care of the tablet assignments/creations.
   // Loops through the "not created" tablets and sends a CreateTablet() request.
-  Status ProcessPendingAssignmentsPerTable(
-      const TableId& table_id, const TabletInfos& tablets, CMGlobalLoadState* global_load_state);
+  // Updated tablets of up to catalog_manager_assignments_batch_size_tables tables are persisted
+  // with a single sys catalog write.
+  // Returns true if assignments of at least one table succeeded.
+  bool ProcessPendingAssignments(
+      const TableToTabletInfos& tables, CMGlobalLoadState* global_load_state);
+
+  // Locks tablets of the table and prepares their assignments. On failure assignments are aborted.
+  Status PreparePendingAssignments(
+      const TableId& table_id, const TabletInfos& tablets, CMGlobalLoadState* global_load_state,
+      PendingTableAssignments* assignments);
+
+  // Persists prepared assignments of the batch, then unlocks their tablets and sends the
+  // CreateTablet() and DeleteTablet() requests.
+  Status PersistPendingAssignments(
+      std::vector<std::unique_ptr<PendingTableAssignments>>* batch);
+
+  // Aborts mutations of prepared assignments and removes tablets created for them.
+  void AbortPendingAssignments(PendingTableAssignments* assignments, const Status& status);
 
   // Select a tablet server from 'ts_descs' on which to place a new replica.
   // Any tablet servers in 'excluded' are not considered.
@@ -1248,7 +1274,7 @@ class CatalogManager : public tserver::TabletPeerLookupIf,
   // object. If 'ts_descs' does not specify enough online tablet
   // servers to select the N replicas, return Status::InvalidArgument.
   //
-  // This method is called by "ProcessPendingAssignmentsPerTable()".
+  // This method is called by "PreparePendingAssignments()".
   Status SelectReplicasForTablet(
       const TSDescriptorVector& ts_descs, TabletInfo* tablet,
       CMPerTableLoadState* per_table_state, CMGlobalLoadState* global_state);
@@ -1287,7 +1313,7 @@ class CatalogManager : public tserver::TabletPeerLookupIf,
   // after the timeout, we regenerate a new one and proceed with a new
   // assignment/creation.
   //
-  // This method is part of the "ProcessPendingAssignmentsPerTable()"
+  // This method is part of the "PersistPendingAssignments()"
   //
   // This must be called after persisting the tablet state as
   // CREATING to ensure coherent state after Master failover.
@@ -1623,6 +1649,11 @@ class CatalogManager : public tserver::TabletPeerLookupIf,
   // Tablet maps: tablet-id -> TabletInfo
   VersionTracker<TabletInfoMap> tablet_map_ GUARDED_BY(mutex_);
 
+  // Immutable copies of table_ids_map_ and tablet_map_, used by read only lookups, so they don't
+  // contend on mutex_ with writers.
+  mutable VersionTrackerSnapshot<TableInfoMap> table_ids_map_snapshot_;
+  mutable VersionTrackerSnapshot<TabletInfoMap> tablet_map_snapshot_;
+
   // Tablets that was hidden instead of deleting, used to cleanup such tablets when time comes.
   std::vector<TabletInfoPtr> hidden_tablets_ GUARDED_BY(mutex_);
 
@@ -1933,6 +1964,7 @@ class CatalogManager : public tserver::TabletPeerLookupIf,
 
   struct ReportedTablet {
     TabletId tablet_id;
+    TableId table_id;
     TabletInfoPtr info;
     const ReportedTabletPB* report;
     std::map<TableId, scoped_refptr<TableInfo>> tables;
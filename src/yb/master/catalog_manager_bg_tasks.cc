@@ -187,17 +187,9 @@ void CatalogManagerBgTasks::Run() {
         catalog_manager_->InitializeGlobalLoadState(ts_descs, &global_load_state);
         // Transition tablet assignment state from preparing to creating, send
         // and schedule creation / deletion RPC messages, etc.
-        // This is done table by table.
-        for (const auto& entries : to_process) {
-          LOG(INFO) << "Processing pending assignments for table: " << entries.first;
-          Status s = catalog_manager_->ProcessPendingAssignmentsPerTable(
-              entries.first, entries.second, &global_load_state);
-          WARN_NOT_OK(s, "Assignment failed");
-          // Set processed_tablets as true if the call succeeds for at least one table.
-          processed_tablets = processed_tablets || s.ok();
-          // TODO Add tests for this in the revision that makes
-          // create/alter fault tolerant.
-        }
+        // This is done table by table, but updates of multiple tables are persisted together.
+        processed_tablets = catalog_manager_->ProcessPendingAssignments(
+            to_process, &global_load_state);
       }
 
       // Trigger pending backfills.
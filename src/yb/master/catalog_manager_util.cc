@@ -213,7 +213,8 @@ Result<std::string> CatalogManagerUtil::GetPlacementUuidFromRaftPeer(
     const ReplicationInfoPB& replication_info, const consensus::RaftPeerPB& peer) {
   switch (peer.member_type()) {
     case consensus::PeerMemberType::PRE_VOTER:
-    case consensus::PeerMemberType::VOTER: {
+    case consensus::PeerMemberType::VOTER:
+    case consensus::PeerMemberType::WITNESS: {
       // This peer is a live replica.
       return replication_info.live_replicas().placement_uuid();
     }
@@ -120,6 +120,15 @@ DEFINE_RUNTIME_bool(load_balancer_drive_aware, true,
 DEFINE_RUNTIME_bool(load_balancer_ignore_cloud_info_similarity, false,
     "If true, ignore the similarity between cloud infos when deciding which tablet to move");
 
+DEFINE_RUNTIME_double(load_balancer_disk_cost_weight, 0,
+    "Weight of the SST files size of the tablet server in its cost. When tablet servers have "
+    "the same number of tablets of the table, the tablet is moved to the server with lower cost. "
+    "0 means that SST files size is not taken into account.");
+
+DEFINE_RUNTIME_double(load_balancer_ops_cost_weight, 0,
+    "Weight of the read and write operations rate of the tablet server in its cost. See "
+    "load_balancer_disk_cost_weight. 0 means that operations rate is not taken into account.");
+
 METRIC_DEFINE_gauge_int64(cluster,
                           is_load_balancing_enabled,
                           "Is Load Balancing Enabled",
@@ -682,6 +691,7 @@ void ClusterLoadBalancer::ResetGlobalState(bool initialize_ts_descs) {
   if (initialize_ts_descs) {
     // Only call GetAllDescriptors once for a LB run, and then cache it in global_state_.
     GetAllDescriptors(&global_state_->ts_descs_);
+    global_state_->ComputeTabletServerCosts();
   }
   skipped_tables_per_run_.clear();
 }
@@ -33,6 +33,10 @@ DECLARE_int32(replication_factor);
 
 DECLARE_bool(allow_leader_balancing_dead_node);
 
+DECLARE_double(load_balancer_disk_cost_weight);
+
+DECLARE_double(load_balancer_ops_cost_weight);
+
 namespace yb {
 namespace master {
 
@@ -65,6 +69,38 @@ int GlobalLoadState::GetGlobalLeaderLoad(const TabletServerId& ts_uuid) const {
   return ts_meta.leaders_count;
 }
 
+void GlobalLoadState::ComputeTabletServerCosts() {
+  ts_costs_.clear();
+  const auto disk_weight = GetAtomicFlag(&FLAGS_load_balancer_disk_cost_weight);
+  const auto ops_weight = GetAtomicFlag(&FLAGS_load_balancer_ops_cost_weight);
+  if (disk_weight <= 0 && ops_weight <= 0) {
+    return;
+  }
+
+  // Metrics are normalized by their max value across tablet servers, so weights are comparable.
+  double max_disk = 0;
+  double max_ops = 0;
+  for (const auto& ts_desc : ts_descs_) {
+    max_disk = std::max<double>(max_disk, ts_desc->total_sst_file_size());
+    max_ops = std::max(max_ops, ts_desc->read_ops_per_sec() + ts_desc->write_ops_per_sec());
+  }
+  for (const auto& ts_desc : ts_descs_) {
+    double cost = 0;
+    if (disk_weight > 0 && max_disk > 0) {
+      cost += disk_weight * ts_desc->total_sst_file_size() / max_disk;
+    }
+    if (ops_weight > 0 && max_ops > 0) {
+      cost += ops_weight * (ts_desc->read_ops_per_sec() + ts_desc->write_ops_per_sec()) / max_ops;
+    }
+    ts_costs_[ts_desc->permanent_uuid()] = cost;
+  }
+}
+
+double GlobalLoadState::GetTabletServerCost(const TabletServerId& ts_uuid) const {
+  auto it = ts_costs_.find(ts_uuid);
+  return it != ts_costs_.end() ? it->second : 0;
+}
+
 PerTableLoadState::PerTableLoadState(GlobalLoadState* global_state)
     : leader_balance_threshold_(FLAGS_leader_balance_threshold),
       current_time_(MonoTime::Now()),
@@ -103,6 +139,12 @@ bool PerTableLoadState::CompareByUuid(const TabletServerId& a, const TabletServe
   auto load_a = GetLoad(a);
   auto load_b = GetLoad(b);
   if (load_a == load_b) {
+    // Prefer servers with lower disk and operations cost, when such costs are enabled.
+    auto cost_a = global_state_->GetTabletServerCost(a);
+    auto cost_b = global_state_->GetTabletServerCost(b);
+    if (cost_a != cost_b) {
+      return cost_a < cost_b;
+    }
     // Use global load as a heuristic to help break ties.
     load_a = global_state_->GetGlobalLoad(a);
     load_b = global_state_->GetGlobalLoad(b);
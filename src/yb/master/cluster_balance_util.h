@@ -222,6 +222,14 @@ class GlobalLoadState {
   // Get global leader load for a certain TS.
   int GetGlobalLeaderLoad(const TabletServerId& ts_uuid) const;
 
+  // Computes cost of each tablet server in ts_descs_ from its heartbeat metrics: SST files size
+  // and read/write operations rate. Each metric is normalized by its max value across tablet
+  // servers, and weighted using load_balancer_disk_cost_weight/load_balancer_ops_cost_weight.
+  void ComputeTabletServerCosts();
+
+  // Get the cost of a certain TS computed by ComputeTabletServerCosts, 0 when costs are disabled.
+  double GetTabletServerCost(const TabletServerId& ts_uuid) const;
+
   // Used to determine how many tablets are being remote bootstrapped across the cluster.
   int total_starting_tablets_ = 0;
 
@@ -240,6 +248,9 @@ class GlobalLoadState {
   // Map from tablet server ids to the global metadata we store for each.
   std::unordered_map<TabletServerId, CBTabletServerLoadCounts> per_ts_global_meta_;
 
+  // Map from tablet server ids to their cost, empty when costs are disabled.
+  std::unordered_map<TabletServerId, double> ts_costs_;
+
   friend class PerTableLoadState;
 };
 
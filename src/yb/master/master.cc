@@ -49,6 +49,7 @@
 
 #include "yb/gutil/bind.h"
 
+#include "yb/master/async_rpc_tasks.h"
 #include "yb/master/auto_flags_orchestrator.h"
 #include "yb/master/master_fwd.h"
 #include "yb/master/catalog_manager.h"
@@ -155,6 +156,7 @@ Master::Master(const MasterOptions& opts)
       catalog_manager_(new enterprise::CatalogManager(this)),
       path_handlers_(new MasterPathHandlers(this)),
       flush_manager_(new FlushManager(this, catalog_manager())),
+      delete_replica_batcher_(std::make_shared<DeleteReplicaBatcher>(this)),
       init_future_(init_status_.get_future()),
       opts_(opts),
       maintenance_manager_(new MaintenanceManager(MaintenanceManager::DEFAULT_OPTIONS)),
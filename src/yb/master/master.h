@@ -101,6 +101,8 @@ class Master : public tserver::DbServerBase {
 
   FlushManager* flush_manager() const { return flush_manager_.get(); }
 
+  DeleteReplicaBatcher& delete_replica_batcher() const { return *delete_replica_batcher_; }
+
   AutoFlagsManager* auto_flags_manager() { return auto_flags_manager_.get(); }
 
   PermissionsManager& permissions_manager();
@@ -221,6 +223,7 @@ class Master : public tserver::DbServerBase {
   std::unique_ptr<enterprise::CatalogManager> catalog_manager_;
   std::unique_ptr<MasterPathHandlers> path_handlers_;
   std::unique_ptr<FlushManager> flush_manager_;
+  std::shared_ptr<DeleteReplicaBatcher> delete_replica_batcher_;
 
   // For initializing the catalog manager.
   std::unique_ptr<ThreadPool> init_pool_;
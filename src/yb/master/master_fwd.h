@@ -55,6 +55,7 @@ class CDCRpcTasks;
 class CDCSplitDriverIf;
 class ClusterConfigInfo;
 class ClusterLoadBalancer;
+class DeleteReplicaBatcher;
 class FlushManager;
 class Master;
 class MasterBackupProxy;
@@ -32,6 +32,8 @@ class MasterTabletServer : public tserver::TabletServerIf,
   MasterTabletServer(Master* master, scoped_refptr<MetricEntity> metric_entity);
   tserver::TSTabletManager* tablet_manager() override;
   tserver::TabletPeerLookupIf* tablet_peer_lookup() override;
+  tserver::TableQuotas* table_quotas() override { return nullptr; }
+  tserver::RpcTraceCapture* rpc_trace_capture() override { return nullptr; }
 
   server::Clock* Clock() override;
   const scoped_refptr<MetricEntity>& MetricEnt() const override;
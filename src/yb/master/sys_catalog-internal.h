@@ -13,6 +13,11 @@
 
 #pragma once
 
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "yb/common/ql_expr.h"
 
 #include "yb/docdb/doc_read_context.h"
@@ -25,8 +30,18 @@
 #include "yb/util/pb_util.h"
 
 namespace yb {
+
+class ThreadPool;
+
 namespace master {
 
+using SysCatalogEntries = std::vector<std::pair<std::string, std::string>>;
+
+// Invokes f for each index in [0, count), splitting indexes into chunks that are processed by
+// pool threads and the calling thread. Returns the first error returned by f.
+Status ParallelForEachIndex(
+    size_t count, ThreadPool* pool, const std::function<Status(size_t)>& f);
+
 class VisitorBase {
  public:
   VisitorBase() {}
@@ -36,6 +51,9 @@ class VisitorBase {
 
   virtual Status Visit(Slice id, Slice data) = 0;
 
+  // Parses entries in parallel using pool, then visits them sequentially in the original order.
+  virtual Status VisitBatch(const SysCatalogEntries& entries, ThreadPool* pool) = 0;
+
  protected:
 };
 
@@ -54,6 +72,22 @@ class Visitor : public VisitorBase {
     return Visit(id.ToBuffer(), metadata);
   }
 
+  Status VisitBatch(const SysCatalogEntries& entries, ThreadPool* pool) override {
+    std::vector<typename PersistentDataEntryClass::data_type> metadata(entries.size());
+    RETURN_NOT_OK(ParallelForEachIndex(
+        entries.size(), pool, [&entries, &metadata](size_t idx) -> Status {
+      Slice data(entries[idx].second);
+      RETURN_NOT_OK_PREPEND(
+          pb_util::ParseFromArray(&metadata[idx], data.data(), data.size()),
+          "Unable to parse metadata field for item id: " + entries[idx].first);
+      return Status::OK();
+    }));
+    for (size_t idx = 0; idx != entries.size(); ++idx) {
+      RETURN_NOT_OK(Visit(entries[idx].first, metadata[idx]));
+    }
+    return Status::OK();
+  }
+
   int entry_type() const { return PersistentDataEntryClass::type(); }
 
  protected:
@@ -48,6 +48,7 @@
 
 #include "yb/util/net/sockaddr.h"
 #include "yb/util/status.h"
+#include "yb/util/threadpool.h"
 
 using std::make_shared;
 using std::string;
@@ -59,6 +60,7 @@ using yb::rpc::MessengerBuilder;
 using yb::rpc::RpcController;
 
 DECLARE_string(cluster_uuid);
+DECLARE_int32(sys_catalog_parallel_load_batch_size);
 
 namespace yb {
 namespace master {
@@ -194,6 +196,39 @@ TEST_F(SysCatalogTest, TestSysCatalogTablesOperations) {
   ASSERT_EQ(kNumSystemTables, loader->tables.size());
 }
 
+// Test that visit with parallel parsing of entries loads the same tables as the sequential one.
+TEST_F(SysCatalogTest, TestParallelVisit) {
+  constexpr int kNumTables = 50;
+  SysCatalogTable* sys_catalog = master_->catalog_manager()->sys_catalog();
+
+  std::vector<scoped_refptr<TableInfo>> tables;
+  for (int i = 0; i != kNumTables; ++i) {
+    auto table = master_->catalog_manager()->NewTableInfo(Format("table_$0", i));
+    auto l = table->LockForWrite();
+    l.mutable_data()->pb.set_name(Format("testtb_$0", i));
+    l.mutable_data()->pb.set_version(i);
+    l.mutable_data()->pb.set_state(SysTablesEntryPB::RUNNING);
+    SchemaToPB(Schema(), l.mutable_data()->pb.mutable_schema());
+    ASSERT_OK(sys_catalog->Upsert(kLeaderTerm, table));
+    l.Commit();
+    tables.push_back(table);
+  }
+
+  std::unique_ptr<ThreadPool> pool;
+  ASSERT_OK(ThreadPoolBuilder("parse").set_max_threads(4).Build(&pool));
+  // Batch size that does not divide the number of entries, to check the last partial batch.
+  FLAGS_sys_catalog_parallel_load_batch_size = 7;
+
+  auto loader = std::make_unique<TestTableLoader>();
+  ASSERT_OK(sys_catalog->Visit(loader.get(), pool.get()));
+  ASSERT_EQ(kNumTables + kNumSystemTables, loader->tables.size());
+  for (const auto& table : tables) {
+    ASSERT_METADATA_EQ(table.get(), loader->tables[table->id()]);
+  }
+
+  pool->Shutdown();
+}
+
 // Verify that data mutations are not available from metadata() until commit.
 TEST_F(SysCatalogTest, TestTableInfoCommit) {
   scoped_refptr<TableInfo> table(master_->catalog_manager()->NewTableInfo("123"));
@@ -34,6 +34,7 @@
 
 #include <cmath>
 #include <memory>
+#include <mutex>
 
 #include <boost/optional.hpp>
 #include <glog/logging.h>
@@ -69,6 +70,7 @@
 #include "yb/gutil/casts.h"
 #include "yb/gutil/strings/escaping.h"
 #include "yb/gutil/strings/split.h"
+#include "yb/gutil/sysinfo.h"
 
 #include "yb/master/catalog_entity_info.h"
 #include "yb/master/catalog_manager_if.h"
@@ -89,6 +91,7 @@
 #include "yb/tserver/ts_tablet_manager.h"
 #include "yb/tserver/tserver.pb.h"
 
+#include "yb/util/countdown_latch.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/flags.h"
 #include "yb/util/format.h"
@@ -141,6 +144,10 @@ DECLARE_int32(master_discovery_timeout_ms);
 DEFINE_int32(sys_catalog_write_timeout_ms, 60000, "Timeout for writes into system catalog");
 DEFINE_uint64(copy_tables_batch_bytes, 500_KB, "Max bytes per batch for copy pg sql tables");
 
+DEFINE_RUNTIME_int32(sys_catalog_parallel_load_batch_size, 10000,
+    "Number of sys catalog entries, that are parsed in parallel while loading catalog into "
+    "memory, after master becomes leader. 0 to parse entries one by one by the loading thread.");
+
 DEFINE_test_flag(int32, sys_catalog_write_rejection_percentage, 0,
   "Reject specified percentage of sys catalog writes.");
 
@@ -814,7 +821,48 @@ void SysCatalogTable::InitLocalRaftPeerPB() {
   TakeRegistration(&reg, &local_peer_pb_);
 }
 
-Status SysCatalogTable::Visit(VisitorBase* visitor) {
+Status ParallelForEachIndex(
+    size_t count, ThreadPool* pool, const std::function<Status(size_t)>& f) {
+  const size_t num_chunks = pool ? std::min<size_t>(count, std::max(base::NumCPUs(), 1)) : 1;
+  if (num_chunks <= 1) {
+    for (size_t idx = 0; idx != count; ++idx) {
+      RETURN_NOT_OK(f(idx));
+    }
+    return Status::OK();
+  }
+
+  std::mutex mutex;
+  Status result;
+  auto process_chunk = [count, num_chunks, &f, &mutex, &result](size_t chunk) {
+    for (size_t idx = chunk * count / num_chunks; idx != (chunk + 1) * count / num_chunks; ++idx) {
+      auto status = f(idx);
+      if (!status.ok()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (result.ok()) {
+          result = std::move(status);
+        }
+        return;
+      }
+    }
+  };
+  CountDownLatch latch(num_chunks - 1);
+  for (size_t chunk = 1; chunk != num_chunks; ++chunk) {
+    auto status = pool->SubmitFunc([&process_chunk, &latch, chunk] {
+      process_chunk(chunk);
+      latch.CountDown();
+    });
+    if (!status.ok()) {
+      // Process the chunk in the calling thread, when pool is not able to accept it.
+      process_chunk(chunk);
+      latch.CountDown();
+    }
+  }
+  process_chunk(0);
+  latch.Wait();
+  return result;
+}
+
+Status SysCatalogTable::Visit(VisitorBase* visitor, ThreadPool* parse_pool) {
   TRACE_EVENT0("master", "Visitor::VisitAll");
 
   auto tablet = tablet_peer()->shared_tablet();
@@ -825,11 +873,27 @@ Status SysCatalogTable::Visit(VisitorBase* visitor) {
   auto start = CoarseMonoClock::Now();
 
   uint64_t count = 0;
-  RETURN_NOT_OK(EnumerateSysCatalog(tablet.get(), doc_read_context_->schema, visitor->entry_type(),
-                                    [visitor, &count](const Slice& id, const Slice& data) {
+  const auto batch_size = parse_pool ?
+      std::max(GetAtomicFlag(&FLAGS_sys_catalog_parallel_load_batch_size), 0) : 0;
+  SysCatalogEntries batch;
+  RETURN_NOT_OK(EnumerateSysCatalog(
+      tablet.get(), doc_read_context_->schema, visitor->entry_type(),
+      [visitor, parse_pool, batch_size, &batch, &count](const Slice& id, const Slice& data) {
     ++count;
-    return visitor->Visit(id, data);
+    if (batch_size == 0) {
+      return visitor->Visit(id, data);
+    }
+    batch.emplace_back(id.ToBuffer(), data.ToBuffer());
+    if (batch.size() < implicit_cast<size_t>(batch_size)) {
+      return Status::OK();
+    }
+    auto status = visitor->VisitBatch(batch, parse_pool);
+    batch.clear();
+    return status;
   }));
+  if (!batch.empty()) {
+    RETURN_NOT_OK(visitor->VisitBatch(batch, parse_pool));
+  }
 
   auto duration = CoarseMonoClock::Now() - start;
   string id = Format("num_entries_with_type_$0_loaded", std::to_string(visitor->entry_type()));
@@ -158,7 +158,9 @@ class SysCatalogTable {
       const yb::consensus::RaftConfigPB& config,
       int64_t current_term);
 
-  Status Visit(VisitorBase* visitor);
+  // Visits all entries of the visitor's type. When parse_pool is specified, entries are parsed in
+  // parallel by its threads, in batches of sys_catalog_parallel_load_batch_size entries.
+  Status Visit(VisitorBase* visitor, ThreadPool* parse_pool = nullptr);
 
   // Read the global ysql catalog version info from the pg_yb_catalog_version catalog table.
   Status ReadYsqlCatalogVersion(TableId ysql_catalog_table_id,
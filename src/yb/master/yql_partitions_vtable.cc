@@ -25,6 +25,8 @@
 
 #include "yb/rpc/messenger.h"
 
+#include "yb/util/flags.h"
+#include "yb/util/monotime.h"
 #include "yb/util/net/dns_resolver.h"
 #include "yb/util/pb_util.h"
 #include "yb/util/result.h"
@@ -39,6 +41,14 @@ DEFINE_bool(generate_partitions_vtable_on_changes, true,
             "Whether we should generate the system.partitions vtable whenever relevant partition "
             "changes occur.");
 
+DEFINE_RUNTIME_int32(partitions_vtable_min_update_interval_ms, 0,
+    "When generate_partitions_vtable_on_changes is set, min interval between rebuilds of the "
+    "system.partitions vtable from its modified rows. Reads within the interval get the previous "
+    "version of the vtable, so the vtable is not rebuilt for every read when tablets change "
+    "frequently, e.g. while leaders move during rolling restart. 0 means the vtable is rebuilt "
+    "on the first read after each change.");
+TAG_FLAG(partitions_vtable_min_update_interval_ms, advanced);
+
 namespace yb {
 namespace master {
 
@@ -89,6 +99,13 @@ Result<std::shared_ptr<QLRowBlock>> YQLPartitionsVTable::RetrieveData(
       // If we have just reset the table, then we need to do regenerate the entire vtable.
       require_full_vtable_reset = cached_tablets_version_ == kInvalidCache ||
                                   cached_tablet_locations_version_ == kInvalidCache;
+      // Otherwise recently rebuilt vtable could be served, while it is not too old.
+      auto min_update_interval =
+          MonoDelta::FromMilliseconds(FLAGS_partitions_vtable_min_update_interval_ms);
+      if (!require_full_vtable_reset && cache_ && min_update_interval > MonoDelta::kZero &&
+          CoarseMonoClock::now() < cache_update_time_ + min_update_interval) {
+        return cache_;
+      }
     }
     if (!require_full_vtable_reset) {
       std::lock_guard<std::shared_timed_mutex> lock(mutex_);
@@ -322,6 +339,7 @@ Result<std::shared_ptr<QLRowBlock>> YQLPartitionsVTable::GetTableFromMap() const
     }
 
     cache_ = vtable;
+    cache_update_time_ = CoarseMonoClock::now();
     update_cache_ = false;
   }
 
@@ -16,6 +16,8 @@
 #include "yb/master/catalog_entity_info.h"
 #include "yb/master/yql_virtual_table.h"
 
+#include "yb/util/monotime.h"
+
 namespace yb {
 namespace master {
 
@@ -85,6 +87,8 @@ class YQLPartitionsVTable : public YQLVirtualTable {
   mutable intptr_t cached_tablet_locations_version_ GUARDED_BY(mutex_) = kInvalidCache;
   // Generate the cache from the map lazily (only when there's a request and update_cache_ is true).
   mutable bool update_cache_ GUARDED_BY(mutex_) = true;
+  // Time when cache_ was last rebuilt from the map.
+  mutable CoarseTimePoint cache_update_time_ GUARDED_BY(mutex_);
 
   // Store the table as a map for more efficient modifications.
   mutable std::map<TableId, std::map<std::string, QLRow>> table_to_partition_start_to_row_map_
@@ -116,6 +116,11 @@ class YQLVirtualTable : public docdb::YQLStorageIf {
     return Status::OK();
   }
 
+  Result<std::vector<std::string>> GetSampleTupleIds(
+      const Schema& schema, size_t max_keys) const override {
+    return std::vector<std::string>();
+  }
+
  protected:
   // Finds the given column name in the schema and updates the specified column in the given row
   // with the provided value.
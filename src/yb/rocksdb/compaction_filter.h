@@ -182,5 +182,20 @@ class CompactionFileFilterFactory {
   virtual const char* Name() const = 0;
 };
 
+// Splits level 0 files into time windows. Files from different windows are not compacted together,
+// so data written during one window is kept in its own files, and could be dropped whole when it
+// expires.
+class CompactionTimeWindowPolicy {
+ public:
+  virtual ~CompactionTimeWindowPolicy() = default;
+
+  // Returns window of each file from `files`. Windows of newer data should be greater.
+  // Returns empty vector when files should not be split into windows at the moment.
+  virtual std::vector<uint64_t> GetWindows(const std::vector<FileMetaData*>& files) = 0;
+
+  // Returns a name that identifies this policy.
+  virtual const char* Name() const = 0;
+};
+
 }  // namespace rocksdb
 
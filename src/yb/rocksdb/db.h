@@ -916,6 +916,12 @@ class DB {
   // Returns approximate middle key (see Version::GetMiddleKey).
   virtual yb::Result<std::string> GetMiddleKey() = 0;
 
+  // Returns up to max_keys internal keys that divide the data into parts of roughly the same size
+  // (see Version::GetSampleKeys).
+  virtual yb::Result<std::vector<std::string>> GetSampleKeys(size_t max_keys) {
+    return STATUS(NotSupported, "GetSampleKeys() not supported");
+  }
+
   // Returns a table reader for the largest SST file.
   virtual yb::Result<TableReader*> TEST_GetLargestSstTableReader() {
     return STATUS(NotSupported, "");
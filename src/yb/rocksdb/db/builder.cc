@@ -32,6 +32,7 @@
 #include <utility>
 #include <vector>
 
+#include "yb/rocksdb/db/compaction_context.h"
 #include "yb/rocksdb/db/compaction_iterator.h"
 #include "yb/rocksdb/db/dbformat.h"
 #include "yb/rocksdb/db/filename.h"
@@ -104,6 +105,42 @@ namespace {
     file_writer->reset(new WritableFileWriter(std::move(file), env_options));
     return Status::OK();
   }
+
+// Feed that writes flushed key-value pairs to the table builder, and updates boundaries of the
+// file metadata.
+class TableBuilderFeed : public CompactionFeed {
+ public:
+  TableBuilderFeed(
+      TableBuilder* builder, FileMetaData* meta,
+      BoundaryValuesExtractor* boundary_values_extractor)
+      : builder_(*builder), meta_(*meta), boundary_values_extractor_(boundary_values_extractor) {
+  }
+
+  Status Feed(const Slice& key, const Slice& value) override {
+    if (builder_.NumEntries() == 0) {
+      meta_.UpdateKey(key, UpdateBoundariesType::kSmallest);
+    }
+    builder_.Add(key, value);
+    meta_.UpdateBoundarySeqNo(GetInternalKeySeqno(key));
+    if (boundary_values_extractor_) {
+      user_values_.clear();
+      RETURN_NOT_OK(boundary_values_extractor_->Extract(ExtractUserKey(key), &user_values_));
+      meta_.UpdateBoundaryUserValues(user_values_, UpdateBoundariesType::kAll);
+    }
+    return Status::OK();
+  }
+
+  Status Flush() override {
+    return Status::OK();
+  }
+
+ private:
+  TableBuilder& builder_;
+  FileMetaData& meta_;
+  BoundaryValuesExtractor* const boundary_values_extractor_;
+  boost::container::small_vector<UserBoundaryValueRef, 0x10> user_values_;
+};
+
 } // anonymous namespace
 
 Status BuildTable(const std::string& dbname,
@@ -124,7 +161,9 @@ Status BuildTable(const std::string& dbname,
                   InternalStats* internal_stats,
                   BoundaryValuesExtractor* boundary_values_extractor,
                   const yb::IOPriority io_priority,
-                  TableProperties* table_properties) {
+                  TableProperties* table_properties,
+                  CompactionContextFactory* compaction_context_factory,
+                  UserFrontierPtr* largest_user_frontier) {
   // Reports the IOStats for flush for every following bytes.
   const size_t kReportFlushIOStatsEvery = 1048576;
   Status s;
@@ -162,35 +201,45 @@ Status BuildTable(const std::string& dbname,
                               &merge, kMaxSequenceNumber, &snapshots,
                               earliest_write_conflict_snapshot,
                               true /* internal key corruption is not ok */);
-    c_iter.SeekToFirst();
-    const bool non_empty = c_iter.Valid();
-    if (non_empty) {
-      meta->UpdateKey(c_iter.key(), UpdateBoundariesType::kSmallest);
-    }
-
-    boost::container::small_vector<UserBoundaryValueRef, 0x10> user_values;
-    for (; c_iter.Valid(); c_iter.Next()) {
-      const Slice& key = c_iter.key();
-      const Slice& value = c_iter.value();
-      builder->Add(key, value);
-      meta->UpdateBoundarySeqNo(GetInternalKeySeqno(key));
-      if (boundary_values_extractor) {
-        user_values.clear();
-        auto status = boundary_values_extractor->Extract(ExtractUserKey(key), &user_values);
-        if (!status.ok()) {
-          builder->Abandon();
-          return status;
-        }
-        meta->UpdateBoundaryUserValues(user_values, UpdateBoundariesType::kAll);
+    TableBuilderFeed builder_feed(builder.get(), meta, boundary_values_extractor);
+    CompactionFeed* feed = &builder_feed;
+    // Compaction context drops obsolete data, that would be removed by the compaction anyway.
+    // Flush has no input files, so all existing files are considered as other data.
+    CompactionContextPtr context;
+    if (compaction_context_factory) {
+      const std::vector<FileMetaData*> no_level0_inputs;
+      context = (*compaction_context_factory)(&builder_feed, CompactionContextOptions {
+        .level0_inputs = no_level0_inputs,
+        .boundary_extractor = boundary_values_extractor,
+      });
+      if (context) {
+        feed = context->Feed();
       }
     }
 
-    if (non_empty) {
+    for (c_iter.SeekToFirst(); s.ok() && c_iter.Valid(); c_iter.Next()) {
+      s = feed->Feed(c_iter.key(), c_iter.value());
+    }
+    if (s.ok()) {
+      s = feed->Flush();
+    }
+    if (s.ok() && context) {
+      s = context->UpdateMeta(meta);
+    }
+    if (!s.ok()) {
+      builder->Abandon();
+      return s;
+    }
+
+    const bool empty = builder->NumEntries() == 0;
+    if (!empty) {
       meta->UpdateKey(builder->LastKey(), UpdateBoundariesType::kLargest);
+      if (context && largest_user_frontier) {
+        *largest_user_frontier = context->GetLargestUserFrontier();
+      }
     }
 
     // Finish and check for builder errors
-    bool empty = builder->NumEntries() == 0;
     s = c_iter.status();
     if (!s.ok() || empty) {
       builder->Abandon();
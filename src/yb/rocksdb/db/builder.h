@@ -30,6 +30,7 @@
 #include "yb/rocksdb/db/table_properties_collector.h"
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/immutable_options.h"
+#include "yb/rocksdb/metadata.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/status.h"
 #include "yb/rocksdb/table_properties.h"
@@ -95,7 +96,11 @@ extern Status BuildTable(
     InternalStats* internal_stats,
     BoundaryValuesExtractor* boundary_values_extractor,
     const yb::IOPriority io_priority = yb::IOPriority::kHigh,
-    TableProperties* table_properties = nullptr);
+    TableProperties* table_properties = nullptr,
+    // When specified, flushed data is passed through the compaction context, and the largest
+    // user frontier of the context is stored to largest_user_frontier.
+    CompactionContextFactory* compaction_context_factory = nullptr,
+    UserFrontierPtr* largest_user_frontier = nullptr);
 
 }  // namespace rocksdb
 
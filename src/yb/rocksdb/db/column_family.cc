@@ -392,6 +392,10 @@ ColumnFamilyData::ColumnFamilyData(
       compaction_picker_.reset(
           new LevelCompactionPicker(ioptions_, internal_comparator_.get()));
 #ifndef ROCKSDB_LITE
+    } else if (ioptions_.compaction_style == kCompactionStyleUniversal &&
+               ioptions_.compaction_time_window_policy) {
+      compaction_picker_.reset(
+          new TimeWindowCompactionPicker(ioptions_, internal_comparator_.get()));
     } else if (ioptions_.compaction_style == kCompactionStyleUniversal) {
       compaction_picker_.reset(
           new UniversalCompactionPicker(ioptions_, internal_comparator_.get()));
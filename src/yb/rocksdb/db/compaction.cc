@@ -591,7 +591,9 @@ bool Compaction::ShouldFormSubcompactions() const {
   if (cfd_->ioptions()->compaction_style == kCompactionStyleLevel) {
     return start_level_ == 0 && !IsOutputLevelEmpty();
   } else if (IsCompactionStyleUniversal()) {
-    return number_levels_ > 1 && output_level_ > 0;
+    // Outputs of single level universal compaction split into subcompactions are installed as one
+    // sorted run, see CompactionJob::InstallCompactionResults.
+    return number_levels_ == 1 || output_level_ > 0;
   } else {
     return false;
   }
@@ -33,8 +33,10 @@
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <limits>
 #include <list>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <thread>
@@ -52,6 +54,7 @@
 #include "yb/rocksdb/db/memtable.h"
 #include "yb/rocksdb/db/memtable_list.h"
 #include "yb/rocksdb/db/merge_helper.h"
+#include "yb/rocksdb/db/table_cache.h"
 #include "yb/rocksdb/db/version_set.h"
 #include "yb/rocksdb/port/likely.h"
 #include "yb/rocksdb/port/port.h"
@@ -62,6 +65,7 @@
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table/internal_iterator.h"
 #include "yb/rocksdb/table/table_builder.h"
+#include "yb/rocksdb/table/table_reader.h"
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/log_buffer.h"
@@ -111,6 +115,7 @@ struct CompactionJob::SubcompactionState : public CompactionFeed {
 
   CompactionFeed* feed = nullptr; // Owned externally.
   CompactionContextPtr context;
+  UserFrontierPtr largest_user_frontier;
 
   Output* current_output() {
     if (outputs.empty()) {
@@ -299,7 +304,7 @@ void CompactionJob::Prepare() {
   // Is this compaction producing files at the bottommost level?
   bottommost_level_ = c->bottommost_level();
 
-  if (c->ShouldFormSubcompactions()) {
+  if (ShouldFormSubcompactions()) {
     const uint64_t start_micros = env_->NowMicros();
     GenSubcompactionBoundaries();
     assert(sizes_.size() == boundaries_.size() + 1);
@@ -316,6 +321,21 @@ void CompactionJob::Prepare() {
   }
 }
 
+bool CompactionJob::ShouldFormSubcompactions() const {
+  auto* c = compact_->compaction;
+  if (!c->ShouldFormSubcompactions()) {
+    return false;
+  }
+  if (c->output_level() > 0) {
+    return true;
+  }
+  // Level 0 outputs are not range partitioned by levels, so they are produced only by large
+  // compactions, and entries of the same row should not be split between subcompactions, because
+  // compaction feed processes all entries of the row together.
+  return db_options_.compaction_row_prefix_extractor &&
+         c->CalculateTotalInputSize() >= db_options_.compaction_size_threshold_bytes;
+}
+
 struct RangeWithSize {
   Range range;
   uint64_t size;
@@ -374,6 +394,52 @@ void CompactionJob::GenSubcompactionBoundaries() {
     }
   }
 
+  const auto& row_prefix_extractor = db_options_.compaction_row_prefix_extractor;
+  if (out_lvl == 0 && row_prefix_extractor) {
+    // Level 0 files could cover the whole key range, so their boundaries are not enough to split
+    // the compaction. Add keys sampled from the index of each file.
+    const auto samples_per_file = db_options_.max_subcompactions;
+    const LevelFilesBrief* flevel = c->input_levels(0);
+    for (size_t i = 0; i < flevel->num_files; i++) {
+      auto samples = [&]() -> Result<std::vector<std::string>> {
+        auto trwh = VERIFY_RESULT(cfd->table_cache()->GetTableReader(
+            env_options_, cfd->internal_comparator(), flevel->files[i].fd, kDefaultQueryId,
+            /* no_io = */ false, /* file_read_hist = */ nullptr, /* skip_filters = */ true));
+        return trwh.table_reader->GetSampleKeys(samples_per_file);
+      }();
+      if (!samples.ok()) {
+        RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+            "[%s] [JOB %d] Failed to sample keys of file %" PRIu64 ": %s",
+            cfd->GetName().c_str(), job_id_, flevel->files[i].fd.GetNumber(),
+            samples.status().ToString().c_str());
+        continue;
+      }
+      for (auto& sample : *samples) {
+        boundary_keys_.push_back(std::move(sample));
+        bounds.emplace_back(boundary_keys_.back());
+      }
+    }
+
+    // Move each boundary to the start of its row, so the whole row belongs to one subcompaction.
+    // Boundaries that are not valid row keys, e.g. shortened index keys, are dropped.
+    std::vector<Slice> row_bounds;
+    row_bounds.reserve(bounds.size());
+    for (const auto& bound : bounds) {
+      auto row_prefix = (*row_prefix_extractor)(ExtractUserKey(bound));
+      if (!row_prefix.ok()) {
+        continue;
+      }
+      boundary_keys_.push_back(
+          InternalKey(*row_prefix, kMaxSequenceNumber, kValueTypeForSeek).Encode().ToBuffer());
+      row_bounds.emplace_back(boundary_keys_.back());
+    }
+    bounds = std::move(row_bounds);
+    if (bounds.empty()) {
+      sizes_.emplace_back(0);
+      return;
+    }
+  }
+
   std::sort(bounds.begin(), bounds.end(),
     [cfd_comparator] (const Slice& a, const Slice& b) -> bool {
       return cfd_comparator->Compare(ExtractUserKey(a), ExtractUserKey(b)) < 0;
@@ -405,9 +471,11 @@ void CompactionJob::GenSubcompactionBoundaries() {
 
   // Group the ranges into subcompactions
   const double min_file_fill_percent = 4.0 / 5;
-  uint64_t max_output_files = static_cast<uint64_t>(std::ceil(
-      sum / min_file_fill_percent /
-      cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl)));
+  const auto max_file_size = cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl);
+  // Size of level 0 files produced by universal compaction is not limited.
+  uint64_t max_output_files = max_file_size == std::numeric_limits<uint64_t>::max()
+      ? std::numeric_limits<uint64_t>::max()
+      : static_cast<uint64_t>(std::ceil(sum / min_file_fill_percent / max_file_size));
   uint64_t subcompactions =
       std::min({static_cast<uint64_t>(ranges.size()),
                 static_cast<uint64_t>(db_options_.max_subcompactions),
@@ -469,6 +537,13 @@ Result<FileNumbersHolder> CompactionJob::Run() {
     thread.join();
   }
 
+  for (const auto& state : compact_->sub_compact_states) {
+    if (state.largest_user_frontier) {
+      UpdateUserFrontier(
+          &largest_user_frontier_, state.largest_user_frontier, UpdateUserValueType::kLargest);
+    }
+  }
+
   if (output_directory_ && !db_options_.disableDataSync) {
     RETURN_NOT_OK(output_directory_->Fsync());
   }
@@ -485,6 +560,24 @@ Result<FileNumbersHolder> CompactionJob::Run() {
     }
   }
 
+  // Both shutdown and column family drop interrupt the compaction with ShutdownInProgress.
+  if (status.IsShutdownInProgress()) {
+    // Output of interrupted compaction is discarded, log how much work is lost.
+    auto* cfd = compact_->compaction->column_family_data();
+    const char* reason = cfd->IsDropped() ? "column family drop" : "shutdown";
+    size_t num_outputs = 0;
+    uint64_t output_bytes = 0;
+    for (const auto& state : compact_->sub_compact_states) {
+      num_outputs += state.outputs.size();
+      output_bytes += state.total_bytes;
+    }
+    RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+        "[%s] [JOB %d] Compaction interrupted by %s after %.3f seconds, discarding %"
+        ROCKSDB_PRIszt " output files of %" PRIu64 " bytes",
+        cfd->GetName().c_str(), job_id_, reason, compaction_stats_.micros / 1000000.0,
+        num_outputs, output_bytes);
+  }
+
   TablePropertiesCollection tp;
   for (const auto& state : compact_->sub_compact_states) {
     for (const auto& output : state.outputs) {
@@ -711,7 +804,7 @@ void CompactionJob::ProcessKeyValueCompaction(
   // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
   // filter.
   if (sub_compact->context) {
-    largest_user_frontier_ = sub_compact->context->GetLargestUserFrontier();
+    sub_compact->largest_user_frontier = sub_compact->context->GetLargestUserFrontier();
   }
 
   sub_compact->num_input_records = c_iter_stats.num_input_records;
@@ -938,9 +1031,32 @@ Status CompactionJob::InstallCompactionResults(
   // Add compaction outputs
   compaction->AddInputDeletions(compaction->edit());
 
+  // Outputs of level 0 compaction split into subcompactions get the same sequence number range,
+  // so they are ordered together and treated as one sorted run (see IsSameSortedRun).
+  std::optional<std::pair<SequenceNumber, SequenceNumber>> sorted_run_seqnos;
+  if (compaction->output_level() == 0 && compact_->sub_compact_states.size() > 1) {
+    for (const auto& sub_compact : compact_->sub_compact_states) {
+      for (const auto& out : sub_compact.outputs) {
+        if (!sorted_run_seqnos) {
+          sorted_run_seqnos.emplace(out.meta.smallest.seqno, out.meta.largest.seqno);
+        } else {
+          sorted_run_seqnos->first = std::min(sorted_run_seqnos->first, out.meta.smallest.seqno);
+          sorted_run_seqnos->second = std::max(sorted_run_seqnos->second, out.meta.largest.seqno);
+        }
+      }
+    }
+  }
+
   for (const auto& sub_compact : compact_->sub_compact_states) {
     for (const auto& out : sub_compact.outputs) {
-      compaction->edit()->AddFile(compaction->output_level(), out.meta);
+      if (!sorted_run_seqnos) {
+        compaction->edit()->AddFile(compaction->output_level(), out.meta);
+        continue;
+      }
+      auto meta = out.meta;
+      meta.smallest.seqno = sorted_run_seqnos->first;
+      meta.largest.seqno = sorted_run_seqnos->second;
+      compaction->edit()->AddFile(compaction->output_level(), meta);
     }
   }
   if (largest_user_frontier_) {
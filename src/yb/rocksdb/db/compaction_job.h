@@ -102,6 +102,7 @@ class CompactionJob {
   struct SubcompactionState;
 
   void AggregateStatistics();
+  bool ShouldFormSubcompactions() const;
   void GenSubcompactionBoundaries();
 
   // update the thread status for starting a compaction.
@@ -176,6 +177,8 @@ class CompactionJob {
   bool measure_io_stats_;
   // Stores the Slices that designate the boundaries for each subcompaction
   std::vector<Slice> boundaries_;
+  // Storage for boundary keys that are not taken from file metadata.
+  std::deque<std::string> boundary_keys_;
   // Stores the approx size of keys covered in the range of each subcompaction
   std::vector<uint64_t> sizes_;
 
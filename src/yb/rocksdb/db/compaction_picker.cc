@@ -29,9 +29,11 @@
 
 #include <inttypes.h>
 
+#include <algorithm>
 #include <limits>
 #include <queue>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 
@@ -160,6 +162,22 @@ CompressionType GetCompressionType(const ImmutableCFOptions& ioptions,
   }
 }
 
+namespace {
+
+// Returns compression type for the output of universal compaction, whose input files have
+// input_size bytes in total.
+CompressionType GetUniversalCompressionType(const ImmutableCFOptions& ioptions,
+                                            int level, int base_level, uint64_t input_size,
+                                            const bool enable_compression = true) {
+  if (enable_compression && ioptions.large_output_compression_min_size > 0 &&
+      input_size >= ioptions.large_output_compression_min_size) {
+    return ioptions.large_output_compression;
+  }
+  return GetCompressionType(ioptions, level, base_level, enable_compression);
+}
+
+} // namespace
+
 CompactionPicker::CompactionPicker(const ImmutableCFOptions& ioptions,
                                    const InternalKeyComparator* icmp)
     : ioptions_(ioptions), icmp_(icmp) {}
@@ -523,12 +541,14 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
 
     std::vector<CompactionInputFiles> inputs(vstorage->num_levels() -
                                              start_level);
+    uint64_t input_size = 0;
     for (int level = start_level; level < vstorage->num_levels(); level++) {
       inputs[level - start_level].level = level;
       auto& files = inputs[level - start_level].files;
 
       for (FileMetaData* f : vstorage->LevelFiles(level)) {
         files.push_back(f);
+        input_size += f->fd.GetTotalFileSize();
       }
       if (FilesInCompaction(files)) {
         *manual_conflict = true;
@@ -539,7 +559,7 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
         vstorage, mutable_cf_options, std::move(inputs), output_level,
         mutable_cf_options.MaxFileSizeForLevel(output_level),
         /* max_grandparent_overlap_bytes = */ LLONG_MAX, output_path_id,
-        GetCompressionType(ioptions_, output_level, 1),
+        GetUniversalCompressionType(ioptions_, output_level, 1, input_size),
         /* grandparents = */ std::vector<FileMetaData*>(), ioptions_.info_log,
         /* is_manual = */ true);
     if (c && start_level == 0) {
@@ -637,11 +657,24 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
 
   std::vector<FileMetaData*> grandparents;
   GetGrandparents(vstorage, inputs, output_level_inputs, &grandparents);
+  CompressionType compression;
+  if (ioptions_.compaction_style == kCompactionStyleUniversal) {
+    uint64_t input_size = 0;
+    for (const auto& level_inputs : compaction_inputs) {
+      for (const auto* f : level_inputs.files) {
+        input_size += f->fd.GetTotalFileSize();
+      }
+    }
+    compression = GetUniversalCompressionType(
+        ioptions_, output_level, vstorage->base_level(), input_size);
+  } else {
+    compression = GetCompressionType(ioptions_, output_level, vstorage->base_level());
+  }
   auto compaction = Compaction::Create(
       vstorage, mutable_cf_options, std::move(compaction_inputs), output_level,
       mutable_cf_options.MaxFileSizeForLevel(output_level),
       mutable_cf_options.MaxGrandParentOverlapBytes(input_level), output_path_id,
-      GetCompressionType(ioptions_, output_level, vstorage->base_level()), std::move(grandparents),
+      compression, std::move(grandparents),
       ioptions_.info_log, /* is manual compaction = */ true);
   if (!compaction) {
     return nullptr;
@@ -1220,10 +1253,18 @@ struct UniversalCompactionPicker::SortedRun {
     return file ? file->delete_after_compaction() : false;
   }
 
+  // Adds files of level 0 sorted run to the compaction inputs.
+  void AddLevel0Files(std::vector<FileMetaData*>* files) const {
+    files->push_back(file);
+    files->insert(files->end(), same_run_files.begin(), same_run_files.end());
+  }
+
   int level;
   // `file` Will be null for level > 0. For level = 0, the sorted run is
   // for this file.
   FileMetaData* file;
+  // Other level 0 files of the same sorted run, see IsSameSortedRun.
+  std::vector<FileMetaData*> same_run_files;
   // For level > 0, `size` and `compensated_file_size` are sum of sizes all
   // files in the level. `being_compacted` should be the same for all files
   // in a non-zero level. Use the value here.
@@ -1257,9 +1298,9 @@ void UniversalCompactionPicker::SortedRun::DumpSizeInfo(
     snprintf(out_buf, out_buf_size,
              "file %" PRIu64 "[%" ROCKSDB_PRIszt
              "] "
-             "with size %" PRIu64 " (compensated size %" PRIu64 ")",
-             file->fd.GetNumber(), sorted_run_count, file->fd.GetTotalFileSize(),
-             file->compensated_file_size);
+             "with size %" PRIu64 " (compensated size %" PRIu64 ", files %" ROCKSDB_PRIszt ")",
+             file->fd.GetNumber(), sorted_run_count, size, compensated_file_size,
+             same_run_files.size() + 1);
   } else {
     snprintf(out_buf, out_buf_size,
              "level %d[%" ROCKSDB_PRIszt
@@ -1280,7 +1321,20 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
     // Any files that can be directly removed during compaction can be included, even if they
     // exceed the "max file size for compaction."
     if (f->fd.GetTotalFileSize() <= max_file_size || f->delete_after_compaction()) {
-      ret.back().emplace_back(0, f, f->fd.GetTotalFileSize(), f->compensated_file_size,
+      auto& runs = ret.back();
+      // Files that could be directly removed are kept in separate runs, so they could be picked
+      // for deletion one by one.
+      if (!runs.empty() && runs.back().level == 0 && !f->delete_after_compaction() &&
+          !runs.back().delete_after_compaction() &&
+          IsSameSortedRun(*runs.back().file, *f)) {
+        auto& run = runs.back();
+        run.same_run_files.push_back(f);
+        run.size += f->fd.GetTotalFileSize();
+        run.compensated_file_size += f->compensated_file_size;
+        run.being_compacted = run.being_compacted || f->being_compacted;
+        continue;
+      }
+      runs.emplace_back(0, f, f->fd.GetTotalFileSize(), f->compensated_file_size,
           f->being_compacted);
     // If last sequence is empty it means that there are multiple too-large-to-compact files in
     // a row. So we just don't start new sequence in this case.
@@ -1525,6 +1579,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::DoPickCompaction(
 // validate that all the chosen files of L0 are non overlapping in time
 #ifndef NDEBUG
   SequenceNumber prev_smallest_seqno = 0U;
+  FileMetaData* prev_file = nullptr;
   bool is_first = true;
 
   size_t level_index = 0U;
@@ -1533,10 +1588,11 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::DoPickCompaction(
       DCHECK_LE(f->smallest.seqno, f->largest.seqno);
       if (is_first) {
         is_first = false;
-      } else {
+      } else if (!IsSameSortedRun(*prev_file, *f)) {
         DCHECK_GT(prev_smallest_seqno, f->largest.seqno);
       }
       prev_smallest_seqno = f->smallest.seqno;
+      prev_file = f;
     }
     level_index = 1U;
   }
@@ -1766,8 +1822,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   for (size_t i = start_index; i < first_index_after; i++) {
     auto& picking_sr = sorted_runs[i];
     if (picking_sr.level == 0) {
-      FileMetaData* picking_file = picking_sr.file;
-      inputs[0].files.push_back(picking_file);
+      picking_sr.AddLevel0Files(&inputs[0].files);
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -1789,7 +1844,8 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   return Compaction::Create(
       vstorage, mutable_cf_options, std::move(inputs), output_level,
       mutable_cf_options.MaxFileSizeForLevel(output_level), LLONG_MAX, path_id,
-      GetCompressionType(ioptions_, start_level, 1, enable_compression),
+      GetUniversalCompressionType(
+          ioptions_, start_level, 1, estimated_total_size, enable_compression),
       /* grandparents = */ std::vector<FileMetaData*>(), ioptions_.info_log,
       /* is_manual = */ false, score,
       /* deletion_compaction = */ false, compaction_reason);
@@ -1819,8 +1875,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalDe
     const auto sr = &sorted_runs[loop];
 
     if (!sr->being_compacted && sr->delete_after_compaction()) {
-      FileMetaData* f = sr->file;
-      input_files.files.push_back(f);
+      sr->AddLevel0Files(&input_files.files);
 
       char file_num_buf[kFormatFileSizeInfoBufSize];
       sr->DumpSizeInfo(file_num_buf, sizeof(file_num_buf), loop);
@@ -1957,8 +2012,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
   for (size_t loop = start_index; loop < sorted_runs.size(); loop++) {
     auto& picking_sr = sorted_runs[loop];
     if (picking_sr.level == 0) {
-      FileMetaData* f = picking_sr.file;
-      inputs[0].files.push_back(f);
+      picking_sr.AddLevel0Files(&inputs[0].files);
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -1975,11 +2029,121 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
       vstorage, mutable_cf_options, std::move(inputs), vstorage->num_levels() - 1,
       mutable_cf_options.MaxFileSizeForLevel(vstorage->num_levels() - 1),
       /* max_grandparent_overlap_bytes */ LLONG_MAX, path_id,
-      GetCompressionType(ioptions_, vstorage->num_levels() - 1, 1),
+      GetUniversalCompressionType(
+          ioptions_, vstorage->num_levels() - 1, 1, estimated_total_size),
       /* grandparents */ std::vector<FileMetaData*>(), ioptions_.info_log, /* is manual = */ false,
       score, false /* deletion_compaction */, CompactionReason::kUniversalSizeAmplification);
 }
 
+std::unique_ptr<Compaction> TimeWindowCompactionPicker::PickCompaction(
+    const std::string& cf_name,
+    const MutableCFOptions& mutable_cf_options,
+    VersionStorageInfo* vstorage,
+    LogBuffer* log_buffer) {
+  const auto& level0_files = vstorage->LevelFiles(0);
+  std::vector<uint64_t> windows;
+  if (vstorage->num_levels() == 1 && !level0_files.empty()) {
+    windows = ioptions_.compaction_time_window_policy->GetWindows(level0_files);
+  }
+  if (windows.empty()) {
+    return UniversalCompactionPicker::PickCompaction(
+        cf_name, mutable_cf_options, vstorage, log_buffer);
+  }
+  if (windows.size() != level0_files.size()) {
+    LOG(DFATAL) << "Wrong number of time windows: " << windows.size() << ", while "
+                << level0_files.size() << " files expected";
+    return UniversalCompactionPicker::PickCompaction(
+        cf_name, mutable_cf_options, vstorage, log_buffer);
+  }
+
+  std::unordered_map<const FileMetaData*, uint64_t> file_windows;
+  for (size_t i = 0; i != level0_files.size(); ++i) {
+    file_windows.emplace(level0_files[i], windows[i]);
+  }
+  const auto newest_window = *std::max_element(windows.begin(), windows.end());
+
+  std::vector<std::vector<SortedRun>> sorted_runs = CalculateSortedRuns(
+      *vstorage,
+      ioptions_,
+      mutable_cf_options.MaxFileSizeForCompaction());
+
+  for (const auto& block : sorted_runs) {
+    // Level 0 files are ordered from newest to oldest, so files of one window form continuous
+    // sequence, unless hybrid time went back. Each such sequence is compacted separately.
+    auto window_begin = block.begin();
+    while (window_begin != block.end()) {
+      const auto window = file_windows[window_begin->file];
+      auto window_end = std::find_if(window_begin, block.end(), [&](const SortedRun& sr) {
+        return file_windows[sr.file] != window;
+      });
+      std::vector<SortedRun> window_runs(window_begin, window_end);
+      window_begin = window_end;
+
+      RDEBUG(ioptions_.info_log,
+             "[%s] Time window: %" PRIu64 ", sorted runs: %" ROCKSDB_PRIszt "\n",
+             cf_name.c_str(), window, window_runs.size());
+      auto result = window == newest_window
+          ? DoPickCompaction(cf_name, mutable_cf_options, vstorage, log_buffer, window_runs)
+          : PickCompactionOldWindow(
+                cf_name, mutable_cf_options, vstorage, window_runs, log_buffer);
+      if (result != nullptr) {
+        return result;
+      }
+    }
+  }
+  TEST_SYNC_POINT("TimeWindowCompactionPicker::PickCompaction:SkippingCompaction");
+  return nullptr;
+}
+
+std::unique_ptr<Compaction> TimeWindowCompactionPicker::PickCompactionOldWindow(
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    VersionStorageInfo* vstorage, const std::vector<SortedRun>& sorted_runs,
+    LogBuffer* log_buffer) {
+  const double score = vstorage->CompactionScore(0);
+  // Expired files are dropped without merging them with the rest of the window.
+  if (ioptions_.compaction_file_filter_factory) {
+    auto c = PickCompactionUniversalDeletion(
+        cf_name, mutable_cf_options, vstorage, score, sorted_runs, log_buffer);
+    if (c) {
+      LOG_TO_BUFFER(log_buffer, "[%s] Time window: compacting for direct deletion\n",
+                    cf_name.c_str());
+      return c;
+    }
+  }
+
+  if (sorted_runs.size() < 2) {
+    return nullptr;
+  }
+  for (const auto& sr : sorted_runs) {
+    if (sr.being_compacted || sr.delete_after_compaction()) {
+      RDEBUG(ioptions_.info_log, "[%s] Time window: skipping window with %s, that is %s\n",
+             cf_name.c_str(), sr.FileNumAsString().c_str(),
+             sr.being_compacted ? "being compacted" : "marked for deletion");
+      return nullptr;
+    }
+  }
+
+  std::vector<CompactionInputFiles> inputs(1);
+  uint64_t estimated_total_size = 0;
+  for (size_t loop = 0; loop < sorted_runs.size(); loop++) {
+    const auto& sr = sorted_runs[loop];
+    sr.AddLevel0Files(&inputs[0].files);
+    estimated_total_size += sr.size;
+
+    char file_num_buf[kFormatFileSizeInfoBufSize];
+    sr.DumpSizeInfo(file_num_buf, sizeof(file_num_buf), loop);
+    LOG_TO_BUFFER(log_buffer, "[%s] Time window: picking %s", cf_name.c_str(), file_num_buf);
+  }
+
+  return Compaction::Create(
+      vstorage, mutable_cf_options, std::move(inputs), /* output level = */ 0,
+      mutable_cf_options.MaxFileSizeForLevel(0),
+      /* max_grandparent_overlap_bytes */ LLONG_MAX, GetPathId(ioptions_, estimated_total_size),
+      GetCompressionType(ioptions_, 0, 1),
+      /* grandparents */ std::vector<FileMetaData*>(), ioptions_.info_log, /* is manual = */ false,
+      score, false /* deletion_compaction */, CompactionReason::kUniversalTimeWindow);
+}
+
 bool FIFOCompactionPicker::NeedsCompaction(const VersionStorageInfo* vstorage)
     const {
   const int kLevel0 = 0;
@@ -261,7 +261,7 @@ class UniversalCompactionPicker : public CompactionPicker {
   virtual bool NeedsCompaction(const VersionStorageInfo* vstorage) const
       override;
 
- private:
+ protected:
   struct SortedRun;
 
   std::unique_ptr<Compaction> DoPickCompaction(
@@ -307,6 +307,32 @@ class UniversalCompactionPicker : public CompactionPicker {
                             uint64_t file_size);
 };
 
+// Universal compaction, that splits level 0 files into time windows using
+// compaction_time_window_policy, and never compacts files from different windows together.
+// Files of the newest window are compacted as by UniversalCompactionPicker, while files of older
+// windows, that do not receive new writes anymore, are merged into one sorted run. So old data is
+// not rewritten together with new data, and expired windows could be dropped whole by the
+// compaction file filter.
+class TimeWindowCompactionPicker : public UniversalCompactionPicker {
+ public:
+  TimeWindowCompactionPicker(const ImmutableCFOptions& ioptions,
+                             const InternalKeyComparator* icmp)
+      : UniversalCompactionPicker(ioptions, icmp) {}
+
+  std::unique_ptr<Compaction> PickCompaction(
+      const std::string& cf_name,
+      const MutableCFOptions& mutable_cf_options,
+      VersionStorageInfo* vstorage,
+      LogBuffer* log_buffer) override;
+
+ private:
+  // Pick compaction that merges sorted runs of a window, that is not the newest one.
+  std::unique_ptr<Compaction> PickCompactionOldWindow(
+      const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+      VersionStorageInfo* vstorage, const std::vector<SortedRun>& sorted_runs,
+      LogBuffer* log_buffer);
+};
+
 class FIFOCompactionPicker : public CompactionPicker {
  public:
   FIFOCompactionPicker(const ImmutableCFOptions& ioptions,
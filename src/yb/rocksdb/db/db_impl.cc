@@ -55,6 +55,7 @@
 #include "yb/util/flags.h"
 #include "yb/util/priority_thread_pool.h"
 #include "yb/util/atomic.h"
+#include "yb/util/monotime.h"
 
 #include "yb/rocksdb/db/auto_roll_logger.h"
 #include "yb/rocksdb/db/builder.h"
@@ -156,6 +157,14 @@ DEFINE_int32(automatic_compaction_extra_priority, 50,
              "enabled. This deprioritizes manual compactions including those induced by the "
              "tserver (e.g. post-split compactions). Suggested value between 0 and 50.");
 
+DEFINE_int32(compaction_priority_wait_step_secs, 0,
+             "Compaction task gets 1 extra priority for every compaction_priority_wait_step_secs "
+             "seconds it waited in the queue before start, so compactions of small tablets are "
+             "not starved by compactions of large ones. 0 disables.");
+
+DEFINE_int32(compaction_priority_max_wait_bonus, 20,
+             "Max extra priority that compaction task could get for waiting in the queue.");
+
 DECLARE_bool(enable_automatic_tablet_splitting);
 
 DEFINE_bool(rocksdb_use_logging_iterator, false,
@@ -278,6 +287,9 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
   }
 
   void DoRun(yb::PriorityThreadPoolSuspender* suspender) override {
+    // Priority gained while waiting is kept, so the task is not paused right after start by the
+    // task it has outrun.
+    wait_bonus_.store(CalcWaitBonus(), std::memory_order_release);
     compaction_->SetSuspender(suspender);
     db_impl_->BackgroundCallCompaction(manual_compaction_, std::move(compaction_holder_), this);
   }
@@ -420,9 +432,22 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
       result += FLAGS_automatic_compaction_extra_priority;
     }
 
+    auto wait_bonus = wait_bonus_.load(std::memory_order_acquire);
+    result += wait_bonus >= 0 ? wait_bonus : CalcWaitBonus();
+
     return result;
   }
 
+  int CalcWaitBonus() const {
+    const auto step_secs = FLAGS_compaction_priority_wait_step_secs;
+    if (step_secs <= 0) {
+      return 0;
+    }
+    auto waited_secs = yb::ToSeconds(yb::CoarseMonoClock::Now() - queued_time_);
+    return std::min(
+        static_cast<int>(waited_secs / step_secs), FLAGS_compaction_priority_max_wait_bonus);
+  }
+
   void SetFileAndByteCount() {
     size_t levels = compaction_->num_input_levels();
     uint64_t file_count = 0;
@@ -435,6 +460,9 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
   DBImpl::ManualCompaction* const manual_compaction_;
   std::unique_ptr<Compaction> compaction_holder_;
   Compaction* compaction_;
+  const yb::CoarseTimePoint queued_time_ = yb::CoarseMonoClock::Now();
+  // Extra priority gained while waiting in the queue, fixed when the task is started.
+  std::atomic<int> wait_bonus_{-1};
   int priority_;
   yb::AtomicInt<int> job_id_{kNoJobId};
   CompactionInfo compaction_info_;
@@ -3914,6 +3942,27 @@ static void CleanupIteratorState(void* arg1, void* arg2) {
 
   delete state;
 }
+
+// Adds range of rows contained in the memtable iterator to row_ranges.
+// Returns false when the range could not be determined.
+bool AddMemTableRowRange(
+    InternalIterator* iter, const TableStatsReadFileFilter& filter,
+    std::vector<RowPrefixRange>* row_ranges) {
+  iter->SeekToFirst();
+  if (!iter->Valid()) {
+    return iter->status().ok();
+  }
+  RowPrefixRange range;
+  range.first = filter.RowPrefix(ExtractUserKey(iter->key())).ToBuffer();
+  iter->SeekToLast();
+  if (!iter->Valid()) {
+    return false;
+  }
+  range.last = filter.RowPrefix(ExtractUserKey(iter->key())).ToBuffer();
+  row_ranges->push_back(std::move(range));
+  return true;
+}
+
 }  // namespace
 
 InternalIterator* DBImpl::NewInternalIterator(const ReadOptions& read_options,
@@ -3925,13 +3974,31 @@ InternalIterator* DBImpl::NewInternalIterator(const ReadOptions& read_options,
   // Need to create internal iterator from the arena.
   MergeIteratorBuilder merge_iter_builder(cfd->internal_comparator().get(), arena);
   // Collect iterator for mutable mem
-  merge_iter_builder.AddIterator(
-      super_version->mem->NewIterator(read_options, arena));
-  // Collect all needed child iterators for immutable memtables
-  super_version->imm->AddIterators(read_options, &merge_iter_builder);
+  auto* mem_iter = super_version->mem->NewIterator(read_options, arena);
+  merge_iter_builder.AddIterator(mem_iter);
+
+  // Table stats file filter requires ranges of rows present in memtables.
+  std::vector<RowPrefixRange> memtable_row_ranges;
+  bool use_table_stats_file_filter =
+      read_options.table_stats_file_filter && !cfd->ioptions()->prefix_extractor;
+  if (use_table_stats_file_filter) {
+    const auto& filter = *read_options.table_stats_file_filter;
+    use_table_stats_file_filter = AddMemTableRowRange(mem_iter, filter, &memtable_row_ranges);
+    std::vector<InternalIterator*> imm_iters;
+    super_version->imm->AddIterators(read_options, &imm_iters, arena);
+    for (auto* iter : imm_iters) {
+      use_table_stats_file_filter = use_table_stats_file_filter &&
+                                    AddMemTableRowRange(iter, filter, &memtable_row_ranges);
+      merge_iter_builder.AddIterator(iter);
+    }
+  } else {
+    // Collect all needed child iterators for immutable memtables
+    super_version->imm->AddIterators(read_options, &merge_iter_builder);
+  }
   // Collect iterators for files in L0 - Ln
-  super_version->current->AddIterators(read_options, env_options_,
-                                       &merge_iter_builder);
+  super_version->current->AddIterators(
+      read_options, env_options_, &merge_iter_builder,
+      use_table_stats_file_filter ? &memtable_row_ranges : nullptr);
   internal_iter = merge_iter_builder.Finish();
   IterState* cleanup = new IterState(this, &mutex_, super_version);
   internal_iter->RegisterCleanup(CleanupIteratorState, cleanup, nullptr);
@@ -5803,6 +5870,22 @@ Result<std::string> DBImpl::GetMiddleKey() {
   return default_cf_handle_->cfd()->current()->GetMiddleKey();
 }
 
+Result<std::vector<std::string>> DBImpl::GetSampleKeys(size_t max_keys) {
+  // Reading the whole index could take a while, so don't hold the mutex for that time.
+  Version* current;
+  {
+    InstrumentedMutexLock lock(&mutex_);
+    current = default_cf_handle_->cfd()->current();
+    current->Ref();
+  }
+  auto result = current->GetSampleKeys(max_keys);
+  {
+    InstrumentedMutexLock lock(&mutex_);
+    current->Unref();
+  }
+  return result;
+}
+
 yb::Result<TableReader*> DBImpl::TEST_GetLargestSstTableReader() {
   InstrumentedMutexLock lock(&mutex_);
   return default_cf_handle_->cfd()->current()->TEST_GetLargestSstTableReader();
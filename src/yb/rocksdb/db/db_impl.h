@@ -485,6 +485,8 @@ class DBImpl : public DB {
 
   Result<std::string> GetMiddleKey() override;
 
+  Result<std::vector<std::string>> GetSampleKeys(size_t max_keys) override;
+
   // Returns a table reader for the largest SST file.
   Result<TableReader*> TEST_GetLargestSstTableReader() override;
 
@@ -1264,6 +1264,89 @@ INSTANTIATE_TEST_CASE_P(UniversalCompactionNumLevels, DBTestUniversalCompactionW
                         ::testing::Combine(::testing::Values(1, 3, 5),
                                            ::testing::Bool()));
 
+class DBTestUniversalSubcompactions : public DBTestBase {
+ public:
+  DBTestUniversalSubcompactions() : DBTestBase("/db_universal_subcompactions_test") {}
+};
+
+namespace {
+
+// Row of the key is the part before '/'.
+Slice RowPrefix(Slice user_key) {
+  auto end = user_key.cdata() + user_key.size();
+  auto pos = std::find(user_key.cdata(), end, '/');
+  return pos == end ? user_key : Slice(user_key.cdata(), pos + 1);
+}
+
+std::string RowKey(int row, int column) {
+  char buf[100];
+  snprintf(buf, sizeof(buf), "row%04d/col%d", row, column);
+  return buf;
+}
+
+} // namespace
+
+TEST_F(DBTestUniversalSubcompactions, SingleLevel) {
+  constexpr int kNumFiles = 4;
+  constexpr int kNumRows = 300;
+  constexpr int kNumColumns = 3;
+
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.disable_auto_compactions = true;
+  options.max_subcompactions = 4;
+  options.compaction_size_threshold_bytes = 0;
+  options.compaction_row_prefix_extractor =
+      std::make_shared<std::function<yb::Result<Slice>(Slice)>>(
+          [](Slice user_key) -> yb::Result<Slice> { return RowPrefix(user_key); });
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 256;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  for (int file = 0; file != kNumFiles; ++file) {
+    for (int row = 0; row != kNumRows; ++row) {
+      for (int column = 0; column != kNumColumns; ++column) {
+        ASSERT_OK(Put(RowKey(row, column), yb::Format("value$0", file)));
+      }
+    }
+    ASSERT_OK(Flush());
+  }
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  ASSERT_GT(files.size(), 1);
+  std::sort(files.begin(), files.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.smallest.key < rhs.smallest.key;
+  });
+  for (size_t i = 0; i != files.size(); ++i) {
+    // Outputs form one sorted run.
+    ASSERT_EQ(files[i].smallest.seqno, files[0].smallest.seqno);
+    ASSERT_EQ(files[i].largest.seqno, files[0].largest.seqno);
+    if (i > 0) {
+      // Rows are not split between subcompactions.
+      ASSERT_LT(RowPrefix(files[i - 1].largest.key).ToBuffer(),
+                RowPrefix(files[i].smallest.key).ToBuffer());
+    }
+  }
+
+  for (int row = 0; row != kNumRows; ++row) {
+    for (int column = 0; column != kNumColumns; ++column) {
+      ASSERT_EQ(Get(RowKey(row, column)), yb::Format("value$0", kNumFiles - 1));
+    }
+  }
+
+  // Outputs are compacted again as a single sorted run.
+  ASSERT_OK(Put(RowKey(0, 0), "new_value"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(Get(RowKey(0, 0)), "new_value");
+  ASSERT_EQ(Get(RowKey(kNumRows - 1, 0)), yb::Format("value$0", kNumFiles - 1));
+}
+
 class DBTestUniversalManualCompactionOutputPathId
     : public DBTestUniversalCompactionBase {
  public:
@@ -1465,6 +1548,65 @@ TEST_F(DBTestUniversalCompaction, IncludeFilesSmallerThanThreshold) {
   GenerateFilesAndCheckCompactionResult(options, file_sizes, value_size, 1);
 }
 
+namespace {
+
+// Time window of the file is the first character of its keys.
+class KeyPrefixTimeWindowPolicy : public CompactionTimeWindowPolicy {
+ public:
+  std::vector<uint64_t> GetWindows(const std::vector<FileMetaData*>& files) override {
+    std::vector<uint64_t> result;
+    for (auto* file : files) {
+      result.push_back(file->smallest.key.user_key()[0]);
+    }
+    return result;
+  }
+
+  const char* Name() const override {
+    return "KeyPrefixTimeWindowPolicy";
+  }
+};
+
+} // namespace
+
+TEST_F(DBTestUniversalCompaction, TimeWindows) {
+  Options options;
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.level0_file_num_compaction_trigger = 3;
+  options.compaction_time_window_policy = std::make_shared<KeyPrefixTimeWindowPolicy>();
+  options = CurrentOptions(options);
+  DestroyAndReopen(options);
+
+  ASSERT_OK(dbfull()->SetOptions({{"disable_auto_compactions", "true"}}));
+
+  constexpr int kKeysPerFile = 100;
+  // Two files of the first window, followed by three files of the second one.
+  const std::vector<char> file_windows = {'1', '1', '2', '2', '2'};
+  for (size_t i = 0; i != file_windows.size(); ++i) {
+    for (int j = 0; j != kKeysPerFile; ++j) {
+      ASSERT_OK(Put(yb::Format("$0key$1", file_windows[i], j), yb::ToString(i)));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(NumSortedRuns(0), file_windows.size());
+
+  ASSERT_OK(dbfull()->EnableAutoCompaction({dbfull()->DefaultColumnFamily()}));
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+
+  // Files of each window are compacted together, but windows are never mixed.
+  ASSERT_EQ(NumSortedRuns(0), 2);
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(files.size(), 2);
+  for (const auto& file : files) {
+    ASSERT_EQ(file.smallest.key[0], file.largest.key[0]) << file.ToString();
+  }
+  for (int j = 0; j != kKeysPerFile; ++j) {
+    ASSERT_EQ(Get(yb::Format("1key$0", j)), "1");
+    ASSERT_EQ(Get(yb::Format("2key$0", j)), "4");
+  }
+}
+
 }  // namespace rocksdb
 
 #endif  // !defined(ROCKSDB_LITE)
@@ -234,6 +234,7 @@ Result<FileNumbersHolder> FlushJob::WriteLevel0Table(
   meta->fd = FileDescriptor(file_number, 0, 0, 0);
 
   Status s;
+  UserFrontierPtr largest_user_frontier;
   {
     db_mutex_->Unlock();
     if (log_buffer_) {
@@ -298,7 +299,9 @@ Result<FileNumbersHolder> FlushJob::WriteLevel0Table(
                      cfd_->internal_stats(),
                      db_options_.boundary_extractor.get(),
                      yb::IOPriority::kHigh,
-                     &table_properties_);
+                     &table_properties_,
+                     db_options_.flush_compaction_context_factory.get(),
+                     &largest_user_frontier);
       info.table_properties = table_properties_;
       LogFlush(db_options_.info_log);
     }
@@ -341,6 +344,11 @@ Result<FileNumbersHolder> FlushJob::WriteLevel0Table(
     // that key range.
     // Add file to L0
     edit->AddCleanedFile(0 /* level */, *meta);
+    // Persist frontier of the compaction context, for instance history cutoff used to drop
+    // obsolete data.
+    if (largest_user_frontier) {
+      edit->UpdateFlushedFrontier(std::move(largest_user_frontier));
+    }
   }
 
   InternalStats::CompactionStats stats(1);
@@ -78,11 +78,12 @@ DEFINE_string(memtablerep, "skiplist",
               "\tskiplist            -- backed by a skiplist\n"
               "\tvector              -- backed by an std::vector\n"
               "\thashskiplist        -- backed by a hash skip list\n"
-              "\thashlinklist        -- backed by a hash linked list\n");
+              "\thashlinklist        -- backed by a hash linked list\n"
+              "\tprefixindexedskiplist -- backed by a skiplist with a prefix hash index\n");
 
 DEFINE_int64(bucket_count, 1000000,
-             "bucket_count parameter to pass into NewHashSkiplistRepFactory or "
-             "NewHashLinkListRepFactory");
+             "bucket_count parameter to pass into NewHashSkiplistRepFactory, "
+             "NewHashLinkListRepFactory or PrefixIndexedSkipListFactory");
 
 DEFINE_int32(
     hashskiplist_height, 4,
@@ -92,6 +93,10 @@ DEFINE_int32(
     hashskiplist_branching_factor, 4,
     "branching_factor parameter to pass into NewHashSkiplistRepFactory");
 
+DEFINE_int32(
+    prefixindexedskiplist_lookahead, 16,
+    "lookahead parameter to pass into PrefixIndexedSkipListFactory");
+
 DEFINE_int32(
     huge_page_tlb_size, 0,
     "huge_page_tlb_size parameter to pass into NewHashLinkListRepFactory");
@@ -123,6 +128,10 @@ DEFINE_int32(num_scans, 10,
 
 DEFINE_int32(item_size, 100, "Number of bytes each item should be");
 
+DEFINE_int64(huge_page_size, 0,
+             "Page size for huge page TLB used for memtable arena blocks. "
+             "When 0 arena blocks are allocated with malloc.");
+
 DEFINE_int32(prefix_length, 8,
              "Prefix length to pass into NewFixedPrefixTransform");
 
@@ -607,6 +616,11 @@ int main(int argc, char** argv) {
         FLAGS_if_log_bucket_dist_when_flash, FLAGS_threshold_use_skiplist));
     options.prefix_extractor.reset(
         rocksdb::NewFixedPrefixTransform(FLAGS_prefix_length));
+  } else if (FLAGS_memtablerep == "prefixindexedskiplist") {
+    factory.reset(new rocksdb::PrefixIndexedSkipListFactory(
+        std::shared_ptr<const rocksdb::SliceTransform>(
+            rocksdb::NewFixedPrefixTransform(FLAGS_prefix_length)),
+        FLAGS_bucket_count, FLAGS_prefixindexedskiplist_lookahead));
   } else {
     fprintf(stdout, "Unknown memtablerep: %s\n", FLAGS_memtablerep.c_str());
     exit(1);
@@ -615,7 +629,7 @@ int main(int argc, char** argv) {
   rocksdb::InternalKeyComparator internal_key_comp(
       rocksdb::BytewiseComparator());
   rocksdb::MemTable::KeyComparator key_comp(internal_key_comp);
-  rocksdb::Arena arena;
+  rocksdb::Arena arena(rocksdb::Arena::kMinBlockSize, FLAGS_huge_page_size);
   rocksdb::WriteBuffer wb(FLAGS_write_buffer_size);
   rocksdb::MemTableAllocator memtable_allocator(&arena, &wb);
   uint64_t sequence;
@@ -113,6 +113,10 @@ class SkipListBase {
     // Advance to the first entry with a key >= target
     void Seek(Key target);
 
+    // Position at the entry with the specified key, that was previously inserted to the list.
+    // Supported only by node types that are able to restore node from its key.
+    void SetPosition(Key key);
+
     // Position at the first entry in list.
     // Final state of iterator is Valid() iff list is not empty.
     void SeekToFirst();
@@ -314,6 +318,11 @@ void SkipListBase<Key, Comparator, NodeType>::Iterator::Seek(Key target) {
   node_ = list_->FindGreaterOrEqual(target);
 }
 
+template<class Key, class Comparator, class NodeType>
+void SkipListBase<Key, Comparator, NodeType>::Iterator::SetPosition(Key key) {
+  node_ = Node::FromKey(key);
+}
+
 template<class Key, class Comparator, class NodeType>
 void SkipListBase<Key, Comparator, NodeType>::Iterator::SeekToFirst() {
   node_ = list_->head_->Next(0);
@@ -615,6 +624,11 @@ struct SingleWriterInlineSkipListNode {
   static SingleWriterInlineSkipListNode* CreateHead(Allocator* allocator, int height) {
     return Create(allocator, 0 /* key_size */, height);
   }
+
+  static SingleWriterInlineSkipListNode* FromKey(const char* key) {
+    return reinterpret_cast<SingleWriterInlineSkipListNode*>(
+        const_cast<char*>(key) - offsetof(SingleWriterInlineSkipListNode, key));
+  }
 };
 
 // Skip list designed for using variable size byte arrays as a key.
@@ -639,8 +653,7 @@ class SingleWriterInlineSkipList :
 
   void Insert(const char* key) {
     Base::PrepareInsert(key);
-    auto node = reinterpret_cast<SingleWriterInlineSkipListNode*>(
-        const_cast<char*>(key) - offsetof(SingleWriterInlineSkipListNode, key));
+    auto node = SingleWriterInlineSkipListNode::FromKey(key);
     Base::CompleteInsert(node, node->UnstashHeight());
   }
 
@@ -63,8 +63,6 @@ InternalKeyPropertiesCollector::GetReadableProperties() const {
   };
 }
 
-namespace {
-
 EntryType GetEntryType(ValueType value_type) {
   switch (value_type) {
     case kTypeValue:
@@ -80,8 +78,6 @@ EntryType GetEntryType(ValueType value_type) {
   }
 }
 
-}  // namespace
-
 Status UserKeyTablePropertiesCollector::InternalAdd(const Slice& key,
                                                     const Slice& value,
                                                     uint64_t file_size) {
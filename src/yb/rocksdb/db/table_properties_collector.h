@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include "yb/rocksdb/db/dbformat.h"
 #include "yb/rocksdb/table_properties.h"
 
 #include <memory>
@@ -29,6 +30,8 @@
 
 namespace rocksdb {
 
+EntryType GetEntryType(ValueType value_type);
+
 struct InternalKeyTablePropertiesNames {
   static const std::string kDeletedKeys;
 };
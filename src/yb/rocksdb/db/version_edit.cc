@@ -132,6 +132,12 @@ std::string FileMetaData::ToString() const {
                     being_compacted, smallest, largest);
 }
 
+bool IsSameSortedRun(const FileMetaData& lhs, const FileMetaData& rhs) {
+  // Files added with DB::AddFile could have zero sequence numbers.
+  return lhs.largest.seqno != 0 &&
+         lhs.smallest.seqno == rhs.smallest.seqno && lhs.largest.seqno == rhs.largest.seqno;
+}
+
 void VersionEdit::Clear() {
   comparator_.reset();
   max_level_ = 0;
@@ -166,6 +166,10 @@ struct FileMetaData {
   AtomicWord delete_after_compaction_ = 0;
 };
 
+// Outputs of level 0 compaction that was split into subcompactions have disjoint key ranges and
+// share the same sequence number range, so they form one sorted run.
+bool IsSameSortedRun(const FileMetaData& lhs, const FileMetaData& rhs);
+
 class VersionEdit {
  public:
   VersionEdit() { Clear(); }
@@ -805,9 +805,28 @@ uint64_t VersionStorageInfo::GetEstimatedActiveKeys() const {
   }
 }
 
+namespace {
+
+RowPrefixRange FileRowRange(
+    const FdWithBoundaries& file, const TableStatsReadFileFilter& filter) {
+  return RowPrefixRange {
+    .first = filter.RowPrefix(file.smallest.user_key()).ToBuffer(),
+    .last = filter.RowPrefix(file.largest.user_key()).ToBuffer(),
+  };
+}
+
+bool RowRangesOverlap(
+    const Comparator& comparator, const RowPrefixRange& lhs, const RowPrefixRange& rhs) {
+  return comparator.Compare(lhs.first, rhs.last) <= 0 &&
+         comparator.Compare(rhs.first, lhs.last) <= 0;
+}
+
+} // namespace
+
 void Version::AddIterators(const ReadOptions& read_options,
                            const EnvOptions& soptions,
-                           MergeIteratorBuilder* merge_iter_builder) {
+                           MergeIteratorBuilder* merge_iter_builder,
+                           const std::vector<RowPrefixRange>* memtable_row_ranges) {
   assert(storage_info_.finalized_);
 
   if (storage_info_.num_non_empty_levels() == 0) {
@@ -816,10 +835,24 @@ void Version::AddIterators(const ReadOptions& read_options,
   }
 
   auto* arena = merge_iter_builder->GetArena();
+  const auto* stats_filter =
+      memtable_row_ranges ? read_options.table_stats_file_filter.get() : nullptr;
+  // Level 0 files checked by stats_filter, with their table readers. File rejected by stats_filter
+  // is still read when it shares rows with some other source, otherwise the iterator would return
+  // partial rows. So iterators for such files are created only when it is known which of them
+  // are read.
+  struct StatsFilteredFile {
+    size_t idx;
+    TableCache::TableReaderWithHandle trwh;
+    RowPrefixRange row_range;
+    bool read;
+  };
+  std::vector<StatsFilteredFile> stats_filtered_files;
 
   // Merge all level zero files together since they may overlap
-  for (size_t i = 0; i < storage_info_.LevelFilesBrief(0).num_files; i++) {
-    const auto& file = storage_info_.LevelFilesBrief(0).files[i];
+  const auto& level0_files = storage_info_.LevelFilesBrief(0);
+  for (size_t i = 0; i < level0_files.num_files; i++) {
+    const auto& file = level0_files.files[i];
     if (!read_options.file_filter || read_options.file_filter->Filter(file)) {
       InternalIterator *file_iter;
       TableCache::TableReaderWithHandle trwh;
@@ -829,6 +862,16 @@ void Version::AddIterators(const ReadOptions& read_options,
       if (s.ok()) {
         if (!read_options.table_aware_file_filter ||
             read_options.table_aware_file_filter->Filter(trwh.table_reader)) {
+          if (stats_filter) {
+            bool read = stats_filter->Filter(trwh.table_reader);
+            stats_filtered_files.push_back(StatsFilteredFile {
+              .idx = i,
+              .trwh = std::move(trwh),
+              .row_range = FileRowRange(file, *stats_filter),
+              .read = read,
+            });
+            continue;
+          }
           file_iter = cfd_->table_cache()->NewIterator(
               read_options, &trwh, storage_info_.LevelFiles(0)[i]->UserFilter(), false, arena);
         } else {
@@ -843,6 +886,68 @@ void Version::AddIterators(const ReadOptions& read_options,
     }
   }
 
+  if (!stats_filtered_files.empty()) {
+    std::vector<RowPrefixRange> other_row_ranges(
+        memtable_row_ranges->begin(), memtable_row_ranges->end());
+    for (int level = 1; level < storage_info_.num_non_empty_levels(); level++) {
+      const auto& level_files = storage_info_.LevelFilesBrief(level);
+      if (level_files.num_files != 0) {
+        other_row_ranges.push_back(RowPrefixRange {
+          .first = stats_filter->RowPrefix(level_files.files[0].smallest.user_key()).ToBuffer(),
+          .last = stats_filter->RowPrefix(
+              level_files.files[level_files.num_files - 1].largest.user_key()).ToBuffer(),
+        });
+      }
+    }
+
+    // Whether the file shares rows with any other source that is read.
+    const auto& user_comparator = *cfd_->internal_comparator()->user_comparator();
+    auto overlaps_read_rows = [&](size_t file_idx) {
+      const auto& row_range = stats_filtered_files[file_idx].row_range;
+      for (const auto& other_range : other_row_ranges) {
+        if (RowRangesOverlap(user_comparator, row_range, other_range)) {
+          return true;
+        }
+      }
+      for (size_t i = 0; i != stats_filtered_files.size(); ++i) {
+        const auto& other_file = stats_filtered_files[i];
+        if (i != file_idx && other_file.read &&
+            RowRangesOverlap(user_comparator, row_range, other_file.row_range)) {
+          return true;
+        }
+      }
+      return false;
+    };
+
+    // Each added file could make other rejected files overlap with read rows, so repeat until
+    // nothing changes.
+    bool added = true;
+    while (added) {
+      added = false;
+      for (size_t i = 0; i != stats_filtered_files.size(); ++i) {
+        auto& file = stats_filtered_files[i];
+        if (!file.read && overlaps_read_rows(i)) {
+          file.read = true;
+          added = true;
+        }
+      }
+    }
+
+    // Rows of the file, that does not share rows with other sources, are complete in this file.
+    // So its data blocks could be also filtered.
+    ReadOptions data_blocks_read_options = read_options;
+    data_blocks_read_options.table_stats_filter_data_blocks = true;
+    for (size_t i = 0; i != stats_filtered_files.size(); ++i) {
+      auto& file = stats_filtered_files[i];
+      if (!file.read) {
+        continue;
+      }
+      merge_iter_builder->AddIterator(cfd_->table_cache()->NewIterator(
+          overlaps_read_rows(i) ? read_options : data_blocks_read_options, &file.trwh,
+          storage_info_.LevelFiles(0)[file.idx]->UserFilter(), false, arena));
+    }
+  }
+
   // For levels > 0, we can use a concatenating iterator that sequentially
   // walks through the non-overlapping files in the level, opening them
   // lazily.
@@ -1251,10 +1356,14 @@ void VersionStorageInfo::ComputeCompactionScore(
       // overwrites/deletions).
       int num_sorted_runs = 0;
       uint64_t total_size = 0;
+      FileMetaData* prev_file = nullptr;
       for (auto* f : files_[level]) {
         if (!f->being_compacted) {
           total_size += f->compensated_file_size;
-          num_sorted_runs++;
+          if (!prev_file || !IsSameSortedRun(*prev_file, *f)) {
+            num_sorted_runs++;
+          }
+          prev_file = f;
         }
       }
       if (compaction_style_ == kCompactionStyleUniversal) {
@@ -2092,6 +2201,11 @@ Result<std::string> Version::GetMiddleKey() {
   return trwh.table_reader->GetMiddleKey();
 }
 
+Result<std::vector<std::string>> Version::GetSampleKeys(size_t max_keys) {
+  const auto trwh = VERIFY_RESULT(GetLargestSstTableReader());
+  return trwh.table_reader->GetSampleKeys(max_keys);
+}
+
 Result<TableReader*> Version::TEST_GetLargestSstTableReader() {
   const auto trwh = VERIFY_RESULT(GetLargestSstTableReader());
   return trwh.table_reader;
@@ -435,13 +435,23 @@ class VersionStorageInfo {
   void operator=(const VersionStorageInfo&) = delete;
 };
 
+// Inclusive range of row prefixes, see TableStatsReadFileFilter.
+struct RowPrefixRange {
+  std::string first;
+  std::string last;
+};
+
 class Version {
  public:
   // Append to *iters a sequence of iterators that will
   // yield the contents of this Version when merged together.
   // REQUIRES: This version has been saved (see VersionSet::SaveTo)
+  // ReadOptions::table_stats_file_filter is applied only when memtable_row_ranges is specified,
+  // it should contain row ranges of all memtables that are read together with this version.
+  // Data blocks are filtered only for level 0 files that don't share rows with other read sources.
   void AddIterators(const ReadOptions&, const EnvOptions& soptions,
-                    MergeIteratorBuilder* merger_iter_builder);
+                    MergeIteratorBuilder* merger_iter_builder,
+                    const std::vector<RowPrefixRange>* memtable_row_ranges = nullptr);
 
   // Lookup the value for key.  If found, store it in *val and
   // return OK.  Else return a non-OK status.
@@ -519,6 +529,11 @@ class Version {
   // Returns Status(Incomplete) if there are no SST files for this version.
   Result<std::string> GetMiddleKey();
 
+  // Returns up to max_keys internal keys that divide the largest SST file into parts of roughly
+  // the same size (see TableReader::GetSampleKeys).
+  // Returns Status(Incomplete) if there are no SST files for this version.
+  Result<std::vector<std::string>> GetSampleKeys(size_t max_keys);
+
   // Returns a table reader for the largest SST file.
   Result<TableReader*> TEST_GetLargestSstTableReader();
 
@@ -107,6 +107,10 @@ struct ImmutableCFOptions {
 
   std::vector<CompressionType> compression_per_level;
 
+  uint64_t large_output_compression_min_size;
+
+  CompressionType large_output_compression;
+
   CompressionOptions compression_opts;
 
   bool level_compaction_dynamic_level_bytes;
@@ -135,6 +139,8 @@ struct ImmutableCFOptions {
 
   CompactionFileFilterFactory* compaction_file_filter_factory;
 
+  CompactionTimeWindowPolicy* compaction_time_window_policy;
+
   std::shared_ptr<RocksDBPriorityThreadPoolMetrics> priority_thread_pool_metrics;
 };
 
@@ -74,6 +74,8 @@ enum class CompactionReason {
   kManualCompaction,
   // DB::SuggestCompactRange() marked files for compaction
   kFilesMarkedForCompaction,
+  // [Universal] merging files of the time window, that does not receive new writes
+  kUniversalTimeWindow,
 };
 
 #ifndef ROCKSDB_LITE
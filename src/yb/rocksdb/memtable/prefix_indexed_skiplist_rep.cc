@@ -0,0 +1,256 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <atomic>
+
+#include "yb/rocksdb/db/memtable.h"
+#include "yb/rocksdb/db/skiplist.h"
+#include "yb/rocksdb/memtablerep.h"
+#include "yb/rocksdb/slice_transform.h"
+#include "yb/rocksdb/util/arena.h"
+#include "yb/rocksdb/util/murmurhash.h"
+
+namespace rocksdb {
+namespace {
+
+// Index entry for keys that share the same prefix.
+struct PrefixEntry {
+  PrefixEntry(Slice prefix_, const char* first_, PrefixEntry* next_)
+      : prefix(prefix_), first(first_), next(next_) {}
+
+  // Points to the key that introduced this prefix. Memtable nodes are never deallocated, even
+  // when erased, so it stays valid for the lifetime of the memtable.
+  const Slice prefix;
+
+  // The smallest key with this prefix, or nullptr when all such keys were erased.
+  std::atomic<const char*> first;
+
+  PrefixEntry* const next;
+};
+
+class PrefixIndexedSkipListRep : public MemTableRep {
+ public:
+  using SkipListImpl = SingleWriterInlineSkipList<const MemTableRep::KeyComparator&>;
+
+  PrefixIndexedSkipListRep(
+      const MemTableRep::KeyComparator& compare, MemTableAllocator* allocator,
+      const SliceTransform* transform, size_t bucket_count, size_t lookahead)
+      : MemTableRep(allocator), skip_list_(compare, allocator), cmp_(compare),
+        transform_(transform), bucket_count_(bucket_count), lookahead_(lookahead) {
+    auto mem = allocator->AllocateAligned(sizeof(std::atomic<PrefixEntry*>) * bucket_count_);
+    buckets_ = reinterpret_cast<std::atomic<PrefixEntry*>*>(mem);
+    for (size_t i = 0; i != bucket_count_; ++i) {
+      new (&buckets_[i]) std::atomic<PrefixEntry*>(nullptr);
+    }
+  }
+
+  KeyHandle Allocate(const size_t len, char** buf) override {
+    *buf = skip_list_.AllocateKey(len);
+    return static_cast<KeyHandle>(*buf);
+  }
+
+  void Insert(KeyHandle handle) override {
+    auto key = static_cast<const char*>(handle);
+    skip_list_.Insert(key);
+
+    // Index is updated after the key is linked to the list, so reader that observes the key in
+    // the index is also able to iterate from it.
+    auto user_key = UserKey(key);
+    if (!transform_->InDomain(user_key)) {
+      return;
+    }
+    auto prefix = transform_->Transform(user_key);
+    auto& bucket = buckets_[Hash(prefix)];
+    auto entry = FindEntry(bucket, prefix);
+    if (!entry) {
+      auto mem = allocator_->AllocateAligned(sizeof(PrefixEntry));
+      bucket.store(
+          new (mem) PrefixEntry(prefix, key, bucket.load(std::memory_order_relaxed)),
+          std::memory_order_release);
+      return;
+    }
+    auto first = entry->first.load(std::memory_order_relaxed);
+    if (!first || cmp_(key, first) < 0) {
+      entry->first.store(key, std::memory_order_release);
+    }
+  }
+
+  bool Erase(KeyHandle handle, const MemTableRep::KeyComparator& comparator) override {
+    auto key = static_cast<const char*>(handle);
+    auto user_key = UserKey(key);
+    PrefixEntry* entry = nullptr;
+    Slice prefix;
+    if (transform_->InDomain(user_key)) {
+      prefix = transform_->Transform(user_key);
+      entry = FindEntry(buckets_[Hash(prefix)], prefix);
+    }
+
+    if (!skip_list_.Erase(key, comparator)) {
+      return false;
+    }
+
+    // Erase removes the smallest entry with the user key, so it was the first entry with the
+    // prefix iff the first entry has the same user key.
+    auto first = entry ? entry->first.load(std::memory_order_relaxed) : nullptr;
+    if (!first || UserKey(first).compare(user_key) != 0) {
+      return true;
+    }
+    // Erased node still points to its successor.
+    SkipListImpl::Iterator iter(&skip_list_);
+    iter.SetPosition(first);
+    iter.Next();
+    const char* next = nullptr;
+    if (iter.Valid()) {
+      auto next_user_key = UserKey(iter.key());
+      if (transform_->InDomain(next_user_key) &&
+          transform_->Transform(next_user_key) == prefix) {
+        next = iter.key();
+      }
+    }
+    entry->first.store(next, std::memory_order_release);
+    return true;
+  }
+
+  bool Contains(const char* key) const override {
+    return skip_list_.Contains(key);
+  }
+
+  size_t ApproximateMemoryUsage() override {
+    // All memory is allocated through allocator; nothing to report here
+    return 0;
+  }
+
+  void Get(const LookupKey& k, void* callback_args,
+           bool (*callback_func)(void* arg, const char* entry)) override {
+    SkipListImpl::Iterator iter(&skip_list_);
+    if (!Seek(k.memtable_key().cdata(), &iter)) {
+      return;
+    }
+    for (; iter.Valid() && callback_func(callback_args, iter.key()); iter.Next()) {
+    }
+  }
+
+  uint64_t ApproximateNumEntries(const Slice& start_ikey, const Slice& end_ikey) override {
+    std::string tmp;
+    uint64_t start_count = skip_list_.EstimateCount(EncodeKey(&tmp, start_ikey));
+    uint64_t end_count = skip_list_.EstimateCount(EncodeKey(&tmp, end_ikey));
+    return (end_count >= start_count) ? (end_count - start_count) : 0;
+  }
+
+  class Iterator : public MemTableRep::Iterator {
+   public:
+    explicit Iterator(const PrefixIndexedSkipListRep& rep) : rep_(rep), iter_(&rep.skip_list_) {}
+
+    bool Valid() const override {
+      return iter_.Valid();
+    }
+
+    const char* key() const override {
+      return iter_.key();
+    }
+
+    void Next() override {
+      iter_.Next();
+    }
+
+    void Prev() override {
+      iter_.Prev();
+    }
+
+    void Seek(const Slice& internal_key, const char* memtable_key) override {
+      const char* encoded_key =
+          memtable_key != nullptr ? memtable_key : EncodeKey(&tmp_, internal_key);
+      if (!rep_.Seek(encoded_key, &iter_)) {
+        iter_.Seek(encoded_key);
+      }
+    }
+
+    void SeekToFirst() override {
+      iter_.SeekToFirst();
+    }
+
+    void SeekToLast() override {
+      iter_.SeekToLast();
+    }
+
+   private:
+    const PrefixIndexedSkipListRep& rep_;
+    SkipListImpl::Iterator iter_;
+    std::string tmp_; // For passing to EncodeKey
+  };
+
+  MemTableRep::Iterator* GetIterator(Arena* arena = nullptr) override {
+    void* mem = arena ? arena->AllocateAligned(sizeof(Iterator)) : operator new(sizeof(Iterator));
+    return new (mem) Iterator(*this);
+  }
+
+ private:
+  size_t Hash(Slice prefix) const {
+    return MurmurHash(prefix.data(), static_cast<int>(prefix.size()), 0) % bucket_count_;
+  }
+
+  static PrefixEntry* FindEntry(const std::atomic<PrefixEntry*>& bucket, Slice prefix) {
+    for (auto entry = bucket.load(std::memory_order_acquire); entry; entry = entry->next) {
+      if (entry->prefix == prefix) {
+        return entry;
+      }
+    }
+    return nullptr;
+  }
+
+  // Positions iter at the first entry >= memtable_key.
+  // Returns false, leaving iter unpositioned, when there are no entries with the same prefix as
+  // memtable_key.
+  bool Seek(const char* memtable_key, SkipListImpl::Iterator* iter) const {
+    auto user_key = UserKey(memtable_key);
+    if (!transform_->InDomain(user_key)) {
+      iter->Seek(memtable_key);
+      return true;
+    }
+    auto prefix = transform_->Transform(user_key);
+    auto entry = FindEntry(buckets_[Hash(prefix)], prefix);
+    auto first = entry ? entry->first.load(std::memory_order_acquire) : nullptr;
+    if (!first) {
+      return false;
+    }
+    // All keys with the same prefix are adjacent, so there is no key between memtable_key and
+    // first, when memtable_key is less than first.
+    iter->SetPosition(first);
+    for (size_t step = 0; step <= lookahead_ && iter->Valid(); ++step) {
+      if (cmp_(memtable_key, iter->key()) <= 0) {
+        return true;
+      }
+      iter->Next();
+    }
+    iter->Seek(memtable_key);
+    return true;
+  }
+
+  SkipListImpl skip_list_;
+  const MemTableRep::KeyComparator& cmp_;
+  const SliceTransform* const transform_;
+  const size_t bucket_count_;
+  const size_t lookahead_;
+  std::atomic<PrefixEntry*>* buckets_;
+};
+
+} // namespace
+
+MemTableRep* PrefixIndexedSkipListFactory::CreateMemTableRep(
+    const MemTableRep::KeyComparator& compare, MemTableAllocator* allocator,
+    const SliceTransform* transform, Logger* logger) {
+  return new PrefixIndexedSkipListRep(
+      compare, allocator, prefix_transform_.get(), bucket_count_, lookahead_);
+}
+
+} // namespace rocksdb
@@ -0,0 +1,134 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <memory>
+#include <string>
+
+#include "yb/rocksdb/db/memtable.h"
+#include "yb/rocksdb/db/merge_context.h"
+#include "yb/rocksdb/db/writebuffer.h"
+#include "yb/rocksdb/memtablerep.h"
+#include "yb/rocksdb/slice_transform.h"
+#include "yb/rocksdb/table/scoped_arena_iterator.h"
+#include "yb/rocksdb/util/testharness.h"
+#include "yb/rocksdb/util/testutil.h"
+
+namespace rocksdb {
+
+class PrefixIndexedSkipListRepTest : public RocksDBTest {
+ protected:
+  void SetUp() override {
+    RocksDBTest::SetUp();
+    // Use small bucket count and lookahead, so collisions and fallback to regular search are
+    // also covered.
+    options_.memtable_factory = std::make_shared<PrefixIndexedSkipListFactory>(
+        std::shared_ptr<const SliceTransform>(NewFixedPrefixTransform(2)), 2 /* bucket_count */,
+        1 /* lookahead */);
+    ioptions_ = std::make_unique<ImmutableCFOptions>(options_);
+    write_buffer_ = std::make_unique<WriteBuffer>(options_.db_write_buffer_size);
+    mem_ = new MemTable(
+        cmp_, *ioptions_, MutableCFOptions(options_, *ioptions_), write_buffer_.get(),
+        kMaxSequenceNumber);
+    mem_->Ref();
+  }
+
+  void TearDown() override {
+    delete mem_->Unref();
+    RocksDBTest::TearDown();
+  }
+
+  void Put(const std::string& key, const std::string& value) {
+    Slice key_slice(key);
+    Slice value_slice(value);
+    mem_->Add(++seq_, kTypeValue, SliceParts(&key_slice, 1), SliceParts(&value_slice, 1));
+  }
+
+  std::string Get(const std::string& key) {
+    std::string value;
+    Status s;
+    MergeContext merge_context;
+    if (!mem_->Get(LookupKey(key, seq_), &value, &s, &merge_context)) {
+      return "NOT_FOUND";
+    }
+    return value;
+  }
+
+  // Returns user key of the first entry that is greater or equal to key.
+  std::string Seek(const std::string& key) {
+    Arena arena;
+    ScopedArenaIterator iter(mem_->NewIterator(ReadOptions(), &arena));
+    iter->Seek(InternalKey::MaxPossibleForUserKey(key).Encode());
+    return iter->Valid() ? ExtractUserKey(iter->key()).ToString() : "END";
+  }
+
+  InternalKeyComparator cmp_{BytewiseComparator()};
+  Options options_;
+  std::unique_ptr<ImmutableCFOptions> ioptions_;
+  std::unique_ptr<WriteBuffer> write_buffer_;
+  MemTable* mem_ = nullptr;
+  SequenceNumber seq_ = 0;
+};
+
+TEST_F(PrefixIndexedSkipListRepTest, GetAndSeek) {
+  Put("b1", "v1");
+  Put("b3", "v3");
+  Put("b5", "v5");
+  Put("d1", "d1");
+  // Out of transform domain.
+  Put("c", "c");
+  // Smaller than the first key with the same prefix.
+  Put("b0", "v0");
+
+  ASSERT_EQ("v0", Get("b0"));
+  ASSERT_EQ("v5", Get("b5"));
+  ASSERT_EQ("c", Get("c"));
+  ASSERT_EQ("NOT_FOUND", Get("b2"));
+  ASSERT_EQ("NOT_FOUND", Get("a1"));
+
+  ASSERT_EQ("b0", Seek("b"));
+  ASSERT_EQ("b0", Seek("b0"));
+  ASSERT_EQ("b3", Seek("b2"));
+  // Further than lookahead from the first key with the same prefix.
+  ASSERT_EQ("b5", Seek("b4"));
+  ASSERT_EQ("c", Seek("b6"));
+  // Prefix without keys.
+  ASSERT_EQ("b0", Seek("a1"));
+  ASSERT_EQ("d1", Seek("c1"));
+  ASSERT_EQ("END", Seek("e1"));
+}
+
+TEST_F(PrefixIndexedSkipListRepTest, Erase) {
+  Put("b1", "v1");
+  Put("b2", "v2");
+  Put("c1", "c1");
+
+  ASSERT_TRUE(mem_->Erase("b1"));
+  ASSERT_EQ("NOT_FOUND", Get("b1"));
+  ASSERT_EQ("v2", Get("b2"));
+  ASSERT_EQ("b2", Seek("b0"));
+
+  ASSERT_TRUE(mem_->Erase("b2"));
+  ASSERT_EQ("NOT_FOUND", Get("b2"));
+  ASSERT_EQ("c1", Seek("b0"));
+
+  Put("b3", "v3");
+  ASSERT_EQ("v3", Get("b3"));
+  ASSERT_EQ("b3", Seek("b0"));
+}
+
+} // namespace rocksdb
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -264,6 +264,40 @@ class SkipListFactory : public MemTableRepFactory {
   const ConcurrentWrites concurrent_writes_;
 };
 
+// This uses a single writer skip list to store keys, and additionally indexes them by prefix of
+// the user key with a hash table.
+// Seek and Get start from the smallest key with the same prefix as the target, doing at most
+// 'lookahead' steps, and fall back to the regular skip list search. Get returns immediately when
+// there are no keys with the target prefix.
+//
+// Parameters:
+//   prefix_transform: Should return prefix of its input, so all keys with the same prefix are
+//     adjacent in the memtable order. It is not related to options.prefix_extractor, so iterators
+//     keep total order semantics.
+//   bucket_count: Number of hash table buckets, allocated in each memtable.
+//   lookahead: Max number of steps from the smallest key with the target prefix.
+class PrefixIndexedSkipListFactory : public MemTableRepFactory {
+ public:
+  explicit PrefixIndexedSkipListFactory(
+      std::shared_ptr<const SliceTransform> prefix_transform, size_t bucket_count = 1 << 14,
+      size_t lookahead = 16)
+      : prefix_transform_(std::move(prefix_transform)), bucket_count_(bucket_count),
+        lookahead_(lookahead) {}
+
+  MemTableRep* CreateMemTableRep(const MemTableRep::KeyComparator&,
+                                 MemTableAllocator*,
+                                 const SliceTransform*,
+                                 Logger* logger) override;
+  const char* Name() const override { return "PrefixIndexedSkipListFactory"; }
+
+  bool IsInMemoryEraseSupported() const override { return true; }
+
+ private:
+  const std::shared_ptr<const SliceTransform> prefix_transform_;
+  const size_t bucket_count_;
+  const size_t lookahead_;
+};
+
 class CDSSkipListFactory : public MemTableRepFactory {
  public:
   MemTableRep* CreateMemTableRep(const MemTableRep::KeyComparator&,
@@ -59,6 +59,7 @@ class CompactionFilterFactory;
 class Comparator;
 class Env;
 class CompactionFileFilterFactory;
+class CompactionTimeWindowPolicy;
 enum InfoLogLevel : unsigned char;
 class SstFileManager;
 class FilterPolicy;
@@ -380,6 +381,13 @@ struct ColumnFamilyOptions {
   // change when data grows.
   std::vector<CompressionType> compression_per_level;
 
+  // Universal compactions, whose input files are at least large_output_compression_min_size bytes
+  // in total, use large_output_compression instead of the compression selected above. Allows to
+  // use stronger and slower compression for big files produced by major compactions, while
+  // flushes and small compactions use a fast one. 0 disables this feature.
+  uint64_t large_output_compression_min_size = 0;
+  CompressionType large_output_compression = kNoCompression;
+
   // different options for compression algorithms
   CompressionOptions compression_opts;
 
@@ -766,6 +774,15 @@ struct ColumnFamilyOptions {
   // Dynamically changeable through SetOptions() API
   size_t memtable_prefix_bloom_huge_page_tlb_size;
 
+  // Page size for huge page TLB for memtable arena blocks. If 0, arena blocks are allocated
+  // from malloc. If huge pages could not be allocated, falls back to malloc.
+  // Need to reserve huge pages for it to be allocated. For example:
+  //      sysctl -w vm.nr_hugepages=20
+  // See linux doc Documentation/vm/hugetlbpage.txt
+  //
+  // Dynamically changeable through SetOptions() API, affects memtables created after the change.
+  size_t memtable_huge_page_size;
+
   // Control locality of bloom filter probes to improve cache miss rate.
   // This option only applies to memtable prefix bloom and plaintable
   // prefix bloom. It essentially limits every bloom checking to one cache line.
@@ -1021,6 +1038,9 @@ struct DBOptions {
   // This value represents the maximum number of threads that will
   // concurrently perform a compaction job by breaking it into multiple,
   // smaller ones that are run simultaneously.
+  // Compactions with level 0 output are split only when they are large
+  // (see compaction_size_threshold_bytes) and compaction_row_prefix_extractor
+  // is set.
   // Default: 1 (i.e. no subcompactions)
   uint32_t max_subcompactions;
 
@@ -1340,10 +1360,21 @@ struct DBOptions {
 
   std::shared_ptr<CompactionContextFactory> compaction_context_factory;
 
+  // Compaction context factory applied to the data flushed from memtables, so obsolete data that
+  // would be removed by compaction does not reach disk. Factory could return nullptr to flush
+  // data as is.
+  std::shared_ptr<CompactionContextFactory> flush_compaction_context_factory;
+
   // Function that returns max file size for compaction.
   // Supported only for level0 of universal style compactions.
   std::shared_ptr<std::function<uint64_t()>> max_file_size_for_compaction;
 
+  // Returns prefix of the user key that is shared by all entries of its row, or error when key
+  // could not be decoded. Compactions with level 0 output, i.e. universal compactions with single
+  // level, are split into subcompactions only when it is set. Their boundaries are aligned to rows,
+  // so all entries of the row are processed by the same subcompaction.
+  std::shared_ptr<std::function<yb::Result<Slice>(Slice)>> compaction_row_prefix_extractor;
+
   // Invoked after memtable switched.
   std::shared_ptr<std::function<MemTableFilter()>> mem_table_flush_filter_factory;
 
@@ -1366,6 +1397,10 @@ struct DBOptions {
   // completely expired based on their table and/or column TTL.
   std::shared_ptr<CompactionFileFilterFactory> compaction_file_filter_factory;
 
+  // When set, universal compactions of single level DB only compact files of the same time window,
+  // see TimeWindowCompactionPicker.
+  std::shared_ptr<CompactionTimeWindowPolicy> compaction_time_window_policy;
+
   // Metrics tracker for tasks in the priority thread pool.
   std::shared_ptr<RocksDBPriorityThreadPoolMetrics> priority_thread_pool_metrics;
 
@@ -1432,6 +1467,28 @@ class TableAwareReadFileFilter {
   virtual ~TableAwareReadFileFilter() {}
 };
 
+// Filter that skips files using statistics of values, that were collected to table properties
+// when the file was written. Unlike key based filters, entries of the same row could be spread
+// across several files, so file is skipped only when none of the other files and memtables read
+// by the iterator contains entries of rows from its key range.
+class TableStatsReadFileFilter {
+ public:
+  // Returns false when table does not contain values that could match the filter.
+  virtual bool Filter(TableReader*) const = 0;
+
+  // Returns prefix of the user key, that identifies the row this key belongs to.
+  virtual Slice RowPrefix(Slice user_key) const = 0;
+
+  // Returns false when data block with specified stats, produced by DataBlockStatsCollector, does
+  // not contain values that could match the filter. Stats of data block should cover all entries
+  // of rows that have entries in this block. So skipping it could leave only partial entries of
+  // rows that don't match, and the reader is still responsible for checking rows against filter.
+  virtual bool FilterDataBlock(Slice block_stats) const { return true; }
+
+ protected:
+  virtual ~TableStatsReadFileFilter() {}
+};
+
 // Options that control read operations
 struct ReadOptions {
   // If true, all data read from underlying storage will be
@@ -1537,6 +1594,13 @@ struct ReadOptions {
 
   std::shared_ptr<ReadFileFilter> file_filter;
 
+  // Applied only to files in level 0, see TableStatsReadFileFilter.
+  std::shared_ptr<TableStatsReadFileFilter> table_stats_file_filter;
+
+  // Whether table_stats_file_filter should also be applied to data blocks of the file. Set by
+  // Version::AddIterators only for files that don't share rows with other read sources.
+  bool table_stats_filter_data_blocks = false;
+
   static const ReadOptions kDefault;
 
   ReadOptions();
@@ -34,9 +34,11 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/status.h"
+#include "yb/rocksdb/table_properties.h"
 #include "yb/rocksdb/types.h"
 
 #include "yb/util/size_literals.h"
@@ -75,6 +77,31 @@ YB_DEFINE_ENUM(IndexType,
   (kMultiLevelBinarySearch)
 );
 
+// Collects stats of entries in data blocks of SST file. Stats are written to separate meta block
+// and are used to skip data blocks by ReadOptions::table_stats_file_filter.
+class DataBlockStatsCollector {
+ public:
+  virtual ~DataBlockStatsCollector() = default;
+
+  // Called for each entry added to SST file, in order.
+  virtual void Add(const Slice& user_key, const Slice& value, EntryType type) = 0;
+
+  // Called after the last entry of the data block was added.
+  virtual void BlockFinished() = 0;
+
+  // Called after all data blocks were finished. Returns encoded stats for each data block in the
+  // same order, or empty vector when stats could not be collected.
+  virtual std::vector<std::string> Finish() = 0;
+};
+
+class DataBlockStatsCollectorFactory {
+ public:
+  virtual ~DataBlockStatsCollectorFactory() = default;
+
+  // Creates collector for new SST file, should be thread safe.
+  virtual std::unique_ptr<DataBlockStatsCollector> CreateDataBlockStatsCollector() = 0;
+};
+
 // For advanced user only
 struct BlockBasedTableOptions {
   // @flush_block_policy_factory creates the instances of flush block policy.
@@ -93,6 +120,11 @@ struct BlockBasedTableOptions {
   // Note: Fixed-size bloom filter data blocks are never pre-loaded.
   bool cache_index_and_filter_blocks = false;
 
+  // When cache_index_and_filter_blocks is set, put index and filter blocks directly to the multi
+  // touch part of the block cache, so scans of data blocks, that fill the single touch part, do
+  // not evict them.
+  bool cache_index_and_filter_blocks_with_high_priority = false;
+
   IndexType index_type = IndexType::kMultiLevelBinarySearch;
 
   // Influence the behavior when kHashSearch is used.
@@ -153,6 +185,12 @@ struct BlockBasedTableOptions {
   // used to avoid too many index levels in case we have large keys.
   size_t min_keys_per_index_block = 64;
 
+  // For kMultiLevelBinarySearch: whether to write fence pointers for data blocks into separate
+  // meta block. Fence pointers are loaded and pinned in memory when SST is opened and allow the
+  // index iterator to locate data block for most seeks without reading lower level index blocks.
+  // Only used with bytewise user key comparator.
+  bool data_block_fence_pointers = false;
+
   // Use delta encoding to compress keys in data blocks.
   // Iterator::PinData() requires this option to be disabled.
   //
@@ -176,6 +214,9 @@ struct BlockBasedTableOptions {
   typedef std::unordered_map<std::string, FilterPolicyPtr> FilterPoliciesMap;
   std::shared_ptr<FilterPoliciesMap> supported_filter_policies;
 
+  // If non-nullptr, stats of entries in each data block are collected to separate meta block.
+  std::shared_ptr<DataBlockStatsCollectorFactory> data_block_stats_collector_factory;
+
   // If true, place whole keys in the filter (not just prefixes).
   // This must generally be true for gets to be efficient.
   bool whole_key_filtering = true;
@@ -26,6 +26,7 @@
 #include <assert.h>
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <map>
 #include <memory>
@@ -40,6 +41,7 @@
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/comparator.h"
 #include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/db/table_properties_collector.h"
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/filter_policy.h"
 #include "yb/rocksdb/flush_block_policy.h"
@@ -49,6 +51,7 @@
 #include "yb/rocksdb/table/block_based_table_factory.h"
 #include "yb/rocksdb/table/block_based_table_internal.h"
 #include "yb/rocksdb/table/block_builder.h"
+#include "yb/rocksdb/table/data_block_stats.h"
 #include "yb/rocksdb/table/filter_block.h"
 #include "yb/rocksdb/table/fixed_size_filter_block.h"
 #include "yb/rocksdb/table/format.h"
@@ -286,6 +289,12 @@ struct BlockBasedTableBuilder::Rep {
   IndexBuilder::IndexBlocks data_index_blocks;
   BlockHandle last_index_block_handle;
   std::unique_ptr<IndexBuilder> filter_index_builder;
+  // Not null when fence pointers should be written for data blocks.
+  std::unique_ptr<DataBlockFencePointersBuilder> fence_pointers_builder;
+  // Not null when stats should be collected for data blocks.
+  std::unique_ptr<DataBlockStatsCollector> data_block_stats_collector;
+  // Offsets of flushed data blocks, used only with data_block_stats_collector.
+  std::vector<uint64_t> data_block_offsets;
 
   std::string last_key;
   std::string last_filter_key;
@@ -394,6 +403,17 @@ BlockBasedTableBuilder::Rep::Rep(
   } else {
     data_writer = metadata_writer;
   }
+  // Fence pointers are built from user keys, so could be used only when user keys are ordered
+  // bytewise.
+  if (table_options.data_block_fence_pointers &&
+      table_options.index_type == IndexType::kMultiLevelBinarySearch &&
+      strcmp(internal_comparator->user_comparator()->Name(), BytewiseComparator()->Name()) == 0) {
+    fence_pointers_builder = std::make_unique<DataBlockFencePointersBuilder>();
+  }
+  if (table_options.data_block_stats_collector_factory) {
+    data_block_stats_collector =
+        table_options.data_block_stats_collector_factory->CreateDataBlockStatsCollector();
+  }
   for (auto& collector_factories : int_tbl_prop_collector_factories) {
     table_properties_collectors.emplace_back(
         collector_factories->CreateIntTblPropCollector(column_family_id));
@@ -483,6 +503,10 @@ void BlockBasedTableBuilder::Add(const Slice& key, const Slice& value) {
 
   r->last_key.assign(key.cdata(), key.size());
   r->data_block_builder.Add(key, value);
+  if (r->data_block_stats_collector) {
+    r->data_block_stats_collector->Add(
+        ExtractUserKey(key), value, GetEntryType(ExtractValueType(key)));
+  }
   r->props.num_entries++;
   r->props.raw_key_size += key.size();
   r->props.raw_value_size += value.size();
@@ -518,6 +542,10 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
 
   r->props.data_size += data_block_size;
   ++r->props.num_data_blocks;
+  if (r->data_block_stats_collector) {
+    r->data_block_stats_collector->BlockFinished();
+    r->data_block_offsets.push_back(r->data_pending_handle.offset());
+  }
   // Add item to index block.
   // We do not emit the index entry for a block until we have seen the
   // first key for the next data block.  This allows us to use shorter
@@ -529,6 +557,10 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   r->data_index_builder->AddIndexEntry(&r->last_key,
       next_block_first_key.empty() ? nullptr : &next_block_first_key,
       r->data_pending_handle);
+  if (r->fence_pointers_builder) {
+    // At this point last_key contains key of the index entry for just flushed block.
+    r->fence_pointers_builder->Add(ExtractUserKey(r->last_key), r->data_pending_handle);
+  }
   while (r->data_index_builder->ShouldFlush()) {
     auto result = r->data_index_builder->FlushNextBlock(
         &r->data_index_blocks, r->last_index_block_handle);
@@ -742,6 +774,22 @@ Status BlockBasedTableBuilder::Finish() {
     WriteBlock(item.second, &block_handle, r->metadata_writer.get());
     meta_index_builder.Add(item.first, block_handle);
   }
+  if (r->fence_pointers_builder && r->fence_pointers_builder->NumBlocks() != 0) {
+    BlockHandle block_handle;
+    WriteBlock(r->fence_pointers_builder->Finish(), &block_handle, r->metadata_writer.get());
+    meta_index_builder.Add(kDataBlockFencePointersBlock, block_handle);
+  }
+  if (r->data_block_stats_collector && !r->data_block_offsets.empty()) {
+    auto block_stats = r->data_block_stats_collector->Finish();
+    // Collector returns empty vector when it failed to collect stats.
+    if (block_stats.size() == r->data_block_offsets.size()) {
+      BlockHandle block_handle;
+      WriteBlock(
+          EncodeDataBlockStats(r->data_block_offsets, block_stats), &block_handle,
+          r->metadata_writer.get());
+      meta_index_builder.Add(kDataBlockStatsBlock, block_handle);
+    }
+  }
 
   if (ok()) {
     if (r->filter_block_builder != nullptr) {
@@ -180,6 +180,9 @@ std::string BlockBasedTableFactory::GetPrintableTableOptions() const {
   snprintf(buffer, kBufferSize, "  index_block_restart_interval: %d\n",
            table_options_.index_block_restart_interval);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  data_block_fence_pointers: %d\n",
+           table_options_.data_block_fence_pointers);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  filter_policy: %s\n",
            table_options_.filter_policy == nullptr ?
              "nullptr" : table_options_.filter_policy->Name());
@@ -222,6 +225,8 @@ const char BlockBasedTablePropertyNames::kDataBlockKeyValueEncodingFormat[] =
 const char kHashIndexPrefixesBlock[] = "rocksdb.hashindex.prefixes";
 const char kHashIndexPrefixesMetadataBlock[] =
     "rocksdb.hashindex.metadata";
+const char kDataBlockFencePointersBlock[] = "rocksdb.data.block.fence.pointers";
+const char kDataBlockStatsBlock[] = "rocksdb.data.block.stats";
 const char kPropTrue[] = "1";
 const char kPropFalse[] = "0";
 
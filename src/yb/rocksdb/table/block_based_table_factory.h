@@ -88,6 +88,8 @@ class BlockBasedTableFactory : public TableFactory {
 
 extern const char kHashIndexPrefixesBlock[];
 extern const char kHashIndexPrefixesMetadataBlock[];
+extern const char kDataBlockFencePointersBlock[];
+extern const char kDataBlockStatsBlock[];
 extern const char kPropTrue[];
 extern const char kPropFalse[];
 
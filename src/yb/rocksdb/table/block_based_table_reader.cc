@@ -23,6 +23,7 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -43,6 +44,7 @@
 #include "yb/rocksdb/table/block_based_table_internal.h"
 #include "yb/rocksdb/table/block_hash_index.h"
 #include "yb/rocksdb/table/block_prefix_index.h"
+#include "yb/rocksdb/table/data_block_stats.h"
 #include "yb/rocksdb/table/filter_block.h"
 #include "yb/rocksdb/table/fixed_size_filter_block.h"
 #include "yb/rocksdb/table/format.h"
@@ -228,6 +230,9 @@ struct BlockBasedTable::Rep {
   // types.
   BlockHandle filter_handle;
 
+  // Not null when SST file contains stats of data blocks.
+  std::unique_ptr<DataBlockStats> data_block_stats;
+
   std::shared_ptr<const TableProperties> table_properties;
   IndexType index_type = IndexType::kBinarySearch;
   bool hash_index_allow_collision = false;
@@ -260,6 +265,12 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
         block_type_(block_type) {}
 
   InternalIterator* NewSecondaryIterator(const Slice& index_value) override {
+    if (block_type_ == BlockType::kData && read_options_.table_stats_filter_data_blocks &&
+        read_options_.table_stats_file_filter &&
+        !table_->DataBlockMayMatch(*read_options_.table_stats_file_filter, index_value)) {
+      // Two level iterator moves to the next data block when this one is empty.
+      return NewEmptyInternalIterator();
+    }
     return table_->NewDataBlockIterator(read_options_, index_value, block_type_);
   }
 
@@ -436,6 +447,8 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
 
   RETURN_NOT_OK(new_table->SetupFilter(meta_iter.get()));
 
+  new_table->LoadDataBlockStats(meta_iter.get());
+
   if (data_index_load_mode == DataIndexLoadMode::PRELOAD_ON_OPEN) {
     // Will use block cache for data index access?
     if (table_options.cache_index_and_filter_blocks) {
@@ -698,6 +711,9 @@ size_t BlockBasedTable::ApproximateMemoryUsage() const {
   if (data_index_reader) {
     usage += data_index_reader->ApproximateMemoryUsage();
   }
+  if (rep_->data_block_stats) {
+    usage += rep_->data_block_stats->ApproximateMemoryUsage();
+  }
   return usage;
 }
 
@@ -976,6 +992,14 @@ Slice BlockBasedTable::GetFilterKeyFromUserKey(const Slice &user_key) const {
       rep_->filter_key_transformer->Transform(user_key) : user_key;
 }
 
+QueryId BlockBasedTable::IndexAndFilterQueryId(QueryId query_id) const {
+  if (rep_->table_options.cache_index_and_filter_blocks_with_high_priority &&
+      query_id != kNoCacheQueryId) {
+    return kInMultiTouchId;
+  }
+  return query_id;
+}
+
 BlockBasedTable::CachableEntry<FilterBlockReader> BlockBasedTable::GetFilter(
     const QueryId query_id,
     bool no_io,
@@ -1038,8 +1062,9 @@ BlockBasedTable::CachableEntry<FilterBlockReader> BlockBasedTable::GetFilter(
       *filter_block_handle, cache_key_buffer);
 
   Statistics* statistics = rep_->ioptions.statistics;
+  const auto cache_query_id = IndexAndFilterQueryId(query_id);
   auto cache_handle = GetEntryFromCache(block_cache, filter_block_cache_key,
-      BLOCK_CACHE_FILTER_MISS, BLOCK_CACHE_FILTER_HIT, statistics, query_id);
+      BLOCK_CACHE_FILTER_MISS, BLOCK_CACHE_FILTER_HIT, statistics, cache_query_id);
 
   FilterBlockReader* filter = nullptr;
   if (cache_handle != nullptr) {
@@ -1054,7 +1079,7 @@ BlockBasedTable::CachableEntry<FilterBlockReader> BlockBasedTable::GetFilter(
     filter = ReadFilterBlock(*filter_block_handle, rep_, &filter_size);
     if (filter != nullptr) {
       assert(filter_size > 0);
-      Status s = block_cache->Insert(filter_block_cache_key, query_id,
+      Status s = block_cache->Insert(filter_block_cache_key, cache_query_id,
                                      filter, filter_size,
                                      &DeleteCachedEntry<FilterBlockReader>, &cache_handle,
                                      statistics);
@@ -1103,9 +1128,10 @@ yb::Result<BlockBasedTable::CachableEntry<IndexReader>> BlockBasedTable::GetInde
     auto key = GetCacheKey(rep_->base_reader_with_cache_prefix->cache_key_prefix,
         rep_->footer.index_handle(), cache_key);
     Statistics* statistics = rep_->ioptions.statistics;
+    const auto cache_query_id = IndexAndFilterQueryId(read_options.query_id);
     auto cache_handle =
         GetEntryFromCache(block_cache, key, BLOCK_CACHE_INDEX_MISS,
-            BLOCK_CACHE_INDEX_HIT, statistics, read_options.query_id);
+            BLOCK_CACHE_INDEX_HIT, statistics, cache_query_id);
 
     if (cache_handle == nullptr && no_io) {
       return ReturnNoIOError();
@@ -1118,7 +1144,7 @@ yb::Result<BlockBasedTable::CachableEntry<IndexReader>> BlockBasedTable::GetInde
       std::unique_ptr<IndexReader> index_reader_unique;
       RETURN_NOT_OK(CreateDataBlockIndexReader(&index_reader_unique));
       RETURN_NOT_OK(block_cache->Insert(
-          key, read_options.query_id, index_reader_unique.get(), index_reader_unique->usable_size(),
+          key, cache_query_id, index_reader_unique.get(), index_reader_unique->usable_size(),
           &DeleteCachedEntry<IndexReader>, &cache_handle, statistics));
       assert(cache_handle);
       index_reader = index_reader_unique.release();
@@ -1147,6 +1173,86 @@ yb::Result<BlockBasedTable::CachableEntry<IndexReader>> BlockBasedTable::GetInde
   }
 }
 
+void BlockBasedTable::LoadDataBlockFencePointers(
+    MultiLevelIndexReader* index_reader, InternalIterator* preloaded_meta_index_iter) {
+  std::unique_ptr<Block> meta_guard;
+  std::unique_ptr<InternalIterator> meta_iter_guard;
+  auto meta_index_iter = preloaded_meta_index_iter;
+  if (meta_index_iter == nullptr) {
+    auto s = ReadMetaBlock(rep_, &meta_guard, &meta_iter_guard);
+    if (!s.ok()) {
+      RLOG(InfoLogLevel::WARN_LEVEL, rep_->ioptions.info_log,
+          "Unable to read the metaindex block to load fence pointers: %s", s.ToString().c_str());
+      return;
+    }
+    meta_index_iter = meta_iter_guard.get();
+  }
+
+  BlockHandle fence_pointers_handle;
+  if (!FindMetaBlock(meta_index_iter, kDataBlockFencePointersBlock, &fence_pointers_handle).ok()) {
+    // SST file was written without fence pointers.
+    return;
+  }
+
+  BlockContents contents;
+  auto s = ReadBlockContents(
+      rep_->base_reader_with_cache_prefix->reader.get(), rep_->footer, ReadOptions::kDefault,
+      fence_pointers_handle, &contents, rep_->ioptions.env, rep_->mem_tracker,
+      true /* do decompression */);
+  if (!s.ok()) {
+    RLOG(InfoLogLevel::WARN_LEVEL, rep_->ioptions.info_log,
+        "Failed to read data block fence pointers: %s", s.ToString().c_str());
+    return;
+  }
+  auto fence_pointers = DataBlockFencePointers::Decode(contents.data);
+  if (!fence_pointers.ok()) {
+    RLOG(InfoLogLevel::WARN_LEVEL, rep_->ioptions.info_log,
+        "Failed to decode data block fence pointers: %s",
+        fence_pointers.status().ToString().c_str());
+    return;
+  }
+  index_reader->SetFencePointers(std::move(*fence_pointers));
+}
+
+void BlockBasedTable::LoadDataBlockStats(InternalIterator* meta_index_iter) {
+  BlockHandle stats_handle;
+  if (!FindMetaBlock(meta_index_iter, kDataBlockStatsBlock, &stats_handle).ok()) {
+    // SST file was written without data block stats.
+    return;
+  }
+
+  BlockContents contents;
+  auto s = ReadBlockContents(
+      rep_->base_reader_with_cache_prefix->reader.get(), rep_->footer, ReadOptions::kDefault,
+      stats_handle, &contents, rep_->ioptions.env, rep_->mem_tracker,
+      true /* do decompression */);
+  if (!s.ok()) {
+    RLOG(InfoLogLevel::WARN_LEVEL, rep_->ioptions.info_log,
+        "Failed to read data block stats: %s", s.ToString().c_str());
+    return;
+  }
+  auto stats = DataBlockStats::Decode(contents.data);
+  if (!stats.ok()) {
+    RLOG(InfoLogLevel::WARN_LEVEL, rep_->ioptions.info_log,
+        "Failed to decode data block stats: %s", stats.status().ToString().c_str());
+    return;
+  }
+  rep_->data_block_stats = std::move(*stats);
+}
+
+bool BlockBasedTable::DataBlockMayMatch(
+    const TableStatsReadFileFilter& filter, Slice index_value) const {
+  if (!rep_->data_block_stats) {
+    return true;
+  }
+  BlockHandle handle;
+  if (!handle.DecodeFrom(&index_value).ok()) {
+    return true;
+  }
+  auto block_stats = rep_->data_block_stats->Find(handle.offset());
+  return block_stats.empty() || filter.FilterDataBlock(block_stats);
+}
+
 InternalIterator* BlockBasedTable::NewIndexIterator(
     const ReadOptions& read_options, BlockIter* input_iter) {
   const auto index_reader_result = GetIndexReader(read_options);
@@ -1201,8 +1307,17 @@ yb::Result<BlockBasedTable::CachableEntry<Block>> BlockBasedTable::RetrieveBlock
       ckey = GetCacheKey(reader->compressed_cache_key_prefix, handle, compressed_cache_key);
     }
 
+    // Blocks of multi-level index are cached with the same priority as its top level.
+    std::optional<ReadOptions> index_read_options;
+    if (block_type == BlockType::kIndex &&
+        rep_->table_options.cache_index_and_filter_blocks_with_high_priority) {
+      index_read_options.emplace(ro);
+      index_read_options->query_id = IndexAndFilterQueryId(ro.query_id);
+    }
+    const ReadOptions& cache_read_options = index_read_options ? *index_read_options : ro;
+
     Status status = GetDataBlockFromCache(
-        key, ckey, block_cache, block_cache_compressed, statistics, ro, &block,
+        key, ckey, block_cache, block_cache_compressed, statistics, cache_read_options, &block,
         rep_->table_options.format_version, block_type, rep_->mem_tracker);
 
     if (block.value == nullptr && !no_io && ro.fill_cache) {
@@ -1215,7 +1330,7 @@ yb::Result<BlockBasedTable::CachableEntry<Block>> BlockBasedTable::RetrieveBlock
       }
 
       RETURN_NOT_OK(PutDataBlockToCache(key, ckey, block_cache, block_cache_compressed,
-                                        ro, statistics, &block, raw_block.release(),
+                                        cache_read_options, statistics, &block, raw_block.release(),
                                         rep_->table_options.format_version, rep_->mem_tracker));
       status = Status::OK();
     }
@@ -1647,6 +1762,10 @@ Status BlockBasedTable::CreateDataBlockIndexReader(
       auto result = MultiLevelIndexReader::Create(
           file, footer, num_levels, footer.index_handle(), env, comparator, rep_->mem_tracker);
       RETURN_NOT_OK(result);
+      // With single level index, top level index block already points to data blocks.
+      if (num_levels > 1) {
+        LoadDataBlockFencePointers(result->get(), preloaded_meta_index_iter);
+      }
       *index_reader = std::move(*result);
       return Status::OK();
     }
@@ -1959,6 +2078,27 @@ yb::Result<std::string> BlockBasedTable::GetMiddleKey() {
       rep_->comparator.get(), MiddlePointPolicy::kMiddleHigh);
 }
 
+yb::Result<std::vector<std::string>> BlockBasedTable::GetSampleKeys(size_t max_keys) {
+  std::vector<std::string> result;
+  const auto num_data_blocks =
+      rep_->table_properties ? rep_->table_properties->num_data_blocks : 0;
+  if (max_keys == 0 || num_data_blocks <= 1) {
+    return result;
+  }
+  // Each of max_keys + 1 parts contains at least one data block.
+  const auto step = std::max<uint64_t>(num_data_blocks / (max_keys + 1), 1);
+  std::unique_ptr<InternalIterator> index_iter(NewIndexIterator(ReadOptions::kDefault));
+  uint64_t block_idx = 0;
+  for (index_iter->SeekToFirst(); index_iter->Valid() && result.size() < max_keys;
+       index_iter->Next()) {
+    if (++block_idx % step == 0) {
+      result.push_back(index_iter->key().ToBuffer());
+    }
+  }
+  RETURN_NOT_OK_PREPEND(index_iter->status(), "Failed to iterate index");
+  return result;
+}
+
 yb::Result<IndexReaderCleanablePtr> BlockBasedTable::TEST_GetIndexReader() {
   auto index_reader = VERIFY_RESULT(GetIndexReader(ReadOptions::kDefault));
   auto cache = rep_->table_options.block_cache;
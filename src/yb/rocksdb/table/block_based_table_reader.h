@@ -58,6 +58,8 @@ struct ReadOptions;
 class GetContext;
 class InternalIterator;
 class IndexReader;
+class MultiLevelIndexReader;
+class TableStatsReadFileFilter;
 
 // Index reader special unique pointer to control the instance's way of deletion. Can be removed
 // when https://github.com/yugabyte/yugabyte-db/issues/4720 is resolved.
@@ -203,6 +205,9 @@ class BlockBasedTable : public TableReader {
 
   yb::Result<std::string> GetMiddleKey() override;
 
+  // Samples are taken from the data index.
+  yb::Result<std::vector<std::string>> GetSampleKeys(size_t max_keys) override;
+
   // Helper function that force reading block from a file and takes care about block cleanup.
   yb::Result<std::unique_ptr<Block>> RetrieveBlockFromFile(const ReadOptions& ro,
       const Slice& index_value, BlockType block_type);
@@ -244,6 +249,9 @@ class BlockBasedTable : public TableReader {
   // to get the correct filter block.
   // Note: even if we check prefix match we still need to get filter based on filter_key, not its
   // prefix, because prefix for the key goes to the same filter block as key itself.
+  // Returns query id to look up and insert index and filter blocks to the block cache with.
+  QueryId IndexAndFilterQueryId(QueryId query_id) const;
+
   CachableEntry<FilterBlockReader> GetFilter(const QueryId query_id,
                                              bool no_io = false,
                                              const Slice* filter_key = nullptr) const;
@@ -297,6 +305,19 @@ class BlockBasedTable : public TableReader {
       std::unique_ptr<IndexReader>* index_reader,
       InternalIterator* preloaded_meta_index_iter = nullptr);
 
+  // Loads data block fence pointers, if they are present in SST file, to the index reader.
+  // Fence pointers are optional, so errors are just logged.
+  void LoadDataBlockFencePointers(
+      MultiLevelIndexReader* index_reader, InternalIterator* preloaded_meta_index_iter);
+
+  // Loads stats of data blocks, if they are present in SST file. Stats are optional, so errors are
+  // just logged.
+  void LoadDataBlockStats(InternalIterator* meta_index_iter);
+
+  // Returns false when filter shows that data block with specified index value has no matching
+  // entries.
+  bool DataBlockMayMatch(const TableStatsReadFileFilter& filter, Slice index_value) const;
+
   bool NonBlockBasedFilterKeyMayMatch(FilterBlockReader* filter, const Slice& filter_key) const;
 
   Status ReadPropertiesBlock(InternalIterator* meta_iter);
@@ -0,0 +1,81 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/table/data_block_stats.h"
+
+#include <algorithm>
+
+#include "yb/rocksdb/util/coding.h"
+
+#include "yb/util/logging.h"
+#include "yb/util/status_format.h"
+
+namespace rocksdb {
+
+std::string EncodeDataBlockStats(
+    const std::vector<uint64_t>& block_offsets, const std::vector<std::string>& block_stats) {
+  DCHECK_EQ(block_offsets.size(), block_stats.size());
+  std::string result;
+  PutVarint64(&result, block_offsets.size());
+  for (size_t i = 0; i != block_offsets.size(); ++i) {
+    PutVarint64(&result, block_offsets[i]);
+    PutLengthPrefixedSlice(&result, block_stats[i]);
+  }
+  return result;
+}
+
+Result<std::unique_ptr<DataBlockStats>> DataBlockStats::Decode(Slice data) {
+  auto result = std::make_unique<DataBlockStats>();
+  data.CopyToBuffer(&result->data_);
+  Slice input = result->data_;
+  uint64_t num_blocks;
+  if (!GetVarint64(&input, &num_blocks)) {
+    return STATUS(Corruption, "Bad data block stats header");
+  }
+  result->offsets_.reserve(num_blocks);
+  result->stats_.reserve(num_blocks);
+  for (uint64_t i = 0; i != num_blocks; ++i) {
+    uint64_t offset;
+    Slice stats;
+    if (!GetVarint64(&input, &offset) || !GetLengthPrefixedSlice(&input, &stats)) {
+      return STATUS_FORMAT(Corruption, "Bad stats of data block $0", i);
+    }
+    if (!result->offsets_.empty() && offset <= result->offsets_.back()) {
+      return STATUS_FORMAT(
+          Corruption, "Data block offsets are not increasing: $0 after $1", offset,
+          result->offsets_.back());
+    }
+    result->offsets_.push_back(offset);
+    result->stats_.push_back(stats);
+  }
+  if (!input.empty()) {
+    return STATUS_FORMAT(
+        Corruption, "Unexpected $0 bytes after data block stats", input.size());
+  }
+  return result;
+}
+
+Slice DataBlockStats::Find(uint64_t block_offset) const {
+  auto it = std::lower_bound(offsets_.begin(), offsets_.end(), block_offset);
+  if (it == offsets_.end() || *it != block_offset) {
+    return Slice();
+  }
+  return stats_[it - offsets_.begin()];
+}
+
+size_t DataBlockStats::ApproximateMemoryUsage() const {
+  return sizeof(*this) + data_.capacity() + offsets_.capacity() * sizeof(uint64_t) +
+         stats_.capacity() * sizeof(Slice);
+}
+
+} // namespace rocksdb
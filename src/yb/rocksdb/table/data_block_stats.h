@@ -0,0 +1,58 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "yb/rocksdb/status.h"
+
+#include "yb/util/result.h"
+#include "yb/util/slice.h"
+
+namespace rocksdb {
+
+using yb::Result;
+
+// Encodes stats of data blocks, produced by DataBlockStatsCollector, to the meta block.
+// Stats are stored with offsets of their data blocks, that are used to find them by block handle.
+std::string EncodeDataBlockStats(
+    const std::vector<uint64_t>& block_offsets, const std::vector<std::string>& block_stats);
+
+// Stats of data blocks of SST file, pinned in memory.
+class DataBlockStats {
+ public:
+  static Result<std::unique_ptr<DataBlockStats>> Decode(Slice data);
+
+  // Returns stats of data block with specified offset, or empty slice when there are no stats for
+  // this block.
+  Slice Find(uint64_t block_offset) const;
+
+  size_t NumBlocks() const {
+    return offsets_.size();
+  }
+
+  size_t ApproximateMemoryUsage() const;
+
+ private:
+  std::string data_;
+  std::vector<uint64_t> offsets_;
+  // Stats of the block with corresponding offset, pointing into data_.
+  std::vector<Slice> stats_;
+};
+
+} // namespace rocksdb
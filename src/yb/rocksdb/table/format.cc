@@ -379,8 +379,12 @@ Status ReadBlock(
               file->file()->filename(), handle.ToDebugString(), expected_read_size);
         }
 
-        if (options.verify_checksums) {
-          return VerifyBlockChecksum(file, footer, handle, read_result.cdata(), handle.size());
+        // Contents of memory mapped file are not copied on read, so the block that passed
+        // verification once does not need to be verified again.
+        if (options.verify_checksums && !file->IsBlockVerified(handle.offset())) {
+          RETURN_NOT_OK(
+              VerifyBlockChecksum(file, footer, handle, read_result.cdata(), handle.size()));
+          file->SetBlockVerified(handle.offset());
         }
         return Status::OK();
       };
@@ -454,10 +458,11 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
   char* used_buf = nullptr;
   rocksdb::CompressionType compression_type;
 
-  if (decompression_requested &&
-      n + kBlockTrailerSize < DefaultStackBufferSize) {
+  if (file->file()->IsMemoryMapped() ||
+      (decompression_requested && n + kBlockTrailerSize < DefaultStackBufferSize)) {
     // If we've got a small enough hunk of data, read it in to the
-    // trivially allocated stack buffer instead of needing a full malloc()
+    // trivially allocated stack buffer instead of needing a full malloc().
+    // Memory mapped file does not use the buffer at all, so there is no need to allocate it.
     used_buf = &stack_buf[0];
   } else {
     heap_buf = std::unique_ptr<char[]>(new char[n + kBlockTrailerSize]);
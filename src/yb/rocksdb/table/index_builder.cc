@@ -138,6 +138,55 @@ void HashIndexBuilder::FlushPendingPrefix() {
   PutVarint32(&prefix_meta_block_, pending_block_num_);
 }
 
+void DataBlockFencePointersBuilder::Add(const Slice& user_key, const BlockHandle& block_handle) {
+  if (entries_.empty()) {
+    user_key.CopyToBuffer(&first_key_);
+  }
+  Entry entry = {
+    .shared_prefix_size = user_key.difference_offset(first_key_),
+    .bytes = {0},
+    .block_handle = block_handle,
+  };
+  auto tail = user_key.WithoutPrefix(entry.shared_prefix_size);
+  memcpy(entry.bytes, tail.data(), std::min(tail.size(), kFingerprintSize));
+  entries_.push_back(entry);
+}
+
+Slice DataBlockFencePointersBuilder::Finish() {
+  // Keys are added in sorted order, so size of prefix shared with the first key is non-increasing.
+  // Index key of the last block is usually replaced with short successor, that does not share
+  // prefix with other keys, so it is not taken into account.
+  size_t prefix_size = 0;
+  if (entries_.size() > 1) {
+    prefix_size = entries_[entries_.size() - 2].shared_prefix_size;
+  } else if (!entries_.empty()) {
+    prefix_size = entries_.back().shared_prefix_size;
+  }
+  buffer_.clear();
+  PutLengthPrefixedSlice(&buffer_, Slice(first_key_.data(), prefix_size));
+  PutVarint64(&buffer_, entries_.size());
+  char fingerprint[kFingerprintSize];
+  for (const auto& entry : entries_) {
+    if (entry.shared_prefix_size < prefix_size) {
+      // Could happen only for the last key, that is greater than any key with the prefix, so use
+      // max fingerprint for it.
+      memset(fingerprint, 0xff, kFingerprintSize);
+    } else {
+      // Bytes of the key after common prefix are the bytes of the first key till the end of prefix
+      // shared with the first key, followed by remembered bytes.
+      const auto from_first_key = std::min(
+          entry.shared_prefix_size - prefix_size, kFingerprintSize);
+      memcpy(fingerprint, first_key_.data() + prefix_size, from_first_key);
+      memcpy(fingerprint + from_first_key, entry.bytes, kFingerprintSize - from_first_key);
+    }
+    buffer_.append(fingerprint, kFingerprintSize);
+  }
+  for (const auto& entry : entries_) {
+    entry.block_handle.AppendEncodedTo(&buffer_);
+  }
+  return buffer_;
+}
+
 MultiLevelIndexBuilder::MultiLevelIndexBuilder(
     const Comparator* comparator, const BlockBasedTableOptions& table_opt)
     : IndexBuilder(comparator),
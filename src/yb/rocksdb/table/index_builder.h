@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "yb/rocksdb/flush_block_policy.h"
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table/block_builder.h"
@@ -219,6 +221,36 @@ class HashIndexBuilder : public IndexBuilder {
   uint64_t current_restart_index_ = 0;
 };
 
+// Builds fence pointers for data blocks of SST file, see DataBlockFencePointers.
+// For each data block stores fingerprint of the user key from its index entry and block handle.
+// Fingerprint is first kFingerprintSize bytes of the user key after prefix shared by index keys
+// of SST file (except the last one). Since this prefix is only known once all keys are added, for
+// each key we remember size of prefix it shares with the first key and bytes that follow this
+// prefix, and build fingerprints in Finish.
+class DataBlockFencePointersBuilder {
+ public:
+  static constexpr size_t kFingerprintSize = sizeof(uint64_t);
+
+  // Should be called for data blocks in order, with user key of the block index entry.
+  void Add(const Slice& user_key, const BlockHandle& block_handle);
+
+  // Returns encoded fence pointers, that remains valid while builder is alive.
+  Slice Finish();
+
+  size_t NumBlocks() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    size_t shared_prefix_size;
+    char bytes[kFingerprintSize];
+    BlockHandle block_handle;
+  };
+
+  std::string first_key_;
+  std::vector<Entry> entries_;
+  std::string buffer_;
+};
+
 class MultiLevelIndexBuilder : public IndexBuilder {
  public:
   MultiLevelIndexBuilder(const Comparator* comparator, const BlockBasedTableOptions& table_opt);
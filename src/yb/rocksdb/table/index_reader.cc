@@ -13,10 +13,18 @@
 
 #include "yb/rocksdb/table/index_reader.h"
 
+#include <algorithm>
+
+#include "yb/gutil/endian.h"
+
+#include "yb/rocksdb/db/dbformat.h"
 #include "yb/rocksdb/table/block_based_table_factory.h"
 #include "yb/rocksdb/table/block_based_table_internal.h"
 #include "yb/rocksdb/table/iterator_wrapper.h"
+#include "yb/rocksdb/table/index_builder.h"
 #include "yb/rocksdb/table/meta_blocks.h"
+#include "yb/rocksdb/util/coding.h"
+
 #include "yb/util/slice.h"
 
 namespace rocksdb {
@@ -287,6 +295,147 @@ class MultiLevelIterator : public InternalIterator {
   IteratorWrapper* bottommost_positioned_iter_ = nullptr;
 };
 
+namespace {
+
+// Index iterator that uses fence pointers to find data block on seek. Since fence pointers don't
+// contain index keys, key() and moving to adjacent entries require the underlying multi-level
+// index iterator to be positioned, so it is lazily seeked to the same target.
+class FencePointersIndexIterator : public InternalIterator {
+ public:
+  FencePointersIndexIterator(
+      const DataBlockFencePointers& fence_pointers, InternalIterator* index_iter)
+      : fence_pointers_(fence_pointers), index_iter_(index_iter) {}
+
+  void Seek(const Slice& target) override {
+    auto block_idx = fence_pointers_.Find(target);
+    if (block_idx == DataBlockFencePointers::kUnknownBlock) {
+      positioned_by_fence_pointers_ = false;
+      index_iter_->Seek(target);
+      return;
+    }
+    positioned_by_fence_pointers_ = true;
+    block_idx_ = block_idx;
+    target.CopyToBuffer(&target_);
+    if (block_idx_ < fence_pointers_.NumBlocks()) {
+      block_handle_encoded_.clear();
+      fence_pointers_.block_handle(block_idx_).AppendEncodedTo(&block_handle_encoded_);
+    }
+  }
+
+  void SeekToFirst() override {
+    positioned_by_fence_pointers_ = false;
+    index_iter_->SeekToFirst();
+  }
+
+  void SeekToLast() override {
+    positioned_by_fence_pointers_ = false;
+    index_iter_->SeekToLast();
+  }
+
+  void Next() override {
+    PositionIndexIterator();
+    index_iter_->Next();
+  }
+
+  void Prev() override {
+    PositionIndexIterator();
+    index_iter_->Prev();
+  }
+
+  bool Valid() const override {
+    return positioned_by_fence_pointers_ ? block_idx_ < fence_pointers_.NumBlocks()
+                                         : index_iter_->Valid();
+  }
+
+  Slice key() const override {
+    PositionIndexIterator();
+    return index_iter_->key();
+  }
+
+  Slice value() const override {
+    DCHECK(Valid());
+    return positioned_by_fence_pointers_ ? Slice(block_handle_encoded_) : index_iter_->value();
+  }
+
+  Status status() const override {
+    return positioned_by_fence_pointers_ ? Status::OK() : index_iter_->status();
+  }
+
+ private:
+  void PositionIndexIterator() const {
+    if (positioned_by_fence_pointers_) {
+      index_iter_->Seek(target_);
+      positioned_by_fence_pointers_ = false;
+    }
+  }
+
+  const DataBlockFencePointers& fence_pointers_;
+  std::unique_ptr<InternalIterator> index_iter_;
+  mutable bool positioned_by_fence_pointers_ = false;
+  size_t block_idx_ = 0;
+  std::string target_;
+  std::string block_handle_encoded_;
+};
+
+uint64_t KeyFingerprint(Slice key_without_prefix) {
+  char buffer[DataBlockFencePointersBuilder::kFingerprintSize] = {0};
+  memcpy(buffer, key_without_prefix.data(), std::min(key_without_prefix.size(), sizeof(buffer)));
+  return BigEndian::Load64(buffer);
+}
+
+} // namespace
+
+Result<std::unique_ptr<DataBlockFencePointers>> DataBlockFencePointers::Decode(Slice data) {
+  auto result = std::make_unique<DataBlockFencePointers>();
+  Slice prefix;
+  uint64_t num_blocks;
+  if (!GetLengthPrefixedSlice(&data, &prefix) || !GetVarint64(&data, &num_blocks) ||
+      data.size() < num_blocks * DataBlockFencePointersBuilder::kFingerprintSize) {
+    return STATUS(Corruption, "Bad data block fence pointers header");
+  }
+  prefix.CopyToBuffer(&result->prefix_);
+  result->fingerprints_.reserve(num_blocks);
+  for (uint64_t i = 0; i != num_blocks; ++i) {
+    result->fingerprints_.push_back(BigEndian::Load64(data.data()));
+    data.remove_prefix(DataBlockFencePointersBuilder::kFingerprintSize);
+  }
+  result->block_handles_.resize(num_blocks);
+  for (auto& block_handle : result->block_handles_) {
+    RETURN_NOT_OK(block_handle.DecodeFrom(&data));
+  }
+  if (!data.empty()) {
+    return STATUS_FORMAT(
+        Corruption, "Unexpected $0 bytes after data block fence pointers", data.size());
+  }
+  return result;
+}
+
+size_t DataBlockFencePointers::Find(Slice internal_key) const {
+  if (internal_key.size() < kLastInternalComponentSize) {
+    return kUnknownBlock;
+  }
+  auto user_key = ExtractUserKey(internal_key);
+  if (!user_key.starts_with(prefix_)) {
+    // All index keys, except the last one, start with prefix_. So if key is less than prefix_, then
+    // it is less than all index keys. Otherwise it is greater than all index keys except,
+    // possibly, the last one.
+    return user_key.compare(prefix_) < 0 ? 0 : kUnknownBlock;
+  }
+  auto fingerprint = KeyFingerprint(user_key.WithoutPrefix(prefix_.size()));
+  auto it = std::lower_bound(fingerprints_.begin(), fingerprints_.end(), fingerprint);
+  // Index keys with greater fingerprint are greater than the key, but index keys with the same
+  // fingerprint could be both less and greater than it.
+  if (it != fingerprints_.end() && *it == fingerprint) {
+    return kUnknownBlock;
+  }
+  return it - fingerprints_.begin();
+}
+
+size_t DataBlockFencePointers::ApproximateMemoryUsage() const {
+  return sizeof(*this) + prefix_.capacity() + fingerprints_.capacity() * sizeof(uint64_t) +
+         block_handles_.capacity() * sizeof(BlockHandle);
+}
+
 Result<std::unique_ptr<MultiLevelIndexReader>> MultiLevelIndexReader::Create(
     RandomAccessFileReader* file, const Footer& footer, const uint32_t num_levels,
     const BlockHandle& top_level_index_handle, Env* env, const ComparatorPtr& comparator,
@@ -303,8 +452,12 @@ InternalIterator* MultiLevelIndexReader::NewIterator(
     BlockIter* iter, TwoLevelIteratorState* index_iterator_state, bool) {
   InternalIterator* top_level_iter = top_level_index_block_->NewIndexIterator(
       comparator_.get(), iter, /* total_order_seek = */ true);
-  return new MultiLevelIterator(
+  auto* result = new MultiLevelIterator(
       index_iterator_state, top_level_iter, num_levels_, top_level_iter != iter);
+  if (fence_pointers_) {
+    return new FencePointersIndexIterator(*fence_pointers_, result);
+  }
+  return result;
 }
 
 Result<std::string> MultiLevelIndexReader::GetMiddleKey() const {
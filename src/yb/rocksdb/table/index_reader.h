@@ -15,8 +15,12 @@
 
 #include <stddef.h>
 
+#include <limits>
+#include <vector>
+
 #include "yb/rocksdb/status.h"
 #include "yb/rocksdb/table/block.h"
+#include "yb/rocksdb/table/format.h"
 #include "yb/rocksdb/table/two_level_iterator.h"
 
 #include "yb/util/logging.h"
@@ -175,6 +179,40 @@ class HashIndexReader : public IndexReader {
   BlockContents prefixes_contents_;
 };
 
+// Fence pointers for data blocks of SST file, pinned in memory. See DataBlockFencePointersBuilder
+// for details.
+// Fingerprint of the key is monotonic, so data block for seek could be found by binary search over
+// array of integers, without reading index blocks. It is not possible when fingerprint of the
+// target key is equal to fingerprint of the found index key. In this case regular index should be
+// used.
+class DataBlockFencePointers {
+ public:
+  static constexpr size_t kUnknownBlock = std::numeric_limits<size_t>::max();
+
+  static Result<std::unique_ptr<DataBlockFencePointers>> Decode(Slice data);
+
+  // Returns index of the first data block with index key that is not less than internal_key,
+  // i.e. the block that index iterator would point to after seeking to internal_key.
+  // Returns NumBlocks() if there is no such block and kUnknownBlock if it could not be determined
+  // using fingerprints.
+  size_t Find(Slice internal_key) const;
+
+  const BlockHandle& block_handle(size_t idx) const {
+    return block_handles_[idx];
+  }
+
+  size_t NumBlocks() const {
+    return fingerprints_.size();
+  }
+
+  size_t ApproximateMemoryUsage() const;
+
+ private:
+  std::string prefix_;
+  std::vector<uint64_t> fingerprints_;
+  std::vector<BlockHandle> block_handles_;
+};
+
 // Index that allows binary search lookup in a multi-level index structure.
 class MultiLevelIndexReader : public IndexReader {
  public:
@@ -200,6 +238,12 @@ class MultiLevelIndexReader : public IndexReader {
 
   Result<std::string> GetMiddleKey() const override;
 
+  // When fence pointers are set, index iterator uses them to find data block, falling back to
+  // multi-level index lookup when they are not enough.
+  void SetFencePointers(std::unique_ptr<DataBlockFencePointers> fence_pointers) {
+    fence_pointers_ = std::move(fence_pointers);
+  }
+
   uint32_t TEST_GetNumLevels() const {
     return num_levels_;
   }
@@ -216,11 +260,13 @@ class MultiLevelIndexReader : public IndexReader {
   }
 
   size_t ApproximateMemoryUsage() const override {
-    return top_level_index_block_->ApproximateMemoryUsage();
+    return top_level_index_block_->ApproximateMemoryUsage() +
+           (fence_pointers_ ? fence_pointers_->ApproximateMemoryUsage() : 0);
   }
 
   const uint32_t num_levels_;
   const std::unique_ptr<Block> top_level_index_block_;
+  std::unique_ptr<DataBlockFencePointers> fence_pointers_;
 };
 
 } // namespace rocksdb
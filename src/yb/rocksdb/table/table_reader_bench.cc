@@ -26,6 +26,8 @@ int main() {
 }
 #else
 
+#include <cinttypes>
+
 #include "yb/util/flags.h"
 
 #include "yb/rocksdb/db.h"
@@ -157,6 +159,14 @@ void TableReaderBenchmark(const Options& opts, const EnvOptions& env_options,
       fprintf(stderr, "Open Table Error: %s\n", s.ToString().c_str());
       exit(1);
     }
+    // Make sure index is loaded, so its memory usage is reported.
+    delete table_reader->NewIterator(read_options);
+    auto props = table_reader->GetTableProperties();
+    fprintf(stderr,
+            "Table: file size: %" PRIu64 ", data blocks: %" PRIu64 ", index size: %" PRIu64
+            ", table reader memory usage: %zu\n",
+            file_size, props->num_data_blocks, props->data_index_size,
+            table_reader->ApproximateMemoryUsage());
   }
 
   Random rnd(301);
@@ -277,6 +287,12 @@ DEFINE_bool(through_db, false, "If enable, a DB instance will be created and "
 DEFINE_bool(mmap_read, true, "Whether use mmap read");
 DEFINE_string(table_factory, "block_based",
               "Table factory to use: `block_based` (default) or `plain_table`.");
+DEFINE_string(index_type, "multi_level",
+              "Index type for block based table: `binary_search` or `multi_level` (default).");
+DEFINE_bool(data_block_fence_pointers, false,
+            "Write data block fence pointers for block based table with multi level index.");
+DEFINE_int64(block_size, 4096, "Data block size for block based table.");
+DEFINE_int64(index_block_size, 4096, "Index block size for block based table.");
 DEFINE_string(time_unit, "microsecond",
               "The time unit used for measuring performance. User can specify "
               "`microsecond` (default) or `nanosecond`");
@@ -310,7 +326,19 @@ int main(int argc, char** argv) {
     options.prefix_extractor.reset(rocksdb::NewFixedPrefixTransform(
         FLAGS_prefix_len));
   } else if (FLAGS_table_factory == "block_based") {
-    tf.reset(new rocksdb::BlockBasedTableFactory());
+    rocksdb::BlockBasedTableOptions table_options;
+    if (FLAGS_index_type == "binary_search") {
+      table_options.index_type = rocksdb::IndexType::kBinarySearch;
+    } else if (FLAGS_index_type == "multi_level") {
+      table_options.index_type = rocksdb::IndexType::kMultiLevelBinarySearch;
+    } else {
+      fprintf(stderr, "Invalid index type %s\n", FLAGS_index_type.c_str());
+      return 1;
+    }
+    table_options.data_block_fence_pointers = FLAGS_data_block_fence_pointers;
+    table_options.block_size = FLAGS_block_size;
+    table_options.index_block_size = FLAGS_index_block_size;
+    tf.reset(new rocksdb::BlockBasedTableFactory(table_options));
   } else {
     fprintf(stderr, "Invalid table type %s\n", FLAGS_table_factory.c_str());
   }
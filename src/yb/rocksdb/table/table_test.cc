@@ -1523,6 +1523,79 @@ TEST_F(TableTest, MultiLevelIndexTest) {
   }
 }
 
+TEST_F(TableTest, MultiLevelIndexWithFencePointersTest) {
+  BlockBasedTableOptions table_options;
+  table_options.index_type = IndexType::kMultiLevelBinarySearch;
+  table_options.data_block_fence_pointers = true;
+  table_options.min_keys_per_index_block = 2;
+  table_options.index_block_size = 48;
+  TestIndex(table_options, 3);
+}
+
+TEST_F(TableTest, DataBlockFencePointersSeek) {
+  TableConstructor c(BytewiseComparator());
+  Random rnd(301);
+  // All user keys have the same size, so bytewise order of internal keys matches their order.
+  // Keys are grouped, so keys of the same group have the same fingerprint.
+  auto make_user_key = [](int group, int idx) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "prefix/%04d/%08d", group, idx);
+    return std::string(buffer);
+  };
+  for (int group = 0; group != 200; group += 2) {
+    auto group_size = rnd.Uniform(20);
+    for (uint32_t i = 0; i != group_size; ++i) {
+      c.Add(InternalKey(make_user_key(group, rnd.Uniform(100000)), 0, kTypeValue).Encode()
+                .ToString(), RandomString(&rnd, 100));
+    }
+  }
+
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  Options options;
+  options.compression = kNoCompression;
+  BlockBasedTableOptions table_options;
+  table_options.index_type = IndexType::kMultiLevelBinarySearch;
+  table_options.data_block_fence_pointers = true;
+  table_options.block_size = 512;
+  table_options.index_block_size = 128;
+  table_options.min_keys_per_index_block = 2;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options,
+           std::make_shared<InternalKeyComparator>(BytewiseComparator()), &keys, &kvmap);
+  std::unique_ptr<InternalIterator> iter(c.GetTableReader()->NewIterator(ReadOptions()));
+
+  auto check_seek = [&](const std::string& user_key) {
+    auto target = InternalKey(user_key, 0, kTypeValue).Encode().ToString();
+    iter->Seek(target);
+    ASSERT_OK(iter->status());
+    auto expected = kvmap.lower_bound(target);
+    for (int step = 0; step != 3; ++step, ++expected) {
+      if (expected == kvmap.end()) {
+        ASSERT_FALSE(iter->Valid()) << "Target: " << user_key;
+        break;
+      }
+      ASSERT_TRUE(iter->Valid()) << "Target: " << user_key;
+      ASSERT_EQ(expected->first, iter->key().ToString()) << "Target: " << user_key;
+      ASSERT_EQ(expected->second, iter->value().ToString()) << "Target: " << user_key;
+      iter->Next();
+    }
+  };
+
+  for (const auto& key : keys) {
+    ASSERT_NO_FATALS(check_seek(ExtractUserKey(key).ToString()));
+  }
+  for (int group = -1; group != 202; ++group) {
+    ASSERT_NO_FATALS(check_seek(make_user_key(group, rnd.Uniform(100000))));
+  }
+  ASSERT_NO_FATALS(check_seek("a"));
+  ASSERT_NO_FATALS(check_seek("prefix"));
+  ASSERT_NO_FATALS(check_seek("prefix/"));
+  ASSERT_NO_FATALS(check_seek("z"));
+}
+
 // It's very hard to figure out the index block size of a block accurately.
 // To make sure we get the index size, we just make sure as key number
 // grows, the filter block size also grows.
@@ -149,6 +149,7 @@ char* Arena::AllocateFromHugePage(size_t bytes) {
   }
   // the following shouldn't throw because of the above reserve()
   huge_blocks_.emplace_back(MmapInfo(addr, bytes));
+  Consumed(bytes);
   return reinterpret_cast<char*>(addr);
 #else
   return nullptr;
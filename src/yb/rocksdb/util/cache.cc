@@ -24,6 +24,9 @@
 #include <assert.h>
 #include <stdio.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/statistics.h"
@@ -48,6 +51,11 @@ DEFINE_bool(cache_overflow_single_touch, true,
             "Whether to enable overflow of single touch cache into the multi touch cache "
             "allocation");
 
+DEFINE_bool(cache_multi_touch_frequency_admission, false,
+            "Whether to move single touch entry to the full multi touch cache only when it was "
+            "accessed more often than the multi touch entry it would evict. Makes multi touch "
+            "cache resistant to scans, that touch the same blocks from different queries.");
+
 namespace rocksdb {
 
 Cache::~Cache() {
@@ -375,6 +383,72 @@ class LRUHandleDeleter {
   autovector<LRUHandle*> handles_;
 };
 
+// Approximate number of recent lookups of each key, used by frequency based admission to the
+// multi touch cache. Count-min sketch with kDepth rows of saturating counters. All counters are
+// halved after sample size increments, so frequency of keys that are not accessed anymore decays.
+class FrequencySketch {
+ public:
+  bool empty() const {
+    return counters_.empty();
+  }
+
+  // Allocates sketch for approximately num_entries keys, all counters are reset.
+  void Resize(size_t num_entries) {
+    size_t width = kMinWidth;
+    while (width < num_entries) {
+      width <<= 1;
+    }
+    counters_.assign(width * kDepth, 0);
+    mask_ = width - 1;
+    sample_size_ = width * 10;
+    additions_ = 0;
+  }
+
+  void Increment(uint32_t hash) {
+    if (counters_.empty()) {
+      return;
+    }
+    bool added = false;
+    for (size_t row = 0; row != kDepth; ++row) {
+      auto& counter = counters_[Index(hash, row)];
+      if (counter < kMaxFrequency) {
+        ++counter;
+        added = true;
+      }
+    }
+    if (added && ++additions_ >= sample_size_) {
+      for (auto& counter : counters_) {
+        counter >>= 1;
+      }
+      additions_ /= 2;
+    }
+  }
+
+  uint8_t Frequency(uint32_t hash) const {
+    uint8_t result = kMaxFrequency;
+    for (size_t row = 0; row != kDepth; ++row) {
+      result = std::min(result, counters_[Index(hash, row)]);
+    }
+    return result;
+  }
+
+ private:
+  static constexpr size_t kDepth = 4;
+  static constexpr size_t kMinWidth = 1024;
+  static constexpr uint8_t kMaxFrequency = 15;
+
+  size_t Index(uint32_t hash, size_t row) const {
+    // Keys of the same shard share the high bits of hash, so mix all of them into the index.
+    uint64_t mixed = (hash + (row + 1) * 0x9E3779B97F4A7C15ULL) * 0xBF58476D1CE4E5B9ULL;
+    return row * (mask_ + 1) + ((mixed >> 32) & mask_);
+  }
+
+  std::vector<uint8_t> counters_;
+  size_t mask_ = 0;
+  size_t sample_size_ = 0;
+  size_t additions_ = 0;
+};
+
 // A single shard of sharded cache.
 class LRUCache {
  public:
@@ -458,6 +532,11 @@ class LRUCache {
   // Checks if the corresponding subcache contains space.
   bool HasFreeSpace(const SubCacheType subcache_type);
 
+  // Checks whether single touch entry, that was accessed by another query, should be moved to the
+  // multi touch cache. With frequency admission it is moved to the full multi touch cache only
+  // when it was accessed more often than the least recently used multi touch entry.
+  bool ShouldPromoteToMultiTouch(LRUHandle* e);
+
   size_t TotalUsage() const {
     return single_touch_sub_cache_.Usage() + multi_touch_sub_cache_.Usage();
   }
@@ -472,6 +551,9 @@ class LRUCache {
 
   HandleTable table_;
 
+  // Used only when cache_multi_touch_frequency_admission is enabled.
+  FrequencySketch frequency_sketch_;
+
   shared_ptr<yb::CacheMetrics> metrics_;
 };
 
@@ -561,6 +643,10 @@ void LRUCache::SetCapacity(size_t capacity) {
     MutexLock l(&mutex_);
     multi_touch_capacity_ = round((1 - FLAGS_cache_single_touch_ratio) * capacity);
     total_capacity_ = capacity;
+    if (FLAGS_cache_multi_touch_frequency_admission) {
+      // Block size is not known to the cache, so assume 4KB entries.
+      frequency_sketch_.Resize(capacity / 4096);
+    }
     EvictFromLRU(0, &last_reference_list, MULTI_TOUCH);
     EvictFromLRU(0, &last_reference_list, SINGLE_TOUCH);
   }
@@ -579,6 +665,7 @@ void LRUCache::SetStrictCapacityLimit(bool strict_capacity_limit) {
 Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
                                 Statistics* statistics)  {
   MutexLock l(&mutex_);
+  frequency_sketch_.Increment(hash);
   LRUHandle* e = table_.Lookup(key, hash);
   if (e != nullptr) {
     assert(e->in_cache);
@@ -591,7 +678,7 @@ Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash, const QueryId q
 
     // Now the handle will be added to the multi touch pool only if it exists.
     if (FLAGS_cache_single_touch_ratio < 1 && e->GetSubCacheType() != MULTI_TOUCH &&
-        e->query_id != query_id) {
+        e->query_id != query_id && ShouldPromoteToMultiTouch(e)) {
       {
         LRUHandleDeleter multi_touch_eviction_list(metrics_.get());
         EvictFromLRU(e->charge, &multi_touch_eviction_list, MULTI_TOUCH);
@@ -653,6 +740,16 @@ bool LRUCache::HasFreeSpace(const SubCacheType subcache_type) {
   FATAL_INVALID_ENUM_VALUE(SubCacheType, subcache_type);
 }
 
+bool LRUCache::ShouldPromoteToMultiTouch(LRUHandle* e) {
+  if (frequency_sketch_.empty() ||
+      multi_touch_sub_cache_.Usage() + e->charge <= multi_touch_capacity_ ||
+      multi_touch_sub_cache_.IsLRUEmpty()) {
+    return true;
+  }
+  const LRUHandle* victim = multi_touch_sub_cache_.LRU_Head().next;
+  return frequency_sketch_.Frequency(e->hash) > frequency_sketch_.Frequency(victim->hash);
+}
+
 void LRUCache::Release(Cache::Handle* handle) {
   if (handle == nullptr) {
     return;
@@ -37,6 +37,7 @@
 using std::shared_ptr;
 
 DECLARE_double(cache_single_touch_ratio);
+DECLARE_bool(cache_multi_touch_frequency_admission);
 
 namespace rocksdb {
 
@@ -467,6 +468,41 @@ TEST_F(CacheTest, EvictionPolicyMultiTouch) {
   ASSERT_LT(kCacheSize * FLAGS_cache_single_touch_ratio, cache_->GetUsage());
 }
 
+TEST_F(CacheTest, MultiTouchFrequencyAdmission) {
+  FLAGS_cache_multi_touch_frequency_admission = true;
+  const int kCapacity = 100;
+  const int kMultiTouchCapacity = kCapacity * (1 - FLAGS_cache_single_touch_ratio);
+  auto cache = NewLRUCache(kCapacity, 0);
+  QueryId qid1 = 1000;
+  QueryId qid2 = 1001;
+
+  // Fill multi touch cache with entries, that are looked up several times.
+  for (int i = 0; i < kMultiTouchCapacity; i++) {
+    ASSERT_OK(Insert(cache, i, i + 1, 1, qid1));
+    for (int j = 0; j < 4; j++) {
+      ASSERT_TRUE(LookupAndCheckInMultiTouch(cache, i, i + 1, qid2));
+    }
+  }
+
+  // Scan touches each entry from two queries, but it should not replace frequently used entries.
+  for (int i = 1000; i < 1000 + kCapacity * 2; i++) {
+    ASSERT_OK(Insert(cache, i, i + 1, 1, qid1));
+    ASSERT_FALSE(LookupAndCheckInMultiTouch(cache, i, i + 1, qid2));
+  }
+  for (int i = 0; i < kMultiTouchCapacity; i++) {
+    ASSERT_TRUE(LookupAndCheckInMultiTouch(cache, i, i + 1, qid2));
+  }
+
+  // Entry that is accessed more often than the multi touch victim is still promoted.
+  ASSERT_OK(Insert(cache, 5000, 5001, 1, qid1));
+  for (int j = 0; j < 10; j++) {
+    ASSERT_EQ(5001, Lookup(cache, 5000, qid2));
+  }
+  ASSERT_TRUE(LookupAndCheckInMultiTouch(cache, 5000, 5001, qid2));
+
+  FLAGS_cache_multi_touch_frequency_admission = false;
+}
+
 TEST_F(CacheTest, HeavyEntries) {
   // Add a bunch of light and heavy entries and then count the combined
   // size of items still in the cache, which must be approximately the
@@ -32,12 +32,15 @@
 #include "yb/rocksdb/util/sync_point.h"
 
 #include "yb/util/priority_thread_pool.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stats/iostats_context_imp.h"
 #include "yb/util/status_log.h"
 #include "yb/util/test_kill.h"
 
 using std::unique_ptr;
 
+using namespace yb::size_literals;
+
 DEFINE_bool(allow_preempting_compactions, true,
             "Whether a compaction may be preempted in favor of another compaction with higher "
             "priority");
@@ -55,6 +58,40 @@ Status SequentialFileReader::Read(size_t n, Slice* result, uint8_t* scratch) {
 
 Status SequentialFileReader::Skip(uint64_t n) { return file_->Skip(n); }
 
+namespace {
+
+// Expected average size of the blocks, used to pick number of slots for verified block offsets.
+constexpr uint64_t kVerifiedBlockSizeEstimate = 16_KB;
+constexpr size_t kMinVerifiedBlockSlots = 16;
+
+} // namespace
+
+bool VerifiedBlocks::Contains(uint64_t offset) const {
+  return Slot(offset).load(std::memory_order_acquire) == offset + 1;
+}
+
+void VerifiedBlocks::Insert(uint64_t offset) {
+  Slot(offset).store(offset + 1, std::memory_order_release);
+}
+
+std::atomic<uint64_t>& VerifiedBlocks::Slot(uint64_t offset) const {
+  // Block offsets have a lot of common low bits, so mix them before picking the slot.
+  return slots_[(offset * 0x9E3779B97F4A7C15ULL >> 32) % slots_.size()];
+}
+
+std::unique_ptr<VerifiedBlocks> RandomAccessFileReader::CreateVerifiedBlocks(
+    const RandomAccessFile& file) {
+  if (!file.IsMemoryMapped()) {
+    return nullptr;
+  }
+  auto size = file.Size();
+  if (!size.ok()) {
+    return nullptr;
+  }
+  return std::make_unique<VerifiedBlocks>(std::max<size_t>(
+      *size / kVerifiedBlockSizeEstimate, kMinVerifiedBlockSlots));
+}
+
 Status RandomAccessFileReader::Read(uint64_t offset, size_t n, Slice* result,
                                     char* scratch) const {
   Status s;
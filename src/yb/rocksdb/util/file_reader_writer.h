@@ -25,7 +25,10 @@
 
 #include <string.h>
 
+#include <atomic>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "yb/util/flags.h"
 
@@ -77,6 +80,23 @@ class SequentialFileReader {
   SequentialFile* file() { return file_.get(); }
 };
 
+// Lossy set of offsets of the file blocks, that passed checksum verification. Offsets are stored
+// in a fixed number of slots, so an offset could be evicted by the other one using the same slot,
+// leading to repeated verification. But an offset that was not inserted is never reported.
+class VerifiedBlocks {
+ public:
+  explicit VerifiedBlocks(size_t num_slots) : slots_(num_slots) {}
+
+  bool Contains(uint64_t offset) const;
+  void Insert(uint64_t offset);
+
+ private:
+  std::atomic<uint64_t>& Slot(uint64_t offset) const;
+
+  // Each slot contains offset + 1 of the block, so zero marks an empty slot.
+  mutable std::vector<std::atomic<uint64_t>> slots_;
+};
+
 class RandomAccessFileReader {
  private:
   std::unique_ptr<RandomAccessFile> file_;
@@ -84,6 +104,10 @@ class RandomAccessFileReader {
   Statistics*     stats_;
   uint32_t        hist_type_;
   HistogramImpl*  file_read_hist_;
+  // Only created for memory mapped files, whose data does not change once verified.
+  std::unique_ptr<VerifiedBlocks> verified_blocks_;
+
+  static std::unique_ptr<VerifiedBlocks> CreateVerifiedBlocks(const RandomAccessFile& file);
 
  public:
   explicit RandomAccessFileReader(std::unique_ptr<RandomAccessFile>&& raf,
@@ -95,7 +119,8 @@ class RandomAccessFileReader {
         env_(env),
         stats_(stats),
         hist_type_(hist_type),
-        file_read_hist_(file_read_hist) {}
+        file_read_hist_(file_read_hist),
+        verified_blocks_(CreateVerifiedBlocks(*file_)) {}
 
   RandomAccessFileReader(RandomAccessFileReader&& o) ROCKSDB_NOEXCEPT {
     *this = std::move(o);
@@ -107,6 +132,7 @@ class RandomAccessFileReader {
     stats_ = std::move(o.stats_);
     hist_type_ = std::move(o.hist_type_);
     file_read_hist_ = std::move(o.file_read_hist_);
+    verified_blocks_ = std::move(o.verified_blocks_);
     return *this;
   }
 
@@ -117,6 +143,18 @@ class RandomAccessFileReader {
   Status ReadAndValidate(
       uint64_t offset, size_t n, Slice* result, char* scratch, const yb::ReadValidator& validator);
 
+  // Whether checksum of the block at the specified offset was already verified. Always false for
+  // files that are not memory mapped.
+  bool IsBlockVerified(uint64_t offset) const {
+    return verified_blocks_ && verified_blocks_->Contains(offset);
+  }
+
+  void SetBlockVerified(uint64_t offset) {
+    if (verified_blocks_) {
+      verified_blocks_->Insert(offset);
+    }
+  }
+
   RandomAccessFile* file() { return file_.get(); }
 };
 
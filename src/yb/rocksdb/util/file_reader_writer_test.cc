@@ -141,6 +141,24 @@ TEST_F(WritableFileWriterTest, AppendStatusReturn) {
   ASSERT_NOK(writer->Append(std::string(2 * kMb, 'b')));
 }
 
+TEST(VerifiedBlocksTest, Lossy) {
+  VerifiedBlocks blocks(4);
+  ASSERT_FALSE(blocks.Contains(0));
+  blocks.Insert(0);
+  ASSERT_TRUE(blocks.Contains(0));
+
+  // Much more offsets than slots, so some of them are evicted, but only inserted offsets could
+  // be reported as verified.
+  constexpr uint64_t kBlockSize = 32 * 1024;
+  for (uint64_t i = 1; i <= 100; ++i) {
+    blocks.Insert(i * kBlockSize);
+    ASSERT_TRUE(blocks.Contains(i * kBlockSize));
+  }
+  for (uint64_t i = 101; i <= 200; ++i) {
+    ASSERT_FALSE(blocks.Contains(i * kBlockSize));
+  }
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
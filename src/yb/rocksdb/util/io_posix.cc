@@ -136,6 +136,31 @@ size_t PosixMmapReadableFile::memory_footprint() const {
   return malloc_usable_size(this) + filename_.capacity();
 }
 
+void PosixMmapReadableFile::Hint(AccessPattern pattern) {
+  int advice = MADV_NORMAL;
+  switch (pattern) {
+    case NORMAL:
+      advice = MADV_NORMAL;
+      break;
+    case RANDOM:
+      advice = MADV_RANDOM;
+      break;
+    case SEQUENTIAL:
+      advice = MADV_SEQUENTIAL;
+      break;
+    case WILLNEED:
+      advice = MADV_WILLNEED;
+      break;
+    case DONTNEED:
+      advice = MADV_DONTNEED;
+      break;
+    default:
+      assert(false);
+      break;
+  }
+  madvise(mmapped_region_, length_, advice);
+}
+
 /*
  * PosixMmapFile
  *
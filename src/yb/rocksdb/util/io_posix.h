@@ -57,6 +57,11 @@ class PosixMmapReadableFile : public RandomAccessFile {
   // Doesn't include memory usage by mmap.
   size_t memory_footprint() const override;
   const std::string& filename() const override { return filename_; }
+  bool IsMemoryMapped() const override { return true; }
+  // Data is returned without copying, so there is no reason to buffer it for read-ahead.
+  bool ShouldForwardRawRequest() const override { return true; }
+  void EnableReadAhead() override { Hint(SEQUENTIAL); }
+  void Hint(AccessPattern pattern) override;
 };
 
 class PosixMmapFile : public WritableFile {
@@ -98,6 +98,8 @@ void MutableCFOptions::Dump(Logger* log) const {
       memtable_prefix_bloom_probes);
   RLOG(log, " memtable_prefix_bloom_huge_page_tlb_size: %" ROCKSDB_PRIszt,
       memtable_prefix_bloom_huge_page_tlb_size);
+  RLOG(log, "                  memtable_huge_page_size: %" ROCKSDB_PRIszt,
+      memtable_huge_page_size);
   RLOG(log, "                    max_successive_merges: %" ROCKSDB_PRIszt,
       max_successive_merges);
   RLOG(log, "                           filter_deletes: %d",
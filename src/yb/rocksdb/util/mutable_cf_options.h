@@ -36,6 +36,7 @@ struct MutableCFOptions {
         memtable_prefix_bloom_probes(options.memtable_prefix_bloom_probes),
         memtable_prefix_bloom_huge_page_tlb_size(
             options.memtable_prefix_bloom_huge_page_tlb_size),
+        memtable_huge_page_size(options.memtable_huge_page_size),
         max_successive_merges(options.max_successive_merges),
         filter_deletes(options.filter_deletes),
         inplace_update_num_locks(options.inplace_update_num_locks),
@@ -75,6 +76,7 @@ struct MutableCFOptions {
         memtable_prefix_bloom_bits(0),
         memtable_prefix_bloom_probes(0),
         memtable_prefix_bloom_huge_page_tlb_size(0),
+        memtable_huge_page_size(0),
         max_successive_merges(0),
         filter_deletes(false),
         inplace_update_num_locks(0),
@@ -128,6 +130,7 @@ struct MutableCFOptions {
   uint32_t memtable_prefix_bloom_bits;
   uint32_t memtable_prefix_bloom_probes;
   size_t memtable_prefix_bloom_huge_page_tlb_size;
+  size_t memtable_huge_page_size;
   size_t max_successive_merges;
   bool filter_deletes;
   size_t inplace_update_num_locks;
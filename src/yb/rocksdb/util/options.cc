@@ -81,6 +81,8 @@ ImmutableCFOptions::ImmutableCFOptions(const Options& options)
       use_fsync(options.use_fsync),
       compression(options.compression),
       compression_per_level(options.compression_per_level),
+      large_output_compression_min_size(options.large_output_compression_min_size),
+      large_output_compression(options.large_output_compression),
       compression_opts(options.compression_opts),
       level_compaction_dynamic_level_bytes(
           options.level_compaction_dynamic_level_bytes),
@@ -96,6 +98,7 @@ ImmutableCFOptions::ImmutableCFOptions(const Options& options)
       block_based_table_mem_tracker(options.block_based_table_mem_tracker),
       iterator_replacer(options.iterator_replacer),
       compaction_file_filter_factory(options.compaction_file_filter_factory.get()),
+      compaction_time_window_policy(options.compaction_time_window_policy.get()),
       priority_thread_pool_metrics(options.priority_thread_pool_metrics) {}
 
 ColumnFamilyOptions::ColumnFamilyOptions()
@@ -144,6 +147,7 @@ ColumnFamilyOptions::ColumnFamilyOptions()
       memtable_prefix_bloom_bits(0),
       memtable_prefix_bloom_probes(6),
       memtable_prefix_bloom_huge_page_tlb_size(0),
+      memtable_huge_page_size(0),
       bloom_locality(0),
       max_successive_merges(0),
       min_partial_merge_operands(2),
@@ -166,6 +170,8 @@ ColumnFamilyOptions::ColumnFamilyOptions(const Options& options)
           options.max_write_buffer_number_to_maintain),
       compression(options.compression),
       compression_per_level(options.compression_per_level),
+      large_output_compression_min_size(options.large_output_compression_min_size),
+      large_output_compression(options.large_output_compression),
       compression_opts(options.compression_opts),
       prefix_extractor(options.prefix_extractor),
       num_levels(options.num_levels),
@@ -213,6 +219,7 @@ ColumnFamilyOptions::ColumnFamilyOptions(const Options& options)
       memtable_prefix_bloom_probes(options.memtable_prefix_bloom_probes),
       memtable_prefix_bloom_huge_page_tlb_size(
           options.memtable_prefix_bloom_huge_page_tlb_size),
+      memtable_huge_page_size(options.memtable_huge_page_size),
       bloom_locality(options.bloom_locality),
       max_successive_merges(options.max_successive_merges),
       min_partial_merge_operands(options.min_partial_merge_operands),
@@ -447,6 +454,12 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
       RHEADER(log, "         Options.compression: %s",
           CompressionTypeToString(compression).c_str());
     }
+  if (large_output_compression_min_size > 0) {
+    RHEADER(log, "   Options.large_output_compression: %s",
+        CompressionTypeToString(large_output_compression).c_str());
+    RHEADER(log, "   Options.large_output_compression_min_size: %" PRIu64,
+        large_output_compression_min_size);
+  }
   RHEADER(log, "      Options.prefix_extractor: %s",
       prefix_extractor == nullptr ? "nullptr" : prefix_extractor->Name());
   RHEADER(log, "            Options.num_levels: %d", num_levels);
@@ -552,6 +565,8 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
   RHEADER(log,
       "  Options.memtable_prefix_bloom_huge_page_tlb_size: %" ROCKSDB_PRIszt,
          memtable_prefix_bloom_huge_page_tlb_size);
+  RHEADER(log, "                 Options.memtable_huge_page_size: %" ROCKSDB_PRIszt,
+         memtable_huge_page_size);
   RHEADER(log, "                          Options.bloom_locality: %d",
       bloom_locality);
 
@@ -450,6 +450,9 @@ static std::unordered_map<std::string, OptionTypeInfo> cf_options_type_info = {
      {offsetof(struct ColumnFamilyOptions,
                memtable_prefix_bloom_huge_page_tlb_size),
       OptionType::kSizeT, OptionVerificationType::kNormal}},
+    {"memtable_huge_page_size",
+     {offsetof(struct ColumnFamilyOptions, memtable_huge_page_size),
+      OptionType::kSizeT, OptionVerificationType::kNormal}},
     {"write_buffer_size",
      {offsetof(struct ColumnFamilyOptions, write_buffer_size),
       OptionType::kSizeT, OptionVerificationType::kNormal}},
@@ -520,6 +523,9 @@ static std::unordered_map<std::string,
     {"cache_index_and_filter_blocks",
      {offsetof(struct BlockBasedTableOptions, cache_index_and_filter_blocks),
       OptionType::kBoolean, OptionVerificationType::kNormal}},
+    {"cache_index_and_filter_blocks_with_high_priority",
+     {offsetof(struct BlockBasedTableOptions, cache_index_and_filter_blocks_with_high_priority),
+      OptionType::kBoolean, OptionVerificationType::kNormal}},
     {"index_type",
      {offsetof(struct BlockBasedTableOptions, index_type),
       OptionType::kBlockBasedTableIndexType, OptionVerificationType::kNormal}},
@@ -553,6 +559,9 @@ static std::unordered_map<std::string,
     {"min_keys_per_index_block",
      {offsetof(struct BlockBasedTableOptions, min_keys_per_index_block), OptionType::kSizeT,
       OptionVerificationType::kNormal}},
+    {"data_block_fence_pointers",
+     {offsetof(struct BlockBasedTableOptions, data_block_fence_pointers), OptionType::kBoolean,
+      OptionVerificationType::kNormal}},
     {"filter_policy",
      {offsetof(struct BlockBasedTableOptions, filter_policy),
       OptionType::kFilterPolicy, OptionVerificationType::kByName}},
@@ -159,6 +159,7 @@ TEST_F(OptionsTest, GetOptionsFromMapTest) {
       {"memtable_prefix_bloom_bits", "26"},
       {"memtable_prefix_bloom_probes", "27"},
       {"memtable_prefix_bloom_huge_page_tlb_size", "28"},
+      {"memtable_huge_page_size", "2097152"},
       {"bloom_locality", "29"},
       {"max_successive_merges", "30"},
       {"min_partial_merge_operands", "31"},
@@ -257,6 +258,7 @@ TEST_F(OptionsTest, GetOptionsFromMapTest) {
   ASSERT_EQ(new_cf_opt.memtable_prefix_bloom_bits, 26U);
   ASSERT_EQ(new_cf_opt.memtable_prefix_bloom_probes, 27U);
   ASSERT_EQ(new_cf_opt.memtable_prefix_bloom_huge_page_tlb_size, 28U);
+  ASSERT_EQ(new_cf_opt.memtable_huge_page_size, 2097152U);
   ASSERT_EQ(new_cf_opt.bloom_locality, 29U);
   ASSERT_EQ(new_cf_opt.max_successive_merges, 30U);
   ASSERT_EQ(new_cf_opt.min_partial_merge_operands, 31U);
@@ -1726,6 +1728,7 @@ Status GetFromString(ColumnFamilyOptions* source, ColumnFamilyOptions* destinati
       "bloom_locality=8016;"
       "target_file_size_base=4294976376;"
       "memtable_prefix_bloom_huge_page_tlb_size=2557;"
+      "memtable_huge_page_size=2097152;"
       "max_successive_merges=5497;"
       "max_sequential_skip_in_iterations=4294971408;"
       "arena_block_size=1893;"
@@ -1895,6 +1898,7 @@ TEST_F(OptionsParserTest, BlockBasedTableOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(BlockBasedTableOptions, data_block_key_value_encoding_format),
       BLACKLIST_ENTRY(BlockBasedTableOptions, filter_policy),
       BLACKLIST_ENTRY(BlockBasedTableOptions, supported_filter_policies),
+      BLACKLIST_ENTRY(BlockBasedTableOptions, data_block_stats_collector_factory),
   };
 
   // In this test, we catch a new option of BlockBasedTableOptions that is not
@@ -1931,13 +1935,16 @@ TEST_F(OptionsParserTest, DBOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(DBOptions, wal_filter),
       BLACKLIST_ENTRY(DBOptions, boundary_extractor),
       BLACKLIST_ENTRY(DBOptions, compaction_context_factory),
+      BLACKLIST_ENTRY(DBOptions, flush_compaction_context_factory),
       BLACKLIST_ENTRY(DBOptions, max_file_size_for_compaction),
+      BLACKLIST_ENTRY(DBOptions, compaction_row_prefix_extractor),
       BLACKLIST_ENTRY(DBOptions, mem_table_flush_filter_factory),
       BLACKLIST_ENTRY(DBOptions, log_prefix),
       BLACKLIST_ENTRY(DBOptions, mem_tracker),
       BLACKLIST_ENTRY(DBOptions, block_based_table_mem_tracker),
       BLACKLIST_ENTRY(DBOptions, iterator_replacer),
       BLACKLIST_ENTRY(DBOptions, compaction_file_filter_factory),
+      BLACKLIST_ENTRY(DBOptions, compaction_time_window_policy),
       BLACKLIST_ENTRY(DBOptions, priority_thread_pool_metrics),
       BLACKLIST_ENTRY(DBOptions, disk_group_no),
   };
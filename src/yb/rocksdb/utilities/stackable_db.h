@@ -288,6 +288,10 @@ class StackableDB : public DB {
     return db_->GetMiddleKey();
   };
 
+  yb::Result<std::vector<std::string>> GetSampleKeys(size_t max_keys) override {
+    return db_->GetSampleKeys(max_keys);
+  }
+
   virtual void GetColumnFamilyMetaData(
       ColumnFamilyHandle *column_family,
       ColumnFamilyMetaData* cf_meta) override {
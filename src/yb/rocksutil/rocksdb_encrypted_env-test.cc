@@ -12,6 +12,7 @@
 //
 
 #include <string>
+#include <vector>
 
 #include "yb/gutil/casts.h"
 
@@ -21,10 +22,16 @@
 #include "yb/encryption/header_manager.h"
 #include "yb/encryption/header_manager_mock_impl.h"
 
+#include "yb/util/flags.h"
+#include "yb/util/monotime.h"
 #include "yb/util/random_util.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status.h"
 #include "yb/util/test_util.h"
 
+DEFINE_int32(encrypted_env_bench_file_size_mb, 32,
+             "Size of the file written and read by the encrypted env throughput benchmark.");
+
 namespace yb {
 
 constexpr uint32_t kDataSize = 1000;
@@ -58,4 +65,64 @@ TEST_F(TestRocksDBEncryptedEnv, FileOps) {
   }
 }
 
+// Compares throughput of plaintext and encrypted files with SST like access pattern: large
+// appends on write, block sized random reads and sequential reads, as done by compactions.
+TEST_F(TestRocksDBEncryptedEnv, Throughput) {
+  OverrideFlagForSlowTests("encrypted_env_bench_file_size_mb", "512");
+  constexpr size_t kAppendSize = 64_KB;
+  constexpr size_t kBlockSize = 32_KB;
+  const size_t file_size = FLAGS_encrypted_env_bench_file_size_mb * 1_MB;
+  const size_t num_blocks = file_size / kBlockSize;
+
+  auto header_manager = encryption::GetMockHeaderManager();
+  encryption::HeaderManager* hm_ptr = header_manager.get();
+  auto env = yb::NewRocksDBEncryptedEnv(std::move(header_manager));
+  auto fname = GetTestPath("bench-file");
+  auto bytes = RandomBytes(kAppendSize);
+  Slice data(bytes.data(), bytes.size());
+  std::vector<uint8_t> scratch(kBlockSize);
+
+  auto log_throughput = [file_size](const char* op, bool encrypted, MonoTime start) {
+    auto seconds = (MonoTime::Now() - start).ToSeconds();
+    LOG(INFO) << (encrypted ? "Encrypted" : "Plaintext") << " " << op << ": "
+              << file_size / 1_MB / seconds << " MB/s";
+  };
+
+  for (bool encrypted : {false, true}) {
+    down_cast<encryption::HeaderManagerMockImpl*>(hm_ptr)->SetFileEncryption(encrypted);
+
+    std::unique_ptr<rocksdb::WritableFile> writable_file;
+    ASSERT_OK(env->NewWritableFile(fname, &writable_file, rocksdb::EnvOptions()));
+    auto start = MonoTime::Now();
+    for (size_t written = 0; written < file_size; written += kAppendSize) {
+      ASSERT_OK(writable_file->Append(data));
+    }
+    ASSERT_OK(writable_file->Close());
+    log_throughput("write", encrypted, start);
+
+    std::unique_ptr<rocksdb::RandomAccessFile> ra_file;
+    ASSERT_OK(env->NewRandomAccessFile(fname, &ra_file, rocksdb::EnvOptions()));
+    start = MonoTime::Now();
+    for (size_t i = 0; i != num_blocks; ++i) {
+      Slice result;
+      auto offset = RandomUniformInt<size_t>(0, num_blocks - 1) * kBlockSize;
+      ASSERT_OK(ra_file->Read(offset, kBlockSize, &result, scratch.data()));
+      ASSERT_EQ(result.size(), kBlockSize);
+    }
+    log_throughput("random read", encrypted, start);
+
+    std::unique_ptr<rocksdb::SequentialFile> s_file;
+    ASSERT_OK(env->NewSequentialFile(fname, &s_file, rocksdb::EnvOptions()));
+    start = MonoTime::Now();
+    for (size_t i = 0; i != num_blocks; ++i) {
+      Slice result;
+      ASSERT_OK(s_file->Read(kBlockSize, &result, scratch.data()));
+      ASSERT_EQ(result.size(), kBlockSize);
+    }
+    log_throughput("sequential read", encrypted, start);
+
+    ASSERT_OK(env->DeleteFile(fname));
+  }
+}
+
 } // namespace yb
@@ -24,6 +24,7 @@
 #include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
 
+using yb::operator"" _KB;
 using yb::operator"" _MB;
 
 DEFINE_bool(
@@ -35,11 +36,40 @@ DEFINE_int64(
     "Throttle inbound RPC calls larger than specified size on hitting mem tracker soft limit. "
     "Throttling is disabled if negative value is specified.");
 
+DEFINE_RUNTIME_uint64(rpc_min_shared_call_size, 64_KB,
+    "Min size of received call, whose data references connection read buffer instead of being "
+    "copied.");
+
 DECLARE_int32(memory_limit_warn_threshold_percentage);
 
 namespace yb {
 namespace rpc {
 
+namespace {
+
+// Returns call data for [begin, end) range of data. Data of big enough call, located in a single
+// block, references shared_buffer, that contains this block. Otherwise data is copied.
+CallData MakeCallData(
+    const IoVecs& data, size_t begin, size_t end, const RefCntBuffer& shared_buffer) {
+  if (shared_buffer && end - begin >= FLAGS_rpc_min_shared_call_size) {
+    size_t offset = 0;
+    for (const auto& block : data) {
+      if (offset + block.iov_len > begin) {
+        if (end <= offset + block.iov_len) {
+          return CallData(shared_buffer, Slice(IoVecBegin(block) + begin - offset, end - begin));
+        }
+        break;
+      }
+      offset += block.iov_len;
+    }
+  }
+  CallData result(end - begin);
+  IoVecsToBuffer(data, begin, end, result.data());
+  return result;
+}
+
+} // namespace
+
 bool ShouldThrottleRpc(
     const MemTrackerPtr& throttle_tracker, ssize_t call_data_size, const char* throttle_message) {
   return (FLAGS_rpc_throttle_threshold_bytes >= 0 &&
@@ -62,7 +92,7 @@ BinaryCallParser::BinaryCallParser(
 
 Result<ProcessCallsResult> BinaryCallParser::Parse(
     const rpc::ConnectionPtr& connection, const IoVecs& data, ReadBufferFull read_buffer_full,
-    const MemTrackerPtr* tracker_for_throttle) {
+    const MemTrackerPtr* tracker_for_throttle, const RefCntBuffer& shared_buffer) {
   if (call_data_.should_reject()) {
     // We can't properly respond with error, because we don't have enough call data since we
     // have ignored it. So, we will just ignore this call and client will have timeout.
@@ -163,8 +193,8 @@ Result<ProcessCallsResult> BinaryCallParser::Parse(
     // connections, don't confuse with RAFT heartbeats which are higher level non-empty messages).
     if (!skip_empty_messages_ || data_length > 0) {
       connection->UpdateLastActivity();
-      CallData call_data(call_data_size);
-      IoVecsToBuffer(data, consumed + body_offset, consumed + total_length, call_data.data());
+      auto call_data = MakeCallData(
+          data, consumed + body_offset, consumed + total_length, shared_buffer);
       RETURN_NOT_OK(listener_->HandleCall(connection, &call_data));
     }
 
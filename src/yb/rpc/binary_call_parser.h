@@ -15,6 +15,7 @@
 
 #include "yb/util/mem_tracker.h"
 #include "yb/util/net/socket.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/strongly_typed_bool.h"
 
 #include "yb/rpc/rpc_fwd.h"
@@ -44,9 +45,12 @@ class BinaryCallParser {
 
   // If tracker_for_throttle is not nullptr - throttle big requests when tracker_for_throttle
   // (or any of its ancestors) exceeds soft memory limit.
+  // If shared_buffer is not empty, it contains data, and big calls reference it instead of
+  // copying their data.
   Result<ProcessCallsResult> Parse(const rpc::ConnectionPtr& connection, const IoVecs& data,
                                    ReadBufferFull read_buffer_full,
-                                   const MemTrackerPtr* tracker_for_throttle);
+                                   const MemTrackerPtr* tracker_for_throttle,
+                                   const RefCntBuffer& shared_buffer);
 
  private:
   MemTrackerPtr buffer_tracker_;
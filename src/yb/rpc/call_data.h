@@ -14,6 +14,7 @@
 #pragma once
 
 #include "yb/util/ref_cnt_buffer.h"
+#include "yb/util/slice.h"
 #include "yb/util/strongly_typed_bool.h"
 
 namespace yb {
@@ -21,9 +22,14 @@ namespace rpc {
 
 struct CallData {
  public:
-  CallData() : buffer_(EmptyBuffer()) {}
+  CallData() : buffer_(EmptyBuffer()), data_(buffer_.data()) {}
+
+  explicit CallData(size_t size) : buffer_(size), data_(buffer_.data()), size_(size) {}
+
+  // Call data that is a part of the shared buffer, e.g. slab of the connection read buffer.
+  CallData(RefCntBuffer buffer, Slice data)
+      : buffer_(std::move(buffer)), data_(data.cdata()), size_(data.size()), shared_(true) {}
 
-  explicit CallData(size_t size) : buffer_(size) {}
   class ShouldRejectTag {};
 
   CallData(size_t size, ShouldRejectTag) {}
@@ -31,32 +37,49 @@ struct CallData {
   CallData(const CallData&) = delete;
   void operator=(const CallData&) = delete;
 
-  CallData(CallData&& rhs) = default;
-  CallData& operator=(CallData&& rhs) = default;
+  CallData(CallData&& rhs) noexcept
+      : buffer_(std::move(rhs.buffer_)), data_(rhs.data_), size_(rhs.size_),
+        shared_(rhs.shared_) {
+    rhs.Reset();
+  }
+
+  CallData& operator=(CallData&& rhs) noexcept {
+    buffer_ = std::move(rhs.buffer_);
+    data_ = rhs.data_;
+    size_ = rhs.size_;
+    shared_ = rhs.shared_;
+    rhs.Reset();
+    return *this;
+  }
 
   bool empty() const {
-    return buffer_.empty();
+    return size_ == 0;
   }
 
   char* data() const {
-    return buffer_.data();
+    return const_cast<char*>(data_);
   }
 
   bool should_reject() const { return !buffer_; }
 
   void Reset() {
     buffer_.Reset();
+    data_ = nullptr;
+    size_ = 0;
+    shared_ = false;
   }
 
   size_t size() const {
-    return buffer_.size();
+    return size_;
   }
 
+  // Buffer that holds the call data, could be bigger than the data itself.
   const RefCntBuffer& buffer() const {
     return buffer_;
   }
 
-  size_t DynamicMemoryUsage() const { return buffer_.DynamicMemoryUsage(); }
+  // Shared buffer is accounted by its owner, so only the call data is reported.
+  size_t DynamicMemoryUsage() const { return shared_ ? size_ : buffer_.DynamicMemoryUsage(); }
 
  private:
   static RefCntBuffer EmptyBuffer() {
@@ -65,6 +88,9 @@ struct CallData {
   }
 
   RefCntBuffer buffer_;
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  bool shared_ = false;
 };
 
 } // namespace rpc
@@ -13,16 +13,68 @@
 
 #include "yb/rpc/circular_read_buffer.h"
 
+#include <algorithm>
+
+#include "yb/util/flags.h"
 #include "yb/util/result.h"
 #include "yb/util/tostring.h"
 
+DEFINE_RUNTIME_uint32(rpc_read_buffer_max_shared_slabs, 2,
+    "Max number of slabs, besides the current one, that the connection read buffer keeps for "
+    "parsed calls that reference received data without copying it. When all of them are "
+    "referenced, received calls are copied. 0 disables sharing.");
+
 namespace yb {
 namespace rpc {
 
 CircularReadBuffer::CircularReadBuffer(size_t capacity, const MemTrackerPtr& parent_tracker)
     : consumption_(MemTracker::FindOrCreateTracker("Receive", parent_tracker, AddToParent::kFalse),
                    capacity),
-      buffer_(static_cast<char*>(malloc(capacity))), capacity_(capacity) {
+      buffer_(capacity), capacity_(capacity) {
+}
+
+RefCntBuffer CircularReadBuffer::SharedSlab() {
+  if (!buffer_) {
+    return RefCntBuffer();
+  }
+  // The slab could be referenced only if there is a slab to switch to. Once it is referenced,
+  // the switch is already guaranteed.
+  if (buffer_.unique() && detached_slabs_.size() >= FLAGS_rpc_read_buffer_max_shared_slabs) {
+    auto has_free_slab = std::any_of(
+        detached_slabs_.begin(), detached_slabs_.end(),
+        [](const RefCntBuffer& slab) { return slab.unique(); });
+    if (!has_free_slab) {
+      return RefCntBuffer();
+    }
+  }
+  return buffer_;
+}
+
+void CircularReadBuffer::SwitchSlabIfShared() {
+  if (buffer_.unique()) {
+    return;
+  }
+  auto it = std::find_if(
+      detached_slabs_.begin(), detached_slabs_.end(),
+      [](const RefCntBuffer& slab) { return slab.unique(); });
+  if (it != detached_slabs_.end()) {
+    std::swap(*it, buffer_);
+  } else {
+    detached_slabs_.push_back(std::move(buffer_));
+    it = detached_slabs_.end() - 1;
+    buffer_ = RefCntBuffer(capacity_);
+    consumption_.Reset(capacity_ * (detached_slabs_.size() + 1));
+  }
+  // Move not yet consumed bytes to the beginning of the new slab.
+  const auto& old_slab = *it;
+  size_t end = pos_ + size_;
+  if (end <= capacity_) {
+    memcpy(buffer_.data(), old_slab.data() + pos_, size_);
+  } else {
+    memcpy(buffer_.data(), old_slab.data() + pos_, capacity_ - pos_);
+    memcpy(buffer_.data() + capacity_ - pos_, old_slab.data(), end - capacity_);
+  }
+  pos_ = 0;
 }
 
 bool CircularReadBuffer::Empty() {
@@ -30,7 +82,8 @@ bool CircularReadBuffer::Empty() {
 }
 
 void CircularReadBuffer::Reset() {
-  buffer_.reset();
+  buffer_.Reset();
+  detached_slabs_.clear();
 }
 
 Result<IoVecs> CircularReadBuffer::PrepareAppend() {
@@ -38,6 +91,8 @@ Result<IoVecs> CircularReadBuffer::PrepareAppend() {
     return STATUS(IllegalState, "Read buffer was reset");
   }
 
+  SwitchSlabIfShared();
+
   IoVecs result;
 
   if (!prepend_.empty()) {
@@ -46,11 +101,11 @@ Result<IoVecs> CircularReadBuffer::PrepareAppend() {
 
   size_t end = pos_ + size_;
   if (end < capacity_) {
-    result.push_back(iovec{buffer_.get() + end, capacity_ - end});
+    result.push_back(iovec{buffer_.data() + end, capacity_ - end});
   }
   size_t start = end <= capacity_ ? 0 : end - capacity_;
   if (pos_ > start) {
-    result.push_back(iovec{buffer_.get() + start, pos_ - start});
+    result.push_back(iovec{buffer_.data() + start, pos_ - start});
   }
 
   if (result.empty()) {
@@ -79,10 +134,10 @@ IoVecs CircularReadBuffer::AppendedVecs() {
 
   size_t end = pos_ + size_;
   if (end <= capacity_) {
-    result.push_back(iovec{buffer_.get() + pos_, size_});
+    result.push_back(iovec{buffer_.data() + pos_, size_});
   } else {
-    result.push_back(iovec{buffer_.get() + pos_, capacity_ - pos_});
-    result.push_back(iovec{buffer_.get(), end - capacity_});
+    result.push_back(iovec{buffer_.data() + pos_, capacity_ - pos_});
+    result.push_back(iovec{buffer_.data(), end - capacity_});
   }
 
   return result;
@@ -13,24 +13,30 @@
 
 #pragma once
 
+#include <vector>
+
 #include "yb/rpc/stream.h"
 
 #include "yb/util/mem_tracker.h"
+#include "yb/util/ref_cnt_buffer.h"
 
 namespace yb {
 namespace rpc {
 
-struct FreeMemory {
-  void operator()(void* data) const {
-    free(data);
-  }
-};
-
 // StreamReadBuffer implementation that is based on circular buffer of fixed capacity.
+//
+// Received data is stored in a reference counted slab, so parsed calls could keep views into it
+// instead of copying their data. While a view is alive, the slab is not written anymore: the
+// next append switches to a free slab, copying not yet consumed bytes. Number of slabs per buffer
+// is limited by rpc_read_buffer_max_shared_slabs.
 class CircularReadBuffer : public StreamReadBuffer {
  public:
   explicit CircularReadBuffer(size_t capacity, const MemTrackerPtr& parent_tracker);
 
+  // Returns the slab that contains AppendedVecs, when parsed calls could reference it.
+  // Otherwise, i.e., when all slabs are referenced, returns an empty buffer.
+  RefCntBuffer SharedSlab();
+
   bool ReadyToRead() override;
   bool Empty() override;
   void Reset() override;
@@ -43,8 +49,13 @@ class CircularReadBuffer : public StreamReadBuffer {
   size_t DataAvailable() override;
 
  private:
+  // Switches to free slab if the current one is referenced by parsed calls.
+  void SwitchSlabIfShared();
+
   ScopedTrackedConsumption consumption_;
-  std::unique_ptr<char, FreeMemory> buffer_;
+  RefCntBuffer buffer_;
+  // Slabs that were replaced by switching, some of them could still be referenced.
+  std::vector<RefCntBuffer> detached_slabs_;
   const size_t capacity_;
   size_t pos_ = 0;
   size_t size_ = 0;
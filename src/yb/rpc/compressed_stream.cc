@@ -13,6 +13,9 @@
 
 #include "yb/rpc/compressed_stream.h"
 
+#include <mutex>
+#include <unordered_map>
+
 #include <lz4.h>
 #include <snappy-sinksource.h>
 #include <snappy.h>
@@ -27,6 +30,10 @@
 #include "yb/rpc/outbound_data.h"
 #include "yb/rpc/refined_stream.h"
 
+#include "yb/util/crc.h"
+#include "yb/util/env.h"
+#include "yb/util/faststring.h"
+#include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/result.h"
 #include "yb/util/size_literals.h"
@@ -35,7 +42,17 @@
 using namespace std::literals;
 
 DEFINE_int32(stream_compression_algo, 0, "Algorithm used for stream compression. "
-                                         "0 - no compression, 1 - gzip, 2 - snappy, 3 - lz4.");
+                                         "0 - no compression, 1 - gzip, 2 - snappy, 3 - lz4, "
+                                         "4 - streaming lz4.");
+
+DEFINE_RUNTIME_uint64(stream_compression_min_size, 256,
+    "Min size of the message that is compressed by streaming lz4 stream compression, smaller "
+    "messages are sent uncompressed.");
+
+DEFINE_NON_RUNTIME_string(stream_compression_dictionary_file, "",
+    "File with the dictionary for streaming lz4 stream compression, e.g. trained on sample "
+    "RPC payloads. The last 64KB of the file are used. Both sides of the connection should use "
+    "the same dictionary, otherwise connection is failed.");
 
 namespace yb {
 namespace rpc {
@@ -728,8 +745,325 @@ class LZ4Compressor : public Compressor {
   ScopedTrackedConsumption consumption_;
 };
 
+// Streaming LZ4 compressor, chunks of the same direction share compression history, so
+// repetitive data of consequent messages is also compressed. Messages smaller than
+// stream_compression_min_size are sent uncompressed. Optionally history is initialized
+// with the dictionary from stream_compression_dictionary_file.
+//
+// Each chunk has 3 bytes header: chunk type and big endian 2 bytes length of the chunk body.
+// The first chunk of each direction is kDictionary, with 4 bytes dictionary id, 0 when there is
+// no dictionary. Server side uses the dictionary announced by the client.
+constexpr size_t kLZ4StreamHeaderLen = 3;
+constexpr size_t kLZ4StreamChunkSize = 16_KB;
+// LZ4 requires input history to stay in place, so compressed data is copied to the ring buffer,
+// LZ4 handles the case when the next chunk overwrites the history.
+constexpr size_t kLZ4StreamCompressRingBufferSize = 64_KB + kLZ4StreamChunkSize;
+// Minimal size of the decompression ring buffer, that is not synchronized with the compression
+// one, see LZ4_DECODER_RING_BUFFER_SIZE.
+constexpr size_t kLZ4StreamDecompressRingBufferSize = 64_KB + 14 + kLZ4StreamChunkSize;
+
+YB_DEFINE_ENUM(LZ4StreamChunkType, (kDictionary)(kRaw)(kCompressed));
+
+struct LZ4StreamDictionary {
+  uint32_t id;
+  std::string data;
+};
+
+using LZ4StreamDictionaryPtr = std::shared_ptr<const LZ4StreamDictionary>;
+
+// Loads dictionary from the specified file, nullptr if file is not specified.
+Result<LZ4StreamDictionaryPtr> LoadLZ4StreamDictionary() {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, LZ4StreamDictionaryPtr> dictionaries;
+
+  const auto path = FLAGS_stream_compression_dictionary_file;
+  if (path.empty()) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& result = dictionaries[path];
+  if (!result) {
+    faststring data;
+    RETURN_NOT_OK(ReadFileToString(Env::Default(), path, &data));
+    // LZ4 uses only the last 64KB of dictionary.
+    size_t size = std::min<size_t>(data.size(), 64_KB);
+    auto dictionary = std::make_shared<LZ4StreamDictionary>();
+    dictionary->data.assign(data.c_str() + data.size() - size, size);
+    dictionary->id = crc::Crc32c(dictionary->data.data(), dictionary->data.size());
+    // 0 is reserved for absent dictionary.
+    dictionary->id = std::max<uint32_t>(dictionary->id, 1);
+    result = std::move(dictionary);
+  }
+  return result;
+}
+
+// Returns slice for [begin, end) range of data, copying it to buffer when range is not
+// contiguous.
+Slice IoVecsRange(const IoVecs& data, size_t begin, size_t end, char* buffer) {
+  size_t offset = 0;
+  for (const auto& block : data) {
+    if (begin >= offset && end <= offset + block.iov_len) {
+      return Slice(IoVecBegin(block) + begin - offset, end - begin);
+    }
+    offset += block.iov_len;
+  }
+  IoVecsToBuffer(data, begin, end, buffer);
+  return Slice(buffer, end - begin);
+}
+
+// Fills read buffer io vecs with provided data.
+class IoVecsWriter {
+ public:
+  explicit IoVecsWriter(IoVecs vecs) : vecs_(std::move(vecs)), it_(vecs_.begin()) {}
+
+  // Removes written prefix from data.
+  void Write(Slice* data) {
+    while (!data->empty() && it_ != vecs_.end()) {
+      size_t len = std::min(data->size(), it_->iov_len);
+      memcpy(it_->iov_base, data->data(), len);
+      IoVecRemovePrefix(len, &*it_);
+      data->remove_prefix(len);
+      appended_ += len;
+      if (it_->iov_len == 0) {
+        ++it_;
+      }
+    }
+  }
+
+  size_t appended() const {
+    return appended_;
+  }
+
+ private:
+  IoVecs vecs_;
+  IoVecs::iterator it_;
+  size_t appended_ = 0;
+};
+
+class LZ4StreamCompressor : public Compressor {
+ public:
+  static constexpr char kId = 'C';
+  static constexpr int kIndex = 4;
+  static constexpr size_t kHeaderLen = kLZ4StreamHeaderLen;
+
+  explicit LZ4StreamCompressor(MemTrackerPtr mem_tracker)
+      : decompress_input_buf_(kHeaderLen + LZ4_compressBound(narrow_cast<int>(kLZ4StreamChunkSize))) {
+    if (mem_tracker) {
+      consumption_ = ScopedTrackedConsumption(
+          std::move(mem_tracker),
+          kLZ4StreamCompressRingBufferSize + kLZ4StreamDecompressRingBufferSize +
+              decompress_input_buf_.size());
+    }
+  }
+
+  ~LZ4StreamCompressor() {
+    if (encode_stream_) {
+      LZ4_freeStream(encode_stream_);
+    }
+    if (decode_stream_) {
+      LZ4_freeStreamDecode(decode_stream_);
+    }
+  }
+
+  OutboundDataPtr ConnectionHeader() override {
+    return GetConnectionHeader<LZ4StreamCompressor>();
+  }
+
+  Status Init() override {
+    encode_stream_ = LZ4_createStream();
+    decode_stream_ = LZ4_createStreamDecode();
+    if (!encode_stream_ || !decode_stream_) {
+      return STATUS(RuntimeError, "Failed to create LZ4 stream");
+    }
+    local_dictionary_ = VERIFY_RESULT(LoadLZ4StreamDictionary());
+    return Status::OK();
+  }
+
+  std::string ToString() const override {
+    return "LZ4Stream";
+  }
+
+  Status Compress(
+      const SmallRefCntBuffers& input, RefinedStream* stream, OutboundDataPtr data) override {
+    if (!dictionary_sent_) {
+      RETURN_NOT_OK(SendDictionary(stream));
+    }
+    const bool compress = TotalLen(input) >= FLAGS_stream_compression_min_size;
+    // Increment iterator in loop body to be able to check whether it is last iteration or not.
+    for (auto input_it = input.begin(); input_it != input.end();) {
+      Slice input_slice = input_it->AsSlice();
+      ++input_it;
+      while (!input_slice.empty()) {
+        auto chunk = input_slice.Prefix(std::min(input_slice.size(), kLZ4StreamChunkSize));
+        input_slice.remove_prefix(chunk.size());
+        auto output = compress ? VERIFY_RESULT(CompressChunk(chunk))
+                               : MakeChunk(LZ4StreamChunkType::kRaw, chunk);
+        RETURN_NOT_OK(stream->SendToLower(std::make_shared<SingleBufferOutboundData>(
+            std::move(output),
+            // We processed last buffer, attach data to it, so it will be notified when this buffer
+            // is transferred.
+            input_slice.empty() && input_it == input.end() ? std::move(data) : nullptr)));
+      }
+    }
+
+    return Status::OK();
+  }
+
+  Result<ReadBufferFull> Decompress(StreamReadBuffer* inp, StreamReadBuffer* out) override {
+    IoVecsWriter writer(VERIFY_RESULT(out->PrepareAppend()));
+    // Data decompressed by the previous call, that did not fit into output buffer.
+    writer.Write(&pending_output_);
+
+    auto input = inp->AppendedVecs();
+    const size_t input_size = IoVecsFullSize(input);
+    size_t consumed = 0;
+    while (pending_output_.empty() && input_size >= consumed + kHeaderLen) {
+      char header[kHeaderLen];
+      IoVecsToBuffer(input, consumed, consumed + kHeaderLen, header);
+      size_t size = BigEndian::Load16(header + 1);
+      if (input_size < consumed + kHeaderLen + size) {
+        break;
+      }
+      auto chunk = IoVecsRange(
+          input, consumed + kHeaderLen, consumed + kHeaderLen + size,
+          decompress_input_buf_.data());
+      consumed += kHeaderLen + size;
+      switch (static_cast<uint8_t>(header[0])) {
+        case to_underlying(LZ4StreamChunkType::kDictionary):
+          RETURN_NOT_OK(ReceiveDictionary(chunk));
+          break;
+        case to_underlying(LZ4StreamChunkType::kRaw):
+          writer.Write(&chunk);
+          if (!chunk.empty()) {
+            // Input is consumed, so have to keep remaining data in our own buffer.
+            memmove(decompress_input_buf_.data(), chunk.data(), chunk.size());
+            pending_output_ = Slice(decompress_input_buf_.data(), chunk.size());
+          }
+          break;
+        case to_underlying(LZ4StreamChunkType::kCompressed):
+          pending_output_ = VERIFY_RESULT(DecompressChunk(chunk));
+          writer.Write(&pending_output_);
+          break;
+        default:
+          return STATUS_FORMAT(
+              Corruption, "Unknown LZ4 stream chunk type: $0", static_cast<int>(header[0]));
+      }
+    }
+
+    out->DataAppended(writer.appended());
+    inp->Consume(consumed, Slice());
+    return ReadBufferFull(out->Full());
+  }
+
+ private:
+  static RefCntBuffer MakeChunk(LZ4StreamChunkType type, Slice body) {
+    RefCntBuffer result(kHeaderLen + body.size());
+    result.data()[0] = to_underlying(type);
+    BigEndian::Store16(result.data() + 1, narrow_cast<uint16_t>(body.size()));
+    body.CopyTo(result.data() + kHeaderLen);
+    return result;
+  }
+
+  Status SendDictionary(RefinedStream* stream) {
+    // Server side receives the dictionary id before the first call, so it uses the same
+    // dictionary as client.
+    if (!dictionary_received_) {
+      encode_dictionary_ = local_dictionary_;
+    }
+    char body[sizeof(uint32_t)];
+    BigEndian::Store32(body, encode_dictionary_ ? encode_dictionary_->id : 0);
+    if (encode_dictionary_) {
+      LZ4_loadDict(
+          encode_stream_, encode_dictionary_->data.data(),
+          narrow_cast<int>(encode_dictionary_->data.size()));
+    }
+    dictionary_sent_ = true;
+    return stream->SendToLower(std::make_shared<SingleBufferOutboundData>(
+        MakeChunk(LZ4StreamChunkType::kDictionary, Slice(body, sizeof(body))), nullptr));
+  }
+
+  Status ReceiveDictionary(Slice body) {
+    if (dictionary_received_ || body.size() != sizeof(uint32_t)) {
+      return STATUS(Corruption, "Unexpected LZ4 stream dictionary chunk");
+    }
+    auto id = BigEndian::Load32(body.data());
+    if (id != 0) {
+      if (!local_dictionary_ || local_dictionary_->id != id) {
+        return STATUS_FORMAT(
+            NotSupported, "Unknown LZ4 stream dictionary $0, local dictionary: $1", id,
+            local_dictionary_ ? local_dictionary_->id : 0);
+      }
+      if (!dictionary_sent_) {
+        encode_dictionary_ = local_dictionary_;
+      }
+      decode_dictionary_ = local_dictionary_;
+      LZ4_setStreamDecode(
+          decode_stream_, decode_dictionary_->data.data(),
+          narrow_cast<int>(decode_dictionary_->data.size()));
+    }
+    dictionary_received_ = true;
+    return Status::OK();
+  }
+
+  Result<RefCntBuffer> CompressChunk(Slice chunk) {
+    // LZ4 requires history to stay in place, so input is copied to the ring buffer.
+    char* input = compress_ring_buf_ + compress_ring_pos_;
+    chunk.CopyTo(input);
+    auto bound = LZ4_compressBound(narrow_cast<int>(chunk.size()));
+    RefCntBuffer output(kHeaderLen + bound);
+    int res = LZ4_compress_fast_continue(
+        encode_stream_, input, output.data() + kHeaderLen, narrow_cast<int>(chunk.size()), bound,
+        /* acceleration= */ 1);
+    if (res <= 0) {
+      return STATUS_FORMAT(RuntimeError, "LZ4 compression failed: $0", res);
+    }
+    AdvanceRingPos(chunk.size(), kLZ4StreamCompressRingBufferSize, &compress_ring_pos_);
+    output.data()[0] = to_underlying(LZ4StreamChunkType::kCompressed);
+    BigEndian::Store16(output.data() + 1, res);
+    output.Shrink(kHeaderLen + res);
+    return output;
+  }
+
+  // Returns decompressed data, that stays valid until the next chunk is decompressed.
+  Result<Slice> DecompressChunk(Slice chunk) {
+    char* output = decompress_ring_buf_ + decompress_ring_pos_;
+    int res = LZ4_decompress_safe_continue(
+        decode_stream_, chunk.cdata(), output, narrow_cast<int>(chunk.size()),
+        narrow_cast<int>(kLZ4StreamChunkSize));
+    if (res < 0) {
+      return STATUS_FORMAT(RuntimeError, "LZ4 decompression failed: $0", res);
+    }
+    AdvanceRingPos(res, kLZ4StreamDecompressRingBufferSize, &decompress_ring_pos_);
+    return Slice(output, res);
+  }
+
+  // Moves position after the processed chunk, wrapping when the next chunk could not fit.
+  static void AdvanceRingPos(size_t size, size_t ring_size, size_t* pos) {
+    *pos += size;
+    if (*pos + kLZ4StreamChunkSize > ring_size) {
+      *pos = 0;
+    }
+  }
+
+  LZ4_stream_t* encode_stream_ = nullptr;
+  LZ4_streamDecode_t* decode_stream_ = nullptr;
+  LZ4StreamDictionaryPtr local_dictionary_;
+  LZ4StreamDictionaryPtr encode_dictionary_;
+  LZ4StreamDictionaryPtr decode_dictionary_;
+  bool dictionary_sent_ = false;
+  bool dictionary_received_ = false;
+
+  char compress_ring_buf_[kLZ4StreamCompressRingBufferSize];
+  size_t compress_ring_pos_ = 0;
+  char decompress_ring_buf_[kLZ4StreamDecompressRingBufferSize];
+  size_t decompress_ring_pos_ = 0;
+  std::vector<char> decompress_input_buf_;
+  Slice pending_output_;
+  ScopedTrackedConsumption consumption_;
+};
+
 #undef LZ4
-#define YB_COMPRESSION_ALGORITHMS (Zlib)(Snappy)(LZ4)
+#define YB_COMPRESSION_ALGORITHMS (Zlib)(Snappy)(LZ4)(LZ4Stream)
 
 #define YB_CREATE_COMPRESSOR_CASE(r, data, name) \
   case BOOST_PP_CAT(name, Compressor)::data: \
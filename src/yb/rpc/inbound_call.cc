@@ -40,6 +40,7 @@
 #include "yb/rpc/rpc_metrics.h"
 #include "yb/rpc/service_if.h"
 
+#include "yb/util/call_accounting.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
@@ -144,6 +145,18 @@ void InboundCall::RecordCallReceived() {
   LOG_IF_WITH_PREFIX(DFATAL, timing_.time_received.Initialized()) << "Already marked as received";
   VLOG_WITH_PREFIX(4) << "Received";
   timing_.time_received = MonoTime::Now();
+  call_accounting_ = CallAccounting::MaybeCreate();
+  if (call_accounting_) {
+    call_accounting_->EnterPhase(CallPhase::kReactor);
+  }
+}
+
+void InboundCall::RecordCallEnqueued() {
+  timing_.time_enqueued = MonoTime::Now();
+  if (call_accounting_) {
+    call_accounting_->Add(CallPhase::kReactor, timing_.time_enqueued - timing_.time_received);
+    call_accounting_->EnterPhase(CallPhase::kQueue);
+  }
 }
 
 void InboundCall::RecordHandlingStarted(scoped_refptr<Histogram> incoming_queue_time) {
@@ -152,6 +165,9 @@ void InboundCall::RecordHandlingStarted(scoped_refptr<Histogram> incoming_queue_
   LOG_IF_WITH_PREFIX(DFATAL, timing_.time_handled.Initialized()) << "Already marked as started";
   timing_.time_handled = MonoTime::Now();
   VLOG_WITH_PREFIX(4) << "Handling";
+  if (call_accounting_ && timing_.time_enqueued.Initialized()) {
+    call_accounting_->Add(CallPhase::kQueue, timing_.time_handled - timing_.time_enqueued);
+  }
   incoming_queue_time->Increment(
       timing_.time_handled.GetDeltaSince(timing_.time_received).ToMicroseconds());
 }
@@ -69,6 +69,7 @@ class Message;
 
 namespace yb {
 
+class CallAccounting;
 class Histogram;
 class Trace;
 
@@ -76,6 +77,7 @@ namespace rpc {
 
 struct InboundCallTiming {
   MonoTime time_received;   // Time the call was first accepted.
+  MonoTime time_enqueued;   // Time the call was added to the service queue.
   MonoTime time_handled;    // Time the call handler was kicked off.
   MonoTime time_completed;  // Time the call handler completed.
 };
@@ -130,11 +132,20 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
 
   Trace* trace();
 
+  // Phase time accounting of the call, nullptr when the call was not sampled.
+  const scoped_refptr<CallAccounting>& call_accounting() const {
+    return call_accounting_;
+  }
+
   // When this InboundCall was received (instantiated).
   // Should only be called once on a given instance.
   // Not thread-safe. Should only be called by the current "owner" thread.
   void RecordCallReceived();
 
+  // When the call was added to the service queue.
+  // Not thread-safe. Should only be called by the current "owner" thread.
+  void RecordCallEnqueued();
+
   // When RPC call Handle() was called on the server side.
   // Updates the Histogram with time elapsed since the call was received,
   // and should only be called once on a given instance.
@@ -157,6 +168,11 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
   // If the client did not specify a deadline, returns MonoTime::Max().
   virtual CoarseTimePoint GetClientDeadline() const = 0;
 
+  // Scheduling class of the call in the service queue.
+  virtual RpcPriorityClass GetPriorityClass() const {
+    return RpcPriorityClass::kNormal;
+  }
+
   virtual void DoSerialize(boost::container::small_vector_base<RefCntBuffer>* output) = 0;
 
   // Returns the time spent in the service queue -- from the time the call was received, until
@@ -241,6 +257,7 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
 
   // The trace buffer.
   scoped_refptr<Trace> trace_;
+  scoped_refptr<CallAccounting> call_accounting_;
 
   // Timing information related to this RPC call.
   InboundCallTiming timing_;
@@ -30,7 +30,10 @@
 // under the License.
 //
 
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -53,6 +56,9 @@
 METRIC_DECLARE_counter(rpc_connections_accepted);
 METRIC_DECLARE_counter(rpcs_queue_overflow);
 
+DECLARE_bool(rpc_service_priority_scheduling);
+DECLARE_string(rpc_service_max_concurrent_calls);
+
 using std::string;
 using std::shared_ptr;
 using strings::Substitute;
@@ -246,6 +252,126 @@ TEST_F(MultiThreadedRpcTest, TestBlowOutServiceQueue) {
   ASSERT_EQ(1, rpcs_queue_overflow->value());
 }
 
+// Test that calls over the service concurrency limit wait for the running ones, even when the
+// thread pool has free workers.
+TEST_F(MultiThreadedRpcTest, ServiceMaxConcurrentCalls) {
+  constexpr int kCalls = 3;
+  constexpr auto kSleep = 200ms;
+  FLAGS_rpc_service_max_concurrent_calls = "CalculatorService=1";
+
+  MessengerBuilder bld("messenger1");
+  bld.set_metric_entity(metric_entity());
+  std::unique_ptr<Messenger> server_messenger = ASSERT_RESULT(bld.Build());
+
+  Endpoint server_addr;
+  ASSERT_OK(server_messenger->ListenAddress(
+      CreateConnectionContextFactory<YBInboundConnectionContext>(),
+      Endpoint(), &server_addr));
+
+  std::unique_ptr<ServiceIf> service(new GenericCalculatorService());
+  auto service_name = service->service_name();
+  ThreadPool thread_pool("pool", 10UL, kCalls + 1UL);
+  scoped_refptr<ServicePool> service_pool(new ServicePool(10,
+                                                          &thread_pool,
+                                                          &server_messenger->scheduler(),
+                                                          std::move(service),
+                                                          metric_entity()));
+  ASSERT_OK(server_messenger->RegisterService(service_name, service_pool));
+  ASSERT_OK(server_messenger->StartAcceptor());
+
+  const auto sleep_micros = ToMicroseconds(kSleep);
+  auto start = CoarseMonoClock::now();
+  std::vector<std::thread> threads;
+  for (int i = 0; i != kCalls; ++i) {
+    threads.emplace_back([this, server_addr, sleep_micros] {
+      auto client_messenger = CreateAutoShutdownMessengerHolder("Client");
+      Proxy proxy(client_messenger.get(), HostPort::FromBoundEndpoint(server_addr));
+      rpc_test::SleepRequestPB req;
+      req.set_sleep_micros(sleep_micros);
+      rpc_test::SleepResponsePB resp;
+      RpcController controller;
+      controller.set_timeout(10s);
+      ASSERT_OK(proxy.SyncRequest(
+          CalculatorServiceMethods::SleepMethod(), /* method_metrics= */ nullptr, req, &resp,
+          &controller));
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto elapsed = CoarseMonoClock::now() - start;
+  LOG(INFO) << "Elapsed: " << AsString(elapsed);
+  ASSERT_GE(elapsed, kSleep * kCalls);
+
+  server_messenger->UnregisterAllServices();
+  service_pool->Shutdown();
+  thread_pool.Shutdown();
+  server_messenger->Shutdown();
+}
+
+// Test that queued call with higher priority class is handled before the call with lower one,
+// that was received earlier.
+TEST_F(MultiThreadedRpcTest, ServicePriorityScheduling) {
+  constexpr auto kSleep = 300ms;
+  FLAGS_rpc_service_max_concurrent_calls = "CalculatorService=1";
+  FLAGS_rpc_service_priority_scheduling = true;
+
+  MessengerBuilder bld("messenger1");
+  bld.set_metric_entity(metric_entity());
+  std::unique_ptr<Messenger> server_messenger = ASSERT_RESULT(bld.Build());
+
+  Endpoint server_addr;
+  ASSERT_OK(server_messenger->ListenAddress(
+      CreateConnectionContextFactory<YBInboundConnectionContext>(),
+      Endpoint(), &server_addr));
+
+  std::unique_ptr<ServiceIf> service(new GenericCalculatorService());
+  auto service_name = service->service_name();
+  ThreadPool thread_pool("pool", 10UL, 4UL);
+  scoped_refptr<ServicePool> service_pool(new ServicePool(10,
+                                                          &thread_pool,
+                                                          &server_messenger->scheduler(),
+                                                          std::move(service),
+                                                          metric_entity()));
+  ASSERT_OK(server_messenger->RegisterService(service_name, service_pool));
+  ASSERT_OK(server_messenger->StartAcceptor());
+
+  const auto sleep_micros = ToMicroseconds(kSleep);
+  std::mutex mutex;
+  std::vector<RpcPriorityClass> finished;
+  std::vector<std::thread> threads;
+  // The first call occupies the only slot of the service, so the next ones are queued.
+  for (auto priority_class : {RpcPriorityClass::kNormal, RpcPriorityClass::kBackground,
+                              RpcPriorityClass::kHigh}) {
+    threads.emplace_back([this, server_addr, sleep_micros, priority_class, &mutex, &finished] {
+      auto client_messenger = CreateAutoShutdownMessengerHolder("Client");
+      Proxy proxy(client_messenger.get(), HostPort::FromBoundEndpoint(server_addr));
+      rpc_test::SleepRequestPB req;
+      req.set_sleep_micros(sleep_micros);
+      rpc_test::SleepResponsePB resp;
+      RpcController controller;
+      controller.set_timeout(10s);
+      controller.set_priority_class(priority_class);
+      ASSERT_OK(proxy.SyncRequest(
+          CalculatorServiceMethods::SleepMethod(), /* method_metrics= */ nullptr, req, &resp,
+          &controller));
+      std::lock_guard<std::mutex> lock(mutex);
+      finished.push_back(priority_class);
+    });
+    std::this_thread::sleep_for(kSleep / 3);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(AsString(finished), AsString(std::vector<RpcPriorityClass>{
+      RpcPriorityClass::kNormal, RpcPriorityClass::kHigh, RpcPriorityClass::kBackground}));
+
+  server_messenger->UnregisterAllServices();
+  service_pool->Shutdown();
+  thread_pool.Shutdown();
+  server_messenger->Shutdown();
+}
+
 static void HammerServerWithTCPConns(const Endpoint& addr) {
   while (true) {
     Socket socket;
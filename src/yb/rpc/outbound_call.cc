@@ -217,8 +217,15 @@ Status OutboundCall::SetRequestParam(AnyMessageConstPtr req, const MemTrackerPtr
   size_t call_id_size = Output::VarintSize32(call_id_);
   size_t timeout_ms_size = Output::VarintSize32(timeout_ms);
   auto serialized_remote_method = remote_method_->serialized();
-
-  size_t header_pb_len = 1 + call_id_size + serialized_remote_method.size() + 1 + timeout_ms_size;
+  // Normal priority is not sent, to keep the header of regular calls unchanged.
+  auto priority_class = to_underlying(controller_->priority_class());
+  size_t priority_class_size = controller_->priority_class() != RpcPriorityClass::kNormal
+      ? 1 + Output::VarintSize32(priority_class) : 0;
+  auto trace_id = trace_ ? trace_->trace_id() : 0;
+  size_t trace_id_size = trace_id ? 1 + sizeof(trace_id) : 0;
+
+  size_t header_pb_len = 1 + call_id_size + serialized_remote_method.size() + 1 + timeout_ms_size +
+                         priority_class_size + trace_id_size;
   size_t header_size =
       kMsgLengthPrefixLength                            // Int prefix for the total length.
       + CodedOutputStream::VarintSize32(
@@ -242,6 +249,15 @@ Status OutboundCall::SetRequestParam(AnyMessageConstPtr req, const MemTrackerPtr
   dst += serialized_remote_method.size();
   dst = CodedOutputStream::WriteTagToArray(RequestHeader::kTimeoutMillisFieldNumber << 3, dst);
   dst = Output::WriteVarint32ToArray(timeout_ms, dst);
+  if (priority_class_size) {
+    dst = Output::WriteTagToArray(RequestHeader::kPriorityClassFieldNumber << 3, dst);
+    dst = Output::WriteVarint32ToArray(priority_class, dst);
+  }
+  if (trace_id_size) {
+    // 1 is the wire type of fixed64.
+    dst = Output::WriteTagToArray(RequestHeader::kTraceIdFieldNumber << 3 | 1, dst);
+    dst = Output::WriteLittleEndian64ToArray(trace_id, dst);
+  }
 
   DCHECK_EQ(dst - buffer_.udata(), header_size);
 
@@ -329,7 +345,17 @@ bool OutboundCall::SetState(State new_state) {
   }
 }
 
+void OutboundCall::TrackOutstandingBytes(std::shared_ptr<std::atomic<int64_t>> counter) {
+  tracked_request_size_ = buffer_.size();
+  counter->fetch_add(tracked_request_size_, std::memory_order_relaxed);
+  outstanding_bytes_ = std::move(counter);
+}
+
 void OutboundCall::InvokeCallback() {
+  if (outstanding_bytes_) {
+    outstanding_bytes_->fetch_sub(tracked_request_size_, std::memory_order_relaxed);
+    outstanding_bytes_ = nullptr;
+  }
   if (callback_thread_pool_) {
     callback_task_.SetOutboundCall(shared_from(this));
     callback_thread_pool_->Enqueue(&callback_task_);
@@ -557,6 +583,12 @@ Status OutboundCall::InitHeader(RequestHeader* header) {
 
   if (!IsFinished()) {
     header->set_timeout_millis(VERIFY_RESULT(TimeoutMs()));
+    if (controller_->priority_class() != RpcPriorityClass::kNormal) {
+      header->set_priority_class(to_underlying(controller_->priority_class()));
+    }
+  }
+  if (trace_ && trace_->trace_id()) {
+    header->set_trace_id(trace_->trace_id());
   }
   return Status::OK();
 }
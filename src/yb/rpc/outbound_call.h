@@ -33,6 +33,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
 #include <deque>
@@ -63,6 +64,7 @@
 
 #include "yb/util/status_fwd.h"
 #include "yb/util/atomic.h"
+#include "yb/util/lockfree.h"
 #include "yb/util/locks.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/memory/memory_usage.h"
@@ -222,7 +224,7 @@ class InvokeCallbackTask : public rpc::ThreadPoolTask {
 // then passed to the reactor thread to send on the wire. It's typically
 // kept using a shared_ptr because a call may terminate in any number
 // of different threads, making it tricky to enforce single ownership.
-class OutboundCall : public RpcCall {
+class OutboundCall : public RpcCall, public MPSCQueueEntry<OutboundCall> {
  public:
   OutboundCall(const RemoteMethod* remote_method,
                const std::shared_ptr<OutboundCallMetrics>& outbound_call_metrics,
@@ -292,6 +294,24 @@ class OutboundCall : public RpcCall {
     hostname_ = hostname;
   }
 
+  // Used by Reactor to keep the call alive while it is in the lock-free outbound queue.
+  void RetainForQueue(OutboundCallPtr self) {
+    queue_retained_self_ = std::move(self);
+  }
+
+  OutboundCallPtr ReleaseFromQueue() {
+    return std::move(queue_retained_self_);
+  }
+
+  // Size of the serialized request, valid until the request is transferred.
+  size_t request_size() const {
+    return buffer_.size();
+  }
+
+  // Adds bytes of the request to the counter, they are subtracted when the call is finished.
+  // Used by Proxy to pick the least loaded connection.
+  void TrackOutstandingBytes(std::shared_ptr<std::atomic<int64_t>> counter);
+
   void SetThreadPoolFailure(const Status& status) {
     thread_pool_failure_ = status;
   }
@@ -415,6 +435,11 @@ class OutboundCall : public RpcCall {
 
   std::shared_ptr<const OutboundMethodMetrics> method_metrics_;
 
+  std::shared_ptr<std::atomic<int64_t>> outstanding_bytes_;
+  int64_t tracked_request_size_ = 0;
+
+  OutboundCallPtr queue_retained_self_;
+
   DISALLOW_COPY_AND_ASSIGN(OutboundCall);
 };
 
@@ -50,16 +50,47 @@
 
 #include "yb/util/backoff_waiter.h"
 #include "yb/util/countdown_latch.h"
+#include "yb/util/flags.h"
 #include "yb/util/metrics.h"
 #include "yb/util/net/dns_resolver.h"
 #include "yb/util/net/sockaddr.h"
 #include "yb/util/net/socket.h"
 #include "yb/util/result.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status.h"
 
+using namespace yb::size_literals;
+
 DEFINE_int32(num_connections_to_server, 8,
              "Number of underlying connections to each server");
 
+DEFINE_NON_RUNTIME_int32(num_large_payload_connections_to_server, 0,
+    "Number of additional connections to each server, dedicated to calls with requests of at "
+    "least rpc_large_payload_threshold_bytes, so bulk transfers do not delay small calls "
+    "queued on the same socket. 0 sends large calls over the regular connections.");
+
+DEFINE_RUNTIME_uint64(rpc_large_payload_threshold_bytes, 1_MB,
+    "Calls with serialized request of at least this size are sent over the large payload "
+    "connections, when num_large_payload_connections_to_server is set.");
+
+DEFINE_RUNTIME_bool(proxy_pick_least_loaded_connection, false,
+    "Send the call over the connection to the server with the least bytes of outstanding "
+    "requests, instead of round robin.");
+
+namespace {
+
+bool ValidateLargePayloadConnections(const char* flagname, int value) {
+  if (value >= 0 && value <= 128) {
+    return true;
+  }
+  LOG(ERROR) << flagname << " should be in range [0, 128], value " << value << " is invalid";
+  return false;
+}
+
+} // namespace
+
+DEFINE_validator(num_large_payload_connections_to_server, &ValidateLargePayloadConnections);
+
 DEFINE_int32(proxy_resolve_cache_ms, 5000,
              "Time in milliseconds to cache resolution result in Proxy");
 
@@ -89,9 +120,13 @@ Proxy::Proxy(ProxyContext* context,
       latency_hist_(ScopedDnsTracker::active_metric()),
       // Use the context->num_connections_to_server() here as opposed to directly reading the
       // FLAGS_num_connections_to_server, because the flag value could have changed since then.
-      num_connections_to_server_(context_->num_connections_to_server()) {
+      num_connections_to_server_(context_->num_connections_to_server()),
+      num_large_payload_connections_(FLAGS_num_large_payload_connections_to_server),
+      outstanding_bytes_(std::make_shared<std::vector<std::atomic<int64_t>>>(
+          num_connections_to_server_ + num_large_payload_connections_)) {
   VLOG(1) << "Create proxy to " << remote << " with num_connections_to_server="
-          << num_connections_to_server_;
+          << num_connections_to_server_ << ", num_large_payload_connections="
+          << num_large_payload_connections_;
   if (context_->parent_mem_tracker()) {
     mem_tracker_ = MemTracker::FindOrCreateTracker(
         "Queueing", context_->parent_mem_tracker());
@@ -316,12 +351,42 @@ void Proxy::ResolveDone(const Result<IpAddress>& result) {
 }
 
 void Proxy::QueueCall(RpcController* controller, const Endpoint& endpoint) {
-  uint8_t idx = num_calls_.fetch_add(1) % num_connections_to_server_;
+  auto& call = *controller->call_;
+  // Large calls use their own connections, so small calls are not queued behind them.
+  size_t first_idx = 0;
+  size_t num_connections = num_connections_to_server_;
+  if (num_large_payload_connections_ &&
+      call.request_size() >= GetAtomicFlag(&FLAGS_rpc_large_payload_threshold_bytes)) {
+    first_idx = num_connections_to_server_;
+    num_connections = num_large_payload_connections_;
+  }
+  size_t idx = first_idx + num_calls_.fetch_add(1, std::memory_order_relaxed) % num_connections;
+  if (GetAtomicFlag(&FLAGS_proxy_pick_least_loaded_connection)) {
+    idx = PickLeastLoadedConnection(first_idx, num_connections, idx);
+    call.TrackOutstandingBytes(
+        std::shared_ptr<std::atomic<int64_t>>(outstanding_bytes_, &(*outstanding_bytes_)[idx]));
+  }
   ConnectionId conn_id(endpoint, idx, protocol_);
-  controller->call_->SetConnectionId(conn_id, &remote_.host());
+  call.SetConnectionId(conn_id, &remote_.host());
   context_->QueueOutboundCall(controller->call_);
 }
 
+size_t Proxy::PickLeastLoadedConnection(size_t first_idx, size_t num_connections, size_t start) {
+  // Scan starts from the round robin choice, so connections with equal load are used evenly.
+  auto& outstanding_bytes = *outstanding_bytes_;
+  auto result = start;
+  auto min_bytes = outstanding_bytes[start].load(std::memory_order_relaxed);
+  for (size_t i = 1; i < num_connections && min_bytes > 0; ++i) {
+    auto idx = first_idx + (start - first_idx + i) % num_connections;
+    auto bytes = outstanding_bytes[idx].load(std::memory_order_relaxed);
+    if (bytes < min_bytes) {
+      min_bytes = bytes;
+      result = idx;
+    }
+  }
+  return result;
+}
+
 void Proxy::NotifyFailed(RpcController* controller, const Status& status) {
   // We should retain reference to call, so it would not be destroyed during SetFailed.
   auto call = controller->call_;
@@ -36,6 +36,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/lockfree/queue.hpp>
@@ -159,6 +160,9 @@ class Proxy {
   void ResolveDone(const Result<IpAddress>& result);
   void NotifyAllFailed(const Status& status);
   void QueueCall(RpcController* controller, const Endpoint& endpoint);
+  // Returns index of the connection with the least outstanding bytes, among num_connections
+  // connections starting at first_idx.
+  size_t PickLeastLoadedConnection(size_t first_idx, size_t num_connections, size_t start);
   ThreadPool *GetCallbackThreadPool(
       bool force_run_callback_on_reactor, InvokeCallbackMode invoke_callback_mode);
 
@@ -207,6 +211,13 @@ class Proxy {
   // Number of outbound connections to create per each destination server address.
   int num_connections_to_server_;
 
+  // Number of additional connections used for calls with large requests.
+  const int num_large_payload_connections_;
+
+  // Bytes of requests in flight per connection index, tracked when the least loaded connection
+  // is picked. Shared with calls, since they could outlive the proxy.
+  std::shared_ptr<std::vector<std::atomic<int64_t>>> outstanding_bytes_;
+
   std::shared_ptr<MemTracker> mem_tracker_;
 };
 
@@ -41,6 +41,7 @@
 #include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 
 #include <boost/preprocessor/cat.hpp>
 #include <boost/preprocessor/stringize.hpp>
@@ -60,12 +61,14 @@
 #include "yb/util/atomic.h"
 #include "yb/util/countdown_latch.h"
 #include "yb/util/errno.h"
+#include "yb/util/flags.h"
 #include "yb/util/format.h"
 #include "yb/util/logging.h"
 #include "yb/util/memory/memory.h"
 #include "yb/util/metric_entity.h"
 #include "yb/util/monotime.h"
 #include "yb/util/net/socket.h"
+#include "yb/util/numa.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status.h"
@@ -79,8 +82,13 @@ using namespace std::literals;
 
 DEFINE_uint64(rpc_read_buffer_size, 0,
               "RPC connection read buffer size. 0 to auto detect.");
+DEFINE_NON_RUNTIME_bool(rpc_numa_aware_reactors, false,
+    "Bind reactor threads to NUMA nodes in round robin order, so memory of the connections served "
+    "by the reactor is allocated on the node it runs on.");
+
 DECLARE_string(local_ip_for_outbound_sockets);
 DECLARE_int32(num_connections_to_server);
+DECLARE_int32(num_large_payload_connections_to_server);
 DECLARE_int32(socket_receive_buffer_size);
 
 namespace yb {
@@ -135,6 +143,7 @@ Reactor::Reactor(Messenger* messenger,
                  int index,
                  const MessengerBuilder &bld)
     : messenger_(messenger),
+      index_(index),
       name_(StringPrintf("%s_R%03d", messenger->name().c_str(), index)),
       log_prefix_(name_ + ": "),
       loop_(kDefaultLibEvFlags),
@@ -142,7 +151,8 @@ Reactor::Reactor(Messenger* messenger,
       last_unused_tcp_scan_(cur_time_),
       connection_keepalive_time_(bld.connection_keepalive_time()),
       coarse_timer_granularity_(bld.coarse_timer_granularity()),
-      num_connections_to_server_(bld.num_connections_to_server()) {
+      num_connections_to_server_(
+          bld.num_connections_to_server() + FLAGS_num_large_payload_connections_to_server) {
   static std::once_flag libev_once;
   std::call_once(libev_once, DoInitLibEv);
 
@@ -258,11 +268,11 @@ void Reactor::ShutdownInternal() {
 
   VLOG_WITH_PREFIX(1) << "aborting outbound calls";
   CHECK(processing_outbound_queue_.empty()) << yb::ToString(processing_outbound_queue_);
-  {
-    std::lock_guard<simple_spinlock> lock(outbound_queue_lock_);
-    outbound_queue_stopped_ = true;
-    outbound_queue_.swap(processing_outbound_queue_);
+  outbound_queue_stopped_ = true;
+  while (outbound_queue_producers_.load() != 0) {
+    std::this_thread::yield();
   }
+  DrainOutboundQueue();
   for (auto& call : processing_outbound_queue_) {
     call->Transferred(aborted, nullptr);
   }
@@ -495,6 +505,9 @@ void Reactor::RunThread() {
   ThreadRestrictions::SetWaitAllowed(false);
   ThreadRestrictions::SetIOAllowed(false);
   DVLOG_WITH_PREFIX(6) << "Calling Reactor::RunThread()...";
+  if (FLAGS_rpc_numa_aware_reactors) {
+    WARN_NOT_OK(BindCurrentThreadToNumaNode(index_), LogPrefix() + "Bind to NUMA node failed");
+  }
   loop_.run(/* flags */ 0);
   VLOG_WITH_PREFIX(1) << "thread exiting.";
 }
@@ -697,10 +710,7 @@ void Reactor::DestroyConnection(Connection *conn, const Status &conn_status) {
 
 void Reactor::ProcessOutboundQueue() {
   CHECK(processing_outbound_queue_.empty()) << yb::ToString(processing_outbound_queue_);
-  {
-    std::lock_guard<simple_spinlock> lock(outbound_queue_lock_);
-    outbound_queue_.swap(processing_outbound_queue_);
-  }
+  DrainOutboundQueue();
   if (processing_outbound_queue_.empty()) {
     return;
   }
@@ -727,26 +737,29 @@ void Reactor::QueueOutboundCall(OutboundCallPtr call) {
   DVLOG_WITH_PREFIX(3) << "Queueing outbound call "
                        << call->ToString() << " to remote " << call->conn_id().remote();
 
-  bool was_empty = false;
-  bool closing = false;
-  {
-    std::lock_guard<simple_spinlock> lock(outbound_queue_lock_);
-    if (!outbound_queue_stopped_) {
-      was_empty = outbound_queue_.empty();
-      outbound_queue_.push_back(call);
-    } else {
-      closing = true;
-    }
-  }
-  if (closing) {
+  // Stop flag and producers counter use sequentially consistent ordering, so either the producer
+  // sees the stop, or shutdown waits for its push to complete before draining the queue.
+  ++outbound_queue_producers_;
+  if (outbound_queue_stopped_.load()) {
+    --outbound_queue_producers_;
     call->Transferred(AbortedError(), nullptr /* conn */);
     return;
   }
+  TRACE_TO(call->trace(), "Scheduled.");
+  auto* raw_call = call.get();
+  raw_call->RetainForQueue(std::move(call));
+  bool was_empty = outbound_queue_.Push(raw_call);
+  --outbound_queue_producers_;
   if (was_empty) {
     auto scheduled = ScheduleReactorTask(process_outbound_queue_task_);
     LOG_IF_WITH_PREFIX(WARNING, !scheduled) << "Failed to schedule process outbound queue task";
   }
-  TRACE_TO(call->trace(), "Scheduled.");
+}
+
+void Reactor::DrainOutboundQueue() {
+  while (auto* call = outbound_queue_.Pop()) {
+    processing_outbound_queue_.push_back(call->ReleaseFromQueue());
+  }
 }
 
 // ------------------------------------------------------------------------------------------------
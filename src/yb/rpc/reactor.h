@@ -430,6 +430,9 @@ class Reactor {
 
   void ProcessOutboundQueue();
 
+  // Moves calls from outbound_queue_ to processing_outbound_queue_.
+  void DrainOutboundQueue();
+
   void CheckReadyToStop();
 
   // Drains the pending_tasks_ queue into async_handler_tasks_. Returns true if the reactor is
@@ -444,6 +447,8 @@ class Reactor {
   // parent messenger
   Messenger* const messenger_;
 
+  const int index_;
+
   const std::string name_;
 
   const std::string log_prefix_;
@@ -502,8 +507,14 @@ class Reactor {
   // Scan for idle connections on this granularity.
   CoarseMonoClock::Duration coarse_timer_granularity_;
 
-  simple_spinlock outbound_queue_lock_;
-  bool outbound_queue_stopped_ = false;
+  // Outbound calls queued by other threads, processed in batches by ProcessOutboundQueue.
+  // Only the first call of the batch schedules the processing task, i.e. wakes up the reactor.
+  MPSCQueue<OutboundCall> outbound_queue_;
+
+  // Number of threads pushing to outbound_queue_. Shutdown waits for it to become zero after
+  // setting outbound_queue_stopped_, so calls pushed concurrently with stop are not lost.
+  std::atomic<int64_t> outbound_queue_producers_{0};
+  std::atomic<bool> outbound_queue_stopped_{false};
 
   // We found that we should shut down, but not all connections are ready for it.  Only accessed in
   // the reactor thread.
@@ -511,7 +522,6 @@ class Reactor {
 
   CoarseTimePoint stop_start_time_;
 
-  std::vector<OutboundCallPtr> outbound_queue_;
 
   // Outbound calls currently being processed. Only accessed on the reactor thread. Could be a local
   // variable, but implemented as a member field as an optimization to avoid memory allocation.
@@ -520,7 +530,8 @@ class Reactor {
   std::vector<ConnectionPtr> processing_connections_;
   ReactorTaskPtr process_outbound_queue_task_;
 
-  // Number of outbound connections to create per each destination server address.
+  // Number of outbound connections to create per each destination server address, including
+  // connections dedicated to large payload calls.
   int num_connections_to_server_;
 };
 
@@ -30,19 +30,35 @@
 // under the License.
 //
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <thread>
 
 #include <gtest/gtest.h>
 
+#include "yb/gutil/casts.h"
+#include "yb/gutil/strings/split.h"
+
+#include "yb/rpc/compressed_stream.h"
 #include "yb/rpc/proxy.h"
 #include "yb/rpc/rpc-test-base.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/rpc/rtest.proxy.h"
+#include "yb/rpc/secure_stream.h"
+#include "yb/rpc/tcp_stream.h"
 
 #include "yb/util/countdown_latch.h"
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/jsonwriter.h"
+#include "yb/util/mem_tracker.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/random_util.h"
+#include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
+#include "yb/util/stol_utils.h"
+#include "yb/util/stopwatch.h"
 #include "yb/util/test_util.h"
 #include "yb/util/thread.h"
 
@@ -51,9 +67,141 @@ using namespace std::literals; // NOLINT
 using std::string;
 using std::shared_ptr;
 
+DEFINE_string(rpc_bench_streams, "plain,tls,zlib,snappy,lz4,lz4stream",
+              "Comma separated list of streams used by BenchmarkSuite. Stream is one of plain, tls, "
+              "zlib, snappy, lz4, lz4stream. Compression could be combined with TLS, e.g. tls+lz4.");
+DEFINE_string(rpc_bench_payload_sizes, "64,16384,1048576",
+              "Comma separated list of payload sizes in bytes used by BenchmarkSuite.");
+DEFINE_string(rpc_bench_transfers, "echo,sidecar",
+              "Comma separated list of payload transfer modes used by BenchmarkSuite. echo - "
+              "payload is sent in both request and response protobufs, sidecar - payload is "
+              "returned as a response sidecar.");
+DEFINE_string(rpc_bench_concurrency, "16",
+              "Comma separated list of numbers of concurrent client threads used by "
+              "BenchmarkSuite.");
+DEFINE_string(rpc_bench_connections, "1,4",
+              "Comma separated list of numbers of connections to server used by BenchmarkSuite.");
+DEFINE_int32(rpc_bench_client_reactors, 4, "Number of client reactors used by BenchmarkSuite.");
+DEFINE_int32(rpc_bench_server_worker_threads, 4,
+             "Number of server worker threads used by BenchmarkSuite.");
+DEFINE_int32(rpc_bench_warmup_ms, 200, "Warmup time of each BenchmarkSuite case.");
+DEFINE_int32(rpc_bench_case_duration_ms, 1000, "Measured time of each BenchmarkSuite case.");
+DEFINE_string(rpc_bench_output_file, "",
+              "When not empty, BenchmarkSuite results are appended to this file, one JSON object "
+              "per line.");
+
+DECLARE_int32(stream_compression_algo);
+
 namespace yb {
 namespace rpc {
 
+namespace {
+
+struct BenchStream {
+  std::string name;
+  bool tls = false;
+  // Value of stream_compression_algo, 0 when compression is not used.
+  int compression_algo = 0;
+};
+
+Result<BenchStream> ParseBenchStream(const std::string& name) {
+  static const std::vector<std::string> kCompressionAlgos = {
+      "zlib", "snappy", "lz4", "lz4stream" };
+
+  BenchStream result = { .name = name };
+  Slice left(name);
+  if (left.starts_with("tls")) {
+    result.tls = true;
+    left.remove_prefix(3);
+    if (left.empty()) {
+      return result;
+    }
+    if (!left.starts_with("+")) {
+      return STATUS_FORMAT(InvalidArgument, "Unknown stream: $0", name);
+    }
+    left.remove_prefix(1);
+  } else if (left == "plain") {
+    return result;
+  }
+  auto it = std::find(kCompressionAlgos.begin(), kCompressionAlgos.end(), left.ToBuffer());
+  if (it == kCompressionAlgos.end()) {
+    return STATUS_FORMAT(InvalidArgument, "Unknown stream: $0", name);
+  }
+  // Compression algorithms are numbered starting from 1.
+  result.compression_algo = narrow_cast<int>(it - kCompressionAlgos.begin() + 1);
+  return result;
+}
+
+std::vector<std::string> SplitList(const std::string& list) {
+  return strings::Split(list, ",", strings::SkipEmpty());
+}
+
+template <class Int>
+std::vector<Int> ParseIntList(const std::string& list) {
+  std::vector<Int> result;
+  for (const auto& str : SplitList(list)) {
+    result.push_back(narrow_cast<Int>(CHECK_RESULT(CheckedStoll(str))));
+  }
+  return result;
+}
+
+struct BenchCase {
+  BenchStream stream;
+  bool sidecar;
+  size_t payload_size;
+  int concurrency;
+  int connections;
+};
+
+struct BenchResult {
+  uint64_t calls = 0;
+  double calls_per_second = 0;
+  uint64_t latency_p50_us = 0;
+  uint64_t latency_p99_us = 0;
+  uint64_t latency_p999_us = 0;
+  uint64_t latency_max_us = 0;
+  double user_cpu_us_per_call = 0;
+  double sys_cpu_us_per_call = 0;
+};
+
+std::string BenchResultToJson(const BenchCase& bench_case, const BenchResult& result) {
+  std::stringstream out;
+  JsonWriter writer(&out, JsonWriter::COMPACT);
+  writer.StartObject();
+  writer.String("stream");
+  writer.String(bench_case.stream.name);
+  writer.String("transfer");
+  writer.String(bench_case.sidecar ? "sidecar" : "echo");
+  writer.String("payload_size");
+  writer.Uint64(bench_case.payload_size);
+  writer.String("concurrency");
+  writer.Int(bench_case.concurrency);
+  writer.String("connections");
+  writer.Int(bench_case.connections);
+  writer.String("calls");
+  writer.Uint64(result.calls);
+  writer.String("calls_per_second");
+  writer.Double(result.calls_per_second);
+  writer.String("payload_bytes_per_second");
+  writer.Double(result.calls_per_second * bench_case.payload_size);
+  writer.String("latency_p50_us");
+  writer.Uint64(result.latency_p50_us);
+  writer.String("latency_p99_us");
+  writer.Uint64(result.latency_p99_us);
+  writer.String("latency_p999_us");
+  writer.Uint64(result.latency_p999_us);
+  writer.String("latency_max_us");
+  writer.Uint64(result.latency_max_us);
+  writer.String("user_cpu_us_per_call");
+  writer.Double(result.user_cpu_us_per_call);
+  writer.String("sys_cpu_us_per_call");
+  writer.Double(result.sys_cpu_us_per_call);
+  writer.EndObject();
+  return out.str();
+}
+
+} // namespace
+
 class RpcBench : public RpcTestBase {
  public:
   RpcBench() {}
@@ -61,10 +209,138 @@ class RpcBench : public RpcTestBase {
  protected:
   friend class ClientThread;
 
+  std::unique_ptr<Messenger> CreateBenchMessenger(
+      const std::string& name, const MessengerOptions& options, const BenchStream& stream);
+
+  BenchResult RunCase(const BenchCase& bench_case);
+
   HostPort server_hostport_;
   std::atomic<bool> should_run_{true};
+  std::unique_ptr<SecureContext> secure_context_;
 };
 
+std::unique_ptr<Messenger> RpcBench::CreateBenchMessenger(
+    const std::string& name, const MessengerOptions& options, const BenchStream& stream) {
+  auto builder = CreateMessengerBuilder(name, options);
+  auto factory = TcpStream::Factory();
+  if (stream.tls) {
+    if (!secure_context_) {
+      secure_context_ = std::make_unique<SecureContext>(
+          RequireClientCertificate::kFalse, UseClientCertificate::kFalse);
+      CHECK_OK(secure_context_->TEST_GenerateKeys(
+          1024, "127.0.0.1", MatchingCertKeyPair::kTrue));
+    }
+    factory = SecureStreamFactory(
+        std::move(factory), MemTracker::GetRootTracker(), secure_context_.get());
+    if (!stream.compression_algo) {
+      builder.SetListenProtocol(SecureStreamProtocol());
+      builder.AddStreamFactory(SecureStreamProtocol(), std::move(factory));
+    }
+  }
+  if (stream.compression_algo) {
+    // Compression algorithm is picked when the connection is created, so both server and client
+    // messengers would use it.
+    FLAGS_stream_compression_algo = stream.compression_algo;
+    builder.SetListenProtocol(CompressedStreamProtocol());
+    builder.AddStreamFactory(
+        CompressedStreamProtocol(),
+        CompressedStreamFactory(std::move(factory), MemTracker::GetRootTracker()));
+  }
+  return CHECK_RESULT(builder.Build());
+}
+
+// CPU time is measured for the whole process, so it includes both client and server side.
+BenchResult RpcBench::RunCase(const BenchCase& bench_case) {
+  TestServerOptions server_options;
+  server_options.n_worker_threads = FLAGS_rpc_bench_server_worker_threads;
+  TestServer server(
+      CreateBenchMessenger("TestServer", server_options.messenger_options, bench_case.stream),
+      server_options);
+  CHECK_OK(server.RegisterService(std::make_unique<GenericCalculatorService>()));
+  CHECK_OK(server.Start());
+
+  MessengerOptions client_options = kDefaultClientMessengerOptions;
+  client_options.n_reactors = FLAGS_rpc_bench_client_reactors;
+  client_options.num_connections_to_server = bench_case.connections;
+  auto client_messenger = rpc::CreateAutoShutdownMessengerHolder(
+      CreateBenchMessenger("Client", client_options, bench_case.stream));
+  Proxy proxy(
+      client_messenger.get(), HostPort::FromBoundEndpoint(server.bound_endpoint()),
+      client_messenger->DefaultProtocol());
+
+  // Human readable payload, so compression has something to work with.
+  const auto payload = RandomHumanReadableString(bench_case.payload_size);
+  HdrHistogram latency_us(60000000, 3);
+  std::atomic<bool> recording{false};
+  std::atomic<bool> stop{false};
+
+  auto call = [&proxy, &bench_case, &payload]() {
+    RpcController controller;
+    controller.set_timeout(10s);
+    if (bench_case.sidecar) {
+      rpc_test::SendStringsRequestPB req;
+      req.set_random_seed(narrow_cast<uint32_t>(bench_case.payload_size));
+      req.add_sizes(bench_case.payload_size);
+      rpc_test::SendStringsResponsePB resp;
+      CHECK_OK(proxy.SyncRequest(
+          CalculatorServiceMethods::SendStringsMethod(), /* method_metrics= */ nullptr, req,
+          &resp, &controller));
+      CHECK_EQ(resp.sidecars_size(), 1);
+      CHECK_EQ(CHECK_RESULT(controller.GetSidecar(narrow_cast<int>(resp.sidecars(0)))).size(),
+               bench_case.payload_size);
+    } else {
+      rpc_test::EchoRequestPB req;
+      req.set_data(payload);
+      rpc_test::EchoResponsePB resp;
+      CHECK_OK(proxy.SyncRequest(
+          CalculatorServiceMethods::EchoMethod(), /* method_metrics= */ nullptr, req, &resp,
+          &controller));
+      CHECK_EQ(resp.data().size(), bench_case.payload_size);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i != bench_case.concurrency; ++i) {
+    threads.emplace_back([&call, &latency_us, &recording, &stop] {
+      CDSAttacher attacher;
+      while (!stop.load(std::memory_order_acquire)) {
+        auto start = MonoTime::Now();
+        call();
+        auto passed = MonoTime::Now() - start;
+        if (recording.load(std::memory_order_acquire)) {
+          latency_us.Increment(passed.ToMicroseconds());
+        }
+      }
+    });
+  }
+
+  std::this_thread::sleep_for(FLAGS_rpc_bench_warmup_ms * 1ms);
+  Stopwatch sw(Stopwatch::ALL_THREADS);
+  sw.start();
+  recording.store(true, std::memory_order_release);
+  std::this_thread::sleep_for(FLAGS_rpc_bench_case_duration_ms * 1ms);
+  recording.store(false, std::memory_order_release);
+  sw.stop();
+  stop.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  BenchResult result;
+  result.calls = latency_us.TotalCount();
+  if (result.calls == 0) {
+    return result;
+  }
+  result.calls_per_second = result.calls / sw.elapsed().wall_seconds();
+  result.latency_p50_us = latency_us.ValueAtPercentile(50);
+  result.latency_p99_us = latency_us.ValueAtPercentile(99);
+  result.latency_p999_us = latency_us.ValueAtPercentile(99.9);
+  result.latency_max_us = latency_us.MaxValue();
+  result.user_cpu_us_per_call = sw.elapsed().user / 1000.0 / result.calls;
+  result.sys_cpu_us_per_call = sw.elapsed().system / 1000.0 / result.calls;
+  return result;
+}
+
 class ClientThread {
  public:
   explicit ClientThread(RpcBench *bench)
@@ -155,6 +431,55 @@ TEST_F(RpcBench, BenchmarkCalls) {
   LOG(INFO) << "Sys CPU per req:  " << sys_cpu_micros_per_req << "us";
 }
 
+// Sweeps streams, transfer modes, payload sizes, concurrency and number of connections specified
+// by the rpc_bench_* flags. Results of each case are logged and optionally written to
+// rpc_bench_output_file as JSON lines.
+TEST_F(RpcBench, BenchmarkSuite) {
+  std::vector<BenchStream> streams;
+  for (const auto& name : SplitList(FLAGS_rpc_bench_streams)) {
+    streams.push_back(ASSERT_RESULT(ParseBenchStream(name)));
+  }
+  std::vector<bool> transfers;
+  for (const auto& name : SplitList(FLAGS_rpc_bench_transfers)) {
+    ASSERT_TRUE(name == "echo" || name == "sidecar") << "Unknown transfer: " << name;
+    transfers.push_back(name == "sidecar");
+  }
+  auto payload_sizes = ParseIntList<size_t>(FLAGS_rpc_bench_payload_sizes);
+  auto concurrencies = ParseIntList<int>(FLAGS_rpc_bench_concurrency);
+  auto connections = ParseIntList<int>(FLAGS_rpc_bench_connections);
+
+  std::ofstream output;
+  if (!FLAGS_rpc_bench_output_file.empty()) {
+    output.open(FLAGS_rpc_bench_output_file, std::ios_base::app);
+    ASSERT_TRUE(output.good()) << "Failed to open " << FLAGS_rpc_bench_output_file;
+  }
+
+  auto old_compression_algo = FLAGS_stream_compression_algo;
+  for (const auto& stream : streams) {
+    for (auto sidecar : transfers) {
+      for (auto payload_size : payload_sizes) {
+        for (auto concurrency : concurrencies) {
+          for (auto num_connections : connections) {
+            BenchCase bench_case = {
+              .stream = stream,
+              .sidecar = sidecar,
+              .payload_size = payload_size,
+              .concurrency = concurrency,
+              .connections = num_connections,
+            };
+            auto json = BenchResultToJson(bench_case, RunCase(bench_case));
+            LOG(INFO) << "Bench result: " << json;
+            if (output.is_open()) {
+              output << json << std::endl;
+            }
+          }
+        }
+      }
+    }
+  }
+  FLAGS_stream_compression_algo = old_compression_algo;
+}
+
 } // namespace rpc
 } // namespace yb
 
@@ -66,6 +66,7 @@
 #include "yb/util/format.h"
 #include "yb/util/logging_test_util.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/path_util.h"
 #include "yb/util/result.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
@@ -88,11 +89,16 @@ DECLARE_bool(TEST_pause_calculator_echo_request);
 DECLARE_bool(binary_call_parser_reject_on_mem_tracker_hard_limit);
 DECLARE_bool(enable_rpc_keepalive);
 DECLARE_int32(num_connections_to_server);
+DECLARE_int32(num_large_payload_connections_to_server);
+DECLARE_bool(proxy_pick_least_loaded_connection);
+DECLARE_uint64(rpc_large_payload_threshold_bytes);
 DECLARE_int64(rpc_throttle_threshold_bytes);
 DECLARE_int32(stream_compression_algo);
+DECLARE_string(stream_compression_dictionary_file);
 DECLARE_int64(memory_limit_hard_bytes);
 DECLARE_string(vmodule);
 DECLARE_uint64(rpc_connection_timeout_ms);
+DECLARE_uint64(rpc_min_shared_call_size);
 DECLARE_uint64(rpc_read_buffer_size);
 
 using namespace std::chrono_literals;
@@ -463,6 +469,46 @@ TEST_F(TestRpc, TestConnectionHeartbeating) {
   }
 }
 
+// Test that calls with large requests are sent over the dedicated connection.
+TEST_F(TestRpc, LargePayloadConnections) {
+  FLAGS_num_connections_to_server = 1;
+  FLAGS_num_large_payload_connections_to_server = 1;
+  FLAGS_rpc_large_payload_threshold_bytes = 1_KB;
+  FLAGS_proxy_pick_least_loaded_connection = true;
+
+  HostPort server_addr;
+  StartTestServerWithGeneratedCode(&server_addr);
+
+  // Single reactor, so all client connections are visible in its metrics.
+  MessengerOptions messenger_options = { 1, kDefaultClientMessengerOptions.keep_alive_timeout };
+  auto client_messenger = CreateAutoShutdownMessengerHolder("Client", messenger_options);
+  ProxyCache proxy_cache(client_messenger.get());
+  CalculatorServiceProxy proxy(&proxy_cache, server_addr, client_messenger->DefaultProtocol());
+
+  auto echo = [&proxy](size_t size) {
+    RpcController controller;
+    controller.set_timeout(5s * kTimeMultiplier);
+    rpc_test::EchoRequestPB req;
+    req.set_data(RandomHumanReadableString(size));
+    rpc_test::EchoResponsePB resp;
+    ASSERT_OK(proxy.Echo(req, &resp, &controller));
+    ASSERT_EQ(req.data(), resp.data());
+  };
+
+  for (int i = 0; i != 10; ++i) {
+    ASSERT_NO_FATALS(echo(16));
+  }
+  ASSERT_NO_FATALS(CheckClientMessengerConnections(client_messenger.get(), 1));
+
+  ASSERT_NO_FATALS(echo(4_KB));
+  ASSERT_NO_FATALS(CheckClientMessengerConnections(client_messenger.get(), 2));
+
+  for (int i = 0; i != 10; ++i) {
+    ASSERT_NO_FATALS(echo(i % 2 ? 16 : 4_KB));
+  }
+  ASSERT_NO_FATALS(CheckClientMessengerConnections(client_messenger.get(), 2));
+}
+
 // Test that the RpcSidecar transfers the expected messages.
 TEST_F(TestRpc, TestRpcSidecar) {
   // Set up server.
@@ -1216,6 +1262,13 @@ TEST_F(TestRpcSecure, ConcurrentOps) {
   RunSecureTest(&TestConcurrentOps);
 }
 
+// Calls reference the read buffer slabs, instead of copying, so the slabs are switched while
+// responses are in flight.
+TEST_F(TestRpc, ConcurrentOpsWithSharedReadBuffer) {
+  FLAGS_rpc_min_shared_call_size = 1_KB;
+  RunPlainTest(&TestConcurrentOps);
+}
+
 TEST_F(TestRpcSecure, CantAllocateReadBuffer) {
   RunSecureTest(&TestCantAllocateReadBuffer, SetupServerForTestCantAllocateReadBuffer());
 }
@@ -1319,11 +1372,42 @@ std::string CompressionName(const testing::TestParamInfo<int>& info) {
     case 1: return "Zlib";
     case 2: return "Snappy";
     case 3: return "LZ4";
+    case 4: return "LZ4Stream";
   }
   return Format("Unknown compression $0", info.param);
 }
 
-INSTANTIATE_TEST_CASE_P(, TestRpcCompression, testing::Range(1, 4), CompressionName);
+INSTANTIATE_TEST_CASE_P(, TestRpcCompression, testing::Range(1, 5), CompressionName);
+
+class TestRpcCompressionDictionary : public RpcTestBase {
+ public:
+  void SetUp() override {
+    RpcTestBase::SetUp();
+    FLAGS_stream_compression_algo = 4;
+    FLAGS_stream_compression_dictionary_file = JoinPathSegments(
+        GetTestDataDirectory(), "dictionary");
+    ASSERT_OK(WriteStringToFile(
+        env_.get(), RandomHumanReadableString(16_KB), FLAGS_stream_compression_dictionary_file));
+  }
+
+ protected:
+  template <class F>
+  void RunCompressionTest(const F& f) {
+    RunTest(this, TestServerOptions(), [this](
+        const std::string& name, const MessengerOptions& options) {
+      auto builder = CreateMessengerBuilder(name, options);
+      builder.SetListenProtocol(CompressedStreamProtocol());
+      builder.AddStreamFactory(
+          CompressedStreamProtocol(),
+          CompressedStreamFactory(TcpStream::Factory(), MemTracker::GetRootTracker()));
+      return EXPECT_RESULT(builder.Build());
+    }, f);
+  }
+};
+
+TEST_F(TestRpcCompressionDictionary, ConcurrentOps) {
+  RunCompressionTest(&TestConcurrentOps);
+}
 
 class TestRpcSecureCompression : public TestRpcSecure {
  public:
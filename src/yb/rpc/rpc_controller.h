@@ -137,6 +137,14 @@ class RpcController {
 
   InvokeCallbackMode invoke_callback_mode() { return invoke_callback_mode_; }
 
+  // Sets scheduling class of the call in the service queue of the server.
+  // Must be set prior to making the request.
+  void set_priority_class(RpcPriorityClass priority_class) {
+    priority_class_ = priority_class;
+  }
+
+  RpcPriorityClass priority_class() const { return priority_class_; }
+
   // Return the configured timeout.
   MonoDelta timeout() const;
 
@@ -165,6 +173,7 @@ class RpcController {
   OutboundCallPtr call_;
   bool allow_local_calls_in_curr_thread_ = false;
   InvokeCallbackMode invoke_callback_mode_ = InvokeCallbackMode::kThreadPoolNormal;
+  RpcPriorityClass priority_class_ = RpcPriorityClass::kNormal;
 
   DISALLOW_COPY_AND_ASSIGN(RpcController);
 };
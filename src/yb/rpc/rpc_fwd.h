@@ -138,6 +138,15 @@ using ResponseCallback = std::function<void()>;
 
 YB_DEFINE_ENUM(ServicePriority, (kNormal)(kHigh));
 
+// Scheduling class of the call in the service queue, passed in the request header.
+// Values are sent over the wire, so new classes should be appended only.
+YB_DEFINE_ENUM(RpcPriorityClass,
+    // Long running maintenance calls, like backfill and CDC polling.
+    (kBackground)
+    (kNormal)
+    // Calls that should not wait behind regular user traffic.
+    (kHigh));
+
 // Specifies how to run callback for async outbound call.
 YB_DEFINE_ENUM(InvokeCallbackMode,
     // On reactor thread.
@@ -187,6 +187,21 @@ Status ParseHeader(
           return STATUS(Corruption, "Unable to decode timeout_ms field");
         }
         break;
+      case RequestHeader::kPriorityClassFieldNumber: {
+        uint32_t temp;
+        if (!in->ReadVarint32(&temp)) {
+          return STATUS(Corruption, "Unable to decode priority_class field");
+        }
+        // Unknown classes from newer clients are handled as normal.
+        if (temp < kElementsInRpcPriorityClass) {
+          parsed_header->priority_class = static_cast<RpcPriorityClass>(temp);
+        }
+        } break;
+      case RequestHeader::kTraceIdFieldNumber:
+        if (!in->ReadLittleEndian64(&parsed_header->trace_id)) {
+          return STATUS(Corruption, "Unable to decode trace_id field");
+        }
+        break;
       default: {
         if (!SkipField(tag & 7, in)) {
           return STATUS_FORMAT(Corruption, "Unable to skip: $0", tag);
@@ -302,6 +317,12 @@ void ParsedRequestHeader::ToPB(RequestHeader* out) const {
   if (timeout_ms) {
     out->set_timeout_millis(timeout_ms);
   }
+  if (priority_class != RpcPriorityClass::kNormal) {
+    out->set_priority_class(to_underlying(priority_class));
+  }
+  if (trace_id) {
+    out->set_trace_id(trace_id);
+  }
   auto parsed_remote_method = ParseRemoteMethod(remote_method);
   if (parsed_remote_method.ok()) {
     out->mutable_remote_method()->set_service_name(parsed_remote_method->service.ToBuffer());
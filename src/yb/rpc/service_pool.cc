@@ -35,10 +35,15 @@
 #include <pthread.h>
 #include <sys/types.h>
 
+#include <array>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/asio/strand.hpp>
@@ -49,12 +54,16 @@
 
 #include "yb/gutil/atomicops.h"
 #include "yb/gutil/ref_counted.h"
+#include "yb/gutil/strings/numbers.h"
+#include "yb/gutil/strings/split.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/thread_annotations.h"
 
 #include "yb/rpc/inbound_call.h"
 #include "yb/rpc/scheduler.h"
 #include "yb/rpc/service_if.h"
 
+#include "yb/util/call_accounting.h"
 #include "yb/util/countdown_latch.h"
 #include "yb/util/flags.h"
 #include "yb/util/lockfree.h"
@@ -79,6 +88,16 @@ DEFINE_RUNTIME_int64(backpressure_recovery_period_ms, 600000,
     "Once we hit a backpressure/service-overflow we will consider dropping stale requests "
     "for this duration (in ms)");
 TAG_FLAG(backpressure_recovery_period_ms, advanced);
+DEFINE_NON_RUNTIME_string(rpc_service_max_concurrent_calls, "",
+    "Comma separated list of service=limit pairs, that limit the number of calls of the service "
+    "that are concurrently handled by the shared RPC thread pool, so a service with long calls "
+    "could not occupy all workers. Service is specified by its full or short name, e.g. "
+    "yb.tserver.TabletServerService or TabletServerService. Calls over the limit wait in the "
+    "service queue.");
+DEFINE_NON_RUNTIME_bool(rpc_service_priority_scheduling, false,
+    "Whether the service handles queued calls in order of their priority class and deadline, "
+    "instead of the arrival order. Expired calls are failed before execution, and calls of the "
+    "lowest class are the first to be dropped when the thread pool queue overflows.");
 DEFINE_test_flag(bool, enable_backpressure_mode_for_testing, false,
             "For testing purposes. Enables the rpc's to be considered timed out in the queue even "
             "when we have not had any backpressure in the recent past.");
@@ -116,6 +135,35 @@ namespace {
 const CoarseDuration kTimeoutCheckGranularity = 100ms;
 const char* const kTimedOutInQueue = "Call waited in the queue past deadline";
 
+// Returns limit of concurrently handled calls for the service, or 0 if it is not limited.
+size_t MaxConcurrentCalls(const std::string& service_name) {
+  auto short_name_pos = service_name.rfind('.');
+  auto short_name = short_name_pos == std::string::npos
+      ? service_name : service_name.substr(short_name_pos + 1);
+  for (const auto& entry : strings::Split(
+           FLAGS_rpc_service_max_concurrent_calls, ",", strings::SkipEmpty())) {
+    std::vector<std::string> kv = strings::Split(entry, "=");
+    uint64_t limit = 0;
+    if (kv.size() != 2 || !safe_strtou64(kv[1], &limit)) {
+      LOG(WARNING) << "Invalid rpc_service_max_concurrent_calls entry: " << entry;
+      continue;
+    }
+    if (kv[0] == service_name || kv[0] == short_name) {
+      return limit;
+    }
+  }
+  return 0;
+}
+
+const char* PriorityClassMetricSuffix(RpcPriorityClass priority_class) {
+  switch (priority_class) {
+    case RpcPriorityClass::kBackground: return "background";
+    case RpcPriorityClass::kNormal: return "normal";
+    case RpcPriorityClass::kHigh: return "high";
+  }
+  FATAL_INVALID_ENUM_VALUE(RpcPriorityClass, priority_class);
+}
+
 } // namespace
 
 class ServicePoolImpl final : public InboundCallHandler {
@@ -135,6 +183,9 @@ class ServicePoolImpl final : public InboundCallHandler {
             METRIC_rpcs_timed_out_early_in_queue.Instantiate(entity)),
         rpcs_queue_overflow_(METRIC_rpcs_queue_overflow.Instantiate(entity)),
         check_timeout_strand_(scheduler->io_service()),
+        max_concurrent_calls_(MaxConcurrentCalls(service_->service_name())),
+        priority_scheduling_(FLAGS_rpc_service_priority_scheduling),
+        metric_entity_(entity),
         log_prefix_(Format("$0: ", service_->service_name())) {
 
           // Create per service counter for rpcs_in_queue_.
@@ -147,7 +198,26 @@ class ServicePoolImpl final : public InboundCallHandler {
                   description, MetricUnit::kRequests, description, MetricLevel::kInfo)),
               static_cast<int64>(0) /* initial_value */);
 
-          LOG_WITH_PREFIX(INFO) << "yb::rpc::ServicePoolImpl created at " << this;
+          if (priority_scheduling_) {
+            for (auto priority_class : List(static_cast<RpcPriorityClass*>(nullptr))) {
+              auto class_id = Format(
+                  "rpcs_in_queue_$0_$1", service_->service_name(),
+                  PriorityClassMetricSuffix(priority_class));
+              EscapeMetricNameForPrometheus(&class_id);
+              string class_description = class_id + " metric for ServicePoolImpl";
+              rpcs_in_queue_by_class_[to_underlying(priority_class)] = entity->FindOrCreateGauge(
+                  std::unique_ptr<GaugePrototype<int64_t>>(new OwningGaugePrototype<int64_t>(
+                      entity->prototype().name(), std::move(class_id), class_description,
+                      MetricUnit::kRequests, class_description, MetricLevel::kInfo)),
+                  static_cast<int64>(0) /* initial_value */);
+            }
+          }
+
+          LOG_WITH_PREFIX(INFO) << "yb::rpc::ServicePoolImpl created at " << this
+                                << (max_concurrent_calls_
+                                        ? Format(", max concurrent calls: $0",
+                                                 max_concurrent_calls_)
+                                        : std::string());
   }
 
   ~ServicePoolImpl() {
@@ -177,11 +247,14 @@ class ServicePoolImpl final : public InboundCallHandler {
         while (pre_check_timeout_queue_.pop(inbound_call_wrapper)) {}
         shutdown_complete_latch_.CountDown();
       });
+
+      AbortDeferredTasks();
     }
   }
 
   void Enqueue(const InboundCallPtr& call) {
     TRACE_TO(call->trace(), "Inserting onto call queue");
+    call->RecordCallEnqueued();
 
     auto task = call->BindTask(this);
     if (!task) {
@@ -195,7 +268,13 @@ class ServicePoolImpl final : public InboundCallHandler {
       ScheduleCheckTimeout(call_deadline);
     }
 
-    thread_pool_.Enqueue(task);
+    if (priority_scheduling_) {
+      PushScheduledCall(call);
+    }
+
+    if (AdmitTask(task)) {
+      thread_pool_.Enqueue(task);
+    }
   }
 
   const Counter* RpcsTimedOutInQueueMetricForTests() const {
@@ -231,7 +310,12 @@ class ServicePoolImpl final : public InboundCallHandler {
         CoarseMonoClock::Now().time_since_epoch(), std::memory_order_release);
   }
 
-  void Failure(const InboundCallPtr& call, const Status& status) override {
+  void Failure(const InboundCallPtr& failed_call, const Status& status) override {
+    TaskFinished();
+    // The task is just a slot in the thread pool, so the least important call is dropped instead
+    // of the one that was bound to the task.
+    const auto& call = priority_scheduling_ ? PopScheduledCall(/* most_important= */ false)
+                                            : failed_call;
     if (!call->TryStartProcessing()) {
       return;
     }
@@ -253,8 +337,17 @@ class ServicePoolImpl final : public InboundCallHandler {
   }
 
   void Handle(InboundCallPtr incoming) override {
+    auto se = ScopeExit([this] {
+      TaskFinished();
+    });
+    if (priority_scheduling_) {
+      incoming = PopScheduledCall(/* most_important= */ true);
+    }
     incoming->RecordHandlingStarted(incoming_queue_time_);
     ADOPT_TRACE(incoming->trace());
+    // Holds the accounting, since the call could be destroyed before the handler returns.
+    auto call_accounting = incoming->call_accounting();
+    ADOPT_CALL_ACCOUNTING(call_accounting.get());
 
     const char* error_message;
     if (PREDICT_FALSE(incoming->ClientTimedOut())) {
@@ -264,6 +357,14 @@ class ServicePoolImpl final : public InboundCallHandler {
     } else {
       if (incoming->TryStartProcessing()) {
         TRACE_TO(incoming->trace(), "Handling call $0", AsString(incoming->method_name()));
+        if (call_accounting) {
+          call_accounting->SetMethodName(incoming->method_name().ToBuffer());
+          if (call_accounting->time_accounted()) {
+            call_accounting->SetMethodCounters(
+                CallPhaseCountersForMethod(incoming->method_name()));
+          }
+        }
+        ScopedCallPhase service_thread_phase(CallPhase::kServiceThread);
         service_->Handle(std::move(incoming));
       }
       return;
@@ -279,6 +380,103 @@ class ServicePoolImpl final : public InboundCallHandler {
   }
 
  private:
+  struct ScheduledCall {
+    RpcPriorityClass priority_class;
+    CoarseTimePoint deadline;
+    uint64_t serial_no;
+    InboundCallPtr call;
+  };
+
+  // More important calls go first: higher priority class, then earlier deadline, then earlier
+  // arrival.
+  struct ScheduledCallLess {
+    bool operator()(const ScheduledCall& lhs, const ScheduledCall& rhs) const {
+      if (lhs.priority_class != rhs.priority_class) {
+        return lhs.priority_class > rhs.priority_class;
+      }
+      if (lhs.deadline != rhs.deadline) {
+        return lhs.deadline < rhs.deadline;
+      }
+      return lhs.serial_no < rhs.serial_no;
+    }
+  };
+
+  void PushScheduledCall(const InboundCallPtr& call) {
+    auto priority_class = call->GetPriorityClass();
+    {
+      std::lock_guard<std::mutex> lock(scheduled_calls_mutex_);
+      scheduled_calls_.insert(ScheduledCall {
+        .priority_class = priority_class,
+        .deadline = call->GetClientDeadline(),
+        .serial_no = ++scheduled_calls_serial_no_,
+        .call = call,
+      });
+    }
+    rpcs_in_queue_by_class_[to_underlying(priority_class)]->Increment();
+  }
+
+  // Each scheduled call has its own task in the thread pool, so there is always a call to pop,
+  // when the task is handled or failed.
+  InboundCallPtr PopScheduledCall(bool most_important) {
+    decltype(scheduled_calls_)::node_type node;
+    {
+      std::lock_guard<std::mutex> lock(scheduled_calls_mutex_);
+      CHECK(!scheduled_calls_.empty());
+      node = scheduled_calls_.extract(
+          most_important ? scheduled_calls_.begin() : std::prev(scheduled_calls_.end()));
+    }
+    rpcs_in_queue_by_class_[to_underlying(node.value().priority_class)]->Decrement();
+    return std::move(node.value().call);
+  }
+
+  // Returns true if the task could be passed to the thread pool. Otherwise the task is deferred
+  // until one of the calls, handled by the thread pool, is finished.
+  bool AdmitTask(ThreadPoolTask* task) {
+    if (!max_concurrent_calls_) {
+      return true;
+    }
+    std::lock_guard<std::mutex> lock(concurrency_mutex_);
+    if (running_tasks_ < max_concurrent_calls_ || closing_.load(std::memory_order_acquire)) {
+      ++running_tasks_;
+      return true;
+    }
+    deferred_tasks_.push_back(task);
+    return false;
+  }
+
+  // Invoked when the task admitted by AdmitTask was handled or failed by the thread pool.
+  void TaskFinished() {
+    if (!max_concurrent_calls_) {
+      return;
+    }
+    ThreadPoolTask* task;
+    {
+      std::lock_guard<std::mutex> lock(concurrency_mutex_);
+      if (deferred_tasks_.empty()) {
+        --running_tasks_;
+        return;
+      }
+      // Slot of the finished task is passed to the deferred one.
+      task = deferred_tasks_.front();
+      deferred_tasks_.pop_front();
+    }
+    thread_pool_.Enqueue(task);
+  }
+
+  void AbortDeferredTasks() {
+    std::deque<ThreadPoolTask*> deferred_tasks;
+    {
+      std::lock_guard<std::mutex> lock(concurrency_mutex_);
+      deferred_tasks.swap(deferred_tasks_);
+      // Failure of the deferred task is accounted as finish of admitted one.
+      running_tasks_ += deferred_tasks.size();
+    }
+    const auto status = STATUS(Aborted, "Service is shutting down");
+    for (auto* task : deferred_tasks) {
+      task->Done(status);
+    }
+  }
+
   void TimedOut(InboundCall* call, const char* error_message, Counter* metric) {
     if (call->RespondTimedOutIfPending(error_message)) {
       metric->Increment();
@@ -405,6 +603,17 @@ class ServicePoolImpl final : public InboundCallHandler {
     rpcs_in_queue_->Decrement();
   }
 
+  // Counters are created lazily, since only sampled calls are accounted.
+  CallPhaseCountersPtr CallPhaseCountersForMethod(Slice method_name) {
+    std::lock_guard<std::mutex> lock(call_phase_counters_mutex_);
+    auto& result = call_phase_counters_[method_name.ToBuffer()];
+    if (!result) {
+      result = std::make_shared<CallPhaseCounters>(
+          metric_entity_, Format("_$0_$1", service_->service_name(), method_name.ToBuffer()));
+    }
+    return result;
+  }
+
   const size_t max_queued_calls_;
   ThreadPool& thread_pool_;
   Scheduler& scheduler_;
@@ -456,6 +665,27 @@ class ServicePoolImpl final : public InboundCallHandler {
 
   std::atomic<bool> closing_ = {false};
   CountDownLatch shutdown_complete_latch_{1};
+
+  // Limit of calls concurrently handled by thread_pool_, 0 if not limited.
+  const size_t max_concurrent_calls_;
+  std::mutex concurrency_mutex_;
+  size_t running_tasks_ GUARDED_BY(concurrency_mutex_) = 0;
+  std::deque<ThreadPoolTask*> deferred_tasks_ GUARDED_BY(concurrency_mutex_);
+
+  // When priority scheduling is enabled, calls are taken from scheduled_calls_, and the task
+  // of the call is only used as a slot in the thread pool.
+  const bool priority_scheduling_;
+  std::mutex scheduled_calls_mutex_;
+  uint64_t scheduled_calls_serial_no_ GUARDED_BY(scheduled_calls_mutex_) = 0;
+  std::set<ScheduledCall, ScheduledCallLess> scheduled_calls_ GUARDED_BY(scheduled_calls_mutex_);
+  std::array<scoped_refptr<AtomicGauge<int64_t>>, kElementsInRpcPriorityClass>
+      rpcs_in_queue_by_class_;
+
+  scoped_refptr<MetricEntity> metric_entity_;
+  std::mutex call_phase_counters_mutex_;
+  std::unordered_map<std::string, CallPhaseCountersPtr> call_phase_counters_
+      GUARDED_BY(call_phase_counters_mutex_);
+
   std::string log_prefix_;
 };
 
@@ -43,7 +43,9 @@ namespace rpc {
 
 namespace {
 
-const size_t kMaxIov = 16;
+// Number of iovecs passed to a single sendmsg call, so queued data of many calls is sent with
+// a single syscall.
+const size_t kMaxIov = 64;
 
 }
 
@@ -163,6 +165,7 @@ Status TcpStream::TryWrite() {
 
 TcpStream::FillIovResult TcpStream::FillIov(iovec* out) {
   int index = 0;
+  size_t bytes_size = 0;
   size_t offset = send_position_;
   bool only_heartbeats = true;
   for (auto& data : sending_) {
@@ -184,14 +187,15 @@ TcpStream::FillIovResult TcpStream::FillIov(iovec* out) {
 
       out[index].iov_base = bytes.data() + offset;
       out[index].iov_len = bytes.size() - offset;
+      bytes_size += out[index].iov_len;
       offset = 0;
       if (++index == kMaxIov) {
-        return FillIovResult{index, only_heartbeats};
+        return FillIovResult{index, bytes_size, only_heartbeats};
       }
     }
   }
 
-  return FillIovResult{index, only_heartbeats};
+  return FillIovResult{index, bytes_size, only_heartbeats};
 }
 
 Status TcpStream::DoWrite() {
@@ -251,6 +255,12 @@ Status TcpStream::DoWrite() {
         context_->Transferred(data, Status::OK());
       }
     }
+
+    // Socket send buffer is full, so the next attempt would fail with EAGAIN. Wait for the write
+    // event instead.
+    if (*result < fill_result.bytes) {
+      break;
+    }
   }
 
   return Status::OK();
@@ -314,7 +324,8 @@ Status TcpStream::ReadHandler() {
   context_->UpdateLastRead();
 
   for (;;) {
-    auto received = Receive();
+    bool drained = false;
+    auto received = Receive(&drained);
     if (PREDICT_FALSE(!received.ok())) {
       if (Errno(received.status()) == ESHUTDOWN) {
         VLOG_WITH_PREFIX(1) << "Shut down by remote end.";
@@ -333,13 +344,14 @@ Status TcpStream::ReadHandler() {
     if (!continue_receiving.ok()) {
       return continue_receiving.status();
     }
-    if (!continue_receiving.get()) {
+    // Level triggered read event will be raised again, when more data arrives.
+    if (!continue_receiving.get() || drained) {
       return Status::OK();
     }
   }
 }
 
-Result<bool> TcpStream::Receive() {
+Result<bool> TcpStream::Receive(bool* drained) {
   auto iov = ReadBuffer().PrepareAppend();
   if (!iov.ok()) {
     VLOG_WITH_PREFIX(3) << "ReadBuffer().PrepareAppend() error: " << iov.status();
@@ -380,6 +392,12 @@ Result<bool> TcpStream::Receive() {
   }
   DVLOG_WITH_PREFIX(4) << "socket_.Recvv() bytes: " << *nread;
 
+  size_t capacity = 0;
+  for (const auto& vec : *iov) {
+    capacity += vec.iov_len;
+  }
+  *drained = *nread < capacity;
+
   IncrementCounterBy(bytes_received_counter_, *nread);
   ReadBuffer().DataAppended(*nread);
   return *nread != 0;
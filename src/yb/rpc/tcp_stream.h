@@ -68,6 +68,8 @@ class TcpStream : public Stream {
  private:
   struct FillIovResult {
     int len;
+    // Total number of bytes in filled iovecs.
+    size_t bytes;
     bool only_heartbeats;
   };
 
@@ -99,7 +101,10 @@ class TcpStream : public Stream {
   Status ReadHandler();
   Status WriteHandler(bool just_connected);
 
-  Result<bool> Receive();
+  // Returns true if anything was received. Sets drained to true when the socket had less data than
+  // the read buffer could accept, so there is no need to try receiving again until the next read
+  // event.
+  Result<bool> Receive(bool* drained);
   // Try to parse received data and process it.
   Result<bool> TryProcessReceived();
 
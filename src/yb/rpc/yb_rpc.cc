@@ -27,6 +27,7 @@
 #include "yb/rpc/rpc_introspection.pb.h"
 #include "yb/rpc/serialization.h"
 
+#include "yb/util/call_accounting.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/flags.h"
 #include "yb/util/format.h"
@@ -152,12 +153,14 @@ Result<ProcessCallsResult> YBInboundConnectionContext::ProcessCalls(
     data_copy[0].iov_len -= kConnectionHeaderSize;
     data_copy[0].iov_base = const_cast<uint8_t*>(slice.data() + kConnectionHeaderSize);
     auto result = VERIFY_RESULT(
-        parser().Parse(connection, data_copy, ReadBufferFull::kFalse, &call_tracker()));
+        parser().Parse(connection, data_copy, ReadBufferFull::kFalse, &call_tracker(),
+                       read_buffer().SharedSlab()));
     result.consumed += kConnectionHeaderSize;
     return result;
   }
 
-  return parser().Parse(connection, data, read_buffer_full, &call_tracker());
+  return parser().Parse(
+      connection, data, read_buffer_full, &call_tracker(), read_buffer().SharedSlab());
 }
 
 namespace {
@@ -286,6 +289,12 @@ Status YBInboundCall::ParseFrom(const MemTrackerPtr& mem_tracker, CallData* call
     return STATUS(Corruption, "Non-connection context request header must specify remote_method");
   }
 
+  // Caller trace is sampled, so trace of this call should be collected as well.
+  if (header_.trace_id) {
+    EnsureTraceCreated();
+    trace_->set_trace_id(header_.trace_id);
+  }
+
   return Status::OK();
 }
 
@@ -385,6 +394,16 @@ bool YBInboundCall::DumpPB(const DumpRunningRpcsRequestPB& req,
   }
   resp->set_elapsed_millis(MonoTime::Now().GetDeltaSince(timing_.time_received)
       .ToMilliseconds());
+  if (call_accounting_) {
+    for (auto phase : CallPhaseList()) {
+      auto time = call_accounting_->Get(phase);
+      if (time > MonoDelta::kZero) {
+        auto& phase_time = *resp->add_call_phase_times();
+        phase_time.set_phase(CallPhaseMetricName(phase));
+        phase_time.set_time_us(time.ToMicroseconds());
+      }
+    }
+  }
   return true;
 }
 
@@ -533,7 +552,9 @@ void YBOutboundConnectionContext::AssignConnection(const ConnectionPtr& connecti
 
 Result<ProcessCallsResult> YBOutboundConnectionContext::ProcessCalls(
     const ConnectionPtr& connection, const IoVecs& data, ReadBufferFull read_buffer_full) {
-  return parser().Parse(connection, data, read_buffer_full, nullptr /* tracker_for_throttle */);
+  return parser().Parse(
+      connection, data, read_buffer_full, nullptr /* tracker_for_throttle */,
+      read_buffer().SharedSlab());
 }
 
 void YBOutboundConnectionContext::UpdateLastRead(const ConnectionPtr& connection) {
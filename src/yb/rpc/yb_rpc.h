@@ -56,6 +56,8 @@ class YBConnectionContext : public ConnectionContextWithCallId, public BinaryCal
  protected:
   BinaryCallParser& parser() { return parser_; }
 
+  CircularReadBuffer& read_buffer() { return read_buffer_; }
+
   ev::loop_ref* loop_ = nullptr;
 
   EvTimerHolder timer_;
@@ -182,6 +184,10 @@ class YBInboundCall : public InboundCall {
 
   CoarseTimePoint GetClientDeadline() const override;
 
+  RpcPriorityClass GetPriorityClass() const override {
+    return header_.priority_class;
+  }
+
   MonoTime ReceiveTime() const {
     return timing_.time_received;
   }
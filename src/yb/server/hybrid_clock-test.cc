@@ -39,6 +39,7 @@
 
 #include "yb/util/atomic.h"
 #include "yb/util/monotime.h"
+#include "yb/util/ntp_clock.h"
 #include "yb/util/random.h"
 #include "yb/util/random_util.h"
 #include "yb/util/test_util.h"
@@ -46,6 +47,7 @@
 
 using std::vector;
 
+DECLARE_uint64(max_clock_skew_usec);
 DECLARE_uint64(max_clock_sync_error_usec);
 DECLARE_bool(disable_clock_sync_error);
 
@@ -95,6 +97,25 @@ TEST(MockHybridClockTest, TestMockedSystemClock) {
             HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(time.time_point, 1).ToUint64());
 }
 
+TEST_F(HybridClockTest, BoundedErrorClockUncertaintyWindow) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_max_clock_skew_usec) = 500000;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_max_clock_sync_error_usec) = 20000;
+  MockClock mock_clock;
+  BoundedErrorClock clock(mock_clock.AsClock());
+
+  mock_clock.Set({1000000, 5000});
+  auto now = ASSERT_RESULT(clock.Now());
+  ASSERT_EQ(clock.MaxGlobalTime(now), 1000000 + 5000 + 20000);
+
+  // Window never exceeds max clock skew.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_max_clock_skew_usec) = 10000;
+  ASSERT_EQ(clock.MaxGlobalTime(now), 1000000 + 10000);
+
+  // Clock error above the bound is not tolerated.
+  mock_clock.Set({1000000, 30000});
+  ASSERT_NOK(clock.Now());
+}
+
 // Test that two subsequent time reads are monotonically increasing.
 TEST_F(HybridClockTest, TestNow_ValuesIncreaseMonotonically) {
   const HybridTime now1 = clock_->Now();
@@ -66,9 +66,11 @@ METRIC_DEFINE_gauge_int64(server, hybrid_clock_skew,
                            "Server clock skew.");
 
 DEFINE_string(time_source, "",
-              "The clock source that HybridClock should use (for tests only). "
-              "Leave empty for WallClock, other values depend on added clock providers and "
-              "specific for appropriate tests, that adds them.");
+              "The clock source that HybridClock should use. "
+              "Leave empty for WallClock. Servers also provide 'ntp' and 'bounded_error' clocks, "
+              "that use clock error reported by NTP to bound read uncertainty window, and should "
+              "be used by all servers of the cluster. Other values depend on added clock "
+              "providers and specific for appropriate tests, that adds them.");
 TAG_FLAG(time_source, hidden);
 
 DEFINE_bool(fail_on_out_of_range_clock_skew, true,
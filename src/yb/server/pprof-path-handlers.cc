@@ -49,7 +49,9 @@
 #include <gperftools/profiler.h>
 #endif
 
+#include <algorithm>
 #include <fstream>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -61,8 +63,10 @@
 #include "yb/gutil/strings/substitute.h"
 #include "yb/gutil/sysinfo.h"
 #include "yb/server/webserver.h"
+#include "yb/util/debug-util.h"
 #include "yb/util/env.h"
 #include "yb/util/monotime.h"
+#include "yb/util/stack_trace.h"
 #include "yb/util/spinlock_profiling.h"
 #include "yb/util/status.h"
 #include "yb/util/status_log.h"
@@ -90,6 +94,8 @@ bool Symbolize(void *pc, char *out, int out_size);
 namespace yb {
 
 const int PPROF_DEFAULT_SAMPLE_SECS = 30; // pprof default sample time in seconds.
+const int STACK_SAMPLES_DEFAULT_HZ = 10;
+const int STACK_SAMPLES_MAX_HZ = 100;
 
 // pprof asks for the url /pprof/cmdline to figure out what application it's profiling.
 // The server should respond by sending the executable path.
@@ -215,6 +221,82 @@ static void PprofContentionHandler(const Webserver::WebRequest& req,
 #endif // defined(__linux__)
 }
 
+// Samples stacks of all threads of the process with the specified frequency, using the same signal
+// based mechanism as /threadz, and outputs them in the folded format, that could be passed
+// directly to flamegraph.pl: one line per unique stack, with frames from the outermost to the
+// innermost separated by ';', followed by the number of samples.
+// Unlike /pprof/profile it does not require tcmalloc and also accounts threads blocked in kernel,
+// so it could be used to find where RPCs are waiting. Idle threads are skipped unless
+// include_idle=true is specified.
+//   curl 'http://remote_host:9000/pprof/stack_samples?seconds=30&hz=10' > out.folded
+static void PprofStackSamplesHandler(const Webserver::WebRequest& req,
+                                     Webserver::WebResponse* resp) {
+  std::stringstream *output = &resp->output;
+  string secs_str = FindWithDefault(req.parsed_args, "seconds", "");
+  int32_t seconds = ParseLeadingInt32Value(secs_str.c_str(), PPROF_DEFAULT_SAMPLE_SECS);
+  string hz_str = FindWithDefault(req.parsed_args, "hz", "");
+  int32_t hz = std::clamp(
+      ParseLeadingInt32Value(hz_str.c_str(), STACK_SAMPLES_DEFAULT_HZ), 1, STACK_SAMPLES_MAX_HZ);
+  bool include_idle = FindWithDefault(req.parsed_args, "include_idle", "") == "true";
+
+  LOG(INFO) << "Starting stack sampling: seconds=" << seconds << " hz=" << hz;
+
+  std::map<StackTrace, int64_t> samples;
+  int64_t failed_samples = 0;
+  const auto interval = MonoDelta::FromSeconds(1.0 / hz);
+  const auto deadline = MonoTime::Now() + MonoDelta::FromSeconds(seconds);
+  std::vector<pid_t> tids;
+  std::vector<ThreadIdForStack> thread_ids;
+  for (auto next = MonoTime::Now(); next < deadline; next += interval) {
+    tids.clear();
+    WARN_NOT_OK(ListThreads(&tids), "Failed to list threads");
+    thread_ids.assign(tids.begin(), tids.end());
+    std::sort(thread_ids.begin(), thread_ids.end());
+    for (auto& stack : ThreadStacks(thread_ids)) {
+      if (stack.ok() && *stack) {
+        ++samples[*stack];
+      } else {
+        ++failed_samples;
+      }
+    }
+    SleepUntil(next + interval);
+  }
+
+  // Symbolization is expensive, so it is done once per unique stack, after sampling is finished.
+  std::map<string, int64_t> folded;
+  for (const auto& [stack, count] : samples) {
+    if (!include_idle) {
+      StackTraceGroup group;
+      stack.Symbolize(StackTraceLineFormat::DEFAULT, &group);
+      if (group == StackTraceGroup::kIdle) {
+        continue;
+      }
+    }
+    string line;
+    for (int i = stack.num_frames(); i-- > 0;) {
+      // Return address points to the instruction after the call, see SymbolizeAddress.
+      auto* pc = reinterpret_cast<void*>(reinterpret_cast<size_t>(stack.frame(i)) - 1);
+      char symbol_buf[1024];
+      if (!line.empty()) {
+        line += ';';
+      }
+      if (google::Symbolize(pc, symbol_buf, sizeof(symbol_buf))) {
+        line += symbol_buf;
+      } else {
+        line += strings::Substitute("$0", pc);
+      }
+    }
+    folded[line] += count;
+  }
+
+  for (const auto& [line, count] : folded) {
+    *output << line << " " << count << endl;
+  }
+
+  LOG(INFO) << strings::Substitute(
+      "Handled request for /pprof/stack_samples: unique stacks=$0 failed samples=$1",
+      folded.size(), failed_samples);
+}
 
 // pprof asks for the url /pprof/symbol to map from hex addresses to variable names.
 // When the server receives a GET request for /pprof/symbol, it should return a line
@@ -280,6 +362,8 @@ void AddPprofPathHandlers(Webserver* webserver) {
   webserver->RegisterPathHandler("/pprof/profile", "", PprofCpuProfileHandler, false, false);
   webserver->RegisterPathHandler("/pprof/symbol", "", PprofSymbolHandler, false, false);
   webserver->RegisterPathHandler("/pprof/contention", "", PprofContentionHandler, false, false);
+  webserver->RegisterPathHandler(
+      "/pprof/stack_samples", "", PprofStackSamplesHandler, false, false);
 }
 
 } // namespace yb
@@ -66,6 +66,7 @@
 #include "yb/server/tracing-path-handlers.h"
 #include "yb/server/webserver.h"
 
+#include "yb/util/active_session_history.h"
 #include "yb/util/atomic.h"
 #include "yb/util/concurrent_value.h"
 #include "yb/util/env.h"
@@ -454,6 +455,7 @@ RpcAndWebServerBase::RpcAndWebServerBase(
   fs_manager_.reset(new FsManager(options.env, fs_opts));
 
   CHECK_OK(StartThreadInstrumentation(metric_entity_, web_server_.get()));
+  CHECK_OK(StartActiveSessionHistory(web_server_.get()));
 }
 
 RpcAndWebServerBase::~RpcAndWebServerBase() {
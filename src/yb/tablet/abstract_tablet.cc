@@ -13,6 +13,8 @@
 
 #include "yb/tablet/abstract_tablet.h"
 
+#include <optional>
+
 #include "yb/common/ql_resultset.h"
 #include "yb/common/ql_value.h"
 #include "yb/common/schema.h"
@@ -21,6 +23,8 @@
 #include "yb/docdb/doc_read_context.h"
 #include "yb/docdb/pgsql_operation.h"
 
+#include "yb/rocksdb/perf_context.h"
+
 #include "yb/tablet/read_result.h"
 #include "yb/tablet/tablet_metadata.h"
 
@@ -31,6 +35,31 @@ using std::vector;
 namespace yb {
 namespace tablet {
 
+namespace {
+
+// Snapshot of the thread local RocksDB perf context counters, that are reported as DocDB
+// execution statistics of the request.
+struct DocDBStatsSnapshot {
+  uint64_t seeks = rocksdb::perf_context.seek_child_seek_count +
+                   rocksdb::perf_context.seek_on_memtable_count;
+  uint64_t keys_skipped = rocksdb::perf_context.internal_key_skipped_count +
+                          rocksdb::perf_context.internal_delete_skipped_count;
+  uint64_t block_cache_hits = rocksdb::perf_context.block_cache_hit_count;
+  uint64_t block_cache_misses = rocksdb::perf_context.block_read_count;
+  uint64_t block_read_bytes = rocksdb::perf_context.block_read_byte;
+
+  void FillDelta(PgsqlDocDBStatsPB* out) const {
+    DocDBStatsSnapshot now;
+    out->set_seeks(now.seeks - seeks);
+    out->set_keys_skipped(now.keys_skipped - keys_skipped);
+    out->set_block_cache_hits(now.block_cache_hits - block_cache_hits);
+    out->set_block_cache_misses(now.block_cache_misses - block_cache_misses);
+    out->set_block_read_bytes(now.block_read_bytes - block_read_bytes);
+  }
+};
+
+} // namespace
+
 Result<HybridTime> AbstractTablet::SafeTime(RequireLease require_lease,
                                             HybridTime min_allowed,
                                             CoarseTimePoint deadline) const {
@@ -100,6 +129,10 @@ Status AbstractTablet::ProcessPgsqlReadRequest(CoarseTimePoint deadline,
   const auto index_doc_read_context = pgsql_read_request.has_index_request()
       ? GetDocReadContext(pgsql_read_request.index_request().table_id()) : nullptr;
 
+  std::optional<DocDBStatsSnapshot> docdb_stats_start;
+  if (pgsql_read_request.fetch_docdb_stats()) {
+    docdb_stats_start.emplace();
+  }
   TRACE("Start Execute");
   auto fetched_rows = doc_op.Execute(
       QLStorage(), deadline, read_time, is_explicit_request_read_time, *doc_read_context,
@@ -112,6 +145,9 @@ Status AbstractTablet::ProcessPgsqlReadRequest(CoarseTimePoint deadline,
     return Status::OK();
   }
   result->response.Swap(&doc_op.response());
+  if (docdb_stats_start) {
+    docdb_stats_start->FillDelta(result->response.mutable_docdb_stats());
+  }
 
   if (num_rows_read) {
     *num_rows_read = *fetched_rows;
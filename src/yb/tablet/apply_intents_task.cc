@@ -13,6 +13,8 @@
 
 #include "yb/tablet/apply_intents_task.h"
 
+#include <algorithm>
+
 #include "yb/docdb/docdb.h"
 
 #include "yb/gutil/dynamic_annotations.h"
@@ -21,6 +23,7 @@
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/monotime.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/status_log.h"
 
 using namespace std::literals;
@@ -29,6 +32,10 @@ DEFINE_int64(apply_intents_task_injected_delay_ms, 0,
              "Inject such delay before applying intents for large transactions. "
              "Could be used to throttle the apply speed.");
 
+DEFINE_RUNTIME_int32(txn_max_apply_batch_transactions, 16,
+                     "Max number of large transactions, whose intents are applied by one "
+                     "write to regular DB. Records limit of the write is shared by them.");
+
 DEFINE_test_flag(int32, pause_and_skip_apply_intents_task_loop_ms, 0,
                  "If set to a value greater than zero, each loop of the apply intents task will "
                  "sleep for the specified duration and continue without doing apply work.");
@@ -50,13 +57,42 @@ bool ApplyIntentsTask::Prepare(RunningTransactionPtr transaction, ScopedRWOperat
 
   transaction_ = std::move(transaction);
   operation_ = std::move(*DCHECK_NOTNULL(operation));
+  running_transaction_context_.AddPendingApply(this);
   return true;
 }
 
 void ApplyIntentsTask::Run() {
   VLOG_WITH_PREFIX(4) << __func__;
+  run_ = true;
+
+  if (absorbed_) {
+    VLOG_WITH_PREFIX(4) << "Intents were applied by another task";
+    return;
+  }
 
-  for (;;) {
+  auto tasks = running_transaction_context_.TakePendingApplies(
+      this, std::max(FLAGS_txn_max_apply_batch_transactions, 1));
+  for (auto* task : tasks) {
+    task->absorbed_ = true;
+  }
+  tasks.insert(tasks.begin(), this);
+  ApplyBatch(tasks);
+  for (size_t i = 1; i < tasks.size(); ++i) {
+    tasks[i]->AbsorbedTaskFinished();
+  }
+}
+
+void ApplyIntentsTask::ApplyBatch(const std::vector<ApplyIntentsTask*>& tasks) {
+  auto active_tasks = tasks;
+  std::vector<const TransactionApplyData*> apply_data;
+  auto se = ScopeExit([this, &active_tasks] {
+    // Transactions whose apply was interrupted are no longer applying.
+    for (size_t i = 0; i != active_tasks.size(); ++i) {
+      running_transaction_context_.LargeApplyFinished(HybridTime::kInvalid);
+    }
+  });
+
+  while (!active_tasks.empty()) {
     AtomicFlagSleepMs(&FLAGS_apply_intents_task_injected_delay_ms);
 
     if (running_transaction_context_.Closing()) {
@@ -71,24 +107,65 @@ void ApplyIntentsTask::Run() {
       continue;
     }
 
-    auto result = applier_.ApplyIntents(apply_data_);
+    apply_data.clear();
+    for (auto* task : active_tasks) {
+      apply_data.push_back(&task->apply_data_);
+    }
+    auto result = applier_.ApplyIntentsBatch(apply_data);
     if (!result.ok()) {
       LOG_WITH_PREFIX(DFATAL)
-          << "Failed to apply intents " << apply_data_.ToString() << ": " << result.status();
+          << "Failed to apply intents of "
+          << CollectionToString(apply_data, [](const auto* data) { return data->ToString(); })
+          << ": " << result.status();
       break;
     }
 
-    transaction_->SetApplyData(*result);
-    VLOG_WITH_PREFIX(2) << "Performed next apply step: " << result->ToString();
-
-    if (!result->active()) {
-      break;
+    size_t num_active = 0;
+    for (size_t i = 0; i != active_tasks.size(); ++i) {
+      auto* task = active_tasks[i];
+      const auto& apply_state = (*result)[i];
+      // SetApplyData could remove transaction, so commit time is taken before it.
+      const auto commit_ht = task->apply_data_.commit_ht;
+      task->transaction_->SetApplyData(apply_state);
+      VLOG_WITH_PREFIX(2) << "Performed next apply step of " << task->apply_data_.transaction_id
+                          << ": " << apply_state.ToString();
+      if (apply_state.active()) {
+        active_tasks[num_active++] = task;
+      } else {
+        running_transaction_context_.LargeApplyFinished(commit_ht);
+      }
     }
+    active_tasks.resize(num_active);
   }
 }
 
 void ApplyIntentsTask::Done(const Status& status) {
   WARN_NOT_OK(status, "Apply intents task failed");
+  if (!run_) {
+    // The strand is closing. If the task is still pending, then nobody will apply its intents,
+    // otherwise the task that absorbed it is responsible for them.
+    if (running_transaction_context_.RemovePendingApply(this)) {
+      running_transaction_context_.LargeApplyFinished(HybridTime::kInvalid);
+      Release();
+    } else {
+      AbsorbedTaskFinished();
+    }
+    return;
+  }
+  if (absorbed_) {
+    AbsorbedTaskFinished();
+    return;
+  }
+  Release();
+}
+
+void ApplyIntentsTask::AbsorbedTaskFinished() {
+  if (absorbed_finishes_.fetch_add(1, std::memory_order_acq_rel) == 1) {
+    Release();
+  }
+}
+
+void ApplyIntentsTask::Release() {
   operation_.Reset();
   transaction_.reset();
 }
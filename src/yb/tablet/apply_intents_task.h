@@ -23,6 +23,9 @@ namespace yb {
 namespace tablet {
 
 // Used by RunningTransaction to apply its intents.
+// Task is registered as pending apply when submitted. When it starts, it also takes other pending
+// tasks and applies their intents together with its own ones, writing one regular DB batch per
+// step. Tasks whose intents were applied this way do nothing when they are executed.
 class ApplyIntentsTask : public rpc::StrandTask {
  public:
   ApplyIntentsTask(TransactionIntentApplier* applier,
@@ -39,6 +42,16 @@ class ApplyIntentsTask : public rpc::StrandTask {
  private:
   std::string LogPrefix() const;
 
+  // Applies intents of tasks, until all of them are applied or apply is interrupted.
+  void ApplyBatch(const std::vector<ApplyIntentsTask*>& tasks);
+
+  // Releases the transaction and the operation, that were taken by Prepare.
+  void Release();
+
+  // Absorbed task is used by the task that absorbed it and by its own Done, that could be invoked
+  // outside of the strand when the strand is closing. Whichever of them finishes last releases it.
+  void AbsorbedTaskFinished();
+
   TransactionIntentApplier& applier_;
   RunningTransactionContext& running_transaction_context_;
   const TransactionApplyData& apply_data_;
@@ -48,6 +61,11 @@ class ApplyIntentsTask : public rpc::StrandTask {
   // Helps to avoid multiple submissions of the same task.
   // The task can be submitted only once, so this flag never reverts its state to false.
   std::atomic<bool> used_{false};
+  // Whether intents of this task were applied by another task. Only accessed from the strand.
+  bool absorbed_ = false;
+  // Whether Run was invoked for this task. Only accessed from the strand.
+  bool run_ = false;
+  std::atomic<int> absorbed_finishes_{0};
   RunningTransactionPtr transaction_;
 };
 
@@ -0,0 +1,65 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/hot_keys.h"
+
+#include "yb/util/format.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace tablet {
+
+class HotKeysTest : public YBTest {
+};
+
+TEST_F(HotKeysTest, TopKeys) {
+  HotKeys hot_keys(8);
+  ASSERT_EQ(hot_keys.TopKeyFraction(), 0);
+
+  // Hot and warm keys among many cold keys, that don't fit into capacity.
+  for (int i = 0; i != 100; ++i) {
+    hot_keys.Record("hot", 2);
+    hot_keys.Record("warm", 1);
+    hot_keys.Record(Format("cold_$0", i), 1);
+  }
+
+  auto top = hot_keys.TopKeys(2);
+  ASSERT_EQ(top.size(), 2);
+  ASSERT_EQ(top[0].key, "hot");
+  ASSERT_EQ(top[0].count, 200);
+  ASSERT_EQ(top[0].error, 0);
+  ASSERT_EQ(top[1].key, "warm");
+  ASSERT_EQ(top[1].count, 100);
+  ASSERT_EQ(hot_keys.TopKeys(10).size(), 8);
+  ASSERT_EQ(hot_keys.TopKeyFraction(), 0.5);
+}
+
+TEST_F(HotKeysTest, Weight) {
+  HotKeys hot_keys(2);
+  hot_keys.Record("a", 10);
+  hot_keys.Record("b", 1);
+  // Replaces b, that has the lowest count, and inherits it as error.
+  hot_keys.Record("c", 5);
+
+  auto top = hot_keys.TopKeys(2);
+  ASSERT_EQ(top.size(), 2);
+  ASSERT_EQ(top[0].key, "a");
+  ASSERT_EQ(top[0].count, 10);
+  ASSERT_EQ(top[1].key, "c");
+  ASSERT_EQ(top[1].count, 6);
+  ASSERT_EQ(top[1].error, 1);
+}
+
+}  // namespace tablet
+}  // namespace yb
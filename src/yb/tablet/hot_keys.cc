@@ -0,0 +1,123 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/hot_keys.h"
+
+#include <algorithm>
+
+#include "yb/util/flags.h"
+#include "yb/util/random_util.h"
+
+DEFINE_RUNTIME_uint32(tablet_hot_key_sample_one_in_n, 100,
+    "Fraction of read and write requests, whose keys are tracked to find the hot keys of the "
+    "tablet, is 1 / tablet_hot_key_sample_one_in_n. 0 disables hot key tracking.");
+
+DEFINE_NON_RUNTIME_uint32(tablet_hot_key_capacity, 32,
+    "Max number of hot keys tracked per tablet for reads and for writes.");
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+const MonoDelta kDecayPeriod = MonoDelta::FromMinutes(1);
+
+} // namespace
+
+HotKeys::HotKeys(size_t capacity)
+    : capacity_(std::max<size_t>(capacity ? capacity : FLAGS_tablet_hot_key_capacity, 1)),
+      last_decay_(CoarseMonoClock::now()) {
+}
+
+uint64_t HotKeys::Sample() {
+  uint64_t one_in_n = GetAtomicFlag(&FLAGS_tablet_hot_key_sample_one_in_n);
+  if (one_in_n == 0) {
+    return 0;
+  }
+  return one_in_n == 1 || RandomWithChance(one_in_n) ? one_in_n : 0;
+}
+
+void HotKeys::Record(Slice key, uint64_t weight) {
+  auto now = CoarseMonoClock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  MaybeDecay(now);
+  total_ += weight;
+  auto min_it = entries_.end();
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (key == Slice(it->key)) {
+      it->count += weight;
+      return;
+    }
+    if (min_it == entries_.end() || it->count < min_it->count) {
+      min_it = it;
+    }
+  }
+  if (entries_.size() < capacity_) {
+    entries_.push_back(Entry {
+      .key = key.ToBuffer(),
+      .count = weight,
+      .error = 0,
+    });
+    return;
+  }
+  // Space saving: new key replaces the least frequent one, inheriting its count as the error.
+  min_it->key.assign(key.cdata(), key.size());
+  min_it->error = min_it->count;
+  min_it->count += weight;
+}
+
+void HotKeys::MaybeDecay(CoarseTimePoint now) {
+  if (MonoDelta(now - last_decay_) < kDecayPeriod) {
+    return;
+  }
+  last_decay_ = now;
+  total_ /= 2;
+  for (auto& entry : entries_) {
+    entry.count /= 2;
+    entry.error /= 2;
+  }
+}
+
+std::vector<HotKeys::Entry> HotKeys::TopKeys(size_t limit) {
+  std::vector<Entry> result;
+  {
+    auto now = CoarseMonoClock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    MaybeDecay(now);
+    result = entries_;
+  }
+  std::sort(result.begin(), result.end(), [](const Entry& lhs, const Entry& rhs) {
+    return lhs.count > rhs.count;
+  });
+  if (result.size() > limit) {
+    result.resize(limit);
+  }
+  return result;
+}
+
+double HotKeys::TopKeyFraction() {
+  auto now = CoarseMonoClock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  MaybeDecay(now);
+  if (total_ == 0) {
+    return 0;
+  }
+  uint64_t max_guaranteed = 0;
+  for (const auto& entry : entries_) {
+    max_guaranteed = std::max(max_guaranteed, entry.count - entry.error);
+  }
+  return static_cast<double>(max_guaranteed) / total_;
+}
+
+}  // namespace tablet
+}  // namespace yb
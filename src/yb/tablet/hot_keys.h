@@ -0,0 +1,69 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/util/monotime.h"
+#include "yb/util/slice.h"
+
+namespace yb {
+namespace tablet {
+
+// Tracks the most frequently accessed keys of the tablet with the space saving algorithm, over
+// the sample of requests selected by tablet_hot_key_sample_one_in_n. Counts are halved every
+// minute, so keys that are not accessed anymore leave the top. Thread safe.
+class HotKeys {
+ public:
+  struct Entry {
+    std::string key;
+    // Estimated number of accesses, scaled by sampling rate.
+    uint64_t count;
+    // Max overestimation of count, i.e. accesses of the keys evicted before this one was added.
+    uint64_t error;
+  };
+
+  // capacity - max number of tracked keys, 0 means tablet_hot_key_capacity.
+  explicit HotKeys(size_t capacity = 0);
+
+  // Returns weight of the request if it is selected by sampling, and 0 otherwise. All keys
+  // accessed by the selected request should be recorded with this weight.
+  static uint64_t Sample();
+
+  void Record(Slice key, uint64_t weight);
+
+  // Returns up to limit keys with the highest counts, in descending order.
+  std::vector<Entry> TopKeys(size_t limit);
+
+  // Fraction of accesses guaranteed to be made to the hottest key, since counts are
+  // overestimated by their error. 0 when nothing was recorded.
+  double TopKeyFraction();
+
+ private:
+  void MaybeDecay(CoarseTimePoint now) REQUIRES(mutex_);
+
+  const size_t capacity_;
+  std::mutex mutex_;
+  // The number of tracked keys is small, so they are kept unordered and searched linearly.
+  std::vector<Entry> entries_ GUARDED_BY(mutex_);
+  uint64_t total_ GUARDED_BY(mutex_) = 0;
+  CoarseTimePoint last_decay_ GUARDED_BY(mutex_);
+};
+
+}  // namespace tablet
+}  // namespace yb
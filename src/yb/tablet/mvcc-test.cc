@@ -42,10 +42,15 @@
 
 #include "yb/util/atomic.h"
 #include "yb/util/enums.h"
+#include "yb/util/flags.h"
 #include "yb/util/random_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status.h"
+#include "yb/util/test_thread_holder.h"
 #include "yb/util/test_util.h"
+#include "yb/util/tsan_util.h"
+
+DECLARE_bool(mvcc_lock_free_safe_time);
 
 using namespace std::literals;
 using std::vector;
@@ -91,7 +96,30 @@ TEST_F(MvccTest, Basic) {
   }
 }
 
+TEST_F(MvccTest, PendingOperationsHoldKeyLocks) {
+  ASSERT_TRUE(manager_.AllPendingOperationsHoldKeyLocks());
+  auto ht1 = manager_.AddLeaderPending(OpId(1, 1), HoldsKeyLocks::kTrue);
+  ASSERT_TRUE(manager_.AllPendingOperationsHoldKeyLocks());
+  auto ht2 = manager_.AddLeaderPending(OpId(1, 2));
+  auto ht3 = manager_.AddLeaderPending(OpId(1, 3), HoldsKeyLocks::kTrue);
+  ASSERT_FALSE(manager_.AllPendingOperationsHoldKeyLocks());
+  manager_.Replicated(ht1, OpId(1, 1));
+  ASSERT_FALSE(manager_.AllPendingOperationsHoldKeyLocks());
+  manager_.Replicated(ht2, OpId(1, 2));
+  ASSERT_TRUE(manager_.AllPendingOperationsHoldKeyLocks());
+  manager_.Replicated(ht3, OpId(1, 3));
+
+  auto ht4 = clock_->Now();
+  manager_.AddFollowerPending(ht4, OpId(1, 4));
+  ASSERT_FALSE(manager_.AllPendingOperationsHoldKeyLocks());
+  manager_.Replicated(ht4, OpId(1, 4));
+  ASSERT_TRUE(manager_.AllPendingOperationsHoldKeyLocks());
+}
+
 TEST_F(MvccTest, SafeHybridTimeToReadAt) {
+  // Lock free SafeTime calls are not recorded in the op trace.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_mvcc_lock_free_safe_time) = false;
+
   std::ostringstream mvcc_op_trace_stream;
   manager_.TEST_DumpTrace(&mvcc_op_trace_stream);
   ASSERT_STR_CONTAINS(mvcc_op_trace_stream.str(), "No MVCC operations");
@@ -328,6 +356,54 @@ TEST_F(MvccTest, RandomWithHTLease) {
   RunRandomizedTest(true);
 }
 
+TEST_F(MvccTest, RandomWithoutLockFreeSafeTime) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_mvcc_lock_free_safe_time) = false;
+  RunRandomizedTest(true);
+}
+
+// Measures SafeTime throughput with different number of reader threads, while single writer
+// adds and replicates operations.
+TEST_F(MvccTest, SafeTimeScalability) {
+  const auto kTestDuration = RegularBuildVsSanitizers(500ms, 100ms);
+  constexpr size_t kMaxReaders = 64;
+
+  std::atomic<int64_t> next_index{1};
+  for (bool lock_free : {false, true}) {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_mvcc_lock_free_safe_time) = lock_free;
+    for (size_t num_readers = 1; num_readers <= kMaxReaders; num_readers *= 2) {
+      TestThreadHolder thread_holder;
+      std::atomic<size_t> num_calls{0};
+      for (size_t i = 0; i != num_readers; ++i) {
+        thread_holder.AddThreadFunctor(
+            [this, &num_calls, &stop = thread_holder.stop_flag()] {
+          size_t calls = 0;
+          auto last_safe_time = HybridTime::kMin;
+          while (!stop.load(std::memory_order_acquire)) {
+            auto safe_time = manager_.SafeTime(FixedHybridTimeLease());
+            ASSERT_GE(safe_time, last_safe_time);
+            last_safe_time = safe_time;
+            ++calls;
+          }
+          num_calls.fetch_add(calls);
+        });
+      }
+      thread_holder.AddThreadFunctor(
+          [this, &next_index, &stop = thread_holder.stop_flag()] {
+        while (!stop.load(std::memory_order_acquire)) {
+          OpId op_id(1, next_index.fetch_add(1));
+          auto ht = manager_.AddLeaderPending(op_id);
+          std::this_thread::sleep_for(10us);
+          manager_.Replicated(ht, op_id);
+        }
+      });
+      thread_holder.WaitAndStop(kTestDuration);
+      LOG(INFO) << "Lock free: " << lock_free << ", readers: " << num_readers
+                << ", SafeTime calls per second: "
+                << num_calls.load() / ToSeconds(kTestDuration);
+    }
+  }
+}
+
 TEST_F(MvccTest, WaitForSafeTime) {
   constexpr uint64_t kLease = 10;
   constexpr uint64_t kDelta = 10;
@@ -56,6 +56,10 @@ DEFINE_test_flag(int64, mvcc_op_trace_num_items, 32,
 DEFINE_test_flag(int32, inject_mvcc_delay_add_leader_pending_ms, 0,
                  "Inject delay after MvccManager::AddLeaderPending read clock.");
 
+DEFINE_RUNTIME_bool(mvcc_lock_free_safe_time, true,
+                    "Whether MvccManager::SafeTime tries to compute safe time without acquiring "
+                    "the mutex, from the snapshot of pending operations published by writers.");
+
 namespace yb {
 namespace tablet {
 
@@ -272,8 +276,10 @@ void MvccManager::Replicated(HybridTime ht, const OpId& op_id) {
     CHECK(!queue_.empty()) << InvariantViolationLogPrefix();
     CHECK_EQ(queue_.front(),
              (QueueItem{ .hybrid_time = ht, .op_id = op_id })) << InvariantViolationLogPrefix();
+    BeginSnapshotUpdate();
     queue_.pop_front();
     last_replicated_ = ht;
+    FinishSnapshotUpdate();
   }
   cond_.notify_all();
 }
@@ -290,7 +296,9 @@ void MvccManager::Aborted(HybridTime ht, const OpId& op_id) {
     CHECK_EQ(queue_.back(),
              (QueueItem{ .hybrid_time = ht, .op_id = op_id }))
         << InvariantViolationLogPrefix() << "It is allowed to abort only last operation";
+    BeginSnapshotUpdate();
     queue_.pop_back();
+    FinishSnapshotUpdate();
   }
   cond_.notify_all();
 }
@@ -305,12 +313,19 @@ bool BadNextOpId(const OpId& prev, const OpId& next) {
   return false;
 }
 
-HybridTime MvccManager::AddLeaderPending(const OpId& op_id) {
+HybridTime MvccManager::AddLeaderPending(const OpId& op_id, HoldsKeyLocks holds_key_locks) {
   std::lock_guard<std::mutex> lock(mutex_);
+  // Lock free reader that read the clock before this point either sees the new operation, or
+  // returns safe time less than its hybrid time.
+  BeginSnapshotUpdate();
   auto ht = clock_->Now();
   AtomicFlagSleepMs(&FLAGS_TEST_inject_mvcc_delay_add_leader_pending_ms);
   VLOG_WITH_PREFIX(1) << __func__ << "(" << op_id << "), time: " << ht;
   AddPending(ht, op_id, /* is_follower_side= */ false);
+  FinishSnapshotUpdate();
+  if (!holds_key_locks) {
+    max_pending_without_key_locks_ = queue_.back().hybrid_time;
+  }
 
   if (op_trace_) {
     op_trace_->Add(AddLeaderPendingTraceItem {
@@ -326,7 +341,10 @@ void MvccManager::AddFollowerPending(HybridTime ht, const OpId& op_id) {
   std::lock_guard<std::mutex> lock(mutex_);
   VLOG_WITH_PREFIX(1) << __func__ << "(" << ht << ", " << op_id << ")";
 
+  BeginSnapshotUpdate();
   AddPending(ht, op_id, /* is_follower_side= */ true);
+  FinishSnapshotUpdate();
+  max_pending_without_key_locks_ = queue_.back().hybrid_time;
 
   if (op_trace_) {
     op_trace_->Add(AddFollowerPendingTraceItem {
@@ -336,15 +354,28 @@ void MvccManager::AddFollowerPending(HybridTime ht, const OpId& op_id) {
   }
 }
 
+void MvccManager::BeginSnapshotUpdate() {
+  snapshot_version_.fetch_add(1, std::memory_order_seq_cst);
+}
+
+void MvccManager::FinishSnapshotUpdate() {
+  snapshot_queue_front_.store(
+      queue_.empty() ? HybridTime::kMax : queue_.front().hybrid_time, std::memory_order_seq_cst);
+  snapshot_last_replicated_.store(last_replicated_, std::memory_order_seq_cst);
+  snapshot_version_.fetch_add(1, std::memory_order_seq_cst);
+}
+
 void MvccManager::AddPending(HybridTime ht, const OpId& op_id, bool is_follower_side) {
   CHECK(!op_id.empty());
 
   HybridTime last_ht_in_queue = queue_.empty() ? HybridTime::kMin : queue_.back().hybrid_time;
+  HybridTime max_safe_time_returned_with_lease = max_safe_time_returned_with_lease_.load();
+  HybridTime max_safe_time_returned_without_lease = max_safe_time_returned_without_lease_.load();
 
   HybridTime sanity_check_lower_bound =
       std::max({
-          max_safe_time_returned_with_lease_.safe_time,
-          max_safe_time_returned_without_lease_.safe_time,
+          max_safe_time_returned_with_lease,
+          max_safe_time_returned_without_lease,
           max_safe_time_returned_for_follower_.safe_time,
           propagated_safe_time_,
           last_replicated_,
@@ -365,8 +396,8 @@ void MvccManager::AddPending(HybridTime ht, const OpId& op_id, bool is_follower_
 #define LOG_INFO_FOR_HT_LOWER_BOUND(t) LOG_INFO_FOR_HT_LOWER_BOUND_IMPL(t, t)
 
       ss << "New operation's hybrid time too low: " << ht << ", op id: " << op_id
-         << LOG_INFO_FOR_HT_LOWER_BOUND_WITH_SOURCE(max_safe_time_returned_with_lease_)
-         << LOG_INFO_FOR_HT_LOWER_BOUND_WITH_SOURCE(max_safe_time_returned_without_lease_)
+         << LOG_INFO_FOR_HT_LOWER_BOUND(max_safe_time_returned_with_lease)
+         << LOG_INFO_FOR_HT_LOWER_BOUND(max_safe_time_returned_without_lease)
          << LOG_INFO_FOR_HT_LOWER_BOUND_WITH_SOURCE(max_safe_time_returned_for_follower_)
          << LOG_INFO_FOR_HT_LOWER_BOUND(last_replicated_)
          << LOG_INFO_FOR_HT_LOWER_BOUND(last_ht_in_queue)
@@ -416,7 +447,9 @@ void MvccManager::SetLastReplicated(HybridTime ht) {
     if (op_trace_) {
       op_trace_->Add(SetLastReplicatedTraceItem { .ht = ht });
     }
+    BeginSnapshotUpdate();
     last_replicated_ = ht;
+    FinishSnapshotUpdate();
   }
   cond_.notify_all();
 }
@@ -552,6 +585,13 @@ HybridTime MvccManager::SafeTime(
     HybridTime min_allowed,
     CoarseTimePoint deadline,
     const FixedHybridTimeLease& ht_lease) const NO_THREAD_SAFETY_ANALYSIS {
+  if (GetAtomicFlag(&FLAGS_mvcc_lock_free_safe_time)) {
+    auto safe_time = TryGetSafeTimeLockFree(min_allowed, ht_lease);
+    if (safe_time) {
+      return safe_time;
+    }
+  }
+
   std::unique_lock<std::mutex> lock(mutex_);
   auto safe_time = DoGetSafeTime(min_allowed, deadline, ht_lease, &lock);
   if (op_trace_) {
@@ -565,6 +605,75 @@ HybridTime MvccManager::SafeTime(
   return safe_time;
 }
 
+HybridTime MvccManager::ComputeSafeTime(
+    HybridTime queue_front, HybridTime last_replicated, const FixedHybridTimeLease& ht_lease,
+    HybridTime max_returned_with_lease, SafeTimeSource* source) const {
+  HybridTime result;
+  if (queue_front == HybridTime::kMax) {
+    result = ht_lease.time.is_valid()
+        ? std::max(max_returned_with_lease, ht_lease.time)
+        : clock_->Now();
+    *source = SafeTimeSource::kNow;
+    VLOG_WITH_PREFIX(2) << "DoGetSafeTime, Now: " << result;
+  } else {
+    result = queue_front.Decremented();
+    *source = SafeTimeSource::kNextInQueue;
+    VLOG_WITH_PREFIX(2) << "DoGetSafeTime, Queue front (decremented): " << result;
+  }
+
+  if (!ht_lease.empty()) {
+    auto used_lease = std::max({ht_lease.lease, max_returned_with_lease});
+    if (result > used_lease) {
+      result = used_lease;
+      *source = SafeTimeSource::kHybridTimeLease;
+    }
+  }
+
+  // This function could be invoked at a follower, so it has a very old ht_lease. In this case it
+  // is safe to read at least at last_replicated.
+  return std::max(result, last_replicated);
+}
+
+HybridTime MvccManager::TryGetSafeTimeLockFree(
+    HybridTime min_allowed, const FixedHybridTimeLease& ht_lease) const {
+  if (!ht_lease.lease.is_valid() || min_allowed > ht_lease.lease) {
+    // Let DoGetSafeTime report violated invariant.
+    return HybridTime::kInvalid;
+  }
+  if (!ht_lease.empty() && !ht_lease.time.is_valid()) {
+    return HybridTime::kInvalid;
+  }
+
+  // All accesses are sequentially consistent, so when version was not changed during computation,
+  // writer that adds new operation reads the clock after us, and the operation gets hybrid time
+  // greater than the result.
+  auto version = snapshot_version_.load(std::memory_order_seq_cst);
+  if (version & 1) {
+    return HybridTime::kInvalid;
+  }
+  auto queue_front = snapshot_queue_front_.load(std::memory_order_seq_cst);
+  auto last_replicated = snapshot_last_replicated_.load(std::memory_order_seq_cst);
+  const bool has_lease = !ht_lease.empty();
+  auto& max_returned = has_lease ? max_safe_time_returned_with_lease_
+                                 : max_safe_time_returned_without_lease_;
+  auto enforced_min_time = max_returned.load(std::memory_order_seq_cst);
+  auto max_returned_with_lease = has_lease
+      ? enforced_min_time : max_safe_time_returned_with_lease_.load(std::memory_order_seq_cst);
+
+  SafeTimeSource source = SafeTimeSource::kUnknown;
+  auto result = ComputeSafeTime(
+      queue_front, last_replicated, ht_lease, max_returned_with_lease, &source);
+  if (snapshot_version_.load(std::memory_order_seq_cst) != version ||
+      result < min_allowed || result < enforced_min_time) {
+    return HybridTime::kInvalid;
+  }
+
+  UpdateAtomicMax(&max_returned, result);
+  VTRACE(2, "Returning lock free safe time $0. Source $1. Min requested safe time was $2",
+         yb::ToString(result), yb::ToString(source), yb::ToString(min_allowed));
+  return result;
+}
+
 HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
                                       const CoarseTimePoint deadline,
                                       const FixedHybridTimeLease& ht_lease,
@@ -581,32 +690,19 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
     LOG_IF_WITH_PREFIX(DFATAL, !ht_lease.time.is_valid()) << "Bad ht lease: " << ht_lease;
   }
 
+  auto& max_returned = has_lease ? max_safe_time_returned_with_lease_
+                                 : max_safe_time_returned_without_lease_;
   HybridTime result;
+  HybridTime enforced_min_time;
   SafeTimeSource source = SafeTimeSource::kUnknown;
-  auto predicate = [this, &result, &source, min_allowed, ht_lease, has_lease] {
-    if (queue_.empty()) {
-      result = ht_lease.time.is_valid()
-          ? std::max(max_safe_time_returned_with_lease_.safe_time, ht_lease.time)
-          : clock_->Now();
-      source = SafeTimeSource::kNow;
-      VLOG_WITH_PREFIX(2) << "DoGetSafeTime, Now: " << result;
-    } else {
-      result = queue_.front().hybrid_time.Decremented();
-      source = SafeTimeSource::kNextInQueue;
-      VLOG_WITH_PREFIX(2) << "DoGetSafeTime, Queue front (decremented): " << result;
-    }
-
-    if (has_lease) {
-      auto used_lease = std::max({ht_lease.lease, max_safe_time_returned_with_lease_.safe_time});
-      if (result > used_lease) {
-        result = used_lease;
-        source = SafeTimeSource::kHybridTimeLease;
-      }
-    }
-
-    // This function could be invoked at a follower, so it has a very old ht_lease. In this case it
-    // is safe to read at least at last_replicated_.
-    result = std::max(result, last_replicated_);
+  auto predicate = [this, &result, &enforced_min_time, &source, &max_returned, min_allowed,
+                    ht_lease] {
+    // Lock free readers could update max returned safe time concurrently, so it is loaded before
+    // computing the result.
+    enforced_min_time = max_returned.load(std::memory_order_seq_cst);
+    result = ComputeSafeTime(
+        queue_.empty() ? HybridTime::kMax : queue_.front().hybrid_time, last_replicated_,
+        ht_lease, max_safe_time_returned_with_lease_.load(std::memory_order_seq_cst), &source);
     VTRACE(3, "Current safe time $0. Source $1", yb::ToString(result),
            yb::ToString(source));
 
@@ -623,8 +719,6 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
   VLOG_WITH_PREFIX_AND_FUNC(1)
       << "(" << min_allowed << ", " << ht_lease << "),  result = " << result;
 
-  auto enforced_min_time = has_lease ? max_safe_time_returned_with_lease_.safe_time
-                                     : max_safe_time_returned_without_lease_.safe_time;
   CHECK_GE(result, enforced_min_time)
       << InvariantViolationLogPrefix()
       << ": " << EXPR_VALUE_FOR_LOG(has_lease)
@@ -636,11 +730,7 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
       << ", " << EXPR_VALUE_FOR_LOG(queue_.size())
       << ", " << EXPR_VALUE_FOR_LOG(queue_);
 
-  if (has_lease) {
-    max_safe_time_returned_with_lease_ = { result, source };
-  } else {
-    max_safe_time_returned_without_lease_ = { result, source };
-  }
+  UpdateAtomicMax(&max_returned, result);
   VTRACE(2, "Returning safe time $0. Source $1. Min requested safe time was $2",
          yb::ToString(result), yb::ToString(source), yb::ToString(min_allowed));
   return result;
@@ -657,6 +747,13 @@ HybridTime MvccManager::LastReplicatedHybridTime() const {
   return last_replicated_;
 }
 
+bool MvccManager::AllPendingOperationsHoldKeyLocks() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Operations are replicated in order, so when the first pending operation is after the last
+  // operation without key locks, all pending operations hold them.
+  return queue_.empty() || queue_.front().hybrid_time > max_pending_without_key_locks_;
+}
+
 // Using NO_THREAD_SAFETY_ANALYSIS here because we're only reading op_trace_ here and it is set
 // in the constructor.
 MvccManager::InvariantViolationLoggingHelper MvccManager::InvariantViolationLogPrefix() const {
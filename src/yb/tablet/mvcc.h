@@ -31,6 +31,7 @@
 //
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <vector>
@@ -42,6 +43,7 @@
 #include "yb/util/enums.h"
 #include "yb/util/math_util.h"
 #include "yb/util/opid.h"
+#include "yb/util/strongly_typed_bool.h"
 
 namespace yb {
 namespace tablet {
@@ -51,6 +53,8 @@ namespace tablet {
 YB_DEFINE_ENUM(SafeTimeSource,
                (kUnknown)(kNow)(kNextInQueue)(kHybridTimeLease)(kPropagated)(kLastReplicated));
 
+YB_STRONGLY_TYPED_BOOL(HoldsKeyLocks);
+
 struct SafeTimeWithSource {
   HybridTime safe_time = HybridTime::kMin;
   SafeTimeSource source = SafeTimeSource::kUnknown;
@@ -107,7 +111,10 @@ class MvccManager {
 
   // Adds leader operation and returns its time.
   // OpId is being passed for the ease of debugging.
-  HybridTime AddLeaderPending(const OpId& op_id) EXCLUDES(mutex_);
+  // holds_key_locks - whether the operation holds locks on the keys it writes until it is
+  // replicated or aborted.
+  HybridTime AddLeaderPending(
+      const OpId& op_id, HoldsKeyLocks holds_key_locks = HoldsKeyLocks::kFalse) EXCLUDES(mutex_);
 
   // Notifies that operation with appropriate time was replicated.
   // It should be first operation in queue.
@@ -131,6 +138,9 @@ class MvccManager {
   //
   // Returns invalid hybrid time in case it cannot satisfy provided requirements, for instance
   // because of timeout.
+  //
+  // When safe time could be computed from the published snapshot of the queue, and it does not
+  // require waiting, mutex_ is not acquired and the call is not recorded in the op trace.
   HybridTime SafeTime(
       HybridTime min_allowed, CoarseTimePoint deadline, const FixedHybridTimeLease& ht_lease) const
       EXCLUDES(mutex_);
@@ -146,6 +156,10 @@ class MvccManager {
   // Returns time of last replicated operation.
   HybridTime LastReplicatedHybridTime() const EXCLUDES(mutex_);
 
+  // Returns true when all pending operations hold locks on the keys they write. In this case
+  // absence of conflicting locks on a key means that there are no pending writes to it.
+  bool AllPendingOperationsHoldKeyLocks() const EXCLUDES(mutex_);
+
   class MvccOpTrace;
 
   void TEST_DumpTrace(std::ostream* out);
@@ -156,6 +170,24 @@ class MvccManager {
                            const FixedHybridTimeLease& ht_lease,
                            std::unique_lock<std::mutex>* lock) const REQUIRES(mutex_);
 
+  // Tries to get safe time from the snapshot published by writers, without acquiring mutex_.
+  // Returns invalid hybrid time when snapshot was changed concurrently, or the result does not
+  // satisfy min_allowed, so caller should fall back to DoGetSafeTime.
+  HybridTime TryGetSafeTimeLockFree(
+      HybridTime min_allowed, const FixedHybridTimeLease& ht_lease) const;
+
+  // Computes safe time from the first pending operation time (kMax when there are no pending
+  // operations) and the time of the last replicated operation.
+  HybridTime ComputeSafeTime(
+      HybridTime queue_front, HybridTime last_replicated, const FixedHybridTimeLease& ht_lease,
+      HybridTime max_returned_with_lease, SafeTimeSource* source) const;
+
+  // Writers that change queue_ or last_replicated_ should surround changes with these calls, so
+  // lock free readers would detect concurrent change. Reading the clock for the new operation
+  // should also happen between these calls.
+  void BeginSnapshotUpdate() REQUIRES(mutex_);
+  void FinishSnapshotUpdate() REQUIRES(mutex_);
+
   const std::string& LogPrefix() const { return prefix_; }
 
   struct InvariantViolationLoggingHelper;
@@ -200,6 +232,10 @@ class MvccManager {
 
   HybridTime last_replicated_ = HybridTime::kMin;
 
+  // Max hybrid time of added operations, that don't hold key locks. Follower side operations never
+  // hold them.
+  HybridTime max_pending_without_key_locks_ = HybridTime::kMin;
+
   // If we are a follower, this is the latest safe time sent by the leader to us. If we are the
   // leader, this is a safe time that gets updated every time the majority-replicated watermarks
   // change.
@@ -207,8 +243,15 @@ class MvccManager {
   // Special flag for RF==1 mode when propagated_safe_time_ can be not up-to-date.
   bool leader_only_mode_ = false;
 
-  mutable SafeTimeWithSource max_safe_time_returned_with_lease_;
-  mutable SafeTimeWithSource max_safe_time_returned_without_lease_;
+  // Seqlock style snapshot of queue_ front and last_replicated_ for lock free SafeTime.
+  // snapshot_version_ is odd while writer is changing them.
+  std::atomic<uint64_t> snapshot_version_{0};
+  std::atomic<HybridTime> snapshot_queue_front_{HybridTime::kMax};
+  std::atomic<HybridTime> snapshot_last_replicated_{HybridTime::kMin};
+
+  // Updated by both lock free and regular SafeTime, so they are atomic.
+  mutable std::atomic<HybridTime> max_safe_time_returned_with_lease_{HybridTime::kMin};
+  mutable std::atomic<HybridTime> max_safe_time_returned_without_lease_{HybridTime::kMin};
   mutable SafeTimeWithSource max_safe_time_returned_for_follower_ { HybridTime::kMin };
 
   std::unique_ptr<MvccOpTrace> op_trace_ GUARDED_BY(mutex_);
@@ -117,7 +117,8 @@ void Operation::AddedToLeader(const OpId& op_id, const OpId& committed_op_id) {
   HybridTime hybrid_time;
   auto shared_tablet = tablet();
   if (use_mvcc()) {
-    hybrid_time = shared_tablet->mvcc_manager()->AddLeaderPending(op_id);
+    hybrid_time = shared_tablet->mvcc_manager()->AddLeaderPending(
+        op_id, HoldsKeyLocks(holds_key_locks()));
   } else {
     hybrid_time = shared_tablet->clock()->Now();
   }
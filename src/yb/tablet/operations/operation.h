@@ -212,6 +212,11 @@ class Operation {
     return false;
   }
 
+  // Whether this operation holds locks on the keys it writes, until it is replicated or aborted.
+  virtual bool holds_key_locks() const {
+    return false;
+  }
+
   // Initialize operation at leader side.
   // op_id - operation id.
   // committed_op_id - current committed operation id.
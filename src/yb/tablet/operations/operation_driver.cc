@@ -95,6 +95,7 @@ OperationDriver::OperationDriver(OperationTracker *operation_tracker,
       consensus_(consensus),
       preparer_(preparer),
       trace_(Trace::NewTraceForParent(Trace::CurrentTrace())),
+      call_accounting_(CallAccounting::Current()),
       start_time_(MonoTime::Now()),
       replication_state_(NOT_REPLICATING),
       prepare_state_(NOT_PREPARED),
@@ -198,6 +199,7 @@ void OperationDriver::AddedToLeader(const OpId& op_id, const OpId& committed_op_
   ADOPT_TRACE(trace());
   CHECK(!GetOpId().valid());
   op_id_copy_.store(op_id, boost::memory_order_release);
+  replication_timer_.Start(CallPhase::kReplication, call_accounting_.get());
 
   operation_->AddedToLeader(op_id, committed_op_id);
 
@@ -308,6 +310,7 @@ void OperationDriver::HandleFailure(const Status& status) {
 void OperationDriver::ReplicationFinished(
     const Status& status, int64_t leader_term, OpIds* applied_op_ids) {
   LOG_IF(DFATAL, status.ok() && !GetOpId().valid()) << "Invalid op id after replication";
+  replication_timer_.Stop();
 
   PrepareState prepare_state_copy;
   {
@@ -48,6 +48,7 @@
 
 #include "yb/tablet/operations/operation.h"
 
+#include "yb/util/call_accounting.h"
 #include "yb/util/status_fwd.h"
 #include "yb/util/lockfree.h"
 #include "yb/util/opid.h"
@@ -267,6 +268,10 @@ class OperationDriver : public RefCountedThreadSafe<OperationDriver>,
   // Trace object for tracing any operations started by this driver.
   scoped_refptr<Trace> trace_;
 
+  // Accounting of the call that submitted the operation, if it was sampled.
+  scoped_refptr<CallAccounting> call_accounting_;
+  CallPhaseTimer replication_timer_;
+
   const MonoTime start_time_;
 
   ReplicationState replication_state_;
@@ -58,6 +58,13 @@ DEFINE_int64(tablet_operation_memory_limit_mb, 1024,
              "disabled.");
 TAG_FLAG(tablet_operation_memory_limit_mb, advanced);
 
+DEFINE_RUNTIME_int32(tablet_operation_type_memory_limit_percentage, 100,
+    "Maximum percentage of the tablet operation memory limit that may be consumed by in-flight "
+    "operations of a single type. Operations of one type could use memory not used by other "
+    "types up to this limit, so the rest of memory stays available for other types. "
+    "100 means that there is no limit per operation type.");
+TAG_FLAG(tablet_operation_type_memory_limit_percentage, advanced);
+
 METRIC_DEFINE_gauge_uint64(tablet, all_operations_inflight,
                            "Operations In Flight",
                            yb::MetricUnit::kOperations,
@@ -106,6 +113,25 @@ METRIC_DEFINE_gauge_uint64(tablet, change_auto_flags_config_operations_inflight,
                            yb::MetricUnit::kOperations,
                            "Number of AutoFlags config change operations currently in-flight");
 
+#define DEFINE_MEMORY_PRESSURE_REJECTIONS(lower, description) \
+  METRIC_DEFINE_counter(tablet, BOOST_PP_CAT(lower, _operation_memory_pressure_rejections), \
+                        description " Operation Memory Pressure Rejections", \
+                        yb::MetricUnit::kOperations, \
+                        "Number of " description " operations rejected because the tablet's " \
+                        "operation memory limit or the limit of their type was reached.")
+
+DEFINE_MEMORY_PRESSURE_REJECTIONS(write, "Write");
+DEFINE_MEMORY_PRESSURE_REJECTIONS(alter_schema, "Change Metadata");
+DEFINE_MEMORY_PRESSURE_REJECTIONS(update_transaction, "Update Transaction");
+DEFINE_MEMORY_PRESSURE_REJECTIONS(snapshot, "Snapshot");
+DEFINE_MEMORY_PRESSURE_REJECTIONS(split, "Split");
+DEFINE_MEMORY_PRESSURE_REJECTIONS(truncate, "Truncate");
+DEFINE_MEMORY_PRESSURE_REJECTIONS(empty, "Empty");
+DEFINE_MEMORY_PRESSURE_REJECTIONS(history_cutoff, "History Cutoff");
+DEFINE_MEMORY_PRESSURE_REJECTIONS(change_auto_flags_config, "AutoFlags Config Change");
+
+#undef DEFINE_MEMORY_PRESSURE_REJECTIONS
+
 using namespace std::literals;
 using std::shared_ptr;
 using std::vector;
@@ -120,7 +146,10 @@ using strings::Substitute;
 #define GINIT(x) x(METRIC_##x.Instantiate(entity, 0))
 #define INSTANTIATE(upper, lower) \
   operations_inflight[to_underlying(OperationType::BOOST_PP_CAT(k, upper))] = \
-      BOOST_PP_CAT(BOOST_PP_CAT(METRIC_, lower), _operations_inflight).Instantiate(entity, 0);
+      BOOST_PP_CAT(BOOST_PP_CAT(METRIC_, lower), _operations_inflight).Instantiate(entity, 0); \
+  memory_pressure_rejections[to_underlying(OperationType::BOOST_PP_CAT(k, upper))] = \
+      BOOST_PP_CAT(BOOST_PP_CAT(METRIC_, lower), _operation_memory_pressure_rejections) \
+          .Instantiate(entity);
 OperationTracker::Metrics::Metrics(const scoped_refptr<MetricEntity>& entity)
     : GINIT(all_operations_inflight),
       MINIT(operation_memory_pressure_rejections) {
@@ -153,26 +182,60 @@ OperationTracker::~OperationTracker() {
 
 Status OperationTracker::Add(OperationDriver* driver) {
   int64_t driver_mem_footprint = driver->SpaceUsed();
-  if (mem_tracker_ && !mem_tracker_->TryConsume(driver_mem_footprint)) {
-    if (metrics_) {
-      metrics_->operation_memory_pressure_rejections->Increment();
+  if (mem_tracker_) {
+    auto type_index = to_underlying(driver->operation_type());
+    auto type_limit_percentage =
+        GetAtomicFlag(&FLAGS_tablet_operation_type_memory_limit_percentage);
+    int64_t type_consumption = 0;
+    int64_t type_limit = std::numeric_limits<int64_t>::max();
+    bool type_limit_exceeded = false;
+    if (type_limit_percentage < 100 && mem_tracker_->has_limit()) {
+      type_limit = mem_tracker_->limit() / 100 * std::max(type_limit_percentage, 0);
+      std::lock_guard<std::mutex> lock(mutex_);
+      type_consumption = type_memory_consumption_[type_index];
+      type_limit_exceeded = type_consumption + driver_mem_footprint > type_limit;
+      if (!type_limit_exceeded) {
+        // Reserve memory of the type before consuming it from the tracker, so concurrent adds
+        // could not exceed the limit of the type.
+        type_memory_consumption_[type_index] += driver_mem_footprint;
+      }
+    } else {
+      std::lock_guard<std::mutex> lock(mutex_);
+      type_memory_consumption_[type_index] += driver_mem_footprint;
     }
 
-    // May be nullptr due to TabletPeer::SetPropagatedSafeTime.
-    auto* operation = driver->operation();
+    if (type_limit_exceeded || !mem_tracker_->TryConsume(driver_mem_footprint)) {
+      if (!type_limit_exceeded) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        type_memory_consumption_[type_index] -= driver_mem_footprint;
+      }
+      if (metrics_) {
+        metrics_->operation_memory_pressure_rejections->Increment();
+        metrics_->memory_pressure_rejections[type_index]->Increment();
+      }
 
-    // May be nullptr in unit tests even when operation is not nullptr.
-    TabletPtr tablet = operation ? operation->tablet_nullable() : nullptr;
+      // May be nullptr due to TabletPeer::SetPropagatedSafeTime.
+      auto* operation = driver->operation();
 
-    string msg = Substitute(
-        "Operation failed, tablet $0 operation memory consumption ($1) "
-        "has exceeded its limit ($2) or the limit of an ancestral tracker",
-        tablet ? tablet->tablet_id() : "(unknown)",
-        mem_tracker_->consumption(), mem_tracker_->limit());
+      // May be nullptr in unit tests even when operation is not nullptr.
+      TabletPtr tablet = operation ? operation->tablet_nullable() : nullptr;
 
-    YB_LOG_EVERY_N_SECS(WARNING, 1) << msg << THROTTLE_MSG;
+      string msg = type_limit_exceeded
+          ? Format(
+                "Operation failed, tablet $0 memory consumption of $1 operations ($2) "
+                "has exceeded the limit of operation type ($3)",
+                tablet ? tablet->tablet_id() : "(unknown)", driver->operation_type(),
+                type_consumption, type_limit)
+          : Substitute(
+                "Operation failed, tablet $0 operation memory consumption ($1) "
+                "has exceeded its limit ($2) or the limit of an ancestral tracker",
+                tablet ? tablet->tablet_id() : "(unknown)",
+                mem_tracker_->consumption(), mem_tracker_->limit());
 
-    return STATUS(ServiceUnavailable, msg);
+      YB_LOG_EVERY_N_SECS(WARNING, 1) << msg << THROTTLE_MSG;
+
+      return STATUS(ServiceUnavailable, msg);
+    }
   }
 
   IncrementCounters(*driver);
@@ -180,7 +243,7 @@ Status OperationTracker::Add(OperationDriver* driver) {
   // Cache the operation memory footprint so we needn't refer to the request
   // again, as it may disappear between now and then.
   State st;
-  st.memory_footprint = driver_mem_footprint;
+  st.memory_footprint = mem_tracker_ ? driver_mem_footprint : 0;
   std::lock_guard<std::mutex> lock(mutex_);
   CHECK(pending_operations_.emplace(driver, st).second);
   return Status::OK();
@@ -219,6 +282,7 @@ void OperationTracker::Release(OperationDriver* driver, OpIds* applied_op_ids) {
     // below.
     std::lock_guard<std::mutex> lock(mutex_);
     st = FindOrDie(pending_operations_, driver);
+    type_memory_consumption_[to_underlying(operation_type)] -= st.memory_footprint;
     if (PREDICT_FALSE(pending_operations_.erase(driver) != 1)) {
       LOG_WITH_PREFIX(FATAL) << "Could not remove pending operation from map: "
           << driver->ToStringUnlocked();
@@ -102,6 +102,7 @@ class OperationTracker {
     scoped_refptr<AtomicGauge<uint64_t> > operations_inflight[kOperationTypeMapSize];
 
     scoped_refptr<Counter> operation_memory_pressure_rejections;
+    scoped_refptr<Counter> memory_pressure_rejections[kOperationTypeMapSize];
   };
 
   // Increments relevant metric counters.
@@ -131,6 +132,9 @@ class OperationTracker {
       ScopedRefPtrEqualsFunctor> OperationMap;
   OperationMap pending_operations_ GUARDED_BY(mutex_);
 
+  // Memory consumed by pending operations of each type, tracked only when mem_tracker_ is set.
+  int64_t type_memory_consumption_[kOperationTypeMapSize] GUARDED_BY(mutex_) = {};
+
   std::unique_ptr<Metrics> metrics_;
 
   std::shared_ptr<MemTracker> mem_tracker_;
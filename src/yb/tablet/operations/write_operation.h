@@ -67,6 +67,14 @@ class WriteOperation : public OperationBase<OperationType::kWrite, LWWritePB>  {
     return true;
   }
 
+  bool holds_key_locks() const override {
+    return holds_key_locks_;
+  }
+
+  void set_holds_key_locks(bool value) {
+    holds_key_locks_ = value;
+  }
+
  private:
   // Executes a Prepare for a write transaction
   //
@@ -99,6 +107,8 @@ class WriteOperation : public OperationBase<OperationType::kWrite, LWWritePB>  {
   Status DoAborted(const Status& status) override;
 
   HybridTime WriteHybridTime() const override;
+
+  bool holds_key_locks_ = false;
 };
 
 }  // namespace tablet
@@ -15,6 +15,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -33,6 +34,7 @@
 #include "yb/util/flags.h"
 #include "yb/util/lockfree.h"
 #include "yb/util/logging.h"
+#include "yb/util/monotime.h"
 #include "yb/util/threadpool.h"
 
 DEFINE_uint64(max_group_replicate_batch_size, 16,
@@ -41,6 +43,12 @@ DEFINE_uint64(max_group_replicate_batch_size, 16,
 DEFINE_double(estimated_replicate_msg_size_percentage, 0.95,
               "The estimated percentage of replicate message size in a log entry batch.");
 
+DEFINE_RUNTIME_uint64(preparer_batch_max_delay_us, 0,
+    "Max time the first operation of the leader-side batch could be held by the preparer, waiting "
+    "for more operations to replicate them together. The preparer waits only when the measured "
+    "operation arrival rate says that the next operation is expected within this time. "
+    "0 disables waiting.");
+
 DEFINE_test_flag(int32, preparer_batch_inject_latency_ms, 0,
                  "Inject latency before replicating batch.");
 
@@ -109,7 +117,15 @@ class PreparerImpl {
   std::mutex stop_mtx_;
   std::condition_variable stop_cond_;
 
+  // Time of the last submitted leader-side operation and moving average of the interval between
+  // such operations, in nanoseconds. Updated without synchronization, because they are used only
+  // as a hint for batching.
+  std::atomic<int64_t> last_submit_time_ns_{0};
+  std::atomic<int64_t> avg_submit_interval_ns_{std::numeric_limits<int64_t>::max()};
+
   OperationDrivers leader_side_batch_;
+  // Time when the first operation was added to leader_side_batch_.
+  MonoTime leader_side_batch_start_;
   size_t leader_side_batch_size_estimate_ = 0;
   const size_t leader_side_batch_size_limit_;
   const size_t leader_side_single_op_size_limit_;
@@ -122,6 +138,13 @@ class PreparerImpl {
   void Run();
   void ProcessItem(OperationDriver* item);
 
+  void UpdateSubmitInterval();
+
+  // Waits for more leader-side operations while it is worth to hold the current batch, according
+  // to preparer_batch_max_delay_us and the rate of submitted operations. Returns true when new
+  // operations were submitted.
+  bool WaitForMoreLeaderSideOperations();
+
   void ProcessAndClearLeaderSideBatch();
 
   void ProcessFailedItem(OperationDriver* item, Status status);
@@ -182,6 +205,7 @@ Status PreparerImpl::Submit(OperationDriver* operation_driver) {
   if (leader_side) {
     // Prepare leader-side operations on the "preparer thread" so we can only acquire the
     // ReplicaState lock once and append multiple operations.
+    UpdateSubmitInterval();
     active_tasks_.fetch_add(1, std::memory_order_release);
     queue_.Push(operation_driver);
   } else {
@@ -208,6 +232,9 @@ void PreparerImpl::Run() {
       active_tasks_.fetch_sub(1, std::memory_order_release);
       ProcessItem(item);
     }
+    if (WaitForMoreLeaderSideOperations()) {
+      continue;
+    }
     ProcessAndClearLeaderSideBatch();
     std::unique_lock<std::mutex> stop_lock(stop_mtx_);
     running_.store(false, std::memory_order_release);
@@ -230,6 +257,52 @@ void PreparerImpl::Run() {
   }
 }
 
+void PreparerImpl::UpdateSubmitInterval() {
+  if (GetAtomicFlag(&FLAGS_preparer_batch_max_delay_us) == 0) {
+    return;
+  }
+  int64_t now = MonoTime::Now().ToUint64();
+  auto last = last_submit_time_ns_.exchange(now, std::memory_order_acq_rel);
+  if (last == 0 || now <= last) {
+    return;
+  }
+  int64_t interval = now - last;
+  auto avg = avg_submit_interval_ns_.load(std::memory_order_acquire);
+  // Exponentially weighted moving average, with weight 1/8 for the new interval.
+  avg_submit_interval_ns_.store(
+      avg == std::numeric_limits<int64_t>::max() ? interval : avg - avg / 8 + interval / 8,
+      std::memory_order_release);
+}
+
+bool PreparerImpl::WaitForMoreLeaderSideOperations() {
+  if (leader_side_batch_.empty() ||
+      leader_side_batch_.size() >= FLAGS_max_group_replicate_batch_size) {
+    return false;
+  }
+  auto max_delay_us = GetAtomicFlag(&FLAGS_preparer_batch_max_delay_us);
+  if (max_delay_us == 0) {
+    return false;
+  }
+  auto deadline = leader_side_batch_start_ + MonoDelta::FromMicroseconds(max_delay_us);
+  auto now = MonoTime::Now();
+  auto expected_arrival = MonoDelta::FromNanoseconds(
+      avg_submit_interval_ns_.load(std::memory_order_acquire));
+  if (now >= deadline || expected_arrival > deadline.GetDeltaSince(now)) {
+    return false;
+  }
+  // Delays are in microseconds, so don't sleep and just yield.
+  while (!stop_requested_.load(std::memory_order_acquire)) {
+    if (active_tasks_.load(std::memory_order_acquire)) {
+      return true;
+    }
+    if (MonoTime::Now() >= deadline) {
+      break;
+    }
+    std::this_thread::yield();
+  }
+  return false;
+}
+
 namespace {
 
 bool ShouldApplySeparately(OperationType operation_type) {
@@ -291,6 +364,9 @@ void PreparerImpl::ProcessItem(OperationDriver* item) {
           bound_term != leader_side_batch_.back()->consensus_round()->bound_term())) {
     ProcessAndClearLeaderSideBatch();
   }
+  if (leader_side_batch_.empty()) {
+    leader_side_batch_start_ = MonoTime::Now();
+  }
   leader_side_batch_.push_back(item);
   leader_side_batch_size_estimate_ += item_replicate_msg_size;
   if (apply_separately) {
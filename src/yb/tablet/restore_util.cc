@@ -178,9 +178,7 @@ Status RestorePatch::PatchCurrentStateFromRestoringState() {
 }
 
 void AddKeyValue(const Slice& key, const Slice& value, docdb::DocWriteBatch* write_batch) {
-  auto& pair = write_batch->AddRaw();
-  pair.key.assign(key.cdata(), key.size());
-  pair.value.assign(value.cdata(), value.size());
+  write_batch->AddRaw(key, value);
 }
 
 void WriteToRocksDB(
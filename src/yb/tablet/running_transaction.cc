@@ -13,17 +13,23 @@
 
 #include "yb/tablet/running_transaction.h"
 
+#include <algorithm>
+
 #include "yb/client/transaction_rpc.h"
 
 #include "yb/common/hybrid_time.h"
 #include "yb/common/pgsql_error.h"
 
+#include "yb/gutil/walltime.h"
+
+#include "yb/tablet/shared_transaction_status_cache.h"
 #include "yb/tablet/transaction_participant_context.h"
 
 #include "yb/tserver/tserver_service.pb.h"
 
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 #include "yb/util/trace.h"
 #include "yb/util/tsan_util.h"
 #include "yb/util/yb_pg_errcodes.h"
@@ -43,6 +49,47 @@ DEFINE_int64(transaction_abort_check_timeout_ms, 30000 * yb::kTimeMultiplier,
 namespace yb {
 namespace tablet {
 
+void RunningTransactionContext::AddPendingApply(ApplyIntentsTask* task) {
+  IncrementGauge(metric_large_transactions_applying_);
+  std::lock_guard<std::mutex> lock(pending_applies_mutex_);
+  pending_applies_.push_back(task);
+}
+
+std::vector<ApplyIntentsTask*> RunningTransactionContext::TakePendingApplies(
+    ApplyIntentsTask* task, size_t max_tasks) {
+  std::vector<ApplyIntentsTask*> result;
+  std::lock_guard<std::mutex> lock(pending_applies_mutex_);
+  auto it = std::find(pending_applies_.begin(), pending_applies_.end(), task);
+  if (it != pending_applies_.end()) {
+    pending_applies_.erase(it);
+  }
+  while (result.size() + 1 < max_tasks && !pending_applies_.empty()) {
+    result.push_back(pending_applies_.front());
+    pending_applies_.pop_front();
+  }
+  return result;
+}
+
+bool RunningTransactionContext::RemovePendingApply(ApplyIntentsTask* task) {
+  std::lock_guard<std::mutex> lock(pending_applies_mutex_);
+  auto it = std::find(pending_applies_.begin(), pending_applies_.end(), task);
+  if (it == pending_applies_.end()) {
+    return false;
+  }
+  pending_applies_.erase(it);
+  return true;
+}
+
+void RunningTransactionContext::LargeApplyFinished(HybridTime commit_ht) {
+  DecrementGauge(metric_large_transactions_applying_);
+  if (commit_ht.is_valid() && metric_large_transaction_apply_lag_) {
+    auto now_micros = GetCurrentTimeMicros();
+    auto commit_micros = commit_ht.GetPhysicalValueMicros();
+    metric_large_transaction_apply_lag_->Increment(
+        now_micros > commit_micros ? now_micros - commit_micros : 0);
+  }
+}
+
 RunningTransaction::RunningTransaction(TransactionMetadata metadata,
                                        const TransactionalBatchData& last_batch_data,
                                        OneWayBitmap&& replicated_batches,
@@ -115,6 +162,9 @@ void RunningTransaction::RequestStatusAt(const StatusRequest& request,
       return;
     }
   }
+  if (RequestStatusFromSharedCache(request, lock)) {
+    return;
+  }
   bool was_empty = status_waiters_.empty();
   status_waiters_.push_back(request);
   if (!was_empty) {
@@ -132,6 +182,35 @@ void RunningTransaction::RequestStatusAt(const StatusRequest& request,
   SendStatusRequest(request_id, shared_self);
 }
 
+bool RunningTransaction::RequestStatusFromSharedCache(
+    const StatusRequest& request, std::unique_lock<std::mutex>* lock) {
+  if (!context_.shared_status_cache_) {
+    return false;
+  }
+  auto cached = context_.shared_status_cache_->Get(id());
+  if (!cached) {
+    return false;
+  }
+  auto transaction_status = GetStatusAt(
+      request.global_limit_ht, cached->status_time, cached->status);
+  if (!transaction_status && cached->status == TransactionStatus::PENDING &&
+      request.flags.Test(TransactionLoadFlag::kAcceptRecentPending)) {
+    transaction_status = TransactionStatus::PENDING;
+  }
+  if (!transaction_status) {
+    return false;
+  }
+  VLOG_WITH_PREFIX(4) << "Status from shared cache: " << *cached << ", requested: "
+                      << request.ToString();
+  TransactionStatusResult result{*transaction_status, cached->status_time};
+  if (*transaction_status != TransactionStatus::ABORTED) {
+    result.aborted_subtxn_set = std::move(cached->aborted_subtxn_set);
+  }
+  lock->unlock();
+  request.callback(std::move(result));
+  return true;
+}
+
 bool RunningTransaction::WasAborted() const {
   return last_known_status_ == TransactionStatus::ABORTED;
 }
@@ -213,22 +292,59 @@ boost::optional<TransactionStatus> RunningTransaction::GetStatusAt(
 }
 
 void RunningTransaction::SendStatusRequest(
-    int64_t serial_no, const RunningTransactionPtr& shared_self) {
+    int64_t serial_no, const RunningTransactionPtr& shared_self, bool allow_shared) {
   TRACE_FUNC();
   VTRACE(1, yb::ToString(metadata_.transaction_id));
+  auto* shared_cache = allow_shared ? context_.shared_status_cache_ : nullptr;
+  const auto status_tablet = metadata_.status_tablet;
+  if (shared_cache && !shared_cache->StartStatusRequest(
+          id(), status_tablet,
+          [this, serial_no, shared_self](
+              const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+            SharedStatusReceived(status, response, serial_no, shared_self);
+          })) {
+    VLOG_WITH_PREFIX(4) << "Joined status request in flight";
+    return;
+  }
   tserver::GetTransactionStatusRequestPB req;
-  req.set_tablet_id(metadata_.status_tablet);
+  req.set_tablet_id(status_tablet);
   req.add_transaction_id()->assign(
       pointer_cast<const char*>(metadata_.transaction_id.data()), metadata_.transaction_id.size());
   req.set_propagated_hybrid_time(context_.participant_context_.Now().ToUint64());
-  context_.rpcs_.RegisterAndStart(
+  auto sent = context_.rpcs_.RegisterAndStart(
       client::GetTransactionStatus(
           TransactionRpcDeadline(),
           nullptr /* tablet */,
           context_.participant_context_.client_future().get(),
           &req,
-          std::bind(&RunningTransaction::StatusReceived, this, _1, _2, serial_no, shared_self)),
+          [this, serial_no, shared_self, shared_cache, status_tablet](
+              const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+            if (shared_cache) {
+              shared_cache->StatusRequestDone(id(), status_tablet, status, response);
+            }
+            StatusReceived(status, response, serial_no, shared_self);
+          }),
       &get_status_handle_);
+  if (!sent && shared_cache) {
+    shared_cache->StatusRequestDone(
+        id(), status_tablet, STATUS(Aborted, "Status request was not sent"),
+        tserver::GetTransactionStatusResponsePB());
+  }
+}
+
+void RunningTransaction::SharedStatusReceived(
+    const Status& status, const tserver::GetTransactionStatusResponsePB& response,
+    int64_t serial_no, const RunningTransactionPtr& shared_self) {
+  if (!status.ok()) {
+    // Failure of the request sent on behalf of another tablet, does not mean that we would fail
+    // to get status, so send own request.
+    VLOG_WITH_PREFIX(4) << "Shared status request failed: " << status;
+    SendStatusRequest(serial_no, shared_self, /* allow_shared= */ false);
+    return;
+  }
+  // The shared request could be sent before our waiters were registered, so its serial number
+  // does not tell anything about them, and only status time could be used to notify them.
+  StatusReceived(status, response, kSharedStatusRequestSerialNo, shared_self);
 }
 
 void RunningTransaction::StatusReceived(
@@ -348,6 +464,16 @@ void RunningTransaction::DoStatusReceived(const Status& status,
     transaction_status = last_known_status_;
     aborted_subtxn_set = last_known_aborted_subtxn_set_;
 
+    if (context_.shared_status_cache_) {
+      if (transaction_status == TransactionStatus::COMMITTED) {
+        context_.shared_status_cache_->Committed(id(), time_of_status, aborted_subtxn_set);
+      } else if (transaction_status == TransactionStatus::ABORTED) {
+        context_.shared_status_cache_->Aborted(id(), time_of_status);
+      } else if (transaction_status == TransactionStatus::PENDING) {
+        context_.shared_status_cache_->Pending(id(), time_of_status, aborted_subtxn_set);
+      }
+    }
+
     status_waiters = ExtractFinishedStatusWaitersUnlocked(
         serial_no, time_of_status, transaction_status);
     if (!status_waiters_.empty()) {
@@ -370,9 +496,11 @@ std::vector<StatusRequest> RunningTransaction::ExtractFinishedStatusWaitersUnloc
   result.reserve(status_waiters_.size());
   auto w = status_waiters_.begin();
   for (auto it = status_waiters_.begin(); it != status_waiters_.end(); ++it) {
+    // Response of the shared request could be older than read time of the waiter, in this case
+    // waiter should wait for the next request instead of failing.
     if (it->serial_no <= serial_no ||
         GetStatusAt(it->global_limit_ht, time_of_status, transaction_status) ||
-        time_of_status < it->read_ht) {
+        (serial_no != kSharedStatusRequestSerialNo && time_of_status < it->read_ht)) {
       result.push_back(std::move(*it));
     } else {
       if (w != it) {
@@ -404,7 +532,8 @@ void RunningTransaction::NotifyWaiters(int64_t serial_no, HybridTime time_of_sta
       // It means that between read_ht and global_limit_ht transaction was pending.
       // It implies that transaction was not committed before request was sent.
       // We could safely respond PENDING to caller.
-      LOG_IF_WITH_PREFIX(DFATAL, waiter.serial_no > serial_no)
+      LOG_IF_WITH_PREFIX(DFATAL, serial_no != kSharedStatusRequestSerialNo &&
+                                 waiter.serial_no > serial_no)
           << "Notify waiter with request id greater than id of status request: "
           << waiter.serial_no << " vs " << serial_no;
       waiter.callback(TransactionStatusResult{
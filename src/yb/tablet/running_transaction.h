@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <limits>
 #include <memory>
 
 #include "yb/client/client_fwd.h"
@@ -55,6 +56,17 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
     return abort_check_ht_;
   }
 
+  // Start time of the transaction, or kMax when its intents were already applied to regular DB.
+  HybridTime not_applied_start_ht() const {
+    return intents_applied_ ? HybridTime::kMax : start_ht();
+  }
+
+  // Marks that intents of this transaction were applied to regular DB, while the transaction is
+  // kept for CDC or running requests.
+  void SetIntentsApplied() {
+    intents_applied_ = true;
+  }
+
   MUST_USE_RESULT bool UpdateStatus(
       TransactionStatus transaction_status, HybridTime time_of_status,
       HybridTime coordinator_safe_time, AbortedSubTransactionSet aborted_subtxn_set);
@@ -129,7 +141,24 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
       HybridTime last_known_status_hybrid_time,
       TransactionStatus last_known_status);
 
-  void SendStatusRequest(int64_t serial_no, const RunningTransactionPtr& shared_self);
+  // Responds to request using status from shared cache, if it is known there.
+  // Returns true if request was handled, in this case lock is released.
+  bool RequestStatusFromSharedCache(
+      const StatusRequest& request, std::unique_lock<std::mutex>* lock);
+
+  // Serial number used to process response of the status request, that was shared with other
+  // participants. Such response does not satisfy waiters by serial number.
+  static constexpr int64_t kSharedStatusRequestSerialNo = std::numeric_limits<int64_t>::min();
+
+  // When allow_shared is true, the request could be coalesced with the request for the same
+  // transaction, that is already sent by another participant of this node.
+  void SendStatusRequest(
+      int64_t serial_no, const RunningTransactionPtr& shared_self, bool allow_shared = true);
+
+  void SharedStatusReceived(const Status& status,
+                            const tserver::GetTransactionStatusResponsePB& response,
+                            int64_t serial_no,
+                            const RunningTransactionPtr& shared_self);
 
   void StatusReceived(const Status& status,
                       const tserver::GetTransactionStatusResponsePB& response,
@@ -180,6 +209,7 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
   docdb::ApplyTransactionState apply_state_;
   // Atomic that reflects active state, required to provide concurrent access to ProcessingApply.
   std::atomic<bool> processing_apply_{false};
+  bool intents_applied_ = false;
   ApplyIntentsTask apply_intents_task_;
 
   // Time of the next check whether this transaction has been aborted.
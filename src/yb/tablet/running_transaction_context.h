@@ -15,14 +15,17 @@
 
 #include <stdint.h>
 
+#include <deque>
 #include <functional>
 #include <mutex>
 #include <type_traits>
+#include <vector>
 
 #include "yb/util/flags.h"
 
 #include "yb/gutil/callback.h"
 #include "yb/gutil/integral_types.h"
+#include "yb/gutil/thread_annotations.h"
 
 #include "yb/rpc/rpc.h"
 
@@ -31,6 +34,7 @@
 
 #include "yb/util/delayer.h"
 #include "yb/util/math_util.h"
+#include "yb/util/metrics_fwd.h"
 #include "yb/util/shared_lock.h"
 #include "yb/util/status_callback.h"
 
@@ -55,6 +59,7 @@ class MinRunningNotifier {
   TransactionIntentApplier* applier_;
 };
 
+class ApplyIntentsTask;
 class RunningTransaction;
 
 typedef std::shared_ptr<RunningTransaction> RunningTransactionPtr;
@@ -62,8 +67,10 @@ typedef std::shared_ptr<RunningTransaction> RunningTransactionPtr;
 class RunningTransactionContext {
  public:
   RunningTransactionContext(TransactionParticipantContext* participant_context,
-                            TransactionIntentApplier* applier)
-      : participant_context_(*participant_context), applier_(*applier) {
+                            TransactionIntentApplier* applier,
+                            SharedTransactionStatusCache* shared_status_cache)
+      : participant_context_(*participant_context), applier_(*applier),
+        shared_status_cache_(shared_status_cache) {
   }
 
   virtual ~RunningTransactionContext() {}
@@ -86,15 +93,37 @@ class RunningTransactionContext {
 
   virtual bool Closing() const = 0;
 
+  // Registers apply intents task of large transaction, that was submitted to the strand.
+  void AddPendingApply(ApplyIntentsTask* task);
+
+  // Removes task from pending applies and takes up to max_tasks - 1 other pending tasks,
+  // whose intents will be applied together with intents of the specified task.
+  std::vector<ApplyIntentsTask*> TakePendingApplies(ApplyIntentsTask* task, size_t max_tasks);
+
+  // Removes task from pending applies. Returns false if the task was already taken.
+  bool RemovePendingApply(ApplyIntentsTask* task);
+
+  // Invoked when apply of large transaction is finished. commit_ht is invalid when apply was
+  // interrupted.
+  void LargeApplyFinished(HybridTime commit_ht);
+
  protected:
   friend class RunningTransaction;
 
   rpc::Rpcs rpcs_;
   TransactionParticipantContext& participant_context_;
   TransactionIntentApplier& applier_;
+  // Final statuses of transactions, shared by participants of the tablet server. Could be null.
+  SharedTransactionStatusCache* const shared_status_cache_;
   int64_t request_serial_ = 0;
   std::mutex mutex_;
 
+  std::mutex pending_applies_mutex_;
+  std::deque<ApplyIntentsTask*> pending_applies_ GUARDED_BY(pending_applies_mutex_);
+
+  scoped_refptr<AtomicGauge<uint64_t>> metric_large_transactions_applying_;
+  scoped_refptr<Histogram> metric_large_transaction_apply_lag_;
+
   // Used only in tests.
   Delayer delayer_;
 };
@@ -0,0 +1,132 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <thread>
+#include <vector>
+
+#include "yb/tablet/shared_transaction_status_cache.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+DECLARE_uint64(conflict_resolution_pending_status_ttl_ms);
+
+namespace yb {
+namespace tablet {
+
+class SharedTransactionStatusCacheTest : public YBTest {
+};
+
+TEST_F(SharedTransactionStatusCacheTest, Simple) {
+  SharedTransactionStatusCache cache(1000);
+  auto committed_id = TransactionId::GenerateRandom();
+  auto aborted_id = TransactionId::GenerateRandom();
+  const HybridTime kCommitTime(1000);
+  const HybridTime kSafeTime(2000);
+  AbortedSubTransactionSet aborted_subtxn_set;
+  ASSERT_OK(aborted_subtxn_set.SetRange(2, 3));
+
+  ASSERT_FALSE(cache.Get(committed_id));
+
+  cache.Committed(committed_id, kCommitTime, aborted_subtxn_set);
+  cache.Aborted(aborted_id, kSafeTime);
+
+  auto committed = cache.Get(committed_id);
+  ASSERT_TRUE(committed);
+  ASSERT_EQ(committed->status, TransactionStatus::COMMITTED);
+  ASSERT_EQ(committed->status_time, kCommitTime);
+  ASSERT_EQ(committed->aborted_subtxn_set, aborted_subtxn_set);
+
+  auto aborted = cache.Get(aborted_id);
+  ASSERT_TRUE(aborted);
+  ASSERT_EQ(aborted->status, TransactionStatus::ABORTED);
+  ASSERT_EQ(aborted->status_time, kSafeTime);
+
+  // Commit takes precedence over abort, that coordinator reports after the transaction was
+  // applied everywhere and forgotten.
+  cache.Aborted(committed_id, kSafeTime);
+  ASSERT_EQ(cache.Get(committed_id)->status, TransactionStatus::COMMITTED);
+  cache.Committed(aborted_id, kCommitTime, AbortedSubTransactionSet());
+  ASSERT_EQ(cache.Get(aborted_id)->status, TransactionStatus::COMMITTED);
+}
+
+TEST_F(SharedTransactionStatusCacheTest, Bounded) {
+  constexpr size_t kCapacity = 160;
+  SharedTransactionStatusCache cache(kCapacity);
+  std::vector<TransactionId> ids;
+  for (size_t i = 0; i != kCapacity * 10; ++i) {
+    ids.push_back(TransactionId::GenerateRandom());
+    cache.Committed(ids.back(), HybridTime(i + 1), AbortedSubTransactionSet());
+    ASSERT_LE(cache.TEST_Size(), kCapacity);
+  }
+  // The first added transaction was evicted, while the last one is still there.
+  ASSERT_FALSE(cache.Get(ids.front()));
+  ASSERT_TRUE(cache.Get(ids.back()));
+}
+
+TEST_F(SharedTransactionStatusCacheTest, Pending) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_conflict_resolution_pending_status_ttl_ms) = 100;
+  SharedTransactionStatusCache cache(1000);
+  auto id = TransactionId::GenerateRandom();
+
+  cache.Pending(id, HybridTime(1000), AbortedSubTransactionSet());
+  auto pending = cache.Get(id);
+  ASSERT_TRUE(pending);
+  ASSERT_EQ(pending->status, TransactionStatus::PENDING);
+  ASSERT_EQ(pending->status_time, HybridTime(1000));
+
+  // Older pending status does not replace the newer one.
+  cache.Pending(id, HybridTime(500), AbortedSubTransactionSet());
+  ASSERT_EQ(cache.Get(id)->status_time, HybridTime(1000));
+
+  cache.Committed(id, HybridTime(2000), AbortedSubTransactionSet());
+  cache.Pending(id, HybridTime(3000), AbortedSubTransactionSet());
+  ASSERT_EQ(cache.Get(id)->status, TransactionStatus::COMMITTED);
+
+  auto expiring_id = TransactionId::GenerateRandom();
+  cache.Pending(expiring_id, HybridTime(1000), AbortedSubTransactionSet());
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  ASSERT_FALSE(cache.Get(expiring_id));
+  // Final status does not expire.
+  ASSERT_TRUE(cache.Get(id));
+}
+
+TEST_F(SharedTransactionStatusCacheTest, CoalesceRequests) {
+  SharedTransactionStatusCache cache(1000);
+  auto id = TransactionId::GenerateRandom();
+  const TabletId kStatusTablet = "status_tablet";
+  size_t responses = 0;
+  auto callback = [&responses](const Status& status, const auto& response) {
+    ASSERT_OK(status);
+    ++responses;
+  };
+
+  ASSERT_TRUE(cache.StartStatusRequest(id, kStatusTablet, callback));
+  ASSERT_FALSE(cache.StartStatusRequest(id, kStatusTablet, callback));
+  ASSERT_FALSE(cache.StartStatusRequest(id, kStatusTablet, callback));
+  // Request to another status tablet is not coalesced.
+  ASSERT_TRUE(cache.StartStatusRequest(id, "other_status_tablet", callback));
+
+  cache.StatusRequestDone(
+      id, kStatusTablet, Status::OK(), tserver::GetTransactionStatusResponsePB());
+  ASSERT_EQ(responses, 2);
+
+  // Next request is sent again.
+  ASSERT_TRUE(cache.StartStatusRequest(id, kStatusTablet, callback));
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,166 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/shared_transaction_status_cache.h"
+
+#include <algorithm>
+
+#include <boost/functional/hash.hpp>
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/logging.h"
+
+DEFINE_RUNTIME_uint64(conflict_resolution_pending_status_ttl_ms, 10,
+    "For how long pending status of the transaction received from coordinator could be used by "
+    "conflict resolution on any tablet of the node, instead of requesting it again. "
+    "0 to disable.");
+
+namespace yb {
+namespace tablet {
+
+size_t SharedTransactionStatusCache::RequestKeyHash::operator()(const RequestKey& key) const {
+  size_t result = TransactionIdHash()(key.first);
+  boost::hash_combine(result, key.second);
+  return result;
+}
+
+SharedTransactionStatusCache::SharedTransactionStatusCache(size_t capacity)
+    : shard_capacity_(std::max<size_t>(capacity / kNumShards, 1)) {
+}
+
+void SharedTransactionStatusCache::Committed(
+    const TransactionId& id, HybridTime commit_ht,
+    const AbortedSubTransactionSet& aborted_subtxn_set) {
+  DCHECK(commit_ht.is_valid());
+  Put(id, TransactionStatusResult(TransactionStatus::COMMITTED, commit_ht, aborted_subtxn_set));
+}
+
+void SharedTransactionStatusCache::Aborted(const TransactionId& id, HybridTime status_time) {
+  Put(id, TransactionStatusResult(TransactionStatus::ABORTED, status_time));
+}
+
+void SharedTransactionStatusCache::Pending(
+    const TransactionId& id, HybridTime status_time,
+    const AbortedSubTransactionSet& aborted_subtxn_set) {
+  auto ttl_ms = FLAGS_conflict_resolution_pending_status_ttl_ms;
+  if (ttl_ms == 0) {
+    return;
+  }
+  Put(id, TransactionStatusResult(TransactionStatus::PENDING, status_time, aborted_subtxn_set),
+      CoarseMonoClock::now() + std::chrono::milliseconds(ttl_ms));
+}
+
+void SharedTransactionStatusCache::Put(
+    const TransactionId& id, TransactionStatusResult result, CoarseTimePoint expiration) {
+  auto& shard = ShardFor(id);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto& index = shard.entries.get<IdTag>();
+  auto it = index.find(id);
+  if (it != index.end() && it->result.status == TransactionStatus::PENDING) {
+    // Any newer status replaces the pending one.
+    if (result.status != TransactionStatus::PENDING ||
+        result.status_time >= it->result.status_time) {
+      index.modify(it, [&result, expiration](Entry& entry) {
+        entry.result = std::move(result);
+        entry.expiration = expiration;
+      });
+    }
+    return;
+  }
+  if (it != index.end()) {
+    if (result.status == TransactionStatus::PENDING) {
+      return;
+    }
+    // Coordinator forgets transaction after it was applied to all involved tablets, and reports it
+    // as aborted after that. So commit always takes precedence over abort.
+    LOG_IF(WARNING, it->result.status != result.status)
+        << "Final status of " << id << " reported as " << result << " while " << it->result
+        << " is cached";
+    if (result.status == TransactionStatus::COMMITTED) {
+      index.modify(it, [&result](Entry& entry) { entry.result = std::move(result); });
+    }
+    return;
+  }
+  shard.entries.push_front(Entry{id, std::move(result), expiration});
+  if (shard.entries.size() > shard_capacity_) {
+    shard.entries.pop_back();
+  }
+}
+
+boost::optional<TransactionStatusResult> SharedTransactionStatusCache::Get(
+    const TransactionId& id) {
+  auto& shard = ShardFor(id);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto& index = shard.entries.get<IdTag>();
+  auto it = index.find(id);
+  if (it == index.end()) {
+    return boost::none;
+  }
+  if (it->expiration != CoarseTimePoint::max() && it->expiration <= CoarseMonoClock::now()) {
+    index.erase(it);
+    return boost::none;
+  }
+  return it->result;
+}
+
+bool SharedTransactionStatusCache::StartStatusRequest(
+    const TransactionId& id, const TabletId& status_tablet, StatusResponseCallback callback) {
+  auto& shard = ShardFor(id);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto it = shard.requests.find(RequestKey(id, status_tablet));
+  if (it == shard.requests.end()) {
+    shard.requests.emplace(RequestKey(id, status_tablet), std::vector<StatusResponseCallback>());
+    return true;
+  }
+  it->second.push_back(std::move(callback));
+  return false;
+}
+
+void SharedTransactionStatusCache::StatusRequestDone(
+    const TransactionId& id, const TabletId& status_tablet, const Status& status,
+    const tserver::GetTransactionStatusResponsePB& response) {
+  std::vector<StatusResponseCallback> callbacks;
+  {
+    auto& shard = ShardFor(id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.requests.find(RequestKey(id, status_tablet));
+    if (it == shard.requests.end()) {
+      LOG(DFATAL) << "Status request done for unknown request: " << id << ", " << status_tablet;
+      return;
+    }
+    callbacks.swap(it->second);
+    shard.requests.erase(it);
+  }
+  for (const auto& callback : callbacks) {
+    callback(status, response);
+  }
+}
+
+SharedTransactionStatusCache::Shard& SharedTransactionStatusCache::ShardFor(
+    const TransactionId& id) {
+  return shards_[TransactionIdHash()(id) % kNumShards];
+}
+
+size_t SharedTransactionStatusCache::TEST_Size() {
+  size_t result = 0;
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    result += shard.entries.size();
+  }
+  return result;
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,134 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/optional.hpp>
+
+#include "yb/common/entity_ids_types.h"
+#include "yb/common/transaction.h"
+
+#include "yb/gutil/port.h"
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/tserver/tserver_fwd.h"
+
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace tablet {
+
+// Caches final statuses of transactions, i.e. committed with commit hybrid time or aborted.
+// Shared by transaction participants of all tablets of the tablet server, so a transaction
+// that touches multiple tablets on the same node has its status requested from coordinator once.
+// Also keeps recently received pending statuses for a short time, and coalesces concurrent
+// status requests for the same transaction sent by different participants.
+// Bounded, least recently added entries are evicted first. Thread safe.
+class SharedTransactionStatusCache {
+ public:
+  using StatusResponseCallback = std::function<void(
+      const Status&, const tserver::GetTransactionStatusResponsePB&)>;
+
+  // capacity - max number of cached transactions, split equally between shards.
+  explicit SharedTransactionStatusCache(size_t capacity);
+
+  // Remembers that transaction was committed at commit_ht.
+  void Committed(
+      const TransactionId& id, HybridTime commit_ht,
+      const AbortedSubTransactionSet& aborted_subtxn_set);
+
+  // Remembers that coordinator reported transaction as aborted. status_time is the coordinator
+  // safe time of the response, if it was provided.
+  void Aborted(const TransactionId& id, HybridTime status_time);
+
+  // Remembers that coordinator reported transaction as pending at status_time. Such entry expires
+  // after conflict_resolution_pending_status_ttl_ms and never overrides the final status.
+  void Pending(
+      const TransactionId& id, HybridTime status_time,
+      const AbortedSubTransactionSet& aborted_subtxn_set);
+
+  // Returns final status of transaction if known, otherwise recent pending status if known.
+  boost::optional<TransactionStatusResult> Get(const TransactionId& id);
+
+  // Registers status request for transaction with specified status tablet.
+  // Returns true when there is no such request in flight, so the caller should send it, and then
+  // call StatusRequestDone with the response. Otherwise returns false and callback will be invoked
+  // with the response of the request in flight.
+  bool StartStatusRequest(
+      const TransactionId& id, const TabletId& status_tablet, StatusResponseCallback callback);
+
+  void StatusRequestDone(
+      const TransactionId& id, const TabletId& status_tablet, const Status& status,
+      const tserver::GetTransactionStatusResponsePB& response);
+
+  size_t TEST_Size();
+
+ private:
+  static constexpr size_t kNumShards = 16;
+
+  struct Entry {
+    TransactionId id;
+    TransactionStatusResult result;
+    // Pending entries are valid only till this time.
+    CoarseTimePoint expiration = CoarseTimePoint::max();
+  };
+
+  using RequestKey = std::pair<TransactionId, TabletId>;
+
+  struct RequestKeyHash {
+    size_t operator()(const RequestKey& key) const;
+  };
+
+  class IdTag;
+
+  using Entries = boost::multi_index_container<
+      Entry,
+      boost::multi_index::indexed_by<
+          boost::multi_index::sequenced<>,
+          boost::multi_index::hashed_unique<
+              boost::multi_index::tag<IdTag>,
+              boost::multi_index::member<Entry, TransactionId, &Entry::id>,
+              TransactionIdHash>
+      >
+  >;
+
+  struct alignas(CACHELINE_SIZE) Shard {
+    std::mutex mutex;
+    Entries entries GUARDED_BY(mutex);
+    // Callbacks waiting for the response of the status request in flight.
+    std::unordered_map<RequestKey, std::vector<StatusResponseCallback>, RequestKeyHash> requests
+        GUARDED_BY(mutex);
+  };
+
+  void Put(
+      const TransactionId& id, TransactionStatusResult result,
+      CoarseTimePoint expiration = CoarseTimePoint::max());
+
+  Shard& ShardFor(const TransactionId& id);
+
+  const size_t shard_capacity_;
+  std::array<Shard, kNumShards> shards_;
+};
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,239 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// End to end benchmark of DocDB read and write paths on a single tablet. Each workload reports
+// its throughput, latency percentiles, CPU time per operation and write amplification of the
+// regular RocksDB as one line of JSON, prefixed by "BENCHMARK_RESULT", and optionally appends
+// it to tablet_bench_output_file.
+
+#include <fstream>
+#include <string>
+
+#include "yb/common/ql_protocol_util.h"
+#include "yb/common/ql_rowblock.h"
+#include "yb/common/schema.h"
+
+#include "yb/rocksdb/statistics.h"
+
+#include "yb/tablet/local_tablet_writer.h"
+#include "yb/tablet/read_result.h"
+#include "yb/tablet/tablet-test-util.h"
+#include "yb/tablet/tablet.h"
+
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/jsonwriter.h"
+#include "yb/util/random_util.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/stopwatch.h"
+#include "yb/util/test_macros.h"
+
+DEFINE_int32(tablet_bench_num_rows, 20000, "Number of rows inserted by the benchmark.");
+DEFINE_int32(tablet_bench_num_ops, 20000,
+             "Number of operations made by read and update workloads of the benchmark.");
+DEFINE_int32(tablet_bench_rows_per_batch, 10, "Number of rows per write batch.");
+DEFINE_int32(tablet_bench_scan_rows, 100, "Number of rows read by one range scan.");
+DEFINE_int32(tablet_bench_value_size, 100, "Size of the string column value.");
+DEFINE_string(tablet_bench_output_file, "",
+              "If not empty, JSON results of the benchmark are appended to this file.");
+
+DECLARE_bool(ycql_enable_packed_row);
+DECLARE_int64(db_write_buffer_size);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+// Rows are distributed between hash keys, so range scans read rows of the same hash key.
+constexpr int kRowsPerHashKey = 1000;
+
+// Latency is tracked with microsecond precision up to 10 seconds.
+constexpr uint64_t kMaxLatencyUs = 10000000;
+
+} // namespace
+
+class TabletBench : public YBTabletTest {
+ public:
+  TabletBench()
+      : YBTabletTest(Schema({ ColumnSchema("h", INT32, false, true),
+                              ColumnSchema("r", INT32),
+                              ColumnSchema("v1", INT64, true),
+                              ColumnSchema("v2", STRING, true),
+                              ColumnSchema("v3", INT32, true) },
+                            2)) {
+    OverrideFlagForSlowTests("tablet_bench_num_rows", "1000000");
+    OverrideFlagForSlowTests("tablet_bench_num_ops", "200000");
+  }
+
+  void SetUp() override {
+    FLAGS_ycql_enable_packed_row = true;
+    FLAGS_db_write_buffer_size = 16_MB;
+    YBTabletTest::SetUp();
+    writer_ = std::make_unique<LocalTabletWriter>(tablet());
+    value_ = RandomHumanReadableString(FLAGS_tablet_bench_value_size);
+  }
+
+ protected:
+  void AddRow(int row, int64_t version, LocalTabletWriter::Batch* batch) {
+    QLWriteRequestPB* req = batch->Add();
+    req->set_type(QLWriteRequestPB::QL_STMT_INSERT);
+    QLAddInt32HashValue(req, row / kRowsPerHashKey);
+    QLAddInt32RangeValue(req, row % kRowsPerHashKey);
+    QLSetHashCode(req);
+    QLAddInt64ColumnValue(req, kFirstColumnId + 2, version);
+    QLAddStringColumnValue(req, kFirstColumnId + 3, value_);
+    QLAddInt32ColumnValue(req, kFirstColumnId + 4, row);
+  }
+
+  // Writes batches of rows returned by row_generator, one batch per operation.
+  template <class RowGenerator>
+  void WriteRows(const char* workload, int num_rows, const RowGenerator& row_generator) {
+    int64_t version = 0;
+    Run(workload, num_rows / FLAGS_tablet_bench_rows_per_batch,
+        [this, &row_generator, &version]() -> Status {
+          LocalTabletWriter::Batch batch;
+          for (int i = 0; i != FLAGS_tablet_bench_rows_per_batch; ++i) {
+            AddRow(row_generator(), ++version, &batch);
+          }
+          return writer_->WriteBatch(&batch);
+        });
+  }
+
+  void Load() {
+    int next_row = 0;
+    WriteRows("insert", FLAGS_tablet_bench_num_rows, [&next_row] { return next_row++; });
+    ASSERT_OK(tablet()->Flush(FlushMode::kSync));
+  }
+
+  // Reads up to limit rows starting from the specified row, and returns number of read rows.
+  Result<size_t> ReadRows(int row, int limit) {
+    QLReadRequestPB req;
+    QLAddInt32HashValue(&req, row / kRowsPerHashKey);
+    QLSetHashCode(&req);
+    auto* condition = req.mutable_where_expr()->mutable_condition();
+    QLSetInt32Condition(
+        condition, kFirstColumnId + 1, limit == 1 ? QL_OP_EQUAL : QL_OP_GREATER_THAN_EQUAL,
+        row % kRowsPerHashKey);
+    req.set_limit(limit);
+    QLAddColumns(schema_, {}, &req);
+    auto read_time = ReadHybridTime::SingleTime(VERIFY_RESULT(tablet()->SafeTime()));
+    QLReadRequestResult result;
+    RETURN_NOT_OK(tablet()->HandleQLReadRequest(
+        CoarseTimePoint::max(), read_time, req, TransactionMetadataPB(), &result));
+    SCHECK_EQ(result.response.status(), QLResponsePB::YQL_STATUS_OK, IllegalState,
+              result.response.error_message());
+    return CreateRowBlock(QLClient::YQL_CLIENT_CQL, schema_, result.rows_data)->row_count();
+  }
+
+  int RandomRow() {
+    return RandomUniformInt(0, FLAGS_tablet_bench_num_rows - 1);
+  }
+
+  uint64_t Ticker(rocksdb::Tickers ticker) {
+    const auto& statistics = tablet()->regulardb_statistics();
+    return statistics ? statistics->getTickerCount(ticker) : 0;
+  }
+
+  // Runs num_ops operations and reports results of the workload.
+  template <class Op>
+  void Run(const char* workload, int num_ops, const Op& op) {
+    HdrHistogram latency(kMaxLatencyUs, 2);
+    auto user_bytes_before = Ticker(rocksdb::BYTES_WRITTEN);
+    auto sst_bytes_before =
+        Ticker(rocksdb::FLUSH_WRITE_BYTES) + Ticker(rocksdb::COMPACT_WRITE_BYTES);
+    Stopwatch stopwatch(Stopwatch::ALL_THREADS);
+    stopwatch.start();
+    for (int i = 0; i != num_ops; ++i) {
+      auto start = MonoTime::Now();
+      ASSERT_OK(op());
+      latency.Increment((MonoTime::Now() - start).ToMicroseconds());
+    }
+    stopwatch.stop();
+    auto user_bytes = Ticker(rocksdb::BYTES_WRITTEN) - user_bytes_before;
+    auto sst_bytes =
+        Ticker(rocksdb::FLUSH_WRITE_BYTES) + Ticker(rocksdb::COMPACT_WRITE_BYTES) -
+        sst_bytes_before;
+    auto times = stopwatch.elapsed();
+
+    std::stringstream out;
+    JsonWriter writer(&out, JsonWriter::COMPACT);
+    writer.StartObject();
+    writer.String("workload");
+    writer.String(workload);
+    writer.String("ops");
+    writer.Int64(num_ops);
+    writer.String("ops_per_sec");
+    writer.Double(num_ops / times.wall_seconds());
+    writer.String("latency_us");
+    writer.StartObject();
+    for (auto percentile : {50.0, 95.0, 99.0, 99.9}) {
+      writer.String(Format("p$0", percentile));
+      writer.Uint64(latency.ValueAtPercentile(percentile));
+    }
+    writer.String("max");
+    writer.Uint64(latency.MaxValue());
+    writer.EndObject();
+    writer.String("cpu_us_per_op");
+    writer.Double(
+        (times.user_cpu_seconds() + times.system_cpu_seconds()) * 1e6 / num_ops);
+    writer.String("write_amplification");
+    writer.Double(user_bytes ? static_cast<double>(sst_bytes) / user_bytes : 0.0);
+    writer.EndObject();
+
+    LOG(INFO) << "BENCHMARK_RESULT " << out.str();
+    if (!FLAGS_tablet_bench_output_file.empty()) {
+      std::ofstream file(FLAGS_tablet_bench_output_file, std::ios_base::app);
+      file << out.str() << std::endl;
+    }
+  }
+
+  std::unique_ptr<LocalTabletWriter> writer_;
+  std::string value_;
+};
+
+TEST_F(TabletBench, Insert) {
+  ASSERT_NO_FATALS(Load());
+}
+
+TEST_F(TabletBench, PointRead) {
+  ASSERT_NO_FATALS(Load());
+  Run("point_read", FLAGS_tablet_bench_num_ops, [this]() -> Status {
+    auto rows = VERIFY_RESULT(ReadRows(RandomRow(), 1));
+    SCHECK_EQ(rows, 1, IllegalState, "Row not found");
+    return Status::OK();
+  });
+}
+
+TEST_F(TabletBench, RangeScan) {
+  ASSERT_NO_FATALS(Load());
+  Run("range_scan", FLAGS_tablet_bench_num_ops / FLAGS_tablet_bench_scan_rows, [this] {
+    return ResultToStatus(ReadRows(RandomRow(), FLAGS_tablet_bench_scan_rows));
+  });
+}
+
+TEST_F(TabletBench, UpdateChurn) {
+  ASSERT_NO_FATALS(Load());
+  // Updates of a small set of rows create many versions of the same keys, that should be
+  // removed by compactions.
+  const int hot_rows = std::max(FLAGS_tablet_bench_num_rows / 100, 1);
+  WriteRows("update_churn", FLAGS_tablet_bench_num_ops, [hot_rows] {
+    return RandomUniformInt(0, hot_rows - 1);
+  });
+  ASSERT_OK(tablet()->Flush(FlushMode::kSync));
+  Run("point_read_after_churn", FLAGS_tablet_bench_num_ops, [this, hot_rows] {
+    return ResultToStatus(ReadRows(RandomUniformInt(0, hot_rows - 1), 1));
+  });
+}
+
+}  // namespace tablet
+}  // namespace yb
@@ -32,6 +32,9 @@
 
 #include "yb/tablet/tablet.h"
 
+#include <algorithm>
+#include <tuple>
+
 #include <boost/container/static_vector.hpp>
 
 #include "yb/client/auto_flags_manager.h"
@@ -56,25 +59,34 @@
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/opid_util.h"
 
+#include "yb/docdb/colocated_tables_stats.h"
 #include "yb/docdb/compaction_file_filter.h"
 #include "yb/docdb/conflict_resolution.h"
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/cql_operation.h"
+#include "yb/docdb/doc_column_stats.h"
 #include "yb/docdb/doc_read_context.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
+#include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/doc_write_batch.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb_compaction_filter_intents.h"
 #include "yb/docdb/docdb_debug.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/docdb/intents_file_transactions.h"
+#include "yb/docdb/obsolete_data_stats.h"
 #include "yb/docdb/pgsql_operation.h"
 #include "yb/docdb/ql_rocksdb_storage.h"
 #include "yb/docdb/redis_operation.h"
 #include "yb/docdb/rocksdb_writer.h"
+#include "yb/docdb/row_cache.h"
 
 #include "yb/gutil/casts.h"
 
+#include "yb/rocksdb/db.h"
+#include "yb/rocksdb/db/compaction_context.h"
 #include "yb/rocksdb/db/memtable.h"
+#include "yb/rocksdb/table.h"
 #include "yb/rocksdb/utilities/checkpoint.h"
 
 #include "yb/rocksutil/yb_rocksdb.h"
@@ -101,6 +113,7 @@
 #include "yb/tserver/tserver.pb.h"
 #include "yb/tserver/tserver_error.h"
 
+#include "yb/util/call_accounting.h"
 #include "yb/util/debug-util.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/flags.h"
@@ -164,6 +177,13 @@ DEFINE_RUNTIME_uint64(backfill_index_write_batch_size, 128,
     "The batch size for backfilling the index.");
 TAG_FLAG(backfill_index_write_batch_size, advanced);
 
+DEFINE_RUNTIME_uint64(backfill_index_shuffle_buffer_size, 8192,
+    "Number of index rows buffered by the index backfill of a tablet before writing them. "
+    "Buffered rows are grouped by the index tablet and sorted, so each index tablet receives "
+    "batches of backfill_index_write_batch_size rows. Values not above "
+    "backfill_index_write_batch_size disable buffering.");
+TAG_FLAG(backfill_index_shuffle_buffer_size, advanced);
+
 DEFINE_RUNTIME_int32(backfill_index_rate_rows_per_sec, 0,
     "Rate of at which the indexed table's entries are populated into the index table during index "
     "backfill. This is a per-tablet flag, i.e. a tserver responsible for "
@@ -213,10 +233,24 @@ DEFINE_test_flag(int32, backfill_drop_frequency, 0,
     "to create an inconsistency between the index and the indexed tables where n is the "
     "input parameter given.");
 
+DEFINE_int64(docdb_row_cache_size_bytes, 0,
+             "Size of per tablet cache of hot packed rows, used for point reads of non "
+             "transactional YCQL tables. 0 to disable.");
+
 DEFINE_bool(tablet_enable_ttl_file_filter, false,
             "Enables compaction to directly delete files that have expired based on TTL, "
             "rather than removing them via the normal compaction process.");
 
+DEFINE_bool(tablet_enable_time_window_compaction, false,
+            "Enables compaction of tables with TTL, that compacts only files within the same time "
+            "window, see compaction_time_windows_per_table_ttl. Old data is not rewritten with new "
+            "data, and expired windows are deleted whole with tablet_enable_ttl_file_filter.");
+
+DEFINE_RUNTIME_bool(tablet_enable_history_gc_on_flush, false,
+                    "Apply history garbage collection, the same as done by compactions, to the "
+                    "regular DB memtables being flushed. So versions of frequently updated rows, "
+                    "which are older than history cutoff, are not written to disk.");
+
 DEFINE_test_flag(int32, slowdown_backfill_by_ms, 0,
                  "If set > 0, slows down the backfill process by this amount.");
 
@@ -260,6 +294,7 @@ DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
 DECLARE_int64(apply_intents_task_injected_delay_ms);
+DECLARE_int32(txn_max_apply_batch_records);
 DECLARE_string(regular_tablets_data_block_key_value_encoding);
 DECLARE_int64(cdc_intent_retention_ms);
 
@@ -416,7 +451,8 @@ Tablet::Tablet(const TabletInitData& data)
       retention_policy_(std::make_shared<TabletRetentionPolicy>(
           clock_, data.allowed_history_cutoff_provider, metadata_.get())),
       full_compaction_pool_(data.full_compaction_pool),
-      ts_post_split_compaction_added_(std::move(data.post_split_compaction_added)) {
+      ts_post_split_compaction_added_(std::move(data.post_split_compaction_added)),
+      post_split_compaction_done_(std::move(data.post_split_compaction_done)) {
   CHECK(schema()->has_column_ids());
   LOG_WITH_PREFIX(INFO) << "Schema version for " << metadata_->table_name() << " is "
                         << metadata_->schema_version();
@@ -454,12 +490,14 @@ Tablet::Tablet(const TabletInitData& data)
       data.transaction_participant_context &&
       (is_sys_catalog_ || transactional)) {
     transaction_participant_ = std::make_unique<TransactionParticipant>(
-        data.transaction_participant_context, this, DCHECK_NOTNULL(tablet_metrics_entity_));
+        data.transaction_participant_context, this, DCHECK_NOTNULL(tablet_metrics_entity_),
+        data.shared_transaction_status_cache);
     if (data.waiting_txn_registry) {
       wait_queue_ = std::make_unique<docdb::WaitQueue>(
         transaction_participant_.get(), metadata_->fs_manager()->uuid(), data.waiting_txn_registry,
         client_future_, clock(), DCHECK_NOTNULL(tablet_metrics_entity_),
         DCHECK_NOTNULL(data.wait_queue_pool)->NewToken(ThreadPool::ExecutionMode::SERIAL));
+      transaction_participant_->SetWaitQueue(wait_queue_.get());
     }
   }
 
@@ -701,6 +739,16 @@ Status Tablet::OpenKeyValueTablet() {
       retention_policy_, &key_bounds_,
       std::bind(&Tablet::DeleteMarkerRetentionTime, this, _1),
       metadata_.get());
+  rocksdb_options.flush_compaction_context_factory =
+      std::make_shared<rocksdb::CompactionContextFactory>(
+          [factory = rocksdb_options.compaction_context_factory](
+              rocksdb::CompactionFeed* next_feed, const rocksdb::CompactionContextOptions& options)
+              -> rocksdb::CompactionContextPtr {
+    if (!FLAGS_tablet_enable_history_gc_on_flush) {
+      return nullptr;
+    }
+    return (*factory)(next_feed, options);
+  });
 
   rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
     if (mem_table_flush_filter_factory_) {
@@ -729,6 +777,42 @@ Status Tablet::OpenKeyValueTablet() {
   rocksdb::Options regular_rocksdb_options(rocksdb_options);
   regular_rocksdb_options.listeners.push_back(
       std::make_shared<RegularRocksDbListener>(this, regular_rocksdb_options.log_prefix));
+  regular_rocksdb_options.compaction_row_prefix_extractor =
+      docdb::CreateCompactionRowPrefixExtractor();
+  if (FLAGS_tablet_enable_time_window_compaction) {
+    regular_rocksdb_options.compaction_time_window_policy =
+        std::make_shared<docdb::DocDBCompactionTimeWindowPolicy>([this] {
+          return docdb::TableTTL(*metadata()->schema());
+        });
+  }
+  regular_rocksdb_options.table_properties_collector_factories.push_back(
+      docdb::CreateObsoleteDataStatsCollectorFactory([this] {
+        return docdb::TableTTL(*metadata()->schema());
+      }));
+  if (metadata()->colocated()) {
+    regular_rocksdb_options.table_properties_collector_factories.push_back(
+        docdb::CreateColocatedTablesCollectorFactory());
+  } else {
+    // Columns with statistics are taken from the schema at open, so changing column_stats_ids
+    // affects only files written after the tablet is reopened.
+    auto column_stats_collector_factory = docdb::CreateColumnStatsCollectorFactory(
+        *metadata()->schema(), metadata_.get());
+    if (column_stats_collector_factory) {
+      regular_rocksdb_options.table_properties_collector_factories.push_back(
+          std::move(column_stats_collector_factory));
+    }
+    auto data_block_stats_collector_factory = docdb::CreateDataBlockColumnStatsCollectorFactory(
+        *metadata()->schema(), metadata_.get());
+    if (data_block_stats_collector_factory) {
+      // Table factory is shared with intents DB, so regular DB gets its own copy.
+      auto regular_table_options = *static_cast<rocksdb::BlockBasedTableOptions*>(
+          rocksdb_options.table_factory->GetOptions());
+      regular_table_options.data_block_stats_collector_factory =
+          std::move(data_block_stats_collector_factory);
+      regular_rocksdb_options.table_factory.reset(
+          rocksdb::NewBlockBasedTableFactory(regular_table_options));
+    }
+  }
 
   const string db_dir = metadata()->rocksdb_dir();
   RETURN_NOT_OK(CreateTabletDirectories(db_dir, metadata()->fs_manager()));
@@ -751,6 +835,7 @@ Status Tablet::OpenKeyValueTablet() {
     LOG_WITH_PREFIX(INFO) << "Opening intents DB at: " << db_dir + kIntentsDBSuffix;
     rocksdb::Options intents_rocksdb_options(rocksdb_options);
     intents_rocksdb_options.compaction_context_factory = {};
+    intents_rocksdb_options.flush_compaction_context_factory = {};
     docdb::SetLogPrefix(&intents_rocksdb_options, LogPrefix(docdb::StorageDbType::kIntents));
 
     intents_rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
@@ -760,6 +845,8 @@ Status Tablet::OpenKeyValueTablet() {
     intents_rocksdb_options.compaction_filter_factory =
         FLAGS_tablet_do_compaction_cleanup_for_intents ?
         std::make_shared<docdb::DocDBIntentsCompactionFilterFactory>(this, &key_bounds_) : nullptr;
+    intents_rocksdb_options.table_properties_collector_factories.push_back(
+        docdb::CreateIntentsFileTransactionsCollectorFactory());
 
     intents_rocksdb_options.mem_tracker = MemTracker::FindOrCreateTracker(kIntentsDB, mem_tracker_);
     intents_rocksdb_options.block_based_table_mem_tracker =
@@ -780,6 +867,11 @@ Status Tablet::OpenKeyValueTablet() {
     intents_db_->ListenFilesChanged(std::bind(&Tablet::CleanupIntentFiles, this));
   }
 
+  if (FLAGS_docdb_row_cache_size_bytes > 0 && !transaction_participant_ &&
+      metadata_->table_type() == TableType::YQL_TABLE_TYPE) {
+    row_cache_ = std::make_unique<docdb::RowCache>(
+        FLAGS_docdb_row_cache_size_bytes, mem_tracker_);
+  }
   ql_storage_.reset(new docdb::QLRocksDBStorage(doc_db()));
   if (transaction_participant_) {
     // We need to set the "cdc_sdk_min_checkpoint_op_id" so that intents don't get
@@ -833,6 +925,34 @@ void Tablet::CleanupIntentFiles() {
       "Submit cleanup intent files failed");
 }
 
+bool Tablet::IntentsFileTransactionsFinished(const rocksdb::LiveFileMetaData& file) {
+  rocksdb::TablePropertiesCollection properties;
+  auto status = intents_db_->GetPropertiesOfAllTables(&properties);
+  if (!status.ok()) {
+    LOG_WITH_PREFIX_AND_FUNC(WARNING) << "Failed to get intents files properties: " << status;
+    return false;
+  }
+  auto it = properties.find(file.FullName());
+  if (it == properties.end()) {
+    return false;
+  }
+  auto transactions = docdb::IntentsFileTransactions(*it->second);
+  if (!transactions.ok()) {
+    LOG_WITH_PREFIX_AND_FUNC(WARNING)
+        << "Failed to decode transactions of " << file.ToString() << ": "
+        << transactions.status();
+    return false;
+  }
+  if (!*transactions) {
+    return false;
+  }
+  auto result = !transaction_participant_->AnyRunning(**transactions);
+  VLOG_WITH_PREFIX_AND_FUNC(4)
+      << file.ToString() << ", transactions: " << (**transactions).size()
+      << ", finished: " << result;
+  return result;
+}
+
 void Tablet::DoCleanupIntentFiles() {
   if (metadata_->is_under_twodc_replication()) {
     VLOG_WITH_PREFIX_AND_FUNC(4) << "Exit because of TwoDC replication";
@@ -875,7 +995,8 @@ void Tablet::DoCleanupIntentFiles() {
     }
 
     auto min_running_start_ht = transaction_participant_->MinRunningHybridTime();
-    if (!min_running_start_ht.is_valid() || min_running_start_ht <= best_file_max_ht) {
+    if ((!min_running_start_ht.is_valid() || min_running_start_ht <= best_file_max_ht) &&
+        !IntentsFileTransactionsFinished(*best_file)) {
       has_deletions_blocked_by_running_transations = true;
       VLOG_WITH_PREFIX_AND_FUNC(4)
           << "Cannot delete because of running transactions: " << min_running_start_ht
@@ -1123,6 +1244,7 @@ Status Tablet::CompleteShutdownRocksDBs(
   Status intents_status = ResetRocksDB(destroy, rocksdb_options, &intents_db_);
   Status regular_status = ResetRocksDB(destroy, rocksdb_options, &regular_db_);
   key_bounds_ = docdb::KeyBounds();
+  row_cache_.reset();
   // Reset rocksdb_shutdown_requested_ to the initial state like RocksDBs were never opened,
   // so we don't have to reset it on RocksDB open (we potentially can have several places in the
   // code doing opening RocksDB while RocksDB shutdown is always going through
@@ -1192,6 +1314,7 @@ Status Tablet::ApplyRowOperations(
             << put_batch.ShortDebugString();
     metrics_->rows_inserted->IncrementBy(put_batch.write_pairs().size());
   }
+  SampleWriteKeys(put_batch);
 
   return ApplyOperation(
       *operation, write_request.batch_idx(), put_batch, already_applied_to_regular_db);
@@ -1213,8 +1336,14 @@ Status Tablet::ApplyOperation(
     auto ttl = write_batch.has_ttl()
         ? MonoDelta::FromNanoseconds(write_batch.ttl())
         : docdb::ValueControlFields::kMaxTtl;
-    frontiers_ptr->Largest().set_max_value_level_ttl_expiration_time(
-        docdb::FileExpirationFromValueTTL(operation.hybrid_time(), ttl));
+    auto expiration_time = docdb::FileExpirationFromValueTTL(operation.hybrid_time(), ttl);
+    // Values that use the default TTL never expire when the table does not have one, so the file
+    // containing them could not be dropped because of other values with TTL.
+    if (write_batch.has_value_with_default_ttl() &&
+        docdb::TableTTL(*metadata()->schema()).Equals(docdb::ValueControlFields::kMaxTtl)) {
+      expiration_time = docdb::kNoExpiration;
+    }
+    frontiers_ptr->Largest().set_max_value_level_ttl_expiration_time(expiration_time);
     for (const auto& p : write_batch.table_schema_version()) {
       // Since new frontiers does not contain schema version just add it there.
       auto table_id = p.table_id().empty()
@@ -1366,7 +1495,13 @@ Status Tablet::ApplyKeyValueRowOperations(
       regular_write_batch.SetDirectWriter(&writer);
     }
     if (regular_write_batch.Count() != 0 || regular_write_batch.HasDirectWriter()) {
+      if (row_cache_) {
+        row_cache_->WillApply(put_batch, hybrid_time);
+      }
       WriteToRocksDB(frontiers, &regular_write_batch, StorageDbType::kRegular);
+      if (row_cache_) {
+        row_cache_->Applied(put_batch);
+      }
     }
 
     if (snapshot_coordinator_) {
@@ -1418,6 +1553,21 @@ void Tablet::WriteToRocksDB(
   }
 }
 
+void Tablet::BindCallAccounting() {
+  auto* call_accounting = CallAccounting::Current();
+  if (!call_accounting) {
+    return;
+  }
+  call_accounting->SetTabletId(tablet_id());
+  if (!call_accounting->time_accounted() || !tablet_metrics_entity_) {
+    return;
+  }
+  std::call_once(call_phase_counters_once_, [this] {
+    call_phase_counters_ = std::make_shared<CallPhaseCounters>(tablet_metrics_entity_, "");
+  });
+  call_accounting->SetTabletCounters(call_phase_counters_);
+}
+
 //--------------------------------------------------------------------------------------------------
 // Redis Request Processing.
 Status Tablet::HandleRedisReadRequest(CoarseTimePoint deadline,
@@ -1428,7 +1578,10 @@ Status Tablet::HandleRedisReadRequest(CoarseTimePoint deadline,
   auto scoped_read_operation = CreateNonAbortableScopedRWOperation(deadline);
   RETURN_NOT_OK(scoped_read_operation);
 
-  ScopedTabletMetricsTracker metrics_tracker(metrics_->ql_read_latency);
+  ScopedTabletMetricsTracker metrics_tracker(
+      metrics_->ql_read_latency, metrics_->read_requests_handled);
+  BindCallAccounting();
+  ScopedCallPhase read_phase(CallPhase::kRocksDbRead);
 
   docdb::RedisReadOperation doc_op(redis_read_request, doc_db(), deadline, read_time);
   RETURN_NOT_OK(doc_op.Execute());
@@ -1462,7 +1615,10 @@ Status Tablet::HandleQLReadRequest(
     QLReadRequestResult* result) {
   auto scoped_read_operation = CreateNonAbortableScopedRWOperation(deadline);
   RETURN_NOT_OK(scoped_read_operation);
-  ScopedTabletMetricsTracker metrics_tracker(metrics_->ql_read_latency);
+  ScopedTabletMetricsTracker metrics_tracker(
+      metrics_->ql_read_latency, metrics_->read_requests_handled);
+  BindCallAccounting();
+  ScopedCallPhase read_phase(CallPhase::kRocksDbRead);
 
   bool schema_version_compatible = IsSchemaVersionCompatible(
       metadata()->schema_version(), ql_read_request.schema_version(),
@@ -1540,6 +1696,51 @@ Status Tablet::CreatePagingStateForRead(const QLReadRequestPB& ql_read_request,
   return Status::OK();
 }
 
+void Tablet::SampleReadKeys(const Schema& schema, const PgsqlReadRequestPB& request) {
+  auto weight = HotKeys::Sample();
+  if (!weight) {
+    return;
+  }
+  if (request.batch_arguments_size() > 0) {
+    for (const auto& batch_argument : request.batch_arguments()) {
+      if (batch_argument.has_ybctid()) {
+        hot_read_keys_.Record(batch_argument.ybctid().value().binary_value(), weight);
+      }
+    }
+    return;
+  }
+  // Scans without key columns would be accounted to the empty key.
+  if (!request.has_ybctid_column_value() && request.partition_column_values().empty() &&
+      request.range_column_values().empty()) {
+    return;
+  }
+  auto key = docdb::FetchEncodedDocKey(schema, request);
+  if (key.ok()) {
+    hot_read_keys_.Record(*key, weight);
+  }
+}
+
+void Tablet::SampleWriteKeys(const docdb::LWKeyValueWriteBatchPB& write_batch) {
+  auto weight = HotKeys::Sample();
+  if (!weight) {
+    return;
+  }
+  Slice prev_doc_key;
+  for (const auto& write_pair : write_batch.write_pairs()) {
+    auto doc_key_size = docdb::DocKey::EncodedSize(
+        write_pair.key(), docdb::DocKeyPart::kWholeDocKey);
+    if (!doc_key_size.ok()) {
+      continue;
+    }
+    Slice doc_key(write_pair.key().data(), *doc_key_size);
+    // Columns of the same row are written by consecutive pairs.
+    if (doc_key != prev_doc_key) {
+      hot_write_keys_.Record(doc_key, weight);
+      prev_doc_key = doc_key;
+    }
+  }
+}
+
 //--------------------------------------------------------------------------------------------------
 // PGSQL Request Processing.
 //--------------------------------------------------------------------------------------------------
@@ -1555,7 +1756,10 @@ Status Tablet::HandlePgsqlReadRequest(
   TRACE(LogPrefix());
   auto scoped_read_operation = CreateNonAbortableScopedRWOperation(deadline);
   RETURN_NOT_OK(scoped_read_operation);
-  ScopedTabletMetricsTracker metrics_tracker(metrics_->ql_read_latency);
+  ScopedTabletMetricsTracker metrics_tracker(
+      metrics_->ql_read_latency, metrics_->read_requests_handled);
+  BindCallAccounting();
+  ScopedCallPhase read_phase(CallPhase::kRocksDbRead);
 
   const shared_ptr<tablet::TableInfo> table_info =
       VERIFY_RESULT(metadata_->GetTableInfo(pgsql_read_request.table_id()));
@@ -1565,6 +1769,7 @@ Status Tablet::HandlePgsqlReadRequest(
           table_info->schema().table_properties().is_ysql_catalog_table(),
           &subtransaction_metadata);
   RETURN_NOT_OK(txn_op_ctx);
+  SampleReadKeys(table_info->schema(), pgsql_read_request);
   auto status = ProcessPgsqlReadRequest(
       deadline, read_time, is_explicit_request_read_time,
       pgsql_read_request, table_info, *txn_op_ctx, result, num_rows_read);
@@ -1813,34 +2018,81 @@ Status Tablet::WaitForFlush() {
 
 Status Tablet::ImportData(const std::string& source_dir) {
   // We import only regular records, so don't have to deal with intents here.
-  return regular_db_->Import(source_dir);
+  RETURN_NOT_OK(regular_db_->Import(source_dir));
+  if (row_cache_) {
+    row_cache_->Clear();
+  }
+  return Status::OK();
 }
 
 // We apply intents by iterating over whole transaction reverse index.
 // Using value of reverse index record we find original intent record and apply it.
 // After that we delete both intent record and reverse index record.
 Result<docdb::ApplyTransactionState> Tablet::ApplyIntents(const TransactionApplyData& data) {
-  VLOG_WITH_PREFIX(4) << __func__ << ": " << data.transaction_id;
+  auto result = VERIFY_RESULT(ApplyIntentsBatch({&data}));
+  return std::move(result.front());
+}
 
+Result<std::vector<docdb::ApplyTransactionState>> Tablet::ApplyIntentsBatch(
+    const std::vector<const TransactionApplyData*>& data) {
   // This flag enables tests to induce a situation where a transaction has committed but its intents
   // haven't yet moved to regular db for a sufficiently long period. For example, it can help a test
   // to reliably assert that conflict resolution/ concurrency control with a conflicting committed
   // transaction is done properly in the rare situation where the committed transaction's intents
   // are still in intents db and not yet in regular db.
   AtomicFlagSleepMs(&FLAGS_TEST_inject_sleep_before_applying_intents_ms);
-  docdb::ApplyIntentsContext context(
-      data.transaction_id, data.apply_state, data.aborted, data.commit_ht, data.log_ht,
-      &key_bounds_, intents_db_.get());
-  docdb::IntentsWriter intents_writer(
-      data.apply_state ? data.apply_state->key : Slice(), intents_db_.get(), &context);
+
+  const int64_t max_records_per_transaction = std::max<int64_t>(
+      FLAGS_txn_max_apply_batch_records / static_cast<int64_t>(data.size()), 1);
+  std::vector<std::unique_ptr<docdb::ApplyIntentsContext>> contexts;
+  std::vector<std::unique_ptr<docdb::IntentsWriter>> intents_writers;
+  contexts.reserve(data.size());
+  intents_writers.reserve(data.size());
+  docdb::CompositeDirectWriter writer;
+  docdb::ConsensusFrontiers frontiers;
+  docdb::ConsensusFrontiers* frontiers_ptr = nullptr;
+  for (const auto* txn_data : data) {
+    VLOG_WITH_PREFIX(4) << __func__ << ": " << txn_data->transaction_id;
+    contexts.push_back(std::make_unique<docdb::ApplyIntentsContext>(
+        txn_data->transaction_id, txn_data->apply_state, txn_data->aborted, txn_data->commit_ht,
+        txn_data->log_ht, &key_bounds_, intents_db_.get(), max_records_per_transaction));
+    intents_writers.push_back(std::make_unique<docdb::IntentsWriter>(
+        txn_data->apply_state ? txn_data->apply_state->key : Slice(), intents_db_.get(),
+        contexts.back().get()));
+    writer.Add(intents_writers.back().get());
+
+    if (txn_data->op_id.empty()) {
+      continue;
+    }
+    // data.hybrid_time contains transaction commit time.
+    docdb::ConsensusFrontiers txn_frontiers;
+    if (!InitFrontiers(*txn_data, &txn_frontiers)) {
+      continue;
+    }
+    // TTL of the values written by transaction is not tracked, so don't let files with them be
+    // expired by value TTL.
+    if (docdb::TableTTL(*metadata()->schema()).Equals(docdb::ValueControlFields::kMaxTtl)) {
+      txn_frontiers.Largest().set_max_value_level_ttl_expiration_time(docdb::kNoExpiration);
+    }
+    if (frontiers_ptr) {
+      frontiers.MergeFrontiers(txn_frontiers);
+    } else {
+      frontiers = txn_frontiers;
+      frontiers_ptr = &frontiers;
+    }
+  }
+
   rocksdb::WriteBatch regular_write_batch;
-  regular_write_batch.SetDirectWriter(&intents_writer);
-  // data.hybrid_time contains transaction commit time.
+  regular_write_batch.SetDirectWriter(&writer);
   // We don't set transaction field of put_batch, otherwise we would write another bunch of intents.
-  docdb::ConsensusFrontiers frontiers;
-  auto frontiers_ptr = data.op_id.empty() ? nullptr : InitFrontiers(data, &frontiers);
   WriteToRocksDB(frontiers_ptr, &regular_write_batch, StorageDbType::kRegular);
-  return context.apply_state();
+
+  std::vector<docdb::ApplyTransactionState> result;
+  result.reserve(contexts.size());
+  for (auto& context : contexts) {
+    result.push_back(std::move(context->apply_state()));
+  }
+  return result;
 }
 
 template <class Ids>
@@ -2145,12 +2397,19 @@ Result<PgsqlBackfillSpecPB> QueryPostgresToDoBackfill(
   return spec;
 }
 
+// Number of index rows accumulated by YCQL index backfill before writing them to index tablets.
+size_t BackfillIndexFlushSize() {
+  return std::max(
+      GetAtomicFlag(&FLAGS_backfill_index_write_batch_size),
+      GetAtomicFlag(&FLAGS_backfill_index_shuffle_buffer_size));
+}
+
 struct BackfillParams {
   explicit BackfillParams(const CoarseTimePoint deadline)
       : start_time(CoarseMonoClock::Now()),
         deadline(deadline),
         rate_per_sec(GetAtomicFlag(&FLAGS_backfill_index_rate_rows_per_sec)),
-        batch_size(GetAtomicFlag(&FLAGS_backfill_index_write_batch_size)) {
+        batch_size(BackfillIndexFlushSize()) {
     auto grace_margin_ms = GetAtomicFlag(&FLAGS_backfill_index_timeout_grace_margin_ms);
     if (grace_margin_ms < 0) {
       // We need: grace_margin_ms >= 1000 * batch_size / rate_per_sec;
@@ -2517,7 +2776,7 @@ Status Tablet::FlushWriteIndexBatchIfRequired(
     const CoarseTimePoint deadline,
     docdb::IndexRequests* index_requests,
     std::unordered_set<TableId>* failed_indexes) {
-  if (index_requests->size() < FLAGS_backfill_index_write_batch_size) {
+  if (index_requests->size() < BackfillIndexFlushSize()) {
     return Status::OK();
   }
   return FlushWriteIndexBatch(write_time, deadline, index_requests, failed_indexes);
@@ -2544,6 +2803,17 @@ Status Tablet::FlushWriteIndexBatch(
   constexpr int kMaxNumRetries = 10;
   auto metadata_cache = YBMetaDataCache();
 
+  // Index writes are shuffled by the destination index tablet and sorted by partition key. Each
+  // round takes the next backfill_index_write_batch_size rows of every index tablet, so it is
+  // sent as one RPC per index tablet, instead of spreading a batch over all index tablets.
+  struct ShuffledIndexOp {
+    shared_ptr<client::YBqlWriteOp> op;
+    PartitionKeyPtr partition_start;
+    PartitionKey partition_key;
+    size_t round = 0;
+  };
+  std::vector<ShuffledIndexOp> shuffled_ops;
+  shuffled_ops.reserve(index_requests->size());
   for (auto& pair : *index_requests) {
     client::YBTablePtr index_table =
         VERIFY_RESULT(GetTable(pair.first->table_id(), metadata_cache));
@@ -2551,24 +2821,63 @@ Status Tablet::FlushWriteIndexBatch(
     shared_ptr<client::YBqlWriteOp> index_op(index_table->NewQLWrite());
     index_op->set_write_time_for_backfill(write_time);
     index_op->mutable_request()->Swap(&pair.second);
-    if (index_table->IsUniqueIndex()) {
-      if (ops_by_primary_key.count(index_op) > 0) {
+    PartitionKey partition_key;
+    RETURN_NOT_OK(index_op->GetPartitionKey(&partition_key));
+    auto partition_start = index_table->FindPartitionStart(partition_key);
+    shuffled_ops.push_back(ShuffledIndexOp {
+      .op = std::move(index_op),
+      .partition_start = std::move(partition_start),
+      .partition_key = std::move(partition_key),
+    });
+  }
+  auto same_tablet = [](const ShuffledIndexOp& lhs, const ShuffledIndexOp& rhs) {
+    return lhs.op->table()->id() == rhs.op->table()->id() &&
+           *lhs.partition_start == *rhs.partition_start;
+  };
+  std::stable_sort(
+      shuffled_ops.begin(), shuffled_ops.end(),
+      [](const ShuffledIndexOp& lhs, const ShuffledIndexOp& rhs) {
+    return std::tie(lhs.op->table()->id(), *lhs.partition_start, lhs.partition_key) <
+           std::tie(rhs.op->table()->id(), *rhs.partition_start, rhs.partition_key);
+  });
+  const auto batch_size = std::max<size_t>(FLAGS_backfill_index_write_batch_size, 1);
+  size_t position_in_tablet = 0;
+  for (size_t i = 0; i != shuffled_ops.size(); ++i) {
+    if (i && !same_tablet(shuffled_ops[i - 1], shuffled_ops[i])) {
+      position_in_tablet = 0;
+    }
+    shuffled_ops[i].round = position_in_tablet++ / batch_size;
+  }
+  std::stable_sort(
+      shuffled_ops.begin(), shuffled_ops.end(),
+      [](const ShuffledIndexOp& lhs, const ShuffledIndexOp& rhs) {
+    return lhs.round < rhs.round;
+  });
+
+  size_t round = 0;
+  for (auto& shuffled_op : shuffled_ops) {
+    auto& index_op = shuffled_op.op;
+    bool collides = index_op->table()->IsUniqueIndex() && ops_by_primary_key.count(index_op) > 0;
+    if (collides || shuffled_op.round != round) {
+      if (collides) {
         VLOG(2) << "Splitting the batch of writes because " << index_op->ToString()
                 << " collides with an existing update in this batch.";
-        VLOG(1) << "Flushing " << ops_by_primary_key.size() << " ops to the index";
-        RETURN_NOT_OK(FlushWithRetries(session, write_ops, kMaxNumRetries, failed_indexes));
-        VLOG(3) << "Done flushing ops to the index";
-        ops_by_primary_key.clear();
       }
+      VLOG(1) << "Flushing " << write_ops.size() << " ops to the index";
+      RETURN_NOT_OK(FlushWithRetries(session, write_ops, kMaxNumRetries, failed_indexes));
+      VLOG(3) << "Done flushing ops to the index";
+      ops_by_primary_key.clear();
+      write_ops.clear();
+      round = shuffled_op.round;
+    }
+    if (index_op->table()->IsUniqueIndex()) {
       ops_by_primary_key.insert(index_op);
     }
     session->Apply(index_op);
     write_ops.push_back(index_op);
   }
 
-  VLOG(1) << Format("Flushing $0 ops to the index",
-                    (!ops_by_primary_key.empty() ? ops_by_primary_key.size()
-                                                 : write_ops.size()));
+  VLOG(1) << Format("Flushing $0 ops to the index", write_ops.size());
   RETURN_NOT_OK(FlushWithRetries(session, write_ops, kMaxNumRetries, failed_indexes));
   index_requests->clear();
 
@@ -3222,6 +3531,25 @@ Result<HybridTime> Tablet::DoGetSafeTime(
   return CheckSafeTime(mvcc_.SafeTime(min_allowed, deadline, ht_lease), min_allowed);
 }
 
+Result<bool> Tablet::CanReadDocumentWithoutSafeTime(
+    Slice doc_key, HybridTime read_ht, CoarseTimePoint deadline) {
+  if (!ht_lease_provider_) {
+    return false;
+  }
+  // Operations added after this point will get hybrid time after ht_lease.time, so it is enough to
+  // check operations that are pending now.
+  auto ht_lease = VERIFY_RESULT(ht_lease_provider_(read_ht, deadline));
+  if (read_ht > ht_lease.time || read_ht > ht_lease.lease) {
+    return false;
+  }
+  if (!mvcc_.AllPendingOperationsHoldKeyLocks()) {
+    return false;
+  }
+  return !VERIFY_RESULT(docdb::HasConflictingWriteLocks(
+      doc_key, metadata_->schema()->table_properties().is_transactional(),
+      &shared_lock_manager_));
+}
+
 ScopedRWOperationPause Tablet::PauseWritePermits(CoarseTimePoint deadline) {
   TRACE("Blocking write permit(s)");
   auto se = ScopeExit([] { TRACE("Blocking write permit(s) done"); });
@@ -3383,12 +3711,122 @@ std::pair<uint64_t, uint64_t> Tablet::GetCurrentVersionSstFilesAllSizes() const
   }, std::pair<uint64_t, uint64_t>(0, 0));
 }
 
+uint64_t Tablet::GetOrphanedPostSplitSstFilesSize() const {
+  if (!key_bounds_.IsInitialized() || metadata_->has_been_fully_compacted()) {
+    return 0;
+  }
+  return GetRegularDbStat([this] {
+    auto total = regular_db_->GetCurrentVersionSstFilesSize();
+    // Estimate size of the data within bounds and subtract it from the total, so unbounded side
+    // does not require sentinel key.
+    uint64_t size = 0;
+    if (key_bounds_.upper.empty()) {
+      rocksdb::Range range(Slice(), key_bounds_.lower.AsSlice());
+      regular_db_->GetApproximateSizes(&range, 1, &size);
+      return std::min<uint64_t>(size, total);
+    }
+    rocksdb::Range range(key_bounds_.lower.AsSlice(), key_bounds_.upper.AsSlice());
+    regular_db_->GetApproximateSizes(&range, 1, &size);
+    return total - std::min<uint64_t>(size, total);
+  }, static_cast<uint64_t>(0));
+}
+
+std::pair<uint64_t, uint64_t> Tablet::GetOwnSstFilesAllSizes() const {
+  auto sizes = GetCurrentVersionSstFilesAllSizes();
+  auto orphaned = GetOrphanedPostSplitSstFilesSize();
+  if (orphaned == 0 || sizes.first == 0) {
+    return sizes;
+  }
+  orphaned = std::min(orphaned, sizes.first);
+  auto own_fraction = static_cast<double>(sizes.first - orphaned) / sizes.first;
+  return {sizes.first - orphaned, static_cast<uint64_t>(sizes.second * own_fraction)};
+}
+
 uint64_t Tablet::GetCurrentVersionNumSSTFiles() const {
   return GetRegularDbStat([this] {
     return regular_db_->GetCurrentVersionNumSSTFiles();
   }, 0);
 }
 
+double Tablet::ObsoleteDataPercentage(HybridTime history_cutoff) const {
+  return GetRegularDbStat([this, history_cutoff] {
+    rocksdb::TablePropertiesCollection properties;
+    auto status = regular_db_->GetPropertiesOfAllTables(&properties);
+    if (!status.ok()) {
+      LOG_WITH_PREFIX_AND_FUNC(WARNING) << "Failed to get regular files properties: " << status;
+      return 0.0;
+    }
+    uint64_t total_bytes = 0;
+    uint64_t obsolete_bytes = 0;
+    for (const auto& [file_name, file_properties] : properties) {
+      auto stats = docdb::ObsoleteDataStats(*file_properties);
+      if (!stats.ok() || !*stats) {
+        // File without stats is accounted as not having obsolete data.
+        total_bytes += file_properties->raw_key_size + file_properties->raw_value_size;
+        continue;
+      }
+      total_bytes += (**stats).total_bytes();
+      // Obsolete entries could not be removed while they are visible to reads after history
+      // cutoff, so only files whose obsolete entries all fall below it are taken into account.
+      if (HybridTime((**stats).max_obsolete_ht()) < history_cutoff) {
+        obsolete_bytes += (**stats).tombstone_bytes() + (**stats).overwritten_bytes() +
+                          (**stats).expired_bytes();
+      }
+    }
+    return total_bytes ? 100.0 * obsolete_bytes / total_bytes : 0.0;
+  }, 0.0);
+}
+
+uint64_t Tablet::EstimatedNumRows() const {
+  auto [sst_rows, memtable_rows] = GetRegularDbStat([this] {
+    int64_t sst_rows = 0;
+    rocksdb::TablePropertiesCollection properties;
+    auto status = regular_db_->GetPropertiesOfAllTables(&properties);
+    if (!status.ok()) {
+      LOG_WITH_PREFIX_AND_FUNC(WARNING) << "Failed to get regular files properties: " << status;
+    }
+    for (const auto& [file_name, file_properties] : properties) {
+      auto stats = docdb::ObsoleteDataStats(*file_properties);
+      if (!stats.ok() || !*stats || !(**stats).has_doc_key_count()) {
+        // File without row count, so all its entries are accounted as rows.
+        sst_rows += file_properties->num_entries;
+        continue;
+      }
+      // Deleted row is accounted in this file, and in the older file where it was written.
+      sst_rows += static_cast<int64_t>((**stats).doc_key_count()) -
+                  2 * static_cast<int64_t>((**stats).deleted_doc_key_count());
+    }
+    // Memtable counters are per entry, that is per row for inserts of packed rows.
+    int64_t memtable_rows = 0;
+    for (const auto* property : {&rocksdb::DB::Properties::kNumEntriesActiveMemTable,
+                                 &rocksdb::DB::Properties::kNumEntriesImmMemTables}) {
+      uint64_t value = 0;
+      if (regular_db_->GetIntProperty(*property, &value)) {
+        memtable_rows += static_cast<int64_t>(value);
+      }
+    }
+    for (const auto* property : {&rocksdb::DB::Properties::kNumDeletesActiveMemTable,
+                                 &rocksdb::DB::Properties::kNumDeletesImmMemTables}) {
+      uint64_t value = 0;
+      if (regular_db_->GetIntProperty(*property, &value)) {
+        memtable_rows -= 2 * static_cast<int64_t>(value);
+      }
+    }
+    return std::pair<int64_t, int64_t>(sst_rows, memtable_rows);
+  }, std::pair<int64_t, int64_t>(0, 0));
+
+  // SST files shared with another split child contain rows of both children.
+  auto orphaned = GetOrphanedPostSplitSstFilesSize();
+  if (orphaned != 0 && sst_rows > 0) {
+    auto total = GetCurrentVersionSstFilesSize();
+    if (total != 0) {
+      auto own_fraction = static_cast<double>(total - std::min(orphaned, total)) / total;
+      sst_rows = static_cast<int64_t>(sst_rows * own_fraction);
+    }
+  }
+  return std::max<int64_t>(sst_rows + memtable_rows, 0);
+}
+
 std::pair<int, int> Tablet::GetNumMemtables() const {
   int intents_num_memtables = 0;
   int regular_num_memtables = 0;
@@ -3412,6 +3850,31 @@ std::pair<int, int> Tablet::GetNumMemtables() const {
   return std::make_pair(intents_num_memtables, regular_num_memtables);
 }
 
+std::pair<uint64_t, uint64_t> Tablet::GetMemtableSizes() const {
+  uint64_t mutable_size = 0;
+  uint64_t immutable_size = 0;
+
+  auto scoped_operation = CreateNonAbortableScopedRWOperation();
+  if (!scoped_operation.ok()) {
+    return std::make_pair(0, 0);
+  }
+  std::lock_guard<rw_spinlock> lock(component_lock_);
+  for (auto* db : { regular_db_.get(), intents_db_.get() }) {
+    if (!db) {
+      continue;
+    }
+    uint64_t active = 0;
+    uint64_t all = 0;
+    if (db->GetIntProperty(rocksdb::DB::Properties::kCurSizeActiveMemTable, &active) &&
+        db->GetIntProperty(rocksdb::DB::Properties::kCurSizeAllMemTables, &all)) {
+      mutable_size += active;
+      immutable_size += all > active ? all - active : 0;
+    }
+  }
+
+  return std::make_pair(mutable_size, immutable_size);
+}
+
 // ------------------------------------------------------------------------------------------------
 
 Result<TransactionOperationContext> Tablet::CreateTransactionOperationContext(
@@ -3624,7 +4087,8 @@ void Tablet::InitRocksDBOptions(
     rocksdb::BlockBasedTableOptions table_options) {
   docdb::InitRocksDBOptions(
       options, log_prefix, regulardb_statistics_, tablet_options_, std::move(table_options),
-      hash_for_data_root_dir(metadata_->data_root_dir()));
+      hash_for_data_root_dir(metadata_->data_root_dir()),
+      metadata_->schema()->table_properties().bloom_filter_range_components());
 }
 
 rocksdb::Env& Tablet::rocksdb_env() const {
@@ -3763,9 +4227,13 @@ void Tablet::TriggerFullCompactionSync(FullCompactionReason reason) {
   TEST_PAUSE_IF_FLAG(TEST_pause_before_full_compaction);
   LOG_WITH_PREFIX(INFO) << "Beginning full compaction on this tablet. "
       << "Reason: " << ToString(reason);
+  auto status = ForceFullRocksDBCompact();
   WARN_WITH_PREFIX_NOT_OK(
-      ForceFullRocksDBCompact(), LogPrefix() + "Failed tablet full compaction ("
-      + ToString(reason) + ")");
+      status, LogPrefix() + "Failed tablet full compaction (" + ToString(reason) + ")");
+  // Notify only after successful compaction, a failed one is retried by the periodic scheduling.
+  if (status.ok() && reason == FullCompactionReason::PostSplit && post_split_compaction_done_) {
+    post_split_compaction_done_();
+  }
 }
 
 bool Tablet::HasActiveTTLFileExpiration() {
@@ -59,6 +59,7 @@
 
 #include "yb/tablet/tablet_fwd.h"
 #include "yb/tablet/abstract_tablet.h"
+#include "yb/tablet/hot_keys.h"
 #include "yb/tablet/mvcc.h"
 #include "yb/tablet/operation_filter.h"
 #include "yb/tablet/tablet_options.h"
@@ -77,6 +78,7 @@
 
 namespace yb {
 
+class CallPhaseCounters;
 class FsManager;
 class MemTracker;
 class MetricEntity;
@@ -92,7 +94,7 @@ YB_STRONGLY_TYPED_BOOL(IncludeIntents);
 YB_STRONGLY_TYPED_BOOL(Abortable);
 YB_STRONGLY_TYPED_BOOL(FlushOnShutdown);
 
-YB_DEFINE_ENUM(FullCompactionReason, (PostSplit)(Scheduled));
+YB_DEFINE_ENUM(FullCompactionReason, (PostSplit)(Scheduled)(ObsoleteData));
 
 
 inline FlushFlags operator|(FlushFlags lhs, FlushFlags rhs) {
@@ -304,6 +306,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   Result<docdb::ApplyTransactionState> ApplyIntents(const TransactionApplyData& data) override;
 
+  Result<std::vector<docdb::ApplyTransactionState>> ApplyIntentsBatch(
+      const std::vector<const TransactionApplyData*>& data) override;
+
   Status RemoveIntents(
       const RemoveIntentsData& data, RemoveReason reason, const TransactionId& id) override;
 
@@ -462,6 +467,12 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   docdb::SharedLockManager* shared_lock_manager() { return &shared_lock_manager_; }
 
+  // Returns true when strongly consistent read of the document with specified encoded doc key
+  // could be done at read_ht without waiting for safe time, i.e. there are no pending writes to
+  // this document, and operations added later will get hybrid time after read_ht.
+  Result<bool> CanReadDocumentWithoutSafeTime(
+      Slice doc_key, HybridTime read_ht, CoarseTimePoint deadline);
+
   docdb::WaitQueue* wait_queue() { return wait_queue_.get(); }
 
   std::atomic<int64_t>* monotonic_counter() { return &monotonic_counter_; }
@@ -484,6 +495,14 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // May be nullptr in unit tests, etc.
   TabletMetrics* metrics() { return metrics_.get(); }
 
+  // Binds the sampled call being executed by the current thread to the tablet, so time spent
+  // by the call is also aggregated in the call phase counters of the tablet.
+  void BindCallAccounting();
+
+  // Most frequently read and written doc keys of the tablet, tracked over sampled requests.
+  HotKeys& hot_read_keys() { return hot_read_keys_; }
+  HotKeys& hot_write_keys() { return hot_write_keys_; }
+
   // Return handle to the metric entity of this tablet/table.
   const scoped_refptr<MetricEntity>& GetTableMetricsEntity() const {
     return table_metrics_entity_;
@@ -576,7 +595,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   Status ForceFullRocksDBCompact(docdb::SkipFlush skip_flush = docdb::SkipFlush::kFalse);
 
-  docdb::DocDB doc_db() const { return { regular_db_.get(), intents_db_.get(), &key_bounds_ }; }
+  docdb::DocDB doc_db() const {
+    return { regular_db_.get(), intents_db_.get(), &key_bounds_, row_cache_.get() };
+  }
 
   // Returns approximate middle key for tablet split:
   // - for hash-based partitions: encoded hash code in order to split by hash code.
@@ -608,11 +629,33 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   std::pair<uint64_t, uint64_t> GetCurrentVersionSstFilesAllSizes() const;
   uint64_t GetCurrentVersionNumSSTFiles() const;
 
+  // Returns estimated size of regular DB SST files data outside of the tablet key bounds, i.e. data
+  // of the parent tablet, that is shared with another split child till post-split compaction.
+  uint64_t GetOrphanedPostSplitSstFilesSize() const;
+
+  // Same as GetCurrentVersionSstFilesAllSizes, but without estimated size of orphaned post-split
+  // data. So SST files shared by split children are not accounted twice.
+  std::pair<uint64_t, uint64_t> GetOwnSstFilesAllSizes() const;
+
+  // Returns estimated percentage of regular DB data, that would be removed by full compaction
+  // with the specified history cutoff, according to obsolete data stats of SST files.
+  double ObsoleteDataPercentage(HybridTime history_cutoff) const;
+
+  // Returns approximate number of live rows in the tablet, maintained incrementally from row
+  // counts collected to SST file properties by flushes and compactions, and memtable counters.
+  // Rows updated after being written to older SST files are accounted in each of them, so it is
+  // an overestimate till those files are compacted together.
+  uint64_t EstimatedNumRows() const;
+
   void ListenNumSSTFilesChanged(std::function<void()> listener);
 
   // Returns the number of memtables in intents and regular db-s.
   std::pair<int, int> GetNumMemtables() const;
 
+  // Returns the approximate size of the mutable memtables, and of the immutable memtables that are
+  // not flushed yet, summed over intents and regular db-s.
+  std::pair<uint64_t, uint64_t> GetMemtableSizes() const;
+
   void SetHybridTimeLeaseProvider(HybridTimeLeaseProvider provider) {
     ht_lease_provider_ = std::move(provider);
   }
@@ -798,6 +841,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   FRIEND_TEST(TestTablet, TestGetLogRetentionSizeForIndex);
 
+  // Record doc keys of the request to hot keys, if it is selected by sampling.
+  void SampleReadKeys(const Schema& schema, const PgsqlReadRequestPB& request);
+  void SampleWriteKeys(const docdb::LWKeyValueWriteBatchPB& write_batch);
+
   Status OpenKeyValueTablet();
   virtual Status CreateTabletDirectories(const std::string& db_dir, FsManager* fs);
 
@@ -916,6 +963,13 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   std::unique_ptr<TabletMetrics> metrics_;
   std::shared_ptr<void> metric_detacher_;
 
+  HotKeys hot_read_keys_;
+  HotKeys hot_write_keys_;
+
+  // Created on first sampled call, to avoid extra metrics per tablet while accounting is off.
+  std::once_flag call_phase_counters_once_;
+  std::shared_ptr<CallPhaseCounters> call_phase_counters_;
+
   // A pointer to the server's clock.
   scoped_refptr<server::Clock> clock_;
 
@@ -949,6 +1003,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Optional key bounds (see docdb::KeyBounds) served by this tablet.
   docdb::KeyBounds key_bounds_;
 
+  // Cache of hot rows, see docdb::RowCache.
+  std::unique_ptr<docdb::RowCache> row_cache_;
+
   std::unique_ptr<docdb::YQLStorageIf> ql_storage_;
 
   // This is for docdb fine-grained locking.
@@ -1023,6 +1080,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   void CleanupIntentFiles();
   void DoCleanupIntentFiles();
 
+  // Returns true if intents SST file tracks its transactions, and all of them are finished.
+  bool IntentsFileTransactionsFinished(const rocksdb::LiveFileMetaData& file);
+
   void RegularDbFilesChanged();
 
   HybridTime ApplierSafeTime(HybridTime min_allowed, CoarseTimePoint deadline) override;
@@ -1081,6 +1141,8 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Gauge to monitor post-split compactions that have been started.
   scoped_refptr<yb::AtomicGauge<uint64_t>> ts_post_split_compaction_added_;
 
+  std::function<void()> post_split_compaction_done_;
+
   simple_spinlock operation_filters_mutex_;
 
   boost::intrusive::list<OperationFilter> operation_filters_ GUARDED_BY(operation_filters_mutex_);
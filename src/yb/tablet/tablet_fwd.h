@@ -46,6 +46,7 @@ typedef std::shared_ptr<TabletPeer> TabletPeerPtr;
 class ChangeMetadataOperation;
 class Operation;
 class OperationFilter;
+class SharedTransactionStatusCache;
 class SnapshotCoordinator;
 class SnapshotOperation;
 class SplitOperation;
@@ -121,6 +121,16 @@ METRIC_DEFINE_counter(tablet, pgsql_consistent_prefix_read_rows,
                       yb::MetricUnit::kRequests,
                       "Number of pgsql rows read as part of a consistent prefix request");
 
+METRIC_DEFINE_counter(tablet, read_requests_handled,
+  "Read Requests Handled",
+  yb::MetricUnit::kRequests,
+  "Number of read requests handled by this tablet.");
+
+METRIC_DEFINE_counter(tablet, write_batches_handled,
+  "Write Batches Handled",
+  yb::MetricUnit::kRequests,
+  "Number of write batches applied by this tablet.");
+
 METRIC_DEFINE_counter(tablet, tablet_data_corruptions,
   "Tablet Data Corruption Detections",
   yb::MetricUnit::kUnits,
@@ -147,15 +157,22 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& table_entity,
     MINIT(tablet_entity, consistent_prefix_read_requests),
     MINIT(tablet_entity, pgsql_consistent_prefix_read_rows),
     MINIT(tablet_entity, tablet_data_corruptions),
-    MINIT(tablet_entity, rows_inserted) {
+    MINIT(tablet_entity, rows_inserted),
+    MINIT(tablet_entity, read_requests_handled),
+    MINIT(tablet_entity, write_batches_handled) {
 }
 #undef MINIT
 
-ScopedTabletMetricsTracker::ScopedTabletMetricsTracker(scoped_refptr<Histogram> latency)
-    : latency_(latency), start_time_(MonoTime::Now()) {}
+ScopedTabletMetricsTracker::ScopedTabletMetricsTracker(
+    scoped_refptr<Histogram> latency, scoped_refptr<Counter> requests)
+    : latency_(std::move(latency)), requests_(std::move(requests)),
+      start_time_(MonoTime::Now()) {}
 
 ScopedTabletMetricsTracker::~ScopedTabletMetricsTracker() {
   latency_->Increment(MonoTime::Now().GetDeltaSince(start_time_).ToMicroseconds());
+  if (requests_) {
+    requests_->Increment();
+  }
 }
 } // namespace tablet
 } // namespace yb
@@ -70,15 +70,21 @@ struct TabletMetrics {
   scoped_refptr<Counter> tablet_data_corruptions;
 
   scoped_refptr<Counter> rows_inserted;
+
+  // Per tablet number of handled requests, reported to the master to detect hot tablets.
+  scoped_refptr<Counter> read_requests_handled;
+  scoped_refptr<Counter> write_batches_handled;
 };
 
 class ScopedTabletMetricsTracker {
  public:
-  explicit ScopedTabletMetricsTracker(scoped_refptr<Histogram> latency);
+  explicit ScopedTabletMetricsTracker(
+      scoped_refptr<Histogram> latency, scoped_refptr<Counter> requests = nullptr);
   ~ScopedTabletMetricsTracker();
 
  private:
   scoped_refptr<Histogram> latency_;
+  scoped_refptr<Counter> requests_;
   MonoTime start_time_;
 };
 
@@ -54,6 +54,8 @@ namespace tablet {
 // Common for all tablets within TabletManager.
 struct TabletOptions {
   std::shared_ptr<rocksdb::Cache> block_cache;
+  // Cache of compressed blocks, used as the second tier after block_cache when set.
+  std::shared_ptr<rocksdb::Cache> compressed_block_cache;
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor;
   std::vector<std::shared_ptr<rocksdb::EventListener>> listeners;
   yb::Env* env = Env::Default();
@@ -88,6 +90,9 @@ struct TabletInitData {
   AutoFlagsManager* auto_flags_manager = nullptr;
   ThreadPool* full_compaction_pool;
   scoped_refptr<yb::AtomicGauge<uint64_t>> post_split_compaction_added;
+  // Invoked after post-split compaction of the tablet has finished.
+  std::function<void()> post_split_compaction_done;
+  SharedTransactionStatusCache* shared_transaction_status_cache = nullptr;
 };
 
 } // namespace tablet
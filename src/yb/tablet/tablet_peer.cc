@@ -1370,9 +1370,9 @@ TabletOnDiskSizeInfo TabletPeer::GetOnDiskSizeInfo() const {
   }
 
   if (tablet_) {
-    info.sst_files_disk_size = tablet_->GetCurrentVersionSstFilesSize();
-    info.uncompressed_sst_files_disk_size =
-        tablet_->GetCurrentVersionSstFilesUncompressedSize();
+    auto sst_sizes = tablet_->GetOwnSstFilesAllSizes();
+    info.sst_files_disk_size = sst_sizes.first;
+    info.uncompressed_sst_files_disk_size = sst_sizes.second;
   }
 
   auto log = log_atomic_.load(std::memory_order_acquire);
@@ -1549,6 +1549,7 @@ Status TabletPeer::ChangeRole(const std::string& requestor_uuid) {
 
     switch(peer_pb.member_type()) {
       case PeerMemberType::OBSERVER: FALLTHROUGH_INTENDED;
+      case PeerMemberType::WITNESS: FALLTHROUGH_INTENDED;
       case PeerMemberType::VOTER:
         LOG(ERROR) << "Peer " << peer_pb.permanent_uuid() << " is a "
                    << PeerMemberType_Name(peer_pb.member_type())
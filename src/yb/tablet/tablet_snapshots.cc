@@ -13,6 +13,8 @@
 
 #include "yb/tablet/tablet_snapshots.h"
 
+#include <unordered_set>
+
 #include <boost/algorithm/string/predicate.hpp>
 
 #include "yb/common/index.h"
@@ -23,8 +25,12 @@
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/doc_write_batch.h"
+#include "yb/docdb/row_cache.h"
+
+#include "yb/gutil/casts.h"
 
 #include "yb/rocksdb/db.h"
+#include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksdb/util/file_util.h"
 #include "yb/rocksdb/utilities/checkpoint.h"
 
@@ -51,6 +57,13 @@ DEFINE_test_flag(int32, delay_tablet_split_metadata_restore_secs, 0,
                  "How much time in secs to delay restoring tablet split metadata after restoring "
                  "checkpoint.");
 
+DEFINE_RUNTIME_bool(enable_in_place_pitr, false,
+                    "Restore tablets to a time within the history retention interval of a "
+                    "snapshot schedule by writing current versions with the values of rows changed "
+                    "after the restore time, instead of replacing the tablet with the preceding "
+                    "snapshot. Used only when table schemas were not changed since the restore "
+                    "time.");
+
 namespace yb {
 namespace tablet {
 
@@ -59,10 +72,49 @@ namespace {
 const std::string kTempSnapshotDirSuffix = ".tmp";
 const std::string kTabletMetadataFile = "tablet.metadata";
 
+// Max number of restored key-value pairs written to RocksDB in one batch by in place restore.
+constexpr size_t kInPlaceRestoreBatchSize = 10000;
+
 std::string TabletMetadataFile(const std::string& dir) {
   return JoinPathSegments(dir, kTabletMetadataFile);
 }
 
+// Skips SST files that were entirely written not later than the specified hybrid time, so they
+// could not contain changes made after it. Files without frontier are always read.
+class ChangedAfterFileFilter : public rocksdb::ReadFileFilter {
+ public:
+  ChangedAfterFileFilter(rocksdb::DB* db, HybridTime hybrid_time) {
+    for (const auto& file : db->GetLiveFilesMetaData()) {
+      if (file.largest.user_frontier &&
+          down_cast<docdb::ConsensusFrontier&>(*file.largest.user_frontier).hybrid_time() <=
+              hybrid_time) {
+        unchanged_files_.insert(file.name_id);
+      }
+    }
+  }
+
+  bool Filter(const rocksdb::FdWithBoundaries& file) const override {
+    return !unchanged_files_.count(file.fd.GetNumber());
+  }
+
+  size_t num_skipped_files() const {
+    return unchanged_files_.size();
+  }
+
+ private:
+  std::unordered_set<uint64_t> unchanged_files_;
+};
+
+class InPlaceRestorePatch : public RestorePatch {
+ public:
+  using RestorePatch::RestorePatch;
+
+ private:
+  Result<bool> ShouldSkipEntry(const Slice& key, const Slice& value) override {
+    return false;
+  }
+};
+
 } // namespace
 
 struct TabletSnapshots::RestoreMetadata {
@@ -267,6 +319,10 @@ Status TabletSnapshots::Restore(SnapshotOperation* operation) {
     table_metadata->index_map.emplace(ToRepeatedPtrField(entry.indexes()));
     table_metadata->table_id = entry.table_id().ToBuffer();
   }
+  if (CanRestoreInPlace(restore_at, restore_metadata, !request.schedule_id().empty())) {
+    RETURN_NOT_OK(RestoreInPlace(operation, restore_at, restore_metadata));
+    return restoration_id ? tablet().RestoreStarted(restoration_id) : Status::OK();
+  }
   Status s = RestoreCheckpoint(
       snapshot_dir, restore_at, restore_metadata, frontier, !request.schedule_id().empty());
   VLOG_WITH_PREFIX(1) << "Complete checkpoint restoring with result " << s << " in folder: "
@@ -281,6 +337,100 @@ Status TabletSnapshots::Restore(SnapshotOperation* operation) {
   return s;
 }
 
+bool TabletSnapshots::CanRestoreInPlace(
+    HybridTime restore_at, const RestoreMetadata& restore_metadata, bool is_pitr_restore) {
+  if (!FLAGS_enable_in_place_pitr || !restore_at || !is_pitr_restore ||
+      tablet().is_sys_catalog()) {
+    return false;
+  }
+  // Restored rows keep packing of the schema version they were written with, so the schema
+  // should not be changed since restore time.
+  auto& metadata = *tablet().metadata();
+  if (restore_metadata.schema && restore_metadata.schema_version != metadata.schema_version()) {
+    return false;
+  }
+  for (const auto& table_metadata : restore_metadata.colocated_tables_metadata) {
+    auto table_info = metadata.GetTableInfo(table_metadata.table_id);
+    if (!table_info.ok() || (*table_info)->schema_version != table_metadata.schema_version) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Status TabletSnapshots::RestoreInPlace(
+    SnapshotOperation* operation, HybridTime restore_at, const RestoreMetadata& restore_metadata) {
+  LongOperationTracker long_operation_tracker("Restore in place", 5s);
+
+  // Keeps history after restore_at from being garbage collected while restore is in progress.
+  // Fails when restore_at is already out of history retention interval.
+  auto scoped_read_operation = VERIFY_RESULT(ScopedReadOperation::Create(
+      &tablet(), RequireLease::kFalse, ReadHybridTime::SingleTime(restore_at)));
+
+  auto doc_db = tablet().doc_db();
+  auto file_filter = std::make_shared<ChangedAfterFileFilter>(doc_db.regular, restore_at);
+  auto changes_iter = docdb::CreateRocksDBIterator(
+      doc_db.regular, doc_db.key_bounds, docdb::BloomFilterMode::DONT_USE_BLOOM_FILTER,
+      boost::none, rocksdb::kDefaultQueryId, file_filter);
+
+  FetchState existing_state(doc_db, ReadHybridTime::Max());
+  FetchState restoring_state(doc_db, ReadHybridTime::SingleTime(restore_at));
+  docdb::DocWriteBatch write_batch(doc_db, docdb::InitMarkerBehavior::kOptional);
+  InPlaceRestorePatch restore_patch(&existing_state, &restoring_state, &write_batch);
+
+  // Keys of regular RocksDB are ordered by doc key, so each row changed after restore_at is
+  // patched once, by a forward pass of both fetch states.
+  KeyBuffer doc_key;
+  size_t num_changed_rows = 0;
+  changes_iter.SeekToFirst();
+  while (changes_iter.Valid()) {
+    auto key = changes_iter.key();
+    auto write_time = VERIFY_RESULT(DocHybridTime::DecodeFromEnd(key));
+    if (write_time.hybrid_time() <= restore_at) {
+      changes_iter.Next();
+      continue;
+    }
+    auto doc_key_size = VERIFY_RESULT(
+        docdb::DocKey::EncodedHashPartAndDocKeySizes(key)).doc_key_size;
+    doc_key = key.Prefix(doc_key_size);
+    ++num_changed_rows;
+
+    RETURN_NOT_OK(existing_state.SetPrefix(doc_key.AsSlice()));
+    RETURN_NOT_OK(restoring_state.SetPrefix(doc_key.AsSlice()));
+    RETURN_NOT_OK(restore_patch.PatchCurrentStateFromRestoringState());
+    if (write_batch.size() >= kInPlaceRestoreBatchSize) {
+      WriteToRocksDB(
+          &write_batch, operation->WriteHybridTime(), operation->op_id(), &tablet(), std::nullopt);
+      write_batch.Clear();
+    }
+
+    // Skip remaining entries of the same row.
+    doc_key.PushBack(docdb::KeyEntryTypeAsChar::kMaxByte);
+    changes_iter.Seek(doc_key.AsSlice());
+  }
+  RETURN_NOT_OK(changes_iter.status());
+
+  if (write_batch.size()) {
+    WriteToRocksDB(
+        &write_batch, operation->WriteHybridTime(), operation->op_id(), &tablet(), std::nullopt);
+  }
+  // Restored rows are written directly to RocksDB, so cached rows could be outdated.
+  if (doc_db.row_cache) {
+    doc_db.row_cache->Clear();
+  }
+
+  if (restore_metadata.schema && tablet().metadata()->hidden() != restore_metadata.hide) {
+    tablet().metadata()->SetHidden(restore_metadata.hide);
+    RETURN_NOT_OK(tablet().metadata()->Flush());
+  }
+
+  LOG_WITH_PREFIX(INFO)
+      << "Restored in place to " << restore_at << ", changed rows: " << num_changed_rows
+      << ", skipped files: " << file_filter->num_skipped_files() << ", "
+      << restore_patch.TickersToString();
+  return Status::OK();
+}
+
 Status TabletSnapshots::RestorePartialRows(SnapshotOperation* operation) {
   docdb::DocWriteBatch write_batch(tablet().doc_db(), docdb::InitMarkerBehavior::kOptional);
 
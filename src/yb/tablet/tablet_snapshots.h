@@ -104,6 +104,16 @@ class TabletSnapshots : public TabletComponent {
       const std::string& dir, HybridTime restore_at, const RestoreMetadata& metadata,
       const docdb::ConsensusFrontier& frontier, bool is_pitr_restore);
 
+  // Whether PITR restore to restore_at could be done in place, using MVCC history of the tablet.
+  bool CanRestoreInPlace(
+      HybridTime restore_at, const RestoreMetadata& metadata, bool is_pitr_restore);
+
+  // Restores rows changed after restore_at by writing their state at restore_at as new versions.
+  // Rows are found by scanning only SST files written after restore_at, so the cost is
+  // proportional to the amount of changes instead of the tablet size.
+  Status RestoreInPlace(
+      SnapshotOperation* operation, HybridTime restore_at, const RestoreMetadata& metadata);
+
   // Applies specified snapshot operation.
   Status Apply(SnapshotOperation* operation);
 
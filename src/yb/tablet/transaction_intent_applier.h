@@ -14,6 +14,7 @@
 #pragma once
 
 #include <type_traits>
+#include <vector>
 
 #include "yb/common/transaction.h"
 
@@ -34,6 +35,12 @@ YB_DEFINE_ENUM(RemoveReason,
 class TransactionIntentApplier {
  public:
   virtual Result<docdb::ApplyTransactionState> ApplyIntents(const TransactionApplyData& data) = 0;
+
+  // Applies next portion of intents of several transactions with one write to regular DB.
+  // Limit of records written at once is shared by all transactions.
+  // Returns apply state of each transaction, in the same order.
+  virtual Result<std::vector<docdb::ApplyTransactionState>> ApplyIntentsBatch(
+      const std::vector<const TransactionApplyData*>& data) = 0;
   virtual Status RemoveIntents(
       const RemoveIntentsData& data, RemoveReason reason,
       const TransactionId& transaction_id) = 0;
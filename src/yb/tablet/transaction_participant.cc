@@ -30,6 +30,7 @@
 
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/transaction_dump.h"
+#include "yb/docdb/wait_queue.h"
 
 #include "yb/rpc/poller.h"
 
@@ -41,6 +42,7 @@
 #include "yb/tablet/remove_intents_task.h"
 #include "yb/tablet/running_transaction.h"
 #include "yb/tablet/running_transaction_context.h"
+#include "yb/tablet/shared_transaction_status_cache.h"
 #include "yb/tablet/transaction_loader.h"
 #include "yb/tablet/transaction_participant_context.h"
 #include "yb/tablet/transaction_status_resolver.h"
@@ -94,6 +96,11 @@ DEFINE_uint64(transactions_status_poll_interval_ms, 500 * yb::kTimeMultiplier,
 
 DEFINE_bool(transactions_poll_check_aborted, true, "Check aborted transactions during poll.");
 
+DEFINE_RUNTIME_bool(skip_intents_of_applied_transactions_in_reads, true,
+    "Whether reads ignore intents of transactions that were already applied to regular DB, but "
+    "are kept for CDC. So reads don't have to iterate intents DB only because a CDC stream lags.");
+TAG_FLAG(skip_intents_of_applied_transactions_in_reads, advanced);
+
 DECLARE_int64(transaction_abort_check_timeout_ms);
 
 DECLARE_int64(cdc_intent_retention_ms);
@@ -104,6 +111,14 @@ METRIC_DEFINE_simple_counter(
 METRIC_DEFINE_simple_gauge_uint64(
     tablet, transactions_running, "Total number of transactions running in participant",
     yb::MetricUnit::kTransactions);
+METRIC_DEFINE_simple_gauge_uint64(
+    tablet, large_transactions_applying,
+    "Number of large transactions whose intents are being applied in background",
+    yb::MetricUnit::kTransactions);
+METRIC_DEFINE_coarse_histogram(
+    tablet, large_transaction_apply_lag, "Large transaction apply lag",
+    yb::MetricUnit::kMicroseconds,
+    "Time between commit of large transaction and completion of applying its intents.");
 
 DEFINE_test_flag(int32, txn_participant_inject_latency_on_apply_update_txn_ms, 0,
                  "How much latency to inject when a update txn operation is applied.");
@@ -127,14 +142,17 @@ class TransactionParticipant::Impl
     : public RunningTransactionContext, public TransactionLoaderContext {
  public:
   Impl(TransactionParticipantContext* context, TransactionIntentApplier* applier,
-       const scoped_refptr<MetricEntity>& entity)
-      : RunningTransactionContext(context, applier),
+       const scoped_refptr<MetricEntity>& entity,
+       SharedTransactionStatusCache* shared_status_cache)
+      : RunningTransactionContext(context, applier, shared_status_cache),
         log_prefix_(context->LogPrefix()),
         loader_(this, entity),
         poller_(log_prefix_, std::bind(&Impl::Poll, this)) {
     LOG_WITH_PREFIX(INFO) << "Create";
     metric_transactions_running_ = METRIC_transactions_running.Instantiate(entity, 0);
     metric_transaction_not_found_ = METRIC_transaction_not_found.Instantiate(entity);
+    metric_large_transactions_applying_ = METRIC_large_transactions_applying.Instantiate(entity, 0);
+    metric_large_transaction_apply_lag_ = METRIC_large_transaction_apply_lag.Instantiate(entity);
   }
 
   ~Impl() {
@@ -621,6 +639,11 @@ class TransactionParticipant::Impl
   Status ProcessApply(const TransactionApplyData& data) {
     VLOG_WITH_PREFIX(2) << "Apply: " << data.ToString();
 
+    if (shared_status_cache_ && !data.is_external) {
+      // Other tablets of this transaction on the same node don't have to ask coordinator anymore.
+      shared_status_cache_->Committed(data.transaction_id, data.commit_ht, data.aborted);
+    }
+
     loader_.WaitLoaded(data.transaction_id);
 
     ScopedRWOperation operation(pending_op_counter_);
@@ -675,6 +698,10 @@ class TransactionParticipant::Impl
                           << apply_state.ToString();
 
       UpdateAppliedTransaction(data, apply_state, &operation);
+
+      if (wait_queue_ && !data.is_external) {
+        wait_queue_->SignalCommitted(data.transaction_id, data.commit_ht, data.aborted);
+      }
     }
 
     NotifyApplied(data);
@@ -786,6 +813,10 @@ class TransactionParticipant::Impl
     return Status::OK();
   }
 
+  void SetWaitQueue(docdb::WaitQueue* wait_queue) {
+    wait_queue_ = wait_queue;
+  }
+
   void SetDB(
       const docdb::DocDB& db, const docdb::KeyBounds* key_bounds,
       RWOperationCounter* pending_op_counter) {
@@ -834,6 +865,19 @@ class TransactionParticipant::Impl
     return &participant_context_;
   }
 
+  HybridTime MinRunningNotAppliedHybridTime() {
+    if (!GetAtomicFlag(&FLAGS_skip_intents_of_applied_transactions_in_reads)) {
+      return MinRunningHybridTime();
+    }
+    auto result = min_running_not_applied_ht_.load(std::memory_order_acquire);
+    if (result == HybridTime::kMax || result == HybridTime::kInvalid) {
+      return result;
+    }
+    // Keeps checking status of the long running min transaction.
+    MinRunningHybridTime();
+    return result;
+  }
+
   HybridTime MinRunningHybridTime() {
     auto result = min_running_ht_.load(std::memory_order_acquire);
     if (result == HybridTime::kMax || result == HybridTime::kInvalid) {
@@ -977,6 +1021,20 @@ class TransactionParticipant::Impl
     return Status::OK();
   }
 
+  bool AnyRunning(const std::vector<TransactionId>& ids) {
+    if (!min_running_ht_.load(std::memory_order_acquire).is_valid()) {
+      // Transactions are not loaded yet.
+      return true;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& id : ids) {
+      if (transactions_.find(id) != transactions_.end()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   size_t TEST_GetNumRunningTransactions() {
     std::lock_guard<std::mutex> lock(mutex_);
     auto txn_to_id = [](const RunningTransactionPtr& txn) {
@@ -1104,6 +1162,7 @@ class TransactionParticipant::Impl
 
  private:
   class AbortCheckTimeTag;
+  class NotAppliedStartTimeTag;
   class StartTimeTag;
 
   typedef boost::multi_index_container<RunningTransactionPtr,
@@ -1121,6 +1180,11 @@ class TransactionParticipant::Impl
               boost::multi_index::tag<AbortCheckTimeTag>,
               boost::multi_index::const_mem_fun <
                   RunningTransaction, HybridTime, &RunningTransaction::abort_check_ht>
+          >,
+          boost::multi_index::ordered_non_unique <
+              boost::multi_index::tag<NotAppliedStartTimeTag>,
+              boost::multi_index::const_mem_fun <
+                  RunningTransaction, HybridTime, &RunningTransaction::not_applied_start_ht>
           >
       >
   > Transactions;
@@ -1203,10 +1267,15 @@ class TransactionParticipant::Impl
 
     if (transactions_.empty()) {
       min_running_ht_.store(HybridTime::kMax, std::memory_order_release);
+      min_running_not_applied_ht_.store(HybridTime::kMax, std::memory_order_release);
       CheckMinRunningHybridTimeSatisfiedUnlocked(min_running_notifier);
       return;
     }
 
+    min_running_not_applied_ht_.store(
+        (**transactions_.get<NotAppliedStartTimeTag>().begin()).not_applied_start_ht(),
+        std::memory_order_release);
+
     auto& first_txn = **transactions_.get<StartTimeTag>().begin();
     if (first_txn.start_ht() != min_running_ht_.load(std::memory_order_relaxed)) {
       min_running_ht_.store(first_txn.start_ht(), std::memory_order_release);
@@ -1312,6 +1381,15 @@ class TransactionParticipant::Impl
       return true;
     }
 
+    if ((reason == RemoveReason::kApplied || reason == RemoveReason::kLargeApplied) &&
+        (**it).not_applied_start_ht() != HybridTime::kMax) {
+      // Values of the transaction are already in regular DB, so new reads don't need its intents.
+      CHECK(transactions_.modify(it, [](auto& txn) {
+        txn->SetIntentsApplied();
+      }));
+      TransactionsModifiedUnlocked(min_running_notifier);
+    }
+
     // We cannot remove the transaction at this point, because there are running requests
     // that are reading the provisional DB and could request status of this transaction.
     // So we store transaction in a queue and wait when all requests that we launched before our
@@ -1451,6 +1529,11 @@ class TransactionParticipant::Impl
     recently_removed_transactions_cleanup_queue_.push_back({transaction.id(), now + 15s});
     LOG_IF_WITH_PREFIX(DFATAL, !recently_removed_transactions_.insert(transaction.id()).second)
         << "Transaction removed twice: " << transaction.id();
+    // Committed transactions are signaled right after apply, while aborted ones are signaled when
+    // removed.
+    if (wait_queue_ && !transaction.local_commit_time().is_valid()) {
+      wait_queue_->SignalAborted(transaction.id());
+    }
     transactions_.erase(it);
     TransactionsModifiedUnlocked(min_running_notifier);
   }
@@ -1681,6 +1764,9 @@ class TransactionParticipant::Impl
   // Owned externally, should be guaranteed that would not be destroyed before this.
   RWOperationCounter* pending_op_counter_ = nullptr;
 
+  // Set once right after construction, before any transaction is processed.
+  docdb::WaitQueue* wait_queue_ = nullptr;
+
   Transactions transactions_;
   // Ids of running requests, stored in increasing order.
   std::deque<int64_t> running_requests_;
@@ -1736,6 +1822,8 @@ class TransactionParticipant::Impl
   CountDownLatch shutdown_latch_{1};
 
   std::atomic<HybridTime> min_running_ht_{HybridTime::kInvalid};
+  // Same as min_running_ht_, but ignoring transactions whose intents were applied to regular DB.
+  std::atomic<HybridTime> min_running_not_applied_ht_{HybridTime::kInvalid};
   std::atomic<CoarseTimePoint> next_check_min_running_{CoarseTimePoint()};
   HybridTime waiting_for_min_running_ht_ = HybridTime::kMax;
   std::atomic<bool> shutdown_done_{false};
@@ -1754,8 +1842,9 @@ class TransactionParticipant::Impl
 
 TransactionParticipant::TransactionParticipant(
     TransactionParticipantContext* context, TransactionIntentApplier* applier,
-    const scoped_refptr<MetricEntity>& entity)
-    : impl_(new Impl(context, applier, entity)) {
+    const scoped_refptr<MetricEntity>& entity,
+    SharedTransactionStatusCache* shared_status_cache)
+    : impl_(new Impl(context, applier, entity, shared_status_cache)) {
 }
 
 TransactionParticipant::~TransactionParticipant() {
@@ -1859,6 +1948,10 @@ void TransactionParticipant::SetDB(
   impl_->SetDB(db, key_bounds, pending_op_counter);
 }
 
+void TransactionParticipant::SetWaitQueue(docdb::WaitQueue* wait_queue) {
+  impl_->SetWaitQueue(wait_queue);
+}
+
 void TransactionParticipant::GetStatus(
     const TransactionId& transaction_id,
     size_t required_num_replicated_batches,
@@ -1876,6 +1969,14 @@ HybridTime TransactionParticipant::MinRunningHybridTime() const {
   return impl_->MinRunningHybridTime();
 }
 
+HybridTime TransactionParticipant::MinRunningNotAppliedHybridTime() const {
+  return impl_->MinRunningNotAppliedHybridTime();
+}
+
+bool TransactionParticipant::AnyRunning(const std::vector<TransactionId>& ids) const {
+  return impl_->AnyRunning(ids);
+}
+
 void TransactionParticipant::WaitMinRunningHybridTime(HybridTime ht) {
   impl_->WaitMinRunningHybridTime(ht);
 }
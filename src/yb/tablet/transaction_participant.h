@@ -111,7 +111,8 @@ class TransactionParticipant : public TransactionStatusManager {
  public:
   TransactionParticipant(
       TransactionParticipantContext* context, TransactionIntentApplier* applier,
-      const scoped_refptr<MetricEntity>& entity);
+      const scoped_refptr<MetricEntity>& entity,
+      SharedTransactionStatusCache* shared_status_cache = nullptr);
   virtual ~TransactionParticipant();
 
   // Notify participant that this context is ready and it could start performing its requests.
@@ -171,6 +172,9 @@ class TransactionParticipant : public TransactionStatusManager {
       const docdb::DocDB& db, const docdb::KeyBounds* key_bounds,
       RWOperationCounter* pending_op_counter);
 
+  // Wait queue of the tablet, that should be signaled when transactions are committed or aborted.
+  void SetWaitQueue(docdb::WaitQueue* wait_queue);
+
   Status CheckAborted(const TransactionId& id);
 
   void FillPriorities(
@@ -190,6 +194,12 @@ class TransactionParticipant : public TransactionStatusManager {
 
   HybridTime MinRunningHybridTime() const override;
 
+  HybridTime MinRunningNotAppliedHybridTime() const override;
+
+  // Returns true if any of specified transactions is still known to participant, i.e. was not
+  // applied or aborted and cleaned up yet. Also returns true while transactions are being loaded.
+  bool AnyRunning(const std::vector<TransactionId>& ids) const;
+
   Result<HybridTime> WaitForSafeTime(HybridTime safe_time, CoarseTimePoint deadline) override;
 
   // When minimal start hybrid time of running transaction will be at least `ht` applier
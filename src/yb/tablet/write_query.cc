@@ -13,6 +13,8 @@
 
 #include "yb/tablet/write_query.h"
 
+#include <unordered_map>
+
 #include "yb/client/client.h"
 #include "yb/client/error.h"
 #include "yb/client/meta_data_cache.h"
@@ -41,11 +43,17 @@
 
 #include "yb/tserver/tserver.pb.h"
 
+#include "yb/util/atomic.h"
+#include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/metrics.h"
 #include "yb/util/sync_point.h"
 #include "yb/util/trace.h"
 
+DEFINE_RUNTIME_AUTO_bool(enable_range_tombstones, kLocalPersisted, false, true,
+    "Allow range delete statements, that write range tombstones. Older versions fail to decode "
+    "range tombstone keys, so they are written only after all nodes are upgraded.");
+
 using namespace std::placeholders;
 
 namespace yb {
@@ -128,6 +136,7 @@ WriteQuery::WriteQuery(
       response_(response),
       kind_(kind),
       start_time_(CoarseMonoClock::Now()),
+      call_accounting_(CallAccounting::Current()),
       execute_mode_(ExecuteMode::kSimple) {
 }
 
@@ -200,6 +209,7 @@ void WriteQuery::Finished(WriteOperation* operation, const Status& status) {
     if (metrics) {
       auto op_duration_usec = MonoDelta(CoarseMonoClock::now() - start_time_).ToMicroseconds();
       metrics->ql_write_latency->Increment(op_duration_usec);
+      metrics->write_batches_handled->Increment();
     }
   }
 
@@ -372,6 +382,15 @@ Result<bool> WriteQuery::PgsqlPrepareExecute() {
       resp->set_skipped(true);
       continue;
     }
+    // Range tombstones are stored under the table doc key, that exists only in colocated tablets.
+    if (req.stmt_type() == PgsqlWriteRequestPB::PGSQL_DELETE_RANGE) {
+      if (!GetAtomicFlag(&FLAGS_enable_range_tombstones)) {
+        return STATUS(NotSupported, "Range delete is not enabled until all nodes are upgraded");
+      }
+      if (!colocated) {
+        return STATUS(NotSupported, "Range delete is supported only for colocated tables");
+      }
+    }
     const TableInfoPtr table_info = VERIFY_RESULT(metadata.GetTableInfo(req.table_id()));
     docdb::AddTableSchemaVersion(
         table_info->cotable_id, table_info->schema_version, request().mutable_write_batch());
@@ -430,11 +449,17 @@ Status WriteQuery::DoExecute() {
         << operation_->ToString();
   }
 
+  shared_tablet->BindCallAccounting();
+
   docdb::PartialRangeKeyIntents partial_range_key_intents(metadata.UsePartialRangeKeyIntents());
-  prepare_result_ = VERIFY_RESULT(docdb::PrepareDocWriteOperation(
-      doc_ops_, write_batch.read_pairs(), shared_tablet->metrics()->write_lock_latency,
-      isolation_level_, kind(), row_mark_type, transactional_table, write_batch.has_transaction(),
-      deadline(), partial_range_key_intents, shared_tablet->shared_lock_manager()));
+  {
+    ScopedCallPhase lock_wait_phase(CallPhase::kLockWait);
+    prepare_result_ = VERIFY_RESULT(docdb::PrepareDocWriteOperation(
+        doc_ops_, write_batch.read_pairs(), shared_tablet->metrics()->write_lock_latency,
+        isolation_level_, kind(), row_mark_type, transactional_table,
+        write_batch.has_transaction(), deadline(), partial_range_key_intents,
+        shared_tablet->shared_lock_manager()));
+  }
 
   TEST_SYNC_POINT("WriteQuery::DoExecute::PreparedDocWriteOps");
 
@@ -448,6 +473,7 @@ Status WriteQuery::DoExecute() {
     return Status::OK();
   }
 
+  conflict_resolution_timer_.Start(CallPhase::kConflictResolution, call_accounting_.get());
   if (isolation_level_ == IsolationLevel::NON_TRANSACTIONAL) {
     auto now = shared_tablet->clock()->Now();
     return docdb::ResolveOperationConflicts(
@@ -455,6 +481,8 @@ Status WriteQuery::DoExecute() {
         transaction_participant, shared_tablet->metrics()->transaction_conflicts.get(),
         &prepare_result_.lock_batch, shared_tablet->wait_queue(),
         [this, now](const Result<HybridTime>& result) {
+          conflict_resolution_timer_.Stop();
+          ADOPT_CALL_ACCOUNTING(call_accounting_.get());
           if (!result.ok()) {
             ExecuteDone(result.status());
             TRACE("InvokeCallback");
@@ -493,6 +521,8 @@ Status WriteQuery::DoExecute() {
       transaction_participant, shared_tablet->metrics()->transaction_conflicts.get(),
       &prepare_result_.lock_batch, shared_tablet->wait_queue(),
       [this](const Result<HybridTime>& result) {
+        conflict_resolution_timer_.Stop();
+        ADOPT_CALL_ACCOUNTING(call_accounting_.get());
         if (!result.ok()) {
           ExecuteDone(result.status());
           TRACE("ExecuteDone");
@@ -611,6 +641,7 @@ Status WriteQuery::DoCompleteExecute() {
   }
 
   docdb_locks_ = std::move(prepare_result_.lock_batch);
+  operation_->set_holds_key_locks(!docdb_locks_.empty());
 
   return Status::OK();
 }
@@ -763,6 +794,11 @@ void WriteQuery::UpdateQLIndexes() {
   client::YBTransactionPtr txn;
   IndexOps index_ops;
   const ChildTransactionDataPB* child_transaction_data = nullptr;
+  // Rows of the batch usually update the same indexes, so each index table is resolved once per
+  // batch. All index writes are applied to the same session, so writes to the same index tablet
+  // are sent with a single RPC, and RPCs to different tablets are sent concurrently.
+  std::unordered_map<TableId, client::YBTablePtr> index_tables;
+  std::shared_ptr<client::YBMetaDataCache> metadata_cache;
   for (auto& doc_op : doc_ops_) {
     auto* write_op = down_cast<docdb::QLWriteOperation*>(doc_op.get());
     if (write_op->index_requests().empty()) {
@@ -797,22 +833,26 @@ void WriteQuery::UpdateQLIndexes() {
 
     // Apply the write ops to update the index
     for (auto& [index_info, index_request] : write_op->index_requests()) {
-      client::YBTablePtr index_table;
-      bool cache_used_ignored = false;
-      auto metadata_cache = shared_tablet->YBMetaDataCache();
-      if (!metadata_cache) {
-        StartSynchronization(
-            std::move(self_),
-            STATUS(Corruption, "Table metadata cache is not present for index update"));
-        return;
-      }
-      // TODO create async version of GetTable.
-      // It is ok to have sync call here, because we use cache and it should not take too long.
-      auto status = metadata_cache->GetTable(
-          index_info->table_id(), &index_table, &cache_used_ignored);
-      if (!status.ok()) {
-        StartSynchronization(std::move(self_), status);
-        return;
+      auto& index_table = index_tables[index_info->table_id()];
+      if (!index_table) {
+        if (!metadata_cache) {
+          metadata_cache = shared_tablet->YBMetaDataCache();
+        }
+        if (!metadata_cache) {
+          StartSynchronization(
+              std::move(self_),
+              STATUS(Corruption, "Table metadata cache is not present for index update"));
+          return;
+        }
+        bool cache_used_ignored = false;
+        // TODO create async version of GetTable.
+        // It is ok to have sync call here, because we use cache and it should not take too long.
+        auto status = metadata_cache->GetTable(
+            index_info->table_id(), &index_table, &cache_used_ignored);
+        if (!status.ok()) {
+          StartSynchronization(std::move(self_), status);
+          return;
+        }
       }
       std::shared_ptr<client::YBqlWriteOp> index_op(index_table->NewQLWrite());
       index_op->mutable_request()->Swap(&index_request);
@@ -24,6 +24,7 @@
 
 #include "yb/tserver/tserver.fwd.h"
 
+#include "yb/util/call_accounting.h"
 #include "yb/util/operation_counter.h"
 
 namespace yb {
@@ -212,6 +213,10 @@ class WriteQuery {
   // this transaction's start time
   CoarseTimePoint start_time_;
 
+  // Accounting of the call that issued this query, if it was sampled.
+  scoped_refptr<CallAccounting> call_accounting_;
+  CallPhaseTimer conflict_resolution_timer_;
+
   HybridTime restart_read_ht_;
 
   docdb::DocOperations doc_ops_;
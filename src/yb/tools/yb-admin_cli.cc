@@ -742,6 +742,21 @@ void ClusterAdminCli::RegisterCommandHandlers(ClusterAdminClientClass* client) {
         return Status::OK();
       });
 
+  Register(
+      "get_tablet_hot_keys", " <ts_uuid> <tablet_id> [<limit>]",
+      [client](const CLIArguments& args) -> Status {
+        if (args.size() != 2 && args.size() != 3) {
+          return ClusterAdminCli::kInvalidArguments;
+        }
+        uint32_t limit = 0;
+        if (args.size() == 3) {
+          limit = VERIFY_RESULT(CheckedStoi(args[2]));
+        }
+        RETURN_NOT_OK_PREPEND(client->GetTabletHotKeys(args[0], args[1], limit),
+                              "Unable to get tablet hot keys");
+        return Status::OK();
+      });
+
   Register(
       "set_load_balancer_enabled", " (0|1)",
       [client](const CLIArguments& args) -> Status {
@@ -1498,6 +1498,34 @@ Status ClusterAdminClient::ListTabletsForTabletServer(const PeerId& ts_uuid) {
   return Status::OK();
 }
 
+Status ClusterAdminClient::GetTabletHotKeys(
+    const PeerId& ts_uuid, const TabletId& tablet_id, uint32_t limit) {
+  auto ts_addr = VERIFY_RESULT(GetFirstRpcAddressForTS(ts_uuid));
+
+  TabletServerServiceProxy ts_proxy(proxy_cache_.get(), ts_addr);
+
+  tserver::GetTabletHotKeysRequestPB req;
+  req.set_tablet_id(tablet_id);
+  req.set_limit(limit);
+  const auto resp = VERIFY_RESULT(InvokeRpc(
+      &TabletServerServiceProxy::GetTabletHotKeys, ts_proxy, req));
+
+  cout << "Operation" << kColumnSep
+       << "Count" << kColumnSep
+       << "Error" << kColumnSep
+       << "Key" << endl;
+  for (const auto* keys : {&resp.read_keys(), &resp.write_keys()}) {
+    const char* operation = keys == &resp.read_keys() ? "read" : "write";
+    for (const auto& entry : *keys) {
+      cout << operation << kColumnSep
+           << entry.count() << kColumnSep
+           << entry.error() << kColumnSep
+           << Slice(entry.key()).ToDebugHexString() << endl;
+    }
+  }
+  return Status::OK();
+}
+
 Status ClusterAdminClient::SetLoadBalancerEnabled(bool is_enabled) {
   const auto list_resp = VERIFY_RESULT(InvokeRpc(
       &master::MasterClusterProxy::ListMasters, *master_cluster_proxy_,
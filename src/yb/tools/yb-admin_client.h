@@ -205,6 +205,9 @@ class ClusterAdminClient {
   // List all the tablets a certain tablet server is serving
   Status ListTabletsForTabletServer(const PeerId& ts_uuid);
 
+  // List the most frequently read and written keys of the tablet replica on the tablet server
+  Status GetTabletHotKeys(const PeerId& ts_uuid, const TabletId& tablet_id, uint32_t limit);
+
   Status SetLoadBalancerEnabled(bool is_enabled);
 
   Status GetLoadBalancerState();
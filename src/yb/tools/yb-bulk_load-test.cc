@@ -406,6 +406,9 @@ class YBBulkLoadTestWithoutRebalancing : public YBBulkLoadTest {
     FLAGS_enable_load_balancing = false;
     YBBulkLoadTest::SetUp();
   }
+
+ protected:
+  void TestCLITool(const std::vector<std::string>& extra_bulk_load_args);
 };
 
 
@@ -514,7 +517,8 @@ TEST_F(YBBulkLoadTest, InvalidLines) {
   ASSERT_NOK(partition_generator_->LookupTabletId("123,123.2", &tablet_id, &partition_key));
 }
 
-TEST_F_EX(YBBulkLoadTest, TestCLITool, YBBulkLoadTestWithoutRebalancing) {
+void YBBulkLoadTestWithoutRebalancing::TestCLITool(
+    const std::vector<std::string>& extra_bulk_load_args) {
   string exe_path = GetToolPath(kPartitionToolName);
   vector<string> argv = {kPartitionToolName, "-master_addresses", master_addresses_comma_separated_,
       "-table_name", kTableName, "-namespace_name", kNamespace};
@@ -590,6 +594,8 @@ TEST_F_EX(YBBulkLoadTest, TestCLITool, YBBulkLoadTestWithoutRebalancing) {
       "-flush_batch_for_tests",
       "-never_fsync", "true"
   };
+  bulk_load_argv.insert(
+      bulk_load_argv.end(), extra_bulk_load_args.begin(), extra_bulk_load_args.end());
 
   std::unique_ptr<Subprocess> bulk_load_process;
   ASSERT_OK(StartProcessAndGetStreams(bulk_load_exec, bulk_load_argv, &out, &in,
@@ -712,5 +718,13 @@ TEST_F_EX(YBBulkLoadTest, TestCLITool, YBBulkLoadTestWithoutRebalancing) {
   }
 }
 
+TEST_F_EX(YBBulkLoadTest, TestCLITool, YBBulkLoadTestWithoutRebalancing) {
+  TestCLITool({});
+}
+
+TEST_F_EX(YBBulkLoadTest, TestCLIToolPackedRow, YBBulkLoadTestWithoutRebalancing) {
+  TestCLITool({"-ycql_enable_packed_row", "true"});
+}
+
 } // namespace tools
 } // namespace yb
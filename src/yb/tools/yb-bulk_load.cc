@@ -270,6 +270,8 @@ Status BulkLoadTask::InsertRow(const string &row,
   QLWriteRequestPB req;
   req.set_type(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT);
   req.set_client(YQL_CLIENT_CQL);
+  // Used to find schema packing, when rows are written in packed format.
+  req.set_schema_version(schema_version);
 
   int col_id = 0;
   auto it = tokenizer.begin();
@@ -0,0 +1,341 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+// Replays Write and Read RPCs captured by tablet server with rpc_trace_capture_file against a test
+// cluster, preserving their relative timing scaled by rate_scale. RPCs are sent to the leaders of
+// the captured tablet ids, so the cluster should have the same tablets, e.g. be restored from
+// a snapshot of the captured one.
+//
+// Requests are replayed outside of their original transactions and read times, so transactional
+// operations are replayed as single shard ones.
+
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <glog/logging.h>
+
+#include "yb/client/client.h"
+
+#include "yb/common/wire_protocol.h"
+
+#include "yb/gutil/strings/split.h"
+
+#include "yb/master/master_client.pb.h"
+
+#include "yb/rpc/rpc_controller.h"
+
+#include "yb/tserver/tserver.pb.h"
+#include "yb/tserver/tserver_service.proxy.h"
+
+#include "yb/util/env.h"
+#include "yb/util/flags.h"
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/logging.h"
+#include "yb/util/pb_util.h"
+#include "yb/util/result.h"
+#include "yb/util/status_log.h"
+
+DEFINE_string(master_addresses, "localhost",
+              "Comma separated list of master addresses of the cluster to replay against.");
+DEFINE_string(trace_file, "", "File captured by tablet server with rpc_trace_capture_file.");
+DEFINE_double(rate_scale, 1.0,
+              "Speed of the replay relative to the capture. For instance, capture sampled with "
+              "rpc_trace_capture_sample_one_in_n=100 is replayed at the original rate of RPCs "
+              "with rate_scale=100.");
+DEFINE_int32(max_inflight_rpcs, 128,
+             "Max number of concurrent RPCs, replay falls behind the schedule when reached.");
+DEFINE_int64(rpc_timeout_ms, 10000, "Timeout of replayed RPCs.");
+DEFINE_bool(replay_writes, true, "Whether to replay captured Write RPCs.");
+DEFINE_bool(replay_reads, true, "Whether to replay captured Read RPCs.");
+
+namespace yb {
+namespace tools {
+
+namespace {
+
+// Latency is tracked with microsecond precision up to 1 minute.
+constexpr uint64_t kMaxLatencyUs = 60000000;
+
+void PrepareForReplay(tserver::WriteRequestPB* req) {
+  req->clear_propagated_hybrid_time();
+  req->clear_read_time();
+  req->clear_include_trace();
+  // Retryable request ids of the captured client would make replayed writes duplicates.
+  req->clear_client_id1();
+  req->clear_client_id2();
+  req->clear_request_id();
+  req->clear_min_running_request_id();
+  if (req->has_write_batch()) {
+    req->mutable_write_batch()->clear_transaction();
+    req->mutable_write_batch()->clear_subtransaction();
+  }
+  for (auto& pgsql_req : *req->mutable_pgsql_write_batch()) {
+    pgsql_req.clear_ysql_catalog_version();
+    pgsql_req.clear_ysql_db_catalog_version();
+  }
+}
+
+void PrepareForReplay(tserver::ReadRequestPB* req) {
+  req->clear_propagated_hybrid_time();
+  req->clear_read_time();
+  req->clear_include_trace();
+  req->clear_transaction();
+  req->clear_subtransaction();
+  for (auto& pgsql_req : *req->mutable_pgsql_batch()) {
+    pgsql_req.clear_ysql_catalog_version();
+    pgsql_req.clear_ysql_db_catalog_version();
+  }
+}
+
+bool IsLeaderChange(const tserver::TabletServerErrorPB& error) {
+  switch (error.code()) {
+    case tserver::TabletServerErrorPB::NOT_THE_LEADER: FALLTHROUGH_INTENDED;
+    case tserver::TabletServerErrorPB::LEADER_NOT_READY_TO_SERVE: FALLTHROUGH_INTENDED;
+    case tserver::TabletServerErrorPB::TABLET_NOT_FOUND: FALLTHROUGH_INTENDED;
+    case tserver::TabletServerErrorPB::TABLET_NOT_RUNNING:
+      return true;
+    default:
+      return false;
+  }
+}
+
+struct ReplayStats {
+  ReplayStats() : latency(kMaxLatencyUs, 2) {}
+
+  std::atomic<uint64_t> succeeded{0};
+  std::atomic<uint64_t> failed{0};
+  HdrHistogram latency;
+};
+
+} // namespace
+
+class RpcReplayer {
+ public:
+  explicit RpcReplayer(client::YBClient* client) : client_(*client) {}
+
+  Status Run(const std::string& path);
+
+ private:
+  struct Call {
+    bool is_write = false;
+    TabletId tablet_id;
+    tserver::WriteRequestPB write_req;
+    tserver::WriteResponsePB write_resp;
+    tserver::ReadRequestPB read_req;
+    tserver::ReadResponsePB read_resp;
+    rpc::RpcController controller;
+    MonoTime start;
+  };
+
+  Result<std::shared_ptr<tserver::TabletServerServiceProxy>> LeaderProxy(
+      const TabletId& tablet_id);
+
+  Status Send(tserver::RpcTraceEntryPB* entry);
+
+  void Finished(Call* call);
+
+  void PrintStats(const char* name, const ReplayStats& stats);
+
+  client::YBClient& client_;
+  std::unordered_map<TabletId, std::shared_ptr<tserver::TabletServerServiceProxy>> leaders_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  int inflight_ = 0;
+  std::unordered_set<TabletId> stale_leaders_;
+
+  ReplayStats write_stats_;
+  ReplayStats read_stats_;
+};
+
+Result<std::shared_ptr<tserver::TabletServerServiceProxy>> RpcReplayer::LeaderProxy(
+    const TabletId& tablet_id) {
+  bool stale;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stale = stale_leaders_.erase(tablet_id) != 0;
+  }
+  auto it = leaders_.find(tablet_id);
+  if (it != leaders_.end() && !stale) {
+    return it->second;
+  }
+
+  master::TabletLocationsPB locations;
+  RETURN_NOT_OK(client_.GetTabletLocation(tablet_id, &locations));
+  for (const auto& replica : locations.replicas()) {
+    if (replica.role() != PeerRole::LEADER || replica.ts_info().private_rpc_addresses().empty()) {
+      continue;
+    }
+    auto proxy = std::make_shared<tserver::TabletServerServiceProxy>(
+        &client_.proxy_cache(), HostPortFromPB(replica.ts_info().private_rpc_addresses(0)));
+    leaders_[tablet_id] = proxy;
+    return proxy;
+  }
+  return STATUS_FORMAT(NotFound, "No leader for tablet $0", tablet_id);
+}
+
+Status RpcReplayer::Send(tserver::RpcTraceEntryPB* entry) {
+  auto call = std::make_unique<Call>();
+  call->is_write = entry->has_write();
+  if (call->is_write) {
+    call->write_req.Swap(entry->mutable_write());
+    PrepareForReplay(&call->write_req);
+    call->tablet_id = call->write_req.tablet_id();
+  } else {
+    call->read_req.Swap(entry->mutable_read());
+    PrepareForReplay(&call->read_req);
+    call->tablet_id = call->read_req.tablet_id();
+  }
+  auto proxy = LeaderProxy(call->tablet_id);
+  auto& stats = call->is_write ? write_stats_ : read_stats_;
+  if (!proxy.ok()) {
+    YB_LOG_EVERY_N_SECS(WARNING, 5) << "Failed to find leader: " << proxy.status();
+    ++stats.failed;
+    return Status::OK();
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return inflight_ < FLAGS_max_inflight_rpcs; });
+    ++inflight_;
+  }
+
+  call->controller.set_timeout(MonoDelta::FromMilliseconds(FLAGS_rpc_timeout_ms));
+  call->start = MonoTime::Now();
+  auto* raw_call = call.release();
+  auto callback = [this, raw_call] { Finished(raw_call); };
+  if (raw_call->is_write) {
+    (**proxy).WriteAsync(
+        raw_call->write_req, &raw_call->write_resp, &raw_call->controller, callback);
+  } else {
+    (**proxy).ReadAsync(
+        raw_call->read_req, &raw_call->read_resp, &raw_call->controller, callback);
+  }
+  return Status::OK();
+}
+
+void RpcReplayer::Finished(Call* call) {
+  std::unique_ptr<Call> holder(call);
+  auto& stats = call->is_write ? write_stats_ : read_stats_;
+  stats.latency.Increment((MonoTime::Now() - call->start).ToMicroseconds());
+  const auto* error = call->is_write
+      ? (call->write_resp.has_error() ? &call->write_resp.error() : nullptr)
+      : (call->read_resp.has_error() ? &call->read_resp.error() : nullptr);
+  if (call->controller.status().ok() && !error) {
+    ++stats.succeeded;
+  } else {
+    ++stats.failed;
+    YB_LOG_EVERY_N_SECS(WARNING, 5)
+        << "RPC to " << call->tablet_id << " failed: "
+        << (error ? StatusFromPB(error->status()) : call->controller.status());
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!call->controller.status().ok() || (error && IsLeaderChange(*error))) {
+    stale_leaders_.insert(call->tablet_id);
+  }
+  --inflight_;
+  cond_.notify_one();
+}
+
+Status RpcReplayer::Run(const std::string& path) {
+  std::unique_ptr<RandomAccessFile> file;
+  RETURN_NOT_OK(Env::Default()->NewRandomAccessFile(path, &file));
+  ReadablePBContainerFile container(std::move(file));
+  RETURN_NOT_OK(container.Init());
+
+  auto start = MonoTime::Now();
+  MonoDelta max_lag = MonoDelta::kZero;
+  uint64_t captured_rpcs = 0;
+  uint64_t last_offset_us = 0;
+  for (;;) {
+    tserver::RpcTraceEntryPB entry;
+    auto status = container.ReadNextPB(&entry);
+    if (status.IsEndOfFile()) {
+      break;
+    }
+    RETURN_NOT_OK(status);
+    if (entry.has_write() ? !FLAGS_replay_writes : !FLAGS_replay_reads) {
+      continue;
+    }
+    captured_rpcs += std::max<uint32_t>(entry.sample_one_in_n(), 1);
+    last_offset_us = entry.offset_us();
+    auto scheduled = start + MonoDelta::FromMicroseconds(entry.offset_us() / FLAGS_rate_scale);
+    auto now = MonoTime::Now();
+    if (now < scheduled) {
+      SleepFor(scheduled - now);
+    } else {
+      max_lag = std::max(max_lag, now - scheduled);
+    }
+    RETURN_NOT_OK(Send(&entry));
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return inflight_ == 0; });
+  }
+  RETURN_NOT_OK(container.Close());
+
+  std::cout << "Replayed " << MonoTime::Now() - start << ", captured "
+            << MonoDelta::FromMicroseconds(last_offset_us) << " with about " << captured_rpcs
+            << " RPCs, max lag behind schedule " << max_lag << std::endl;
+  PrintStats("write", write_stats_);
+  PrintStats("read", read_stats_);
+  return Status::OK();
+}
+
+void RpcReplayer::PrintStats(const char* name, const ReplayStats& stats) {
+  if (stats.succeeded + stats.failed == 0) {
+    return;
+  }
+  std::cout << name << ": succeeded " << stats.succeeded << ", failed " << stats.failed
+            << ", latency us p50 " << stats.latency.ValueAtPercentile(50)
+            << ", p99 " << stats.latency.ValueAtPercentile(99)
+            << ", p99.9 " << stats.latency.ValueAtPercentile(99.9)
+            << ", max " << stats.latency.MaxValue() << std::endl;
+}
+
+static int ReplayMain(int argc, char** argv) {
+  ParseCommandLineFlags(&argc, &argv, true);
+  InitGoogleLoggingSafe(argv[0]);
+  if (FLAGS_trace_file.empty() || FLAGS_rate_scale <= 0) {
+    std::cerr << "usage: " << argv[0] << " --master_addresses <addresses> --trace_file <path> "
+              << "[--rate_scale <scale>]" << std::endl;
+    return 1;
+  }
+
+  std::vector<std::string> addrs = strings::Split(FLAGS_master_addresses, ",");
+  auto client = client::YBClientBuilder().master_server_addrs(addrs).Build();
+  if (!client.ok()) {
+    std::cerr << "Failed to connect to cluster: " << client.status() << std::endl;
+    return 1;
+  }
+
+  RpcReplayer replayer(client->get());
+  auto status = replayer.Run(FLAGS_trace_file);
+  if (!status.ok()) {
+    std::cerr << "Replay failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace tools
+}  // namespace yb
+
+int main(int argc, char** argv) {
+  return yb::tools::ReplayMain(argc, argv);
+}
@@ -74,7 +74,7 @@ class MockYsckTabletServer : public YsckTabletServer {
       const Schema& schema,
       const ChecksumOptions& options,
       const ReportResultCallback& callback) override {
-    callback.Run(Status::OK(), 0);
+    callback.Run(Status::OK(), 0, 0);
   }
 
   Status CurrentHybridTime(uint64_t* hybrid_time) const override {
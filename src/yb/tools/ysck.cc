@@ -32,7 +32,9 @@
 
 #include "yb/tools/ysck.h"
 
+#include <algorithm>
 #include <mutex>
+#include <optional>
 #include <unordered_set>
 
 #include <glog/logging.h>
@@ -41,12 +43,16 @@
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/ref_counted.h"
 #include "yb/gutil/strings/join.h"
+#include "yb/gutil/strings/split.h"
 #include "yb/gutil/strings/substitute.h"
 
 #include "yb/util/blocking_queue.h"
 #include "yb/util/countdown_latch.h"
+#include "yb/util/env.h"
+#include "yb/util/faststring.h"
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
+#include "yb/util/result.h"
 
 namespace yb {
 namespace tools {
@@ -63,10 +69,14 @@ DEFINE_int32(checksum_timeout_sec, 120,
              "before timing out.");
 DEFINE_int32(checksum_scan_concurrency, 4,
              "Number of concurrent checksum scans to execute per tablet server.");
+DEFINE_string(checksum_progress_file, "",
+              "File with ids of the already verified tablets. Such tablets are skipped by the "
+              "checksum scan, and tablets verified by the scan are added to the file.");
 
 ChecksumOptions::ChecksumOptions()
     : timeout(MonoDelta::FromSeconds(FLAGS_checksum_timeout_sec)),
-      scan_concurrency(FLAGS_checksum_scan_concurrency) {}
+      scan_concurrency(FLAGS_checksum_scan_concurrency),
+      progress_file(FLAGS_checksum_progress_file) {}
 
 ChecksumOptions::ChecksumOptions(MonoDelta timeout, int scan_concurrency)
     : timeout(std::move(timeout)),
@@ -197,6 +207,15 @@ class ChecksumResultReporter : public RefCountedThreadSafe<ChecksumResultReporte
   typedef std::unordered_map<std::string, TableResults> ReplicaResultMap;
   typedef std::unordered_map<std::string, ReplicaResultMap> TabletResultMap;
 
+  // Amount of data checksummed by a tablet server.
+  struct ServerStats {
+    uint64_t scanned_bytes = 0;
+    size_t num_replicas = 0;
+    // Time of the last reported result.
+    MonoTime last_report;
+  };
+  typedef std::unordered_map<std::string, ServerStats> ServerStatsMap;
+
   // Initialize reporter with the number of replicas being queried.
   explicit ChecksumResultReporter(int num_tablet_replicas)
       : responses_(num_tablet_replicas) {
@@ -206,8 +225,13 @@ class ChecksumResultReporter : public RefCountedThreadSafe<ChecksumResultReporte
   void ReportResult(const std::string& tablet_id,
                     const std::string& replica_uuid,
                     const Status& status,
-                    uint64_t checksum) {
+                    uint64_t checksum,
+                    uint64_t scanned_bytes) {
     std::lock_guard<simple_spinlock> guard(lock_);
+    ServerStats& stats = server_stats_[replica_uuid];
+    stats.scanned_bytes += scanned_bytes;
+    ++stats.num_replicas;
+    stats.last_report = MonoTime::Now();
     unordered_map<string, TableResults>& replica_results =
         LookupOrInsert(&checksums_, tablet_id, unordered_map<string, TableResults>());
     if (replica_results.find(replica_uuid) == replica_results.end()) {
@@ -235,6 +259,11 @@ class ChecksumResultReporter : public RefCountedThreadSafe<ChecksumResultReporte
     return checksums_;
   }
 
+  ServerStatsMap server_stats() const {
+    std::lock_guard<simple_spinlock> guard(lock_);
+    return server_stats_;
+  }
+
  private:
   friend class RefCountedThreadSafe<ChecksumResultReporter>;
   ~ChecksumResultReporter() {}
@@ -244,9 +273,11 @@ class ChecksumResultReporter : public RefCountedThreadSafe<ChecksumResultReporte
                       const Status& status, uint64_t checksum);
 
   CountDownLatch responses_;
-  mutable simple_spinlock lock_; // Protects 'checksums_'.
+  mutable simple_spinlock lock_; // Protects 'checksums_' and 'server_stats_'.
   // checksums_ is an unordered_map of { tablet_id : { replica_uuid : checksum } }.
   TabletResultMap checksums_;
+  // server_stats_ is an unordered_map of { replica_uuid : stats }.
+  ServerStatsMap server_stats_;
 };
 
 // Queue of tablet replicas for an individual tablet server.
@@ -262,8 +293,9 @@ void TabletServerChecksumCallback(
     const TabletId& tablet_id,
     const ChecksumOptions& options,
     const Status& status,
-    uint64_t checksum) {
-  reporter->ReportResult(tablet_id, tablet_server->uuid(), status, checksum);
+    uint64_t checksum,
+    uint64_t scanned_bytes) {
+  reporter->ReportResult(tablet_id, tablet_server->uuid(), status, checksum, scanned_bytes);
 
   std::pair<Schema, TabletId> table_tablet;
   if (queue->BlockingGet(&table_tablet)) {
@@ -279,6 +311,41 @@ void TabletServerChecksumCallback(
   }
 }
 
+// Reads ids of the tablets, that were verified by previous checksum scans.
+Result<std::unordered_set<TabletId>> LoadVerifiedTablets(const std::string& progress_file) {
+  std::unordered_set<TabletId> result;
+  if (progress_file.empty() || !Env::Default()->FileExists(progress_file)) {
+    return result;
+  }
+  faststring content;
+  RETURN_NOT_OK(ReadFileToString(Env::Default(), progress_file, &content));
+  const std::string text = content.ToString();
+  for (const auto& tablet_id : strings::Split(text, "\n", strings::SkipWhitespace())) {
+    result.insert(tablet_id.ToString());
+  }
+  return result;
+}
+
+// Appends ids of the tablets, that were verified by the current checksum scan, to the progress
+// file.
+Status SaveVerifiedTablets(
+    const std::string& progress_file, const std::unordered_set<TabletId>& previously_verified,
+    const std::vector<TabletId>& verified) {
+  if (progress_file.empty() || verified.empty()) {
+    return Status::OK();
+  }
+  std::string content;
+  for (const auto& tablet_id : previously_verified) {
+    content += tablet_id;
+    content += '\n';
+  }
+  for (const auto& tablet_id : verified) {
+    content += tablet_id;
+    content += '\n';
+  }
+  return WriteStringToFileSync(Env::Default(), content, progress_file);
+}
+
 Status Ysck::ChecksumData(const vector<string>& tables,
                           const vector<string>& tablets,
                           const ChecksumOptions& opts) {
@@ -288,6 +355,9 @@ Status Ysck::ChecksumData(const vector<string>& tables,
   // Copy options so that local modifications can be made and passed on.
   ChecksumOptions options = opts;
 
+  const auto previously_verified = VERIFY_RESULT(LoadVerifiedTablets(options.progress_file));
+  std::unordered_set<TabletId> skipped_tablets;
+
   using TabletTableMap = std::unordered_map<
       std::shared_ptr<YsckTablet>, std::vector<std::shared_ptr<YsckTable>>>;
   TabletTableMap tablet_table_map;
@@ -312,6 +382,10 @@ Status Ysck::ChecksumData(const vector<string>& tables,
     for (const shared_ptr<YsckTablet>& tablet : table->tablets()) {
       VLOG(1) << "Tablet: " << tablet->id();
       if (!tablets_filter.empty() && !ContainsKey(tablets_filter, tablet->id())) continue;
+      if (ContainsKey(previously_verified, tablet->id())) {
+        skipped_tablets.insert(tablet->id());
+        continue;
+      }
       if (tablet_table_map.find(tablet) == tablet_table_map.end()) {
         tablet_table_map[tablet] = std::vector<shared_ptr<YsckTable>>(1, table);
       } else {
@@ -320,8 +394,12 @@ Status Ysck::ChecksumData(const vector<string>& tables,
       num_tablet_replicas += tablet->replicas().size();
     }
   }
+  if (!skipped_tablets.empty()) {
+    LOG(INFO) << Substitute("Skipping $0 tablets verified by previous checksum scans",
+                            skipped_tablets.size());
+  }
   // Number of tablet replicas can be zero if there are no user tables available.
-  if (there_are_non_system_tables && num_tablet_replicas == 0) {
+  if (there_are_non_system_tables && num_tablet_replicas == 0 && skipped_tablets.empty()) {
     string msg = "No tablet replicas found.";
     if (!tables.empty() || !tablets.empty()) {
       msg += " Filter: ";
@@ -356,6 +434,8 @@ Status Ysck::ChecksumData(const vector<string>& tables,
     }
   }
 
+  const MonoTime start = MonoTime::Now();
+
   // Kick off checksum scans in parallel. For each tablet server, we start
   // scan_concurrency scans. Each callback then initiates one additional
   // scan when it returns if the queue for that TS is not empty.
@@ -385,6 +465,45 @@ Status Ysck::ChecksumData(const vector<string>& tables,
   }
   ChecksumResultReporter::TabletResultMap checksums = reporter->checksums();
 
+  for (const auto& entry : reporter->server_stats()) {
+    const auto& stats = entry.second;
+    shared_ptr<YsckTabletServer> ts = FindOrDie(cluster_->tablet_servers(), entry.first);
+    const double seconds = std::max(stats.last_report.GetDeltaSince(start).ToSeconds(), 1e-3);
+    LOG(INFO) << Substitute("P $0 ($1): checksummed $2 replicas, $3 bytes, $4 bytes/sec",
+                            ts->uuid(), ts->address(), stats.num_replicas, stats.scanned_bytes,
+                            static_cast<uint64_t>(stats.scanned_bytes / seconds));
+  }
+
+  // Tablet is verified when results for all of its replicas were received, and all of them have
+  // the same checksum.
+  std::vector<TabletId> verified_tablets;
+  for (const TabletTableMap::value_type& entry : tablet_table_map) {
+    const shared_ptr<YsckTablet>& tablet = entry.first;
+    auto it = checksums.find(tablet->id());
+    if (it == checksums.end()) {
+      continue;
+    }
+    bool verified = it->second.size() == tablet->replicas().size();
+    std::optional<uint64_t> first_checksum;
+    for (const auto& replica_results : it->second) {
+      if (!verified) {
+        break;
+      }
+      verified = replica_results.second.size() == entry.second.size();
+      for (const ChecksumResultReporter::ResultPair& result : replica_results.second) {
+        if (!result.first.ok() || (first_checksum && *first_checksum != result.second)) {
+          verified = false;
+          break;
+        }
+        first_checksum = result.second;
+      }
+    }
+    if (verified) {
+      verified_tablets.push_back(tablet->id());
+    }
+  }
+  RETURN_NOT_OK(SaveVerifiedTablets(options.progress_file, previously_verified, verified_tablets));
+
   int num_errors = 0;
   int num_mismatches = 0;
   int num_results = 0;
@@ -65,6 +65,11 @@ struct ChecksumOptions {
 
   // The maximum number of concurrent checksum scans to run per tablet server.
   int scan_concurrency;
+
+  // File with ids of the tablets, whose checksums were already verified, one per line.
+  // Such tablets are skipped, and tablets verified by this scan are added to the file, so an
+  // interrupted scan of a large cluster could be resumed. Empty means progress is not tracked.
+  std::string progress_file;
 };
 
 // Representation of a tablet replica on a tablet server.
@@ -175,7 +180,8 @@ class YsckTable {
   DISALLOW_COPY_AND_ASSIGN(YsckTable);
 };
 
-typedef Callback<void(const Status& status, uint64_t checksum)> ReportResultCallback;
+typedef Callback<void(const Status& status, uint64_t checksum, uint64_t scanned_bytes)>
+    ReportResultCallback;
 
 // The following two classes must be extended in order to communicate with their respective
 // components. The two main use cases envisioned for this are:
@@ -30,6 +30,8 @@
 // under the License.
 //
 
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 #include "yb/client/client.h"
@@ -46,7 +48,10 @@
 #include "yb/tools/data_gen_util.h"
 #include "yb/tools/ysck_remote.h"
 
+#include "yb/util/env.h"
+#include "yb/util/faststring.h"
 #include "yb/util/monotime.h"
+#include "yb/util/path_util.h"
 #include "yb/util/promise.h"
 #include "yb/util/random.h"
 #include "yb/util/status_log.h"
@@ -234,6 +239,30 @@ TEST_F(RemoteYsckTest, TestChecksum) {
   ASSERT_OK(s);
 }
 
+TEST_F(RemoteYsckTest, TestChecksumProgressFile) {
+  ASSERT_OK(GenerateRowWrites(100));
+
+  ChecksumOptions options(MonoDelta::FromSeconds(10), 16);
+  options.progress_file = JoinPathSegments(GetTestDataDirectory(), "checksum_progress");
+  ASSERT_OK(WaitFor([this, &options]() -> Result<bool> {
+    RETURN_NOT_OK(ysck_->FetchTableAndTabletInfo());
+    return ysck_->ChecksumData(vector<string>(), vector<string>(), options).ok();
+  }, 30s, "Checksum scan"));
+
+  faststring content;
+  ASSERT_OK(ReadFileToString(env_.get(), options.progress_file, &content));
+  // Each of the table tablets is recorded as verified.
+  const auto verified_tablets = content.ToString();
+  ASSERT_EQ(std::count(verified_tablets.begin(), verified_tablets.end(), '\n'), 3)
+      << verified_tablets;
+
+  // All tablets were verified, so the resumed scan has nothing to do.
+  ASSERT_OK(ysck_->ChecksumData(vector<string>(), vector<string>(), options));
+  faststring resumed_content;
+  ASSERT_OK(ReadFileToString(env_.get(), options.progress_file, &resumed_content));
+  ASSERT_EQ(verified_tablets, resumed_content.ToString());
+}
+
 TEST_F(RemoteYsckTest, TestChecksumTimeout) {
   uint64_t num_writes = 10000;
   LOG(INFO) << "Generating row writes...";
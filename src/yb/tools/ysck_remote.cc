@@ -157,13 +157,13 @@ class ChecksumStepper {
       s = StatusFromPB(resp_.error().status());
     }
     if (!s.ok()) {
-      reporter_callback_.Run(s, 0);
+      reporter_callback_.Run(s, 0, 0);
       return; // Deletes 'this'.
     }
 
     DCHECK(resp_.has_checksum());
 
-    reporter_callback_.Run(s, resp_.checksum());
+    reporter_callback_.Run(s, resp_.checksum(), resp_.scanned_bytes());
   }
 
  private:
@@ -15,7 +15,9 @@
 
 #include "yb/tserver/full_compaction_manager.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "yb/common/hybrid_time.h"
 
@@ -50,24 +52,115 @@ DEFINE_RUNTIME_int32(scheduled_full_compaction_jitter_factor_percentage,
               "computed when scheduling a compaction, between 0 and (frequency * jitter factor) "
               "hours.");
 
+DEFINE_RUNTIME_int32(scheduled_full_compaction_obsolete_data_percentage, 0,
+              "Schedule full compaction on tablets whose estimated percentage of obsolete data, "
+              "i.e. tombstones, overwritten versions and entries with expired TTL below history "
+              "cutoff, reaches this value, regardless of "
+              "scheduled_full_compaction_frequency_hours. The estimate is collected to SST file "
+              "properties by flushes and compactions. 0 indicates the feature is disabled.");
+
+DEFINE_RUNTIME_int32(scheduled_full_compaction_obsolete_data_min_interval_secs, 3600,
+              "Minimal time since the last full compaction of the tablet, before a full compaction "
+              "is scheduled on it because of obsolete data. Protects from repeated compactions "
+              "when obsolete data could not be removed, e.g. delete markers retained for "
+              "xCluster.");
+
+DEFINE_RUNTIME_int32(scheduled_full_compaction_min_obsolete_data_percentage, 0,
+              "Full compactions scheduled by scheduled_full_compaction_frequency_hours are "
+              "skipped on tablets whose estimated percentage of obsolete data is below this value, "
+              "so cold tablets are not rewritten without gain.");
+
+DEFINE_RUNTIME_int32(post_split_compaction_max_in_flight, 2,
+              "Max number of post-split compactions queued or running on the tablet server at "
+              "once. Tablets with the largest estimated size of data left from their parent are "
+              "compacted first, the next one is scheduled when a compaction finishes. "
+              "0 to compact each tablet as soon as it is opened after split.");
+
+DECLARE_bool(TEST_skip_post_split_compaction);
+DECLARE_int32(timestamp_history_retention_interval_sec);
+
 namespace yb {
 namespace tserver {
 
 using tablet::TabletPeerPtr;
 
+namespace {
+
+// Approximate history cutoff, that is used to decide which obsolete data could be removed.
+HybridTime HistoryCutoff(HybridTime now) {
+  return now.AddSeconds(-ANNOTATE_UNPROTECTED_READ(
+      FLAGS_timestamp_history_retention_interval_sec));
+}
+
+} // namespace
+
 FullCompactionManager::FullCompactionManager(TSTabletManager* ts_tablet_manager)
     : ts_tablet_manager_(ts_tablet_manager) {
   SetFrequencyAndJitterFromFlags();
 }
 
 void FullCompactionManager::ScheduleFullCompactions() {
+  SchedulePostSplitCompactions();
   SetFrequencyAndJitterFromFlags();
   DoScheduleFullCompactions();
 }
 
+void FullCompactionManager::TriggerPostSplitCompactionIfNeeded(tablet::Tablet* tablet) {
+  if (GetAtomicFlag(&FLAGS_post_split_compaction_max_in_flight) <= 0) {
+    tablet->TriggerPostSplitCompactionIfNeeded();
+    return;
+  }
+  SchedulePostSplitCompactions();
+}
+
+void FullCompactionManager::SchedulePostSplitCompactions() {
+  const auto max_in_flight = GetAtomicFlag(&FLAGS_post_split_compaction_max_in_flight);
+  if (max_in_flight <= 0 || PREDICT_FALSE(FLAGS_TEST_skip_post_split_compaction)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(post_split_mutex_);
+  int in_flight = 0;
+  std::vector<std::pair<uint64_t, tablet::TabletPtr>> candidates;
+  for (const auto& peer : ts_tablet_manager_->GetTabletPeers()) {
+    auto tablet = peer->shared_tablet();
+    if (!tablet) {
+      continue;
+    }
+    auto has_orphaned_data = tablet->StillHasOrphanedPostSplitData();
+    if (!has_orphaned_data.ok() || !*has_orphaned_data) {
+      continue;
+    }
+    if (tablet->HasActiveFullCompaction()) {
+      ++in_flight;
+      continue;
+    }
+    candidates.emplace_back(tablet->GetOrphanedPostSplitSstFilesSize(), std::move(tablet));
+  }
+  if (in_flight >= max_in_flight || candidates.empty()) {
+    return;
+  }
+
+  std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first > rhs.first;
+  });
+  for (const auto& [orphaned_size, tablet] : candidates) {
+    if (in_flight >= max_in_flight) {
+      break;
+    }
+    VLOG(1) << "Scheduling post-split compaction of tablet " << tablet->tablet_id()
+            << ", orphaned data size: " << orphaned_size;
+    tablet->TriggerPostSplitCompactionIfNeeded();
+    if (tablet->HasActiveFullCompaction()) {
+      ++in_flight;
+    }
+  }
+}
+
 void FullCompactionManager::DoScheduleFullCompactions() {
-  // If compaction_frequency_ is 0, feature is disabled.
-  if (compaction_frequency_ == MonoDelta::kZero) {
+  // If compaction_frequency_ is 0 and obsolete data compactions are off, feature is disabled.
+  if (compaction_frequency_ == MonoDelta::kZero &&
+      GetAtomicFlag(&FLAGS_scheduled_full_compaction_obsolete_data_percentage) <= 0) {
     num_scheduled_last_execution_.store(0);
     return;
   }
@@ -76,7 +169,7 @@ void FullCompactionManager::DoScheduleFullCompactions() {
   PeerNextCompactList peers_to_compact = GetPeersEligibleForCompaction();
 
   for (auto itr = peers_to_compact.begin(); itr != peers_to_compact.end(); itr++) {
-    const auto peer = itr->second;
+    const auto peer = itr->second.peer;
     const auto tablet = peer->shared_tablet();
     if (!tablet) {
       LOG(WARNING) << "Unable to schedule full compaction on tablet " << peer->tablet_id()
@@ -84,7 +177,8 @@ void FullCompactionManager::DoScheduleFullCompactions() {
       continue;
     }
     Status s = tablet->TriggerFullCompactionIfNeeded(
-        tablet::FullCompactionReason::Scheduled);
+        itr->second.obsolete_data ? tablet::FullCompactionReason::ObsoleteData
+                                  : tablet::FullCompactionReason::Scheduled);
     if (s.ok()) {
       // Remove tablet from compaction times on successful schedule.
       next_compact_time_per_tablet_.erase(peer->tablet_id());
@@ -110,18 +204,59 @@ PeerNextCompactList FullCompactionManager::GetPeersEligibleForCompaction() {
       continue;
     }
 
+    if (ShouldCompactObsoleteData(peer, *tablet, now)) {
+      compact_list.emplace(
+          HybridTime(peer->tablet_metadata()->last_full_compaction_time()),
+          PeerToCompact { .peer = peer, .obsolete_data = true });
+      continue;
+    }
+
+    if (compaction_frequency_ == MonoDelta::kZero) {
+      continue;
+    }
+
     // If the next compaction time is pre-calculated, use that. Otherwise, calculate
     // a new one.
     const HybridTime next_compact_time = DetermineNextCompactTime(peer, now);
 
     // If the tablet is ready to compact, then add it to the list.
-    if (next_compact_time <= now) {
-      compact_list.insert(std::make_pair(next_compact_time, peer));
+    if (next_compact_time > now) {
+      continue;
+    }
+    const auto min_obsolete_data_percentage =
+        GetAtomicFlag(&FLAGS_scheduled_full_compaction_min_obsolete_data_percentage);
+    if (min_obsolete_data_percentage > 0 &&
+        tablet->ObsoleteDataPercentage(HistoryCutoff(now)) < min_obsolete_data_percentage) {
+      VLOG(2) << "Skip scheduled full compaction of tablet " << tablet_id
+              << ": not enough obsolete data";
+      continue;
     }
+    compact_list.emplace(next_compact_time, PeerToCompact { .peer = peer });
   }
   return compact_list;
 }
 
+bool FullCompactionManager::ShouldCompactObsoleteData(
+    const TabletPeerPtr& peer, const tablet::Tablet& tablet, HybridTime now) const {
+  const auto obsolete_data_percentage =
+      GetAtomicFlag(&FLAGS_scheduled_full_compaction_obsolete_data_percentage);
+  if (obsolete_data_percentage <= 0) {
+    return false;
+  }
+  const HybridTime last_compact_time(peer->tablet_metadata()->last_full_compaction_time());
+  const auto min_interval = MonoDelta::FromSeconds(
+      GetAtomicFlag(&FLAGS_scheduled_full_compaction_obsolete_data_min_interval_secs));
+  if (!last_compact_time.is_special() && now < last_compact_time.AddDelta(min_interval)) {
+    return false;
+  }
+  const auto percentage = tablet.ObsoleteDataPercentage(HistoryCutoff(now));
+  if (percentage < obsolete_data_percentage) {
+    return false;
+  }
+  VLOG(1) << "Tablet " << peer->tablet_id() << " has " << percentage << "% of obsolete data";
+  return true;
+}
+
 void FullCompactionManager::SetFrequencyAndJitterFromFlags() {
   const auto compaction_frequency = MonoDelta::FromHours(
       ANNOTATE_UNPROTECTED_READ(FLAGS_scheduled_full_compaction_frequency_hours));
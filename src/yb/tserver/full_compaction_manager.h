@@ -17,6 +17,7 @@
 #define YB_TSERVER_FULL_COMPACTION_MANAGER_H
 
 #include <map>
+#include <mutex>
 #include <unordered_map>
 
 #include "yb/common/common_fwd.h"
@@ -32,7 +33,13 @@
 namespace yb {
 namespace tserver {
 
-typedef std::multimap<HybridTime, tablet::TabletPeerPtr> PeerNextCompactList;
+struct PeerToCompact {
+  tablet::TabletPeerPtr peer;
+  // Compaction is scheduled because of obsolete data, instead of the compaction frequency.
+  bool obsolete_data = false;
+};
+
+typedef std::multimap<HybridTime, PeerToCompact> PeerNextCompactList;
 
 class FullCompactionManager {
  public:
@@ -42,6 +49,17 @@ class FullCompactionManager {
   // since the last runs, and resets to those values if so. Then, runs DoScheduleFullCompactions().
   void ScheduleFullCompactions();
 
+  // Triggers post-split compaction of the just opened tablet, if it still has data of its parent.
+  // The compaction is scheduled by SchedulePostSplitCompactions, unless
+  // post_split_compaction_max_in_flight is 0.
+  void TriggerPostSplitCompactionIfNeeded(tablet::Tablet* tablet);
+
+  // Schedules full compactions of tablets, that still share SST files with their parent after
+  // split. Tablets with the largest estimated size of data outside of their key bounds are
+  // compacted first, and at most post_split_compaction_max_in_flight compactions are queued or
+  // running at once, so a wave of splits does not turn into a wave of full compactions.
+  void SchedulePostSplitCompactions();
+
   MonoDelta compaction_frequency() const { return compaction_frequency_; }
 
   MonoDelta max_jitter() const { return max_jitter_; }
@@ -79,8 +97,14 @@ class FullCompactionManager {
   // Iterates through all peers, determining the next compaction time for each peer
   // eligible for scheduled full compactions. Returns a list of peers that are currently
   // ready for compaction, ordered by how recently they were last compacted (oldest first).
+  // Peers whose estimated obsolete data reaches
+  // scheduled_full_compaction_obsolete_data_percentage are ready regardless of the frequency.
   PeerNextCompactList GetPeersEligibleForCompaction();
 
+  // Checks whether the tablet should be compacted because of its estimated obsolete data.
+  bool ShouldCompactObsoleteData(
+      const tablet::TabletPeerPtr& peer, const tablet::Tablet& tablet, HybridTime now) const;
+
   // Returns the next compaction time for a given tablet peer. Next compaction time will
   // be from the in-memory map of next compaction times (next_compact_time_per_tablet_)
   // if able. If one is not available, then a new next compaction time will be calculated
@@ -127,6 +151,9 @@ class FullCompactionManager {
   // In-memory map of pre-calculated next compaction times per tablet.
   std::unordered_map<TabletId, HybridTime> next_compact_time_per_tablet_;
 
+  // Serializes SchedulePostSplitCompactions, that is invoked from compaction threads.
+  std::mutex post_split_mutex_;
+
   // Number of compactions that were scheduled during the previous execution.
   // -1 indicates that there is no information about the previous execution.
   std::atomic<int> num_scheduled_last_execution_ = -1;
@@ -15,6 +15,7 @@
 
 #include <mutex>
 #include <queue>
+#include <unordered_map>
 
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
@@ -32,17 +33,26 @@
 #include "yb/common/pg_types.h"
 #include "yb/common/wire_protocol.h"
 
+#include "yb/gutil/casts.h"
+
 #include "yb/master/master_admin.proxy.h"
 
+#include "yb/rpc/constants.h"
+#include "yb/rpc/lightweight_message.h"
 #include "yb/rpc/rpc_context.h"
 #include "yb/rpc/rpc_controller.h"
+#include "yb/rpc/rpc_header.pb.h"
 #include "yb/rpc/scheduler.h"
+#include "yb/rpc/serialization.h"
 
 #include "yb/tserver/pg_client_session.h"
 #include "yb/tserver/pg_create_table.h"
+#include "yb/tserver/pg_response_cache.h"
+#include "yb/tserver/pg_sequence_cache.h"
 #include "yb/tserver/pg_table_cache.h"
 #include "yb/tserver/tablet_server_interface.h"
 #include "yb/tserver/tserver_service.pb.h"
+#include "yb/tserver/tserver_shared_mem.h"
 
 #include "yb/util/net/net_util.h"
 #include "yb/util/result.h"
@@ -50,12 +60,23 @@
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 #include "yb/util/status.h"
+#include "yb/util/thread.h"
 
 using namespace std::literals;
 
 DEFINE_uint64(pg_client_session_expiration_ms, 60000,
               "Pg client session expiration time in milliseconds.");
 
+DEFINE_uint64(pg_client_database_info_cache_ttl_ms, 10000,
+              "Time in milliseconds for which database info, requested by new YSQL connections, "
+              "is cached by the tablet server. 0 disables the cache.");
+
+DEFINE_uint64(pg_client_table_size_cache_ttl_ms, 10000,
+              "Time in milliseconds for which table size and row count estimates, requested by "
+              "the YSQL planner, are cached by the tablet server. 0 disables the cache.");
+
+DECLARE_uint64(rpc_max_message_size);
+
 namespace yb {
 namespace tserver {
 
@@ -107,6 +128,47 @@ using LockablePgClientSession = Lockable<PgClientSession>;
 using PgClientSessionLocker = Locker<PgClientSession>;
 using LockablePgClientSessionPtr = std::shared_ptr<LockablePgClientSession>;
 
+// Serves requests, received through shared memory exchange of a single session.
+class SharedExchangeThread {
+ public:
+  using Handler = std::function<void(const SharedExchangeRequest&, SharedExchange*)>;
+
+  SharedExchangeThread(std::unique_ptr<SharedExchange> exchange, Handler handler)
+      : exchange_(std::move(exchange)), handler_(std::move(handler)) {
+  }
+
+  ~SharedExchangeThread() {
+    exchange_->SignalStop();
+    if (thread_) {
+      WARN_NOT_OK(ThreadJoiner(thread_.get()).Join(), "Failed to join shared exchange thread");
+    }
+  }
+
+  Status Start(uint64_t session_id) {
+    return Thread::Create(
+        "pg_client", Format("shared_exchange_$0", session_id), &SharedExchangeThread::Execute,
+        this, &thread_);
+  }
+
+ private:
+  void Execute() {
+    for (;;) {
+      auto request = exchange_->ReceiveRequest();
+      if (!request.ok()) {
+        if (!request.status().IsShutdownInProgress()) {
+          LOG(WARNING) << "Failed to receive shared exchange request: " << request.status();
+        }
+        return;
+      }
+      handler_(*request, exchange_.get());
+    }
+  }
+
+  std::unique_ptr<SharedExchange> exchange_;
+  Handler handler_;
+  scoped_refptr<Thread> thread_;
+};
+
 } // namespace
 
 template <class T>
@@ -176,12 +238,15 @@ class PgClientServiceImpl::Impl {
         transaction_pool_provider_(std::move(transaction_pool_provider)),
         table_cache_(client_future),
         check_expired_sessions_(scheduler),
+        scheduler_(*scheduler),
         xcluster_safe_time_map_(xcluster_safe_time_map) {
     ScheduleCheckExpiredSessions(CoarseMonoClock::now());
   }
 
   ~Impl() {
     check_expired_sessions_.Shutdown();
+    std::lock_guard<std::mutex> lock(exchange_threads_mutex_);
+    exchange_threads_.clear();
   }
 
   Status Heartbeat(
@@ -193,13 +258,21 @@ class PgClientServiceImpl::Impl {
     auto session_id = ++session_serial_no_;
     auto session = std::make_shared<LockablePgClientSession>(
         session_id, &client(), clock_, transaction_pool_provider_, &table_cache_,
-        xcluster_safe_time_map_);
+        &sequence_cache_, xcluster_safe_time_map_);
     resp->set_session_id(session_id);
 
-    std::lock_guard<rw_spinlock> lock(mutex_);
-    auto it = sessions_.emplace(
-        FLAGS_pg_client_session_expiration_ms * 1ms, std::move(session)).first;
-    session_expiration_queue_.push({it->expiration(), session_id});
+    {
+      std::lock_guard<rw_spinlock> lock(mutex_);
+      auto it = sessions_.emplace(
+          FLAGS_pg_client_session_expiration_ms * 1ms, std::move(session)).first;
+      session_expiration_queue_.push({it->expiration(), session_id});
+    }
+
+    // Exchange is started only after the session is registered, so the first request received
+    // through it finds the session.
+    if (req.pid()) {
+      resp->set_shared_exchange_started(StartSharedExchange(session_id, req));
+    }
     return Status::OK();
   }
 
@@ -219,10 +292,30 @@ class PgClientServiceImpl::Impl {
   Status GetDatabaseInfo(
       const PgGetDatabaseInfoRequestPB& req, PgGetDatabaseInfoResponsePB* resp,
       rpc::RpcContext* context) {
+    // Every new connection requests info of its database, so it is cached to avoid a master RPC
+    // per connection. Info of the database with specified oid could change only when it is
+    // dropped and recreated, so short staleness is acceptable.
+    const auto ttl = FLAGS_pg_client_database_info_cache_ttl_ms * 1ms;
+    if (ttl > 0ms) {
+      std::lock_guard<std::mutex> lock(database_info_mutex_);
+      auto it = database_info_cache_.find(req.oid());
+      if (it != database_info_cache_.end() && it->second.expiration > CoarseMonoClock::now()) {
+        *resp->mutable_info() = it->second.info;
+        return Status::OK();
+      }
+    }
+
     RETURN_NOT_OK(client().GetNamespaceInfo(
         GetPgsqlNamespaceId(req.oid()), "" /* namespace_name */, YQL_DATABASE_PGSQL,
         resp->mutable_info()));
 
+    if (ttl > 0ms) {
+      std::lock_guard<std::mutex> lock(database_info_mutex_);
+      database_info_cache_[req.oid()] = DatabaseInfoEntry {
+        .expiration = CoarseMonoClock::now() + ttl,
+        .info = resp->info(),
+      };
+    }
     return Status::OK();
   }
 
@@ -342,17 +435,43 @@ class PgClientServiceImpl::Impl {
   Status GetTableDiskSize(
       const PgGetTableDiskSizeRequestPB& req, PgGetTableDiskSizeResponsePB* resp,
       rpc::RpcContext* context) {
-    auto result =
-        client().GetTableDiskSize(PgObjectId::GetYbTableIdFromPB(req.table_id()));
+    auto table_id = PgObjectId::GetYbTableIdFromPB(req.table_id());
+    // Planner requests estimates of each YSQL table it plans a query for, while master updates
+    // them only on tserver heartbeats. So such requests are served from the cache.
+    const auto ttl = req.use_cache() ? FLAGS_pg_client_table_size_cache_ttl_ms * 1ms : 0ms;
+    if (ttl > 0ms) {
+      std::lock_guard<std::mutex> lock(table_size_mutex_);
+      auto it = table_size_cache_.find(table_id);
+      if (it != table_size_cache_.end() && it->second.expiration > CoarseMonoClock::now()) {
+        FillTableSize(it->second.info, resp);
+        return Status::OK();
+      }
+    }
+
+    auto result = client().GetTableDiskSize(table_id);
     if (!result.ok()) {
       StatusToPB(result.status(), resp->mutable_status());
-    } else {
-      resp->set_size(result->table_size);
-      resp->set_num_missing_tablets(result->num_missing_tablets);
+      return Status::OK();
+    }
+    FillTableSize(*result, resp);
+
+    if (ttl > 0ms) {
+      std::lock_guard<std::mutex> lock(table_size_mutex_);
+      table_size_cache_[table_id] = TableSizeEntry {
+        .expiration = CoarseMonoClock::now() + ttl,
+        .info = *result,
+      };
     }
     return Status::OK();
   }
 
+  static void FillTableSize(
+      const client::TableSizeInfo& info, PgGetTableDiskSizeResponsePB* resp) {
+    resp->set_size(info.table_size);
+    resp->set_num_missing_tablets(info.num_missing_tablets);
+    resp->set_estimated_num_rows(info.estimated_num_rows);
+  }
+
   Status CheckIfPitrActive(
       const PgCheckIfPitrActiveRequestPB& req, PgCheckIfPitrActiveResponsePB* resp,
       rpc::RpcContext* context) {
@@ -447,30 +566,219 @@ class PgClientServiceImpl::Impl {
 
   void CheckExpiredSessions() {
     auto now = CoarseMonoClock::now();
-    std::lock_guard<rw_spinlock> lock(mutex_);
-    while (!session_expiration_queue_.empty()) {
-      auto& top = session_expiration_queue_.top();
-      if (top.first > now) {
-        break;
+    std::vector<uint64_t> expired_sessions;
+    {
+      std::lock_guard<rw_spinlock> lock(mutex_);
+      while (!session_expiration_queue_.empty()) {
+        auto& top = session_expiration_queue_.top();
+        if (top.first > now) {
+          break;
+        }
+        auto id = top.second;
+        session_expiration_queue_.pop();
+        auto it = sessions_.find(id);
+        if (it != sessions_.end()) {
+          auto current_expiration = it->expiration();
+          if (current_expiration > now) {
+            session_expiration_queue_.push({current_expiration, id});
+          } else {
+            sessions_.erase(it);
+            expired_sessions.push_back(id);
+          }
+        }
       }
-      auto id = top.second;
-      session_expiration_queue_.pop();
-      auto it = sessions_.find(id);
-      if (it != sessions_.end()) {
-        auto current_expiration = it->expiration();
-        if (current_expiration > now) {
-          session_expiration_queue_.push({current_expiration, id});
-        } else {
-          sessions_.erase(it);
+      ScheduleCheckExpiredSessions(now);
+    }
+    StopSharedExchanges(expired_sessions);
+  }
+
+  bool StartSharedExchange(uint64_t session_id, const PgHeartbeatRequestPB& req) {
+    auto exchange = SharedExchange::Open(
+        req.pid(), req.shared_exchange_fd(), req.shared_exchange_buffer_size(),
+        FLAGS_rpc_max_message_size);
+    if (!exchange.ok()) {
+      LOG(WARNING) << "Failed to open shared exchange of session " << session_id << ": "
+                   << exchange.status();
+      return false;
+    }
+    auto thread = std::make_unique<SharedExchangeThread>(
+        std::move(*exchange),
+        [this, session_id](const SharedExchangeRequest& request, SharedExchange* exchange) {
+      PerformShared(session_id, request, exchange);
+    });
+    auto status = thread->Start(session_id);
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to start shared exchange thread of session " << session_id << ": "
+                   << status;
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(exchange_threads_mutex_);
+    exchange_threads_.emplace(session_id, std::move(thread));
+    return true;
+  }
+
+  void StopSharedExchanges(const std::vector<uint64_t>& session_ids) {
+    std::vector<std::unique_ptr<SharedExchangeThread>> threads;
+    {
+      std::lock_guard<std::mutex> lock(exchange_threads_mutex_);
+      for (auto id : session_ids) {
+        auto it = exchange_threads_.find(id);
+        if (it != exchange_threads_.end()) {
+          threads.push_back(std::move(it->second));
+          exchange_threads_.erase(it);
         }
       }
     }
-    ScheduleCheckExpiredSessions(now);
+    // Threads are joined on destruction, so it is done without holding the mutex.
+  }
+
+  void PerformShared(
+      uint64_t session_id, const SharedExchangeRequest& request, SharedExchange* exchange) {
+    PgPerformRequestPB req;
+    PgPerformResponsePB resp;
+    std::vector<rpc::SidecarHolder> sidecars;
+    auto status = DoPerformShared(session_id, request, &req, &resp, &sidecars);
+    if (!status.ok()) {
+      StatusToPB(status, resp.mutable_status());
+      sidecars.clear();
+    }
+    status = RespondShared(resp, sidecars, request.deadline, exchange);
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to respond through shared exchange of session " << session_id
+                   << ": " << status;
+    }
+  }
+
+  Status DoPerformShared(
+      uint64_t session_id, const SharedExchangeRequest& request, PgPerformRequestPB* req,
+      PgPerformResponsePB* resp, std::vector<rpc::SidecarHolder>* sidecars) {
+    auto data = request.data.AsSlice();
+    if (!req->ParseFromArray(data.data(), narrow_cast<int>(data.size()))) {
+      return STATUS(InvalidArgument, "Failed to parse perform request from shared exchange");
+    }
+    if (req->session_id() != session_id) {
+      return STATUS_FORMAT(
+          InvalidArgument, "Perform request of session $0 received through exchange of $1",
+          req->session_id(), session_id);
+    }
+    auto session = VERIFY_RESULT(DoGetSession(session_id));
+    PgResponseCache::Entry entry;
+    auto cache_key = PgResponseCache::Key(*req);
+    if (cache_key) {
+      // Exchange thread serves only one request of its session and does not hold any locks, so
+      // it just waits for the same request performed by another caller.
+      std::promise<PgResponseCache::Entry> entry_promise;
+      response_cache_.Get(*cache_key, [&entry_promise](PgResponseCache::Entry cache_entry) {
+        entry_promise.set_value(std::move(cache_entry));
+      });
+      entry = entry_promise.get_future().get();
+      if (entry.response) {
+        *resp = entry.response->response;
+        *sidecars = entry.response->sidecars;
+        return Status::OK();
+      }
+    }
+    // Perform completes asynchronously, but exchange serves only one request at a time, so the
+    // thread just waits for it.
+    std::promise<void> promise;
+    RETURN_NOT_OK(PgClientSessionLocker(session)->Perform(
+        *req, resp, request.deadline,
+        [&promise, resp, sidecars, &entry](std::vector<rpc::SidecarHolder>* response_sidecars) {
+      if (entry.setter) {
+        entry.setter(*resp, *response_sidecars);
+      }
+      *sidecars = std::move(*response_sidecars);
+      promise.set_value();
+    }));
+    promise.get_future().wait();
+    return Status::OK();
+  }
+
+  // Response is formatted as the RPC call response, so the client parses it the same way as the
+  // response received through RPC. Sidecars are copied directly to shared memory.
+  Status RespondShared(
+      const PgPerformResponsePB& resp, const std::vector<rpc::SidecarHolder>& sidecars,
+      CoarseTimePoint deadline, SharedExchange* exchange) {
+    auto body_size = resp.ByteSizeLong();
+    rpc::ResponseHeader header;
+    header.set_call_id(0);
+    size_t sidecars_size = 0;
+    for (const auto& sidecar : sidecars) {
+      header.add_sidecar_offsets(narrow_cast<uint32_t>(body_size + sidecars_size));
+      sidecars_size += sidecar.second.size();
+    }
+    auto buffer = VERIFY_RESULT(rpc::SerializeRequest(
+        body_size, sidecars_size, header, rpc::AnyMessageConstPtr(&resp)));
+    std::vector<Slice> parts;
+    parts.reserve(sidecars.size() + 1);
+    parts.push_back(buffer.AsSlice().WithoutPrefix(rpc::kMsgLengthPrefixLength));
+    for (const auto& sidecar : sidecars) {
+      parts.push_back(sidecar.second);
+    }
+    return exchange->Respond(parts, deadline);
   }
 
   Status DoPerform(
       const PgPerformRequestPB& req, PgPerformResponsePB* resp, rpc::RpcContext* context) {
-    return VERIFY_RESULT(GetSession(req))->Perform(req, resp, context);
+    auto session = VERIFY_RESULT(DoGetSession(req.session_id()));
+    auto cache_key = PgResponseCache::Key(req);
+    if (!cache_key) {
+      return PgClientSessionLocker(session)->Perform(req, resp, context);
+    }
+    // Context is moved, because the response could be sent after the same request, performed by
+    // another caller, completes.
+    auto shared_context = std::make_shared<rpc::RpcContext>(std::move(*context));
+    response_cache_.Get(
+        *cache_key,
+        [scheduler = &scheduler_, session, &req, resp, shared_context](
+            PgResponseCache::Entry entry) {
+      if (entry.response) {
+        *resp = entry.response->response;
+        for (const auto& sidecar : entry.response->sidecars) {
+          shared_context->AddRpcSidecar(sidecar.second);
+        }
+        shared_context->RespondSuccess();
+        return;
+      }
+      if (entry.setter) {
+        PerformAndRespond(session, req, resp, shared_context, std::move(entry.setter));
+        return;
+      }
+      // The same request performed by another caller failed. Waiters are notified on the thread
+      // that completed it, which could hold the lock of its session, so the request is performed
+      // on the scheduler.
+      scheduler->Schedule(
+          [session, &req, resp, shared_context](const Status& status) {
+        if (!status.ok()) {
+          Respond(status, resp, shared_context.get());
+          return;
+        }
+        PerformAndRespond(session, req, resp, shared_context, /* setter= */ nullptr);
+      }, 0s);
+    });
+    return Status::OK();
+  }
+
+  static void PerformAndRespond(
+      const LockablePgClientSessionPtr& session, const PgPerformRequestPB& req,
+      PgPerformResponsePB* resp, const std::shared_ptr<rpc::RpcContext>& context,
+      PgResponseCache::Setter setter) {
+    // Sidecars are collected by the responder, so the response could be stored in the cache.
+    auto status = PgClientSessionLocker(session)->Perform(
+        req, resp, context->GetClientDeadline(),
+        [context, resp, setter = std::move(setter)](std::vector<rpc::SidecarHolder>* sidecars) {
+      if (setter) {
+        setter(*resp, *sidecars);
+      }
+      for (const auto& sidecar : *sidecars) {
+        context->AddRpcSidecar(sidecar.second);
+      }
+      context->RespondSuccess();
+    });
+    // Context was moved, so failure should be responded here.
+    if (!status.ok()) {
+      Respond(status, resp, context.get());
+    }
   }
 
   const TabletServerIf& tablet_server_;
@@ -478,6 +786,26 @@ class PgClientServiceImpl::Impl {
   scoped_refptr<ClockBase> clock_;
   TransactionPoolProvider transaction_pool_provider_;
   PgTableCache table_cache_;
+  PgResponseCache response_cache_;
+  PgSequenceCache sequence_cache_;
+
+  struct DatabaseInfoEntry {
+    CoarseTimePoint expiration;
+    master::GetNamespaceInfoResponsePB info;
+  };
+
+  std::mutex database_info_mutex_;
+  std::unordered_map<uint32_t, DatabaseInfoEntry> database_info_cache_
+      GUARDED_BY(database_info_mutex_);
+
+  struct TableSizeEntry {
+    CoarseTimePoint expiration;
+    client::TableSizeInfo info;
+  };
+
+  std::mutex table_size_mutex_;
+  std::unordered_map<TableId, TableSizeEntry> table_size_cache_ GUARDED_BY(table_size_mutex_);
+
   rw_spinlock mutex_;
 
   class ExpirationTag;
@@ -509,8 +837,13 @@ class PgClientServiceImpl::Impl {
   std::atomic<int64_t> session_serial_no_{0};
 
   rpc::ScheduledTaskTracker check_expired_sessions_;
+  rpc::Scheduler& scheduler_;
 
   const XClusterSafeTimeMap* xcluster_safe_time_map_;
+
+  std::mutex exchange_threads_mutex_;
+  std::unordered_map<uint64_t, std::unique_ptr<SharedExchangeThread>> exchange_threads_
+      GUARDED_BY(exchange_threads_mutex_);
 };
 
 PgClientServiceImpl::PgClientServiceImpl(
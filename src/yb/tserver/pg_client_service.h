@@ -42,6 +42,7 @@ namespace tserver {
     (DropDatabase) \
     (DropTable) \
     (DropTablegroup) \
+    (FetchSequenceTuple) \
     (FinishTransaction) \
     (GetCatalogMasterVersion) \
     (GetDatabaseInfo) \
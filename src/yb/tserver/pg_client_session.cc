@@ -13,6 +13,7 @@
 
 #include "yb/tserver/pg_client_session.h"
 
+#include <limits>
 #include <mutex>
 
 #include "yb/client/batcher.h"
@@ -36,11 +37,13 @@
 
 #include "yb/tserver/pg_client.pb.h"
 #include "yb/tserver/pg_create_table.h"
+#include "yb/tserver/pg_sequence_cache.h"
 #include "yb/tserver/pg_table_cache.h"
 #include "yb/tserver/xcluster_safe_time_map.h"
 
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/result.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status_format.h"
@@ -51,6 +54,11 @@
 
 using std::string;
 
+DEFINE_RUNTIME_uint32(ysql_sequence_cache_lease_multiplier, 10,
+    "The node leases this many caches of sequence values at once from the sequence row, and hands "
+    "them out to local backends one cache at a time. Sequences with cache 1 are not leased, so "
+    "their values are ordered across the nodes.");
+
 DECLARE_bool(ysql_serializable_isolation_for_ddl_txn);
 
 namespace yb {
@@ -305,6 +313,9 @@ struct PerformData {
   PgClientSessionOperations ops;
   PgTableCache* table_cache;
   PgClientSession::UsedReadTimePtr used_read_time;
+  // Set instead of context for requests received through shared memory exchange.
+  PgPerformSharedResponder shared_responder;
+  std::vector<rpc::SidecarHolder> sidecars;
 
   void FlushDone(client::FlushStatus* flush_status) {
     auto status = CombineErrorsToStatus(flush_status->errors, flush_status->status);
@@ -314,7 +325,27 @@ struct PerformData {
     if (!status.ok()) {
       StatusToPB(status, resp->mutable_status());
     }
-    context.RespondSuccess();
+    if (shared_responder) {
+      shared_responder(&sidecars);
+    } else {
+      context.RespondSuccess();
+    }
+  }
+
+  size_t AddSidecar(const client::YBPgsqlOp& op) {
+    if (!shared_responder) {
+      return context.AddRpcSidecar(op.rows_data());
+    }
+    // Rows data is passed to the shared memory exchange directly, so it should be kept alive by
+    // its holder.
+    auto holder = op.rows_data_holder();
+    auto data = op.rows_data();
+    if (!holder) {
+      holder = RefCntBuffer(data);
+      data = holder.AsSlice();
+    }
+    sidecars.emplace_back(std::move(holder), data);
+    return sidecars.size() - 1;
   }
 
   Status ProcessResponse() {
@@ -342,7 +373,7 @@ struct PerformData {
       auto& op_resp = *responses.Add();
       op_resp.Swap(op->mutable_response());
       if (op_resp.has_rows_data_sidecar()) {
-        op_resp.set_rows_data_sidecar(narrow_cast<int>(context.AddRpcSidecar(op->rows_data())));
+        op_resp.set_rows_data_sidecar(narrow_cast<int>(AddSidecar(*op)));
       }
     }
 
@@ -363,12 +394,14 @@ client::YBSessionPtr CreateSession(
 PgClientSession::PgClientSession(
     uint64_t id, client::YBClient* client, const scoped_refptr<ClockBase>& clock,
     std::reference_wrapper<const TransactionPoolProvider> transaction_pool_provider,
-    PgTableCache* table_cache, const XClusterSafeTimeMap* xcluster_safe_time_map)
+    PgTableCache* table_cache, PgSequenceCache* sequence_cache,
+    const XClusterSafeTimeMap* xcluster_safe_time_map)
     : id_(id),
       client_(*client),
       clock_(clock),
       transaction_pool_provider_(transaction_pool_provider.get()),
       table_cache_(*table_cache),
+      sequence_cache_(*sequence_cache),
       xcluster_safe_time_map_(xcluster_safe_time_map) {}
 
 uint64_t PgClientSession::id() const {
@@ -686,6 +719,28 @@ Status PgClientSession::Perform(
   return Status::OK();
 }
 
+Status PgClientSession::Perform(
+    const PgPerformRequestPB& req, PgPerformResponsePB* resp, CoarseTimePoint deadline,
+    PgPerformSharedResponder responder) {
+  auto session_info = VERIFY_RESULT(SetupSession(req, deadline));
+  auto* session = session_info.first;
+  auto ops = VERIFY_RESULT(PrepareOperations(req, session, &table_cache_));
+  auto data = std::make_shared<PerformData>(PerformData {
+    .session_id = id_,
+    .req = &req,
+    .resp = resp,
+    .context = {},
+    .ops = std::move(ops),
+    .table_cache = &table_cache_,
+    .used_read_time = session_info.second,
+    .shared_responder = std::move(responder),
+  });
+  session->FlushAsync([data](client::FlushStatus* flush_status) {
+    data->FlushDone(flush_status);
+  });
+  return Status::OK();
+}
+
 void PgClientSession::ProcessReadTimeManipulation(ReadTimeManipulation manipulation) {
   switch (manipulation) {
     case ReadTimeManipulation::RESET: {
@@ -978,46 +1033,64 @@ Status PgClientSession::InsertSequenceTuple(
   auto& session = EnsureSession(PgClientSessionKind::kSequence);
   session->SetDeadline(context->GetClientDeadline());
   // TODO(async_flush): https://github.com/yugabyte/yugabyte-db/issues/12173
-  return session->TEST_ApplyAndFlush(std::move(psql_write));
+  RETURN_NOT_OK(session->TEST_ApplyAndFlush(std::move(psql_write)));
+  sequence_cache_.Invalidate(req.db_oid(), req.seq_oid());
+  return Status::OK();
 }
 
 Status PgClientSession::UpdateSequenceTuple(
     const PgUpdateSequenceTupleRequestPB& req, PgUpdateSequenceTupleResponsePB* resp,
     rpc::RpcContext* context) {
+  std::optional<std::pair<int64_t, bool>> expected;
+  if (req.has_expected()) {
+    expected.emplace(req.expected_last_val(), req.expected_is_called());
+  }
+  resp->set_skipped(VERIFY_RESULT(DoUpdateSequenceTuple(
+      req, req.last_val(), req.is_called(), expected, context->GetClientDeadline())));
+  if (!expected) {
+    // Row was set bypassing the node level cache, e.g. by setval or ALTER SEQUENCE.
+    sequence_cache_.Invalidate(req.db_oid(), req.seq_oid());
+  }
+  return Status::OK();
+}
+
+template <class Req>
+Result<bool> PgClientSession::DoUpdateSequenceTuple(
+    const Req& req, int64_t last_val, bool is_called,
+    const std::optional<std::pair<int64_t, bool>>& expected, CoarseTimePoint deadline) {
   PgObjectId table_oid(kPgSequencesDataDatabaseOid, kPgSequencesDataTableOid);
   auto table = VERIFY_RESULT(table_cache_.Get(table_oid.GetYbTableId()));
 
   std::shared_ptr<client::YBPgsqlWriteOp> psql_write(client::YBPgsqlWriteOp::NewUpdate(table));
 
   auto write_request = psql_write->mutable_request();
-  RETURN_NOT_OK(
-      (SetCatalogVersion<PgUpdateSequenceTupleRequestPB, PgsqlWriteRequestPB>(req, write_request)));
+  RETURN_NOT_OK((SetCatalogVersion<Req, PgsqlWriteRequestPB>(req, write_request)));
   write_request->add_partition_column_values()->mutable_value()->set_int64_value(req.db_oid());
   write_request->add_partition_column_values()->mutable_value()->set_int64_value(req.seq_oid());
 
   PgsqlColumnValuePB* column_value = write_request->add_column_new_values();
   column_value->set_column_id(table->schema().ColumnId(kPgSequenceLastValueColIdx));
-  column_value->mutable_expr()->mutable_value()->set_int64_value(req.last_val());
+  column_value->mutable_expr()->mutable_value()->set_int64_value(last_val);
 
   column_value = write_request->add_column_new_values();
   column_value->set_column_id(table->schema().ColumnId(kPgSequenceIsCalledColIdx));
-  column_value->mutable_expr()->mutable_value()->set_bool_value(req.is_called());
+  column_value->mutable_expr()->mutable_value()->set_bool_value(is_called);
 
   auto where_pb = write_request->mutable_where_expr()->mutable_condition();
 
-  if (req.has_expected()) {
+  if (expected) {
     // WHERE clause => WHERE last_val == expected_last_val AND is_called == expected_is_called.
     where_pb->set_op(QL_OP_AND);
 
     auto cond = where_pb->add_operands()->mutable_condition();
     cond->set_op(QL_OP_EQUAL);
     cond->add_operands()->set_column_id(table->schema().ColumnId(kPgSequenceLastValueColIdx));
-    cond->add_operands()->mutable_value()->set_int64_value(req.expected_last_val());
+    cond->add_operands()->mutable_value()->set_int64_value(expected->first);
 
     cond = where_pb->add_operands()->mutable_condition();
     cond->set_op(QL_OP_EQUAL);
     cond->add_operands()->set_column_id(table->schema().ColumnId(kPgSequenceIsCalledColIdx));
-    cond->add_operands()->mutable_value()->set_bool_value(req.expected_is_called());
+    cond->add_operands()->mutable_value()->set_bool_value(expected->second);
   } else {
     where_pb->set_op(QL_OP_EXISTS);
   }
@@ -1034,16 +1107,24 @@ Status PgClientSession::UpdateSequenceTuple(
       table->schema().ColumnId(kPgSequenceIsCalledColIdx));
 
   auto& session = EnsureSession(PgClientSessionKind::kSequence);
-  session->SetDeadline(context->GetClientDeadline());
+  session->SetDeadline(deadline);
   // TODO(async_flush): https://github.com/yugabyte/yugabyte-db/issues/12173
   RETURN_NOT_OK(session->TEST_ApplyAndFlush(psql_write));
-  resp->set_skipped(psql_write->response().skipped());
-  return Status::OK();
+  return psql_write->response().skipped();
 }
 
 Status PgClientSession::ReadSequenceTuple(
     const PgReadSequenceTupleRequestPB& req, PgReadSequenceTupleResponsePB* resp,
     rpc::RpcContext* context) {
+  auto tuple = VERIFY_RESULT(DoReadSequenceTuple(req, context->GetClientDeadline()));
+  resp->set_last_val(tuple.first);
+  resp->set_is_called(tuple.second);
+  return Status::OK();
+}
+
+template <class Req>
+Result<std::pair<int64_t, bool>> PgClientSession::DoReadSequenceTuple(
+    const Req& req, CoarseTimePoint deadline) {
   using pggate::PgDocData;
   using pggate::PgWireDataHeader;
 
@@ -1053,8 +1134,7 @@ Status PgClientSession::ReadSequenceTuple(
   std::shared_ptr<client::YBPgsqlReadOp> psql_read(client::YBPgsqlReadOp::NewSelect(table));
 
   auto read_request = psql_read->mutable_request();
-  RETURN_NOT_OK(
-      (SetCatalogVersion<PgReadSequenceTupleRequestPB, PgsqlReadRequestPB>(req, read_request)));
+  RETURN_NOT_OK((SetCatalogVersion<Req, PgsqlReadRequestPB>(req, read_request)));
   read_request->add_partition_column_values()->mutable_value()->set_int64_value(req.db_oid());
   read_request->add_partition_column_values()->mutable_value()->set_int64_value(req.seq_oid());
 
@@ -1075,7 +1155,7 @@ Status PgClientSession::ReadSequenceTuple(
       table->schema().ColumnId(kPgSequenceIsCalledColIdx));
 
   auto& session = EnsureSession(PgClientSessionKind::kSequence);
-  session->SetDeadline(context->GetClientDeadline());
+  session->SetDeadline(deadline);
   // TODO(async_flush): https://github.com/yugabyte/yugabyte-db/issues/12173
   RETURN_NOT_OK(session->TEST_ReadSync(psql_read));
 
@@ -1093,7 +1173,6 @@ Status PgClientSession::ReadSequenceTuple(
   int64_t last_val = 0;
   size_t read_size = PgDocData::ReadNumber(&cursor, &last_val);
   cursor.remove_prefix(read_size);
-  resp->set_last_val(last_val);
 
   header = PgDocData::ReadDataHeader(&cursor);
   if (header.is_null()) {
@@ -1101,7 +1180,46 @@ Status PgClientSession::ReadSequenceTuple(
   }
   bool is_called = false;
   read_size = PgDocData::ReadNumber(&cursor, &is_called);
-  resp->set_is_called(is_called);
+  return std::make_pair(last_val, is_called);
+}
+
+Status PgClientSession::FetchSequenceTuple(
+    const PgFetchSequenceTupleRequestPB& req, PgFetchSequenceTupleResponsePB* resp,
+    rpc::RpcContext* context) {
+  const PgSequenceParams params {
+    .increment = req.inc_by(),
+    .min_value = req.min_value(),
+    .max_value = req.max_value(),
+    .cycle = req.cycle(),
+  };
+  auto deadline = context->GetClientDeadline();
+  auto entry = sequence_cache_.Get(req.db_oid(), req.seq_oid());
+  std::lock_guard<std::mutex> lock(entry->mutex);
+  auto range = entry->Take(params, req.fetch_count());
+  if (!range) {
+    // Sequences with cache 1 are leased one value at a time, so the order of values matches the
+    // order of nextval calls across the nodes.
+    const int64_t multiplier = std::max<int64_t>(FLAGS_ysql_sequence_cache_lease_multiplier, 1);
+    const int64_t lease_count =
+        req.fetch_count() > 1 &&
+        req.fetch_count() <= std::numeric_limits<int64_t>::max() / multiplier
+            ? req.fetch_count() * multiplier : req.fetch_count();
+    for (;;) {
+      auto tuple = VERIFY_RESULT(DoReadSequenceTuple(req, deadline));
+      auto lease = VERIFY_RESULT(NextPgSequenceRange(
+          tuple.first, tuple.second, params, lease_count));
+      auto skipped = VERIFY_RESULT(DoUpdateSequenceTuple(
+          req, lease.last, /* is_called= */ true, tuple, deadline));
+      if (!skipped) {
+        VLOG_WITH_PREFIX(4) << "Leased " << lease.ToString() << " of sequence " << req.seq_oid();
+        entry->SetLease(params, lease);
+        break;
+      }
+    }
+    range = entry->Take(params, req.fetch_count());
+  }
+  resp->set_first_value(range->first);
+  resp->set_last_value(range->last);
   return Status::OK();
 }
 
@@ -1120,7 +1238,9 @@ Status PgClientSession::DeleteSequenceTuple(
   auto& session = EnsureSession(PgClientSessionKind::kSequence);
   session->SetDeadline(context->GetClientDeadline());
   // TODO(async_flush): https://github.com/yugabyte/yugabyte-db/issues/12173
-  return session->TEST_ApplyAndFlush(std::move(psql_delete));
+  RETURN_NOT_OK(session->TEST_ApplyAndFlush(std::move(psql_delete)));
+  sequence_cache_.Invalidate(req.db_oid(), req.seq_oid());
+  return Status::OK();
 }
 
 Status PgClientSession::DeleteDBSequences(
@@ -1146,7 +1266,9 @@ Status PgClientSession::DeleteDBSequences(
   auto& session = EnsureSession(PgClientSessionKind::kSequence);
   session->SetDeadline(context->GetClientDeadline());
   // TODO(async_flush): https://github.com/yugabyte/yugabyte-db/issues/12173
-  return session->TEST_ApplyAndFlush(std::move(psql_delete));
+  RETURN_NOT_OK(session->TEST_ApplyAndFlush(std::move(psql_delete)));
+  sequence_cache_.InvalidateDatabase(req.db_oid());
+  return Status::OK();
 }
 
 client::YBSessionPtr& PgClientSession::EnsureSession(PgClientSessionKind kind) {
@@ -18,6 +18,7 @@
 #include <array>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -61,6 +62,7 @@ namespace tserver {
     (DropDatabase) \
     (DropTable) \
     (DropTablegroup) \
+    (FetchSequenceTuple) \
     (FinishTransaction) \
     (InsertSequenceTuple) \
     (ReadSequenceTuple) \
@@ -74,6 +76,10 @@ using PgClientSessionOperations = std::vector<std::shared_ptr<client::YBPgsqlOp>
 
 YB_DEFINE_ENUM(PgClientSessionKind, (kPlain)(kDdl)(kCatalog)(kSequence));
 
+// Invoked when response to the perform request, received through shared memory exchange, is
+// ready. Sidecars referenced by the response are passed instead of being copied to RPC sidecars.
+using PgPerformSharedResponder = std::function<void(std::vector<rpc::SidecarHolder>* sidecars)>;
+
 class PgClientSession : public std::enable_shared_from_this<PgClientSession> {
  public:
   struct UsedReadTime {
@@ -87,13 +93,18 @@ class PgClientSession : public std::enable_shared_from_this<PgClientSession> {
       uint64_t id,
       client::YBClient* client, const scoped_refptr<ClockBase>& clock,
       std::reference_wrapper<const TransactionPoolProvider> transaction_pool_provider,
-      PgTableCache* table_cache, const XClusterSafeTimeMap* xcluster_safe_time_map);
+      PgTableCache* table_cache, PgSequenceCache* sequence_cache,
+      const XClusterSafeTimeMap* xcluster_safe_time_map);
 
   uint64_t id() const;
 
   Status Perform(
       const PgPerformRequestPB& req, PgPerformResponsePB* resp, rpc::RpcContext* context);
 
+  Status Perform(
+      const PgPerformRequestPB& req, PgPerformResponsePB* resp, CoarseTimePoint deadline,
+      PgPerformSharedResponder responder);
+
   #define PG_CLIENT_SESSION_METHOD_DECLARE(r, data, method) \
   Status method( \
       const BOOST_PP_CAT(BOOST_PP_CAT(Pg, method), RequestPB)& req, \
@@ -119,6 +130,16 @@ class PgClientSession : public std::enable_shared_from_this<PgClientSession> {
       PgPerformResponsePB* resp, rpc::RpcContext* context);
   void ProcessReadTimeManipulation(ReadTimeManipulation manipulation);
 
+  template <class Req>
+  Result<std::pair<int64_t, bool>> DoReadSequenceTuple(const Req& req, CoarseTimePoint deadline);
+
+  // Returns whether the update was skipped, because the row does not match expected
+  // last_val and is_called.
+  template <class Req>
+  Result<bool> DoUpdateSequenceTuple(
+      const Req& req, int64_t last_val, bool is_called,
+      const std::optional<std::pair<int64_t, bool>>& expected, CoarseTimePoint deadline);
+
   client::YBClient& client();
   client::YBSessionPtr& EnsureSession(PgClientSessionKind kind);
   client::YBSessionPtr& Session(PgClientSessionKind kind);
@@ -163,6 +184,7 @@ class PgClientSession : public std::enable_shared_from_this<PgClientSession> {
   scoped_refptr<ClockBase> clock_;
   const TransactionPoolProvider& transaction_pool_provider_;
   PgTableCache& table_cache_;
+  PgSequenceCache& sequence_cache_;
   const XClusterSafeTimeMap* xcluster_safe_time_map_;
 
   std::array<SessionData, kPgClientSessionKindMapSize> sessions_;
@@ -0,0 +1,206 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "yb/tserver/pg_response_cache.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+DECLARE_bool(ysql_enable_catalog_response_cache);
+DECLARE_uint64(ysql_catalog_response_cache_max_entries);
+DECLARE_uint64(ysql_catalog_response_cache_ttl_ms);
+
+namespace yb {
+namespace tserver {
+
+class PgResponseCacheTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_enable_catalog_response_cache) = true;
+  }
+
+  static PgPerformRequestPB MakeRequest(
+      uint64_t catalog_version, const std::string& table_id, uint64_t session_id = 1) {
+    PgPerformRequestPB req;
+    req.set_session_id(session_id);
+    auto& options = *req.mutable_options();
+    options.set_use_catalog_session(true);
+    options.set_response_cache_catalog_version(catalog_version);
+    auto& read = *req.add_ops()->mutable_read();
+    read.set_table_id(table_id);
+    read.set_stmt_id(session_id);
+    return req;
+  }
+
+  static std::string Key(const PgPerformRequestPB& req) {
+    auto key = PgResponseCache::Key(req);
+    EXPECT_TRUE(key.has_value());
+    return key ? *key : std::string();
+  }
+
+  // Returns the entry if callback was invoked before Get returned.
+  std::optional<PgResponseCache::Entry> Get(const std::string& key) {
+    std::optional<PgResponseCache::Entry> result;
+    cache_.Get(key, [&result](PgResponseCache::Entry entry) {
+      result = std::move(entry);
+    });
+    return result;
+  }
+
+  // Checks that the key is missing in the cache and fills it with response for read_ht.
+  void Fill(const std::string& key, uint64_t read_ht) {
+    auto entry = Get(key);
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_FALSE(entry->response);
+    ASSERT_TRUE(entry->setter);
+    entry->setter(MakeResponse(read_ht), {});
+  }
+
+  // Checks that the response for read_ht is served from the cache.
+  void CheckHit(const std::string& key, uint64_t read_ht) {
+    auto entry = Get(key);
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_TRUE(entry->response);
+    ASSERT_FALSE(entry->setter);
+    ASSERT_EQ(entry->response->response.catalog_read_time().read_ht(), read_ht);
+  }
+
+  static PgPerformResponsePB MakeResponse(uint64_t read_ht) {
+    PgPerformResponsePB response;
+    response.mutable_catalog_read_time()->set_read_ht(read_ht);
+    return response;
+  }
+
+  PgResponseCache cache_;
+};
+
+TEST_F(PgResponseCacheTest, Hit) {
+  auto key = Key(MakeRequest(1, "table"));
+  ASSERT_NO_FATALS(Fill(key, 10));
+  ASSERT_NO_FATALS(CheckHit(key, 10));
+
+  // Request of another session shares the response.
+  ASSERT_EQ(Key(MakeRequest(1, "table", /* session_id= */ 2)), key);
+  ASSERT_NO_FATALS(CheckHit(key, 10));
+
+  // Request for another table does not.
+  ASSERT_NO_FATALS(Fill(Key(MakeRequest(1, "other_table")), 20));
+}
+
+TEST_F(PgResponseCacheTest, ConcurrentMiss) {
+  auto key = Key(MakeRequest(1, "table"));
+  auto entry = Get(key);
+  ASSERT_TRUE(entry.has_value());
+  ASSERT_TRUE(entry->setter);
+
+  // Concurrent identical request waits for the response without blocking.
+  constexpr int kWaiters = 3;
+  std::vector<std::optional<PgResponseCache::Entry>> waiters(kWaiters);
+  for (auto& waiter : waiters) {
+    cache_.Get(key, [&waiter](PgResponseCache::Entry waiter_entry) {
+      waiter = std::move(waiter_entry);
+    });
+    ASSERT_FALSE(waiter.has_value());
+  }
+
+  entry->setter(MakeResponse(10), {});
+  for (const auto& waiter : waiters) {
+    ASSERT_TRUE(waiter.has_value());
+    ASSERT_TRUE(waiter->response);
+    ASSERT_EQ(waiter->response->response.catalog_read_time().read_ht(), 10U);
+  }
+}
+
+TEST_F(PgResponseCacheTest, ConcurrentMissFailed) {
+  auto key = Key(MakeRequest(1, "table"));
+  std::optional<PgResponseCache::Entry> waiter;
+  {
+    auto entry = Get(key);
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_TRUE(entry->setter);
+    cache_.Get(key, [&waiter](PgResponseCache::Entry waiter_entry) {
+      waiter = std::move(waiter_entry);
+    });
+    ASSERT_FALSE(waiter.has_value());
+    // Setter is destroyed without being invoked, as when the request fails before performing.
+  }
+
+  // Waiter should perform the request itself.
+  ASSERT_TRUE(waiter.has_value());
+  ASSERT_FALSE(waiter->response);
+  ASSERT_FALSE(waiter->setter);
+
+  // Failed response is not cached.
+  ASSERT_NO_FATALS(Fill(key, 10));
+  ASSERT_NO_FATALS(CheckHit(key, 10));
+}
+
+TEST_F(PgResponseCacheTest, Expiration) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_catalog_response_cache_ttl_ms) = 100 * kTimeMultiplier;
+  auto key = Key(MakeRequest(1, "table"));
+  ASSERT_NO_FATALS(Fill(key, 10));
+  ASSERT_NO_FATALS(CheckHit(key, 10));
+
+  SleepFor(FLAGS_ysql_catalog_response_cache_ttl_ms * 1ms);
+  ASSERT_NO_FATALS(Fill(key, 20));
+  ASSERT_NO_FATALS(CheckHit(key, 20));
+}
+
+TEST_F(PgResponseCacheTest, CatalogVersionChange) {
+  auto key = Key(MakeRequest(1, "table"));
+  ASSERT_NO_FATALS(Fill(key, 10));
+
+  // Response cached for the old catalog version is not served for the new one.
+  auto new_key = Key(MakeRequest(2, "table"));
+  ASSERT_NE(new_key, key);
+  ASSERT_NO_FATALS(Fill(new_key, 20));
+  ASSERT_NO_FATALS(CheckHit(new_key, 20));
+  ASSERT_NO_FATALS(CheckHit(key, 10));
+}
+
+TEST_F(PgResponseCacheTest, Eviction) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_catalog_response_cache_max_entries) = 2;
+  auto key1 = Key(MakeRequest(1, "table1"));
+  auto key2 = Key(MakeRequest(1, "table2"));
+  auto key3 = Key(MakeRequest(1, "table3"));
+  ASSERT_NO_FATALS(Fill(key1, 10));
+  ASSERT_NO_FATALS(Fill(key2, 20));
+  // Use key1, so key2 becomes the least recently used entry.
+  ASSERT_NO_FATALS(CheckHit(key1, 10));
+  ASSERT_NO_FATALS(Fill(key3, 30));
+
+  ASSERT_NO_FATALS(CheckHit(key1, 10));
+  ASSERT_NO_FATALS(CheckHit(key3, 30));
+  ASSERT_NO_FATALS(Fill(key2, 40));
+}
+
+TEST_F(PgResponseCacheTest, NotCacheable) {
+  auto req = MakeRequest(1, "table");
+  req.mutable_options()->set_response_cache_catalog_version(0);
+  ASSERT_FALSE(PgResponseCache::Key(req).has_value());
+
+  req = MakeRequest(1, "table");
+  req.add_ops()->mutable_write();
+  ASSERT_FALSE(PgResponseCache::Key(req).has_value());
+}
+
+}  // namespace tserver
+}  // namespace yb
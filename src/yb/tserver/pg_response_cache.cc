@@ -0,0 +1,266 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/pg_response_cache.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/monotime.h"
+
+using namespace std::literals;
+
+DEFINE_RUNTIME_bool(ysql_enable_catalog_response_cache, false,
+    "Serve catalog reads of new connections and catalog cache refreshes from the node level "
+    "cache of responses, keyed by the catalog version.");
+
+DEFINE_RUNTIME_uint64(ysql_catalog_response_cache_ttl_ms, 5000,
+    "Time to live of the cached catalog read response. DDLs that do not increment the catalog "
+    "version become visible to new connections only after the cached response expires.");
+
+DEFINE_RUNTIME_uint64(ysql_catalog_response_cache_max_entries, 1000,
+    "Max number of responses in the node level cache of catalog read responses. Least recently "
+    "used responses are evicted when the limit is reached.");
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+class CacheEntry {
+ public:
+  explicit CacheEntry(CoarseTimePoint expiration) : expiration_(expiration) {}
+
+  bool Expired(CoarseTimePoint now) const {
+    return expiration_ <= now;
+  }
+
+  bool Failed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return filled_ && !response_;
+  }
+
+  // Invokes callback with the response, immediately if it is already set, or when it is set.
+  void Wait(PgResponseCache::GetCallback callback) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!filled_) {
+        waiters_.push_back(std::move(callback));
+        return;
+      }
+    }
+    Notify(callback);
+  }
+
+  // Sets the response, nullptr means that the request failed and waiters should perform it
+  // themselves.
+  void Fill(PgResponseCache::ResponsePtr response) {
+    std::vector<PgResponseCache::GetCallback> waiters;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      response_ = std::move(response);
+      filled_ = true;
+      waiters.swap(waiters_);
+    }
+    for (const auto& waiter : waiters) {
+      Notify(waiter);
+    }
+  }
+
+ private:
+  void Notify(const PgResponseCache::GetCallback& callback) {
+    // response_ is not modified after filled_ is set.
+    callback(PgResponseCache::Entry { .response = response_ });
+  }
+
+  const CoarseTimePoint expiration_;
+  mutable std::mutex mutex_;
+  bool filled_ GUARDED_BY(mutex_) = false;
+  PgResponseCache::ResponsePtr response_;
+  std::vector<PgResponseCache::GetCallback> waiters_ GUARDED_BY(mutex_);
+};
+
+using CacheEntryPtr = std::shared_ptr<CacheEntry>;
+
+// Fills the entry with the response of the performed request.
+// Entry is marked as failed if the filler is destroyed without being invoked, so waiters don't
+// wait for the response that will never be set.
+class EntryFiller {
+ public:
+  explicit EntryFiller(CacheEntryPtr entry) : entry_(std::move(entry)) {}
+
+  ~EntryFiller() {
+    if (entry_) {
+      entry_->Fill(nullptr);
+    }
+  }
+
+  void Fill(const PgPerformResponsePB& response, const std::vector<rpc::SidecarHolder>& sidecars) {
+    auto entry = std::move(entry_);
+    if (response.has_status()) {
+      entry->Fill(nullptr);
+      return;
+    }
+    auto value = std::make_shared<PgResponseCache::Response>();
+    value->response = response;
+    // Sidecar holders are ref counted and not modified after response is sent, so they are shared
+    // by all responses served from this entry.
+    value->sidecars = sidecars;
+    entry->Fill(std::move(value));
+  }
+
+ private:
+  CacheEntryPtr entry_;
+};
+
+struct KeyAndEntry {
+  std::string key;
+  mutable CacheEntryPtr entry;
+};
+
+// Serialization is deterministic, so identical requests always produce the same key.
+std::string SerializeKey(const PgPerformRequestPB& req) {
+  std::string result;
+  {
+    google::protobuf::io::StringOutputStream output(&result);
+    google::protobuf::io::CodedOutputStream stream(&output);
+    stream.SetSerializationDeterministic(true);
+    req.SerializeToCodedStream(&stream);
+  }
+  return result;
+}
+
+} // namespace
+
+class PgResponseCache::Impl {
+ public:
+  void Get(const std::string& key, GetCallback callback) {
+    CacheEntryPtr entry;
+    std::shared_ptr<EntryFiller> filler;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto now = CoarseMonoClock::now();
+      auto it = entries_.get<KeyTag>().find(key);
+      if (it == entries_.get<KeyTag>().end() || it->entry->Expired(now) || it->entry->Failed()) {
+        CleanupExpired(now);
+        entry = std::make_shared<CacheEntry>(now + FLAGS_ysql_catalog_response_cache_ttl_ms * 1ms);
+        filler = std::make_shared<EntryFiller>(entry);
+        Insert(key, entry);
+      } else {
+        entry = it->entry;
+        entries_.relocate(entries_.begin(), entries_.project<0>(it));
+      }
+    }
+
+    if (filler) {
+      callback(Entry {
+        .setter = [filler](const PgPerformResponsePB& response,
+                           const std::vector<rpc::SidecarHolder>& sidecars) {
+          filler->Fill(response, sidecars);
+        },
+      });
+      return;
+    }
+
+    // The same request is performed by another caller, or was already performed.
+    entry->Wait(std::move(callback));
+  }
+
+ private:
+  class KeyTag;
+
+  void Insert(const std::string& key, const CacheEntryPtr& entry) REQUIRES(mutex_) {
+    auto& index = entries_.get<KeyTag>();
+    auto it = index.find(key);
+    if (it != index.end()) {
+      it->entry = entry;
+      entries_.relocate(entries_.begin(), entries_.project<0>(it));
+      return;
+    }
+    entries_.push_front(KeyAndEntry { .key = key, .entry = entry });
+    while (entries_.size() > std::max<uint64_t>(FLAGS_ysql_catalog_response_cache_max_entries, 1)) {
+      entries_.pop_back();
+    }
+  }
+
+  void CleanupExpired(CoarseTimePoint now) REQUIRES(mutex_) {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->entry->Expired(now)) {
+        it = entries_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  std::mutex mutex_;
+  // Entries in the order of use, the most recently used first.
+  boost::multi_index_container<
+      KeyAndEntry,
+      boost::multi_index::indexed_by<
+          boost::multi_index::sequenced<>,
+          boost::multi_index::hashed_unique<
+              boost::multi_index::tag<KeyTag>,
+              boost::multi_index::member<KeyAndEntry, std::string, &KeyAndEntry::key>
+          >
+      >
+  > entries_ GUARDED_BY(mutex_);
+};
+
+PgResponseCache::PgResponseCache() : impl_(new Impl()) {}
+
+PgResponseCache::~PgResponseCache() = default;
+
+std::optional<std::string> PgResponseCache::Key(const PgPerformRequestPB& req) {
+  const auto& options = req.options();
+  if (!FLAGS_ysql_enable_catalog_response_cache || !options.use_catalog_session() ||
+      !options.response_cache_catalog_version()) {
+    return std::nullopt;
+  }
+  // Key contains only fields that affect the response, so requests of different sessions with the
+  // same catalog version, read time and read ops share the cached response.
+  PgPerformRequestPB key_req;
+  auto& key_options = *key_req.mutable_options();
+  key_options.set_response_cache_catalog_version(options.response_cache_catalog_version());
+  if (options.has_read_time()) {
+    *key_options.mutable_read_time() = options.read_time();
+  }
+  key_options.set_namespace_id(options.namespace_id());
+  for (const auto& op : req.ops()) {
+    if (!op.has_read()) {
+      return std::nullopt;
+    }
+    auto& key_op = *key_req.add_ops();
+    key_op = op;
+    key_op.mutable_read()->clear_stmt_id();
+  }
+  return SerializeKey(key_req);
+}
+
+void PgResponseCache::Get(const std::string& key, GetCallback callback) {
+  impl_->Get(key, std::move(callback));
+}
+
+}  // namespace tserver
+}  // namespace yb
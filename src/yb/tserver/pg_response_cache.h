@@ -0,0 +1,74 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/tserver/pg_client.pb.h"
+
+namespace yb {
+namespace tserver {
+
+// Node level cache of the catalog read responses.
+// New connections and catalog cache refreshes of all postgres backends of the node read the same
+// catalog data, so the response for the first of them is reused by the others, while the catalog
+// version stays the same.
+// Concurrent identical requests wait for the one that is being performed, so connection storm
+// produces a single read from the master. Waiters do not block threads, they are called back when
+// the response is set.
+class PgResponseCache {
+ public:
+  struct Response {
+    PgPerformResponsePB response;
+    std::vector<rpc::SidecarHolder> sidecars;
+  };
+
+  using ResponsePtr = std::shared_ptr<const Response>;
+  using Setter = std::function<void(
+      const PgPerformResponsePB& response, const std::vector<rpc::SidecarHolder>& sidecars)>;
+
+  // Result of the cache lookup. When response is not set, the caller should perform the request
+  // itself and, if setter is set, pass the response to it.
+  struct Entry {
+    ResponsePtr response;
+    Setter setter;
+  };
+
+  using GetCallback = std::function<void(Entry)>;
+
+  PgResponseCache();
+  ~PgResponseCache();
+
+  // Returns cache key for the request, or nullopt when the request could not be cached.
+  static std::optional<std::string> Key(const PgPerformRequestPB& req);
+
+  // Invokes callback with the cache entry for the key. If the same request is being performed by
+  // another caller, callback is invoked when its response is set, on the thread that sets it.
+  // Callback is not invoked while holding the cache lock, so it could perform the request.
+  void Get(const std::string& key, GetCallback callback);
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace tserver
+}  // namespace yb
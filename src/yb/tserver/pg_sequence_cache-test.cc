@@ -0,0 +1,92 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <limits>
+
+#include "yb/common/pgsql_error.h"
+
+#include "yb/tserver/pg_sequence_cache.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace tserver {
+
+class PgSequenceCacheTest : public YBTest {
+ protected:
+  static void CheckRange(const PgSequenceRange& range, int64_t first, int64_t last) {
+    ASSERT_EQ(range.first, first) << range.ToString();
+    ASSERT_EQ(range.last, last) << range.ToString();
+  }
+};
+
+TEST_F(PgSequenceCacheTest, NextRange) {
+  const PgSequenceParams params { .increment = 2, .min_value = 1, .max_value = 20 };
+
+  CheckRange(ASSERT_RESULT(NextPgSequenceRange(1, false, params, 3)), 1, 5);
+  CheckRange(ASSERT_RESULT(NextPgSequenceRange(5, true, params, 3)), 7, 11);
+  // Range ends at the max value.
+  CheckRange(ASSERT_RESULT(NextPgSequenceRange(15, true, params, 10)), 17, 19);
+
+  auto status = ResultToStatus(NextPgSequenceRange(19, true, params, 3));
+  ASSERT_NOK(status);
+  ASSERT_EQ(PgsqlError(status), YBPgErrorCode::YB_PG_SEQUENCE_GENERATOR_LIMIT_EXCEEDED);
+
+  auto cycled = params;
+  cycled.cycle = true;
+  CheckRange(ASSERT_RESULT(NextPgSequenceRange(19, true, cycled, 3)), 1, 5);
+}
+
+TEST_F(PgSequenceCacheTest, NextRangeDescending) {
+  constexpr auto kMin = std::numeric_limits<int64_t>::min();
+  constexpr auto kMax = std::numeric_limits<int64_t>::max();
+  const PgSequenceParams params {
+    .increment = -3,
+    .min_value = kMin,
+    .max_value = kMax,
+    .cycle = true,
+  };
+
+  // Distance between the bounds does not fit into int64.
+  CheckRange(ASSERT_RESULT(NextPgSequenceRange(kMax, false, params, 2)), kMax, kMax - 3);
+  CheckRange(ASSERT_RESULT(NextPgSequenceRange(kMin + 4, true, params, 10)), kMin + 1, kMin + 1);
+  CheckRange(ASSERT_RESULT(NextPgSequenceRange(kMin + 1, true, params, 2)), kMax, kMax - 3);
+}
+
+TEST_F(PgSequenceCacheTest, Lease) {
+  const PgSequenceParams params { .increment = 1, .min_value = 1, .max_value = 1000 };
+  PgSequenceCache cache;
+  auto entry = cache.Get(1, 2);
+  std::lock_guard<std::mutex> lock(entry->mutex);
+  ASSERT_FALSE(entry->Take(params, 5));
+
+  entry->SetLease(params, PgSequenceRange { .first = 1, .last = 12 });
+  CheckRange(*entry->Take(params, 5), 1, 5);
+  CheckRange(*entry->Take(params, 5), 6, 10);
+  CheckRange(*entry->Take(params, 5), 11, 12);
+  ASSERT_FALSE(entry->Take(params, 5));
+
+  // Values leased with other params are not handed out.
+  entry->SetLease(params, PgSequenceRange { .first = 20, .last = 30 });
+  auto altered = params;
+  altered.increment = 2;
+  ASSERT_FALSE(entry->Take(altered, 5));
+
+  // Invalidated sequence gets a new entry.
+  cache.Invalidate(1, 2);
+  ASSERT_NE(cache.Get(1, 2), entry);
+}
+
+}  // namespace tserver
+}  // namespace yb
@@ -0,0 +1,145 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/pg_sequence_cache.h"
+
+#include <algorithm>
+
+#include "yb/common/pgsql_error.h"
+
+#include "yb/util/format.h"
+#include "yb/util/status_format.h"
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+// Sequence values are stepped using unsigned arithmetic, so distance between any two int64
+// values is representable, and stepping never overflows within the sequence bounds.
+uint64_t AbsIncrement(const PgSequenceParams& params) {
+  return params.increment > 0 ? static_cast<uint64_t>(params.increment)
+                              : 0 - static_cast<uint64_t>(params.increment);
+}
+
+// Number of increments that could be added to the value, without crossing the sequence bound.
+uint64_t StepsToBound(int64_t value, const PgSequenceParams& params) {
+  if (params.increment > 0) {
+    if (value > params.max_value) {
+      return 0;
+    }
+    return (static_cast<uint64_t>(params.max_value) - static_cast<uint64_t>(value)) /
+           AbsIncrement(params);
+  }
+  if (value < params.min_value) {
+    return 0;
+  }
+  return (static_cast<uint64_t>(value) - static_cast<uint64_t>(params.min_value)) /
+         AbsIncrement(params);
+}
+
+int64_t Step(int64_t value, const PgSequenceParams& params, uint64_t steps) {
+  return static_cast<int64_t>(
+      static_cast<uint64_t>(value) + steps * static_cast<uint64_t>(params.increment));
+}
+
+} // namespace
+
+std::string PgSequenceParams::ToString() const {
+  return Format(
+      "{ increment: $0 min_value: $1 max_value: $2 cycle: $3 }", increment, min_value, max_value,
+      cycle);
+}
+
+std::string PgSequenceRange::ToString() const {
+  return Format("[$0, $1]", first, last);
+}
+
+Result<PgSequenceRange> NextPgSequenceRange(
+    int64_t last_value, bool is_called, const PgSequenceParams& params, int64_t count) {
+  SCHECK_NE(params.increment, 0, InvalidArgument, "Zero sequence increment");
+  SCHECK_GT(count, 0, InvalidArgument, "Wrong number of sequence values requested");
+  PgSequenceRange result;
+  if (!is_called) {
+    result.first = last_value;
+  } else if (StepsToBound(last_value, params) > 0) {
+    result.first = Step(last_value, params, 1);
+  } else if (params.cycle) {
+    result.first = params.increment > 0 ? params.min_value : params.max_value;
+  } else {
+    return STATUS_EC_FORMAT(
+        IllegalState, PgsqlError(YBPgErrorCode::YB_PG_SEQUENCE_GENERATOR_LIMIT_EXCEEDED),
+        "nextval: reached $0 value of sequence ($1)",
+        params.increment > 0 ? "maximum" : "minimum",
+        params.increment > 0 ? params.max_value : params.min_value);
+  }
+  result.last = Step(
+      result.first, params,
+      std::min<uint64_t>(count - 1, StepsToBound(result.first, params)));
+  return result;
+}
+
+std::optional<PgSequenceRange> PgSequenceCache::Entry::Take(
+    const PgSequenceParams& params, int64_t count) {
+  if (!params_ || !(*params_ == params) || count <= 0) {
+    return std::nullopt;
+  }
+  auto distance = params.increment > 0
+      ? static_cast<uint64_t>(lease_.last) - static_cast<uint64_t>(lease_.first)
+      : static_cast<uint64_t>(lease_.first) - static_cast<uint64_t>(lease_.last);
+  PgSequenceRange result {
+    .first = lease_.first,
+    .last = Step(
+        lease_.first, params, std::min<uint64_t>(count - 1, distance / AbsIncrement(params))),
+  };
+  if (result.last == lease_.last) {
+    params_.reset();
+  } else {
+    lease_.first = Step(result.last, params, 1);
+  }
+  return result;
+}
+
+void PgSequenceCache::Entry::SetLease(
+    const PgSequenceParams& params, const PgSequenceRange& range) {
+  params_ = params;
+  lease_ = range;
+}
+
+PgSequenceCache::EntryPtr PgSequenceCache::Get(int64_t db_oid, int64_t seq_oid) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& result = entries_[Key(db_oid, seq_oid)];
+  if (!result) {
+    result = std::make_shared<Entry>();
+  }
+  return result;
+}
+
+void PgSequenceCache::Invalidate(int64_t db_oid, int64_t seq_oid) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.erase(Key(db_oid, seq_oid));
+}
+
+void PgSequenceCache::InvalidateDatabase(int64_t db_oid) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->first.first == db_oid) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace tserver
+}  // namespace yb
@@ -0,0 +1,107 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <boost/functional/hash.hpp>
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/util/result.h"
+
+namespace yb {
+namespace tserver {
+
+struct PgSequenceParams {
+  int64_t increment = 1;
+  int64_t min_value = 1;
+  int64_t max_value = 0;
+  bool cycle = false;
+
+  bool operator==(const PgSequenceParams& rhs) const {
+    return increment == rhs.increment && min_value == rhs.min_value &&
+           max_value == rhs.max_value && cycle == rhs.cycle;
+  }
+
+  std::string ToString() const;
+};
+
+// Range of sequence values, both ends inclusive, stepping by the sequence increment.
+struct PgSequenceRange {
+  int64_t first = 0;
+  int64_t last = 0;
+
+  std::string ToString() const;
+};
+
+// Returns the range of at most count values, that follows the sequence row with specified
+// last_value and is_called, the same way postgres nextval does. The range does not wrap around,
+// so in cycled sequence it ends at the bound and the next range starts from the other bound.
+// Returns error with SEQUENCE_GENERATOR_LIMIT_EXCEEDED pgsql error code when the row is at the
+// bound of not cycled sequence.
+Result<PgSequenceRange> NextPgSequenceRange(
+    int64_t last_value, bool is_called, const PgSequenceParams& params, int64_t count);
+
+// Node level cache of the sequence values.
+// Instead of updating the sequence row on every cache refill of each backend, the node leases a
+// range of values that is several times larger than the cache of the sequence with a single
+// conditional update of the row, and hands out sub-ranges of the requested size to the local
+// backends. So each backend still gets cache size ranges of increasing values, while the hot row
+// is updated rarely.
+class PgSequenceCache {
+ public:
+  class Entry {
+   public:
+    // Takes at most count next values of the leased range. Returns nullopt when there are no
+    // leased values, or they were leased with other sequence params.
+    std::optional<PgSequenceRange> Take(const PgSequenceParams& params, int64_t count)
+        REQUIRES(mutex);
+
+    void SetLease(const PgSequenceParams& params, const PgSequenceRange& range) REQUIRES(mutex);
+
+    // Serializes usage of the entry, including leasing of new range from the sequence row.
+    std::mutex mutex;
+
+   private:
+    std::optional<PgSequenceParams> params_ GUARDED_BY(mutex);
+    PgSequenceRange lease_ GUARDED_BY(mutex);
+  };
+
+  using EntryPtr = std::shared_ptr<Entry>;
+
+  EntryPtr Get(int64_t db_oid, int64_t seq_oid);
+
+  // Forgets leased values of the sequence, should be called after the sequence row was modified
+  // bypassing the cache. Values are not expected to be unique after setval and alike, so it is
+  // fine for concurrent users of the old entry to finish handing out its values.
+  void Invalidate(int64_t db_oid, int64_t seq_oid);
+
+  void InvalidateDatabase(int64_t db_oid);
+
+ private:
+  using Key = std::pair<int64_t, int64_t>;
+
+  std::mutex mutex_;
+  std::unordered_map<Key, EntryPtr, boost::hash<Key>> entries_ GUARDED_BY(mutex_);
+};
+
+}  // namespace tserver
+}  // namespace yb
@@ -27,10 +27,12 @@
 #include "yb/tablet/write_query.h"
 
 #include "yb/tserver/service_util.h"
+#include "yb/tserver/table_quotas.h"
 #include "yb/tserver/tablet_server_interface.h"
 #include "yb/tserver/ts_tablet_manager.h"
 #include "yb/tserver/tserver.pb.h"
 
+#include "yb/util/call_accounting.h"
 #include "yb/util/countdown_latch.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/flags.h"
@@ -64,6 +66,12 @@ DEFINE_RUNTIME_bool(ysql_follower_reads_avoid_waiting_for_safe_time, true,
     "faster than waiting for safe time to catch up.");
 TAG_FLAG(ysql_follower_reads_avoid_waiting_for_safe_time, advanced);
 
+DEFINE_RUNTIME_bool(point_reads_skip_safe_time_wait, false,
+    "Whether strongly consistent YSQL read of a single row by ybctid on the leader could be done "
+    "at the requested read time without waiting for safe time, when there are no pending writes "
+    "to this row.");
+TAG_FLAG(point_reads_skip_safe_time_wait, advanced);
+
 METRIC_DEFINE_coarse_histogram(server, read_time_wait,
                                "Read Time Wait",
                                yb::MetricUnit::kMicroseconds,
@@ -91,7 +99,7 @@ class ReadQuery : public std::enable_shared_from_this<ReadQuery>, public rpc::Th
       TabletServerIf* server, ReadTabletProvider* read_tablet_provider, const ReadRequestPB* req,
       ReadResponsePB* resp, rpc::RpcContext context)
       : server_(*server), read_tablet_provider_(*read_tablet_provider), req_(req), resp_(resp),
-        context_(std::move(context)) {
+        context_(std::move(context)), call_accounting_(CallAccounting::Current()) {
     auto metric_entity = server->MetricEnt();
     if (metric_entity) {
       read_time_wait_ = METRIC_read_time_wait.Instantiate(metric_entity);
@@ -131,6 +139,10 @@ class ReadQuery : public std::enable_shared_from_this<ReadQuery>, public rpc::Th
   bool IsForBackfill() const;
   bool IsPgsqlFollowerReadAtAFollower() const;
 
+  // Whether the request reads single row at the specified read time on the leader, and there are
+  // no pending writes to this row, so the read does not have to wait for safe time.
+  Result<bool> CanSkipSafeTimeWait();
+
   // Read implementation. If restart is required returns restart time, in case of success
   // returns invalid ReadHybridTime. Otherwise returns error status.
   Result<ReadHybridTime> DoRead();
@@ -145,6 +157,7 @@ class ReadQuery : public std::enable_shared_from_this<ReadQuery>, public rpc::Th
   // replica state lock for too long.
   // So ThreadPool is used to proceed with read.
   void Run() override {
+    ADOPT_CALL_ACCOUNTING(call_accounting_.get());
     auto status = PickReadTime(server_.Clock());
     if (status.ok()) {
       status = Complete();
@@ -162,6 +175,7 @@ class ReadQuery : public std::enable_shared_from_this<ReadQuery>, public rpc::Th
   const ReadRequestPB* req_;
   ReadResponsePB* resp_;
   rpc::RpcContext context_;
+  scoped_refptr<CallAccounting> call_accounting_;
 
   std::shared_ptr<tablet::AbstractTablet> abstract_tablet_;
 
@@ -172,6 +186,9 @@ class ReadQuery : public std::enable_shared_from_this<ReadQuery>, public rpc::Th
   HostPortPB host_port_pb_;
   bool allow_retry_ = false;
   bool reading_from_non_leader_ = false;
+  // Whether response size should be charged to table quotas.
+  bool charge_table_quotas_ = false;
+  size_t sidecars_bytes_ = 0;
   RequestScope request_scope_;
   std::shared_ptr<ReadQuery> retained_self_;
 
@@ -221,6 +238,7 @@ Status ReadQuery::DoPerform() {
     context_.EnsureTraceCreated();
   }
   ADOPT_TRACE(context_.trace());
+  ADOPT_CALL_ACCOUNTING(call_accounting_.get());
   TRACE("Start Read");
   TRACE_EVENT1("tserver", "TabletServiceImpl::Read", "tablet_id", req_->tablet_id());
   VLOG(2) << "Received Read RPC: " << req_->DebugString();
@@ -309,6 +327,11 @@ Status ReadQuery::DoPerform() {
         server_.tablet_peer_lookup()->GetServingTablet(req_->tablet_id()), {});
   }
   reading_from_non_leader_ = tablet_peer && !CheckPeerIsLeader(*tablet_peer).ok();
+  if (reading_from_non_leader_ && req_->max_staleness_ms() > 0 &&
+      req_->consistency_level() == YBConsistencyLevel::CONSISTENT_PREFIX &&
+      abstract_tablet_ && !abstract_tablet_->system()) {
+    RETURN_NOT_OK(CheckFollowerStaleness(*tablet_peer, req_->max_staleness_ms()));
+  }
   if (PREDICT_FALSE(FLAGS_TEST_assert_reads_served_by_follower)) {
     CHECK_NE(req_->consistency_level(), YBConsistencyLevel::STRONG)
         << "--TEST_assert_reads_served_by_follower is true but consistency level is "
@@ -325,6 +348,14 @@ Status ReadQuery::DoPerform() {
         TabletServerError(TabletServerErrorPB::TABLET_NOT_FOUND));
   }
 
+  auto* table_quotas = server_.table_quotas();
+  if (table_quotas && table_quotas->enabled() && !abstract_tablet_->system()) {
+    RETURN_NOT_OK(table_quotas->Consume(
+        *tablet()->metadata(), QuotaTableId(req_->pgsql_batch()), req_->ByteSizeLong()));
+    // Response size is known only after the read, so it is charged when the read completes.
+    charge_table_quotas_ = true;
+  }
+
   if (FLAGS_TEST_simulate_time_out_failures_msecs > 0 && RandomUniformInt(0, 10) < 2) {
     LOG(INFO) << "Marking request as timed out for test: " << req_->ShortDebugString();
     SleepFor(MonoDelta::FromMilliseconds(FLAGS_TEST_simulate_time_out_failures_msecs));
@@ -440,11 +471,15 @@ Status ReadQuery::DoPickReadTime(server::Clock* clock) {
         return STATUS(IllegalState, "Requested read time is not safe at this follower.");
       }
     }
-    safe_ht_to_read_ =
-        (current_safe_time > read_time_.read
-             ? current_safe_time
-             : VERIFY_RESULT(abstract_tablet_->SafeTime(
-                   require_lease_, read_time_.read, context_.GetClientDeadline())));
+    if (VERIFY_RESULT(CanSkipSafeTimeWait())) {
+      safe_ht_to_read_ = read_time_.read;
+    } else {
+      safe_ht_to_read_ =
+          (current_safe_time > read_time_.read
+               ? current_safe_time
+               : VERIFY_RESULT(abstract_tablet_->SafeTime(
+                     require_lease_, read_time_.read, context_.GetClientDeadline())));
+    }
   }
   if (read_time_wait_) {
     auto safe_time_wait = MonoTime::Now() - start_time;
@@ -459,10 +494,27 @@ bool ReadQuery::IsPgsqlFollowerReadAtAFollower() const {
           req_->consistency_level() == YBConsistencyLevel::CONSISTENT_PREFIX);
 }
 
+Result<bool> ReadQuery::CanSkipSafeTimeWait() {
+  if (!GetAtomicFlag(&FLAGS_point_reads_skip_safe_time_wait) ||
+      require_lease_ != tablet::RequireLease::kTrue || reading_from_non_leader_ ||
+      abstract_tablet_->system() || req_->pgsql_batch_size() != 1) {
+    return false;
+  }
+  const auto& pgsql_req = req_->pgsql_batch(0);
+  if (!pgsql_req.has_ybctid_column_value() || pgsql_req.has_index_request() ||
+      pgsql_req.batch_arguments_size() != 0) {
+    return false;
+  }
+  return tablet()->CanReadDocumentWithoutSafeTime(
+      pgsql_req.ybctid_column_value().value().binary_value(), read_time_.read,
+      context_.GetClientDeadline());
+}
+
 Status ReadQuery::Complete() {
   for (;;) {
     resp_->Clear();
     context_.ResetRpcSidecars();
+    sidecars_bytes_ = 0;
     VLOG(1) << "Read time: " << read_time_ << ", safe: " << safe_ht_to_read_;
     const auto result = VERIFY_RESULT(DoRead());
     if (allow_retry_ && read_time_ && read_time_ == result) {
@@ -536,6 +588,12 @@ Status ReadQuery::Complete() {
   }
 #endif
 
+  if (charge_table_quotas_) {
+    server_.table_quotas()->Charge(
+        *tablet()->metadata(), QuotaTableId(req_->pgsql_batch()),
+        resp_->ByteSizeLong() + sidecars_bytes_);
+  }
+
   MakeRpcOperationCompletionCallback<ReadResponsePB>(
       std::move(context_), resp_, server_.Clock())(Status::OK());
   TRACE("Done Read");
@@ -643,6 +701,7 @@ Result<ReadHybridTime> ReadQuery::DoReadImpl() {
       if (result.restart_read_ht.is_valid()) {
         return FormRestartReadHybridTime(result.restart_read_ht);
       }
+      sidecars_bytes_ += result.rows_data.size();
       result.response.set_rows_data_sidecar(
           narrow_cast<int32_t>(context_.AddRpcSidecar(result.rows_data)));
       resp_->add_ql_batch()->Swap(&result.response);
@@ -668,6 +727,7 @@ Result<ReadHybridTime> ReadQuery::DoReadImpl() {
       if (result.restart_read_ht.is_valid()) {
         return FormRestartReadHybridTime(result.restart_read_ht);
       }
+      sidecars_bytes_ += result.rows_data.size();
       result.response.set_rows_data_sidecar(
           narrow_cast<int32_t>(context_.AddRpcSidecar(result.rows_data)));
       resp_->add_pgsql_batch()->Swap(&result.response);
@@ -229,6 +229,9 @@ class RemoteBootstrapClient {
   // First available WAL segment.
   uint64_t first_wal_seqno_ = 0;
 
+  // Directory with the RocksDB files of the session on the source.
+  std::string source_checkpoint_dir_;
+
   int64_t start_time_micros_ = 0;
 
   // We track whether this session succeeded and send this information as part of the
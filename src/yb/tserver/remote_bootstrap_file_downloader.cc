@@ -14,6 +14,9 @@
 #include "yb/tserver/remote_bootstrap_file_downloader.h"
 
 #include <iomanip>
+#include <unordered_set>
+
+#include <boost/algorithm/string/predicate.hpp>
 
 #include "yb/common/wire_protocol.h"
 
@@ -29,9 +32,11 @@
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/net/rate_limiter.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
 #include "yb/util/stopwatch.h"
+#include "yb/util/threadpool.h"
 
 using namespace yb::size_literals;
 
@@ -47,6 +52,14 @@ DEFINE_int64(remote_bootstrap_rate_limit_bytes_per_sec, 256_MB,
              "the total limit will be 2 * remote_bootstrap_rate_limit_bytes_per_sec because a "
              "tserver or master can act both as a sender and receiver at the same time.");
 
+DEFINE_RUNTIME_int32(remote_bootstrap_max_concurrent_file_downloads, 4,
+    "Maximum number of RocksDB files downloaded concurrently by a single remote bootstrap "
+    "session. The session rate limit is split between the concurrent downloads.");
+
+DEFINE_RUNTIME_bool(remote_bootstrap_link_local_source_files, true,
+    "Hard link RocksDB files of the remote bootstrap source, when it is located on the same host "
+    "and file system, instead of downloading them.");
+
 DEFINE_int32(bytes_remote_bootstrap_durable_write_mb, 1024,
              "Explicitly call fsync after downloading the specified amount of data in MB "
              "during a remote bootstrap session. If 0 fsync() is not called.");
@@ -102,16 +115,23 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   RETURN_NOT_OK(env().CreateDirs(DirName(file_path)));
 
   if (file_pb.inode() != 0) {
-    auto it = inode2file_.find(file_pb.inode());
-    if (it != inode2file_.end()) {
+    std::string existing_file;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = inode2file_.find(file_pb.inode());
+      if (it != inode2file_.end()) {
+        existing_file = it->second;
+      }
+    }
+    if (!existing_file.empty()) {
       VLOG_WITH_PREFIX(2) << "File with the same inode already found: " << file_path
-                          << " => " << it->second;
-      auto link_status = env().LinkFile(it->second, file_path);
+                          << " => " << existing_file;
+      auto link_status = env().LinkFile(existing_file, file_path);
       if (link_status.ok()) {
         return Status::OK();
       }
       // TODO fallback to copy.
-      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << it->second
+      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << existing_file
                              << ": " << link_status;
     }
   }
@@ -130,12 +150,84 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   VLOG_WITH_PREFIX(2) << "Downloaded file " << file_path;
 
   if (file_pb.inode() != 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
     inode2file_.emplace(file_pb.inode(), file_path);
   }
 
   return Status::OK();
 }
 
+Status RemoteBootstrapFileDownloader::DownloadFiles(
+    const google::protobuf::RepeatedPtrField<tablet::FilePB>& files, const std::string& dir,
+    DataIdPB::IdType type, const std::string& source_dir) {
+  auto download = [this, &dir, type, &source_dir](const tablet::FilePB& file_pb) {
+    if (!source_dir.empty() && TryLinkLocalSourceFile(file_pb, source_dir, dir)) {
+      return Status::OK();
+    }
+    DataIdPB data_id;
+    data_id.set_type(type);
+    auto start = MonoTime::Now();
+    RETURN_NOT_OK(DownloadFile(file_pb, dir, &data_id));
+    LOG_WITH_PREFIX(INFO)
+        << "Downloaded file " << file_pb.name() << " of size " << file_pb.size_bytes()
+        << " in " << (MonoTime::Now() - start).ToSeconds() << " seconds";
+    return Status::OK();
+  };
+
+  // Files that share inode with a file that is listed earlier are hard linked to it, so they are
+  // processed after all other files are downloaded.
+  std::vector<const tablet::FilePB*> to_download;
+  std::vector<const tablet::FilePB*> to_link;
+  {
+    std::unordered_set<uint64_t> inodes;
+    for (const auto& file_pb : files) {
+      if (file_pb.inode() != 0 && !inodes.insert(file_pb.inode()).second) {
+        to_link.push_back(&file_pb);
+      } else {
+        to_download.push_back(&file_pb);
+      }
+    }
+  }
+
+  auto max_concurrency = std::max(FLAGS_remote_bootstrap_max_concurrent_file_downloads, 1);
+  if (max_concurrency == 1 || to_download.size() <= 1) {
+    for (const auto* file_pb : to_download) {
+      RETURN_NOT_OK(download(*file_pb));
+    }
+  } else {
+    std::unique_ptr<ThreadPool> pool;
+    RETURN_NOT_OK(ThreadPoolBuilder("rb-download")
+                      .set_max_threads(std::min<int>(max_concurrency, to_download.size()))
+                      .Build(&pool));
+    std::mutex status_mutex;
+    Status status;
+    std::atomic<bool> failed{false};
+    for (const auto* file_pb : to_download) {
+      RETURN_NOT_OK(pool->SubmitFunc([&, file_pb] {
+        if (failed.load(std::memory_order_acquire)) {
+          return;
+        }
+        auto download_status = download(*file_pb);
+        if (!download_status.ok()) {
+          failed.store(true, std::memory_order_release);
+          std::lock_guard<std::mutex> lock(status_mutex);
+          if (status.ok()) {
+            status = std::move(download_status);
+          }
+        }
+      }));
+    }
+    pool->Wait();
+    pool->Shutdown();
+    RETURN_NOT_OK(status);
+  }
+
+  for (const auto* file_pb : to_link) {
+    RETURN_NOT_OK(download(*file_pb));
+  }
+  return Status::OK();
+}
+
 template<class Appendable>
 Status RemoteBootstrapFileDownloader::DownloadFile(
     const DataIdPB& data_id, Appendable* appendable) {
@@ -149,8 +241,13 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
 
   std::unique_ptr<RateLimiter> rate_limiter;
 
+  active_downloads_.fetch_add(1, std::memory_order_acq_rel);
+  auto se = ScopeExit([this] {
+    active_downloads_.fetch_sub(1, std::memory_order_acq_rel);
+  });
+
   if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0) {
-    static auto rate_updater = []() {
+    auto rate_updater = [this]() {
       auto remote_bootstrap_clients_started =
           remote_bootstrap_clients_started_.load(std::memory_order_acquire);
       if (remote_bootstrap_clients_started < 1) {
@@ -158,8 +255,11 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
                                    << remote_bootstrap_clients_started;
         return static_cast<uint64_t>(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec);
       }
+      auto active_downloads = std::max<size_t>(
+          active_downloads_.load(std::memory_order_acquire), 1);
       return static_cast<uint64_t>(
-          FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / remote_bootstrap_clients_started);
+          FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / remote_bootstrap_clients_started /
+          active_downloads);
     };
 
     rate_limiter = std::make_unique<RateLimiter>(rate_updater);
@@ -254,6 +354,50 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   return Status::OK();
 }
 
+bool RemoteBootstrapFileDownloader::TryLinkLocalSourceFile(
+    const tablet::FilePB& file_pb, const std::string& source_dir, const std::string& dir) {
+  if (!FLAGS_remote_bootstrap_link_local_source_files || file_pb.inode() == 0) {
+    return false;
+  }
+  // Only SST files are immutable, other files like MANIFEST could be modified by either side.
+  if (!boost::ends_with(file_pb.name(), ".sst") &&
+      !boost::ends_with(file_pb.name(), ".sst.sblock.0")) {
+    return false;
+  }
+  auto source_path = JoinPathSegments(source_dir, file_pb.name());
+  // Same path could exist on a different host, so the file is linked only when it is the same
+  // file as reported by the source.
+  auto inode = env().GetFileINode(source_path);
+  if (!inode.ok() || *inode != file_pb.inode()) {
+    return false;
+  }
+  auto size = env().GetFileSize(source_path);
+  if (!size.ok() || *size != file_pb.size_bytes()) {
+    return false;
+  }
+
+  auto file_path = JoinPathSegments(dir, file_pb.name());
+  auto status = env().CreateDirs(DirName(file_path));
+  if (status.ok() && env().FileExists(file_path)) {
+    status = env().DeleteFile(file_path);
+  }
+  if (status.ok()) {
+    // Fails when the source is on a different file system, the file is downloaded in this case.
+    status = env().LinkFile(source_path, file_path);
+  }
+  if (!status.ok()) {
+    VLOG_WITH_PREFIX(1) << "Failed to link local source file " << source_path << " => "
+                        << file_path << ": " << status;
+    return false;
+  }
+  VLOG_WITH_PREFIX(2) << "Linked local source file " << source_path << " => " << file_path;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    inode2file_.emplace(file_pb.inode(), file_path);
+  }
+  return true;
+}
+
 Status RemoteBootstrapFileDownloader::VerifyData(uint64_t offset, const DataChunkPB& chunk) {
   // Verify the offset is what we expected.
   if (offset != chunk.offset()) {
@@ -13,10 +13,16 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
+#include <google/protobuf/repeated_field.h>
+
+#include "yb/gutil/thread_annotations.h"
+
 #include "yb/rpc/rpc_fwd.h"
 
 #include "yb/tablet/metadata.pb.h"
@@ -47,6 +53,14 @@ class RemoteBootstrapFileDownloader {
   Status DownloadFile(
       const tablet::FilePB& file_pb, const std::string& dir, DataIdPB* data_id);
 
+  // Downloads the specified files of the same data type to dir, up to
+  // remote_bootstrap_max_concurrent_file_downloads files at a time.
+  // When source_dir is not empty, files that are found in it on this host, with the same inode as
+  // reported by the source, are hard linked instead of being downloaded.
+  Status DownloadFiles(
+      const google::protobuf::RepeatedPtrField<tablet::FilePB>& files, const std::string& dir,
+      DataIdPB::IdType type, const std::string& source_dir = std::string());
+
   // Download a single remote file. The block and WAL implementations delegate
   // to this method when downloading files.
   //
@@ -68,6 +82,11 @@ class RemoteBootstrapFileDownloader {
  private:
   Status VerifyData(uint64_t offset, const DataChunkPB& resp);
 
+  // Hard links the file of the source that is located on the same host and file system.
+  // Returns false if the file could not be linked, so it should be downloaded.
+  bool TryLinkLocalSourceFile(
+      const tablet::FilePB& file_pb, const std::string& source_dir, const std::string& dir);
+
   const std::string& LogPrefix() const {
     return log_prefix_;
   }
@@ -80,7 +99,12 @@ class RemoteBootstrapFileDownloader {
   std::shared_ptr<RemoteBootstrapServiceProxy> proxy_;
   std::string session_id_;
   MonoDelta session_idle_timeout_ = MonoDelta::kZero;
-  std::unordered_map<uint64_t, std::string> inode2file_;
+  // Number of files being downloaded by this downloader, the rate limit of the session is split
+  // between them.
+  std::atomic<size_t> active_downloads_{0};
+
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, std::string> inode2file_ GUARDED_BY(mutex_);
 };
 
 Status UnwindRemoteError(const Status& status, const rpc::RpcController& controller);
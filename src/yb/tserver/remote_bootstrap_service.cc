@@ -230,6 +230,7 @@ void RemoteBootstrapServiceImpl::BeginRemoteBootstrapSession(
   resp->set_session_idle_timeout_millis(FLAGS_remote_bootstrap_idle_timeout_ms);
   resp->mutable_superblock()->CopyFrom(session->tablet_superblock());
   resp->mutable_initial_committed_cstate()->CopyFrom(session->initial_committed_cstate());
+  resp->set_checkpoint_dir(session->checkpoint_dir());
 
   auto const& log_segments = session->log_segments();
   resp->mutable_deprecated_wal_segment_seqnos()->Reserve(narrow_cast<int>(log_segments.size()));
@@ -287,11 +288,9 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
     session = it->second.session;
   }
 
-  session->EnsureRateLimiterIsInitialized();
-
   MAYBE_FAULT(FLAGS_TEST_fault_crash_on_handle_rb_fetch_data);
 
-  int64_t rate_limit = session->rate_limiter().GetMaxSizeForNextTransmission();
+  int64_t rate_limit = session->GetMaxSizeForNextTransmission();
   VLOG(3) << " rate limiter max len: " << rate_limit;
   GetDataPieceInfo info = {
     .offset = req->offset(),
@@ -304,15 +303,15 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
   RPC_RETURN_NOT_OK(ValidateFetchRequestDataId(data_id, &info.error_code, session),
                     info.error_code, "Invalid DataId");
 
-  session->data_read_timer().resume();
+  auto read_start = MonoTime::Now();
   RPC_RETURN_NOT_OK(session->GetDataPiece(data_id, &info),
                     info.error_code, "Unable to get piece of data file");
-  session->data_read_timer().stop();
+  auto data_read_time = MonoTime::Now() - read_start;
 
-  session->rate_limiter().UpdateDataSizeAndMaybeSleep(info.data.size());
-  session->crc_compute_timer().resume();
+  session->UpdateDataSizeAndMaybeSleep(info.data.size());
+  auto crc_start = MonoTime::Now();
   uint32_t crc32 = Crc32c(info.data.data(), info.data.length());
-  session->crc_compute_timer().stop();
+  session->AddTimes(data_read_time, MonoTime::Now() - crc_start);
 
   DataChunkPB* data_chunk = resp->mutable_chunk();
   *data_chunk->mutable_data() = std::move(info.data);
@@ -454,11 +453,11 @@ Status RemoteBootstrapServiceImpl::DoEndRemoteBootstrapSession(
         << session->rate_limiter().GetRate() << ", RateLimiter total time slept: "
         << session->rate_limiter().total_time_slept() << ", Total bytes: "
         << total_bytes << ", Read rate "
-        << (total_bytes / session->data_read_timer().elapsed().wall_millis())
-        << " bytes/msec (Total ms: " << session->data_read_timer().elapsed().wall_millis()
+        << (total_bytes / session->data_read_time().ToMilliseconds())
+        << " bytes/msec (Total ms: " << session->data_read_time().ToMilliseconds()
         << "), CRC computation rate: "
-        << (total_bytes / session->crc_compute_timer().elapsed().wall_millis()) << " bytes/msec"
-        << "(Total ms: " << session->crc_compute_timer().elapsed().wall_millis() << ")";
+        << (total_bytes / session->crc_compute_time().ToMilliseconds()) << " bytes/msec"
+        << "(Total ms: " << session->crc_compute_time().ToMilliseconds() << ")";
     }
 
     if (PREDICT_FALSE(FLAGS_TEST_inject_latency_before_change_role_secs)) {
@@ -550,6 +550,35 @@ void RemoteBootstrapSession::EnsureRateLimiterIsInitialized() {
   }
 }
 
+int64_t RemoteBootstrapSession::GetMaxSizeForNextTransmission() {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  EnsureRateLimiterIsInitialized();
+  return rate_limiter_.GetMaxSizeForNextTransmission();
+}
+
+void RemoteBootstrapSession::UpdateDataSizeAndMaybeSleep(uint64_t data_size) {
+  // Sleeping while holding the mutex also delays the concurrent fetches of this session, that is
+  // desired since they share the rate limit.
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  rate_limiter_.UpdateDataSizeAndMaybeSleep(data_size);
+}
+
+void RemoteBootstrapSession::AddTimes(MonoDelta data_read_time, MonoDelta crc_compute_time) {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  data_read_time_ += data_read_time;
+  crc_compute_time_ += crc_compute_time;
+}
+
+MonoDelta RemoteBootstrapSession::data_read_time() {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  return data_read_time_;
+}
+
+MonoDelta RemoteBootstrapSession::crc_compute_time() {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  return crc_compute_time_;
+}
+
 Status RemoteBootstrapSession::RefreshRemoteLogAnchorSessionAsync() {
   if (rbs_anchor_client_ && rbs_anchor_session_created_) {
     RETURN_NOT_OK(rbs_anchor_client_->KeepLogAnchorAliveAsync());
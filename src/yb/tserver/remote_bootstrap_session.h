@@ -140,8 +140,18 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
 
   RateLimiter& rate_limiter() { return rate_limiter_; }
 
-  Stopwatch& crc_compute_timer() { return crc_compute_timer_; }
-  Stopwatch& data_read_timer() { return data_read_timer_; }
+  const std::string& checkpoint_dir() const { return checkpoint_dir_; }
+
+  // Thread safe wrappers of the rate limiter, since the client could fetch several files of the
+  // session concurrently. The rate limiter is initialized by the first call.
+  int64_t GetMaxSizeForNextTransmission() EXCLUDES(rate_limiter_mutex_);
+  void UpdateDataSizeAndMaybeSleep(uint64_t data_size) EXCLUDES(rate_limiter_mutex_);
+
+  // Accumulated time spent on reading data and calculating checksums by this session.
+  void AddTimes(MonoDelta data_read_time, MonoDelta crc_compute_time)
+      EXCLUDES(rate_limiter_mutex_);
+  MonoDelta data_read_time() EXCLUDES(rate_limiter_mutex_);
+  MonoDelta crc_compute_time() EXCLUDES(rate_limiter_mutex_);
 
   static const std::string kCheckpointsDir;
 
@@ -229,9 +239,11 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   // Time when this session was initialized.
   MonoTime start_time_;
 
-  // Stopwatch to capture the latency of different operations
-  Stopwatch crc_compute_timer_;
-  Stopwatch data_read_timer_;
+  std::mutex rate_limiter_mutex_;
+
+  // Latency of different operations
+  MonoDelta crc_compute_time_ GUARDED_BY(rate_limiter_mutex_) = MonoDelta::kZero;
+  MonoDelta data_read_time_ GUARDED_BY(rate_limiter_mutex_) = MonoDelta::kZero;
 
   // Used to limit the transmission rate.
   RateLimiter rate_limiter_;
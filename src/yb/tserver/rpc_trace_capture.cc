@@ -0,0 +1,182 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/rpc_trace_capture.h"
+
+#include "yb/tserver/tserver.pb.h"
+
+#include "yb/util/env.h"
+#include "yb/util/flags.h"
+#include "yb/util/logging.h"
+#include "yb/util/pb_util.h"
+#include "yb/util/random_util.h"
+#include "yb/util/status_log.h"
+
+DEFINE_RUNTIME_string(rpc_trace_capture_file, "",
+    "When not empty, a sample of Write and Read RPCs received by the tablet server is captured "
+    "to this file, that could be replayed with yb-rpc-replay. Changing the flag starts a new "
+    "capture, existing file is overwritten.");
+
+DEFINE_RUNTIME_uint32(rpc_trace_capture_sample_one_in_n, 100,
+    "Fraction of Write and Read RPCs captured to rpc_trace_capture_file is "
+    "1 / rpc_trace_capture_sample_one_in_n.");
+
+DEFINE_RUNTIME_bool(rpc_trace_capture_redact_values, true,
+    "Replace string and binary values of non key columns in captured writes with filler of the "
+    "same size.");
+
+DEFINE_RUNTIME_uint64(rpc_trace_capture_max_entries, 1000000,
+    "Capture to rpc_trace_capture_file stops after this number of RPCs.");
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+void RedactValue(QLValuePB* value) {
+  switch (value->value_case()) {
+    case QLValuePB::kStringValue:
+      value->set_string_value(std::string(value->string_value().size(), 'x'));
+      return;
+    case QLValuePB::kBinaryValue:
+      value->set_binary_value(std::string(value->binary_value().size(), 'x'));
+      return;
+    default:
+      return;
+  }
+}
+
+template <class ColumnValues>
+void RedactColumnValues(ColumnValues* column_values) {
+  for (auto& column_value : *column_values) {
+    if (column_value.has_expr() && column_value.expr().has_value()) {
+      RedactValue(column_value.mutable_expr()->mutable_value());
+    }
+  }
+}
+
+void Redact(WriteRequestPB* req) {
+  for (auto& ql_req : *req->mutable_ql_write_batch()) {
+    RedactColumnValues(ql_req.mutable_column_values());
+  }
+  for (auto& pgsql_req : *req->mutable_pgsql_write_batch()) {
+    RedactColumnValues(pgsql_req.mutable_column_values());
+    RedactColumnValues(pgsql_req.mutable_column_new_values());
+  }
+}
+
+} // namespace
+
+RpcTraceCapture::RpcTraceCapture() {
+  WARN_NOT_OK(Reload(), "Failed to start RPC trace capture");
+  auto registration = RegisterFlagUpdateCallback(
+      &FLAGS_rpc_trace_capture_file, "RpcTraceCapture", [this] {
+    WARN_NOT_OK(Reload(), "Failed to start RPC trace capture");
+  });
+  if (registration.ok()) {
+    flag_callback_ = std::move(*registration);
+  } else {
+    LOG(WARNING) << "Failed to register RPC trace capture callback: " << registration.status();
+  }
+}
+
+RpcTraceCapture::~RpcTraceCapture() {
+  flag_callback_.Deregister();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (file_) {
+    WARN_NOT_OK(file_->Close(), "Failed to close RPC trace capture file");
+  }
+}
+
+Status RpcTraceCapture::Reload() {
+  std::string path = FLAGS_rpc_trace_capture_file;
+  std::lock_guard<std::mutex> lock(mutex_);
+  active_.store(false, std::memory_order_release);
+  if (file_) {
+    auto status = file_->Close();
+    file_.reset();
+    LOG(INFO) << "Stopped RPC trace capture after " << num_entries_ << " entries";
+    RETURN_NOT_OK(status);
+  }
+  if (path.empty()) {
+    return Status::OK();
+  }
+
+  std::unique_ptr<WritableFile> writable_file;
+  RETURN_NOT_OK(Env::Default()->NewWritableFile(path, &writable_file));
+  auto file = std::make_unique<WritablePBContainerFile>(std::move(writable_file));
+  RETURN_NOT_OK(file->Init(RpcTraceEntryPB()));
+  file_ = std::move(file);
+  start_ = MonoTime::Now();
+  num_entries_ = 0;
+  active_.store(true, std::memory_order_release);
+  LOG(INFO) << "Started RPC trace capture to " << path;
+  return Status::OK();
+}
+
+uint32_t RpcTraceCapture::Sample() const {
+  uint32_t one_in_n = GetAtomicFlag(&FLAGS_rpc_trace_capture_sample_one_in_n);
+  if (one_in_n <= 1) {
+    return 1;
+  }
+  return RandomWithChance(one_in_n) ? one_in_n : 0;
+}
+
+void RpcTraceCapture::Record(const WriteRequestPB& req) {
+  auto sample_one_in_n = Sample();
+  if (!sample_one_in_n) {
+    return;
+  }
+  RpcTraceEntryPB entry;
+  entry.set_sample_one_in_n(sample_one_in_n);
+  entry.set_request_bytes(req.ByteSizeLong());
+  auto* write = entry.mutable_write();
+  *write = req;
+  if (GetAtomicFlag(&FLAGS_rpc_trace_capture_redact_values)) {
+    Redact(write);
+  }
+  Append(&entry);
+}
+
+void RpcTraceCapture::Record(const ReadRequestPB& req) {
+  auto sample_one_in_n = Sample();
+  if (!sample_one_in_n) {
+    return;
+  }
+  RpcTraceEntryPB entry;
+  entry.set_sample_one_in_n(sample_one_in_n);
+  entry.set_request_bytes(req.ByteSizeLong());
+  *entry.mutable_read() = req;
+  Append(&entry);
+}
+
+void RpcTraceCapture::Append(RpcTraceEntryPB* entry) {
+  auto now = MonoTime::Now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!file_) {
+    return;
+  }
+  entry->set_offset_us((now - start_).ToMicroseconds());
+  auto status = file_->Append(*entry);
+  if (status.ok() && ++num_entries_ < GetAtomicFlag(&FLAGS_rpc_trace_capture_max_entries)) {
+    return;
+  }
+  WARN_NOT_OK(status, "Failed to append RPC trace entry");
+  WARN_NOT_OK(file_->Close(), "Failed to close RPC trace capture file");
+  file_.reset();
+  active_.store(false, std::memory_order_release);
+  LOG(INFO) << "Stopped RPC trace capture after " << num_entries_ << " entries";
+}
+
+}  // namespace tserver
+}  // namespace yb
@@ -0,0 +1,67 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/tserver/tserver_fwd.h"
+
+#include "yb/util/flags/flags_callback.h"
+#include "yb/util/monotime.h"
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+
+class WritablePBContainerFile;
+
+namespace tserver {
+
+// Captures a sample of Write and Read RPCs received by the tablet server to the file specified by
+// rpc_trace_capture_file. The file is a protobuf container of RpcTraceEntryPB, that could be
+// replayed against another cluster with yb-rpc-replay, or printed with yb-pbc-dump.
+class RpcTraceCapture {
+ public:
+  RpcTraceCapture();
+  ~RpcTraceCapture();
+
+  bool enabled() const {
+    return active_.load(std::memory_order_acquire);
+  }
+
+  void Record(const WriteRequestPB& req);
+  void Record(const ReadRequestPB& req);
+
+  // Closes the current file and starts capture to the file specified by rpc_trace_capture_file.
+  Status Reload();
+
+ private:
+  // Returns sampling weight of the request, 0 when it should not be captured.
+  uint32_t Sample() const;
+
+  void Append(RpcTraceEntryPB* entry);
+
+  std::mutex mutex_;
+  std::unique_ptr<WritablePBContainerFile> file_ GUARDED_BY(mutex_);
+  MonoTime start_ GUARDED_BY(mutex_);
+  uint64_t num_entries_ GUARDED_BY(mutex_) = 0;
+  std::atomic<bool> active_{false};
+  FlagCallbackRegistration flag_callback_;
+};
+
+}  // namespace tserver
+}  // namespace yb
@@ -310,6 +310,23 @@ Result<TabletPeerTablet> LookupTabletPeer(
   return DoLookupTabletPeer(tablet_manager, tablet_id);
 }
 
+Result<int64_t> CheckFollowerStaleness(
+    const tablet::TabletPeer& tablet_peer, uint64_t max_staleness_ms) {
+  // TODO(hector): This safe time could be reused by the read operation.
+  auto tablet = VERIFY_RESULT(tablet_peer.shared_tablet_safe());
+  auto safe_time_micros = tablet->mvcc_manager()->SafeTimeForFollower(
+      HybridTime::kMin, CoarseTimePoint::min()).GetPhysicalValueMicros();
+  auto now_micros = tablet_peer.clock_ptr()->Now().GetPhysicalValueMicros();
+  auto follower_staleness_us = static_cast<int64_t>(now_micros - safe_time_micros);
+  if (follower_staleness_us > static_cast<int64_t>(max_staleness_ms * 1000)) {
+    VLOG(1) << "Rejecting stale read with staleness " << follower_staleness_us << "us, max: "
+            << max_staleness_ms << "ms";
+    return STATUS(
+        IllegalState, "Stale follower", TabletServerError(TabletServerErrorPB::STALE_FOLLOWER));
+  }
+  return follower_staleness_us;
+}
+
 Result<std::shared_ptr<tablet::AbstractTablet>> GetTablet(
     TabletPeerLookupIf* tablet_manager, const TabletId& tablet_id,
     tablet::TabletPeerPtr tablet_peer, YBConsistencyLevel consistency_level,
@@ -342,20 +359,8 @@ Result<std::shared_ptr<tablet::AbstractTablet>> GetTablet(
     // than FLAGS_max_stale_read_bound_time_ms.
     if (PREDICT_FALSE(!s.ok())) {
       if (FLAGS_max_stale_read_bound_time_ms > 0) {
-        auto consensus = tablet_peer->shared_consensus();
-        // TODO(hector): This safe time could be reused by the read operation.
-        auto tablet = VERIFY_RESULT(tablet_peer->shared_tablet_safe());
-        auto safe_time_micros = tablet->mvcc_manager()->SafeTimeForFollower(
-            HybridTime::kMin, CoarseTimePoint::min()).GetPhysicalValueMicros();
-        auto now_micros = tablet_peer->clock_ptr()->Now().GetPhysicalValueMicros();
-        auto follower_staleness_us = now_micros - safe_time_micros;
-        if (follower_staleness_us > FLAGS_max_stale_read_bound_time_ms * 1000) {
-          VLOG(1) << "Rejecting stale read with staleness "
-                     << follower_staleness_us << "us";
-          return STATUS(
-              IllegalState, "Stale follower",
-              TabletServerError(TabletServerErrorPB::STALE_FOLLOWER));
-        }
+        auto follower_staleness_us = VERIFY_RESULT(CheckFollowerStaleness(
+            *tablet_peer, FLAGS_max_stale_read_bound_time_ms));
         if (PREDICT_FALSE(
             FLAGS_TEST_assert_reads_from_follower_rejected_because_of_staleness)) {
           LOG(FATAL) << "--TEST_assert_reads_from_follower_rejected_because_of_staleness is true,"
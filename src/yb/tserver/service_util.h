@@ -234,6 +234,11 @@ Status CheckPeerIsLeader(const tablet::TabletPeer& tablet_peer);
 Status CheckPeerIsReady(
     const tablet::TabletPeer& tablet_peer, AllowSplitTablet allow_split_tablet);
 
+// Returns STALE_FOLLOWER error when safe time of the follower lags behind the current time by more
+// than max_staleness_ms. Otherwise returns the staleness of the follower in microseconds.
+Result<int64_t> CheckFollowerStaleness(
+    const tablet::TabletPeer& tablet_peer, uint64_t max_staleness_ms);
+
 Result<std::shared_ptr<tablet::AbstractTablet>> GetTablet(
     TabletPeerLookupIf* tablet_manager, const TabletId& tablet_id,
     tablet::TabletPeerPtr tablet_peer, YBConsistencyLevel consistency_level,
@@ -0,0 +1,127 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <string>
+
+#include "yb/tserver/table_quotas.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/status.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+DECLARE_string(table_quotas);
+
+namespace yb {
+namespace tserver {
+
+class TableQuotasTest : public YBTest {
+ protected:
+  Status Reload(const std::string& quotas) {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_table_quotas) = quotas;
+    return quotas_.Reload();
+  }
+
+  TableQuotas quotas_{nullptr};
+};
+
+TEST_F(TableQuotasTest, TokenBucketRefill) {
+  auto now = CoarseMonoClock::now();
+  QuotaTokenBucket bucket(10);
+  ASSERT_EQ(bucket.TimeUntilAvailable(now), MonoDelta::kZero);
+
+  // Charge is accounted even when it exceeds available tokens.
+  bucket.Charge(15, now);
+  auto delay = bucket.TimeUntilAvailable(now);
+  ASSERT_GE(delay, 500ms);
+  ASSERT_LE(delay, 510ms);
+
+  // Debt is paid off by refill.
+  ASSERT_GT(bucket.TimeUntilAvailable(now + 400ms), MonoDelta::kZero);
+  ASSERT_EQ(bucket.TimeUntilAvailable(now + 600ms), MonoDelta::kZero);
+}
+
+TEST_F(TableQuotasTest, TokenBucketBurst) {
+  auto now = CoarseMonoClock::now();
+  QuotaTokenBucket bucket(10);
+
+  // Idle bucket accumulates at most one second worth of tokens.
+  now += 10s;
+  bucket.Charge(10, now);
+  ASSERT_GT(bucket.TimeUntilAvailable(now), MonoDelta::kZero);
+  ASSERT_EQ(bucket.TimeUntilAvailable(now + 200ms), MonoDelta::kZero);
+}
+
+TEST_F(TableQuotasTest, Reload) {
+  ASSERT_FALSE(quotas_.enabled());
+
+  ASSERT_OK(Reload(" ns1:0:100 , ns2/table:10:0,,ns3:0:0 "));
+  ASSERT_TRUE(quotas_.enabled());
+
+  // Request over the bytes quota goes into debt, so the following request is rejected.
+  ASSERT_OK(quotas_.TEST_Consume("ns1", "table", 200));
+  auto status = quotas_.TEST_Consume("ns1", "table", 1);
+  ASSERT_TRUE(status.IsServiceUnavailable()) << status;
+  ASSERT_STR_CONTAINS(status.ToString(), "Quota of ns1 exceeded");
+
+  // Only the table of ns2 has quota.
+  for (int i = 0; i != 20; ++i) {
+    ASSERT_OK(quotas_.TEST_Consume("ns2", "other_table", 1000));
+  }
+
+  // Zero stands for no limit.
+  for (int i = 0; i != 20; ++i) {
+    ASSERT_OK(quotas_.TEST_Consume("ns3", "table", 1000));
+  }
+
+  // Namespace without quota.
+  ASSERT_OK(quotas_.TEST_Consume("ns4", "table", 1000));
+
+  for (const auto* wrong_quota : {"ns1:10", "ns1:10:10:10", ":10:10"}) {
+    ASSERT_NOK(Reload(wrong_quota)) << wrong_quota;
+  }
+
+  // Removing quotas disables them.
+  ASSERT_OK(Reload(""));
+  ASSERT_FALSE(quotas_.enabled());
+}
+
+TEST_F(TableQuotasTest, TableScopeOverNamespace) {
+  ASSERT_OK(Reload("ns:0:100,ns/table:0:1000000"));
+
+  // Table with its own quota is not limited by the namespace quota.
+  for (int i = 0; i != 10; ++i) {
+    ASSERT_OK(quotas_.TEST_Consume("ns", "table", 200));
+  }
+
+  // Other tables of the namespace share its quota.
+  ASSERT_OK(quotas_.TEST_Consume("ns", "table1", 200));
+  auto status = quotas_.TEST_Consume("ns", "table2", 1);
+  ASSERT_TRUE(status.IsServiceUnavailable()) << status;
+  ASSERT_STR_CONTAINS(status.ToString(), "Quota of ns exceeded");
+
+  // Exhausted namespace quota does not affect the table quota.
+  ASSERT_OK(quotas_.TEST_Consume("ns", "table", 200));
+
+  ASSERT_OK(Reload("ns:0:1000000,ns/table:0:100"));
+  ASSERT_OK(quotas_.TEST_Consume("ns", "table", 200));
+  status = quotas_.TEST_Consume("ns", "table", 1);
+  ASSERT_TRUE(status.IsServiceUnavailable()) << status;
+  ASSERT_STR_CONTAINS(status.ToString(), "Quota of ns/table exceeded");
+  ASSERT_OK(quotas_.TEST_Consume("ns", "table1", 200));
+}
+
+}  // namespace tserver
+}  // namespace yb
@@ -0,0 +1,268 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/table_quotas.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+
+#include "yb/gutil/map-util.h"
+
+#include "yb/tablet/tablet_metadata.h"
+
+#include "yb/tserver/tserver_error.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/format.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/result.h"
+#include "yb/util/shared_lock.h"
+#include "yb/util/status_format.h"
+#include "yb/util/stol_utils.h"
+
+DEFINE_RUNTIME_string(table_quotas, "",
+    "Comma separated list of per tablet server quotas on reads and writes, in the format "
+    "<namespace>[/<table>]:<ops_per_sec>:<bytes_per_sec>. Quota of the namespace is shared by "
+    "all its tables, that do not have their own quota. Request and read response sizes are "
+    "accounted as bytes. 0 means no limit. Requests over the quota are rejected with the delay "
+    "after which they could be retried.");
+
+DEFINE_RUNTIME_uint64(table_quota_max_retry_delay_ms, 1000,
+    "Max retry delay returned to the client, whose request was rejected by table_quotas.");
+
+METRIC_DEFINE_counter(server, table_quota_rejections,
+                      "Requests Rejected By Table Quotas", yb::MetricUnit::kRequests,
+                      "Number of read and write requests rejected because the quota of their "
+                      "table or namespace was exhausted.");
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+std::string TableScope(const std::string& namespace_name, const std::string& table_name) {
+  return namespace_name + "/" + table_name;
+}
+
+std::unique_ptr<QuotaTokenBucket> MakeBucket(Slice limit) {
+  auto rate = CheckedStoll(limit);
+  if (!rate.ok() || *rate <= 0) {
+    return nullptr;
+  }
+  return std::make_unique<QuotaTokenBucket>(*rate);
+}
+
+} // namespace
+
+QuotaTokenBucket::QuotaTokenBucket(double rate)
+    : rate_(rate), tokens_(rate), last_refill_(CoarseMonoClock::now()) {
+}
+
+void QuotaTokenBucket::Refill(CoarseTimePoint now) {
+  if (now <= last_refill_) {
+    return;
+  }
+  auto seconds = MonoDelta(now - last_refill_).ToSeconds();
+  tokens_ = std::min(tokens_ + seconds * rate_, rate_);
+  last_refill_ = now;
+}
+
+MonoDelta QuotaTokenBucket::TimeUntilAvailable(CoarseTimePoint now) {
+  Refill(now);
+  if (tokens_ > 0) {
+    return MonoDelta::kZero;
+  }
+  // Bucket is in debt, so request could be retried when debt is paid off.
+  return std::max(MonoDelta::FromSeconds(-tokens_ / rate_), MonoDelta::FromNanoseconds(1));
+}
+
+void QuotaTokenBucket::Charge(double amount, CoarseTimePoint now) {
+  Refill(now);
+  tokens_ -= amount;
+}
+
+class TableQuotas::Quota {
+ public:
+  Quota(std::unique_ptr<QuotaTokenBucket> ops, std::unique_ptr<QuotaTokenBucket> bytes)
+      : ops_(std::move(ops)), bytes_(std::move(bytes)) {}
+
+  // Consumes one operation and the request bytes if both buckets have tokens. Otherwise returns
+  // the time after which they would be available.
+  MonoDelta Consume(size_t request_bytes, CoarseTimePoint now) {
+    std::lock_guard<simple_spinlock> lock(mutex_);
+    // Quota is checked before consuming, so rejected request does not consume any of it.
+    auto delay = MonoDelta::kZero;
+    for (auto* bucket : {ops_.get(), bytes_.get()}) {
+      if (bucket) {
+        delay = std::max(delay, bucket->TimeUntilAvailable(now));
+      }
+    }
+    if (delay == MonoDelta::kZero) {
+      if (ops_) {
+        ops_->Charge(1, now);
+      }
+      if (bytes_) {
+        bytes_->Charge(request_bytes, now);
+      }
+    }
+    return delay;
+  }
+
+  void Charge(size_t bytes, CoarseTimePoint now) {
+    if (!bytes_) {
+      return;
+    }
+    std::lock_guard<simple_spinlock> lock(mutex_);
+    bytes_->Charge(bytes, now);
+  }
+
+ private:
+  simple_spinlock mutex_;
+  const std::unique_ptr<QuotaTokenBucket> ops_ PT_GUARDED_BY(mutex_);
+  const std::unique_ptr<QuotaTokenBucket> bytes_ PT_GUARDED_BY(mutex_);
+};
+
+TableQuotas::TableQuotas(const scoped_refptr<MetricEntity>& metric_entity) {
+  if (metric_entity) {
+    rejections_ = METRIC_table_quota_rejections.Instantiate(metric_entity);
+  }
+  WARN_NOT_OK(Reload(), "Failed to load table quotas");
+  auto registration = RegisterFlagUpdateCallback(&FLAGS_table_quotas, "TableQuotas", [this] {
+    WARN_NOT_OK(Reload(), "Failed to load table quotas");
+  });
+  if (registration.ok()) {
+    flag_callback_ = std::move(*registration);
+  } else {
+    LOG(WARNING) << "Failed to register table quotas callback: " << registration.status();
+  }
+}
+
+TableQuotas::~TableQuotas() {
+  flag_callback_.Deregister();
+}
+
+Status TableQuotas::Reload() {
+  std::vector<std::string> entries;
+  std::string flag_value = FLAGS_table_quotas;
+  boost::split(entries, flag_value, boost::is_any_of(","));
+  std::unordered_map<std::string, QuotaPtr> quotas;
+  for (auto& entry : entries) {
+    boost::trim(entry);
+    if (entry.empty()) {
+      continue;
+    }
+    std::vector<std::string> parts;
+    boost::split(parts, entry, boost::is_any_of(":"));
+    if (parts.size() != 3 || parts[0].empty()) {
+      return STATUS_FORMAT(InvalidArgument, "Wrong table quota: $0", entry);
+    }
+    quotas[parts[0]] = std::make_shared<Quota>(MakeBucket(parts[1]), MakeBucket(parts[2]));
+  }
+
+  std::lock_guard<rw_spinlock> lock(mutex_);
+  quotas_ = std::move(quotas);
+  table_quotas_.clear();
+  has_quotas_.store(!quotas_.empty(), std::memory_order_release);
+  return Status::OK();
+}
+
+TableQuotas::TableQuotaPtr TableQuotas::ResolveTableQuota(
+    const std::string& namespace_name, const std::string& table_name) {
+  auto result = std::make_shared<TableQuota>();
+  result->scope = TableScope(namespace_name, table_name);
+  result->quota = FindPtrOrNull(quotas_, result->scope);
+  if (!result->quota) {
+    result->scope = namespace_name;
+    result->quota = FindPtrOrNull(quotas_, namespace_name);
+  }
+  return result;
+}
+
+Result<TableQuotas::TableQuotaPtr> TableQuotas::GetTableQuota(
+    const tablet::RaftGroupMetadata& metadata, const TableId& table_id) {
+  if (table_id.empty()) {
+    return GetTableQuota(metadata, metadata.table_id());
+  }
+  {
+    SharedLock<rw_spinlock> lock(mutex_);
+    auto it = table_quotas_.find(table_id);
+    if (it != table_quotas_.end()) {
+      return it->second;
+    }
+  }
+
+  // Table of colocated tablet is not the primary table of the tablet, so its names are taken from
+  // the table info.
+  auto table_info = VERIFY_RESULT(metadata.GetTableInfo(table_id));
+  std::lock_guard<rw_spinlock> lock(mutex_);
+  auto& result = table_quotas_[table_id];
+  if (!result) {
+    result = ResolveTableQuota(table_info->namespace_name, table_info->table_name);
+  }
+  return result;
+}
+
+Status TableQuotas::Consume(
+    const tablet::RaftGroupMetadata& metadata, const TableId& table_id, size_t request_bytes) {
+  if (!has_quotas_.load(std::memory_order_acquire)) {
+    return Status::OK();
+  }
+  return DoConsume(*VERIFY_RESULT(GetTableQuota(metadata, table_id)), request_bytes);
+}
+
+Status TableQuotas::TEST_Consume(
+    const std::string& namespace_name, const std::string& table_name, size_t request_bytes) {
+  TableQuotaPtr table_quota;
+  {
+    SharedLock<rw_spinlock> lock(mutex_);
+    table_quota = ResolveTableQuota(namespace_name, table_name);
+  }
+  return DoConsume(*table_quota, request_bytes);
+}
+
+Status TableQuotas::DoConsume(const TableQuota& table_quota, size_t request_bytes) {
+  if (!table_quota.quota) {
+    return Status::OK();
+  }
+  auto delay = table_quota.quota->Consume(request_bytes, CoarseMonoClock::now());
+  if (delay == MonoDelta::kZero) {
+    return Status::OK();
+  }
+
+  if (rejections_) {
+    rejections_->Increment();
+  }
+  delay = std::min(
+      delay, MonoDelta::FromMilliseconds(GetAtomicFlag(&FLAGS_table_quota_max_retry_delay_ms)));
+  return STATUS(
+      ServiceUnavailable, Format("Quota of $0 exceeded", table_quota.scope),
+      TabletServerDelay(std::max(delay, MonoDelta::FromMilliseconds(1))));
+}
+
+void TableQuotas::Charge(
+    const tablet::RaftGroupMetadata& metadata, const TableId& table_id, size_t bytes) {
+  if (!has_quotas_.load(std::memory_order_acquire) || bytes == 0) {
+    return;
+  }
+  auto table_quota = GetTableQuota(metadata, table_id);
+  if (table_quota.ok() && (**table_quota).quota) {
+    (**table_quota).quota->Charge(bytes, CoarseMonoClock::now());
+  }
+}
+
+}  // namespace tserver
+}  // namespace yb
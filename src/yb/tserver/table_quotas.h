@@ -0,0 +1,131 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "yb/common/entity_ids_types.h"
+
+#include "yb/gutil/ref_counted.h"
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/tablet/tablet_fwd.h"
+
+#include "yb/util/flags/flags_callback.h"
+#include "yb/util/locks.h"
+#include "yb/util/metrics_fwd.h"
+#include "yb/util/monotime.h"
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+namespace tserver {
+
+// Token bucket, that allows rate per second with burst of one second worth of tokens.
+// Tokens could be charged after the operation, so the bucket goes into debt that is paid off by
+// the following operations.
+class QuotaTokenBucket {
+ public:
+  explicit QuotaTokenBucket(double rate);
+
+  // Returns zero when the bucket has tokens, otherwise the time after which they would be
+  // available.
+  MonoDelta TimeUntilAvailable(CoarseTimePoint now);
+
+  // Consumes tokens without checking whether they are available.
+  void Charge(double amount, CoarseTimePoint now);
+
+  double rate() const {
+    return rate_;
+  }
+
+ private:
+  void Refill(CoarseTimePoint now);
+
+  const double rate_;
+  double tokens_;
+  CoarseTimePoint last_refill_;
+};
+
+// Tablet server level limits of the rate of reads and writes to the namespace or table, configured
+// by table_quotas flag. Requests over the quota are rejected with ServiceUnavailable, that
+// contains the delay after which the request could be retried.
+class TableQuotas {
+ public:
+  explicit TableQuotas(const scoped_refptr<MetricEntity>& metric_entity);
+  ~TableQuotas();
+
+  bool enabled() const {
+    return has_quotas_.load(std::memory_order_acquire);
+  }
+
+  // Checks quota of the table with specified id, or of its namespace if the table does not have
+  // its own quota, and consumes one operation and the request bytes from it.
+  // Empty table_id stands for the primary table of the tablet.
+  Status Consume(
+      const tablet::RaftGroupMetadata& metadata, const TableId& table_id, size_t request_bytes);
+
+  // Charges bytes that are known only after the operation was executed, like size of the read
+  // response.
+  void Charge(const tablet::RaftGroupMetadata& metadata, const TableId& table_id, size_t bytes);
+
+  // Parses table_quotas flag and replaces current quotas with it.
+  Status Reload();
+
+  // Same as Consume, but for the table with specified names.
+  Status TEST_Consume(
+      const std::string& namespace_name, const std::string& table_name, size_t request_bytes);
+
+ private:
+  class Quota;
+  using QuotaPtr = std::shared_ptr<Quota>;
+
+  // Quota that is applied to the table, if any, and its scope.
+  struct TableQuota {
+    QuotaPtr quota;
+    std::string scope;
+  };
+  using TableQuotaPtr = std::shared_ptr<const TableQuota>;
+
+  // Returns quota of the table, resolving it on the first request to the table after reload.
+  Result<TableQuotaPtr> GetTableQuota(
+      const tablet::RaftGroupMetadata& metadata, const TableId& table_id) EXCLUDES(mutex_);
+
+  TableQuotaPtr ResolveTableQuota(
+      const std::string& namespace_name, const std::string& table_name) REQUIRES_SHARED(mutex_);
+
+  Status DoConsume(const TableQuota& table_quota, size_t request_bytes);
+
+  rw_spinlock mutex_;
+  // Quotas by scope, which is namespace name or namespace name and table name separated by '/'.
+  std::unordered_map<std::string, QuotaPtr> quotas_ GUARDED_BY(mutex_);
+  // Quotas resolved by table id. Cleared on reload.
+  std::unordered_map<TableId, TableQuotaPtr> table_quotas_ GUARDED_BY(mutex_);
+  std::atomic<bool> has_quotas_{false};
+  scoped_refptr<Counter> rejections_;
+  FlagCallbackRegistration flag_callback_;
+};
+
+// Returns id of the table of the first YSQL operation of the request, that is used to check its
+// quota. Empty id stands for the primary table of the tablet, used by requests of other APIs.
+template <class Ops>
+const TableId& QuotaTableId(const Ops& pgsql_ops) {
+  static const TableId kPrimaryTable;
+  return pgsql_ops.empty() ? kPrimaryTable : pgsql_ops.begin()->table_id();
+}
+
+}  // namespace tserver
+}  // namespace yb
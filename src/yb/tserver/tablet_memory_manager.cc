@@ -13,6 +13,8 @@
 
 #include "yb/tserver/tablet_memory_manager.h"
 
+#include <algorithm>
+
 #include "yb/consensus/log_cache.h"
 #include "yb/consensus/raft_consensus.h"
 
@@ -22,6 +24,8 @@
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/memory_monitor.h"
 
+#include "yb/server/clock.h"
+
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_options.h"
 #include "yb/tablet/tablet_peer.h"
@@ -30,6 +34,7 @@
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/mem_tracker.h"
+#include "yb/util/metrics.h"
 #include "yb/util/status_log.h"
 
 using namespace std::literals;
@@ -76,9 +81,45 @@ DEFINE_int32(db_block_cache_num_shard_bits, 4,
              "Number of bits to use for sharding the block cache (defaults to 4 bits)");
 TAG_FLAG(db_block_cache_num_shard_bits, advanced);
 
+DEFINE_int64(db_compressed_block_cache_size_bytes, 0,
+             "Size of RocksDB cache of compressed blocks (in bytes), that is looked up on miss of "
+             "the block cache before reading the block from disk. Compressed blocks are smaller, "
+             "so this cache holds more data than the block cache of the same size. 0 disables "
+             "compressed block cache.");
+TAG_FLAG(db_compressed_block_cache_size_bytes, advanced);
+
+DEFINE_RUNTIME_int32(memstore_max_unflushed_age_secs, 0,
+    "Flush the tablet whose oldest memstore write is older than this number of seconds, so the "
+    "WAL tail replayed by the tablet bootstrap is bounded for tablets with rare writes. "
+    "0 disables age based flushes.");
+
+DEFINE_RUNTIME_bool(enable_memory_pressure_memstore_flush, true,
+    "When the soft memory limit of the server is exceeded, evict the log cache of all tablets "
+    "and, if it is not enough, flush the tablet with the oldest memstore write, before writes "
+    "are rejected.");
+
+DEFINE_RUNTIME_bool(memstore_flush_largest_first, true,
+    "When the global memstore limit is reached, flush tablets with the largest mutable memtables "
+    "until the memory freed by the flushes reaches memstore_flush_target_percentage of the limit. "
+    "Otherwise, flush tablets with the oldest memstore write one by one.");
+
+DEFINE_RUNTIME_int32(memstore_flush_target_percentage, 80,
+    "Percentage of the global memstore limit that memstore usage is reduced to by the flushes "
+    "started when the limit is reached, if memstore_flush_largest_first is set.");
+
 DEFINE_test_flag(bool, pretend_memory_exceeded_enforce_flush, false,
                   "Always pretend memory has been exceeded to enforce background flush.");
 
+METRIC_DEFINE_counter(server, memory_pressure_log_cache_evicted_bytes,
+                      "Log Cache Bytes Evicted On Memory Pressure", yb::MetricUnit::kBytes,
+                      "Number of bytes evicted from the log cache because the soft memory limit "
+                      "of the server was exceeded.");
+
+METRIC_DEFINE_counter(server, memory_pressure_memstore_flushes,
+                      "Memstore Flushes On Memory Pressure", yb::MetricUnit::kOperations,
+                      "Number of memstore flushes started because the soft memory limit of the "
+                      "server was exceeded.");
+
 namespace yb {
 namespace tserver {
 
@@ -86,6 +127,8 @@ using strings::Substitute;
 
 namespace {
 
+constexpr auto kOldMemstoreCheckInterval = 10s;
+
 class FunctorGC : public GarbageCollector {
  public:
   explicit FunctorGC(std::function<void(size_t)> impl) : impl_(std::move(impl)) {}
@@ -165,8 +208,12 @@ TabletMemoryManager::TabletMemoryManager(
   InitLogCacheGC();
   // Assign background_task_ if necessary.
   ConfigureBackgroundTask(options);
+  // Must be initialized after background_task_, since the collector wakes it.
+  InitMemoryPressureGC(metrics);
 }
 
+TabletMemoryManager::~TabletMemoryManager() = default;
+
 Status TabletMemoryManager::Init() {
   if (background_task_) {
     RETURN_NOT_OK(background_task_->Init());
@@ -202,6 +249,24 @@ void TabletMemoryManager::InitBlockCache(
     block_based_table_gc_ = std::make_shared<LRUCacheGC>(options->block_cache);
     block_based_table_mem_tracker_->AddGarbageCollector(block_based_table_gc_);
   }
+
+  if (FLAGS_db_compressed_block_cache_size_bytes > 0) {
+    options->compressed_block_cache = rocksdb::NewLRUCache(
+        FLAGS_db_compressed_block_cache_size_bytes, FLAGS_db_block_cache_num_shard_bits);
+    // Raw blocks are already consumed from the per tablet trackers under BlockBasedTable, so the
+    // compressed cache usage is polled without adding it to the parent once more.
+    auto compressed_block_cache = options->compressed_block_cache;
+    compressed_block_cache_mem_tracker_ = MemTracker::CreateTracker(
+        FLAGS_db_compressed_block_cache_size_bytes,
+        "CompressedBlockCache",
+        [compressed_block_cache] {
+          return static_cast<int64_t>(compressed_block_cache->GetUsage());
+        },
+        block_based_table_mem_tracker_,
+        AddToParent::kFalse);
+    compressed_block_cache_gc_ = std::make_shared<LRUCacheGC>(compressed_block_cache);
+    compressed_block_cache_mem_tracker_->AddGarbageCollector(compressed_block_cache_gc_);
+  }
 }
 
 void TabletMemoryManager::InitLogCacheGC() {
@@ -211,6 +276,65 @@ void TabletMemoryManager::InitLogCacheGC() {
   log_cache_mem_tracker->AddGarbageCollector(log_cache_gc_);
 }
 
+void TabletMemoryManager::InitMemoryPressureGC(const scoped_refptr<MetricEntity>& metrics) {
+  if (metrics) {
+    memory_pressure_log_cache_evicted_bytes_ =
+        METRIC_memory_pressure_log_cache_evicted_bytes.Instantiate(metrics);
+    memory_pressure_memstore_flushes_ =
+        METRIC_memory_pressure_memstore_flushes.Instantiate(metrics);
+  }
+  memory_pressure_gc_ = std::make_shared<FunctorGC>(
+      std::bind(&TabletMemoryManager::MemoryPressureGC, this, _1));
+  server_mem_tracker_->AddGarbageCollector(memory_pressure_gc_);
+}
+
+void TabletMemoryManager::MemoryPressureGC(size_t required) {
+  if (!FLAGS_enable_memory_pressure_memstore_flush) {
+    return;
+  }
+
+  // Log cache is the cheapest to free, entries are read back from the WAL when needed.
+  auto evicted = EvictLogCache(required);
+  if (memory_pressure_log_cache_evicted_bytes_) {
+    memory_pressure_log_cache_evicted_bytes_->IncrementBy(evicted);
+  }
+  if (evicted >= required) {
+    return;
+  }
+
+  // Flush is asynchronous, so it is requested from the background task, and the caller proceeds
+  // with the other collectors or rejects the request if they don't free enough memory.
+  if (!memory_pressure_flush_requested_.exchange(true, std::memory_order_acq_rel) &&
+      background_task_) {
+    YB_WARN_NOT_OK(background_task_->Wake(), "Wakeup error");
+  }
+}
+
+void TabletMemoryManager::FlushTabletOnMemoryPressure() {
+  if (!memory_pressure_flush_requested_.exchange(false, std::memory_order_acq_rel)) {
+    return;
+  }
+  auto peer_to_flush = TabletToFlush();
+  if (!peer_to_flush) {
+    return;
+  }
+  auto tablet_to_flush = peer_to_flush->shared_tablet();
+  if (!tablet_to_flush) {
+    return;
+  }
+  LOG(INFO) << LogPrefix(peer_to_flush) << "Flushing tablet on memory pressure, consumption: "
+            << HumanReadableNumBytes::ToString(server_mem_tracker_->consumption());
+  WARN_NOT_OK(
+      tablet_to_flush->Flush(tablet::FlushMode::kAsync, tablet::FlushFlags::kAllDbs),
+      Substitute("Flush failed on $0", peer_to_flush->tablet_id()));
+  if (memory_pressure_memstore_flushes_) {
+    memory_pressure_memstore_flushes_->Increment();
+  }
+  for (auto listener : TEST_listeners) {
+    listener->StartedFlush(peer_to_flush->tablet_id());
+  }
+}
+
 void TabletMemoryManager::ConfigureBackgroundTask(tablet::TabletOptions* options) {
   // Calculate memstore_size_bytes based on total RAM available and global percentage.
   CHECK(FLAGS_global_memstore_size_percentage > 0 && FLAGS_global_memstore_size_percentage <= 100)
@@ -229,9 +353,14 @@ void TabletMemoryManager::ConfigureBackgroundTask(tablet::TabletOptions* options
   // Add memory monitor and background thread for flushing.
   // TODO(zhaoalex): replace task with Poller
   background_task_.reset(new BackgroundTask(
-    std::function<void()>([this]() { FlushTabletIfLimitExceeded(); }),
+    std::function<void()>([this]() {
+      FlushTabletIfLimitExceeded();
+      FlushTabletOnMemoryPressure();
+      FlushTabletsWithOldMemstore();
+    }),
     "tablet manager",
-    "flush scheduler bgtask"));
+    "flush scheduler bgtask",
+    kOldMemstoreCheckInterval));
   options->memory_monitor = std::make_shared<rocksdb::MemoryMonitor>(
       memstore_size_bytes,
       std::function<void()>([this](){
@@ -258,6 +387,13 @@ void TabletMemoryManager::LogCacheGC(MemTracker* log_cache_mem_tracker, size_t b
     bytes_to_evict = std::min<size_t>(bytes_to_evict, consumption - limit);
   }
 
+  auto total_evicted = EvictLogCache(bytes_to_evict);
+
+  LOG(INFO) << "Evicted from log cache: " << HumanReadableNumBytes::ToString(total_evicted)
+            << ", required: " << HumanReadableNumBytes::ToString(bytes_to_evict);
+}
+
+size_t TabletMemoryManager::EvictLogCache(size_t bytes_to_evict) {
   auto peers = peers_fn_();
   // Sort by inverse log size.
   std::sort(peers.begin(), peers.end(), [](const auto& lhs, const auto& rhs) {
@@ -276,13 +412,14 @@ void TabletMemoryManager::LogCacheGC(MemTracker* log_cache_mem_tracker, size_t b
       break;
     }
   }
-
-
-  LOG(INFO) << "Evicted from log cache: " << HumanReadableNumBytes::ToString(total_evicted)
-            << ", required: " << HumanReadableNumBytes::ToString(bytes_to_evict);
+  return total_evicted;
 }
 
 void TabletMemoryManager::FlushTabletIfLimitExceeded() {
+  if (FLAGS_memstore_flush_largest_first) {
+    FlushLargestTabletsIfLimitExceeded();
+    return;
+  }
   int iteration = 0;
   while (memory_monitor_->Exceeded() ||
          (iteration++ == 0 && FLAGS_TEST_pretend_memory_exceeded_enforce_flush)) {
@@ -312,6 +449,111 @@ void TabletMemoryManager::FlushTabletIfLimitExceeded() {
   }
 }
 
+void TabletMemoryManager::FlushLargestTabletsIfLimitExceeded() {
+  const bool pretend_exceeded = FLAGS_TEST_pretend_memory_exceeded_enforce_flush;
+  if (!memory_monitor_->Exceeded() && !pretend_exceeded) {
+    return;
+  }
+
+  struct FlushCandidate {
+    tablet::TabletPeerPtr peer;
+    tablet::TabletPtr tablet;
+    uint64_t mutable_size;
+  };
+  std::vector<FlushCandidate> candidates;
+  uint64_t being_flushed = 0;
+  for (const tablet::TabletPeerPtr& peer : peers_fn_()) {
+    auto tablet = peer->shared_tablet();
+    if (!tablet) {
+      continue;
+    }
+    auto [mutable_size, immutable_size] = tablet->GetMemtableSizes();
+    being_flushed += immutable_size;
+    if (mutable_size > 0) {
+      candidates.push_back(FlushCandidate {
+        .peer = peer,
+        .tablet = std::move(tablet),
+        .mutable_size = mutable_size,
+      });
+    }
+  }
+
+  // Memory of the immutable memtables is freed when their flushes complete, so only the rest is
+  // freed by new flushes. Otherwise every wakeup while flushes are in progress would start flushing
+  // even more small memtables.
+  const auto limit = memory_monitor_->limit();
+  const auto target = limit * std::clamp(FLAGS_memstore_flush_target_percentage, 0, 100) / 100;
+  const auto usage = memory_monitor_->memory_usage();
+  const int64_t to_free =
+      static_cast<int64_t>(usage) - static_cast<int64_t>(being_flushed + target);
+  if (to_free <= 0 && !pretend_exceeded) {
+    return;
+  }
+
+  std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.mutable_size > rhs.mutable_size;
+  });
+
+  YB_LOG_EVERY_N_SECS(INFO, 5) << Format(
+      "Memstore global limit of $0 bytes reached, usage: $1, being flushed: $2, "
+      "flushing up to $3 tablets to free $4 bytes",
+      limit, usage, being_flushed, candidates.size(), to_free);
+
+  auto flush_tick = rocksdb::FlushTick();
+  int64_t freed = 0;
+  // Flushes are asynchronous, so the selected tablets are flushed in parallel.
+  for (const auto& candidate : candidates) {
+    LOG(INFO) << LogPrefix(candidate.peer) << "Flushing tablet with memstore size "
+              << HumanReadableNumBytes::ToString(candidate.mutable_size);
+    WARN_NOT_OK(
+        candidate.tablet->Flush(
+            tablet::FlushMode::kAsync, tablet::FlushFlags::kAllDbs, flush_tick),
+        Substitute("Flush failed on $0", candidate.peer->tablet_id()));
+    for (auto listener : TEST_listeners) {
+      listener->StartedFlush(candidate.peer->tablet_id());
+    }
+    freed += candidate.mutable_size;
+    if (freed >= to_free) {
+      break;
+    }
+  }
+}
+
+void TabletMemoryManager::FlushTabletsWithOldMemstore() {
+  auto max_age_secs = FLAGS_memstore_max_unflushed_age_secs;
+  if (max_age_secs <= 0) {
+    return;
+  }
+  for (const tablet::TabletPeerPtr& peer : peers_fn_()) {
+    const auto tablet = peer->shared_tablet();
+    if (!tablet) {
+      continue;
+    }
+    const auto ht = tablet->OldestMutableMemtableWriteHybridTime();
+    if (!ht.ok()) {
+      YB_LOG_EVERY_N_SECS(WARNING, 5) << Format(
+          "Failed to get oldest mutable memtable write ht for tablet $0: $1",
+          tablet->tablet_id(), ht.status());
+      continue;
+    }
+    if (*ht == HybridTime::kMax) {
+      continue;
+    }
+    auto age = MonoDelta::FromMicroseconds(
+        tablet->clock()->Now().GetPhysicalValueMicros() - ht->GetPhysicalValueMicros());
+    if (age < MonoDelta::FromSeconds(max_age_secs)) {
+      continue;
+    }
+    LOG(INFO) << LogPrefix(peer) << "Flushing tablet with memstore write " << age << " ago";
+    WARN_NOT_OK(
+        tablet->Flush(tablet::FlushMode::kAsync, tablet::FlushFlags::kAllDbs),
+        Substitute("Flush failed on $0", peer->tablet_id()));
+    for (auto listener : TEST_listeners) {
+      listener->StartedFlush(peer->tablet_id());
+    }
+  }
+}
+
 // Return the tablet with the oldest write in memstore, or nullptr if all tablet memstores are
 // empty or about to flush.
 tablet::TabletPeerPtr TabletMemoryManager::TabletToFlush() {
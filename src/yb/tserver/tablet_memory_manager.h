@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include <boost/optional.hpp>
@@ -21,6 +22,7 @@
 
 #include "yb/util/background_task.h"
 #include "yb/util/mem_tracker.h"
+#include "yb/util/metrics_fwd.h"
 
 namespace yb {
 namespace tserver {
@@ -35,6 +37,7 @@ class TabletMemoryManagerListenerIf {
 // - Block cache initialization and tracking
 // - Log cache garbage collection
 // - Memory flushing once the global memstore limit is reached
+// - Flushing memstores with old writes, to bound the WAL replayed on tablet bootstrap
 class TabletMemoryManager {
  public:
   // 'default_block_cache_size_percentage' indicates what percentage of tablet memory will be
@@ -49,7 +52,7 @@ class TabletMemoryManager {
       const scoped_refptr<MetricEntity>& metrics,
       const std::function<std::vector<tablet::TabletPeerPtr>()>& peers_fn);
 
-  ~TabletMemoryManager() = default;
+  ~TabletMemoryManager();
 
   // Init and Shutdown start/stop the background memstore management task.
   Status Init();
@@ -61,6 +64,9 @@ class TabletMemoryManager {
   // Flushing function for the memstore.
   void FlushTabletIfLimitExceeded();
 
+  // Flushes tablets whose oldest memstore write is older than memstore_max_unflushed_age_secs.
+  void FlushTabletsWithOldMemstore();
+
   std::vector<std::shared_ptr<TabletMemoryManagerListenerIf>> TEST_listeners;
 
  private:
@@ -82,6 +88,24 @@ class TabletMemoryManager {
   // Log cache garbage collection function bound to the memory tracker.
   void LogCacheGC(MemTracker* log_cache_mem_tracker, size_t bytes_to_evict);
 
+  // Evicts up to bytes_to_evict from the log caches of the tablets with the largest log cache
+  // first. Returns the number of evicted bytes.
+  size_t EvictLogCache(size_t bytes_to_evict);
+
+  // Initializes the garbage collector of the server memory tracker, that is invoked when the
+  // soft memory limit is exceeded, before writes are rejected.
+  void InitMemoryPressureGC(const scoped_refptr<MetricEntity>& metrics);
+
+  // Evicts the log cache, and requests memstore flush if it was not enough.
+  void MemoryPressureGC(size_t required);
+
+  // Flushes the tablet with the oldest memstore write, if requested by MemoryPressureGC.
+  void FlushTabletOnMemoryPressure();
+
+  // Flushes tablets with the largest mutable memtables, until the memstore usage, excluding the
+  // memtables that are already being flushed, would drop to memstore_flush_target_percentage.
+  void FlushLargestTabletsIfLimitExceeded();
+
   // Determines which tablet has the oldest mutable memtable write time.  May return a null ptr
   // if no tablet meets the criteria.  Uses peers_fn_ to determine the full list of peers to check.
   tablet::TabletPeerPtr TabletToFlush();
@@ -98,8 +122,19 @@ class TabletMemoryManager {
 
   std::shared_ptr<GarbageCollector> block_based_table_gc_;
 
+  std::shared_ptr<MemTracker> compressed_block_cache_mem_tracker_;
+
+  std::shared_ptr<GarbageCollector> compressed_block_cache_gc_;
+
   std::shared_ptr<GarbageCollector> log_cache_gc_;
 
+  std::shared_ptr<GarbageCollector> memory_pressure_gc_;
+
+  std::atomic<bool> memory_pressure_flush_requested_{false};
+
+  scoped_refptr<Counter> memory_pressure_log_cache_evicted_bytes_;
+  scoped_refptr<Counter> memory_pressure_memstore_flushes_;
+
   std::unique_ptr<BackgroundTask> background_task_;
 
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor_;
@@ -74,6 +74,8 @@
 #include "yb/tserver/metrics_snapshotter.h"
 #include "yb/tserver/pg_client_service.h"
 #include "yb/tserver/remote_bootstrap_service.h"
+#include "yb/tserver/rpc_trace_capture.h"
+#include "yb/tserver/table_quotas.h"
 #include "yb/tserver/tablet_service.h"
 #include "yb/tserver/ts_tablet_manager.h"
 #include "yb/tserver/tserver-path-handlers.h"
@@ -174,6 +176,8 @@ TabletServer::TabletServer(const TabletServerOptions& opts)
       opts_(opts),
       auto_flags_manager_(new AutoFlagsManager("yb-tserver", fs_manager_.get())),
       tablet_manager_(new TSTabletManager(fs_manager_.get(), this, metric_registry())),
+      table_quotas_(new TableQuotas(metric_entity())),
+      rpc_trace_capture_(new RpcTraceCapture()),
       path_handlers_(new TabletServerPathHandlers(this)),
       maintenance_manager_(new MaintenanceManager(MaintenanceManager::DEFAULT_OPTIONS)),
       master_config_index_(0) {
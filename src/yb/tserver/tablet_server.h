@@ -115,6 +115,8 @@ class TabletServer : public DbServerBase, public TabletServerIf {
 
   TSTabletManager* tablet_manager() override { return tablet_manager_.get(); }
   TabletPeerLookupIf* tablet_peer_lookup() override;
+  TableQuotas* table_quotas() override { return table_quotas_.get(); }
+  RpcTraceCapture* rpc_trace_capture() override { return rpc_trace_capture_.get(); }
 
   Heartbeater* heartbeater() { return heartbeater_.get(); }
 
@@ -287,6 +289,10 @@ class TabletServer : public DbServerBase, public TabletServerIf {
   // Manager for tablets which are available on this server.
   std::unique_ptr<TSTabletManager> tablet_manager_;
 
+  std::unique_ptr<TableQuotas> table_quotas_;
+
+  std::unique_ptr<RpcTraceCapture> rpc_trace_capture_;
+
   // Used to forward redis pub/sub messages to the redis pub/sub handler
   yb::AtomicUniquePtr<rpc::Publisher> publish_service_ptr_;
 
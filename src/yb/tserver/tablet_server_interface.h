@@ -43,6 +43,12 @@ class TabletServerIf : public LocalTabletServer {
   virtual TSTabletManager* tablet_manager() = 0;
   virtual TabletPeerLookupIf* tablet_peer_lookup() = 0;
 
+  // Quotas of reads and writes, nullptr when server does not enforce them.
+  virtual TableQuotas* table_quotas() = 0;
+
+  // Capture of sampled RPCs, nullptr when server does not support it.
+  virtual RpcTraceCapture* rpc_trace_capture() = 0;
+
   virtual server::Clock* Clock() = 0;
   virtual rpc::Publisher* GetPublisher() = 0;
 
@@ -81,7 +81,9 @@
 #include "yb/tablet/write_query.h"
 
 #include "yb/tserver/read_query.h"
+#include "yb/tserver/rpc_trace_capture.h"
 #include "yb/tserver/service_util.h"
+#include "yb/tserver/table_quotas.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
 #include "yb/tserver/tserver_error.h"
@@ -99,6 +101,7 @@
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
+#include "yb/util/net/rate_limiter.h"
 #include "yb/util/random_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
@@ -108,6 +111,7 @@
 #include "yb/util/status_fwd.h"
 #include "yb/util/status_log.h"
 #include "yb/util/string_util.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/trace.h"
 
 #include "yb/yql/pgwrapper/ysql_upgrade.h"
@@ -129,6 +133,10 @@ DEFINE_int32(num_concurrent_backfills_allowed, -1,
 
 DEFINE_test_flag(bool, tserver_noop_read_write, false, "Respond NOOP to read/write.");
 
+DEFINE_RUNTIME_uint64(checksum_scan_rate_limit_bytes_per_sec, 0,
+    "Maximum rate of data scanned by all concurrent checksum scans of the tablet server. "
+    "0 means no limit.");
+
 DEFINE_RUNTIME_uint64(index_backfill_upperbound_for_user_enforced_txn_duration_ms, 65000,
     "For Non-Txn tables, it is impossible to know at the tservers "
     "whether or not an 'old transaction' is still active. To avoid "
@@ -162,6 +170,9 @@ DEFINE_test_flag(double, respond_write_failed_probability, 0.0,
 
 DEFINE_test_flag(bool, rpc_delete_tablet_fail, false, "Should delete tablet RPC fail.");
 
+DEFINE_NON_RUNTIME_int32(delete_tablets_batch_max_threads, 8,
+    "Maximum number of threads deleting tablets received in DeleteTablets batches.");
+
 DECLARE_bool(disable_alter_vs_write_mutual_exclusion);
 DECLARE_uint64(max_clock_skew_usec);
 DECLARE_uint64(transaction_min_running_check_interval_ms);
@@ -406,7 +417,8 @@ class ScanResultChecksummer {
  public:
   ScanResultChecksummer() {}
 
-  void HandleRow(const Schema& schema, const QLTableRow& row) {
+  // Returns the number of bytes of the row, that were checksummed.
+  size_t HandleRow(const Schema& schema, const QLTableRow& row) {
     QLValue value;
     buffer_.clear();
     for (uint32_t col_index = 0; col_index != schema.num_columns(); ++col_index) {
@@ -426,6 +438,7 @@ class ScanResultChecksummer {
       }
     }
     crc_->Compute(buffer_.c_str(), buffer_.size(), &agg_checksum_, nullptr);
+    return buffer_.size();
   }
 
   // Accessors for initializing / setting the checksum.
@@ -452,8 +465,13 @@ TabletServiceImpl::TabletServiceImpl(TabletServerIf* server)
 TabletServiceAdminImpl::TabletServiceAdminImpl(TabletServer* server)
     : TabletServerAdminServiceIf(server->MetricEnt()), server_(server) {
   ts_split_op_added_ = METRIC_ts_split_op_added.Instantiate(server->MetricEnt(), 0);
+  CHECK_OK(ThreadPoolBuilder("delete-tablets")
+               .set_max_threads(FLAGS_delete_tablets_batch_max_threads)
+               .Build(&delete_tablets_pool_));
 }
 
+TabletServiceAdminImpl::~TabletServiceAdminImpl() = default;
+
 void TabletServiceAdminImpl::BackfillDone(
     const tablet::ChangeMetadataRequestPB* req, ChangeMetadataResponsePB* resp,
     rpc::RpcContext context) {
@@ -1131,6 +1149,70 @@ void TabletServiceImpl::PerformAtLeader(
   }
 }
 
+void TabletServiceImpl::HeartbeatTransactions(const HeartbeatTransactionsRequestPB* req,
+                                              HeartbeatTransactionsResponsePB* resp,
+                                              rpc::RpcContext context) {
+  TRACE("HeartbeatTransactions");
+
+  VLOG(2) << "HeartbeatTransactions: " << req->tablet_id() << ", "
+          << req->transaction_ids().size() << " transactions";
+  UpdateClock(*req, server_->Clock());
+
+  auto tablet = LookupLeaderTabletOrRespond(
+      server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
+  if (!tablet) {
+    return;
+  }
+  auto* coordinator = tablet.tablet->transaction_coordinator();
+  if (!coordinator) {
+    SetupErrorAndRespond(
+        resp->mutable_error(),
+        STATUS(InvalidArgument, "Does not have transaction coordinator to process heartbeats"),
+        &context);
+    return;
+  }
+
+  struct BatchState {
+    BatchState(
+        rpc::RpcContext context_, HeartbeatTransactionsResponsePB* resp_, server::ClockPtr clock_,
+        int left_)
+        : context(std::move(context_)), resp(resp_), clock(std::move(clock_)), left(left_) {}
+
+    rpc::RpcContext context;
+    HeartbeatTransactionsResponsePB* const resp;
+    const server::ClockPtr clock;
+    std::atomic<int> left;
+  };
+  const auto num_transactions = req->transaction_ids().size();
+  for (int i = 0; i != num_transactions; ++i) {
+    resp->add_statuses()->set_code(AppStatusPB::OK);
+  }
+  if (num_transactions == 0) {
+    resp->set_propagated_hybrid_time(server_->Clock()->Now().ToUint64());
+    context.RespondSuccess();
+    return;
+  }
+  auto batch = std::make_shared<BatchState>(
+      std::move(context), resp, server_->Clock(), num_transactions);
+  // Heartbeats are submitted one after another, so they are replicated in the same Raft batch.
+  for (int i = 0; i != num_transactions; ++i) {
+    auto state = std::make_unique<tablet::UpdateTxnOperation>(tablet.tablet);
+    auto& txn_state = *state->AllocateRequest();
+    txn_state.set_transaction_id(req->transaction_ids(i));
+    txn_state.set_status(TransactionStatus::PENDING);
+    state->set_completion_callback([batch, i](const Status& status) {
+      if (!status.ok()) {
+        StatusToPB(status, batch->resp->mutable_statuses(i));
+      }
+      if (batch->left.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        batch->resp->set_propagated_hybrid_time(batch->clock->Now().ToUint64());
+        batch->context.RespondSuccess();
+      }
+    });
+    coordinator->Handle(std::move(state), tablet.leader_term, /* is_external= */ false);
+  }
+}
+
 void TabletServiceImpl::GetTransactionStatus(const GetTransactionStatusRequestPB* req,
                                              GetTransactionStatusResponsePB* resp,
                                              rpc::RpcContext context) {
@@ -1438,40 +1520,92 @@ void TabletServiceAdminImpl::DeleteTablet(const DeleteTabletRequestPB* req,
   if (!CheckUuidMatchOrRespond(server_->tablet_manager(), "DeleteTablet", req, resp, &context)) {
     return;
   }
+
+  boost::optional<TabletServerErrorPB::Code> error_code;
+  Status s = DoDeleteTablet(*req, context.requestor_string(), &error_code);
+  if (PREDICT_FALSE(!s.ok())) {
+    HandleErrorResponse(resp, &context, s, error_code);
+    return;
+  }
+  context.RespondSuccess();
+}
+
+void TabletServiceAdminImpl::DeleteTablets(const DeleteTabletsRequestPB* req,
+                                           DeleteTabletsResponsePB* resp,
+                                           rpc::RpcContext context) {
+  if (PREDICT_FALSE(FLAGS_TEST_rpc_delete_tablet_fail)) {
+    context.RespondFailure(STATUS(NetworkError, "Simulating network partition for test"));
+    return;
+  }
+
+  if (!CheckUuidMatchOrRespond(server_->tablet_manager(), "DeleteTablets", req, resp, &context)) {
+    return;
+  }
+  if (req->requests().empty()) {
+    context.RespondSuccess();
+    return;
+  }
+
+  for (int i = 0; i != req->requests_size(); ++i) {
+    resp->add_responses();
+  }
+  auto requestor = context.requestor_string();
+  auto shared_context = std::make_shared<rpc::RpcContext>(std::move(context));
+  auto num_remaining = std::make_shared<std::atomic<int>>(req->requests_size());
+  for (int i = 0; i != req->requests_size(); ++i) {
+    // Each task fills its own preallocated response, so they don't interfere.
+    std::function<void()> task = [this, req, resp, i, requestor, shared_context, num_remaining] {
+      boost::optional<TabletServerErrorPB::Code> error_code;
+      auto s = DoDeleteTablet(req->requests(i), requestor, &error_code);
+      if (PREDICT_FALSE(!s.ok())) {
+        auto* error = resp->mutable_responses(i)->mutable_error();
+        error->set_code(error_code.get_value_or(TabletServerErrorPB::UNKNOWN_ERROR));
+        StatusToPB(s, error->mutable_status());
+      }
+      if (num_remaining->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        shared_context->RespondSuccess();
+      }
+    };
+    auto s = delete_tablets_pool_->SubmitFunc(task);
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to submit delete of tablet " << req->requests(i).tablet_id()
+                   << ", running it inline: " << s;
+      task();
+    }
+  }
+}
+
+Status TabletServiceAdminImpl::DoDeleteTablet(
+    const DeleteTabletRequestPB& req, const std::string& requestor,
+    boost::optional<TabletServerErrorPB::Code>* error_code) {
   TRACE_EVENT2("tserver", "DeleteTablet",
-               "tablet_id", req->tablet_id(),
-               "reason", req->reason());
+               "tablet_id", req.tablet_id(),
+               "reason", req.reason());
 
   tablet::TabletDataState delete_type = tablet::TABLET_DATA_UNKNOWN;
-  if (req->has_delete_type()) {
-    delete_type = req->delete_type();
+  if (req.has_delete_type()) {
+    delete_type = req.delete_type();
   }
-  LOG(INFO) << "T " << req->tablet_id() << " P " << server_->permanent_uuid()
+  LOG(INFO) << "T " << req.tablet_id() << " P " << server_->permanent_uuid()
             << ": Processing DeleteTablet with delete_type " << TabletDataState_Name(delete_type)
-            << (req->has_reason() ? (" (" + req->reason() + ")") : "")
-            << (req->hide_only() ? " (Hide only)" : "")
-            << (req->keep_data() ? " (Not deleting data)" : "")
-            << " from " << context.requestor_string();
-  VLOG(1) << "Full request: " << req->DebugString();
+            << (req.has_reason() ? (" (" + req.reason() + ")") : "")
+            << (req.hide_only() ? " (Hide only)" : "")
+            << (req.keep_data() ? " (Not deleting data)" : "")
+            << " from " << requestor;
+  VLOG(1) << "Full request: " << req.DebugString();
 
   boost::optional<int64_t> cas_config_opid_index_less_or_equal;
-  if (req->has_cas_config_opid_index_less_or_equal()) {
-    cas_config_opid_index_less_or_equal = req->cas_config_opid_index_less_or_equal();
+  if (req.has_cas_config_opid_index_less_or_equal()) {
+    cas_config_opid_index_less_or_equal = req.cas_config_opid_index_less_or_equal();
   }
-  boost::optional<TabletServerErrorPB::Code> error_code;
-  Status s = server_->tablet_manager()->DeleteTablet(
-      req->tablet_id(),
+  return server_->tablet_manager()->DeleteTablet(
+      req.tablet_id(),
       delete_type,
-      tablet::ShouldAbortActiveTransactions(req->should_abort_active_txns()),
+      tablet::ShouldAbortActiveTransactions(req.should_abort_active_txns()),
       cas_config_opid_index_less_or_equal,
-      req->hide_only(),
-      req->keep_data(),
-      &error_code);
-  if (PREDICT_FALSE(!s.ok())) {
-    HandleErrorResponse(resp, &context, s, error_code);
-    return;
-  }
-  context.RespondSuccess();
+      req.hide_only(),
+      req.keep_data(),
+      error_code);
 }
 
 // TODO(sagnik): Modify this to actually create a copartitioned table
@@ -1751,6 +1885,16 @@ void TabletServiceImpl::Write(const WriteRequestPB* req,
     return;
   }
 
+  auto* table_quotas = server_->table_quotas();
+  if (table_quotas && table_quotas->enabled()) {
+    auto status = table_quotas->Consume(
+        *tablet.tablet->metadata(), QuotaTableId(req->pgsql_write_batch()), req->ByteSizeLong());
+    if (!status.ok()) {
+      SetupErrorAndRespond(resp->mutable_error(), status, &context);
+      return;
+    }
+  }
+
   if (tablet.tablet->metadata()->hidden()) {
     auto status = STATUS(NotFound, "Tablet not found", req->tablet_id());
     SetupErrorAndRespond(
@@ -1818,6 +1962,11 @@ void TabletServiceImpl::Write(const WriteRequestPB* req,
     }
   }
 
+  auto* rpc_trace_capture = server_->rpc_trace_capture();
+  if (rpc_trace_capture && rpc_trace_capture->enabled()) {
+    rpc_trace_capture->Record(*req);
+  }
+
   auto query = std::make_unique<tablet::WriteQuery>(
       tablet.leader_term, context.GetClientDeadline(), tablet.peer.get(),
       tablet.tablet, resp);
@@ -1846,6 +1995,11 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
     return;
   }
 
+  auto* rpc_trace_capture = server_->rpc_trace_capture();
+  if (rpc_trace_capture && rpc_trace_capture->enabled()) {
+    rpc_trace_capture->Record(*req);
+  }
+
   PerformRead(server_, this, req, resp, std::move(context));
 }
 
@@ -1869,28 +2023,29 @@ void ConsensusServiceImpl::CompleteUpdateConsensusResponse(
 }
 
 void ConsensusServiceImpl::MultiRaftUpdateConsensus(
-      const consensus::MultiRaftConsensusRequestPB *req,
-      consensus::MultiRaftConsensusResponsePB *resp,
+      const consensus::LWMultiRaftConsensusRequestPB *req,
+      consensus::LWMultiRaftConsensusResponsePB *resp,
       rpc::RpcContext context) {
     DVLOG(3) << "Received Batch Consensus Update RPC: " << req->ShortDebugString();
     // Effectively performs ConsensusServiceImpl::UpdateConsensus for
     // each ConsensusRequestPB in the batch but does not fail the entire
     // batch if a single request fails.
-    for (int i = 0; i < req->consensus_request_size(); i++) {
-      // Unfortunately, we have to use const_cast here,
-      // because the protobuf-generated interface only gives us a const request
-      // but we need to be able to move messages out of the request for efficiency.
-      auto consensus_req = const_cast<ConsensusRequestPB*>(&req->consensus_request(i));
-      auto consensus_resp = resp->add_consensus_response();;
-
-      auto uuid_match_res = CheckUuidMatch(tablet_manager_, "UpdateConsensus", consensus_req,
+    // Unfortunately, we have to use const_cast here, because the protobuf-generated interface only
+    // gives us a const request, but we need to be able to move messages out of the request for
+    // efficiency.
+    auto& consensus_requests =
+        *const_cast<consensus::LWMultiRaftConsensusRequestPB*>(req)->mutable_consensus_request();
+    for (auto& consensus_req : consensus_requests) {
+      auto* consensus_resp = resp->add_consensus_response();
+
+      auto uuid_match_res = CheckUuidMatch(tablet_manager_, "UpdateConsensus", &consensus_req,
                                            context.requestor_string());
       if (!uuid_match_res.ok()) {
         SetupError(consensus_resp->mutable_error(), uuid_match_res.status());
         continue;
       }
 
-      auto peer_tablet_res = LookupTabletPeer(tablet_manager_, consensus_req->tablet_id());
+      auto peer_tablet_res = LookupTabletPeer(tablet_manager_, consensus_req.tablet_id());
       if (!peer_tablet_res.ok()) {
         SetupError(consensus_resp->mutable_error(), peer_tablet_res.status());
         continue;
@@ -1905,11 +2060,10 @@ void ConsensusServiceImpl::MultiRaftUpdateConsensus(
       }
       auto consensus = *consensus_res;
 
-      // TODO(lw_uc) effective update for multiraft.
-      auto temp_resp = rpc::MakeSharedMessage<consensus::LWConsensusResponsePB>();
+      // Request and response share the arena of the RPC call, so neither is copied.
       Status s = consensus->Update(
-         rpc::CopySharedMessage(*consensus_req),
-         temp_resp.get(), context.GetClientDeadline());
+         rpc::SharedField(context.shared_params(), &consensus_req),
+         consensus_resp, context.GetClientDeadline());
       if (PREDICT_FALSE(!s.ok())) {
         // Clear the response first, since a partially-filled response could
         // result in confusing a caller, or in having missing required fields
@@ -1919,8 +2073,7 @@ void ConsensusServiceImpl::MultiRaftUpdateConsensus(
         continue;
       }
 
-      CompleteUpdateConsensusResponse(tablet_peer, temp_resp.get());
-      temp_resp->ToGoogleProtobuf(consensus_resp);
+      CompleteUpdateConsensusResponse(tablet_peer, consensus_resp);
     }
     context.RespondSuccess();
 }
@@ -2344,7 +2497,13 @@ void TabletServiceImpl::ListTabletsForTabletServer(const ListTabletsForTabletSer
 
 namespace {
 
-Result<uint64_t> CalcChecksum(tablet::Tablet* tablet, CoarseTimePoint deadline) {
+// Rate limiter is updated when at least this number of bytes were scanned, to avoid checking the
+// time per row.
+constexpr size_t kChecksumRateLimiterUpdateBytes = 64_KB;
+
+Status CalcChecksum(
+    tablet::Tablet* tablet, CoarseTimePoint deadline, RateLimiter* rate_limiter,
+    ChecksumResponsePB* resp) {
   auto scoped_read_operation = tablet->CreateNonAbortableScopedRWOperation();
   RETURN_NOT_OK(scoped_read_operation);
 
@@ -2355,23 +2514,50 @@ Result<uint64_t> CalcChecksum(tablet::Tablet* tablet, CoarseTimePoint deadline)
 
   QLTableRow value_map;
   ScanResultChecksummer collector;
+  uint64_t scanned_bytes = 0;
+  size_t unlimited_bytes = 0;
 
   while (VERIFY_RESULT((**iter).HasNext())) {
     RETURN_NOT_OK((**iter).NextRow(&value_map));
-    collector.HandleRow(*schema, value_map);
+    auto row_bytes = collector.HandleRow(*schema, value_map);
+    scanned_bytes += row_bytes;
+    unlimited_bytes += row_bytes;
+    if (rate_limiter->active() && unlimited_bytes >= kChecksumRateLimiterUpdateBytes) {
+      rate_limiter->UpdateDataSizeAndMaybeSleep(unlimited_bytes);
+      unlimited_bytes = 0;
+    }
   }
 
-  return collector.agg_checksum();
+  resp->set_checksum(collector.agg_checksum());
+  resp->set_scanned_bytes(scanned_bytes);
+  return Status::OK();
 }
 
 } // namespace
 
-Result<uint64_t> TabletServiceImpl::DoChecksum(
-    const ChecksumRequestPB* req, CoarseTimePoint deadline) {
+Status TabletServiceImpl::DoChecksum(
+    const ChecksumRequestPB* req, CoarseTimePoint deadline, ChecksumResponsePB* resp) {
   auto abstract_tablet = VERIFY_RESULT(GetTablet(
       server_->tablet_peer_lookup(), req->tablet_id(), /* tablet_peer = */ nullptr,
       req->consistency_level(), AllowSplitTablet::kTrue));
-  return CalcChecksum(down_cast<tablet::Tablet*>(abstract_tablet.get()), deadline);
+
+  num_active_checksum_scans_.fetch_add(1, std::memory_order_acq_rel);
+  auto se = ScopeExit([this] {
+    num_active_checksum_scans_.fetch_sub(1, std::memory_order_acq_rel);
+  });
+
+  // The rate limit is shared by all concurrent checksum scans of the tablet server.
+  RateLimiter rate_limiter;
+  if (FLAGS_checksum_scan_rate_limit_bytes_per_sec > 0) {
+    rate_limiter.SetTargetRateUpdater([this] {
+      return FLAGS_checksum_scan_rate_limit_bytes_per_sec / std::max<uint64_t>(
+          num_active_checksum_scans_.load(std::memory_order_acquire), 1);
+    });
+    rate_limiter.Init();
+  }
+
+  return CalcChecksum(
+      down_cast<tablet::Tablet*>(abstract_tablet.get()), deadline, &rate_limiter, resp);
 }
 
 void TabletServiceImpl::Checksum(const ChecksumRequestPB* req,
@@ -2379,13 +2565,12 @@ void TabletServiceImpl::Checksum(const ChecksumRequestPB* req,
                                  rpc::RpcContext context) {
   VLOG(1) << "Full request: " << req->DebugString();
 
-  auto checksum = DoChecksum(req, context.GetClientDeadline());
-  if (!checksum.ok()) {
-    SetupErrorAndRespond(resp->mutable_error(), checksum.status(), &context);
+  auto status = DoChecksum(req, context.GetClientDeadline(), resp);
+  if (!status.ok()) {
+    SetupErrorAndRespond(resp->mutable_error(), status, &context);
     return;
   }
 
-  resp->set_checksum(*checksum);
   context.RespondSuccess();
 }
 
@@ -2454,6 +2639,25 @@ void TabletServiceImpl::GetSplitKey(
   });
 }
 
+void TabletServiceImpl::GetTabletHotKeys(
+    const GetTabletHotKeysRequestPB* req, GetTabletHotKeysResponsePB* resp,
+    RpcContext context) {
+  auto peer_tablet = VERIFY_RESULT_OR_RETURN(LookupTabletPeerOrRespond(
+      server_->tablet_peer_lookup(), req->tablet_id(), resp, &context));
+  auto limit = req->limit() ? req->limit() : std::numeric_limits<size_t>::max();
+  auto fill = [limit](tablet::HotKeys* hot_keys, auto* out) {
+    for (const auto& entry : hot_keys->TopKeys(limit)) {
+      auto* out_entry = out->Add();
+      out_entry->set_key(entry.key);
+      out_entry->set_count(entry.count);
+      out_entry->set_error(entry.error);
+    }
+  };
+  fill(&peer_tablet.tablet->hot_read_keys(), resp->mutable_read_keys());
+  fill(&peer_tablet.tablet->hot_write_keys(), resp->mutable_write_keys());
+  context.RespondSuccess();
+}
+
 void TabletServiceImpl::GetSharedData(const GetSharedDataRequestPB* req,
                                       GetSharedDataResponsePB* resp,
                                       rpc::RpcContext context) {
@@ -40,6 +40,7 @@
 #include <utility>
 #include <vector>
 
+#include <boost/optional/optional.hpp>
 #include <boost/range/iterator_range.hpp>
 
 #include "yb/common/common_fwd.h"
@@ -61,6 +62,7 @@ namespace yb {
 class Schema;
 class Status;
 class HybridTime;
+class ThreadPool;
 
 namespace tserver {
 
@@ -115,6 +117,10 @@ class TabletServiceImpl : public TabletServerServiceIf, public ReadTabletProvide
                          UpdateTransactionResponsePB* resp,
                          rpc::RpcContext context) override;
 
+  void HeartbeatTransactions(const HeartbeatTransactionsRequestPB* req,
+                             HeartbeatTransactionsResponsePB* resp,
+                             rpc::RpcContext context) override;
+
   void GetTransactionStatus(const GetTransactionStatusRequestPB* req,
                             GetTransactionStatusResponsePB* resp,
                             rpc::RpcContext context) override;
@@ -158,6 +164,11 @@ class TabletServiceImpl : public TabletServerServiceIf, public ReadTabletProvide
       GetSplitKeyResponsePB* resp,
       rpc::RpcContext context) override;
 
+  void GetTabletHotKeys(
+      const GetTabletHotKeysRequestPB* req,
+      GetTabletHotKeysResponsePB* resp,
+      rpc::RpcContext context) override;
+
   void GetSharedData(const GetSharedDataRequestPB* req,
                      GetSharedDataResponsePB* resp,
                      rpc::RpcContext context) override;
@@ -180,13 +191,17 @@ class TabletServiceImpl : public TabletServerServiceIf, public ReadTabletProvide
   template <class Req, class Resp, class F>
   void PerformAtLeader(const Req& req, Resp* resp, rpc::RpcContext* context, const F& f);
 
-  Result<uint64_t> DoChecksum(const ChecksumRequestPB* req, CoarseTimePoint deadline);
+  Status DoChecksum(
+      const ChecksumRequestPB* req, CoarseTimePoint deadline, ChecksumResponsePB* resp);
 
   Status HandleUpdateTransactionStatusLocation(const UpdateTransactionStatusLocationRequestPB* req,
                                                UpdateTransactionStatusLocationResponsePB* resp,
                                                std::shared_ptr<rpc::RpcContext> context);
 
   TabletServerIf *const server_;
+
+  // Number of running checksum scans, used to split the checksum scan rate limit between them.
+  std::atomic<uint64_t> num_active_checksum_scans_{0};
 };
 
 class TabletServiceAdminImpl : public TabletServerAdminServiceIf {
@@ -194,6 +209,8 @@ class TabletServiceAdminImpl : public TabletServerAdminServiceIf {
   typedef std::vector<tablet::TabletPeerPtr> TabletPeers;
 
   explicit TabletServiceAdminImpl(TabletServer* server);
+  ~TabletServiceAdminImpl();
+
   void CreateTablet(const CreateTabletRequestPB* req,
                     CreateTabletResponsePB* resp,
                     rpc::RpcContext context) override;
@@ -206,6 +223,11 @@ class TabletServiceAdminImpl : public TabletServerAdminServiceIf {
                     DeleteTabletResponsePB* resp,
                     rpc::RpcContext context) override;
 
+  // Deletes tablets of the batch concurrently, and responds when all of them are processed.
+  void DeleteTablets(const DeleteTabletsRequestPB* req,
+                     DeleteTabletsResponsePB* resp,
+                     rpc::RpcContext context) override;
+
   void AlterSchema(const tablet::ChangeMetadataRequestPB* req,
                    ChangeMetadataResponsePB* resp,
                    rpc::RpcContext context) override;
@@ -271,6 +293,10 @@ class TabletServiceAdminImpl : public TabletServerAdminServiceIf {
 
   Status DoCreateTablet(const CreateTabletRequestPB* req, CreateTabletResponsePB* resp);
 
+  Status DoDeleteTablet(
+      const DeleteTabletRequestPB& req, const std::string& requestor,
+      boost::optional<TabletServerErrorPB::Code>* error_code);
+
   // Used to implement wait/signal mechanism for backfill requests.
   // Since the number of concurrently allowed backfill requests is
   // limited.
@@ -279,6 +305,9 @@ class TabletServiceAdminImpl : public TabletServerAdminServiceIf {
   std::atomic<int32_t> num_tablets_backfilling_{0};
   std::atomic<int32_t> num_test_retry_calls{0};
   scoped_refptr<yb::AtomicGauge<uint64_t>> ts_split_op_added_;
+
+  // Runs deletions of tablets received in DeleteTablets batches.
+  std::unique_ptr<ThreadPool> delete_tablets_pool_;
 };
 
 class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
@@ -292,8 +321,8 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                        consensus::LWConsensusResponsePB *resp,
                        rpc::RpcContext context) override;
 
-  void MultiRaftUpdateConsensus(const consensus::MultiRaftConsensusRequestPB *req,
-                                consensus::MultiRaftConsensusResponsePB *resp,
+  void MultiRaftUpdateConsensus(const consensus::LWMultiRaftConsensusRequestPB *req,
+                                consensus::LWMultiRaftConsensusResponsePB *resp,
                                 rpc::RpcContext context) override;
 
   void RequestConsensusVote(const consensus::VoteRequestPB* req,
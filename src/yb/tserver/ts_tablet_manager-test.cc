@@ -711,6 +711,24 @@ TEST_F(TsTabletManagerTest, DataAndWalFilesLocations) {
   }
 }
 
+TEST_F(TsTabletManagerTest, DataAndWalFilesLocationsForSmallTables) {
+  // Each table has a single tablet, so tablets should be spread across the drives.
+  std::set<std::string> data_dirs;
+  auto drive_path_len = GetDrivePath(0).size();
+  for (int i = 0; i < kDrivesNum; ++i) {
+    std::string wal;
+    std::string data;
+    tablet_manager_->GetAndRegisterDataAndWalDir(fs_manager_,
+                                                 Substitute("table-$0", i + 1),
+                                                 Substitute("tablet-$0", i + 1),
+                                                 &data,
+                                                 &wal);
+    ASSERT_EQ(data.substr(0, drive_path_len), wal.substr(0, drive_path_len));
+    data_dirs.insert(data);
+  }
+  ASSERT_EQ(data_dirs.size(), static_cast<size_t>(kDrivesNum));
+}
+
 namespace {
   const HybridTime kNoLastCompact = HybridTime(tablet::kNoLastFullCompactionTime);
   // An arbitrary realistic time.
@@ -66,10 +66,12 @@
 #include "yb/fs/fs_manager.h"
 
 #include "yb/gutil/bind.h"
+#include "yb/gutil/map-util.h"
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/gutil/sysinfo.h"
 
+#include "yb/master/master_defaults.h"
 #include "yb/master/master_heartbeat.pb.h"
 #include "yb/master/sys_catalog.h"
 
@@ -80,6 +82,7 @@
 
 #include "yb/tablet/metadata.pb.h"
 #include "yb/tablet/operations/split_operation.h"
+#include "yb/tablet/shared_transaction_status_cache.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet.pb.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
@@ -245,6 +248,10 @@ DEFINE_test_flag(int32, sleep_after_tombstoning_tablet_secs, 0,
 DEFINE_bool(enable_restart_transaction_status_tablets_first, true,
             "Set to true to prioritize bootstrapping transaction status tablets first.");
 
+DEFINE_NON_RUNTIME_uint64(shared_transaction_status_cache_size, 100000,
+    "Max number of final transaction statuses cached by tablet server, and shared by "
+    "transaction participants of all its tablets. 0 disables the cache.");
+
 DECLARE_bool(enable_wait_queues);
 
 DECLARE_string(rocksdb_compact_flush_rate_limit_sharing_mode);
@@ -325,7 +332,6 @@ using std::string;
 using std::unordered_set;
 using std::vector;
 using std::min;
-using std::deque;
 using strings::Substitute;
 using tablet::BOOTSTRAPPING;
 using tablet::NOT_STARTED;
@@ -347,6 +353,25 @@ using yb::MonoTime;
 
 constexpr int32_t kDefaultTserverBlockCacheSizePercentage = 50;
 
+namespace {
+
+// Tablets with lower priority value are bootstrapped first on tserver start.
+int BootstrapPriority(const RaftGroupMetadata& meta) {
+  if (FLAGS_enable_restart_transaction_status_tablets_first &&
+      meta.table_type() == TRANSACTION_STATUS_TABLE_TYPE) {
+    return 0;
+  }
+  auto namespace_name = meta.namespace_name();
+  if (namespace_name == master::kSystemNamespaceName ||
+      namespace_name == master::kSystemSchemaNamespaceName ||
+      namespace_name == master::kSystemAuthNamespaceName) {
+    return 1;
+  }
+  return 2;
+}
+
+} // namespace
+
 void TSTabletManager::VerifyTabletData() {
   LOG_WITH_PREFIX(INFO) << "Beginning tablet data verification checks";
   for (const TabletPeerPtr& peer : GetTabletPeers()) {
@@ -522,7 +547,12 @@ Status TSTabletManager::Init() {
         client_future(), scoped_refptr<server::Clock>(server_->clock()));
   }
 
-  deque<RaftGroupMetadataPtr> metas;
+  if (FLAGS_shared_transaction_status_cache_size > 0) {
+    shared_transaction_status_cache_ = std::make_unique<tablet::SharedTransactionStatusCache>(
+        FLAGS_shared_transaction_status_cache_size);
+  }
+
+  std::vector<RaftGroupMetadataPtr> metas;
 
   // First, load all of the tablet metadata. We do this before we start
   // submitting the actual OpenTablet() tasks so that we don't have to compete
@@ -539,22 +569,25 @@ Status TSTabletManager::Init() {
     RegisterDataAndWalDir(
         fs_manager_, meta->table_id(), meta->raft_group_id(), meta->data_root_dir(),
         meta->wal_root_dir());
-    if (FLAGS_enable_restart_transaction_status_tablets_first) {
-      // Prioritize bootstrapping transaction status tablets first.
-      if (meta->table_type() == TRANSACTION_STATUS_TABLE_TYPE) {
-        metas.push_front(meta);
-      } else {
-        metas.push_back(meta);
-      }
-    } else {
-      metas.push_back(meta);
-    }
+    metas.push_back(meta);
   }
 
+  // Tablets that other tablets depend on are bootstrapped first, i.e. transaction status tablets
+  // are required to resolve intents of all other transactional tablets, and system tablets are
+  // required by clients before user data is accessed.
+  std::stable_sort(
+      metas.begin(), metas.end(),
+      [](const RaftGroupMetadataPtr& lhs, const RaftGroupMetadataPtr& rhs) {
+    return BootstrapPriority(*lhs) < BootstrapPriority(*rhs);
+  });
+
   MonoDelta elapsed = MonoTime::Now().GetDeltaSince(start);
   LOG(INFO) << "Loaded metadata for " << tablet_ids.size() << " tablet in "
             << elapsed.ToMilliseconds() << " ms";
 
+  startup_bootstrap_progress_.start = CoarseMonoClock::now();
+  startup_bootstrap_progress_.num_total.store(metas.size(), std::memory_order_release);
+
   // Now submit the "Open" task for each.
   for (const RaftGroupMetadataPtr& meta : metas) {
     scoped_refptr<TransitionInProgressDeleter> deleter;
@@ -562,8 +595,10 @@ Status TSTabletManager::Init() {
         meta->raft_group_id(), "opening tablet", &deleter));
 
     TabletPeerPtr tablet_peer = VERIFY_RESULT(CreateAndRegisterTabletPeer(meta, NEW_PEER));
-    RETURN_NOT_OK(open_tablet_pool_->SubmitFunc(
-        std::bind(&TSTabletManager::OpenTablet, this, meta, deleter)));
+    RETURN_NOT_OK(open_tablet_pool_->SubmitFunc([this, meta, deleter] {
+      OpenTablet(meta, deleter);
+      startup_bootstrap_progress_.num_done.fetch_add(1, std::memory_order_acq_rel);
+    }));
   }
 
   // Background task initiation.
@@ -1550,7 +1585,11 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
       .waiting_txn_registry = waiting_txn_registry_.get(),
       .wait_queue_pool = wait_queue_pool_.get(),
       .full_compaction_pool = full_compaction_pool(),
-      .post_split_compaction_added = ts_post_split_compaction_added_
+      .post_split_compaction_added = ts_post_split_compaction_added_,
+      .post_split_compaction_done = [this] {
+        full_compaction_manager_->SchedulePostSplitCompactions();
+      },
+      .shared_transaction_status_cache = shared_transaction_status_cache_.get(),
     };
     tablet::BootstrapTabletData data = {
       .tablet_init_data = tablet_init_data,
@@ -1614,7 +1653,7 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
     }
   }
 
-  tablet->TriggerPostSplitCompactionIfNeeded();
+  full_compaction_manager_->TriggerPostSplitCompactionIfNeeded(tablet.get());
 
   if (tablet->ShouldDisableLbMove()) {
     std::lock_guard<RWMutex> lock(mutex_);
@@ -2001,6 +2040,24 @@ Status TSTabletManager::GetNumTabletsPendingBootstrap(
   return Status::OK();
 }
 
+std::string TSTabletManager::StartupBootstrapProgress() const {
+  const auto& progress = startup_bootstrap_progress_;
+  auto total = progress.num_total.load(std::memory_order_acquire);
+  auto done = progress.num_done.load(std::memory_order_acquire);
+  if (done >= total) {
+    return Format("Bootstrapped all $0 tablets", total);
+  }
+  auto elapsed = CoarseMonoClock::now() - progress.start;
+  auto result = Format("Bootstrapped $0 of $1 tablets in $2", done, total, MonoDelta(elapsed));
+  if (done > 0) {
+    // Tablets are bootstrapped in order of priority, not size, so this is only a rough estimate.
+    result += Format(
+        ", ETA $0", MonoDelta(elapsed * static_cast<int64_t>(total - done) /
+                              static_cast<int64_t>(done)));
+  }
+  return result;
+}
+
 int TSTabletManager::GetNumLiveTablets() const {
   int count = 0;
   SharedLock<RWMutex> lock(mutex_);
@@ -2313,24 +2370,10 @@ void TSTabletManager::GetAndRegisterDataAndWalDir(FsManager* fs_manager,
     }
   }
   // Find the data directory with the least count of tablets for this table.
-  table_data_assignment_iter = table_data_assignment_map_.find(table_id);
-  auto data_assignment_value_map = table_data_assignment_iter->second;
-  string min_dir;
-  uint64_t min_dir_count = kuint64max;
-  for (auto it = data_assignment_value_map.begin(); it != data_assignment_value_map.end(); ++it) {
-    if (min_dir_count > it->second.size()) {
-      min_dir = it->first;
-      min_dir_count = it->second.size();
-    }
-  }
-  *data_root_dir = min_dir;
-  // Increment the count for min_dir.
-  auto data_assignment_value_iter = table_data_assignment_map_[table_id].find(min_dir);
-  data_assignment_value_iter->second.insert(tablet_id);
+  *data_root_dir = GetLeastLoadedDirUnlocked(table_data_assignment_map_, table_id);
+  table_data_assignment_map_[table_id][*data_root_dir].insert(tablet_id);
 
   // Find the wal directory with the least count of tablets for this table.
-  min_dir = "";
-  min_dir_count = kuint64max;
   auto wal_root_dirs = fs_manager->GetWalRootDirs();
   CHECK(!wal_root_dirs.empty()) << "No wal root directories found";
   auto table_wal_assignment_iter = table_wal_assignment_map_.find(table_id);
@@ -2340,17 +2383,35 @@ void TSTabletManager::GetAndRegisterDataAndWalDir(FsManager* fs_manager,
       table_wal_assignment_map_[table_id][wal_root_iter] = tablet_id_set;
     }
   }
-  table_wal_assignment_iter = table_wal_assignment_map_.find(table_id);
-  auto wal_assignment_value_map = table_wal_assignment_iter->second;
-  for (auto it = wal_assignment_value_map.begin(); it != wal_assignment_value_map.end(); ++it) {
-    if (min_dir_count > it->second.size()) {
-      min_dir = it->first;
-      min_dir_count = it->second.size();
+  *wal_root_dir = GetLeastLoadedDirUnlocked(table_wal_assignment_map_, table_id);
+  table_wal_assignment_map_[table_id][*wal_root_dir].insert(tablet_id);
+}
+
+std::string TSTabletManager::GetLeastLoadedDirUnlocked(
+    const TableDiskAssignmentMap& assignment_map, const TableId& table_id) {
+  // Total number of tablets of all tables, assigned to each directory.
+  std::unordered_map<std::string, size_t> total_counts;
+  for (const auto& table_and_dirs : assignment_map) {
+    for (const auto& dir_and_tablets : table_and_dirs.second) {
+      total_counts[dir_and_tablets.first] += dir_and_tablets.second.size();
+    }
+  }
+
+  // Pick the directory with the least count of tablets for this table. Ties are broken by the
+  // total count of tablets in the directory, otherwise tables with a few tablets would all be
+  // placed to the first directory.
+  const std::string* result = nullptr;
+  std::pair<size_t, size_t> min_counts(kuint64max, kuint64max);
+  for (const auto& dir_and_tablets : FindOrDie(assignment_map, table_id)) {
+    std::pair<size_t, size_t> counts(
+        dir_and_tablets.second.size(), total_counts[dir_and_tablets.first]);
+    if (counts < min_counts) {
+      result = &dir_and_tablets.first;
+      min_counts = counts;
     }
   }
-  *wal_root_dir = min_dir;
-  auto wal_assignment_value_iter = table_wal_assignment_map_[table_id].find(min_dir);
-  wal_assignment_value_iter->second.insert(tablet_id);
+  CHECK(result) << "No directories assigned for table " << table_id;
+  return *result;
 }
 
 void TSTabletManager::RegisterDataAndWalDir(FsManager* fs_manager,
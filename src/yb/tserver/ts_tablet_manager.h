@@ -300,6 +300,10 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Return the number of tablets in RUNNING or BOOTSTRAPPING state.
   int GetNumLiveTablets() const;
 
+  // Human readable progress of bootstrapping the tablets found on disk at start, with the
+  // estimated time to finish it.
+  std::string StartupBootstrapProgress() const;
+
   // Return the number of tablets for which this ts is a leader.
   int GetLeaderCount() const;
 
@@ -451,6 +455,11 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Returns either table_data_assignment_map_ or table_wal_assignment_map_ depending on dir_type.
   TableDiskAssignmentMap* GetTableDiskAssignmentMapUnlocked(TabletDirType dir_type);
 
+  // Returns the directory of the assignment map with the least count of tablets of the table,
+  // preferring directories with the least total count of tablets.
+  std::string GetLeastLoadedDirUnlocked(
+      const TableDiskAssignmentMap& assignment_map, const TableId& table_id);
+
   // Returns assigned root dir of specified type for specified table and tablet.
   // If root dir is not registered for the specified table_id and tablet_id combination - returns
   // error.
@@ -627,6 +636,8 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   std::unique_ptr<rpc::Poller> waiting_txn_registry_poller_;
 
+  std::unique_ptr<tablet::SharedTransactionStatusCache> shared_transaction_status_cache_;
+
   // For block cache and memory monitor shared across tablets
   tablet::TabletOptions tablet_options_;
 
@@ -640,6 +651,15 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   std::atomic<int32_t> num_tablets_being_remote_bootstrapped_{0};
 
+  // Progress of bootstrapping the tablets found on disk at start. start is set in Init() before
+  // num_total is published, and neither is changed after that.
+  struct StartupBootstrapProgressInfo {
+    CoarseTimePoint start;
+    std::atomic<size_t> num_total{0};
+    std::atomic<size_t> num_done{0};
+  };
+  StartupBootstrapProgressInfo startup_bootstrap_progress_;
+
   // Gauge to monitor applied split operations.
   scoped_refptr<yb::AtomicGauge<uint64_t>> ts_split_op_apply_;
 
@@ -44,6 +44,8 @@
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/quorum_util.h"
 
+#include "yb/docdb/doc_key.h"
+
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/join.h"
@@ -239,7 +241,8 @@ void HandleTabletPage(
       {"tablet-consensus-status", "Consensus Status"},
       {"log-anchors", "Tablet Log Anchors"},
       {"transactions", "Transactions"},
-      {"rocksdb", "RocksDB" }};
+      {"rocksdb", "RocksDB" },
+      {"hot-keys", "Hot Keys"}};
 
   auto encoded_tablet_id = UrlEncodeToString(tablet_id);
   for (const auto& entry : entries) {
@@ -385,6 +388,35 @@ void HandleRocksDBPage(
   DumpRocksDB("Intents", doc_db.intents, output);
 }
 
+void OutputHotKeys(const char* title, tablet::HotKeys* hot_keys, std::stringstream* out) {
+  *out << "<h2>" << title << "</h2>\n";
+  *out << "<table class='table table-striped'>\n";
+  *out << "  <tr><th>Key</th><th>Estimated Count</th><th>Max Error</th></tr>\n";
+  for (const auto& entry : hot_keys->TopKeys(std::numeric_limits<size_t>::max())) {
+    *out << Format(
+        "  <tr><td>$0</td><td>$1</td><td>$2</td></tr>\n",
+        EscapeForHtmlToString(docdb::DocKey::DebugSliceToString(entry.key)), entry.count,
+        entry.error);
+  }
+  *out << "</table>\n";
+}
+
+void HandleHotKeysPage(
+    const std::string& tablet_id, const tablet::TabletPeerPtr& peer,
+    const Webserver::WebRequest& req, Webserver::WebResponse* resp) {
+  std::stringstream *output = &resp->output;
+  *output << "<h1>Hot Keys for Tablet " << EscapeForHtmlToString(tablet_id) << "</h1>"
+          << std::endl;
+
+  auto tablet_result = peer->shared_tablet_safe();
+  if (!tablet_result.ok()) {
+    *output << tablet_result.status();
+    return;
+  }
+  OutputHotKeys("Read", &(*tablet_result)->hot_read_keys(), output);
+  OutputHotKeys("Write", &(*tablet_result)->hot_write_keys(), output);
+}
+
 template<class F>
 void RegisterTabletPathHandler(
     Webserver* web_server, TabletServer* tserver, const std::string& path, const F& f) {
@@ -421,6 +453,7 @@ Status TabletServerPathHandlers::Register(Webserver* server) {
   RegisterTabletPathHandler(server, tserver_, "/log-anchors", &HandleLogAnchorsPage);
   RegisterTabletPathHandler(server, tserver_, "/transactions", &HandleTransactionsPage);
   RegisterTabletPathHandler(server, tserver_, "/rocksdb", &HandleRocksDBPage);
+  RegisterTabletPathHandler(server, tserver_, "/hot-keys", &HandleHotKeysPage);
   server->RegisterPathHandler(
       "/", "Dashboards",
       std::bind(&TabletServerPathHandlers::HandleDashboardsPage, this, _1, _2), true /* styled */,
@@ -666,6 +699,8 @@ void TabletServerPathHandlers::HandleTabletsPage(const Webserver::WebRequest& re
   std::sort(peers.begin(), peers.end(), &CompareByTabletId);
 
   *output << "<h1>Tablets</h1>\n";
+  *output << "<p>" << EscapeForHtmlToString(tserver_->tablet_manager()->StartupBootstrapProgress())
+          << "</p>\n";
   *output << "<table class='table table-striped'>\n";
   *output << "  <tr><th>Namespace</th><th>Table name</th><th>Table UUID</th><th>Tablet ID</th>"
              "<th>Partition</th>"
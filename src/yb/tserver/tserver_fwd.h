@@ -34,8 +34,11 @@ namespace tserver {
 class Heartbeater;
 class LocalTabletServer;
 class MetricsSnapshotter;
+class PgSequenceCache;
 class PgTableCache;
+class RpcTraceCapture;
 class TSTabletManager;
+class TableQuotas;
 class TabletPeerLookupIf;
 class TabletServer;
 class TabletServerAdminServiceProxy;
@@ -20,6 +20,7 @@
 #include "yb/master/master_heartbeat.pb.h"
 
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_peer.h"
 
@@ -42,6 +43,12 @@ DEFINE_bool(tserver_heartbeat_metrics_add_drive_data, true,
 DEFINE_bool(tserver_heartbeat_metrics_add_replication_status, true,
             "Add replication status to metrics tserver sends to master");
 
+DEFINE_int32(tserver_heartbeat_metrics_full_drive_data_interval, 12,
+             "Number of metrics heartbeats after which tserver reports drive data of all its "
+             "tablets to master. In other metrics heartbeats only the tablets, whose drive data "
+             "changed since the previous report, are included. Values less than 2 mean that all "
+             "tablets are reported in every metrics heartbeat.");
+
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
 
 using namespace std::literals;
@@ -72,24 +79,44 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
   bool should_add_replication_status =
       FLAGS_tserver_heartbeat_metrics_add_replication_status && no_full_tablet_report;
 
+  // Master keeps the last reported drive data of each tablet replica, so only changed entries are
+  // sent, with periodic full reports to repair data dropped by master, e.g. on leader change.
+  bool add_all_tablet_data = false;
+  if (should_add_tablet_data) {
+    if (++metrics_heartbeats_since_full_drive_data_ >=
+            FLAGS_tserver_heartbeat_metrics_full_drive_data_interval) {
+      add_all_tablet_data = true;
+      metrics_heartbeats_since_full_drive_data_ = 0;
+    }
+  } else {
+    // Master requested full tablet report, so it could have lost any previously reported data.
+    prev_tablet_drive_data_.clear();
+  }
+
+  const auto now = CoarseMonoClock::Now();
+  std::unordered_map<TabletId, TabletOps> tablet_ops;
+  std::unordered_map<TabletId, TabletDriveData> tablet_drive_data;
   for (const auto& tablet_peer : server().tablet_manager()->GetTabletPeers()) {
     if (tablet_peer) {
       auto tablet = tablet_peer->shared_tablet();
       if (tablet) {
-        auto sizes = tablet->GetCurrentVersionSstFilesAllSizes();
+        auto sizes = tablet->GetOwnSstFilesAllSizes();
         total_file_sizes += sizes.first;
         uncompressed_file_sizes += sizes.second;
         num_files += tablet->GetCurrentVersionNumSSTFiles();
         if (should_add_tablet_data && tablet_peer->log_available() &&
             tablet_peer->tablet_metadata()->tablet_data_state() ==
               tablet::TabletDataState::TABLET_DATA_READY) {
-          auto tablet_metadata = req->add_storage_metadata();
-          tablet_metadata->set_tablet_id(tablet_peer->tablet_id());
-          tablet_metadata->set_sst_file_size(sizes.first);
-          tablet_metadata->set_wal_file_size(tablet_peer->log()->OnDiskSize());
-          tablet_metadata->set_uncompressed_sst_file_size(sizes.second);
-          tablet_metadata->set_may_have_orphaned_post_split_data(
+          master::TabletDriveStorageMetadataPB tablet_metadata;
+          tablet_metadata.set_tablet_id(tablet_peer->tablet_id());
+          tablet_metadata.set_sst_file_size(sizes.first);
+          tablet_metadata.set_wal_file_size(tablet_peer->log()->OnDiskSize());
+          tablet_metadata.set_uncompressed_sst_file_size(sizes.second);
+          tablet_metadata.set_may_have_orphaned_post_split_data(
                 tablet->MayHaveOrphanedPostSplitData());
+          tablet_metadata.set_estimated_num_rows(tablet->EstimatedNumRows());
+          AddTabletOps(tablet_peer->tablet_id(), tablet.get(), now, &tablet_metadata, &tablet_ops);
+          AddTabletDriveData(add_all_tablet_data, &tablet_metadata, &tablet_drive_data, req);
         }
       }
     }
@@ -134,6 +161,11 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
     }
   }
 
+  if (should_add_tablet_data) {
+    prev_tablet_ops_ = std::move(tablet_ops);
+    prev_tablet_drive_data_ = std::move(tablet_drive_data);
+  }
+
   metrics->set_total_sst_file_size(total_file_sizes);
   metrics->set_uncompressed_sst_file_size(uncompressed_file_sizes);
   metrics->set_num_sst_files(num_files);
@@ -187,6 +219,55 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
   }
 }
 
+void TServerMetricsHeartbeatDataProvider::AddTabletOps(
+    const TabletId& tablet_id, tablet::Tablet* tablet, CoarseTimePoint now,
+    master::TabletDriveStorageMetadataPB* tablet_metadata,
+    std::unordered_map<TabletId, TabletOps>* tablet_ops) {
+  auto* tablet_metrics = tablet->metrics();
+  if (!tablet_metrics) {
+    return;
+  }
+  TabletOps ops {
+    .reads = tablet_metrics->read_requests_handled->value(),
+    .writes = tablet_metrics->write_batches_handled->value(),
+    .time = now,
+  };
+  auto it = prev_tablet_ops_.find(tablet_id);
+  if (it != prev_tablet_ops_.end()) {
+    auto seconds = MonoDelta(now - it->second.time).ToSeconds();
+    if (seconds > 0) {
+      tablet_metadata->set_read_ops_per_sec((ops.reads - it->second.reads) / seconds);
+      tablet_metadata->set_write_ops_per_sec((ops.writes - it->second.writes) / seconds);
+    }
+  }
+  tablet_metadata->set_hot_key_fraction(std::max(
+      tablet->hot_read_keys().TopKeyFraction(), tablet->hot_write_keys().TopKeyFraction()));
+  tablet_ops->emplace(tablet_id, ops);
+}
+
+void TServerMetricsHeartbeatDataProvider::AddTabletDriveData(
+    bool add_all_tablet_data, master::TabletDriveStorageMetadataPB* tablet_metadata,
+    std::unordered_map<TabletId, TabletDriveData>* tablet_drive_data,
+    master::TSHeartbeatRequestPB* req) {
+  TabletDriveData drive_data {
+    .sst_file_size = tablet_metadata->sst_file_size(),
+    .wal_file_size = tablet_metadata->wal_file_size(),
+    .uncompressed_sst_file_size = tablet_metadata->uncompressed_sst_file_size(),
+    .may_have_orphaned_post_split_data = tablet_metadata->may_have_orphaned_post_split_data(),
+    .read_ops_per_sec = tablet_metadata->read_ops_per_sec(),
+    .write_ops_per_sec = tablet_metadata->write_ops_per_sec(),
+    .hot_key_fraction = tablet_metadata->hot_key_fraction(),
+    .estimated_num_rows = tablet_metadata->estimated_num_rows(),
+  };
+  const auto& tablet_id = tablet_metadata->tablet_id();
+  auto it = prev_tablet_drive_data_.find(tablet_id);
+  bool changed = it == prev_tablet_drive_data_.end() || !(it->second == drive_data);
+  tablet_drive_data->emplace(tablet_id, drive_data);
+  if (add_all_tablet_data || changed) {
+    req->add_storage_metadata()->Swap(tablet_metadata);
+  }
+}
+
 uint64_t TServerMetricsHeartbeatDataProvider::CalculateUptime() {
   MonoDelta delta = MonoTime::Now().GetDeltaSince(start_time_);
   uint64_t uptime_seconds = static_cast<uint64_t>(delta.ToSeconds());
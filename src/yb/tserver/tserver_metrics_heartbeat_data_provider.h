@@ -14,8 +14,14 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 
 #include "yb/cdc/cdc_util.h"
+
+#include "yb/master/master_heartbeat.fwd.h"
+
+#include "yb/tablet/tablet_fwd.h"
+
 #include "yb/tserver/heartbeater.h"
 
 namespace yb {
@@ -31,12 +37,63 @@ class TServerMetricsHeartbeatDataProvider : public PeriodicalHeartbeatDataProvid
 
   uint64_t CalculateUptime();
 
+  // Stores the per tablet read and write ops for computing per tablet iops.
+  struct TabletOps {
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+    CoarseTimePoint time;
+  };
+
+  // Sets the rate of read and write ops handled by the tablet since the previous report, and
+  // stores the current number of ops to tablet_ops.
+  void AddTabletOps(
+      const TabletId& tablet_id, tablet::Tablet* tablet, CoarseTimePoint now,
+      master::TabletDriveStorageMetadataPB* tablet_metadata,
+      std::unordered_map<TabletId, TabletOps>* tablet_ops);
+
+  // Drive data of the tablet, as it was reported to master.
+  struct TabletDriveData {
+    uint64_t sst_file_size = 0;
+    uint64_t wal_file_size = 0;
+    uint64_t uncompressed_sst_file_size = 0;
+    bool may_have_orphaned_post_split_data = false;
+    double read_ops_per_sec = 0;
+    double write_ops_per_sec = 0;
+    double hot_key_fraction = 0;
+    uint64_t estimated_num_rows = 0;
+
+    bool operator==(const TabletDriveData& rhs) const {
+      return sst_file_size == rhs.sst_file_size && wal_file_size == rhs.wal_file_size &&
+             uncompressed_sst_file_size == rhs.uncompressed_sst_file_size &&
+             may_have_orphaned_post_split_data == rhs.may_have_orphaned_post_split_data &&
+             read_ops_per_sec == rhs.read_ops_per_sec &&
+             write_ops_per_sec == rhs.write_ops_per_sec &&
+             hot_key_fraction == rhs.hot_key_fraction &&
+             estimated_num_rows == rhs.estimated_num_rows;
+    }
+  };
+
+  // Adds tablet_metadata to the heartbeat request, when add_all_tablet_data is set or the drive
+  // data of the tablet changed since the previous report, and stores its drive data to
+  // tablet_drive_data.
+  void AddTabletDriveData(
+      bool add_all_tablet_data, master::TabletDriveStorageMetadataPB* tablet_metadata,
+      std::unordered_map<TabletId, TabletDriveData>* tablet_drive_data,
+      master::TSHeartbeatRequestPB* req);
+
   MonoTime start_time_;
 
   // Stores the total read and writes ops for computing iops.
   uint64_t prev_reads_ = 0;
   uint64_t prev_writes_ = 0;
 
+  std::unordered_map<TabletId, TabletOps> prev_tablet_ops_;
+
+  std::unordered_map<TabletId, TabletDriveData> prev_tablet_drive_data_;
+
+  // Number of metrics heartbeats since drive data of all tablets was reported.
+  int metrics_heartbeats_since_full_drive_data_ = 0;
+
   // Stores the previously reported replication errors.
   cdc::TabletReplicationErrorMap prev_replication_error_map_;
 };
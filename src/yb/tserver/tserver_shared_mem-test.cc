@@ -0,0 +1,99 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <unistd.h>
+
+#include <string>
+#include <thread>
+
+#include "yb/tserver/tserver_shared_mem.h"
+
+#include "yb/util/random_util.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace tserver {
+
+constexpr size_t kMaxMessageSize = 64 * 1024;
+
+class SharedExchangeTest : public YBTest {
+};
+
+TEST_F(SharedExchangeTest, Exchange) {
+  constexpr size_t kBufferSize = 1024;
+  constexpr int kRequests = 100;
+
+  auto client = ASSERT_RESULT(SharedExchange::Create(kBufferSize, kMaxMessageSize));
+  auto server = ASSERT_RESULT(SharedExchange::Open(
+      getpid(), client->fd(), kBufferSize, kMaxMessageSize));
+
+  std::thread server_thread([&server] {
+    for (;;) {
+      auto request = server->ReceiveRequest();
+      if (!request.ok()) {
+        ASSERT_TRUE(request.status().IsShutdownInProgress()) << request.status();
+        break;
+      }
+      // Response is the request repeated twice, so it is split into chunks more often.
+      auto data = request->data.AsSlice();
+      ASSERT_OK(server->Respond({data, data}, request->deadline));
+    }
+  });
+
+  for (int i = 0; i != kRequests; ++i) {
+    // Covers empty, single chunk and multiple chunks requests.
+    auto size = i == 0 ? 0 : RandomUniformInt<size_t>(1, kBufferSize * 3);
+    auto request = RandomHumanReadableString(size);
+    auto half = request.size() / 2;
+    auto response = ASSERT_RESULT(client->Exchange(
+        {Slice(request.data(), half), Slice(request.data() + half, request.size() - half)},
+        CoarseMonoClock::now() + 10s));
+    ASSERT_EQ(response.AsSlice().ToBuffer(), request + request);
+  }
+
+  client->SignalStop();
+  server_thread.join();
+
+  ASSERT_TRUE(client->Exchange({}, CoarseMonoClock::now() + 1s).status().IsShutdownInProgress());
+}
+
+TEST_F(SharedExchangeTest, Timeout) {
+  auto client = ASSERT_RESULT(SharedExchange::Create(1024, kMaxMessageSize));
+  auto status = client->Exchange({Slice("request")}, CoarseMonoClock::now() + 100ms).status();
+  ASSERT_TRUE(status.IsTimedOut()) << status;
+}
+
+TEST_F(SharedExchangeTest, TooBigMessage) {
+  constexpr size_t kBufferSize = 1024;
+
+  auto client = ASSERT_RESULT(SharedExchange::Create(kBufferSize, kMaxMessageSize * 2));
+  auto server = ASSERT_RESULT(SharedExchange::Open(
+      getpid(), client->fd(), kBufferSize, kMaxMessageSize));
+
+  std::thread server_thread([&server] {
+    auto request = server->ReceiveRequest();
+    ASSERT_TRUE(request.status().IsCorruption()) << request.status();
+    server->SignalStop();
+  });
+
+  auto request = RandomHumanReadableString(kMaxMessageSize + 1);
+  auto status = client->Exchange({Slice(request)}, CoarseMonoClock::now() + 10s).status();
+  server_thread.join();
+  ASSERT_TRUE(status.IsShutdownInProgress()) << status;
+}
+
+} // namespace tserver
+} // namespace yb
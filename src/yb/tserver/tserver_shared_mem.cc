@@ -0,0 +1,247 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/tserver_shared_mem.h"
+
+#include <fcntl.h>
+#include <sched.h>
+
+#include <limits>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include "yb/gutil/casts.h"
+
+#include "yb/util/enums.h"
+#include "yb/util/errno.h"
+#include "yb/util/format.h"
+#include "yb/util/status_format.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace tserver {
+
+enum class SharedExchangeOwner : uint32_t {
+  kClient = 0,
+  kServer = 1,
+  kShutdown = 2,
+};
+
+struct SharedExchangeHeader {
+  // Futex word, so stored as a plain 32 bit value.
+  std::atomic<uint32_t> owner{to_underlying(SharedExchangeOwner::kClient)};
+  // Request timeout, 0 when request does not have deadline.
+  uint32_t timeout_ms = 0;
+  // Size of the whole message.
+  uint64_t total_size = 0;
+  // Size of the message part, currently stored in the buffer.
+  uint64_t chunk_size = 0;
+};
+
+namespace {
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+// Waits for value at addr to change from expected, or deadline to pass.
+void FutexWait(std::atomic<uint32_t>* addr, uint32_t expected, CoarseTimePoint deadline) {
+#if defined(__linux__)
+  struct timespec ts;
+  struct timespec* timeout = nullptr;
+  if (deadline != CoarseTimePoint::max()) {
+    MonoDelta(deadline - CoarseMonoClock::now()).ToTimeSpec(&ts);
+    timeout = &ts;
+  }
+  // Futex is shared between processes, so FUTEX_PRIVATE_FLAG is not used.
+  syscall(SYS_futex, addr, FUTEX_WAIT, expected, timeout, nullptr, 0);
+#else
+  sched_yield();
+#endif
+}
+
+void FutexWakeAll(std::atomic<uint32_t>* addr) {
+#if defined(__linux__)
+  syscall(SYS_futex, addr, FUTEX_WAKE, std::numeric_limits<int>::max(), nullptr, nullptr, 0);
+#endif
+}
+
+} // namespace
+
+Result<std::unique_ptr<SharedExchange>> SharedExchange::Create(
+    size_t buffer_size, size_t max_message_size) {
+  auto segment = VERIFY_RESULT(SharedMemorySegment::Create(
+      sizeof(SharedExchangeHeader) + buffer_size));
+  new (segment.GetAddress()) SharedExchangeHeader();
+  return std::make_unique<SharedExchange>(std::move(segment), buffer_size, max_message_size);
+}
+
+Result<std::unique_ptr<SharedExchange>> SharedExchange::Open(
+    int pid, int fd, size_t buffer_size, size_t max_message_size) {
+  // Segment is created by the postgres backend, so it is accessible by its fd in /proc.
+  auto path = Format("/proc/$0/fd/$1", pid, fd);
+  int local_fd = open(path.c_str(), O_RDWR);
+  if (local_fd == -1) {
+    return STATUS_FROM_ERRNO(path, errno);
+  }
+  auto segment = SharedMemorySegment::Open(
+      local_fd, SharedMemorySegment::AccessMode::kReadWrite,
+      sizeof(SharedExchangeHeader) + buffer_size);
+  if (!segment.ok()) {
+    close(local_fd);
+    return segment.status();
+  }
+  return std::make_unique<SharedExchange>(std::move(*segment), buffer_size, max_message_size);
+}
+
+SharedExchange::SharedExchange(
+    SharedMemorySegment segment, size_t buffer_size, size_t max_message_size)
+    : segment_(std::move(segment)), buffer_size_(buffer_size),
+      max_message_size_(max_message_size),
+      header_(*static_cast<SharedExchangeHeader*>(segment_.GetAddress())) {
+}
+
+SharedExchange::~SharedExchange() = default;
+
+Result<RefCntBuffer> SharedExchange::Exchange(
+    const std::vector<Slice>& request, CoarseTimePoint deadline) {
+  RETURN_NOT_OK(SendRequest(request, deadline));
+  return FetchResponse(deadline);
+}
+
+Status SharedExchange::SendRequest(const std::vector<Slice>& request, CoarseTimePoint deadline) {
+  uint32_t timeout_ms = 0;
+  if (deadline != CoarseTimePoint::max()) {
+    timeout_ms = narrow_cast<uint32_t>(std::max<int64_t>(
+        MonoDelta(deadline - CoarseMonoClock::now()).ToMilliseconds(), 1));
+  }
+  RETURN_NOT_OK(WaitOwnership(SharedExchangeOwner::kClient, deadline));
+  header_.timeout_ms = timeout_ms;
+  return Send(SharedExchangeOwner::kClient, SharedExchangeOwner::kServer, request, deadline);
+}
+
+Result<RefCntBuffer> SharedExchange::FetchResponse(CoarseTimePoint deadline) {
+  RETURN_NOT_OK(WaitOwnership(SharedExchangeOwner::kClient, deadline));
+  return Receive(SharedExchangeOwner::kClient, SharedExchangeOwner::kServer, deadline);
+}
+
+Result<SharedExchangeRequest> SharedExchange::ReceiveRequest() {
+  RETURN_NOT_OK(WaitOwnership(SharedExchangeOwner::kServer, CoarseTimePoint::max()));
+  auto timeout_ms = header_.timeout_ms;
+  SharedExchangeRequest result {
+    .data = {},
+    .deadline = timeout_ms ? CoarseMonoClock::now() + timeout_ms * 1ms : CoarseTimePoint::max(),
+  };
+  result.data = VERIFY_RESULT(Receive(
+      SharedExchangeOwner::kServer, SharedExchangeOwner::kClient, result.deadline));
+  return result;
+}
+
+Status SharedExchange::Respond(const std::vector<Slice>& response, CoarseTimePoint deadline) {
+  return Send(SharedExchangeOwner::kServer, SharedExchangeOwner::kClient, response, deadline);
+}
+
+void SharedExchange::SignalStop() {
+  header_.owner.store(
+      to_underlying(SharedExchangeOwner::kShutdown), std::memory_order_release);
+  FutexWakeAll(&header_.owner);
+}
+
+Status SharedExchange::Send(
+    SharedExchangeOwner self, SharedExchangeOwner peer, const std::vector<Slice>& parts,
+    CoarseTimePoint deadline) {
+  size_t total_size = 0;
+  for (const auto& part : parts) {
+    total_size += part.size();
+  }
+  header_.total_size = total_size;
+  auto* buffer = pointer_cast<uint8_t*>(&header_ + 1);
+  size_t chunk_size = 0;
+  for (auto part : parts) {
+    while (!part.empty()) {
+      if (chunk_size == buffer_size_) {
+        header_.chunk_size = chunk_size;
+        RETURN_NOT_OK(PassOwnership(self, peer));
+        RETURN_NOT_OK(WaitOwnership(self, deadline));
+        chunk_size = 0;
+      }
+      auto len = std::min(part.size(), buffer_size_ - chunk_size);
+      memcpy(buffer + chunk_size, part.data(), len);
+      chunk_size += len;
+      part.remove_prefix(len);
+    }
+  }
+  header_.chunk_size = chunk_size;
+  return PassOwnership(self, peer);
+}
+
+Result<RefCntBuffer> SharedExchange::Receive(
+    SharedExchangeOwner self, SharedExchangeOwner peer, CoarseTimePoint deadline) {
+  // Header is written by the other process, so its size is validated before allocation.
+  auto total_size = header_.total_size;
+  if (total_size > max_message_size_) {
+    return STATUS_FORMAT(
+        Corruption, "Shared exchange message is too big: $0, max allowed: $1",
+        total_size, max_message_size_);
+  }
+  RefCntBuffer result(total_size);
+  const auto* buffer = pointer_cast<const uint8_t*>(&header_ + 1);
+  size_t received = 0;
+  for (;;) {
+    auto chunk_size = header_.chunk_size;
+    if (chunk_size > buffer_size_ || chunk_size > result.size() - received ||
+        (chunk_size == 0 && received != result.size())) {
+      return STATUS_FORMAT(
+          Corruption, "Wrong shared exchange chunk size $0, received $1 of $2",
+          chunk_size, received, result.size());
+    }
+    memcpy(result.udata() + received, buffer, chunk_size);
+    received += chunk_size;
+    if (received == result.size()) {
+      return result;
+    }
+    RETURN_NOT_OK(PassOwnership(self, peer));
+    RETURN_NOT_OK(WaitOwnership(self, deadline));
+  }
+}
+
+Status SharedExchange::WaitOwnership(SharedExchangeOwner self, CoarseTimePoint deadline) {
+  for (;;) {
+    auto owner = header_.owner.load(std::memory_order_acquire);
+    if (owner == to_underlying(self)) {
+      return Status::OK();
+    }
+    if (owner == to_underlying(SharedExchangeOwner::kShutdown)) {
+      return STATUS(ShutdownInProgress, "Shared exchange stopped");
+    }
+    if (CoarseMonoClock::now() >= deadline) {
+      return STATUS(TimedOut, "Timed out waiting for shared exchange");
+    }
+    FutexWait(&header_.owner, owner, deadline);
+  }
+}
+
+Status SharedExchange::PassOwnership(SharedExchangeOwner self, SharedExchangeOwner peer) {
+  auto expected = to_underlying(self);
+  if (!header_.owner.compare_exchange_strong(
+          expected, to_underlying(peer), std::memory_order_acq_rel)) {
+    return STATUS(ShutdownInProgress, "Shared exchange stopped");
+  }
+  FutexWakeAll(&header_.owner);
+  return Status::OK();
+}
+
+} // namespace tserver
+} // namespace yb
@@ -14,13 +14,19 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
+#include <vector>
 
 #include <boost/asio/ip/tcp.hpp>
 
 #include "yb/tserver/tserver_util_fwd.h"
 
 #include "yb/util/atomic.h"
+#include "yb/util/monotime.h"
 #include "yb/util/net/net_fwd.h"
+#include "yb/util/ref_cnt_buffer.h"
+#include "yb/util/result.h"
+#include "yb/util/shared_mem.h"
 #include "yb/util/slice.h"
 
 #include "yb/yql/pggate/ybc_pg_typedefs.h"
@@ -96,6 +102,79 @@ class TServerSharedData {
   std::atomic<uint64_t> db_catalog_versions_[kMaxNumDbCatalogVersions] = {0};
 };
 
+struct SharedExchangeHeader;
+enum class SharedExchangeOwner : uint32_t;
+
+struct SharedExchangeRequest {
+  RefCntBuffer data;
+  CoarseTimePoint deadline;
+};
+
+// Request/response exchange between postgres backend and its PgClientSession, through shared
+// memory segment created by the backend and mapped by the tserver.
+// The buffer is owned either by the client or by the server, and ownership is passed to the peer
+// with futex wakeup. Message that does not fit into the buffer is passed in several chunks,
+// every chunk except the last one is acknowledged by the receiver passing ownership back.
+// Only one request could be in flight. The response is fetched by the client after sending the
+// request, without any intermediate thread on the server side.
+// Messages larger than max_message_size are rejected by the receiver as corrupted, so size read
+// from the shared header never results in an unbounded allocation.
+class SharedExchange {
+ public:
+  // Creates exchange with buffer of specified size, to be used by the client.
+  static Result<std::unique_ptr<SharedExchange>> Create(
+      size_t buffer_size, size_t max_message_size);
+
+  // Maps exchange created by the process with specified pid, to be used by the server.
+  static Result<std::unique_ptr<SharedExchange>> Open(
+      int pid, int fd, size_t buffer_size, size_t max_message_size);
+
+  SharedExchange(SharedMemorySegment segment, size_t buffer_size, size_t max_message_size);
+  ~SharedExchange();
+
+  int fd() const {
+    return segment_.GetFd();
+  }
+
+  size_t buffer_size() const {
+    return buffer_size_;
+  }
+
+  // Client side. Sends request, consisting of specified parts, and waits for the response.
+  Result<RefCntBuffer> Exchange(const std::vector<Slice>& request, CoarseTimePoint deadline);
+
+  // Client side. Sends request, consisting of specified parts. Returns after the last chunk of
+  // the request was passed to the server, the response should be fetched with FetchResponse.
+  Status SendRequest(const std::vector<Slice>& request, CoarseTimePoint deadline);
+
+  // Client side. Waits for the response to the request passed to SendRequest.
+  Result<RefCntBuffer> FetchResponse(CoarseTimePoint deadline);
+
+  // Server side. Waits for the next request.
+  // Returns ShutdownInProgress after SignalStop was called by any side.
+  Result<SharedExchangeRequest> ReceiveRequest();
+
+  // Server side. Sends response to the last received request.
+  Status Respond(const std::vector<Slice>& response, CoarseTimePoint deadline);
+
+  // Wakes up any side waiting on this exchange, all further operations fail.
+  void SignalStop();
+
+ private:
+  Status Send(
+      SharedExchangeOwner self, SharedExchangeOwner peer, const std::vector<Slice>& parts,
+      CoarseTimePoint deadline);
+  Result<RefCntBuffer> Receive(
+      SharedExchangeOwner self, SharedExchangeOwner peer, CoarseTimePoint deadline);
+  Status WaitOwnership(SharedExchangeOwner self, CoarseTimePoint deadline);
+  Status PassOwnership(SharedExchangeOwner self, SharedExchangeOwner peer);
+
+  SharedMemorySegment segment_;
+  const size_t buffer_size_;
+  const size_t max_message_size_;
+  SharedExchangeHeader& header_;
+};
+
 }  // namespace tserver
 }  // namespace yb
 
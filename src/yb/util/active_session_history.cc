@@ -0,0 +1,176 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/active_session_history.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "yb/gutil/walltime.h"
+
+#include "yb/util/call_accounting.h"
+#include "yb/util/flags.h"
+#include "yb/util/status.h"
+#include "yb/util/thread.h"
+#include "yb/util/url-coding.h"
+#include "yb/util/web_callback_registry.h"
+
+using namespace std::placeholders;
+
+DEFINE_RUNTIME_int32(ash_sample_interval_ms, 0,
+    "Interval of sampling the phase of all inbound calls in progress into the active session "
+    "history, that is shown at /ash. When positive, the current phase is tracked for every call, "
+    "not only for the ones sampled by rpc_call_accounting_1_in_n. 0 disables sampling.");
+
+DEFINE_NON_RUNTIME_uint64(ash_max_samples, 100000,
+    "Max number of samples kept in the active session history, older samples are discarded.");
+
+namespace yb {
+
+namespace {
+
+const int kDefaultReportSeconds = 300;
+const auto kDisabledPollInterval = MonoDelta::FromSeconds(1);
+
+struct AshSample {
+  MicrosecondsInt64 time;
+  std::string method_name;
+  std::string tablet_id;
+  std::optional<CallPhase> phase;
+};
+
+class ActiveSessionHistory {
+ public:
+  static ActiveSessionHistory& Instance() {
+    static auto* instance = new ActiveSessionHistory();
+    return *instance;
+  }
+
+  Status Start() {
+    std::lock_guard<std::mutex> lock(start_mutex_);
+    if (thread_) {
+      return Status::OK();
+    }
+    return Thread::Create(
+        "ash", "ash_sampler", &ActiveSessionHistory::Run, this, &thread_);
+  }
+
+  void Handle(const WebCallbackRegistry::WebRequest& req,
+              WebCallbackRegistry::WebResponse* resp);
+
+ private:
+  void Run() {
+    std::vector<AshSample> batch;
+    for (;;) {
+      auto interval_ms = GetAtomicFlag(&FLAGS_ash_sample_interval_ms);
+      if (interval_ms <= 0) {
+        SleepFor(kDisabledPollInterval);
+        continue;
+      }
+      auto now = GetCurrentTimeMicros();
+      CallAccounting::ForEachLive([&batch, now](const CallAccounting& accounting) {
+        batch.push_back(AshSample {
+          .time = now,
+          .method_name = accounting.method_name(),
+          .tablet_id = accounting.tablet_id(),
+          .phase = accounting.current_phase(),
+        });
+      });
+      AddSamples(&batch);
+      SleepFor(MonoDelta::FromMilliseconds(interval_ms));
+    }
+  }
+
+  void AddSamples(std::vector<AshSample>* batch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& sample : *batch) {
+      samples_.push_back(std::move(sample));
+    }
+    batch->clear();
+    while (samples_.size() > FLAGS_ash_max_samples) {
+      samples_.pop_front();
+    }
+  }
+
+  std::mutex start_mutex_;
+  scoped_refptr<Thread> thread_;
+
+  std::mutex mutex_;
+  std::deque<AshSample> samples_;
+};
+
+void ActiveSessionHistory::Handle(const WebCallbackRegistry::WebRequest& req,
+                                  WebCallbackRegistry::WebResponse* resp) {
+  std::stringstream* output = &resp->output;
+  int seconds = kDefaultReportSeconds;
+  auto it = req.parsed_args.find("seconds");
+  if (it != req.parsed_args.end()) {
+    seconds = std::max(atoi(it->second.c_str()), 1);
+  }
+  auto interval_ms = GetAtomicFlag(&FLAGS_ash_sample_interval_ms);
+
+  // Number of samples by method, tablet and phase.
+  using Key = std::tuple<std::string, std::string, std::string>;
+  std::map<Key, size_t> counts;
+  auto min_time = GetCurrentTimeMicros() - seconds * MonoTime::kMicrosecondsPerSecond;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto i = samples_.rbegin(); i != samples_.rend() && i->time >= min_time; ++i) {
+      ++counts[Key(i->method_name, i->tablet_id,
+                   i->phase ? CallPhaseMetricName(*i->phase) : "untracked")];
+    }
+  }
+  std::vector<std::pair<size_t, const Key*>> ordered;
+  for (const auto& [key, count] : counts) {
+    ordered.emplace_back(count, &key);
+  }
+  std::sort(ordered.begin(), ordered.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first > rhs.first;
+  });
+
+  *output << "<h1>Active Session History</h1>\n";
+  if (interval_ms <= 0) {
+    *output << "<p>Sampling is disabled, set ash_sample_interval_ms to enable it.</p>\n";
+  } else {
+    *output << "<p>Calls in progress are sampled every " << interval_ms << "ms.</p>\n";
+  }
+  *output << "<p>Samples of the last " << seconds << " seconds. Untracked phase means that the "
+          << "call waits for an operation without instrumentation.</p>\n";
+  *output << "<table class='table table-striped'>\n"
+          << "<tr><th>Method</th><th>Tablet</th><th>Phase</th><th>Samples</th></tr>\n";
+  for (const auto& [count, key] : ordered) {
+    *output << "<tr><td>" << EscapeForHtmlToString(std::get<0>(*key)) << "</td><td>"
+            << EscapeForHtmlToString(std::get<1>(*key)) << "</td><td>" << std::get<2>(*key)
+            << "</td><td>" << count << "</td></tr>\n";
+  }
+  *output << "</table>\n";
+}
+
+} // namespace
+
+Status StartActiveSessionHistory(WebCallbackRegistry* web) {
+  auto& ash = ActiveSessionHistory::Instance();
+  RETURN_NOT_OK(ash.Start());
+  web->RegisterPathHandler(
+      "/ash", "Active Session History",
+      std::bind(&ActiveSessionHistory::Handle, &ash, _1, _2), true, false);
+  return Status::OK();
+}
+
+} // namespace yb
@@ -0,0 +1,30 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Active session history: periodic samples of the phase that each inbound call is in, based on
+// the call accounting. Allows to see afterwards, what slow calls were waiting for: RPC queue, lock
+// wait, conflict resolution, replication, RocksDB read or intents resolution.
+
+#pragma once
+
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+
+class WebCallbackRegistry;
+
+// Starts sampler thread, when it is not started yet, and registers /ash with the webserver.
+// Sampling is done only while ash_sample_interval_ms is positive.
+Status StartActiveSessionHistory(WebCallbackRegistry* web);
+
+} // namespace yb
@@ -0,0 +1,140 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <thread>
+
+#include "yb/util/call_accounting.h"
+#include "yb/util/metrics.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+DECLARE_int32(ash_sample_interval_ms);
+DECLARE_int32(rpc_call_accounting_1_in_n);
+
+namespace yb {
+
+METRIC_DEFINE_entity(call_accounting_test_entity);
+
+constexpr auto kSleep = 100ms;
+
+class CallAccountingTest : public YBTest {
+ protected:
+  int64_t CounterValue(const scoped_refptr<MetricEntity>& entity, const std::string& name) {
+    return entity->FindOrCreateCounter(std::make_unique<OwningCounterPrototype>(
+        entity->prototype().name(), name, name, MetricUnit::kMicroseconds, name,
+        MetricLevel::kInfo))->value();
+  }
+
+  bool IsLive(const CallAccounting* accounting) {
+    bool found = false;
+    CallAccounting::ForEachLive([accounting, &found](const CallAccounting& live) {
+      found = found || &live == accounting;
+    });
+    return found;
+  }
+};
+
+TEST_F(CallAccountingTest, Sampling) {
+  FLAGS_rpc_call_accounting_1_in_n = 0;
+  ASSERT_FALSE(CallAccounting::MaybeCreate());
+  FLAGS_rpc_call_accounting_1_in_n = 1;
+  ASSERT_TRUE(CallAccounting::MaybeCreate());
+
+  // Active session history requires accounting of every call, but without time measurement.
+  FLAGS_rpc_call_accounting_1_in_n = 0;
+  FLAGS_ash_sample_interval_ms = 100;
+  auto accounting = CallAccounting::MaybeCreate();
+  ASSERT_TRUE(accounting);
+  ASSERT_FALSE(accounting->time_accounted());
+}
+
+TEST_F(CallAccountingTest, CurrentPhase) {
+  scoped_refptr<CallAccounting> accounting(
+      make_scoped_refptr(new CallAccounting(/* time_accounted= */ false)));
+  ASSERT_TRUE(IsLive(accounting.get()));
+  ASSERT_EQ(accounting->current_phase(), std::nullopt);
+
+  CallPhaseTimer timer;
+  {
+    ADOPT_CALL_ACCOUNTING(accounting.get());
+    ScopedCallPhase service_phase(CallPhase::kServiceThread);
+    {
+      ScopedCallPhase read_phase(CallPhase::kRocksDbRead);
+      ASSERT_EQ(accounting->current_phase(), CallPhase::kRocksDbRead);
+    }
+    ASSERT_EQ(accounting->current_phase(), CallPhase::kServiceThread);
+    timer.Start(CallPhase::kReplication);
+  }
+  // Async phase started by the service thread is not overwritten when service thread finishes.
+  ASSERT_EQ(accounting->current_phase(), CallPhase::kReplication);
+  timer.Stop();
+  ASSERT_EQ(accounting->current_phase(), std::nullopt);
+  ASSERT_EQ(accounting->Get(CallPhase::kServiceThread), MonoDelta::kZero);
+
+  auto* raw = accounting.get();
+  accounting.reset();
+  ASSERT_FALSE(IsLive(raw));
+}
+
+TEST_F(CallAccountingTest, NestedPhases) {
+  MetricRegistry registry;
+  auto entity = METRIC_ENTITY_call_accounting_test_entity.Instantiate(&registry, "test");
+  auto counters = std::make_shared<CallPhaseCounters>(entity, "_test");
+
+  {
+    // Phases are not accounted without current call.
+    ScopedCallPhase phase(CallPhase::kServiceThread);
+  }
+
+  scoped_refptr<CallAccounting> accounting(make_scoped_refptr(new CallAccounting()));
+  accounting->SetMethodCounters(counters);
+  CallPhaseTimer timer;
+  {
+    ADOPT_CALL_ACCOUNTING(accounting.get());
+    ScopedCallPhase service_phase(CallPhase::kServiceThread);
+    std::this_thread::sleep_for(kSleep);
+    {
+      ScopedCallPhase read_phase(CallPhase::kRocksDbRead);
+      std::this_thread::sleep_for(kSleep);
+      {
+        ScopedCallPhase intents_phase(CallPhase::kIntentsResolution);
+        std::this_thread::sleep_for(kSleep);
+      }
+    }
+    timer.Start(CallPhase::kReplication);
+  }
+  ASSERT_EQ(CallAccounting::Current(), nullptr);
+  std::thread([&timer] {
+    std::this_thread::sleep_for(kSleep);
+    timer.Stop();
+  }).join();
+
+  for (auto phase : {CallPhase::kServiceThread, CallPhase::kRocksDbRead,
+                     CallPhase::kIntentsResolution, CallPhase::kReplication}) {
+    auto time = accounting->Get(phase);
+    LOG(INFO) << phase << ": " << time;
+    ASSERT_GE(time, MonoDelta(kSleep)) << phase;
+    // Time of the nested phases is not included.
+    ASSERT_LT(time, MonoDelta(kSleep * 2)) << phase;
+  }
+  ASSERT_EQ(accounting->Get(CallPhase::kLockWait), MonoDelta::kZero);
+
+  auto expected_us = accounting->Get(CallPhase::kServiceThread).ToMicroseconds();
+  accounting.reset();
+  ASSERT_EQ(CounterValue(entity, "call_service_thread_time_test"), expected_us);
+  ASSERT_EQ(CounterValue(entity, "call_lock_wait_time_test"), 0);
+}
+
+} // namespace yb
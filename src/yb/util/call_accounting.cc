@@ -0,0 +1,275 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/call_accounting.h"
+
+#include <array>
+
+#include "yb/gutil/walltime.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/format.h"
+#include "yb/util/metrics.h"
+#include "yb/util/random.h"
+#include "yb/util/threadlocal.h"
+
+DEFINE_RUNTIME_int32(rpc_call_accounting_1_in_n, 0,
+    "Account time spent by every Nth inbound call in each phase of its execution: reactor, "
+    "service queue, service thread, lock wait, conflict resolution, replication, RocksDB read "
+    "and intents resolution. Accounted time is aggregated per RPC method and per tablet, and "
+    "is shown for the calls in progress in /rpcz. 0 disables accounting.");
+
+DECLARE_int32(ash_sample_interval_ms);
+
+namespace yb {
+
+namespace {
+
+thread_local ScopedCallPhase* threadlocal_call_phase_ = nullptr;
+
+// Alive accountings, sharded to reduce contention between calls created by different threads.
+class CallAccountingRegistry {
+ public:
+  void Register(CallAccounting* accounting) {
+    auto& shard = ShardFor(accounting);
+    std::lock_guard<simple_spinlock> lock(shard.mutex);
+    shard.calls.push_back(*accounting);
+  }
+
+  void Unregister(CallAccounting* accounting) {
+    auto& shard = ShardFor(accounting);
+    std::lock_guard<simple_spinlock> lock(shard.mutex);
+    shard.calls.erase(shard.calls.iterator_to(*accounting));
+  }
+
+  void ForEach(const std::function<void(const CallAccounting&)>& f) {
+    for (auto& shard : shards_) {
+      std::lock_guard<simple_spinlock> lock(shard.mutex);
+      for (const auto& accounting : shard.calls) {
+        f(accounting);
+      }
+    }
+  }
+
+ private:
+  static constexpr size_t kNumShards = 16;
+
+  struct Shard {
+    simple_spinlock mutex;
+    boost::intrusive::list<CallAccounting> calls GUARDED_BY(mutex);
+  };
+
+  Shard& ShardFor(CallAccounting* accounting) {
+    // Low bits of the pointer are always zero because of alignment.
+    return shards_[(reinterpret_cast<uintptr_t>(accounting) >> 6) % kNumShards];
+  }
+
+  std::array<Shard, kNumShards> shards_;
+};
+
+// Never destroyed, since accountings could be alive during static destruction.
+CallAccountingRegistry& Registry() {
+  static auto* registry = new CallAccountingRegistry();
+  return *registry;
+}
+
+} // namespace
+
+thread_local CallAccounting* CallAccounting::threadlocal_call_accounting_ = nullptr;
+
+const char* CallPhaseMetricName(CallPhase phase) {
+  switch (phase) {
+    case CallPhase::kReactor: return "reactor";
+    case CallPhase::kQueue: return "queue";
+    case CallPhase::kServiceThread: return "service_thread";
+    case CallPhase::kLockWait: return "lock_wait";
+    case CallPhase::kConflictResolution: return "conflict_resolution";
+    case CallPhase::kReplication: return "replication";
+    case CallPhase::kRocksDbRead: return "rocksdb_read";
+    case CallPhase::kIntentsResolution: return "intents_resolution";
+  }
+  FATAL_INVALID_ENUM_VALUE(CallPhase, phase);
+}
+
+CallPhaseCounters::CallPhaseCounters(
+    const scoped_refptr<MetricEntity>& entity, const std::string& suffix) {
+  for (auto phase : CallPhaseList()) {
+    auto name = Format("call_$0_time$1", CallPhaseMetricName(phase), suffix);
+    EscapeMetricNameForPrometheus(&name);
+    auto description = Format(
+        "Time spent by the sampled calls in the $0 phase", CallPhaseMetricName(phase));
+    counters_[to_underlying(phase)] = entity->FindOrCreateCounter(
+        std::make_unique<OwningCounterPrototype>(
+            entity->prototype().name(), std::move(name), description,
+            MetricUnit::kMicroseconds, description, MetricLevel::kInfo));
+  }
+}
+
+CallPhaseCounters::~CallPhaseCounters() = default;
+
+void CallPhaseCounters::Add(CallPhase phase, int64_t micros) {
+  counters_[to_underlying(phase)]->IncrementBy(micros);
+}
+
+CallAccounting::CallAccounting(bool time_accounted) : time_accounted_(time_accounted) {
+  Registry().Register(this);
+}
+
+scoped_refptr<CallAccounting> CallAccounting::MaybeCreate() {
+  auto freq = GetAtomicFlag(&FLAGS_rpc_call_accounting_1_in_n);
+  if (freq > 0) {
+    BLOCK_STATIC_THREAD_LOCAL(yb::Random, rng_ptr, static_cast<uint32_t>(GetCurrentTimeMicros()));
+    if (rng_ptr->OneIn(freq)) {
+      return make_scoped_refptr(new CallAccounting());
+    }
+  }
+  if (GetAtomicFlag(&FLAGS_ash_sample_interval_ms) > 0) {
+    return make_scoped_refptr(new CallAccounting(/* time_accounted= */ false));
+  }
+  return nullptr;
+}
+
+void CallAccounting::ForEachLive(const std::function<void(const CallAccounting&)>& f) {
+  Registry().ForEach(f);
+}
+
+CallAccounting::~CallAccounting() {
+  // Should be done first, so concurrent ForEachLive does not see partially destroyed object.
+  Registry().Unregister(this);
+
+  CallPhaseCountersPtr method_counters;
+  CallPhaseCountersPtr tablet_counters;
+  {
+    std::lock_guard<simple_spinlock> lock(mutex_);
+    method_counters = std::move(method_counters_);
+    tablet_counters = std::move(tablet_counters_);
+  }
+  if (!method_counters && !tablet_counters) {
+    return;
+  }
+  for (auto phase : CallPhaseList()) {
+    auto micros = Get(phase).ToMicroseconds();
+    if (micros == 0) {
+      continue;
+    }
+    if (method_counters) {
+      method_counters->Add(phase, micros);
+    }
+    if (tablet_counters) {
+      tablet_counters->Add(phase, micros);
+    }
+  }
+}
+
+void CallAccounting::SetMethodCounters(CallPhaseCountersPtr counters) {
+  std::lock_guard<simple_spinlock> lock(mutex_);
+  method_counters_ = std::move(counters);
+}
+
+void CallAccounting::SetTabletCounters(CallPhaseCountersPtr counters) {
+  std::lock_guard<simple_spinlock> lock(mutex_);
+  if (!tablet_counters_) {
+    tablet_counters_ = std::move(counters);
+  }
+}
+
+void CallAccounting::SetMethodName(std::string method_name) {
+  std::lock_guard<simple_spinlock> lock(mutex_);
+  method_name_ = std::move(method_name);
+}
+
+void CallAccounting::SetTabletId(const std::string& tablet_id) {
+  std::lock_guard<simple_spinlock> lock(mutex_);
+  if (tablet_id_.empty()) {
+    tablet_id_ = tablet_id;
+  }
+}
+
+std::string CallAccounting::method_name() const {
+  std::lock_guard<simple_spinlock> lock(mutex_);
+  return method_name_;
+}
+
+std::string CallAccounting::tablet_id() const {
+  std::lock_guard<simple_spinlock> lock(mutex_);
+  return tablet_id_;
+}
+
+void CallAccounting::LeavePhase(CallPhase phase, std::optional<CallPhase> next) {
+  int expected = to_underlying(phase);
+  current_phase_.compare_exchange_strong(
+      expected, next ? to_underlying(*next) : kNoPhase, std::memory_order_acq_rel);
+}
+
+ScopedCallPhase::ScopedCallPhase(CallPhase phase)
+    : accounting_(CallAccounting::Current()), phase_(phase) {
+  if (!accounting_) {
+    return;
+  }
+  parent_ = threadlocal_call_phase_;
+  threadlocal_call_phase_ = this;
+  accounting_->EnterPhase(phase_);
+  timed_ = accounting_->time_accounted();
+  if (!timed_) {
+    return;
+  }
+  start_ = MonoTime::Now();
+  if (parent_ && parent_->timed_) {
+    // Parent is paused while the nested phase is in progress.
+    parent_->accounting_->Add(parent_->phase_, start_ - parent_->start_);
+  }
+}
+
+ScopedCallPhase::~ScopedCallPhase() {
+  if (!accounting_) {
+    return;
+  }
+  std::optional<CallPhase> next;
+  if (parent_ && parent_->accounting_ == accounting_) {
+    next = parent_->phase_;
+  }
+  accounting_->LeavePhase(phase_, next);
+  if (timed_) {
+    auto now = MonoTime::Now();
+    accounting_->Add(phase_, now - start_);
+    if (parent_ && parent_->timed_) {
+      parent_->start_ = now;
+    }
+  }
+  threadlocal_call_phase_ = parent_;
+}
+
+void CallPhaseTimer::Start(CallPhase phase, CallAccounting* accounting) {
+  accounting_ = accounting;
+  if (!accounting_) {
+    return;
+  }
+  phase_ = phase;
+  accounting_->EnterPhase(phase_);
+  if (accounting_->time_accounted()) {
+    start_ = MonoTime::Now();
+  }
+}
+
+void CallPhaseTimer::Stop() {
+  if (!accounting_) {
+    return;
+  }
+  accounting_->LeavePhase(phase_, std::nullopt);
+  if (accounting_->time_accounted()) {
+    accounting_->Add(phase_, MonoTime::Now() - start_);
+  }
+  accounting_ = nullptr;
+}
+
+} // namespace yb
@@ -0,0 +1,219 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <boost/intrusive/list.hpp>
+
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/util/enums.h"
+#include "yb/util/locks.h"
+#include "yb/util/metrics_fwd.h"
+#include "yb/util/monotime.h"
+
+namespace yb {
+
+// Phases of the call, whose time is accounted separately.
+YB_DEFINE_ENUM(CallPhase,
+    // Time from the call being received by the reactor till it is added to the service queue.
+    (kReactor)
+    // Time spent in the service queue.
+    (kQueue)
+    // Time spent by the service thread, excluding time of the nested phases below.
+    (kServiceThread)
+    // Time waiting for the DocDB locks.
+    (kLockWait)
+    // Time resolving conflicts with other transactions.
+    (kConflictResolution)
+    // Time from the operation being submitted to Raft till it is replicated.
+    (kReplication)
+    // Time reading RocksDB, excluding intents resolution.
+    (kRocksDbRead)
+    // Time resolving status of the provisional records seen while reading.
+    (kIntentsResolution));
+
+const char* CallPhaseMetricName(CallPhase phase);
+
+// Per phase counters of the accounted time in microseconds, aggregated for a metric entity.
+class CallPhaseCounters {
+ public:
+  // Creates counters named call_<phase>_time<suffix> in the specified entity.
+  CallPhaseCounters(const scoped_refptr<MetricEntity>& entity, const std::string& suffix);
+  ~CallPhaseCounters();
+
+  void Add(CallPhase phase, int64_t micros);
+
+ private:
+  std::array<scoped_refptr<Counter>, kCallPhaseMapSize> counters_;
+};
+
+using CallPhaseCountersPtr = std::shared_ptr<CallPhaseCounters>;
+
+// Time spent by a single call in each phase.
+// Created only for the sampled calls, so all hooks are no-op when there is no current accounting.
+// When destroyed, the accounted time is added to the counters of the RPC method and tablet that
+// were bound to the call.
+// When active session history is enabled, accounting is also created for the calls that are not
+// sampled, but only tracks the current phase of the call without measuring time.
+class CallAccounting : public RefCountedThreadSafe<CallAccounting>,
+                       public boost::intrusive::list_base_hook<> {
+ public:
+  explicit CallAccounting(bool time_accounted = true);
+
+  // Returns new accounting, if the call should be sampled according to
+  // rpc_call_accounting_1_in_n or active session history is enabled, nullptr otherwise.
+  static scoped_refptr<CallAccounting> MaybeCreate();
+
+  // Invokes f for all calls, whose accounting is alive. Invoked under the lock, so f should be
+  // fast and should not create or destroy accounting.
+  static void ForEachLive(const std::function<void(const CallAccounting&)>& f);
+
+  // Accounting of the call being executed by the current thread, if any.
+  static CallAccounting* Current() {
+    return threadlocal_call_accounting_;
+  }
+
+  void Add(CallPhase phase, MonoDelta delta) {
+    nanos_[to_underlying(phase)].fetch_add(delta.ToNanoseconds(), std::memory_order_relaxed);
+  }
+
+  bool time_accounted() const {
+    return time_accounted_;
+  }
+
+  // Phase the call is currently in, nullopt when the call is not in any tracked phase, for
+  // instance it waits for the asynchronous operation that is not instrumented.
+  std::optional<CallPhase> current_phase() const {
+    auto phase = current_phase_.load(std::memory_order_acquire);
+    if (phase == kNoPhase) {
+      return std::nullopt;
+    }
+    return static_cast<CallPhase>(phase);
+  }
+
+  void EnterPhase(CallPhase phase) {
+    current_phase_.store(to_underlying(phase), std::memory_order_release);
+  }
+
+  // Switches to the next phase, only if the call is still in the specified phase. So async phase
+  // started by the nested scope is not overwritten when outer scope finishes.
+  void LeavePhase(CallPhase phase, std::optional<CallPhase> next);
+
+  MonoDelta Get(CallPhase phase) const {
+    return MonoDelta::FromNanoseconds(
+        nanos_[to_underlying(phase)].load(std::memory_order_relaxed));
+  }
+
+  void SetMethodCounters(CallPhaseCountersPtr counters);
+
+  // Only the first tablet bound to the call is used.
+  void SetTabletCounters(CallPhaseCountersPtr counters);
+
+  void SetMethodName(std::string method_name);
+
+  // Only the first tablet bound to the call is used.
+  void SetTabletId(const std::string& tablet_id);
+
+  std::string method_name() const;
+
+  std::string tablet_id() const;
+
+ private:
+  friend class RefCountedThreadSafe<CallAccounting>;
+  friend class ScopedAdoptCallAccounting;
+
+  ~CallAccounting();
+
+  static thread_local CallAccounting* threadlocal_call_accounting_;
+
+  static constexpr int kNoPhase = -1;
+
+  const bool time_accounted_;
+  std::array<std::atomic<int64_t>, kCallPhaseMapSize> nanos_{};
+  std::atomic<int> current_phase_{kNoPhase};
+
+  mutable simple_spinlock mutex_;
+  CallPhaseCountersPtr method_counters_ GUARDED_BY(mutex_);
+  CallPhaseCountersPtr tablet_counters_ GUARDED_BY(mutex_);
+  std::string method_name_ GUARDED_BY(mutex_);
+  std::string tablet_id_ GUARDED_BY(mutex_);
+};
+
+// Makes the specified accounting current for the thread, for the duration of the scope.
+class ScopedAdoptCallAccounting {
+ public:
+  explicit ScopedAdoptCallAccounting(CallAccounting* accounting)
+      : old_(CallAccounting::threadlocal_call_accounting_) {
+    CallAccounting::threadlocal_call_accounting_ = accounting;
+  }
+
+  ~ScopedAdoptCallAccounting() {
+    CallAccounting::threadlocal_call_accounting_ = old_;
+  }
+
+ private:
+  CallAccounting* old_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedAdoptCallAccounting);
+};
+
+#define ADOPT_CALL_ACCOUNTING(accounting) \
+    ::yb::ScopedAdoptCallAccounting _adopt_call_accounting(accounting)
+
+// Accounts time of the scope to the phase of the current call.
+// Time is exclusive, i.e. time of the nested scopes is accounted only to the nested phase.
+class ScopedCallPhase {
+ public:
+  explicit ScopedCallPhase(CallPhase phase);
+  ~ScopedCallPhase();
+
+ private:
+  CallAccounting* accounting_;
+  CallPhase phase_;
+  ScopedCallPhase* parent_ = nullptr;
+  bool timed_ = false;
+  MonoTime start_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedCallPhase);
+};
+
+// Accounts time of the asynchronous phase, that starts and finishes in different threads.
+class CallPhaseTimer {
+ public:
+  CallPhaseTimer() = default;
+
+  // Starts the timer for the specified call, does nothing when accounting is nullptr.
+  void Start(CallPhase phase, CallAccounting* accounting = CallAccounting::Current());
+
+  // Accounts time since Start, does nothing when timer was not started.
+  void Stop();
+
+  CallAccounting* accounting() const {
+    return accounting_.get();
+  }
+
+ private:
+  scoped_refptr<CallAccounting> accounting_;
+  CallPhase phase_ = CallPhase::kReactor;
+  MonoTime start_;
+};
+
+} // namespace yb
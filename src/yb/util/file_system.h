@@ -162,6 +162,13 @@ class RandomAccessFile : public FileWithUniqueId {
     return 0;
   }
 
+  // Returns true if Read returns slices pointing directly to the memory mapped file contents,
+  // instead of copying them to scratch. Such data does not change while the file is open.
+  // Wrappers should not forward this call, since they could transform the data.
+  virtual bool IsMemoryMapped() const {
+    return false;
+  }
+
   // Used by the file_reader_writer to decide if the ReadAhead wrapper
   // should simply forward the call and do not enact buffering or locking.
   virtual bool ShouldForwardRawRequest() const {
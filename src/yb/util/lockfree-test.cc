@@ -90,6 +90,25 @@ TEST(LockfreeTest, MPSCQueueSimple) {
   ASSERT_EQ(nullptr, queue.Pop());
 }
 
+TEST(LockfreeTest, MPSCQueueFirstInBatch) {
+  std::vector<TestEntry> entries(4);
+  MPSCQueue<TestEntry> queue;
+
+  ASSERT_TRUE(queue.Push(&entries[0]));
+  ASSERT_FALSE(queue.Push(&entries[1]));
+  ASSERT_EQ(&entries[0], queue.Pop());
+  // Consumer took the batch, so the next push starts a new one, even though entries[1] is not
+  // popped yet.
+  ASSERT_TRUE(queue.Push(&entries[2]));
+  ASSERT_FALSE(queue.Push(&entries[3]));
+  ASSERT_EQ(&entries[1], queue.Pop());
+  ASSERT_EQ(&entries[2], queue.Pop());
+  ASSERT_EQ(&entries[3], queue.Pop());
+  ASSERT_EQ(nullptr, queue.Pop());
+  ASSERT_TRUE(queue.Push(&entries[0]));
+  ASSERT_EQ(&entries[0], queue.Pop());
+}
+
 TEST(LockfreeTest, MPSCQueueConcurrent) {
   constexpr size_t kThreads = 10;
   constexpr size_t kEntriesPerThread = 200000;
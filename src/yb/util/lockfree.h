@@ -27,12 +27,14 @@ template <class T>
 class MPSCQueue {
  public:
   // Thread safe - could be invoked from multiple threads.
-  void Push(T* value) {
+  // Returns true if there were no entries pushed since the last time the consumer took them,
+  // so the producer could wake up the consumer only once per batch.
+  bool Push(T* value) {
     T* old_head = push_head_.load(std::memory_order_acquire);
     for (;;) {
       SetNext(value, old_head);
       if (push_head_.compare_exchange_weak(old_head, value, std::memory_order_acq_rel)) {
-        break;
+        return old_head == nullptr;
       }
     }
   }
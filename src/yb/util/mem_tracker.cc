@@ -161,6 +161,12 @@ GoogleOnceType root_tracker_once = GOOGLE_ONCE_INIT;
 // is greater than mem_tracker_tcmalloc_gc_release_bytes, this will trigger a tcmalloc gc.
 Atomic64 released_memory_since_gc;
 
+// Released memory is accumulated per thread and added to released_memory_since_gc in batches,
+// since Release is invoked for every tracker by all threads, so incrementing the global counter
+// on every call bounces its cache line between cores.
+constexpr int64_t kReleasedMemoryBatchBytes = 64_KB;
+thread_local int64_t thread_released_memory = 0;
+
 #ifdef TCMALLOC_ENABLED
 
 // Memory tracker for tcmalloc tracing.
@@ -672,9 +678,19 @@ void MemTracker::Release(int64_t bytes) {
     return;
   }
 
-  if (PREDICT_FALSE(base::subtle::Barrier_AtomicIncrement(&released_memory_since_gc, bytes) >
-                    GetAtomicFlag(&FLAGS_mem_tracker_tcmalloc_gc_release_bytes))) {
-    GcTcmalloc();
+  thread_released_memory += bytes;
+  auto gc_release_bytes = GetAtomicFlag(&FLAGS_mem_tracker_tcmalloc_gc_release_bytes);
+  // Reading the global counter does not invalidate its cache line. It is checked together with the
+  // batch, so GC is not delayed when the threshold is crossed by the current thread.
+  if (thread_released_memory >= kReleasedMemoryBatchBytes ||
+      base::subtle::NoBarrier_Load(&released_memory_since_gc) + thread_released_memory >
+          gc_release_bytes) {
+    auto released = base::subtle::Barrier_AtomicIncrement(
+        &released_memory_since_gc, thread_released_memory);
+    thread_released_memory = 0;
+    if (PREDICT_FALSE(released > gc_release_bytes)) {
+      GcTcmalloc();
+    }
   }
 
   if (UpdateConsumption()) {
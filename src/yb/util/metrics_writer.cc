@@ -63,9 +63,8 @@ Status PrometheusWriter::FlushSingleEntry(
     }
     *output_ << "}";
   }
-  *output_ << " " << value;
-  *output_ << " " << timestamp_;
-  *output_ << std::endl;
+  // Output is not flushed after every entry, since it could contain hundreds of thousands of them.
+  *output_ << " " << value << " " << timestamp_ << '\n';
   return Status::OK();
 }
 
@@ -75,12 +74,22 @@ void PrometheusWriter::InvalidAggregationFunction(AggregationFunction aggregatio
 
 void PrometheusWriter::AddAggregatedEntry(
     const std::string& entity_id, const MetricEntity::AttributeMap& attr,
+    std::initializer_list<const char*> excluded_attrs,
     const std::string& metric_name, int64_t value, AggregationFunction aggregation_function) {
+  // Attributes are copied only when they are stored, since this function is invoked for every
+  // metric of every tablet.
+  auto store_attributes = [&attr, excluded_attrs](MetricEntity::AttributeMap* out) {
+    *out = attr;
+    for (const auto* name : excluded_attrs) {
+      out->erase(name);
+    }
+  };
   // For tablet level metrics, we roll up on the table level.
   auto it = aggregated_attributes_.find(entity_id);
   if (it == aggregated_attributes_.end()) {
     // If it's the first time we see this table, create the aggregate attrs.
-    aggregated_attributes_.emplace(entity_id, attr);
+    it = aggregated_attributes_.emplace(entity_id, MetricEntity::AttributeMap()).first;
+    store_attributes(&it->second);
   }
   auto& stored_value = aggregated_values_[metric_name][entity_id];
   switch (aggregation_function) {
@@ -90,7 +99,7 @@ void PrometheusWriter::AddAggregatedEntry(
     case kMax:
       // If we have a new max, also update the metadata so that it matches correctly.
       if (value > stored_value) {
-        aggregated_attributes_[entity_id] = attr;
+        store_attributes(&it->second);
         stored_value = value;
       }
       break;
@@ -109,24 +118,17 @@ Status PrometheusWriter::WriteSingleEntry(
   }
   switch (aggregation_level_) {
   case AggregationMetricLevel::kServer:
-  {
-    MetricEntity::AttributeMap new_attr = attr;
-    new_attr.erase("table_id");
-    new_attr.erase("table_name");
-    new_attr.erase("namespace_name");
-    AddAggregatedEntry("", new_attr, name, value, aggregation_function);
+    AddAggregatedEntry(
+        "", attr, {"table_id", "table_name", "namespace_name"}, name, value,
+        aggregation_function);
     break;
-  }
   case AggregationMetricLevel::kStream:
-  {
-    MetricEntity::AttributeMap new_attr = attr;
-    new_attr.erase("table_id");
-    new_attr.erase("table_name");
-    AddAggregatedEntry(attr.find("stream_id")->second, new_attr, name, value, aggregation_function);
+    AddAggregatedEntry(
+        attr.find("stream_id")->second, attr, {"table_id", "table_name"}, name, value,
+        aggregation_function);
     break;
-  }
   case AggregationMetricLevel::kTable:
-    AddAggregatedEntry(it->second, attr, name, value, aggregation_function);
+    AddAggregatedEntry(it->second, attr, {}, name, value, aggregation_function);
     break;
   }
   return Status::OK();
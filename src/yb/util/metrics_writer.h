@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <initializer_list>
 #include <map>
 
 #include "yb/util/metric_entity.h"
@@ -60,8 +61,10 @@ class PrometheusWriter {
 
   void InvalidAggregationFunction(AggregationFunction aggregation_function);
 
+  // Attributes listed in excluded_attrs are not included to the attributes of aggregated entry.
   void AddAggregatedEntry(const std::string& key,
                           const MetricEntity::AttributeMap& attr,
+                          std::initializer_list<const char*> excluded_attrs,
                           const std::string& name, int64_t value,
                           AggregationFunction aggregation_function);
 
@@ -85,6 +85,14 @@ TEST_F(MtHdrHistogramTest, ConcurrentWriteTest) {
 
   HdrHistogram snapshot(hist);
   ASSERT_EQ(num_threads_ * num_times_, snapshot.CountInBucketForValue(kValue));
+  // Striped counts and sums are aggregated on read.
+  ASSERT_EQ(num_threads_ * num_times_, hist.TotalCount());
+  ASSERT_EQ(num_threads_ * num_times_ * kValue, hist.TotalSum());
+  ASSERT_EQ(hist.TotalCount(), snapshot.CurrentCount());
+  hist.ResetPercentiles();
+  ASSERT_EQ(0, hist.CurrentCount());
+  ASSERT_EQ(0, hist.CurrentSum());
+  ASSERT_EQ(num_threads_ * num_times_, hist.TotalCount());
 
   delete[] threads;
 }
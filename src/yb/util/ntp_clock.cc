@@ -13,7 +13,15 @@
 
 #include "yb/util/ntp_clock.h"
 
+#include <algorithm>
+
+#include "yb/util/atomic.h"
+#include "yb/util/flags.h"
 #include "yb/util/result.h"
+#include "yb/util/status_format.h"
+
+DECLARE_uint64(max_clock_skew_usec);
+DECLARE_uint64(max_clock_sync_error_usec);
 
 namespace yb {
 
@@ -38,4 +46,33 @@ const std::string& NtpClock::Name() {
   return result;
 }
 
+#if !defined(__APPLE__)
+BoundedErrorClock::BoundedErrorClock() : impl_(AdjTimeClock()) {}
+#endif
+
+BoundedErrorClock::BoundedErrorClock(PhysicalClockPtr impl) : impl_(std::move(impl)) {}
+
+Result<PhysicalTime> BoundedErrorClock::Now() {
+  auto now = VERIFY_RESULT(impl_->Now());
+  // Other servers rely on this bound, so it is checked even when clock sync errors are disabled.
+  auto max_error_bound = GetAtomicFlag(&FLAGS_max_clock_sync_error_usec);
+  if (now.max_error > max_error_bound) {
+    return STATUS_FORMAT(
+        ServiceUnavailable, "Clock error $0 us exceeds max allowed $1 us", now.max_error,
+        max_error_bound);
+  }
+  return now;
+}
+
+MicrosTime BoundedErrorClock::MaxGlobalTime(PhysicalTime time) {
+  return time.time_point + std::min<MicrosTime>(
+      time.max_error + GetAtomicFlag(&FLAGS_max_clock_sync_error_usec),
+      GetAtomicFlag(&FLAGS_max_clock_skew_usec));
+}
+
+const std::string& BoundedErrorClock::Name() {
+  static std::string result("bounded_error");
+  return result;
+}
+
 } // namespace yb
@@ -43,5 +43,29 @@ class NtpClock : public PhysicalClock {
   PhysicalClockPtr impl_;
 };
 
+// Clock that keeps time of the underlying clock, but uses its reported error to shrink the read
+// uncertainty window.
+// Every server using this clock refuses to provide time when its error exceeds
+// max_clock_sync_error_usec. So the clock of any other server does not exceed true time by more
+// than this bound, and true time does not exceed our time by more than our own error.
+// So uncertainty window is own error plus max_clock_sync_error_usec, but never more than
+// max_clock_skew_usec.
+// Safe only when all servers of the cluster use this clock.
+class BoundedErrorClock : public PhysicalClock {
+ public:
+#if !defined(__APPLE__)
+  BoundedErrorClock();
+#endif
+  explicit BoundedErrorClock(PhysicalClockPtr impl);
+
+  Result<PhysicalTime> Now() override;
+  MicrosTime MaxGlobalTime(PhysicalTime time) override;
+
+  static const std::string& Name();
+
+ private:
+  PhysicalClockPtr impl_;
+};
+
 } // namespace yb
 
@@ -0,0 +1,37 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/util/numa.h"
+#include "yb/util/test_macros.h"
+
+namespace yb {
+
+TEST(NumaTest, ParseCpuList) {
+  ASSERT_EQ(ASSERT_RESULT(ParseCpuList("0-3,8,10-11\n")), (CpuList{0, 1, 2, 3, 8, 10, 11}));
+  ASSERT_EQ(ASSERT_RESULT(ParseCpuList("5")), (CpuList{5}));
+  ASSERT_TRUE(ASSERT_RESULT(ParseCpuList("\n")).empty());
+  ASSERT_NOK(ParseCpuList("3-1"));
+  ASSERT_NOK(ParseCpuList("1-2-3"));
+  ASSERT_NOK(ParseCpuList("a"));
+}
+
+TEST(NumaTest, BindCurrentThread) {
+  ASSERT_FALSE(NumaNodeCpus().empty());
+#if defined(__linux__)
+  ASSERT_OK(BindCurrentThreadToNumaNode(0));
+#endif
+}
+
+} // namespace yb
@@ -0,0 +1,120 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/numa.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include <fstream>
+#include <iterator>
+
+#include <boost/algorithm/string/trim.hpp>
+
+#include "yb/gutil/strings/split.h"
+
+#include "yb/util/errno.h"
+#include "yb/util/logging.h"
+#include "yb/util/status_format.h"
+#include "yb/util/stol_utils.h"
+
+namespace yb {
+
+namespace {
+
+std::vector<CpuList> ReadNumaNodeCpus() {
+  std::vector<CpuList> result;
+#if defined(__linux__)
+  for (int node = 0;; ++node) {
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    if (!file.is_open()) {
+      break;
+    }
+    std::string content(
+        (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    auto cpus = ParseCpuList(content);
+    if (!cpus.ok()) {
+      LOG(WARNING) << "Failed to parse CPUs of NUMA node " << node << ": " << cpus.status();
+      result.clear();
+      break;
+    }
+    result.push_back(std::move(*cpus));
+  }
+#endif
+  if (result.empty()) {
+    result.emplace_back();
+  }
+  LOG(INFO) << "NUMA nodes: " << result.size();
+  return result;
+}
+
+} // namespace
+
+Result<CpuList> ParseCpuList(const std::string& input) {
+  CpuList result;
+  auto trimmed = boost::algorithm::trim_copy(input);
+  if (trimmed.empty()) {
+    return result;
+  }
+  for (const auto& range : strings::Split(trimmed, ",")) {
+    std::vector<std::string> bounds = strings::Split(range, "-");
+    if (bounds.empty() || bounds.size() > 2) {
+      return STATUS_FORMAT(InvalidArgument, "Invalid CPU range '$0' in '$1'", range, input);
+    }
+    auto first = VERIFY_RESULT(CheckedStoi(bounds.front()));
+    auto last = VERIFY_RESULT(CheckedStoi(bounds.back()));
+    if (first < 0 || last < first) {
+      return STATUS_FORMAT(InvalidArgument, "Invalid CPU range '$0' in '$1'", range, input);
+    }
+    for (auto cpu = first; cpu <= last; ++cpu) {
+      result.push_back(cpu);
+    }
+  }
+  return result;
+}
+
+const std::vector<CpuList>& NumaNodeCpus() {
+  static const std::vector<CpuList> result = ReadNumaNodeCpus();
+  return result;
+}
+
+Status BindCurrentThreadToNumaNode(size_t node) {
+  const auto& nodes = NumaNodeCpus();
+  if (nodes.size() <= 1) {
+    return Status::OK();
+  }
+  const auto& cpus = nodes[node % nodes.size()];
+  if (cpus.empty()) {
+    return Status::OK();
+  }
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpu_set);
+    }
+  }
+  if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+    return STATUS_FORMAT(
+        RuntimeError, "Failed to bind thread to NUMA node $0: $1", node % nodes.size(),
+        ErrnoToString(errno));
+  }
+  return Status::OK();
+#else
+  return STATUS(NotSupported, "Binding threads to NUMA nodes is not supported");
+#endif
+}
+
+} // namespace yb
@@ -0,0 +1,37 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "yb/util/result.h"
+
+namespace yb {
+
+using CpuList = std::vector<int>;
+
+// Parses list of CPUs in the kernel cpulist format, i.e. "0-3,8,10-11".
+Result<CpuList> ParseCpuList(const std::string& input);
+
+// Returns CPUs of each NUMA node of the host, read from sysfs once. When NUMA topology is not
+// available, the host is considered a single node without known CPUs.
+const std::vector<CpuList>& NumaNodeCpus();
+
+// Binds the current thread to CPUs of the specified NUMA node, taken modulo number of nodes.
+// Memory allocated by the thread afterwards is placed on that node by the default first touch
+// policy. Does nothing on hosts with a single NUMA node.
+Status BindCurrentThreadToNumaNode(size_t node);
+
+} // namespace yb
@@ -100,6 +100,11 @@ class RefCntBuffer {
     return data_ == nullptr;
   }
 
+  // Returns true if this is the only reference to the buffer.
+  bool unique() const {
+    return data_ != nullptr && counter_reference().load(std::memory_order_acquire) == 1;
+  }
+
   std::string ToBuffer() const {
     return std::string(begin(), end());
   }
@@ -99,6 +99,16 @@ class StackTrace {
 
   uint64_t HashCode() const;
 
+  int num_frames() const {
+    return num_frames_;
+  }
+
+  // Returns the return address of the frame with the specified index, starting from the innermost
+  // frame.
+  void* frame(int index) const {
+    return frames_[index];
+  }
+
   explicit operator bool() const {
     return num_frames_ != 0;
   }
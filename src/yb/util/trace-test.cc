@@ -59,6 +59,9 @@ using rapidjson::Value;
 using std::string;
 using std::vector;
 
+DECLARE_bool(enable_distributed_tracing);
+DECLARE_bool(enable_tracing);
+
 namespace yb {
 
 class TraceTest : public YBTest {
@@ -128,6 +131,19 @@ TEST_F(TraceTest, TestChildTrace) {
             XOutDigits(traceA->DumpToString(false)));
 }
 
+TEST_F(TraceTest, TestDistributedTraceId) {
+  FLAGS_enable_tracing = true;
+  ASSERT_EQ(Trace::NewTrace()->trace_id(), 0);
+
+  FLAGS_enable_distributed_tracing = true;
+  auto root = Trace::NewTrace();
+  ASSERT_NE(root->trace_id(), 0);
+  // Outbound calls use child traces, that should propagate the id of the root.
+  auto child = Trace::NewTraceForParent(root.get());
+  ASSERT_EQ(child->trace_id(), root->trace_id());
+  ASSERT_STR_CONTAINS(root->DumpToString(false), "Trace id: ");
+}
+
 static void GenerateTraceEvents(int thread_id,
                                 int num_events) {
   for (int i = 0; i < num_events; i++) {
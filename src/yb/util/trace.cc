@@ -60,6 +60,11 @@ DEFINE_RUNTIME_int32(sampled_trace_1_in_n, 1000,
     "Flag to enable/disable sampled tracing. 0 disables.");
 TAG_FLAG(sampled_trace_1_in_n, advanced);
 
+DEFINE_RUNTIME_bool(enable_distributed_tracing, false,
+    "Assign id to the sampled traces and propagate it to the outbound calls, so their traces are "
+    "also collected by the remote servers. Traces of the same operation on different nodes could "
+    "be correlated by this id, and are logged by servers when the call is slow.");
+
 DEFINE_RUNTIME_bool(use_monotime_for_traces, false,
     "Flag to enable use of MonoTime::Now() instead of "
     "CoarseMonoClock::Now(). CoarseMonoClock is much cheaper so it is better to use it. However "
@@ -279,27 +284,40 @@ ThreadSafeArena* Trace::GetAndInitArena() {
 }
 
 scoped_refptr<Trace> Trace::NewTrace() {
+  BLOCK_STATIC_THREAD_LOCAL(yb::Random, rng_ptr, static_cast<uint32_t>(GetCurrentTimeMicros()));
+  scoped_refptr<Trace> ret;
   if (GetAtomicFlag(&FLAGS_enable_tracing)) {
-    return scoped_refptr<Trace>(new Trace());
-  }
-  const int32_t sampling_freq = GetAtomicFlag(&FLAGS_sampled_trace_1_in_n);
-  if (sampling_freq <= 0) {
-    VLOG(2) << "Sampled tracing returns nullptr";
-    return nullptr;
-  }
+    ret = new Trace();
+  } else {
+    const int32_t sampling_freq = GetAtomicFlag(&FLAGS_sampled_trace_1_in_n);
+    if (sampling_freq <= 0) {
+      VLOG(2) << "Sampled tracing returns nullptr";
+      return nullptr;
+    }
 
-  BLOCK_STATIC_THREAD_LOCAL(yb::Random, rng_ptr, static_cast<uint32_t>(GetCurrentTimeMicros()));
-  auto ret = scoped_refptr<Trace>(rng_ptr->OneIn(sampling_freq) ? new Trace() : nullptr);
-  VLOG(2) << "Sampled tracing returns " << (ret ? "non-null" : "nullptr");
-  if (ret) {
+    ret = rng_ptr->OneIn(sampling_freq) ? new Trace() : nullptr;
+    VLOG(2) << "Sampled tracing returns " << (ret ? "non-null" : "nullptr");
+    if (!ret) {
+      return nullptr;
+    }
     TRACE_TO(ret.get(), "Sampled trace created probabilistically");
   }
+  if (GetAtomicFlag(&FLAGS_enable_distributed_tracing)) {
+    // Sampling decision is made by the root of the distributed trace, and is propagated to the
+    // remote calls by the presence of the trace id.
+    uint64_t trace_id;
+    do {
+      trace_id = rng_ptr->Next64();
+    } while (trace_id == 0);
+    ret->set_trace_id(trace_id);
+  }
   return ret;
 }
 
 scoped_refptr<Trace>  Trace::NewTraceForParent(Trace* parent) {
   if (parent) {
     scoped_refptr<Trace> trace(new Trace);
+    trace->set_trace_id(parent->trace_id());
     parent->AddChildTrace(trace.get());
     return trace;
   }
@@ -393,6 +411,11 @@ void Trace::Dump(std::ostream* out, int32_t tracing_depth, bool include_time_del
     trace_start_time_usec = trace_start_time_usec_;
   }
 
+  auto trace_id = this->trace_id();
+  if (trace_id) {
+    *out << "Trace id: " << std::hex << trace_id << std::dec << std::endl;
+  }
+
   DoDump(
       out, tracing_depth, include_time_deltas, trace_start_time_usec,
       entries | boost::adaptors::indirected, &child_traces);
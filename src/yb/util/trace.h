@@ -215,6 +215,17 @@ class Trace : public RefCountedThreadSafe<Trace> {
     end_to_end_traces_requested_ = flag;
   }
 
+  // Id of the distributed trace, that this trace belongs to. Traces of the same distributed
+  // operation on different nodes have the same id, that is printed when trace is dumped, so they
+  // could be correlated. 0 when trace is not distributed.
+  uint64_t trace_id() const {
+    return trace_id_.load(std::memory_order_acquire);
+  }
+
+  void set_trace_id(uint64_t trace_id) {
+    trace_id_.store(trace_id, std::memory_order_release);
+  }
+
  private:
   friend class ScopedAdoptTrace;
   friend class RefCountedThreadSafe<Trace>;
@@ -249,6 +260,8 @@ class Trace : public RefCountedThreadSafe<Trace> {
   bool must_print_ = false;
   bool end_to_end_traces_requested_ = false;
 
+  std::atomic<uint64_t> trace_id_{0};
+
   std::vector<scoped_refptr<Trace> > child_traces_;
 
   DISALLOW_COPY_AND_ASSIGN(Trace);
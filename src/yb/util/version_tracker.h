@@ -18,6 +18,8 @@
 #include <stddef.h>
 
 #include <atomic>
+#include <memory>
+#include <mutex>
 
 namespace yb {
 
@@ -104,5 +106,46 @@ VersionTrackerCheckOut<Value> VersionTracker<Value>::CheckOut() {
   return VersionTrackerCheckOut<Value>(this);
 }
 
+// Immutable copy of data tracked by VersionTracker, that could be read without the external
+// synchronization required by VersionTracker. The copy is rebuilt lazily by readers that find it
+// stale, so writers don't pay for copying.
+template <class Value>
+class VersionTrackerSnapshot {
+ public:
+  struct Data {
+    size_t version;
+    Value value;
+  };
+
+  // Returns the snapshot if it matches the current version of tracker, otherwise nullptr.
+  // Does not require any synchronization. Note that tracker version is incremented after the
+  // checkout is destroyed, so during modification the old, still matching, snapshot is returned.
+  // That is the same as if the reader acquired the lock before the writer.
+  std::shared_ptr<const Data> GetIfActual(const VersionTracker<Value>& tracker) const {
+    auto data = std::atomic_load_explicit(&data_, std::memory_order_acquire);
+    if (data && data->version == tracker.Version()) {
+      return data;
+    }
+    return nullptr;
+  }
+
+  // Rebuilds the snapshot if it is stale. Should be invoked while holding at least shared access
+  // to the tracked data. If some other thread is already rebuilding snapshot, then returns without
+  // waiting for it.
+  void Update(const VersionTracker<Value>& tracker) {
+    std::unique_lock<std::mutex> lock(update_mutex_, std::try_to_lock);
+    if (!lock.owns_lock() || GetIfActual(tracker)) {
+      return;
+    }
+    std::atomic_store_explicit(
+        &data_, std::make_shared<const Data>(Data{tracker.Version(), *tracker}),
+        std::memory_order_release);
+  }
+
+ private:
+  std::shared_ptr<const Data> data_;
+  std::mutex update_mutex_;
+};
+
 } // namespace yb
 
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <string>
+#include "yb/util/slice.h"
 #include "yb/util/status_fwd.h"
 #include "yb/gutil/endian.h"
 
@@ -40,7 +41,7 @@ class YBPartition {
     encoded_key->append(reinterpret_cast<char *>(&uval), sizeof(uval));
   }
 
-  static uint16_t HashColumnCompoundValue(const std::string &compound);
+  static uint16_t HashColumnCompoundValue(Slice compound);
 };
 
 } // namespace yb
@@ -17,6 +17,9 @@
 
 #include <ldap.h>
 
+#include <string>
+#include <unordered_map>
+
 #include <boost/algorithm/string.hpp>
 
 #include "yb/common/ql_rowblock.h"
@@ -473,11 +476,21 @@ unique_ptr<CQLResponse> CQLProcessor::ProcessRequest(const BatchRequest& req) {
   }
 
   unique_ptr<CQLResponse> result;
+  // Batches usually repeat the same statement with different parameters, so parse trees are looked
+  // up or prepared once per distinct statement of the batch, and reused by its other queries.
+  std::unordered_map<CQLMessage::QueryId, const ParseTree*> prepared_parse_trees;
+  std::unordered_map<std::string, const ParseTree*> unprepared_parse_trees;
+
   // For each query in the batch, look up the query id if it is a prepared statement, or prepare the
   // query if it is not prepared. Then execute the parse trees with the parameters.
   for (const BatchRequest::Query& query : req.queries()) {
     if (query.is_prepared) {
       VLOG(1) << "BATCH EXECUTE " << b2a_hex(query.query_id);
+      auto it = prepared_parse_trees.find(query.query_id);
+      if (it != prepared_parse_trees.end()) {
+        batch.emplace_back(*it->second, query.params);
+        continue;
+      }
       auto stmt_res = GetPreparedStatement(query.query_id, query.params.schema_version());
       if (!stmt_res.ok()) {
         result = ProcessError(stmt_res.status(), query.query_id);
@@ -491,8 +504,17 @@ unique_ptr<CQLResponse> CQLProcessor::ProcessRequest(const BatchRequest& req) {
         break;
       }
       batch.emplace_back(*parse_tree, query.params);
+      // Schema version is used only by paging state, that batch queries don't have.
+      if (query.params.schema_version() == ql::StatementParameters::kUseLatest) {
+        prepared_parse_trees.emplace(query.query_id, &*parse_tree);
+      }
     } else {
       VLOG(1) << "BATCH QUERY " << query.query;
+      auto it = unprepared_parse_trees.find(query.query);
+      if (it != unprepared_parse_trees.end()) {
+        batch.emplace_back(*it->second, query.params);
+        continue;
+      }
       ParseTree::UniPtr parse_tree;
       s = Prepare(query.query, &parse_tree);
       if (PREDICT_FALSE(!s.ok())) {
@@ -500,6 +522,7 @@ unique_ptr<CQLResponse> CQLProcessor::ProcessRequest(const BatchRequest& req) {
         break;
       }
       batch.emplace_back(*parse_tree, query.params);
+      unprepared_parse_trees.emplace(query.query, parse_tree.get());
       parse_trees_.insert(std::move(parse_tree));
     }
   }
@@ -99,7 +99,9 @@ CQLConnectionContext::CQLConnectionContext(
 Result<rpc::ProcessCallsResult> CQLConnectionContext::ProcessCalls(
     const rpc::ConnectionPtr& connection, const IoVecs& data,
     rpc::ReadBufferFull read_buffer_full) {
-  return parser_.Parse(connection, data, read_buffer_full, nullptr /* tracker_for_throttle */);
+  return parser_.Parse(
+      connection, data, read_buffer_full, nullptr /* tracker_for_throttle */,
+      RefCntBuffer() /* shared_buffer */);
 }
 
 Status CQLConnectionContext::HandleCall(
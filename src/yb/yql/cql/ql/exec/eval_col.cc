@@ -13,9 +13,13 @@
 //
 //--------------------------------------------------------------------------------------------------
 
+#include <memory>
+#include <vector>
+
 #include "yb/common/jsonb.h"
 #include "yb/common/ql_value.h"
 
+#include "yb/util/flags.h"
 #include "yb/util/result.h"
 
 #include "yb/yql/cql/ql/exec/exec_context.h"
@@ -24,14 +28,65 @@
 #include "yb/yql/cql/ql/ptree/column_desc.h"
 #include "yb/yql/cql/ql/ptree/pt_dml.h"
 #include "yb/yql/cql/ql/ptree/pt_expr.h"
+#include "yb/yql/cql/ql/ptree/pt_insert.h"
+#include "yb/yql/cql/ql/ptree/pt_insert_json_clause.h"
 #include "yb/yql/cql/ql/ptree/pt_update.h"
 #include "yb/yql/cql/ql/util/statement_params.h"
 
+DEFINE_RUNTIME_bool(ycql_use_insert_request_template, true,
+    "Build column values of the prepared INSERT once and only fill values of its bind variables "
+    "on the following executions, instead of converting the whole statement on each execution.");
+TAG_FLAG(ycql_use_insert_request_template, advanced);
+
 namespace yb {
 namespace ql {
 
 using std::shared_ptr;
 
+// Column values of the prepared INSERT, whose bind variables are resolved to slots in the request.
+// Constant values are converted only once, so execution just copies the template and fills the
+// slots with the bound values.
+struct InsertRequestTemplate {
+  struct Slot {
+    const PTBindVar* bind_var;
+    const ColumnDesc* col_desc;
+    // Index in hashed_column_values, range_column_values or column_values of the request,
+    // depending on the kind of the column.
+    int index;
+  };
+
+  // False when the statement does not have a template, for instance INSERT JSON or conditional
+  // INSERT, or when its value expressions are not constants or bind variables.
+  bool supported = false;
+  QLWriteRequestPB request;
+  std::vector<Slot> slots;
+};
+
+namespace {
+
+QLExpressionPB* MutableTemplateSlot(
+    QLWriteRequestPB* req, const InsertRequestTemplate::Slot& slot) {
+  if (slot.col_desc->is_hash()) {
+    return req->mutable_hashed_column_values(slot.index);
+  }
+  if (slot.col_desc->is_primary()) {
+    return req->mutable_range_column_values(slot.index);
+  }
+  return req->mutable_column_values(slot.index)->mutable_expr();
+}
+
+int LastValueIndex(const QLWriteRequestPB& req, const ColumnDesc& col_desc) {
+  if (col_desc.is_hash()) {
+    return req.hashed_column_values_size() - 1;
+  }
+  if (col_desc.is_primary()) {
+    return req.range_column_values_size() - 1;
+  }
+  return req.column_values_size() - 1;
+}
+
+} // namespace
+
 //--------------------------------------------------------------------------------------------------
 
 Status Executor::ColumnRefsToPB(const PTDmlStmt *tnode,
@@ -134,5 +189,102 @@ Status Executor::ColumnArgsToPB(const PTDmlStmt *tnode, QLWriteRequestPB *req) {
   return Status::OK();
 }
 
+Status Executor::BuildInsertRequestTemplate(const PTInsertStmt *tnode,
+                                            InsertRequestTemplate *request_template) {
+  if (tnode->InsertingValue()->opcode() == TreeNodeOpcode::kPTInsertJsonClause ||
+      tnode->if_clause() != nullptr ||
+      !tnode->subscripted_col_args().empty() ||
+      !tnode->json_col_args().empty()) {
+    return Status::OK();
+  }
+
+  QLWriteRequestPB *req = &request_template->request;
+  for (const ColumnArg& col : tnode->column_args()) {
+    if (!col.IsInitialized()) {
+      continue;
+    }
+    const ColumnDesc *col_desc = col.desc();
+    const PTExpr::SharedPtr& expr = col.expr();
+    if (expr == nullptr) {
+      return Status::OK();
+    }
+    if (expr->expr_op() == ExprOperator::kBindVar) {
+      CreateQLExpression(req, *col_desc);
+      request_template->slots.push_back(InsertRequestTemplate::Slot {
+          static_cast<const PTBindVar*>(expr.get()), col_desc, LastValueIndex(*req, *col_desc)});
+      continue;
+    }
+    // Function calls like now() or uuid() should be evaluated on each execution, so only constants
+    // are converted to the template.
+    if (!expr->is_constant()) {
+      return Status::OK();
+    }
+    QLExpressionPB *expr_pb = CreateQLExpression(req, *col_desc);
+    RETURN_NOT_OK(PTExprToPB(expr, expr_pb));
+    if (col_desc->is_primary()) {
+      RETURN_NOT_OK(EvalExpr(expr_pb, QLTableRow::empty_row()));
+      // Leave reporting of the error to the regular conversion.
+      if (expr_pb->has_value() && IsNull(expr_pb->value())) {
+        return Status::OK();
+      }
+    }
+  }
+
+  request_template->supported = true;
+  return Status::OK();
+}
+
+Result<bool> Executor::InsertRequestTemplateToPB(const PTInsertStmt *tnode,
+                                                 QLWriteRequestPB *req) {
+  if (!FLAGS_ycql_use_insert_request_template || tnode->bind_variables().empty()) {
+    return false;
+  }
+
+  auto request_template = tnode->request_template();
+  if (!request_template) {
+    auto new_template = std::make_shared<InsertRequestTemplate>();
+    auto status = BuildInsertRequestTemplate(tnode, new_template.get());
+    if (!status.ok()) {
+      VLOG(3) << "Failed to build INSERT request template: " << status;
+      new_template = std::make_shared<InsertRequestTemplate>();
+    }
+    // Concurrent executions could build the template at the same time, it is the same for all of
+    // them, so it does not matter which one is stored.
+    tnode->set_request_template(new_template);
+    request_template = std::move(new_template);
+  }
+  if (!request_template->supported) {
+    return false;
+  }
+
+  const StatementParameters& params = exec_context_->params();
+  for (const auto& slot : request_template->slots) {
+    if (VERIFY_RESULT(params.IsBindVariableUnset(slot.bind_var->name()->c_str(),
+                                                 slot.bind_var->pos()))) {
+      // Unset columns are omitted from the request, so it does not match the template.
+      return false;
+    }
+  }
+
+  req->mutable_hashed_column_values()->MergeFrom(request_template->request.hashed_column_values());
+  req->mutable_range_column_values()->MergeFrom(request_template->request.range_column_values());
+  req->mutable_column_values()->MergeFrom(request_template->request.column_values());
+  for (const auto& slot : request_template->slots) {
+    QLExpressionPB *expr_pb = MutableTemplateSlot(req, slot);
+    RETURN_NOT_OK(PTExprToPB(slot.bind_var, expr_pb));
+
+    if (slot.col_desc->is_primary()) {
+      RETURN_NOT_OK(EvalExpr(expr_pb, QLTableRow::empty_row()));
+
+      // Null values not allowed for primary key.
+      if (expr_pb->has_value() && IsNull(expr_pb->value())) {
+        LOG(INFO) << "Unexpected null value. Current request: " << req->DebugString();
+        return exec_context_->Error(tnode, ErrorCode::NULL_ARGUMENT_FOR_PRIMARY_KEY);
+      }
+    }
+  }
+  return true;
+}
+
 }  // namespace ql
 }  // namespace yb
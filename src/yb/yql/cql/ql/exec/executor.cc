@@ -1275,7 +1275,13 @@ Status Executor::ExecPTNode(const PTInsertStmt *tnode, TnodeContext* tnode_conte
                              static_cast<PTInsertJsonClause*>(tnode->InsertingValue().get()),
                              req));
   } else {
-    s = ColumnArgsToPB(tnode, req);
+    // Prepared INSERT fills bind variables of its request template, when possible.
+    auto converted = InsertRequestTemplateToPB(tnode, req);
+    if (!converted.ok()) {
+      s = converted.status();
+    } else if (!*converted) {
+      s = ColumnArgsToPB(tnode, req);
+    }
     if (PREDICT_FALSE(!s.ok())) {
       // Note: INVALID_ARGUMENTS is retryable error code (due to mapping into STALE_METADATA),
       //       INVALID_REQUEST - non-retryable.
@@ -361,6 +361,15 @@ class Executor : public QLExprExecutor {
   // Convert column arguments to protobuf.
   Status ColumnArgsToPB(const PTDmlStmt *tnode, QLWriteRequestPB *req);
 
+  // Convert column arguments of the prepared INSERT to protobuf using its request template.
+  // Returns false when the statement has no template or some of its bind variables are unset,
+  // so the arguments should be converted by ColumnArgsToPB.
+  Result<bool> InsertRequestTemplateToPB(const PTInsertStmt *tnode, QLWriteRequestPB *req);
+
+  // Build request template of the INSERT, leaves it unsupported for statements of other shapes.
+  Status BuildInsertRequestTemplate(const PTInsertStmt *tnode,
+                                    InsertRequestTemplate *request_template);
+
   // Convert INSERT JSON clause to protobuf.
   Status InsertJsonClauseToPB(const PTInsertStmt *insert_stmt,
                                       const PTInsertJsonClause *json_clause,
@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+
 #include "yb/yql/cql/ql/ptree/list_node.h"
 #include "yb/yql/cql/ql/ptree/pt_dml.h"
 #include "yb/yql/cql/ql/ptree/pt_insert_values_clause.h"
@@ -82,6 +85,16 @@ class PTInsertStmt : public PTDmlStmt {
     return true;
   }
 
+  // Write request built by the executor on the first execution of the prepared statement and
+  // reused by the following executions, see InsertRequestTemplate.
+  std::shared_ptr<const InsertRequestTemplate> request_template() const {
+    return std::atomic_load_explicit(&request_template_, std::memory_order_acquire);
+  }
+
+  void set_request_template(std::shared_ptr<const InsertRequestTemplate> value) const {
+    std::atomic_store_explicit(&request_template_, std::move(value), std::memory_order_release);
+  }
+
  private:
 
   //
@@ -114,6 +127,11 @@ class PTInsertStmt : public PTDmlStmt {
 
   // -- The semantic analyzer will decorate this node with the following information --
 
+  // -- The executor will decorate this node with the following information --
+
+  // Parse tree of the prepared statement is shared by concurrent executions, so template is
+  // accessed atomically.
+  mutable std::shared_ptr<const InsertRequestTemplate> request_template_;
 };
 
 }  // namespace ql
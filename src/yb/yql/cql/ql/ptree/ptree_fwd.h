@@ -26,6 +26,7 @@ class ColumnOp;
 class FuncOp;
 class IdxPredicateState;
 class IfExprState;
+struct InsertRequestTemplate;
 class JsonColumnArg;
 class JsonColumnOp;
 class PTAllColumns;
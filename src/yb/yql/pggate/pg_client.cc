@@ -13,6 +13,11 @@
 
 #include "yb/yql/pggate/pg_client.h"
 
+#include <unistd.h>
+
+#include <condition_variable>
+#include <mutex>
+
 #include "yb/client/client-internal.h"
 #include "yb/client/table.h"
 #include "yb/client/table_info.h"
@@ -20,7 +25,10 @@
 #include "yb/client/yb_table_name.h"
 
 #include "yb/gutil/casts.h"
+#include "yb/gutil/thread_annotations.h"
 
+#include "yb/rpc/call_data.h"
+#include "yb/rpc/outbound_call.h"
 #include "yb/rpc/poller.h"
 #include "yb/rpc/rpc_controller.h"
 
@@ -29,22 +37,38 @@
 #include "yb/tserver/tserver_shared_mem.h"
 
 #include "yb/util/debug-util.h"
+#include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/protobuf_util.h"
 #include "yb/util/result.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/shared_mem.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status.h"
+#include "yb/util/status_log.h"
+#include "yb/util/thread.h"
 
 #include "yb/yql/pggate/pg_op.h"
 #include "yb/yql/pggate/pg_tabledesc.h"
 
+using namespace yb::size_literals;
+
 DECLARE_bool(use_node_hostname_for_local_tserver);
 DECLARE_int32(backfill_index_client_rpc_timeout_ms);
 DECLARE_int32(yb_client_admin_operation_timeout_sec);
+DECLARE_uint64(rpc_max_message_size);
 
 DEFINE_uint64(pg_client_heartbeat_interval_ms, 10000, "Pg client heartbeat interval in ms.");
 
+DEFINE_NON_RUNTIME_bool(pg_client_use_shared_memory, false,
+    "Send perform requests to the local tserver through shared memory exchange, instead of "
+    "loopback RPC. Only one perform is sent through the exchange at a time, while its response "
+    "is not received other performs use RPC.");
+
+DEFINE_NON_RUNTIME_uint64(pg_client_shared_memory_buffer_size, 1_MB,
+    "Size of the shared memory exchange buffer of a pg client session. Larger requests and "
+    "responses are transferred in several chunks.");
+
 DECLARE_bool(TEST_index_read_multiple_partitions);
 DECLARE_bool(TEST_enable_db_catalog_version_mode);
 
@@ -127,16 +151,49 @@ class PgClient::Impl {
     proxy_ = std::make_unique<tserver::PgClientServiceProxy>(
         proxy_cache, host_port, nullptr /* protocol */, resolve_cache_timeout);
 
+    if (FLAGS_pg_client_use_shared_memory) {
+      auto exchange = tserver::SharedExchange::Create(
+          FLAGS_pg_client_shared_memory_buffer_size, FLAGS_rpc_max_message_size);
+      if (exchange.ok()) {
+        exchange_ = std::move(*exchange);
+      } else {
+        LOG(WARNING) << "Failed to create shared exchange, using RPC: " << exchange.status();
+      }
+    }
+
     auto future = create_session_promise_.get_future();
     Heartbeat(true);
     session_id_ = VERIFY_RESULT(future.get());
     LOG_WITH_PREFIX(INFO) << "Session id acquired";
+    if (exchange_) {
+      auto status = Thread::Create(
+          "pg_client", "shared_exchange", &Impl::ExchangeThread, this, &exchange_thread_);
+      if (!status.ok()) {
+        LOG_WITH_PREFIX(WARNING) << "Failed to start shared exchange thread, using RPC: "
+                                 << status;
+        exchange_->SignalStop();
+        exchange_.reset();
+      }
+    }
     heartbeat_poller_.Start(scheduler, FLAGS_pg_client_heartbeat_interval_ms * 1ms);
     return Status::OK();
   }
 
   void Shutdown() {
     heartbeat_poller_.Shutdown();
+    if (exchange_) {
+      exchange_->SignalStop();
+      {
+        std::lock_guard<std::mutex> lock(exchange_mutex_);
+        exchange_stopped_ = true;
+      }
+      exchange_cond_.notify_one();
+      if (exchange_thread_) {
+        WARN_NOT_OK(ThreadJoiner(exchange_thread_.get()).Join(),
+                    "Failed to join shared exchange thread");
+      }
+      exchange_.reset();
+    }
     proxy_ = nullptr;
   }
 
@@ -151,12 +208,20 @@ class PgClient::Impl {
     tserver::PgHeartbeatRequestPB req;
     if (!create) {
       req.set_session_id(session_id_);
+    } else if (exchange_) {
+      req.set_pid(getpid());
+      req.set_shared_exchange_fd(exchange_->fd());
+      req.set_shared_exchange_buffer_size(exchange_->buffer_size());
     }
     proxy_->HeartbeatAsync(
         req, &heartbeat_resp_, PrepareHeartbeatController(),
         [this, create] {
       auto status = ResponseStatus(heartbeat_resp_);
       if (create) {
+        if (exchange_ && (!status.ok() || !heartbeat_resp_.shared_exchange_started())) {
+          LOG_WITH_PREFIX(INFO) << "TServer did not start shared exchange, using RPC";
+          exchange_.reset();
+        }
         if (!status.ok()) {
           create_session_promise_.set_value(status);
         } else {
@@ -341,6 +406,38 @@ class PgClient::Impl {
     return std::make_pair(resp.last_val(), resp.is_called());
   }
 
+  Result<std::pair<int64_t, int64_t>> FetchSequenceTuple(int64_t db_oid,
+                                                         int64_t seq_oid,
+                                                         uint64_t ysql_catalog_version,
+                                                         bool is_db_catalog_version_mode,
+                                                         int64_t fetch_count,
+                                                         int64_t inc_by,
+                                                         int64_t min_value,
+                                                         int64_t max_value,
+                                                         bool cycle) {
+    tserver::PgFetchSequenceTupleRequestPB req;
+    req.set_session_id(session_id_);
+    req.set_db_oid(db_oid);
+    req.set_seq_oid(seq_oid);
+    if (is_db_catalog_version_mode) {
+      DCHECK(FLAGS_TEST_enable_db_catalog_version_mode);
+      req.set_ysql_db_catalog_version(ysql_catalog_version);
+    } else {
+      req.set_ysql_catalog_version(ysql_catalog_version);
+    }
+    req.set_fetch_count(fetch_count);
+    req.set_inc_by(inc_by);
+    req.set_min_value(min_value);
+    req.set_max_value(max_value);
+    req.set_cycle(cycle);
+
+    tserver::PgFetchSequenceTupleResponsePB resp;
+
+    RETURN_NOT_OK(proxy_->FetchSequenceTuple(req, &resp, PrepareController()));
+    RETURN_NOT_OK(ResponseStatus(resp));
+    return std::make_pair(resp.first_value(), resp.last_value());
+  }
+
   Status DeleteSequenceTuple(int64_t db_oid, int64_t seq_oid) {
     tserver::PgDeleteSequenceTupleRequestPB req;
     req.set_session_id(session_id_);
@@ -377,6 +474,14 @@ class PgClient::Impl {
     auto data = std::make_shared<PerformData>(&arena);
     data->operations = std::move(*operations);
     data->callback = callback;
+
+    // Exchange serves one request at a time, so while its response is not fetched yet, other
+    // performs issued by the operation buffer are sent through RPC.
+    if (exchange_ && !exchange_busy_.load(std::memory_order_acquire)) {
+      PerformShared(req, std::move(data));
+      return;
+    }
+
     data->controller.set_invoke_callback_mode(rpc::InvokeCallbackMode::kReactorThread);
 
     proxy_->PerformAsync(req, &data->resp, SetupController(&data->controller), [data] {
@@ -396,6 +501,89 @@ class PgClient::Impl {
     });
   }
 
+  // Sends request through shared memory exchange. Response is fetched by the exchange thread,
+  // that invokes the callback, so the caller is not blocked till the perform completes.
+  void PerformShared(const tserver::LWPgPerformRequestPB& req, std::shared_ptr<PerformData> data) {
+    exchange_busy_.store(true, std::memory_order_release);
+    auto deadline = CoarseMonoClock::now() + timeout_;
+    RefCntBuffer request(req.SerializedSize());
+    req.SerializeToArray(request.udata());
+    auto status = exchange_->SendRequest({request.AsSlice()}, deadline);
+    if (!status.ok()) {
+      ExchangeFailed(status);
+      PerformResult result;
+      result.status = std::move(status);
+      data->callback(result);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(exchange_mutex_);
+      exchange_perform_ = std::move(data);
+      exchange_deadline_ = deadline;
+    }
+    exchange_cond_.notify_one();
+  }
+
+  void ExchangeThread() {
+    for (;;) {
+      std::shared_ptr<PerformData> data;
+      CoarseTimePoint deadline;
+      {
+        std::unique_lock<std::mutex> lock(exchange_mutex_);
+        exchange_cond_.wait(lock, [this] { return exchange_perform_ || exchange_stopped_; });
+        if (!exchange_perform_) {
+          return;
+        }
+        data = std::move(exchange_perform_);
+        deadline = exchange_deadline_;
+      }
+      PerformResult result;
+      auto response = FetchExchangeResponse(&data->resp, deadline);
+      if (response.ok()) {
+        // Following perform could use the exchange, before callback of this one is invoked.
+        exchange_busy_.store(false, std::memory_order_release);
+        result.response = std::move(*response);
+        result.status = ResponseStatus(data->resp);
+      } else {
+        result.status = response.status();
+      }
+      if (result.status.ok()) {
+        result.status = data->Process();
+      }
+      if (result.status.ok() && data->resp.has_catalog_read_time()) {
+        result.catalog_read_time = ReadHybridTime::FromPB(data->resp.catalog_read_time());
+      }
+      data->callback(result);
+    }
+  }
+
+  Result<rpc::CallResponsePtr> FetchExchangeResponse(
+      tserver::LWPgPerformResponsePB* resp, CoarseTimePoint deadline) {
+    auto response = exchange_->FetchResponse(deadline);
+    if (!response.ok()) {
+      ExchangeFailed(response.status());
+      if (response.status().IsTimedOut()) {
+        return STATUS(TimedOut, "Timed out waiting for Perform");
+      }
+      return response.status();
+    }
+    auto data = response->AsSlice();
+    rpc::CallData call_data(std::move(*response), data);
+    auto call_response = std::make_shared<rpc::CallResponse>();
+    RETURN_NOT_OK(call_response->ParseFrom(&call_data));
+    RETURN_NOT_OK(resp->ParseFromSlice(call_response->serialized_response()));
+    return call_response;
+  }
+
+  // State of the exchange is unknown after failure, so exchange_busy_ is left set and following
+  // requests are sent via RPC.
+  void ExchangeFailed(const Status& status) {
+    if (!status.IsShutdownInProgress()) {
+      LOG_WITH_PREFIX(WARNING) << "Shared exchange failed, using RPC: " << status;
+    }
+    exchange_->SignalStop();
+  }
+
   void PrepareOperations(tserver::LWPgPerformRequestPB* req, PgsqlOps* operations) {
     auto& ops = *req->mutable_ops();
     for (auto& op : *operations) {
@@ -516,18 +704,20 @@ class PgClient::Impl {
   }
 
   Result<client::TableSizeInfo> GetTableDiskSize(
-      const PgObjectId& table_oid) {
+      const PgObjectId& table_oid, bool use_cache) {
     tserver::PgGetTableDiskSizeResponsePB resp;
 
     tserver::PgGetTableDiskSizeRequestPB req;
     table_oid.ToPB(req.mutable_table_id());
+    req.set_use_cache(use_cache);
 
     RETURN_NOT_OK(proxy_->GetTableDiskSize(req, &resp, PrepareController()));
     if (resp.has_status()) {
       return StatusFromPB(resp.status());
     }
 
-    return client::TableSizeInfo{resp.size(), resp.num_missing_tablets()};
+    return client::TableSizeInfo{
+        resp.size(), resp.num_missing_tablets(), resp.estimated_num_rows()};
   }
 
   Result<bool> CheckIfPitrActive() {
@@ -599,6 +789,18 @@ class PgClient::Impl {
   }
 
   std::unique_ptr<tserver::PgClientServiceProxy> proxy_;
+  // Set when perform requests are sent through shared memory exchange.
+  std::unique_ptr<tserver::SharedExchange> exchange_;
+  // Fetches responses of perform requests sent through exchange_.
+  scoped_refptr<Thread> exchange_thread_;
+  std::mutex exchange_mutex_;
+  std::condition_variable exchange_cond_;
+  // Perform sent through exchange_, whose response was not fetched yet.
+  std::shared_ptr<PerformData> exchange_perform_ GUARDED_BY(exchange_mutex_);
+  CoarseTimePoint exchange_deadline_ GUARDED_BY(exchange_mutex_);
+  bool exchange_stopped_ GUARDED_BY(exchange_mutex_) = false;
+  // Set from sending perform request through exchange_ till its response is fetched.
+  std::atomic<bool> exchange_busy_{false};
   rpc::RpcController controller_;
   uint64_t session_id_ = 0;
 
@@ -694,8 +896,8 @@ Status PgClient::ValidatePlacement(const tserver::PgValidatePlacementRequestPB*
 }
 
 Result<client::TableSizeInfo> PgClient::GetTableDiskSize(
-    const PgObjectId& table_oid) {
-  return impl_->GetTableDiskSize(table_oid);
+    const PgObjectId& table_oid, bool use_cache) {
+  return impl_->GetTableDiskSize(table_oid, use_cache);
 }
 
 Status PgClient::InsertSequenceTuple(int64_t db_oid,
@@ -729,6 +931,20 @@ Result<std::pair<int64_t, bool>> PgClient::ReadSequenceTuple(int64_t db_oid,
       db_oid, seq_oid, ysql_catalog_version, is_db_catalog_version_mode);
 }
 
+Result<std::pair<int64_t, int64_t>> PgClient::FetchSequenceTuple(int64_t db_oid,
+                                                                int64_t seq_oid,
+                                                                uint64_t ysql_catalog_version,
+                                                                bool is_db_catalog_version_mode,
+                                                                int64_t fetch_count,
+                                                                int64_t inc_by,
+                                                                int64_t min_value,
+                                                                int64_t max_value,
+                                                                bool cycle) {
+  return impl_->FetchSequenceTuple(
+      db_oid, seq_oid, ysql_catalog_version, is_db_catalog_version_mode, fetch_count, inc_by,
+      min_value, max_value, cycle);
+}
+
 Status PgClient::DeleteSequenceTuple(int64_t db_oid, int64_t seq_oid) {
   return impl_->DeleteSequenceTuple(db_oid, seq_oid);
 }
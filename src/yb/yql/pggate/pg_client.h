@@ -101,7 +101,8 @@ class PgClient {
 
   Status ValidatePlacement(const tserver::PgValidatePlacementRequestPB* req);
 
-  Result<client::TableSizeInfo> GetTableDiskSize(const PgObjectId& table_oid);
+  // When use_cache is set, estimates fetched by tserver recently could be returned.
+  Result<client::TableSizeInfo> GetTableDiskSize(const PgObjectId& table_oid, bool use_cache);
 
   Status InsertSequenceTuple(int64_t db_oid,
                                      int64_t seq_oid,
@@ -124,6 +125,17 @@ class PgClient {
                                                      uint64_t ysql_catalog_version,
                                                      bool is_db_catalog_version_mode);
 
+  // Returns the first and the last of fetched values.
+  Result<std::pair<int64_t, int64_t>> FetchSequenceTuple(int64_t db_oid,
+                                                         int64_t seq_oid,
+                                                         uint64_t ysql_catalog_version,
+                                                         bool is_db_catalog_version_mode,
+                                                         int64_t fetch_count,
+                                                         int64_t inc_by,
+                                                         int64_t min_value,
+                                                         int64_t max_value,
+                                                         bool cycle);
+
   Status DeleteSequenceTuple(int64_t db_oid, int64_t seq_oid);
 
   Status DeleteDBSequences(int64_t db_oid);
@@ -500,5 +500,14 @@ void PgDml::GetAndResetReadRpcStats(uint64_t* reads, uint64_t* read_wait,
   }
 }
 
+void PgDml::GetAndResetDocDBStats(YBCPgDocDBStats* stats) {
+  if (secondary_index_query_) {
+    secondary_index_query_->GetAndResetDocDBStats(stats);
+  }
+  if (doc_op_) {
+    doc_op_->GetAndResetDocDBStats(stats);
+  }
+}
+
 }  // namespace pggate
 }  // namespace yb
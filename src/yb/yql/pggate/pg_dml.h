@@ -103,6 +103,9 @@ class PgDml : public PgStatement {
   void GetAndResetReadRpcStats(uint64_t* reads, uint64_t* read_wait,
                                uint64_t* tbl_reads, uint64_t* tbl_read_wait);
 
+  // DocDB stats of both index and table reads for EXPLAIN ANALYZE
+  void GetAndResetDocDBStats(YBCPgDocDBStats* stats);
+
  protected:
   // Method members.
   // Constructor.
@@ -15,10 +15,15 @@
 #include "yb/yql/pggate/pg_doc_op.h"
 
 #include <algorithm>
+#include <optional>
 #include <utility>
 
+#include "yb/client/yb_op.h"
+
 #include "yb/common/row_mark.h"
 
+#include "yb/docdb/doc_key.h"
+
 #include "yb/gutil/casts.h"
 #include "yb/gutil/strings/escaping.h"
 
@@ -117,6 +122,69 @@ auto BuildRowOrders(const LWPgsqlResponsePB& response,
   return orders;
 }
 
+struct ScanBound {
+  std::string key;
+  bool is_inclusive;
+};
+
+struct ScanBounds {
+  std::optional<ScanBound> lower;
+  std::optional<ScanBound> upper;
+};
+
+template <class Bound>
+std::optional<ScanBound> MakeScanBound(bool has_bound, const Bound& bound) {
+  if (!has_bound) {
+    return std::nullopt;
+  }
+  return ScanBound { .key = bound.key().ToBuffer(), .is_inclusive = bound.is_inclusive() };
+}
+
+// Returns key bounds of the rows that could match the request. Bounds come from the query
+// conditions, including the values bound at execution time, and use the same encoding as
+// partition keys.
+Result<ScanBounds> GetScanBounds(const PgTableDesc& table, const LWPgsqlReadRequestPB& req) {
+  ScanBounds result {
+    .lower = MakeScanBound(req.has_lower_bound(), req.lower_bound()),
+    .upper = MakeScanBound(req.has_upper_bound(), req.upper_bound()),
+  };
+  if (result.lower || result.upper || !table.IsRangePartitioned()) {
+    return result;
+  }
+  // Range partitioned table without explicit bounds, derive them from the conditions on range
+  // columns, the same way partition key of the request is calculated.
+  std::vector<docdb::KeyEntryValue> lower, upper;
+  RETURN_NOT_OK(client::GetRangePartitionBounds(table.schema(), req, &lower, &upper));
+  if (!lower.empty() && !upper.empty()) {
+    result.lower = ScanBound {
+      .key = docdb::DocKey(std::move(lower)).Encode().ToStringBuffer(),
+      .is_inclusive = true,
+    };
+    result.upper = ScanBound {
+      .key = docdb::DocKey(std::move(upper)).Encode().ToStringBuffer(),
+      .is_inclusive = true,
+    };
+  }
+  return result;
+}
+
+// Checks whether keys of the partition [partition_lower_bound, partition_upper_bound) could match
+// the scan bounds. Empty partition_upper_bound means the end of the key space.
+bool PartitionMatchesScanBounds(
+    const ScanBounds& bounds, Slice partition_lower_bound, Slice partition_upper_bound) {
+  if (bounds.upper && !partition_lower_bound.empty()) {
+    const auto cmp = partition_lower_bound.compare(bounds.upper->key);
+    if (cmp > 0 || (cmp == 0 && !bounds.upper->is_inclusive)) {
+      return false;
+    }
+  }
+  if (bounds.lower && !partition_upper_bound.empty() &&
+      Slice(bounds.lower->key).compare(partition_upper_bound) >= 0) {
+    return false;
+  }
+  return true;
+}
+
 } // namespace
 
 PgDocResult::PgDocResult(rpc::SidecarHolder data, std::vector<int64_t>&& row_orders)
@@ -264,12 +332,16 @@ Result<std::list<PgDocResult>> PgDocOp::GetResult() {
     }
 
     DCHECK(response_.Valid());
+    const auto prev_read_rpc_wait_time = read_rpc_wait_time_;
     result = VERIFY_RESULT(ProcessResponse(response_.Get(&read_rpc_wait_time_)));
     // In case ProcessResponse doesn't fail with an error
     // it should return non empty rows and/or set end_of_data_.
     DCHECK(!result.empty() || end_of_data_);
     // Prefetch next portion of data if needed.
     if (!(end_of_data_ || suppress_next_result_prefetching_)) {
+      if (read_rpc_wait_time_ > prev_read_rpc_wait_time) {
+        PrefetchedResponseWaited(result);
+      }
       RETURN_NOT_OK(SendRequest(true /* force_non_bufferable */));
     }
   }
@@ -277,6 +349,15 @@ Result<std::list<PgDocResult>> PgDocOp::GetResult() {
   return result;
 }
 
+void PgDocOp::GetAndResetDocDBStats(YBCPgDocDBStats* stats) {
+  stats->seeks += docdb_stats_.seeks;
+  stats->keys_skipped += docdb_stats_.keys_skipped;
+  stats->block_cache_hits += docdb_stats_.block_cache_hits;
+  stats->block_cache_misses += docdb_stats_.block_cache_misses;
+  stats->block_read_bytes += docdb_stats_.block_read_bytes;
+  docdb_stats_ = {};
+}
+
 Result<int32_t> PgDocOp::GetRowsAffectedCount() const {
   RETURN_NOT_OK(exec_status_);
   DCHECK(end_of_data_);
@@ -357,6 +438,14 @@ Result<std::list<PgDocResult>> PgDocOp::ProcessCallResponse(const rpc::CallRespo
       continue;
     }
     rows_affected_count_ += op_response->rows_affected_count();
+    if (op_response->has_docdb_stats()) {
+      const auto& stats = op_response->docdb_stats();
+      docdb_stats_.seeks += stats.seeks();
+      docdb_stats_.keys_skipped += stats.keys_skipped();
+      docdb_stats_.block_cache_hits += stats.block_cache_hits();
+      docdb_stats_.block_cache_misses += stats.block_cache_misses();
+      docdb_stats_.block_read_bytes += stats.block_read_bytes();
+    }
     if (!op_response->has_rows_data_sidecar()) {
       continue;
     }
@@ -451,6 +540,9 @@ Status PgDocReadOp::ExecuteInit(const PgExecParameters *exec_params) {
   if (pg_session_->ShouldUseFollowerReads()) {
     read_op_->set_read_from_followers();
   }
+  if (FLAGS_ysql_fetch_docdb_stats) {
+    read_op_->read_request().set_fetch_docdb_stats(true);
+  }
   SetRequestPrefetchLimit();
   SetBackfillSpec();
   SetRowMark();
@@ -677,10 +769,35 @@ Result<bool> PgDocReadOp::PopulateParallelSelectOps() {
   SCHECK(read_op_->read_request().partition_column_values().empty(),
          IllegalState,
          "Request with non empty partition_column_values can't be parallelized");
-  // Create batch operators, one per partition, to execute in parallel.
+  // Scan bounds of the request are known by now, so partitions that could not have matching rows,
+  // i.e. other regional partitions of the table, are pruned before sending any requests.
   // TODO(tsplit): what if table partition is changed during PgDocReadOp lifecycle before or after
   // the following line?
-  ClonePgsqlOps(table_->GetPartitionCount());
+  const auto& partition_keys = table_->GetPartitions();
+  const auto scan_bounds = VERIFY_RESULT(GetScanBounds(*table_, read_op_->read_request()));
+  std::vector<size_t> partitions;
+  partitions.reserve(partition_keys.size());
+  for (size_t partition = 0; partition < partition_keys.size(); ++partition) {
+    const auto partition_upper_bound = partition + 1 < partition_keys.size()
+        ? Slice(partition_keys[partition + 1]) : Slice();
+    if (PartitionMatchesScanBounds(
+            scan_bounds, partition_keys[partition], partition_upper_bound)) {
+      partitions.push_back(partition);
+    }
+  }
+  if (partitions.empty()) {
+    // Bounds are contradictory, there is nothing to scan. Send single request with the original
+    // bounds, so the tablet returns empty result.
+    pgsql_ops_.emplace_back(read_op_);
+    pgsql_ops_.back()->set_active(true);
+    active_op_count_ = 1;
+    return true;
+  }
+  VLOG(1) << "Partitions to scan in parallel: " << partitions.size() << " of "
+          << partition_keys.size();
+
+  // Create batch operators, one per matching partition, to execute in parallel.
+  ClonePgsqlOps(partitions.size());
   // Set "parallelism_level_" to control how many operators can be sent at one time.
   //
   // TODO(neil) The calculation for this control variable should be applied to ALL operators, but
@@ -691,30 +808,32 @@ Result<bool> PgDocReadOp::PopulateParallelSelectOps() {
 
     // Establish lower and upper bounds on parallelism.
     int kMinParSelParallelism = 1;
-    int kMaxParSelParallelism = 16;
-    parallelism_level_ =
-      std::min(std::max(tserver_count * 2, kMinParSelParallelism), kMaxParSelParallelism);
+    int max_parallelism = std::max(FLAGS_ysql_max_select_parallelism, kMinParSelParallelism);
+    parallelism_level_ = std::min(
+        std::max(tserver_count * FLAGS_ysql_select_parallelism_per_tserver,
+                 kMinParSelParallelism),
+        max_parallelism);
   } else {
     parallelism_level_ = parallelism_level;
   }
 
   // Assign partitions to operators.
-  const auto& partition_keys = table_->GetPartitions();
-  SCHECK_EQ(partition_keys.size(), pgsql_ops_.size(), IllegalState,
-            "Number of partitions and number of partition keys are not the same");
+  SCHECK_EQ(partitions.size(), pgsql_ops_.size(), IllegalState,
+            "Number of partitions to scan and number of operators are not the same");
 
-  for (size_t partition = 0; partition < partition_keys.size(); partition++) {
+  for (size_t op_index = 0; op_index < partitions.size(); op_index++) {
     // Construct a new YBPgsqlReadOp.
-    pgsql_ops_[partition]->set_active(true);
+    pgsql_ops_[op_index]->set_active(true);
 
     // Use partition index to setup the protobuf to identify the partition that this request
     // is for. Batcher will use this information to send the request to correct tablet server, and
     // server uses this information to operate on correct tablet.
     // - Range partition uses range partition key to identify partition.
     // - Hash partition uses "next_partition_key" and "max_hash_code" to identify partition.
-    RETURN_NOT_OK(SetLowerUpperBound(&GetReadReq(partition), partition));
+    RETURN_NOT_OK(SetLowerUpperBound(
+        &GetReadReq(op_index), partitions[op_index], KeepTighterBounds::kTrue));
   }
-  active_op_count_ = partition_keys.size();
+  active_op_count_ = partitions.size();
 
   return true;
 }
@@ -926,6 +1045,47 @@ void PgDocReadOp::SetRequestPrefetchLimit() {
   req.set_limit(limit);
 }
 
+void PgDocReadOp::PrefetchedResponseWaited(const std::list<PgDocResult>& result) {
+  // Next page of the partition could be requested only after the paging state of the previous
+  // page is received. So when executor is faster than the network, we fetch bigger pages instead
+  // of keeping several requests in flight.
+  uint64_t max_limit = FLAGS_ysql_max_prefetch_limit;
+  if (!exec_params_.limit_use_default) {
+    max_limit = std::min<uint64_t>(
+        max_limit, exec_params_.limit_count + exec_params_.limit_offset);
+  }
+  auto& req = read_op_->read_request();
+  const auto limit = req.limit();
+  if (limit >= max_limit) {
+    return;
+  }
+
+  uint64_t rows = 0;
+  size_t bytes = 0;
+  for (const auto& doc_result : result) {
+    rows += doc_result.row_count();
+    bytes += doc_result.data_size();
+  }
+  if (rows == 0) {
+    return;
+  }
+  // Response could contain pages from multiple partitions.
+  const auto sent_ops = std::max<size_t>(result.size(), 1);
+  const auto row_size = std::max<size_t>(bytes / rows, 1);
+  const auto bytes_limit = FLAGS_ysql_max_prefetch_bytes / sent_ops / row_size;
+  const auto new_limit = std::min({limit * 2, max_limit, std::max<uint64_t>(bytes_limit, limit)});
+  if (new_limit == limit) {
+    return;
+  }
+  VLOG(3) << __func__ << " limit: " << limit << " new_limit: " << new_limit
+          << " row_size: " << row_size;
+
+  req.set_limit(new_limit);
+  for (size_t op_index = 0; op_index != active_op_count_; ++op_index) {
+    GetReadReq(op_index).set_limit(new_limit);
+  }
+}
+
 void PgDocReadOp::SetRowMark() {
   auto& req = read_op_->read_request();
   const auto row_mark_type = GetRowMarkType(&exec_params_);
@@ -1011,14 +1171,25 @@ LWPgsqlReadRequestPB& PgDocReadOp::GetReadReq(size_t op_index) {
   return GetReadOp(op_index).read_request();
 }
 
-Result<bool> PgDocReadOp::SetLowerUpperBound(LWPgsqlReadRequestPB* request, size_t partition) {
+Result<bool> PgDocReadOp::SetLowerUpperBound(
+    LWPgsqlReadRequestPB* request, size_t partition, KeepTighterBounds keep_tighter_bounds) {
   const auto& partition_keys = table_->GetPartitions();
-  const std::string default_upper_bound;
-  const auto& upper_bound = (partition < partition_keys.size() - 1)
+  std::string lower_bound = partition_keys[partition];
+  std::string upper_bound = (partition < partition_keys.size() - 1)
       ? partition_keys[partition + 1]
-      : default_upper_bound;
+      : std::string();
+  // Empty bound is not applied, so bound of the request is kept when it is tighter.
+  if (keep_tighter_bounds) {
+    if (request->has_lower_bound() && request->lower_bound().key().compare(lower_bound) >= 0) {
+      lower_bound.clear();
+    }
+    if (request->has_upper_bound() &&
+        (upper_bound.empty() || request->upper_bound().key().compare(upper_bound) < 0)) {
+      upper_bound.clear();
+    }
+  }
   RETURN_NOT_OK(table_->SetScanBoundary(request,
-                                        partition_keys[partition],
+                                        lower_bound,
                                         /* lower_bound_is_inclusive */ true,
                                         upper_bound,
                                         /* upper_bound_is_inclusive */ false));
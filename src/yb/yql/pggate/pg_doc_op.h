@@ -30,6 +30,7 @@
 #include "yb/yql/pggate/pg_op.h"
 #include "yb/yql/pggate/pg_session.h"
 #include "yb/yql/pggate/pg_sys_table_prefetcher.h"
+#include "yb/yql/pggate/ybc_pg_typedefs.h"
 
 namespace yb {
 namespace pggate {
@@ -37,6 +38,7 @@ namespace pggate {
 class PgTuple;
 
 YB_STRONGLY_TYPED_BOOL(RequestSent);
+YB_STRONGLY_TYPED_BOOL(KeepTighterBounds);
 
 //--------------------------------------------------------------------------------------------------
 // PgDocResult represents a batch of rows in ONE reply from tablet servers.
@@ -50,6 +52,11 @@ class PgDocResult {
   // Get the order of the next row in this batch.
   int64_t NextRowOrder();
 
+  // Orders of all rows in this batch.
+  const std::vector<int64_t>& row_orders() const {
+    return row_orders_;
+  }
+
   // End of this batch.
   bool is_eof() const {
     return row_count_ == 0 || row_iterator_.empty();
@@ -78,6 +85,11 @@ class PgDocResult {
     return row_count_;
   }
 
+  // Size of the data selected from DocDB.
+  size_t data_size() const {
+    return data_.second.size();
+  }
+
  private:
   // Data selected from DocDB.
   rpc::SidecarHolder data_;
@@ -325,6 +337,9 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
     read_rpc_wait_time_ = MonoDelta::FromNanoseconds(0);
   }
 
+  // Adds DocDB execution stats of reads to stats for EXPLAIN ANALYZE.
+  void GetAndResetDocDBStats(YBCPgDocDBStats* stats);
+
  protected:
   PgDocOp(
     const PgSession::ScopedRefPtr& pg_session, PgTable* table,
@@ -337,6 +352,10 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
 
   virtual Status DoPopulateDmlByYbctidOps(const YbctidGenerator& generator) = 0;
 
+  // Invoked when upper level had to wait for the prefetched response, before prefetching next
+  // portion of data. Could be used to make each request fetch more data.
+  virtual void PrefetchedResponseWaited(const std::list<PgDocResult>& result) {}
+
   // Only active operators are kept in the active range [0, active_op_count_)
   // - Not execute operators that are outside of range [0, active_op_count_).
   // - Sort the operators in "pgsql_ops_" to move "inactive" operators to the end of the list.
@@ -438,6 +457,7 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
   // Read RPC stats for EXPLAIN ANALYZE.
   uint64_t read_rpc_count_ = 0;
   MonoDelta read_rpc_wait_time_ = MonoDelta::FromNanoseconds(0);
+  YBCPgDocDBStats docdb_stats_ = {};
 
  private:
   Status SendRequest(bool force_non_bufferable);
@@ -529,6 +549,9 @@ class PgDocReadOp : public PgDocOp {
   // Analyze options and pick the appropriate prefetch limit.
   void SetRequestPrefetchLimit();
 
+  // Doubles prefetch limit up to ysql_max_prefetch_limit rows and ysql_max_prefetch_bytes bytes.
+  void PrefetchedResponseWaited(const std::list<PgDocResult>& result) override;
+
   // Set the backfill_spec field of our read request.
   void SetBackfillSpec();
 
@@ -538,7 +561,11 @@ class PgDocReadOp : public PgDocOp {
   // Set the read_time for our backfill's read request based on our exec control parameter.
   void SetReadTimeForBackfill();
 
-  Result<bool> SetLowerUpperBound(LWPgsqlReadRequestPB* request, size_t partition);
+  // When keep_tighter_bounds is set, bounds of the request, that are tighter than the partition
+  // bounds, are not overwritten.
+  Result<bool> SetLowerUpperBound(
+      LWPgsqlReadRequestPB* request, size_t partition,
+      KeepTighterBounds keep_tighter_bounds = KeepTighterBounds::kFalse);
 
   // Get the read_op for a specific operation index from pgsql_ops_.
   PgsqlReadOp& GetReadOp(size_t op_index);
@@ -324,13 +324,12 @@ void TranslateDecimal(Slice *yb_cursor, const PgWireDataHeader& header, int inde
   size_t read_size = PgDocData::ReadNumber(yb_cursor, &data_size);
   yb_cursor->remove_prefix(read_size);
 
-  // Read the decimal value from Protobuf and decode it to internal format.
-  std::string serialized_decimal;
-  read_size = PgDocData::ReadString(yb_cursor, &serialized_decimal, data_size);
-  yb_cursor->remove_prefix(read_size);
+  // Decode the decimal value to internal format directly from RPC buffer.
+  Slice serialized_decimal(yb_cursor->data(), data_size);
+  yb_cursor->remove_prefix(data_size);
   util::Decimal yb_decimal;
   if (!yb_decimal.DecodeFromComparable(serialized_decimal).ok()) {
-    LOG(FATAL) << "Failed to deserialize DECIMAL from " << serialized_decimal;
+    LOG(FATAL) << "Failed to deserialize DECIMAL from " << serialized_decimal.ToDebugHexString();
     return;
   }
 
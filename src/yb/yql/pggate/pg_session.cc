@@ -362,6 +362,20 @@ Result<std::pair<int64_t, bool>> PgSession::ReadSequenceTuple(int64_t db_oid,
       db_oid, seq_oid, ysql_catalog_version, is_db_catalog_version_mode);
 }
 
+Result<std::pair<int64_t, int64_t>> PgSession::FetchSequenceTuple(int64_t db_oid,
+                                                                 int64_t seq_oid,
+                                                                 uint64_t ysql_catalog_version,
+                                                                 bool is_db_catalog_version_mode,
+                                                                 int64_t fetch_count,
+                                                                 int64_t inc_by,
+                                                                 int64_t min_value,
+                                                                 int64_t max_value,
+                                                                 bool cycle) {
+  return pg_client_.FetchSequenceTuple(
+      db_oid, seq_oid, ysql_catalog_version, is_db_catalog_version_mode, fetch_count, inc_by,
+      min_value, max_value, cycle);
+}
+
 Status PgSession::DeleteSequenceTuple(int64_t db_oid, int64_t seq_oid) {
   return pg_client_.DeleteSequenceTuple(db_oid, seq_oid);
 }
@@ -446,8 +460,9 @@ void PgSession::InvalidateAllTablesCache() {
   table_cache_.clear();
 }
 
-Result<client::TableSizeInfo> PgSession::GetTableDiskSize(const PgObjectId& table_oid) {
-  return pg_client_.GetTableDiskSize(table_oid);
+Result<client::TableSizeInfo> PgSession::GetTableDiskSize(
+    const PgObjectId& table_oid, bool use_cache) {
+  return pg_client_.GetTableDiskSize(table_oid, use_cache);
 }
 
 Status PgSession::StartOperationsBuffering() {
@@ -533,6 +548,9 @@ Result<PerformFuture> PgSession::Perform(
       catalog_read_time_.ToPB(options.mutable_read_time());
     }
     options.set_use_catalog_session(true);
+    if (catalog_response_cache_version_) {
+      options.set_response_cache_catalog_version(catalog_response_cache_version_);
+    }
   } else {
     const auto txn_serial_no = pg_txn_manager_->SetupPerformOptions(&options);
     ProcessPerformOnTxnSerialNo(
@@ -126,6 +126,12 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   void ResetCatalogReadPoint();
   [[nodiscard]] bool HasCatalogReadPoint() const;
 
+  // Allows catalog reads to be served from the node level response cache of the local tserver,
+  // for the specified catalog version. 0 disables the cache.
+  void SetCatalogResponseCacheVersion(uint64_t catalog_version) {
+    catalog_response_cache_version_ = catalog_version;
+  }
+
   //------------------------------------------------------------------------------------------------
   // Operations on Session.
   //------------------------------------------------------------------------------------------------
@@ -167,6 +173,17 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
                                                      uint64_t ysql_catalog_version,
                                                      bool is_db_catalog_version_mode);
 
+  // Returns the first and the last of fetched values.
+  Result<std::pair<int64_t, int64_t>> FetchSequenceTuple(int64_t db_oid,
+                                                         int64_t seq_oid,
+                                                         uint64_t ysql_catalog_version,
+                                                         bool is_db_catalog_version_mode,
+                                                         int64_t fetch_count,
+                                                         int64_t inc_by,
+                                                         int64_t min_value,
+                                                         int64_t max_value,
+                                                         bool cycle);
+
   Status DeleteSequenceTuple(int64_t db_oid, int64_t seq_oid);
 
   Status DeleteDBSequences(int64_t db_oid);
@@ -191,7 +208,7 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   Result<PgTableDescPtr> LoadTable(const PgObjectId& table_id);
   void InvalidateTableCache(
       const PgObjectId& table_id, InvalidateOnPgClient invalidate_on_pg_client);
-  Result<client::TableSizeInfo> GetTableDiskSize(const PgObjectId& table_oid);
+  Result<client::TableSizeInfo> GetTableDiskSize(const PgObjectId& table_oid, bool use_cache);
 
   // Start operation buffering. Buffering must not be in progress.
   Status StartOperationsBuffering();
@@ -351,6 +368,7 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   const scoped_refptr<server::HybridClock> clock_;
 
   ReadHybridTime catalog_read_time_;
+  uint64_t catalog_response_cache_version_ = 0;
 
   // Execution status.
   Status status_;
@@ -85,6 +85,7 @@ DECLARE_bool(use_node_to_node_encryption);
 DECLARE_string(certs_dir);
 DECLARE_bool(node_to_node_encryption_use_client_certificates);
 DECLARE_int32(backfill_index_client_rpc_timeout_ms);
+DECLARE_bool(TEST_enable_db_catalog_version_mode);
 
 namespace yb {
 namespace pggate {
@@ -249,6 +250,8 @@ Status FetchExistingYbctids(PgSession::ScopedRefPtr session,
       uint64_t in_txn_limit, bool force_non_bufferable) {
     return precast_sender.Send(session, ops, ops_count, table, in_txn_limit, force_non_bufferable);
   };
+  // Index of the first ybctid of each doc_op.
+  boost::container::small_vector<size_t, 16> doc_op_first_ybctid;
   // Start all the doc_ops to read from docdb in parallel, one doc_op per table ID.
   // Each doc_op will use request_sender to send all the requests with single perform RPC.
   for (auto it = ybctids->begin(), end = ybctids->end(); it != end;) {
@@ -257,8 +260,9 @@ Status FetchExistingYbctids(PgSession::ScopedRefPtr session,
     bool is_region_local = region_local_tables.find(table_id) != region_local_tables.end();
     auto read_op = std::make_shared<PgsqlReadOpWithPgTable>(arena.get(), desc, is_region_local);
 
-    auto* expr_pb = read_op->read_request().add_targets();
-    expr_pb->set_column_id(to_underlying(PgSystemAttrNum::kYBTupleId));
+    // Only existence of the rows is checked, so no targets are requested. Found rows are
+    // identified by the orders of their batch arguments, that DocDB returns with the response.
+    doc_op_first_ybctid.push_back(it - ybctids->begin());
     doc_ops.push_back(std::make_unique<PgDocReadOp>(
         session, &read_op->table(), std::move(read_op), request_sender));
     auto& doc_op = *doc_ops.back();
@@ -280,21 +284,35 @@ Status FetchExistingYbctids(PgSession::ScopedRefPtr session,
   // of each doc_op will be sent individually).
   precast_sender.DisableCollecting();
   // Collect the results from the docdb ops.
-  ybctids->clear();
-  for (auto& it : doc_ops) {
+  std::vector<TableYbctid> found;
+  for (size_t i = 0; i != doc_ops.size(); ++i) {
+    auto& doc_op = *doc_ops[i];
+    const auto first = doc_op_first_ybctid[i];
+    const auto count = (i + 1 != doc_ops.size() ? doc_op_first_ybctid[i + 1] : ybctids->size()) -
+                       first;
     for (;;) {
-      auto rowsets = VERIFY_RESULT(it->GetResult());
+      auto rowsets = VERIFY_RESULT(doc_op.GetResult());
       if (rowsets.empty()) {
         break;
       }
-      for (auto& row : rowsets) {
-        RETURN_NOT_OK(row.ProcessSystemColumns());
-        for (const auto& ybctid : row.ybctids()) {
-          ybctids->emplace_back(it->table()->id().object_oid, ybctid.ToBuffer());
+      for (auto& rowset : rowsets) {
+        // Response without found rows has no batch argument orders, so local orders of all sent
+        // ybctids are used for it, see BuildRowOrders.
+        if (rowset.row_count() == 0) {
+          continue;
+        }
+        const auto& orders = rowset.row_orders();
+        SCHECK_EQ(orders.size(), static_cast<size_t>(rowset.row_count()), IllegalState,
+                  "Batch argument orders are expected for all found rows");
+        for (auto order : orders) {
+          SCHECK(order >= 0 && static_cast<size_t>(order) < count, IllegalState,
+                 Format("Unexpected batch argument order $0, batch size $1", order, count));
+          found.push_back(std::move((*ybctids)[first + order]));
         }
       }
     }
   }
+  *ybctids = std::move(found);
 
   return Status::OK();
 }
@@ -580,6 +598,25 @@ Status PgApiImpl::ReadSequenceTuple(int64_t db_oid,
   return Status::OK();
 }
 
+Status PgApiImpl::FetchSequenceTuple(int64_t db_oid,
+                                     int64_t seq_oid,
+                                     uint64_t ysql_catalog_version,
+                                     bool is_db_catalog_version_mode,
+                                     int64_t fetch_count,
+                                     int64_t inc_by,
+                                     int64_t min_value,
+                                     int64_t max_value,
+                                     bool cycle,
+                                     int64_t *first_value,
+                                     int64_t *last_value) {
+  auto res = VERIFY_RESULT(pg_session_->FetchSequenceTuple(
+      db_oid, seq_oid, ysql_catalog_version, is_db_catalog_version_mode, fetch_count, inc_by,
+      min_value, max_value, cycle));
+  *first_value = res.first;
+  *last_value = res.second;
+  return Status::OK();
+}
+
 Status PgApiImpl::DeleteSequenceTuple(int64_t db_oid, int64_t seq_oid) {
   return pg_session_->DeleteSequenceTuple(db_oid, seq_oid);
 }
@@ -972,8 +1009,9 @@ Status PgApiImpl::SetCatalogCacheVersion(
   return STATUS(InvalidArgument, "Invalid statement handle");
 }
 
-Result<client::TableSizeInfo> PgApiImpl::GetTableDiskSize(const PgObjectId& table_oid) {
-  return pg_session_->GetTableDiskSize(table_oid);
+Result<client::TableSizeInfo> PgApiImpl::GetTableDiskSize(
+    const PgObjectId& table_oid, bool use_cache) {
+  return pg_session_->GetTableDiskSize(table_oid, use_cache);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1664,6 +1702,10 @@ void PgApiImpl::GetAndResetReadRpcStats(PgStatement *handle,
                                                          tbl_reads, tbl_read_wait);
 }
 
+void PgApiImpl::GetAndResetDocDBStats(PgStatement *handle, YBCPgDocDBStats* stats) {
+  down_cast<PgDmlRead*>(handle)->GetAndResetDocDBStats(stats);
+}
+
 void PgApiImpl::GetAndResetOperationFlushRpcStats(uint64_t* count,
                                                   uint64_t* wait_time) {
   pg_session_->GetAndResetOperationFlushRpcStats(count, wait_time);
@@ -1812,6 +1854,10 @@ void PgApiImpl::StartSysTablePrefetching() {
   }
   CHECK(!pg_session_->HasCatalogReadPoint());
   pg_sys_table_prefetcher_.reset(new PgSysTablePrefetcher());
+  // Per database catalog versions are not tracked by the response cache key yet.
+  if (!FLAGS_TEST_enable_db_catalog_version_mode) {
+    pg_session_->SetCatalogResponseCacheVersion(tserver_shared_object_->ysql_catalog_version());
+  }
 }
 
 void PgApiImpl::StopSysTablePrefetching() {
@@ -1820,6 +1866,7 @@ void PgApiImpl::StopSysTablePrefetching() {
   } else {
     pg_sys_table_prefetcher_.reset();
   }
+  pg_session_->SetCatalogResponseCacheVersion(0);
 }
 
 void PgApiImpl::RegisterSysTableForPrefetching(
@@ -188,6 +188,18 @@ class PgApiImpl {
                                    int64_t *last_val,
                                    bool *is_called);
 
+  Status FetchSequenceTuple(int64_t db_oid,
+                            int64_t seq_oid,
+                            uint64_t ysql_catalog_version,
+                            bool is_db_catalog_version_mode,
+                            int64_t fetch_count,
+                            int64_t inc_by,
+                            int64_t min_value,
+                            int64_t max_value,
+                            bool cycle,
+                            int64_t *first_value,
+                            int64_t *last_value);
+
   Status DeleteSequenceTuple(int64_t db_oid, int64_t seq_oid);
 
   void DeleteStatement(PgStatement *handle);
@@ -323,7 +335,7 @@ class PgApiImpl {
   Status SetCatalogCacheVersion(
       PgStatement *handle, uint64_t version, std::optional<PgOid> db_oid = std::nullopt);
 
-  Result<client::TableSizeInfo> GetTableDiskSize(const PgObjectId& table_oid);
+  Result<client::TableSizeInfo> GetTableDiskSize(const PgObjectId& table_oid, bool use_cache);
 
   //------------------------------------------------------------------------------------------------
   // Create and drop index.
@@ -603,6 +615,8 @@ class PgApiImpl {
   void GetAndResetReadRpcStats(PgStatement *handle, uint64_t* reads, uint64_t* read_wait,
                                uint64_t* tbl_reads, uint64_t* tbl_read_wait);
 
+  void GetAndResetDocDBStats(PgStatement *handle, YBCPgDocDBStats* stats);
+
   //------------------------------------------------------------------------------------------------
   // System Validation.
   Status ValidatePlacement(const char *placement_info);
@@ -16,8 +16,11 @@
 // (linked into postgres).
 
 #include "yb/util/flags.h"
+#include "yb/util/size_literals.h"
 #include "yb/yql/pggate/pggate_flags.h"
 
+using namespace yb::size_literals;
+
 DEFINE_int32(pgsql_rpc_keepalive_time_ms, 0,
              "If an RPC connection from a client is idle for this amount of time, the server "
              "will disconnect the client. Setting flag to 0 disables this clean up.");
@@ -45,6 +48,15 @@ DEFINE_int32(ysql_request_limit, 1024,
 DEFINE_uint64(ysql_prefetch_limit, 1024,
               "Maximum number of rows to prefetch");
 
+DEFINE_uint64(ysql_max_prefetch_limit, 1024,
+              "When a scan has to wait for the prefetched rows, number of rows requested by each "
+              "next request is doubled, starting from ysql_prefetch_limit and up to this value. "
+              "Values not greater than ysql_prefetch_limit disable it.");
+
+DEFINE_uint64(ysql_max_prefetch_bytes, 4_MB,
+              "Number of rows requested by each next request is not grown above this size of "
+              "the response, estimated from the size of the previous response.");
+
 DEPRECATE_FLAG(double, ysql_backward_prefetch_scale_factor, "11_2022");
 
 DEFINE_uint64(ysql_session_max_batch_size, 3072,
@@ -108,6 +120,19 @@ DEFINE_int32(ysql_select_parallelism, -1,
             "Number of read requests to issue in parallel to tablets of a table "
             "for SELECT.");
 
+DEFINE_int32(ysql_select_parallelism_per_tserver, 2,
+            "When ysql_select_parallelism is negative, number of read requests to issue in "
+            "parallel to tablets of a table for SELECT per primary tablet server, bounded by "
+            "ysql_max_select_parallelism.");
+
+DEFINE_int32(ysql_max_select_parallelism, 16,
+            "Upper bound on the number of read requests issued in parallel to tablets of a table "
+            "for SELECT, when parallelism is derived from the number of tablet servers.");
+
+DEFINE_bool(ysql_fetch_docdb_stats, true,
+            "Whether to request DocDB execution statistics of reads from tablet servers, so they "
+            "are shown by EXPLAIN (ANALYZE, DIST, VERBOSE).");
+
 DEFINE_int32(ysql_max_write_restart_attempts, 20,
              "Max number of restart attempts made for writes on transaction conflicts.");
 
@@ -22,6 +22,8 @@ DECLARE_string(pggate_master_addresses);
 DECLARE_int32(pggate_tserver_shm_fd);
 DECLARE_int32(ysql_request_limit);
 DECLARE_uint64(ysql_prefetch_limit);
+DECLARE_uint64(ysql_max_prefetch_limit);
+DECLARE_uint64(ysql_max_prefetch_bytes);
 DECLARE_double(ysql_backward_prefetch_scale_factor);
 DECLARE_uint64(ysql_session_max_batch_size);
 DECLARE_bool(ysql_non_txn_copy);
@@ -31,6 +33,9 @@ DECLARE_int64(TEST_inject_delay_between_prepare_ybctid_execute_batch_ybctid_ms);
 DECLARE_bool(TEST_index_read_multiple_partitions);
 DECLARE_int32(ysql_output_buffer_size);
 DECLARE_int32(ysql_select_parallelism);
+DECLARE_int32(ysql_select_parallelism_per_tserver);
+DECLARE_int32(ysql_max_select_parallelism);
+DECLARE_bool(ysql_fetch_docdb_stats);
 DECLARE_int32(ysql_sequence_cache_minval);
 DECLARE_int32(ysql_num_databases_reserved_in_db_catalog_version_mode);
 
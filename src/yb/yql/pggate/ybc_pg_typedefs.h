@@ -385,6 +385,15 @@ typedef struct PgRangeSplitDatum {
   YBCPgDatumKind datum_kind;
 } YBCPgSplitDatum;
 
+// DocDB execution statistics of reads for EXPLAIN ANALYZE, see PgsqlDocDBStatsPB.
+typedef struct PgDocDBStats {
+  uint64_t seeks;
+  uint64_t keys_skipped;
+  uint64_t block_cache_hits;
+  uint64_t block_cache_misses;
+  uint64_t block_read_bytes;
+} YBCPgDocDBStats;
+
 typedef enum PgBoundType {
   YB_YQL_BOUND_INVALID = 0,
   YB_YQL_BOUND_VALID,
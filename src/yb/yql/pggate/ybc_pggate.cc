@@ -421,6 +421,22 @@ YBCStatus YBCReadSequenceTuple(int64_t db_oid,
       db_oid, seq_oid, ysql_catalog_version, is_db_catalog_version_mode, last_val, is_called));
 }
 
+YBCStatus YBCFetchSequenceTuple(int64_t db_oid,
+                                int64_t seq_oid,
+                                uint64_t ysql_catalog_version,
+                                bool is_db_catalog_version_mode,
+                                int64_t fetch_count,
+                                int64_t inc_by,
+                                int64_t min_value,
+                                int64_t max_value,
+                                bool cycle,
+                                int64_t *first_value,
+                                int64_t *last_value) {
+  return ToYBCStatus(pgapi->FetchSequenceTuple(
+      db_oid, seq_oid, ysql_catalog_version, is_db_catalog_version_mode, fetch_count, inc_by,
+      min_value, max_value, cycle, first_value, last_value));
+}
+
 YBCStatus YBCDeleteSequenceTuple(int64_t db_oid, int64_t seq_oid) {
   return ToYBCStatus(pgapi->DeleteSequenceTuple(db_oid, seq_oid));
 }
@@ -681,13 +697,26 @@ YBCStatus YBCPgGetTableDiskSize(YBCPgOid table_oid,
                                 YBCPgOid database_oid,
                                 int64_t *size,
                                 int32_t *num_missing_tablets) {
-  return ExtractValueFromResult(pgapi->GetTableDiskSize({database_oid, table_oid}),
-                                [size, num_missing_tablets](auto value) {
+  return ExtractValueFromResult(
+      pgapi->GetTableDiskSize({database_oid, table_oid}, /* use_cache= */ false),
+      [size, num_missing_tablets](auto value) {
      *size = value.table_size;
      *num_missing_tablets = value.num_missing_tablets;
   });
 }
 
+YBCStatus YBCPgGetTableEstimatedNumRows(YBCPgOid table_oid,
+                                        YBCPgOid database_oid,
+                                        double *num_rows,
+                                        int32_t *num_missing_tablets) {
+  return ExtractValueFromResult(
+      pgapi->GetTableDiskSize({database_oid, table_oid}, /* use_cache= */ true),
+      [num_rows, num_missing_tablets](auto value) {
+     *num_rows = static_cast<double>(value.estimated_num_rows);
+     *num_missing_tablets = value.num_missing_tablets;
+  });
+}
+
 // Index Operations -------------------------------------------------------------------------------
 
 YBCStatus YBCPgNewCreateIndex(const char *database_name,
@@ -1109,7 +1138,7 @@ YBCStatus YBCAppendDatumToKey(uint64_t data, const YBCPgTypeEntity *typeentity,
 }
 
 uint16_t YBCCompoundHash(const char *key, size_t length) {
-  return YBPartition::HashColumnCompoundValue(string(key, length));
+  return YBPartition::HashColumnCompoundValue(Slice(key, length));
 }
 
 //------------------------------------------------------------------------------------------------
@@ -1357,6 +1386,10 @@ void YBCGetAndResetReadRpcStats(YBCPgStatement handle, uint64_t* reads, uint64_t
   pgapi->GetAndResetReadRpcStats(handle, reads, read_wait, tbl_reads, tbl_read_wait);
 }
 
+void YBCGetAndResetDocDBStats(YBCPgStatement handle, YBCPgDocDBStats* stats) {
+  pgapi->GetAndResetDocDBStats(handle, stats);
+}
+
 //------------------------------------------------------------------------------------------------
 // Thread-local variables.
 //------------------------------------------------------------------------------------------------
@@ -128,6 +128,20 @@ YBCStatus YBCReadSequenceTuple(int64_t db_oid,
                                int64_t *last_val,
                                bool *is_called);
 
+// Fetches next fetch_count values of the sequence through the node level cache of the sequence
+// values. Fetched values are first_value, first_value + inc_by, ..., last_value.
+YBCStatus YBCFetchSequenceTuple(int64_t db_oid,
+                                int64_t seq_oid,
+                                uint64_t ysql_catalog_version,
+                                bool is_db_catalog_version_mode,
+                                int64_t fetch_count,
+                                int64_t inc_by,
+                                int64_t min_value,
+                                int64_t max_value,
+                                bool cycle,
+                                int64_t *first_value,
+                                int64_t *last_value);
+
 YBCStatus YBCDeleteSequenceTuple(int64_t db_oid, int64_t seq_oid);
 
 // Create database.
@@ -271,6 +285,13 @@ YBCStatus YBCPgGetTableDiskSize(YBCPgOid table_oid,
                                 int64_t *size,
                                 int32_t *num_missing_tablets);
 
+// Approximate number of live rows of the table, maintained by its tablets. Could be served from
+// the recently fetched estimates cached by the local tablet server.
+YBCStatus YBCPgGetTableEstimatedNumRows(YBCPgOid table_oid,
+                                        YBCPgOid database_oid,
+                                        double *num_rows,
+                                        int32_t *num_missing_tablets);
+
 YBCStatus YBCGetSplitPoints(YBCPgTableDesc table_desc,
                             const YBCPgTypeEntity **type_entities,
                             YBCPgTypeAttrs *type_attrs_arr,
@@ -497,6 +518,9 @@ YBCStatus YBCPgExecSelect(YBCPgStatement handle, const YBCPgExecParameters *exec
 void YBCGetAndResetReadRpcStats(YBCPgStatement handle, uint64_t* reads, uint64_t* read_wait,
                                 uint64_t* tbl_reads, uint64_t* tbl_read_wait);
 
+// Adds DocDB execution statistics of the statement reads to stats, and resets them.
+void YBCGetAndResetDocDBStats(YBCPgStatement handle, YBCPgDocDBStats* stats);
+
 // Transaction control -----------------------------------------------------------------------------
 YBCStatus YBCPgBeginTransaction();
 YBCStatus YBCPgRecreateTransaction();
@@ -245,6 +245,33 @@ TEST_F(PgFKeyTest, YB_DISABLE_TEST_IN_TSAN(InsertWithLargeNumberOfFK)) {
   }
 }
 
+// Test checks that FK check reports violation, when some or all referenced rows are missing,
+// including the case of parent table tablets without any referenced rows.
+TEST_F(PgFKeyTest, YB_DISABLE_TEST_IN_TSAN(InsertWithMissingReferencedRow)) {
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.ExecuteFormat(
+      "CREATE TABLE $0(k INT PRIMARY KEY) SPLIT INTO 3 TABLETS", kPKTable));
+  ASSERT_OK(conn.ExecuteFormat(
+      "CREATE TABLE $0(k INT PRIMARY KEY, pk INT REFERENCES $1(k))", kFKTable, kPKTable));
+
+  // Parent table is empty.
+  auto status = conn.ExecuteFormat("INSERT INTO $0 VALUES(1, 1)", kFKTable);
+  ASSERT_NOK(status);
+  ASSERT_STR_CONTAINS(status.ToString(), "violates foreign key constraint");
+
+  ASSERT_OK(conn.ExecuteFormat("INSERT INTO $0 VALUES(1), (2)", kPKTable));
+  // Referenced rows are spread over tablets of the parent table, so part of the tablets does not
+  // return any rows.
+  status = conn.ExecuteFormat(
+      "INSERT INTO $0 SELECT s, s FROM generate_series(1, 10) AS s", kFKTable);
+  ASSERT_NOK(status);
+  ASSERT_STR_CONTAINS(status.ToString(), "violates foreign key constraint");
+
+  ASSERT_OK(conn.ExecuteFormat("INSERT INTO $0 VALUES(1, 1), (2, 2)", kFKTable));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>(Format("SELECT COUNT(*) FROM $0", kFKTable))),
+            2);
+}
+
 // Test checks rows written by buffered write operations are read successfully while
 // performing FK constraint check.
 TEST_F_EX(PgFKeyTest, YB_DISABLE_TEST_IN_TSAN(BufferedWriteOfReferencedRows), PgFKeyTestNoFKCache) {
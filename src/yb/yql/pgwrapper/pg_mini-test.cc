@@ -504,6 +504,25 @@ TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(WriteRetry)) {
   ASSERT_STR_CONTAINS(status.ToString(), "duplicate key value violates unique constraint");
 }
 
+TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(AnalyzeSkipsParts)) {
+  constexpr int kNumRows = 100000;
+  FLAGS_db_block_size_bytes = 2_KB;
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY, value TEXT) SPLIT INTO 1 TABLETS"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, 'value_' || i FROM generate_series(1, $0) AS i", kNumRows));
+  ASSERT_NO_FATALS(FlushAndCompactTablets());
+
+  // Rows after the first sampled rows are mostly skipped, so the row count is an estimate.
+  ASSERT_OK(conn.Execute("ANALYZE t"));
+  auto reltuples = ASSERT_RESULT(conn.FetchValue<int64_t>(
+      "SELECT reltuples::bigint FROM pg_class WHERE relname = 't'"));
+  LOG(INFO) << "Estimated rows: " << reltuples;
+  ASSERT_GE(reltuples, kNumRows * 0.8);
+  ASSERT_LE(reltuples, kNumRows * 1.2);
+}
+
 TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(With)) {
   auto conn = ASSERT_RESULT(Connect());
 
@@ -47,6 +47,9 @@ DECLARE_bool(enable_automatic_tablet_splitting);
 DECLARE_int32(cleanup_split_tablets_interval_sec);
 DECLARE_uint64(rpc_connection_timeout_ms);
 DECLARE_uint64(force_single_shard_waiter_retry_ms);
+DECLARE_bool(batch_deadlock_probes_by_status_tablet);
+DECLARE_uint64(transaction_deadlock_detection_interval_usec);
+DECLARE_int32(transaction_table_num_tablets);
 
 using namespace std::literals;
 
@@ -458,6 +461,134 @@ TEST_F(PgPessimisticLockingTest, YB_DISABLE_TEST_IN_TSAN(LongWaitBeforeDeadlock)
   EXPECT_LT(succeeded_commit, kClients);
 }
 
+// Periodic probe scan is effectively disabled, so deadlocks could only be found by probes sent
+// when new wait-for edges are reported.
+class PgEdgeTriggeredDeadlockTest : public PgPessimisticLockingTest {
+ protected:
+  void SetUp() override {
+    FLAGS_transaction_deadlock_detection_interval_usec = 3600 * 1000000ULL;
+    PgPessimisticLockingTest::SetUp();
+  }
+};
+
+TEST_F(PgEdgeTriggeredDeadlockTest, YB_DISABLE_TEST_IN_TSAN(DeadlockFoundOnNewEdge)) {
+  constexpr int kClients = 3;
+  auto setup_conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(setup_conn.Execute("CREATE TABLE foo (k INT PRIMARY KEY, v INT)"));
+  ASSERT_OK(setup_conn.ExecuteFormat(
+      "insert into foo select generate_series(0, $0), 0", kClients));
+  TestThreadHolder thread_holder;
+
+  CountDownLatch first_select(kClients);
+  CountDownLatch done(kClients);
+  std::atomic<int> failed_second_select{0};
+
+  auto deadline = GetDeadlockDetectedDeadline();
+
+  for (int i = 0; i != kClients; ++i) {
+    thread_holder.AddThreadFunctor([this, i, &first_select, &done, &failed_second_select] {
+      auto conn = ASSERT_RESULT(Connect());
+      ASSERT_OK(conn.StartTransaction(IsolationLevel::SNAPSHOT_ISOLATION));
+      ASSERT_OK(conn.FetchFormat("SELECT * FROM foo WHERE k=$0 FOR UPDATE", i));
+      first_select.CountDown();
+      ASSERT_TRUE(first_select.WaitFor(5s * kTimeMultiplier));
+
+      // The last client closes the cycle, after wait-for edges of the others were already
+      // reported and probed without finding a deadlock.
+      if (i == kClients - 1) {
+        std::this_thread::sleep_for(2s * kTimeMultiplier);
+      }
+      auto blocker_idx = GetBlockerIdx(i, kClients);
+      if (conn.FetchFormat("SELECT * FROM foo WHERE k=$0 FOR UPDATE", blocker_idx).ok()) {
+        if (!conn.CommitTransaction().ok()) {
+          LOG(INFO) << "Commit failed " << i;
+        }
+      } else {
+        LOG(INFO) << "Second select failed " << i << " on blocker " << blocker_idx;
+        ++failed_second_select;
+      }
+
+      done.CountDown();
+      ASSERT_TRUE(done.WaitFor(15s * kTimeMultiplier));
+    });
+  }
+
+  thread_holder.WaitAndStop(25s * kTimeMultiplier);
+  ASSERT_LE(CoarseMonoClock::Now(), deadline);
+  ASSERT_GE(failed_second_select, 1);
+}
+
+// Transaction 2 waits for transactions 0 and 1, that share the only status tablet, so probes for
+// both blockers are sent in one rpc when batching is enabled. Transaction 1 waits for transaction
+// 2, so the deadlock has to be found through the blocker that is not the first one of the probe.
+class PgDeadlockProbeBatchingTest : public PgPessimisticLockingTest,
+                                    public testing::WithParamInterface<bool> {
+ protected:
+  void SetUp() override {
+    FLAGS_transaction_table_num_tablets = 1;
+    PgPessimisticLockingTest::SetUp();
+    // AutoFlag is promoted on cluster start, so it is changed after that.
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_batch_deadlock_probes_by_status_tablet) = GetParam();
+  }
+};
+
+TEST_P(PgDeadlockProbeBatchingTest, YB_DISABLE_TEST_IN_TSAN(DeadlockWithSharedLockBlockers)) {
+  auto setup_conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(setup_conn.Execute("CREATE TABLE foo (k INT PRIMARY KEY, v INT)"));
+  ASSERT_OK(setup_conn.Execute("insert into foo select generate_series(0, 1), 0"));
+  TestThreadHolder thread_holder;
+
+  CountDownLatch locked(2);
+  CountDownLatch failed(1);
+  CountDownLatch done(2);
+  std::atomic<int> failed_selects{0};
+
+  auto deadline = GetDeadlockDetectedDeadline();
+
+  ASSERT_OK(setup_conn.StartTransaction(IsolationLevel::SNAPSHOT_ISOLATION));
+  ASSERT_OK(setup_conn.Fetch("SELECT * FROM foo WHERE k=0 FOR SHARE"));
+
+  for (int i = 1; i <= 2; ++i) {
+    thread_holder.AddThreadFunctor([this, i, &locked, &failed, &done, &failed_selects] {
+      auto conn = ASSERT_RESULT(Connect());
+      ASSERT_OK(conn.StartTransaction(IsolationLevel::SNAPSHOT_ISOLATION));
+      ASSERT_OK(conn.Fetch(i == 1
+          ? "SELECT * FROM foo WHERE k=0 FOR SHARE" : "SELECT * FROM foo WHERE k=1 FOR UPDATE"));
+      locked.CountDown();
+      ASSERT_TRUE(locked.WaitFor(5s * kTimeMultiplier));
+
+      // Transaction 2 starts waiting first, so the cycle is closed by transaction 1.
+      if (i == 1) {
+        std::this_thread::sleep_for(2s * kTimeMultiplier);
+      }
+      auto s = ResultToStatus(conn.FetchFormat("SELECT * FROM foo WHERE k=$0 FOR UPDATE", 2 - i));
+      if (s.ok()) {
+        if (!conn.CommitTransaction().ok()) {
+          LOG(INFO) << "Commit failed " << i;
+        }
+      } else {
+        LOG(INFO) << "Second select failed " << i << ": " << s;
+        ++failed_selects;
+        failed.CountDown();
+      }
+
+      done.CountDown();
+      ASSERT_TRUE(done.WaitFor(20s * kTimeMultiplier));
+    });
+  }
+
+  // Transaction 0 is not a part of the deadlock, and should not block the surviving waiter.
+  ASSERT_TRUE(failed.WaitFor(deadline - CoarseMonoClock::Now()));
+  ASSERT_OK(setup_conn.CommitTransaction());
+
+  thread_holder.WaitAndStop(10s * kTimeMultiplier);
+  ASSERT_LE(CoarseMonoClock::Now(), deadline);
+  ASSERT_GE(failed_selects, 1);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    PgPessimisticLockingTest, PgDeadlockProbeBatchingTest, ::testing::Bool());
+
 TEST_F(PgPessimisticLockingTest, YB_DISABLE_TEST_IN_TSAN(SavepointRollbackUnblock)) {
   auto setup_conn = ASSERT_RESULT(Connect());
   ASSERT_OK(setup_conn.Execute("CREATE TABLE foo (k INT PRIMARY KEY, v INT)"));
@@ -78,7 +78,7 @@ namespace redisserver {
 
 #define REDIS_COMMANDS \
     ((get, Get, 2, READ)) \
-    ((mget, MGet, -2, READ)) \
+    ((mget, MGet, -2, LOCAL)) \
     ((hget, HGet, 3, READ)) \
     ((tsget, TsGet, 3, READ)) \
     ((hmget, HMGet, -3, READ)) \
@@ -983,6 +983,116 @@ void HandleKeys(LocalCommandData data) {
   }
 }
 
+// MGET reads all its keys with a single flush, so reads of keys on different tablets are sent in
+// parallel. Command is added to each tablet of its keys, so it is executed after the preceding
+// commands of the batch, that use the same tablets.
+class MGetProcessor : public std::enable_shared_from_this<MGetProcessor> {
+ public:
+  explicit MGetProcessor(const LocalCommandData& data) : data_(data) {}
+
+  // Creates read operations for the keys and returns partition key of each distinct tablet.
+  Result<std::vector<std::string>> Prepare() {
+    auto* table = data_.table();
+    if (!table) {
+      return STATUS(RuntimeError, "Could not open YBTable");
+    }
+    std::vector<std::string> result;
+    std::unordered_set<std::string> partition_starts;
+    for (size_t i = 1; i != data_.arg_size(); ++i) {
+      const auto key = data_.arg(i);
+      if (key.empty()) {
+        return STATUS(InvalidCommand, "A MGET request must have non empty key fields");
+      }
+      auto operation = std::make_shared<client::YBRedisReadOp>(table->shared_from_this());
+      operation->mutable_request()->mutable_key_value()->set_key(key.cdata(), key.size());
+      operation->mutable_request()->mutable_get_request()->set_request_type(
+          RedisGetRequestPB_GetRequestType_GET);
+      std::string partition_key;
+      RETURN_NOT_OK(operation->GetPartitionKey(&partition_key));
+      if (partition_starts.insert(*table->FindPartitionStart(partition_key)).second) {
+        result.push_back(std::move(partition_key));
+      }
+      operations_.push_back(std::move(operation));
+    }
+    callbacks_.resize(result.size());
+    return result;
+  }
+
+  bool Store(size_t idx, client::YBSession* session, const StatusFunctor& callback) {
+    callbacks_[idx] = callback;
+    if (idx == 0) {
+      session_ = session;
+    }
+    if (stored_.fetch_add(1, std::memory_order_acq_rel) + 1 == callbacks_.size()) {
+      Execute();
+    }
+    return true;
+  }
+
+ private:
+  void Execute() {
+    for (const auto& operation : operations_) {
+      session_->Apply(operation);
+    }
+    session_->set_allow_local_calls_in_curr_thread(false);
+    session_->FlushAsync(std::bind(&MGetProcessor::Processed, shared_from_this(), _1));
+  }
+
+  void Processed(client::FlushStatus* flush_status) {
+    auto status = flush_status->status;
+    if (!status.ok() && !flush_status->errors.empty()) {
+      status = flush_status->errors.front()->status();
+    }
+
+    RedisResponsePB resp;
+    if (status.ok()) {
+      resp.set_code(RedisResponsePB::OK);
+      auto* array_response = resp.mutable_array_response();
+      array_response->set_encoded(true);
+      for (const auto& operation : operations_) {
+        const auto& response = operation->response();
+        if (response.code() == RedisResponsePB::SERVER_ERROR) {
+          resp = response;
+          break;
+        }
+        // As in Redis, keys that don't exist or are not strings are returned as nil.
+        if (response.code() == RedisResponsePB::OK && response.has_string_response()) {
+          AddElements(redisserver::EncodeAsBulkString(response.string_response()), array_response);
+        } else {
+          array_response->add_elements(redisserver::kNilResponse);
+        }
+      }
+    }
+    data_.Respond(status, &resp);
+
+    for (const auto& callback : callbacks_) {
+      callback(Status::OK());
+    }
+  }
+
+  LocalCommandData data_;
+
+  std::vector<std::shared_ptr<client::YBRedisReadOp>> operations_;
+  std::vector<StatusFunctor> callbacks_;
+  client::YBSession* session_ = nullptr;
+  std::atomic<size_t> stored_{0};
+};
+
+void HandleMGet(LocalCommandData data) {
+  auto processor = std::make_shared<MGetProcessor>(data);
+  auto partition_keys = processor->Prepare();
+  if (!partition_keys.ok()) {
+    data.Respond(partition_keys.status(), nullptr);
+    return;
+  }
+  size_t idx = 0;
+  for (const auto& partition_key : *partition_keys) {
+    data.Apply(std::bind(
+        &MGetProcessor::Store, processor, idx, _1, _2), partition_key, ManualResponse::kTrue);
+    ++idx;
+  }
+}
+
 void HandleCommand(LocalCommandData data) {
   data.Respond();
 }
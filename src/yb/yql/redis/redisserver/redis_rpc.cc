@@ -325,11 +325,12 @@ Out DoSerializeResponses(const Collection& responses, Out out) {
   // TODO(Amit): As and when we implement get/set and its h* equivalents, we would have to
   // handle arrays, hashes etc. For now, we only support the string response.
 
+  static const std::string kUnknownError = "Unknown error";
+
   for (const auto& redis_response : responses) {
-    string error_message = redis_response.error_message();
-    if (error_message == "") {
-      error_message = "Unknown error";
-    }
+    // Responses are walked twice, to compute the size and to write them, so avoid copying message.
+    const std::string& error_message = redis_response.error_message().empty()
+        ? kUnknownError : redis_response.error_message();
     // Several types of error cases:
     //    1) Parsing error: The command is malformed (eg. too few arguments "SET a")
     //    2) Server error: Request to server failed due to reasons not related to the command
@@ -3180,6 +3180,36 @@ TEST_F(TestRedisService, TestKeysPipeline) {
   VerifyCallbacks();
 }
 
+TEST_F(TestRedisService, TestMGet) {
+  DoRedisTestOk(__LINE__, {"SET", "ma", "1"});
+  DoRedisTestOk(__LINE__, {"SET", "mb", "2"});
+  DoRedisTestInt(__LINE__, {"HSET", "mh", "f", "3"}, 1);
+  // Writes preceding MGET in the pipeline should be visible to it.
+  DoRedisTestResultsArray(
+      __LINE__, {"MGET", "ma", "mne", "mb", "mh", "ma"},
+      {RedisReply(RedisReplyType::kString, "1"), RedisReply(),
+       RedisReply(RedisReplyType::kString, "2"), RedisReply(),
+       RedisReply(RedisReplyType::kString, "1")});
+  SyncClient();
+
+  // Keys on different tablets.
+  std::vector<std::string> command = {"MGET"};
+  std::vector<RedisReply> expected;
+  for (int i = 0; i != 50; ++i) {
+    auto key = Format("mk$0", i);
+    auto value = std::to_string(i);
+    DoRedisTestOk(__LINE__, {"SET", key, value});
+    command.push_back(key);
+    expected.emplace_back(RedisReplyType::kString, value);
+  }
+  DoRedisTestResultsArray(__LINE__, command, expected);
+  SyncClient();
+
+  DoRedisTestExpectError(__LINE__, {"MGET"});
+  SyncClient();
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, TestIncrCorner) {
   DoRedisTestOk(__LINE__, {"SET", "kstr", "str"});
   SyncClient();